@@ -13,6 +13,7 @@
 #include "bdd.h"
 #include "depth.h"
 #include "cube.h"
+#include "parallel.h"
 
 // ABC Headers
 #include "base/abc/abc.h"
@@ -25,7 +26,9 @@ void alloc_and_init_activity_info(Abc_Ntk_t * ntk);
 void ace_update_latch_probs(Abc_Ntk_t * ntk);
 void print_node_bdd(Abc_Ntk_t * ntk);
 void print_nodes(Vec_Ptr_t * nodes);
-int ace_calc_activity(Abc_Ntk_t * ntk, int num_vectors, char * clk_name);
+void ace_calc_node_switch_act(Abc_Obj_t * obj, void * ntk_ptr);
+int ace_calc_activity(Abc_Ntk_t * ntk, int num_vectors, char * clk_name,
+		int depth, int num_threads, ace_sim_mode_t sim_mode);
 
 st__table * ace_info_hash_table;
 
@@ -143,14 +146,43 @@ void print_nodes(Vec_Ptr_t * nodes) {
 	fflush(0);
 }
 
-int ace_calc_activity(Abc_Ntk_t * ntk, int num_vectors, char * clk_name) {
+void ace_calc_node_switch_act(Abc_Obj_t * obj, void * ntk_ptr) {
+	Abc_Ntk_t * ntk = (Abc_Ntk_t*) ntk_ptr;
+	Ace_Obj_Info_t * info2 = Ace_ObjInfo(obj);
+	//Ace_Obj_Info_t * fanin_info2;
+
+	VTR_ASSERT(Abc_ObjType(obj) == ABC_OBJ_NODE);
+
+	if (Abc_ObjFaninNum(obj) < 1) {
+		info2->switch_act = 0.0;
+		return;
+	} else {
+		Vec_Ptr_t * literals = Vec_PtrAlloc(0);
+		Abc_Obj_t * fanin;
+		int j;
+
+		VTR_ASSERT(obj->Type == ABC_OBJ_NODE);
+
+		Abc_ObjForEachFanin(obj, fanin, j)
+		{
+			Vec_PtrPush(literals, fanin);
+		}
+		info2->switch_act = ace_bdd_calc_switch_act((DdManager*)ntk->pManFunc, obj,
+				literals);
+		Vec_PtrFree(literals);
+	}
+	VTR_ASSERT(info2->switch_act >= 0);
+}
+
+int ace_calc_activity(Abc_Ntk_t * ntk, int num_vectors, char * clk_name,
+		int depth, int num_threads, ace_sim_mode_t sim_mode) {
 	int error = 0;
 	Vec_Ptr_t * nodes_all;
 	Vec_Ptr_t * nodes_logic;
 	Vec_Ptr_t * next_state_node_vec;
 	Vec_Ptr_t * latches_in_cycles_vec;
 	Abc_Obj_t * obj;
-	int i, j;
+	int i;
 	Ace_Obj_Info_t * info;
 
 	//Build BDD
@@ -196,7 +228,12 @@ int ace_calc_activity(Abc_Ntk_t * ntk, int num_vectors, char * clk_name) {
 
 		//print_nodes(next_state_node_vec);
 
-		ace_sim_activities(ntk, next_state_node_vec, num_vectors, 0.05);
+		if (sim_mode == ACE_SIM_PACKED) {
+			ace_sim_activities_packed(ntk, num_vectors, depth, num_threads);
+		} else {
+			ace_sim_activities(ntk, next_state_node_vec, num_vectors, 0.05, depth,
+					num_threads);
+		}
 		//ace_sim_activities(ntk, nodes_logic, num_vectors, 0.05);
 
 		ace_update_latch_probs(ntk);
@@ -272,32 +309,12 @@ int ace_calc_activity(Abc_Ntk_t * ntk, int num_vectors, char * clk_name) {
 		}
 	}
 
-	Vec_PtrForEachEntry(Abc_Obj_t*, nodes_logic, obj, i)
-	{
-		Ace_Obj_Info_t * info2 = Ace_ObjInfo(obj);
-		//Ace_Obj_Info_t * fanin_info2;
-
-		VTR_ASSERT(Abc_ObjType(obj) == ABC_OBJ_NODE);
-
-		if (Abc_ObjFaninNum(obj) < 1) {
-			info2->switch_act = 0.0;
-			continue;
-		} else {
-			Vec_Ptr_t * literals = Vec_PtrAlloc(0);
-			Abc_Obj_t * fanin;
-
-			VTR_ASSERT(obj->Type == ABC_OBJ_NODE);
-
-			Abc_ObjForEachFanin(obj, fanin, j)
-			{
-				Vec_PtrPush(literals, fanin);
-			}
-			info2->switch_act = ace_bdd_calc_switch_act((DdManager*)ntk->pManFunc, obj,
-					literals);
-			Vec_PtrFree(literals);
-		}
-		VTR_ASSERT(info2->switch_act >= 0);
-	}
+	/* A node only depends on the probabilities of its fanins, so the
+	 * nodes of the same depth are computed concurrently */
+	Vec_Ptr_t ** levels = ace_levelize_nodes(nodes_logic, depth);
+	ace_parallel_for_levels(levels, depth + 1, num_threads,
+			ace_calc_node_switch_act, ntk);
+	ace_free_levels(levels, depth);
     Vec_PtrFree(nodes_logic);
     Vec_PtrFree(latches_in_cycles_vec);
 
@@ -338,6 +355,8 @@ int main(int argc, char * argv[]) {
 	Abc_Ntk_t * ntk;
 	Abc_Obj_t * obj;
 	int seed = 0;
+	int num_threads = 1;
+	ace_sim_mode_t sim_mode = ACE_SIM_SCALAR;
 
 	p = ACE_PI_STATIC_PROB;
 	d = ACE_PI_SWITCH_PROB;
@@ -346,7 +365,8 @@ int main(int argc, char * argv[]) {
 	char new_blif_file_name[BLIF_FILE_NAME_LEN];
     char* clk_name = NULL;
 	ace_io_parse_argv(argc, argv, &BLIF, &IN_ACT, &OUT_ACT, blif_file_name,
-			new_blif_file_name, &pi_format, &p, &d, &seed, &clk_name);
+			new_blif_file_name, &pi_format, &p, &d, &seed, &clk_name,
+			&num_threads, &sim_mode);
 
 	srand(seed);
 
@@ -428,7 +448,8 @@ int main(int argc, char * argv[]) {
 	}
 
 	if (!error) {
-		error = ace_calc_activity(ntk, ACE_NUM_VECTORS, clk_name);
+		error = ace_calc_activity(ntk, ACE_NUM_VECTORS, clk_name, depth,
+				num_threads, sim_mode);
 	}
 
 	//Abc_NtkToSop(ntk, 0);
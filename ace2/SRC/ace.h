@@ -38,6 +38,9 @@ typedef enum {
 typedef enum {
 	ACE_UNDEF, ACE_DEF, ACE_SIM, ACE_NEW, ACE_OLD
 } ace_status_t;
+typedef enum {
+	ACE_SIM_SCALAR, ACE_SIM_PACKED
+} ace_sim_mode_t;
 
 void prob_epsilon_fix(double * d);
 
@@ -15,9 +15,11 @@ int check_pi_status(Abc_Obj_t * obj);
 void ace_bdd_count_paths(DdManager * mgr, DdNode * bdd, int * num_one_paths,
 		int * num_zero_paths);
 double calc_cube_switch_prob(DdManager * mgr, DdNode * bdd, ace_cube_t * cube,
-		Vec_Ptr_t * inputs, int phase);
+		Vec_Ptr_t * inputs, const double * prob0to1, const double * prob1to0,
+		int phase);
 double calc_switch_prob_recur(DdManager * mgr, DdNode * bdd_next, DdNode * bdd,
-		ace_cube_t * cube, Vec_Ptr_t * inputs, double P1, int phase);
+		ace_cube_t * cube, Vec_Ptr_t * inputs, const double * prob0to1,
+		const double * prob1to0, double P1, int phase);
 
 void ace_bdd_get_literals(Abc_Ntk_t * ntk, st__table ** lit_st_table,
 		Vec_Ptr_t ** literals) {
@@ -170,7 +172,8 @@ int ace_bdd_build_network_bdds(
 #endif
 
 double calc_cube_switch_prob_recur(DdManager * mgr, DdNode * bdd,
-		ace_cube_t * cube, Vec_Ptr_t * inputs, st__table * visited, int phase) {
+		ace_cube_t * cube, Vec_Ptr_t * inputs, const double * prob0to1,
+		const double * prob1to0, st__table * visited, int phase) {
 	double * current_prob;
 	short i;
 	Abc_Obj_t * pi;
@@ -210,22 +213,22 @@ double calc_cube_switch_prob_recur(DdManager * mgr, DdNode * bdd,
 
 	Ace_Obj_Info_t * fanin_info = Ace_ObjInfo(pi);
 
-	then_prob = calc_cube_switch_prob_recur(mgr, bdd_if1, cube, inputs, visited,
-			phase);
+	then_prob = calc_cube_switch_prob_recur(mgr, bdd_if1, cube, inputs,
+			prob0to1, prob1to0, visited, phase);
 	VTR_ASSERT(then_prob + EPSILON >= 0 && then_prob - EPSILON <= 1);
 
-	else_prob = calc_cube_switch_prob_recur(mgr, bdd_if0, cube, inputs, visited,
-			phase);
+	else_prob = calc_cube_switch_prob_recur(mgr, bdd_if0, cube, inputs,
+			prob0to1, prob1to0, visited, phase);
 	VTR_ASSERT(else_prob + EPSILON >= 0 && else_prob - EPSILON <= 1);
 
 	switch (node_get_literal (cube->cube, i)) {
 	case ZERO:
-		*current_prob = fanin_info->prob0to1 * then_prob
-				+ (1.0 - fanin_info->prob0to1) * else_prob;
+		*current_prob = prob0to1[i] * then_prob
+				+ (1.0 - prob0to1[i]) * else_prob;
 		break;
 	case ONE:
-		*current_prob = (1.0 - fanin_info->prob1to0) * then_prob
-				+ fanin_info->prob1to0 * else_prob;
+		*current_prob = (1.0 - prob1to0[i]) * then_prob
+				+ prob1to0[i] * else_prob;
 		break;
 	case TWO:
 		*current_prob = fanin_info->static_prob * then_prob
@@ -242,13 +245,15 @@ double calc_cube_switch_prob_recur(DdManager * mgr, DdNode * bdd,
 }
 
 double calc_cube_switch_prob(DdManager * mgr, DdNode * bdd, ace_cube_t * cube,
-		Vec_Ptr_t * inputs, int phase) {
+		Vec_Ptr_t * inputs, const double * prob0to1, const double * prob1to0,
+		int phase) {
 	double sp;
 	st__table * visited;
 
 	visited = st__init_table(st__ptrcmp, st__ptrhash);
 
-	sp = calc_cube_switch_prob_recur(mgr, bdd, cube, inputs, visited, phase);
+	sp = calc_cube_switch_prob_recur(mgr, bdd, cube, inputs, prob0to1, prob1to0,
+			visited, phase);
 
 	st__free_table(visited);
 
@@ -257,7 +262,8 @@ double calc_cube_switch_prob(DdManager * mgr, DdNode * bdd, ace_cube_t * cube,
 }
 
 double calc_switch_prob_recur(DdManager * mgr, DdNode * bdd_next, DdNode * bdd,
-		ace_cube_t * cube, Vec_Ptr_t * inputs, double P1, int phase) {
+		ace_cube_t * cube, Vec_Ptr_t * inputs, const double * prob0to1,
+		const double * prob1to0, double P1, int phase) {
 	short i;
 	Abc_Obj_t * pi;
 	double switch_prob_t, switch_prob_e;
@@ -273,7 +279,8 @@ double calc_switch_prob_recur(DdManager * mgr, DdNode * bdd_next, DdNode * bdd,
 	if (bdd == Cudd_ReadLogicZero(mgr)) {
 		if (phase != 1)
 			return (0.0);
-		prob = calc_cube_switch_prob(mgr, bdd_next, cube, inputs, phase);
+		prob = calc_cube_switch_prob(mgr, bdd_next, cube, inputs, prob0to1,
+				prob1to0, phase);
 		prob *= P1;
 
 		VTR_ASSERT(prob + EPSILON >= 0. && prob - EPSILON <= 1.);
@@ -281,7 +288,8 @@ double calc_switch_prob_recur(DdManager * mgr, DdNode * bdd_next, DdNode * bdd,
 	} else if (bdd == Cudd_ReadOne(mgr)) {
 		if (phase != 0)
 			return (0.0);
-		prob = calc_cube_switch_prob(mgr, bdd_next, cube, inputs, phase);
+		prob = calc_cube_switch_prob(mgr, bdd_next, cube, inputs, prob0to1,
+				prob1to0, phase);
 		prob *= P1;
 
 		VTR_ASSERT(prob + EPSILON >= 0. && prob - EPSILON <= 1.);
@@ -306,7 +314,7 @@ double calc_switch_prob_recur(DdManager * mgr, DdNode * bdd_next, DdNode * bdd,
 	set_remove(cube1->cube, 2 * i);
 	set_insert(cube1->cube, 2 * i + 1);
 	switch_prob_t = calc_switch_prob_recur(mgr, bdd_next, bdd_if1, cube1,
-			inputs, P1 * info->static_prob, phase);
+			inputs, prob0to1, prob1to0, P1 * info->static_prob, phase);
 	ace_cube_free(cube1);
 
 	/* Recursive call down the ELSE branch */
@@ -314,7 +322,7 @@ double calc_switch_prob_recur(DdManager * mgr, DdNode * bdd_next, DdNode * bdd,
 	set_insert(cube0->cube, 2 * i);
 	set_remove(cube0->cube, 2 * i + 1);
 	switch_prob_e = calc_switch_prob_recur(mgr, bdd_next, bdd_if0, cube0,
-			inputs, P1 * (1.0 - info->static_prob), phase);
+			inputs, prob0to1, prob1to0, P1 * (1.0 - info->static_prob), phase);
 	ace_cube_free(cube0);
 
 	VTR_ASSERT(switch_prob_t + EPSILON >= 0. && switch_prob_t - EPSILON <= 1.);
@@ -331,6 +339,8 @@ double ace_bdd_calc_switch_act(DdManager * mgr, Abc_Obj_t * obj,
 	Abc_Obj_t * fanin;
 	ace_cube_t * cube;
 	double switch_act;
+	double * prob0to1;
+	double * prob1to0;
 	int i;
 	DdNode * bdd;
 
@@ -349,32 +359,42 @@ double ace_bdd_calc_switch_act(DdManager * mgr, Abc_Obj_t * obj,
 	n0 = n1 = 0;
 	ace_bdd_count_paths(mgr, bdd, &n1, &n0);
 
+	/* The transition probabilities of the fanins depend on the depth of obj,
+	 * so they are kept local to allow evaluating nodes concurrently */
+	prob0to1 = (double*) malloc(Vec_PtrSize(fanins) * sizeof(double));
+	prob1to0 = (double*) malloc(Vec_PtrSize(fanins) * sizeof(double));
+
 	Vec_PtrForEachEntry(Abc_Obj_t*, fanins, fanin, i)
 	//#define Vec_PtrForEachEntry( vVec, pEntry, i ) for ( i = 0; (i < Vec_PtrSize(vVec)) && (((pEntry) = Vec_PtrEntry(vVec, i)), 1); i++ )
 	//for ( i = 0; (i < Vec_PtrSize(fanins)) && (((fanin) = Vec_PtrEntry(fanins, i)), 1); i++ )
 	{
 		Ace_Obj_Info_t * fanin_info = Ace_ObjInfo(fanin);
 
-		fanin_info->prob0to1 =
+		prob0to1[i] =
 				ACE_P0TO1 (fanin_info->static_prob, fanin_info->switch_prob / (double) d);
-		fanin_info->prob1to0 =
+		prob1to0[i] =
 				ACE_P1TO0 (fanin_info->static_prob, fanin_info->switch_prob / (double) d);
 
-		prob_epsilon_fix(&fanin_info->prob0to1);
-		prob_epsilon_fix(&fanin_info->prob1to0);
+		prob_epsilon_fix(&prob0to1[i]);
+		prob_epsilon_fix(&prob1to0[i]);
 
 		VTR_ASSERT(
-				fanin_info->prob0to1 + EPSILON >= 0.
-						&& fanin_info->prob0to1 - EPSILON <= 1.0);
+				prob0to1[i] + EPSILON >= 0.
+						&& prob0to1[i] - EPSILON <= 1.0);
 		VTR_ASSERT(
-				fanin_info->prob1to0 + EPSILON >= 0.
-						&& fanin_info->prob1to0 - EPSILON <= 1.0);
+				prob1to0[i] + EPSILON >= 0.
+						&& prob1to0[i] - EPSILON <= 1.0);
 	}
 	cube = ace_cube_new_dc(Vec_PtrSize(fanins));
 
 	switch_act = 2.0
-			* calc_switch_prob_recur(mgr, bdd, bdd, cube, fanins, 1.0, n1 > n0)
+			* calc_switch_prob_recur(mgr, bdd, bdd, cube, fanins, prob0to1,
+					prob1to0, 1.0, n1 > n0)
 			* (double) d;
+
+	ace_cube_free(cube);
+	free(prob0to1);
+	free(prob1to0);
 	//switch_act = 2.0 * calc_switch_prob_recur (mgr, bdd, bdd, cube, fanins, 1.0, 1) * (double) d;
 
 	return switch_act;
@@ -1,3 +1,5 @@
+#include "vtr_assert.h"
+
 #include "ace.h"
 #include "depth.h"
 
@@ -48,3 +50,33 @@ int ace_calc_network_depth(Abc_Ntk_t * ntk) {
     Vec_PtrFree(nodes);
 	return depth;
 }
+
+Vec_Ptr_t ** ace_levelize_nodes(Vec_Ptr_t * nodes, int depth) {
+	int i;
+	Abc_Obj_t * obj;
+	Vec_Ptr_t ** levels;
+
+	levels = (Vec_Ptr_t**) malloc((depth + 1) * sizeof(Vec_Ptr_t*));
+	for (i = 0; i <= depth; i++) {
+		levels[i] = Vec_PtrAlloc(0);
+	}
+
+	Vec_PtrForEachEntry(Abc_Obj_t*, nodes, obj, i)
+	{
+		Ace_Obj_Info_t * info = Ace_ObjInfo(obj);
+
+		VTR_ASSERT(info->depth >= 0 && info->depth <= depth);
+		Vec_PtrPush(levels[info->depth], obj);
+	}
+
+	return levels;
+}
+
+void ace_free_levels(Vec_Ptr_t ** levels, int depth) {
+	int i;
+
+	for (i = 0; i <= depth; i++) {
+		Vec_PtrFree(levels[i]);
+	}
+	free(levels);
+}
@@ -1,6 +1,13 @@
 #ifndef __ACE_DEPTH_H_
 #define __ACE_DEPTH_H_
 
+#include "ace.h"
+
 int ace_calc_network_depth(Abc_Ntk_t * ntk);
 
+/* Groups the nodes by the depth computed by ace_calc_network_depth(),
+ * keeping their order within each level */
+Vec_Ptr_t ** ace_levelize_nodes(Vec_Ptr_t * nodes, int depth);
+void ace_free_levels(Vec_Ptr_t ** levels, int depth);
+
 #endif
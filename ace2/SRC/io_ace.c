@@ -100,7 +100,8 @@ void ace_io_print_activity(Abc_Ntk_t * ntk, FILE * fp) {
 
 int ace_io_parse_argv(int argc, char ** argv, FILE ** BLIF, FILE ** IN_ACT,
 		FILE ** OUT_ACT, char * blif_file_name, char * new_blif_file_name,
-		ace_pi_format_t * pi_format, double *p, double * d, int * seed, char** clk_name) {
+		ace_pi_format_t * pi_format, double *p, double * d, int * seed, char** clk_name,
+		int * num_threads, ace_sim_mode_t * sim_mode) {
 	int i;
 	char option;
 
@@ -150,6 +151,25 @@ int ace_io_parse_argv(int argc, char ** argv, FILE ** BLIF, FILE ** IN_ACT,
 			case 'c':
 				*clk_name = argv[i];
 				break;
+			case 'm':
+				if (strcmp(argv[i], "scalar") == 0) {
+					*sim_mode = ACE_SIM_SCALAR;
+				} else if (strcmp(argv[i], "packed") == 0) {
+					*sim_mode = ACE_SIM_PACKED;
+				} else {
+					printf("Unknown simulation mode '%s'\n", argv[i]);
+					ace_io_print_usage();
+					exit(1);
+				}
+				break;
+			case 't':
+				*num_threads = atoi(argv[i]);
+				if (*num_threads < 1) {
+					printf("Number of threads must be positive\n");
+					ace_io_print_usage();
+					exit(1);
+				}
+				break;
 			default:
 				ace_io_print_usage();
 				exit(1);
@@ -193,6 +213,11 @@ void ace_io_print_usage() {
 	(void) fprintf(stderr, "    -p [PI static probability]    |\n");
 	(void) fprintf(stderr, "    -d [PI switching activity]    |\n");
 	(void) fprintf(stderr, "                                --+\n");
+	(void) fprintf(stderr, "\n");
+	(void) fprintf(stderr, "                                --+\n");
+	(void) fprintf(stderr, "    -m [scalar|packed]            | optional\n");
+	(void) fprintf(stderr, "    -t [number of threads]        |\n");
+	(void) fprintf(stderr, "                                --+\n");
 }
 
 int ace_io_read_activity(Abc_Ntk_t * ntk, FILE * in_file_desc,
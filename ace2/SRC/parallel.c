@@ -0,0 +1,65 @@
+//The standard headers are included first, as ace.h redefines bool
+#include <condition_variable>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+#include "vtr_assert.h"
+
+#include "ace.h"
+#include "parallel.h"
+
+void ace_parallel_for_levels(Vec_Ptr_t ** levels, int num_levels,
+		int num_threads, ace_node_task_t task, void * data) {
+	Abc_Obj_t * obj;
+	int i, j;
+
+	VTR_ASSERT(num_threads > 0);
+
+	if (num_threads == 1) {
+		for (i = 0; i < num_levels; i++) {
+			Vec_PtrForEachEntry(Abc_Obj_t*, levels[i], obj, j)
+			{
+				task(obj, data);
+			}
+		}
+		return;
+	}
+
+	/* Barrier which all the threads reach at the end of each level */
+	std::mutex mutex;
+	std::condition_variable cond;
+	int num_arrived = 0;
+	int generation = 0;
+
+	auto barrier = [&]() {
+		std::unique_lock<std::mutex> lock(mutex);
+		int cur_generation = generation;
+		if (++num_arrived == num_threads) {
+			num_arrived = 0;
+			generation++;
+			cond.notify_all();
+		} else {
+			cond.wait(lock, [&]() {return generation != cur_generation;});
+		}
+	};
+
+	auto worker = [&](int thread_id) {
+		for (int ilevel = 0; ilevel < num_levels; ilevel++) {
+			Vec_Ptr_t * level = levels[ilevel];
+			for (int inode = thread_id; inode < Vec_PtrSize(level); inode += num_threads) {
+				task((Abc_Obj_t*) Vec_PtrEntry(level, inode), data);
+			}
+			barrier();
+		}
+	};
+
+	std::vector<std::thread> threads;
+	for (i = 1; i < num_threads; i++) {
+		threads.emplace_back(worker, i);
+	}
+	worker(0);
+	for (auto& thread : threads) {
+		thread.join();
+	}
+}
@@ -0,0 +1,15 @@
+#ifndef __ACE_PARALLEL_H__
+#define __ACE_PARALLEL_H__
+
+#include "ace.h"
+
+typedef void (*ace_node_task_t)(Abc_Obj_t * obj, void * data);
+
+/* Calls task(obj, data) for the nodes of each level concurrently on
+ * num_threads threads, level after level, so that the fanins of a node are
+ * always evaluated before the node. The nodes are split among the threads
+ * in a fixed way, hence the results do not depend on thread scheduling. */
+void ace_parallel_for_levels(Vec_Ptr_t ** levels, int num_levels,
+		int num_threads, ace_node_task_t task, void * data);
+
+#endif
@@ -1,7 +1,11 @@
 #include "vtr_assert.h"
 
+#include <stdint.h>
+
 #include "ace.h"
 #include "sim.h"
+#include "depth.h"
+#include "parallel.h"
 
 #include "bdd/cudd/cudd.h"
 #include "bdd/cudd/cuddInt.h"
@@ -9,6 +13,8 @@
 void get_pi_values(Abc_Ntk_t * ntk, Vec_Ptr_t * nodes, int cycle);
 int * getFaninValues(Abc_Obj_t * obj_ptr);
 ace_status_t getFaninStatus(Abc_Obj_t * obj_ptr);
+void evaluate_node(Abc_Ntk_t * ntk, Abc_Obj_t * obj);
+void evaluate_node_task(Abc_Obj_t * obj, void * ntk);
 void evaluate_circuit(Abc_Ntk_t * ntk, Vec_Ptr_t * node_vec, int cycle);
 void update_FFs(Abc_Ntk_t * ntk);
 
@@ -177,78 +183,87 @@ ace_status_t getFaninStatus(Abc_Obj_t * obj_ptr) {
 	return ACE_OLD;
 }
 
-void evaluate_circuit(Abc_Ntk_t * ntk, Vec_Ptr_t * node_vec, int /*cycle*/) {
-	Abc_Obj_t * obj;
+void evaluate_node(Abc_Ntk_t * ntk, Abc_Obj_t * obj) {
 	Ace_Obj_Info_t * info;
-	int i;
 	int value = -1;
 	int * faninValues;
 	ace_status_t status;
 	DdNode * dd_node;
 
-	Vec_PtrForEachEntry(Abc_Obj_t*, node_vec, obj, i)
-	{
-		info = Ace_ObjInfo(obj);
+	info = Ace_ObjInfo(obj);
 
-		switch (Abc_ObjType(obj)) {
-		case ABC_OBJ_PI:
-		case ABC_OBJ_BO:
-			break;
+	switch (Abc_ObjType(obj)) {
+	case ABC_OBJ_PI:
+	case ABC_OBJ_BO:
+		break;
 
-		case ABC_OBJ_PO:
-		case ABC_OBJ_BI:
-		case ABC_OBJ_LATCH:
-		case ABC_OBJ_NODE:
-			status = getFaninStatus(obj);
-			switch (status) {
-			case ACE_UNDEF:
-				info->status = ACE_UNDEF;
-				break;
-			case ACE_OLD:
-				info->status = ACE_OLD;
-				info->num_ones += info->value;
-				break;
-			case ACE_NEW:
-				if (Abc_ObjIsNode(obj)) {
-					faninValues = getFaninValues(obj);
-					VTR_ASSERT(faninValues);
-					dd_node = Cudd_Eval((DdManager*) ntk->pManFunc, (DdNode*) obj->pData, faninValues);
-					VTR_ASSERT(Cudd_IsConstant(dd_node));
-					if (dd_node == Cudd_ReadOne((DdManager*) ntk->pManFunc)) {
-						value = 1;
-					} else if (dd_node == Cudd_ReadLogicZero((DdManager*) ntk->pManFunc)) {
-						value = 0;
-					} else {
-						VTR_ASSERT(0);
-					}
-					free(faninValues);
+	case ABC_OBJ_PO:
+	case ABC_OBJ_BI:
+	case ABC_OBJ_LATCH:
+	case ABC_OBJ_NODE:
+		status = getFaninStatus(obj);
+		switch (status) {
+		case ACE_UNDEF:
+			info->status = ACE_UNDEF;
+			break;
+		case ACE_OLD:
+			info->status = ACE_OLD;
+			info->num_ones += info->value;
+			break;
+		case ACE_NEW:
+			if (Abc_ObjIsNode(obj)) {
+				faninValues = getFaninValues(obj);
+				VTR_ASSERT(faninValues);
+				dd_node = Cudd_Eval((DdManager*) ntk->pManFunc, (DdNode*) obj->pData, faninValues);
+				VTR_ASSERT(Cudd_IsConstant(dd_node));
+				if (dd_node == Cudd_ReadOne((DdManager*) ntk->pManFunc)) {
+					value = 1;
+				} else if (dd_node == Cudd_ReadLogicZero((DdManager*) ntk->pManFunc)) {
+					value = 0;
 				} else {
-					Ace_Obj_Info_t * fanin_info = Ace_ObjInfo(
-							Abc_ObjFanin0(obj));
-					value = fanin_info->value;
+					VTR_ASSERT(0);
 				}
+				free(faninValues);
+			} else {
+				Ace_Obj_Info_t * fanin_info = Ace_ObjInfo(
+						Abc_ObjFanin0(obj));
+				value = fanin_info->value;
+			}
 
-				if (info->value != value || info->status == ACE_UNDEF) {
-					info->value = value;
-					if (info->status != ACE_UNDEF) {
-						/* Don't count the first value as a toggle */
-						info->num_toggles++;
-					}
-					info->status = ACE_NEW;
-				} else {
-					info->status = ACE_OLD;
+			if (info->value != value || info->status == ACE_UNDEF) {
+				info->value = value;
+				if (info->status != ACE_UNDEF) {
+					/* Don't count the first value as a toggle */
+					info->num_toggles++;
 				}
-				info->num_ones += info->value;
-				break;
-			default:
-				VTR_ASSERT(0);
-				break;
+				info->status = ACE_NEW;
+			} else {
+				info->status = ACE_OLD;
 			}
+			info->num_ones += info->value;
 			break;
 		default:
 			VTR_ASSERT(0);
 			break;
 		}
+		break;
+	default:
+		VTR_ASSERT(0);
+		break;
+	}
+}
+
+void evaluate_node_task(Abc_Obj_t * obj, void * ntk) {
+	evaluate_node((Abc_Ntk_t*) ntk, obj);
+}
+
+void evaluate_circuit(Abc_Ntk_t * ntk, Vec_Ptr_t * node_vec, int /*cycle*/) {
+	Abc_Obj_t * obj;
+	int i;
+
+	Vec_PtrForEachEntry(Abc_Obj_t*, node_vec, obj, i)
+	{
+		evaluate_node(ntk, obj);
 	}
 }
 
@@ -290,7 +305,7 @@ void update_FFs(Abc_Ntk_t * ntk) {
 }
 
 void ace_sim_activities(Abc_Ntk_t * ntk, Vec_Ptr_t * nodes, int max_cycles,
-		double threshold) {
+		double threshold, int depth, int num_threads) {
 	Abc_Obj_t * obj;
 	Ace_Obj_Info_t * info;
 	int i;
@@ -316,10 +331,24 @@ void ace_sim_activities(Abc_Ntk_t * ntk, Vec_Ptr_t * nodes, int max_cycles,
 	}
 
 	Vec_Ptr_t * logic_nodes = Abc_NtkDfs(ntk, TRUE);
-	for (i = 0; i < max_cycles; i++) {
-		get_pi_values(ntk, nodes, i);
-		evaluate_circuit(ntk, logic_nodes, i);
-		update_FFs(ntk);
+	if (num_threads > 1) {
+		/* The nodes of the same depth are evaluated concurrently, while
+		 * the primary inputs and the FFs are updated on a single thread
+		 * to keep the random input vectors the same */
+		Vec_Ptr_t ** levels = ace_levelize_nodes(logic_nodes, depth);
+		for (i = 0; i < max_cycles; i++) {
+			get_pi_values(ntk, nodes, i);
+			ace_parallel_for_levels(levels, depth + 1, num_threads,
+					evaluate_node_task, ntk);
+			update_FFs(ntk);
+		}
+		ace_free_levels(levels, depth);
+	} else {
+		for (i = 0; i < max_cycles; i++) {
+			get_pi_values(ntk, nodes, i);
+			evaluate_circuit(ntk, logic_nodes, i);
+			update_FFs(ntk);
+		}
 	}
 
 	//Vec_PtrForEachEntry(Abc_Obj_t *, nodes, obj, i)
@@ -338,3 +367,268 @@ void ace_sim_activities(Abc_Ntk_t * ntk, Vec_Ptr_t * nodes, int max_cycles,
 	}
     Vec_PtrFree(logic_nodes);
 }
+
+/*------------- Bit-parallel simulation ---------------------*/
+
+#define ACE_NUM_LANES 64
+
+/* A node of the BDD of a logic node, where ids index the node words of
+ * the function and id 0 is the constant one */
+typedef struct {
+	int fanin_id; /* Object id of the fanin which is the variable */
+	int then_id;
+	int then_compl;
+	int else_id;
+	int else_compl;
+} ace_packed_bdd_node_t;
+
+/* The BDD of a logic node flattened in topological order, so that it is
+ * evaluated on 64 vectors by a loop over its nodes */
+typedef struct {
+	int num_nodes;
+	ace_packed_bdd_node_t * nodes;
+	uint64_t * words; /* Value of each node, for the current vectors */
+	int root_id;
+	int root_compl;
+} ace_packed_func_t;
+
+typedef struct {
+	ace_packed_func_t ** funcs; /* Indexed by object id, NULL if not a logic node */
+	uint64_t * values;          /* Indexed by object id, one vector per lane */
+	int * num_ones;
+	int * num_toggles;
+	uint64_t lane_mask;
+	int step;
+} ace_packed_sim_t;
+
+int compile_bdd_node(DdManager * mgr, Abc_Obj_t * obj, DdNode * bdd,
+		ace_packed_func_t * func, st__table * visited);
+ace_packed_func_t * compile_packed_func(DdManager * mgr, Abc_Obj_t * obj);
+void free_packed_func(ace_packed_func_t * func);
+uint64_t evaluate_packed_func(ace_packed_func_t * func, const uint64_t * values);
+void evaluate_packed_node_task(Abc_Obj_t * obj, void * data);
+void get_packed_pi_values(Abc_Ntk_t * ntk, ace_packed_sim_t * sim,
+		int num_lanes, int num_steps);
+void update_packed_FFs(Abc_Ntk_t * ntk, ace_packed_sim_t * sim);
+
+/* Adds the regular node of bdd (and its descendants) to func, returning its id */
+int compile_bdd_node(DdManager * mgr, Abc_Obj_t * obj, DdNode * bdd,
+		ace_packed_func_t * func, st__table * visited) {
+	DdNode * node = Cudd_Regular(bdd);
+	char * id;
+	ace_packed_bdd_node_t bdd_node;
+
+	if (Cudd_IsConstant(node)) {
+		return 0;
+	}
+	if (st__lookup(visited, (char *) node, &id)) {
+		return (int) (intptr_t) id;
+	}
+
+	bdd_node.fanin_id = Abc_ObjId(Abc_ObjFanin(obj, node->index));
+	bdd_node.then_id = compile_bdd_node(mgr, obj, Cudd_T(node), func, visited);
+	bdd_node.then_compl = Cudd_IsComplement(Cudd_T(node));
+	bdd_node.else_id = compile_bdd_node(mgr, obj, Cudd_E(node), func, visited);
+	bdd_node.else_compl = Cudd_IsComplement(Cudd_E(node));
+
+	func->nodes[func->num_nodes] = bdd_node;
+	st__insert(visited, (char *) node, (char *) (intptr_t) func->num_nodes);
+	return func->num_nodes++;
+}
+
+ace_packed_func_t * compile_packed_func(DdManager * mgr, Abc_Obj_t * obj) {
+	DdNode * bdd = (DdNode*) obj->pData;
+	ace_packed_func_t * func;
+	st__table * visited;
+	int size;
+
+	VTR_ASSERT(Cudd_ReadOne(mgr) == Cudd_Regular(Cudd_ReadLogicZero(mgr)));
+
+	size = Cudd_DagSize(bdd);
+
+	func = (ace_packed_func_t*) malloc(sizeof(ace_packed_func_t));
+	func->nodes = (ace_packed_bdd_node_t*) malloc((size + 1) * sizeof(ace_packed_bdd_node_t));
+	func->num_nodes = 1;
+
+	visited = st__init_table(st__ptrcmp, st__ptrhash);
+	func->root_id = compile_bdd_node(mgr, obj, bdd, func, visited);
+	func->root_compl = Cudd_IsComplement(bdd);
+	st__free_table(visited);
+
+	VTR_ASSERT(func->num_nodes <= size + 1);
+	func->words = (uint64_t*) malloc(func->num_nodes * sizeof(uint64_t));
+	func->words[0] = ~(uint64_t) 0;
+
+	return func;
+}
+
+void free_packed_func(ace_packed_func_t * func) {
+	free(func->nodes);
+	free(func->words);
+	free(func);
+}
+
+uint64_t evaluate_packed_func(ace_packed_func_t * func, const uint64_t * values) {
+	int i;
+	uint64_t * words = func->words;
+
+	for (i = 1; i < func->num_nodes; i++) {
+		const ace_packed_bdd_node_t * node = &func->nodes[i];
+		uint64_t x = values[node->fanin_id];
+		uint64_t t = node->then_compl ? ~words[node->then_id] : words[node->then_id];
+		uint64_t e = node->else_compl ? ~words[node->else_id] : words[node->else_id];
+		words[i] = (x & t) | (~x & e);
+	}
+
+	return func->root_compl ? ~words[func->root_id] : words[func->root_id];
+}
+
+void evaluate_packed_node_task(Abc_Obj_t * obj, void * data) {
+	ace_packed_sim_t * sim = (ace_packed_sim_t*) data;
+	int id = Abc_ObjId(obj);
+	uint64_t value;
+
+	VTR_ASSERT(sim->funcs[id]);
+	value = evaluate_packed_func(sim->funcs[id], sim->values) & sim->lane_mask;
+
+	if (sim->step > 0) {
+		sim->num_toggles[id] += __builtin_popcountll(value ^ sim->values[id]);
+	}
+	sim->num_ones[id] += __builtin_popcountll(value);
+	sim->values[id] = value;
+}
+
+/* Draws the values of the primary inputs for the current step of each lane,
+ * where lane k simulates the cycles [k * num_steps, (k + 1) * num_steps) */
+void get_packed_pi_values(Abc_Ntk_t * ntk, ace_packed_sim_t * sim,
+		int num_lanes, int num_steps) {
+	Abc_Obj_t * obj;
+	Ace_Obj_Info_t * info;
+	int i, lane;
+	double prob0to1, prob1to0, rand_num;
+
+	Abc_NtkForEachPi(ntk, obj, i)
+	{
+		int id = Abc_ObjId(obj);
+		uint64_t old_value = sim->values[id];
+		uint64_t value = 0;
+
+		info = Ace_ObjInfo(obj);
+		prob0to1 = ACE_P0TO1(info->static_prob, info->switch_prob);
+		prob1to0 = ACE_P1TO0(info->static_prob, info->switch_prob);
+
+		for (lane = 0; lane < num_lanes; lane++) {
+			int bit;
+			if (info->values) {
+				bit = (info->values[lane * num_steps + sim->step] == 1);
+			} else {
+				//coverity[dont_call]
+				rand_num = (double) rand() / (double) RAND_MAX;
+				if (sim->step == 0 || ((old_value >> lane) & 1) == 0) {
+					bit = (rand_num < prob0to1);
+				} else {
+					bit = !(rand_num < prob1to0);
+				}
+			}
+			value |= (uint64_t) bit << lane;
+		}
+
+		if (sim->step > 0) {
+			sim->num_toggles[id] += __builtin_popcountll(value ^ old_value);
+		}
+		sim->num_ones[id] += __builtin_popcountll(value);
+		sim->values[id] = value;
+	}
+}
+
+void update_packed_FFs(Abc_Ntk_t * ntk, ace_packed_sim_t * sim) {
+	Abc_Obj_t * obj;
+	int i;
+
+	Abc_NtkForEachLatch(ntk, obj, i)
+	{
+		uint64_t value = sim->values[Abc_ObjId(Abc_ObjFanin0(Abc_ObjFanin0(obj)))];
+
+		sim->values[Abc_ObjId(Abc_ObjFanin0(obj))] = value;
+		sim->values[Abc_ObjId(obj)] = value;
+		sim->values[Abc_ObjId(Abc_ObjFanout0(obj))] = value;
+	}
+}
+
+void ace_sim_activities_packed(Abc_Ntk_t * ntk, int max_cycles, int depth,
+		int num_threads) {
+	Abc_Obj_t * obj;
+	Ace_Obj_Info_t * info;
+	ace_packed_sim_t sim;
+	int i;
+	int num_lanes, num_steps, num_vectors;
+	int num_objs = Abc_NtkObjNumMax(ntk);
+
+	VTR_ASSERT(max_cycles > 0);
+
+	/* The vectors are split into independent sequences, one per lane */
+	num_lanes = MIN(ACE_NUM_LANES, max_cycles);
+	num_steps = max_cycles / num_lanes;
+	num_vectors = num_lanes * num_steps;
+
+	sim.funcs = (ace_packed_func_t**) calloc(num_objs, sizeof(ace_packed_func_t*));
+	sim.values = (uint64_t*) calloc(num_objs, sizeof(uint64_t));
+	sim.num_ones = (int*) calloc(num_objs, sizeof(int));
+	sim.num_toggles = (int*) calloc(num_objs, sizeof(int));
+	sim.lane_mask = (num_lanes == ACE_NUM_LANES) ? ~(uint64_t) 0 : (((uint64_t) 1 << num_lanes) - 1);
+
+	Vec_Ptr_t * logic_nodes = Abc_NtkDfs(ntk, TRUE);
+	Vec_PtrForEachEntry(Abc_Obj_t*, logic_nodes, obj, i)
+	{
+		sim.funcs[Abc_ObjId(obj)] = compile_packed_func((DdManager*) ntk->pManFunc, obj);
+	}
+	Vec_Ptr_t ** levels = ace_levelize_nodes(logic_nodes, depth);
+
+	/* The FFs start at 0 in all the lanes */
+	for (sim.step = 0; sim.step < num_steps; sim.step++) {
+		get_packed_pi_values(ntk, &sim, num_lanes, num_steps);
+		ace_parallel_for_levels(levels, depth + 1, num_threads,
+				evaluate_packed_node_task, &sim);
+		update_packed_FFs(ntk, &sim);
+	}
+
+	/* Like update_FFs(), the FFs have the activities of their inputs */
+	Abc_NtkForEachLatch(ntk, obj, i)
+	{
+		int fanin_id = Abc_ObjId(Abc_ObjFanin0(Abc_ObjFanin0(obj)));
+		int ids[3] = {(int) Abc_ObjId(Abc_ObjFanin0(obj)), (int) Abc_ObjId(obj),
+				(int) Abc_ObjId(Abc_ObjFanout0(obj))};
+		for (int j = 0; j < 3; j++) {
+			sim.num_ones[ids[j]] = sim.num_ones[fanin_id];
+			sim.num_toggles[ids[j]] = sim.num_toggles[fanin_id];
+		}
+	}
+
+	Abc_NtkForEachObj(ntk, obj, i)
+	{
+		info = Ace_ObjInfo(obj);
+		info->num_ones = sim.num_ones[Abc_ObjId(obj)];
+		info->num_toggles = sim.num_toggles[Abc_ObjId(obj)];
+
+		info->static_prob = info->num_ones / (double) num_vectors;
+		VTR_ASSERT(info->static_prob >= 0.0 && info->static_prob <= 1.0);
+		info->switch_prob = info->num_toggles / (double) num_vectors;
+		VTR_ASSERT(info->switch_prob >= 0.0 && info->switch_prob <= 1.0);
+
+		VTR_ASSERT(info->switch_prob - EPSILON <= 2.0 * (1.0 - info->static_prob));
+		VTR_ASSERT(info->switch_prob - EPSILON <= 2.0 * (info->static_prob));
+
+		info->status = ACE_SIM;
+	}
+
+	ace_free_levels(levels, depth);
+	Vec_PtrForEachEntry(Abc_Obj_t*, logic_nodes, obj, i)
+	{
+		free_packed_func(sim.funcs[Abc_ObjId(obj)]);
+	}
+	Vec_PtrFree(logic_nodes);
+	free(sim.funcs);
+	free(sim.values);
+	free(sim.num_ones);
+	free(sim.num_toggles);
+}
@@ -3,7 +3,14 @@
 
 #include "ace.h"
 
+/* With num_threads > 1, the nodes of the same depth (up to depth) are
+ * evaluated concurrently in each cycle */
 void ace_sim_activities(Abc_Ntk_t * ntk, Vec_Ptr_t * node_vec, int max_cycles,
-		double threshold);
+		double threshold, int depth, int num_threads);
+
+/* Bit-parallel simulation, which evaluates the BDDs of the nodes on 64
+ * independent sequences of vectors at once, each of max_cycles / 64 cycles */
+void ace_sim_activities_packed(Abc_Ntk_t * ntk, int max_cycles, int depth,
+		int num_threads);
 
 #endif
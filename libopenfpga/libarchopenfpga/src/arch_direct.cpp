@@ -1,6 +1,7 @@
 #include "vtr_assert.h"
 
 #include "arch_direct.h"
+#include "openfpga_binary_io.h"
 
 /************************************************************************
  * Member functions for class ArchDirect
@@ -110,3 +111,16 @@ void ArchDirect::set_direction(const ArchDirectId& direct_id,
 bool ArchDirect::valid_direct_id(const ArchDirectId& direct_id) const {
   return ( size_t(direct_id) < direct_ids_.size() ) && ( direct_id == direct_ids_[direct_id] ); 
 }
+
+/************************************************************************
+ * Public Mutators: serialization
+ ***********************************************************************/
+template <class Archive>
+void ArchDirect::serialize(Archive& archive) {
+  archive(direct_ids_, names_, circuit_models_, types_, directions_,
+          direct_name2ids_);
+}
+
+/* Only the binary archives are used to serialize the data */
+template void ArchDirect::serialize(openfpga::BinaryWriter& archive);
+template void ArchDirect::serialize(openfpga::BinaryReader& archive);
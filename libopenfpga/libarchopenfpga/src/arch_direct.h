@@ -74,6 +74,10 @@ class ArchDirect {
                        const e_direct_direction& y_dir);
   public: /* Public invalidators/validators */
     bool valid_direct_id(const ArchDirectId& direct_id) const;
+  public: /* Public Mutators: serialization */
+    /* Write or read all the internal data with an archive of openfpga_binary_io.h */
+    template <class Archive>
+    void serialize(Archive& archive);
   private: /* Internal data */
     vtr::vector<ArchDirectId, ArchDirectId> direct_ids_;
     
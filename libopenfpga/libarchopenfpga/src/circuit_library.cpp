@@ -6,6 +6,8 @@
 
 #include "openfpga_port_parser.h"
 #include "circuit_library.h"
+#include "openfpga_binary_io.h"
+#include "openfpga_hot_path_counters.h"
 
 /************************************************************************
  * Member functions for class CircuitLibrary
@@ -545,21 +547,14 @@ float CircuitLibrary::rram_wprog_reset_nmos(const CircuitModelId& model_id) cons
 CircuitPortId CircuitLibrary::model_port(const CircuitModelId& model_id, const std::string& name) const {
   /* validate the model_id */
   VTR_ASSERT(valid_model_id(model_id));
-  /* Walk through the ports and try to find a matched name */
-  CircuitPortId ret = CircuitPortId::INVALID();
-  size_t num_found = 0;
-  for (auto model_ports_by_type : model_port_lookup_[model_id]) {
-    for (auto port_id : model_ports_by_type) {
-      if (0 != name.compare(port_prefix(port_id))) {
-        continue; /* Not the one, go to the next*/
-      }
-      ret = port_id; /* Find one */
-      num_found++;
-    }
+  /* Search the fast look-up by names */
+  const auto& result = model_port_name_lookup_[model_id].find(name);
+  if (result == model_port_name_lookup_[model_id].end()) {
+    return CircuitPortId::INVALID();
   }
   /* Make sure we will not find two ports with the same name */
-  VTR_ASSERT( (0 == num_found) || (1 == num_found) );
-  return ret;
+  VTR_ASSERT(1 == result->second.size());
+  return result->second.front();
 }
 
 /* Access the type of a port of a circuit model */
@@ -760,39 +755,28 @@ std::vector<CircuitPortId> CircuitLibrary::model_global_ports_by_type(const Circ
 }
 
 /* Find the ports of a circuit model by a given type, return a list of qualified ports */
-std::vector<CircuitPortId> CircuitLibrary::model_ports_by_type(const CircuitModelId& model_id, 
-                                                               const enum e_circuit_model_port_type& type) const {
-  std::vector<CircuitPortId> port_ids;
-  for (const auto& port_id : model_ports(model_id)) {
-    /* We skip unmatched ports */
-    if ( type != port_type(port_id) ) {
-      continue; 
-    }
-    port_ids.push_back(port_id);
-  } 
-  return port_ids;
+const std::vector<CircuitPortId>& CircuitLibrary::model_ports_by_type(const CircuitModelId& model_id, 
+                                                                      const enum e_circuit_model_port_type& type) const {
+  /* validate the model_id */
+  VTR_ASSERT(valid_model_id(model_id));
+  VTR_ASSERT(type < model_port_lookup_[model_id].size());
+  return model_port_lookup_[model_id][type];
 }
 
 /* Find the ports of a circuit model by a given type, return a list of qualified ports 
  * with an option to include/exclude global ports
+ * Note: I/O port should be kept, as they are not global ports
  */
-std::vector<CircuitPortId> CircuitLibrary::model_ports_by_type(const CircuitModelId& model_id, 
-                                                               const enum e_circuit_model_port_type& type,
-                                                               const bool& ignore_global_port) const {
-  std::vector<CircuitPortId> port_ids;
-  for (const auto& port_id : model_port_lookup_[model_id][type]) {
-    /* We skip unmatched ports */
-    if ( type != port_type(port_id) ) {
-      continue; 
-    }
-    /* We skip global ports if specified. Note: I/O port should be kept */
-    if ( (true == ignore_global_port)
-      && (true == port_is_global(port_id)) ) {
-      continue; 
-    }
-    port_ids.push_back(port_id);
-  } 
-  return port_ids;
+const std::vector<CircuitPortId>& CircuitLibrary::model_ports_by_type(const CircuitModelId& model_id, 
+                                                                      const enum e_circuit_model_port_type& type,
+                                                                      const bool& ignore_global_port) const {
+  if (false == ignore_global_port) {
+    return model_ports_by_type(model_id, type);
+  }
+  /* validate the model_id */
+  VTR_ASSERT(valid_model_id(model_id));
+  VTR_ASSERT(type < model_non_global_port_lookup_[model_id].size());
+  return model_non_global_port_lookup_[model_id][type];
 }
 
 /* Create a vector for all the ports whose directionality is input
@@ -1082,23 +1066,16 @@ CircuitModelId CircuitLibrary::model(const char* name) const {
 
 /* Find a circuit model by a given name and return its id */
 CircuitModelId CircuitLibrary::model(const std::string& name) const { 
-  CircuitModelId ret = CircuitModelId::INVALID();
-  size_t num_found = 0;
-  for (circuit_model_string_iterator it = model_names_.begin();
-       it != model_names_.end();
-       it++) {
-    /* Bypass unmatched names */
-    if ( 0 != name.compare(*it) ) {
-      continue;
-    }
-    /* Find one and record it 
-     * FIXME: I feel that we may have a better way in getting the CircuitModelId
-     */
-    ret = CircuitModelId(it - model_names_.begin()); 
-    num_found++;
+  OPENFPGA_COUNT_HOT_PATH_CALL(HOT_PATH_CIRCUIT_MODEL);
+  /* Search the fast look-up by names */
+  const auto& result = model_name_lookup_.find(name);
+  if (result == model_name_lookup_.end()) {
+    return CircuitModelId::INVALID();
   }
-  VTR_ASSERT((0 == num_found) || (1 == num_found));
-  return ret;
+  /* Make sure we will not find two models with the same name */
+  VTR_ASSERT(1 == result->second.size());
+  OPENFPGA_COUNT_HOT_PATH_HIT(HOT_PATH_CIRCUIT_MODEL);
+  return result->second.front();
 }
 
 /* Get the CircuitModelId of a default circuit model with a given type */
@@ -1223,6 +1200,12 @@ CircuitModelId CircuitLibrary::add_model(const enum e_circuit_model_type& type)
    */
   model_port_lookup_.resize(model_ids_.size());
   model_port_lookup_[model_id].resize(NUM_CIRCUIT_MODEL_PORT_TYPES);
+  model_non_global_port_lookup_.resize(model_ids_.size());
+  model_non_global_port_lookup_[model_id].resize(NUM_CIRCUIT_MODEL_PORT_TYPES);
+
+  /* Register the empty name in the fast look-up by names */
+  model_port_name_lookup_.emplace_back();
+  model_name_lookup_[model_names_[model_id]].push_back(model_id);
 
   return model_id;
 }
@@ -1231,7 +1214,9 @@ CircuitModelId CircuitLibrary::add_model(const enum e_circuit_model_type& type)
 void CircuitLibrary::set_model_name(const CircuitModelId& model_id, const std::string& name) {
   /* validate the model_id */
   VTR_ASSERT(valid_model_id(model_id));
+  std::string old_name = model_names_[model_id];
   model_names_[model_id] = name;
+  update_model_name_lookup(model_id, old_name);
   return;
 }
 
@@ -1415,8 +1400,13 @@ CircuitPortId CircuitLibrary::add_model_port(const CircuitModelId& model_id,
   port_in_edge_ids_.emplace_back();
   port_out_edge_ids_.emplace_back();
  
-  /* Build the fast look-up for circuit model ports */
-  build_model_port_lookup();
+  /* Update the fast look-up for circuit model ports
+   * Port ids are created in an increasing order, so the look-up remains sorted
+   */
+  model_port_lookup_[model_id][port_type].push_back(circuit_port_id);
+  /* A port is not global by default */
+  model_non_global_port_lookup_[model_id][port_type].push_back(circuit_port_id);
+  model_port_name_lookup_[model_id][port_prefix_[circuit_port_id]].push_back(circuit_port_id);
 
   return circuit_port_id;
 }
@@ -1435,7 +1425,9 @@ void CircuitLibrary::set_port_prefix(const CircuitPortId& circuit_port_id,
                                      const std::string& port_prefix) {
   /* validate the circuit_port_id */
   VTR_ASSERT(valid_circuit_port_id(circuit_port_id));
+  std::string old_prefix = port_prefix_[circuit_port_id];
   port_prefix_[circuit_port_id] = port_prefix;
+  update_model_port_name_lookup(circuit_port_id, old_prefix);
   return;
 }
 
@@ -1498,7 +1490,20 @@ void CircuitLibrary::set_port_is_global(const CircuitPortId& circuit_port_id,
                                         const bool& is_global) {
   /* validate the circuit_port_id */
   VTR_ASSERT(valid_circuit_port_id(circuit_port_id));
+  if (is_global == port_is_global_[circuit_port_id]) {
+    return;
+  }
   port_is_global_[circuit_port_id] = is_global;
+
+  /* Update the fast look-up of non-global ports, which should remain sorted */
+  std::vector<CircuitPortId>& non_global_ports = model_non_global_port_lookup_[port_model_ids_[circuit_port_id]][port_types_[circuit_port_id]];
+  auto it = std::lower_bound(non_global_ports.begin(), non_global_ports.end(), circuit_port_id);
+  if (true == is_global) {
+    VTR_ASSERT((it != non_global_ports.end()) && (circuit_port_id == *it));
+    non_global_ports.erase(it);
+  } else {
+    non_global_ports.insert(it, circuit_port_id);
+  }
   return;
 }
 
@@ -2370,17 +2375,46 @@ void CircuitLibrary::build_model_port_lookup() {
   invalidate_model_port_lookup();
   /* Classify circuit models by type */
   model_port_lookup_.resize(model_ids_.size());
+  model_non_global_port_lookup_.resize(model_ids_.size());
   for (const auto& model_id : model_ids_) {
     model_port_lookup_[model_id].resize(NUM_CIRCUIT_MODEL_PORT_TYPES);
+    model_non_global_port_lookup_[model_id].resize(NUM_CIRCUIT_MODEL_PORT_TYPES);
   }
   /* Walk through models and categorize */
   for (const auto& port : port_ids_) {
     CircuitModelId model_id = port_model_ids_[port];
     model_port_lookup_[model_id][port_type(port)].push_back(port);
+    if (false == port_is_global(port)) {
+      model_non_global_port_lookup_[model_id][port_type(port)].push_back(port);
+    }
   }
   return;
 }
 
+/************************************************************************
+ * Internal mutators: update fast look-ups by names
+ ***********************************************************************/
+/* Move a circuit model from its old name to its current name in the fast look-up */
+void CircuitLibrary::update_model_name_lookup(const CircuitModelId& model_id, const std::string& old_name) {
+  std::vector<CircuitModelId>& old_models = model_name_lookup_[old_name];
+  old_models.erase(std::find(old_models.begin(), old_models.end(), model_id));
+  if (true == old_models.empty()) {
+    model_name_lookup_.erase(old_name);
+  }
+  model_name_lookup_[model_names_[model_id]].push_back(model_id);
+}
+
+/* Move a circuit port from its old prefix to its current prefix in the fast look-up */
+void CircuitLibrary::update_model_port_name_lookup(const CircuitPortId& circuit_port_id, const std::string& old_prefix) {
+  std::unordered_map<std::string, std::vector<CircuitPortId>>& port_name_lookup = model_port_name_lookup_[port_model_ids_[circuit_port_id]];
+  std::vector<CircuitPortId>& old_ports = port_name_lookup[old_prefix];
+  old_ports.erase(std::find(old_ports.begin(), old_ports.end(), circuit_port_id));
+  if (true == old_ports.empty()) {
+    port_name_lookup.erase(old_prefix);
+  }
+  port_name_lookup[port_prefix_[circuit_port_id]].push_back(circuit_port_id);
+}
+
 /************************************************************************
  * Internal invalidators/validators 
  ***********************************************************************/
@@ -2436,6 +2470,7 @@ void CircuitLibrary::invalidate_model_lookup() const {
 /* Empty fast lookup for circuit ports for a model */
 void CircuitLibrary::invalidate_model_port_lookup() const {
   model_port_lookup_.clear();
+  model_non_global_port_lookup_.clear();
   return;
 }
 
@@ -2458,6 +2493,44 @@ void CircuitLibrary::invalidate_model_timing_graph() {
   return;
 }
 
+/************************************************************************
+ * Public Mutators: serialization
+ ***********************************************************************/
+template <class Archive>
+void CircuitLibrary::serialize(Archive& archive) {
+  archive(model_ids_, model_types_, model_names_, model_prefix_,
+          model_verilog_netlists_, model_spice_netlists_, model_is_default_,
+          sub_models_, model_lookup_, model_port_lookup_,
+          model_non_global_port_lookup_, model_name_lookup_,
+          model_port_name_lookup_, dump_structural_verilog_,
+          dump_explicit_port_map_, design_tech_types_, is_power_gated_,
+          device_model_names_, buffer_existence_, buffer_model_names_,
+          buffer_model_ids_, buffer_location_maps_,
+          pass_gate_logic_model_names_, pass_gate_logic_model_ids_, port_ids_,
+          port_model_ids_, port_types_, port_sizes_, port_prefix_,
+          port_lib_names_, port_inv_prefix_, port_default_values_, port_is_io_,
+          port_is_data_io_, port_is_mode_select_, port_is_global_,
+          port_is_reset_, port_is_set_, port_is_config_enable_, port_is_prog_,
+          port_tri_state_model_names_, port_tri_state_model_ids_,
+          port_inv_model_names_, port_inv_model_ids_, port_tri_state_maps_,
+          port_lut_frac_level_, port_is_harden_lut_port_,
+          port_lut_output_masks_, port_sram_orgz_, edge_ids_,
+          edge_parent_model_ids_, port_in_edge_ids_, port_out_edge_ids_,
+          edge_src_port_ids_, edge_src_pin_ids_, edge_sink_port_ids_,
+          edge_sink_pin_ids_, edge_timing_info_, delay_types_,
+          delay_in_port_names_, delay_out_port_names_, delay_values_,
+          buffer_types_, buffer_sizes_, buffer_num_levels_,
+          buffer_f_per_stage_, pass_gate_logic_types_, pass_gate_logic_sizes_,
+          mux_structure_, mux_num_levels_, mux_const_input_values_,
+          mux_use_local_encoder_, mux_use_advanced_rram_design_,
+          lut_is_fracturable_, gate_types_, rram_res_, wprog_set_,
+          wprog_reset_, wire_types_, wire_rc_, wire_num_levels_);
+}
+
+/* Only the binary archives are used to serialize the data */
+template void CircuitLibrary::serialize(openfpga::BinaryWriter& archive);
+template void CircuitLibrary::serialize(openfpga::BinaryReader& archive);
+
 /************************************************************************
  * End of file : circuit_library.cpp 
  ***********************************************************************/
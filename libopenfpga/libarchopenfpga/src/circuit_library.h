@@ -13,6 +13,7 @@
 /* Header files should be included in a sequence */
 /* Standard header files required go first */
 #include <string>
+#include <unordered_map>
 
 #include "vtr_geometry.h"
 
@@ -266,8 +267,11 @@ class CircuitLibrary {
                                                           const bool& recursive,
                                                           const bool& ignore_config_memories) const;
 
-    std::vector<CircuitPortId> model_ports_by_type(const CircuitModelId& model_id, const enum e_circuit_model_port_type& port_type) const;
-    std::vector<CircuitPortId> model_ports_by_type(const CircuitModelId& model_id, const enum e_circuit_model_port_type& port_type, const bool& include_global_port) const;
+    /* The ports by type are partitioned once when the ports are added,
+     * so that netlist writers can query them repeatedly without any copy
+     */
+    const std::vector<CircuitPortId>& model_ports_by_type(const CircuitModelId& model_id, const enum e_circuit_model_port_type& port_type) const;
+    const std::vector<CircuitPortId>& model_ports_by_type(const CircuitModelId& model_id, const enum e_circuit_model_port_type& port_type, const bool& include_global_port) const;
     std::vector<CircuitPortId> model_input_ports(const CircuitModelId& model_id) const;
     std::vector<CircuitPortId> model_output_ports(const CircuitModelId& model_id) const;
     std::vector<size_t> pins(const CircuitPortId& circuit_port_id) const;
@@ -490,6 +494,9 @@ class CircuitLibrary {
     bool valid_model_id(const CircuitModelId& model_id) const;
     bool valid_circuit_port_id(const CircuitPortId& circuit_port_id) const;
     bool valid_circuit_pin_id(const CircuitPortId& circuit_port_id, const size_t& pin_id) const;
+  private: /* Internal mutators: update fast look-ups by names */
+    void update_model_name_lookup(const CircuitModelId& model_id, const std::string& old_name);
+    void update_model_port_name_lookup(const CircuitPortId& circuit_port_id, const std::string& old_prefix);
   private: /* Internal invalidators/validators */
     /* Validators */
     bool valid_edge_id(const CircuitEdgeId& edge_id) const;
@@ -500,6 +507,10 @@ class CircuitLibrary {
     void invalidate_model_lookup() const;
     void invalidate_model_port_lookup() const;
     void invalidate_model_timing_graph();
+  public: /* Public Mutators: serialization */
+    /* Write or read all the internal data with an archive of openfpga_binary_io.h */
+    template <class Archive>
+    void serialize(Archive& archive);
   private: /* Internal data */
     /* Fundamental information */
     vtr::vector<CircuitModelId, CircuitModelId> model_ids_;
@@ -521,6 +532,14 @@ class CircuitLibrary {
     mutable CircuitModelLookup model_lookup_; /* [model_type][model_ids] */
     typedef vtr::vector<CircuitModelId, std::vector<std::vector<CircuitPortId>>> CircuitModelPortLookup;
     mutable CircuitModelPortLookup model_port_lookup_; /* [model_id][port_type][port_ids] */
+    mutable CircuitModelPortLookup model_non_global_port_lookup_; /* [model_id][port_type][port_ids], excluding global ports */
+
+    /* fast look-up for circuit models and ports by names, which are updated whenever a name is set
+     * Models (ports) with the same name are all stored, so that duplicated names can be detected
+     * in searching without walking through all the names
+     */
+    std::unordered_map<std::string, std::vector<CircuitModelId>> model_name_lookup_; /* [model_name][model_ids] */
+    vtr::vector<CircuitModelId, std::unordered_map<std::string, std::vector<CircuitPortId>>> model_port_name_lookup_; /* [model_id][port_prefix][port_ids] */
 
     /* Verilog generator options */ 
     vtr::vector<CircuitModelId, bool> dump_structural_verilog_;
@@ -131,4 +131,32 @@ enum e_config_protocol_type {
 
 constexpr std::array<const char*, NUM_CONFIG_PROTOCOL_TYPES> CONFIG_PROTOCOL_TYPE_STRING = {{"standalone", "scan_chain", "memory_bank", "frame_based"}};
 
+/********************************************************************
+ * Types of circuits driving the Bit-Lines (BLs) of memory banks
+ * 1. BLs are driven by a decoder, so that a memory cell is programmed per cycle
+ * 2. BLs are driven by a shift register, so that a Word-Line (WL) of
+ *    memory cells is programmed per cycle
+ */
+enum e_blwl_protocol_type {
+  BLWL_PROTOCOL_DECODER,
+  BLWL_PROTOCOL_SHIFT_REGISTER,
+  NUM_BLWL_PROTOCOL_TYPES
+};
+
+constexpr std::array<const char*, NUM_BLWL_PROTOCOL_TYPES> BLWL_PROTOCOL_TYPE_STRING = {{"decoder", "shift_register"}};
+
+/********************************************************************
+ * Types of compression applied to the bitstreams of configuration chains
+ * 1. No compression: the head of each chain is fed with a bit per cycle
+ * 2. Run-length compression: a decompressor at the head of each chain
+ *    expands a bit value and a run length into consecutive bits
+ */
+enum e_config_chain_compression_type {
+  CONFIG_CHAIN_COMPRESSION_NONE,
+  CONFIG_CHAIN_COMPRESSION_RUN_LENGTH,
+  NUM_CONFIG_CHAIN_COMPRESSION_TYPES
+};
+
+constexpr std::array<const char*, NUM_CONFIG_CHAIN_COMPRESSION_TYPES> CONFIG_CHAIN_COMPRESSION_TYPE_STRING = {{"none", "run_length"}};
+
 #endif
@@ -1,6 +1,7 @@
 #include "vtr_assert.h"
 
 #include "config_protocol.h"
+#include "openfpga_binary_io.h"
 
 /************************************************************************
  * Member functions for class ConfigProtocol
@@ -10,6 +11,11 @@
  * Constructors
  ***********************************************************************/
 ConfigProtocol::ConfigProtocol() {
+  balance_regions_ = false;
+  bl_protocol_type_ = BLWL_PROTOCOL_DECODER;
+  frame_data_width_ = 1;
+  chain_compression_type_ = CONFIG_CHAIN_COMPRESSION_NONE;
+  run_length_width_ = 4;
   return;
 }
 
@@ -32,6 +38,26 @@ int ConfigProtocol::num_regions() const {
   return num_regions_;
 }
 
+bool ConfigProtocol::balance_regions() const {
+  return balance_regions_;
+}
+
+e_blwl_protocol_type ConfigProtocol::bl_protocol_type() const {
+  return bl_protocol_type_;
+}
+
+size_t ConfigProtocol::frame_data_width() const {
+  return frame_data_width_;
+}
+
+e_config_chain_compression_type ConfigProtocol::chain_compression_type() const {
+  return chain_compression_type_;
+}
+
+size_t ConfigProtocol::run_length_width() const {
+  return run_length_width_;
+}
+
 /************************************************************************
  * Public Mutators
  ***********************************************************************/
@@ -50,3 +76,38 @@ void ConfigProtocol::set_memory_model(const CircuitModelId& memory_model) {
 void ConfigProtocol::set_num_regions(const int& num_regions) {
   num_regions_ = num_regions;
 }
+
+void ConfigProtocol::set_balance_regions(const bool& balance_regions) {
+  balance_regions_ = balance_regions;
+}
+
+void ConfigProtocol::set_bl_protocol_type(const e_blwl_protocol_type& bl_protocol_type) {
+  bl_protocol_type_ = bl_protocol_type;
+}
+
+void ConfigProtocol::set_frame_data_width(const size_t& frame_data_width) {
+  VTR_ASSERT(0 < frame_data_width);
+  frame_data_width_ = frame_data_width;
+}
+
+void ConfigProtocol::set_chain_compression_type(const e_config_chain_compression_type& chain_compression_type) {
+  chain_compression_type_ = chain_compression_type;
+}
+
+void ConfigProtocol::set_run_length_width(const size_t& run_length_width) {
+  VTR_ASSERT(0 < run_length_width);
+  run_length_width_ = run_length_width;
+}
+
+/************************************************************************
+ * Public Mutators: serialization
+ ***********************************************************************/
+template <class Archive>
+void ConfigProtocol::serialize(Archive& archive) {
+  archive(type_, memory_model_name_, memory_model_, num_regions_, balance_regions_, bl_protocol_type_, frame_data_width_,
+          chain_compression_type_, run_length_width_);
+}
+
+/* Only the binary archives are used to serialize the data */
+template void ConfigProtocol::serialize(openfpga::BinaryWriter& archive);
+template void ConfigProtocol::serialize(openfpga::BinaryReader& archive);
@@ -16,11 +16,25 @@ class ConfigProtocol {
     std::string memory_model_name() const;
     CircuitModelId memory_model() const;
     int num_regions() const;
+    bool balance_regions() const;
+    e_blwl_protocol_type bl_protocol_type() const;
+    size_t frame_data_width() const;
+    e_config_chain_compression_type chain_compression_type() const;
+    size_t run_length_width() const;
   public: /* Public Mutators */
     void set_type(const e_config_protocol_type& type);
     void set_memory_model_name(const std::string& memory_model_name);
     void set_memory_model(const CircuitModelId& memory_model);
     void set_num_regions(const int& num_regions);
+    void set_balance_regions(const bool& balance_regions);
+    void set_bl_protocol_type(const e_blwl_protocol_type& bl_protocol_type);
+    void set_frame_data_width(const size_t& frame_data_width);
+    void set_chain_compression_type(const e_config_chain_compression_type& chain_compression_type);
+    void set_run_length_width(const size_t& run_length_width);
+  public: /* Public Mutators: serialization */
+    /* Write or read all the internal data with an archive of openfpga_binary_io.h */
+    template <class Archive>
+    void serialize(Archive& archive);
   private: /* Internal data */
     /* The type of configuration protocol. 
      * In other words, it is about how to organize and access each configurable memory 
@@ -33,6 +47,27 @@ class ConfigProtocol {
 
     /* Number of configurable regions */
     int num_regions_;
+
+    /* Split the fabric into regions with similar numbers of configuration bits,
+     * rather than similar numbers of configurable blocks
+     */
+    bool balance_regions_;
+
+    /* The circuit driving the Bit-Lines of memory banks */
+    e_blwl_protocol_type bl_protocol_type_;
+
+    /* Number of configuration bits loaded under each frame address,
+     * i.e., the width of the data input of each region for frame-based protocol
+     */
+    size_t frame_data_width_;
+
+    /* The compression of the bitstreams loaded to configuration chains */
+    e_config_chain_compression_type chain_compression_type_;
+
+    /* Number of bits of the run length given to the decompressor of each chain,
+     * i.e., a run includes up to 2^run_length_width bits
+     */
+    size_t run_length_width_;
 };
 
 #endif
@@ -0,0 +1,149 @@
+/********************************************************************
+ * This file includes functions to write and read a binary image of
+ * the OpenFPGA architecture data structures.
+ *
+ * The image is a cache of an OpenFPGA architecture XML file, which
+ * has been parsed and checked. It records a digest of the XML file
+ * and the build of OpenFPGA, and is considered stale when any of them
+ * changes. Loading the image skips parsing the XML
+ * as well as building the links, lookups and timing graphs.
+ *******************************************************************/
+#include <fstream>
+
+/* Headers from vtrutil library */
+#include "vtr_digest.h"
+#include "vtr_log.h"
+#include "vtr_time.h"
+
+/* Headers from openfpgautil library */
+#include "openfpga_binary_io.h"
+#include "openfpga_version.h"
+
+#include "openfpga_arch_image.h"
+
+/* Increase the number when the contents of the image change */
+constexpr uint32_t OPENFPGA_ARCH_IMAGE_VERSION = 6;
+constexpr const char* OPENFPGA_ARCH_IMAGE_MAGIC = "OpenFPGA architecture image";
+
+/********************************************************************
+ * Serialize all the data structures of an OpenFPGA architecture
+ * in the same sequence for both writing and reading
+ *******************************************************************/
+template <class Archive>
+static void serialize_openfpga_arch(Archive& archive,
+                                    openfpga::Arch& openfpga_arch) {
+  archive(openfpga_arch.circuit_lib,
+          openfpga_arch.tech_lib,
+          openfpga_arch.circuit_tech_binding,
+          openfpga_arch.config_protocol,
+          openfpga_arch.cb_switch2circuit,
+          openfpga_arch.sb_switch2circuit,
+          openfpga_arch.routing_seg2circuit,
+          openfpga_arch.arch_direct,
+          openfpga_arch.tile_annotations,
+          openfpga_arch.pb_type_annotations);
+}
+
+/********************************************************************
+ * The header of an image identifies the source XML and the build of OpenFPGA.
+ * An image created by another build may have a different memory layout
+ *******************************************************************/
+template <class Archive>
+static void serialize_openfpga_arch_image_header(Archive& archive,
+                                                 std::string& magic,
+                                                 uint32_t& version,
+                                                 std::string& build,
+                                                 std::string& arch_digest) {
+  archive(magic, version, build, arch_digest);
+}
+
+static std::string openfpga_arch_image_build() {
+  return std::string(openfpga::VERSION) + " " + std::string(openfpga::BUILD_TIMESTAMP);
+}
+
+/********************************************************************
+ * Load an OpenFPGA architecture from a binary image,
+ * if the image is up-to-date with the architecture XML file.
+ * Return false if the image does not exist, is stale or corrupted,
+ * in which case the architecture XML file should be parsed again
+ *******************************************************************/
+bool read_openfpga_arch_image(const char* image_file_name,
+                              const char* arch_file_name,
+                              openfpga::Arch& openfpga_arch) {
+  vtr::ScopedStartFinishTimer timer("Read OpenFPGA architecture image");
+
+  std::ifstream fp(image_file_name, std::ios::in | std::ios::binary);
+  if (false == fp.good()) {
+    VTR_LOG("No architecture image '%s' found\n",
+            image_file_name);
+    return false;
+  }
+
+  openfpga::BinaryReader reader(fp);
+
+  std::string magic;
+  uint32_t version = 0;
+  std::string build;
+  std::string arch_digest;
+  serialize_openfpga_arch_image_header(reader, magic, version, build, arch_digest);
+
+  if ( (false == reader.good())
+    || (std::string(OPENFPGA_ARCH_IMAGE_MAGIC) != magic)
+    || (OPENFPGA_ARCH_IMAGE_VERSION != version)
+    || (openfpga_arch_image_build() != build)) {
+    VTR_LOG("Architecture image '%s' was created by another version of OpenFPGA\n",
+            image_file_name);
+    return false;
+  }
+
+  if (vtr::secure_digest_file(std::string(arch_file_name)) != arch_digest) {
+    VTR_LOG("Architecture image '%s' is outdated by '%s'\n",
+            image_file_name, arch_file_name);
+    return false;
+  }
+
+  openfpga::Arch image_arch;
+  serialize_openfpga_arch(reader, image_arch);
+  if (false == reader.good()) {
+    VTR_LOG("Architecture image '%s' is corrupted\n",
+            image_file_name);
+    return false;
+  }
+
+  openfpga_arch = std::move(image_arch);
+
+  return true;
+}
+
+/********************************************************************
+ * Write an OpenFPGA architecture to a binary image,
+ * which is bound to the architecture XML file it is built from
+ *******************************************************************/
+void write_openfpga_arch_image(const char* image_file_name,
+                               const char* arch_file_name,
+                               const openfpga::Arch& openfpga_arch) {
+  vtr::ScopedStartFinishTimer timer("Write OpenFPGA architecture image");
+
+  std::ofstream fp(image_file_name, std::ios::out | std::ios::trunc | std::ios::binary);
+  if (false == fp.good()) {
+    VTR_LOG_WARN("Unable to write architecture image '%s'\n",
+                 image_file_name);
+    return;
+  }
+
+  openfpga::BinaryWriter writer(fp);
+
+  std::string magic(OPENFPGA_ARCH_IMAGE_MAGIC);
+  uint32_t version = OPENFPGA_ARCH_IMAGE_VERSION;
+  std::string build = openfpga_arch_image_build();
+  std::string arch_digest = vtr::secure_digest_file(std::string(arch_file_name));
+  serialize_openfpga_arch_image_header(writer, magic, version, build, arch_digest);
+
+  /* The data is not modified when writing */
+  serialize_openfpga_arch(writer, const_cast<openfpga::Arch&>(openfpga_arch));
+
+  if (false == writer.good()) {
+    VTR_LOG_WARN("Failed in writing architecture image '%s'\n",
+                 image_file_name);
+  }
+}
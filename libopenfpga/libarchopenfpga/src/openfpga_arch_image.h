@@ -0,0 +1,21 @@
+#ifndef OPENFPGA_ARCH_IMAGE_H
+#define OPENFPGA_ARCH_IMAGE_H
+
+/********************************************************************
+ * Include header files that are required by function declaration
+ *******************************************************************/
+#include <string>
+#include "openfpga_arch.h"
+
+/********************************************************************
+ * Function declaration
+ *******************************************************************/
+bool read_openfpga_arch_image(const char* image_file_name,
+                              const char* arch_file_name,
+                              openfpga::Arch& openfpga_arch);
+
+void write_openfpga_arch_image(const char* image_file_name,
+                               const char* arch_file_name,
+                               const openfpga::Arch& openfpga_arch);
+
+#endif
@@ -5,6 +5,7 @@
 #include "vtr_log.h"
 #include "vtr_assert.h"
 #include "pb_type_annotation.h"
+#include "openfpga_binary_io.h"
 
 /* namespace openfpga begins */
 namespace openfpga {
@@ -242,4 +243,22 @@ void PbTypeAnnotation::add_interconnect_circuit_model_pair(const std::string& in
   interconnect_circuit_model_names_[interc_name] = circuit_model_name;
 }
 
+/************************************************************************
+ * Public Mutators: serialization
+ ***********************************************************************/
+template <class Archive>
+void PbTypeAnnotation::serialize(Archive& archive) {
+  archive(operating_pb_type_name_, operating_parent_pb_type_names_,
+          operating_parent_mode_names_, physical_pb_type_name_,
+          physical_parent_pb_type_names_, physical_parent_mode_names_,
+          physical_mode_name_, idle_mode_name_, mode_bits_,
+          circuit_model_name_, physical_pb_type_index_factor_,
+          physical_pb_type_index_offset_, operating_pb_type_ports_,
+          interconnect_circuit_model_names_);
+}
+
+/* Only the binary archives are used to serialize the data */
+template void PbTypeAnnotation::serialize(BinaryWriter& archive);
+template void PbTypeAnnotation::serialize(BinaryReader& archive);
+
 } /* namespace openfpga ends */
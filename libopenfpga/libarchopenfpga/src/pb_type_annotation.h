@@ -75,6 +75,10 @@ class PbTypeAnnotation {
                                         const int& physical_pin_rotate_offset);
     void add_interconnect_circuit_model_pair(const std::string& interc_name,
                                              const std::string& circuit_model_name);
+  public: /* Public Mutators: serialization */
+    /* Write or read all the internal data with an archive of openfpga_binary_io.h */
+    template <class Archive>
+    void serialize(Archive& archive);
   private: /* Internal data */
     /* Binding between physical pb_type and operating pb_type 
      * both operating and physial pb_type names contain the full names 
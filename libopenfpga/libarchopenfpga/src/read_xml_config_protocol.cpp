@@ -33,6 +33,36 @@ e_config_protocol_type string_to_config_protocol_type(const std::string& type_st
   return NUM_CONFIG_PROTOCOL_TYPES;
 }
 
+/********************************************************************
+ * Convert string to the enumerate of BL/WL protocol type
+ *******************************************************************/
+static 
+e_blwl_protocol_type string_to_blwl_protocol_type(const std::string& type_string) {
+  
+  for (size_t itype = 0; itype < NUM_BLWL_PROTOCOL_TYPES; ++itype) {
+    if (std::string(BLWL_PROTOCOL_TYPE_STRING[itype]) == type_string) {
+      return static_cast<e_blwl_protocol_type>(itype); 
+    }
+  }
+
+  return NUM_BLWL_PROTOCOL_TYPES;
+}
+
+/********************************************************************
+ * Convert string to the enumerate of configuration chain compression type
+ *******************************************************************/
+static 
+e_config_chain_compression_type string_to_config_chain_compression_type(const std::string& type_string) {
+  
+  for (size_t itype = 0; itype < NUM_CONFIG_CHAIN_COMPRESSION_TYPES; ++itype) {
+    if (std::string(CONFIG_CHAIN_COMPRESSION_TYPE_STRING[itype]) == type_string) {
+      return static_cast<e_config_chain_compression_type>(itype); 
+    }
+  }
+
+  return NUM_CONFIG_CHAIN_COMPRESSION_TYPES;
+}
+
 /********************************************************************
  * Parse XML codes of a <organization> to an object of configuration protocol
  *******************************************************************/
@@ -65,6 +95,83 @@ void read_xml_config_organization(pugi::xml_node& xml_config_orgz,
                    "Invalid 'num_region=%d' definition. At least 1 region should be defined!\n",
                    config_protocol.num_regions());
   }
+
+  /* Parse if the regions should be balanced by their numbers of configuration bits */
+  config_protocol.set_balance_regions(get_attribute(xml_config_orgz, "balance_regions", loc_data, pugiutil::ReqOpt::OPTIONAL).as_bool(false));
+  if ( (true == config_protocol.balance_regions())
+    && (CONFIG_MEM_SCAN_CHAIN != config_protocol.type()) ) {
+    archfpga_throw(loc_data.filename_c_str(), loc_data.line(xml_config_orgz),
+                   "Invalid 'balance_regions' definition. It is only applicable to configuration protocol '%s'!\n",
+                   CONFIG_PROTOCOL_TYPE_STRING[CONFIG_MEM_SCAN_CHAIN]);
+  }
+
+  /* Parse the circuit driving the Bit-Lines, which is only applicable to memory banks */
+  const char* bl_protocol_attr = get_attribute(xml_config_orgz, "bl_protocol", loc_data, pugiutil::ReqOpt::OPTIONAL).as_string(BLWL_PROTOCOL_TYPE_STRING[BLWL_PROTOCOL_DECODER]);
+  e_blwl_protocol_type bl_protocol_type = string_to_blwl_protocol_type(std::string(bl_protocol_attr));
+  if (NUM_BLWL_PROTOCOL_TYPES == bl_protocol_type) {
+    archfpga_throw(loc_data.filename_c_str(), loc_data.line(xml_config_orgz),
+                   "Invalid 'bl_protocol' attribute '%s'. Expect ['%s'|'%s']\n",
+                   bl_protocol_attr,
+                   BLWL_PROTOCOL_TYPE_STRING[BLWL_PROTOCOL_DECODER],
+                   BLWL_PROTOCOL_TYPE_STRING[BLWL_PROTOCOL_SHIFT_REGISTER]);
+  }
+  if ( (BLWL_PROTOCOL_DECODER != bl_protocol_type)
+    && (CONFIG_MEM_MEMORY_BANK != config_protocol.type()) ) {
+    archfpga_throw(loc_data.filename_c_str(), loc_data.line(xml_config_orgz),
+                   "Invalid 'bl_protocol' definition. It is only applicable to configuration protocol '%s'!\n",
+                   CONFIG_PROTOCOL_TYPE_STRING[CONFIG_MEM_MEMORY_BANK]);
+  }
+  config_protocol.set_bl_protocol_type(bl_protocol_type);
+
+  /* Parse the number of configuration bits loaded under each frame address,
+   * which is only applicable to frame-based protocol
+   */
+  int frame_data_width = get_attribute(xml_config_orgz, "data_width", loc_data, pugiutil::ReqOpt::OPTIONAL).as_int(1);
+  if (1 > frame_data_width) {
+    archfpga_throw(loc_data.filename_c_str(), loc_data.line(xml_config_orgz),
+                   "Invalid 'data_width=%d' definition. At least 1 bit should be loaded per frame!\n",
+                   frame_data_width);
+  }
+  if ( (1 != frame_data_width)
+    && (CONFIG_MEM_FRAME_BASED != config_protocol.type()) ) {
+    archfpga_throw(loc_data.filename_c_str(), loc_data.line(xml_config_orgz),
+                   "Invalid 'data_width' definition. It is only applicable to configuration protocol '%s'!\n",
+                   CONFIG_PROTOCOL_TYPE_STRING[CONFIG_MEM_FRAME_BASED]);
+  }
+  config_protocol.set_frame_data_width(frame_data_width);
+
+  /* Parse the compression of bitstreams, which is only applicable to configuration chains */
+  const char* compression_attr = get_attribute(xml_config_orgz, "compression", loc_data, pugiutil::ReqOpt::OPTIONAL).as_string(CONFIG_CHAIN_COMPRESSION_TYPE_STRING[CONFIG_CHAIN_COMPRESSION_NONE]);
+  e_config_chain_compression_type compression_type = string_to_config_chain_compression_type(std::string(compression_attr));
+  if (NUM_CONFIG_CHAIN_COMPRESSION_TYPES == compression_type) {
+    archfpga_throw(loc_data.filename_c_str(), loc_data.line(xml_config_orgz),
+                   "Invalid 'compression' attribute '%s'. Expect ['%s'|'%s']\n",
+                   compression_attr,
+                   CONFIG_CHAIN_COMPRESSION_TYPE_STRING[CONFIG_CHAIN_COMPRESSION_NONE],
+                   CONFIG_CHAIN_COMPRESSION_TYPE_STRING[CONFIG_CHAIN_COMPRESSION_RUN_LENGTH]);
+  }
+  if ( (CONFIG_CHAIN_COMPRESSION_NONE != compression_type)
+    && (CONFIG_MEM_SCAN_CHAIN != config_protocol.type()) ) {
+    archfpga_throw(loc_data.filename_c_str(), loc_data.line(xml_config_orgz),
+                   "Invalid 'compression' definition. It is only applicable to configuration protocol '%s'!\n",
+                   CONFIG_PROTOCOL_TYPE_STRING[CONFIG_MEM_SCAN_CHAIN]);
+  }
+  config_protocol.set_chain_compression_type(compression_type);
+
+  /* Parse the width of run lengths, which is only applicable to run-length compression */
+  int run_length_width = get_attribute(xml_config_orgz, "run_length_width", loc_data, pugiutil::ReqOpt::OPTIONAL).as_int(config_protocol.run_length_width());
+  if ( (1 > run_length_width) || (16 < run_length_width) ) {
+    archfpga_throw(loc_data.filename_c_str(), loc_data.line(xml_config_orgz),
+                   "Invalid 'run_length_width=%d' definition. Expect a width between 1 and 16 bits!\n",
+                   run_length_width);
+  }
+  if ( (size_t(run_length_width) != config_protocol.run_length_width())
+    && (CONFIG_CHAIN_COMPRESSION_RUN_LENGTH != compression_type) ) {
+    archfpga_throw(loc_data.filename_c_str(), loc_data.line(xml_config_orgz),
+                   "Invalid 'run_length_width' definition. It is only applicable to compression '%s'!\n",
+                   CONFIG_CHAIN_COMPRESSION_TYPE_STRING[CONFIG_CHAIN_COMPRESSION_RUN_LENGTH]);
+  }
+  config_protocol.set_run_length_width(run_length_width);
 }
 
 /********************************************************************
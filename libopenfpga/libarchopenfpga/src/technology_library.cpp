@@ -1,6 +1,7 @@
 #include "vtr_assert.h"
 
 #include "technology_library.h"
+#include "openfpga_binary_io.h"
 
 /************************************************************************
  * Member functions for class TechnologyLibrary
@@ -557,3 +558,23 @@ bool TechnologyLibrary::valid_model_id(const TechnologyModelId& model_id) const
 bool TechnologyLibrary::valid_variation_id(const TechnologyVariationId& variation_id) const {
   return ( size_t(variation_id) < variation_ids_.size() ) && ( variation_id == variation_ids_[variation_id] ); 
 }
+
+/************************************************************************
+ * Public Mutators: serialization
+ ***********************************************************************/
+template <class Archive>
+void TechnologyLibrary::serialize(Archive& archive) {
+  archive(model_ids_, model_names_, model_types_, model_lib_types_,
+          model_corners_, model_refs_, model_lib_paths_, model_vdds_,
+          model_pn_ratios_, transistor_model_names_,
+          transistor_model_chan_lengths_, transistor_model_min_widths_,
+          transistor_model_max_widths_, transistor_model_variation_names_,
+          transistor_model_variation_ids_, rram_resistances_,
+          rram_variation_names_, rram_variation_ids_, variation_ids_,
+          variation_names_, variation_abs_values_, variation_num_sigmas_,
+          model_name2ids_, variation_name2ids_);
+}
+
+/* Only the binary archives are used to serialize the data */
+template void TechnologyLibrary::serialize(openfpga::BinaryWriter& archive);
+template void TechnologyLibrary::serialize(openfpga::BinaryReader& archive);
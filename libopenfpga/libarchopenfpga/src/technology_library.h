@@ -162,6 +162,10 @@ class TechnologyLibrary {
   public: /* Public invalidators/validators */
     bool valid_model_id(const TechnologyModelId& model_id) const;
     bool valid_variation_id(const TechnologyVariationId& variation_id) const;
+  public: /* Public Mutators: serialization */
+    /* Write or read all the internal data with an archive of openfpga_binary_io.h */
+    template <class Archive>
+    void serialize(Archive& archive);
   private: /* Internal data */
     /* Transistor-related fundamental information */
     /* Unique identifier for each model
@@ -4,6 +4,7 @@
 #include "vtr_assert.h"
 
 #include "tile_annotation.h"
+#include "openfpga_binary_io.h"
 
 /* namespace openfpga begins */
 namespace openfpga {
@@ -155,4 +156,19 @@ bool TileAnnotation::valid_global_port_attributes(const TileGlobalPortId& global
   return ((0 == attribute_counter) || (1 == attribute_counter));
 }
 
+/************************************************************************
+ * Public Mutators: serialization
+ ***********************************************************************/
+template <class Archive>
+void TileAnnotation::serialize(Archive& archive) {
+  archive(global_port_ids_, global_port_names_, global_port_tile_names_,
+          global_port_tile_coordinates_, global_port_tile_ports_,
+          global_port_is_clock_, global_port_is_reset_, global_port_is_set_,
+          global_port_default_values_, global_port_name2ids_);
+}
+
+/* Only the binary archives are used to serialize the data */
+template void TileAnnotation::serialize(BinaryWriter& archive);
+template void TileAnnotation::serialize(BinaryReader& archive);
+
 } /* namespace openfpga ends */
@@ -71,6 +71,10 @@ class TileAnnotation {
      * - A port can only be defined as clock or set or reset
      */
     bool valid_global_port_attributes(const TileGlobalPortId& global_port_id) const;
+  public: /* Public Mutators: serialization */
+    /* Write or read all the internal data with an archive of openfpga_binary_io.h */
+    template <class Archive>
+    void serialize(Archive& archive);
   private: /* Internal data */
     /* Global port information for tiles */
     vtr::vector<TileGlobalPortId, TileGlobalPortId> global_port_ids_;
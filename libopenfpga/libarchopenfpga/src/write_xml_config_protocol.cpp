@@ -29,6 +29,20 @@ void write_xml_config_organization(std::fstream& fp,
 
   write_xml_attribute(fp, "type", CONFIG_PROTOCOL_TYPE_STRING[config_protocol.type()]);
   write_xml_attribute(fp, "circuit_model_name", circuit_lib.model_name(config_protocol.memory_model()).c_str());
+  if (true == config_protocol.balance_regions()) {
+    write_xml_attribute(fp, "num_regions", config_protocol.num_regions());
+    write_xml_attribute(fp, "balance_regions", "true");
+  }
+  if (BLWL_PROTOCOL_DECODER != config_protocol.bl_protocol_type()) {
+    write_xml_attribute(fp, "bl_protocol", BLWL_PROTOCOL_TYPE_STRING[config_protocol.bl_protocol_type()]);
+  }
+  if (1 != config_protocol.frame_data_width()) {
+    write_xml_attribute(fp, "data_width", config_protocol.frame_data_width());
+  }
+  if (CONFIG_CHAIN_COMPRESSION_NONE != config_protocol.chain_compression_type()) {
+    write_xml_attribute(fp, "compression", CONFIG_CHAIN_COMPRESSION_TYPE_STRING[config_protocol.chain_compression_type()]);
+    write_xml_attribute(fp, "run_length_width", config_protocol.run_length_width());
+  }
 
   fp << "/>" << "\n";
 }
@@ -54,6 +54,12 @@ std::string FabricKey::key_alias(const FabricKeyId& key_id) const {
   return key_alias_[key_id]; 
 }
 
+FabricRegionId FabricKey::key_region(const FabricKeyId& key_id) const {
+  /* validate the key_id */
+  VTR_ASSERT(valid_key_id(key_id));
+  return key_regions_[key_id];
+}
+
 bool FabricKey::empty() const {
   return 0 == key_ids_.size();
 }
@@ -91,14 +97,13 @@ void FabricKey::add_key_to_region(const FabricRegionId& region_id,
   /* validate the region_id */
   VTR_ASSERT(valid_region_id(region_id));
 
-  /* Check if the key is already in the region */
-  if (region_key_ids_[region_id].end() != std::find(region_key_ids_[region_id].begin(),
-                                                    region_key_ids_[region_id].end(),
-                                                    key_id)) {
+  /* Check if the key is already in the region, which is recorded by the region of the key
+   * rather than searched in the keys of the region, as a region may contain millions of keys
+   */
+  if (region_id == key_regions_[key_id]) {
     VTR_LOG_WARN("Try to add a key '%s' which is already in the region '%lu'!\n",
                  key_name(key_id).c_str(),
                  size_t(region_id));
-    VTR_ASSERT(region_id == key_regions_[key_id]);
     return; /* Nothing to do but leave a warning! */
   }
 
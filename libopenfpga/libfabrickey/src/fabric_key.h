@@ -58,6 +58,9 @@ class FabricKey {
     /* Access the alias of a key */
     std::string key_alias(const FabricKeyId& key_id) const;
 
+    /* Access the region of a key, which is invalid if the key is not added to any region */
+    FabricRegionId key_region(const FabricKeyId& key_id) const;
+
     /* Check if there are any keys */
     bool empty() const;
 
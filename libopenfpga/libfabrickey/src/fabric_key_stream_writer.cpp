@@ -0,0 +1,198 @@
+/********************************************************************
+ * This file includes member functions of the writer which outputs
+ * fabric keys to files key by key
+ *
+ * The XML format is described in the documentation of fabric keys.
+ * The binary format stores the same contents in sequence:
+ *   magic, version, number of regions, number of keys,
+ *   then for each region: number of keys of the region,
+ *   then for each key: id, name, value, alias
+ * where numbers are 64-bit integers and strings are led by their sizes
+ *******************************************************************/
+/* Headers from vtr util library */
+#include "vtr_assert.h"
+#include "vtr_log.h"
+
+/* Headers from openfpga util library */
+#include "openfpga_digest.h"
+
+/* Headers from arch openfpga library */
+#include "write_xml_utils.h"
+
+#include "fabric_key_stream_writer.h"
+
+/********************************************************************
+ * Decode the format of fabric keys from a string
+ *******************************************************************/
+e_fabric_key_format find_fabric_key_format(const std::string& format_name) {
+  for (size_t iformat = 0; iformat < NUM_FABRIC_KEY_FORMATS; ++iformat) {
+    if (format_name == std::string(FABRIC_KEY_FORMAT_STRING[iformat])) {
+      return static_cast<e_fabric_key_format>(iformat);
+    }
+  }
+  return NUM_FABRIC_KEY_FORMATS;
+}
+
+/************************************************************************
+ * Constructors
+ ***********************************************************************/
+FabricKeyStreamWriter::FabricKeyStreamWriter(const std::string& fname,
+                                             const e_fabric_key_format& format,
+                                             const size_t& num_regions,
+                                             const size_t& num_keys)
+  : fname_(fname),
+    format_(format),
+    fp_(fname),
+    num_regions_(num_regions),
+    num_keys_(num_keys),
+    num_regions_written_(0),
+    num_keys_written_(0),
+    num_region_keys_(0),
+    num_region_keys_written_(0),
+    consistent_(true) {
+  VTR_ASSERT(NUM_FABRIC_KEY_FORMATS != format_);
+
+  /* Validate the file stream */
+  openfpga::check_file_stream(fname_.c_str(), fp_.stream());
+
+  if (FABRIC_KEY_FORMAT_BIN == format_) {
+    bin_writer_.reset(new openfpga::BinaryWriter(fp_.stream()));
+    (*bin_writer_)(std::string(FABRIC_KEY_BIN_MAGIC),
+                   FABRIC_KEY_BIN_VERSION,
+                   static_cast<uint64_t>(num_regions_),
+                   static_cast<uint64_t>(num_keys_));
+    return;
+  }
+
+  /* Write the root node */
+  fp_.stream() << "<fabric_key";
+  write_xml_attribute(fp_.stream(), "num_regions", num_regions_);
+  write_xml_attribute(fp_.stream(), "num_keys", num_keys_);
+  fp_.stream() << ">" << "\n";
+}
+
+/************************************************************************
+ * Public mutators
+ ***********************************************************************/
+void FabricKeyStreamWriter::begin_region(const size_t& num_keys) {
+  num_region_keys_ = num_keys;
+  num_region_keys_written_ = 0;
+
+  if (FABRIC_KEY_FORMAT_BIN == format_) {
+    (*bin_writer_)(static_cast<uint64_t>(num_region_keys_));
+    return;
+  }
+
+  openfpga::write_tab_to_file(fp_.stream(), 1);
+  fp_.stream() << "<region";
+  write_xml_attribute(fp_.stream(), "id", num_regions_written_);
+  write_xml_attribute(fp_.stream(), "num_keys", num_region_keys_);
+  fp_.stream() << ">" << "\n";
+}
+
+void FabricKeyStreamWriter::write_key(const size_t& id,
+                                      const std::string& name,
+                                      const size_t& value,
+                                      const std::string& alias) {
+  ++num_region_keys_written_;
+  ++num_keys_written_;
+
+  if (FABRIC_KEY_FORMAT_BIN == format_) {
+    (*bin_writer_)(static_cast<uint64_t>(id),
+                   name,
+                   static_cast<uint64_t>(value),
+                   alias);
+    return;
+  }
+
+  openfpga::write_tab_to_file(fp_.stream(), 2);
+  fp_.stream() << "<key";
+  write_xml_attribute(fp_.stream(), "id", id);
+  if (!name.empty()) {
+    write_xml_attribute(fp_.stream(), "name", name.c_str());
+  }
+  write_xml_attribute(fp_.stream(), "value", value);
+  if (!alias.empty()) {
+    write_xml_attribute(fp_.stream(), "alias", alias.c_str());
+  }
+  fp_.stream() << "/>" << "\n";
+}
+
+void FabricKeyStreamWriter::end_region() {
+  if (num_region_keys_ != num_region_keys_written_) {
+    VTR_LOG_ERROR("Wrote %lu keys to region '%lu' of fabric key '%s' while %lu keys are declared!\n",
+                  num_region_keys_written_, num_regions_written_, fname_.c_str(), num_region_keys_);
+    consistent_ = false;
+  }
+  ++num_regions_written_;
+
+  if (FABRIC_KEY_FORMAT_BIN == format_) {
+    return;
+  }
+
+  openfpga::write_tab_to_file(fp_.stream(), 1);
+  fp_.stream() << "</region>" << "\n";
+}
+
+int FabricKeyStreamWriter::finish() {
+  int err_code = 0;
+
+  if ( (num_regions_ != num_regions_written_)
+    || (num_keys_ != num_keys_written_) ) {
+    consistent_ = false;
+    VTR_LOG_ERROR("Wrote %lu regions and %lu keys to fabric key '%s' while %lu regions and %lu keys are declared!\n",
+                  num_regions_written_, num_keys_written_, fname_.c_str(), num_regions_, num_keys_);
+  }
+  if (false == consistent_) {
+    err_code = 1;
+  }
+
+  if (FABRIC_KEY_FORMAT_XML == format_) {
+    /* Finish writing the root node */
+    fp_.stream() << "</fabric_key>" << "\n";
+  }
+
+  fp_.stream().flush();
+  if (false == fp_.stream().good()) {
+    VTR_LOG_ERROR("Failed in writing fabric key '%s'!\n",
+                  fname_.c_str());
+    err_code = 2;
+  }
+
+  /* Close the file stream */
+  fp_.close();
+
+  return err_code;
+}
+
+/********************************************************************
+ * Write a fabric key to a file in the given format region by region
+ *
+ * Return 0 if successful
+ * Return 1 if there are more serious bugs in the architecture 
+ * Return 2 if fail when creating files
+ *******************************************************************/
+int write_fabric_key_in_format(const char* fname,
+                               const FabricKey& fabric_key,
+                               const e_fabric_key_format& format) {
+  FabricKeyStreamWriter writer(std::string(fname), format,
+                               fabric_key.regions().size(), fabric_key.keys().size());
+
+  /* Write region by region */ 
+  for (const FabricRegionId& region : fabric_key.regions()) {
+    std::vector<FabricKeyId> region_keys = fabric_key.region_keys(region);
+    writer.begin_region(region_keys.size());
+
+    /* Write component by component */ 
+    for (const FabricKeyId& key : region_keys) {
+      writer.write_key(size_t(key),
+                       fabric_key.key_name(key),
+                       fabric_key.key_value(key),
+                       fabric_key.key_alias(key));
+    }
+
+    writer.end_region();
+  }
+
+  return writer.finish();
+}
@@ -0,0 +1,95 @@
+#ifndef FABRIC_KEY_STREAM_WRITER_H
+#define FABRIC_KEY_STREAM_WRITER_H
+
+/********************************************************************
+ * Include header files that are required by data structure declaration
+ *******************************************************************/
+#include <array>
+#include <memory>
+#include <string>
+
+/* Headers from openfpgautil library */
+#include "openfpga_binary_io.h"
+#include "openfpga_buffered_file_stream.h"
+
+#include "fabric_key.h"
+
+/* File formats of fabric keys */
+enum e_fabric_key_format {
+  FABRIC_KEY_FORMAT_XML,
+  FABRIC_KEY_FORMAT_BIN,
+  NUM_FABRIC_KEY_FORMATS
+};
+/* Strings used in command options */
+constexpr std::array<const char*, NUM_FABRIC_KEY_FORMATS> FABRIC_KEY_FORMAT_STRING = {{"xml", "bin"}};
+
+/* Decode the format from a string, return NUM_FABRIC_KEY_FORMATS if invalid */
+e_fabric_key_format find_fabric_key_format(const std::string& format_name);
+
+/* Identification of the binary format of fabric keys */
+constexpr const char* FABRIC_KEY_BIN_MAGIC = "OpenFPGA fabric key";
+/* Increase the number when the contents of the binary format change */
+constexpr uint32_t FABRIC_KEY_BIN_VERSION = 1;
+
+/********************************************************************
+ * A writer which outputs the keys of a fabric to a file one by one,
+ * so that the keys of a huge fabric can be written without
+ * being collected in a FabricKey first
+ *
+ * The numbers of regions and keys are given in advance,
+ * which are stored in the file for readers to reserve memory.
+ * Regions are numbered in the sequence they are written.
+ *
+ * Example:
+ *   FabricKeyStreamWriter writer(fname, FABRIC_KEY_FORMAT_XML, 1, 2);
+ *   writer.begin_region(2);
+ *   writer.write_key(0, "grid_clb", 0, "grid_clb_1__1_");
+ *   writer.write_key(1, "sb_1__1_", 0, "");
+ *   writer.end_region();
+ *   int err_code = writer.finish();
+ *******************************************************************/
+class FabricKeyStreamWriter {
+  public: /* Constructors */
+    FabricKeyStreamWriter(const std::string& fname,
+                          const e_fabric_key_format& format,
+                          const size_t& num_regions,
+                          const size_t& num_keys);
+    FabricKeyStreamWriter(const FabricKeyStreamWriter&) = delete;
+    FabricKeyStreamWriter& operator=(const FabricKeyStreamWriter&) = delete;
+  public: /* Public mutators */
+    /* Start a region with the given number of keys */
+    void begin_region(const size_t& num_keys);
+    /* Write a key of current region. The name and the alias are skipped when empty */
+    void write_key(const size_t& id,
+                   const std::string& name,
+                   const size_t& value,
+                   const std::string& alias);
+    void end_region();
+    /* Finish and close the file
+     * Return 0 if successful
+     * Return 1 if the number of regions or keys written are not as declared
+     * Return 2 if fail when writing the file
+     */
+    int finish();
+  private: /* Internal data */
+    std::string fname_;
+    e_fabric_key_format format_;
+    openfpga::BufferedFileStream fp_;
+    std::unique_ptr<openfpga::BinaryWriter> bin_writer_;
+    size_t num_regions_;
+    size_t num_keys_;
+    /* Numbers of regions and keys written so far, to check against the declared numbers */
+    size_t num_regions_written_;
+    size_t num_keys_written_;
+    size_t num_region_keys_;
+    size_t num_region_keys_written_;
+    /* If the numbers of keys written are the same as declared, otherwise the file cannot be read back */
+    bool consistent_;
+};
+
+/* Write all the keys of a fabric key to a file in the given format */
+int write_fabric_key_in_format(const char* fname,
+                               const FabricKey& fabric_key,
+                               const e_fabric_key_format& format);
+
+#endif
@@ -0,0 +1,134 @@
+/********************************************************************
+ * This file includes the function which reads a binary file of
+ * a fabric key, written by write_bin_fabric_key(), 
+ * to the associated data structures
+ * See fabric_key_stream_writer.cpp for the contents of the file
+ *******************************************************************/
+#include <fstream>
+#include <string>
+
+/* Headers from vtr util library */
+#include "vtr_assert.h"
+#include "vtr_time.h"
+
+/* Headers from libarchfpga */
+#include "arch_error.h"
+
+/* Headers from openfpgautil library */
+#include "openfpga_binary_io.h"
+
+#include "fabric_key_stream_writer.h"
+#include "read_bin_fabric_key.h"
+
+/********************************************************************
+ * Parse a binary file of fabric key to an object of FabricKey
+ * Keys are read one by one, and all the regions and keys
+ * are created in advance, as their numbers are given in the header
+ *******************************************************************/
+FabricKey read_bin_fabric_key(const char* key_fname) {
+
+  vtr::ScopedStartFinishTimer timer("Read Fabric Key binary file");
+
+  FabricKey fabric_key;
+
+  std::ifstream fp(key_fname, std::ios::in | std::ios::binary);
+  if (false == fp.good()) {
+    archfpga_throw(key_fname, 0,
+                   "Unable to open fabric key file '%s'!\n",
+                   key_fname);
+  }
+
+  openfpga::BinaryReader reader(fp);
+
+  std::string magic;
+  uint32_t version = 0;
+  uint64_t num_regions = 0;
+  uint64_t num_keys = 0;
+  reader(magic, version, num_regions, num_keys);
+  if ( (false == reader.good())
+    || (std::string(FABRIC_KEY_BIN_MAGIC) != magic) ) {
+    archfpga_throw(key_fname, 0,
+                   "File '%s' is not a binary fabric key!\n",
+                   key_fname);
+  }
+  if (FABRIC_KEY_BIN_VERSION != version) {
+    archfpga_throw(key_fname, 0,
+                   "Binary fabric key '%s' has version %u while version %u is expected!\n",
+                   key_fname, version, FABRIC_KEY_BIN_VERSION);
+  }
+
+  /* A corrupted header would cause a huge allocation.
+   * Each region takes at least 8 bytes and each key takes at least 32 bytes,
+   * so larger numbers than the size of the file allows must be an error
+   */
+  std::streampos curr_pos = fp.tellg();
+  fp.seekg(0, std::ios::end);
+  uint64_t num_bytes = fp.tellg() - curr_pos;
+  fp.seekg(curr_pos);
+  if ( (num_bytes / 8 < num_regions)
+    || (num_bytes / 32 < num_keys) ) {
+    archfpga_throw(key_fname, 0,
+                   "Binary fabric key '%s' is too small for %lu regions and %lu keys!\n",
+                   key_fname, size_t(num_regions), size_t(num_keys));
+  }
+
+  /* Reserve memory space for the regions and keys */
+  fabric_key.reserve_regions(num_regions);
+  for (size_t iregion = 0; iregion < num_regions; ++iregion) {
+    fabric_key.create_region();
+  }
+  fabric_key.reserve_keys(num_keys);
+  for (size_t ikey = 0; ikey < num_keys; ++ikey) {
+    fabric_key.create_key();
+  }
+
+  size_t num_keys_read = 0;
+  std::string name;
+  std::string alias;
+  for (const FabricRegionId& region_id : fabric_key.regions()) {
+    uint64_t num_region_keys = 0;
+    reader(num_region_keys);
+    if ( (false == reader.good())
+      || (num_keys < num_keys_read + num_region_keys) ) {
+      archfpga_throw(key_fname, 0,
+                     "Invalid number of keys in region '%lu'!\n",
+                     size_t(region_id));
+    }
+    fabric_key.reserve_region_keys(region_id, num_region_keys);
+
+    for (size_t ikey = 0; ikey < num_region_keys; ++ikey) {
+      uint64_t id = 0;
+      uint64_t value = 0;
+      reader(id, name, value, alias);
+      if (false == reader.good()) {
+        archfpga_throw(key_fname, 0,
+                       "Unexpected end of file in region '%lu'!\n",
+                       size_t(region_id));
+      }
+
+      FabricKeyId key = FabricKeyId(id);
+      if ( (false == fabric_key.valid_key_id(key))
+        || (true == fabric_key.valid_region_id(fabric_key.key_region(key))) ) {
+        archfpga_throw(key_fname, 0,
+                       "Invalid key id '%lu' in region '%lu' (in total %lu keys)!\n",
+                       size_t(id), size_t(region_id), size_t(num_keys));
+      }
+
+      fabric_key.set_key_name(key, name);
+      fabric_key.set_key_value(key, value);
+      if (!alias.empty()) {
+        fabric_key.set_key_alias(key, alias);
+      }
+      fabric_key.add_key_to_region(region_id, key);
+    }
+    num_keys_read += num_region_keys;
+  }
+
+  if (num_keys_read != num_keys) {
+    archfpga_throw(key_fname, 0,
+                   "Regions contain %lu keys while %lu keys are expected!\n",
+                   num_keys_read, size_t(num_keys));
+  }
+
+  return fabric_key;
+}
@@ -0,0 +1,14 @@
+#ifndef READ_BIN_FABRIC_KEY_H
+#define READ_BIN_FABRIC_KEY_H
+
+/********************************************************************
+ * Include header files that are required by function declaration
+ *******************************************************************/
+#include "fabric_key.h"
+
+/********************************************************************
+ * Function declaration
+ *******************************************************************/
+FabricKey read_bin_fabric_key(const char* key_fname);
+
+#endif
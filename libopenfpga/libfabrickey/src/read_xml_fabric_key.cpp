@@ -2,12 +2,14 @@
  * This file includes the top-level function of this library
  * which reads an XML of a fabric key to the associated
  * data structures
+ *
+ * The XML is streamed through rather than loaded to a document,
+ * so the regions and keys are created as their elements are read
  *******************************************************************/
+#include <cstdlib>
+#include <limits>
 #include <string>
-
-/* Headers from pugi XML library */
-#include "pugixml.hpp"
-#include "pugixml_util.hpp"
+#include <vector>
 
 /* Headers from vtr util library */
 #include "vtr_assert.h"
@@ -15,89 +17,103 @@
 
 /* Headers from libarchfpga */
 #include "arch_error.h"
-#include "read_xml_util.h"
+
+/* Headers from openfpgautil library */
+#include "openfpga_xml_stream_reader.h"
 
 #include "read_xml_fabric_key.h"
 
+/********************************************************************
+ * Find the value of an attribute which is required in an element
+ *******************************************************************/
+static
+const std::string& get_required_fabric_key_attribute(const openfpga::XmlStreamReader& reader,
+                                                     const char* fname,
+                                                     const std::string& attribute_name) {
+  if (false == reader.has_attribute(attribute_name)) {
+    archfpga_throw(fname, reader.line(),
+                   "Expected '%s' attribute in <%s>!\n",
+                   attribute_name.c_str(), reader.name().c_str());
+  }
+  return reader.attribute(attribute_name);
+}
+
+/********************************************************************
+ * Convert the value of an attribute which is required in an element
+ * to a non-negative integer
+ *******************************************************************/
+static
+size_t get_fabric_key_attribute_as_integer(const openfpga::XmlStreamReader& reader,
+                                           const char* fname,
+                                           const std::string& attribute_name) {
+  const std::string& value = get_required_fabric_key_attribute(reader, fname, attribute_name);
+  char* end = nullptr;
+  long number = std::strtol(value.c_str(), &end, 10);
+  if ((true == value.empty()) || ('\0' != *end) || (0 > number)) {
+    archfpga_throw(fname, reader.line(),
+                   "Invalid value '%s' of attribute '%s' in <%s>, expect a non-negative integer!\n",
+                   value.c_str(), attribute_name.c_str(), reader.name().c_str());
+  }
+  return number;
+}
+
 /********************************************************************
  * Parse XML codes of a <key> to an object of FabricKey
+ * Keys are created on demand, as they may be listed in any sequence
  *******************************************************************/
-static 
-void read_xml_region_key(pugi::xml_node& xml_component_key,
-                         const pugiutil::loc_data& loc_data,
+static
+void read_xml_region_key(const openfpga::XmlStreamReader& reader,
+                         const char* fname,
                          FabricKey& fabric_key,
-                         const FabricRegionId& fabric_region) {
+                         const FabricRegionId& fabric_region,
+                         const size_t& max_num_keys) {
 
   /* Find the id of component key */
-  const size_t& id = get_attribute(xml_component_key, "id", loc_data).as_int();
+  const size_t& id = get_fabric_key_attribute_as_integer(reader, fname, "id");
+  if (max_num_keys <= id) {
+    archfpga_throw(fname, reader.line(),
+                   "Invalid 'id' attribute '%lu' (in total %lu keys)!\n",
+                   id,
+                   max_num_keys);
+  }
+  while (fabric_key.keys().size() <= id) {
+    fabric_key.create_key();
+  }
 
-  if (false == fabric_key.valid_key_id(FabricKeyId(id))) {
-    archfpga_throw(loc_data.filename_c_str(), loc_data.line(xml_component_key),
-                   "Invalid 'id' attribute '%d' (in total %lu keys)!\n",
+  if (true == fabric_key.valid_region_id(fabric_key.key_region(FabricKeyId(id)))) {
+    archfpga_throw(fname, reader.line(),
+                   "Key id '%lu' has been defined in region '%lu'!\n",
                    id,
-                   fabric_key.keys().size());
+                   size_t(fabric_key.key_region(FabricKeyId(id))));
   }
 
   VTR_ASSERT_SAFE(true == fabric_key.valid_key_id(FabricKeyId(id)));
 
   /* If we have an alias, set the value as well */
-  const std::string& alias = get_attribute(xml_component_key, "alias", loc_data, pugiutil::ReqOpt::OPTIONAL).as_string();
+  const std::string& alias = reader.attribute("alias");
   if (!alias.empty()) {
     fabric_key.set_key_alias(FabricKeyId(id), alias);
   }
 
-  /* If we have the alias set, name and valus are optional then 
-   * Otherwise, they are mandatory attributes 
+  /* If we have the alias set, name and valus are optional then
+   * Otherwise, they are mandatory attributes
    */
-  pugiutil::ReqOpt required_name_value = pugiutil::ReqOpt::OPTIONAL; 
-  if (true == alias.empty()) {
-    required_name_value = pugiutil::ReqOpt::REQUIRED;
+  if ( (true == alias.empty()) || (true == reader.has_attribute("name")) ) {
+    fabric_key.set_key_name(FabricKeyId(id), get_required_fabric_key_attribute(reader, fname, "name"));
+  }
+  if ( (true == alias.empty()) || (true == reader.has_attribute("value")) ) {
+    fabric_key.set_key_value(FabricKeyId(id), get_fabric_key_attribute_as_integer(reader, fname, "value"));
   }
 
-  const std::string& name = get_attribute(xml_component_key, "name", loc_data, required_name_value).as_string();
-  const size_t& value = get_attribute(xml_component_key, "value", loc_data, required_name_value).as_int();
-  
-  fabric_key.set_key_name(FabricKeyId(id), name);
-  fabric_key.set_key_value(FabricKeyId(id), value);
   fabric_key.add_key_to_region(fabric_region, FabricKeyId(id));
 }
 
-/********************************************************************
- * Parse XML codes of a <key> to an object of FabricKey
- *******************************************************************/
-static 
-void read_xml_fabric_region(pugi::xml_node& xml_region,
-                            const pugiutil::loc_data& loc_data,
-                            FabricKey& fabric_key) {
-  /* Find the unique id for the region */
-  const FabricRegionId& region_id = FabricRegionId(get_attribute(xml_region, "id", loc_data).as_int());
-  if (false == fabric_key.valid_region_id(region_id)) {
-    archfpga_throw(loc_data.filename_c_str(), loc_data.line(xml_region),
-                   "Invalid region id '%lu' (in total %lu regions)!\n",
-                   size_t(region_id),
-                   fabric_key.regions().size());
-  }
-  VTR_ASSERT_SAFE(true == fabric_key.valid_region_id(region_id));
-
-  /* Reserve memory space for the keys in the region */
-  size_t num_keys = std::distance(xml_region.children().begin(), xml_region.children().end());
-  fabric_key.reserve_region_keys(region_id, num_keys);
-
-  for (pugi::xml_node xml_key : xml_region.children()) {
-    /* Error out if the XML child has an invalid name! */
-    if (xml_key.name() != std::string("key")) {
-      archfpga_throw(loc_data.filename_c_str(), loc_data.line(xml_region),
-                     "Unexpected child '%s' in region '%lu', Region XML node can only contain keys!\n",
-                     xml_key.name(),
-                     size_t(region_id));
-    }
-    /* Parse the key for this region */
-    read_xml_region_key(xml_key, loc_data, fabric_key, region_id);
-  }
-}
-
 /********************************************************************
  * Parse XML codes about <fabric> to an object of FabricKey
+ *
+ * The root may give the numbers of regions and keys in its attributes
+ * 'num_regions' and 'num_keys', and a region may give its number of keys
+ * in its attribute 'num_keys', which are used to reserve memory
  *******************************************************************/
 FabricKey read_xml_fabric_key(const char* key_fname) {
 
@@ -105,53 +121,124 @@ FabricKey read_xml_fabric_key(const char* key_fname) {
 
   FabricKey fabric_key;
 
-  /* Parse the file */
-  pugi::xml_document doc;
-  pugiutil::loc_data loc_data;
-
-  try {
-    loc_data = pugiutil::load_xml(doc, key_fname);
-
-    pugi::xml_node xml_root = get_single_child(doc, "fabric_key", loc_data);
+  openfpga::XmlStreamReader reader(key_fname);
+  if (false == reader.is_open()) {
+    archfpga_throw(key_fname, 0,
+                   "%s\n", reader.error().c_str());
+  }
 
-    size_t num_regions = std::distance(xml_root.children().begin(), xml_root.children().end());
-    /* Reserve memory space for the region */
-    fabric_key.reserve_regions(num_regions);
-    for (size_t iregion = 0; iregion < num_regions; ++iregion) {
-      fabric_key.create_region();
+  /* Number of elements found, which should be the same as the regions and keys created */
+  size_t num_region_elements = 0;
+  size_t num_key_elements = 0;
+  std::vector<bool> regions_defined;
+  bool root_found = false;
+  /* Numbers of regions and keys declared by the root, which bound the ids */
+  size_t max_num_regions = std::numeric_limits<size_t>::max();
+  size_t max_num_keys = std::numeric_limits<size_t>::max();
+  FabricRegionId curr_region = FabricRegionId::INVALID();
+
+  while (true == reader.next()) {
+    if (openfpga::XmlStreamReader::XML_END_ELEMENT == reader.event()) {
+      if (1 == reader.depth()) {
+        curr_region = FabricRegionId::INVALID();
+      }
+      continue;
     }
 
-    /* Reserve memory space for the keys */
-    size_t num_keys = 0;
+    if (0 == reader.depth()) {
+      /* The root element */
+      if (reader.name() != std::string("fabric_key")) {
+        archfpga_throw(key_fname, reader.line(),
+                       "Expected a root <fabric_key> rather than <%s>!\n",
+                       reader.name().c_str());
+      }
+      if (true == root_found) {
+        archfpga_throw(key_fname, reader.line(),
+                       "Expected only one root <fabric_key>!\n");
+      }
+      root_found = true;
+      /* Reserve memory space for the regions and keys */
+      if (true == reader.has_attribute("num_regions")) {
+        max_num_regions = get_fabric_key_attribute_as_integer(reader, key_fname, "num_regions");
+        fabric_key.reserve_regions(max_num_regions);
+      }
+      if (true == reader.has_attribute("num_keys")) {
+        max_num_keys = get_fabric_key_attribute_as_integer(reader, key_fname, "num_keys");
+        fabric_key.reserve_keys(max_num_keys);
+      }
+    } else if (1 == reader.depth()) {
+      /* Error out if the XML child has an invalid name! */
+      if (reader.name() != std::string("region")) {
+        archfpga_throw(key_fname, reader.line(),
+                       "Unexpected child '%s' in <fabric_key>, expect <region>!\n",
+                       reader.name().c_str());
+      }
+      /* Find the unique id for the region */
+      size_t region_id = get_fabric_key_attribute_as_integer(reader, key_fname, "id");
+      if (max_num_regions <= region_id) {
+        archfpga_throw(key_fname, reader.line(),
+                       "Invalid region id '%lu' (in total %lu regions)!\n",
+                       region_id,
+                       max_num_regions);
+      }
+      while (fabric_key.regions().size() <= region_id) {
+        fabric_key.create_region();
+      }
+      curr_region = FabricRegionId(region_id);
+      if (regions_defined.size() <= region_id) {
+        regions_defined.resize(region_id + 1, false);
+      }
+      if (true == regions_defined[region_id]) {
+        archfpga_throw(key_fname, reader.line(),
+                       "Region id '%lu' has been defined!\n",
+                       region_id);
+      }
+      regions_defined[region_id] = true;
+      ++num_region_elements;
 
-    for (pugi::xml_node xml_region : xml_root.children()) {
+      /* Reserve memory space for the keys in the region */
+      if (true == reader.has_attribute("num_keys")) {
+        fabric_key.reserve_region_keys(curr_region, get_fabric_key_attribute_as_integer(reader, key_fname, "num_keys"));
+      }
+    } else if (2 == reader.depth()) {
       /* Error out if the XML child has an invalid name! */
-      if (xml_region.name() != std::string("region")) {
-        bad_tag(xml_region, loc_data, xml_root, {"region"});
+      if (reader.name() != std::string("key")) {
+        archfpga_throw(key_fname, reader.line(),
+                       "Unexpected child '%s' in region '%lu', Region XML node can only contain keys!\n",
+                       reader.name().c_str(),
+                       size_t(curr_region));
       }
-      num_keys += std::distance(xml_region.children().begin(), xml_region.children().end());
+      /* Parse the key for this region */
+      read_xml_region_key(reader, key_fname, fabric_key, curr_region, max_num_keys);
+      ++num_key_elements;
+    } else {
+      archfpga_throw(key_fname, reader.line(),
+                     "Unexpected child '%s' in <key>!\n",
+                     reader.name().c_str());
     }
+  }
 
-    fabric_key.reserve_keys(num_keys);
-    for (size_t ikey = 0; ikey < num_keys; ++ikey) {
-      fabric_key.create_key();
-    }
+  if (false == reader.error().empty()) {
+    archfpga_throw(key_fname, 0,
+                   "Unable to read XML file '%s', %s\n",
+                   key_fname, reader.error().c_str());
+  }
+  if (false == root_found) {
+    archfpga_throw(key_fname, 0,
+                   "Expected a root <fabric_key>!\n");
+  }
 
-    /* Iterate over the children under this node,
-     * each child should be named after circuit_model
-     */
-    for (pugi::xml_node xml_region : xml_root.children()) {
-      /* Error out if the XML child has an invalid name! */
-      if (xml_region.name() != std::string("region")) {
-        bad_tag(xml_region, loc_data, xml_root, {"region"});
-      }
-      read_xml_fabric_region(xml_region, loc_data, fabric_key);
-    } 
-  } catch (pugiutil::XmlError& e) {
-    archfpga_throw(key_fname, e.line(),
-                   "%s", e.what());
+  /* Ids should be unique and start from zero without gaps */
+  if (num_region_elements != fabric_key.regions().size()) {
+    archfpga_throw(key_fname, 0,
+                   "Invalid region ids: %lu regions are defined while the largest id is '%lu'!\n",
+                   num_region_elements, fabric_key.regions().size() - 1);
+  }
+  if (num_key_elements != fabric_key.keys().size()) {
+    archfpga_throw(key_fname, 0,
+                   "Invalid key ids: %lu keys are defined while the largest id is '%lu'!\n",
+                   num_key_elements, fabric_key.keys().size() - 1);
   }
 
-  return fabric_key; 
+  return fabric_key;
 }
-
@@ -0,0 +1,26 @@
+/********************************************************************
+ * This file includes functions that output a fabric key to a binary file,
+ * which is more compact and faster to read back than XML
+ * See fabric_key_stream_writer.cpp for the contents of the file
+ *******************************************************************/
+/* Headers from vtr util library */
+#include "vtr_time.h"
+
+/* Headers from fabrickey library */
+#include "fabric_key_stream_writer.h"
+#include "write_bin_fabric_key.h"
+
+/********************************************************************
+ * A writer to output a fabric key to binary format
+ *
+ * Return 0 if successful
+ * Return 1 if there are more serious bugs in the architecture 
+ * Return 2 if fail when creating files
+ *******************************************************************/
+int write_bin_fabric_key(const char* fname,
+                         const FabricKey& fabric_key) {
+
+  vtr::ScopedStartFinishTimer timer("Write Fabric Key binary file");
+
+  return write_fabric_key_in_format(fname, fabric_key, FABRIC_KEY_FORMAT_BIN);
+}
@@ -0,0 +1,15 @@
+#ifndef WRITE_BIN_FABRIC_KEY_H
+#define WRITE_BIN_FABRIC_KEY_H
+
+/********************************************************************
+ * Include header files that are required by function declaration
+ *******************************************************************/
+#include "fabric_key.h"
+
+/********************************************************************
+ * Function declaration
+ *******************************************************************/
+int write_bin_fabric_key(const char* fname,
+                         const FabricKey& fabric_key);
+
+#endif
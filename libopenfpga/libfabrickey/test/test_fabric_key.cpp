@@ -3,6 +3,8 @@
  * 1. parser of data structures
  * 2. writer of data structures
  *******************************************************************/
+#include <string>
+
 /* Headers from vtrutils */
 #include "vtr_assert.h"
 #include "vtr_log.h"
@@ -10,6 +12,8 @@
 /* Headers from fabric key */
 #include "read_xml_fabric_key.h"
 #include "write_xml_fabric_key.h"
+#include "read_bin_fabric_key.h"
+#include "write_bin_fabric_key.h"
 
 int main(int argc, const char** argv) {
   /* Ensure we have only one or two argument */
@@ -23,11 +27,36 @@ int main(int argc, const char** argv) {
 
   /* Output the circuit library to an XML file
    * This is optional only used when there is a second argument
+   * A file with the extension '.bin' is written in binary format
+   * and read back, which should give the same keys
    */
   if (3 <= argc) { 
-    write_xml_fabric_key(argv[2], test_key);
-    VTR_LOG("Echo the fabric key to an XML file: %s.\n",
-            argv[2]);
+    std::string out_fname(argv[2]);
+    if ( (4 < out_fname.size())
+      && (std::string(".bin") == out_fname.substr(out_fname.size() - 4)) ) {
+      int err_code = write_bin_fabric_key(argv[2], test_key);
+      VTR_ASSERT(0 == err_code);
+      VTR_LOG("Echo the fabric key to a binary file: %s.\n",
+              argv[2]);
+
+      FabricKey bin_key = read_bin_fabric_key(argv[2]);
+      VTR_ASSERT(bin_key.regions().size() == test_key.regions().size());
+      VTR_ASSERT(bin_key.keys().size() == test_key.keys().size());
+      for (const FabricRegionId& region : test_key.regions()) {
+        VTR_ASSERT(bin_key.region_keys(region) == test_key.region_keys(region));
+      }
+      for (const FabricKeyId& key : test_key.keys()) {
+        VTR_ASSERT(bin_key.key_name(key) == test_key.key_name(key));
+        VTR_ASSERT(bin_key.key_value(key) == test_key.key_value(key));
+        VTR_ASSERT(bin_key.key_alias(key) == test_key.key_alias(key));
+      }
+      VTR_LOG("Read back the same fabric key from the binary file: %s.\n",
+              argv[2]);
+    } else {
+      write_xml_fabric_key(argv[2], test_key);
+      VTR_LOG("Echo the fabric key to an XML file: %s.\n",
+              argv[2]);
+    }
   }
 }
 
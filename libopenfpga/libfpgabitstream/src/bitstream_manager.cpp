@@ -2,8 +2,11 @@
  * This file includes member functions for data structure BitstreamManager 
  ******************************************************************************/
 #include <algorithm>
+#include <set>
 
 #include "vtr_assert.h"
+#include "openfpga_memory_usage.h"
+#include "openfpga_hot_path_counters.h"
 #include "bitstream_manager.h"
 
 /* begin namespace openfpga */
@@ -17,6 +20,9 @@ BitstreamManager::BitstreamManager() {
   num_bits_ = 0;
   invalid_block_ids_.clear();
   invalid_bit_ids_.clear();
+
+  /* The empty string is the default of all the blocks */
+  intern_string(std::string());
 }
 
 /**************************************************
@@ -49,21 +55,30 @@ bool BitstreamManager::bit_value(const ConfigBitId& bit_id) const {
   /* Ensure a valid id */
   VTR_ASSERT(true == valid_bit_id(bit_id));
 
-  return '1' == bit_values_[bit_id];
+  return bit_values_[bit_id];
 }
 
 ConfigBlockId BitstreamManager::bit_parent_block(const ConfigBitId& bit_id) const {
   /* Ensure a valid id */
   VTR_ASSERT(true == valid_bit_id(bit_id));
 
-  return bit_parent_blocks_[bit_id];
+  /* Find the last block whose lsb is no larger than the bit id */
+  std::vector<ConfigBlockId>::const_iterator it = std::upper_bound(bit_blocks_.begin(), bit_blocks_.end(), size_t(bit_id),
+                                                                   [&](const size_t& bit, const ConfigBlockId& block) {
+                                                                     return bit < block_bit_id_lsbs_[block];
+                                                                   });
+  VTR_ASSERT(it != bit_blocks_.begin());
+  ConfigBlockId parent_block = *(--it);
+  VTR_ASSERT(size_t(bit_id) < block_bit_id_lsbs_[parent_block] + block_bit_lengths_[parent_block]);
+
+  return parent_block;
 }
 
 std::string BitstreamManager::block_name(const ConfigBlockId& block_id) const {
   /* Ensure the input ids are valid */
   VTR_ASSERT(true == valid_block_id(block_id));
 
-  return block_names_[block_id];
+  return strings_[block_name_ids_[block_id]];
 }
 
 ConfigBlockId BitstreamManager::block_parent(const ConfigBlockId& block_id) const {
@@ -76,13 +91,26 @@ ConfigBlockId BitstreamManager::block_parent(const ConfigBlockId& block_id) cons
 std::vector<ConfigBlockId> BitstreamManager::block_children(const ConfigBlockId& block_id) const {
   /* Ensure the input ids are valid */
   VTR_ASSERT(true == valid_block_id(block_id));
+  /* The contents of shared blocks are in their shared bitstreams */
+  VTR_ASSERT_SAFE(false == is_shared_block(block_id));
+
+  return std::vector<ConfigBlockId>(child_block_ids_[block_id].begin(), child_block_ids_[block_id].end());
+}
+
+size_t BitstreamManager::num_block_children(const ConfigBlockId& block_id) const {
+  /* Ensure the input ids are valid */
+  VTR_ASSERT(true == valid_block_id(block_id));
+  /* The contents of shared blocks are in their shared bitstreams */
+  VTR_ASSERT_SAFE(false == is_shared_block(block_id));
 
-  return child_block_ids_[block_id];
+  return child_block_ids_[block_id].size();
 }
 
 std::vector<ConfigBitId> BitstreamManager::block_bits(const ConfigBlockId& block_id) const {
   /* Ensure the input ids are valid */
   VTR_ASSERT(true == valid_block_id(block_id));
+  /* The contents of shared blocks are in their shared bitstreams */
+  VTR_ASSERT_SAFE(false == is_shared_block(block_id));
 
   size_t lsb = block_bit_id_lsbs_[block_id]; 
   size_t length = block_bit_lengths_[block_id]; 
@@ -100,11 +128,21 @@ std::vector<ConfigBitId> BitstreamManager::block_bits(const ConfigBlockId& block
   return bits;
 }
 
+size_t BitstreamManager::num_block_bits(const ConfigBlockId& block_id) const {
+  /* Ensure the input ids are valid */
+  VTR_ASSERT(true == valid_block_id(block_id));
+  /* The contents of shared blocks are in their shared bitstreams */
+  VTR_ASSERT_SAFE(false == is_shared_block(block_id));
+
+  return block_bit_lengths_[block_id];
+}
+
 /* Find the child block in a bitstream manager with a given name */
 ConfigBlockId BitstreamManager::find_child_block(const ConfigBlockId& block_id, 
                                                  const std::string& child_block_name) const {
   /* Ensure the input ids are valid */
   VTR_ASSERT(true == valid_block_id(block_id));
+  OPENFPGA_COUNT_HOT_PATH_CALL(HOT_PATH_FIND_CHILD_BLOCK);
 
   std::vector<ConfigBlockId> candidates;
 
@@ -113,6 +151,7 @@ ConfigBlockId BitstreamManager::find_child_block(const ConfigBlockId& block_id,
       candidates.push_back(child);
     }
   }
+  OPENFPGA_COUNT_HOT_PATH_BYTES(HOT_PATH_FIND_CHILD_BLOCK, candidates.capacity() * sizeof(ConfigBlockId));
 
   /* We should have 0 or 1 candidate! */
   VTR_ASSERT(0 == candidates.size() || 1 == candidates.size());
@@ -120,6 +159,7 @@ ConfigBlockId BitstreamManager::find_child_block(const ConfigBlockId& block_id,
     /* Not found, return an invalid value */
     return ConfigBlockId::INVALID();
   }
+  OPENFPGA_COUNT_HOT_PATH_HIT(HOT_PATH_FIND_CHILD_BLOCK);
   return candidates[0];
 }
 
@@ -134,36 +174,100 @@ std::string BitstreamManager::block_input_net_ids(const ConfigBlockId& block_id)
   /* Ensure the input ids are valid */
   VTR_ASSERT(true == valid_block_id(block_id));
 
-  return block_input_net_ids_[block_id];
+  return strings_[block_input_net_ids_[block_id]];
 }
 
 std::string BitstreamManager::block_output_net_ids(const ConfigBlockId& block_id) const {
   /* Ensure the input ids are valid */
   VTR_ASSERT(true == valid_block_id(block_id));
 
-  return block_output_net_ids_[block_id];
+  return strings_[block_output_net_ids_[block_id]];
+}
+
+bool BitstreamManager::is_shared_block(const ConfigBlockId& block_id) const {
+  /* Ensure the input ids are valid */
+  VTR_ASSERT(true == valid_block_id(block_id));
+
+  return 0 < shared_blocks_.count(block_id);
+}
+
+const std::shared_ptr<const BitstreamManager>& BitstreamManager::shared_block_bitstream(const ConfigBlockId& block_id) const {
+  /* Ensure the input ids are valid */
+  VTR_ASSERT(true == is_shared_block(block_id));
+
+  return shared_blocks_.at(block_id).bitstream;
+}
+
+ConfigBlockId BitstreamManager::shared_block_source(const ConfigBlockId& block_id) const {
+  /* Ensure the input ids are valid */
+  VTR_ASSERT(true == is_shared_block(block_id));
+
+  return shared_blocks_.at(block_id).source_block;
+}
+
+bool BitstreamManager::has_shared_blocks() const {
+  return false == shared_blocks_.empty();
+}
+
+size_t BitstreamManager::memory_usage() const {
+  /* Shared bitstreams are counted once */
+  size_t shared_bitstream_bytes = 0;
+  std::set<const BitstreamManager*> shared_bitstreams;
+  for (const auto& shared_block : shared_blocks_) {
+    if (true == shared_bitstreams.insert(shared_block.second.bitstream.get()).second) {
+      shared_bitstream_bytes += sizeof(BitstreamManager) + shared_block.second.bitstream->memory_usage();
+    }
+  }
+
+  return shared_bitstream_bytes
+       + openfpga::memory_usage(shared_blocks_)
+       + openfpga::memory_usage(invalid_block_ids_)
+       + openfpga::memory_usage(block_bit_id_lsbs_)
+       + openfpga::memory_usage(block_bit_lengths_)
+       + openfpga::memory_usage(block_name_ids_)
+       + openfpga::memory_usage(parent_block_ids_)
+       + openfpga::memory_usage(child_block_ids_)
+       + openfpga::memory_usage(block_path_ids_)
+       + openfpga::memory_usage(block_input_net_ids_)
+       + openfpga::memory_usage(block_output_net_ids_)
+       + openfpga::memory_usage(strings_)
+       + openfpga::memory_usage(string_ids_)
+       + openfpga::memory_usage(invalid_bit_ids_)
+       + openfpga::memory_usage(bit_values_)
+       + openfpga::memory_usage(bit_blocks_);
 }
 
 /******************************************************************************
  * Public Mutators
  ******************************************************************************/
 ConfigBitId BitstreamManager::add_bit(const ConfigBlockId& parent_block, const bool& bit_value) {
+  /* Ensure the input ids are valid */
+  VTR_ASSERT(true == valid_block_id(parent_block));
+
   ConfigBitId bit = ConfigBitId(num_bits_);
-  /* Add a new bit, and allocate associated data structures */
-  num_bits_++;
-  if (true == bit_value) {
-    bit_values_.push_back('1');
+
+  /* The parent block of a bit is derived from the bit range of blocks.
+   * Therefore, a bit can only be added to a block without bits,
+   * or to the last block whose bit range ends at the new bit
+   */
+  if (0 == block_bit_lengths_[parent_block]) {
+    block_bit_id_lsbs_[parent_block] = num_bits_;
+    bit_blocks_.push_back(parent_block);
   } else {
-    bit_values_.push_back('0');
+    VTR_ASSERT(parent_block == bit_blocks_.back());
+    VTR_ASSERT(num_bits_ == block_bit_id_lsbs_[parent_block] + block_bit_lengths_[parent_block]);
   }
+  block_bit_lengths_[parent_block]++;
 
-  bit_parent_blocks_.push_back(parent_block);
+  /* Add a new bit, and allocate associated data structures */
+  num_bits_++;
+  bit_values_.push_back(bit_value);
 
   return bit; 
 }
 
 void BitstreamManager::reserve_blocks(const size_t& num_blocks) {
-  block_names_.reserve(num_blocks);
+  block_name_ids_.reserve(num_blocks);
   block_bit_id_lsbs_.reserve(num_blocks);
   block_bit_lengths_.reserve(num_blocks);
   block_path_ids_.reserve(num_blocks);
@@ -177,16 +281,21 @@ void BitstreamManager::reserve_bits(const size_t& num_bits) {
   bit_values_.reserve(num_bits);
 }
 
+void BitstreamManager::reserve_block_names(const size_t& num_names) {
+  strings_.reserve(num_names);
+  string_ids_.reserve(num_names);
+}
+
 ConfigBlockId BitstreamManager::create_block() {
   ConfigBlockId block = ConfigBlockId(num_blocks_);
   /* Add a new bit, and allocate associated data structures */
   num_blocks_++;
-  block_names_.emplace_back();
+  block_name_ids_.push_back(0);
   block_bit_id_lsbs_.emplace_back(-1);
   block_bit_lengths_.emplace_back(0);
   block_path_ids_.push_back(-2);
-  block_input_net_ids_.emplace_back();
-  block_output_net_ids_.emplace_back();
+  block_input_net_ids_.push_back(0);
+  block_output_net_ids_.push_back(0);
   parent_block_ids_.push_back(ConfigBlockId::INVALID());
   child_block_ids_.emplace_back();
 
@@ -204,7 +313,7 @@ void BitstreamManager::set_block_name(const ConfigBlockId& block_id,
                                       const std::string& block_name) {
   /* Ensure the input ids are valid */
   VTR_ASSERT(true == valid_block_id(block_id));
-  block_names_[block_id] = block_name;
+  block_name_ids_[block_id] = intern_string(block_name);
 }
 
 void BitstreamManager::reserve_child_blocks(const ConfigBlockId& parent_block,
@@ -225,7 +334,7 @@ void BitstreamManager::add_child_block(const ConfigBlockId& parent_block, const
   VTR_ASSERT(ConfigBlockId::INVALID() == parent_block_ids_[child_block]);
 
   /* Ensure the child block is not in the list of children of the parent block */
-  std::vector<ConfigBlockId>::iterator it = std::find(child_block_ids_[parent_block].begin(), child_block_ids_[parent_block].end(), child_block);
+  auto it = std::find(child_block_ids_[parent_block].begin(), child_block_ids_[parent_block].end(), child_block);
   VTR_ASSERT(it == child_block_ids_[parent_block].end());
 
   /* Add the child_block to the parent_block */
@@ -239,12 +348,20 @@ void BitstreamManager::add_block_bits(const ConfigBlockId& block,
   /* Ensure the input ids are valid */
   VTR_ASSERT(true == valid_block_id(block));
 
+  /* The bits of a block can be added only once */
+  VTR_ASSERT(0 == block_bit_lengths_[block]);
+
+  if (true == block_bitstream.empty()) {
+    return;
+  }
+
   /* Add the bit to the block, record anchors in bit indexing for block-level searching */
   block_bit_id_lsbs_[block] = num_bits_;
   block_bit_lengths_[block] = block_bitstream.size();
-  for (const bool& bit : block_bitstream) {
-    add_bit(block, bit);
-  }
+  bit_blocks_.push_back(block);
+
+  num_bits_ += block_bitstream.size();
+  bit_values_.insert(bit_values_.end(), block_bitstream.begin(), block_bitstream.end());
 }
 
 void BitstreamManager::add_path_id_to_block(const ConfigBlockId& block, const int& path_id) {
@@ -261,7 +378,7 @@ void BitstreamManager::add_input_net_id_to_block(const ConfigBlockId& block,
   VTR_ASSERT(true == valid_block_id(block));
 
   /* Add the bit to the block */
-  block_input_net_ids_[block] = input_net_id;
+  block_input_net_ids_[block] = intern_string(input_net_id);
 }
 
 void BitstreamManager::add_output_net_id_to_block(const ConfigBlockId& block,
@@ -270,7 +387,322 @@ void BitstreamManager::add_output_net_id_to_block(const ConfigBlockId& block,
   VTR_ASSERT(true == valid_block_id(block));
 
   /* Add the bit to the block */
-  block_output_net_ids_[block] = output_net_id;
+  block_output_net_ids_[block] = intern_string(output_net_id);
+}
+
+void BitstreamManager::add_sub_bitstream(const ConfigBlockId& parent_block,
+                                         const BitstreamManager& sub_bitstream,
+                                         const ConfigBlockId& sub_root_block) {
+  /* Ensure the input ids are valid */
+  VTR_ASSERT(true == valid_block_id(parent_block));
+  VTR_ASSERT(true == sub_bitstream.valid_block_id(sub_root_block));
+  /* The root block is a placeholder, which should not contain any bit */
+  VTR_ASSERT(0 == sub_bitstream.block_bit_lengths_[sub_root_block]);
+  VTR_ASSERT(false == sub_bitstream.has_shared_blocks());
+
+  /* Map the block ids of the sub bitstream to the block ids in this bitstream manager */
+  vtr::vector<ConfigBlockId, ConfigBlockId> block_id_map(sub_bitstream.num_blocks(), ConfigBlockId::INVALID());
+  block_id_map[sub_root_block] = parent_block;
+
+  /* Map the strings of the sub bitstream to the strings in this bitstream manager */
+  std::vector<uint32_t> string_id_map;
+  string_id_map.reserve(sub_bitstream.strings_.size());
+  for (const std::string& sub_string : sub_bitstream.strings_) {
+    string_id_map.push_back(intern_string(sub_string));
+  }
+
+  for (size_t iblk = 0; iblk < sub_bitstream.num_blocks(); ++iblk) {
+    ConfigBlockId sub_block = ConfigBlockId(iblk);
+    if (sub_block == sub_root_block) {
+      continue;
+    }
+    /* Each block must be a descendant of the root block, whose parent has been added already */
+    ConfigBlockId sub_parent_block = sub_bitstream.parent_block_ids_[sub_block];
+    VTR_ASSERT(true == sub_bitstream.valid_block_id(sub_parent_block));
+    VTR_ASSERT(size_t(sub_parent_block) < iblk || sub_parent_block == sub_root_block);
+
+    ConfigBlockId block = create_block();
+    block_name_ids_[block] = string_id_map[sub_bitstream.block_name_ids_[sub_block]];
+    block_id_map[sub_block] = block;
+    reserve_child_blocks(block, sub_bitstream.child_block_ids_[sub_block].size());
+    add_child_block(block_id_map[sub_parent_block], block);
+
+    block_path_ids_[block] = sub_bitstream.block_path_ids_[sub_block];
+    block_input_net_ids_[block] = string_id_map[sub_bitstream.block_input_net_ids_[sub_block]];
+    block_output_net_ids_[block] = string_id_map[sub_bitstream.block_output_net_ids_[sub_block]];
+  }
+
+  /* Bits are appended in their original order, so the lsb of each block is simply shifted */
+  size_t bit_id_offset = num_bits_;
+  for (const ConfigBlockId& sub_block : sub_bitstream.bit_blocks_) {
+    ConfigBlockId block = block_id_map[sub_block];
+    block_bit_id_lsbs_[block] = sub_bitstream.block_bit_id_lsbs_[sub_block] + bit_id_offset;
+    block_bit_lengths_[block] = sub_bitstream.block_bit_lengths_[sub_block];
+    bit_blocks_.push_back(block);
+  }
+  num_bits_ += sub_bitstream.num_bits();
+  bit_values_.insert(bit_values_.end(), sub_bitstream.bit_values_.begin(), sub_bitstream.bit_values_.end());
+}
+
+ConfigBlockId BitstreamManager::add_shared_block(const ConfigBlockId& parent_block,
+                                                 const std::string& block_name,
+                                                 const std::shared_ptr<const BitstreamManager>& shared_bitstream,
+                                                 const ConfigBlockId& shared_source_block) {
+  /* Ensure the input ids are valid */
+  VTR_ASSERT(true == valid_block_id(parent_block));
+  VTR_ASSERT(nullptr != shared_bitstream);
+  VTR_ASSERT(true == shared_bitstream->valid_block_id(shared_source_block));
+  /* Shared bitstreams are not nested */
+  VTR_ASSERT(false == shared_bitstream->has_shared_blocks());
+
+  ConfigBlockId block = add_block(block_name);
+  add_child_block(parent_block, block);
+
+  t_shared_block& shared_block = shared_blocks_[block];
+  shared_block.bitstream = shared_bitstream;
+  shared_block.source_block = shared_source_block;
+  shared_block.bit_id_lsb = num_bits_;
+
+  return block;
+}
+
+void BitstreamManager::materialize_shared_blocks() {
+  if (true == shared_blocks_.empty()) {
+    return;
+  }
+
+  /* The descendants of the source block of each shared block, in the order of their ids,
+   * which are the blocks copied after the shared block
+   * The offset of each block from the shared block is the index in the list plus 1
+   */
+  std::map<std::pair<const BitstreamManager*, ConfigBlockId>, std::vector<ConfigBlockId>> shared_subtrees;
+  std::map<std::pair<const BitstreamManager*, ConfigBlockId>, vtr::vector<ConfigBlockId, size_t>> shared_subtree_offsets;
+  size_t num_flat_blocks = num_blocks_;
+  size_t num_flat_bits = num_bits_;
+  for (const auto& shared_block : shared_blocks_) {
+    const BitstreamManager& shared_bitstream = *(shared_block.second.bitstream);
+    std::pair<const BitstreamManager*, ConfigBlockId> subtree_key(&shared_bitstream, shared_block.second.source_block);
+    if (0 == shared_subtrees.count(subtree_key)) {
+      vtr::vector<ConfigBlockId, size_t>& offsets = shared_subtree_offsets[subtree_key];
+      offsets.resize(shared_bitstream.num_blocks(), 0);
+      std::vector<bool> in_subtree(shared_bitstream.num_blocks(), false);
+      std::vector<ConfigBlockId> block_stack(1, shared_block.second.source_block);
+      while (false == block_stack.empty()) {
+        ConfigBlockId cur_block = block_stack.back();
+        block_stack.pop_back();
+        for (const ConfigBlockId& child_block : shared_bitstream.child_block_ids_[cur_block]) {
+          in_subtree[size_t(child_block)] = true;
+          block_stack.push_back(child_block);
+        }
+      }
+      std::vector<ConfigBlockId>& subtree = shared_subtrees[subtree_key];
+      for (const ConfigBlockId& cand_block : shared_bitstream.blocks()) {
+        if (true == in_subtree[size_t(cand_block)]) {
+          subtree.push_back(cand_block);
+          offsets[cand_block] = subtree.size();
+        }
+      }
+    }
+    num_flat_blocks += shared_subtrees[subtree_key].size();
+    for (const ConfigBlockId& subtree_block : shared_subtrees[subtree_key]) {
+      num_flat_bits += shared_bitstream.block_bit_lengths_[subtree_block];
+    }
+    num_flat_bits += shared_bitstream.block_bit_lengths_[shared_block.second.source_block];
+  }
+
+  BitstreamManager flat_bitstream;
+  flat_bitstream.reserve_blocks(num_flat_blocks);
+  flat_bitstream.reserve_bits(num_flat_bits);
+  /* Strings are kept with the same ids, while those of shared bitstreams are added */
+  flat_bitstream.strings_ = strings_;
+  flat_bitstream.string_ids_ = string_ids_;
+  std::map<const BitstreamManager*, std::vector<uint32_t>> shared_string_id_maps;
+
+  /* Create the blocks, where each shared block is followed by the copy of its descendants */
+  vtr::vector<ConfigBlockId, ConfigBlockId> block_id_map(num_blocks_, ConfigBlockId::INVALID());
+  for (const ConfigBlockId& block : blocks()) {
+    ConfigBlockId flat_block = flat_bitstream.create_block();
+    block_id_map[block] = flat_block;
+    flat_bitstream.block_name_ids_[flat_block] = block_name_ids_[block];
+    flat_bitstream.parent_block_ids_[flat_block] = parent_block_ids_[block];
+
+    auto shared_result = shared_blocks_.find(block);
+    if (shared_result == shared_blocks_.end()) {
+      flat_bitstream.block_path_ids_[flat_block] = block_path_ids_[block];
+      flat_bitstream.block_input_net_ids_[flat_block] = block_input_net_ids_[block];
+      flat_bitstream.block_output_net_ids_[flat_block] = block_output_net_ids_[block];
+      flat_bitstream.child_block_ids_[flat_block] = child_block_ids_[block];
+      continue;
+    }
+
+    const BitstreamManager& shared_bitstream = *(shared_result->second.bitstream);
+    const ConfigBlockId& source_block = shared_result->second.source_block;
+    std::pair<const BitstreamManager*, ConfigBlockId> subtree_key(&shared_bitstream, source_block);
+    const std::vector<ConfigBlockId>& subtree = shared_subtrees.at(subtree_key);
+    const vtr::vector<ConfigBlockId, size_t>& offsets = shared_subtree_offsets.at(subtree_key);
+
+    std::vector<uint32_t>& string_id_map = shared_string_id_maps[&shared_bitstream];
+    if (true == string_id_map.empty()) {
+      string_id_map.reserve(shared_bitstream.strings_.size());
+      for (const std::string& shared_string : shared_bitstream.strings_) {
+        string_id_map.push_back(flat_bitstream.intern_string(shared_string));
+      }
+    }
+
+    /* The source block is copied to the shared block, except its name */
+    flat_bitstream.block_path_ids_[flat_block] = shared_bitstream.block_path_ids_[source_block];
+    flat_bitstream.block_input_net_ids_[flat_block] = string_id_map[shared_bitstream.block_input_net_ids_[source_block]];
+    flat_bitstream.block_output_net_ids_[flat_block] = string_id_map[shared_bitstream.block_output_net_ids_[source_block]];
+    for (const ConfigBlockId& shared_child_block : shared_bitstream.child_block_ids_[source_block]) {
+      flat_bitstream.child_block_ids_[flat_block].push_back(ConfigBlockId(size_t(flat_block) + offsets[shared_child_block]));
+    }
+
+    for (const ConfigBlockId& shared_subtree_block : subtree) {
+      ConfigBlockId flat_subtree_block = flat_bitstream.create_block();
+      VTR_ASSERT(size_t(flat_subtree_block) == size_t(flat_block) + offsets[shared_subtree_block]);
+      ConfigBlockId shared_parent_block = shared_bitstream.parent_block_ids_[shared_subtree_block];
+      flat_bitstream.parent_block_ids_[flat_subtree_block] = (shared_parent_block == source_block) ? flat_block : ConfigBlockId(size_t(flat_block) + offsets[shared_parent_block]);
+      flat_bitstream.block_name_ids_[flat_subtree_block] = string_id_map[shared_bitstream.block_name_ids_[shared_subtree_block]];
+      flat_bitstream.block_path_ids_[flat_subtree_block] = shared_bitstream.block_path_ids_[shared_subtree_block];
+      flat_bitstream.block_input_net_ids_[flat_subtree_block] = string_id_map[shared_bitstream.block_input_net_ids_[shared_subtree_block]];
+      flat_bitstream.block_output_net_ids_[flat_subtree_block] = string_id_map[shared_bitstream.block_output_net_ids_[shared_subtree_block]];
+      flat_bitstream.child_block_ids_[flat_subtree_block].reserve(shared_bitstream.child_block_ids_[shared_subtree_block].size());
+      for (const ConfigBlockId& shared_child_block : shared_bitstream.child_block_ids_[shared_subtree_block]) {
+        flat_bitstream.child_block_ids_[flat_subtree_block].push_back(ConfigBlockId(size_t(flat_block) + offsets[shared_child_block]));
+      }
+    }
+  }
+
+  /* Renumber the parent and child blocks of the blocks which are not copied */
+  for (const ConfigBlockId& block : blocks()) {
+    ConfigBlockId flat_block = block_id_map[block];
+    if (ConfigBlockId::INVALID() != parent_block_ids_[block]) {
+      flat_bitstream.parent_block_ids_[flat_block] = block_id_map[parent_block_ids_[block]];
+    }
+    if (0 < shared_blocks_.count(block)) {
+      continue;
+    }
+    for (ConfigBlockId& child_block : flat_bitstream.child_block_ids_[flat_block]) {
+      child_block = block_id_map[child_block];
+    }
+  }
+
+  /* Add the bits in the order they were added, where the bits of a shared block
+   * are put before the bits of any block added after the shared block
+   */
+  auto shared_it = shared_blocks_.begin();
+  size_t ibit_block = 0;
+  while ( (shared_it != shared_blocks_.end())
+       || (ibit_block < bit_blocks_.size()) ) {
+    if ( (ibit_block < bit_blocks_.size())
+      && ( (shared_it == shared_blocks_.end())
+        || (shared_it->second.bit_id_lsb > block_bit_id_lsbs_[bit_blocks_[ibit_block]]) ) ) {
+      const ConfigBlockId& block = bit_blocks_[ibit_block];
+      size_t lsb = block_bit_id_lsbs_[block];
+      flat_bitstream.add_block_bits(block_id_map[block],
+                                    std::vector<bool>(bit_values_.begin() + lsb,
+                                                      bit_values_.begin() + lsb + block_bit_lengths_[block]));
+      ++ibit_block;
+      continue;
+    }
+
+    const BitstreamManager& shared_bitstream = *(shared_it->second.bitstream);
+    const ConfigBlockId& source_block = shared_it->second.source_block;
+    const vtr::vector<ConfigBlockId, size_t>& offsets = shared_subtree_offsets.at(std::make_pair(&shared_bitstream, source_block));
+    ConfigBlockId flat_block = block_id_map[shared_it->first];
+    for (const ConfigBlockId& shared_bit_block : shared_bitstream.bit_blocks_) {
+      ConfigBlockId flat_bit_block = flat_block;
+      if (shared_bit_block != source_block) {
+        if (0 == offsets[shared_bit_block]) {
+          /* Not a descendant of the source block */
+          continue;
+        }
+        flat_bit_block = ConfigBlockId(size_t(flat_block) + offsets[shared_bit_block]);
+      }
+      size_t lsb = shared_bitstream.block_bit_id_lsbs_[shared_bit_block];
+      flat_bitstream.add_block_bits(flat_bit_block,
+                                    std::vector<bool>(shared_bitstream.bit_values_.begin() + lsb,
+                                                      shared_bitstream.bit_values_.begin() + lsb + shared_bitstream.block_bit_lengths_[shared_bit_block]));
+    }
+    ++shared_it;
+  }
+
+  VTR_ASSERT(num_flat_blocks == flat_bitstream.num_blocks());
+  VTR_ASSERT(num_flat_bits == flat_bitstream.num_bits());
+
+  *this = std::move(flat_bitstream);
+}
+
+size_t BitstreamManager::overwrite_block_bitstream(const ConfigBlockId& block,
+                                                   const BitstreamManager& src_bitstream,
+                                                   const ConfigBlockId& src_block) {
+  /* Ensure the input ids are valid */
+  VTR_ASSERT(true == valid_block_id(block));
+  VTR_ASSERT(true == src_bitstream.valid_block_id(src_block));
+  /* Shared blocks should be materialized before being modified */
+  VTR_ASSERT(false == is_shared_block(block));
+  VTR_ASSERT(false == src_bitstream.is_shared_block(src_block));
+
+  /* The hierarchy should be the same */
+  VTR_ASSERT(block_name(block) == src_bitstream.block_name(src_block));
+  VTR_ASSERT(child_block_ids_[block].size() == src_bitstream.child_block_ids_[src_block].size());
+  VTR_ASSERT(block_bit_lengths_[block] == src_bitstream.block_bit_lengths_[src_block]);
+
+  block_path_ids_[block] = src_bitstream.block_path_ids_[src_block];
+  block_input_net_ids_[block] = intern_string(src_bitstream.block_input_net_ids(src_block));
+  block_output_net_ids_[block] = intern_string(src_bitstream.block_output_net_ids(src_block));
+
+  size_t num_changed_bits = 0;
+  for (short ibit = 0; ibit < block_bit_lengths_[block]; ++ibit) {
+    ConfigBitId bit = ConfigBitId(block_bit_id_lsbs_[block] + ibit);
+    bool src_bit_value = src_bitstream.bit_values_[ConfigBitId(src_bitstream.block_bit_id_lsbs_[src_block] + ibit)];
+    if (src_bit_value != bit_values_[bit]) {
+      bit_values_[bit] = src_bit_value;
+      num_changed_bits++;
+    }
+  }
+
+  for (size_t ichild = 0; ichild < child_block_ids_[block].size(); ++ichild) {
+    num_changed_bits += overwrite_block_bitstream(child_block_ids_[block][ichild],
+                                                  src_bitstream,
+                                                  src_bitstream.child_block_ids_[src_block][ichild]);
+  }
+
+  return num_changed_bits;
+}
+
+void BitstreamManager::shrink_to_fit() {
+  block_bit_id_lsbs_.shrink_to_fit();
+  block_bit_lengths_.shrink_to_fit();
+  block_name_ids_.shrink_to_fit();
+  parent_block_ids_.shrink_to_fit();
+  for (vtr::small_vector<ConfigBlockId>& child_blocks : child_block_ids_) {
+    child_blocks.shrink_to_fit();
+  }
+  child_block_ids_.shrink_to_fit();
+  block_path_ids_.shrink_to_fit();
+  block_input_net_ids_.shrink_to_fit();
+  block_output_net_ids_.shrink_to_fit();
+  strings_.shrink_to_fit();
+  bit_values_.shrink_to_fit();
+  bit_blocks_.shrink_to_fit();
+}
+
+/******************************************************************************
+ * Private Mutators
+ ******************************************************************************/
+uint32_t BitstreamManager::intern_string(const std::string& str) {
+  std::unordered_map<std::string, uint32_t>::const_iterator it = string_ids_.find(str);
+  if (it != string_ids_.end()) {
+    return it->second;
+  }
+
+  VTR_ASSERT(strings_.size() < UINT32_MAX);
+  uint32_t string_id = strings_.size();
+  strings_.push_back(str);
+  string_ids_[str] = string_id;
+
+  return string_id;
 }
 
 /******************************************************************************
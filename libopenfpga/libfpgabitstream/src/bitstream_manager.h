@@ -29,16 +29,31 @@
  * 1. Each block inside BitstreamManager should have only 1 parent block 
  *    and multiple child block
  * 2. Each bit inside BitstreamManager should have only 1 parent block 
+ *
+ * Shared blocks
+ * -------------
+ * Many blocks, e.g., the unused grids of the same type, have exactly the same
+ * contents. Such a block can be added as a shared block, which refers to a block
+ * of another bitstream manager (the shared bitstream) for its child blocks, bits,
+ * path id and net ids, while only its name is stored in this bitstream manager.
+ * The shared bitstream is stored once, whatever the number of blocks referring to it.
+ * The contents of shared blocks are not visible through the accessors of blocks and bits,
+ * so the bitstream manager should be materialized, i.e., each shared block
+ * gets its own copy of the contents, before visiting all the blocks or bits.
  * 
  ******************************************************************************/
 #ifndef BITSTREAM_MANAGER_H
 #define BITSTREAM_MANAGER_H
 
+#include <cstdint>
+#include <string>
 #include <vector>
 #include <map>
-#include <unordered_set>
+#include <memory>
 #include <unordered_map>
 #include "vtr_vector.h"
+#include "vtr_small_vector.h"
+#include "vtr_lazy_id_iterator.h"
 
 #include "bitstream_manager_fwd.h"
 
@@ -46,63 +61,12 @@
 namespace openfpga {
 
 class BitstreamManager {
-  public: /* Type implementations */
-    /*
-     * This class (forward delcared above) is a template used to represent a lazily calculated 
-     * iterator of the specified ID type. The key assumption made is that the ID space is 
-     * contiguous and can be walked by incrementing the underlying ID value. To account for 
-     * invalid IDs, it keeps a reference to the invalid ID set and returns ID::INVALID() for
-     * ID values in the set.
-     *
-     * It is used to lazily create an iteration range (e.g. as returned by RRGraph::edges() RRGraph::nodes())
-     * just based on the count of allocated elements (i.e. RRGraph::num_nodes_ or RRGraph::num_edges_),
-     * and the set of any invalid IDs (i.e. RRGraph::invalid_node_ids_, RRGraph::invalid_edge_ids_).
-     */
-    template<class ID>
-    class lazy_id_iterator : public std::iterator<std::bidirectional_iterator_tag, ID> {
-      public:
-        //Since we pass ID as a template to std::iterator we need to use an explicit 'typename'
-        //to bring the value_type and iterator names into scope
-        typedef typename std::iterator<std::bidirectional_iterator_tag, ID>::value_type value_type;
-        typedef typename std::iterator<std::bidirectional_iterator_tag, ID>::iterator iterator;
-
-        lazy_id_iterator(value_type init, const std::unordered_set<ID>& invalid_ids)
-            : value_(init)
-            , invalid_ids_(invalid_ids) {}
-
-        //Advance to the next ID value
-        iterator operator++() {
-            value_ = ID(size_t(value_) + 1);
-            return *this;
-        }
-
-        //Advance to the previous ID value
-        iterator operator--() {
-            value_ = ID(size_t(value_) - 1);
-            return *this;
-        }
-
-        //Dereference the iterator
-        value_type operator*() const { return (invalid_ids_.count(value_)) ? ID::INVALID() : value_; }
-
-        friend bool operator==(const lazy_id_iterator<ID> lhs, const lazy_id_iterator<ID> rhs) { return lhs.value_ == rhs.value_; }
-        friend bool operator!=(const lazy_id_iterator<ID> lhs, const lazy_id_iterator<ID> rhs) { return !(lhs == rhs); }
-
-      private:
-        value_type value_;
-        const std::unordered_set<ID>& invalid_ids_;
-    };
-
   public: /* Public constructor */
     BitstreamManager();
 
   public: /* Types and ranges */
-    //Lazy iterator utility forward declaration
-    template<class ID>
-    class lazy_id_iterator;
-
-    typedef lazy_id_iterator<ConfigBitId> config_bit_iterator;
-    typedef lazy_id_iterator<ConfigBlockId> config_block_iterator;
+    typedef vtr::lazy_id_iterator<ConfigBitId> config_bit_iterator;
+    typedef vtr::lazy_id_iterator<ConfigBlockId> config_block_iterator;
 
     typedef vtr::Range<config_bit_iterator> config_bit_range;
     typedef vtr::Range<config_block_iterator> config_block_range;
@@ -131,9 +95,15 @@ class BitstreamManager {
     /* Find the children of a block */
     std::vector<ConfigBlockId> block_children(const ConfigBlockId& block_id) const;
 
+    /* Find the number of children of a block */
+    size_t num_block_children(const ConfigBlockId& block_id) const;
+
     /* Find all the bits that belong to a block */
     std::vector<ConfigBitId> block_bits(const ConfigBlockId& block_id) const;
 
+    /* Find the number of bits that belong to a block */
+    size_t num_block_bits(const ConfigBlockId& block_id) const;
+
     /* Find the child block in a bitstream manager with a given name */
     ConfigBlockId find_child_block(const ConfigBlockId& block_id, const std::string& child_block_name) const;
 
@@ -146,6 +116,23 @@ class BitstreamManager {
     /* Find input net ids of a block */
     std::string block_output_net_ids(const ConfigBlockId& block_id) const;
 
+    /* Find if a block refers to a block of a shared bitstream for its contents */
+    bool is_shared_block(const ConfigBlockId& block_id) const;
+
+    /* Find the shared bitstream which a shared block refers to */
+    const std::shared_ptr<const BitstreamManager>& shared_block_bitstream(const ConfigBlockId& block_id) const;
+
+    /* Find the block of the shared bitstream which a shared block refers to */
+    ConfigBlockId shared_block_source(const ConfigBlockId& block_id) const;
+
+    /* Find if any block is a shared block, i.e., the bitstream manager is not materialized */
+    bool has_shared_blocks() const;
+
+    /* Estimate the heap memory (in bytes) held by the bitstream database,
+     * where each shared bitstream is counted once
+     */
+    size_t memory_usage() const;
+
   public:  /* Public Mutators */
     /* Add a new configuration bit to the bitstream manager */
     ConfigBitId add_bit(const ConfigBlockId& parent_block, const bool& bit_value);
@@ -156,6 +143,9 @@ class BitstreamManager {
     /* Reserve memory for a number of bits */
     void reserve_bits(const size_t& num_bits);
 
+    /* Reserve memory for a number of unique names of blocks */
+    void reserve_block_names(const size_t& num_names);
+
     /* Create a new block of configuration bits */
     ConfigBlockId create_block();
 
@@ -186,6 +176,46 @@ class BitstreamManager {
     /* Add an output net id to a block */
     void add_output_net_id_to_block(const ConfigBlockId& block, const std::string& output_net_id);
 
+    /* Append all the blocks and bits under a root block of another bitstream manager
+     * to this bitstream manager. The child blocks of the root block will be
+     * added as the child blocks of the given parent block.
+     * Blocks and bits are added in the same order as they are in the sub bitstream,
+     * so that the result is the same as building them directly in this bitstream manager
+     */
+    void add_sub_bitstream(const ConfigBlockId& parent_block,
+                           const BitstreamManager& sub_bitstream,
+                           const ConfigBlockId& sub_root_block);
+
+    /* Add a block which refers to a block of a shared bitstream for its child blocks,
+     * bits, path id and net ids, which are not copied.
+     * The shared bitstream should not contain any shared block
+     */
+    ConfigBlockId add_shared_block(const ConfigBlockId& parent_block,
+                                   const std::string& block_name,
+                                   const std::shared_ptr<const BitstreamManager>& shared_bitstream,
+                                   const ConfigBlockId& shared_source_block);
+
+    /* Copy the contents of the shared bitstreams to each shared block.
+     * Blocks and bits are renumbered in the same order as if the contents were added
+     * by add_sub_bitstream() when each shared block was added
+     */
+    void materialize_shared_blocks();
+
+    /* Overwrite the bits, the path ids and the net ids of a block and all its descendants
+     * with those of a block of another bitstream manager, e.g., the same block built again
+     * from other implementation results. Both blocks should have the same hierarchy,
+     * i.e., the same names, child blocks and number of bits.
+     * Return the number of bits whose values are changed
+     */
+    size_t overwrite_block_bitstream(const ConfigBlockId& block,
+                                     const BitstreamManager& src_bitstream,
+                                     const ConfigBlockId& src_block);
+
+    /* Release the memory reserved but not used by the blocks and bits
+     * Call this only when the bitstream is finished
+     */
+    void shrink_to_fit();
+
   public:  /* Public Validators */
     bool valid_bit_id(const ConfigBitId& bit_id) const;
 
@@ -193,10 +223,14 @@ class BitstreamManager {
 
     bool valid_block_path_id(const ConfigBlockId& block_id) const;
 
+  private: /* Internal mutators */
+    /* Find the id of a string in the string pool, add it to the pool if not found */
+    uint32_t intern_string(const std::string& str);
+
   private: /* Internal data */
     /* Unique id of a block of bits in the Bitstream */
     size_t num_blocks_; 
-    std::unordered_set<ConfigBlockId> invalid_block_ids_;
+    vtr::tombstone_bitmap<ConfigBlockId> invalid_block_ids_;
     vtr::vector<ConfigBlockId, size_t> block_bit_id_lsbs_; 
     vtr::vector<ConfigBlockId, short> block_bit_lengths_; 
 
@@ -207,9 +241,9 @@ class BitstreamManager {
      * Note that the blocks here all unique, unlike ModuleManager where modules can be instanciated 
      * Therefore, this block graph can be considered as a flattened graph of ModuleGraph
      */
-    vtr::vector<ConfigBlockId, std::string> block_names_; 
+    vtr::vector<ConfigBlockId, uint32_t> block_name_ids_; 
     vtr::vector<ConfigBlockId, ConfigBlockId> parent_block_ids_; 
-    vtr::vector<ConfigBlockId, std::vector<ConfigBlockId>> child_block_ids_; 
+    vtr::vector<ConfigBlockId, vtr::small_vector<ConfigBlockId>> child_block_ids_; 
 
     /* The ids of the inputs of routing multiplexer blocks which is propagated to outputs 
      * By default, it will be -2 (which is invalid)
@@ -230,15 +264,41 @@ class BitstreamManager {
      *   -Bitstream manager will NOT check if the id is good for bitstream builders
      *    It just store the results
      */
-    vtr::vector<ConfigBlockId, std::string> block_input_net_ids_; 
-    vtr::vector<ConfigBlockId, std::string> block_output_net_ids_; 
+    vtr::vector<ConfigBlockId, uint32_t> block_input_net_ids_; 
+    vtr::vector<ConfigBlockId, uint32_t> block_output_net_ids_; 
+
+    /* Pool of the block names and the net ids, where each unique string is stored once.
+     * Blocks refer to the strings by their ids in the pool.
+     * Block names are mostly the instance names of memory modules, which are repeated
+     * in many tiles. The string pool is much smaller than storing a string for each block
+     * The first string of the pool is always empty, which is the default for all the blocks
+     */
+    std::vector<std::string> strings_;
+    std::unordered_map<std::string, uint32_t> string_ids_;
 
     /* Unique id of a bit in the Bitstream */
     size_t num_bits_; 
-    std::unordered_set<ConfigBitId> invalid_bit_ids_; 
-    /* value of a bit in the Bitstream */
-    vtr::vector<ConfigBitId, char> bit_values_;
-    vtr::vector<ConfigBitId, ConfigBlockId> bit_parent_blocks_;
+    vtr::tombstone_bitmap<ConfigBitId> invalid_bit_ids_; 
+    /* value of a bit in the Bitstream, packed in a bitset (1 bit per configuration bit) */
+    vtr::vector<ConfigBitId, bool> bit_values_;
+
+    /* Blocks which contain bits, in the sequence of their first bit.
+     * Bits of a block are contiguous, starting from block_bit_id_lsbs_,
+     * so that the parent block of a bit can be found by a binary search
+     * on this list, instead of storing the parent block for each bit
+     */
+    std::vector<ConfigBlockId> bit_blocks_;
+
+    /* Blocks whose contents are those of a block in a shared bitstream.
+     * The first bit of a shared block is the number of bits when the block is added,
+     * so that the bits can be put in the same place when materialized
+     */
+    struct t_shared_block {
+      std::shared_ptr<const BitstreamManager> bitstream;
+      ConfigBlockId source_block;
+      size_t bit_id_lsb;
+    };
+    std::map<ConfigBlockId, t_shared_block> shared_blocks_;
 };
 
 } /* end namespace openfpga */
@@ -39,6 +39,49 @@ std::vector<ConfigBlockId> find_bitstream_manager_block_hierarchy(const Bitstrea
   return block_hierarchy;
 }
 
+/********************************************************************
+ * Recursively visit the child blocks of a block, where the path
+ * of the block is extended by the names of the child blocks,
+ * and then cut back when a child block is done
+ *******************************************************************/
+static 
+void rec_visit_bitstream_manager_block_paths(const BitstreamManager& bitstream_manager,
+                                             const ConfigBlockId& block,
+                                             const std::string& separator,
+                                             std::string& block_path,
+                                             const BitstreamBlockPathVisitor& visitor) {
+  visitor(block, block_path);
+
+  size_t path_length = block_path.size();
+  for (const ConfigBlockId& child_block : bitstream_manager.block_children(block)) {
+    block_path += separator;
+    block_path += bitstream_manager.block_name(child_block);
+    rec_visit_bitstream_manager_block_paths(bitstream_manager, child_block, separator, block_path, visitor);
+    block_path.resize(path_length);
+  }
+}
+
+/********************************************************************
+ * Visit a block and all its child blocks of bitstream manager in a
+ * top-down way, with the hierarchical path of each block
+ *   <root_path><separator><child_name><separator>...<block_name>
+ * The root block is given the root path, which is typically
+ * the name of the root block or the name of its instance.
+ *
+ * The path is built once along the traversal, which is much cheaper
+ * than finding the hierarchy from the root for each block
+ *******************************************************************/
+void visit_bitstream_manager_block_paths(const BitstreamManager& bitstream_manager,
+                                         const ConfigBlockId& root_block,
+                                         const std::string& root_path,
+                                         const std::string& separator,
+                                         const BitstreamBlockPathVisitor& visitor) {
+  VTR_ASSERT(true == bitstream_manager.valid_block_id(root_block));
+
+  std::string block_path(root_path);
+  rec_visit_bitstream_manager_block_paths(bitstream_manager, root_block, separator, block_path, visitor);
+}
+
 /********************************************************************
  * Find all the top-level blocks in a bitstream manager, 
  * which have no parents
@@ -72,4 +115,32 @@ size_t find_bitstream_manager_config_bit_index_in_parent_block(const BitstreamMa
 }
 
 
+/********************************************************************
+ * Check if two blocks of bitstream managers have the same hierarchy,
+ * i.e., the same names, child blocks and number of bits in all the levels,
+ * e.g., the bitstreams of two designs implemented on the same fabric.
+ * Shared blocks are not supported and should be materialized before
+ *******************************************************************/
+bool is_bitstream_manager_block_hierarchy_same(const BitstreamManager& bitstream_manager,
+                                               const ConfigBlockId& block,
+                                               const BitstreamManager& cand_bitstream_manager,
+                                               const ConfigBlockId& cand_block) {
+  if ( (bitstream_manager.block_name(block) != cand_bitstream_manager.block_name(cand_block))
+    || (bitstream_manager.num_block_bits(block) != cand_bitstream_manager.num_block_bits(cand_block))
+    || (bitstream_manager.num_block_children(block) != cand_bitstream_manager.num_block_children(cand_block)) ) {
+    return false;
+  }
+
+  std::vector<ConfigBlockId> children = bitstream_manager.block_children(block);
+  std::vector<ConfigBlockId> cand_children = cand_bitstream_manager.block_children(cand_block);
+  for (size_t ichild = 0; ichild < children.size(); ++ichild) {
+    if (false == is_bitstream_manager_block_hierarchy_same(bitstream_manager, children[ichild],
+                                                           cand_bitstream_manager, cand_children[ichild])) {
+      return false;
+    }
+  }
+
+  return true;
+}
+
 } /* end namespace openfpga */
@@ -4,6 +4,8 @@
 /********************************************************************
  * Include header files that are required by function declaration
  *******************************************************************/
+#include <functional>
+#include <string>
 #include <vector>
 #include "bitstream_manager.h"
 
@@ -17,11 +19,25 @@ namespace openfpga {
 std::vector<ConfigBlockId> find_bitstream_manager_block_hierarchy(const BitstreamManager& bitstream_manager, 
                                                                   const ConfigBlockId& block);
 
+/* Function to be called on each block with its hierarchical path */
+typedef std::function<void(const ConfigBlockId&, const std::string&)> BitstreamBlockPathVisitor;
+
+void visit_bitstream_manager_block_paths(const BitstreamManager& bitstream_manager,
+                                         const ConfigBlockId& root_block,
+                                         const std::string& root_path,
+                                         const std::string& separator,
+                                         const BitstreamBlockPathVisitor& visitor);
+
 std::vector<ConfigBlockId> find_bitstream_manager_top_blocks(const BitstreamManager& bitstream_manager);
 
 size_t find_bitstream_manager_config_bit_index_in_parent_block(const BitstreamManager& bitstream_manager,
                                                                const ConfigBitId& bit_id);
 
+bool is_bitstream_manager_block_hierarchy_same(const BitstreamManager& bitstream_manager,
+                                               const ConfigBlockId& block,
+                                               const BitstreamManager& cand_bitstream_manager,
+                                               const ConfigBlockId& cand_block);
+
 } /* end namespace openfpga */
 
 #endif
@@ -0,0 +1,166 @@
+/********************************************************************
+ * This file includes the functions which read a binary file of
+ * the fabric-independent bitstream in the Cap'n Proto format
+ * to the associated data structures
+ *
+ * The file is mapped to memory and decoded in place,
+ * so that no intermediate copy of the file is created
+ *******************************************************************/
+#include <string>
+
+/* Headers from vtr util library */
+#include "vtr_assert.h"
+#include "vtr_time.h"
+
+/* Headers from libarchfpga */
+#include "arch_error.h"
+
+#ifdef VTR_ENABLE_CAPNPROTO
+/* Headers from vtrcapnproto library */
+#  include "vtr_error.h"
+#  include "capnp/serialize.h"
+#  include "mmap_file.h"
+#  include "arch_bitstream.capnp.h"
+#endif /* VTR_ENABLE_CAPNPROTO */
+
+#include "read_bin_arch_bitstream.h"
+
+/* begin namespace openfpga */
+namespace openfpga {
+
+#ifndef VTR_ENABLE_CAPNPROTO
+
+/********************************************************************
+ * Binary bitstream requires Cap'n Proto, error out when it is disabled
+ *******************************************************************/
+BitstreamManager read_bin_architecture_bitstream(const std::string& fname) {
+  archfpga_throw(fname.c_str(), 0,
+                 "Reading architecture bitstream from binary file is disabled because VTR_ENABLE_CAPNPROTO=OFF.\n"
+                 "Re-compile with CMake option VTR_ENABLE_CAPNPROTO=ON to enable.\n");
+}
+
+#else /* VTR_ENABLE_CAPNPROTO */
+
+/********************************************************************
+ * Decode a message of ArchBitstream to an object of BitstreamManager
+ * Blocks are created in the sequence of their ids and the bits are
+ * added block by block in the sequence of their ids,
+ * so that all the ids are the same as those in the file
+ *******************************************************************/
+static
+void read_bin_arch_bitstream_message(const ArchBitstream::Reader& arch_bitstream,
+                                     const std::string& fname,
+                                     BitstreamManager& bitstream_manager) {
+  ::capnp::List<ArchBitstreamBlock>::Reader blocks = arch_bitstream.getBlocks();
+
+  /* Create all the blocks before linking them, as a child may have a smaller id than its parent */
+  bitstream_manager.reserve_blocks(blocks.size());
+  for (const ArchBitstreamBlock::Reader& block_reader : blocks) {
+    ConfigBlockId block = bitstream_manager.add_block(block_reader.getName());
+
+    /* -2 is an invalid value defined in the bitstream manager internally */
+    if (-2 < block_reader.getPathId()) {
+      bitstream_manager.add_path_id_to_block(block, block_reader.getPathId());
+    }
+    if (0 < block_reader.getInputNetIds().size()) {
+      bitstream_manager.add_input_net_id_to_block(block, block_reader.getInputNetIds());
+    }
+    if (0 < block_reader.getOutputNetIds().size()) {
+      bitstream_manager.add_output_net_id_to_block(block, block_reader.getOutputNetIds());
+    }
+  }
+
+  for (size_t iblock = 0; iblock < blocks.size(); ++iblock) {
+    ConfigBlockId block = ConfigBlockId(iblock);
+    ::capnp::List<uint32_t>::Reader children = blocks[iblock].getChildren();
+    bitstream_manager.reserve_child_blocks(block, children.size());
+    for (const uint32_t& child : children) {
+      ConfigBlockId child_block = ConfigBlockId(child);
+      if ( (false == bitstream_manager.valid_block_id(child_block))
+        || (ConfigBlockId::INVALID() != bitstream_manager.block_parent(child_block)) ) {
+        archfpga_throw(fname.c_str(), 0,
+                       "Invalid child block id '%u' of block '%s'!\n",
+                       child, bitstream_manager.block_name(block).c_str());
+      }
+      bitstream_manager.add_child_block(block, child_block);
+    }
+  }
+
+  /* Unpack the bits block by block */
+  size_t num_bits = arch_bitstream.getNumBits();
+  ::capnp::Data::Reader bit_values = arch_bitstream.getBitValues();
+  if (bit_values.size() != (num_bits + 7) / 8) {
+    archfpga_throw(fname.c_str(), 0,
+                   "Expect %lu bytes for %lu bits but find %lu bytes!\n",
+                   (num_bits + 7) / 8, num_bits, bit_values.size());
+  }
+
+  bitstream_manager.reserve_bits(num_bits);
+  size_t curr_bit = 0;
+  std::vector<bool> block_bits;
+  for (const uint32_t& bit_block : arch_bitstream.getBitBlocks()) {
+    ConfigBlockId block = ConfigBlockId(bit_block);
+    if ( (false == bitstream_manager.valid_block_id(block))
+      || (0 < bitstream_manager.block_bits(block).size()) ) {
+      archfpga_throw(fname.c_str(), 0,
+                     "Invalid block id '%u' which owns bits!\n",
+                     bit_block);
+    }
+    size_t block_num_bits = blocks[bit_block].getNumBits();
+    if (num_bits < curr_bit + block_num_bits) {
+      archfpga_throw(fname.c_str(), 0,
+                     "Bits of block '%s' exceed the %lu bits in total!\n",
+                     bitstream_manager.block_name(block).c_str(), num_bits);
+    }
+    block_bits.resize(block_num_bits);
+    for (size_t ibit = 0; ibit < block_num_bits; ++ibit, ++curr_bit) {
+      block_bits[ibit] = (0 != (bit_values[curr_bit / 8] & (1 << (curr_bit % 8))));
+    }
+    bitstream_manager.add_block_bits(block, block_bits);
+  }
+
+  if (curr_bit != num_bits) {
+    archfpga_throw(fname.c_str(), 0,
+                   "Blocks own %lu bits while %lu bits are expected!\n",
+                   curr_bit, num_bits);
+  }
+}
+
+/********************************************************************
+ * Parse a binary file of ArchBitstream to an object of BitstreamManager
+ *******************************************************************/
+BitstreamManager read_bin_architecture_bitstream(const std::string& fname) {
+
+  vtr::ScopedStartFinishTimer timer("Read Architecture Bitstream binary file");
+
+  BitstreamManager bitstream_manager;
+
+  try {
+    /* The file is unmapped when the object leaves scope */
+    MmapFile f(fname);
+
+    /* Bitstream of large devices may exceed the default traversal limit, which is a protection
+     * against malicious messages, so remove the limit
+     */
+    ::capnp::ReaderOptions reader_options;
+    reader_options.traversalLimitInWords = UINT64_MAX;
+    ::capnp::FlatArrayMessageReader reader(f.getData(), reader_options);
+
+    read_bin_arch_bitstream_message(reader.getRoot<ArchBitstream>(), fname, bitstream_manager);
+  } catch (ArchFpgaError&) {
+    /* Errors found in decoding have been reported with the file name */
+    throw;
+  } catch (vtr::VtrError& e) {
+    archfpga_throw(fname.c_str(), 0,
+                   "%s", e.what());
+  } catch (kj::Exception& e) {
+    archfpga_throw(fname.c_str(), 0,
+                   "%s", e.getDescription().cStr());
+  }
+
+  return bitstream_manager;
+}
+
+#endif /* VTR_ENABLE_CAPNPROTO */
+
+} /* end namespace openfpga */
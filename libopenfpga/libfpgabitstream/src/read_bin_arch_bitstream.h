@@ -0,0 +1,21 @@
+#ifndef READ_BIN_ARCH_BITSTREAM_H
+#define READ_BIN_ARCH_BITSTREAM_H
+
+/********************************************************************
+ * Include header files that are required by function declaration
+ *******************************************************************/
+#include <string>
+#include "bitstream_manager.h"
+
+/********************************************************************
+ * Function declaration
+ *******************************************************************/
+
+/* begin namespace openfpga */
+namespace openfpga {
+
+BitstreamManager read_bin_architecture_bitstream(const std::string& fname);
+
+} /* end namespace openfpga */
+
+#endif
@@ -1,13 +1,16 @@
 /********************************************************************
  * This file includes the top-level function of this library
- * which reads an XML of a fabric key to the associated
+ * which reads an XML of an architecture bitstream to the associated
  * data structures
+ *
+ * The XML is streamed through rather than loaded to a document,
+ * so the blocks and bits are created as their elements are read,
+ * and large bitstream databases can be read with little memory
+ * on top of the bitstream manager
  *******************************************************************/
+#include <cstdlib>
 #include <string>
-
-/* Headers from pugi XML library */
-#include "pugixml.hpp"
-#include "pugixml_util.hpp"
+#include <vector>
 
 /* Headers from vtr util library */
 #include "vtr_assert.h"
@@ -15,7 +18,9 @@
 
 /* Headers from libarchfpga */
 #include "arch_error.h"
-#include "read_xml_util.h"
+
+/* Headers from openfpgautil library */
+#include "openfpga_xml_stream_reader.h"
 
 #include "openfpga_reserved_words.h"
 
@@ -24,121 +29,72 @@
 /* begin namespace openfpga */
 namespace openfpga {
 
+/* Elements of the XML of an architecture bitstream */
+enum e_xml_arch_bitstream_element {
+  XML_ARCH_BITSTREAM_BLOCK,
+  XML_ARCH_BITSTREAM_INPUT_NETS,
+  XML_ARCH_BITSTREAM_OUTPUT_NETS,
+  XML_ARCH_BITSTREAM_BITS,
+  /* Elements whose contents are not read, e.g., <hierarchy> */
+  XML_ARCH_BITSTREAM_IGNORED
+};
+
 /********************************************************************
- * Parse XML codes of a <bitstream_block> to an object of BitstreamManager
- * This function goes recursively until we reach the leaf node
+ * Find the value of an attribute which is required in an element
  *******************************************************************/
-static 
-void rec_read_xml_bitstream_block(pugi::xml_node& xml_bitstream_block,
-                                  const pugiutil::loc_data& loc_data,
-                                  BitstreamManager& bitstream_manager,
-                                  const ConfigBlockId& parent_block) {
-
-  /* Find the name of this bitstream block */
-  const std::string& block_name = get_attribute(xml_bitstream_block, "name", loc_data).as_string();
-
-  /* Create the bitstream block */
-  ConfigBlockId curr_block = bitstream_manager.add_block(block_name);
-
-  /* Add it to parent block */
-  bitstream_manager.add_child_block(parent_block, curr_block);
-
-  /* Parse input nets if defined */
-  pugi::xml_node xml_input_nets = get_single_child(xml_bitstream_block, "input_nets", loc_data, pugiutil::ReqOpt::OPTIONAL);
-  if (xml_input_nets) {
-    std::vector<std::string> input_nets;
-    size_t num_input_nets = count_children(xml_input_nets, "path", loc_data, pugiutil::ReqOpt::OPTIONAL);
-    input_nets.resize(num_input_nets);
-
-    /* Find the child paths/nets */
-    for (pugi::xml_node xml_input_net : xml_input_nets.children()) {
-      /* We only care child bitstream blocks here */
-      if (xml_input_net.name() != std::string("path")) {
-        bad_tag(xml_input_net, loc_data, xml_input_nets, {"path"});
-      }
-      const int& id = get_attribute(xml_input_net, "id", loc_data).as_int();
-      const std::string& net_name = get_attribute(xml_input_net, "net_name", loc_data).as_string();
-      VTR_ASSERT((size_t)id < input_nets.size());
-      input_nets[id] = net_name; 
-    } 
-
-    std::string input_nets_str;
-    bool need_splitter = false;
-    for (const std::string& input_net : input_nets) {
-      if (true == need_splitter) {
-        input_nets_str += std::string(" ");
-      }
-      input_nets_str += input_net;
-      need_splitter = true;
-    }
-    bitstream_manager.add_input_net_id_to_block(curr_block, input_nets_str); 
+static
+const std::string& get_required_stream_attribute(const XmlStreamReader& reader,
+                                                 const char* fname,
+                                                 const std::string& attribute_name) {
+  if (false == reader.has_attribute(attribute_name)) {
+    archfpga_throw(fname, reader.line(),
+                   "Expected '%s' attribute in <%s>!\n",
+                   attribute_name.c_str(), reader.name().c_str());
   }
+  return reader.attribute(attribute_name);
+}
 
-  /* Parse output nets if defined */
-  pugi::xml_node xml_output_nets = get_single_child(xml_bitstream_block, "output_nets", loc_data, pugiutil::ReqOpt::OPTIONAL);
-  if (xml_output_nets) {
-    std::vector<std::string> output_nets;
-    size_t num_output_nets = count_children(xml_output_nets, "path", loc_data, pugiutil::ReqOpt::OPTIONAL);
-    output_nets.resize(num_output_nets);
-
-    /* Find the child paths/nets */
-    for (pugi::xml_node xml_output_net : xml_output_nets.children()) {
-      /* We only care child bitstream blocks here */
-      if (xml_output_net.name() != std::string("path")) {
-        bad_tag(xml_output_net, loc_data, xml_output_nets, {"path"});
-      }
-      const int& id = get_attribute(xml_output_net, "id", loc_data).as_int();
-      const std::string& net_name = get_attribute(xml_output_net, "net_name", loc_data).as_string();
-      VTR_ASSERT((size_t)id < output_nets.size());
-      output_nets[id] = net_name; 
-    } 
-
-    std::string output_nets_str;
-    bool need_splitter = false;
-    for (const std::string& output_net : output_nets) {
-      if (true == need_splitter) {
-        output_nets_str += std::string(" ");
-      }
-      output_nets_str += output_net;
-      need_splitter = true;
-    }
-    bitstream_manager.add_output_net_id_to_block(curr_block, output_nets_str); 
+/********************************************************************
+ * Convert the value of an attribute to an integer
+ *******************************************************************/
+static
+long get_stream_attribute_as_integer(const XmlStreamReader& reader,
+                                     const char* fname,
+                                     const std::string& attribute_name,
+                                     const std::string& value) {
+  char* end = nullptr;
+  long number = std::strtol(value.c_str(), &end, 10);
+  if ((true == value.empty()) || ('\0' != *end)) {
+    archfpga_throw(fname, reader.line(),
+                   "Invalid value '%s' of attribute '%s' in <%s>, expect an integer!\n",
+                   value.c_str(), attribute_name.c_str(), reader.name().c_str());
   }
+  return number;
+}
 
-  /* Parse configuration bits */
-  pugi::xml_node xml_bitstream = get_single_child(xml_bitstream_block, "bitstream", loc_data, pugiutil::ReqOpt::OPTIONAL);
-  if (xml_bitstream) {
-    /* Parse path_id: -2 is an invalid value defined in the bitstream manager internally */
-    const int& path_id = get_attribute(xml_bitstream, "path_id", loc_data, pugiutil::ReqOpt::OPTIONAL).as_int(-2);
-    if (-2 < path_id) {
-      bitstream_manager.add_path_id_to_block(curr_block, path_id); 
-    }
-
-    /* Find the child paths/nets */
-    std::vector<bool> block_bits;
-    for (pugi::xml_node xml_bit : xml_bitstream.children()) {
-      /* We only care child bitstream blocks here */
-      if (xml_bit.name() != std::string("bit")) {
-        bad_tag(xml_bit, loc_data, xml_bitstream, {"bit"});
-      }
-      const int& bit_value = get_attribute(xml_bit, "value", loc_data).as_int();
-      block_bits.push_back(1 == bit_value);
+/********************************************************************
+ * Join the names of nets with spaces, as stored in bitstream manager
+ *******************************************************************/
+static
+std::string join_xml_bitstream_net_names(const std::vector<std::string>& nets) {
+  std::string nets_str;
+  bool need_splitter = false;
+  for (const std::string& net : nets) {
+    if (true == need_splitter) {
+      nets_str += std::string(" ");
     }
-    /* Link the bit to parent block */
-    bitstream_manager.add_block_bits(curr_block, block_bits);
+    nets_str += net;
+    need_splitter = true;
   }
-  
-  /* Go recursively: find all the child blocks and parse */
-  for (pugi::xml_node xml_child : xml_bitstream_block.children()) {
-    /* We only care child bitstream blocks here */
-    if (xml_child.name() == std::string("bitstream_block")) {
-      rec_read_xml_bitstream_block(xml_child, loc_data, bitstream_manager, curr_block);
-    }
-  } 
+  return nets_str;
 }
 
 /********************************************************************
  * Parse XML codes about <bitstream> to an object of Bitstream
+ *
+ * The top-level block may give the numbers of blocks and bits
+ * in its attributes 'num_blocks' and 'num_bits', which are used
+ * to reserve the memory of the bitstream manager
  *******************************************************************/
 BitstreamManager read_xml_architecture_bitstream(const char* fname) {
 
@@ -146,51 +102,146 @@ BitstreamManager read_xml_architecture_bitstream(const char* fname) {
 
   BitstreamManager bitstream_manager;
 
-  /* Parse the file */
-  pugi::xml_document doc;
-  pugiutil::loc_data loc_data;
-
-  try {
-    loc_data = pugiutil::load_xml(doc, fname);
-
-    /* Count the child <bitstream_block> */
-
-    pugi::xml_node xml_root = get_single_child(doc, "bitstream_block", loc_data);
+  XmlStreamReader reader(fname);
+  if (false == reader.is_open()) {
+    archfpga_throw(fname, 0,
+                   "%s\n", reader.error().c_str());
+  }
 
-    /* Find the name of the top block*/
-    const std::string& top_block_name = get_attribute(xml_root, "name", loc_data).as_string();
-    
-    if (top_block_name != std::string(FPGA_TOP_MODULE_NAME)) {
-      archfpga_throw(loc_data.filename_c_str(), loc_data.line(xml_root),
-                     "Top-level block must be named as '%s'!\n",
-                     FPGA_TOP_MODULE_NAME);
+  /* Elements which are open, and the blocks among them */
+  std::vector<e_xml_arch_bitstream_element> elements;
+  std::vector<ConfigBlockId> blocks;
+  /* Contents of the nets or bits being read, which are added to the block at the end of their element */
+  std::vector<std::string> nets;
+  std::vector<bool> block_bits;
+
+  while (true == reader.next()) {
+    if (XmlStreamReader::XML_END_ELEMENT == reader.event()) {
+      VTR_ASSERT(false == elements.empty());
+      switch (elements.back()) {
+      case XML_ARCH_BITSTREAM_BLOCK:
+        blocks.pop_back();
+        break;
+      case XML_ARCH_BITSTREAM_INPUT_NETS:
+        bitstream_manager.add_input_net_id_to_block(blocks.back(), join_xml_bitstream_net_names(nets));
+        break;
+      case XML_ARCH_BITSTREAM_OUTPUT_NETS:
+        bitstream_manager.add_output_net_id_to_block(blocks.back(), join_xml_bitstream_net_names(nets));
+        break;
+      case XML_ARCH_BITSTREAM_BITS:
+        /* Link the bits to parent block */
+        bitstream_manager.add_block_bits(blocks.back(), block_bits);
+        break;
+      default:
+        break;
+      }
+      elements.pop_back();
+      continue;
     }
 
-    /* Create the top-level block */
-    ConfigBlockId top_block = bitstream_manager.add_block(top_block_name);
+    /* The top-level block */
+    if (true == elements.empty()) {
+      if (reader.name() != std::string("bitstream_block")) {
+        archfpga_throw(fname, reader.line(),
+                       "Expected a top-level <bitstream_block> rather than <%s>!\n",
+                       reader.name().c_str());
+      }
+      if (0 < bitstream_manager.num_blocks()) {
+        archfpga_throw(fname, reader.line(),
+                       "Expected only one top-level <bitstream_block>!\n");
+      }
+      /* Find the name of the top block*/
+      const std::string& top_block_name = get_required_stream_attribute(reader, fname, "name");
+      if (top_block_name != std::string(FPGA_TOP_MODULE_NAME)) {
+        archfpga_throw(fname, reader.line(),
+                       "Top-level block must be named as '%s'!\n",
+                       FPGA_TOP_MODULE_NAME);
+      }
+      /* Reserve bitstream blocks and bits in the data base */
+      if (true == reader.has_attribute("num_blocks")) {
+        bitstream_manager.reserve_blocks(get_stream_attribute_as_integer(reader, fname, "num_blocks", reader.attribute("num_blocks")));
+      }
+      if (true == reader.has_attribute("num_bits")) {
+        bitstream_manager.reserve_bits(get_stream_attribute_as_integer(reader, fname, "num_bits", reader.attribute("num_bits")));
+      }
+      /* Create the top-level block */
+      blocks.push_back(bitstream_manager.add_block(top_block_name));
+      elements.push_back(XML_ARCH_BITSTREAM_BLOCK);
+      continue;
+    }
 
-    size_t num_blks = count_children(xml_root, "bitstream_block", loc_data, pugiutil::ReqOpt::OPTIONAL);
+    e_xml_arch_bitstream_element parent_element = elements.back();
+    e_xml_arch_bitstream_element curr_element = XML_ARCH_BITSTREAM_IGNORED;
+
+    if (XML_ARCH_BITSTREAM_BLOCK == parent_element) {
+      if (reader.name() == std::string("bitstream_block")) {
+        /* Create the bitstream block and add it to parent block */
+        ConfigBlockId curr_block = bitstream_manager.add_block(get_required_stream_attribute(reader, fname, "name"));
+        bitstream_manager.add_child_block(blocks.back(), curr_block);
+        blocks.push_back(curr_block);
+        curr_element = XML_ARCH_BITSTREAM_BLOCK;
+      } else if (1 == blocks.size()) {
+        /* The top-level block only contains child blocks */
+        archfpga_throw(fname, reader.line(),
+                       "Invalid child <%s> in <bitstream_block>, expect <bitstream_block>!\n",
+                       reader.name().c_str());
+      } else if (reader.name() == std::string("input_nets")) {
+        nets.clear();
+        curr_element = XML_ARCH_BITSTREAM_INPUT_NETS;
+      } else if (reader.name() == std::string("output_nets")) {
+        nets.clear();
+        curr_element = XML_ARCH_BITSTREAM_OUTPUT_NETS;
+      } else if (reader.name() == std::string("bitstream")) {
+        /* Parse path_id: -2 is an invalid value defined in the bitstream manager internally */
+        if (true == reader.has_attribute("path_id")) {
+          long path_id = get_stream_attribute_as_integer(reader, fname, "path_id", reader.attribute("path_id"));
+          if (-2 < path_id) {
+            bitstream_manager.add_path_id_to_block(blocks.back(), path_id);
+          }
+        }
+        block_bits.clear();
+        curr_element = XML_ARCH_BITSTREAM_BITS;
+      }
+    } else if ( (XML_ARCH_BITSTREAM_INPUT_NETS == parent_element)
+             || (XML_ARCH_BITSTREAM_OUTPUT_NETS == parent_element) ) {
+      if (reader.name() != std::string("path")) {
+        archfpga_throw(fname, reader.line(),
+                       "Invalid child <%s> of nets, expect <path>!\n",
+                       reader.name().c_str());
+      }
+      long id = get_stream_attribute_as_integer(reader, fname, "id", get_required_stream_attribute(reader, fname, "id"));
+      if (0 > id) {
+        archfpga_throw(fname, reader.line(),
+                       "Invalid path id '%ld'!\n", id);
+      }
+      if (nets.size() <= size_t(id)) {
+        nets.resize(id + 1);
+      }
+      nets[id] = get_required_stream_attribute(reader, fname, "net_name");
+    } else if (XML_ARCH_BITSTREAM_BITS == parent_element) {
+      if (reader.name() != std::string("bit")) {
+        archfpga_throw(fname, reader.line(),
+                       "Invalid child <%s> of <bitstream>, expect <bit>!\n",
+                       reader.name().c_str());
+      }
+      long bit_value = get_stream_attribute_as_integer(reader, fname, "value", get_required_stream_attribute(reader, fname, "value"));
+      block_bits.push_back(1 == bit_value);
+    }
 
-    /* Reserve bitstream blocks in the data base */
-    bitstream_manager.reserve_blocks(num_blks);
+    elements.push_back(curr_element);
+  }
 
-    /* Iterate over the children under this node,
-     * each child should be named after circuit_model
-     */
-    for (pugi::xml_node xml_blk : xml_root.children()) {
-      /* Error out if the XML child has an invalid name! */
-      if (xml_blk.name() != std::string("bitstream_block")) {
-        bad_tag(xml_blk, loc_data, xml_root, {"bitstream_block"});
-      }
-      rec_read_xml_bitstream_block(xml_blk, loc_data, bitstream_manager, top_block);
-    } 
-  } catch (pugiutil::XmlError& e) {
-    archfpga_throw(fname, e.line(),
-                   "%s", e.what());
+  if (false == reader.error().empty()) {
+    archfpga_throw(fname, 0,
+                   "Unable to read XML file '%s', %s\n",
+                   fname, reader.error().c_str());
+  }
+  if (0 == bitstream_manager.num_blocks()) {
+    archfpga_throw(fname, 0,
+                   "Expected a top-level <bitstream_block>!\n");
   }
 
-  return bitstream_manager; 
+  return bitstream_manager;
 }
 
 } /* end namespace openfpga */
-
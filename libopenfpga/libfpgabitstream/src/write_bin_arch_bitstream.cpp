@@ -0,0 +1,121 @@
+/********************************************************************
+ * This file includes functions that output bitstream database
+ * to a binary file in the Cap'n Proto format,
+ * which is much more compact and faster to read back than XML
+ * See arch_bitstream.capnp in libvtrcapnproto for the schema
+ *******************************************************************/
+#include <algorithm>
+
+/* Headers from vtrutil library */
+#include "vtr_assert.h"
+#include "vtr_log.h"
+#include "vtr_time.h"
+
+#ifdef VTR_ENABLE_CAPNPROTO
+/* Headers from vtrcapnproto library */
+#  include "vtr_error.h"
+#  include "capnp/message.h"
+#  include "serdes_utils.h"
+#  include "arch_bitstream.capnp.h"
+#endif /* VTR_ENABLE_CAPNPROTO */
+
+#include "write_bin_arch_bitstream.h"
+
+/* begin namespace openfpga */
+namespace openfpga {
+
+#ifndef VTR_ENABLE_CAPNPROTO
+
+/********************************************************************
+ * Binary bitstream requires Cap'n Proto, error out when it is disabled
+ *******************************************************************/
+int write_bin_architecture_bitstream(const BitstreamManager& /*bitstream_manager*/,
+                                     const std::string& fname) {
+  VTR_LOG_ERROR("Unable to write architecture bitstream to binary file '%s' "
+                "because VTR_ENABLE_CAPNPROTO=OFF.\n"
+                "Re-compile with CMake option VTR_ENABLE_CAPNPROTO=ON to enable.\n",
+                fname.c_str());
+  return 1;
+}
+
+#else /* VTR_ENABLE_CAPNPROTO */
+
+/********************************************************************
+ * Write the bitstream to a binary file without binding to the configuration
+ * procotols of a given FPGA fabric
+ * The content is the same as the XML format but the hierarchy of each
+ * block is not stored, as it can be found from the parent blocks
+ *
+ * Return:
+ *  - 0 if succeed
+ *  - 1 if critical errors occured
+ *******************************************************************/
+int write_bin_architecture_bitstream(const BitstreamManager& bitstream_manager,
+                                     const std::string& fname) {
+  /* Ensure that we have a valid file name */
+  if (true == fname.empty()) {
+    VTR_LOG_ERROR("Received empty file name to output bitstream!\n\tPlease specify a valid file name.\n");
+    return 1;
+  }
+
+  std::string timer_message = std::string("Write ") + std::to_string(bitstream_manager.num_bits()) + std::string(" architecture independent bitstream into binary file '") + fname + std::string("'");
+  vtr::ScopedStartFinishTimer timer(timer_message);
+
+  ::capnp::MallocMessageBuilder builder;
+  ArchBitstream::Builder arch_bitstream = builder.initRoot<ArchBitstream>();
+
+  /* Blocks are written in the sequence of their ids, so that they can be created in order */
+  std::vector<std::pair<size_t, size_t>> bit_blocks;
+  ::capnp::List<ArchBitstreamBlock>::Builder blocks = arch_bitstream.initBlocks(bitstream_manager.num_blocks());
+  for (const ConfigBlockId& block : bitstream_manager.blocks()) {
+    ArchBitstreamBlock::Builder block_builder = blocks[size_t(block)];
+    block_builder.setName(bitstream_manager.block_name(block));
+
+    std::vector<ConfigBlockId> child_blocks = bitstream_manager.block_children(block);
+    ::capnp::List<uint32_t>::Builder children = block_builder.initChildren(child_blocks.size());
+    for (size_t ichild = 0; ichild < child_blocks.size(); ++ichild) {
+      children.set(ichild, size_t(child_blocks[ichild]));
+    }
+
+    block_builder.setPathId(bitstream_manager.block_path_id(block));
+    block_builder.setInputNetIds(bitstream_manager.block_input_net_ids(block));
+    block_builder.setOutputNetIds(bitstream_manager.block_output_net_ids(block));
+
+    std::vector<ConfigBitId> block_bits = bitstream_manager.block_bits(block);
+    block_builder.setNumBits(block_bits.size());
+    if (false == block_bits.empty()) {
+      bit_blocks.push_back(std::make_pair(size_t(block_bits.front()), size_t(block)));
+    }
+  }
+
+  /* Bits of a block are contiguous, sort the blocks by their first bits */
+  std::sort(bit_blocks.begin(), bit_blocks.end());
+  ::capnp::List<uint32_t>::Builder bit_block_ids = arch_bitstream.initBitBlocks(bit_blocks.size());
+  for (size_t iblock = 0; iblock < bit_blocks.size(); ++iblock) {
+    bit_block_ids.set(iblock, bit_blocks[iblock].second);
+  }
+
+  /* Pack the values of bits */
+  arch_bitstream.setNumBits(bitstream_manager.num_bits());
+  ::capnp::Data::Builder bit_values = arch_bitstream.initBitValues((bitstream_manager.num_bits() + 7) / 8);
+  std::fill(bit_values.begin(), bit_values.end(), 0);
+  for (const ConfigBitId& bit : bitstream_manager.bits()) {
+    if (true == bitstream_manager.bit_value(bit)) {
+      bit_values[size_t(bit) / 8] |= (1 << (size_t(bit) % 8));
+    }
+  }
+
+  try {
+    writeMessageToFile(fname, &builder);
+  } catch (vtr::VtrError& e) {
+    VTR_LOG_ERROR("Fail to write architecture bitstream to binary file '%s': %s\n",
+                  fname.c_str(), e.what());
+    return 1;
+  }
+
+  return 0;
+}
+
+#endif /* VTR_ENABLE_CAPNPROTO */
+
+} /* end namespace openfpga */
@@ -42,6 +42,29 @@ void write_bitstream_xml_file_head(std::fstream& fp) {
   fp << std::endl;
 }
 
+/********************************************************************
+ * Recursively count the blocks and bits written for a block,
+ * including the contents of shared blocks
+ *******************************************************************/
+static 
+void rec_count_block_bitstream(const BitstreamManager& bitstream_manager, 
+                               const ConfigBlockId& block,
+                               size_t& num_blocks,
+                               size_t& num_bits) {
+  const BitstreamManager* content_manager = &bitstream_manager;
+  ConfigBlockId content_block = block;
+  if (true == bitstream_manager.is_shared_block(block)) {
+    content_manager = bitstream_manager.shared_block_bitstream(block).get();
+    content_block = bitstream_manager.shared_block_source(block);
+  }
+
+  ++num_blocks;
+  num_bits += content_manager->num_block_bits(content_block);
+  for (const ConfigBlockId& child_block : content_manager->block_children(content_block)) {
+    rec_count_block_bitstream(*content_manager, child_block, num_blocks, num_bits);
+  }
+}
+
 /********************************************************************
  * Recursively write the bitstream of a block to a xml file
  * This function will use a Depth-First Search in outputting bitstream
@@ -49,42 +72,66 @@ void write_bitstream_xml_file_head(std::fstream& fp) {
  * 1. For block with bits as children, we will output the XML lines
  * 2. For block without bits/child blocks, we can return 
  * 3. For block with child blocks, we visit each child recursively
+ *
+ * The hierarchy of the block, from the top block to the block itself,
+ * is carried along the recursion, so that it is not searched 
+ * from the root again for each block
+ *
+ * The contents of a shared block are written from its shared bitstream,
+ * so that the bitstream manager does not have to be materialized
  *******************************************************************/
 static 
 void rec_write_block_bitstream_to_xml_file(std::fstream& fp,
                                            const BitstreamManager& bitstream_manager, 
                                            const ConfigBlockId& block,
-                                           const size_t& hierarchy_level) {
+                                           const size_t& hierarchy_level,
+                                           std::vector<std::pair<const BitstreamManager*, ConfigBlockId>>& block_hierarchy) {
   valid_file_stream(fp);
 
+  block_hierarchy.push_back(std::make_pair(&bitstream_manager, block));
+
+  const BitstreamManager* content_manager = &bitstream_manager;
+  ConfigBlockId content_block = block;
+  if (true == bitstream_manager.is_shared_block(block)) {
+    content_manager = bitstream_manager.shared_block_bitstream(block).get();
+    content_block = bitstream_manager.shared_block_source(block);
+  }
+
   /* Write the bits of this block */
   write_tab_to_file(fp, hierarchy_level);
   fp << "<bitstream_block";
   fp << " name=\"" << bitstream_manager.block_name(block)<< "\"";
   fp << " hierarchy_level=\"" << hierarchy_level << "\"";
+  /* The top block gives the size of the bitstream, so that readers can reserve memory */
+  if (0 == hierarchy_level) {
+    size_t num_blocks = 0;
+    size_t num_bits = 0;
+    rec_count_block_bitstream(bitstream_manager, block, num_blocks, num_bits);
+    fp << " num_blocks=\"" << num_blocks << "\"";
+    fp << " num_bits=\"" << num_bits << "\"";
+  }
   fp << ">" << std::endl;
 
   /* Dive to child blocks if this block has any */
-  for (const ConfigBlockId& child_block : bitstream_manager.block_children(block)) {
-    rec_write_block_bitstream_to_xml_file(fp, bitstream_manager, child_block, hierarchy_level + 1);
+  for (const ConfigBlockId& child_block : content_manager->block_children(content_block)) {
+    rec_write_block_bitstream_to_xml_file(fp, *content_manager, child_block, hierarchy_level + 1, block_hierarchy);
   }
   
-  if (0 == bitstream_manager.block_bits(block).size()) {
+  if (0 == content_manager->num_block_bits(content_block)) {
     write_tab_to_file(fp, hierarchy_level);
     fp << "</bitstream_block>" <<std::endl;
+    block_hierarchy.pop_back();
     return;
   }
 
-  std::vector<ConfigBlockId> block_hierarchy = find_bitstream_manager_block_hierarchy(bitstream_manager, block); 
-  
   /* Output hierarchy of this parent*/
   write_tab_to_file(fp, hierarchy_level + 1);
   fp << "<hierarchy>" << std::endl;
   size_t hierarchy_counter = 0;
-  for (const ConfigBlockId& temp_block : block_hierarchy) {
+  for (const std::pair<const BitstreamManager*, ConfigBlockId>& temp_block : block_hierarchy) {
     write_tab_to_file(fp, hierarchy_level + 2);
     fp << "<instance level=\"" << hierarchy_counter << "\"";
-    fp << " name=\"" << bitstream_manager.block_name(temp_block) << "\"";
+    fp << " name=\"" << temp_block.first->block_name(temp_block.second) << "\"";
     fp << "/>" << std::endl;
     hierarchy_counter++;
   }
@@ -92,12 +139,12 @@ void rec_write_block_bitstream_to_xml_file(std::fstream& fp,
   fp << "</hierarchy>" << std::endl;
 
   /* Output input/output nets if there are any */
-  if (false == bitstream_manager.block_input_net_ids(block).empty()) {
+  if (false == content_manager->block_input_net_ids(content_block).empty()) {
     write_tab_to_file(fp, hierarchy_level + 1);
     fp << "<input_nets>\n";
     size_t path_counter = 0;
     /* Split with space */
-    StringToken input_net_tokenizer(bitstream_manager.block_input_net_ids(block));
+    StringToken input_net_tokenizer(content_manager->block_input_net_ids(content_block));
     for (const std::string& net : input_net_tokenizer.split(std::string(" "))) {
       write_tab_to_file(fp, hierarchy_level + 2);
       fp << "<path id=\"" << path_counter << "\"";
@@ -112,12 +159,12 @@ void rec_write_block_bitstream_to_xml_file(std::fstream& fp,
     fp << "</input_nets>\n";
   }
 
-  if (false == bitstream_manager.block_output_net_ids(block).empty()) {
+  if (false == content_manager->block_output_net_ids(content_block).empty()) {
     write_tab_to_file(fp, hierarchy_level + 1);
     fp << "<output_nets>\n";
     size_t path_counter = 0;
     /* Split with space */
-    StringToken output_net_tokenizer(bitstream_manager.block_output_net_ids(block));
+    StringToken output_net_tokenizer(content_manager->block_output_net_ids(content_block));
     for (const std::string& net : output_net_tokenizer.split(std::string(" "))) {
       write_tab_to_file(fp, hierarchy_level + 2);
       fp << "<path id=\"" << path_counter << "\"";
@@ -137,16 +184,16 @@ void rec_write_block_bitstream_to_xml_file(std::fstream& fp,
   write_tab_to_file(fp, hierarchy_level + 1);
   fp << "<bitstream";
   /* Output path id only when it is valid */
-  if (true == bitstream_manager.valid_block_path_id(block)) {
-    fp << " path_id=\"" << bitstream_manager.block_path_id(block) << "\"";
+  if (true == content_manager->valid_block_path_id(content_block)) {
+    fp << " path_id=\"" << content_manager->block_path_id(content_block) << "\"";
   }
   fp << ">" << std::endl;
 
-  for (const ConfigBitId& child_bit : bitstream_manager.block_bits(block)) {
+  for (const ConfigBitId& child_bit : content_manager->block_bits(content_block)) {
     write_tab_to_file(fp, hierarchy_level + 2);
     fp << "<bit";
     fp << " memory_port=\"" << CONFIGURABLE_MEMORY_DATA_OUT_NAME << "[" << bit_counter << "]" << "\"";
-    fp << " value=\"" << bitstream_manager.bit_value(child_bit) << "\"";
+    fp << " value=\"" << content_manager->bit_value(child_bit) << "\"";
     fp << "/>" << std::endl;
     bit_counter++;
   }
@@ -155,6 +202,8 @@ void rec_write_block_bitstream_to_xml_file(std::fstream& fp,
 
   write_tab_to_file(fp, hierarchy_level);
   fp << "</bitstream_block>" <<std::endl;
+
+  block_hierarchy.pop_back();
 }
 
 /********************************************************************
@@ -196,7 +245,8 @@ void write_xml_architecture_bitstream(const BitstreamManager& bitstream_manager,
   VTR_ASSERT(1 == top_block.size());
 
   /* Write bitstream, block by block, in a recursive way */
-  rec_write_block_bitstream_to_xml_file(fp, bitstream_manager, top_block[0], 0);
+  std::vector<std::pair<const BitstreamManager*, ConfigBlockId>> block_hierarchy;
+  rec_write_block_bitstream_to_xml_file(fp, bitstream_manager, top_block[0], 0, block_hierarchy);
 
   /* Close file handler */
   fp.close();
@@ -0,0 +1,43 @@
+/*********************************************************************
+ * This file includes functions that find the number of threads 
+ * to be used by a command
+ ********************************************************************/
+#include <cstdlib>
+
+#include "vtr_log.h"
+
+#include "openfpga_parallel.h"
+#include "command_threads.h"
+
+/* Begin namespace openfpga */
+namespace openfpga {
+
+/*********************************************************************
+ * Find the number of threads requested by an option of a command,
+ * e.g., '--threads', which is 0 or a positive number.
+ * A zero request is resolved to all the hardware threads.
+ * The default number of threads, see set_default_num_threads(),
+ * is used when the option is not given.
+ * Return false, with errors reported, if the number is invalid
+ ********************************************************************/
+bool find_command_num_threads(const Command& cmd,
+                              const CommandContext& cmd_context,
+                              const CommandOptionId& opt_threads,
+                              size_t& num_threads) {
+  if (false == cmd_context.option_enable(cmd, opt_threads)) {
+    num_threads = find_num_threads(default_num_threads());
+    return true;
+  }
+
+  int num_threads_requested = std::atoi(cmd_context.option_value(cmd, opt_threads).c_str());
+  /* Error out if we have negative number of threads */
+  if (0 > num_threads_requested) {
+    VTR_LOG_ERROR("Invalid number of threads '%d' which should be 0 or a positive number!\n",
+                  num_threads_requested);
+    return false;
+  }
+  num_threads = find_num_threads(size_t(num_threads_requested));
+  return true;
+}
+
+} /* End namespace openfpga */
@@ -0,0 +1,24 @@
+#ifndef COMMAND_THREADS_H
+#define COMMAND_THREADS_H
+
+/********************************************************************
+ * Include header files that are required by function declaration
+ *******************************************************************/
+#include "command.h"
+#include "command_context.h"
+
+/********************************************************************
+ * Function declaration
+ *******************************************************************/
+
+/* Begin namespace openfpga */
+namespace openfpga {
+
+bool find_command_num_threads(const Command& cmd,
+                              const CommandContext& cmd_context,
+                              const CommandOptionId& opt_threads,
+                              size_t& num_threads);
+
+} /* End namespace openfpga */
+
+#endif
@@ -6,6 +6,7 @@
 #include <vector>
 #include <functional>
 #include <ctime>
+#include <istream>
 
 #include "vtr_vector.h"
 #include "vtr_range.h"
@@ -87,6 +88,16 @@ class Shell {
     std::vector<ShellCommandId> commands_by_class(const ShellCommandClassId& cmd_class_id) const;
   public: /* Public mutators */
     void add_title(const char* title);
+    /* Enable the profiling of each executed command,
+     * whose report will be written to the given file when the shell quits
+     */
+    void set_profile_file(const std::string& profile_file);
+    /* Set the number of threads to execute the commands of a script concurrently
+     * Only the consecutive commands which can not modify the data exchange <T>
+     * (whose execute functions are const) and do not depend on each other
+     * are executed concurrently. A zero means using all the hardware threads
+     */
+    void set_num_concurrent_commands(const size_t& num_threads);
     ShellCommandId add_command(const Command& cmd, const char* descr);
     void set_command_class(const ShellCommandId& cmd_id, const ShellCommandClassId& cmd_class_id);
     /* Link the execute function to a command
@@ -135,6 +146,11 @@ class Shell {
 
     void set_command_dependency(const ShellCommandId& cmd_id,
                                 const std::vector<ShellCommandId>& cmd_dependency);
+    /* A successful execution of the command meets the dependency on the substituted commands,
+     * e.g., a command which restores the results of other commands from a file
+     */
+    void set_command_substitutes(const ShellCommandId& cmd_id,
+                                 const std::vector<ShellCommandId>& substituted_cmds);
     ShellCommandClassId add_command_class(const char* name);
   public: /* Public validators */
     bool valid_command_id(const ShellCommandId& cmd_id) const;
@@ -146,6 +162,27 @@ class Shell {
     void run_script_mode(const char* script_file_name,
                          T& context,
                          const bool& batch_mode = false);
+    /* Start the server mode, where each line of the job file is a script to run
+     * The shell and its context stay alive between jobs, so that the data
+     * built by a job, e.g., the fabric, can be reused by the following jobs
+     * The job file can be a named pipe, so that jobs can be sent by other processes
+     * The job_reset_func is called before each job, except the first one,
+     * to drop the data which should not be shared between jobs
+     */
+    void run_server_mode(const char* job_file_name,
+                         T& context,
+                         const std::function<void(T&)>& job_reset_func);
+    /* Run the jobs of a job file, in the same format as the server mode,
+     * each in a child process forked from the current one, with up to num_processes at a time
+     * The children share the context built so far, e.g., the fabric, in a copy-on-write way,
+     * so that nothing has to be rebuilt or made thread-safe
+     * The job_reset_func is called in each child before its job
+     * Return CMD_EXEC_FATAL_ERROR if any job fails, CMD_EXEC_SUCCESS otherwise
+     */
+    int run_forked_jobs(const char* job_file_name,
+                        T& context,
+                        const size_t& num_processes,
+                        const std::function<void(T&)>& job_reset_func);
     /* Print all the commands by their classes. This is actually the help desk */
     void print_commands() const;
     /* Find the exit code (assume quit shell now) */
@@ -154,7 +191,37 @@ class Shell {
     int execution_errors() const;
     /* Quit the shell */
     void exit(const int& init_err = 0) const;
+    /* Write the profiling results of executed commands to a CSV file
+     * Return 0 when profiling is disabled or succeed
+     */
+    int write_profile_report() const;
+  private: /* Private validators */
+    /* Check if a command, or any command substituting it, has been executed successfully */
+    bool command_dependency_met(const ShellCommandId& dep_cmd_id) const;
+  private: /* Private parsers */
+    /* Read the next script to run from a job file, where empty lines and
+     * lines starting with '#' are skipped
+     * Return false when the end of the job file is reached
+     */
+    bool read_next_job_script(std::istream& job_fp, std::string& job_script) const;
   private: /* Private executors */
+    /* Execute the commands of a script, until the end or a fatal error happens */
+    int execute_script(std::istream& fp, T& context);
+    /* Defer a command to be executed concurrently with the deferred ones,
+     * return false if the command has to be executed alone
+     */
+    bool defer_concurrent_command(const std::string& cmd_line,
+                                  std::vector<std::string>& concurrent_cmd_lines) const;
+    /* Execute a list of independent read-only commands concurrently */
+    int execute_concurrent_commands(const std::vector<std::string>& cmd_lines, T& context);
+    /* Execute a command and record its profiling results when profiling is enabled */
+    int execute_and_profile_command(const char* cmd_line, T& common_context);
+    void record_command_profile(const std::string& cmd_line,
+                                const int& status,
+                                const float& wall_time,
+                                const double& cpu_time,
+                                const float& max_rss,
+                                const float& delta_max_rss);
     /* Execute a command, the command line is the user's input to launch a command
      * The common_context is the data structure to exchange data between commands
      */
@@ -214,6 +281,9 @@ class Shell {
      */
     vtr::vector<ShellCommandId, std::vector<ShellCommandId>> command_dependencies_;  
 
+    /* The commands which can substitute a command in the dependency graph */
+    vtr::vector<ShellCommandId, std::vector<ShellCommandId>> command_substitutes_;  
+
     /* Fast name look-up */
     std::map<std::string, ShellCommandId> command_name2ids_;
     std::map<std::string, ShellCommandClassId> command_class2ids_;
@@ -221,6 +291,20 @@ class Shell {
 
     /* Timer */
     std::clock_t time_start_;
+
+    /* Profiling results of each executed command, in the sequence of execution
+     * Profiling is disabled when the file name is empty
+     */
+    std::string profile_file_;
+    std::vector<std::string> profiled_command_names_;
+    std::vector<int> profiled_command_status_;
+    std::vector<float> profiled_wall_times_;
+    std::vector<double> profiled_cpu_times_;
+    std::vector<float> profiled_max_rss_;
+    std::vector<float> profiled_delta_max_rss_;
+
+    /* Number of threads to execute independent read-only commands concurrently */
+    size_t num_concurrent_commands_;
 };
 
 } /* End namespace openfpga */
@@ -1,15 +1,24 @@
 /*********************************************************************
  * Member functions for class Shell
  ********************************************************************/
+#include <cstdio>
+#include <iostream>
 #include <fstream>
 #include <algorithm>
+#include <map>
+#include <sys/stat.h>
+#include <sys/wait.h>
+#include <unistd.h>
 
 /* Headers from vtrutil library */
 #include "vtr_log.h"
 #include "vtr_assert.h"
+#include "vtr_time.h"
 
 /* Headers from openfpgautil library */
 #include "openfpga_tokenizer.h"
+#include "openfpga_parallel.h"
+#include "openfpga_hot_path_counters.h"
 
 /* Headers from readline library */
 #include <readline/readline.h>
@@ -29,6 +38,7 @@ template<class T>
 Shell<T>::Shell(const char* name) {
   name_ = std::string(name);
   time_start_ = 0;
+  num_concurrent_commands_ = 1;
 }
 
 /************************************************************************
@@ -109,6 +119,16 @@ void Shell<T>::add_title(const char* title) {
   title_ = std::string(title);
 }
 
+template<class T>
+void Shell<T>::set_num_concurrent_commands(const size_t& num_threads) {
+  num_concurrent_commands_ = find_num_threads(num_threads);
+}
+
+template<class T>
+void Shell<T>::set_profile_file(const std::string& profile_file) {
+  profile_file_ = profile_file;
+}
+
 /* Add a command with it description */
 template<class T>
 ShellCommandId Shell<T>::add_command(const Command& cmd, const char* descr) {
@@ -134,6 +154,7 @@ ShellCommandId Shell<T>::add_command(const Command& cmd, const char* descr) {
   command_macro_execute_functions_.emplace_back();
   command_status_.push_back(CMD_EXEC_NONE); /* By default, the command should be marked as fatal error as it has been never executed */
   command_dependencies_.emplace_back();
+  command_substitutes_.emplace_back();
 
   /* Register the name in the name2id map */
   command_name2ids_[cmd.name()] = shell_cmd;
@@ -213,6 +234,17 @@ void Shell<T>::set_command_dependency(const ShellCommandId& cmd_id,
   command_dependencies_[cmd_id] = dependent_cmds;
 }
 
+template<class T>
+void Shell<T>::set_command_substitutes(const ShellCommandId& cmd_id,
+                                       const std::vector<ShellCommandId>& substituted_cmds) {
+  /* Validate the command id as well as each of the substituted commands */
+  VTR_ASSERT(true == valid_command_id(cmd_id));
+  for (ShellCommandId substituted_cmd : substituted_cmds) {
+    VTR_ASSERT(true == valid_command_id(substituted_cmd));
+    command_substitutes_[substituted_cmd].push_back(cmd_id);
+  }
+}
+
 /* Add a command with it description */
 template<class T>
 ShellCommandClassId Shell<T>::add_command_class(const char* name) {
@@ -262,7 +294,7 @@ void Shell<T>::run_interactive_mode(T& context, const bool& quiet_mode) {
      * Add to history 
      */
     if (strlen(cmd_line) > 0) {
-      execute_command((const char*)cmd_line, context);
+      execute_and_profile_command((const char*)cmd_line, context);
       add_history(cmd_line);
     }
 
@@ -285,8 +317,6 @@ void Shell<T>::run_script_mode(const char* script_file_name,
     VTR_LOG("%s\n", title().c_str());
   } 
 
-  std::string line;
-
   /* Create an input file stream */
   std::ifstream fp(script_file_name);
 
@@ -297,6 +327,210 @@ void Shell<T>::run_script_mode(const char* script_file_name,
     return; 
   }
 
+  int status = execute_script(fp, context);
+  fp.close();
+
+  /* Check the execution status of the script, 
+   * if fatal error happened, we should abort immediately 
+   */
+  if (CMD_EXEC_FATAL_ERROR == status) {
+    /* If in the batch mode, we will exit with errors */ 
+    VTR_LOGV(batch_mode, "OpenFPGA Abort\n");
+    if (batch_mode) {
+      exit(CMD_EXEC_FATAL_ERROR);
+    }
+    /* If not in the batch mode, we will got to interactive mode */ 
+    VTR_LOGV(!batch_mode, "Enter interactive mode\n");
+  }
+
+  /* If not in batch mode, switch to interactive mode, stay tuned */
+  if (!batch_mode) {
+    run_interactive_mode(context, true); 
+  }
+}
+
+template <class T>
+void Shell<T>::run_server_mode(const char* job_file_name,
+                               T& context,
+                               const std::function<void(T&)>& job_reset_func) {
+
+  time_start_ = std::clock();
+
+  VTR_LOG("Start server mode of %s, reading jobs from %s...\n",
+          name().c_str(), job_file_name);
+
+  /* Print the title of the shell */
+  if (!title().empty()) {
+    VTR_LOG("%s\n", title().c_str());
+  } 
+
+  /* For a named pipe, reaching the end of file means that a client finishes writing.
+   * Reopen the pipe to wait for the next client, until an 'exit' is received
+   */
+  struct stat job_file_stat;
+  bool wait_for_jobs = (0 == stat(job_file_name, &job_file_stat)) && (S_ISFIFO(job_file_stat.st_mode));
+
+  size_t num_jobs = 0;
+  size_t num_failed_jobs = 0;
+  bool exit_server = false;
+  while (false == exit_server) {
+    std::ifstream job_fp(job_file_name);
+    if (!job_fp.is_open()) {
+      VTR_LOG("Fail to open the job file: %s! Please check its location\n",
+              job_file_name);
+      return; 
+    }
+
+    /* Each line is the path to a script to be executed
+     * The jobs are run as they are read, so that a client can send them one by one
+     */
+    std::string job_script;
+    while (true == read_next_job_script(job_fp, job_script)) {
+      if (std::string("exit") == job_script) {
+        exit_server = true;
+        break;
+      }
+
+      /* Drop the data left by the previous job */
+      if (0 < num_jobs) {
+        job_reset_func(context);
+      }
+
+      VTR_LOG("\nStart job %lu: %s\n", num_jobs, job_script.c_str());
+      int status = CMD_EXEC_FATAL_ERROR;
+      std::ifstream script_fp(job_script.c_str());
+      if (!script_fp.is_open()) {
+        VTR_LOG("Fail to open the script file: %s! Please check its location\n",
+                job_script.c_str());
+      } else {
+        status = execute_script(script_fp, context);
+        script_fp.close();
+      }
+ 
+      if (CMD_EXEC_FATAL_ERROR == status) {
+        num_failed_jobs++;
+      }
+      VTR_LOG("Finish job %lu: %s %s\n",
+              num_jobs, job_script.c_str(),
+              CMD_EXEC_FATAL_ERROR == status ? "with fatal errors" : "successfully");
+      num_jobs++;
+    }
+    job_fp.close();
+
+    if (false == wait_for_jobs) {
+      break;
+    }
+  }
+
+  VTR_LOG("\nServer mode finished %lu jobs, where %lu jobs have fatal errors\n",
+          num_jobs, num_failed_jobs);
+}
+
+template <class T>
+int Shell<T>::run_forked_jobs(const char* job_file_name,
+                              T& context,
+                              const size_t& num_processes,
+                              const std::function<void(T&)>& job_reset_func) {
+  VTR_ASSERT(0 < num_processes);
+
+  std::ifstream job_fp(job_file_name);
+  if (!job_fp.is_open()) {
+    VTR_LOG_ERROR("Fail to open the job file: %s! Please check its location\n",
+                  job_file_name);
+    return CMD_EXEC_FATAL_ERROR;
+  }
+
+  /* Each line is the path to a script to be executed */
+  std::vector<std::string> job_scripts;
+  std::string job_script;
+  while (true == read_next_job_script(job_fp, job_script)) {
+    job_scripts.push_back(job_script);
+  }
+  job_fp.close();
+
+  VTR_LOG("Run %lu jobs from %s with up to %lu processes...\n",
+          job_scripts.size(), job_file_name, num_processes);
+
+  /* Job index of each running child process */
+  std::map<pid_t, size_t> running_jobs;
+  size_t num_failed_jobs = 0;
+  size_t next_job = 0;
+  while ( (next_job < job_scripts.size())
+       || (false == running_jobs.empty()) ) {
+    /* Launch jobs until all the processes are busy */
+    if ( (next_job < job_scripts.size())
+      && (running_jobs.size() < num_processes) ) {
+      /* Flush the outputs, otherwise they are duplicated in the child */
+      std::cout.flush();
+      fflush(stdout);
+      pid_t pid = fork();
+      if (0 > pid) {
+        VTR_LOG_ERROR("Fail to create a process for job %lu: %s!\n",
+                      next_job, job_scripts[next_job].c_str());
+        num_failed_jobs++;
+        next_job++;
+        continue;
+      }
+      if (0 == pid) {
+        /* Child process: run the job and quit without returning to the caller */
+        job_reset_func(context);
+        int status = CMD_EXEC_FATAL_ERROR;
+        std::ifstream script_fp(job_scripts[next_job].c_str());
+        if (!script_fp.is_open()) {
+          VTR_LOG_ERROR("Fail to open the script file: %s! Please check its location\n",
+                        job_scripts[next_job].c_str());
+        } else {
+          status = execute_script(script_fp, context);
+          script_fp.close();
+        }
+        std::cout.flush();
+        fflush(stdout);
+        _exit(CMD_EXEC_FATAL_ERROR == status ? 1 : 0);
+      }
+      VTR_LOG("Start job %lu in process %d: %s\n",
+              next_job, int(pid), job_scripts[next_job].c_str());
+      running_jobs[pid] = next_job;
+      next_job++;
+      continue;
+    }
+
+    /* Wait for any process to finish */
+    int child_status = 0;
+    pid_t pid = waitpid(-1, &child_status, 0);
+    if (0 > pid) {
+      VTR_LOG_ERROR("Fail to wait for the processes of %lu running jobs!\n",
+                    running_jobs.size());
+      num_failed_jobs += running_jobs.size();
+      running_jobs.clear();
+      continue;
+    }
+    auto result = running_jobs.find(pid);
+    if (running_jobs.end() == result) {
+      continue;
+    }
+    bool job_succeed = WIFEXITED(child_status) && (0 == WEXITSTATUS(child_status));
+    if (false == job_succeed) {
+      num_failed_jobs++;
+    }
+    VTR_LOG("Finish job %lu: %s %s\n",
+            result->second, job_scripts[result->second].c_str(),
+            (true == job_succeed) ? "successfully" : "with fatal errors");
+    running_jobs.erase(result);
+  }
+
+  VTR_LOG("Finished %lu jobs, where %lu jobs have fatal errors\n",
+          job_scripts.size(), num_failed_jobs);
+
+  return (0 == num_failed_jobs) ? CMD_EXEC_SUCCESS : CMD_EXEC_FATAL_ERROR;
+}
+
+template <class T>
+int Shell<T>::execute_script(std::istream& fp, T& context) {
+  std::string line;
+
+  /* Read-only commands deferred to be executed concurrently */
+  std::vector<std::string> concurrent_cmd_lines;
+
   /* Consider that each line may not end due to the continued line charactor 
    * Use cmd_line to conjunct multiple lines 
    */
@@ -353,8 +587,22 @@ void Shell<T>::run_script_mode(const char* script_file_name,
 
     /* Process the command only when the full command line in ended */
     if (!cmd_line.empty()) {
+      /* Defer the read-only commands, which can be executed concurrently */
+      if (true == defer_concurrent_command(cmd_line, concurrent_cmd_lines)) {
+        cmd_line.clear();
+        continue;
+      }
+
+      /* Commands which may modify the context have to wait for the deferred commands */
+      int status = execute_concurrent_commands(concurrent_cmd_lines, context);
+      concurrent_cmd_lines.clear();
+      if (CMD_EXEC_FATAL_ERROR == status) {
+        VTR_LOG("Fatal error occurred!\n");
+        return CMD_EXEC_FATAL_ERROR;
+      }
+
       VTR_LOG("\nCommand line to execute: %s\n", cmd_line.c_str());
-      int status = execute_command(cmd_line.c_str(), context);
+      status = execute_and_profile_command(cmd_line.c_str(), context);
       /* Empty the line ready to start a new line */
       cmd_line.clear();
 
@@ -363,23 +611,100 @@ void Shell<T>::run_script_mode(const char* script_file_name,
        */
       if (CMD_EXEC_FATAL_ERROR == status) {
         VTR_LOG("Fatal error occurred!\n");
-        /* If in the batch mode, we will exit with errors */ 
-        VTR_LOGV(batch_mode, "OpenFPGA Abort\n");
-        if (batch_mode) {
-          exit(CMD_EXEC_FATAL_ERROR);
-        }
-        /* If not in the batch mode, we will got to interactive mode */ 
-        VTR_LOGV(!batch_mode, "Enter interactive mode\n");
-        break;
+        return CMD_EXEC_FATAL_ERROR;
       }
     }
   }
-  fp.close();
 
-  /* If not in batch mode, switch to interactive mode, stay tuned */
-  if (!batch_mode) {
-    run_interactive_mode(context, true); 
+  /* Finish the deferred commands */
+  if (CMD_EXEC_FATAL_ERROR == execute_concurrent_commands(concurrent_cmd_lines, context)) {
+    VTR_LOG("Fatal error occurred!\n");
+    return CMD_EXEC_FATAL_ERROR;
   }
+
+  return CMD_EXEC_SUCCESS;
+}
+
+template <class T>
+bool Shell<T>::defer_concurrent_command(const std::string& cmd_line,
+                                        std::vector<std::string>& concurrent_cmd_lines) const {
+  if (1 >= num_concurrent_commands_) {
+    return false;
+  }
+
+  /* Only the commands which can not modify the context can run concurrently */
+  openfpga::StringToken tokenizer(cmd_line);
+  ShellCommandId cmd_id = command(tokenizer.split(" ")[0]);
+  if ( (ShellCommandId::INVALID() == cmd_id)
+    || ( (CONST_STANDARD != command_execute_function_types_[cmd_id])
+      && (CONST_SHORT != command_execute_function_types_[cmd_id]) ) ) {
+    return false;
+  }
+
+  /* A command can not run together with itself, as they share the same parsing results,
+   * or with the commands it depends on, which have to finish earlier
+   */
+  for (const std::string& deferred_cmd_line : concurrent_cmd_lines) {
+    openfpga::StringToken deferred_tokenizer(deferred_cmd_line);
+    ShellCommandId deferred_cmd_id = command(deferred_tokenizer.split(" ")[0]);
+    if ( (deferred_cmd_id == cmd_id)
+      || (command_dependencies_[cmd_id].end() != std::find(command_dependencies_[cmd_id].begin(), command_dependencies_[cmd_id].end(), deferred_cmd_id)) ) {
+      return false;
+    }
+  }
+
+  concurrent_cmd_lines.push_back(cmd_line);
+  return true;
+}
+
+template <class T>
+int Shell<T>::execute_concurrent_commands(const std::vector<std::string>& cmd_lines,
+                                          T& context) {
+  /* Execute in the regular way when there is no concurrency */
+  if (1 >= cmd_lines.size()) {
+    for (const std::string& cmd_line : cmd_lines) {
+      VTR_LOG("\nCommand line to execute: %s\n", cmd_line.c_str());
+      if (CMD_EXEC_FATAL_ERROR == execute_and_profile_command(cmd_line.c_str(), context)) {
+        return CMD_EXEC_FATAL_ERROR;
+      }
+    }
+    return CMD_EXEC_SUCCESS;
+  }
+
+  VTR_LOG("\nCommand lines to execute concurrently:\n");
+  for (const std::string& cmd_line : cmd_lines) {
+    VTR_LOG("\t%s\n", cmd_line.c_str());
+  }
+
+  /* Each command writes its own results, which are recorded in the sequence of the script */
+  std::vector<int> status(cmd_lines.size(), CMD_EXEC_NONE);
+  std::vector<float> wall_times(cmd_lines.size(), 0.);
+  std::vector<double> cpu_times(cmd_lines.size(), 0.);
+  std::vector<float> max_rss(cmd_lines.size(), 0.);
+  std::vector<float> delta_max_rss(cmd_lines.size(), 0.);
+  parallel_for(cmd_lines.size(), num_concurrent_commands_,
+               [&](const size_t& icmd) {
+                 vtr::Timer timer;
+                 std::clock_t cpu_start = std::clock();
+                 status[icmd] = execute_command(cmd_lines[icmd].c_str(), context);
+                 wall_times[icmd] = timer.elapsed_sec();
+                 cpu_times[icmd] = (double)(std::clock() - cpu_start) / (double)CLOCKS_PER_SEC;
+                 max_rss[icmd] = timer.max_rss_mib();
+                 delta_max_rss[icmd] = timer.delta_max_rss_mib();
+               });
+
+  int batch_status = CMD_EXEC_SUCCESS;
+  for (size_t icmd = 0; icmd < cmd_lines.size(); ++icmd) {
+    if (false == profile_file_.empty()) {
+      record_command_profile(cmd_lines[icmd], status[icmd], wall_times[icmd],
+                             cpu_times[icmd], max_rss[icmd], delta_max_rss[icmd]);
+    }
+    if (CMD_EXEC_FATAL_ERROR == status[icmd]) {
+      batch_status = CMD_EXEC_FATAL_ERROR;
+    }
+  }
+
+  return batch_status;
 }
 
 template <class T>
@@ -459,15 +784,114 @@ void Shell<T>::exit(const int& init_err) const {
   VTR_LOG("\nThe entire OpenFPGA flow took %g seconds\n",
           (double)(std::clock() - time_start_) / (double)CLOCKS_PER_SEC);
 
+  /* Errors in writing the reports are not critical to the flow
+   * The calls of the hot look-ups are only counted when compiled with OPENFPGA_ENABLE_HOT_PATH_COUNTERS=ON
+   */
+  write_profile_report();
+  report_hot_path_counters(true == profile_file_.empty() ? std::string() : profile_file_ + ".hot_path.csv");
+
   VTR_LOG("\nThank you for using %s!\n",
           name().c_str());
 
   std::exit(shell_exit_code);
 }
 
+template <class T>
+int Shell<T>::write_profile_report() const {
+  if (true == profile_file_.empty()) {
+    return 0;
+  }
+
+  std::ofstream fp(profile_file_.c_str());
+  if (!fp.is_open()) {
+    VTR_LOG_ERROR("Fail to open the profile report file '%s'!\n",
+                  profile_file_.c_str());
+    return 1;
+  }
+
+  /* Each line is a command in the sequence of execution:
+   * Wall time and CPU time are in seconds, memory is in MiB
+   */
+  fp << "index,command,status,wall_time,cpu_time,max_rss,delta_max_rss\n";
+  for (size_t icmd = 0; icmd < profiled_command_names_.size(); ++icmd) {
+    fp << icmd << ","
+       << profiled_command_names_[icmd] << ","
+       << profiled_command_status_[icmd] << ","
+       << profiled_wall_times_[icmd] << ","
+       << profiled_cpu_times_[icmd] << ","
+       << profiled_max_rss_[icmd] << ","
+       << profiled_delta_max_rss_[icmd] << "\n";
+  }
+  fp.close();
+
+  VTR_LOG("\nWrote profiling results of %lu commands to '%s'\n",
+          profiled_command_names_.size(), profile_file_.c_str());
+
+  return 0;
+}
+
+/************************************************************************
+ * Private parsers
+ ***********************************************************************/
+template <class T>
+bool Shell<T>::read_next_job_script(std::istream& job_fp, std::string& job_script) const {
+  std::string line;
+  while (getline(job_fp, line)) {
+    StringToken line_tokenizer(line);
+    line_tokenizer.ltrim(std::string(" "));
+    line_tokenizer.rtrim(std::string(" "));
+    job_script = line_tokenizer.data();
+
+    /* Skip empty and commented lines */
+    if ( (true == job_script.empty())
+      || ('#' == job_script.front()) ) {
+      continue;
+    }
+    return true;
+  }
+  return false;
+}
+
 /************************************************************************
  * Private executors
  ***********************************************************************/
+template <class T>
+int Shell<T>::execute_and_profile_command(const char* cmd_line,
+                                          T& common_context) {
+  if (true == profile_file_.empty()) {
+    return execute_command(cmd_line, common_context);
+  }
+
+  vtr::Timer timer;
+  std::clock_t cpu_start = std::clock();
+
+  int status = execute_command(cmd_line, common_context);
+
+  record_command_profile(std::string(cmd_line), status, timer.elapsed_sec(),
+                         (double)(std::clock() - cpu_start) / (double)CLOCKS_PER_SEC,
+                         timer.max_rss_mib(), timer.delta_max_rss_mib());
+
+  return status;
+}
+
+template <class T>
+void Shell<T>::record_command_profile(const std::string& cmd_line,
+                                      const int& status,
+                                      const float& wall_time,
+                                      const double& cpu_time,
+                                      const float& max_rss,
+                                      const float& delta_max_rss) {
+  /* The name of a command is the first token of the command line */
+  openfpga::StringToken tokenizer(cmd_line);
+  std::vector<std::string> tokens = tokenizer.split(" ");
+  profiled_command_names_.push_back(tokens.empty() ? std::string() : tokens[0]);
+  profiled_command_status_.push_back(status);
+  profiled_wall_times_.push_back(wall_time);
+  profiled_cpu_times_.push_back(cpu_time);
+  profiled_max_rss_.push_back(max_rss);
+  profiled_delta_max_rss_.push_back(delta_max_rss);
+}
+
 template <class T>
 int Shell<T>::execute_command(const char* cmd_line,
                                T& common_context) {
@@ -485,8 +909,7 @@ int Shell<T>::execute_command(const char* cmd_line,
 
   /* Check the dependency graph to see if all the prequistics have been met */
   for (const ShellCommandId& dep_cmd : command_dependencies_[cmd_id]) {
-    if ( (CMD_EXEC_NONE == command_status_[dep_cmd])
-      || (CMD_EXEC_FATAL_ERROR == command_status_[dep_cmd]) ) {
+    if (false == command_dependency_met(dep_cmd)) {
       VTR_LOG("Command '%s' is required to be executed before command '%s'!\n",
               commands_[dep_cmd].name().c_str(), commands_[cmd_id].name().c_str());
       /* Echo the command help desk */
@@ -583,4 +1006,20 @@ bool Shell<T>::valid_command_class_id(const ShellCommandClassId& cmd_class_id) c
   return ( size_t(cmd_class_id) < command_class_ids_.size() ) && ( cmd_class_id == command_class_ids_[cmd_class_id] ); 
 }
 
+/************************************************************************
+ * Private validators
+ ***********************************************************************/
+template<class T>
+bool Shell<T>::command_dependency_met(const ShellCommandId& dep_cmd_id) const {
+  std::vector<ShellCommandId> candidate_cmds = command_substitutes_[dep_cmd_id];
+  candidate_cmds.push_back(dep_cmd_id);
+  for (const ShellCommandId& candidate_cmd : candidate_cmds) {
+    if ( (CMD_EXEC_NONE != command_status_[candidate_cmd])
+      && (CMD_EXEC_FATAL_ERROR != command_status_[candidate_cmd]) ) {
+      return true;
+    }
+  }
+  return false;
+}
+
 } /* End namespace openfpga */
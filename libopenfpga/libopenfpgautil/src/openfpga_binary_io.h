@@ -0,0 +1,319 @@
+#ifndef OPENFPGA_BINARY_IO_H
+#define OPENFPGA_BINARY_IO_H
+
+/********************************************************************
+ * This file includes a pair of archives, which write and read
+ * data structures in a raw binary form.
+ * They are used to dump architecture data structures into the binary
+ * images which are loaded much faster than parsing XML files again.
+ *
+ * A data structure is (de)serialized by listing its members in sequence
+ * in a member function:
+ *   template <class Archive>
+ *   void serialize(Archive& archive) { archive(member_a_, member_b_, ...); }
+ * so that the same list is used for both writing and reading.
+ *
+ * Note:
+ * The binary form depends on the machine and the compiler,
+ * it is meant to be a cache on the local machine, not an exchange format
+ *******************************************************************/
+#include <array>
+#include <cstdint>
+#include <istream>
+#include <map>
+#include <ostream>
+#include <string>
+#include <type_traits>
+#include <unordered_map>
+#include <vector>
+
+#include "vtr_geometry.h"
+#include "vtr_strong_id.h"
+#include "vtr_vector.h"
+
+#include "openfpga_port.h"
+
+/* namespace openfpga begins */
+namespace openfpga {
+
+/********************************************************************
+ * Archive to write data in binary form to an output stream
+ *******************************************************************/
+class BinaryWriter {
+  public: /* Constructors */
+    explicit BinaryWriter(std::ostream& fp) : fp_(fp) {}
+  public: /* Public accessors */
+    bool good() const { return fp_.good(); }
+  public: /* Public mutators */
+    void operator()() {}
+
+    template <typename T, typename... Ts>
+    void operator()(const T& value, const Ts&... values) {
+      write(value);
+      (*this)(values...);
+    }
+  private: /* Internal writers */
+    /* Plain numbers and enumerations are written as they are in memory */
+    template <typename T>
+    typename std::enable_if<std::is_arithmetic<T>::value || std::is_enum<T>::value>::type
+    write(const T& value) {
+      fp_.write(reinterpret_cast<const char*>(&value), sizeof(T));
+    }
+
+    void write_size(const size_t& size) {
+      write(static_cast<uint64_t>(size));
+    }
+
+    void write(const std::string& value) {
+      write_size(value.size());
+      fp_.write(value.data(), value.size());
+    }
+
+    template <typename tag, typename T, T sentinel>
+    void write(const vtr::StrongId<tag, T, sentinel>& id) {
+      write(static_cast<T>(size_t(id)));
+    }
+
+    template <typename T>
+    void write(const vtr::Point<T>& point) {
+      write(point.x());
+      write(point.y());
+    }
+
+    void write(const BasicPort& port) {
+      write(port.get_name());
+      write(port.get_lsb());
+      write(port.get_msb());
+      write(port.get_origin_port_width());
+    }
+
+    template <typename T, size_t N>
+    void write(const std::array<T, N>& values) {
+      for (const T& value : values) {
+        write(value);
+      }
+    }
+
+    template <typename T>
+    void write(const std::vector<T>& values) {
+      write_size(values.size());
+      for (size_t i = 0; i < values.size(); ++i) {
+        /* Bind elements to references, which also works for std::vector<bool> */
+        const T& value = values[i];
+        write(value);
+      }
+    }
+
+    template <typename K, typename V>
+    void write(const vtr::vector<K, V>& values) {
+      write_size(values.size());
+      for (size_t i = 0; i < values.size(); ++i) {
+        const V& value = values[K(i)];
+        write(value);
+      }
+    }
+
+    /* Data structures which list their members in a member function serialize() */
+    template <typename T>
+    typename std::enable_if<std::is_class<T>::value>::type
+    write(const T& value) {
+      /* The data is not modified by serialize() when writing */
+      const_cast<T&>(value).serialize(*this);
+    }
+
+    template <typename K, typename V>
+    void write(const std::map<K, V>& values) {
+      write_size(values.size());
+      for (const auto& pair : values) {
+        write(pair.first);
+        write(pair.second);
+      }
+    }
+
+    /* Note that the sequence of elements in an unordered map differs between runs,
+     * which does not matter as the elements are inserted back one by one
+     */
+    template <typename K, typename V>
+    void write(const std::unordered_map<K, V>& values) {
+      write_size(values.size());
+      for (const auto& pair : values) {
+        write(pair.first);
+        write(pair.second);
+      }
+    }
+
+  private: /* Internal data */
+    std::ostream& fp_;
+};
+
+/********************************************************************
+ * Archive to read data in binary form from an input stream
+ * Any error in reading, e.g., a truncated stream, is recorded
+ * and should be checked by good() after reading
+ *******************************************************************/
+class BinaryReader {
+  public: /* Constructors */
+    explicit BinaryReader(std::istream& fp) : fp_(fp) {
+      /* Find the number of remaining bytes, which bounds the size of any container */
+      std::streampos curr_pos = fp_.tellg();
+      fp_.seekg(0, std::ios::end);
+      num_bytes_ = fp_.tellg() - curr_pos;
+      fp_.seekg(curr_pos);
+      failed_ = !fp_.good();
+    }
+  public: /* Public accessors */
+    bool good() const { return !failed_ && fp_.good(); }
+  public: /* Public mutators */
+    /* Check if all the data of the stream has been read, which should be called
+     * only after the last value is read, as the stream is at its end afterwards
+     */
+    bool at_end() {
+      return good() && (std::istream::traits_type::eof() == fp_.peek());
+    }
+
+    void operator()() {}
+
+    template <typename T, typename... Ts>
+    void operator()(T& value, Ts&... values) {
+      read(value);
+      (*this)(values...);
+    }
+
+    /* Read a single value, e.g., to initialize a variable:
+     *   uint32_t num_nodes = reader.get<uint32_t>();
+     */
+    template <typename T>
+    T get() {
+      T value = T();
+      read(value);
+      return value;
+    }
+  private: /* Internal readers */
+    template <typename T>
+    typename std::enable_if<std::is_arithmetic<T>::value || std::is_enum<T>::value>::type
+    read(T& value) {
+      fp_.read(reinterpret_cast<char*>(&value), sizeof(T));
+    }
+
+    /* A corrupted size would cause a huge allocation.
+     * Since each element takes at least one byte, a size larger
+     * than the size of the stream must be an error
+     */
+    size_t read_size() {
+      uint64_t size = 0;
+      read(size);
+      if ((false == fp_.good()) || (size > num_bytes_)) {
+        failed_ = true;
+        return 0;
+      }
+      return size;
+    }
+
+    void read(std::string& value) {
+      value.resize(read_size());
+      if (0 < value.size()) {
+        fp_.read(&value[0], value.size());
+      }
+    }
+
+    template <typename tag, typename T, T sentinel>
+    void read(vtr::StrongId<tag, T, sentinel>& id) {
+      T value = sentinel;
+      read(value);
+      id = vtr::StrongId<tag, T, sentinel>(value);
+    }
+
+    template <typename T>
+    void read(vtr::Point<T>& point) {
+      T x = T();
+      T y = T();
+      read(x);
+      read(y);
+      point.set(x, y);
+    }
+
+    void read(BasicPort& port) {
+      std::string name;
+      size_t lsb = 0;
+      size_t msb = 0;
+      size_t origin_port_width = 0;
+      read(name);
+      read(lsb);
+      read(msb);
+      read(origin_port_width);
+      port.set_name(name);
+      port.set_lsb(lsb);
+      port.set_msb(msb);
+      port.set_origin_port_width(origin_port_width);
+    }
+
+    template <typename T, size_t N>
+    void read(std::array<T, N>& values) {
+      for (T& value : values) {
+        read(value);
+      }
+    }
+
+    template <typename T>
+    void read(std::vector<T>& values) {
+      values.clear();
+      values.resize(read_size());
+      for (size_t i = 0; i < values.size(); ++i) {
+        T value = T();
+        read(value);
+        values[i] = std::move(value);
+      }
+    }
+
+    template <typename K, typename V>
+    void read(vtr::vector<K, V>& values) {
+      values.clear();
+      values.resize(read_size());
+      for (size_t i = 0; i < values.size(); ++i) {
+        V value = V();
+        read(value);
+        values[K(i)] = std::move(value);
+      }
+    }
+
+    template <typename T>
+    typename std::enable_if<std::is_class<T>::value>::type
+    read(T& value) {
+      value.serialize(*this);
+    }
+
+    template <typename K, typename V>
+    void read(std::map<K, V>& values) {
+      values.clear();
+      size_t size = read_size();
+      for (size_t i = 0; i < size; ++i) {
+        K key = K();
+        V value = V();
+        read(key);
+        read(value);
+        values.emplace(std::move(key), std::move(value));
+      }
+    }
+
+    template <typename K, typename V>
+    void read(std::unordered_map<K, V>& values) {
+      values.clear();
+      size_t size = read_size();
+      for (size_t i = 0; i < size; ++i) {
+        K key = K();
+        V value = V();
+        read(key);
+        read(value);
+        values.emplace(std::move(key), std::move(value));
+      }
+    }
+
+  private: /* Internal data */
+    std::istream& fp_;
+    size_t num_bytes_;
+    bool failed_;
+};
+
+} /* namespace openfpga ends */
+
+#endif
@@ -0,0 +1,180 @@
+/********************************************************************
+ * Member functions for the data structure BufferedFileStream 
+ *******************************************************************/
+#include <cstdio>
+
+#include "vtr_assert.h"
+#include "vtr_log.h"
+
+#include "openfpga_buffered_file_stream.h"
+
+/* namespace openfpga begins */
+namespace openfpga {
+
+/* Postfix of the temporary file written when an existing file may be kept */
+constexpr char* FILE_UPDATE_TEMP_FILE_POSTFIX = ".tmp";
+
+/************************************************************************
+ * Check if two files have the same contents, which are compared by chunks
+ ***********************************************************************/
+static 
+bool same_file_contents(const std::string& fname_a,
+                        const std::string& fname_b) {
+  std::ifstream fp_a(fname_a, std::ifstream::binary);
+  std::ifstream fp_b(fname_b, std::ifstream::binary);
+  if ( (!fp_a.is_open()) || (!fp_b.is_open()) ) {
+    return false;
+  }
+  constexpr size_t CHUNK_SIZE = 64 * 1024;
+  std::unique_ptr<char[]> chunk_a(new char[CHUNK_SIZE]);
+  std::unique_ptr<char[]> chunk_b(new char[CHUNK_SIZE]);
+  while (true) {
+    fp_a.read(chunk_a.get(), CHUNK_SIZE);
+    fp_b.read(chunk_b.get(), CHUNK_SIZE);
+    if (fp_a.gcount() != fp_b.gcount()) {
+      return false;
+    }
+    if (0 != std::char_traits<char>::compare(chunk_a.get(), chunk_b.get(), size_t(fp_a.gcount()))) {
+      return false;
+    }
+    if ( (!fp_a) || (!fp_b) ) {
+      return (fp_a.eof() && fp_b.eof());
+    }
+  }
+}
+
+/************************************************************************
+ * Constructors
+ * The buffer should be given to the stream before opening the file,
+ * otherwise it may be ignored by the standard library
+ ***********************************************************************/
+BufferedFileStream::BufferedFileStream(const std::string& fname,
+                                       const size_t& buffer_size)
+  : BufferedFileStream(fname, FILE_COMPRESSION_NONE, buffer_size) {
+}
+
+/* When compressed, the stream writes to the compressor,
+ * which writes to the buffer of the file
+ * The file stream is still the one opened, e.g., for check_file_stream()
+ */
+BufferedFileStream::BufferedFileStream(const std::string& fname,
+                                       const e_file_compression& compression,
+                                       const size_t& buffer_size)
+  : BufferedFileStream(fname, compression, FILE_UPDATE_ALWAYS, buffer_size) {
+}
+
+/* The temporary file is only needed when the file exists */
+BufferedFileStream::BufferedFileStream(const std::string& fname,
+                                       const e_file_compression& compression,
+                                       const e_file_update& update,
+                                       const size_t& buffer_size) {
+  if (0 < buffer_size) {
+    buffer_.reset(new char[buffer_size]);
+    fp_.rdbuf()->pubsetbuf(buffer_.get(), buffer_size);
+  }
+  fname_ = compressed_file_name(fname, compression);
+  update_ = update;
+  file_updated_ = true;
+  write_fname_ = fname_;
+  if ( (FILE_UPDATE_IF_CHANGED == update_)
+    && (true == std::ifstream(fname_).good()) ) {
+    write_fname_ = fname_ + std::string(FILE_UPDATE_TEMP_FILE_POSTFIX);
+  }
+  if (FILE_COMPRESSION_NONE == compression) {
+    fp_.open(write_fname_, std::fstream::out | std::fstream::trunc);
+  } else {
+    fp_.open(write_fname_, std::fstream::out | std::fstream::trunc | std::fstream::binary);
+    VTR_ASSERT(FILE_COMPRESSION_GZIP == compression);
+    if (true == fp_.is_open()) {
+      gzip_buf_.reset(new GzipOutputStreamBuf(fp_.rdbuf()));
+      static_cast<std::ios&>(fp_).rdbuf(gzip_buf_.get());
+    }
+  }
+  num_bytes_ = 0;
+  elapsed_sec_ = 0.;
+}
+
+BufferedFileStream::~BufferedFileStream() {
+  close();
+}
+
+/************************************************************************
+ * Public accessors
+ ***********************************************************************/
+std::fstream& BufferedFileStream::stream() {
+  return fp_;
+}
+
+std::string BufferedFileStream::file_name() const {
+  return fname_;
+}
+
+size_t BufferedFileStream::num_bytes() const {
+  if ( (true == fp_.is_open()) && (nullptr != gzip_buf_) ) {
+    return gzip_buf_->num_bytes_in();
+  }
+  if (true == fp_.is_open()) {
+    /* tellp() is not const, but it does not change the stream */
+    std::streampos pos = const_cast<std::fstream&>(fp_).tellp();
+    if (0 <= pos) {
+      return size_t(pos);
+    }
+  }
+  return num_bytes_;
+}
+
+float BufferedFileStream::elapsed_sec() const {
+  if (true == fp_.is_open()) {
+    return timer_.elapsed_sec();
+  }
+  return elapsed_sec_;
+}
+
+float BufferedFileStream::bytes_per_sec() const {
+  float elapsed = elapsed_sec();
+  if (0. >= elapsed) {
+    return 0.;
+  }
+  return float(num_bytes()) / elapsed;
+}
+
+e_file_update BufferedFileStream::update() const {
+  return update_;
+}
+
+bool BufferedFileStream::file_updated() const {
+  return file_updated_;
+}
+
+/************************************************************************
+ * Public mutators
+ ***********************************************************************/
+void BufferedFileStream::close() {
+  if (false == fp_.is_open()) {
+    return;
+  }
+  num_bytes_ = num_bytes();
+  /* Writing the buffer to the file is part of the time */
+  fp_.flush();
+  if (nullptr != gzip_buf_) {
+    if (false == gzip_buf_->finish()) {
+      VTR_LOG_ERROR("Failed to compress file '%s'!\n", fname_.c_str());
+    }
+    /* The file stream writes to its own buffer again */
+    static_cast<std::ios&>(fp_).rdbuf(fp_.rdbuf());
+  }
+  fp_.close();
+
+  /* Keep the existing file if the contents are the same */
+  if (write_fname_ != fname_) {
+    if (true == same_file_contents(write_fname_, fname_)) {
+      std::remove(write_fname_.c_str());
+      file_updated_ = false;
+    } else if (0 != std::rename(write_fname_.c_str(), fname_.c_str())) {
+      VTR_LOG_ERROR("Failed to update file '%s'!\n", fname_.c_str());
+    }
+  }
+  elapsed_sec_ = timer_.elapsed_sec();
+}
+
+} /* namespace openfpga ends */
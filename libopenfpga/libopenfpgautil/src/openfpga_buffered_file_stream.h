@@ -0,0 +1,101 @@
+#ifndef OPENFPGA_BUFFERED_FILE_STREAM_H
+#define OPENFPGA_BUFFERED_FILE_STREAM_H
+
+/********************************************************************
+ * Include header files that are required by data structure declaration
+ *******************************************************************/
+#include <fstream>
+#include <memory>
+#include <string>
+
+#include "vtr_time.h"
+
+#include "openfpga_compressed_stream.h"
+
+/* namespace openfpga begins */
+namespace openfpga {
+
+/* Default size of the memory buffer of a file stream: 4 MB */
+constexpr size_t DEFAULT_FILE_STREAM_BUFFER_SIZE = 4 * 1024 * 1024;
+
+/* How an existing file is updated by a file stream */
+enum e_file_update {
+  FILE_UPDATE_ALWAYS, /* The file is overwritten */
+  FILE_UPDATE_IF_CHANGED /* The file, and thus its modification time, is kept when the contents are the same */
+};
+
+/********************************************************************
+ * An output file stream with a large memory buffer
+ * Writers output to the stream as usual, through stream(),
+ * while the contents are written to the file only when the buffer is full 
+ * or when the stream is closed. 
+ * This saves many system calls for netlists with millions of lines.
+ * Note: 
+ *   Writers should use '\n' rather than std::endl, 
+ *   which flushes the buffer at each line
+ *
+ * The contents can also be compressed as they are written,
+ * in which case the extension of the compression, e.g., '.gz',
+ * is appended to the file name
+ *
+ * An existing file can be kept when the contents written are the same,
+ * so that incremental flows, e.g., simulators, do not process it again.
+ * The contents are then written to a temporary file, which is compared
+ * with the existing file and replaces it only if they are different
+ *
+ * Example:
+ *   BufferedFileStream fp(fname);
+ *   check_file_stream(fname.c_str(), fp.stream());
+ *   fp.stream() << "module top;\n";
+ *   fp.close();
+ *******************************************************************/
+class BufferedFileStream {
+  public: /* Constructors */
+    explicit BufferedFileStream(const std::string& fname,
+                                const size_t& buffer_size = DEFAULT_FILE_STREAM_BUFFER_SIZE);
+    BufferedFileStream(const std::string& fname,
+                       const e_file_compression& compression,
+                       const size_t& buffer_size = DEFAULT_FILE_STREAM_BUFFER_SIZE);
+    BufferedFileStream(const std::string& fname,
+                       const e_file_compression& compression,
+                       const e_file_update& update,
+                       const size_t& buffer_size = DEFAULT_FILE_STREAM_BUFFER_SIZE);
+    ~BufferedFileStream();
+    /* No copy, as the stream refers to the buffer */
+    BufferedFileStream(const BufferedFileStream&) = delete;
+    BufferedFileStream& operator=(const BufferedFileStream&) = delete;
+  public: /* Public accessors */
+    std::fstream& stream();
+    /* Name of the file written, including the extension of the compression */
+    std::string file_name() const;
+    /* Number of bytes written so far, before compression */
+    size_t num_bytes() const;
+    /* Time in seconds since the stream is opened, until it is closed */
+    float elapsed_sec() const;
+    /* Throughput in bytes per second */
+    float bytes_per_sec() const;
+    e_file_update update() const;
+    /* If the file is created or its contents are changed, which is known once the stream is closed */
+    bool file_updated() const;
+  public: /* Public mutators */
+    /* Flush the buffer to the file and close it */
+    void close(); 
+  private: /* Internal data */
+    /* Not initialized, so that only the pages in use are mapped by the system */
+    std::unique_ptr<char[]> buffer_;
+    std::fstream fp_;
+    std::string fname_;
+    /* The file actually written, which is a temporary file when an existing file may be kept */
+    std::string write_fname_;
+    e_file_update update_;
+    bool file_updated_;
+    /* Compressor between the stream and the file, if any */
+    std::unique_ptr<GzipOutputStreamBuf> gzip_buf_;
+    size_t num_bytes_;
+    float elapsed_sec_;
+    vtr::Timer timer_;
+};
+
+} /* namespace openfpga ends */
+
+#endif
@@ -0,0 +1,297 @@
+/********************************************************************
+ * This file includes functions to write and read compressed files
+ * Compression in gzip format is available only when built with zlib,
+ * i.e., when OPENFPGA_WITH_ZLIB is defined
+ *******************************************************************/
+#include <cstring>
+#include <fstream>
+#include <sstream>
+
+#ifdef OPENFPGA_WITH_ZLIB
+#include <zlib.h>
+#endif
+
+/* Headers from vtrutil library */
+#include "vtr_assert.h"
+#include "vtr_log.h"
+
+/* Headers from openfpgautil library */
+#include "openfpga_compressed_stream.h"
+
+/* namespace openfpga begins */
+namespace openfpga {
+
+/* Magic number at the beginning of any gzip file */
+constexpr unsigned char GZIP_MAGIC_NUMBER[2] = {0x1f, 0x8b};
+
+/********************************************************************
+ * Public functions on the compression types
+ *******************************************************************/
+e_file_compression find_file_compression(const std::string& compression_name) {
+  for (size_t icompression = 0; icompression < NUM_FILE_COMPRESSIONS; ++icompression) {
+    if (compression_name == std::string(FILE_COMPRESSION_STRING[icompression])) {
+      return e_file_compression(icompression);
+    }
+  }
+  return NUM_FILE_COMPRESSIONS;
+}
+
+bool file_compression_supported(const e_file_compression& compression) {
+  switch (compression) {
+  case FILE_COMPRESSION_NONE:
+    return true;
+  case FILE_COMPRESSION_GZIP:
+#ifdef OPENFPGA_WITH_ZLIB
+    return true;
+#else
+    return false;
+#endif
+  default:
+    return false;
+  }
+}
+
+e_file_compression find_supported_file_compression(const std::string& compression_name) {
+  e_file_compression compression = find_file_compression(compression_name);
+  if (NUM_FILE_COMPRESSIONS == compression) {
+    VTR_LOG_ERROR("Invalid compression '%s'! Expect ['%s'|'%s']\n",
+                  compression_name.c_str(),
+                  FILE_COMPRESSION_STRING[FILE_COMPRESSION_NONE],
+                  FILE_COMPRESSION_STRING[FILE_COMPRESSION_GZIP]);
+    return NUM_FILE_COMPRESSIONS;
+  }
+  if (false == file_compression_supported(compression)) {
+    VTR_LOG_ERROR("Compression '%s' is not supported, as OpenFPGA is built without zlib!\n",
+                  compression_name.c_str());
+    return NUM_FILE_COMPRESSIONS;
+  }
+  return compression;
+}
+
+std::string compressed_file_name(const std::string& fname,
+                                 const e_file_compression& compression) {
+  VTR_ASSERT(NUM_FILE_COMPRESSIONS != compression);
+  return fname + std::string(FILE_COMPRESSION_EXTENSION[compression]);
+}
+
+/********************************************************************
+ * Member functions for GzipOutputStreamBuf
+ *******************************************************************/
+struct GzipOutputStreamBuf::t_zstream {
+#ifdef OPENFPGA_WITH_ZLIB
+  z_stream strm;
+#endif
+};
+
+GzipOutputStreamBuf::GzipOutputStreamBuf(std::streambuf* sink,
+                                         const size_t& buffer_size)
+  : sink_(sink),
+    in_buffer_(buffer_size),
+    out_buffer_(buffer_size),
+    zstream_(new t_zstream),
+    num_bytes_in_(0),
+    num_bytes_out_(0),
+    finished_(false) {
+  VTR_ASSERT(nullptr != sink_);
+  VTR_ASSERT(0 < buffer_size);
+  VTR_ASSERT(true == file_compression_supported(FILE_COMPRESSION_GZIP));
+#ifdef OPENFPGA_WITH_ZLIB
+  std::memset(&zstream_->strm, 0, sizeof(z_stream));
+  /* A window of 15 bits plus 16 selects the gzip format instead of the zlib one */
+  int status = deflateInit2(&zstream_->strm, Z_DEFAULT_COMPRESSION, Z_DEFLATED,
+                            15 + 16, 8, Z_DEFAULT_STRATEGY);
+  VTR_ASSERT(Z_OK == status);
+#endif
+  setp(in_buffer_.data(), in_buffer_.data() + in_buffer_.size());
+}
+
+GzipOutputStreamBuf::~GzipOutputStreamBuf() {
+  finish();
+#ifdef OPENFPGA_WITH_ZLIB
+  deflateEnd(&zstream_->strm);
+#endif
+}
+
+size_t GzipOutputStreamBuf::num_bytes_in() const {
+  return num_bytes_in_ + size_t(pptr() - pbase());
+}
+
+size_t GzipOutputStreamBuf::num_bytes_out() const {
+  return num_bytes_out_;
+}
+
+bool GzipOutputStreamBuf::finish() {
+  if (true == finished_) {
+    return true;
+  }
+  bool status = deflate_input(true);
+  finished_ = true;
+  /* Nothing can be written any more */
+  setp(nullptr, nullptr);
+  return status && (0 == sink_->pubsync());
+}
+
+GzipOutputStreamBuf::int_type GzipOutputStreamBuf::overflow(int_type ch) {
+  if (true == finished_) {
+    return traits_type::eof();
+  }
+  if (false == deflate_input(false)) {
+    return traits_type::eof();
+  }
+  if (false == traits_type::eq_int_type(ch, traits_type::eof())) {
+    *pptr() = traits_type::to_char_type(ch);
+    pbump(1);
+  }
+  return traits_type::not_eof(ch);
+}
+
+/* Only the contents buffered are compressed, without flushing the compressor,
+ * which would degrade the compression ratio
+ */
+int GzipOutputStreamBuf::sync() {
+  if (true == finished_) {
+    return 0;
+  }
+  return (true == deflate_input(false)) ? 0 : -1;
+}
+
+bool GzipOutputStreamBuf::deflate_input(const bool& last) {
+#ifdef OPENFPGA_WITH_ZLIB
+  z_stream& strm = zstream_->strm;
+  size_t num_bytes = size_t(pptr() - pbase());
+  strm.next_in = reinterpret_cast<Bytef*>(pbase());
+  strm.avail_in = uInt(num_bytes);
+  int flush = (true == last) ? Z_FINISH : Z_NO_FLUSH;
+  int status = Z_OK;
+  do {
+    strm.next_out = reinterpret_cast<Bytef*>(out_buffer_.data());
+    strm.avail_out = uInt(out_buffer_.size());
+    status = deflate(&strm, flush);
+    if (Z_STREAM_ERROR == status) {
+      return false;
+    }
+    size_t num_bytes_out = out_buffer_.size() - strm.avail_out;
+    if (std::streamsize(num_bytes_out) != sink_->sputn(out_buffer_.data(), num_bytes_out)) {
+      return false;
+    }
+    num_bytes_out_ += num_bytes_out;
+  } while ( (0 == strm.avail_out)
+         || ((true == last) && (Z_STREAM_END != status)) );
+  VTR_ASSERT(0 == strm.avail_in);
+
+  num_bytes_in_ += num_bytes;
+  setp(in_buffer_.data(), in_buffer_.data() + in_buffer_.size());
+  return true;
+#else
+  (void)last;
+  return false;
+#endif
+}
+
+/********************************************************************
+ * Member functions for CompressedInputFile
+ *******************************************************************/
+struct CompressedInputFile::t_gz_file {
+#ifdef OPENFPGA_WITH_ZLIB
+  gzFile fp = nullptr;
+#endif
+};
+
+CompressedInputFile::CompressedInputFile(const std::string& fname)
+  : gz_file_(new t_gz_file),
+    compressed_(is_gzip_file(fname)),
+    open_(false) {
+  if (true == compressed_) {
+#ifdef OPENFPGA_WITH_ZLIB
+    gz_file_->fp = gzopen(fname.c_str(), "rb");
+    open_ = (nullptr != gz_file_->fp);
+#else
+    VTR_LOG_ERROR("File '%s' is compressed by gzip, which is not supported as OpenFPGA is built without zlib!\n",
+                  fname.c_str());
+#endif
+    return;
+  }
+  fp_.open(fname, std::ifstream::binary);
+  open_ = fp_.is_open();
+}
+
+CompressedInputFile::~CompressedInputFile() {
+#ifdef OPENFPGA_WITH_ZLIB
+  if (nullptr != gz_file_->fp) {
+    gzclose(gz_file_->fp);
+  }
+#endif
+}
+
+bool CompressedInputFile::is_open() const {
+  return open_;
+}
+
+bool CompressedInputFile::is_compressed() const {
+  return compressed_;
+}
+
+long CompressedInputFile::read(char* buffer, const size_t& num_bytes) {
+  if (false == open_) {
+    return -1;
+  }
+  if (true == compressed_) {
+#ifdef OPENFPGA_WITH_ZLIB
+    return gzread(gz_file_->fp, buffer, unsigned(num_bytes));
+#else
+    return -1;
+#endif
+  }
+  fp_.read(buffer, std::streamsize(num_bytes));
+  if (fp_.bad()) {
+    return -1;
+  }
+  return long(fp_.gcount());
+}
+
+/********************************************************************
+ * Public functions to read files
+ *******************************************************************/
+bool is_gzip_file(const std::string& fname) {
+  std::ifstream fp(fname, std::ifstream::binary);
+  unsigned char magic[2] = {0, 0};
+  if (!fp.read(reinterpret_cast<char*>(magic), 2)) {
+    return false;
+  }
+  return (GZIP_MAGIC_NUMBER[0] == magic[0]) && (GZIP_MAGIC_NUMBER[1] == magic[1]);
+}
+
+bool read_file_contents(const std::string& fname, std::string& contents) {
+  contents.clear();
+
+  if (true == is_gzip_file(fname)) {
+#ifdef OPENFPGA_WITH_ZLIB
+    gzFile gz_fp = gzopen(fname.c_str(), "rb");
+    if (nullptr == gz_fp) {
+      return false;
+    }
+    char buffer[64 * 1024];
+    int num_bytes = 0;
+    while (0 < (num_bytes = gzread(gz_fp, buffer, sizeof(buffer)))) {
+      contents.append(buffer, num_bytes);
+    }
+    gzclose(gz_fp);
+    return 0 == num_bytes;
+#else
+    VTR_LOG_ERROR("File '%s' is compressed by gzip, which is not supported as OpenFPGA is built without zlib!\n",
+                  fname.c_str());
+    return false;
+#endif
+  }
+
+  std::ifstream fp(fname, std::ifstream::binary);
+  if (!fp.is_open()) {
+    return false;
+  }
+  std::ostringstream ss;
+  ss << fp.rdbuf();
+  contents = ss.str();
+  return true;
+}
+
+} /* namespace openfpga ends */
@@ -0,0 +1,148 @@
+#ifndef OPENFPGA_COMPRESSED_STREAM_H
+#define OPENFPGA_COMPRESSED_STREAM_H
+
+/********************************************************************
+ * Include header files that are required by data structure declaration
+ *******************************************************************/
+#include <array>
+#include <fstream>
+#include <memory>
+#include <streambuf>
+#include <string>
+#include <vector>
+
+/* namespace openfpga begins */
+namespace openfpga {
+
+/* Compression of output files */
+enum e_file_compression {
+  FILE_COMPRESSION_NONE,
+  FILE_COMPRESSION_GZIP,
+  NUM_FILE_COMPRESSIONS
+};
+/* Strings used in command options */
+constexpr std::array<const char*, NUM_FILE_COMPRESSIONS> FILE_COMPRESSION_STRING = {{"none", "gzip"}};
+/* Extensions appended to the names of compressed files */
+constexpr std::array<const char*, NUM_FILE_COMPRESSIONS> FILE_COMPRESSION_EXTENSION = {{"", ".gz"}};
+
+/* Decode the compression from a string, return NUM_FILE_COMPRESSIONS if invalid */
+e_file_compression find_file_compression(const std::string& compression_name);
+
+/* Whether the compression is available in this build, as gzip requires zlib */
+bool file_compression_supported(const e_file_compression& compression);
+
+/* Decode the compression from a string given by users and check if it is supported.
+ * Errors are reported and NUM_FILE_COMPRESSIONS is returned otherwise
+ */
+e_file_compression find_supported_file_compression(const std::string& compression_name);
+
+/* Name of the file written with the given compression */
+std::string compressed_file_name(const std::string& fname,
+                                 const e_file_compression& compression);
+
+/********************************************************************
+ * A stream buffer which compresses the contents in gzip format
+ * and writes them to another stream buffer, e.g., the one of a file stream.
+ * The contents are compressed by chunks as they are written,
+ * so that the uncompressed contents are never held in memory or on disk.
+ *
+ * Example:
+ *   std::fstream fp(fname + ".gz", std::fstream::out | std::fstream::binary);
+ *   GzipOutputStreamBuf gzip_buf(fp.rdbuf());
+ *   std::ostream os(&gzip_buf);
+ *   os << "module top;\n";
+ *   gzip_buf.finish();
+ *   fp.close();
+ *
+ * This is available only when built with zlib, see file_compression_supported()
+ *******************************************************************/
+class GzipOutputStreamBuf : public std::streambuf {
+  public: /* Constructors */
+    explicit GzipOutputStreamBuf(std::streambuf* sink,
+                                 const size_t& buffer_size = 256 * 1024);
+    ~GzipOutputStreamBuf();
+    GzipOutputStreamBuf(const GzipOutputStreamBuf&) = delete;
+    GzipOutputStreamBuf& operator=(const GzipOutputStreamBuf&) = delete;
+  public: /* Public accessors */
+    /* Number of uncompressed bytes written so far */
+    size_t num_bytes_in() const;
+    /* Number of compressed bytes written to the sink so far */
+    size_t num_bytes_out() const;
+  public: /* Public mutators */
+    /* Compress the remaining contents and write the gzip trailer.
+     * Nothing can be written afterwards
+     */
+    bool finish();
+  protected: /* Overloaded functions of std::streambuf */
+    int_type overflow(int_type ch) override;
+    int sync() override;
+  private: /* Internal functions */
+    /* Compress the contents in the input buffer, return false on errors */
+    bool deflate_input(const bool& last);
+  private: /* Internal data */
+    std::streambuf* sink_;
+    std::vector<char> in_buffer_;
+    std::vector<char> out_buffer_;
+    /* The z_stream of zlib, which is hidden from the users of this header */
+    struct t_zstream;
+    std::unique_ptr<t_zstream> zstream_;
+    size_t num_bytes_in_;
+    size_t num_bytes_out_;
+    bool finished_;
+};
+
+/********************************************************************
+ * A file which is read by chunks, whose contents are decompressed
+ * on the fly when the file is compressed by gzip, 
+ * so that large files can be parsed without holding them in memory.
+ * Files compressed by gzip can be read only when built with zlib
+ *
+ * Example:
+ *   CompressedInputFile fp(fname);
+ *   char buffer[4096];
+ *   long num_bytes = 0;
+ *   while (0 < (num_bytes = fp.read(buffer, sizeof(buffer)))) {
+ *     parse(buffer, num_bytes);
+ *   }
+ *******************************************************************/
+class CompressedInputFile {
+  public: /* Constructors */
+    explicit CompressedInputFile(const std::string& fname);
+    ~CompressedInputFile();
+    CompressedInputFile(const CompressedInputFile&) = delete;
+    CompressedInputFile& operator=(const CompressedInputFile&) = delete;
+  public: /* Public accessors */
+    /* Whether the file is opened, which fails for missing files 
+     * and for compressed files when built without zlib
+     */
+    bool is_open() const;
+    /* Whether the file is compressed by gzip */
+    bool is_compressed() const;
+  public: /* Public mutators */
+    /* Read at most num_bytes bytes of the uncompressed contents into a buffer.
+     * Return the number of bytes read, which is 0 at the end of the file, 
+     * or -1 on errors
+     */
+    long read(char* buffer, const size_t& num_bytes);
+  private: /* Internal data */
+    /* The gzFile of zlib, which is hidden from the users of this header */
+    struct t_gz_file;
+    std::unique_ptr<t_gz_file> gz_file_;
+    std::ifstream fp_;
+    bool compressed_;
+    bool open_;
+};
+
+/* Read all the contents of a file into a string.
+ * Files compressed by gzip are decompressed, when built with zlib.
+ * Return false if the file cannot be opened, the gzip stream is truncated,
+ * or the file is compressed while zlib is not available
+ */
+bool read_file_contents(const std::string& fname, std::string& contents);
+
+/* Whether a file starts with the magic number of gzip */
+bool is_gzip_file(const std::string& fname);
+
+} /* namespace openfpga ends */
+
+#endif
@@ -0,0 +1,38 @@
+/********************************************************************
+ * This file includes functions to load XML files which may be compressed
+ *******************************************************************/
+/* Headers from openfpgautil library */
+#include "openfpga_compressed_stream.h"
+#include "openfpga_compressed_xml.h"
+
+/* namespace openfpga begins */
+namespace openfpga {
+
+pugiutil::loc_data load_compressed_xml(pugi::xml_document& doc,
+                                       const std::string& fname) {
+  if (false == is_gzip_file(fname)) {
+    return pugiutil::load_xml(doc, fname);
+  }
+
+  std::string contents;
+  if (false == read_file_contents(fname, contents)) {
+    throw pugiutil::XmlError("Unable to read compressed XML file '" + fname + "'",
+                             fname, 0);
+  }
+
+  /* Line numbers are found from the decompressed contents */
+  pugiutil::loc_data location_data(fname, contents.data(), contents.size(), 1);
+
+  pugi::xml_parse_result load_result = doc.load_buffer(contents.data(), contents.size());
+  if (!load_result) {
+    size_t line = location_data.line(load_result.offset);
+    size_t col = location_data.col(load_result.offset);
+    throw pugiutil::XmlError("Unable to load XML file '" + fname + "', " + load_result.description()
+                             + " (line: " + std::to_string(line) + " col: " + std::to_string(col) + ")",
+                             fname, line);
+  }
+
+  return location_data;
+}
+
+} /* namespace openfpga ends */
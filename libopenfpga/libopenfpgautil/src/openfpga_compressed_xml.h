@@ -0,0 +1,23 @@
+#ifndef OPENFPGA_COMPRESSED_XML_H
+#define OPENFPGA_COMPRESSED_XML_H
+
+/********************************************************************
+ * Include header files that are required by function declaration
+ *******************************************************************/
+#include <string>
+#include "pugixml.hpp"
+#include "pugixml_util.hpp"
+
+/* namespace openfpga begins */
+namespace openfpga {
+
+/* Load an XML file, which can be compressed by gzip, e.g., when written by
+ * commands with the option '--compress gzip'.
+ * Same as pugiutil::load_xml() for uncompressed files
+ */
+pugiutil::loc_data load_compressed_xml(pugi::xml_document& doc,
+                                       const std::string& fname);
+
+} /* namespace openfpga ends */
+
+#endif
@@ -8,6 +8,7 @@
 
 /* Headers from vtrutil library */
 #include "vtr_log.h"
+#include "vtr_digest.h"
 
 /* Headers from openfpgautil library */
 #include "openfpga_digest.h" 
@@ -272,4 +273,16 @@ bool write_tab_to_file(std::fstream& fp,
   return true;
 }
 
+/******************************************************************** 
+ * Generate a secure hash of a buffer, e.g., the keys of a cache
+ * which are written by a binary archive
+ * Only the hex digits are returned, so that the hash can be
+ * a part of file names
+ ********************************************************************/
+std::string secure_digest_hex(const std::string& data) {
+  std::string digest = vtr::secure_digest_buffer(data.data(), data.size());
+  /* Remove the prefix of the hash type, e.g., 'SHA256:' */
+  return digest.substr(digest.find(':') + 1);
+}
+
 } /* namespace openfpga ends */
@@ -0,0 +1,61 @@
+/********************************************************************
+ * This file includes the counters on the hot look-ups of the
+ * databases of OpenFPGA and their report
+ *******************************************************************/
+#include <fstream>
+
+/* Headers from vtrutil library */
+#include "vtr_log.h"
+
+/* Headers from openfpgautil library */
+#include "openfpga_hot_path_counters.h"
+
+/* namespace openfpga begins */
+namespace openfpga {
+
+#ifdef OPENFPGA_HOT_PATH_COUNTERS
+std::array<t_hot_path_counter, NUM_HOT_PATH_COUNTERS> g_hot_path_counters;
+#endif
+
+int report_hot_path_counters(const std::string& fname) {
+#ifndef OPENFPGA_HOT_PATH_COUNTERS
+  (void)fname;
+  return 0;
+#else
+  VTR_LOG("\nCalls of the hot look-ups:\n");
+  VTR_LOG("%-40s %16s %16s %16s\n", "Look-up", "Calls", "Hits", "Bytes");
+  for (size_t icounter = 0; icounter < NUM_HOT_PATH_COUNTERS; ++icounter) {
+    const t_hot_path_counter& counter = g_hot_path_counters[icounter];
+    VTR_LOG("%-40s %16lu %16lu %16lu\n",
+            HOT_PATH_COUNTER_STRING[icounter],
+            counter.num_calls.load(), counter.num_hits.load(), counter.num_bytes.load());
+  }
+
+  if (true == fname.empty()) {
+    return 0;
+  }
+
+  std::ofstream fp(fname.c_str());
+  if (!fp.is_open()) {
+    VTR_LOG_ERROR("Fail to open the report file of hot look-ups '%s'!\n",
+                  fname.c_str());
+    return 1;
+  }
+  fp << "lookup,calls,hits,bytes\n";
+  for (size_t icounter = 0; icounter < NUM_HOT_PATH_COUNTERS; ++icounter) {
+    const t_hot_path_counter& counter = g_hot_path_counters[icounter];
+    fp << HOT_PATH_COUNTER_STRING[icounter] << ","
+       << counter.num_calls.load() << ","
+       << counter.num_hits.load() << ","
+       << counter.num_bytes.load() << "\n";
+  }
+  fp.close();
+
+  VTR_LOG("Wrote the calls of the hot look-ups to '%s'\n",
+          fname.c_str());
+
+  return 0;
+#endif
+}
+
+} /* namespace openfpga ends */
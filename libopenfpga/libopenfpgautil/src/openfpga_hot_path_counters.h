@@ -0,0 +1,83 @@
+#ifndef OPENFPGA_HOT_PATH_COUNTERS_H
+#define OPENFPGA_HOT_PATH_COUNTERS_H
+
+/********************************************************************
+ * Include header files that are required by data structure declaration
+ *******************************************************************/
+#include <array>
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <string>
+
+/* namespace openfpga begins */
+namespace openfpga {
+
+/********************************************************************
+ * Counters on the hot look-ups of the databases of OpenFPGA,
+ * which count the calls, the calls finding what they look for (hits)
+ * and the bytes allocated by the calls.
+ *
+ * The counters are compiled only when the CMake option
+ * OPENFPGA_ENABLE_HOT_PATH_COUNTERS is ON, which defines
+ * OPENFPGA_HOT_PATH_COUNTERS. Otherwise, the macros below expand to nothing,
+ * so that the look-ups have no extra cost.
+ *
+ * The counters can be updated by many threads at the same time.
+ *
+ * Example:
+ *   OPENFPGA_COUNT_HOT_PATH_CALL(HOT_PATH_FIND_MODULE_PORT);
+ *   if (found) {
+ *     OPENFPGA_COUNT_HOT_PATH_HIT(HOT_PATH_FIND_MODULE_PORT);
+ *   }
+ *******************************************************************/
+enum e_hot_path_counter {
+  HOT_PATH_FIND_MODULE_PORT,
+  HOT_PATH_MODULE_INSTANCE_PORT_NET,
+  HOT_PATH_CIRCUIT_MODEL,
+  HOT_PATH_FIND_CHILD_BLOCK,
+  HOT_PATH_LB_NODE_OUT_EDGES,
+  HOT_PATH_DECODE_MEMORY_BITS,
+  NUM_HOT_PATH_COUNTERS
+};
+constexpr std::array<const char*, NUM_HOT_PATH_COUNTERS> HOT_PATH_COUNTER_STRING = {{"ModuleManager::find_module_port",
+                                                                                     "ModuleManager::module_instance_port_net",
+                                                                                     "CircuitLibrary::model",
+                                                                                     "BitstreamManager::find_child_block",
+                                                                                     "LbRRGraph::node_out_edges",
+                                                                                     "MuxGraph::decode_memory_bits"}};
+
+#ifdef OPENFPGA_HOT_PATH_COUNTERS
+
+struct t_hot_path_counter {
+  std::atomic<uint64_t> num_calls{0};
+  std::atomic<uint64_t> num_hits{0};
+  std::atomic<uint64_t> num_bytes{0};
+};
+
+extern std::array<t_hot_path_counter, NUM_HOT_PATH_COUNTERS> g_hot_path_counters;
+
+#  define OPENFPGA_COUNT_HOT_PATH_CALL(counter) \
+    openfpga::g_hot_path_counters[openfpga::counter].num_calls.fetch_add(1, std::memory_order_relaxed)
+#  define OPENFPGA_COUNT_HOT_PATH_HIT(counter) \
+    openfpga::g_hot_path_counters[openfpga::counter].num_hits.fetch_add(1, std::memory_order_relaxed)
+#  define OPENFPGA_COUNT_HOT_PATH_BYTES(counter, bytes) \
+    openfpga::g_hot_path_counters[openfpga::counter].num_bytes.fetch_add((bytes), std::memory_order_relaxed)
+
+#else
+
+#  define OPENFPGA_COUNT_HOT_PATH_CALL(counter)
+#  define OPENFPGA_COUNT_HOT_PATH_HIT(counter)
+#  define OPENFPGA_COUNT_HOT_PATH_BYTES(counter, bytes)
+
+#endif
+
+/* Report the counters to the log, and to a CSV file when the file name is not empty
+ * Nothing is done when the counters are not compiled
+ * Return 0 on success, and 1 if the file cannot be written
+ */
+int report_hot_path_counters(const std::string& fname);
+
+} /* namespace openfpga ends */
+
+#endif
@@ -0,0 +1,199 @@
+#ifndef OPENFPGA_MEMORY_USAGE_H
+#define OPENFPGA_MEMORY_USAGE_H
+
+/********************************************************************
+ * This file includes templates to estimate the heap memory
+ * held by the containers of data structures, in bytes
+ *
+ * The estimation counts the capacity of containers rather than their size,
+ * as well as the nodes of associative containers,
+ * so that it reflects the actual memory footprint of a database.
+ * It is an approximation: the overhead of memory allocators is not counted
+ * and the node sizes of associative containers are based on common
+ * implementations of the standard library.
+ *
+ * The sizeof() of the object itself is not counted, as it is
+ * counted by its owner. Data structures can join the estimation
+ * by providing a method
+ *   size_t memory_usage() const;
+ * which returns the heap memory held by its internal data
+ *******************************************************************/
+#include <cstddef>
+#include <string>
+#include <vector>
+#include <map>
+#include <set>
+#include <unordered_map>
+#include <unordered_set>
+#include <utility>
+#include <type_traits>
+
+#include "vtr_vector.h"
+#include "vtr_small_vector.h"
+#include "vtr_arena.h"
+
+/* begin namespace openfpga */
+namespace openfpga {
+
+/********************************************************************
+ * Declare all the overloads before their definitions,
+ * so that nested containers can find each other
+ *******************************************************************/
+template<class T>
+size_t memory_usage(const T& data);
+
+size_t memory_usage(const std::string& str);
+
+template<class T1, class T2>
+size_t memory_usage(const std::pair<T1, T2>& data);
+
+template<class T, class Alloc>
+size_t memory_usage(const std::vector<T, Alloc>& vec);
+
+template<class Alloc>
+size_t memory_usage(const std::vector<bool, Alloc>& vec);
+
+template<class T, class S>
+size_t memory_usage(const vtr::small_vector<T, S>& vec);
+
+template<class K, class V>
+size_t memory_usage(const vtr::vector<K, V>& vec);
+
+template<class K>
+size_t memory_usage(const vtr::vector<K, bool>& vec);
+
+template<class K, class V>
+size_t memory_usage(const vtr::vector<K, V, vtr::arena_allocator<V>>& vec);
+
+template<class K, class V, class Compare, class Alloc>
+size_t memory_usage(const std::map<K, V, Compare, Alloc>& map);
+
+template<class K, class Compare, class Alloc>
+size_t memory_usage(const std::set<K, Compare, Alloc>& set);
+
+template<class K, class V, class Hash, class Pred, class Alloc>
+size_t memory_usage(const std::unordered_map<K, V, Hash, Pred, Alloc>& map);
+
+template<class K, class Hash, class Pred, class Alloc>
+size_t memory_usage(const std::unordered_set<K, Hash, Pred, Alloc>& set);
+
+/********************************************************************
+ * Dispatch between the data structures which provide memory_usage()
+ * and the plain data types which do not hold any heap memory
+ *******************************************************************/
+template<class T>
+auto memory_usage_of_object(const T& data, int) -> decltype(size_t(data.memory_usage())) {
+  return data.memory_usage();
+}
+
+template<class T>
+size_t memory_usage_of_object(const T& /*data*/, long) {
+  return 0;
+}
+
+/* Overhead of a node in tree-based containers: color and 3 pointers */
+constexpr size_t TREE_NODE_OVERHEAD = 4 * sizeof(void*);
+/* Overhead of a node in hash-based containers: the next pointer and the cached hash */
+constexpr size_t HASH_NODE_OVERHEAD = sizeof(void*) + sizeof(size_t);
+
+template<class Container>
+size_t memory_usage_of_elements(const Container& container) {
+  size_t num_bytes = 0;
+  for (const auto& elem : container) {
+    num_bytes += memory_usage(elem);
+  }
+  return num_bytes;
+}
+
+/********************************************************************
+ * Definitions
+ *******************************************************************/
+template<class T>
+size_t memory_usage(const T& data) {
+  return memory_usage_of_object(data, 0);
+}
+
+inline
+size_t memory_usage(const std::string& str) {
+  /* Short strings are stored inside the object (Short String Optimization) */
+  static const size_t sso_capacity = std::string().capacity();
+  if (str.capacity() <= sso_capacity) {
+    return 0;
+  }
+  return str.capacity() + 1;
+}
+
+template<class T1, class T2>
+size_t memory_usage(const std::pair<T1, T2>& data) {
+  return memory_usage(data.first) + memory_usage(data.second);
+}
+
+template<class T, class Alloc>
+size_t memory_usage(const std::vector<T, Alloc>& vec) {
+  return vec.capacity() * sizeof(T) + memory_usage_of_elements(vec);
+}
+
+template<class Alloc>
+size_t memory_usage(const std::vector<bool, Alloc>& vec) {
+  /* Bits are packed */
+  return (vec.capacity() + 7) / 8;
+}
+
+template<class T, class S>
+size_t memory_usage(const vtr::small_vector<T, S>& vec) {
+  /* Short vectors are stored inside the object */
+  if (vec.capacity() <= vtr::small_vector<T, S>::INPLACE_CAPACITY) {
+    return memory_usage_of_elements(vec);
+  }
+  return vec.capacity() * sizeof(T) + memory_usage_of_elements(vec);
+}
+
+template<class K, class V>
+size_t memory_usage(const vtr::vector<K, V>& vec) {
+  return vec.capacity() * sizeof(V) + memory_usage_of_elements(vec);
+}
+
+template<class K>
+size_t memory_usage(const vtr::vector<K, bool>& vec) {
+  /* Bits are packed */
+  return (vec.capacity() + 7) / 8;
+}
+
+template<class K, class V>
+size_t memory_usage(const vtr::vector<K, V, vtr::arena_allocator<V>>& vec) {
+  /* The memory drawn from an arena is counted by the arena itself */
+  if (nullptr != vec.get_allocator().arena()) {
+    return memory_usage_of_elements(vec);
+  }
+  return vec.capacity() * sizeof(V) + memory_usage_of_elements(vec);
+}
+
+template<class K, class V, class Compare, class Alloc>
+size_t memory_usage(const std::map<K, V, Compare, Alloc>& map) {
+  return map.size() * (sizeof(std::pair<const K, V>) + TREE_NODE_OVERHEAD)
+       + memory_usage_of_elements(map);
+}
+
+template<class K, class Compare, class Alloc>
+size_t memory_usage(const std::set<K, Compare, Alloc>& set) {
+  return set.size() * (sizeof(K) + TREE_NODE_OVERHEAD)
+       + memory_usage_of_elements(set);
+}
+
+template<class K, class V, class Hash, class Pred, class Alloc>
+size_t memory_usage(const std::unordered_map<K, V, Hash, Pred, Alloc>& map) {
+  return map.bucket_count() * sizeof(void*)
+       + map.size() * (sizeof(std::pair<const K, V>) + HASH_NODE_OVERHEAD)
+       + memory_usage_of_elements(map);
+}
+
+template<class K, class Hash, class Pred, class Alloc>
+size_t memory_usage(const std::unordered_set<K, Hash, Pred, Alloc>& set) {
+  return set.bucket_count() * sizeof(void*)
+       + set.size() * (sizeof(K) + HASH_NODE_OVERHEAD)
+       + memory_usage_of_elements(set);
+}
+
+} /* end namespace openfpga */
+
+#endif
@@ -0,0 +1,172 @@
+/********************************************************************
+ * This file includes functions that run independent tasks
+ * on multiple threads in OpenFPGA framework
+ *******************************************************************/
+#include <algorithm>
+#include <atomic>
+#include <exception>
+#include <map>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+/* Headers from liblog library */
+#include "log.h"
+
+/* Headers from openfpgautil library */
+#include "openfpga_parallel.h" 
+
+namespace openfpga {
+
+/* A single thread unless told otherwise */
+static std::atomic<size_t> default_num_threads_requested(1);
+
+void set_default_num_threads(const size_t& num_threads_requested) {
+  default_num_threads_requested = num_threads_requested;
+}
+
+size_t default_num_threads() {
+  return default_num_threads_requested.load();
+}
+
+/********************************************************************
+ * Find the number of threads to be used
+ * A zero request means using all the hardware threads
+ * Only one thread is used when OpenFPGA is built with a serial execution engine
+ *******************************************************************/
+size_t find_num_threads(const size_t& num_threads_requested) {
+#ifdef OPENFPGA_SERIAL_EXECUTION
+  (void)num_threads_requested;
+  return 1;
+#else
+  if (0 < num_threads_requested) {
+    return num_threads_requested;
+  }
+  size_t num_hw_threads = std::thread::hardware_concurrency();
+  /* The number of hardware threads may not be computable */
+  if (0 == num_hw_threads) {
+    return 1;
+  }
+  return num_hw_threads;
+#endif
+}
+
+/********************************************************************
+ * Run a task for each index in [0, num_tasks) on a number of threads
+ * - Each index is executed exactly once, while the order of
+ *   execution is not guaranteed. Tasks should write their results
+ *   to storage owned by their index, so that the results 
+ *   can be merged in a deterministic order afterwards
+ * - When only one thread is requested, tasks are executed
+ *   in increasing order in the calling thread
+ * - The first exception thrown by any task is rethrown to the caller
+ *   after all the threads are joined
+ * - The messages logged by each task are printed at once and in the
+ *   order of tasks, so that the log is the same as a single thread
+ *******************************************************************/
+void parallel_for(const size_t& num_tasks,
+                  const size_t& num_threads,
+                  const std::function<void(const size_t&)>& task) {
+  parallel_for_with_thread_id(num_tasks, num_threads,
+                              [&](const size_t& itask, const size_t& /*ithread*/) {
+                                task(itask);
+                              });
+}
+
+/********************************************************************
+ * Same as parallel_for() but the task also receives the index of 
+ * the thread executing it, which is in [0, num_threads)
+ * Tasks running on the same thread are never executed concurrently,
+ * so that they can share a scratch storage owned by the thread index
+ *******************************************************************/
+void parallel_for_with_thread_id(const size_t& num_tasks,
+                                 const size_t& num_threads,
+                                 const std::function<void(const size_t&, const size_t&)>& task) {
+#ifdef OPENFPGA_SERIAL_EXECUTION
+  const size_t num_threads_used = 1;
+  (void)num_threads;
+#else
+  const size_t& num_threads_used = num_threads;
+#endif
+  if ((1 >= num_threads_used) || (1 >= num_tasks)) {
+    for (size_t itask = 0; itask < num_tasks; ++itask) {
+      task(itask, 0);
+    }
+    return;
+  }
+
+  std::atomic<size_t> next_task(0);
+  std::exception_ptr first_exception = nullptr;
+  std::mutex exception_mutex;
+
+  /* The messages of each task are buffered, and flushed as soon as 
+   * all the tasks before are done. Only the buffers of tasks done
+   * out of order are kept, which are a few per thread.
+   * When the caller is itself buffering, e.g., in a task of another parallel_for(),
+   * the messages are flushed to the buffer of the caller
+   */
+  t_log_buffer* caller_log_buffer = log_set_thread_buffer(nullptr);
+  log_set_thread_buffer(caller_log_buffer);
+  std::map<size_t, t_log_buffer> done_log_buffers;
+  size_t next_task_to_flush = 0;
+  std::mutex log_order_mutex;
+
+  auto flush_done_logs = [&]() {
+    while ( (false == done_log_buffers.empty())
+         && (next_task_to_flush == done_log_buffers.begin()->first) ) {
+      log_flush_buffer(done_log_buffers.begin()->second, caller_log_buffer);
+      done_log_buffers.erase(done_log_buffers.begin());
+      ++next_task_to_flush;
+    }
+  };
+
+  auto worker = [&](const size_t& ithread) {
+    while (true) {
+      size_t itask = next_task.fetch_add(1);
+      if (itask >= num_tasks) {
+        return;
+      }
+      t_log_buffer task_log_buffer;
+      t_log_buffer* prev_log_buffer = log_set_thread_buffer(&task_log_buffer);
+      try {
+        task(itask, ithread);
+      } catch (...) {
+        std::lock_guard<std::mutex> lock(exception_mutex);
+        if (nullptr == first_exception) {
+          first_exception = std::current_exception();
+        }
+        /* Stop dispatching the remaining tasks */
+        next_task = num_tasks;
+      }
+      log_set_thread_buffer(prev_log_buffer);
+
+      std::lock_guard<std::mutex> lock(log_order_mutex);
+      done_log_buffers[itask] = std::move(task_log_buffer);
+      flush_done_logs();
+    }
+  };
+
+  std::vector<std::thread> threads;
+  size_t num_workers = std::min(num_threads_used, num_tasks);
+  threads.reserve(num_workers - 1);
+  for (size_t ithread = 1; ithread < num_workers; ++ithread) {
+    threads.emplace_back(worker, ithread);
+  }
+  /* The calling thread also takes tasks */
+  worker(0);
+
+  for (std::thread& thread : threads) {
+    thread.join();
+  }
+
+  /* Tasks may be left undone after an exception, the messages of the tasks done are still printed */
+  for (auto& done_log_buffer : done_log_buffers) {
+    log_flush_buffer(done_log_buffer.second, caller_log_buffer);
+  }
+
+  if (nullptr != first_exception) {
+    std::rethrow_exception(first_exception);
+  }
+}
+
+} /* namespace openfpga ends */
@@ -0,0 +1,88 @@
+#ifndef OPENFPGA_PARALLEL_H
+#define OPENFPGA_PARALLEL_H
+
+/********************************************************************
+ * Include header files that are required by function declaration
+ *******************************************************************/
+#include <cstddef>
+#include <functional>
+#include <type_traits>
+#include <vector>
+
+/********************************************************************
+ * Function declaration
+ *******************************************************************/
+/* namespace openfpga begins */
+namespace openfpga {
+
+/* The number of threads used by commands when they are not told,
+ * e.g., given by the '--threads' option when launching the shell.
+ * Zero means all the hardware threads, as the requests of find_num_threads()
+ */
+void set_default_num_threads(const size_t& num_threads_requested);
+size_t default_num_threads();
+
+size_t find_num_threads(const size_t& num_threads_requested);
+
+void parallel_for(const size_t& num_tasks,
+                  const size_t& num_threads,
+                  const std::function<void(const size_t&)>& task);
+
+void parallel_for_with_thread_id(const size_t& num_tasks,
+                                 const size_t& num_threads,
+                                 const std::function<void(const size_t&, const size_t&)>& task);
+
+/********************************************************************
+ * Run a task for each id of a range, e.g., netlist.blocks(), on a number of threads
+ * The ids are collected first, so that any range of ids can be used.
+ * The range is taken by value, as vtr::Range is cheap to copy
+ *******************************************************************/
+template <class IdRange, class Task>
+void parallel_for_each(IdRange ids,
+                       const size_t& num_threads,
+                       const Task& task) {
+  typedef typename std::decay<decltype(*ids.begin())>::type t_id;
+  std::vector<t_id> id_list(ids.begin(), ids.end());
+  parallel_for(id_list.size(), num_threads,
+               [&](const size_t& iid) {
+                 task(id_list[iid]);
+               });
+}
+
+/********************************************************************
+ * Compute a result of type T for each id of a range on a number of threads,
+ * with map_task(id, result), and then merge the results in the order of the range
+ * on the calling thread, with reduce_task(id, result).
+ * The outcome is the same as running both tasks on a single thread,
+ * whatever the number of threads is. The mapping should not modify any data
+ * shared by the tasks, while the reduction can.
+ *
+ * Example:
+ *   parallel_map_reduce<std::string>(netlist.nets(), num_threads,
+ *     [&](const AtomNetId& net, std::string& fixed_name) {
+ *       fixed_name = fix_name(netlist.net_name(net));
+ *     },
+ *     [&](const AtomNetId& net, std::string& fixed_name) {
+ *       annotation.rename_net(net, fixed_name);
+ *     });
+ *******************************************************************/
+template <class T, class IdRange, class MapTask, class ReduceTask>
+void parallel_map_reduce(IdRange ids,
+                         const size_t& num_threads,
+                         const MapTask& map_task,
+                         const ReduceTask& reduce_task) {
+  typedef typename std::decay<decltype(*ids.begin())>::type t_id;
+  std::vector<t_id> id_list(ids.begin(), ids.end());
+  std::vector<T> results(id_list.size());
+  parallel_for(id_list.size(), num_threads,
+               [&](const size_t& iid) {
+                 map_task(id_list[iid], results[iid]);
+               });
+  for (size_t iid = 0; iid < id_list.size(); ++iid) {
+    reduce_task(id_list[iid], results[iid]);
+  }
+}
+
+} /* namespace openfpga ends */
+
+#endif
@@ -135,6 +135,14 @@ bool BasicPort::operator== (const BasicPort& portA) const {
   return false;
 }
 
+/* Only the name, LSB and MSB are hashed as they are compared in operator== */
+size_t BasicPortHash::operator()(const BasicPort& port) const {
+  size_t hash = std::hash<std::string>()(port.get_name());
+  hash ^= std::hash<size_t>()(port.get_lsb()) + 0x9e3779b9 + (hash << 6) + (hash >> 2);
+  hash ^= std::hash<size_t>()(port.get_msb()) + 0x9e3779b9 + (hash << 6) + (hash >> 2);
+  return hash;
+}
+
 bool BasicPort::operator< (const BasicPort& portA) const {
   if  ( (0 == this->get_name().compare(portA.get_name())) 
      && (this->get_lsb() < portA.get_lsb())
@@ -56,6 +56,13 @@ class BasicPort {
     size_t origin_port_width_; /* Original port width of a port, used by traceback port conversion history  */
 };
 
+/* Hash function of ports, consistent with BasicPort::operator==,
+ * so that ports can be the keys of unordered containers
+ */
+struct BasicPortHash {
+  size_t operator()(const BasicPort& port) const;
+};
+
 /* Configuration ports:
  * 1. reserved configuration port, which is used by RRAM FPGA architecture
  * 2. regular configuration port, which is used by any FPGA architecture 
@@ -1,7 +1,9 @@
 /************************************************************************
  * Member functions for Port parsers
  ***********************************************************************/
+#include <cctype>
 #include <cstring>
+#include <stdexcept>
 
 #include "vtr_assert.h"
 #include "vtr_geometry.h"
@@ -13,6 +15,112 @@
 /* namespace openfpga begins */
 namespace openfpga {
 
+/************************************************************************
+ * Convert a token to an integer in the same way as std::stoi(),
+ * i.e., leading whitespaces are skipped and parsing stops at the first
+ * character which is not a digit, but without copying the token
+ ***********************************************************************/
+static 
+int token_to_int(const char* token, const size_t& length) {
+  size_t pos = 0;
+  while ( (pos < length) && (0 != std::isspace(static_cast<unsigned char>(token[pos]))) ) {
+    ++pos;
+  }
+  bool negative = false;
+  if ( (pos < length) && (('-' == token[pos]) || ('+' == token[pos])) ) {
+    negative = ('-' == token[pos]);
+    ++pos;
+  }
+  size_t digit_begin = pos;
+  int value = 0;
+  while ( (pos < length) && (0 != std::isdigit(static_cast<unsigned char>(token[pos]))) ) {
+    value = value * 10 + (token[pos] - '0');
+    ++pos;
+  }
+  if (digit_begin == pos) {
+    throw std::invalid_argument("Invalid pin index in port definition");
+  }
+  return (true == negative) ? -value : value;
+}
+
+/************************************************************************
+ * Parse a port from a range of characters 
+ ***********************************************************************/
+void parse_port(const char* data, const size_t& length, BasicPort& port) {
+  /* Split the data into <port_name> and <pin_string> */
+  const char* name = data;
+  size_t name_length = 0;
+  const char* pins = nullptr;
+  size_t pins_length = 0;
+  size_t num_port_tokens = 0;
+  for_each_string_token(data, length, "[",
+                        [&](const char* token, const size_t& token_length) {
+                          if (0 == num_port_tokens) {
+                            name = token;
+                            name_length = token_length;
+                          } else {
+                            pins = token;
+                            pins_length = token_length;
+                          }
+                          ++num_port_tokens;
+                          return 2 > num_port_tokens;
+                        });
+  /* Make sure we have a port name! */
+  VTR_ASSERT_SAFE ((1 == num_port_tokens) || (2 == num_port_tokens));
+  /* Store the port name! */
+  port.set_name(std::string(name, name_length));
+
+  /* If we only have one token */
+  if (1 == num_port_tokens) {
+    port.set_width(1); 
+    return; /* We can finish here */
+  }
+
+  /* Chomp the ']' */
+  size_t num_pin_strings = 0;
+  for_each_string_token(pins, pins_length, "]",
+                        [&](const char* token, const size_t& token_length) {
+                          pins = token;
+                          pins_length = token_length;
+                          ++num_pin_strings;
+                          return false;
+                        });
+  /* Nothing inside the brackets, treated the same as no brackets */
+  if (0 == num_pin_strings) {
+    port.set_width(1); 
+    return;
+  }
+
+  /* Split the pin string now */
+  int pin_indices[2] = {0, 0};
+  size_t num_pin_tokens = 0;
+  for_each_string_token(pins, pins_length, ":",
+                        [&](const char* token, const size_t& token_length) {
+                          if (2 > num_pin_tokens) {
+                            pin_indices[num_pin_tokens] = token_to_int(token, token_length);
+                          }
+                          ++num_pin_tokens;
+                          return true;
+                        });
+
+  /* Check if we have LSB and MSB or just one */
+  if ( 1 == num_pin_tokens ) {
+    /* Single pin */
+    port.set_width(pin_indices[0], pin_indices[0]); 
+  } else if ( 2 == num_pin_tokens ) {
+    /* A number of pins. 
+     * Note that we always use the LSB for token[0] and MSB for token[1] 
+     */
+    if (pin_indices[1] < pin_indices[0]) {
+      port.set_width(pin_indices[1], pin_indices[0]); 
+    } else {
+      port.set_width(pin_indices[0], pin_indices[1]); 
+    }
+  }
+
+  return;  
+}
+
 /************************************************************************
  * Member functions for PortParser class 
  ***********************************************************************/
@@ -50,49 +158,13 @@ void PortParser::set_data(const std::string& data) {
 /************************************************************************
  * Internal Mutators
  ***********************************************************************/
-/* Parse the data */
+/* Parse the data 
+ * The brackets and the delim are always the default ones,
+ * which are the syntax parsed by parse_port()
+ */
 void PortParser::parse() {
-  /* Create a tokenizer */
-  StringToken tokenizer(data_);
-
-  /* Split the data into <port_name> and <pin_string> */
-  std::vector<std::string> port_tokens = tokenizer.split(bracket_.x());
-  /* Make sure we have a port name! */
-  VTR_ASSERT_SAFE ((1 == port_tokens.size()) || (2 == port_tokens.size()));
-  /* Store the port name! */
-  port_.set_name(port_tokens[0]);
-
-  /* If we only have one token */
-  if (1 == port_tokens.size()) {
-    port_.set_width(1); 
-    return; /* We can finish here */
-  }
-
-  /* Chomp the ']' */
-  tokenizer.set_data(port_tokens[1]);
-  std::vector<std::string> pin_tokens = tokenizer.split(bracket_.y());
-  /* Make sure we have a valid string! */
-  VTR_ASSERT_SAFE (1 == port_tokens.size());
-
-  /* Split the pin string now */
-  tokenizer.set_data(pin_tokens[0]);
-  pin_tokens = tokenizer.split(delim_);
-
-  /* Check if we have LSB and MSB or just one */
-  if ( 1 == pin_tokens.size() ) {
-    /* Single pin */
-    port_.set_width(std::stoi(pin_tokens[0]), std::stoi(pin_tokens[0])); 
-  } else if ( 2 == pin_tokens.size() ) {
-    /* A number of pins. 
-     * Note that we always use the LSB for token[0] and MSB for token[1] 
-     */
-    if (std::stoi(pin_tokens[1]) < std::stoi(pin_tokens[0])) {
-      port_.set_width(std::stoi(pin_tokens[1]), std::stoi(pin_tokens[0])); 
-    } else {
-      port_.set_width(std::stoi(pin_tokens[0]), std::stoi(pin_tokens[1])); 
-    }
-  }
-
+  VTR_ASSERT_SAFE(('[' == bracket_.x()) && (']' == bracket_.y()) && (':' == delim_));
+  parse_port(data_.c_str(), data_.size(), port_);
   return;  
 }
 
@@ -148,18 +220,16 @@ void MultiPortParser::parse() {
   /* Clear content */
   clear();
 
-  /* Create a tokenizer */
-  StringToken tokenizer(data_);
-
-  /* Split the data into <port_name> and <pin_string> */
-  std::vector<std::string> port_tokens = tokenizer.split(delim_);
-  
-  /* Use PortParser for each token */
-  for (const auto& port : port_tokens) {
-    PortParser port_parser(port);
-    /* Get the port name, LSB and MSB */
-    ports_.push_back(port_parser.port());
-  }
+  /* Parse each port in place, without splitting the data into new strings */
+  const char delims[2] = {delim_, '\0'};
+  for_each_string_token(data_.c_str(), data_.size(), delims,
+                        [&](const char* token, const size_t& length) {
+                          BasicPort port;
+                          /* Get the port name, LSB and MSB */
+                          parse_port(token, length, port);
+                          ports_.push_back(port);
+                          return true;
+                        });
 
   return;
 }
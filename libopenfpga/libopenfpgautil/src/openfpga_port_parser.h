@@ -51,6 +51,15 @@ class PortParser{
     BasicPort port_;
 };
 
+/************************************************************************
+ * Parse a port definition in the syntax supported by PortParser
+ * from a range of characters, which is not required to be null-terminated.
+ * Unlike PortParser, no string is created except the name of the port,
+ * so that it is cheap to parse ports from a long line, 
+ * e.g., a fragment of a line visited by for_each_string_token()
+ ***********************************************************************/
+void parse_port(const char* data, const size_t& length, BasicPort& port);
+
 /************************************************************************
  * MultiPortParser: a parser for multiple ports in one line 
  ***********************************************************************/
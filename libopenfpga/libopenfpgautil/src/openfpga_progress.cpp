@@ -0,0 +1,94 @@
+/********************************************************************
+ * This file includes member functions of the progress reporter
+ *******************************************************************/
+/* Headers from liblog library */
+#include "log.h"
+
+/* Headers from vtrutil library */
+#include "vtr_log.h"
+
+/* Headers from openfpgautil library */
+#include "openfpga_progress.h"
+
+/* namespace openfpga begins */
+namespace openfpga {
+
+/************************************************************************
+ * Constructors
+ ***********************************************************************/
+ProgressReporter::ProgressReporter(const std::string& phase_name,
+                                   const size_t& num_tasks,
+                                   const float& interval_sec)
+  : phase_name_(phase_name),
+    num_tasks_(num_tasks),
+    interval_(std::chrono::duration_cast<std::chrono::steady_clock::duration>(std::chrono::duration<float>(interval_sec))),
+    start_time_(std::chrono::steady_clock::now()),
+    num_tasks_done_(0),
+    next_report_ticks_(interval_.count()) {
+}
+
+/************************************************************************
+ * Public accessors
+ ***********************************************************************/
+size_t ProgressReporter::num_tasks() const {
+  return num_tasks_;
+}
+
+size_t ProgressReporter::num_tasks_done() const {
+  return num_tasks_done_.load();
+}
+
+float ProgressReporter::elapsed_sec() const {
+  return std::chrono::duration<float>(std::chrono::steady_clock::now() - start_time_).count();
+}
+
+/************************************************************************
+ * Public mutators
+ ***********************************************************************/
+void ProgressReporter::advance(const size_t& num_tasks_done) {
+  size_t curr_num_tasks_done = num_tasks_done_.fetch_add(num_tasks_done) + num_tasks_done;
+
+  int64_t curr_ticks = (std::chrono::steady_clock::now() - start_time_).count();
+  int64_t next_report_ticks = next_report_ticks_.load();
+  if (curr_ticks < next_report_ticks) {
+    return;
+  }
+
+  /* Only the thread which moves the next report time forward writes the report */
+  if (true == next_report_ticks_.compare_exchange_strong(next_report_ticks, curr_ticks + interval_.count())) {
+    /* Reports are printed right away, even if the messages of the task are buffered by parallel_for() */
+    t_log_buffer* task_log_buffer = log_set_thread_buffer(nullptr);
+    report(curr_num_tasks_done);
+    log_set_thread_buffer(task_log_buffer);
+  }
+}
+
+/************************************************************************
+ * Internal functions
+ ***********************************************************************/
+void ProgressReporter::report(const size_t& num_tasks_done) const {
+  float curr_elapsed_sec = elapsed_sec();
+  float rate = 0.;
+  if (0. < curr_elapsed_sec) {
+    rate = num_tasks_done / curr_elapsed_sec;
+  }
+
+  if (0 == num_tasks_) {
+    VTR_LOG("%s: %lu done, %.1f per second\n",
+            phase_name_.c_str(), num_tasks_done, rate);
+    return;
+  }
+
+  float percentage = 100. * num_tasks_done / num_tasks_;
+  if ( (0. == rate) || (num_tasks_done >= num_tasks_) ) {
+    VTR_LOG("%s: %lu/%lu (%.1f%%) done, %.1f per second\n",
+            phase_name_.c_str(), num_tasks_done, num_tasks_, percentage, rate);
+    return;
+  }
+
+  float eta_sec = (num_tasks_ - num_tasks_done) / rate;
+  VTR_LOG("%s: %lu/%lu (%.1f%%) done, %.1f per second, ETA %.1f seconds\n",
+          phase_name_.c_str(), num_tasks_done, num_tasks_, percentage, rate, eta_sec);
+}
+
+} /* namespace openfpga ends */
@@ -0,0 +1,69 @@
+#ifndef OPENFPGA_PROGRESS_H
+#define OPENFPGA_PROGRESS_H
+
+/********************************************************************
+ * Include header files that are required by data structure declaration
+ *******************************************************************/
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <string>
+
+/* namespace openfpga begins */
+namespace openfpga {
+
+/* Default interval between two progress reports: 10 seconds */
+constexpr float DEFAULT_PROGRESS_REPORT_INTERVAL_SEC = 10.;
+
+/********************************************************************
+ * A lightweight reporter on the progress of a long-running phase,
+ * which counts the tasks done and reports to the log,
+ * at most once per interval, how many have been done,
+ * the rate and an estimated time to finish, e.g.,
+ *   Building routing modules: 1200/4800 (25.0%) done, 98.5 per second, ETA 36.5 seconds
+ * Nothing is reported for phases which finish within the first interval,
+ * so that the log of small fabrics is unchanged.
+ *
+ * The reporter can be advanced by many threads at the same time,
+ * e.g., inside a parallel_for(), while only one of them writes the report.
+ *
+ * Example:
+ *   ProgressReporter progress("Building routing modules", rr_gsbs.size());
+ *   parallel_for(rr_gsbs.size(), num_threads, [&](const size_t& igsb) {
+ *     ...
+ *     progress.advance();
+ *   });
+ *******************************************************************/
+class ProgressReporter {
+  public: /* Constructors */
+    ProgressReporter(const std::string& phase_name,
+                     const size_t& num_tasks,
+                     const float& interval_sec = DEFAULT_PROGRESS_REPORT_INTERVAL_SEC);
+    /* No copy, as the counters are shared by the threads */
+    ProgressReporter(const ProgressReporter&) = delete;
+    ProgressReporter& operator=(const ProgressReporter&) = delete;
+  public: /* Public accessors */
+    size_t num_tasks() const;
+    size_t num_tasks_done() const;
+    /* Time in seconds since the reporter is created */
+    float elapsed_sec() const;
+  public: /* Public mutators */
+    /* Count a number of tasks as done, and report if the interval is passed.
+     * This is thread-safe
+     */
+    void advance(const size_t& num_tasks_done = 1);
+  private: /* Internal functions */
+    void report(const size_t& num_tasks_done) const;
+  private: /* Internal data */
+    std::string phase_name_;
+    size_t num_tasks_;
+    std::chrono::steady_clock::duration interval_;
+    std::chrono::steady_clock::time_point start_time_;
+    std::atomic<size_t> num_tasks_done_;
+    /* Time of the next report, counted in ticks since the start time */
+    std::atomic<int64_t> next_report_ticks_;
+};
+
+} /* namespace openfpga ends */
+
+#endif
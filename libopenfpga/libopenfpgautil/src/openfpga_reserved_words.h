@@ -26,6 +26,12 @@ constexpr char* GIO_INOUT_PREFIX = "gfpga_pad_";
 constexpr char* GRID_MODULE_NAME_PREFIX = "grid_"; 
 constexpr char* LOGICAL_MODULE_NAME_PREFIX = "logical_tile_"; 
 
+/* Tile naming constant strings: instance names of the blocks grouped in a tile */
+constexpr char* TILE_GRID_INSTANCE_NAME = "grid"; 
+constexpr char* TILE_SB_INSTANCE_NAME = "sb"; 
+constexpr char* TILE_CBX_INSTANCE_NAME = "cbx"; 
+constexpr char* TILE_CBY_INSTANCE_NAME = "cby"; 
+
 /* Memory naming constant strings */
 constexpr char* GRID_MEM_INSTANCE_PREFIX = "mem_"; 
 constexpr char* SWITCH_BLOCK_MEM_INSTANCE_PREFIX = "mem_"; 
@@ -49,6 +55,14 @@ constexpr char* DECODER_DATA_OUT_INV_PORT_NAME = "data_out_inv";
 constexpr char* DECODER_BL_ADDRESS_PORT_NAME = "bl_address";
 constexpr char* DECODER_WL_ADDRESS_PORT_NAME = "wl_address";
 
+/* Shift register naming constant strings */
+constexpr char* BL_SHIFT_REGISTER_CLOCK_PORT_NAME = "bl_sr_clk";
+
+/* Run-length decompressor naming constant strings */
+constexpr char* CONFIG_CHAIN_RUN_LENGTH_PORT_NAME = "ccff_run_length";
+constexpr char* CONFIG_CHAIN_DECOMPRESSOR_RESET_PORT_NAME = "ccff_rle_reset";
+constexpr char* CONFIG_CHAIN_DECOMPRESSOR_CLOCK_PORT_NAME = "ccff_rle_clk";
+
 /* Inverted port naming */
 constexpr char* INV_PORT_POSTFIX = "_inv";
 
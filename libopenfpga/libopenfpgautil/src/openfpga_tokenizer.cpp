@@ -26,27 +26,19 @@ std::string StringToken::data() const {
   return data_;
 }
 
-/* Split the string using a given delim */
+/* Split the string using a given delim
+ * Tokens are copied from the string directly, 
+ * which, unlike strtok(), is safe when strings are split on multiple threads
+ */
 std::vector<std::string> StringToken::split(const std::string& delims) const {
   /* Return vector */
   std::vector<std::string> ret;
 
-  /* Get a writable char array */
-  char* tmp = new char[data_.size() + 1];
-  std::copy(data_.begin(), data_.end(), tmp);
-  tmp[data_.size()] = '\0';
-  /* Split using strtok */
-  char* result = std::strtok(tmp, delims.c_str());
-  while (NULL != result) {
-    std::string result_str(result);
-    /* Store the token */
-    ret.push_back(result_str);
-    /* Got to next */
-    result = std::strtok(NULL, delims.c_str());
-  }
-
-  /* Free the tmp */
-  delete[] tmp;
+  for_each_string_token(data_.c_str(), data_.size(), delims.c_str(),
+                        [&](const char* token, const size_t& length) {
+                          ret.emplace_back(token, length);
+                          return true;
+                        });
 
   return ret;
 }
@@ -4,6 +4,7 @@
 /********************************************************************
  * Include header files that are required by data structure declaration
  *******************************************************************/
+#include <cstring>
 #include <string>
 #include <vector>
 
@@ -39,6 +40,45 @@ class StringToken {
     std::vector<char> delims_;
 };
 
+/************************************************************************
+ * Visit the tokens of a string which are split by any of the given delims,
+ * without copying the string or any token into new strings.
+ * The tokens are the same as those given by StringToken::split(),
+ * i.e., empty tokens between successive delims are skipped.
+ * The visitor is called with the first character and the length of each token
+ * and it stops the visit by returning false.
+ * This is a light-weight replacement of std::string_view, which requires C++17
+ *
+ * Example:
+ *   for_each_string_token(data.c_str(), data.size(), " ",
+ *                         [&](const char* token, const size_t& length) {
+ *                           ...
+ *                           return true;
+ *                         });
+ ***********************************************************************/
+template <typename Visitor>
+void for_each_string_token(const char* data, const size_t& length,
+                           const char* delims,
+                           Visitor visitor) {
+  size_t pos = 0;
+  while (pos < length) {
+    /* Skip the delims before a token */
+    while ( (pos < length) && (nullptr != std::strchr(delims, data[pos])) ) {
+      ++pos;
+    }
+    if (pos == length) {
+      return;
+    }
+    size_t token_begin = pos;
+    while ( (pos < length) && (nullptr == std::strchr(delims, data[pos])) ) {
+      ++pos;
+    }
+    if (false == visitor(data + token_begin, pos - token_begin)) {
+      return;
+    }
+  }
+}
+
 } /* namespace openfpga ends */
 
 #endif
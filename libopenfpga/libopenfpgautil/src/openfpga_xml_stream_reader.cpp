@@ -0,0 +1,356 @@
+/********************************************************************
+ * Member functions for class XmlStreamReader
+ *******************************************************************/
+#include <cstdlib>
+#include <cstring>
+
+/* Headers from vtrutil library */
+#include "vtr_assert.h"
+
+/* Headers from openfpgautil library */
+#include "openfpga_xml_stream_reader.h"
+
+/* namespace openfpga begins */
+namespace openfpga {
+
+/* Characters which end the name of an element or an attribute */
+static 
+bool is_xml_name_end(const int& c) {
+  return (-1 == c) || (' ' == c) || ('\t' == c) || ('\n' == c) || ('\r' == c)
+      || ('/' == c) || ('>' == c) || ('=' == c);
+}
+
+/********************************************************************
+ * Constructors
+ *******************************************************************/
+XmlStreamReader::XmlStreamReader(const std::string& fname,
+                                 const size_t& buffer_size)
+  : fp_(fname),
+    buffer_(buffer_size),
+    buffer_pos_(0),
+    buffer_end_(0),
+    eof_(false),
+    line_(1),
+    event_(XML_END_ELEMENT),
+    element_line_(0),
+    pending_end_(false) {
+  VTR_ASSERT(0 < buffer_size);
+  if (false == fp_.is_open()) {
+    error_ = "Unable to open file '" + fname + "'";
+  }
+}
+
+/********************************************************************
+ * Public accessors
+ *******************************************************************/
+bool XmlStreamReader::is_open() const {
+  return fp_.is_open();
+}
+
+XmlStreamReader::e_event XmlStreamReader::event() const {
+  return event_;
+}
+
+const std::string& XmlStreamReader::name() const {
+  return name_;
+}
+
+size_t XmlStreamReader::line() const {
+  return element_line_;
+}
+
+size_t XmlStreamReader::depth() const {
+  /* The current element is still open at its start */
+  if (XML_START_ELEMENT == event_) {
+    VTR_ASSERT(0 < open_elements_.size());
+    return open_elements_.size() - 1;
+  }
+  return open_elements_.size();
+}
+
+bool XmlStreamReader::has_attribute(const std::string& attribute_name) const {
+  for (const std::pair<std::string, std::string>& attr : attributes_) {
+    if (attribute_name == attr.first) {
+      return true;
+    }
+  }
+  return false;
+}
+
+const std::string& XmlStreamReader::attribute(const std::string& attribute_name) const {
+  static const std::string empty_value;
+  for (const std::pair<std::string, std::string>& attr : attributes_) {
+    if (attribute_name == attr.first) {
+      return attr.second;
+    }
+  }
+  return empty_value;
+}
+
+const std::string& XmlStreamReader::error() const {
+  return error_;
+}
+
+/********************************************************************
+ * Public mutators
+ *******************************************************************/
+bool XmlStreamReader::next() {
+  if (false == error_.empty()) {
+    return false;
+  }
+
+  /* Close the empty element reported by the last move */
+  if (true == pending_end_) {
+    pending_end_ = false;
+    event_ = XML_END_ELEMENT;
+    attributes_.clear();
+    open_elements_.pop_back();
+    return true;
+  }
+
+  while (true) {
+    /* Skip texts until the next tag */
+    int c = get();
+    while ((-1 != c) && ('<' != c)) {
+      c = get();
+    }
+    if (-1 == c) {
+      if (false == open_elements_.empty()) {
+        return set_error("Unexpected end of file, element <" + open_elements_.back() + "> is not closed");
+      }
+      return false;
+    }
+
+    element_line_ = line_;
+    c = get();
+    if ('?' == c) {
+      /* Declarations, e.g., <?xml version="1.0"?> */
+      if (false == skip_until("?>")) {
+        return false;
+      }
+      continue;
+    }
+    if ('!' == c) {
+      /* Comments, or document types which are skipped as a whole */
+      if (('-' == peek()) && ('-' == get()) && ('-' == peek())) {
+        get();
+        if (false == skip_until("-->")) {
+          return false;
+        }
+      } else if (false == skip_until(">")) {
+        return false;
+      }
+      continue;
+    }
+    if ('/' == c) {
+      return parse_end_element();
+    }
+    return parse_start_element(c);
+  }
+}
+
+/********************************************************************
+ * Internal functions
+ *******************************************************************/
+bool XmlStreamReader::fill() {
+  if (true == eof_) {
+    return false;
+  }
+  long num_bytes = fp_.read(buffer_.data(), buffer_.size());
+  if (0 >= num_bytes) {
+    if (0 > num_bytes) {
+      set_error("Unable to read the file");
+    }
+    eof_ = true;
+    return false;
+  }
+  buffer_pos_ = 0;
+  buffer_end_ = size_t(num_bytes);
+  return true;
+}
+
+int XmlStreamReader::peek() {
+  if ((buffer_pos_ == buffer_end_) && (false == fill())) {
+    return -1;
+  }
+  return (unsigned char)buffer_[buffer_pos_];
+}
+
+int XmlStreamReader::get() {
+  int c = peek();
+  if (-1 != c) {
+    ++buffer_pos_;
+    if ('\n' == c) {
+      ++line_;
+    }
+  }
+  return c;
+}
+
+void XmlStreamReader::skip_spaces() {
+  int c = peek();
+  while ((' ' == c) || ('\t' == c) || ('\n' == c) || ('\r' == c)) {
+    get();
+    c = peek();
+  }
+}
+
+bool XmlStreamReader::skip_until(const char* terminator) {
+  /* Compare the last characters read with the terminator */
+  size_t length = std::strlen(terminator);
+  std::string last_chars;
+  while ((last_chars.size() < length) || (0 != last_chars.compare(last_chars.size() - length, length, terminator))) {
+    int c = get();
+    if (-1 == c) {
+      return set_error("Unexpected end of file, expect '" + std::string(terminator) + "'");
+    }
+    if (last_chars.size() == length) {
+      last_chars.erase(0, 1);
+    }
+    last_chars.push_back(char(c));
+  }
+  return true;
+}
+
+bool XmlStreamReader::read_name(std::string& name) {
+  name.clear();
+  while (false == is_xml_name_end(peek())) {
+    name.push_back(char(get()));
+  }
+  if (true == name.empty()) {
+    return set_error("Expect a name");
+  }
+  return true;
+}
+
+bool XmlStreamReader::read_attribute_value(std::string& value) {
+  value.clear();
+  int quote = get();
+  if (('"' != quote) && ('\'' != quote)) {
+    return set_error("Expect a quoted attribute value");
+  }
+  while (true) {
+    int c = get();
+    if (-1 == c) {
+      return set_error("Unexpected end of file in an attribute value");
+    }
+    if (quote == c) {
+      return true;
+    }
+    if ('&' != c) {
+      value.push_back(char(c));
+      continue;
+    }
+    /* Decode an entity */
+    std::string entity;
+    c = get();
+    while ((-1 != c) && (';' != c) && (entity.size() < 16)) {
+      entity.push_back(char(c));
+      c = get();
+    }
+    if (';' != c) {
+      return set_error("Invalid entity '&" + entity + "' in an attribute value");
+    }
+    if ("lt" == entity) {
+      value.push_back('<');
+    } else if ("gt" == entity) {
+      value.push_back('>');
+    } else if ("amp" == entity) {
+      value.push_back('&');
+    } else if ("quot" == entity) {
+      value.push_back('"');
+    } else if ("apos" == entity) {
+      value.push_back('\'');
+    } else if ((1 < entity.size()) && ('#' == entity[0])) {
+      /* Only the character references of ASCII characters are supported */
+      bool hex = ('x' == entity[1]);
+      char* end = nullptr;
+      long code = std::strtol(entity.c_str() + (hex ? 2 : 1), &end, hex ? 16 : 10);
+      if ((nullptr == end) || ('\0' != *end) || (0 >= code) || (127 < code)) {
+        return set_error("Unsupported character reference '&" + entity + ";'");
+      }
+      value.push_back(char(code));
+    } else {
+      return set_error("Unknown entity '&" + entity + ";'");
+    }
+  }
+}
+
+bool XmlStreamReader::parse_start_element(const int& first_char) {
+  if (true == is_xml_name_end(first_char)) {
+    return set_error("Expect the name of an element");
+  }
+  name_.clear();
+  name_.push_back(char(first_char));
+  std::string rest_of_name;
+  if (false == is_xml_name_end(peek())) {
+    if (false == read_name(rest_of_name)) {
+      return false;
+    }
+    name_ += rest_of_name;
+  }
+
+  attributes_.clear();
+  while (true) {
+    skip_spaces();
+    int c = peek();
+    if ('>' == c) {
+      get();
+      break;
+    }
+    if ('/' == c) {
+      get();
+      if ('>' != get()) {
+        return set_error("Expect '>' after '/' in element <" + name_ + ">");
+      }
+      pending_end_ = true;
+      break;
+    }
+    if (-1 == c) {
+      return set_error("Unexpected end of file in element <" + name_ + ">");
+    }
+    std::pair<std::string, std::string> attr;
+    if (false == read_name(attr.first)) {
+      return false;
+    }
+    skip_spaces();
+    if ('=' != get()) {
+      return set_error("Expect '=' after attribute '" + attr.first + "' in element <" + name_ + ">");
+    }
+    skip_spaces();
+    if (false == read_attribute_value(attr.second)) {
+      return false;
+    }
+    attributes_.push_back(std::move(attr));
+  }
+
+  open_elements_.push_back(name_);
+  event_ = XML_START_ELEMENT;
+  return true;
+}
+
+bool XmlStreamReader::parse_end_element() {
+  if (false == read_name(name_)) {
+    return false;
+  }
+  skip_spaces();
+  if ('>' != get()) {
+    return set_error("Expect '>' to close element <" + name_ + ">");
+  }
+  if ((true == open_elements_.empty()) || (name_ != open_elements_.back())) {
+    return set_error("Unexpected end of element <" + name_ + ">");
+  }
+  open_elements_.pop_back();
+  attributes_.clear();
+  event_ = XML_END_ELEMENT;
+  return true;
+}
+
+bool XmlStreamReader::set_error(const std::string& message) {
+  if (true == error_.empty()) {
+    error_ = message + " (line: " + std::to_string(line_) + ")";
+  }
+  return false;
+}
+
+} /* namespace openfpga ends */
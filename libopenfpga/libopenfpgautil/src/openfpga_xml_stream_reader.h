@@ -0,0 +1,110 @@
+#ifndef OPENFPGA_XML_STREAM_READER_H
+#define OPENFPGA_XML_STREAM_READER_H
+
+/********************************************************************
+ * Include header files that are required by data structure declaration
+ *******************************************************************/
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "openfpga_compressed_stream.h"
+
+/* namespace openfpga begins */
+namespace openfpga {
+
+/********************************************************************
+ * A reader which streams through the elements of an XML file,
+ * without building a document in memory as pugixml does.
+ * This is meant for large databases written by OpenFPGA, e.g., bitstreams,
+ * whose documents would take several times the size of the files.
+ *
+ * The reader supports the subset of XML used by such databases: 
+ * elements, attributes and the predefined entities in attribute values.
+ * Declarations, comments and texts are skipped.
+ * Files compressed by gzip are decompressed on the fly (requires zlib)
+ *
+ * An empty element, e.g., <bit value="1"/>, is reported as 
+ * a start and an end of element.
+ *
+ * Example:
+ *   XmlStreamReader reader(fname);
+ *   while (true == reader.next()) {
+ *     if (XmlStreamReader::XML_START_ELEMENT == reader.event()) {
+ *       VTR_LOG("<%s name=\"%s\">\n", reader.name().c_str(), reader.attribute("name").c_str());
+ *     }
+ *   }
+ *   if (false == reader.error().empty()) {
+ *     VTR_LOG_ERROR("%s\n", reader.error().c_str());
+ *   }
+ *******************************************************************/
+class XmlStreamReader {
+  public: /* Types */
+    enum e_event {
+      XML_START_ELEMENT,
+      XML_END_ELEMENT
+    };
+  public: /* Constructors */
+    explicit XmlStreamReader(const std::string& fname,
+                             const size_t& buffer_size = 256 * 1024);
+    XmlStreamReader(const XmlStreamReader&) = delete;
+    XmlStreamReader& operator=(const XmlStreamReader&) = delete;
+  public: /* Public accessors */
+    /* Whether the file is opened */
+    bool is_open() const;
+    /* The current event and the name of its element */
+    e_event event() const;
+    const std::string& name() const;
+    /* Line of the current element in the file, starting from 1 */
+    size_t line() const;
+    /* Number of the elements which contain the current one */
+    size_t depth() const;
+    /* Attributes of the current start of element. 
+     * The value is empty when the attribute is not found
+     */
+    bool has_attribute(const std::string& attribute_name) const;
+    const std::string& attribute(const std::string& attribute_name) const;
+    /* Description of the syntax error found, which is empty if none */
+    const std::string& error() const;
+  public: /* Public mutators */
+    /* Move to the next start or end of element.
+     * Return false at the end of the file or on errors, see error()
+     */
+    bool next();
+  private: /* Internal functions */
+    /* Read the next character, or -1 at the end of file */
+    int get();
+    /* Read the next character without consuming it, or -1 at the end of file */
+    int peek();
+    /* Load the next chunk of the file into the buffer, return false at the end of file */
+    bool fill();
+    void skip_spaces();
+    /* Skip the contents until the given terminator, which is consumed */
+    bool skip_until(const char* terminator);
+    bool read_name(std::string& name);
+    bool read_attribute_value(std::string& value);
+    bool parse_start_element(const int& first_char);
+    bool parse_end_element();
+    bool set_error(const std::string& message);
+  private: /* Internal data */
+    CompressedInputFile fp_;
+    std::vector<char> buffer_;
+    size_t buffer_pos_;
+    size_t buffer_end_;
+    bool eof_;
+    size_t line_;
+
+    e_event event_;
+    std::string name_;
+    size_t element_line_;
+    std::vector<std::pair<std::string, std::string>> attributes_;
+    /* Names of the elements which are not closed yet */
+    std::vector<std::string> open_elements_;
+    /* An empty element is to be closed at the next move */
+    bool pending_end_;
+    std::string error_;
+};
+
+} /* namespace openfpga ends */
+
+#endif
@@ -40,22 +40,18 @@ std::string PinConstraints::net(const PinConstraintId& pin_constraint_id) const
 
 std::string PinConstraints::pin_net(const openfpga::BasicPort& pin) const {
   std::string constrained_net_name;
-  for (const PinConstraintId& pin_constraint : pin_constraints()) {
-    if (pin == pin_constraint_pins_[pin_constraint]) {
-      constrained_net_name = net(pin_constraint); 
-      break;
-    }
+  auto result = pin_constraint_pin_lookup_.find(pin);
+  if (result != pin_constraint_pin_lookup_.end()) {
+    constrained_net_name = net(result->second); 
   }
   return constrained_net_name;
 }
 
 openfpga::BasicPort PinConstraints::net_pin(const std::string& net) const {
   openfpga::BasicPort constrained_pin;
-  for (const PinConstraintId& pin_constraint : pin_constraints()) {
-    if (net == pin_constraint_nets_[pin_constraint]) {
-      constrained_pin = pin(pin_constraint); 
-      break;
-    }
+  auto result = pin_constraint_net_lookup_.find(net);
+  if (result != pin_constraint_net_lookup_.end()) {
+    constrained_pin = pin(result->second); 
   }
   return constrained_pin;
 } 
@@ -71,6 +67,8 @@ void PinConstraints::reserve_pin_constraints(const size_t& num_pin_constraints)
   pin_constraint_ids_.reserve(num_pin_constraints);
   pin_constraint_pins_.reserve(num_pin_constraints);
   pin_constraint_nets_.reserve(num_pin_constraints);
+  pin_constraint_pin_lookup_.reserve(num_pin_constraints);
+  pin_constraint_net_lookup_.reserve(num_pin_constraints);
 }
 
 PinConstraintId PinConstraints::create_pin_constraint(const openfpga::BasicPort& pin,
@@ -81,6 +79,10 @@ PinConstraintId PinConstraints::create_pin_constraint(const openfpga::BasicPort&
   pin_constraint_ids_.push_back(pin_constraint_id);
   pin_constraint_pins_.push_back(pin);
   pin_constraint_nets_.push_back(net);
+
+  /* Only the first constraint is kept in the look-ups, as the queries return the first one found */
+  pin_constraint_pin_lookup_.emplace(pin, pin_constraint_id);
+  pin_constraint_net_lookup_.emplace(net, pin_constraint_id);
   
   return pin_constraint_id;
 }
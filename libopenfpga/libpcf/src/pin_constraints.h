@@ -7,6 +7,7 @@
 #include <string>
 #include <map>
 #include <array>
+#include <unordered_map>
 
 /* Headers from vtrutil library */
 #include "vtr_vector.h"
@@ -100,6 +101,10 @@ class PinConstraints {
 
     /* Nets to constraint */
     vtr::vector<PinConstraintId, std::string> pin_constraint_nets_;
+
+    /* Fast look-ups to the first constraint of a pin and of a net */
+    std::unordered_map<openfpga::BasicPort, PinConstraintId, openfpga::BasicPortHash> pin_constraint_pin_lookup_;
+    std::unordered_map<std::string, PinConstraintId> pin_constraint_net_lookup_;
 };
 
 #endif
@@ -53,14 +53,17 @@ std::string RepackDesignConstraints::net(const RepackDesignConstraintId& repack_
 std::string RepackDesignConstraints::find_constrained_pin_net(const std::string& pb_type,
                                                               const openfpga::BasicPort& pin) const {
   std::string constrained_net_name;
-  for (const RepackDesignConstraintId& design_constraint : design_constraints()) {
-    /* If found a constraint, record the net name */
-    if ( (pb_type == repack_design_constraint_pb_types_[design_constraint]) 
-       && (pin == repack_design_constraint_pins_[design_constraint])) {
-      constrained_net_name = repack_design_constraint_nets_[design_constraint];
-      break;
-    }
+  auto pb_type_result = repack_design_constraint_pin_lookup_.find(pb_type);
+  if (pb_type_result == repack_design_constraint_pin_lookup_.end()) {
+    return constrained_net_name;
   }
+  auto pin_result = pb_type_result->second.find(pin);
+  if (pin_result == pb_type_result->second.end()) {
+    return constrained_net_name;
+  }
+  /* If found a constraint, record the net name of the first one */
+  VTR_ASSERT(!pin_result->second.empty());
+  constrained_net_name = repack_design_constraint_nets_[pin_result->second.front()];
   return constrained_net_name;
 }
 
@@ -88,6 +91,8 @@ RepackDesignConstraintId RepackDesignConstraints::create_design_constraint(const
   repack_design_constraint_pb_types_.emplace_back();
   repack_design_constraint_pins_.emplace_back();
   repack_design_constraint_nets_.emplace_back();
+
+  add_pin_lookup(repack_design_constraint_id);
   
   return repack_design_constraint_id;
 }
@@ -96,14 +101,18 @@ void RepackDesignConstraints::set_pb_type(const RepackDesignConstraintId& repack
                                           const std::string& pb_type) {
   /* validate the design_constraint_id */
   VTR_ASSERT(valid_design_constraint_id(repack_design_constraint_id));
+  remove_pin_lookup(repack_design_constraint_id);
   repack_design_constraint_pb_types_[repack_design_constraint_id] = pb_type;
+  add_pin_lookup(repack_design_constraint_id);
 }
 
 void RepackDesignConstraints::set_pin(const RepackDesignConstraintId& repack_design_constraint_id,
                                       const openfpga::BasicPort& pin) {
   /* validate the design_constraint_id */
   VTR_ASSERT(valid_design_constraint_id(repack_design_constraint_id));
+  remove_pin_lookup(repack_design_constraint_id);
   repack_design_constraint_pins_[repack_design_constraint_id] = pin;
+  add_pin_lookup(repack_design_constraint_id);
 }
 
 void RepackDesignConstraints::set_net(const RepackDesignConstraintId& repack_design_constraint_id,
@@ -113,6 +122,34 @@ void RepackDesignConstraints::set_net(const RepackDesignConstraintId& repack_des
   repack_design_constraint_nets_[repack_design_constraint_id] = net;
 }
 
+/************************************************************************
+ * Internal mutators
+ ***********************************************************************/
+void RepackDesignConstraints::add_pin_lookup(const RepackDesignConstraintId& repack_design_constraint_id) {
+  std::vector<RepackDesignConstraintId>& ids = repack_design_constraint_pin_lookup_[repack_design_constraint_pb_types_[repack_design_constraint_id]][repack_design_constraint_pins_[repack_design_constraint_id]];
+  /* Keep the ascending order, so that the first constraint can be found as before */
+  ids.insert(std::lower_bound(ids.begin(), ids.end(), repack_design_constraint_id), repack_design_constraint_id);
+}
+
+void RepackDesignConstraints::remove_pin_lookup(const RepackDesignConstraintId& repack_design_constraint_id) {
+  auto pb_type_result = repack_design_constraint_pin_lookup_.find(repack_design_constraint_pb_types_[repack_design_constraint_id]);
+  VTR_ASSERT(pb_type_result != repack_design_constraint_pin_lookup_.end());
+  auto pin_result = pb_type_result->second.find(repack_design_constraint_pins_[repack_design_constraint_id]);
+  VTR_ASSERT(pin_result != pb_type_result->second.end());
+
+  std::vector<RepackDesignConstraintId>& ids = pin_result->second;
+  auto id_result = std::lower_bound(ids.begin(), ids.end(), repack_design_constraint_id);
+  VTR_ASSERT((id_result != ids.end()) && (*id_result == repack_design_constraint_id));
+  ids.erase(id_result);
+
+  if (ids.empty()) {
+    pb_type_result->second.erase(pin_result);
+  }
+  if (pb_type_result->second.empty()) {
+    repack_design_constraint_pin_lookup_.erase(pb_type_result);
+  }
+}
+
 /************************************************************************
  * Internal invalidators/validators 
  ***********************************************************************/
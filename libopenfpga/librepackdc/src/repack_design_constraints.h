@@ -7,6 +7,7 @@
 #include <string>
 #include <map>
 #include <array>
+#include <unordered_map>
 
 /* Headers from vtrutil library */
 #include "vtr_vector.h"
@@ -104,6 +105,11 @@ class RepackDesignConstraints {
      */
     bool unmapped_net(const std::string& net) const;
 
+  private: /* Internal mutators */
+    /* Add/remove a design constraint to/from the fast look-up with its current pb_type and pin */
+    void add_pin_lookup(const RepackDesignConstraintId& repack_design_constraint_id);
+    void remove_pin_lookup(const RepackDesignConstraintId& repack_design_constraint_id);
+
   private: /* Internal data */
     /* Unique ids for each design constraint */
     vtr::vector<RepackDesignConstraintId, RepackDesignConstraintId> repack_design_constraint_ids_;
@@ -119,6 +125,11 @@ class RepackDesignConstraints {
 
     /* Nets to constraint */
     vtr::vector<RepackDesignConstraintId, std::string> repack_design_constraint_nets_;
+
+    /* Fast look-up to the design constraints of a pin of a pb_type, in the ascending order of ids
+     * [pb_type][pin][0 .. num_constraints - 1]
+     */
+    std::unordered_map<std::string, std::unordered_map<openfpga::BasicPort, std::vector<RepackDesignConstraintId>, openfpga::BasicPortHash>> repack_design_constraint_pin_lookup_;
 };
 
 #endif
@@ -16,6 +16,13 @@ Lexer::Lexer(FILE* file, Callback& callback)
     blifparse_set_in(file, state_);
 }
 
+Lexer::Lexer(const char* data, size_t size, Callback& callback)
+    : callback_(callback) {
+    blifparse_lex_init(&state_);
+    //The lexer scans a copy of the data, which is released with the lexer state
+    blifparse__scan_bytes(data, size, state_);
+}
+
 Lexer::~Lexer() {
     blifparse_lex_destroy(state_);
 }
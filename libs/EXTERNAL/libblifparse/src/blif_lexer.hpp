@@ -11,6 +11,7 @@ typedef void* yyscan_t;
 class Lexer {
     public:
         Lexer(FILE* file, Callback& callback);
+        Lexer(const char* data, size_t size, Callback& callback);
         ~Lexer();
         Parser::symbol_type next_token();
         const char* text() const;
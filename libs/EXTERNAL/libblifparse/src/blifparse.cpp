@@ -9,6 +9,8 @@
 
 namespace blifparse {
 
+static void blif_parse(Lexer& lexer, Callback& callback, const char* filename);
+
 //.conn [Extended BLIF]
 void Callback::conn(std::string /*src*/, std::string /*dst*/) {
     parse_error(-1, ".conn", "Unsupported BLIF extension");
@@ -56,6 +58,19 @@ void blif_parse_file(FILE* blif_file, Callback& callback, const char* filename)
     //Initialize the lexer
     Lexer lexer(blif_file, callback);
 
+    blif_parse(lexer, callback, filename);
+}
+
+void blif_parse_buffer(const char* data, size_t size, Callback& callback, const char* filename) {
+
+    //Initialize the lexer
+    Lexer lexer(data, size, callback);
+
+    blif_parse(lexer, callback, filename);
+}
+
+static void blif_parse(Lexer& lexer, Callback& callback, const char* filename) {
+
     //Setup the parser + lexer
     Parser parser(lexer, callback);
 
@@ -101,6 +101,9 @@ void blif_parse_filename(const char* filename, Callback& callback);
 //Loads from 'blif'. 'filename' only used to pass a filename to callback and can be left unspecified
 void blif_parse_file(FILE* blif, Callback& callback, const char* filename=""); 
 
+//Loads from the 'size' characters at 'data' (e.g. a memory-mapped file). 'filename' only used to pass a filename to callback and can be left unspecified
+void blif_parse_buffer(const char* data, size_t size, Callback& callback, const char* filename="");
+
 /*
  * Enumerations
  */
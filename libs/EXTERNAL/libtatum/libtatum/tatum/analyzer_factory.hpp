@@ -10,6 +10,7 @@
 #include "tatum/graph_walkers.hpp"
 #include "tatum/timing_analyzers.hpp"
 #include "tatum/analyzers/full_timing_analyzers.hpp"
+#include "tatum/analyzers/IncrSetupTimingAnalyzer.hpp"
 
 namespace tatum {
 
@@ -49,6 +50,15 @@ namespace tatum {
  *      SetupAnalysis       =>  SetupTimingAnalyzer
  *      HoldAnalysis        =>  HoldTimingAnalyzer
  *      SetupHoldAnalysis   =>  SetupHoldTimingAnalyzer
+ *
+ * The IncrAnalyzerFactory builds incremental analyzers in the same way, which only re-analyze
+ * the timing graph around the edges passed to invalidate_edge() since the previous update:
+ *
+ *      auto incr_setup_analyzer = IncrAnalyzerFactory<SetupAnalysis,ParallelWalker>::make(timing_graph,
+ *                                                                                          timing_constraints,
+ *                                                                                          delay_calculator);
+ *
+ * where the GraphWalker is used for the first (full) analysis.
  */
 
 ///Factor class to construct timing analyzers
@@ -129,6 +139,38 @@ struct AnalyzerFactory<SetupHoldAnalysis,GraphWalker> {
     }
 };
 
+//Incremental analyzers
+template<class Visitor,
+         class GraphWalker>
+struct IncrAnalyzerFactory {
+
+    template<typename T>
+    struct dependent_false : std::false_type {};
+
+    //Error if the unspecialized template is instantiated
+    static_assert(dependent_false<Visitor>::value,
+                  "Incremental analysis is only supported for setup analysis (i.e. SetupAnalysis)");
+
+    static std::unique_ptr<TimingAnalyzer> make(const TimingGraph& timing_graph,
+                                                const TimingConstraints& timing_constraints,
+                                                const DelayCalculator& delay_calc);
+};
+
+//Specialize for setup
+template<class GraphWalker>
+struct IncrAnalyzerFactory<SetupAnalysis,GraphWalker> {
+
+    static std::unique_ptr<SetupTimingAnalyzer> make(const TimingGraph& timing_graph,
+                                                     const TimingConstraints& timing_constraints,
+                                                     const DelayCalculator& delay_calc) {
+        return std::unique_ptr<SetupTimingAnalyzer>(
+                new detail::IncrSetupTimingAnalyzer<GraphWalker>(timing_graph,
+                                                                 timing_constraints,
+                                                                 delay_calc)
+                );
+    }
+};
+
 } //namepsace
 
 #endif
@@ -13,6 +13,14 @@ template<class Visitor,
          class GraphWalker=SerialWalker>
 struct AnalyzerFactory;
 
+///Factor class to construct incremental timing analyzers
+///
+///\tparam Visitor The analysis type visitor (only SetupAnalysis is supported)
+///\tparam GraphWalker The graph walker to use for full analyses (defaults to serial traversals)
+template<class Visitor,
+         class GraphWalker=SerialWalker>
+struct IncrAnalyzerFactory;
+
 } //namepsace
 
 #endif
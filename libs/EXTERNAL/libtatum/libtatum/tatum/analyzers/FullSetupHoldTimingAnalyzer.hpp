@@ -82,6 +82,8 @@ class FullSetupHoldTimingAnalyzer : public SetupHoldTimingAnalyzer {
             graph_walker_.do_update_slack(timing_graph_, delay_calculator_, hold_visitor);
         }
 
+        void invalidate_edge_impl(const EdgeId /*edge*/) override {} //Every edge is re-analyzed anyway
+        void invalidate_all_edges_impl() override {}
         double get_profiling_data_impl(std::string key) const override { return graph_walker_.get_profiling_data(key); }
         size_t num_unconstrained_startpoints_impl() const override { return graph_walker_.num_unconstrained_startpoints(); }
         size_t num_unconstrained_endpoints_impl() const override { return graph_walker_.num_unconstrained_endpoints(); }
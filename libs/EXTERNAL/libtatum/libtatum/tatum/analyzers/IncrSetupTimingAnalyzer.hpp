@@ -0,0 +1,341 @@
+#pragma once
+#include <algorithm>
+#include <limits>
+#include <vector>
+
+#include "tatum/graph_walkers/SerialWalker.hpp"
+#include "tatum/SetupAnalysis.hpp"
+#include "tatum/analyzers/SetupTimingAnalyzer.hpp"
+#include "tatum/base/validate_timing_graph_constraints.hpp"
+
+namespace tatum { namespace detail {
+
+/**
+ * A concrete implementation of a SetupTimingAnalyzer.
+ *
+ * This is an incremental analyzer: once the timing graph has been fully
+ * analyzed, update_timing_impl() only re-analyzes the nodes affected by
+ * the edges passed to invalidate_edge() since the previous update:
+ *   - arrival times are re-propagated through the fan-out of the invalidated
+ *     edges, stopping at the nodes whose arrival tags do not change,
+ *   - required times are re-propagated through the fan-in of the invalidated
+ *     edges and of the nodes whose arrival tags changed, stopping in the same way,
+ *   - slacks are re-calculated at the re-analyzed nodes and their edges.
+ *
+ * Since each re-analyzed node is processed exactly as in a full analysis,
+ * the results are identical to those of a FullSetupTimingAnalyzer.
+ *
+ * The first update, and the update following invalidate_all_edges(), are full
+ * analyses performed by the GraphWalker. Incremental updates are serial.
+ */
+template<class GraphWalker=SerialWalker>
+class IncrSetupTimingAnalyzer : public SetupTimingAnalyzer {
+    public:
+        IncrSetupTimingAnalyzer(const TimingGraph& timing_graph, const TimingConstraints& timing_constraints, const DelayCalculator& delay_calculator)
+            : SetupTimingAnalyzer()
+            , timing_graph_(timing_graph)
+            , timing_constraints_(timing_constraints)
+            , delay_calculator_(delay_calculator)
+            , setup_visitor_(timing_graph_.nodes().size(), timing_graph_.edges().size())
+            , edge_invalidated_(timing_graph_.edges().size(), false)
+            , node_levels_(timing_graph_.nodes().size(), 0)
+            , node_arrival_queued_(timing_graph_.nodes().size(), false)
+            , node_required_queued_(timing_graph_.nodes().size(), false)
+            , node_slack_queued_(timing_graph_.nodes().size(), false) {
+            validate_timing_graph_constraints(timing_graph_, timing_constraints_);
+
+            //The nodes are re-analyzed level by level, as in a full analysis
+            for(LevelId level_id : timing_graph_.levels()) {
+                for(NodeId node_id : timing_graph_.level_nodes(level_id)) {
+                    node_levels_[size_t(node_id)] = size_t(level_id);
+                }
+            }
+            level_arrival_nodes_.resize(timing_graph_.levels().size());
+            level_required_nodes_.resize(timing_graph_.levels().size());
+
+            //Initialize profiling data
+            graph_walker_.set_profiling_data("total_analysis_sec", 0.);
+            graph_walker_.set_profiling_data("analysis_sec", 0.);
+            graph_walker_.set_profiling_data("num_full_updates", 0.);
+            graph_walker_.set_profiling_data("num_incr_updates", 0.);
+        }
+
+    protected:
+        virtual void update_timing_impl() override {
+            update_setup_timing();
+        }
+
+        virtual void update_setup_timing_impl() override {
+            auto start_time = Clock::now();
+
+            if(full_update_) {
+                full_update();
+                graph_walker_.set_profiling_data("num_full_updates", graph_walker_.get_profiling_data("num_full_updates") + 1);
+            } else {
+                incr_update();
+                graph_walker_.set_profiling_data("num_incr_updates", graph_walker_.get_profiling_data("num_incr_updates") + 1);
+            }
+
+            for(EdgeId edge : invalidated_edges_) {
+                edge_invalidated_[size_t(edge)] = false;
+            }
+            invalidated_edges_.clear();
+            full_update_ = false;
+
+            double analysis_sec = std::chrono::duration_cast<dsec>(Clock::now() - start_time).count();
+
+            //Record profiling data
+            double total_analysis_sec = analysis_sec + graph_walker_.get_profiling_data("total_analysis_sec");
+            graph_walker_.set_profiling_data("total_analysis_sec", total_analysis_sec);
+            graph_walker_.set_profiling_data("analysis_sec", analysis_sec);
+        }
+
+        //TimingAnalyzer
+        void invalidate_edge_impl(const EdgeId edge) override {
+            if(edge_invalidated_[size_t(edge)]) return;
+
+            edge_invalidated_[size_t(edge)] = true;
+            invalidated_edges_.push_back(edge);
+        }
+        void invalidate_all_edges_impl() override { full_update_ = true; }
+        double get_profiling_data_impl(std::string key) const override { return graph_walker_.get_profiling_data(key); }
+        size_t num_unconstrained_startpoints_impl() const override { return graph_walker_.num_unconstrained_startpoints(); }
+        size_t num_unconstrained_endpoints_impl() const override { return graph_walker_.num_unconstrained_endpoints(); }
+
+        //SetupTimingAnalyzer
+        TimingTags::tag_range setup_tags_impl(NodeId node_id) const override { return setup_visitor_.setup_tags(node_id); }
+        TimingTags::tag_range setup_tags_impl(NodeId node_id, TagType type) const override { return setup_visitor_.setup_tags(node_id, type); }
+        TimingTags::tag_range setup_edge_slacks_impl(EdgeId edge_id) const override { return setup_visitor_.setup_edge_slacks(edge_id); }
+        TimingTags::tag_range setup_node_slacks_impl(NodeId node_id) const override { return setup_visitor_.setup_node_slacks(node_id); }
+
+    private:
+        void full_update() {
+            graph_walker_.do_reset(timing_graph_, setup_visitor_);
+
+            graph_walker_.do_arrival_pre_traversal(timing_graph_, timing_constraints_, setup_visitor_);
+            graph_walker_.do_arrival_traversal(timing_graph_, timing_constraints_, delay_calculator_, setup_visitor_);
+
+            graph_walker_.do_required_pre_traversal(timing_graph_, timing_constraints_, setup_visitor_);
+            graph_walker_.do_required_traversal(timing_graph_, timing_constraints_, delay_calculator_, setup_visitor_);
+
+            graph_walker_.do_update_slack(timing_graph_, delay_calculator_, setup_visitor_);
+        }
+
+        void incr_update() {
+            for(EdgeId edge : invalidated_edges_) {
+                //The delay of the edge changes the arrival times at its sink,
+                //the required times at its source and its own slack
+                queue_arrival(timing_graph_.edge_sink_node(edge));
+                queue_required(timing_graph_.edge_src_node(edge));
+                queue_slack(timing_graph_.edge_sink_node(edge));
+            }
+
+            incr_update_arrival();
+            incr_update_required();
+            incr_update_slack();
+        }
+
+        void incr_update_arrival() {
+            for(size_t level = first_arrival_level_; level < level_arrival_nodes_.size(); ++level) {
+                //Nodes are only queued to higher levels while processing a level
+                for(size_t inode = 0; inode < level_arrival_nodes_[level].size(); ++inode) {
+                    NodeId node = level_arrival_nodes_[level][inode];
+                    node_arrival_queued_[size_t(node)] = false;
+
+                    //The tags of the first level only come from the constraints
+                    if(level == 0) continue;
+
+                    incr_update_node_arrival(node);
+                }
+                level_arrival_nodes_[level].clear();
+            }
+            first_arrival_level_ = std::numeric_limits<size_t>::max();
+        }
+
+        void incr_update_node_arrival(const NodeId node) {
+            bool is_sink = (timing_graph_.node_type(node) == NodeType::SINK);
+
+            //The required times of a SINK are set by the arrival traversal,
+            //while the ones of other nodes are kept for the required traversal
+            old_tags_.clear();
+            old_required_tags_.clear();
+            for(const TimingTag& tag : setup_visitor_.setup_tags(node)) {
+                if(tag.type() != TagType::DATA_REQUIRED) {
+                    old_tags_.push_back(tag);
+                } else if(is_sink) {
+                    old_required_tags_.push_back(tag);
+                }
+            }
+
+            setup_visitor_.do_reset_node_tags(node, TagType::CLOCK_LAUNCH);
+            setup_visitor_.do_reset_node_tags(node, TagType::CLOCK_CAPTURE);
+            setup_visitor_.do_reset_node_tags(node, TagType::DATA_ARRIVAL);
+            if(is_sink) {
+                setup_visitor_.do_reset_node_tags(node, TagType::DATA_REQUIRED);
+            }
+            setup_visitor_.do_arrival_traverse_node(timing_graph_, timing_constraints_, delay_calculator_, node);
+            queue_slack(node);
+
+            bool arrival_changed = !same_tags(old_tags_, setup_visitor_.setup_tags(node, TagType::CLOCK_LAUNCH),
+                                                         setup_visitor_.setup_tags(node, TagType::CLOCK_CAPTURE),
+                                                         setup_visitor_.setup_tags(node, TagType::DATA_ARRIVAL));
+            if(arrival_changed) {
+                for(EdgeId edge : timing_graph_.node_out_edges(node)) {
+                    //Slacks are also calculated on the disabled edges
+                    queue_slack(timing_graph_.edge_sink_node(edge));
+
+                    if(timing_graph_.edge_disabled(edge)) continue;
+
+                    queue_arrival(timing_graph_.edge_sink_node(edge));
+                }
+
+                //Required times are only kept for the launch domains arriving at the node
+                if(!is_sink) {
+                    queue_required(node);
+                }
+            }
+
+            if(is_sink && !same_tags(old_required_tags_, setup_visitor_.setup_tags(node, TagType::DATA_REQUIRED))) {
+                queue_required_fanin(node);
+            }
+        }
+
+        void incr_update_required() {
+            if(!required_queued_) return;
+
+            for(size_t level = last_required_level_ + 1; level-- > 0;) {
+                //Nodes are only queued to lower levels while processing a level
+                for(size_t inode = 0; inode < level_required_nodes_[level].size(); ++inode) {
+                    NodeId node = level_required_nodes_[level][inode];
+                    node_required_queued_[size_t(node)] = false;
+
+                    incr_update_node_required(node);
+                }
+                level_required_nodes_[level].clear();
+            }
+            last_required_level_ = 0;
+            required_queued_ = false;
+        }
+
+        void incr_update_node_required(const NodeId node) {
+            //Required times are not propagated through the clock network,
+            //and the ones of SINKs are set by the arrival traversal
+            NodeType node_type = timing_graph_.node_type(node);
+            if(node_type == NodeType::CPIN || node_type == NodeType::SINK) return;
+
+            auto required_tags = setup_visitor_.setup_tags(node, TagType::DATA_REQUIRED);
+            old_required_tags_.assign(required_tags.begin(), required_tags.end());
+
+            setup_visitor_.do_reset_node_tags(node, TagType::DATA_REQUIRED);
+            setup_visitor_.do_required_traverse_node(timing_graph_, timing_constraints_, delay_calculator_, node);
+            queue_slack(node);
+
+            if(!same_tags(old_required_tags_, setup_visitor_.setup_tags(node, TagType::DATA_REQUIRED))) {
+                queue_required_fanin(node);
+            }
+        }
+
+        void incr_update_slack() {
+            for(NodeId node : nodes_to_update_slack_) {
+                node_slack_queued_[size_t(node)] = false;
+
+                setup_visitor_.do_reset_node_slacks(node);
+                for(EdgeId edge : timing_graph_.node_in_edges(node)) {
+                    setup_visitor_.do_reset_edge(edge);
+                }
+                setup_visitor_.do_slack_traverse_node(timing_graph_, delay_calculator_, node);
+            }
+            nodes_to_update_slack_.clear();
+        }
+
+        void queue_arrival(const NodeId node) {
+            if(node_arrival_queued_[size_t(node)]) return;
+
+            node_arrival_queued_[size_t(node)] = true;
+            size_t level = node_levels_[size_t(node)];
+            level_arrival_nodes_[level].push_back(node);
+            first_arrival_level_ = std::min(first_arrival_level_, level);
+        }
+
+        void queue_required(const NodeId node) {
+            if(node_required_queued_[size_t(node)]) return;
+
+            node_required_queued_[size_t(node)] = true;
+            size_t level = node_levels_[size_t(node)];
+            level_required_nodes_[level].push_back(node);
+            last_required_level_ = std::max(last_required_level_, level);
+            required_queued_ = true;
+        }
+
+        //The slacks of a node and of its input edges are re-calculated together
+        void queue_slack(const NodeId node) {
+            if(node_slack_queued_[size_t(node)]) return;
+
+            node_slack_queued_[size_t(node)] = true;
+            nodes_to_update_slack_.push_back(node);
+        }
+
+        void queue_required_fanin(const NodeId node) {
+            for(EdgeId edge : timing_graph_.node_in_edges(node)) {
+                if(timing_graph_.edge_disabled(edge)) continue;
+
+                queue_required(timing_graph_.edge_src_node(edge));
+            }
+        }
+
+        //Tags are the same if they have the same types, domains and times,
+        //the origins do not matter since they are not propagated
+        static bool same_tag(const TimingTag& lhs, const TimingTag& rhs) {
+            return lhs.type() == rhs.type()
+                   && lhs.launch_clock_domain() == rhs.launch_clock_domain()
+                   && lhs.capture_clock_domain() == rhs.capture_clock_domain()
+                   && ((!lhs.time().valid() && !rhs.time().valid()) || lhs.time() == rhs.time());
+        }
+
+        template<class... Ranges>
+        static bool same_tags(const std::vector<TimingTag>& old_tags, const Ranges&... new_ranges) {
+            size_t itag = 0;
+            bool same = true;
+            for(const TimingTags::tag_range& new_tags : {new_ranges...}) {
+                for(const TimingTag& new_tag : new_tags) {
+                    if(itag == old_tags.size() || !same_tag(old_tags[itag], new_tag)) {
+                        same = false;
+                    }
+                    ++itag;
+                }
+            }
+            return same && itag == old_tags.size();
+        }
+
+    private:
+        const TimingGraph& timing_graph_;
+        const TimingConstraints& timing_constraints_;
+        const DelayCalculator& delay_calculator_;
+        SetupAnalysis setup_visitor_;
+        GraphWalker graph_walker_;
+
+        bool full_update_ = true;
+        std::vector<EdgeId> invalidated_edges_;
+        std::vector<bool> edge_invalidated_;
+
+        std::vector<size_t> node_levels_;
+        //Nodes to re-analyze by level, and the lowest (highest) level to start from
+        std::vector<std::vector<NodeId>> level_arrival_nodes_;
+        std::vector<std::vector<NodeId>> level_required_nodes_;
+        size_t first_arrival_level_ = std::numeric_limits<size_t>::max();
+        size_t last_required_level_ = 0;
+        bool required_queued_ = false;
+        std::vector<bool> node_arrival_queued_;
+        std::vector<bool> node_required_queued_;
+        std::vector<bool> node_slack_queued_;
+        std::vector<NodeId> nodes_to_update_slack_;
+
+        //Tags of the node being re-analyzed, before it is re-analyzed
+        std::vector<TimingTag> old_tags_;
+        std::vector<TimingTag> old_required_tags_;
+
+        typedef std::chrono::duration<double> dsec;
+        typedef std::chrono::high_resolution_clock Clock;
+};
+
+}} //namepsace
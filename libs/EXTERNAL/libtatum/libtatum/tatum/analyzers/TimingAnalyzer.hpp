@@ -1,6 +1,8 @@
 #pragma once
 #include <string>
 
+#include "tatum/TimingGraphFwd.hpp"
+
 namespace tatum {
 
 /**
@@ -8,6 +10,8 @@ namespace tatum {
  * which can be:
  *   - updated (update_timing())
  *   - reset (reset_timing()).
+ *   - told which edge delays have changed (invalidate_edge()), so that
+ *     incremental analyzers only re-analyze the affected part of the timing graph
  *
  * This is the most abstract interface provided (it does not allow access
  * to any calculated data).  As a result this interface is suitable for
@@ -28,6 +32,13 @@ class TimingAnalyzer {
         ///Perform timing analysis to update timing information (i.e. arrival & required times)
         void update_timing() { update_timing_impl(); }
 
+        ///Mark an edge whose delay has changed since the last update.
+        ///Full analyzers ignore it, since they re-analyze every edge on each update
+        void invalidate_edge(const EdgeId edge) { invalidate_edge_impl(edge); }
+
+        ///Mark all edges as changed, so that the next update re-analyzes the whole timing graph
+        void invalidate_all_edges() { invalidate_all_edges_impl(); }
+
         double get_profiling_data(std::string key) const { return get_profiling_data_impl(key); }
 
         virtual size_t num_unconstrained_startpoints() const { return num_unconstrained_startpoints_impl(); }
@@ -36,6 +47,9 @@ class TimingAnalyzer {
     protected:
         virtual void update_timing_impl() = 0;
 
+        virtual void invalidate_edge_impl(const EdgeId edge) = 0;
+        virtual void invalidate_all_edges_impl() = 0;
+
         virtual double get_profiling_data_impl(std::string key) const = 0;
 
         virtual size_t num_unconstrained_startpoints_impl() const = 0;
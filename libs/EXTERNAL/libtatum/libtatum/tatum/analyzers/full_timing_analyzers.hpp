@@ -6,7 +6,7 @@
  * In particular these concrete analyzers are 'full' (i.e. non-incremental) timing analyzers,
  * ever call to update_timing_impl() fully re-analyze the timing graph.
  *
- * Note that at this time only 'full' analyzers are supported.
+ * Incremental setup analysis is provided by IncrSetupTimingAnalyzer.
  */
 
 #include "FullSetupTimingAnalyzer.hpp"
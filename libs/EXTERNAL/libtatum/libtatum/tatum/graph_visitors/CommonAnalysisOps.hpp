@@ -50,6 +50,14 @@ class CommonAnalysisOps {
             node_slacks_[node].clear();
         }
 
+        void reset_node_tags(const NodeId node, const TagType type) {
+            node_tags_[node].clear(type);
+        }
+
+        void reset_node_slacks(const NodeId node) {
+            node_slacks_[node].clear();
+        }
+
         void merge_slack_tags(const EdgeId edge, const Time time, TimingTag ref_tag) { 
             ref_tag.set_type(TagType::SLACK);
             edge_slacks_[edge].min(time, ref_tag.origin_node(), ref_tag); 
@@ -34,6 +34,10 @@ class CommonAnalysisVisitor : public GraphVisitor {
         void do_reset_node(const NodeId node_id) override { ops_.reset_node(node_id); }
         void do_reset_edge(const EdgeId edge_id) override { ops_.reset_edge(edge_id); }
 
+        //Partial resets of a node, used by incremental analyzers to re-analyze only part of a node
+        void do_reset_node_tags(const NodeId node_id, const TagType type) { ops_.reset_node_tags(node_id, type); }
+        void do_reset_node_slacks(const NodeId node_id) { ops_.reset_node_slacks(node_id); }
+
         bool do_arrival_pre_traverse_node(const TimingGraph& tg, const TimingConstraints& tc, const NodeId node_id) override;
 
         bool do_required_pre_traverse_node(const TimingGraph& tg, const TimingConstraints& tc, const NodeId node_id) override;
@@ -29,6 +29,7 @@
 #include "golden_reference.hpp"
 #include "echo_loader.hpp"
 #include "verify.hpp"
+#include "verify_incr.hpp"
 #include "util.hpp"
 #include "profile.hpp"
 
@@ -78,6 +79,10 @@ struct Args {
     //Verify results match reference
     size_t verify = 0;
 
+    //Number of random graphs on which the incremental setup analyzer is
+    //checked against the full one (0 implies no check)
+    size_t verify_incr = 0;
+
     //Print reports
     size_t report = 1;
 
@@ -98,6 +103,7 @@ double arithmean(std::vector<double> values);
 void usage(std::string prog) {
     Args default_args;
     cout << "Usage: " << prog << " [options] tg_file\n";
+    cout << "       " << prog << " --verify_incr NUM_GRAPHS\n";
     cout << "\n";
     cout << "  Positional Arguments:\n";
     cout << "    tg_file:                      The input file (or '-' for stdin)\n";
@@ -128,6 +134,10 @@ void usage(std::string prog) {
     cout << "    --verify VERIFY:                  Verify calculated results match reference.\n";
     cout << "                                      0 implies no, non-zero implies yes.\n";
     cout << "                                      (default " << default_args.verify << ")\n";
+    cout << "    --verify_incr NUM_GRAPHS:         Verify incremental setup analysis matches full analysis\n";
+    cout << "                                      on NUM_GRAPHS randomized timing graphs, instead of analyzing tg_file.\n";
+    cout << "                                      0 implies no.\n";
+    cout << "                                      (default " << default_args.verify_incr << ")\n";
     cout << "    --debug_dot_node NODEID:          Specifies the timing graph node node whose transitive\n";
     cout << "                                      connections are dumped to the .dot file (useful for debugging).\n";
     cout << "                                      Values < -1 dump the entire graph,\n";
@@ -186,6 +196,8 @@ Args parse_args(int argc, char** argv) {
                     args.opt_graph_layout = arg_val;
                 } else if (argv[i] == std::string("--verify")) { 
                     args.verify = arg_val;
+                } else if (argv[i] == std::string("--verify_incr")) { 
+                    args.verify_incr = arg_val;
                 } else if (argv[i] == std::string("--print_sizes")) { 
                     args.print_sizes = arg_val;
                 } else if (argv[i] == std::string("--report")) { 
@@ -212,7 +224,7 @@ Args parse_args(int argc, char** argv) {
         }
     }
 
-    if (args.input_file.empty()) {
+    if (args.input_file.empty() && !args.verify_incr) {
         cmd_error(prog, "Missing required positional argument 'tg_file'");
     }
 
@@ -223,6 +235,11 @@ int main(int argc, char** argv) {
 
     Args args = parse_args(argc, argv);
 
+    if (args.verify_incr) {
+        bool verified = verify_incr_setup_analyzer(args.verify_incr, 0);
+        return verified ? 0 : 1;
+    }
+
     int exit_code = 0;
 
     struct timespec prog_start, load_start, opt_start, verify_start;
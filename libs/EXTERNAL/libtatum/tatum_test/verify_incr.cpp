@@ -0,0 +1,255 @@
+#include <algorithm>
+#include <cmath>
+#include <iostream>
+#include <random>
+#include <string>
+#include <tuple>
+#include <vector>
+
+#include "verify_incr.hpp"
+#include "tatum/TimingGraph.hpp"
+#include "tatum/TimingConstraints.hpp"
+#include "tatum/analyzer_factory.hpp"
+#include "tatum/delay_calc/DelayCalculator.hpp"
+#include "tatum/tags/TimingTags.hpp"
+#include "tatum/tags/TimingTag.hpp"
+#include "tatum/util/tatum_linear_map.hpp"
+
+using namespace tatum;
+
+using std::cout;
+using std::endl;
+
+//Number of delay changes applied to each graph
+constexpr size_t NUM_DELAY_CHANGES = 40;
+
+//Every FULL_RESET_PERIOD changes, delays are changed without invalidating
+//the edges, followed by invalidate_all_edges()
+constexpr size_t FULL_RESET_PERIOD = 8;
+
+//A delay calculator whose delays can be changed between analyses
+class MutableDelayCalculator : public DelayCalculator {
+    public:
+        MutableDelayCalculator(size_t num_edges)
+            : max_edge_delays_(num_edges, Time(0.))
+            , setup_times_(num_edges, Time(0.)) {}
+
+        Time max_edge_delay(const TimingGraph& /*tg*/, EdgeId edge_id) const override { return max_edge_delays_[edge_id]; }
+        Time min_edge_delay(const TimingGraph& /*tg*/, EdgeId edge_id) const override { return max_edge_delays_[edge_id]; }
+        Time setup_time(const TimingGraph& /*tg*/, EdgeId edge_id) const override { return setup_times_[edge_id]; }
+        Time hold_time(const TimingGraph& /*tg*/, EdgeId edge_id) const override { return setup_times_[edge_id]; }
+
+        void set_max_edge_delay(EdgeId edge_id, Time delay) { max_edge_delays_[edge_id] = delay; }
+        void set_setup_time(EdgeId edge_id, Time time) { setup_times_[edge_id] = time; }
+
+    private:
+        tatum::util::linear_map<EdgeId,Time> max_edge_delays_;
+        tatum::util::linear_map<EdgeId,Time> setup_times_;
+};
+
+typedef std::tuple<TagType,size_t,size_t,float> TagKey;
+
+void build_random_timing_graph(std::mt19937& rng, TimingGraph& tg, TimingConstraints& tc);
+void randomize_edge_delay(std::mt19937& rng, const TimingGraph& tg, EdgeId edge, MutableDelayCalculator& dc);
+size_t compare_analyzers(const TimingGraph& tg, const SetupTimingAnalyzer& incr_analyzer, const SetupTimingAnalyzer& full_analyzer, size_t igraph, size_t ichange);
+bool same_tags(TimingTags::tag_range incr_tags, TimingTags::tag_range full_tags);
+std::vector<TagKey> sorted_tag_keys(TimingTags::tag_range tags);
+
+bool verify_incr_setup_analyzer(size_t num_graphs, size_t seed) {
+    size_t num_errors = 0;
+    size_t num_incr_updates = 0;
+    size_t num_full_updates = 0;
+
+    for (size_t igraph = 0; igraph < num_graphs; ++igraph) {
+        std::mt19937 rng(seed + igraph);
+
+        TimingGraph tg;
+        TimingConstraints tc;
+        build_random_timing_graph(rng, tg, tc);
+
+        MutableDelayCalculator dc(tg.edges().size());
+        for (EdgeId edge : tg.edges()) {
+            randomize_edge_delay(rng, tg, edge, dc);
+        }
+
+        auto incr_analyzer = IncrAnalyzerFactory<SetupAnalysis>::make(tg, tc, dc);
+        auto full_analyzer = AnalyzerFactory<SetupAnalysis>::make(tg, tc, dc);
+
+        incr_analyzer->update_timing();
+        full_analyzer->update_timing();
+        num_errors += compare_analyzers(tg, *incr_analyzer, *full_analyzer, igraph, 0);
+
+        std::uniform_int_distribution<size_t> edge_dist(0, tg.edges().size() - 1);
+        std::uniform_int_distribution<size_t> num_edges_dist(1, std::max<size_t>(1, tg.edges().size() / 8));
+        for (size_t ichange = 1; ichange <= NUM_DELAY_CHANGES; ++ichange) {
+            bool full_reset = (ichange % FULL_RESET_PERIOD == 0);
+
+            size_t num_changed_edges = num_edges_dist(rng);
+            for (size_t i = 0; i < num_changed_edges; ++i) {
+                EdgeId edge(edge_dist(rng));
+                randomize_edge_delay(rng, tg, edge, dc);
+                if (!full_reset) {
+                    incr_analyzer->invalidate_edge(edge);
+                }
+            }
+            if (full_reset) {
+                incr_analyzer->invalidate_all_edges();
+            }
+
+            incr_analyzer->update_timing();
+            full_analyzer->update_timing();
+            num_errors += compare_analyzers(tg, *incr_analyzer, *full_analyzer, igraph, ichange);
+        }
+
+        num_incr_updates += size_t(incr_analyzer->get_profiling_data("num_incr_updates"));
+        num_full_updates += size_t(incr_analyzer->get_profiling_data("num_full_updates"));
+    }
+
+    cout << "Verified incremental setup analysis on " << num_graphs << " random graphs ("
+         << num_incr_updates << " incremental and " << num_full_updates << " full updates): "
+         << num_errors << " mismatches" << endl;
+
+    return num_errors == 0;
+}
+
+//Builds a random multi-clock netlist of primary inputs and outputs, flip-flops and LUTs.
+//Each LUT only uses the signals created before it, so there is no combinational loop
+void build_random_timing_graph(std::mt19937& rng, TimingGraph& tg, TimingConstraints& tc) {
+    std::uniform_int_distribution<size_t> num_domains_dist(1, 3);
+    std::uniform_int_distribution<size_t> num_ios_dist(1, 4);
+    std::uniform_int_distribution<size_t> num_ffs_dist(2, 10);
+    std::uniform_int_distribution<size_t> num_luts_dist(5, 40);
+    std::uniform_int_distribution<size_t> num_lut_inputs_dist(1, 4);
+    std::uniform_int_distribution<int> constraint_dist(5, 20);
+
+    std::vector<DomainId> domains;
+    std::vector<NodeId> clock_sources;
+    size_t num_domains = num_domains_dist(rng);
+    for (size_t idomain = 0; idomain < num_domains; ++idomain) {
+        NodeId clock_source = tg.add_node(NodeType::SOURCE);
+        DomainId domain = tc.create_clock_domain("clk" + std::to_string(idomain));
+        tc.set_clock_domain_source(clock_source, domain);
+        domains.push_back(domain);
+        clock_sources.push_back(clock_source);
+    }
+    for (DomainId src_domain : domains) {
+        for (DomainId sink_domain : domains) {
+            tc.set_setup_constraint(src_domain, sink_domain, Time(constraint_dist(rng) * 1e-10));
+        }
+    }
+    std::uniform_int_distribution<size_t> domain_dist(0, num_domains - 1);
+
+    //Signals which can drive the inputs of LUTs, flip-flops and primary outputs
+    std::vector<NodeId> drivers;
+    auto random_driver = [&]() {
+        std::uniform_int_distribution<size_t> driver_dist(0, drivers.size() - 1);
+        return drivers[driver_dist(rng)];
+    };
+
+    size_t num_inputs = num_ios_dist(rng);
+    for (size_t i = 0; i < num_inputs; ++i) {
+        NodeId input = tg.add_node(NodeType::SOURCE);
+        tc.set_input_constraint(input, domains[domain_dist(rng)], DelayType::MAX, Time(constraint_dist(rng) * 1e-11));
+        drivers.push_back(input);
+    }
+
+    //The data inputs of the flip-flops are connected once all the signals exist
+    std::vector<NodeId> ff_inputs;
+    size_t num_ffs = num_ffs_dist(rng);
+    for (size_t i = 0; i < num_ffs; ++i) {
+        NodeId cpin = tg.add_node(NodeType::CPIN);
+        tg.add_edge(EdgeType::INTERCONNECT, clock_sources[domain_dist(rng)], cpin);
+
+        NodeId source = tg.add_node(NodeType::SOURCE);
+        tg.add_edge(EdgeType::PRIMITIVE_CLOCK_LAUNCH, cpin, source);
+        NodeId q = tg.add_node(NodeType::OPIN);
+        tg.add_edge(EdgeType::PRIMITIVE_COMBINATIONAL, source, q);
+
+        NodeId sink = tg.add_node(NodeType::SINK);
+        tg.add_edge(EdgeType::PRIMITIVE_CLOCK_CAPTURE, cpin, sink);
+        NodeId d = tg.add_node(NodeType::IPIN);
+        tg.add_edge(EdgeType::PRIMITIVE_COMBINATIONAL, d, sink);
+
+        drivers.push_back(q);
+        ff_inputs.push_back(d);
+    }
+
+    size_t num_luts = num_luts_dist(rng);
+    for (size_t i = 0; i < num_luts; ++i) {
+        NodeId out = tg.add_node(NodeType::OPIN);
+        size_t num_lut_inputs = num_lut_inputs_dist(rng);
+        for (size_t j = 0; j < num_lut_inputs; ++j) {
+            NodeId in = tg.add_node(NodeType::IPIN);
+            tg.add_edge(EdgeType::INTERCONNECT, random_driver(), in);
+            tg.add_edge(EdgeType::PRIMITIVE_COMBINATIONAL, in, out);
+        }
+        drivers.push_back(out);
+    }
+
+    for (NodeId d : ff_inputs) {
+        tg.add_edge(EdgeType::INTERCONNECT, random_driver(), d);
+    }
+
+    size_t num_outputs = num_ios_dist(rng);
+    for (size_t i = 0; i < num_outputs; ++i) {
+        NodeId output = tg.add_node(NodeType::SINK);
+        tg.add_edge(EdgeType::INTERCONNECT, random_driver(), output);
+        tc.set_output_constraint(output, domains[domain_dist(rng)], DelayType::MAX, Time(constraint_dist(rng) * 1e-11));
+    }
+
+    //Some LUT and flip-flop outputs may be unused
+    tg.set_allow_dangling_combinational_nodes(true);
+    tg.levelize();
+    tg.validate();
+}
+
+//Delays are drawn from a few discrete values, so that equal arrival times
+//(and the ties they cause) are common
+void randomize_edge_delay(std::mt19937& rng, const TimingGraph& tg, EdgeId edge, MutableDelayCalculator& dc) {
+    std::uniform_int_distribution<int> delay_dist(0, 10);
+
+    dc.set_max_edge_delay(edge, Time(delay_dist(rng) * 1e-11));
+    if (tg.edge_type(edge) == EdgeType::PRIMITIVE_CLOCK_CAPTURE) {
+        dc.set_setup_time(edge, Time(delay_dist(rng) * 1e-11));
+    }
+}
+
+size_t compare_analyzers(const TimingGraph& tg, const SetupTimingAnalyzer& incr_analyzer, const SetupTimingAnalyzer& full_analyzer, size_t igraph, size_t ichange) {
+    size_t num_errors = 0;
+
+    for (NodeId node : tg.nodes()) {
+        if (!same_tags(incr_analyzer.setup_tags(node), full_analyzer.setup_tags(node))) {
+            cout << "Graph " << igraph << " change " << ichange << ": setup tags of node " << size_t(node) << " differ" << endl;
+            ++num_errors;
+        }
+        if (!same_tags(incr_analyzer.setup_slacks(node), full_analyzer.setup_slacks(node))) {
+            cout << "Graph " << igraph << " change " << ichange << ": setup slacks of node " << size_t(node) << " differ" << endl;
+            ++num_errors;
+        }
+    }
+    for (EdgeId edge : tg.edges()) {
+        if (!same_tags(incr_analyzer.setup_slacks(edge), full_analyzer.setup_slacks(edge))) {
+            cout << "Graph " << igraph << " change " << ichange << ": setup slacks of edge " << size_t(edge) << " differ" << endl;
+            ++num_errors;
+        }
+    }
+
+    return num_errors;
+}
+
+//Tags are compared by their types, domains and times.
+//The origins are not compared, since equal times may come from different nodes
+bool same_tags(TimingTags::tag_range incr_tags, TimingTags::tag_range full_tags) {
+    return sorted_tag_keys(incr_tags) == sorted_tag_keys(full_tags);
+}
+
+std::vector<TagKey> sorted_tag_keys(TimingTags::tag_range tags) {
+    std::vector<TagKey> keys;
+    for (const TimingTag& tag : tags) {
+        //Invalid times are all the same
+        float time = tag.time().valid() ? tag.time().value() : INFINITY;
+        keys.emplace_back(tag.type(), size_t(tag.launch_clock_domain()), size_t(tag.capture_clock_domain()), time);
+    }
+    std::sort(keys.begin(), keys.end());
+    return keys;
+}
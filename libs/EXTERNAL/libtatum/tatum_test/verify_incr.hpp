@@ -0,0 +1,13 @@
+#ifndef VERIFY_INCR_HPP
+#define VERIFY_INCR_HPP
+#include <cstddef>
+
+//Checks that IncrSetupTimingAnalyzer produces the same tags and slacks as
+//FullSetupTimingAnalyzer on num_graphs randomized multi-clock timing graphs,
+//while random edge delays are changed and invalidated (one by one, or all at
+//once). Each graph is generated from seed + its index, so failures can be replayed.
+//
+//Returns true if all the results match
+bool verify_incr_setup_analyzer(size_t num_graphs, size_t seed);
+
+#endif
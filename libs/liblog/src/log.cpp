@@ -7,6 +7,7 @@
 
 #include <stdio.h>
 #include <stdarg.h> /* Allows for variable arguments, necessary for wrapping printf */
+#include <mutex>
 #include "log.h"
 
 #define LOG_DEFAULT_FILE_NAME "output.log"
@@ -15,12 +16,21 @@ static int log_warning = 0;
 static int log_error = 0;
 FILE* log_stream = nullptr;
 
+/* Serializes the messages printed by different threads */
+static std::mutex log_mutex;
+/* Buffer of the messages of the calling thread, if any */
+static thread_local t_log_buffer* log_thread_buffer = nullptr;
+
 static void check_init();
+static std::string log_vformat(const char* message, va_list args);
+static void log_message(const e_log_message_type& type, const char* message, va_list args);
+static void log_print_message(const e_log_message_type& type, const std::string& message);
 
 /* Set the output file of logger.
  * If different than current log file, close current log file and reopen to new log file
  */
 void log_set_output_file(const char* filename) {
+    std::lock_guard<std::mutex> lock(log_mutex);
     if (log_stream != nullptr) {
         fclose(log_stream);
     }
@@ -35,71 +45,118 @@ void log_set_output_file(const char* filename) {
     }
 }
 
+t_log_buffer* log_set_thread_buffer(t_log_buffer* buffer) {
+    t_log_buffer* prev_buffer = log_thread_buffer;
+    log_thread_buffer = buffer;
+    return prev_buffer;
+}
+
+void log_flush_buffer(t_log_buffer& buffer, t_log_buffer* target) {
+    std::lock_guard<std::mutex> lock(log_mutex);
+    if (target != nullptr) {
+        /* The target may be shared by the threads flushing to it, hence the lock */
+        for (auto& message : buffer.messages) {
+            target->messages.push_back(std::move(message));
+        }
+    } else {
+        for (const auto& message : buffer.messages) {
+            log_print_message(message.first, message.second);
+        }
+    }
+    buffer.messages.clear();
+}
+
 void log_print_direct(const char* message, ...) {
     va_list args;
     va_start(args, message);
-    vprintf(message, args);
+    log_message(LOG_MESSAGE_DIRECT, message, args);
     va_end(args);
 }
 
 void log_print_info(const char* message, ...) {
-    check_init(); /* Check if output log file setup, if not, then this function also sets it up */
-
     va_list args;
     va_start(args, message);
-    vprintf(message, args);
+    log_message(LOG_MESSAGE_INFO, message, args);
     va_end(args);
-
-    if (log_stream) {
-        va_start(args, message); /* Must reset variable arguments so that they can be read again */
-        vfprintf(log_stream, message, args);
-        va_end(args);
-
-        fflush(log_stream);
-    }
 }
 
 void log_print_warning(const char* /*filename*/, unsigned int /*line_num*/, const char* message, ...) {
-    check_init(); /* Check if output log file setup, if not, then this function also sets it up */
-
     va_list args;
     va_start(args, message);
-    log_warning++;
-
-    printf("Warning %d: ", log_warning);
-    vprintf(message, args);
+    log_message(LOG_MESSAGE_WARNING, message, args);
     va_end(args);
-
-    if (log_stream) {
-        va_start(args, message); /* Must reset variable arguments so that they can be read again */
-        fprintf(log_stream, "Warning %d: ", log_warning);
-        vfprintf(log_stream, message, args);
-
-        va_end(args);
-        fflush(log_stream);
-    }
 }
 
 void log_print_error(const char* /*filename*/, unsigned int /*line_num*/, const char* message, ...) {
-    check_init(); /* Check if output log file setup, if not, then this function also sets it up */
-
     va_list args;
     va_start(args, message);
-    log_error++;
-
-    check_init();
-    fprintf(stderr, "Error %d: ", log_error);
-    vfprintf(stderr, message, args);
+    log_message(LOG_MESSAGE_ERROR, message, args);
     va_end(args);
+}
 
-    if (log_stream) {
-        va_start(args, message); /* Must reset variable arguments so that they can be read again */
-        fprintf(log_stream, "Error %d: ", log_error);
-        vfprintf(log_stream, message, args);
+static std::string log_vformat(const char* message, va_list args) {
+    va_list args_copy;
+    va_copy(args_copy, args);
+    int len = vsnprintf(nullptr, 0, message, args_copy);
+    va_end(args_copy);
+    if (len <= 0) {
+        return std::string();
+    }
+
+    std::string formatted(len + 1, '\0');
+    vsnprintf(&formatted[0], len + 1, message, args);
+    formatted.resize(len);
+    return formatted;
+}
+
+/* Buffer the message if the calling thread has a buffer, print it otherwise */
+static void log_message(const e_log_message_type& type, const char* message, va_list args) {
+    check_init(); /* Check if output log file setup, if not, then this function also sets it up */
+
+    std::string formatted = log_vformat(message, args);
+    if (log_thread_buffer != nullptr) {
+        log_thread_buffer->messages.emplace_back(type, std::move(formatted));
+        return;
+    }
 
-        va_end(args);
+    std::lock_guard<std::mutex> lock(log_mutex);
+    log_print_message(type, formatted);
+}
 
-        fflush(log_stream);
+/* Print a message to the console and the log file. The caller should hold the log_mutex */
+static void log_print_message(const e_log_message_type& type, const std::string& message) {
+    switch (type) {
+        case LOG_MESSAGE_DIRECT:
+            fputs(message.c_str(), stdout);
+            /* Direct messages are not written to the log file */
+            return;
+        case LOG_MESSAGE_INFO:
+            fputs(message.c_str(), stdout);
+            if (log_stream) {
+                fputs(message.c_str(), log_stream);
+                fflush(log_stream);
+            }
+            return;
+        case LOG_MESSAGE_WARNING:
+            log_warning++;
+            printf("Warning %d: %s", log_warning, message.c_str());
+            if (log_stream) {
+                fprintf(log_stream, "Warning %d: %s", log_warning, message.c_str());
+                fflush(log_stream);
+            }
+            return;
+        case LOG_MESSAGE_ERROR:
+            log_error++;
+            fprintf(stderr, "Error %d: %s", log_error, message.c_str());
+            if (log_stream) {
+                fprintf(log_stream, "Error %d: %s", log_error, message.c_str());
+                fflush(log_stream);
+            }
+            return;
+        default:
+            /* Unknown types are printed as they are */
+            fputs(message.c_str(), stdout);
+            return;
     }
 }
 
@@ -111,6 +168,7 @@ static void check_init() {
 }
 
 void log_close() {
+    std::lock_guard<std::mutex> lock(log_mutex);
     if (log_stream) {
         fclose(log_stream);
     }
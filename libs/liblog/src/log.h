@@ -10,8 +10,37 @@
 #ifndef LOG_H
 #define LOG_H
 
+#include <string>
+#include <utility>
+#include <vector>
+
+enum e_log_message_type {
+    LOG_MESSAGE_DIRECT,
+    LOG_MESSAGE_INFO,
+    LOG_MESSAGE_WARNING,
+    LOG_MESSAGE_ERROR
+};
+
+/* Messages held back for a thread, in the order they are printed */
+struct t_log_buffer {
+    std::vector<std::pair<e_log_message_type, std::string>> messages;
+};
+
 void log_set_output_file(const char* filename);
 
+/* Buffer the messages printed by the calling thread, instead of printing them,
+ * e.g., when running tasks in parallel, so that the messages of each task can be
+ * printed at once and in a deterministic order.
+ * Pass nullptr to print the messages again. The previous buffer is returned, so that it can be restored.
+ * Warnings and errors are numbered when they are flushed.
+ */
+t_log_buffer* log_set_thread_buffer(t_log_buffer* buffer);
+
+/* Print the messages of a buffer at once, without interleaving with other threads, and clear it.
+ * When a target buffer is given, the messages are appended to it instead of being printed
+ */
+void log_flush_buffer(t_log_buffer& buffer, t_log_buffer* target = nullptr);
+
 void log_print_direct(const char* message, ...);
 void log_print_info(const char* message, ...);
 void log_print_warning(const char* filename, unsigned int line_num, const char* message, ...);
@@ -10,7 +10,7 @@ std::size_t loc_data::line(std::ptrdiff_t offset) const {
     auto it = std::lower_bound(offsets_.begin(), offsets_.end(), offset);
     std::size_t index = it - offsets_.begin();
 
-    return 1 + index;
+    return 1 + line_base_ + index;
 }
 
 //Return the column number from the given offset
@@ -46,4 +46,12 @@ void loc_data::build_loc_data() {
     fclose(f);
 }
 
+void loc_data::build_loc_data(const char* buffer, std::size_t size) {
+    for (std::size_t i = 0; i < size; ++i) {
+        if (buffer[i] == '\n') {
+            offsets_.push_back(i);
+        }
+    }
+}
+
 } // namespace pugiutil
@@ -20,6 +20,14 @@ class loc_data {
         build_loc_data();
     }
 
+    //Location data of a fragment of the file, held in the given buffer,
+    //which starts at the given line of the file
+    loc_data(std::string filename_val, const char* buffer, std::size_t size, std::size_t first_line)
+        : filename_(filename_val)
+        , line_base_(first_line - 1) {
+        build_loc_data(buffer, size);
+    }
+
     //The filename this location data is for
     const std::string& filename() const { return filename_; }
     const char* filename_c_str() const { return filename_.c_str(); }
@@ -42,8 +50,10 @@ class loc_data {
 
   private:
     void build_loc_data();
+    void build_loc_data(const char* buffer, std::size_t size);
 
     std::string filename_;
+    std::size_t line_base_ = 0;
     std::vector<std::ptrdiff_t> offsets_;
 };
 } // namespace pugiutil
@@ -35,3 +35,7 @@ const kj::ArrayPtr<const ::capnp::word> MmapFile::getData() const {
     return kj::arrayPtr(reinterpret_cast<const ::capnp::word*>(data_.begin()),
                         size_ / sizeof(::capnp::word));
 }
+
+const kj::ArrayPtr<const char> MmapFile::getChars() const {
+    return kj::arrayPtr(reinterpret_cast<const char*>(data_.begin()), size_);
+}
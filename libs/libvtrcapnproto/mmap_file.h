@@ -10,6 +10,8 @@ class MmapFile {
   public:
     explicit MmapFile(const std::string& file);
     const kj::ArrayPtr<const ::capnp::word> getData() const;
+    //The contents of the file as characters, e.g. for text files
+    const kj::ArrayPtr<const char> getChars() const;
 
   private:
     size_t size_;
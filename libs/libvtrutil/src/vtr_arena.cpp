@@ -0,0 +1,132 @@
+#include <algorithm>
+#include <cstdint>
+#include <cstdlib>
+
+#include "vtr_assert.h"
+#include "vtr_arena.h"
+
+#ifdef __linux__
+#    include <sys/mman.h>
+#endif
+
+namespace vtr {
+
+//Size of transparent huge pages, to which the chunks are aligned when enabled
+constexpr size_t HUGEPAGE_SIZE = 2 * 1024 * 1024;
+
+bump_arena::bump_arena(bool use_hugepage, size_t chunk_size)
+    : use_hugepage_(use_hugepage)
+    , chunk_size_(chunk_size) {
+    VTR_ASSERT(0 < chunk_size_);
+}
+
+bump_arena::~bump_arena() {
+    clear();
+}
+
+void* bump_arena::allocate(size_t size, size_t alignment) {
+    //Alignment must be a power of two
+    VTR_ASSERT(0 < alignment && 0 == (alignment & (alignment - 1)));
+
+    //Each allocation gets a distinct address
+    if (0 == size) {
+        size = 1;
+    }
+
+    size_t pad = (-reinterpret_cast<uintptr_t>(next_mem_loc_ptr_)) & (alignment - 1);
+    if (nullptr == next_mem_loc_ptr_ || mem_avail_ < pad + size) {
+        //Large requests get a chunk of their own, the remainder of the current chunk is wasted
+        add_chunk(size + alignment);
+        pad = (-reinterpret_cast<uintptr_t>(next_mem_loc_ptr_)) & (alignment - 1);
+    }
+
+    char* block = next_mem_loc_ptr_ + pad;
+    next_mem_loc_ptr_ = block + size;
+    mem_avail_ -= pad + size;
+    num_bytes_allocated_ += size;
+
+    return block;
+}
+
+void bump_arena::clear() {
+    for (const t_arena_chunk& chunk : chunks_) {
+        std::free(chunk.data);
+    }
+    chunks_.clear();
+    chunks_.shrink_to_fit();
+    next_mem_loc_ptr_ = nullptr;
+    mem_avail_ = 0;
+    num_bytes_allocated_ = 0;
+}
+
+size_t bump_arena::memory_usage() const {
+    size_t num_bytes = chunks_.capacity() * sizeof(t_arena_chunk);
+    for (const t_arena_chunk& chunk : chunks_) {
+        num_bytes += chunk.size;
+    }
+    return num_bytes;
+}
+
+void bump_arena::add_chunk(size_t min_size) {
+    size_t size = std::max(chunk_size_, min_size);
+    void* data = nullptr;
+
+    if (use_hugepage_) {
+        //Round up to whole huge pages, so that the kernel can back the entire chunk by them
+        size = (size + HUGEPAGE_SIZE - 1) / HUGEPAGE_SIZE * HUGEPAGE_SIZE;
+        if (0 != posix_memalign(&data, HUGEPAGE_SIZE, size)) {
+            data = nullptr;
+        }
+#if defined(__linux__) && defined(MADV_HUGEPAGE)
+        if (nullptr != data) {
+            //Only an advice: a failure leaves the chunk on normal pages
+            madvise(data, size, MADV_HUGEPAGE);
+        }
+#endif
+    } else {
+        data = std::malloc(size);
+    }
+
+    if (nullptr == data) {
+        throw std::bad_alloc();
+    }
+
+    chunks_.push_back({static_cast<char*>(data), size});
+    next_mem_loc_ptr_ = static_cast<char*>(data);
+    mem_avail_ = size;
+}
+
+arena_holder::arena_holder(const arena_holder& other) {
+    if (other.enabled()) {
+        arena_.reset(new bump_arena(other.arena_->use_hugepage(), other.arena_->chunk_size()));
+    }
+}
+
+arena_holder& arena_holder::operator=(const arena_holder& other) {
+    //The own arena is kept, as the containers assigned to keep their allocators
+    if (!enabled() && other.enabled()) {
+        arena_.reset(new bump_arena(other.arena_->use_hugepage(), other.arena_->chunk_size()));
+    }
+    return *this;
+}
+
+void arena_holder::enable(bool use_hugepage) {
+    if (!enabled()) {
+        arena_.reset(new bump_arena(use_hugepage));
+    }
+}
+
+void arena_holder::clear() {
+    if (enabled()) {
+        arena_->clear();
+    }
+}
+
+size_t arena_holder::memory_usage() const {
+    if (!enabled()) {
+        return 0;
+    }
+    return sizeof(bump_arena) + arena_->memory_usage();
+}
+
+} // namespace vtr
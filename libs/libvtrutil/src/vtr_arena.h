@@ -0,0 +1,172 @@
+#ifndef VTR_ARENA_H
+#define VTR_ARENA_H
+#include <cstddef>
+#include <memory>
+#include <new>
+#include <type_traits>
+#include <vector>
+
+namespace vtr {
+
+//A bump allocator, which parcels out memory from large chunks.
+//
+//An allocation is a pointer increment in the current chunk, and nothing is freed
+//until the whole arena is cleared (or destroyed), which releases all the chunks at once.
+//It suits the databases which perform many small allocations as they grow, e.g.,
+//a std::vector per net, and are released together.
+//
+//Optionally, the chunks are aligned to huge pages and the kernel is advised to back them
+//with transparent huge pages (Linux only), which reduces the TLB misses when walking
+//the databases. The advice is silently ignored on the systems which do not support it.
+//
+//The arena is not thread-safe: each thread (or each data structure built by a thread)
+//should use its own arena.
+class bump_arena {
+  public:
+    //Default size of chunks: one huge page on x86-64
+    static constexpr size_t DEFAULT_CHUNK_SIZE = 2 * 1024 * 1024;
+
+    explicit bump_arena(bool use_hugepage = false, size_t chunk_size = DEFAULT_CHUNK_SIZE);
+    ~bump_arena();
+
+    //No copy, as the memory is owned by the arena
+    bump_arena(const bump_arena&) = delete;
+    bump_arena& operator=(const bump_arena&) = delete;
+
+    //Returns a block of memory of the given size and alignment,
+    //which is valid until the arena is cleared
+    void* allocate(size_t size, size_t alignment = alignof(std::max_align_t));
+
+    //Releases all the memory allocated by the arena
+    void clear();
+
+    bool use_hugepage() const { return use_hugepage_; }
+    size_t chunk_size() const { return chunk_size_; }
+    size_t num_chunks() const { return chunks_.size(); }
+
+    //Returns the bytes handed out by allocate() since the last clear
+    size_t num_bytes_allocated() const { return num_bytes_allocated_; }
+
+    //Returns the heap memory held by the arena, in bytes
+    size_t memory_usage() const;
+
+  private:
+    //Starts a new chunk which can hold at least the given number of bytes
+    void add_chunk(size_t min_size);
+
+  private:
+    struct t_arena_chunk {
+        char* data;
+        size_t size;
+    };
+
+    bool use_hugepage_;
+    size_t chunk_size_;
+    std::vector<t_arena_chunk> chunks_;
+    char* next_mem_loc_ptr_ = nullptr; //First free byte in the current chunk
+    size_t mem_avail_ = 0;             //Number of bytes left in the current chunk
+    size_t num_bytes_allocated_ = 0;
+};
+
+//A STL allocator which allocates from a bump_arena, e.g.,
+//    vtr::bump_arena arena;
+//    std::vector<int, vtr::arena_allocator<int>> vec(vtr::arena_allocator<int>(&arena));
+//
+//A default-constructed allocator has no arena and falls back to the heap (like std::allocator).
+//Deallocation is a no-op for the arena memory, which is released when the arena is cleared,
+//so the arena must outlive the containers using it.
+//
+//Copies of a container allocate from the heap, so that copying a data structure
+//never makes the copy depend on (or grow) the arena of the original.
+template<typename T>
+class arena_allocator {
+  public:
+    typedef T value_type;
+
+    //Containers copied or swapped keep the allocator of their memory
+    typedef std::false_type propagate_on_container_copy_assignment;
+    typedef std::true_type propagate_on_container_move_assignment;
+    typedef std::true_type propagate_on_container_swap;
+
+    arena_allocator() noexcept = default;
+    explicit arena_allocator(bump_arena* arena) noexcept
+        : arena_(arena) {}
+    template<typename U>
+    arena_allocator(const arena_allocator<U>& other) noexcept
+        : arena_(other.arena()) {}
+
+    T* allocate(size_t n) {
+        if (nullptr == arena_) {
+            return static_cast<T*>(::operator new(n * sizeof(T)));
+        }
+        return static_cast<T*>(arena_->allocate(n * sizeof(T), alignof(T)));
+    }
+
+    void deallocate(T* ptr, size_t /*n*/) noexcept {
+        if (nullptr == arena_) {
+            ::operator delete(ptr);
+        }
+        //Otherwise the memory is released with the arena
+    }
+
+    arena_allocator select_on_container_copy_construction() const {
+        return arena_allocator();
+    }
+
+    bump_arena* arena() const { return arena_; }
+
+  private:
+    bump_arena* arena_ = nullptr;
+};
+
+template<typename T, typename U>
+bool operator==(const arena_allocator<T>& lhs, const arena_allocator<U>& rhs) {
+    return lhs.arena() == rhs.arena();
+}
+
+template<typename T, typename U>
+bool operator!=(const arena_allocator<T>& lhs, const arena_allocator<U>& rhs) {
+    return !(lhs == rhs);
+}
+
+//An optional arena owned by a data structure, whose containers allocate from it.
+//
+//It behaves as a member of the data structure, so that the implicit copy and move
+//operations of the data structure are still correct:
+//  * A copy owns a new arena with the same settings, since the copied containers
+//    allocate from the heap (see arena_allocator)
+//  * A copy-assignment keeps its own arena, which may still be used by its containers
+//  * A move takes over the arena with the containers using it
+class arena_holder {
+  public:
+    arena_holder() = default;
+    arena_holder(const arena_holder& other);
+    arena_holder& operator=(const arena_holder& other);
+    arena_holder(arena_holder&& other) noexcept = default;
+    arena_holder& operator=(arena_holder&& other) noexcept = default;
+
+    //Creates the arena, if there is none
+    void enable(bool use_hugepage = false);
+
+    bool enabled() const { return nullptr != arena_; }
+
+    //Returns the arena, or nullptr if it is not enabled
+    bump_arena* get() const { return arena_.get(); }
+
+    //Returns an allocator on the arena, or on the heap if the arena is not enabled
+    template<typename T>
+    arena_allocator<T> allocator() const { return arena_allocator<T>(arena_.get()); }
+
+    //Releases the memory of the arena, which should not be used by any container any more
+    void clear();
+
+    //Returns the heap memory held by the arena, in bytes
+    size_t memory_usage() const;
+
+  private:
+    std::unique_ptr<bump_arena> arena_;
+};
+
+} // namespace vtr
+
+#endif
@@ -36,4 +36,12 @@ std::string secure_digest_stream(std::istream& is) {
     return "SHA256:" + picosha2::get_hash_hex_string(hasher);
 }
 
+std::string secure_digest_buffer(const char* data, size_t size) {
+    picosha2::hash256_one_by_one hasher;
+    hasher.process(data, data + size);
+    hasher.finish();
+
+    return "SHA256:" + picosha2::get_hash_hex_string(hasher);
+}
+
 } // namespace vtr
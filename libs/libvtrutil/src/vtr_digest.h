@@ -11,6 +11,10 @@ std::string secure_digest_file(const std::string& filepath);
 //Generate a secure hash of a stream
 std::string secure_digest_stream(std::istream& is);
 
+//Generate a secure hash of the contents of a buffer (e.g. a memory-mapped file),
+//which is identical to the one of a file with the same contents
+std::string secure_digest_buffer(const char* data, size_t size);
+
 } // namespace vtr
 
 #endif
@@ -0,0 +1,105 @@
+#ifndef VTR_LAZY_ID_ITERATOR_H
+#define VTR_LAZY_ID_ITERATOR_H
+#include <iterator>
+#include <vector>
+
+namespace vtr {
+
+/*
+ * A set of removed (i.e. tombstoned) IDs, stored as a bitmap over the ID space.
+ *
+ * The key assumption made is that the ID space is zero-based and contiguous,
+ * as for the IDs which are allocated by incrementing a counter.
+ * It provides the subset of the std::unordered_set interface which is needed to
+ * record the invalid IDs of a data structure, while a look-up is a plain bit test
+ * (or no access at all when nothing has been removed) instead of a hash look-up.
+ */
+template<class ID>
+class tombstone_bitmap {
+  public:
+    //Returns true if no ID has been removed
+    bool empty() const { return 0 == num_tombstones_; }
+
+    //Returns the number of removed IDs
+    size_t size() const { return num_tombstones_; }
+
+    //Returns 1 if the ID has been removed, otherwise 0
+    size_t count(const ID& id) const {
+        if (empty() || size_t(id) >= bits_.size()) {
+            return 0;
+        }
+        return bits_[size_t(id)] ? 1 : 0;
+    }
+
+    //Marks the ID as removed
+    void insert(const ID& id) {
+        if (size_t(id) >= bits_.size()) {
+            bits_.resize(size_t(id) + 1, false);
+        }
+        if (!bits_[size_t(id)]) {
+            bits_[size_t(id)] = true;
+            ++num_tombstones_;
+        }
+    }
+
+    //Forgets all the removed IDs
+    void clear() {
+        bits_.clear();
+        num_tombstones_ = 0;
+    }
+
+    //Returns the heap memory held by the bitmap, in bytes
+    size_t memory_usage() const { return (bits_.capacity() + 7) / 8; }
+
+  private:
+    std::vector<bool> bits_;
+    size_t num_tombstones_ = 0;
+};
+
+/*
+ * A lazily calculated iterator of the specified ID type.
+ * The key assumption made is that the ID space is contiguous and can be walked
+ * by incrementing the underlying ID value. To account for invalid IDs, it keeps
+ * a reference to the tombstone bitmap and returns ID::INVALID() for removed IDs.
+ *
+ * It is used to lazily create an iteration range (e.g. as returned by RRGraph::nodes())
+ * just based on the count of allocated elements and the tombstones of any removed elements.
+ * When no element has been removed, a dereference does not access the bitmap at all,
+ * so that the iteration is as cheap as walking an array index.
+ */
+template<class ID>
+class lazy_id_iterator : public std::iterator<std::bidirectional_iterator_tag, ID> {
+  public:
+    //Since we pass ID as a template to std::iterator we need to use an explicit 'typename'
+    //to bring the value_type name into scope
+    typedef typename std::iterator<std::bidirectional_iterator_tag, ID>::value_type value_type;
+
+    lazy_id_iterator(value_type init, const tombstone_bitmap<ID>& invalid_ids)
+        : value_(init)
+        , invalid_ids_(invalid_ids) {}
+
+    //Advance to the next ID value
+    lazy_id_iterator& operator++() {
+        value_ = ID(size_t(value_) + 1);
+        return *this;
+    }
+
+    //Advance to the previous ID value
+    lazy_id_iterator& operator--() {
+        value_ = ID(size_t(value_) - 1);
+        return *this;
+    }
+
+    //Dereference the iterator
+    value_type operator*() const { return (invalid_ids_.count(value_)) ? ID::INVALID() : value_; }
+
+    friend bool operator==(const lazy_id_iterator<ID> lhs, const lazy_id_iterator<ID> rhs) { return lhs.value_ == rhs.value_; }
+    friend bool operator!=(const lazy_id_iterator<ID> lhs, const lazy_id_iterator<ID> rhs) { return !(lhs == rhs); }
+
+  private:
+    value_type value_;
+    const tombstone_bitmap<ID>& invalid_ids_;
+};
+
+} // namespace vtr
+#endif
@@ -53,6 +53,13 @@
  *
  * To avoid run-time overhead, these are only enabled if VTR_ENABLE_DEBUG_LOGGING 
  * is defined (disabled by default).
+ *
+ * Buffered Logging
+ * ================
+ *
+ * Messages can be held back for the calling thread with log_set_thread_buffer()
+ * of liblog, and printed at once later with log_flush_buffer(),
+ * e.g., to keep the log deterministic when tasks run in parallel.
  */
 
 //Unconditional logging macros
@@ -1,5 +1,6 @@
 #ifndef VTR_SMALL_VECTOR
 #define VTR_SMALL_VECTOR
+#include <array>
 #include <memory>
 #include <algorithm>
 #include <limits>
@@ -174,7 +175,7 @@ class small_vector {
 
     const_pointer data() const {
         if (is_short()) {
-            short_.data_;
+            return short_.data_.data();
         }
         return long_.data_;
     }
@@ -213,10 +214,12 @@ class small_vector {
     }
 
     void reserve(size_type num_elems) {
-        //Don't change capacity unless requested number of elements is both:
-        //  * More than the short capacity (no need to reserve up to short capacity)
-        //  * Greater than the current size (capacity can never be below size)
-        if (num_elems > SHORT_CAPACITY && num_elems > size()) {
+        //Don't change capacity unless:
+        //  * The long format is used, since the format is decided by the size and
+        //    a short vector can not hold a dynamic buffer (no need to reserve up to short capacity,
+        //    the buffer is allocated once the vector grows beyond it)
+        //  * The requested number of elements is greater than the current capacity
+        if (!is_short() && num_elems > capacity()) {
             change_capacity(num_elems);
         }
     }
@@ -290,25 +293,33 @@ class small_vector {
         //
         //Note that change_capacity will automatically convert from short to long
         //format if required.
-        size_type new_size = size() + n;
-        if (capacity() < new_size) {
+        size_type old_size = size();
+        size_type new_size = old_size + n;
+        if (new_size > SHORT_CAPACITY && capacity() < new_size) {
             change_capacity(new_size);
         }
 
-        iterator first = begin() + i;
-        iterator last = first + n;
-        reverse_swap_elements(first, end(), end() + n - 1);
+        //The format is decided by the new size, which is updated only after the insertion.
+        //So the storage is found explicitly, rather than through begin()
+        T* buff = (new_size > SHORT_CAPACITY) ? long_.data_ : short_.data_.data();
+
+        //Shift the values in [i, old_size) by n
+        for (size_type j = old_size; j > i; --j) {
+            new (buff + j - 1 + n) T(std::move(buff[j - 1]));
+            buff[j - 1].~T();
+        }
 
-        //Insert new values at end
-        std::uninitialized_fill(first, last, val);
+        //Insert new values at position
+        std::uninitialized_fill(buff + i, buff + i + n, val);
 
         set_size(new_size);
 
-        return first;
+        return buff + i;
     }
 
     iterator insert(const_iterator position, size_type n, value_type&& val) {
-        return insert(position, n, value_type(val)); //TODO: optimize for moved val
+        const value_type& val_ref = val;
+        return insert(position, n, val_ref); //TODO: optimize for moved val
     }
 
     //Range insert
@@ -415,12 +426,13 @@ class small_vector {
         return begin() + std::distance(cbegin(), position);
     }
 
-    void swap(small_vector<T, S>& other) {
-        swap(*this, other);
+    friend void swap(small_vector<T, S>& lhs, small_vector<T, S>& rhs) {
+        lhs.swap(rhs);
     }
 
-    friend void swap(small_vector<T, S>& lhs, small_vector<T, S>& rhs) {
-        using std::swap;
+    void swap(small_vector<T, S>& other) {
+        small_vector<T, S>& lhs = *this;
+        small_vector<T, S>& rhs = other;
 
         if (lhs.is_short() && rhs.is_short()) {
             //Both short
@@ -445,29 +457,34 @@ class small_vector {
 
             //Save long data
             pointer long_buf = long_vec.long_.data_;
-            size_type long_size = long_vec.long_size_;
+            size_type long_size = long_vec.long_.size_;
             size_type long_capacity = long_vec.long_.capacity_;
 
             //Copy short data into long
             //
             //Note that the long format contains only basic data types with no destructors to call,
             //so we can use uninitialzed copy
-            std::uninitialized_copy(short_vec.short_.begin(), short_vec.short_.end(), long_vec.short_.data_);
-            long_vec.short_.size_ = short_vec.size();
+            std::uninitialized_copy(short_vec.begin(), short_vec.end(), long_vec.short_.data_.data());
+            long_vec.set_size(short_vec.size());
 
             //Destroy original elements in short
             short_vec.destruct_elements();
 
             //Copy long data into short
-            short_vec.long_.data = long_buf;
+            short_vec.long_.data_ = long_buf;
             short_vec.long_.capacity_ = long_capacity;
             short_vec.long_.size_ = long_size;
         }
     }
 
     void clear() {
-        //Destruct all elements and clear size, but do not free memory
+        //Destruct all elements and clear size.
+        //Since the format is decided by the size, an empty vector is always in short format,
+        //and the dynamic buffer (if any) is freed
         destruct_elements();
+        if (!is_short()) {
+            dealloc(long_.data_);
+        }
         set_size(0);
     }
 
@@ -521,39 +538,28 @@ class small_vector {
         }
     }
 
-    small_vector(const small_vector& other) {
-        if (other.is_short()) {
-            ~small_vector(); //Clean-up elements
-
-            //Copy in place
-            short_ = other.short_;
-        } else {
-            if (!is_short() && capacity() >= other.size()) {
-                //Re-use existing buffer, since it has sufficient capacity
-                destruct_elements();
-
-            } else {
-                ~small_vector(); //Clean-up elements, potentially freeing buffer
-
-                //Create new buffer of exact size
-                long_.data_ = alloc(other.size());
-                long_.capacity_ = other.size();
-            }
+    small_vector(const small_vector& other)
+        : small_vector() {
+        if (!other.is_short()) {
+            //Create new buffer of exact size
+            long_.data_ = alloc(other.size());
+            long_.capacity_ = other.size();
+        }
 
-            set_size(other.size());
+        //Copy elements, in place or to the buffer
+        std::uninitialized_copy(other.begin(), other.end(),
+                                (other.is_short()) ? short_.data_.data() : long_.data_);
 
-            //Copy elements
-            std::uninitialized_copy(other.begin(), other.end(), long_.data_);
-        }
+        set_size(other.size());
     }
 
-    small_vector(small_vector&& other)
+    small_vector(small_vector&& other) noexcept
         : small_vector() {
-        swap(*this, other); //Copy-swap
+        swap(other); //Copy-swap
     }
 
     small_vector& operator=(small_vector other) {
-        swap(*this, other); //Copy-swap
+        swap(other); //Copy-swap
         return *this;
     }
 
@@ -95,6 +95,9 @@ class vector_map {
 
     void clear() { vec_.clear(); }
 
+    //Reserves space for n entries
+    void reserve(size_t n) { vec_.reserve(n); }
+
     size_t capacity() const { return vec_.capacity(); }
     void shrink_to_fit() { vec_.shrink_to_fit(); }
 
@@ -0,0 +1,117 @@
+#include "catch.hpp"
+
+#include "vtr_arena.h"
+#include "vtr_vector.h"
+
+#include <cstdint>
+#include <vector>
+
+TEST_CASE("Allocate", "[vtr_arena]") {
+    vtr::bump_arena arena(false, 1024);
+
+    REQUIRE(arena.num_chunks() == 0);
+    REQUIRE(arena.memory_usage() == 0);
+
+    //Blocks are aligned and do not overlap
+    char* prev_end = nullptr;
+    for (size_t i = 1; i < 100; ++i) {
+        char* block = static_cast<char*>(arena.allocate(i, 8));
+        REQUIRE(block != nullptr);
+        REQUIRE(reinterpret_cast<uintptr_t>(block) % 8 == 0);
+        if (prev_end != nullptr && arena.num_chunks() == 1) {
+            REQUIRE(block >= prev_end);
+        }
+        prev_end = block + i;
+    }
+    REQUIRE(arena.num_chunks() > 1);
+    REQUIRE(arena.num_bytes_allocated() == 99 * 100 / 2);
+
+    //Large blocks get a chunk of their own
+    size_t num_chunks = arena.num_chunks();
+    void* large_block = arena.allocate(10 * 1024, 64);
+    REQUIRE(reinterpret_cast<uintptr_t>(large_block) % 64 == 0);
+    REQUIRE(arena.num_chunks() == num_chunks + 1);
+
+    arena.clear();
+    REQUIRE(arena.num_chunks() == 0);
+    REQUIRE(arena.num_bytes_allocated() == 0);
+    REQUIRE(arena.memory_usage() == 0);
+}
+
+TEST_CASE("Hugepage", "[vtr_arena]") {
+    vtr::bump_arena arena(true, 4096);
+
+    void* block = arena.allocate(100);
+    REQUIRE(block != nullptr);
+    REQUIRE(arena.num_chunks() == 1);
+    //Chunks are rounded up to whole huge pages
+    REQUIRE(arena.memory_usage() >= 2 * 1024 * 1024);
+}
+
+TEST_CASE("Allocator", "[vtr_arena]") {
+    vtr::bump_arena arena;
+    typedef vtr::vector<size_t, size_t, vtr::arena_allocator<size_t>> t_arena_vector;
+
+    std::vector<t_arena_vector> vecs;
+    for (size_t i = 0; i < 100; ++i) {
+        vecs.emplace_back(vtr::arena_allocator<size_t>(&arena));
+        for (size_t j = 0; j < i; ++j) {
+            vecs.back().push_back(j);
+        }
+    }
+    REQUIRE(arena.num_bytes_allocated() > 0);
+
+    for (size_t i = 0; i < 100; ++i) {
+        REQUIRE(vecs[i].size() == i);
+        REQUIRE(vecs[i].get_allocator().arena() == &arena);
+        for (size_t j = 0; j < i; ++j) {
+            REQUIRE(vecs[i][j] == j);
+        }
+    }
+
+    //Copies are on the heap
+    t_arena_vector copy = vecs[10];
+    REQUIRE(copy.get_allocator().arena() == nullptr);
+    REQUIRE(copy.size() == 10);
+    REQUIRE(copy[9] == 9);
+
+    //Moves keep the arena
+    t_arena_vector moved = std::move(vecs[20]);
+    REQUIRE(moved.get_allocator().arena() == &arena);
+    REQUIRE(moved.size() == 20);
+
+    //Copy-assignments keep their own allocator
+    copy = vecs[30];
+    REQUIRE(copy.get_allocator().arena() == nullptr);
+    REQUIRE(copy.size() == 30);
+}
+
+TEST_CASE("Holder", "[vtr_arena]") {
+    vtr::arena_holder holder;
+    REQUIRE(!holder.enabled());
+    REQUIRE(holder.allocator<int>().arena() == nullptr);
+    REQUIRE(holder.memory_usage() == 0);
+
+    holder.enable(false);
+    REQUIRE(holder.enabled());
+    vtr::bump_arena* arena = holder.get();
+    REQUIRE(holder.allocator<int>().arena() == arena);
+
+    //Enabling again keeps the arena
+    holder.enable(true);
+    REQUIRE(holder.get() == arena);
+
+    //Copies get their own arena
+    vtr::arena_holder copy(holder);
+    REQUIRE(copy.enabled());
+    REQUIRE(copy.get() != arena);
+
+    vtr::arena_holder copy_assigned;
+    copy_assigned = holder;
+    REQUIRE(copy_assigned.enabled());
+    REQUIRE(copy_assigned.get() != arena);
+
+    //Moves take the arena
+    vtr::arena_holder moved(std::move(holder));
+    REQUIRE(moved.get() == arena);
+}
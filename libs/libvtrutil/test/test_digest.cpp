@@ -0,0 +1,26 @@
+#include "catch.hpp"
+
+#include "vtr_digest.h"
+
+#include <sstream>
+#include <string>
+
+TEST_CASE("Digest Buffer", "[vtr_digest]") {
+    //Larger than the chunks used to read streams
+    std::string contents;
+    for (int i = 0; i < 1000; ++i) {
+        contents += ".names a" + std::to_string(i) + " b\n1 1\n";
+    }
+
+    std::istringstream is(contents);
+    std::string stream_digest = vtr::secure_digest_stream(is);
+
+    REQUIRE(stream_digest.find("SHA256:") == 0);
+    REQUIRE(vtr::secure_digest_buffer(contents.data(), contents.size()) == stream_digest);
+
+    //Digests of different contents differ
+    REQUIRE(vtr::secure_digest_buffer(contents.data(), contents.size() - 1) != stream_digest);
+
+    std::istringstream empty_is("");
+    REQUIRE(vtr::secure_digest_buffer(nullptr, 0) == vtr::secure_digest_stream(empty_is));
+}
@@ -0,0 +1,53 @@
+#include "catch.hpp"
+
+#include "vtr_lazy_id_iterator.h"
+#include "vtr_range.h"
+#include "vtr_strong_id.h"
+
+#include <vector>
+
+struct lazy_test_tag;
+typedef vtr::StrongId<lazy_test_tag> LazyTestId;
+
+TEST_CASE("Tombstone Bitmap", "[vtr_lazy_id_iterator]") {
+    vtr::tombstone_bitmap<LazyTestId> tombstones;
+
+    REQUIRE(tombstones.empty());
+    REQUIRE(tombstones.count(LazyTestId(3)) == 0);
+
+    tombstones.insert(LazyTestId(3));
+    tombstones.insert(LazyTestId(3));
+    tombstones.insert(LazyTestId(1));
+
+    REQUIRE(tombstones.size() == 2);
+    REQUIRE(tombstones.count(LazyTestId(0)) == 0);
+    REQUIRE(tombstones.count(LazyTestId(1)) == 1);
+    REQUIRE(tombstones.count(LazyTestId(3)) == 1);
+    REQUIRE(tombstones.count(LazyTestId(100)) == 0);
+
+    tombstones.clear();
+    REQUIRE(tombstones.empty());
+    REQUIRE(tombstones.count(LazyTestId(3)) == 0);
+}
+
+TEST_CASE("Lazy Iteration", "[vtr_lazy_id_iterator]") {
+    typedef vtr::lazy_id_iterator<LazyTestId> iterator;
+
+    vtr::tombstone_bitmap<LazyTestId> tombstones;
+    auto range = vtr::make_range(iterator(LazyTestId(0), tombstones),
+                                 iterator(LazyTestId(4), tombstones));
+
+    std::vector<LazyTestId> ids;
+    for (LazyTestId id : range) {
+        ids.push_back(id);
+    }
+    REQUIRE(ids == std::vector<LazyTestId>({LazyTestId(0), LazyTestId(1), LazyTestId(2), LazyTestId(3)}));
+
+    /* Removed ids are visited as invalid ids */
+    tombstones.insert(LazyTestId(2));
+    ids.clear();
+    for (LazyTestId id : range) {
+        ids.push_back(id);
+    }
+    REQUIRE(ids == std::vector<LazyTestId>({LazyTestId(0), LazyTestId(1), LazyTestId::INVALID(), LazyTestId(3)}));
+}
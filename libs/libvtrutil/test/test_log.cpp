@@ -0,0 +1,38 @@
+#include "catch.hpp"
+
+#include "vtr_log.h"
+#include "log.h"
+
+#include <string>
+
+TEST_CASE("Log Buffer", "[vtr_log]") {
+    t_log_buffer buffer;
+    REQUIRE(log_set_thread_buffer(&buffer) == nullptr);
+
+    VTR_LOG("Task %d\n", 1);
+    VTR_LOG_ERROR("Failed %s\n", "task");
+
+    //Messages are kept in order with their types
+    REQUIRE(log_set_thread_buffer(nullptr) == &buffer);
+    REQUIRE(buffer.messages.size() == 2);
+    REQUIRE(buffer.messages[0].first == LOG_MESSAGE_INFO);
+    REQUIRE(buffer.messages[0].second == "Task 1\n");
+    REQUIRE(buffer.messages[1].first == LOG_MESSAGE_ERROR);
+    REQUIRE(buffer.messages[1].second == "Failed task\n");
+
+    //Flushing to another buffer appends the messages and clears the source
+    t_log_buffer target;
+    target.messages.emplace_back(LOG_MESSAGE_INFO, "Task 0\n");
+    log_flush_buffer(buffer, &target);
+    REQUIRE(buffer.messages.empty());
+    REQUIRE(target.messages.size() == 3);
+    REQUIRE(target.messages[0].second == "Task 0\n");
+    REQUIRE(target.messages[2].second == "Failed task\n");
+
+    //Long messages are not truncated
+    std::string long_msg(10000, 'x');
+    log_set_thread_buffer(&buffer);
+    VTR_LOG("%s", long_msg.c_str());
+    log_set_thread_buffer(nullptr);
+    REQUIRE(buffer.messages[0].second == long_msg);
+}
@@ -146,3 +146,54 @@ TEST_CASE("Basic", "[vtr_small_vector]") {
     REQUIRE(ref == vec);
     ++i;
 }
+
+TEST_CASE("Format Transitions", "[vtr_small_vector]") {
+    size_t inplace_cap = vtr::small_vector<int>::INPLACE_CAPACITY;
+
+    for (size_t num_elems : {size_t(0), size_t(1), inplace_cap, inplace_cap + 1, 4 * inplace_cap}) {
+        std::vector<int> ref;
+        vtr::small_vector<int> vec;
+
+        //Reserve is only a hint
+        vec.reserve(num_elems);
+        for (size_t i = 0; i < num_elems; ++i) {
+            ref.push_back(i);
+            vec.push_back(i);
+        }
+        REQUIRE(ref == vec);
+
+        //Copy
+        vtr::small_vector<int> copy(vec);
+        REQUIRE(ref == copy);
+
+        //Move
+        vtr::small_vector<int> moved(std::move(copy));
+        REQUIRE(ref == moved);
+
+        //Assign and swap between formats
+        vtr::small_vector<int> other;
+        other.push_back(-1);
+        std::vector<int> other_ref = {-1};
+        swap(other, moved);
+        REQUIRE(ref == other);
+        REQUIRE(other_ref == moved);
+
+        moved = vec;
+        REQUIRE(ref == moved);
+
+        //Insert across the short capacity
+        ref.insert(ref.begin(), inplace_cap, 7);
+        vec.insert(vec.begin(), inplace_cap, 7);
+        REQUIRE(ref == vec);
+
+        //Clear and re-use
+        ref.clear();
+        vec.clear();
+        REQUIRE(ref == vec);
+        REQUIRE(vec.capacity() == inplace_cap);
+
+        ref.push_back(3);
+        vec.push_back(3);
+        REQUIRE(ref == vec);
+    }
+}
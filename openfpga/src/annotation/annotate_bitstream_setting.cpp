@@ -85,6 +85,22 @@ int annotate_bitstream_pb_type_setting(const BitstreamSetting& bitstream_setting
         vpr_bitstream_annotation.set_pb_type_mode_select_bitstream_offset(target_pb_type, bitstream_setting.bitstream_offset(bitstream_pb_type_setting_id));
       }
 
+      /* The content is organized as <.param|.attr> <identifier string>,
+       * which is checked here rather than for each primitive in bitstream generation
+       */
+      VprBitstreamAnnotation::e_eblif_line_type eblif_line_type = VprBitstreamAnnotation::NUM_EBLIF_LINE_TYPES;
+      if (false == bitstream_setting.is_mode_select_bitstream(bitstream_pb_type_setting_id)) {
+        eblif_line_type = vpr_bitstream_annotation.pb_type_bitstream_eblif_line_type(target_pb_type);
+      } else {
+        eblif_line_type = vpr_bitstream_annotation.pb_type_mode_select_bitstream_eblif_line_type(target_pb_type);
+      }
+      if (VprBitstreamAnnotation::NUM_EBLIF_LINE_TYPES == eblif_line_type) {
+        VTR_LOG_ERROR("Invalid bitstream content '%s' for pb_type '%s' which is defined in bitstream setting! Expect '<.param|.attr> <identifier>'\n",
+                      bitstream_setting.pb_type_bitstream_content(bitstream_pb_type_setting_id).c_str(),
+                      target_pb_type_names[0].c_str());
+        return CMD_EXEC_FATAL_ERROR;
+      }
+
       link_success = true;
     }
 
@@ -2,6 +2,8 @@
  * This file includes functions that are used to annotate pb_graph_node
  * and pb_graph_pins from VPR to OpenFPGA
  *******************************************************************/
+#include <unordered_map>
+
 /* Headers from vtrutil library */
 #include "vtr_assert.h"
 #include "vtr_log.h"
@@ -297,21 +299,117 @@ void annotate_primitive_pb_graph_node_unique_index(const DeviceContext& vpr_devi
 }
 
 /********************************************************************
- * Evaluate if the two pb_graph pins are matched by
+ * Location of a port of a physical pb_type in the pin arrays of its pb_graph_nodes
+ * The location is the same for all the pb_graph_nodes of the pb_type, 
+ * so that the pin of a port can be picked from any pb_graph_node without a search
+ *******************************************************************/
+enum e_pb_graph_pin_group {
+  PB_GRAPH_INPUT_PINS,
+  PB_GRAPH_OUTPUT_PINS,
+  PB_GRAPH_CLOCK_PINS,
+  NUM_PB_GRAPH_PIN_GROUPS
+};
+
+struct t_physical_pb_port_location {
+  e_pb_graph_pin_group pin_group;
+  int iport;
+};
+
+typedef std::unordered_map<const t_port*, t_physical_pb_port_location> PhysicalPbPortLookup;
+
+/********************************************************************
+ * Register the ports of the pb_type of a physical pb_graph_node in the look-up,
+ * if they have not been registered by another pb_graph_node of the pb_type
+ *******************************************************************/
+static 
+void build_physical_pb_port_lookup(t_pb_graph_node* physical_pb_graph_node,
+                                   PhysicalPbPortLookup& physical_pb_port_lookup) {
+  /* All the ports of a pb_type are registered together */
+  const t_pb_type* physical_pb_type = physical_pb_graph_node->pb_type;
+  if ( (0 == physical_pb_type->num_ports)
+    || (0 < physical_pb_port_lookup.count(&(physical_pb_type->ports[0]))) ) {
+    return;
+  }
+
+  for (int iport = 0; iport < physical_pb_graph_node->num_input_ports; ++iport) {
+    if (0 < physical_pb_graph_node->num_input_pins[iport]) {
+      physical_pb_port_lookup.emplace(physical_pb_graph_node->input_pins[iport][0].port,
+                                      t_physical_pb_port_location{PB_GRAPH_INPUT_PINS, iport});
+    }
+  }
+  for (int iport = 0; iport < physical_pb_graph_node->num_output_ports; ++iport) {
+    if (0 < physical_pb_graph_node->num_output_pins[iport]) {
+      physical_pb_port_lookup.emplace(physical_pb_graph_node->output_pins[iport][0].port,
+                                      t_physical_pb_port_location{PB_GRAPH_OUTPUT_PINS, iport});
+    }
+  }
+  for (int iport = 0; iport < physical_pb_graph_node->num_clock_ports; ++iport) {
+    if (0 < physical_pb_graph_node->num_clock_pins[iport]) {
+      physical_pb_port_lookup.emplace(physical_pb_graph_node->clock_pins[iport][0].port,
+                                      t_physical_pb_port_location{PB_GRAPH_CLOCK_PINS, iport});
+    }
+  }
+}
+
+/********************************************************************
+ * Find the pin of a port with a given pin number in a physical pb_graph_node
+ * Return nullptr if the port does not belong to the pb_graph_node 
+ * or the pin number is out of range
+ *******************************************************************/
+static 
+t_pb_graph_pin* find_physical_pb_graph_pin(t_pb_graph_node* physical_pb_graph_node,
+                                           const PhysicalPbPortLookup& physical_pb_port_lookup,
+                                           const t_port* physical_pb_port,
+                                           const int& pin_number) {
+  if (physical_pb_port->parent_pb_type != physical_pb_graph_node->pb_type) {
+    return nullptr;
+  }
+  auto result = physical_pb_port_lookup.find(physical_pb_port);
+  if (result == physical_pb_port_lookup.end()) {
+    return nullptr;
+  }
+
+  const t_physical_pb_port_location& location = result->second;
+  t_pb_graph_pin* pins = nullptr;
+  int num_pins = 0;
+  if (PB_GRAPH_INPUT_PINS == location.pin_group) {
+    pins = physical_pb_graph_node->input_pins[location.iport];
+    num_pins = physical_pb_graph_node->num_input_pins[location.iport];
+  } else if (PB_GRAPH_OUTPUT_PINS == location.pin_group) {
+    pins = physical_pb_graph_node->output_pins[location.iport];
+    num_pins = physical_pb_graph_node->num_output_pins[location.iport];
+  } else {
+    VTR_ASSERT(PB_GRAPH_CLOCK_PINS == location.pin_group);
+    pins = physical_pb_graph_node->clock_pins[location.iport];
+    num_pins = physical_pb_graph_node->num_clock_pins[location.iport];
+  }
+
+  if ( (0 > pin_number) || (num_pins <= pin_number) ) {
+    return nullptr;
+  }
+  VTR_ASSERT_SAFE(physical_pb_port == pins[pin_number].port);
+  VTR_ASSERT_SAFE(pin_number == pins[pin_number].pin_number);
+  return &(pins[pin_number]);
+}
+
+/********************************************************************
+ * Find the physical pb_graph pin which is matched to an operating pb_graph_pin by
  *  - pb_type port annotation 
  *  - LSB/MSB and pin offset
+ * When several physical ports are matched, the one coming first in the
+ * pb_graph_node (inputs, outputs and then clocks) is taken
  *******************************************************************/
 static 
-bool try_match_pb_graph_pin(t_pb_graph_pin* operating_pb_graph_pin, 
-                            t_pb_graph_pin* physical_pb_graph_pin,
-                            const VprDeviceAnnotation& vpr_device_annotation) {
-  /* If the parent ports of the two pins are not paired, fail */
+t_pb_graph_pin* find_matched_physical_pb_graph_pin(t_pb_graph_pin* operating_pb_graph_pin, 
+                                                   t_pb_graph_node* physical_pb_graph_node, 
+                                                   const PhysicalPbPortLookup& physical_pb_port_lookup,
+                                                   const VprDeviceAnnotation& vpr_device_annotation) {
+  t_pb_graph_pin* matched_pin = nullptr;
+  t_physical_pb_port_location matched_location{NUM_PB_GRAPH_PIN_GROUPS, 0};
+
+  /* Only the ports paired with the parent port of the operating pin are considered */
   for (t_port* candidate_port : vpr_device_annotation.physical_pb_port(operating_pb_graph_pin->port)) {
-    if (physical_pb_graph_pin->port != candidate_port) {
-      /* Not the one we want, try the next candidate */
-      continue;
-    }
-    /* Check the pin number of physical pb_graph_pin matches the pin number of 
+    /* Find the pin number of physical pb_graph_pin which matches the pin number of 
      * operating pb_graph_pin plus a rotation offset with an initial offset, 
      * which is to align the lsb between operating and physical ports
      *
@@ -336,20 +434,32 @@ bool try_match_pb_graph_pin(t_pb_graph_pin* operating_pb_graph_pin,
     int acc_offset = vpr_device_annotation.physical_pb_pin_offset(operating_pb_graph_pin->port, candidate_port);
     int init_offset = vpr_device_annotation.physical_pb_pin_initial_offset(operating_pb_graph_pin->port, candidate_port);
     const BasicPort& physical_port_range = vpr_device_annotation.physical_pb_port_range(operating_pb_graph_pin->port, candidate_port);
-    if (physical_pb_graph_pin->pin_number != operating_pb_graph_pin->pin_number
-                                           + (int)physical_port_range.get_lsb() 
-                                           + init_offset
-                                           + acc_offset) {
+    int physical_pin_number = operating_pb_graph_pin->pin_number
+                            + (int)physical_port_range.get_lsb() 
+                            + init_offset
+                            + acc_offset;
+
+    t_pb_graph_pin* candidate_pin = find_physical_pb_graph_pin(physical_pb_graph_node,
+                                                               physical_pb_port_lookup,
+                                                               candidate_port,
+                                                               physical_pin_number);
+    if (nullptr == candidate_pin) {
       /* Not the one we want, try the next candidate */
       continue;
     }
 
-    /* Reach here, it means all the requirements have been met */
-    return true;
+    /* Keep the pin coming first in the pb_graph_node */
+    const t_physical_pb_port_location& candidate_location = physical_pb_port_lookup.at(candidate_port);
+    if ( (nullptr == matched_pin)
+      || (candidate_location.pin_group < matched_location.pin_group)
+      || ( (candidate_location.pin_group == matched_location.pin_group)
+        && (candidate_location.iport < matched_location.iport) ) ) {
+      matched_pin = candidate_pin;
+      matched_location = candidate_location;
+    }
   }
 
-  /* If we reach here, we failed */
-  return false;
+  return matched_pin;
 }
 
 /********************************************************************
@@ -378,69 +488,29 @@ void print_success_bind_pb_graph_pin(t_pb_graph_pin* operating_pb_graph_pin,
 static 
 void annotate_physical_pb_graph_pin(t_pb_graph_pin* operating_pb_graph_pin, 
                                     t_pb_graph_node* physical_pb_graph_node, 
+                                    const PhysicalPbPortLookup& physical_pb_port_lookup,
                                     VprDeviceAnnotation& vpr_device_annotation,
                                     const bool& verbose_output) {
-  /* Iterate over every port and pin of the operating pb_graph_node 
-   * and find the physical pins 
-   */
-  for (int iport = 0; iport < physical_pb_graph_node->num_input_ports; ++iport) {
-    for (int ipin = 0; ipin < physical_pb_graph_node->num_input_pins[iport]; ++ipin) {
-      if (false == try_match_pb_graph_pin(operating_pb_graph_pin, 
-                                          &(physical_pb_graph_node->input_pins[iport][ipin]),
-                                          vpr_device_annotation)) {
-        continue;
-      }
-      /* Reach here, it means the pins are matched by the annotation requirements 
-       * We can pair the pin and return  
-       */
-      vpr_device_annotation.add_physical_pb_graph_pin(operating_pb_graph_pin, &(physical_pb_graph_node->input_pins[iport][ipin]));
-      if (true == verbose_output) {
-        print_success_bind_pb_graph_pin(operating_pb_graph_pin, vpr_device_annotation.physical_pb_graph_pin(operating_pb_graph_pin)); 
-      }
-      return;
-    }
-  }
-
-  for (int iport = 0; iport < physical_pb_graph_node->num_output_ports; ++iport) {
-    for (int ipin = 0; ipin < physical_pb_graph_node->num_output_pins[iport]; ++ipin) {
-      if (false == try_match_pb_graph_pin(operating_pb_graph_pin, 
-                                          &(physical_pb_graph_node->output_pins[iport][ipin]),
-                                          vpr_device_annotation)) {
-        continue;
-      }
-      /* Reach here, it means the pins are matched by the annotation requirements 
-       * We can pair the pin and return  
-       */
-      vpr_device_annotation.add_physical_pb_graph_pin(operating_pb_graph_pin, &(physical_pb_graph_node->output_pins[iport][ipin]));
-      if (true == verbose_output) {
-        print_success_bind_pb_graph_pin(operating_pb_graph_pin, vpr_device_annotation.physical_pb_graph_pin(operating_pb_graph_pin)); 
-      }
-      return;
-    }
+  /* Pick the physical pin from the port look-up instead of searching all the pins */
+  t_pb_graph_pin* physical_pb_graph_pin = find_matched_physical_pb_graph_pin(operating_pb_graph_pin,
+                                                                             physical_pb_graph_node,
+                                                                             physical_pb_port_lookup,
+                                                                             const_cast<const VprDeviceAnnotation&>(vpr_device_annotation));
+  if (nullptr == physical_pb_graph_pin) {
+    /* If we reach here, it means that pin pairing fails, error out! */
+    VTR_LOG_ERROR("Fail to match a physical pin for '%s' from pb_graph_node '%s'!\n",
+                  operating_pb_graph_pin->to_string().c_str(),
+                  physical_pb_graph_node->hierarchical_type_name().c_str());
+    return;
   }
 
-  for (int iport = 0; iport < physical_pb_graph_node->num_clock_ports; ++iport) {
-    for (int ipin = 0; ipin < physical_pb_graph_node->num_clock_pins[iport]; ++ipin) {
-      if (false == try_match_pb_graph_pin(operating_pb_graph_pin, 
-                                          &(physical_pb_graph_node->clock_pins[iport][ipin]),
-                                          vpr_device_annotation)) {
-        continue;
-      }
-      /* Reach here, it means the pins are matched by the annotation requirements 
-       * We can pair the pin and return  
-       */
-      vpr_device_annotation.add_physical_pb_graph_pin(operating_pb_graph_pin, &(physical_pb_graph_node->clock_pins[iport][ipin]));
-      if (true == verbose_output) {
-        print_success_bind_pb_graph_pin(operating_pb_graph_pin, vpr_device_annotation.physical_pb_graph_pin(operating_pb_graph_pin)); 
-      }
-      return;
-    }
+  /* Reach here, it means the pins are matched by the annotation requirements 
+   * We can pair the pin and return  
+   */
+  vpr_device_annotation.add_physical_pb_graph_pin(operating_pb_graph_pin, physical_pb_graph_pin);
+  if (true == verbose_output) {
+    print_success_bind_pb_graph_pin(operating_pb_graph_pin, vpr_device_annotation.physical_pb_graph_pin(operating_pb_graph_pin)); 
   }
-
-  /* If we reach here, it means that pin pairing fails, error out! */
-  VTR_LOG_ERROR("Fail to match a physical pin for '%s' from pb_graph_node '%s'!\n",
-                operating_pb_graph_pin->to_string().c_str(),
-                physical_pb_graph_node->hierarchical_type_name().c_str());
 }
 
 /********************************************************************
@@ -452,32 +522,35 @@ void annotate_physical_pb_graph_pin(t_pb_graph_pin* operating_pb_graph_pin,
 static 
 void annotate_physical_pb_graph_node_pins(t_pb_graph_node* operating_pb_graph_node, 
                                           t_pb_graph_node* physical_pb_graph_node, 
+                                          PhysicalPbPortLookup& physical_pb_port_lookup,
                                           VprDeviceAnnotation& vpr_device_annotation,
                                           const bool& verbose_output) {
+  build_physical_pb_port_lookup(physical_pb_graph_node, physical_pb_port_lookup);
+
   /* Iterate over every port and pin of the operating pb_graph_node 
    * and find the physical pins 
    */
   for (int iport = 0; iport < operating_pb_graph_node->num_input_ports; ++iport) {
     for (int ipin = 0; ipin < operating_pb_graph_node->num_input_pins[iport]; ++ipin) {
       annotate_physical_pb_graph_pin(&(operating_pb_graph_node->input_pins[iport][ipin]),
-                                     physical_pb_graph_node, vpr_device_annotation,
-                                     verbose_output);
+                                     physical_pb_graph_node, physical_pb_port_lookup,
+                                     vpr_device_annotation, verbose_output);
     }
   }
 
   for (int iport = 0; iport < operating_pb_graph_node->num_output_ports; ++iport) {
     for (int ipin = 0; ipin < operating_pb_graph_node->num_output_pins[iport]; ++ipin) {
       annotate_physical_pb_graph_pin(&(operating_pb_graph_node->output_pins[iport][ipin]),
-                                     physical_pb_graph_node, vpr_device_annotation,
-                                     verbose_output);
+                                     physical_pb_graph_node, physical_pb_port_lookup,
+                                     vpr_device_annotation, verbose_output);
     }
   }
 
   for (int iport = 0; iport < operating_pb_graph_node->num_clock_ports; ++iport) {
     for (int ipin = 0; ipin < operating_pb_graph_node->num_clock_pins[iport]; ++ipin) {
       annotate_physical_pb_graph_pin(&(operating_pb_graph_node->clock_pins[iport][ipin]),
-                                     physical_pb_graph_node, vpr_device_annotation,
-                                     verbose_output);
+                                     physical_pb_graph_node, physical_pb_port_lookup,
+                                     vpr_device_annotation, verbose_output);
     }
   }
 }
@@ -492,6 +565,7 @@ void annotate_physical_pb_graph_node_pins(t_pb_graph_node* operating_pb_graph_no
  *******************************************************************/
 static 
 void rec_build_vpr_physical_pb_graph_node_annotation(t_pb_graph_node* pb_graph_node, 
+                                                     PhysicalPbPortLookup& physical_pb_port_lookup,
                                                      VprDeviceAnnotation& vpr_device_annotation,
                                                      const bool& verbose_output) {
   /* Go recursive first until we touch the primitive node */
@@ -501,6 +575,7 @@ void rec_build_vpr_physical_pb_graph_node_annotation(t_pb_graph_node* pb_graph_n
         /* Each child may exist multiple times in the hierarchy*/
         for (int jpb = 0; jpb < pb_graph_node->pb_type->modes[imode].pb_type_children[ipb].num_pb; ++jpb) {
           rec_build_vpr_physical_pb_graph_node_annotation(&(pb_graph_node->child_pb_graph_nodes[imode][ipb][jpb]), 
+                                                          physical_pb_port_lookup,
                                                           vpr_device_annotation,
                                                           verbose_output);
         }
@@ -539,7 +614,7 @@ void rec_build_vpr_physical_pb_graph_node_annotation(t_pb_graph_node* pb_graph_n
            physical_pb_graph_node->hierarchical_type_name().c_str());
 
   /* Try to bind each pins under this pb_graph_node to physical_pb_graph_node */
-  annotate_physical_pb_graph_node_pins(pb_graph_node, physical_pb_graph_node, vpr_device_annotation, verbose_output);
+  annotate_physical_pb_graph_node_pins(pb_graph_node, physical_pb_graph_node, physical_pb_port_lookup, vpr_device_annotation, verbose_output);
 }
 
 /********************************************************************
@@ -551,12 +626,15 @@ static
 void annotate_physical_pb_graph_node(const DeviceContext& vpr_device_ctx, 
                                      VprDeviceAnnotation& vpr_device_annotation,
                                      const bool& verbose_output) {
+  /* Locations of the ports of physical pb_types, shared by all the pb_graph_nodes */
+  PhysicalPbPortLookup physical_pb_port_lookup;
+
   for (const t_logical_block_type& lb_type : vpr_device_ctx.logical_block_types) {
     /* By pass nullptr for pb_graph head */
     if (nullptr == lb_type.pb_graph_head) {
       continue;
     }
-    rec_build_vpr_physical_pb_graph_node_annotation(lb_type.pb_graph_head, vpr_device_annotation, verbose_output); 
+    rec_build_vpr_physical_pb_graph_node_annotation(lb_type.pb_graph_head, physical_pb_port_lookup, vpr_device_annotation, verbose_output); 
   }
 }
 
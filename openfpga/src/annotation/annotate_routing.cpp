@@ -2,15 +2,194 @@
  * This file includes functions that are used to annotate routing results
  * from VPR to OpenFPGA
  *******************************************************************/
+#include <map>
+#include <unordered_map>
+#include <vector>
+
 /* Headers from vtrutil library */
 #include "vtr_assert.h"
 #include "vtr_log.h"
 
+/* Headers from openfpgautil library */
+#include "openfpga_parallel.h"
+#include "openfpga_side_manager.h"
+
+/* Headers from openfpgashell library */
+#include "command_exit_codes.h"
+
 #include "annotate_routing.h"
 
 /* begin namespace openfpga */
 namespace openfpga {
 
+/* A pin of a global port in tile annotation, which drives a pin of physical tiles */
+struct t_tile_pin_global_port {
+  TileGlobalPortId global_port;
+  size_t global_port_pin;
+  /* Coordinate of the tiles, where size_t(-1) means any */
+  vtr::Point<size_t> coordinate;
+};
+
+/* The global port pins driving each pin of physical tiles: [physical_tile][tile_pin] */
+typedef std::unordered_map<t_physical_tile_type_ptr, std::vector<std::vector<t_tile_pin_global_port>>> TilePinGlobalPortLookup;
+
+/********************************************************************
+ * Index the pins of physical tiles by the global ports driving them in tile annotation
+ * The pin indices follow the ones used when connecting the global ports
+ * in the top-level module, including all the sub tiles
+ *******************************************************************/
+static 
+TilePinGlobalPortLookup build_tile_pin_global_port_lookup(const DeviceContext& device_ctx,
+                                                          const TileAnnotation& tile_annotation) {
+  TilePinGlobalPortLookup lookup;
+
+  for (const TileGlobalPortId& global_port : tile_annotation.global_ports()) {
+    for (size_t tile_info_id = 0; tile_info_id < tile_annotation.global_port_tile_names(global_port).size(); ++tile_info_id) {
+      const std::string& tile_name = tile_annotation.global_port_tile_names(global_port)[tile_info_id];
+      const BasicPort& tile_port = tile_annotation.global_port_tile_ports(global_port)[tile_info_id];
+      const vtr::Point<size_t>& coordinate = tile_annotation.global_port_tile_coordinates(global_port)[tile_info_id];
+
+      for (const t_physical_tile_type& physical_tile : device_ctx.physical_tile_types) {
+        if (tile_name != std::string(physical_tile.name)) {
+          continue;
+        }
+        for (const t_physical_tile_port& physical_tile_port : physical_tile.ports) {
+          if (tile_port.get_name() != std::string(physical_tile_port.name)) {
+            continue;
+          }
+          std::vector<std::vector<t_tile_pin_global_port>>& pin_global_ports = lookup[&physical_tile];
+          pin_global_ports.resize(physical_tile.num_pins);
+          for (int iz = 0; iz < physical_tile.capacity; ++iz) {
+            for (size_t pin_id = 0; pin_id < size_t(physical_tile_port.num_pins); ++pin_id) {
+              int tile_pin = physical_tile_port.absolute_first_pin_index + iz * physical_tile.equivalent_sites[0]->pb_type->num_pins + pin_id;
+              VTR_ASSERT(tile_pin < physical_tile.num_pins);
+              pin_global_ports[tile_pin].push_back({global_port, pin_id, coordinate});
+            }
+          }
+        }
+      }
+    }
+  }
+
+  return lookup;
+}
+
+/********************************************************************
+ * Find the global port pin driving a pin of a physical tile at a given location
+ * Return nullptr if the pin is not driven by any global port
+ *******************************************************************/
+static 
+const t_tile_pin_global_port* find_tile_pin_global_port(const TilePinGlobalPortLookup& lookup,
+                                                        t_physical_tile_type_ptr physical_tile,
+                                                        const int& tile_pin,
+                                                        const vtr::Point<size_t>& tile_coordinate) {
+  auto result = lookup.find(physical_tile);
+  if (result == lookup.end()) {
+    return nullptr;
+  }
+  for (const t_tile_pin_global_port& pin_global_port : result->second[tile_pin]) {
+    if ( ((size_t(-1) == pin_global_port.coordinate.x()) || (tile_coordinate.x() == pin_global_port.coordinate.x()))
+      && ((size_t(-1) == pin_global_port.coordinate.y()) || (tile_coordinate.y() == pin_global_port.coordinate.y())) ) {
+      return &pin_global_port;
+    }
+  }
+  return nullptr;
+}
+
+/********************************************************************
+ * Assign the nets to the global ports defined in tile annotation,
+ * when all the sinks of a net are tile pins driven by the same global port pin.
+ * Such nets, e.g., clocks and resets, are delivered by the dedicated networks
+ * built for the global ports in the fabric, rather than the routing resources,
+ * and are not considered when annotating the routing results
+ *
+ * Each net visits its sinks only once, using a look-up on the pins of physical tiles
+ *
+ * Errors out if two nets are assigned to the same global port pin
+ *******************************************************************/
+int annotate_global_net_tile_ports(const DeviceContext& device_ctx,
+                                   const ClusteringContext& clustering_ctx,
+                                   const PlacementContext& placement_ctx,
+                                   const TileAnnotation& tile_annotation,
+                                   VprRoutingAnnotation& vpr_routing_annotation,
+                                   const bool& verbose) {
+  size_t counter = 0;
+  VTR_LOG("Assigning nets to global ports of tiles...");
+  VTR_LOGV(verbose, "\n");
+
+  TilePinGlobalPortLookup lookup = build_tile_pin_global_port_lookup(device_ctx, tile_annotation);
+  if (true == lookup.empty()) {
+    VTR_LOG("Done with %d nets assigned\n", counter);
+    return CMD_EXEC_SUCCESS;
+  }
+
+  /* The net assigned to each global port pin */
+  std::map<std::pair<TileGlobalPortId, size_t>, ClusterNetId> global_port_pin_nets;
+  int num_errors = 0;
+
+  for (const ClusterNetId& net_id : clustering_ctx.clb_nlist.nets()) {
+    const t_tile_pin_global_port* net_global_port = nullptr;
+    size_t num_global_sinks = 0;
+    size_t num_sinks = 0;
+    for (const ClusterPinId& sink_pin : clustering_ctx.clb_nlist.net_sinks(net_id)) {
+      ++num_sinks;
+      const t_pl_loc& loc = placement_ctx.block_locs[clustering_ctx.clb_nlist.pin_block(sink_pin)].loc;
+      vtr::Point<size_t> tile_coordinate(loc.x, loc.y);
+      const t_tile_pin_global_port* sink_global_port = find_tile_pin_global_port(lookup,
+                                                                                 device_ctx.grid[loc.x][loc.y].type,
+                                                                                 placement_ctx.physical_pins[sink_pin],
+                                                                                 tile_coordinate);
+      if (nullptr == sink_global_port) {
+        continue;
+      }
+      ++num_global_sinks;
+      if (nullptr == net_global_port) {
+        net_global_port = sink_global_port;
+      } else if ( (net_global_port->global_port != sink_global_port->global_port)
+               || (net_global_port->global_port_pin != sink_global_port->global_port_pin) ) {
+        /* Sinks on different global port pins can not be delivered by a single network */
+        net_global_port = nullptr;
+        break;
+      }
+    }
+
+    if (0 == num_global_sinks) {
+      continue;
+    }
+    if ( (nullptr == net_global_port) || (num_global_sinks != num_sinks) ) {
+      VTR_LOG_WARN("Net '%s' has sinks on global ports of tiles, but not all of its sinks are on the same pin of a global port! It is not assigned to any global port.\n",
+                   clustering_ctx.clb_nlist.net_name(net_id).c_str());
+      continue;
+    }
+
+    std::pair<TileGlobalPortId, size_t> global_port_pin(net_global_port->global_port, net_global_port->global_port_pin);
+    auto result = global_port_pin_nets.emplace(global_port_pin, net_id);
+    if (false == result.second) {
+      VTR_LOG_ERROR("Nets '%s' and '%s' are both assigned to global port '%s[%lu]' of tiles!\n",
+                    clustering_ctx.clb_nlist.net_name(result.first->second).c_str(),
+                    clustering_ctx.clb_nlist.net_name(net_id).c_str(),
+                    tile_annotation.global_port_name(global_port_pin.first).c_str(),
+                    global_port_pin.second);
+      num_errors++;
+      continue;
+    }
+
+    vpr_routing_annotation.set_net_global_port(net_id, global_port_pin.first, global_port_pin.second);
+    VTR_LOGV(verbose, "Assigned net '%s' to global port '%s[%lu]' of tiles\n",
+             clustering_ctx.clb_nlist.net_name(net_id).c_str(),
+             tile_annotation.global_port_name(global_port_pin.first).c_str(),
+             global_port_pin.second);
+    counter++;
+  }
+
+  VTR_LOG("Done with %d nets assigned\n", counter);
+
+  if (0 < num_errors) {
+    return CMD_EXEC_FATAL_ERROR;
+  }
+  return CMD_EXEC_SUCCESS;
+}
+
 /********************************************************************
  * Create a mapping between each rr_node and its mapped nets 
  * based on VPR routing results
@@ -34,16 +213,17 @@ void annotate_rr_node_nets(const DeviceContext& device_ctx,
     if (false == clustering_ctx.clb_nlist.net_sinks(net_id).size()) {
       continue;
     }
-    t_trace* tptr = routing_ctx.trace[net_id].head;
-    while (tptr != nullptr) {
-      RRNodeId rr_node = tptr->index;
+    /* Ignore nets delivered by the dedicated networks of global ports */
+    if (TileGlobalPortId::INVALID() != vpr_routing_annotation.net_global_port(net_id)) {
+      continue;
+    }
+    for (const RRNodeId& rr_node : routing_ctx.routed_net_nodes.net_nodes(net_id)) {
       /* Ignore source and sink nodes, they are the common node multiple starting and ending points */
       if ( (SOURCE != device_ctx.rr_graph.node_type(rr_node)) 
         && (SINK != device_ctx.rr_graph.node_type(rr_node)) ) {
         vpr_routing_annotation.set_rr_node_net(rr_node, net_id);
         counter++;
       }
-      tptr = tptr->next;
     }
   }
 
@@ -58,10 +238,14 @@ void annotate_rr_node_nets(const DeviceContext& device_ctx,
  * It requires a candidate which provided by upstream functions
  * Try to validate a candidate by searching it from driving node list
  * If not validated, try to find a right one in the routing traces
+ *
+ * The routing traces are given as the position of the first occurrence
+ * of each node in the traces, so that the search only visits 
+ * the driving nodes of the rr_node, instead of the whole traces
  *******************************************************************/
 static 
 RRNodeId find_previous_node_from_routing_traces(const RRGraph& rr_graph,
-                                                t_trace* routing_trace_head,
+                                                const std::unordered_map<RRNodeId, size_t>& routing_trace_positions,
                                                 const RRNodeId& prev_node_candidate,
                                                 const RRNodeId& cur_rr_node) {
   RRNodeId prev_node = prev_node_candidate;
@@ -91,54 +275,89 @@ RRNodeId find_previous_node_from_routing_traces(const RRGraph& rr_graph,
      *            |
      *            +-----+ rr_node
      *
-     * Our job now is to start from the head of the traces and find the prev_node 
-     * that drives this rr_node
+     * Our job now is to find the prev_node in the traces that drives this rr_node
      *
-     * This search will find the first-fit and finish.
+     * This search will find the first-fit in the traces, i.e., the driving
+     * node which appears the earliest in the traces
      * This is reasonable because if there is a second-fit, it should be a longer path
      * which should be considered in routing optimization
      */
-    if (false == valid_prev_node) {
-      t_trace* tptr = routing_trace_head;
-      while (tptr != nullptr) {
-        RRNodeId cand_prev_node = tptr->index;
-        bool is_good_cand = false;
-        for (const RREdgeId& in_edge : rr_graph.node_in_edges(cur_rr_node)) {
-          if (cand_prev_node == rr_graph.edge_src_node(in_edge)) {
-            is_good_cand = true;
-            break;
-          }
-        }
-  
-        if (true == is_good_cand) {
-          /* Update prev_node */
-          prev_node = cand_prev_node;
-          break;
-        }
-
-        /* Move on to the next */
-        tptr = tptr->next;
+    size_t first_position = routing_trace_positions.size();
+    for (const RREdgeId& in_edge : rr_graph.node_in_edges(cur_rr_node)) {
+      RRNodeId cand_prev_node = rr_graph.edge_src_node(in_edge);
+      auto result = routing_trace_positions.find(cand_prev_node);
+      if ( (result != routing_trace_positions.end())
+        && (result->second < first_position)) {
+        /* Update prev_node */
+        prev_node = cand_prev_node;
+        first_position = result->second;
       }
-    } 
+    }
   }
 
   return prev_node; 
 }
 
+/********************************************************************
+ * Find the previous node of each node in the routing traces of a net
+ * Return the pairs of (node, previous node), in the sequence of the traces
+ *******************************************************************/
+static 
+std::vector<std::pair<RRNodeId, RRNodeId>> find_net_previous_nodes(const RRGraph& rr_graph,
+                                                                   t_routed_net_nodes::node_range routing_traces) {
+  std::vector<std::pair<RRNodeId, RRNodeId>> prev_nodes;
+
+  /* Index the first occurrence of each node in the traces */
+  std::unordered_map<RRNodeId, size_t> routing_trace_positions;
+  routing_trace_positions.reserve(routing_traces.size());
+  size_t num_traces = 0;
+  for (const RRNodeId& rr_node : routing_traces) {
+    routing_trace_positions.emplace(rr_node, num_traces);
+    ++num_traces;
+  }
+
+  /* Cache Previous nodes */
+  RRNodeId prev_node = RRNodeId::INVALID();
+
+  for (const RRNodeId& rr_node : routing_traces) {
+    /* Find the right previous node */
+    prev_node = find_previous_node_from_routing_traces(rr_graph,
+                                                       routing_trace_positions,
+                                                       prev_node,
+                                                       rr_node);
+
+    /* Only update mapped nodes */
+    if (prev_node) {
+      prev_nodes.push_back(std::make_pair(rr_node, prev_node));
+    }
+
+    /* Update prev_node */
+    prev_node = rr_node;
+  }
+
+  return prev_nodes;
+}
+
 /********************************************************************
  * Create a mapping between each rr_node and its previous node
  * based on VPR routing results
  * - Unmapped rr_node will have an invalid id of previous rr_node
+ *
+ * The previous nodes of each net are found independently on multiple threads,
+ * while the annotation is updated net by net in the sequence of nets,
+ * so that the results are the same whatever number of threads is used
  *******************************************************************/
 void annotate_rr_node_previous_nodes(const DeviceContext& device_ctx,
                                      const ClusteringContext& clustering_ctx,
                                      const RoutingContext& routing_ctx,
                                      VprRoutingAnnotation& vpr_routing_annotation,
+                                     const size_t& num_threads,
                                      const bool& verbose) {
   size_t counter = 0;
   VTR_LOG("Annotating previous nodes for rr_node...");
   VTR_LOGV(verbose, "\n");
-   
+
+  std::vector<ClusterNetId> routed_nets;
   for (auto net_id : clustering_ctx.clb_nlist.nets()) {
     /* Ignore nets that are not routed */
     if (true == clustering_ctx.clb_nlist.net_is_ignored(net_id)) {
@@ -148,36 +367,82 @@ void annotate_rr_node_previous_nodes(const DeviceContext& device_ctx,
     if (false == clustering_ctx.clb_nlist.net_sinks(net_id).size()) {
       continue;
     }
-    
-    /* Cache Previous nodes */
-    RRNodeId prev_node = RRNodeId::INVALID();
+    /* Ignore nets delivered by the dedicated networks of global ports */
+    if (TileGlobalPortId::INVALID() != vpr_routing_annotation.net_global_port(net_id)) {
+      continue;
+    }
+    routed_nets.push_back(net_id);
+  }
 
-    t_trace* tptr = routing_ctx.trace[net_id].head;
-    while (tptr != nullptr) {
-      RRNodeId rr_node = tptr->index;
+  std::vector<std::vector<std::pair<RRNodeId, RRNodeId>>> net_prev_nodes(routed_nets.size());
+  parallel_for(routed_nets.size(), num_threads,
+               [&](const size_t& inet) {
+                 net_prev_nodes[inet] = find_net_previous_nodes(device_ctx.rr_graph,
+                                                                routing_ctx.routed_net_nodes.net_nodes(routed_nets[inet]));
+               });
 
-      /* Find the right previous node */
-      prev_node = find_previous_node_from_routing_traces(device_ctx.rr_graph,
-                                                         routing_ctx.trace[net_id].head,
-                                                         prev_node,
-                                                         rr_node);
+  for (const std::vector<std::pair<RRNodeId, RRNodeId>>& prev_nodes : net_prev_nodes) {
+    for (const std::pair<RRNodeId, RRNodeId>& prev_node : prev_nodes) {
+      vpr_routing_annotation.set_rr_node_prev_node(prev_node.first, prev_node.second);
+      counter++;
+    }
+  }
 
-      /* Only update mapped nodes */
-      if (prev_node) {
-        vpr_routing_annotation.set_rr_node_prev_node(rr_node, prev_node);
-        counter++;
-      }
+  VTR_LOG("Done with %d nodes mapping\n", counter);
+}
+
+/********************************************************************
+ * Count the nodes mapped to nets in each GSB, i.e., the channel nodes
+ * on all the sides and the input and output pins, which include the inputs
+ * and outputs of all the routing multiplexers of the GSB.
+ * A GSB without any used node can be skipped in O(1) by the tools
+ * looking for the mapped nets, e.g., the routing bitstream generator
+ *******************************************************************/
+void annotate_gsb_used_nodes(const DeviceRRGSB& device_rr_gsb,
+                             VprRoutingAnnotation& vpr_routing_annotation,
+                             const size_t& num_threads,
+                             const bool& verbose) {
+  VTR_LOG("Counting used nodes of each GSB...");
+  VTR_LOGV(verbose, "\n");
+
+  vtr::Point<size_t> gsb_range = device_rr_gsb.get_gsb_range();
+  vtr::Matrix<size_t> gsb_num_used_nodes({gsb_range.x(), gsb_range.y()}, 0);
 
-      /* Update prev_node */
-      prev_node = rr_node;
+  auto is_used_node = [&](const RRNodeId& node) {
+    return ClusterNetId::INVALID() != vpr_routing_annotation.rr_node_net(node);
+  };
 
-      /* Move on to the next */
-      tptr = tptr->next;
+  parallel_for(gsb_range.x() * gsb_range.y(), num_threads,
+               [&](const size_t& igsb) {
+                 size_t ix = igsb / gsb_range.y();
+                 size_t iy = igsb % gsb_range.y();
+                 const RRGSB& rr_gsb = device_rr_gsb.get_gsb(ix, iy);
+                 size_t num_used_nodes = 0;
+                 for (size_t side = 0; side < rr_gsb.get_num_sides(); ++side) {
+                   SideManager side_manager(side);
+                   for (size_t itrack = 0; itrack < rr_gsb.get_chan_width(side_manager.get_side()); ++itrack) {
+                     num_used_nodes += is_used_node(rr_gsb.get_chan_node(side_manager.get_side(), itrack));
+                   }
+                   for (size_t inode = 0; inode < rr_gsb.get_num_ipin_nodes(side_manager.get_side()); ++inode) {
+                     num_used_nodes += is_used_node(rr_gsb.get_ipin_node(side_manager.get_side(), inode));
+                   }
+                   for (size_t inode = 0; inode < rr_gsb.get_num_opin_nodes(side_manager.get_side()); ++inode) {
+                     num_used_nodes += is_used_node(rr_gsb.get_opin_node(side_manager.get_side(), inode));
+                   }
+                 }
+                 gsb_num_used_nodes[ix][iy] = num_used_nodes;
+               });
+
+  size_t num_unused_gsbs = 0;
+  for (size_t ix = 0; ix < gsb_range.x(); ++ix) {
+    for (size_t iy = 0; iy < gsb_range.y(); ++iy) {
+      num_unused_gsbs += (0 == gsb_num_used_nodes[ix][iy]);
     }
   }
+  vpr_routing_annotation.set_gsb_num_used_nodes(gsb_num_used_nodes);
 
-  VTR_LOG("Done with %d nodes mapping\n", counter);
+  VTR_LOG("Done with %lu out of %lu GSBs unused\n",
+          num_unused_gsbs, gsb_range.x() * gsb_range.y());
 }
 
 } /* end namespace openfpga */
-
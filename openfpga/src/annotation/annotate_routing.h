@@ -7,6 +7,8 @@
 #include "vpr_context.h"
 #include "openfpga_context.h"
 #include "vpr_routing_annotation.h"
+#include "tile_annotation.h"
+#include "device_rr_gsb.h"
 
 /********************************************************************
  * Function declaration
@@ -15,6 +17,13 @@
 /* begin namespace openfpga */
 namespace openfpga {
 
+int annotate_global_net_tile_ports(const DeviceContext& device_ctx,
+                                   const ClusteringContext& clustering_ctx,
+                                   const PlacementContext& placement_ctx,
+                                   const TileAnnotation& tile_annotation,
+                                   VprRoutingAnnotation& vpr_routing_annotation,
+                                   const bool& verbose);
+
 void annotate_rr_node_nets(const DeviceContext& device_ctx,
                            const ClusteringContext& clustering_ctx,
                            const RoutingContext& routing_ctx,
@@ -25,8 +34,14 @@ void annotate_rr_node_previous_nodes(const DeviceContext& device_ctx,
                                      const ClusteringContext& clustering_ctx,
                                      const RoutingContext& routing_ctx,
                                      VprRoutingAnnotation& vpr_routing_annotation,
+                                     const size_t& num_threads,
                                      const bool& verbose);
 
+void annotate_gsb_used_nodes(const DeviceRRGSB& device_rr_gsb,
+                             VprRoutingAnnotation& vpr_routing_annotation,
+                             const size_t& num_threads,
+                             const bool& verbose);
+
 } /* end namespace openfpga */
 
 #endif
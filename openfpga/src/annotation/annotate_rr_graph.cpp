@@ -9,6 +9,7 @@
 
 /* Headers from openfpgautil library */
 #include "openfpga_side_manager.h"
+#include "openfpga_parallel.h"
 
 /* Headers from vpr library */
 #include "rr_graph_obj_util.h"
@@ -252,7 +253,7 @@ RRGSB build_rr_gsb(const DeviceContext& vpr_device_ctx,
         }
       }
       /* Fill chan_rr_nodes */
-      rr_gsb.add_chan_node(side_manager.get_side(), rr_chan, rr_chan_dir);
+      rr_gsb.add_chan_node(side_manager.get_side(), std::move(rr_chan), std::move(rr_chan_dir));
     }
 
     /* Fill opin_rr_nodes */
@@ -400,9 +401,12 @@ RRGSB build_rr_gsb(const DeviceContext& vpr_device_ctx,
 /********************************************************************
  * Build the annotation for the routing resource graph
  * by collecting the nodes to the General Switch Block context
+ * Each GSB is built independently from the read-only device context,
+ * which is done in parallel when multiple threads are used
  *******************************************************************/
 void annotate_device_rr_gsb(const DeviceContext& vpr_device_ctx, 
                             DeviceRRGSB& device_rr_gsb,
+                            const size_t& num_threads,
                             const bool& verbose_output) {
 
   vtr::ScopedStartFinishTimer timer("Build General Switch Block(GSB) annotation on top of routing resource graph");
@@ -415,27 +419,32 @@ void annotate_device_rr_gsb(const DeviceContext& vpr_device_ctx,
            "Start annotation GSB up to [%lu][%lu]\n",
            gsb_range.x(), gsb_range.y());
 
-  size_t gsb_cnt = 0;
+  /* The fast node look-up is built lazily, which should be done before going parallel */
+  vpr_device_ctx.rr_graph.initialize_fast_node_lookup();
+
   /* For each switch block, determine the size of array */
-  for (size_t ix = 0; ix < gsb_range.x(); ++ix) {
-    for (size_t iy = 0; iy < gsb_range.y(); ++iy) {
-      /* Here we give the builder the fringe coordinates so that it can handle the GSBs at the borderside correctly
-       * sort drive_rr_nodes should be called if required by users
-       */
-      const RRGSB& rr_gsb = build_rr_gsb(vpr_device_ctx, 
-                                         vtr::Point<size_t>(vpr_device_ctx.grid.width() - 2, vpr_device_ctx.grid.height() - 2), 
-                                         vtr::Point<size_t>(ix, iy));
+  parallel_for(gsb_range.x() * gsb_range.y(), num_threads, [&](const size_t& igsb) {
+    size_t ix = igsb / gsb_range.y();
+    size_t iy = igsb % gsb_range.y();
+    /* Here we give the builder the fringe coordinates so that it can handle the GSBs at the borderside correctly
+     * sort drive_rr_nodes should be called if required by users
+     */
+    RRGSB rr_gsb = build_rr_gsb(vpr_device_ctx, 
+                                vtr::Point<size_t>(vpr_device_ctx.grid.width() - 2, vpr_device_ctx.grid.height() - 2), 
+                                vtr::Point<size_t>(ix, iy));
  
-      /* Add to device_rr_gsb */
-      vtr::Point<size_t> gsb_coordinate = rr_gsb.get_sb_coordinate();
-      device_rr_gsb.add_rr_gsb(gsb_coordinate, rr_gsb);
-      gsb_cnt++; /* Update counter */
-      /* Print info */
+    /* Add to device_rr_gsb, the array has been allocated so that each GSB has its own storage
+     * The GSB is moved so that its nodes are not copied
+     */
+    vtr::Point<size_t> gsb_coordinate = rr_gsb.get_sb_coordinate();
+    device_rr_gsb.add_rr_gsb(gsb_coordinate, std::move(rr_gsb));
+    /* Print info, only when GSBs are built in sequence */
+    if (1 >= num_threads) {
       VTR_LOG("[%lu%] Backannotated GSB[%lu][%lu]\r",
-              100 * gsb_cnt / (gsb_range.x() * gsb_range.y()), 
+              100 * (igsb + 1) / (gsb_range.x() * gsb_range.y()), 
               ix, iy);
     }
-  }
+  });
   /* Report number of unique mirrors */
   VTR_LOG("Backannotated %d General Switch Blocks (GSBs).\n",
           gsb_range.x() * gsb_range.y());
@@ -444,9 +453,11 @@ void annotate_device_rr_gsb(const DeviceContext& vpr_device_ctx,
 /********************************************************************
  * Sort all the incoming edges for each channel node which are
  * output ports of the GSB
+ * GSBs are sorted independently, in parallel when multiple threads are used
  *******************************************************************/
 void sort_device_rr_gsb_chan_node_in_edges(const RRGraph& rr_graph,
                                            DeviceRRGSB& device_rr_gsb,
+                                           const size_t& num_threads,
                                            const bool& verbose_output) {
   vtr::ScopedStartFinishTimer timer("Sort incoming edges for each routing track output node of General Switch Block(GSB)");
 
@@ -457,23 +468,21 @@ void sort_device_rr_gsb_chan_node_in_edges(const RRGraph& rr_graph,
            "Start sorting edges for GSBs up to [%lu][%lu]\n",
            gsb_range.x(), gsb_range.y());
 
-  size_t gsb_cnt = 0;
-
   /* For each switch block, determine the size of array */
-  for (size_t ix = 0; ix < gsb_range.x(); ++ix) {
-    for (size_t iy = 0; iy < gsb_range.y(); ++iy) {
-      vtr::Point<size_t> gsb_coordinate(ix, iy);
-      RRGSB& rr_gsb = device_rr_gsb.get_mutable_gsb(gsb_coordinate);
-      rr_gsb.sort_chan_node_in_edges(rr_graph);
-
-      gsb_cnt++; /* Update counter */
-
-      /* Print info */
+  parallel_for(gsb_range.x() * gsb_range.y(), num_threads, [&](const size_t& igsb) {
+    size_t ix = igsb / gsb_range.y();
+    size_t iy = igsb % gsb_range.y();
+    vtr::Point<size_t> gsb_coordinate(ix, iy);
+    RRGSB& rr_gsb = device_rr_gsb.get_mutable_gsb(gsb_coordinate);
+    rr_gsb.sort_chan_node_in_edges(rr_graph);
+
+    /* Print info, only when GSBs are sorted in sequence */
+    if (1 >= num_threads) {
       VTR_LOG("[%lu%] Sorted edges for GSB[%lu][%lu]\r",
-              100 * gsb_cnt / (gsb_range.x() * gsb_range.y()), 
+              100 * (igsb + 1) / (gsb_range.x() * gsb_range.y()), 
               ix, iy);
-    } 
-  }
+    }
+  });
 
   /* Report number of unique mirrors */
   VTR_LOG("Sorted edges for %d General Switch Blocks (GSBs).\n",
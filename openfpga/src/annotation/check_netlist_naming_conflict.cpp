@@ -3,6 +3,8 @@
  * in the users' BLIF netlist that violates the syntax of OpenFPGA
  * fabric generator, i.e., Verilog generator and SPICE generator
  *******************************************************************/
+#include <array>
+#include <cstdlib>
 #include <string>
 #include <fstream>
 
@@ -13,12 +15,14 @@
 
 /* Headers from openfpgashell library */
 #include "command_exit_codes.h"
+#include "command_threads.h"
 
 /* Headers from archopenfpga library */
 #include "write_xml_utils.h" 
 
 /* Headers from openfpgautil library */
 #include "openfpga_digest.h"
+#include "openfpga_parallel.h"
 
 #include "check_netlist_naming_conflict.h"
 
@@ -28,20 +32,74 @@
 /* begin namespace openfpga */
 namespace openfpga {
 
+/********************************************************************
+ * A look-up table over all the characters, which marks the sensitive
+ * characters and their fix-up characters.
+ * A name is then checked and fixed in a single pass over its characters,
+ * rather than searching each sensitive character in the name
+ *******************************************************************/
+struct SensitiveCharTable {
+  std::string sensitive_chars;
+  std::array<bool, 256> is_sensitive;
+  std::array<char, 256> fix_chars;
+};
+
+static 
+SensitiveCharTable build_sensitive_char_table(const std::string& sensitive_chars, 
+                                              const std::string& fix_chars) {
+  VTR_ASSERT(sensitive_chars.length() == fix_chars.length());
+
+  SensitiveCharTable char_table;
+  char_table.sensitive_chars = sensitive_chars;
+  char_table.is_sensitive.fill(false);
+  for (size_t ichar = 0; ichar < char_table.fix_chars.size(); ++ichar) {
+    char_table.fix_chars[ichar] = char(ichar);
+  }
+
+  for (size_t ichar = 0; ichar < sensitive_chars.length(); ++ichar) {
+    unsigned char sensitive_char = static_cast<unsigned char>(sensitive_chars[ichar]);
+    /* The first fix-up takes effect if a character is listed more than once */
+    if (true == char_table.is_sensitive[sensitive_char]) {
+      continue;
+    }
+    char_table.is_sensitive[sensitive_char] = true;
+    char_table.fix_chars[sensitive_char] = fix_chars[ichar];
+  }
+
+  return char_table;
+}
+
 /********************************************************************
  * This function aims to check if the name contains any of the 
  * sensitive characters in the list
  * Return a string of sensitive characters which are contained
- * in the name
+ * in the name, in the sequence of the list
  *******************************************************************/
 static 
 std::string name_contain_sensitive_chars(const std::string& name, 
-                                         const std::string& sensitive_chars) {
+                                         const SensitiveCharTable& char_table) {
   std::string violation;
 
-  for (const char& sensitive_char : sensitive_chars) {
-    /* Return true since we find a characters */
-    if (std::string::npos != name.find(sensitive_char)) {
+  /* Find which characters are in the name, which is done only when the name is illegal */
+  std::array<bool, 256> contained_chars;
+  bool found = false;
+  for (const char& name_char : name) {
+    if (false == char_table.is_sensitive[static_cast<unsigned char>(name_char)]) {
+      continue;
+    }
+    if (false == found) {
+      contained_chars.fill(false);
+      found = true;
+    }
+    contained_chars[static_cast<unsigned char>(name_char)] = true;
+  }
+
+  if (false == found) {
+    return violation;
+  }
+
+  for (const char& sensitive_char : char_table.sensitive_chars) {
+    if (true == contained_chars[static_cast<unsigned char>(sensitive_char)]) {
       violation.push_back(sensitive_char);
     }
   }
@@ -56,19 +114,11 @@ std::string name_contain_sensitive_chars(const std::string& name,
  *******************************************************************/
 static 
 std::string fix_name_contain_sensitive_chars(const std::string& name, 
-                                             const std::string& sensitive_chars,
-                                             const std::string& fix_chars) {
+                                             const SensitiveCharTable& char_table) {
   std::string fixed_name = name;
 
-  VTR_ASSERT(sensitive_chars.length() == fix_chars.length());
-
-  for (size_t ichar = 0; ichar < sensitive_chars.length(); ++ichar) {
-    /* Keep fixing the characters until we cannot find anymore */
-    std::string::size_type pos = 0u;
-    while (std::string::npos != (pos = fixed_name.find(sensitive_chars[ichar], pos))) {
-      fixed_name.replace(pos, 1, std::string(1, fix_chars[ichar]));
-      pos += 1;
-    }
+  for (char& name_char : fixed_name) {
+    name_char = char_table.fix_chars[static_cast<unsigned char>(name_char)];
   }
 
   return fixed_name;
@@ -81,33 +131,42 @@ std::string fix_name_contain_sensitive_chars(const std::string& name,
  *   any sensitive character
  * - Iterate over all the nets and see if any net name contain 
  *   any sensitive character
+ *
+ * The names are checked on multiple threads, while the conflicts are
+ * reported in the sequence of the netlist, so that the outputs are
+ * the same whatever number of threads is used
  *******************************************************************/
 static 
 size_t detect_netlist_naming_conflict(const AtomNetlist& atom_netlist,
-                                    const std::string& sensitive_chars) {
+                                      const SensitiveCharTable& char_table,
+                                      const size_t& num_threads) {
   size_t num_conflicts = 0;
 
   /* Walk through blocks in the netlist */
-  for (const auto& block : atom_netlist.blocks()) {
-    const std::string& block_name = atom_netlist.block_name(block);
-    const std::string& violation = name_contain_sensitive_chars(block_name, sensitive_chars);
-    if (false == violation.empty()) {
-      VTR_LOG("Block '%s' contains illegal characters '%s'\n",
-              block_name.c_str(), violation.c_str());
-      num_conflicts++;
-    }
-  }
+  parallel_map_reduce<std::string>(atom_netlist.blocks(), num_threads,
+    [&](const AtomBlockId& blk, std::string& violation) {
+      violation = name_contain_sensitive_chars(atom_netlist.block_name(blk), char_table);
+    },
+    [&](const AtomBlockId& blk, std::string& violation) {
+      if (false == violation.empty()) {
+        VTR_LOG("Block '%s' contains illegal characters '%s'\n",
+                atom_netlist.block_name(blk).c_str(), violation.c_str());
+        num_conflicts++;
+      }
+    });
 
   /* Walk through nets in the netlist */
-  for (const auto& net : atom_netlist.nets()) {
-    const std::string& net_name = atom_netlist.net_name(net);
-    const std::string& violation = name_contain_sensitive_chars(net_name, sensitive_chars);
-    if (false == violation.empty()) {
-      VTR_LOG("Net '%s' contains illegal characters '%s'\n",
-              net_name.c_str(), violation.c_str());
-      num_conflicts++;
-    }
-  }
+  parallel_map_reduce<std::string>(atom_netlist.nets(), num_threads,
+    [&](const AtomNetId& net, std::string& violation) {
+      violation = name_contain_sensitive_chars(atom_netlist.net_name(net), char_table);
+    },
+    [&](const AtomNetId& net, std::string& violation) {
+      if (false == violation.empty()) {
+        VTR_LOG("Net '%s' contains illegal characters '%s'\n",
+                atom_netlist.net_name(net).c_str(), violation.c_str());
+        num_conflicts++;
+      }
+    });
 
   return num_conflicts;
 } 
@@ -119,36 +178,50 @@ size_t detect_netlist_naming_conflict(const AtomNetlist& atom_netlist,
  *   any sensitive character
  * - Iterate over all the nets and correct any net name that contains
  *   any sensitive character
+ *
+ * The fixed names are found on multiple threads, while they are applied
+ * to the annotation in the sequence of the netlist
  *******************************************************************/
 static 
 void fix_netlist_naming_conflict(const AtomNetlist& atom_netlist,
-                                 const std::string& sensitive_chars,
-                                 const std::string& fix_chars,
+                                 const SensitiveCharTable& char_table,
+                                 const size_t& num_threads,
                                  VprNetlistAnnotation& vpr_netlist_annotation) {
   size_t num_fixes = 0;
 
-  /* Walk through blocks in the netlist */
-  for (const auto& block : atom_netlist.blocks()) {
-    const std::string& block_name = atom_netlist.block_name(block);
-    const std::string& violation = name_contain_sensitive_chars(block_name, sensitive_chars);
-
-    if (false == violation.empty()) {
-      /* Apply fix-up here */
-      vpr_netlist_annotation.rename_block(block, fix_name_contain_sensitive_chars(block_name, sensitive_chars, fix_chars)); 
-      num_fixes++;
-    }
-  }
+  /* Walk through blocks in the netlist
+   * Names are empty for the blocks which do not require any fix-up
+   */
+  parallel_map_reduce<std::string>(atom_netlist.blocks(), num_threads,
+    [&](const AtomBlockId& blk, std::string& fixed_block_name) {
+      const std::string& block_name = atom_netlist.block_name(blk);
+      if (false == name_contain_sensitive_chars(block_name, char_table).empty()) {
+        fixed_block_name = fix_name_contain_sensitive_chars(block_name, char_table);
+      }
+    },
+    [&](const AtomBlockId& blk, std::string& fixed_block_name) {
+      if (false == fixed_block_name.empty()) {
+        /* Apply fix-up here */
+        vpr_netlist_annotation.rename_block(blk, fixed_block_name); 
+        num_fixes++;
+      }
+    });
 
   /* Walk through nets in the netlist */
-  for (const auto& net : atom_netlist.nets()) {
-    const std::string& net_name = atom_netlist.net_name(net);
-    const std::string& violation = name_contain_sensitive_chars(net_name, sensitive_chars);
-    if (false == violation.empty()) {
-      /* Apply fix-up here */
-      vpr_netlist_annotation.rename_net(net, fix_name_contain_sensitive_chars(net_name, sensitive_chars, fix_chars)); 
-      num_fixes++;
-    }
-  }
+  parallel_map_reduce<std::string>(atom_netlist.nets(), num_threads,
+    [&](const AtomNetId& net, std::string& fixed_net_name) {
+      const std::string& net_name = atom_netlist.net_name(net);
+      if (false == name_contain_sensitive_chars(net_name, char_table).empty()) {
+        fixed_net_name = fix_name_contain_sensitive_chars(net_name, char_table);
+      }
+    },
+    [&](const AtomNetId& net, std::string& fixed_net_name) {
+      if (false == fixed_net_name.empty()) {
+        /* Apply fix-up here */
+        vpr_netlist_annotation.rename_net(net, fixed_net_name); 
+        num_fixes++;
+      }
+    });
 
   if (0 < num_fixes) {
     VTR_LOG("Fixed %ld naming conflicts in the netlist.\n",
@@ -225,10 +298,19 @@ int check_netlist_naming_conflict(OpenfpgaContext& openfpga_context,
   const std::string&       fix_chars("____________________________");
 
   CommandOptionId opt_fix = cmd.option("fix");
+  CommandOptionId opt_threads = cmd.option("threads");
+
+  /* Use the default number of threads of the shell unless specified */
+  size_t num_threads = 1;
+  if (false == find_command_num_threads(cmd, cmd_context, opt_threads, num_threads)) {
+    return CMD_EXEC_FATAL_ERROR;
+  }
+
+  SensitiveCharTable char_table = build_sensitive_char_table(sensitive_chars, fix_chars);
 
   /* Do the main job first: detect any naming in the BLIF netlist that violates the syntax */
   if (false == cmd_context.option_enable(cmd, opt_fix)) {
-    size_t num_conflicts = detect_netlist_naming_conflict(g_vpr_ctx.atom().nlist, sensitive_chars); 
+    size_t num_conflicts = detect_netlist_naming_conflict(g_vpr_ctx.atom().nlist, char_table, num_threads); 
     VTR_LOGV_ERROR((0 < num_conflicts && (false == cmd_context.option_enable(cmd, opt_fix))),
                   "Found %ld naming conflicts in the netlist. Please correct so as to use any fabric generators.\n",
                   num_conflicts);
@@ -247,8 +329,8 @@ int check_netlist_naming_conflict(OpenfpgaContext& openfpga_context,
 
   /* If the auto correction is enabled, we apply a fix */
   if (true == cmd_context.option_enable(cmd, opt_fix)) {
-    fix_netlist_naming_conflict(g_vpr_ctx.atom().nlist, sensitive_chars,
-                                fix_chars, openfpga_context.mutable_vpr_netlist_annotation());
+    fix_netlist_naming_conflict(g_vpr_ctx.atom().nlist, char_table,
+                                num_threads, openfpga_context.mutable_vpr_netlist_annotation());
 
     CommandOptionId opt_report = cmd.option("report");
     if (true == cmd_context.option_enable(cmd, opt_report)) {
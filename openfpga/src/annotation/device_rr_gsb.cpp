@@ -1,8 +1,16 @@
 /************************************************************************
  * Member functions for class DeviceRRGSB
  ***********************************************************************/
+#include <unordered_map>
+
 #include "vtr_log.h"
 #include "vtr_assert.h"
+
+/* Headers from openfpgautil library */
+#include "openfpga_side_manager.h"
+#include "openfpga_parallel.h"
+#include "openfpga_memory_usage.h"
+
 #include "device_rr_gsb.h"
 
 /* namespace openfpga begins */
@@ -136,6 +144,18 @@ const RRGSB& DeviceRRGSB::get_sb_unique_module(const vtr::Point<size_t>& coordin
   return get_sb_unique_module(sb_unique_module_id);
 } 
 
+size_t DeviceRRGSB::memory_usage() const {
+  return openfpga::memory_usage(rr_gsb_)
+       + openfpga::memory_usage(gsb_unique_module_id_)
+       + openfpga::memory_usage(gsb_unique_module_)
+       + openfpga::memory_usage(sb_unique_module_id_)
+       + openfpga::memory_usage(sb_unique_module_)
+       + openfpga::memory_usage(cbx_unique_module_id_)
+       + openfpga::memory_usage(cbx_unique_module_)
+       + openfpga::memory_usage(cby_unique_module_id_)
+       + openfpga::memory_usage(cby_unique_module_);
+}
+
 /************************************************************************
  * Public mutators
  ***********************************************************************/
@@ -193,6 +213,16 @@ void DeviceRRGSB::add_rr_gsb(const vtr::Point<size_t>& coordinate,
   rr_gsb_[coordinate.x()][coordinate.y()] = rr_gsb; 
 }
 
+/* Move a switch block to the array, which takes over the storage of the switch block being built */
+void DeviceRRGSB::add_rr_gsb(const vtr::Point<size_t>& coordinate, 
+                             RRGSB&& rr_gsb) {
+  /* Resize upon needs*/
+  resize_upon_need(coordinate);
+
+  /* Add the switch block into array */
+  rr_gsb_[coordinate.x()][coordinate.y()] = std::move(rr_gsb); 
+}
+
 /* Get a rr switch block in the array with a coordinate */
 RRGSB& DeviceRRGSB::get_mutable_gsb(const vtr::Point<size_t>& coordinate) {
   VTR_ASSERT(validate_coordinate(coordinate));
@@ -206,73 +236,143 @@ RRGSB& DeviceRRGSB::get_mutable_gsb(const size_t& x, const size_t& y) {
 }
 
 /* Add a switch block to the array, which will automatically identify and update the lists of unique mirrors and rotatable mirrors */
-void DeviceRRGSB::build_cb_unique_module(const RRGraph& rr_graph, const t_rr_type& cb_type) {
-  /* Make sure a clean start */
-  clear_cb_unique_module(cb_type);
-
+std::vector<vtr::Point<size_t>> DeviceRRGSB::get_gsb_coordinates() const {
+  std::vector<vtr::Point<size_t>> gsb_coordinates;
   for (size_t ix = 0; ix < rr_gsb_.size(); ++ix) {
     for (size_t iy = 0; iy < rr_gsb_[ix].size(); ++iy) {
-      bool is_unique_module = true;
-      vtr::Point<size_t> gsb_coordinate(ix, iy);
+      gsb_coordinates.push_back(vtr::Point<size_t>(ix, iy));
+    }
+  }
+  return gsb_coordinates;
+}
 
-      /* Bypass non-exist CB */
-      if ( false == rr_gsb_[ix][iy].is_cb_exist(cb_type) ) {
-        continue;
-      }
+void DeviceRRGSB::build_cb_unique_module(const RRGraph& rr_graph, const t_rr_type& cb_type, const size_t& num_threads) {
+  /* Make sure a clean start */
+  clear_cb_unique_module(cb_type);
 
-      /* Traverse the unique_mirror list and check it is an mirror of another */
-      for (size_t id = 0; id < get_num_cb_unique_module(cb_type); ++id) {
-        const RRGSB& unique_module = get_cb_unique_module(cb_type, id);
-        if (true == rr_gsb_[ix][iy].is_cb_mirror(rr_graph, unique_module, cb_type)) {
-          /* This is a mirror, raise the flag and we finish */
-          is_unique_module = false;
-          /* Record the id of unique mirror */
-          set_cb_unique_module_id(cb_type, gsb_coordinate, id); 
-          break;
-        }
-      }
-      /* Add to list if this is a unique mirror*/
-      if (true == is_unique_module) {
-        add_cb_unique_module(cb_type, gsb_coordinate);
+  /* Compute the fingerprints of all the CBs, which are independent from each other */
+  std::vector<vtr::Point<size_t>> gsb_coordinates = get_gsb_coordinates();
+  std::vector<size_t> fingerprints(gsb_coordinates.size(), 0);
+  parallel_for(gsb_coordinates.size(), num_threads,
+               [&](const size_t& igsb) {
+                 const RRGSB& rr_gsb = rr_gsb_[gsb_coordinates[igsb].x()][gsb_coordinates[igsb].y()];
+                 if (true == rr_gsb.is_cb_exist(cb_type)) {
+                   fingerprints[igsb] = rr_gsb.get_cb_fingerprint(rr_graph, cb_type);
+                 }
+               });
+
+  /* Unique modules grouped by fingerprints, in the sequence of their ids.
+   * A mirror always has the same fingerprint as its unique module,
+   * so we only need to check the unique modules in the same bucket
+   */
+  std::unordered_map<size_t, std::vector<size_t>> unique_module_buckets;
+
+  for (size_t igsb = 0; igsb < gsb_coordinates.size(); ++igsb) {
+    const vtr::Point<size_t>& gsb_coordinate = gsb_coordinates[igsb];
+    const RRGSB& rr_gsb = rr_gsb_[gsb_coordinate.x()][gsb_coordinate.y()];
+    bool is_unique_module = true;
+
+    /* Bypass non-exist CB */
+    if ( false == rr_gsb.is_cb_exist(cb_type) ) {
+      continue;
+    }
+
+    /* Traverse the unique_mirror list and check it is an mirror of another */
+    std::vector<size_t>& bucket = unique_module_buckets[fingerprints[igsb]];
+    for (const size_t& id : bucket) {
+      const RRGSB& unique_module = get_cb_unique_module(cb_type, id);
+      if (true == rr_gsb.is_cb_mirror(rr_graph, unique_module, cb_type)) {
+        /* This is a mirror, raise the flag and we finish */
+        is_unique_module = false;
         /* Record the id of unique mirror */
-        set_cb_unique_module_id(cb_type, gsb_coordinate, get_num_cb_unique_module(cb_type) - 1); 
+        set_cb_unique_module_id(cb_type, gsb_coordinate, id); 
+        break;
       }
     }
+    /* Add to list if this is a unique mirror*/
+    if (true == is_unique_module) {
+      add_cb_unique_module(cb_type, gsb_coordinate);
+      /* Record the id of unique mirror */
+      set_cb_unique_module_id(cb_type, gsb_coordinate, get_num_cb_unique_module(cb_type) - 1); 
+      bucket.push_back(get_num_cb_unique_module(cb_type) - 1);
+    }
   } 
 }
 
 /* Add a switch block to the array, which will automatically identify and update the lists of unique mirrors and rotatable mirrors */
-void DeviceRRGSB::build_sb_unique_module(const RRGraph& rr_graph) {
+void DeviceRRGSB::build_sb_unique_module(const RRGraph& rr_graph, const size_t& num_threads) {
   /* Make sure a clean start */
   clear_sb_unique_module();
 
-  /* Build the unique module */
-  for (size_t ix = 0; ix < rr_gsb_.size(); ++ix) {
-    for (size_t iy = 0; iy < rr_gsb_[ix].size(); ++iy) {
-      bool is_unique_module = true;
-      vtr::Point<size_t> sb_coordinate(ix, iy);
-
-      /* Traverse the unique_mirror list and check it is an mirror of another */
-      for (size_t id = 0; id < get_num_sb_unique_module(); ++id) {
-        /* Check if the two modules have the same submodules,
-         * if so, these two modules are the same, indicating the sb is not unique.
-         * else the sb is unique 
-         */
-        const RRGSB& unique_module = get_sb_unique_module(id);
-        if (true == rr_gsb_[ix][iy].is_sb_mirror(rr_graph, unique_module)) {
-          /* This is a mirror, raise the flag and we finish */
-          is_unique_module = false;
-          /* Record the id of unique mirror */
-          sb_unique_module_id_[ix][iy] = id; 
-          break;
-        }
+  /* A fingerprint is only meaningful when all the sides of a SB have tracks.
+   * Otherwise, the SB has to be compared with all the unique modules
+   */
+  std::vector<vtr::Point<size_t>> gsb_coordinates = get_gsb_coordinates();
+  std::vector<size_t> fingerprints(gsb_coordinates.size(), 0);
+  std::vector<bool> fingerprint_valid(gsb_coordinates.size(), false);
+  for (size_t igsb = 0; igsb < gsb_coordinates.size(); ++igsb) {
+    const RRGSB& rr_gsb = rr_gsb_[gsb_coordinates[igsb].x()][gsb_coordinates[igsb].y()];
+    bool all_sides_have_tracks = true;
+    for (size_t side = 0; side < rr_gsb.get_num_sides(); ++side) {
+      SideManager side_manager(side);
+      if (0 == rr_gsb.get_chan_width(side_manager.get_side())) {
+        all_sides_have_tracks = false;
+        break;
       }
+    }
+    fingerprint_valid[igsb] = all_sides_have_tracks;
+  }
 
-      /* Add to list if this is a unique mirror*/
-      if (true == is_unique_module) {
-        sb_unique_module_.push_back(sb_coordinate);
+  /* Compute the fingerprints of all the SBs, which are independent from each other */
+  parallel_for(gsb_coordinates.size(), num_threads,
+               [&](const size_t& igsb) {
+                 if (true == fingerprint_valid[igsb]) {
+                   const RRGSB& rr_gsb = rr_gsb_[gsb_coordinates[igsb].x()][gsb_coordinates[igsb].y()];
+                   fingerprints[igsb] = rr_gsb.get_sb_fingerprint(rr_graph);
+                 }
+               });
+
+  /* Unique modules grouped by fingerprints, in the sequence of their ids.
+   * A SB whose sides all have tracks can only be a mirror of a unique module
+   * with the same fingerprint, so we only need to check the unique modules in the same bucket
+   */
+  std::unordered_map<size_t, std::vector<size_t>> unique_module_buckets;
+  std::vector<size_t> all_unique_module_ids;
+
+  /* Build the unique module */
+  for (size_t igsb = 0; igsb < gsb_coordinates.size(); ++igsb) {
+    const vtr::Point<size_t>& sb_coordinate = gsb_coordinates[igsb];
+    const RRGSB& rr_gsb = rr_gsb_[sb_coordinate.x()][sb_coordinate.y()];
+    bool is_unique_module = true;
+
+    const std::vector<size_t>& candidate_ids = (true == fingerprint_valid[igsb])
+                                             ? unique_module_buckets[fingerprints[igsb]]
+                                             : all_unique_module_ids;
+
+    /* Traverse the unique_mirror list and check it is an mirror of another */
+    for (const size_t& id : candidate_ids) {
+      /* Check if the two modules have the same submodules,
+       * if so, these two modules are the same, indicating the sb is not unique.
+       * else the sb is unique 
+       */
+      const RRGSB& unique_module = get_sb_unique_module(id);
+      if (true == rr_gsb.is_sb_mirror(rr_graph, unique_module)) {
+        /* This is a mirror, raise the flag and we finish */
+        is_unique_module = false;
         /* Record the id of unique mirror */
-        sb_unique_module_id_[ix][iy] = sb_unique_module_.size() - 1; 
+        sb_unique_module_id_[sb_coordinate.x()][sb_coordinate.y()] = id; 
+        break;
+      }
+    }
+
+    /* Add to list if this is a unique mirror*/
+    if (true == is_unique_module) {
+      sb_unique_module_.push_back(sb_coordinate);
+      /* Record the id of unique mirror */
+      sb_unique_module_id_[sb_coordinate.x()][sb_coordinate.y()] = sb_unique_module_.size() - 1; 
+      all_unique_module_ids.push_back(sb_unique_module_.size() - 1);
+      if (true == fingerprint_valid[igsb]) {
+        unique_module_buckets[fingerprints[igsb]].push_back(sb_unique_module_.size() - 1);
       }
     }
   } 
@@ -316,15 +416,28 @@ void DeviceRRGSB::build_gsb_unique_module() {
   } 
 }
 
-void DeviceRRGSB::build_unique_module(const RRGraph& rr_graph) {
-  build_sb_unique_module(rr_graph);
+void DeviceRRGSB::build_unique_module(const RRGraph& rr_graph, const size_t& num_threads) {
+  build_sb_unique_module(rr_graph, num_threads);
 
-  build_cb_unique_module(rr_graph, CHANX);
-  build_cb_unique_module(rr_graph, CHANY);
+  build_cb_unique_module(rr_graph, CHANX, num_threads);
+  build_cb_unique_module(rr_graph, CHANY, num_threads);
 
   build_gsb_unique_module();
 }
 
+/* Resolve the drivers of the routing multiplexers once for all the GSBs,
+ * so that the builders of modules and bitstreams, as well as the writers,
+ * share the same sequence of multiplexer inputs.
+ * GSBs are independent from each other, so they are resolved in parallel
+ */
+void DeviceRRGSB::build_mux_drivers(const RRGraph& rr_graph, const size_t& num_threads) {
+  std::vector<vtr::Point<size_t>> gsb_coordinates = get_gsb_coordinates();
+  parallel_for(gsb_coordinates.size(), num_threads,
+               [&](const size_t& igsb) {
+                 rr_gsb_[gsb_coordinates[igsb].x()][gsb_coordinates[igsb].y()].build_mux_drivers(rr_graph);
+               });
+}
+
 void DeviceRRGSB::add_gsb_unique_module(const vtr::Point<size_t>& coordinate) {
   gsb_unique_module_.push_back(coordinate); 
 }
@@ -382,6 +495,17 @@ void DeviceRRGSB::clear() {
   clear_sb_unique_module_id();
 }
 
+/* Release the sorted incoming edges of all the GSBs,
+ * which are only required by the builders of routing modules and bitstreams
+ */
+void DeviceRRGSB::clear_chan_node_in_edges() { 
+  for (size_t x = 0; x < rr_gsb_.size(); ++x) {
+    for (size_t y = 0; y < rr_gsb_[x].size(); ++y) {
+      rr_gsb_[x][y].clear_chan_node_in_edges(); 
+    }
+  }
+}
+
 void DeviceRRGSB::clear_gsb() {
   /* clean gsb array */
   for (size_t x = 0; x < rr_gsb_.size(); ++x) {
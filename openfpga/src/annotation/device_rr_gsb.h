@@ -38,15 +38,19 @@ class DeviceRRGSB {
     const RRGSB& get_cb_unique_module(const t_rr_type& cb_type, const vtr::Point<size_t>& coordinate) const;
     size_t get_num_cb_unique_module(const t_rr_type& cb_type) const; /* get the number of unique mirrors of CBs */
     bool is_gsb_exist(const vtr::Point<size_t> coord) const;
+    size_t memory_usage() const; /* Estimate the heap memory (in bytes) held by the GSBs and their unique mirrors */
   public: /* Mutators */ 
     void reserve(const vtr::Point<size_t>& coordinate); /* Pre-allocate the rr_switch_block array that the device requires */ 
     void reserve_sb_unique_submodule_id(const vtr::Point<size_t>& coordinate); /* Pre-allocate the rr_sb_unique_module_id matrix that the device requires */ 
     void resize_upon_need(const vtr::Point<size_t>& coordinate); /* Resize the rr_switch_block array if needed */ 
     void add_rr_gsb(const vtr::Point<size_t>& coordinate, const RRGSB& rr_gsb); /* Add a switch block to the array, which will automatically identify and update the lists of unique mirrors and rotatable mirrors */
+    void add_rr_gsb(const vtr::Point<size_t>& coordinate, RRGSB&& rr_gsb); /* Move a switch block to the array, without copying its nodes */
     RRGSB& get_mutable_gsb(const vtr::Point<size_t>& coordinate); /* Get a rr switch block in the array with a coordinate */
     RRGSB& get_mutable_gsb(const size_t& x, const size_t& y); /* Get a rr switch block in the array with a coordinate */
-    void build_unique_module(const RRGraph& rr_graph); /* Add a switch block to the array, which will automatically identify and update the lists of unique mirrors and rotatable mirrors */
+    void build_unique_module(const RRGraph& rr_graph, const size_t& num_threads); /* Add a switch block to the array, which will automatically identify and update the lists of unique mirrors and rotatable mirrors */
+    void build_mux_drivers(const RRGraph& rr_graph, const size_t& num_threads); /* Resolve the configurable drivers of the routing multiplexers of all the GSBs, which are shared by the builders and writers */
     void clear(); /* clean the content */
+    void clear_chan_node_in_edges(); /* Release the sorted incoming edges of all the GSBs */
   private: /* Internal cleaners */
     void clear_gsb(); /* clean the content */
     void clear_cb_unique_module(const t_rr_type& cb_type); /* clean the content */
@@ -62,11 +66,12 @@ class DeviceRRGSB {
     bool validate_cb_unique_module_index(const t_rr_type& cb_type, const size_t& index) const; /* Validate if the index in the range of unique_mirror vector*/
     bool validate_cb_type(const t_rr_type& cb_type) const;
   private: /* Internal builders */
+    std::vector<vtr::Point<size_t>> get_gsb_coordinates() const; /* Get the coordinates of all the GSBs in the sequence of x and then y */
     void add_gsb_unique_module(const vtr::Point<size_t>& coordinate);
     void add_cb_unique_module(const t_rr_type& cb_type, const vtr::Point<size_t>& coordinate);
     void set_cb_unique_module_id(const t_rr_type& cb_type, const vtr::Point<size_t>& coordinate, size_t id);
-    void build_sb_unique_module(const RRGraph& rr_graph); /* Add a switch block to the array, which will automatically identify and update the lists of unique mirrors and rotatable mirrors */
-    void build_cb_unique_module(const RRGraph& rr_graph, const t_rr_type& cb_type); /* Add a switch block to the array, which will automatically identify and update the lists of unique side module */
+    void build_sb_unique_module(const RRGraph& rr_graph, const size_t& num_threads); /* Add a switch block to the array, which will automatically identify and update the lists of unique mirrors and rotatable mirrors */
+    void build_cb_unique_module(const RRGraph& rr_graph, const t_rr_type& cb_type, const size_t& num_threads); /* Add a switch block to the array, which will automatically identify and update the lists of unique side module */
     void build_gsb_unique_module(); /* Add a switch block to the array, which will automatically identify and update the lists of unique mirrors and rotatable mirrors */
   private: /* Internal Data */
     std::vector<std::vector<RRGSB>> rr_gsb_;
@@ -3,6 +3,10 @@
  ***********************************************************************/
 #include "vtr_log.h"
 #include "vtr_assert.h"
+
+/* Headers from openfpgautil library */
+#include "openfpga_tokenizer.h"
+
 #include "vpr_bitstream_annotation.h"
 #include "mux_bitstream_constants.h"
 
@@ -20,63 +24,89 @@ VprBitstreamAnnotation::VprBitstreamAnnotation() {
  * Public accessors
  ***********************************************************************/
 VprBitstreamAnnotation::e_bitstream_source_type VprBitstreamAnnotation::pb_type_bitstream_source(t_pb_type* pb_type) const {
-  auto result = bitstream_sources_.find(pb_type);
-  if (result != bitstream_sources_.end()) {
-    return result->second;
+  const t_pb_type_annotation* annotation = find_pb_type_annotation(pb_type);
+  if (nullptr == annotation) {
+    /* Not found, return an invalid type*/
+    return NUM_BITSTREAM_SOURCE_TYPES;
   }
-
-  /* Not found, return an invalid type*/
-  return NUM_BITSTREAM_SOURCE_TYPES;
+  return annotation->bitstream.source;
 }
 
 std::string VprBitstreamAnnotation::pb_type_bitstream_content(t_pb_type* pb_type) const {
-  auto result = bitstream_contents_.find(pb_type);
-  if (result != bitstream_contents_.end()) {
-    return result->second;
+  const t_pb_type_annotation* annotation = find_pb_type_annotation(pb_type);
+  if (nullptr == annotation) {
+    /* Not found, return an invalid type */
+    return std::string();
   }
+  return annotation->bitstream.content;
+}
 
-  /* Not found, return an invalid type */
-  return std::string();
+VprBitstreamAnnotation::e_eblif_line_type VprBitstreamAnnotation::pb_type_bitstream_eblif_line_type(t_pb_type* pb_type) const {
+  const t_pb_type_annotation* annotation = find_pb_type_annotation(pb_type);
+  if (nullptr == annotation) {
+    return NUM_EBLIF_LINE_TYPES;
+  }
+  return annotation->bitstream.eblif_line_type;
 }
 
-size_t VprBitstreamAnnotation::pb_type_bitstream_offset(t_pb_type* pb_type) const {
-  auto result = bitstream_offsets_.find(pb_type);
-  if (result != bitstream_offsets_.end()) {
-    return result->second;
+std::string VprBitstreamAnnotation::pb_type_bitstream_eblif_identifier(t_pb_type* pb_type) const {
+  const t_pb_type_annotation* annotation = find_pb_type_annotation(pb_type);
+  if (nullptr == annotation) {
+    return std::string();
   }
+  return annotation->bitstream.eblif_identifier;
+}
 
-  /* Not found, return an zero offset */
-  return 0;
+size_t VprBitstreamAnnotation::pb_type_bitstream_offset(t_pb_type* pb_type) const {
+  const t_pb_type_annotation* annotation = find_pb_type_annotation(pb_type);
+  if (nullptr == annotation) {
+    /* Not found, return an zero offset */
+    return 0;
+  }
+  return annotation->bitstream.offset;
 }
 
 VprBitstreamAnnotation::e_bitstream_source_type VprBitstreamAnnotation::pb_type_mode_select_bitstream_source(t_pb_type* pb_type) const {
-  auto result = mode_select_bitstream_sources_.find(pb_type);
-  if (result != mode_select_bitstream_sources_.end()) {
-    return result->second;
+  const t_pb_type_annotation* annotation = find_pb_type_annotation(pb_type);
+  if (nullptr == annotation) {
+    /* Not found, return an invalid type*/
+    return NUM_BITSTREAM_SOURCE_TYPES;
   }
-
-  /* Not found, return an invalid type*/
-  return NUM_BITSTREAM_SOURCE_TYPES;
+  return annotation->mode_select_bitstream.source;
 }
 
 std::string VprBitstreamAnnotation::pb_type_mode_select_bitstream_content(t_pb_type* pb_type) const {
-  auto result = mode_select_bitstream_contents_.find(pb_type);
-  if (result != mode_select_bitstream_contents_.end()) {
-    return result->second;
+  const t_pb_type_annotation* annotation = find_pb_type_annotation(pb_type);
+  if (nullptr == annotation) {
+    /* Not found, return an invalid type */
+    return std::string();
   }
+  return annotation->mode_select_bitstream.content;
+}
 
-  /* Not found, return an invalid type */
-  return std::string();
+VprBitstreamAnnotation::e_eblif_line_type VprBitstreamAnnotation::pb_type_mode_select_bitstream_eblif_line_type(t_pb_type* pb_type) const {
+  const t_pb_type_annotation* annotation = find_pb_type_annotation(pb_type);
+  if (nullptr == annotation) {
+    return NUM_EBLIF_LINE_TYPES;
+  }
+  return annotation->mode_select_bitstream.eblif_line_type;
 }
 
-size_t VprBitstreamAnnotation::pb_type_mode_select_bitstream_offset(t_pb_type* pb_type) const {
-  auto result = mode_select_bitstream_offsets_.find(pb_type);
-  if (result != mode_select_bitstream_offsets_.end()) {
-    return result->second;
+std::string VprBitstreamAnnotation::pb_type_mode_select_bitstream_eblif_identifier(t_pb_type* pb_type) const {
+  const t_pb_type_annotation* annotation = find_pb_type_annotation(pb_type);
+  if (nullptr == annotation) {
+    return std::string();
   }
+  return annotation->mode_select_bitstream.eblif_identifier;
+}
 
-  /* Not found, return an zero offset */
-  return 0;
+size_t VprBitstreamAnnotation::pb_type_mode_select_bitstream_offset(t_pb_type* pb_type) const {
+  const t_pb_type_annotation* annotation = find_pb_type_annotation(pb_type);
+  if (nullptr == annotation) {
+    /* Not found, return an zero offset */
+    return 0;
+  }
+  return annotation->mode_select_bitstream.offset;
 }
 
 size_t VprBitstreamAnnotation::interconnect_default_path_id(t_interconnect* interconnect) const {
@@ -94,32 +124,36 @@ size_t VprBitstreamAnnotation::interconnect_default_path_id(t_interconnect* inte
  ***********************************************************************/
 void VprBitstreamAnnotation::set_pb_type_bitstream_source(t_pb_type* pb_type,
                                                           const e_bitstream_source_type& bitstream_source) {
-  bitstream_sources_[pb_type] = bitstream_source; 
+  mutable_pb_type_annotation(pb_type).bitstream.source = bitstream_source; 
 }
 
 void VprBitstreamAnnotation::set_pb_type_bitstream_content(t_pb_type* pb_type,
                                                            const std::string& bitstream_content) {
-  bitstream_contents_[pb_type] = bitstream_content; 
+  t_bitstream_annotation& annotation = mutable_pb_type_annotation(pb_type).bitstream;
+  annotation.content = bitstream_content; 
+  parse_bitstream_content(annotation);
 }
 
 void VprBitstreamAnnotation::set_pb_type_bitstream_offset(t_pb_type* pb_type,
                                                           const size_t& offset) {
-  bitstream_offsets_[pb_type] = offset; 
+  mutable_pb_type_annotation(pb_type).bitstream.offset = offset; 
 }
 
 void VprBitstreamAnnotation::set_pb_type_mode_select_bitstream_source(t_pb_type* pb_type,
                                                                       const e_bitstream_source_type& bitstream_source) {
-  mode_select_bitstream_sources_[pb_type] = bitstream_source; 
+  mutable_pb_type_annotation(pb_type).mode_select_bitstream.source = bitstream_source; 
 }
 
 void VprBitstreamAnnotation::set_pb_type_mode_select_bitstream_content(t_pb_type* pb_type,
                                                                        const std::string& bitstream_content) {
-  mode_select_bitstream_contents_[pb_type] = bitstream_content; 
+  t_bitstream_annotation& annotation = mutable_pb_type_annotation(pb_type).mode_select_bitstream;
+  annotation.content = bitstream_content; 
+  parse_bitstream_content(annotation);
 }
 
 void VprBitstreamAnnotation::set_pb_type_mode_select_bitstream_offset(t_pb_type* pb_type,
                                                                       const size_t& offset) {
-  mode_select_bitstream_offsets_[pb_type] = offset; 
+  mutable_pb_type_annotation(pb_type).mode_select_bitstream.offset = offset; 
 }
 
 void VprBitstreamAnnotation::set_interconnect_default_path_id(t_interconnect* interconnect,
@@ -127,4 +161,42 @@ void VprBitstreamAnnotation::set_interconnect_default_path_id(t_interconnect* in
   interconnect_default_path_ids_[interconnect] = default_path_id;
 }
 
+/************************************************************************
+ * Internal look-up
+ ***********************************************************************/
+const VprBitstreamAnnotation::t_pb_type_annotation* VprBitstreamAnnotation::find_pb_type_annotation(const t_pb_type* pb_type) const {
+  auto it = pb_type_annotation_indices_.find(pb_type);
+  if (it == pb_type_annotation_indices_.end()) {
+    return nullptr;
+  }
+  return &(pb_type_annotations_[it->second]);
+}
+
+VprBitstreamAnnotation::t_pb_type_annotation& VprBitstreamAnnotation::mutable_pb_type_annotation(t_pb_type* pb_type) {
+  auto result = pb_type_annotation_indices_.insert(std::make_pair(pb_type, pb_type_annotations_.size()));
+  if (true == result.second) {
+    pb_type_annotations_.emplace_back();
+  }
+  return pb_type_annotations_[result.first->second];
+}
+
+void VprBitstreamAnnotation::parse_bitstream_content(t_bitstream_annotation& annotation) {
+  annotation.eblif_line_type = NUM_EBLIF_LINE_TYPES;
+  annotation.eblif_identifier.clear();
+
+  StringToken tokenizer(annotation.content);
+  std::vector<std::string> tokens = tokenizer.split(" ");
+  if (2 != tokens.size()) {
+    return;
+  }
+  if (std::string(".param") == tokens[0]) {
+    annotation.eblif_line_type = EBLIF_LINE_PARAM;
+  } else if (std::string(".attr") == tokens[0]) {
+    annotation.eblif_line_type = EBLIF_LINE_ATTR;
+  } else {
+    return;
+  }
+  annotation.eblif_identifier = tokens[1];
+}
+
 } /* End namespace openfpga*/
@@ -6,6 +6,8 @@
  *******************************************************************/
 #include <string> 
 #include <map> 
+#include <unordered_map> 
+#include <vector> 
 
 /* Header from vpr library */
 #include "vpr_context.h"
@@ -28,20 +30,36 @@ class VprBitstreamAnnotation {
       BITSTREAM_SOURCE_EBLIF,
       NUM_BITSTREAM_SOURCE_TYPES
     };
+    /* Lines of .eblif file where bitstream contents can be found,
+     * i.e., the bitstream content is organized as <.param|.attr> <identifier string> 
+     */
+    enum e_eblif_line_type {
+      EBLIF_LINE_PARAM,
+      EBLIF_LINE_ATTR,
+      NUM_EBLIF_LINE_TYPES
+    };
   public:  /* Constructor */
     VprBitstreamAnnotation();
   public:  /* Public accessors */
     e_bitstream_source_type pb_type_bitstream_source(t_pb_type* pb_type) const;
     std::string pb_type_bitstream_content(t_pb_type* pb_type) const;
+    /* The line type and identifier parsed from the bitstream content,
+     * NUM_EBLIF_LINE_TYPES is returned if the content is not in the format
+     */
+    e_eblif_line_type pb_type_bitstream_eblif_line_type(t_pb_type* pb_type) const;
+    std::string pb_type_bitstream_eblif_identifier(t_pb_type* pb_type) const;
     size_t pb_type_bitstream_offset(t_pb_type* pb_type) const;
 
     e_bitstream_source_type pb_type_mode_select_bitstream_source(t_pb_type* pb_type) const;
     std::string pb_type_mode_select_bitstream_content(t_pb_type* pb_type) const;
+    e_eblif_line_type pb_type_mode_select_bitstream_eblif_line_type(t_pb_type* pb_type) const;
+    std::string pb_type_mode_select_bitstream_eblif_identifier(t_pb_type* pb_type) const;
     size_t pb_type_mode_select_bitstream_offset(t_pb_type* pb_type) const;
     size_t interconnect_default_path_id(t_interconnect* interconnect) const;
   public:  /* Public mutators */
     void set_pb_type_bitstream_source(t_pb_type* pb_type,
                                       const e_bitstream_source_type& bitstream_source);
+    /* The content is parsed here, so that it is not parsed for each primitive in bitstream generation */
     void set_pb_type_bitstream_content(t_pb_type* pb_type,
                                        const std::string& bitstream_content);
     void set_pb_type_bitstream_offset(t_pb_type* pb_type,
@@ -55,22 +73,40 @@ class VprBitstreamAnnotation {
                                                   const size_t& offset);
     void set_interconnect_default_path_id(t_interconnect* interconnect,
                                           const size_t& default_path_id);
-  private: /* Internal data */
-    /* For regular bitstreams */
-    /* A look up for pb type to find bitstream source type */
-    std::map<t_pb_type*, e_bitstream_source_type> bitstream_sources_;
-    /* Binding from pb type to bitstream content */
-    std::map<t_pb_type*, std::string> bitstream_contents_;
-    /* Offset to be applied to bitstream */
-    std::map<t_pb_type*, size_t> bitstream_offsets_;
+  private: /* Internal data types */
+    /* Annotation of a regular or mode-select bitstream */
+    struct t_bitstream_annotation {
+      /* Bitstream source type */
+      e_bitstream_source_type source = NUM_BITSTREAM_SOURCE_TYPES;
+      /* Bitstream content and the line type and identifier parsed from it */
+      std::string content;
+      e_eblif_line_type eblif_line_type = NUM_EBLIF_LINE_TYPES;
+      std::string eblif_identifier;
+      /* Offset to be applied to bitstream */
+      size_t offset = 0;
+    };
 
-    /* For mode-select bitstreams */
-    /* A look up for pb type to find bitstream source type */
-    std::map<t_pb_type*, e_bitstream_source_type> mode_select_bitstream_sources_;
-    /* Binding from pb type to bitstream content */
-    std::map<t_pb_type*, std::string> mode_select_bitstream_contents_;
-    /* Offset to be applied to mode-select bitstream */
-    std::map<t_pb_type*, size_t> mode_select_bitstream_offsets_;
+    /* All the bitstream annotations of a pb_type */
+    struct t_pb_type_annotation {
+      t_bitstream_annotation bitstream;
+      t_bitstream_annotation mode_select_bitstream;
+    };
+
+  private: /* Internal look-up */
+    /* Find the annotation of a pb_type, return nullptr if not annotated */
+    const t_pb_type_annotation* find_pb_type_annotation(const t_pb_type* pb_type) const;
+    /* Find the annotation of a pb_type, create one if not annotated */
+    t_pb_type_annotation& mutable_pb_type_annotation(t_pb_type* pb_type);
+    /* Parse a bitstream content to the line type and identifier of .eblif file */
+    static void parse_bitstream_content(t_bitstream_annotation& annotation);
+
+  private: /* Internal data */
+    /* Each annotated pb_type has a dense index to its annotation
+     * All the annotations of the pb_type are accessed 
+     * by a single look-up to the dense index
+     */
+    std::unordered_map<const t_pb_type*, size_t> pb_type_annotation_indices_;
+    std::vector<t_pb_type_annotation> pb_type_annotations_;
 
     /* A look up for interconnect to find default path indices
      * Note: this is different from the default path in bitstream setting which is the index
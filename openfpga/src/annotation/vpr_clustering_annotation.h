@@ -5,6 +5,10 @@
  * Include header files required by the data structure definition
  *******************************************************************/
 #include <map> 
+#include <vector> 
+
+/* Header from vtrutil library */
+#include "vtr_vector.h"
 
 /* Header from vpr library */
 #include "clustered_netlist.h"
@@ -35,20 +39,27 @@ class VprClusteringAnnotation {
     ClusterNetId net(const ClusterBlockId& block_id, const int& pin_index) const;
     bool is_truth_table_adapted(t_pb* pb) const;
     AtomNetlist::TruthTable truth_table(t_pb* pb) const;
-    PhysicalPb physical_pb(const ClusterBlockId& block_id) const;
+    /* Return an empty physical pb if the block has not been repacked */
+    const PhysicalPb& physical_pb(const ClusterBlockId& block_id) const;
   public:  /* Public mutators */
     void rename_net(const ClusterBlockId& block_id, const int& pin_index,
                     const ClusterNetId& net_id);
     void adapt_truth_table(t_pb* pb, const AtomNetlist::TruthTable& tt);
-    void add_physical_pb(const ClusterBlockId& block_id, const PhysicalPb& physical_pb);
+    void add_physical_pb(const ClusterBlockId& block_id, PhysicalPb physical_pb);
     PhysicalPb& mutable_physical_pb(const ClusterBlockId& block_id);
   private: /* Internal data */
-    /* Pair a regular pb_type to its physical pb_type */
-    std::map<ClusterBlockId, std::map<int, ClusterNetId>> net_names_;
+    /* Renamed nets of the pins of clustered blocks, indexed by [block][pin]
+     * A pin may be renamed to an invalid net, so the renaming is flagged separately
+     */
+    vtr::vector<ClusterBlockId, std::vector<ClusterNetId>> net_names_;
+    vtr::vector<ClusterBlockId, std::vector<bool>> net_renamed_;
     std::map<t_pb*, AtomNetlist::TruthTable> block_truth_tables_;
 
-    /* Link clustered blocks to physical pb (mapping results) */
-    std::map<ClusterBlockId, PhysicalPb> physical_pbs_;
+    /* Link clustered blocks to physical pb (mapping results)
+     * A clustered block is not repacked if its physical pb is empty
+     */
+    vtr::vector<ClusterBlockId, PhysicalPb> physical_pbs_;
+    PhysicalPb empty_physical_pb_;
 };
 
 } /* End namespace openfpga*/
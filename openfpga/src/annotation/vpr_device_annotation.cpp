@@ -5,6 +5,7 @@
 
 #include "vtr_log.h"
 #include "vtr_assert.h"
+#include "openfpga_memory_usage.h"
 #include "vpr_device_annotation.h"
 
 /* namespace openfpga begins */
@@ -22,131 +23,117 @@ VprDeviceAnnotation::VprDeviceAnnotation() {
  ***********************************************************************/
 bool VprDeviceAnnotation::is_physical_pb_type(t_pb_type* pb_type) const {
   /* Ensure that the pb_type is in the list */
-  std::map<t_pb_type*, t_pb_type*>::const_iterator it = physical_pb_types_.find(pb_type);
-  if (it == physical_pb_types_.end()) {
+  const t_pb_type_annotation* annotation = find_pb_type_annotation(pb_type);
+  if (nullptr == annotation) {
     return false;
   }
   /* A physical pb_type should be mapped to itself! Otherwise, it is an operating pb_type */
-  return pb_type == physical_pb_types_.at(pb_type);
+  return pb_type == annotation->physical_pb_type;
 }
 
 t_mode* VprDeviceAnnotation::physical_mode(t_pb_type* pb_type) const {
   /* Ensure that the pb_type is in the list */
-  std::map<t_pb_type*, t_mode*>::const_iterator it = physical_pb_modes_.find(pb_type);
-  if (it == physical_pb_modes_.end()) {
+  const t_pb_type_annotation* annotation = find_pb_type_annotation(pb_type);
+  if (nullptr == annotation) {
     return nullptr;
   }
-  return physical_pb_modes_.at(pb_type);
+  return annotation->physical_mode;
 }
 
 t_pb_type* VprDeviceAnnotation::physical_pb_type(t_pb_type* pb_type) const {
   /* Ensure that the pb_type is in the list */
-  std::map<t_pb_type*, t_pb_type*>::const_iterator it = physical_pb_types_.find(pb_type);
-  if (it == physical_pb_types_.end()) {
+  const t_pb_type_annotation* annotation = find_pb_type_annotation(pb_type);
+  if (nullptr == annotation) {
     return nullptr;
   }
-  return physical_pb_types_.at(pb_type);
+  return annotation->physical_pb_type;
 }
 
 std::vector<t_port*> VprDeviceAnnotation::physical_pb_port(t_port* pb_port) const {
-  /* Ensure that the pb_type is in the list */
-  std::map<t_port*, std::vector<t_port*>>::const_iterator it = physical_pb_ports_.find(pb_port);
-  if (it == physical_pb_ports_.end()) {
+  /* Ensure that the pb_port is in the list */
+  const t_port_annotation* annotation = find_port_annotation(pb_port);
+  if (nullptr == annotation) {
     return std::vector<t_port*>();
   }
-  return physical_pb_ports_.at(pb_port);
+  return annotation->physical_pb_ports;
 }
 
 BasicPort VprDeviceAnnotation::physical_pb_port_range(t_port* operating_pb_port,
                                                       t_port* physical_pb_port) const {
-  /* Ensure that the pb_type is in the list */
-  std::map<t_port*, std::map<t_port*, BasicPort>>::const_iterator it = physical_pb_port_ranges_.find(operating_pb_port);
-  if (it == physical_pb_port_ranges_.end()) {
-    /* Return an invalid port. As such the port width will be 0, which is an invalid value */
-    return BasicPort();
-  }
-  if (0 == physical_pb_port_ranges_.at(operating_pb_port).count(physical_pb_port)) {
+  /* Ensure that the pb_port pair is in the list */
+  const t_port_pair_annotation* annotation = find_port_pair_annotation(operating_pb_port, physical_pb_port);
+  if ( (nullptr == annotation) || (false == annotation->has_range) ) {
     /* Return an invalid port. As such the port width will be 0, which is an invalid value */
     return BasicPort();
   }
-  return physical_pb_port_ranges_.at(operating_pb_port).at(physical_pb_port);
+  return annotation->range;
 }
 
 CircuitModelId VprDeviceAnnotation::pb_type_circuit_model(t_pb_type* physical_pb_type) const {
   /* Ensure that the pb_type is in the list */
-  std::map<t_pb_type*, CircuitModelId>::const_iterator it = pb_type_circuit_models_.find(physical_pb_type);
-  if (it == pb_type_circuit_models_.end()) {
+  const t_pb_type_annotation* annotation = find_pb_type_annotation(physical_pb_type);
+  if (nullptr == annotation) {
     /* Return an invalid circuit model id */
     return CircuitModelId::INVALID();
   }
-  return pb_type_circuit_models_.at(physical_pb_type);
+  return annotation->circuit_model;
 }
 
 CircuitModelId VprDeviceAnnotation::interconnect_circuit_model(t_interconnect* pb_interconnect) const {
   /* Ensure that the pb_type is in the list */
-  std::map<t_interconnect*, CircuitModelId>::const_iterator it = interconnect_circuit_models_.find(pb_interconnect);
+  auto it = interconnect_circuit_models_.find(pb_interconnect);
   if (it == interconnect_circuit_models_.end()) {
     /* Return an invalid circuit model id */
     return CircuitModelId::INVALID();
   }
-  return interconnect_circuit_models_.at(pb_interconnect);
+  return it->second;
 }
 
 e_interconnect VprDeviceAnnotation::interconnect_physical_type(t_interconnect* pb_interconnect) const {
   /* Ensure that the pb_type is in the list */
-  std::map<t_interconnect*, e_interconnect>::const_iterator it = interconnect_physical_types_.find(pb_interconnect);
+  auto it = interconnect_physical_types_.find(pb_interconnect);
   if (it == interconnect_physical_types_.end()) {
     /* Return an invalid interconnect type */
     return NUM_INTERC_TYPES;
   }
-  return interconnect_physical_types_.at(pb_interconnect);
+  return it->second;
 }
 
 CircuitPortId VprDeviceAnnotation::pb_circuit_port(t_port* pb_port) const {
-  /* Ensure that the pb_type is in the list */
-  std::map<t_port*, CircuitPortId>::const_iterator it = pb_circuit_ports_.find(pb_port);
-  if (it == pb_circuit_ports_.end()) {
+  /* Ensure that the pb_port is in the list */
+  const t_port_annotation* annotation = find_port_annotation(pb_port);
+  if (nullptr == annotation) {
     /* Return an invalid circuit port id */
     return CircuitPortId::INVALID();
   }
-  return pb_circuit_ports_.at(pb_port);
+  return annotation->circuit_port;
 }
 
 std::vector<size_t> VprDeviceAnnotation::pb_type_mode_bits(t_pb_type* pb_type) const {
   /* Ensure that the pb_type is in the list */
-  std::map<t_pb_type*, std::vector<size_t>>::const_iterator it = pb_type_mode_bits_.find(pb_type);
-  if (it == pb_type_mode_bits_.end()) {
+  const t_pb_type_annotation* annotation = find_pb_type_annotation(pb_type);
+  if (nullptr == annotation) {
     /* Return an empty vector */
     return std::vector<size_t>();
   }
-  return pb_type_mode_bits_.at(pb_type);
+  return annotation->mode_bits;
 }
 
 PbGraphNodeId VprDeviceAnnotation::pb_graph_node_unique_index(t_pb_graph_node* pb_graph_node) const {
-  /* Ensure that the pb_type is in the list */
-  std::map<t_pb_type*, std::vector<t_pb_graph_node*>>::const_iterator it = pb_graph_node_unique_index_.find(pb_graph_node->pb_type);
-  if (it == pb_graph_node_unique_index_.end()) {
-    /* Invalid pb_type, return a null pointer */
-    return PbGraphNodeId::INVALID();
-  }
-
-  /* Try to find the pb_graph_node in the vector */
-  std::vector<t_pb_graph_node*>::const_iterator it_node = std::find(pb_graph_node_unique_index_.at(pb_graph_node->pb_type).begin(),
-                                                                    pb_graph_node_unique_index_.at(pb_graph_node->pb_type).end(),
-                                                                    pb_graph_node);
   /* If it exists, return the index
    * Otherwise, return an invalid id
    */
-  if (it_node == pb_graph_node_unique_index_.at(pb_graph_node->pb_type).end()) {
+  auto it = pb_graph_node_unique_indices_.find(pb_graph_node);
+  if (it == pb_graph_node_unique_indices_.end()) {
     return PbGraphNodeId::INVALID();
   }
-  return PbGraphNodeId(it_node - pb_graph_node_unique_index_.at(pb_graph_node->pb_type).begin());
+  return it->second;
 }
 
 t_pb_graph_node* VprDeviceAnnotation::pb_graph_node(t_pb_type* pb_type, const PbGraphNodeId& unique_index) const {
   /* Ensure that the pb_type is in the list */
-  std::map<t_pb_type*, std::vector<t_pb_graph_node*>>::const_iterator it = pb_graph_node_unique_index_.find(pb_type);
-  if (it == pb_graph_node_unique_index_.end()) {
+  const t_pb_type_annotation* annotation = find_pb_type_annotation(pb_type);
+  if (nullptr == annotation) {
     /* Invalid pb_type, return a null pointer */
     return nullptr;
   }
@@ -154,128 +141,129 @@ t_pb_graph_node* VprDeviceAnnotation::pb_graph_node(t_pb_type* pb_type, const Pb
    *  - Out of range: return a null pointer
    *  - In range: return the pointer
    */
-  if ((size_t)unique_index > pb_graph_node_unique_index_.at(pb_type).size() - 1) {
+  if ( (false == bool(unique_index))
+    || ((size_t)unique_index >= annotation->pb_graph_nodes.size()) ) {
     return nullptr;
   }
 
-  return pb_graph_node_unique_index_.at(pb_type)[size_t(unique_index)];
+  return annotation->pb_graph_nodes[size_t(unique_index)];
 }
 
 t_pb_graph_node* VprDeviceAnnotation::physical_pb_graph_node(t_pb_graph_node* pb_graph_node) const {
   /* Ensure that the pb_graph_node is in the list */
-  std::map<t_pb_graph_node*, t_pb_graph_node*>::const_iterator it = physical_pb_graph_nodes_.find(pb_graph_node);
+  auto it = physical_pb_graph_nodes_.find(pb_graph_node);
   if (it == physical_pb_graph_nodes_.end()) {
     return nullptr;
   }
-  return physical_pb_graph_nodes_.at(pb_graph_node);
+  return it->second;
 }
 
 float VprDeviceAnnotation::physical_pb_type_index_factor(t_pb_type* pb_type) const {
   /* Ensure that the pb_type is in the list */
-  std::map<t_pb_type*, float>::const_iterator it = physical_pb_type_index_factors_.find(pb_type);
-  if (it == physical_pb_type_index_factors_.end()) {
+  const t_pb_type_annotation* annotation = find_pb_type_annotation(pb_type);
+  if (nullptr == annotation) {
     /* Default value is 1 */
     return 1.;
   }
-  return physical_pb_type_index_factors_.at(pb_type);
+  return annotation->index_factor;
 }
 
 int VprDeviceAnnotation::physical_pb_type_index_offset(t_pb_type* pb_type) const {
   /* Ensure that the pb_type is in the list */
-  std::map<t_pb_type*, int>::const_iterator it = physical_pb_type_index_offsets_.find(pb_type);
-  if (it == physical_pb_type_index_offsets_.end()) {
+  const t_pb_type_annotation* annotation = find_pb_type_annotation(pb_type);
+  if (nullptr == annotation) {
     /* Default value is 0 */
     return 0;
   }
-  return physical_pb_type_index_offsets_.at(pb_type);
+  return annotation->index_offset;
 }
 
 int VprDeviceAnnotation::physical_pb_pin_initial_offset(t_port* operating_pb_port,
                                                         t_port* physical_pb_port) const {
-  /* Ensure that the pb_type is in the list */
-  std::map<t_port*, std::map<t_port*, int>>::const_iterator it = physical_pb_pin_initial_offsets_.find(operating_pb_port);
-  if (it == physical_pb_pin_initial_offsets_.end()) {
-    /* Default value is 0 */
-    return 0;
-  }
-  if (0 == physical_pb_pin_initial_offsets_.at(operating_pb_port).count(physical_pb_port)) {
+  /* Ensure that the pb_port pair is in the list */
+  const t_port_pair_annotation* annotation = find_port_pair_annotation(operating_pb_port, physical_pb_port);
+  if (nullptr == annotation) {
     /* Default value is 0 */
     return 0;
   }
-  return physical_pb_pin_initial_offsets_.at(operating_pb_port).at(physical_pb_port);
+  return annotation->initial_offset;
 }
 
 int VprDeviceAnnotation::physical_pb_pin_rotate_offset(t_port* operating_pb_port,
                                                        t_port* physical_pb_port) const {
-  /* Ensure that the pb_type is in the list */
-  std::map<t_port*, std::map<t_port*, int>>::const_iterator it = physical_pb_pin_rotate_offsets_.find(operating_pb_port);
-  if (it == physical_pb_pin_rotate_offsets_.end()) {
+  /* Ensure that the pb_port pair is in the list */
+  const t_port_pair_annotation* annotation = find_port_pair_annotation(operating_pb_port, physical_pb_port);
+  if (nullptr == annotation) {
     /* Default value is 0 */
     return 0;
   }
-  if (0 == physical_pb_pin_rotate_offsets_.at(operating_pb_port).count(physical_pb_port)) {
-    /* Default value is 0 */
-    return 0;
-  }
-  return physical_pb_pin_rotate_offsets_.at(operating_pb_port).at(physical_pb_port);
+  return annotation->rotate_offset;
 }
 
 int VprDeviceAnnotation::physical_pb_pin_offset(t_port* operating_pb_port,
                                                 t_port* physical_pb_port) const {
-  /* Ensure that the pb_type is in the list */
-  std::map<t_port*, std::map<t_port*, int>>::const_iterator it = physical_pb_pin_offsets_.find(operating_pb_port);
-  if (it == physical_pb_pin_offsets_.end()) {
+  /* Ensure that the pb_port pair is in the list */
+  const t_port_pair_annotation* annotation = find_port_pair_annotation(operating_pb_port, physical_pb_port);
+  if (nullptr == annotation) {
     /* Default value is 0 */
     return 0;
   }
-  if (0 == physical_pb_pin_offsets_.at(operating_pb_port).count(physical_pb_port)) {
-    /* Default value is 0 */
-    return 0;
-  }
-  return physical_pb_pin_offsets_.at(operating_pb_port).at(physical_pb_port);
+  return annotation->offset;
 }
 
 t_pb_graph_pin* VprDeviceAnnotation::physical_pb_graph_pin(const t_pb_graph_pin* pb_graph_pin) const {
-  /* Ensure that the pb_type is in the list */
-  std::map<const t_pb_graph_pin*, t_pb_graph_pin*>::const_iterator it = physical_pb_graph_pins_.find(pb_graph_pin);
+  /* Find the top-level pb_graph_node, whose pins are indexed in the look-up */
+  const t_pb_graph_node* pb_graph_head = pb_graph_pin->parent_node;
+  while (nullptr != pb_graph_head->parent_pb_graph_node) {
+    pb_graph_head = pb_graph_head->parent_pb_graph_node;
+  }
+
+  auto it = physical_pb_graph_pins_.find(pb_graph_head);
   if (it == physical_pb_graph_pins_.end()) {
     return nullptr;
   }
-  return physical_pb_graph_pins_.at(pb_graph_pin);
+  if ((size_t)pb_graph_pin->pin_count_in_cluster >= it->second.size()) {
+    return nullptr;
+  }
+  return it->second[pb_graph_pin->pin_count_in_cluster];
 }
 
 CircuitModelId VprDeviceAnnotation::rr_switch_circuit_model(const RRSwitchId& rr_switch) const {
   /* Ensure that the rr_switch is in the list */
-  std::map<RRSwitchId, CircuitModelId>::const_iterator it = rr_switch_circuit_models_.find(rr_switch);
-  if (it == rr_switch_circuit_models_.end()) {
+  if (size_t(rr_switch) >= rr_switch_circuit_models_.size()) {
     return CircuitModelId::INVALID();
   }
-  return rr_switch_circuit_models_.at(rr_switch);
+  return rr_switch_circuit_models_[rr_switch];
 }
 
 CircuitModelId VprDeviceAnnotation::rr_segment_circuit_model(const RRSegmentId& rr_segment) const {
-  /* Ensure that the rr_switch is in the list */
-  std::map<RRSegmentId, CircuitModelId>::const_iterator it = rr_segment_circuit_models_.find(rr_segment);
-  if (it == rr_segment_circuit_models_.end()) {
+  /* Ensure that the rr_segment is in the list */
+  if (size_t(rr_segment) >= rr_segment_circuit_models_.size()) {
     return CircuitModelId::INVALID();
   }
-  return rr_segment_circuit_models_.at(rr_segment);
+  return rr_segment_circuit_models_[rr_segment];
 }
 
 ArchDirectId VprDeviceAnnotation::direct_annotation(const size_t& direct) const {
-  /* Ensure that the rr_switch is in the list */
-  if (0 == direct_annotations_.count(direct)) {
+  /* Ensure that the direct is in the list */
+  if (direct >= direct_annotations_.size()) {
     return ArchDirectId::INVALID();
   }
-  return direct_annotations_.at(direct);
+  return direct_annotations_[direct];
 }
 
-LbRRGraph VprDeviceAnnotation::physical_lb_rr_graph(t_pb_graph_node* pb_graph_head) const {
-  /* Ensure that the rr_switch is in the list */
-  if (0 == physical_lb_rr_graphs_.count(pb_graph_head)) {
-    return LbRRGraph();
+bool VprDeviceAnnotation::has_physical_lb_rr_graph(t_pb_graph_node* pb_graph_head) const {
+  return 0 < physical_lb_rr_graphs_.count(pb_graph_head);
+}
+
+const LbRRGraph& VprDeviceAnnotation::physical_lb_rr_graph(t_pb_graph_node* pb_graph_head) const {
+  /* Ensure that the pb_graph_head is in the list, otherwise return an empty graph */
+  static const LbRRGraph empty_lb_rr_graph;
+  auto it = physical_lb_rr_graphs_.find(pb_graph_head);
+  if (it == physical_lb_rr_graphs_.end()) {
+    return empty_lb_rr_graph;
   }
-  return physical_lb_rr_graphs_.at(pb_graph_head);
+  return it->second;
 }
 
 BasicPort VprDeviceAnnotation::physical_tile_pin_port_info(t_physical_tile_type_ptr physical_tile,
@@ -288,14 +276,14 @@ BasicPort VprDeviceAnnotation::physical_tile_pin_port_info(t_physical_tile_type_
   }
 
   /* Try to find the physical tile port info with pin index */
-  auto pin_search_result = physical_tile_search_result->second.find(pin_index);
-  if (pin_search_result == physical_tile_search_result->second.end()) {
+  if ( (0 > pin_index)
+    || ((size_t)pin_index >= physical_tile_search_result->second.size()) ) {
     /* Not found. Return an invalid port */
     return BasicPort();
   }
   
   /* Reach here, we should find a port. Return the port information */
-  return pin_search_result->second;
+  return physical_tile_search_result->second[pin_index];
 }
 
 int VprDeviceAnnotation::physical_tile_pin_subtile_index(t_physical_tile_type_ptr physical_tile,
@@ -308,44 +296,74 @@ int VprDeviceAnnotation::physical_tile_pin_subtile_index(t_physical_tile_type_pt
   }
 
   /* Try to find the physical tile port info with pin index */
-  auto pin_search_result = physical_tile_search_result->second.find(pin_index);
-  if (pin_search_result == physical_tile_search_result->second.end()) {
+  if ( (0 > pin_index)
+    || ((size_t)pin_index >= physical_tile_search_result->second.size()) ) {
     /* Not found. Return an invalid index */
     return -1;
   }
   
   /* Reach here, we should find a port. Return the port information */
-  return pin_search_result->second;
+  return physical_tile_search_result->second[pin_index];
+}
+
+size_t VprDeviceAnnotation::t_port_annotation::memory_usage() const {
+  return openfpga::memory_usage(physical_pb_ports)
+       + openfpga::memory_usage(port_pairs);
+}
+
+size_t VprDeviceAnnotation::t_pb_type_annotation::memory_usage() const {
+  return openfpga::memory_usage(mode_bits)
+       + openfpga::memory_usage(pb_graph_nodes)
+       + openfpga::memory_usage(ports);
+}
+
+size_t VprDeviceAnnotation::memory_usage() const {
+  return openfpga::memory_usage(pb_type_annotation_indices_)
+       + openfpga::memory_usage(pb_type_annotations_)
+       + openfpga::memory_usage(interconnect_circuit_models_)
+       + openfpga::memory_usage(interconnect_physical_types_)
+       + openfpga::memory_usage(pb_graph_node_unique_indices_)
+       + openfpga::memory_usage(physical_pb_graph_nodes_)
+       + openfpga::memory_usage(physical_pb_graph_pins_)
+       + openfpga::memory_usage(rr_switch_circuit_models_)
+       + openfpga::memory_usage(rr_segment_circuit_models_)
+       + openfpga::memory_usage(direct_annotations_)
+       + openfpga::memory_usage(physical_tile_pin2port_info_map_)
+       + openfpga::memory_usage(physical_tile_pin_subtile_indices_);
+}
+
+size_t VprDeviceAnnotation::physical_lb_rr_graph_memory_usage() const {
+  return openfpga::memory_usage(physical_lb_rr_graphs_);
 }
 
 /************************************************************************
  * Public mutators
  ***********************************************************************/
 void VprDeviceAnnotation::add_pb_type_physical_mode(t_pb_type* pb_type, t_mode* physical_mode) {
+  t_pb_type_annotation& annotation = mutable_pb_type_annotation(pb_type);
   /* Warn any override attempt */
-  std::map<t_pb_type*, t_mode*>::const_iterator it = physical_pb_modes_.find(pb_type);
-  if (it != physical_pb_modes_.end()) {
+  if (nullptr != annotation.physical_mode) {
     VTR_LOG_WARN("Override the annotation between pb_type '%s' and it physical mode '%s'!\n",
                  pb_type->name, physical_mode->name);
   }
 
-  physical_pb_modes_[pb_type] = physical_mode;
+  annotation.physical_mode = physical_mode;
 }
 
 void VprDeviceAnnotation::add_physical_pb_type(t_pb_type* operating_pb_type, t_pb_type* physical_pb_type) {
+  t_pb_type_annotation& annotation = mutable_pb_type_annotation(operating_pb_type);
   /* Warn any override attempt */
-  std::map<t_pb_type*, t_pb_type*>::const_iterator it = physical_pb_types_.find(operating_pb_type);
-  if (it != physical_pb_types_.end()) {
+  if (nullptr != annotation.physical_pb_type) {
     VTR_LOG_WARN("Override the annotation between operating pb_type '%s' and it physical pb_type '%s'!\n",
                  operating_pb_type->name, physical_pb_type->name);
   }
 
-  physical_pb_types_[operating_pb_type] = physical_pb_type;
+  annotation.physical_pb_type = physical_pb_type;
 }
 
 void VprDeviceAnnotation::add_physical_pb_port(t_port* operating_pb_port,
                                                t_port* physical_pb_port) {
-  physical_pb_ports_[operating_pb_port].push_back(physical_pb_port);
+  mutable_port_annotation(operating_pb_port).physical_pb_ports.push_back(physical_pb_port);
 }
 
 void VprDeviceAnnotation::add_physical_pb_port_range(t_port* operating_pb_port,
@@ -354,34 +372,33 @@ void VprDeviceAnnotation::add_physical_pb_port_range(t_port* operating_pb_port,
   /* The port range must satify the port width*/
   VTR_ASSERT((size_t)operating_pb_port->num_pins >= port_range.get_width());
 
+  t_port_pair_annotation& annotation = mutable_port_pair_annotation(operating_pb_port, physical_pb_port);
   /* Warn any override attempt */
-  std::map<t_port*, std::map<t_port*, BasicPort>>::const_iterator it = physical_pb_port_ranges_.find(operating_pb_port);
-  if ( (it != physical_pb_port_ranges_.end())
-    && (0 < physical_pb_port_ranges_[operating_pb_port].count(physical_pb_port)) ) {
+  if (true == annotation.has_range) {
     VTR_LOG_WARN("Override the annotation between operating pb_port '%s' and it physical pb_port range '%s[%ld:%ld]'!\n",
                  operating_pb_port->name,
                  physical_pb_port->name,
                  port_range.get_lsb(), port_range.get_msb());
   }
 
-  physical_pb_port_ranges_[operating_pb_port][physical_pb_port] = port_range;
+  annotation.has_range = true;
+  annotation.range = port_range;
 }
 
 void VprDeviceAnnotation::add_pb_type_circuit_model(t_pb_type* physical_pb_type, const CircuitModelId& circuit_model) {
+  t_pb_type_annotation& annotation = mutable_pb_type_annotation(physical_pb_type);
   /* Warn any override attempt */
-  std::map<t_pb_type*, CircuitModelId>::const_iterator it = pb_type_circuit_models_.find(physical_pb_type);
-  if (it != pb_type_circuit_models_.end()) {
+  if (CircuitModelId::INVALID() != annotation.circuit_model) {
     VTR_LOG_WARN("Override the circuit model for physical pb_type '%s'!\n",
                  physical_pb_type->name);
   }
 
-  pb_type_circuit_models_[physical_pb_type] = circuit_model;
+  annotation.circuit_model = circuit_model;
 }
 
 void VprDeviceAnnotation::add_interconnect_circuit_model(t_interconnect* pb_interconnect, const CircuitModelId& circuit_model) {
   /* Warn any override attempt */
-  std::map<t_interconnect*, CircuitModelId>::const_iterator it = interconnect_circuit_models_.find(pb_interconnect);
-  if (it != interconnect_circuit_models_.end()) {
+  if (0 < interconnect_circuit_models_.count(pb_interconnect)) {
     VTR_LOG_WARN("Override the circuit model for interconnect '%s'!\n",
                  pb_interconnect->name);
   }
@@ -392,8 +409,7 @@ void VprDeviceAnnotation::add_interconnect_circuit_model(t_interconnect* pb_inte
 void VprDeviceAnnotation::add_interconnect_physical_type(t_interconnect* pb_interconnect,
                                                          const e_interconnect& physical_type) {
   /* Warn any override attempt */
-  std::map<t_interconnect*, e_interconnect>::const_iterator it = interconnect_physical_types_.find(pb_interconnect);
-  if (it != interconnect_physical_types_.end()) {
+  if (0 < interconnect_physical_types_.count(pb_interconnect)) {
     VTR_LOG_WARN("Override the physical interconnect for interconnect '%s'!\n",
                  pb_interconnect->name);
   }
@@ -402,36 +418,39 @@ void VprDeviceAnnotation::add_interconnect_physical_type(t_interconnect* pb_inte
 }
 
 void VprDeviceAnnotation::add_pb_circuit_port(t_port* pb_port, const CircuitPortId& circuit_port) {
+  t_port_annotation& annotation = mutable_port_annotation(pb_port);
   /* Warn any override attempt */
-  std::map<t_port*, CircuitPortId>::const_iterator it = pb_circuit_ports_.find(pb_port);
-  if (it != pb_circuit_ports_.end()) {
+  if (CircuitPortId::INVALID() != annotation.circuit_port) {
     VTR_LOG_WARN("Override the circuit port mapping for pb_type port '%s'!\n",
                  pb_port->name);
   }
 
-  pb_circuit_ports_[pb_port] = circuit_port;
+  annotation.circuit_port = circuit_port;
 }
 
 void VprDeviceAnnotation::add_pb_type_mode_bits(t_pb_type* pb_type, const std::vector<size_t>& mode_bits) {
+  t_pb_type_annotation& annotation = mutable_pb_type_annotation(pb_type);
   /* Warn any override attempt */
-  std::map<t_pb_type*, std::vector<size_t>>::const_iterator it = pb_type_mode_bits_.find(pb_type);
-  if (it != pb_type_mode_bits_.end()) {
+  if (true == annotation.has_mode_bits) {
     VTR_LOG_WARN("Override the mode bits mapping for pb_type '%s'!\n",
                  pb_type->name);
   }
 
-  pb_type_mode_bits_[pb_type] = mode_bits;
+  annotation.has_mode_bits = true;
+  annotation.mode_bits = mode_bits;
 }
 
 void VprDeviceAnnotation::add_pb_graph_node_unique_index(t_pb_graph_node* pb_graph_node) {
-  pb_graph_node_unique_index_[pb_graph_node->pb_type].push_back(pb_graph_node);
+  std::vector<t_pb_graph_node*>& pb_graph_nodes = mutable_pb_type_annotation(pb_graph_node->pb_type).pb_graph_nodes;
+  /* The first index of a pb_graph_node is the unique index */
+  pb_graph_node_unique_indices_.insert(std::make_pair(pb_graph_node, PbGraphNodeId(pb_graph_nodes.size())));
+  pb_graph_nodes.push_back(pb_graph_node);
 }
 
 void VprDeviceAnnotation::add_physical_pb_graph_node(t_pb_graph_node* operating_pb_graph_node, 
                                                      t_pb_graph_node* physical_pb_graph_node) {
   /* Warn any override attempt */
-  std::map<t_pb_graph_node*, t_pb_graph_node*>::const_iterator it = physical_pb_graph_nodes_.find(operating_pb_graph_node);
-  if (it != physical_pb_graph_nodes_.end()) {
+  if (0 < physical_pb_graph_nodes_.count(operating_pb_graph_node)) {
     VTR_LOG_WARN("Override the annotation between operating pb_graph_node '%s[%d]' and it physical pb_graph_node '%s[%d]'!\n",
                  operating_pb_graph_node->pb_type->name, 
                  operating_pb_graph_node->placement_index,
@@ -443,67 +462,79 @@ void VprDeviceAnnotation::add_physical_pb_graph_node(t_pb_graph_node* operating_
 }
 
 void VprDeviceAnnotation::add_physical_pb_type_index_factor(t_pb_type* pb_type, const float& factor) {
+  t_pb_type_annotation& annotation = mutable_pb_type_annotation(pb_type);
   /* Warn any override attempt */
-  std::map<t_pb_type*, float>::const_iterator it = physical_pb_type_index_factors_.find(pb_type);
-  if (it != physical_pb_type_index_factors_.end()) {
+  if (true == annotation.has_index_factor) {
     VTR_LOG_WARN("Override the annotation between operating pb_type '%s' and it physical pb_type index factor '%f'!\n",
                  pb_type->name, factor);
   }
 
-  physical_pb_type_index_factors_[pb_type] = factor;
+  annotation.has_index_factor = true;
+  annotation.index_factor = factor;
 }
 
 void VprDeviceAnnotation::add_physical_pb_type_index_offset(t_pb_type* pb_type, const int& offset) {
+  t_pb_type_annotation& annotation = mutable_pb_type_annotation(pb_type);
   /* Warn any override attempt */
-  std::map<t_pb_type*, int>::const_iterator it = physical_pb_type_index_offsets_.find(pb_type);
-  if (it != physical_pb_type_index_offsets_.end()) {
+  if (true == annotation.has_index_offset) {
     VTR_LOG_WARN("Override the annotation between operating pb_type '%s' and it physical pb_type index offset '%d'!\n",
                  pb_type->name, offset);
   }
 
-  physical_pb_type_index_offsets_[pb_type] = offset;
+  annotation.has_index_offset = true;
+  annotation.index_offset = offset;
 }
 
 void VprDeviceAnnotation::add_physical_pb_pin_initial_offset(t_port* operating_pb_port,
                                                              t_port* physical_pb_port,
                                                              const int& offset) {
+  t_port_pair_annotation& annotation = mutable_port_pair_annotation(operating_pb_port, physical_pb_port);
   /* Warn any override attempt */
-  std::map<t_port*, std::map<t_port*, int>>::const_iterator it = physical_pb_pin_initial_offsets_.find(operating_pb_port);
-  if ( (it != physical_pb_pin_initial_offsets_.end())
-    && (0 < physical_pb_pin_initial_offsets_[operating_pb_port].count(physical_pb_port)) ) {
-    VTR_LOG_WARN("Override the annotation between operating pb_port '%s' and it physical pb_port '%s' pin rotate offset '%d'!\n",
-                 operating_pb_port->name, offset);
+  if (true == annotation.has_initial_offset) {
+    VTR_LOG_WARN("Override the annotation between operating pb_port '%s' and it physical pb_port '%s' pin initial offset '%d'!\n",
+                 operating_pb_port->name, physical_pb_port->name, offset);
   }
 
-  physical_pb_pin_initial_offsets_[operating_pb_port][physical_pb_port] = offset;
+  annotation.has_initial_offset = true;
+  annotation.initial_offset = offset;
 }
 
 void VprDeviceAnnotation::add_physical_pb_pin_rotate_offset(t_port* operating_pb_port,
                                                             t_port* physical_pb_port,
                                                             const int& offset) {
+  t_port_pair_annotation& annotation = mutable_port_pair_annotation(operating_pb_port, physical_pb_port);
   /* Warn any override attempt */
-  std::map<t_port*, std::map<t_port*, int>>::const_iterator it = physical_pb_pin_rotate_offsets_.find(operating_pb_port);
-  if ( (it != physical_pb_pin_rotate_offsets_.end())
-    && (0 < physical_pb_pin_rotate_offsets_[operating_pb_port].count(physical_pb_port)) ) {
+  if (true == annotation.has_rotate_offset) {
     VTR_LOG_WARN("Override the annotation between operating pb_port '%s' and it physical pb_port '%s' pin rotate offset '%d'!\n",
-                 operating_pb_port->name, offset);
+                 operating_pb_port->name, physical_pb_port->name, offset);
   }
 
-  physical_pb_pin_rotate_offsets_[operating_pb_port][physical_pb_port] = offset;
+  annotation.has_rotate_offset = true;
+  annotation.rotate_offset = offset;
   /* We initialize the accumulated offset to 0 */
-  physical_pb_pin_offsets_[operating_pb_port][physical_pb_port] = 0;
+  annotation.offset = 0;
 }
 
 void VprDeviceAnnotation::add_physical_pb_graph_pin(const t_pb_graph_pin* operating_pb_graph_pin, 
                                                     t_pb_graph_pin* physical_pb_graph_pin) {
+  /* Find the top-level pb_graph_node, whose pins are indexed in the look-up */
+  const t_pb_graph_node* pb_graph_head = operating_pb_graph_pin->parent_node;
+  while (nullptr != pb_graph_head->parent_pb_graph_node) {
+    pb_graph_head = pb_graph_head->parent_pb_graph_node;
+  }
+  std::vector<t_pb_graph_pin*>& physical_pb_graph_pins = physical_pb_graph_pins_[pb_graph_head];
+  if (physical_pb_graph_pins.empty()) {
+    physical_pb_graph_pins.resize(pb_graph_head->total_pb_pins, nullptr);
+  }
+  VTR_ASSERT((size_t)operating_pb_graph_pin->pin_count_in_cluster < physical_pb_graph_pins.size());
+
   /* Warn any override attempt */
-  std::map<const t_pb_graph_pin*, t_pb_graph_pin*>::const_iterator it = physical_pb_graph_pins_.find(operating_pb_graph_pin);
-  if (it != physical_pb_graph_pins_.end()) {
+  if (nullptr != physical_pb_graph_pins[operating_pb_graph_pin->pin_count_in_cluster]) {
     VTR_LOG_WARN("Override the annotation between operating pb_graph_pin '%s' and it physical pb_graph_pin '%s'!\n",
                  operating_pb_graph_pin->port->name, physical_pb_graph_pin->port->name);
   }
 
-  physical_pb_graph_pins_[operating_pb_graph_pin] = physical_pb_graph_pin;
+  physical_pb_graph_pins[operating_pb_graph_pin->pin_count_in_cluster] = physical_pb_graph_pin;
 
   /* Update the accumulated offsets for the operating port 
    * Each time we pair two pins, we update the offset by the pin rotate offset
@@ -521,20 +552,24 @@ void VprDeviceAnnotation::add_physical_pb_graph_pin(const t_pb_graph_pin* operat
     return;
   }
 
-  physical_pb_pin_offsets_[operating_pb_graph_pin->port][physical_pb_graph_pin->port] += physical_pb_pin_rotate_offset(operating_pb_graph_pin->port, physical_pb_graph_pin->port);
+  t_port_pair_annotation& port_pair = mutable_port_pair_annotation(operating_pb_graph_pin->port, physical_pb_graph_pin->port);
+  port_pair.offset += port_pair.rotate_offset;
 
   if ((size_t)physical_pb_graph_pin->port->num_pins - 1 
     < operating_pb_graph_pin->pin_number
     + physical_pb_port_range(operating_pb_graph_pin->port, physical_pb_graph_pin->port).get_lsb() 
-    + physical_pb_pin_offsets_[operating_pb_graph_pin->port][physical_pb_graph_pin->port]) {
-    physical_pb_pin_offsets_[operating_pb_graph_pin->port][physical_pb_graph_pin->port] = 0;
+    + port_pair.offset) {
+    port_pair.offset = 0;
   }
 }
 
 void VprDeviceAnnotation::add_rr_switch_circuit_model(const RRSwitchId& rr_switch, const CircuitModelId& circuit_model) {
+  VTR_ASSERT(true == bool(rr_switch));
+  if (size_t(rr_switch) >= rr_switch_circuit_models_.size()) {
+    rr_switch_circuit_models_.resize(size_t(rr_switch) + 1, CircuitModelId::INVALID());
+  }
   /* Warn any override attempt */
-  std::map<RRSwitchId, CircuitModelId>::const_iterator it = rr_switch_circuit_models_.find(rr_switch);
-  if (it != rr_switch_circuit_models_.end()) {
+  if (CircuitModelId::INVALID() != rr_switch_circuit_models_[rr_switch]) {
     VTR_LOG_WARN("Override the annotation between rr_switch '%ld' and its circuit_model '%ld'!\n",
                  size_t(rr_switch), size_t(circuit_model));
   }
@@ -543,9 +578,12 @@ void VprDeviceAnnotation::add_rr_switch_circuit_model(const RRSwitchId& rr_switc
 }
 
 void VprDeviceAnnotation::add_rr_segment_circuit_model(const RRSegmentId& rr_segment, const CircuitModelId& circuit_model) {
+  VTR_ASSERT(true == bool(rr_segment));
+  if (size_t(rr_segment) >= rr_segment_circuit_models_.size()) {
+    rr_segment_circuit_models_.resize(size_t(rr_segment) + 1, CircuitModelId::INVALID());
+  }
   /* Warn any override attempt */
-  std::map<RRSegmentId, CircuitModelId>::const_iterator it = rr_segment_circuit_models_.find(rr_segment);
-  if (it != rr_segment_circuit_models_.end()) {
+  if (CircuitModelId::INVALID() != rr_segment_circuit_models_[rr_segment]) {
     VTR_LOG_WARN("Override the annotation between rr_segment '%ld' and its circuit_model '%ld'!\n",
                  size_t(rr_segment), size_t(circuit_model));
   }
@@ -554,8 +592,11 @@ void VprDeviceAnnotation::add_rr_segment_circuit_model(const RRSegmentId& rr_seg
 }
 
 void VprDeviceAnnotation::add_direct_annotation(const size_t& direct, const ArchDirectId& arch_direct_id) {
+  if (direct >= direct_annotations_.size()) {
+    direct_annotations_.resize(direct + 1, ArchDirectId::INVALID());
+  }
   /* Warn any override attempt */
-  if (0 < direct_annotations_.count(direct)) {
+  if (ArchDirectId::INVALID() != direct_annotations_[direct]) {
     VTR_LOG_WARN("Override the annotation between direct '%ld' and its annotation '%ld'!\n",
                  size_t(direct), size_t(arch_direct_id));
   }
@@ -573,16 +614,105 @@ void VprDeviceAnnotation::add_physical_lb_rr_graph(t_pb_graph_node* pb_graph_hea
   physical_lb_rr_graphs_[pb_graph_head] = lb_rr_graph;
 }
 
+LbRRGraph& VprDeviceAnnotation::mutable_physical_lb_rr_graph(t_pb_graph_node* pb_graph_head) {
+  auto it = physical_lb_rr_graphs_.find(pb_graph_head);
+  VTR_ASSERT(it != physical_lb_rr_graphs_.end());
+  return it->second;
+}
+
+void VprDeviceAnnotation::clear_physical_lb_rr_graphs() {
+  physical_lb_rr_graphs_.clear();
+}
+
 void VprDeviceAnnotation::add_physical_tile_pin2port_info_pair(t_physical_tile_type_ptr physical_tile,
                                                                const int& pin_index,
                                                                const BasicPort& port) {
-  physical_tile_pin2port_info_map_[physical_tile][pin_index] = port;
+  VTR_ASSERT(0 <= pin_index);
+  std::vector<BasicPort>& pin2port_info = physical_tile_pin2port_info_map_[physical_tile];
+  if ((size_t)pin_index >= pin2port_info.size()) {
+    pin2port_info.resize(pin_index + 1);
+  }
+  pin2port_info[pin_index] = port;
 }
 
 void VprDeviceAnnotation::add_physical_tile_pin_subtile_index(t_physical_tile_type_ptr physical_tile,
                                                               const int& pin_index,
                                                               const int& subtile_index) {
-  physical_tile_pin_subtile_indices_[physical_tile][pin_index] = subtile_index;
+  VTR_ASSERT(0 <= pin_index);
+  std::vector<int>& pin_subtile_indices = physical_tile_pin_subtile_indices_[physical_tile];
+  if ((size_t)pin_index >= pin_subtile_indices.size()) {
+    pin_subtile_indices.resize(pin_index + 1, -1);
+  }
+  pin_subtile_indices[pin_index] = subtile_index;
+}
+
+/************************************************************************
+ * Internal look-up
+ ***********************************************************************/
+const VprDeviceAnnotation::t_pb_type_annotation* VprDeviceAnnotation::find_pb_type_annotation(const t_pb_type* pb_type) const {
+  auto it = pb_type_annotation_indices_.find(pb_type);
+  if (it == pb_type_annotation_indices_.end()) {
+    return nullptr;
+  }
+  return &(pb_type_annotations_[it->second]);
+}
+
+const VprDeviceAnnotation::t_port_annotation* VprDeviceAnnotation::find_port_annotation(const t_port* pb_port) const {
+  const t_pb_type_annotation* pb_type_annotation = find_pb_type_annotation(pb_port->parent_pb_type);
+  if (nullptr == pb_type_annotation) {
+    return nullptr;
+  }
+  /* Ports are indexed by their position in the pb_type */
+  size_t port_index = pb_port - pb_port->parent_pb_type->ports;
+  if (port_index >= pb_type_annotation->ports.size()) {
+    return nullptr;
+  }
+  return &(pb_type_annotation->ports[port_index]);
+}
+
+const VprDeviceAnnotation::t_port_pair_annotation* VprDeviceAnnotation::find_port_pair_annotation(const t_port* operating_pb_port,
+                                                                                                  const t_port* physical_pb_port) const {
+  const t_port_annotation* port_annotation = find_port_annotation(operating_pb_port);
+  if (nullptr == port_annotation) {
+    return nullptr;
+  }
+  /* An operating port is paired to a few physical ports, a linear search is fast enough */
+  for (const t_port_pair_annotation& port_pair : port_annotation->port_pairs) {
+    if (physical_pb_port == port_pair.physical_pb_port) {
+      return &port_pair;
+    }
+  }
+  return nullptr;
+}
+
+VprDeviceAnnotation::t_pb_type_annotation& VprDeviceAnnotation::mutable_pb_type_annotation(t_pb_type* pb_type) {
+  auto result = pb_type_annotation_indices_.insert(std::make_pair(pb_type, pb_type_annotations_.size()));
+  if (true == result.second) {
+    pb_type_annotations_.emplace_back();
+    pb_type_annotations_.back().ports.resize(pb_type->num_ports);
+  }
+  return pb_type_annotations_[result.first->second];
+}
+
+VprDeviceAnnotation::t_port_annotation& VprDeviceAnnotation::mutable_port_annotation(t_port* pb_port) {
+  t_pb_type_annotation& pb_type_annotation = mutable_pb_type_annotation(pb_port->parent_pb_type);
+  /* Ports are indexed by their position in the pb_type */
+  size_t port_index = pb_port - pb_port->parent_pb_type->ports;
+  VTR_ASSERT(port_index < pb_type_annotation.ports.size());
+  return pb_type_annotation.ports[port_index];
+}
+
+VprDeviceAnnotation::t_port_pair_annotation& VprDeviceAnnotation::mutable_port_pair_annotation(t_port* operating_pb_port,
+                                                                                               t_port* physical_pb_port) {
+  t_port_annotation& port_annotation = mutable_port_annotation(operating_pb_port);
+  for (t_port_pair_annotation& port_pair : port_annotation.port_pairs) {
+    if (physical_pb_port == port_pair.physical_pb_port) {
+      return port_pair;
+    }
+  }
+  port_annotation.port_pairs.emplace_back();
+  port_annotation.port_pairs.back().physical_pb_port = physical_pb_port;
+  return port_annotation.port_pairs.back();
 }
 
 } /* End namespace openfpga*/
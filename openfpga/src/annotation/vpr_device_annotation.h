@@ -5,9 +5,12 @@
  * Include header files required by the data structure definition
  *******************************************************************/
 #include <map> 
+#include <unordered_map> 
+#include <vector> 
 
 /* Header from vtrutil library */
 #include "vtr_strong_id.h"
+#include "vtr_vector.h"
 
 /* Header from archfpga library */
 #include "physical_types.h"
@@ -80,11 +83,18 @@ class VprDeviceAnnotation {
     CircuitModelId rr_switch_circuit_model(const RRSwitchId& rr_switch) const;
     CircuitModelId rr_segment_circuit_model(const RRSegmentId& rr_segment) const;
     ArchDirectId direct_annotation(const size_t& direct) const;
-    LbRRGraph physical_lb_rr_graph(t_pb_graph_node* pb_graph_head) const;
+    bool has_physical_lb_rr_graph(t_pb_graph_node* pb_graph_head) const;
+    const LbRRGraph& physical_lb_rr_graph(t_pb_graph_node* pb_graph_head) const;
     BasicPort physical_tile_pin_port_info(t_physical_tile_type_ptr physical_tile,
                                           const int& pin_index) const;
     int physical_tile_pin_subtile_index(t_physical_tile_type_ptr physical_tile,
                                         const int& pin_index) const;
+    /* Estimate the heap memory (in bytes) held by the annotation, 
+     * excluding the physical routing resource graphs of logical blocks
+     */
+    size_t memory_usage() const;
+    /* Estimate the heap memory (in bytes) held by the physical routing resource graphs of logical blocks */
+    size_t physical_lb_rr_graph_memory_usage() const;
   public:  /* Public mutators */
     void add_pb_type_physical_mode(t_pb_type* pb_type, t_mode* physical_mode);
     void add_physical_pb_type(t_pb_type* operating_pb_type, t_pb_type* physical_pb_type);
@@ -114,104 +124,154 @@ class VprDeviceAnnotation {
     void add_rr_segment_circuit_model(const RRSegmentId& rr_segment, const CircuitModelId& circuit_model);
     void add_direct_annotation(const size_t& direct, const ArchDirectId& arch_direct_id);
     void add_physical_lb_rr_graph(t_pb_graph_node* pb_graph_head, const LbRRGraph& lb_rr_graph);
+    /* Get a physical routing resource graph which has been added, e.g., to build its lookahead */
+    LbRRGraph& mutable_physical_lb_rr_graph(t_pb_graph_node* pb_graph_head);
+    /* Release the physical routing resource graphs of logical blocks, 
+     * which are only used by repacking. They will be built again by a next repacking
+     */
+    void clear_physical_lb_rr_graphs();
     void add_physical_tile_pin2port_info_pair(t_physical_tile_type_ptr physical_tile,
                                               const int& pin_index,
                                               const BasicPort& port);
     void add_physical_tile_pin_subtile_index(t_physical_tile_type_ptr physical_tile,
                                              const int& pin_index,
                                              const int& subtile_index);
-  private: /* Internal data */
-    /* Pair a regular pb_type to its physical pb_type */
-    std::map<t_pb_type*, t_pb_type*> physical_pb_types_;
-    std::map<t_pb_type*, float> physical_pb_type_index_factors_;
-    std::map<t_pb_type*, int> physical_pb_type_index_offsets_;
+  private: /* Internal types */
+    /* Annotation between an operating pb_port and one of its physical pb_ports */
+    struct t_port_pair_annotation {
+      t_port* physical_pb_port = nullptr;
+      bool has_range = false;
+      BasicPort range;
+      bool has_initial_offset = false;
+      int initial_offset = 0;
+      bool has_rotate_offset = false;
+      int rotate_offset = 0;
+      /* Accumulated offsets for a physical pb_type port, just for internal usage */
+      int offset = 0;
+    };
 
-    /* Pair a physical mode for a pb_type
-     * Note:
-     * - the physical mode MUST be a child mode of the pb_type
-     * - the pb_type MUST be a physical pb_type itself
-     */
-    std::map<t_pb_type*, t_mode*> physical_pb_modes_;
+    /* Annotation of a pb_port */
+    struct t_port_annotation {
+      /* Pair a pb_port to its physical pb_ports 
+       * Note:
+       * - the parent of physical pb_port MUST be a physical pb_type
+       */
+      std::vector<t_port*> physical_pb_ports;
+      /* Offsets and port ranges, one for each physical pb_port that is paired */
+      std::vector<t_port_pair_annotation> port_pairs;
+      /* Pair a pb_port to a circuit port in circuit model
+       * Note:
+       * - the parent of physical pb_port MUST be a physical pb_type
+       */
+      CircuitPortId circuit_port = CircuitPortId::INVALID();
 
-    /* Pair a physical pb_type to its circuit model
-     * Note:
-     * - the pb_type MUST be a physical pb_type itself
-     */
-    std::map<t_pb_type*, CircuitModelId> pb_type_circuit_models_;
+      size_t memory_usage() const;
+    };
 
-    /* Pair a interconnect of a physical pb_type to its circuit model
-     * Note:
-     * - the pb_type MUST be a physical pb_type itself
-     */
-    std::map<t_interconnect*, CircuitModelId> interconnect_circuit_models_;
+    /* Annotation of a pb_type */
+    struct t_pb_type_annotation {
+      /* Pair a regular pb_type to its physical pb_type */
+      t_pb_type* physical_pb_type = nullptr;
+      bool has_index_factor = false;
+      float index_factor = 1.;
+      bool has_index_offset = false;
+      int index_offset = 0;
 
-    /* Physical type of interconnect 
-     * Note:
-     * - only applicable to an interconnect belongs to physical mode
-     */
-    std::map<t_interconnect*, e_interconnect> interconnect_physical_types_;
+      /* Pair a physical mode for a pb_type
+       * Note:
+       * - the physical mode MUST be a child mode of the pb_type
+       * - the pb_type MUST be a physical pb_type itself
+       */
+      t_mode* physical_mode = nullptr;
 
-    /* Pair a pb_type to its mode selection bits
-     * - if the pb_type is a physical pb_type, the mode bits are the default mode 
-     *   where the physical pb_type will operate when used
-     * - if the pb_type is an operating pb_type, the mode bits will be applied
-     *   when the operating pb_type is used by packer
-     */
-    std::map<t_pb_type*, std::vector<size_t>> pb_type_mode_bits_;
+      /* Pair a physical pb_type to its circuit model
+       * Note:
+       * - the pb_type MUST be a physical pb_type itself
+       */
+      CircuitModelId circuit_model = CircuitModelId::INVALID();
 
-    /* Pair a pb_port to its physical pb_port 
-     * Note:
-     * - the parent of physical pb_port MUST be a physical pb_type
-     */
-    std::map<t_port*, std::vector<t_port*>> physical_pb_ports_;
-    std::map<t_port*, std::map<t_port*, int>> physical_pb_pin_initial_offsets_;
-    std::map<t_port*, std::map<t_port*, int>> physical_pb_pin_rotate_offsets_;
+      /* Pair a pb_type to its mode selection bits
+       * - if the pb_type is a physical pb_type, the mode bits are the default mode 
+       *   where the physical pb_type will operate when used
+       * - if the pb_type is an operating pb_type, the mode bits will be applied
+       *   when the operating pb_type is used by packer
+       */
+      bool has_mode_bits = false;
+      std::vector<size_t> mode_bits;
 
-    /* Accumulated offsets for a physical pb_type port, just for internal usage */
-    std::map<t_port*, std::map<t_port*, int>> physical_pb_pin_offsets_;
+      /* Pair each pb_graph_node to an unique index in the graph
+       * The unique index if the index in the array of t_pb_graph_node*
+       */ 
+      std::vector<t_pb_graph_node*> pb_graph_nodes;
 
-    /* Pair a pb_port to its LSB and MSB of a physical pb_port 
+      /* Annotation of each port, indexed by the position of the port in the pb_type */
+      std::vector<t_port_annotation> ports;
+
+      size_t memory_usage() const;
+    };
+
+  private: /* Internal look-up */
+    /* Find the annotation of a pb_type or a pb_port, return nullptr if not annotated */
+    const t_pb_type_annotation* find_pb_type_annotation(const t_pb_type* pb_type) const;
+    const t_port_annotation* find_port_annotation(const t_port* pb_port) const;
+    const t_port_pair_annotation* find_port_pair_annotation(const t_port* operating_pb_port,
+                                                            const t_port* physical_pb_port) const;
+    /* Find the annotation of a pb_type or a pb_port, create one if not annotated */
+    t_pb_type_annotation& mutable_pb_type_annotation(t_pb_type* pb_type);
+    t_port_annotation& mutable_port_annotation(t_port* pb_port);
+    t_port_pair_annotation& mutable_port_pair_annotation(t_port* operating_pb_port,
+                                                         t_port* physical_pb_port);
+
+  private: /* Internal data */
+    /* Each annotated pb_type has a dense index to its annotation
+     * All the annotations of the pb_type and its ports are accessed 
+     * by a single look-up to the dense index
+     */
+    std::unordered_map<const t_pb_type*, size_t> pb_type_annotation_indices_;
+    std::vector<t_pb_type_annotation> pb_type_annotations_;
+
+    /* Pair a interconnect of a physical pb_type to its circuit model
      * Note:
-     * - the LSB and MSB MUST be in range of the physical pb_port
+     * - the pb_type MUST be a physical pb_type itself
      */
-    std::map<t_port*, std::map<t_port*, BasicPort>> physical_pb_port_ranges_;
+    std::unordered_map<const t_interconnect*, CircuitModelId> interconnect_circuit_models_;
 
-    /* Pair a pb_port to a circuit port in circuit model
+    /* Physical type of interconnect 
      * Note:
-     * - the parent of physical pb_port MUST be a physical pb_type
+     * - only applicable to an interconnect belongs to physical mode
      */
-    std::map<t_port*, CircuitPortId> pb_circuit_ports_;
+    std::unordered_map<const t_interconnect*, e_interconnect> interconnect_physical_types_;
 
-    /* Pair each pb_graph_node to an unique index in the graph
-     * The unique index if the index in the array of t_pb_graph_node*
-     */ 
-    std::map<t_pb_type*, std::vector<t_pb_graph_node*>> pb_graph_node_unique_index_;
+    /* Reverse look-up of the unique index of each pb_graph_node */
+    std::unordered_map<const t_pb_graph_node*, PbGraphNodeId> pb_graph_node_unique_indices_;
 
     /* Pair a pb_graph_node to a physical pb_graph_node
      * Note:
      * - the pb_type of physical pb_graph_node must be a physical pb_type
      */
-    std::map<t_pb_graph_node*, t_pb_graph_node*> physical_pb_graph_nodes_;
+    std::unordered_map<const t_pb_graph_node*, t_pb_graph_node*> physical_pb_graph_nodes_;
 
-    /* Pair a pb_graph_pin to a physical pb_graph_pin */
-    std::map<const t_pb_graph_pin*, t_pb_graph_pin*> physical_pb_graph_pins_;
+    /* Pair a pb_graph_pin to a physical pb_graph_pin
+     * Pins are indexed by their pin_count_in_cluster in the pb_graph of their top-level pb_graph_node
+     */
+    std::unordered_map<const t_pb_graph_node*, std::vector<t_pb_graph_pin*>> physical_pb_graph_pins_;
 
     /* Pair a Routing Resource Switch (rr_switch) to a circuit model */
-    std::map<RRSwitchId, CircuitModelId> rr_switch_circuit_models_;
+    vtr::vector<RRSwitchId, CircuitModelId> rr_switch_circuit_models_;
 
     /* Pair a Routing Segment (rr_segment) to a circuit model */
-    std::map<RRSegmentId, CircuitModelId> rr_segment_circuit_models_;
+    vtr::vector<RRSegmentId, CircuitModelId> rr_segment_circuit_models_;
 
     /* Pair a direct connection (direct) to a annotation which contains circuit model id */
-    std::map<size_t, ArchDirectId> direct_annotations_;
+    std::vector<ArchDirectId> direct_annotations_;
 
     /* Logical type routing resource graphs built from physical modes */
     std::map<t_pb_graph_node*, LbRRGraph> physical_lb_rr_graphs_;
 
     /* A fast look-up from pin index in physical tile to physical tile port */
-    std::map<t_physical_tile_type_ptr, std::map<int, BasicPort>> physical_tile_pin2port_info_map_;
+    std::unordered_map<t_physical_tile_type_ptr, std::vector<BasicPort>> physical_tile_pin2port_info_map_;
     /* A fast look-up from pin index in physical tile to sub tile index */
-    std::map<t_physical_tile_type_ptr, std::map<int, int>> physical_tile_pin_subtile_indices_;
+    std::unordered_map<t_physical_tile_type_ptr, std::vector<int>> physical_tile_pin_subtile_indices_;
 };
 
 } /* End namespace openfpga*/
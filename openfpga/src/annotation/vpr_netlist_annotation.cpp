@@ -19,49 +19,57 @@ VprNetlistAnnotation::VprNetlistAnnotation() {
  * Public accessors
  ***********************************************************************/
 bool VprNetlistAnnotation::is_block_renamed(const AtomBlockId& block) const {
-  /* Ensure that the pb_type is in the list */
-  std::map<AtomBlockId, std::string>::const_iterator it = block_names_.find(block);
-  return it != block_names_.end();
+  return (size_t(block) < block_names_.size())
+      && (false == block_names_[block].empty());
 }
 
 std::string VprNetlistAnnotation::block_name(const AtomBlockId& block) const {
   VTR_ASSERT(true == is_block_renamed(block));
-  return block_names_.at(block);
+  return block_names_[block];
 }
 
 bool VprNetlistAnnotation::is_net_renamed(const AtomNetId& net) const {
-  /* Ensure that the pb_type is in the list */
-  std::map<AtomNetId, std::string>::const_iterator it = net_names_.find(net);
-  return it != net_names_.end();
+  return (size_t(net) < net_names_.size())
+      && (false == net_names_[net].empty());
 }
 
 std::string VprNetlistAnnotation::net_name(const AtomNetId& net) const {
   VTR_ASSERT(true == is_net_renamed(net));
-  return net_names_.at(net);
+  return net_names_[net];
 }
 
 /************************************************************************
  * Public mutators
  ***********************************************************************/
 void VprNetlistAnnotation::rename_block(const AtomBlockId& block, const std::string& name) {
+  VTR_ASSERT(true == bool(block));
+  VTR_ASSERT(false == name.empty());
+
   /* Warn any override attempt */
-  std::map<AtomBlockId, std::string>::const_iterator it = block_names_.find(block);
-  if (it != block_names_.end()) {
+  if (true == is_block_renamed(block)) {
     VTR_LOG_WARN("Override the block with name '%s' in netlist annotation!\n",
                  name.c_str());
   }
 
+  if (size_t(block) >= block_names_.size()) {
+    block_names_.resize(size_t(block) + 1);
+  }
   block_names_[block] = name;
 }
 
 void VprNetlistAnnotation::rename_net(const AtomNetId& net, const std::string& name) {
+  VTR_ASSERT(true == bool(net));
+  VTR_ASSERT(false == name.empty());
+
   /* Warn any override attempt */
-  std::map<AtomNetId, std::string>::const_iterator it = net_names_.find(net);
-  if (it != net_names_.end()) {
+  if (true == is_net_renamed(net)) {
     VTR_LOG_WARN("Override the net with name '%s' in netlist annotation!\n",
                  name.c_str());
   }
 
+  if (size_t(net) >= net_names_.size()) {
+    net_names_.resize(size_t(net) + 1);
+  }
   net_names_[net] = name;
 }
 
@@ -4,7 +4,10 @@
 /********************************************************************
  * Include header files required by the data structure definition
  *******************************************************************/
-#include <map> 
+#include <string>
+
+/* Header from vtrutil library */
+#include "vtr_vector.h"
 
 /* Header from vpr library */
 #include "atom_netlist.h"
@@ -33,9 +36,11 @@ class VprNetlistAnnotation {
     void rename_block(const AtomBlockId& block, const std::string& name);
     void rename_net(const AtomNetId& net, const std::string& name);
   private: /* Internal data */
-    /* Pair a regular pb_type to its physical pb_type */
-    std::map<AtomBlockId, std::string> block_names_;
-    std::map<AtomNetId, std::string> net_names_;
+    /* New names of blocks and nets, indexed by their ids
+     * An empty name means that the block/net is not renamed
+     */
+    vtr::vector<AtomBlockId, std::string> block_names_;
+    vtr::vector<AtomNetId, std::string> net_names_;
 };
 
 } /* End namespace openfpga*/
@@ -30,12 +30,39 @@ RRNodeId VprRoutingAnnotation::rr_node_prev_node(const RRNodeId& rr_node) const
   return rr_node_prev_nodes_[rr_node];
 }
 
+TileGlobalPortId VprRoutingAnnotation::net_global_port(const ClusterNetId& net_id) const {
+  /* Nets out of the list are not delivered by any global port */
+  if (size_t(net_id) >= net_global_ports_.size()) {
+    return TileGlobalPortId::INVALID();
+  }
+  return net_global_ports_[net_id];
+}
+
+size_t VprRoutingAnnotation::net_global_port_pin(const ClusterNetId& net_id) const {
+  VTR_ASSERT(TileGlobalPortId::INVALID() != net_global_port(net_id));
+  return net_global_port_pins_[net_id];
+}
+
+bool VprRoutingAnnotation::has_gsb_num_used_nodes() const {
+  return false == gsb_num_used_nodes_.empty();
+}
+
+size_t VprRoutingAnnotation::gsb_num_used_nodes(const vtr::Point<size_t>& gsb_coord) const {
+  VTR_ASSERT(true == has_gsb_num_used_nodes());
+  VTR_ASSERT( (gsb_coord.x() < gsb_num_used_nodes_.dim_size(0))
+           && (gsb_coord.y() < gsb_num_used_nodes_.dim_size(1)) );
+  return gsb_num_used_nodes_[gsb_coord.x()][gsb_coord.y()];
+}
+
 /************************************************************************
  * Public mutators
  ***********************************************************************/
 void VprRoutingAnnotation::init(const RRGraph& rr_graph) {
   rr_node_nets_.resize(rr_graph.nodes().size(), ClusterNetId::INVALID());
   rr_node_prev_nodes_.resize(rr_graph.nodes().size(), RRNodeId::INVALID());
+  net_global_ports_.clear();
+  net_global_port_pins_.clear();
+  gsb_num_used_nodes_.clear();
 }
 
 void VprRoutingAnnotation::set_rr_node_net(const RRNodeId& rr_node,
@@ -50,6 +77,11 @@ void VprRoutingAnnotation::set_rr_node_net(const RRNodeId& rr_node,
   }
 
   rr_node_nets_[rr_node] = net_id;
+
+  /* The counts of used nodes are outdated */
+  if (true == has_gsb_num_used_nodes()) {
+    gsb_num_used_nodes_.clear();
+  }
 }
 
 void VprRoutingAnnotation::set_rr_node_prev_node(const RRNodeId& rr_node,
@@ -66,4 +98,20 @@ void VprRoutingAnnotation::set_rr_node_prev_node(const RRNodeId& rr_node,
   rr_node_prev_nodes_[rr_node] = prev_node;
 }
 
+void VprRoutingAnnotation::set_net_global_port(const ClusterNetId& net_id,
+                                               const TileGlobalPortId& global_port,
+                                               const size_t& global_port_pin) {
+  VTR_ASSERT(ClusterNetId::INVALID() != net_id);
+  if (size_t(net_id) >= net_global_ports_.size()) {
+    net_global_ports_.resize(size_t(net_id) + 1, TileGlobalPortId::INVALID());
+    net_global_port_pins_.resize(size_t(net_id) + 1, size_t(-1));
+  }
+  net_global_ports_[net_id] = global_port;
+  net_global_port_pins_[net_id] = global_port_pin;
+}
+
+void VprRoutingAnnotation::set_gsb_num_used_nodes(const vtr::Matrix<size_t>& gsb_num_used_nodes) {
+  gsb_num_used_nodes_ = gsb_num_used_nodes;
+}
+
 } /* End namespace openfpga*/
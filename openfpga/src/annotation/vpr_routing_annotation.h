@@ -6,9 +6,16 @@
  *******************************************************************/
 #include <map> 
 
+/* Header from vtrutil library */
+#include "vtr_geometry.h"
+#include "vtr_ndmatrix.h"
+
 /* Header from vpr library */
 #include "vpr_context.h"
 
+/* Header from archopenfpga library */
+#include "tile_annotation_fwd.h"
+
 /* Begin namespace openfpga */
 namespace openfpga {
 
@@ -27,18 +34,37 @@ class VprRoutingAnnotation {
   public:  /* Public accessors */
     ClusterNetId rr_node_net(const RRNodeId& rr_node) const;
     RRNodeId rr_node_prev_node(const RRNodeId& rr_node) const;
+    /* Tile global port delivering a net through its dedicated network, invalid id if the net is routed */
+    TileGlobalPortId net_global_port(const ClusterNetId& net_id) const;
+    size_t net_global_port_pin(const ClusterNetId& net_id) const;
+    /* Number of rr_nodes of a GSB which are mapped to nets,
+     * available only after being counted and until a node is mapped again
+     */
+    bool has_gsb_num_used_nodes() const;
+    size_t gsb_num_used_nodes(const vtr::Point<size_t>& gsb_coord) const;
   public:  /* Public mutators */
     void init(const RRGraph& rr_graph);
     void set_rr_node_net(const RRNodeId& rr_node,
                          const ClusterNetId& net_id);
     void set_rr_node_prev_node(const RRNodeId& rr_node,
                                const RRNodeId& prev_node);
+    void set_net_global_port(const ClusterNetId& net_id,
+                             const TileGlobalPortId& global_port,
+                             const size_t& global_port_pin);
+    void set_gsb_num_used_nodes(const vtr::Matrix<size_t>& gsb_num_used_nodes);
   private: /* Internal data */
     /* Clustered net ids mapped to each rr_node */
     vtr::vector<RRNodeId, ClusterNetId> rr_node_nets_;
 
     /* Previous rr_node driving each rr_node */
     vtr::vector<RRNodeId, RRNodeId> rr_node_prev_nodes_;
+
+    /* Tile global port (and the pin of the port) delivering each clustered net */
+    vtr::vector<ClusterNetId, TileGlobalPortId> net_global_ports_;
+    vtr::vector<ClusterNetId, size_t> net_global_port_pins_;
+
+    /* Number of used rr_nodes in each GSB: [x][y] */
+    vtr::Matrix<size_t> gsb_num_used_nodes_;
 };
 
 } /* End namespace openfpga*/
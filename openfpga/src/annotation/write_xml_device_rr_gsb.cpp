@@ -1,6 +1,8 @@
 /***************************************************************************************
  * Output internal structure of DeviceRRGSB to XML format 
  ***************************************************************************************/
+#include <vector>
+
 /* Headers from vtrutil library */
 #include "vtr_log.h"
 #include "vtr_assert.h"
@@ -9,6 +11,7 @@
 /* Headers from openfpgautil library */
 #include "openfpga_side_manager.h"
 #include "openfpga_digest.h"
+#include "openfpga_parallel.h"
 
 #include "openfpga_naming.h"
 #include "openfpga_rr_graph_utils.h"
@@ -20,22 +23,18 @@ namespace openfpga {
 
 /***************************************************************************************
  * Output internal structure (only the switch block part) of a RRGSB to XML format 
+ * Return the name of the XML file
  ***************************************************************************************/
 static 
-void write_rr_switch_block_to_xml(const std::string fname_prefix,
-                                  const RRGraph& rr_graph,
-                                  const RRGSB& rr_gsb,
-                                  const bool& verbose) {
+std::string write_rr_switch_block_to_xml(const std::string fname_prefix,
+                                         const RRGraph& rr_graph,
+                                         const RRGSB& rr_gsb) {
   /* Prepare file name */
   std::string fname(fname_prefix);
   vtr::Point<size_t> gsb_coordinate(rr_gsb.get_sb_x(), rr_gsb.get_sb_y());
   fname += generate_switch_block_module_name(gsb_coordinate);
   fname += ".xml";
 
-  VTR_LOGV(verbose,
-           "Output internal structure of Switch Block to '%s'\n",
-           fname.c_str());
-
   /* Create a file handler*/
   std::fstream fp;
   /* Open a file */
@@ -61,11 +60,11 @@ void write_rr_switch_block_to_xml(const std::string fname_prefix,
          << " side=\"" << gsb_side_manager.to_string() 
          << "\" index=\"" << inode 
          << "\" node_id=\"" << size_t(cur_rr_node)
-         << "\" mux_size=\"" << get_rr_graph_configurable_driver_nodes(rr_graph, cur_rr_node).size()
+         << "\" mux_size=\"" << rr_gsb.get_ipin_node_driver_edges(gsb_side, inode).size()
          << "\">" 
          << std::endl; 
       /* General information of each driving nodes */
-      for (const RRNodeId& driver_node : get_rr_graph_configurable_driver_nodes(rr_graph, cur_rr_node)) {
+      for (const RRNodeId& driver_node : rr_gsb.get_ipin_node_driver_nodes(rr_graph, gsb_side, inode)) {
         /* Skip OPINs: they should be in direct connections */
         if (OPIN == rr_graph.node_type(driver_node)) {
           continue;
@@ -175,36 +174,62 @@ void write_rr_switch_block_to_xml(const std::string fname_prefix,
 
   /* close a file */
   fp.close();
+
+  return fname;
 }
 
 /***************************************************************************************
  * Output internal structure (only the switch block part) of all the RRGSBs
  * in a DeviceRRGSB  to XML format 
+ * - When unique is enabled, only the unique mirrors of switch blocks are outputted
+ * - Each XML file is independent, so they are written on multiple threads when requested
+ * - Verbose outputs are reported in the sequence of GSBs after all the files are written,
+ *   so that they are the same whatever number of threads is used
  ***************************************************************************************/
 void write_device_rr_gsb_to_xml(const char* sb_xml_dir, 
                                 const RRGraph& rr_graph,
                                 const DeviceRRGSB& device_rr_gsb,
+                                const bool& unique,
+                                const size_t& num_threads,
                                 const bool& verbose) {
   std::string xml_dir_name = format_dir_path(std::string(sb_xml_dir));
 
   /* Create directories */
   create_directory(xml_dir_name);
 
-  vtr::Point<size_t> sb_range = device_rr_gsb.get_gsb_range();
-
-  size_t gsb_counter = 0;
+  /* Collect the switch blocks to be outputted */
+  std::vector<const RRGSB*> rr_gsbs;
+  if (true == unique) {
+    rr_gsbs.reserve(device_rr_gsb.get_num_sb_unique_module());
+    for (size_t isb = 0; isb < device_rr_gsb.get_num_sb_unique_module(); ++isb) {
+      rr_gsbs.push_back(&(device_rr_gsb.get_sb_unique_module(isb)));
+    }
+  } else {
+    vtr::Point<size_t> sb_range = device_rr_gsb.get_gsb_range();
+    rr_gsbs.reserve(sb_range.x() * sb_range.y());
+    for (size_t ix = 0; ix < sb_range.x(); ++ix) {
+      for (size_t iy = 0; iy < sb_range.y(); ++iy) {
+        rr_gsbs.push_back(&(device_rr_gsb.get_gsb(ix, iy)));
+      }
+    }
+  }
 
   /* For each switch block, an XML file will be outputted */
-  for (size_t ix = 0; ix < sb_range.x(); ++ix) {
-    for (size_t iy = 0; iy < sb_range.y(); ++iy) {
-      const RRGSB& rr_gsb = device_rr_gsb.get_gsb(ix, iy);
-      write_rr_switch_block_to_xml(xml_dir_name, rr_graph, rr_gsb, verbose);
-      gsb_counter++;
-    }
+  std::vector<std::string> xml_fnames(rr_gsbs.size());
+  parallel_for(rr_gsbs.size(), num_threads,
+               [&](const size_t& igsb) {
+                 xml_fnames[igsb] = write_rr_switch_block_to_xml(xml_dir_name, rr_graph, *(rr_gsbs[igsb]));
+               });
+
+  for (const std::string& xml_fname : xml_fnames) {
+    VTR_LOGV(verbose,
+             "Output internal structure of Switch Block to '%s'\n",
+             xml_fname.c_str());
   }
 
-  VTR_LOG("Output %lu XML files to directory '%s'\n",
-          gsb_counter,
+  VTR_LOG("Output %lu XML files of %s switch blocks to directory '%s'\n",
+          xml_fnames.size(),
+          (true == unique) ? "unique" : "all the",
           xml_dir_name.c_str());
 }
 
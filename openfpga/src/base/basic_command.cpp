@@ -2,8 +2,13 @@
  * Add basic commands to the OpenFPGA shell interface, including:
  * - exit
  * - version
+ * - run_benchmarks
  * - help
  *******************************************************************/
+/* Headers from openfpgashell library */
+#include "command_exit_codes.h"
+#include "command_threads.h"
+
 #include "openfpga_title.h"
 #include "basic_command.h"
 
@@ -25,6 +30,33 @@ void add_basic_commands(openfpga::Shell<OpenfpgaContext>& shell) {
   shell.set_command_class(shell_cmd_version_id, basic_cmd_class);
   shell.set_command_execute_function(shell_cmd_version_id, print_openfpga_version_info);
 
+  /* Run benchmarks in parallel processes, which share the fabric built so far */
+  Command shell_cmd_run_benchmarks("run_benchmarks");
+  CommandOptionId opt_list = shell_cmd_run_benchmarks.add_option("list", true, "file path to the list of scripts to run, one script per line, each for a benchmark");
+  shell_cmd_run_benchmarks.set_option_require_value(opt_list, openfpga::OPT_STRING);
+  CommandOptionId opt_jobs = shell_cmd_run_benchmarks.add_option("jobs", false, "Set the number of scripts to run at the same time. Default value is 1. Use 0 to take all the hardware threads");
+  shell_cmd_run_benchmarks.set_option_require_value(opt_jobs, openfpga::OPT_INT);
+  ShellCommandId shell_cmd_run_benchmarks_id = shell.add_command(shell_cmd_run_benchmarks, "Run the scripts of benchmarks, each in a process forked from the shell, starting from the fabric built so far");
+  shell.set_command_class(shell_cmd_run_benchmarks_id, basic_cmd_class);
+  shell.set_command_execute_function(shell_cmd_run_benchmarks_id,
+                                     [&shell](OpenfpgaContext& openfpga_ctx, const Command& cmd, const CommandContext& cmd_context) {
+    /* Only one script runs at a time unless specified,
+     * whatever the default number of threads of the commands
+     */
+    size_t num_jobs = 1;
+    CommandOptionId opt_num_jobs = cmd.option("jobs");
+    if (true == cmd_context.option_enable(cmd, opt_num_jobs)) {
+      if (false == find_command_num_threads(cmd, cmd_context, opt_num_jobs, num_jobs)) {
+        return CMD_EXEC_FATAL_ERROR;
+      }
+    }
+    return shell.run_forked_jobs(cmd_context.option_value(cmd, cmd.option("list")).c_str(),
+                                 openfpga_ctx, num_jobs,
+                                 [](OpenfpgaContext& context) { context.reset_benchmark_data(); });
+  });
+  /* The benchmarks are meant to share a fabric, which should be built before */
+  shell.set_command_dependency(shell_cmd_run_benchmarks_id, std::vector<ShellCommandId>(1, shell.command("build_fabric")));
+
   /* Note: 
    * help MUST be the last to add because the linking to execute function will do a snapshot on the shell 
    */
@@ -27,14 +27,33 @@ size_t IoLocationMap::io_index(const size_t& x,
     return size_t(-1);
   }
 
-  auto result = io_indices_[x][y][z].find(io_port_name);
-  if (result == io_indices_[x][y][z].end()) {
+  size_t io_port_id = find_io_port_id(io_port_name);
+  if (io_port_id >= io_indices_[x][y][z].size()) {
     return size_t(-1);
   }
 
-  return result->second;
+  return io_indices_[x][y][z][io_port_id];
 }
 
+std::array<size_t, 3> IoLocationMap::io_location(const std::string& io_port_name,
+                                                 const size_t& io_index) const {
+  std::array<size_t, 3> invalid_location = {size_t(-1), size_t(-1), size_t(-1)};
+
+  size_t io_port_id = find_io_port_id(io_port_name);
+  if (io_port_id >= io_locations_.size()) {
+    return invalid_location;
+  }
+
+  if (io_index >= io_locations_[io_port_id].size()) {
+    return invalid_location;
+  }
+
+  return io_locations_[io_port_id][io_index];
+}
+
+/**************************************************
+ * Public Mutators
+ *************************************************/
 void IoLocationMap::set_io_index(const size_t& x,
                                  const size_t& y,
                                  const size_t& z,
@@ -52,7 +71,39 @@ void IoLocationMap::set_io_index(const size_t& x,
     io_indices_[x][y].resize(z + 1);
   }
 
-  io_indices_[x][y][z][io_port_name] = io_index;
+  /* Intern the name of I/O port */
+  auto result = io_port_ids_.emplace(io_port_name, io_port_ids_.size());
+  size_t io_port_id = result.first->second;
+
+  if (io_port_id >= io_indices_[x][y][z].size()) {
+    io_indices_[x][y][z].resize(io_port_id + 1, size_t(-1));
+  }
+
+  io_indices_[x][y][z][io_port_id] = io_index;
+
+  /* Update the reverse lookup */
+  if (io_port_id >= io_locations_.size()) {
+    io_locations_.resize(io_port_id + 1);
+  }
+
+  if (io_index >= io_locations_[io_port_id].size()) {
+    io_locations_[io_port_id].resize(io_index + 1, {size_t(-1), size_t(-1), size_t(-1)});
+  }
+
+  io_locations_[io_port_id][io_index] = {x, y, z};
+}
+
+/**************************************************
+ * Internal utilities
+ *************************************************/
+/* Return size_t(-1) if the I/O port is not in the map */
+size_t IoLocationMap::find_io_port_id(const std::string& io_port_name) const {
+  auto result = io_port_ids_.find(io_port_name);
+  if (result == io_port_ids_.end()) {
+    return size_t(-1);
+  }
+
+  return result->second;
 }
 
 } /* end namespace openfpga */
@@ -5,6 +5,7 @@
  * Include header files required by the data structure definition
  *******************************************************************/
 #include <stddef.h>
+#include <array>
 #include <vector>
 #include <string>
 #include <map>
@@ -27,6 +28,10 @@ namespace openfpga {
  *   |  [0]   |  [1]   |   |  [0]   |  [1]   |  |  [0]   |
  *   +-----------------+   +--------+--------+  +--------+
  *
+ * The names of I/O ports are interned, so that the I/O indices of
+ * a location are stored in a plain array indexed by the I/O port.
+ * A reverse lookup finds the location of an I/O from its port and index
+ *
  *******************************************************************/
 class IoLocationMap {
   public: /* Public aggregators */
@@ -34,15 +39,26 @@ class IoLocationMap {
                     const size_t& y,
                     const size_t& z,
                     const std::string& io_port_name) const;
+    /* Find the [x][y][z] location of an I/O, 
+     * return size_t(-1) for each coordinate if the I/O is not in the map
+     */
+    std::array<size_t, 3> io_location(const std::string& io_port_name,
+                                      const size_t& io_index) const;
   public: /* Public mutators */
     void set_io_index(const size_t& x,
                       const size_t& y,
                       const size_t& z,
                       const std::string& io_port_name,
                       const size_t& io_index);
+  private: /* Internal utilities */
+    size_t find_io_port_id(const std::string& io_port_name) const;
   private: /* Internal Data */
-    /* I/O index fast lookup by [x][y][z] location */
-    std::vector<std::vector<std::vector<std::map<std::string, size_t>>>> io_indices_;
+    /* Interned names of I/O ports */
+    std::map<std::string, size_t> io_port_ids_;
+    /* I/O index fast lookup by [x][y][z] location and [io_port_id] */
+    std::vector<std::vector<std::vector<std::vector<size_t>>>> io_indices_;
+    /* Location fast lookup by [io_port_id][io_index] */
+    std::vector<std::vector<std::array<size_t, 3>>> io_locations_;
 };
 
 } /* End namespace openfpga*/
@@ -4,6 +4,7 @@
 #include <algorithm>
 
 #include "vtr_assert.h"
+#include "openfpga_memory_usage.h"
 #include "netlist_manager.h"
 
 /* begin namespace openfpga */
@@ -19,7 +20,8 @@ NetlistManager::netlist_range NetlistManager::netlists() const {
 
 /* Find all the modules that are included in a netlist */
 std::vector<ModuleId> NetlistManager::netlist_modules(const NetlistId& netlist) const {
-  VTR_ASSERT(true == valid_netlist_id(netlist));
+  std::lock_guard<std::mutex> lock(mutex_);
+  VTR_ASSERT(true == valid_netlist_id_unlocked(netlist));
   return included_module_ids_[netlist];
 }
 
@@ -29,52 +31,52 @@ std::vector<ModuleId> NetlistManager::netlist_modules(const NetlistId& netlist)
  ******************************************************************************/
 /* Find the name of a netlist */
 std::string NetlistManager::netlist_name(const NetlistId& netlist) const {
-  VTR_ASSERT(true == valid_netlist_id(netlist));
+  std::lock_guard<std::mutex> lock(mutex_);
+  VTR_ASSERT(true == valid_netlist_id_unlocked(netlist));
   return netlist_names_[netlist];
 }
 
 /* Find a netlist by its name */
 NetlistId NetlistManager::find_netlist(const std::string& netlist_name) const {
-  if (name_id_map_.find(netlist_name) != name_id_map_.end()) {
+  std::lock_guard<std::mutex> lock(mutex_);
+  auto it = name_id_map_.find(netlist_name);
+  if (it != name_id_map_.end()) {
     /* Found, return the id */
-    return name_id_map_.at(netlist_name);
+    return it->second;
   } 
   /* Not found, return an invalid id */
   return NetlistId::INVALID();
 }
 
 NetlistManager::e_netlist_type NetlistManager::netlist_type(const NetlistId& netlist) const {
-  VTR_ASSERT(true == valid_netlist_id(netlist));
+  std::lock_guard<std::mutex> lock(mutex_);
+  VTR_ASSERT(true == valid_netlist_id_unlocked(netlist));
   return netlist_types_[netlist];
 }
 
 /* Find if a module belongs to a netlist */
 bool NetlistManager::is_module_in_netlist(const NetlistId& netlist, const ModuleId& module) const {
-  VTR_ASSERT(true == valid_netlist_id(netlist));
+  std::lock_guard<std::mutex> lock(mutex_);
+  VTR_ASSERT(true == valid_netlist_id_unlocked(netlist));
 
-  for (const ModuleId& included_module : included_module_ids_[netlist]) {
-    /* Already in the netlist, return true */
-    if (module == included_module) {
-      return true;  
-    }
-  }
- 
-  /* Not in the netlist, return false */
-  return false;
+  /* A module belongs to only one netlist */
+  auto it = module_netlist_map_.find(module);
+  return (it != module_netlist_map_.end()) && (netlist == it->second);
 }
 
 /* Find the netlist that a module belongs to */
 NetlistId NetlistManager::find_module_netlist(const ModuleId& module) const {
-  /* Find if the module has been added to a netlist. If used, return false! */
+  std::lock_guard<std::mutex> lock(mutex_);
   /* Not found, return an invalid value */
-  if ( module_netlist_map_.end()
-    != module_netlist_map_.find(module)) {
+  auto it = module_netlist_map_.find(module);
+  if (it == module_netlist_map_.end()) {
     return NetlistId::INVALID();
   }
-  return module_netlist_map_.at(module);
+  return it->second;
 }
 
 std::vector<NetlistId> NetlistManager::netlists_by_type(const NetlistManager::e_netlist_type& netlist_type) const {
+  std::lock_guard<std::mutex> lock(mutex_);
   std::vector<NetlistId> nlists;
 
   for (const NetlistId& nlist_id : netlist_ids_) {
@@ -88,7 +90,8 @@ std::vector<NetlistId> NetlistManager::netlists_by_type(const NetlistManager::e_
 
 /* Find all the preprocessing flags that are included in a netlist */
 std::vector<std::string> NetlistManager::netlist_preprocessing_flags(const NetlistId& netlist) const {
-  VTR_ASSERT(true == valid_netlist_id(netlist));
+  std::lock_guard<std::mutex> lock(mutex_);
+  VTR_ASSERT(true == valid_netlist_id_unlocked(netlist));
 
   std::vector<std::string> flags; 
 
@@ -100,19 +103,36 @@ std::vector<std::string> NetlistManager::netlist_preprocessing_flags(const Netli
   return flags;
 }
 
+size_t NetlistManager::memory_usage() const {
+  std::lock_guard<std::mutex> lock(mutex_);
+  return openfpga::memory_usage(netlist_ids_)
+       + openfpga::memory_usage(netlist_names_)
+       + openfpga::memory_usage(netlist_types_)
+       + openfpga::memory_usage(included_module_ids_)
+       + openfpga::memory_usage(included_preprocessing_flag_ids_)
+       + openfpga::memory_usage(preprocessing_flag_ids_)
+       + openfpga::memory_usage(preprocessing_flag_names_)
+       + openfpga::memory_usage(name_id_map_)
+       + openfpga::memory_usage(module_netlist_map_)
+       + openfpga::memory_usage(flag_name_id_map_);
+}
+
 /******************************************************************************
  * Public mutators
  ******************************************************************************/
 /* Add a netlist to the library */
 NetlistId NetlistManager::add_netlist(const std::string& name) {
-  /* Find if the name has been used. If used, return an invalid Id! */
-  std::map<std::string, NetlistId>::iterator it = name_id_map_.find(name);
-  if (it !=  name_id_map_.end()) {
+  std::lock_guard<std::mutex> lock(mutex_);
+
+  /* Find if the name has been used. If used, return an invalid Id! 
+   * Otherwise, register the new id in the name-to-id map
+   */
+  NetlistId netlist = NetlistId(netlist_ids_.size());
+  if (false == name_id_map_.emplace(name, netlist).second) {
     return NetlistId::INVALID();
   }
 
   /* Create a new id */
-  NetlistId netlist = NetlistId(netlist_ids_.size());
   netlist_ids_.push_back(netlist);
 
   /* Allocate related attributes */
@@ -121,65 +141,53 @@ NetlistId NetlistManager::add_netlist(const std::string& name) {
   included_module_ids_.emplace_back();
   included_preprocessing_flag_ids_.emplace_back();
 
-  /* Register in the name-to-id map */
-  name_id_map_[name] = netlist;  
-
   return netlist;
 } 
 
 void NetlistManager::set_netlist_type(const NetlistId& netlist,
                                       const e_netlist_type& type) {
-  VTR_ASSERT(true == valid_netlist_id(netlist));
+  std::lock_guard<std::mutex> lock(mutex_);
+  VTR_ASSERT(true == valid_netlist_id_unlocked(netlist));
   netlist_types_[netlist] = type;
 }
 
 /* Add a module to a netlist in the library */
 bool NetlistManager::add_netlist_module(const NetlistId& netlist, const ModuleId& module) {
-  VTR_ASSERT(true == valid_netlist_id(netlist));
+  std::lock_guard<std::mutex> lock(mutex_);
+  VTR_ASSERT(true == valid_netlist_id_unlocked(netlist));
 
-  /* Find if the module already in the netlist */
-  std::vector<ModuleId>::iterator module_it = std::find(included_module_ids_[netlist].begin(), included_module_ids_[netlist].end(), module);
-  if (module_it != included_module_ids_[netlist].end()) {
-    /* Already in the netlist, nothing to do */
-    return true;
-  }
   /* Try to register it in module-to-netlist map */
-  /* Find if the module has been added to a netlist. If used, return false! */
-  std::map<ModuleId, NetlistId>::iterator map_it = module_netlist_map_.find(module);
-  if (map_it != module_netlist_map_.end()) {
-    return false;
+  auto map_it = module_netlist_map_.emplace(module, netlist);
+  if (false == map_it.second) {
+    /* Already in the netlist, nothing to do
+     * If the module has been added to another netlist, return false!
+     */
+    return (netlist == map_it.first->second);
   }
 
   /* Does not exist! Should add it to the list */
   included_module_ids_[netlist].push_back(module);
-  /* Register it in module-to-netlist map */
-  module_netlist_map_[module] = netlist;
   return true;
 }
 
 /* Add a pre-processing flag to a netlist */
 void NetlistManager::add_netlist_preprocessing_flag(const NetlistId& netlist, const std::string& preprocessing_flag) {
-  VTR_ASSERT(true == valid_netlist_id(netlist));
-
-  PreprocessingFlagId flag = PreprocessingFlagId(preprocessing_flag_ids_.size());
- 
-  /* Find if the module already in the netlist */
-  for (const PreprocessingFlagId& id : preprocessing_flag_ids_) {
-    if (0 != preprocessing_flag.compare(preprocessing_flag_names_[id])) {
-      continue;
-    }
-    /* Already in the list of pre-processing flags, push it ot the  */
-    flag = id;
-    break;
-  }
-
-  /* Update the list if we need */
-  if (flag == PreprocessingFlagId(preprocessing_flag_ids_.size())) {
+  std::lock_guard<std::mutex> lock(mutex_);
+  VTR_ASSERT(true == valid_netlist_id_unlocked(netlist));
+
+  /* Find if the flag is already in the list of pre-processing flags 
+   * Update the list if we need
+   */
+  auto flag_it = flag_name_id_map_.emplace(preprocessing_flag, PreprocessingFlagId(preprocessing_flag_ids_.size()));
+  PreprocessingFlagId flag = flag_it.first->second;
+  if (true == flag_it.second) {
     preprocessing_flag_ids_.push_back(flag);
     preprocessing_flag_names_.push_back(preprocessing_flag);
   }
 
-  /* Check if the flag is already in the netlist */
+  /* Check if the flag is already in the netlist
+   * A netlist has a few flags, so the list is scanned
+   */
   std::vector<PreprocessingFlagId>::iterator it = std::find(included_preprocessing_flag_ids_[netlist].begin(), included_preprocessing_flag_ids_[netlist].end(), flag);
   if (it == included_preprocessing_flag_ids_[netlist].end()) {
     /* Not in the list, we add it */
@@ -191,12 +199,17 @@ void NetlistManager::add_netlist_preprocessing_flag(const NetlistId& netlist, co
  * Public validators/invalidators
  ******************************************************************************/
 bool NetlistManager::valid_netlist_id(const NetlistId& netlist) const {
-  return (size_t(netlist) < netlist_ids_.size()) && (netlist == netlist_ids_[netlist]);
+  std::lock_guard<std::mutex> lock(mutex_);
+  return valid_netlist_id_unlocked(netlist);
 }
 
 /******************************************************************************
  * Private validators/invalidators
  ******************************************************************************/
+bool NetlistManager::valid_netlist_id_unlocked(const NetlistId& netlist) const {
+  return (size_t(netlist) < netlist_ids_.size()) && (netlist == netlist_ids_[netlist]);
+}
+
 bool NetlistManager::valid_preprocessing_flag_id(const PreprocessingFlagId& flag) const {
   return (size_t(flag) < preprocessing_flag_ids_.size()) && (flag == preprocessing_flag_ids_[flag]);
 }
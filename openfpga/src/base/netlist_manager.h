@@ -7,6 +7,18 @@
  * the netlist manager can generate the dependency on other netlists 
  * This can help us tracking the dependency and generate `include` files easily
  *
+ * The netlists, modules and preprocessing flags are found through hash tables,
+ * so that registering tens of thousands of netlists and modules does not
+ * scan the lists of netlists or of flags
+ *
+ * The netlist manager can be shared by multiple threads, e.g., netlist writers
+ * registering their netlists concurrently: all the accessors and mutators
+ * are guarded by a lock, except netlists() whose range should not be
+ * iterated while netlists are being added.
+ * Note that the netlists are ordered as they are added, so that writers which
+ * expect a fixed order, e.g., for the include files, should still add
+ * their netlists in a deterministic order
+ *
  * Cross-reference:
  *
  *   +---------+               +---------+      
@@ -20,9 +32,10 @@
 #ifndef NETLIST_MANAGER_H
 #define NETLIST_MANAGER_H
 
+#include <mutex>
 #include <string>
+#include <unordered_map>
 #include <vector>
-#include <map>
 #include "vtr_vector.h"
 #include "netlist_manager_fwd.h"
 #include "module_manager.h"
@@ -66,6 +79,8 @@ class NetlistManager {
     bool is_module_in_netlist(const NetlistId& netlist, const ModuleId& module) const;
     /* Find the netlist that a module belongs to */
     NetlistId find_module_netlist(const ModuleId& module) const;
+    /* Estimate the heap memory (in bytes) held by the netlist database */
+    size_t memory_usage() const;
 
   public: /* Public mutators */
     /* Add a netlist to the library */
@@ -82,6 +97,8 @@ class NetlistManager {
     bool valid_netlist_id(const NetlistId& netlist) const;
 
   private: /* Private validators/invalidators */
+    /* Same as valid_netlist_id() but the caller should hold the lock */
+    bool valid_netlist_id_unlocked(const NetlistId& netlist) const;
     bool valid_preprocessing_flag_id(const PreprocessingFlagId& flag) const;
     void invalidate_name2id_map();
     void invalidate_module2netlist_map();
@@ -98,9 +115,14 @@ class NetlistManager {
     vtr::vector<PreprocessingFlagId, std::string> preprocessing_flag_names_;
 
     /* fast look-up for netlist */
-    std::map<std::string, NetlistId> name_id_map_;
-    /* fast look-up for modules in netlists */
-    std::map<ModuleId, NetlistId> module_netlist_map_;
+    std::unordered_map<std::string, NetlistId> name_id_map_;
+    /* fast look-up for modules in netlists: a module belongs to only one netlist */
+    std::unordered_map<ModuleId, NetlistId> module_netlist_map_;
+    /* fast look-up for preprocessing flags */
+    std::unordered_map<std::string, PreprocessingFlagId> flag_name_id_map_;
+
+    /* Guard the database against concurrent accesses */
+    mutable std::mutex mutex_;
 };
 
 } /* end namespace openfpga */
@@ -1,24 +1,34 @@
 /********************************************************************
  * This file includes functions to build bitstream database
  *******************************************************************/
+#include <cstdlib>
+
 /* Headers from vtrutil library */
 #include "vtr_time.h"
 #include "vtr_log.h"
 
 /* Headers from openfpgashell library */
 #include "command_exit_codes.h"
+#include "command_threads.h"
 
 /* Headers from openfpgautil library */
 #include "openfpga_digest.h"
+#include "openfpga_tokenizer.h"
+#include "openfpga_compressed_stream.h"
 
 /* Headers from fpgabitstream library */
 #include "read_xml_arch_bitstream.h"
 #include "write_xml_arch_bitstream.h"
+#include "read_bin_arch_bitstream.h"
+#include "write_bin_arch_bitstream.h"
+#include "bitstream_manager_utils.h"
 
 #include "build_device_bitstream.h"
 #include "write_text_fabric_bitstream.h"
+#include "write_binary_fabric_bitstream.h"
 #include "write_xml_fabric_bitstream.h"
 #include "build_fabric_bitstream.h"
+#include "fabric_bitstream_utils.h"
 #include "openfpga_bitstream.h"
 
 /* Include global variables of VPR */
@@ -27,6 +37,28 @@
 /* begin namespace openfpga */
 namespace openfpga {
 
+/********************************************************************
+ * Release the intermediate data which are only required by
+ * the builders of fabric and bitstream, once the bitstreams are built:
+ * - the sorted incoming edges of GSBs
+ * - the physical routing resource graphs of logical blocks, 
+ *   which are built again by a next repacking
+ * The nets of the module graph and the bitstreams are packed,
+ * as the writers only read them
+ *******************************************************************/
+static 
+void release_build_scratch(OpenfpgaContext& openfpga_ctx) {
+  vtr::ScopedStartFinishTimer timer("Release intermediate data of fabric and bitstream builders");
+
+  openfpga_ctx.mutable_device_rr_gsb().clear_chan_node_in_edges();
+  openfpga_ctx.mutable_vpr_device_annotation().clear_physical_lb_rr_graphs();
+  openfpga_ctx.mutable_module_graph().freeze_nets();
+  openfpga_ctx.mutable_bitstream_manager().shrink_to_fit();
+  openfpga_ctx.mutable_fabric_bitstream().shrink_to_fit();
+
+  openfpga_ctx.mutable_flow_manager().set_scratch_released(true);
+}
+
 /********************************************************************
  * A wrapper function to call the build_device_bitstream() in FPGA bitstream
  *******************************************************************/
@@ -36,13 +68,93 @@ int fpga_bitstream(OpenfpgaContext& openfpga_ctx,
   CommandOptionId opt_verbose = cmd.option("verbose");
   CommandOptionId opt_write_file = cmd.option("write_file");
   CommandOptionId opt_read_file = cmd.option("read_file");
+  CommandOptionId opt_file_format = cmd.option("format");
+  CommandOptionId opt_threads = cmd.option("threads");
+  CommandOptionId opt_incremental = cmd.option("incremental");
+  CommandOptionId opt_share_unused_grids = cmd.option("share_unused_grids");
+
+  /* Use the default number of threads of the shell unless specified */
+  size_t num_threads = 1;
+  if (false == find_command_num_threads(cmd, cmd_context, opt_threads, num_threads)) {
+    return CMD_EXEC_FATAL_ERROR;
+  }
+
+  /* Check file format requirements */
+  std::string file_format("xml");
+  if (true == cmd_context.option_enable(cmd, opt_file_format)) {
+    file_format = cmd_context.option_value(cmd, opt_file_format);
+  }
+  if ( (std::string("xml") != file_format)
+    && (std::string("bin") != file_format) ) {
+    VTR_LOG_ERROR("Invalid file format '%s' which should be either 'xml' or 'bin'!\n",
+                  file_format.c_str());
+    return CMD_EXEC_FATAL_ERROR;
+  }
+
+  /* Incremental builds overwrite the blocks of grids in place, which should not be shared */
+  if ( (true == cmd_context.option_enable(cmd, opt_share_unused_grids))
+    && (true == cmd_context.option_enable(cmd, opt_incremental)) ) {
+    VTR_LOG_ERROR("Option '--share_unused_grids' cannot be used with '--incremental'!\n");
+    return CMD_EXEC_FATAL_ERROR;
+  }
 
   if (true == cmd_context.option_enable(cmd, opt_read_file)) {
-    openfpga_ctx.mutable_bitstream_manager() = read_xml_architecture_bitstream(cmd_context.option_value(cmd, opt_read_file).c_str());
+    if (std::string("bin") == file_format) {
+      openfpga_ctx.mutable_bitstream_manager() = read_bin_architecture_bitstream(cmd_context.option_value(cmd, opt_read_file));
+    } else {
+      openfpga_ctx.mutable_bitstream_manager() = read_xml_architecture_bitstream(cmd_context.option_value(cmd, opt_read_file).c_str());
+    }
+    /* The implementation results of the bitstream read are unknown */
+    openfpga_ctx.mutable_bitstream_build_snapshot().clear();
   } else {
-    openfpga_ctx.mutable_bitstream_manager() = build_device_bitstream(g_vpr_ctx,
-                                                                      openfpga_ctx,
-                                                                      cmd_context.option_enable(cmd, opt_verbose));
+    /* The bitstream builder requires the sorted incoming edges of GSBs */
+    if (true == openfpga_ctx.flow_manager().scratch_released()) {
+      VTR_LOG_ERROR("Intermediate data of builders have been released by '--release_scratch'! Please run 'link_openfpga_arch' again before building bitstream\n");
+      return CMD_EXEC_FATAL_ERROR;
+    }
+
+    /* Try to update the existing bitstream in place, otherwise build it from scratch */
+    bool updated = false;
+    if (true == cmd_context.option_enable(cmd, opt_incremental)) {
+      updated = update_device_bitstream(openfpga_ctx.mutable_bitstream_manager(),
+                                        openfpga_ctx.bitstream_build_snapshot(),
+                                        g_vpr_ctx,
+                                        openfpga_ctx,
+                                        num_threads,
+                                        cmd_context.option_enable(cmd, opt_verbose));
+    }
+    if (false == updated) {
+      openfpga_ctx.mutable_bitstream_manager() = build_device_bitstream(g_vpr_ctx,
+                                                                        openfpga_ctx,
+                                                                        cmd_context.option_enable(cmd, opt_share_unused_grids),
+                                                                        num_threads,
+                                                                        cmd_context.option_enable(cmd, opt_verbose));
+    }
+
+    /* Record the implementation results for a next incremental build */
+    if (true == cmd_context.option_enable(cmd, opt_incremental)) {
+      openfpga_ctx.mutable_bitstream_build_snapshot().take(g_vpr_ctx.atom().nlist.netlist_id(),
+                                                           g_vpr_ctx.clustering().clb_nlist.netlist_id(),
+                                                           vtr::Point<size_t>(g_vpr_ctx.device().grid.width(), g_vpr_ctx.device().grid.height()),
+                                                           g_vpr_ctx.device().rr_graph.nodes().size(),
+                                                           openfpga_ctx.vpr_placement_annotation(),
+                                                           openfpga_ctx.vpr_routing_annotation(),
+                                                           openfpga_ctx.bitstream_manager());
+    } else {
+      openfpga_ctx.mutable_bitstream_build_snapshot().clear();
+    }
+
+    /* The blocks and bits are kept by an incremental build,
+     * so that the fabric bitstream built before is patched in place
+     */
+    if ( (true == updated)
+      && (0 < openfpga_ctx.fabric_bitstream().num_bits()) ) {
+      update_fabric_dependent_bitstream(openfpga_ctx.mutable_fabric_bitstream(),
+                                        openfpga_ctx.bitstream_manager());
+      openfpga_ctx.mutable_fabric_bitstream_by_address() = build_fabric_bitstream_by_address(openfpga_ctx.fabric_bitstream(),
+                                                                                             openfpga_ctx.arch().config_protocol.type());
+      VTR_LOG("Updated fabric bitstream in place\n");
+    }
   }
 
   if (true == cmd_context.option_enable(cmd, opt_write_file)) {
@@ -51,8 +163,17 @@ int fpga_bitstream(OpenfpgaContext& openfpga_ctx,
     /* Create directories */
     create_directory(src_dir_path);
 
-    write_xml_architecture_bitstream(openfpga_ctx.bitstream_manager(),
-                                     cmd_context.option_value(cmd, opt_write_file));
+    if (std::string("bin") == file_format) {
+      /* The binary format stores all the blocks and bits */
+      openfpga_ctx.mutable_bitstream_manager().materialize_shared_blocks();
+      if (0 != write_bin_architecture_bitstream(openfpga_ctx.bitstream_manager(),
+                                                cmd_context.option_value(cmd, opt_write_file))) {
+        return CMD_EXEC_FATAL_ERROR;
+      }
+    } else {
+      write_xml_architecture_bitstream(openfpga_ctx.bitstream_manager(),
+                                       cmd_context.option_value(cmd, opt_write_file));
+    }
   }
 
   /* TODO: should identify the error code from internal function execution */
@@ -65,18 +186,82 @@ int fpga_bitstream(OpenfpgaContext& openfpga_ctx,
 int build_fabric_bitstream(OpenfpgaContext& openfpga_ctx,
                            const Command& cmd, const CommandContext& cmd_context) {
 
+  CommandOptionId opt_release_scratch = cmd.option("release_scratch");
+  CommandOptionId opt_threads = cmd.option("threads");
   CommandOptionId opt_verbose = cmd.option("verbose");
 
+  /* Use the default number of threads of the shell unless specified */
+  size_t num_threads = 1;
+  if (false == find_command_num_threads(cmd, cmd_context, opt_threads, num_threads)) {
+    return CMD_EXEC_FATAL_ERROR;
+  }
+
+  /* Each bit of the fabric bitstream refers to its own bit in the architecture bitstream */
+  if (true == openfpga_ctx.bitstream_manager().has_shared_blocks()) {
+    vtr::ScopedStartFinishTimer timer("Copy the shared bitstreams of unused grids");
+    openfpga_ctx.mutable_bitstream_manager().materialize_shared_blocks();
+  }
+
   /* Build fabric bitstream here */
   openfpga_ctx.mutable_fabric_bitstream() = build_fabric_dependent_bitstream(openfpga_ctx.bitstream_manager(),
                                                                              openfpga_ctx.module_graph(),
                                                                              openfpga_ctx.arch().config_protocol,
+                                                                             num_threads,
                                                                              cmd_context.option_enable(cmd, opt_verbose));
 
+  /* Reorganize the fabric bitstream by addresses only once,
+   * which is shared by the writers of bitstream files and testbenches
+   */
+  openfpga_ctx.mutable_fabric_bitstream_by_address() = build_fabric_bitstream_by_address(openfpga_ctx.fabric_bitstream(),
+                                                                                         openfpga_ctx.arch().config_protocol.type());
+
+  if (true == cmd_context.option_enable(cmd, opt_release_scratch)) {
+    release_build_scratch(openfpga_ctx);
+  }
+
   /* TODO: should identify the error code from internal function execution */
   return CMD_EXEC_SUCCESS;
 }
 
+/********************************************************************
+ * Write a fabric bitstream to a file in a given format
+ * [plain_text|xml|bin], where plain_text is the default one
+ *******************************************************************/
+static 
+int write_fabric_bitstream_file(const BitstreamManager& bitstream_manager,
+                                const FabricBitstream& fabric_bitstream,
+                                const FabricBitstreamByAddress& fabric_bitstream_by_address,
+                                const ConfigProtocol& config_protocol,
+                                const std::string& fname,
+                                const std::string& file_format,
+                                const e_file_compression& compression,
+                                const bool& verbose) {
+  if (std::string("xml") == file_format) {
+    return write_fabric_bitstream_to_xml_file(bitstream_manager,
+                                              fabric_bitstream,
+                                              config_protocol,
+                                              fname,
+                                              compression,
+                                              verbose);
+  } else if (std::string("bin") == file_format) {
+    return write_fabric_bitstream_to_binary_file(bitstream_manager,
+                                                 fabric_bitstream,
+                                                 fabric_bitstream_by_address,
+                                                 config_protocol,
+                                                 fname,
+                                                 verbose);
+  }
+
+  /* By default, output in plain text format */
+  return write_fabric_bitstream_to_text_file(bitstream_manager,
+                                             fabric_bitstream,
+                                             fabric_bitstream_by_address,
+                                             config_protocol,
+                                             fname,
+                                             compression,
+                                             verbose);
+}
+
 /********************************************************************
  * A wrapper function to call the write_fabric_bitstream() in FPGA bitstream
  *******************************************************************/
@@ -86,6 +271,8 @@ int write_fabric_bitstream(const OpenfpgaContext& openfpga_ctx,
   CommandOptionId opt_verbose = cmd.option("verbose");
   CommandOptionId opt_file = cmd.option("file");
   CommandOptionId opt_file_format = cmd.option("format");
+  CommandOptionId opt_diff_against = cmd.option("diff_against");
+  CommandOptionId opt_compress = cmd.option("compress");
 
   /* Write fabric bitstream if required */
   int status = CMD_EXEC_SUCCESS;
@@ -103,22 +290,175 @@ int write_fabric_bitstream(const OpenfpgaContext& openfpga_ctx,
     file_format = cmd_context.option_value(cmd, opt_file_format);
   }
 
-  if (std::string("xml") == file_format) {
-    status = write_fabric_bitstream_to_xml_file(openfpga_ctx.bitstream_manager(),
-                                                openfpga_ctx.fabric_bitstream(),
-                                                openfpga_ctx.arch().config_protocol,
-                                                cmd_context.option_value(cmd, opt_file),
-                                                cmd_context.option_enable(cmd, opt_verbose));
+  e_file_compression compression = FILE_COMPRESSION_NONE;
+  if (true == cmd_context.option_enable(cmd, opt_compress)) {
+    compression = find_supported_file_compression(cmd_context.option_value(cmd, opt_compress));
+    if (NUM_FILE_COMPRESSIONS == compression) {
+      return CMD_EXEC_FATAL_ERROR;
+    }
+    if ( (FILE_COMPRESSION_NONE != compression)
+      && ( (std::string("bin") == file_format)
+        || (true == cmd_context.option_enable(cmd, opt_diff_against)) ) ) {
+      VTR_LOG_ERROR("Compression is only available for full fabric bitstreams in plain text and XML formats!\n");
+      return CMD_EXEC_FATAL_ERROR;
+    }
+  }
+
+  if (true == cmd_context.option_enable(cmd, opt_diff_against)) {
+    /* Differential bitstream is written in the same format as the reference */
+    if (std::string("plain_text") != file_format) {
+      VTR_LOG_ERROR("Differential bitstream is only available in plain text format!\n");
+      return CMD_EXEC_FATAL_ERROR;
+    }
+    status = write_fabric_bitstream_diff_to_text_file(openfpga_ctx.fabric_bitstream_by_address(),
+                                                      openfpga_ctx.arch().config_protocol,
+                                                      cmd_context.option_value(cmd, opt_diff_against),
+                                                      cmd_context.option_value(cmd, opt_file),
+                                                      cmd_context.option_enable(cmd, opt_verbose));
   } else {
-    /* By default, output in plain text format */
-    status = write_fabric_bitstream_to_text_file(openfpga_ctx.bitstream_manager(),
-                                                 openfpga_ctx.fabric_bitstream(),
-                                                 openfpga_ctx.arch().config_protocol,
-                                                 cmd_context.option_value(cmd, opt_file),
-                                                 cmd_context.option_enable(cmd, opt_verbose));
+    status = write_fabric_bitstream_file(openfpga_ctx.bitstream_manager(),
+                                         openfpga_ctx.fabric_bitstream(),
+                                         openfpga_ctx.fabric_bitstream_by_address(),
+                                         openfpga_ctx.arch().config_protocol,
+                                         cmd_context.option_value(cmd, opt_file),
+                                         file_format,
+                                         compression,
+                                         cmd_context.option_enable(cmd, opt_verbose));
   }
   
   return status;
 } 
 
+/********************************************************************
+ * Write the fabric bitstreams of many designs implemented on the same fabric,
+ * each of which is read from an architecture bitstream file,
+ * e.g., written by build_architecture_bitstream --write_file
+ *
+ * The fabric bitstream of the current design, which is built by
+ * build_fabric_bitstream, provides the order and the addresses of 
+ * the configuration bits, which only depend on the fabric.
+ * Therefore, for each design, only the values of the bits are updated,
+ * without walking through the module graph or sorting the addresses again
+ *******************************************************************/
+int write_fabric_bitstream_images(const OpenfpgaContext& openfpga_ctx,
+                                  const Command& cmd, const CommandContext& cmd_context) {
+
+  CommandOptionId opt_verbose = cmd.option("verbose");
+  CommandOptionId opt_read_files = cmd.option("read_files");
+  CommandOptionId opt_read_format = cmd.option("read_format");
+  CommandOptionId opt_files = cmd.option("files");
+  CommandOptionId opt_file_format = cmd.option("format");
+  CommandOptionId opt_compress = cmd.option("compress");
+
+  VTR_ASSERT(true == cmd_context.option_enable(cmd, opt_read_files));
+  VTR_ASSERT(true == cmd_context.option_enable(cmd, opt_files));
+
+  std::vector<std::string> read_fnames = StringToken(cmd_context.option_value(cmd, opt_read_files)).split(',');
+  std::vector<std::string> fnames = StringToken(cmd_context.option_value(cmd, opt_files)).split(',');
+  if (read_fnames.size() != fnames.size()) {
+    VTR_LOG_ERROR("The number of architecture bitstream files (%lu) does not match the number of fabric bitstream files (%lu)!\n",
+                  read_fnames.size(), fnames.size());
+    return CMD_EXEC_FATAL_ERROR;
+  }
+
+  /* Check file format requirements */
+  std::string read_format("xml");
+  if (true == cmd_context.option_enable(cmd, opt_read_format)) {
+    read_format = cmd_context.option_value(cmd, opt_read_format);
+  }
+  if ( (std::string("xml") != read_format)
+    && (std::string("bin") != read_format) ) {
+    VTR_LOG_ERROR("Invalid file format '%s' which should be either 'xml' or 'bin'!\n",
+                  read_format.c_str());
+    return CMD_EXEC_FATAL_ERROR;
+  }
+
+  std::string file_format("plain_text"); 
+  if (true == cmd_context.option_enable(cmd, opt_file_format)) {
+    file_format = cmd_context.option_value(cmd, opt_file_format);
+  }
+
+  e_file_compression compression = FILE_COMPRESSION_NONE;
+  if (true == cmd_context.option_enable(cmd, opt_compress)) {
+    compression = find_supported_file_compression(cmd_context.option_value(cmd, opt_compress));
+    if (NUM_FILE_COMPRESSIONS == compression) {
+      return CMD_EXEC_FATAL_ERROR;
+    }
+    if ( (FILE_COMPRESSION_NONE != compression)
+      && (std::string("bin") == file_format) ) {
+      VTR_LOG_ERROR("Compression is only available for fabric bitstreams in plain text and XML formats!\n");
+      return CMD_EXEC_FATAL_ERROR;
+    }
+  }
+
+  std::vector<ConfigBlockId> top_blocks = find_bitstream_manager_top_blocks(openfpga_ctx.bitstream_manager());
+  VTR_ASSERT(1 == top_blocks.size());
+  const ConfigBlockId& top_block = top_blocks[0];
+
+  /* The copies share the order of the current fabric bitstream,
+   * where the bit values are updated for each design 
+   */
+  BitstreamManager bitstream_manager = openfpga_ctx.bitstream_manager();
+  FabricBitstream fabric_bitstream = openfpga_ctx.fabric_bitstream();
+  FabricBitstreamByAddress fabric_bitstream_by_address;
+  {
+    vtr::ScopedStartFinishTimer timer("Reorganize fabric bitstream by addresses");
+    fabric_bitstream_by_address = build_fabric_bitstream_by_address(fabric_bitstream,
+                                                                    openfpga_ctx.arch().config_protocol.type(),
+                                                                    true);
+  }
+
+  for (size_t iimage = 0; iimage < fnames.size(); ++iimage) {
+    vtr::ScopedStartFinishTimer timer("Write fabric bitstream of '" + read_fnames[iimage] + "'");
+
+    BitstreamManager image_bitstream_manager;
+    if (std::string("bin") == read_format) {
+      image_bitstream_manager = read_bin_architecture_bitstream(read_fnames[iimage]);
+    } else {
+      image_bitstream_manager = read_xml_architecture_bitstream(read_fnames[iimage].c_str());
+    }
+    if (true == image_bitstream_manager.has_shared_blocks()) {
+      image_bitstream_manager.materialize_shared_blocks();
+    }
+
+    std::vector<ConfigBlockId> image_top_blocks = find_bitstream_manager_top_blocks(image_bitstream_manager);
+    if ( (1 != image_top_blocks.size())
+      || (false == is_bitstream_manager_block_hierarchy_same(bitstream_manager, top_block,
+                                                             image_bitstream_manager, image_top_blocks[0])) ) {
+      VTR_LOG_ERROR("Architecture bitstream '%s' is not built on the same fabric as the current one!\n",
+                    read_fnames[iimage].c_str());
+      return CMD_EXEC_FATAL_ERROR;
+    }
+
+    size_t num_changed_bits = bitstream_manager.overwrite_block_bitstream(top_block,
+                                                                          image_bitstream_manager,
+                                                                          image_top_blocks[0]);
+    VTR_LOGV(cmd_context.option_enable(cmd, opt_verbose),
+             "Updated %lu configuration bits from the previous design\n",
+             num_changed_bits);
+
+    update_fabric_dependent_bitstream(fabric_bitstream, bitstream_manager);
+    update_fabric_bitstream_by_address_dins(fabric_bitstream_by_address,
+                                            fabric_bitstream,
+                                            openfpga_ctx.arch().config_protocol.type());
+
+    /* Create directories */
+    create_directory(find_path_dir_name(fnames[iimage]));
+
+    int status = write_fabric_bitstream_file(bitstream_manager,
+                                             fabric_bitstream,
+                                             fabric_bitstream_by_address,
+                                             openfpga_ctx.arch().config_protocol,
+                                             fnames[iimage],
+                                             file_format,
+                                             compression,
+                                             cmd_context.option_enable(cmd, opt_verbose));
+    if (CMD_EXEC_SUCCESS != status) {
+      return status;
+    }
+  }
+
+  return CMD_EXEC_SUCCESS;
+} 
+
 } /* end namespace openfpga */
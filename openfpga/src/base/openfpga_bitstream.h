@@ -24,6 +24,9 @@ int build_fabric_bitstream(OpenfpgaContext& openfpga_ctx,
 int write_fabric_bitstream(const OpenfpgaContext& openfpga_ctx,
                            const Command& cmd, const CommandContext& cmd_context);
 
+int write_fabric_bitstream_images(const OpenfpgaContext& openfpga_ctx,
+                                  const Command& cmd, const CommandContext& cmd_context);
+
 } /* end namespace openfpga */
 
 #endif
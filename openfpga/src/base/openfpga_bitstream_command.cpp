@@ -24,6 +24,14 @@ ShellCommandId add_openfpga_repack_command(openfpga::Shell<OpenfpgaContext>& she
   /* Add an option '--design_constraints' */
   CommandOptionId opt_design_constraints = shell_cmd.add_option("design_constraints", false, "file path to the design constraints");
   shell_cmd.set_option_require_value(opt_design_constraints, openfpga::OPT_STRING);
+  /* Add an option '--lb_rr_graph_cache' */
+  CommandOptionId opt_lb_rr_graph_cache = shell_cmd.add_option("lb_rr_graph_cache", false, "directory path to cache the routing resource graphs of logical tiles, which are shared by the runs on the same architecture");
+  shell_cmd.set_option_require_value(opt_lb_rr_graph_cache, openfpga::OPT_STRING);
+  /* Add an option '--threads' */
+  CommandOptionId opt_threads = shell_cmd.add_option("threads", false, "Set the number of threads to build and check the routing resource graphs of logical tiles and to repack clustered blocks. Default value is given by the '--threads' option of the shell, which is 1 unless specified. Use 0 to take all the hardware threads");
+  shell_cmd.set_option_require_value(opt_threads, openfpga::OPT_INT);
+  /* Add an option '--lookahead' */
+  shell_cmd.add_option("lookahead", false, "Guide the router of logical tiles toward sinks by a lookahead built once per logical tile, which reduces the nodes to be explored");
   /* Add an option '--verbose' */
   shell_cmd.add_option("verbose", false, "Enable verbose output");
   
@@ -57,6 +65,19 @@ ShellCommandId add_openfpga_build_arch_bitstream_command(openfpga::Shell<Openfpg
   CommandOptionId opt_read_file = shell_cmd.add_option("read_file", false, "file path to read the bitstream database");
   shell_cmd.set_option_require_value(opt_read_file, openfpga::OPT_STRING);
 
+  /* Add an option '--format' */
+  CommandOptionId opt_file_format = shell_cmd.add_option("format", false, "file format of the bitstream database to read and write [xml|bin]. Default: xml");
+  shell_cmd.set_option_require_value(opt_file_format, openfpga::OPT_STRING);
+
+  /* Add an option '--incremental' */
+  shell_cmd.add_option("incremental", false, "Build again only the bitstreams of grids and routing blocks whose implementation results are changed since the last incremental build");
+
+  /* Add an option '--share_unused_grids' */
+  shell_cmd.add_option("share_unused_grids", false, "Store the bitstream of unused grids only once for each type of grid, which is copied to each grid only when the fabric bitstream is built");
+
+  /* Add an option '--threads' */
+  CommandOptionId opt_threads = shell_cmd.add_option("threads", false, "Set the number of threads to build the bitstream of independent grids and routing blocks. Default value is given by the '--threads' option of the shell, which is 1 unless specified. Use 0 to take all the hardware threads");
+  shell_cmd.set_option_require_value(opt_threads, openfpga::OPT_INT);
 
   /* Add an option '--verbose' */
   shell_cmd.add_option("verbose", false, "Enable verbose output");
@@ -83,6 +104,13 @@ ShellCommandId add_openfpga_build_fabric_bitstream_command(openfpga::Shell<Openf
                                                            const std::vector<ShellCommandId>& dependent_cmds) {
   Command shell_cmd("build_fabric_bitstream");
 
+  /* Add an option '--release_scratch' */
+  shell_cmd.add_option("release_scratch", false, "Release the intermediate data of the fabric and bitstream builders, which are not required by the writers");
+
+  /* Add an option '--threads' */
+  CommandOptionId opt_threads = shell_cmd.add_option("threads", false, "Set the number of threads to build the bitstream of configurable regions. Default value is given by the '--threads' option of the shell, which is 1 unless specified. Use 0 to take all the hardware threads");
+  shell_cmd.set_option_require_value(opt_threads, openfpga::OPT_INT);
+
   /* Add an option '--verbose' */
   shell_cmd.add_option("verbose", false, "Enable verbose output");
 
@@ -114,16 +142,69 @@ ShellCommandId add_openfpga_write_fabric_bitstream_command(openfpga::Shell<Openf
   shell_cmd.set_option_require_value(opt_file, openfpga::OPT_STRING);
 
   /* Add an option '--file_format'*/
-  CommandOptionId opt_file_format = shell_cmd.add_option("format", false, "file format of fabric bitstream [plain_text|xml]. Default: plain_text");
+  CommandOptionId opt_file_format = shell_cmd.add_option("format", false, "file format of fabric bitstream [plain_text|xml|bin]. Default: plain_text");
   shell_cmd.set_option_require_value(opt_file_format, openfpga::OPT_STRING);
 
+  /* Add an option '--diff_against'*/
+  CommandOptionId opt_diff_against = shell_cmd.add_option("diff_against", false, "file path to a reference fabric bitstream in plain text. Only the words whose data inputs differ from the reference are written. Applicable to memory bank and frame-based configuration protocols");
+  shell_cmd.set_option_require_value(opt_diff_against, openfpga::OPT_STRING);
+
+  /* Add an option '--compress'*/
+  CommandOptionId opt_compress = shell_cmd.add_option("compress", false, "Compress the fabric bitstream as it is written. Can be [none|gzip]. Applicable to plain_text and xml formats. Default: none");
+  shell_cmd.set_option_require_value(opt_compress, openfpga::OPT_STRING);
+
   /* Add an option '--verbose' */
   shell_cmd.add_option("verbose", false, "Enable verbose output");
 
   /* Add command 'fabric_bitstream' to the Shell */
   ShellCommandId shell_cmd_id = shell.add_command(shell_cmd, "Write the fabric-dependent bitstream to a file");
   shell.set_command_class(shell_cmd_id, cmd_class_id);
-  shell.set_command_execute_function(shell_cmd_id, write_fabric_bitstream);
+  shell.set_command_const_execute_function(shell_cmd_id, write_fabric_bitstream);
+
+  /* Add command dependency to the Shell */
+  shell.set_command_dependency(shell_cmd_id, dependent_cmds);
+
+  return shell_cmd_id;
+}
+
+/********************************************************************
+ * - Add a command to Shell environment: write_fabric_bitstream_images
+ * - Add associated options 
+ * - Add command dependency
+ *******************************************************************/
+static 
+ShellCommandId add_openfpga_write_fabric_bitstream_images_command(openfpga::Shell<OpenfpgaContext>& shell,
+                                                                  const ShellCommandClassId& cmd_class_id,
+                                                                  const std::vector<ShellCommandId>& dependent_cmds) {
+  Command shell_cmd("write_fabric_bitstream_images");
+
+  /* Add an option '--read_files' */
+  CommandOptionId opt_read_files = shell_cmd.add_option("read_files", true, "file paths to the architecture bitstreams of designs on the current fabric, separated by commas");
+  shell_cmd.set_option_require_value(opt_read_files, openfpga::OPT_STRING);
+
+  /* Add an option '--read_format' */
+  CommandOptionId opt_read_format = shell_cmd.add_option("read_format", false, "file format of architecture bitstreams [xml|bin]. Default: xml");
+  shell_cmd.set_option_require_value(opt_read_format, openfpga::OPT_STRING);
+
+  /* Add an option '--files' */
+  CommandOptionId opt_files = shell_cmd.add_option("files", true, "file paths to output the fabric bitstreams, separated by commas, one for each architecture bitstream");
+  shell_cmd.set_option_require_value(opt_files, openfpga::OPT_STRING);
+
+  /* Add an option '--file_format'*/
+  CommandOptionId opt_file_format = shell_cmd.add_option("format", false, "file format of fabric bitstreams [plain_text|xml|bin]. Default: plain_text");
+  shell_cmd.set_option_require_value(opt_file_format, openfpga::OPT_STRING);
+
+  /* Add an option '--compress'*/
+  CommandOptionId opt_compress = shell_cmd.add_option("compress", false, "Compress the fabric bitstreams as they are written. Can be [none|gzip]. Applicable to plain_text and xml formats. Default: none");
+  shell_cmd.set_option_require_value(opt_compress, openfpga::OPT_STRING);
+
+  /* Add an option '--verbose' */
+  shell_cmd.add_option("verbose", false, "Enable verbose output");
+
+  /* Add command to the Shell */
+  ShellCommandId shell_cmd_id = shell.add_command(shell_cmd, "Write the fabric-dependent bitstreams of many designs on the current fabric to files");
+  shell.set_command_class(shell_cmd_id, cmd_class_id);
+  shell.set_command_const_execute_function(shell_cmd_id, write_fabric_bitstream_images);
 
   /* Add command dependency to the Shell */
   shell.set_command_dependency(shell_cmd_id, dependent_cmds);
@@ -157,6 +238,10 @@ void add_openfpga_bitstream_commands(openfpga::Shell<OpenfpgaContext>& shell) {
   cmd_dependency_build_arch_bitstream.push_back(shell_cmd_repack_id);
   ShellCommandId shell_cmd_build_arch_bitstream_id = add_openfpga_build_arch_bitstream_command(shell, openfpga_bitstream_cmd_class, cmd_dependency_build_arch_bitstream);
 
+  /* The architecture bitstream can be restored by 'load_context' */
+  const ShellCommandId& shell_cmd_load_context_id = shell.command(std::string("load_context"));
+  shell.set_command_substitutes(shell_cmd_load_context_id, std::vector<ShellCommandId>(1, shell_cmd_build_arch_bitstream_id));
+
   /******************************** 
    * Command 'build_fabric_bitstream' 
    */
@@ -172,6 +257,14 @@ void add_openfpga_bitstream_commands(openfpga::Shell<OpenfpgaContext>& shell) {
   std::vector<ShellCommandId> cmd_dependency_write_fabric_bitstream;
   cmd_dependency_write_fabric_bitstream.push_back(shell_cmd_build_fabric_bitstream_id);
   add_openfpga_write_fabric_bitstream_command(shell, openfpga_bitstream_cmd_class, cmd_dependency_write_fabric_bitstream);
+
+  /******************************** 
+   * Command 'write_fabric_bitstream_images' 
+   */
+  /* The 'write_fabric_bitstream_images' command should NOT be executed before 'build_fabric_bitstream' */
+  std::vector<ShellCommandId> cmd_dependency_write_fabric_bitstream_images;
+  cmd_dependency_write_fabric_bitstream_images.push_back(shell_cmd_build_fabric_bitstream_id);
+  add_openfpga_write_fabric_bitstream_images_command(shell, openfpga_bitstream_cmd_class, cmd_dependency_write_fabric_bitstream_images);
 } 
 
 } /* end namespace openfpga */
@@ -1,15 +1,19 @@
 /********************************************************************
  * This file includes functions to compress the hierachy of routing architecture
  *******************************************************************/
+#include <cstdlib>
+
 /* Headers from vtrutil library */
 #include "vtr_time.h"
 #include "vtr_log.h"
 
 /* Headers from openfpgashell library */
 #include "command_exit_codes.h"
+#include "command_threads.h"
 
 /* Headers from fabrickey library */
 #include "read_xml_fabric_key.h"
+#include "read_bin_fabric_key.h"
 
 #include "device_rr_gsb.h"
 #include "device_rr_gsb_utils.h"
@@ -18,6 +22,8 @@
 #include "fabric_key_writer.h"
 #include "build_fabric_io_location_map.h"
 #include "build_fabric_global_port_info.h"
+#include "build_device_rr_gsb_module_ports.h"
+#include "fabric_cache.h"
 #include "openfpga_build_fabric.h"
 
 /* Include global variables of VPR */
@@ -30,13 +36,13 @@ namespace openfpga {
  * Identify the unique GSBs from the Device RR GSB arrays
  * This function should only be called after the GSB builder is done
  *******************************************************************/
-static 
 void compress_routing_hierarchy(OpenfpgaContext& openfpga_ctx,
+                                const size_t& num_threads,
                                 const bool& verbose_output) {
   vtr::ScopedStartFinishTimer timer("Identify unique General Switch Blocks (GSBs)");
 
   /* Build unique module lists */
-  openfpga_ctx.mutable_device_rr_gsb().build_unique_module(g_vpr_ctx.device().rr_graph);
+  openfpga_ctx.mutable_device_rr_gsb().build_unique_module(g_vpr_ctx.device().rr_graph, num_threads);
 
   /* Report the stats */
   VTR_LOGV(verbose_output, 
@@ -63,6 +69,31 @@ void compress_routing_hierarchy(OpenfpgaContext& openfpga_ctx,
           100. * ((float)find_device_rr_gsb_num_gsb_modules(openfpga_ctx.device_rr_gsb()) / (float)openfpga_ctx.device_rr_gsb().get_num_gsb_unique_module() - 1.));
 }
 
+/********************************************************************
+ * Build the data derived from the module graph, which are required by 
+ * the writers of netlists and bitstreams
+ * This function should only be called after the module graph is built
+ *******************************************************************/
+void build_fabric_annotations(OpenfpgaContext& openfpga_ctx,
+                              const size_t& num_threads) {
+  /* Build I/O location map */
+  openfpga_ctx.mutable_io_location_map() = build_fabric_io_location_map(openfpga_ctx.module_graph(),
+                                                                        g_vpr_ctx.device().grid);
+
+  /* Build fabric global port information */
+  openfpga_ctx.mutable_fabric_global_port_info() = build_fabric_global_port_info(openfpga_ctx.module_graph(),
+                                                                                 openfpga_ctx.arch().tile_annotations,
+                                                                                 openfpga_ctx.arch().circuit_lib);
+
+  /* Resolve the module ports of routing blocks, which are required by the writers */
+  openfpga_ctx.mutable_device_rr_gsb_module_ports() = build_device_rr_gsb_module_ports(openfpga_ctx.module_graph(),
+                                                                                      openfpga_ctx.device_rr_gsb(),
+                                                                                      g_vpr_ctx.device().grid,
+                                                                                      openfpga_ctx.vpr_device_annotation(),
+                                                                                      g_vpr_ctx.device().rr_graph,
+                                                                                      num_threads);
+}
+
 /********************************************************************
  * Build the module graph for FPGA device
  *******************************************************************/
@@ -72,13 +103,69 @@ int build_fabric(OpenfpgaContext& openfpga_ctx,
   CommandOptionId opt_frame_view = cmd.option("frame_view");
   CommandOptionId opt_compress_routing = cmd.option("compress_routing");
   CommandOptionId opt_duplicate_grid_pin = cmd.option("duplicate_grid_pin");
+  CommandOptionId opt_dedup_pb_modules = cmd.option("dedup_pb_modules");
+  CommandOptionId opt_group_tile = cmd.option("group_tile");
   CommandOptionId opt_gen_random_fabric_key = cmd.option("generate_random_fabric_key");
   CommandOptionId opt_write_fabric_key = cmd.option("write_fabric_key");
   CommandOptionId opt_load_fabric_key = cmd.option("load_fabric_key");
+  CommandOptionId opt_fabric_key_format = cmd.option("fabric_key_format");
+  CommandOptionId opt_compact_nets = cmd.option("compact_nets");
+  CommandOptionId opt_net_arena = cmd.option("net_arena");
+  CommandOptionId opt_hugepage = cmd.option("hugepage");
+  CommandOptionId opt_load_cache = cmd.option("load_cache");
+  CommandOptionId opt_write_cache = cmd.option("write_cache");
+  CommandOptionId opt_threads = cmd.option("threads");
   CommandOptionId opt_verbose = cmd.option("verbose");
+
+  /* The builders of routing modules require the sorted incoming edges of GSBs */
+  if (true == openfpga_ctx.flow_manager().scratch_released()) {
+    VTR_LOG_ERROR("Intermediate data of builders have been released by '--release_scratch'! Please run 'link_openfpga_arch' again before building fabric\n");
+    return CMD_EXEC_FATAL_ERROR;
+  }
+
+  /* Use the default number of threads of the shell unless specified */
+  size_t num_threads = 1;
+  if (false == find_command_num_threads(cmd, cmd_context, opt_threads, num_threads)) {
+    return CMD_EXEC_FATAL_ERROR;
+  }
+
+  /* Check file format of fabric keys */
+  e_fabric_key_format fabric_key_format = FABRIC_KEY_FORMAT_XML;
+  if (true == cmd_context.option_enable(cmd, opt_fabric_key_format)) {
+    fabric_key_format = find_fabric_key_format(cmd_context.option_value(cmd, opt_fabric_key_format));
+    if (NUM_FABRIC_KEY_FORMATS == fabric_key_format) {
+      VTR_LOG_ERROR("Invalid fabric key format '%s' which should be either '%s' or '%s'!\n",
+                    cmd_context.option_value(cmd, opt_fabric_key_format).c_str(),
+                    FABRIC_KEY_FORMAT_STRING[FABRIC_KEY_FORMAT_XML],
+                    FABRIC_KEY_FORMAT_STRING[FABRIC_KEY_FORMAT_BIN]);
+      return CMD_EXEC_FATAL_ERROR;
+    }
+  }
+
+  /* Tiles are grouped from the nets of the top module, whose configurable children
+   * should be organized in the routine sequence of a configuration chain 
+   */
+  if (true == cmd_context.option_enable(cmd, opt_group_tile)) {
+    if (true == cmd_context.option_enable(cmd, opt_frame_view)) {
+      VTR_LOG_ERROR("Option '--group_tile' requires the nets of the fabric, which are skipped by '--frame_view'!\n");
+      return CMD_EXEC_FATAL_ERROR;
+    }
+    if ( (true == cmd_context.option_enable(cmd, opt_load_fabric_key))
+      || (true == cmd_context.option_enable(cmd, opt_gen_random_fabric_key)) ) {
+      VTR_LOG_ERROR("Option '--group_tile' is not compatible with fabric keys, i.e., '--load_fabric_key' and '--generate_random_fabric_key'!\n");
+      return CMD_EXEC_FATAL_ERROR;
+    }
+    if ( (CONFIG_MEM_STANDALONE != openfpga_ctx.arch().config_protocol.type())
+      && (CONFIG_MEM_SCAN_CHAIN != openfpga_ctx.arch().config_protocol.type()) ) {
+      VTR_LOG_ERROR("Option '--group_tile' only supports the configuration protocols '%s' and '%s'!\n",
+                    CONFIG_PROTOCOL_TYPE_STRING[CONFIG_MEM_STANDALONE],
+                    CONFIG_PROTOCOL_TYPE_STRING[CONFIG_MEM_SCAN_CHAIN]);
+      return CMD_EXEC_FATAL_ERROR;
+    }
+  }
   
   if (true == cmd_context.option_enable(cmd, opt_compress_routing)) {
-    compress_routing_hierarchy(openfpga_ctx, cmd_context.option_enable(cmd, opt_verbose));
+    compress_routing_hierarchy(openfpga_ctx, num_threads, cmd_context.option_enable(cmd, opt_verbose));
     /* Update flow manager to enable compress routing */
     openfpga_ctx.mutable_flow_manager().set_compress_routing(true);
   }
@@ -96,43 +183,118 @@ int build_fabric(OpenfpgaContext& openfpga_ctx,
   if (true == cmd_context.option_enable(cmd, opt_load_fabric_key)) {
     std::string fkey_fname = cmd_context.option_value(cmd, opt_load_fabric_key);
     VTR_ASSERT(false == fkey_fname.empty());
-    predefined_fabric_key = read_xml_fabric_key(fkey_fname.c_str());
+    if (FABRIC_KEY_FORMAT_BIN == fabric_key_format) {
+      predefined_fabric_key = read_bin_fabric_key(fkey_fname.c_str());
+    } else {
+      predefined_fabric_key = read_xml_fabric_key(fkey_fname.c_str());
+    }
   }
 
   VTR_LOG("\n");
 
-  curr_status = build_device_module_graph(openfpga_ctx.mutable_module_graph(),
-                                          openfpga_ctx.mutable_decoder_lib(),
-                                          const_cast<const OpenfpgaContext&>(openfpga_ctx),
-                                          g_vpr_ctx.device(),
-                                          cmd_context.option_enable(cmd, opt_frame_view),
-                                          cmd_context.option_enable(cmd, opt_compress_routing),
-                                          cmd_context.option_enable(cmd, opt_duplicate_grid_pin),
-                                          predefined_fabric_key,
-                                          cmd_context.option_enable(cmd, opt_gen_random_fabric_key),
-                                          cmd_context.option_enable(cmd, opt_verbose));
-
-  /* If there is any error, final status cannot be overwritten by a success flag */
-  if (CMD_EXEC_SUCCESS != curr_status) {
-    final_status = curr_status;
+  /* The cache of fabric is keyed by the architectures and the options
+   * which the module graph depends on
+   */
+  std::string cache_arch_hash;
+  if ( (true == cmd_context.option_enable(cmd, opt_load_cache))
+    || (true == cmd_context.option_enable(cmd, opt_write_cache)) ) {
+    std::string build_options;
+    build_options += cmd_context.option_enable(cmd, opt_frame_view) ? "1" : "0";
+    build_options += cmd_context.option_enable(cmd, opt_compress_routing) ? "1" : "0";
+    build_options += cmd_context.option_enable(cmd, opt_duplicate_grid_pin) ? "1" : "0";
+    build_options += cmd_context.option_enable(cmd, opt_gen_random_fabric_key) ? "1" : "0";
+    build_options += cmd_context.option_enable(cmd, opt_load_fabric_key) ? "1" : "0";
+    build_options += cmd_context.option_enable(cmd, opt_group_tile) ? "1" : "0";
+    build_options += cmd_context.option_enable(cmd, opt_dedup_pb_modules) ? "1" : "0";
+
+    std::string fkey_fname;
+    if (true == cmd_context.option_enable(cmd, opt_load_fabric_key)) {
+      fkey_fname = cmd_context.option_value(cmd, opt_load_fabric_key);
+    }
+
+    std::string cache_fname = cmd_context.option_enable(cmd, opt_load_cache)
+                            ? cmd_context.option_value(cmd, opt_load_cache)
+                            : cmd_context.option_value(cmd, opt_write_cache);
+    cache_arch_hash = compute_fabric_cache_arch_hash(cache_fname,
+                                                     g_vpr_ctx.device(),
+                                                     openfpga_ctx.arch(),
+                                                     build_options,
+                                                     fkey_fname);
   }
 
-  /* Build I/O location map */
-  openfpga_ctx.mutable_io_location_map() = build_fabric_io_location_map(openfpga_ctx.module_graph(),
-                                                                        g_vpr_ctx.device().grid);
+  /* The nets created afterwards, either by loading the cache or building the fabric, are allocated from the arena */
+  if (true == cmd_context.option_enable(cmd, opt_net_arena)) {
+    openfpga_ctx.mutable_module_graph().enable_net_arena(cmd_context.option_enable(cmd, opt_hugepage));
+  } else if (true == cmd_context.option_enable(cmd, opt_hugepage)) {
+    VTR_LOG_WARN("Option '--hugepage' is ignored as '--net_arena' is not enabled\n");
+  }
 
-  /* Build fabric global port information */
-  openfpga_ctx.mutable_fabric_global_port_info() = build_fabric_global_port_info(openfpga_ctx.module_graph(),
-                                                                                 openfpga_ctx.arch().tile_annotations,
-                                                                                 openfpga_ctx.arch().circuit_lib);
+  /* Update flow manager to record if tiles are grouped */
+  openfpga_ctx.mutable_flow_manager().set_group_tile(cmd_context.option_enable(cmd, opt_group_tile));
+
+  /* Try to load the fabric from cache and build it from scratch on a miss */
+  bool fabric_loaded = false;
+  if (true == cmd_context.option_enable(cmd, opt_load_cache)) {
+    std::string cache_fname = cmd_context.option_value(cmd, opt_load_cache);
+    VTR_ASSERT(false == cache_fname.empty());
+    fabric_loaded = (0 == read_fabric_cache(cache_fname,
+                                            cache_arch_hash,
+                                            openfpga_ctx.mutable_module_graph(),
+                                            openfpga_ctx.mutable_decoder_lib(),
+                                            cmd_context.option_enable(cmd, opt_verbose)));
+  }
+
+  if (false == fabric_loaded) {
+    curr_status = build_device_module_graph(openfpga_ctx.mutable_module_graph(),
+                                            openfpga_ctx.mutable_decoder_lib(),
+                                            const_cast<const OpenfpgaContext&>(openfpga_ctx),
+                                            g_vpr_ctx.device(),
+                                            cmd_context.option_enable(cmd, opt_frame_view),
+                                            cmd_context.option_enable(cmd, opt_compress_routing),
+                                            cmd_context.option_enable(cmd, opt_duplicate_grid_pin),
+                                            cmd_context.option_enable(cmd, opt_dedup_pb_modules),
+                                            cmd_context.option_enable(cmd, opt_group_tile),
+                                            predefined_fabric_key,
+                                            cmd_context.option_enable(cmd, opt_gen_random_fabric_key),
+                                            num_threads,
+                                            cmd_context.option_enable(cmd, opt_verbose));
+
+    /* If there is any error, final status cannot be overwritten by a success flag */
+    if (CMD_EXEC_SUCCESS != curr_status) {
+      final_status = curr_status;
+    }
+  }
+
+  /* Save the fabric to cache, which should be done before nets are packed */
+  if ( (CMD_EXEC_SUCCESS == final_status)
+    && (true == cmd_context.option_enable(cmd, opt_write_cache)) ) {
+    std::string cache_fname = cmd_context.option_value(cmd, opt_write_cache);
+    VTR_ASSERT(false == cache_fname.empty());
+    if (0 != write_fabric_cache(cache_fname,
+                                cache_arch_hash,
+                                openfpga_ctx.module_graph(),
+                                openfpga_ctx.decoder_lib(),
+                                cmd_context.option_enable(cmd, opt_verbose))) {
+      final_status = CMD_EXEC_FATAL_ERROR;
+    }
+  }
+
+  /* Pack the nets into compact storage as no more connections will be added */
+  if (true == cmd_context.option_enable(cmd, opt_compact_nets)) {
+    vtr::ScopedStartFinishTimer timer("Compact module nets");
+    openfpga_ctx.mutable_module_graph().freeze_nets();
+  }
+
+  build_fabric_annotations(openfpga_ctx, num_threads);
 
   /* Output fabric key if user requested */
   if (true == cmd_context.option_enable(cmd, opt_write_fabric_key)) {
     std::string fkey_fname = cmd_context.option_value(cmd, opt_write_fabric_key);
     VTR_ASSERT(false == fkey_fname.empty());
-    curr_status = write_fabric_key_to_xml_file(openfpga_ctx.module_graph(),
-                                               fkey_fname,
-                                               cmd_context.option_enable(cmd, opt_verbose));
+    curr_status = write_fabric_key_to_file(openfpga_ctx.module_graph(),
+                                           fkey_fname,
+                                           fabric_key_format,
+                                           cmd_context.option_enable(cmd, opt_verbose));
     /* If there is any error, final status cannot be overwritten by a success flag */
     if (CMD_EXEC_SUCCESS != curr_status) {
       final_status = curr_status;
@@ -171,12 +333,15 @@ int write_fabric_hierarchy(const OpenfpgaContext& openfpga_ctx,
     }
   }
 
+  CommandOptionId opt_compact = cmd.option("compact");
+
   std::string hie_file_name = cmd_context.option_value(cmd, opt_file);
 
   /* Write hierarchy to a file */
   return write_fabric_hierarchy_to_text_file(openfpga_ctx.module_graph(),
                                              hie_file_name,
                                              size_t(depth),
+                                             cmd_context.option_enable(cmd, opt_compact),
                                              cmd_context.option_enable(cmd, opt_verbose));
 }
 
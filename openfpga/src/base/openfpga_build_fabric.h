@@ -15,6 +15,13 @@
 /* begin namespace openfpga */
 namespace openfpga {
 
+void compress_routing_hierarchy(OpenfpgaContext& openfpga_ctx,
+                                const size_t& num_threads,
+                                const bool& verbose_output);
+
+void build_fabric_annotations(OpenfpgaContext& openfpga_ctx,
+                              const size_t& num_threads);
+
 int build_fabric(OpenfpgaContext& openfpga_ctx,
                  const Command& cmd, const CommandContext& cmd_context); 
 
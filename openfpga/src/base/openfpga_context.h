@@ -20,7 +20,10 @@
 #include "openfpga_flow_manager.h"
 #include "bitstream_manager.h"
 #include "fabric_bitstream.h"
+#include "fabric_bitstream_by_address.h"
+#include "bitstream_build_snapshot.h"
 #include "device_rr_gsb.h"
+#include "device_rr_gsb_module_ports.h"
 #include "io_location_map.h"
 #include "fabric_global_port_info.h"
 
@@ -63,6 +66,7 @@ class OpenfpgaContext : public Context  {
     const openfpga::VprRoutingAnnotation& vpr_routing_annotation() const { return vpr_routing_annotation_; }
     const openfpga::VprBitstreamAnnotation& vpr_bitstream_annotation() const { return vpr_bitstream_annotation_; }
     const openfpga::DeviceRRGSB& device_rr_gsb() const { return device_rr_gsb_; }
+    const openfpga::DeviceRRGSBModulePorts& device_rr_gsb_module_ports() const { return device_rr_gsb_module_ports_; }
     const openfpga::MuxLibrary& mux_lib() const { return mux_lib_; }
     const openfpga::DecoderLibrary& decoder_lib() const { return decoder_lib_; }
     const openfpga::TileDirect& tile_direct() const { return tile_direct_; }
@@ -70,6 +74,8 @@ class OpenfpgaContext : public Context  {
     const openfpga::FlowManager& flow_manager() const { return flow_manager_; }
     const openfpga::BitstreamManager& bitstream_manager() const { return bitstream_manager_; }
     const openfpga::FabricBitstream& fabric_bitstream() const { return fabric_bitstream_; }
+    const openfpga::FabricBitstreamByAddress& fabric_bitstream_by_address() const { return fabric_bitstream_by_address_; }
+    const openfpga::BitstreamBuildSnapshot& bitstream_build_snapshot() const { return bitstream_build_snapshot_; }
     const openfpga::IoLocationMap& io_location_map() const { return io_location_map_; }
     const openfpga::FabricGlobalPortInfo& fabric_global_port_info() const { return fabric_global_port_info_; }
     const openfpga::NetlistManager& verilog_netlists() const { return verilog_netlists_; }
@@ -85,6 +91,7 @@ class OpenfpgaContext : public Context  {
     openfpga::VprRoutingAnnotation& mutable_vpr_routing_annotation() { return vpr_routing_annotation_; }
     openfpga::VprBitstreamAnnotation& mutable_vpr_bitstream_annotation() { return vpr_bitstream_annotation_; }
     openfpga::DeviceRRGSB& mutable_device_rr_gsb() { return device_rr_gsb_; }
+    openfpga::DeviceRRGSBModulePorts& mutable_device_rr_gsb_module_ports() { return device_rr_gsb_module_ports_; }
     openfpga::MuxLibrary& mutable_mux_lib() { return mux_lib_; }
     openfpga::DecoderLibrary& mutable_decoder_lib() { return decoder_lib_; }
     openfpga::TileDirect& mutable_tile_direct() { return tile_direct_; }
@@ -92,10 +99,29 @@ class OpenfpgaContext : public Context  {
     openfpga::FlowManager& mutable_flow_manager() { return flow_manager_; }
     openfpga::BitstreamManager& mutable_bitstream_manager() { return bitstream_manager_; }
     openfpga::FabricBitstream& mutable_fabric_bitstream() { return fabric_bitstream_; }
+    openfpga::FabricBitstreamByAddress& mutable_fabric_bitstream_by_address() { return fabric_bitstream_by_address_; }
+    openfpga::BitstreamBuildSnapshot& mutable_bitstream_build_snapshot() { return bitstream_build_snapshot_; }
     openfpga::IoLocationMap& mutable_io_location_map() { return io_location_map_; }
     openfpga::FabricGlobalPortInfo& mutable_fabric_global_port_info() { return fabric_global_port_info_; }
     openfpga::NetlistManager& mutable_verilog_netlists() { return verilog_netlists_; }
     openfpga::NetlistManager& mutable_spice_netlists() { return spice_netlists_; }
+    /* Drop the data which is built on the VPR contexts of a benchmark,
+     * including the annotation to VPR and the bitstreams,
+     * so that another benchmark can be implemented on the fabric in this context
+     * The OpenFPGA architecture, the module graph and its look-ups are kept
+     */
+    void reset_benchmark_data() {
+      vpr_device_annotation_ = openfpga::VprDeviceAnnotation();
+      vpr_netlist_annotation_ = openfpga::VprNetlistAnnotation();
+      vpr_clustering_annotation_ = openfpga::VprClusteringAnnotation();
+      vpr_placement_annotation_ = openfpga::VprPlacementAnnotation();
+      vpr_routing_annotation_ = openfpga::VprRoutingAnnotation();
+      vpr_bitstream_annotation_ = openfpga::VprBitstreamAnnotation();
+      bitstream_manager_ = openfpga::BitstreamManager();
+      fabric_bitstream_ = openfpga::FabricBitstream();
+      fabric_bitstream_by_address_ = openfpga::FabricBitstreamByAddress();
+      bitstream_build_snapshot_.clear();
+    }
   private: /* Internal data */
     /* Data structure to store information from read_openfpga_arch library */
     openfpga::Arch arch_;
@@ -122,6 +148,9 @@ class OpenfpgaContext : public Context  {
 
     /* Device-level annotation */
     openfpga::DeviceRRGSB device_rr_gsb_;
+
+    /* Module ports of routing blocks, which are resolved from the GSBs */
+    openfpga::DeviceRRGSBModulePorts device_rr_gsb_module_ports_;
     
     /* Library of physical implmentation of routing multiplexers */
     openfpga::MuxLibrary mux_lib_;
@@ -140,6 +169,10 @@ class OpenfpgaContext : public Context  {
     /* Bitstream database */
     openfpga::BitstreamManager bitstream_manager_;
     openfpga::FabricBitstream fabric_bitstream_;
+    /* Fabric bitstream organized by addresses, shared by the writers of bitstream files and testbenches */
+    openfpga::FabricBitstreamByAddress fabric_bitstream_by_address_;
+    /* Implementation results of the architecture bitstream, used by incremental bitstream builds */
+    openfpga::BitstreamBuildSnapshot bitstream_build_snapshot_;
 
     /* Netlist database 
      * TODO: Each format should have an independent entry
@@ -0,0 +1,405 @@
+/***************************************************************************************
+ * This file includes functions to save the OpenFPGA context to a binary checkpoint file
+ * and to load it back, so that a flow can be split into stages, e.g.,
+ *   - architecture preparation: build_fabric
+ *   - implementation of a benchmark: repack and build_architecture_bitstream
+ *   - outputs: netlists, testbenches and bitstream files
+ * where each stage restarts from the checkpoint of the previous one
+ *
+ * A checkpoint contains the data which are expensive to build and do not refer to
+ * the internal data of VPR: the module graph with the decoder library, and the
+ * architecture bitstream. The other data, e.g., the annotation to VPR, are rebuilt by 
+ * running vpr and link_openfpga_arch before loading the checkpoint, 
+ * while the data derived from the module graph are rebuilt when it is loaded.
+ * The checkpoint is keyed by a hash of the VPR device and the OpenFPGA architecture
+ *
+ * Layout of the checkpoint, which is written by the binary archives of openfpga_binary_io.h
+ *   - magic:                string "OFPGACTX"
+ *   - version:              uint32
+ *   - architecture hash:    string, see fabric_cache.cpp
+ *   - flags:                uint8, see CONTEXT_CHECKPOINT_*
+ *   - if the fabric is saved:
+ *     - fabric:             in the format of the fabric cache, see fabric_cache.cpp
+ *   - if the architecture bitstream is saved:
+ *     - number of blocks:   uint32
+ *     - blocks:             name (string), parent block (uint32), path id (int32),
+ *                           input net ids (string), output net ids (string)
+ *     - for each block, its children:
+ *       - number of children: uint32
+ *       - children:         block (uint32)
+ *     - number of blocks with bits: uint32
+ *     - blocks with bits, in the sequence of their first bit:
+ *                           block (uint32), number of bits (uint32), 
+ *                           values of bits, packed by 8 bits per byte
+ *   Integers are in the byte order of the machine, and a string is stored as
+ *   its length (uint64) followed by its characters
+ ***************************************************************************************/
+#include <cstdio>
+#include <fstream>
+#include <algorithm>
+
+/* Headers from vtrutil library */
+#include "vtr_log.h"
+#include "vtr_assert.h"
+#include "vtr_time.h"
+
+/* Headers from openfpgashell library */
+#include "command_exit_codes.h"
+
+/* Headers from openfpgautil library */
+#include "openfpga_digest.h"
+#include "openfpga_binary_io.h"
+
+#include "fabric_cache.h"
+#include "openfpga_build_fabric.h"
+#include "openfpga_context_checkpoint.h"
+
+/* Include global variables of VPR */
+#include "globals.h"
+
+/* begin namespace openfpga */
+namespace openfpga {
+
+constexpr char CONTEXT_CHECKPOINT_MAGIC[] = "OFPGACTX";
+constexpr uint32_t CONTEXT_CHECKPOINT_VERSION = 3;
+constexpr uint32_t CONTEXT_CHECKPOINT_INVALID_ID = UINT32_MAX;
+
+/* Flags of the content of a checkpoint */
+constexpr uint8_t CONTEXT_CHECKPOINT_HAS_FABRIC = 1 << 0;
+constexpr uint8_t CONTEXT_CHECKPOINT_COMPRESS_ROUTING = 1 << 1;
+constexpr uint8_t CONTEXT_CHECKPOINT_HAS_BITSTREAM = 1 << 2;
+constexpr uint8_t CONTEXT_CHECKPOINT_GROUP_TILE = 1 << 3;
+
+/***************************************************************************************
+ * Compute the hash of the architectures which the checkpoint depends on
+ ***************************************************************************************/
+static
+std::string compute_context_checkpoint_arch_hash(const std::string& fname,
+                                                 const OpenfpgaContext& openfpga_ctx) {
+  return compute_fabric_cache_arch_hash(fname,
+                                        g_vpr_ctx.device(),
+                                        openfpga_ctx.arch(),
+                                        std::string("context_checkpoint"),
+                                        std::string());
+}
+
+/***************************************************************************************
+ * Encode the architecture bitstream
+ * Bits are stored by blocks in the sequence of their first bit, 
+ * so that the ids of bits are the same when they are decoded
+ ***************************************************************************************/
+static
+void write_bitstream_manager_to_checkpoint(BinaryWriter& writer,
+                                           const BitstreamManager& bitstream_manager) {
+  writer(static_cast<uint32_t>(bitstream_manager.num_blocks()));
+  for (const ConfigBlockId& block : bitstream_manager.blocks()) {
+    ConfigBlockId parent = bitstream_manager.block_parent(block);
+    writer(bitstream_manager.block_name(block));
+    writer(static_cast<uint32_t>(ConfigBlockId::INVALID() == parent ? CONTEXT_CHECKPOINT_INVALID_ID : size_t(parent)));
+    writer(static_cast<int32_t>(bitstream_manager.block_path_id(block)));
+    writer(bitstream_manager.block_input_net_ids(block));
+    writer(bitstream_manager.block_output_net_ids(block));
+  }
+
+  for (const ConfigBlockId& block : bitstream_manager.blocks()) {
+    std::vector<ConfigBlockId> children = bitstream_manager.block_children(block);
+    writer(static_cast<uint32_t>(children.size()));
+    for (const ConfigBlockId& child : children) {
+      writer(static_cast<uint32_t>(size_t(child)));
+    }
+  }
+
+  /* Blocks with bits in the sequence of their first bit */
+  std::vector<std::pair<ConfigBitId, ConfigBlockId>> bit_blocks;
+  for (const ConfigBlockId& block : bitstream_manager.blocks()) {
+    std::vector<ConfigBitId> block_bits = bitstream_manager.block_bits(block);
+    if (false == block_bits.empty()) {
+      bit_blocks.push_back(std::make_pair(block_bits.front(), block));
+    }
+  }
+  std::sort(bit_blocks.begin(), bit_blocks.end());
+
+  writer(static_cast<uint32_t>(bit_blocks.size()));
+  for (const auto& bit_block : bit_blocks) {
+    std::vector<ConfigBitId> block_bits = bitstream_manager.block_bits(bit_block.second);
+    writer(static_cast<uint32_t>(size_t(bit_block.second)));
+    writer(static_cast<uint32_t>(block_bits.size()));
+    for (size_t ibit = 0; ibit < block_bits.size(); ibit += 8) {
+      uint8_t packed_bits = 0;
+      for (size_t ipack = 0; (ipack < 8) && (ibit + ipack < block_bits.size()); ++ipack) {
+        if (true == bitstream_manager.bit_value(block_bits[ibit + ipack])) {
+          packed_bits |= 1 << ipack;
+        }
+      }
+      writer(static_cast<uint8_t>(packed_bits));
+    }
+  }
+}
+
+/***************************************************************************************
+ * Decode the architecture bitstream
+ * Return false if the checkpoint is corrupted
+ ***************************************************************************************/
+static
+bool read_bitstream_manager_from_checkpoint(BinaryReader& reader,
+                                            BitstreamManager& bitstream_manager) {
+  size_t num_blocks = reader.get<uint32_t>();
+  if (false == reader.good()) {
+    return false;
+  }
+  bitstream_manager.reserve_blocks(num_blocks);
+  for (size_t iblock = 0; iblock < num_blocks; ++iblock) {
+    std::string block_name = reader.get<std::string>();
+    reader.get<uint32_t>(); /* The parent is recovered from the children list */
+    int path_id = reader.get<int32_t>();
+    std::string input_net_ids = reader.get<std::string>();
+    std::string output_net_ids = reader.get<std::string>();
+    if (false == reader.good()) {
+      return false;
+    }
+    ConfigBlockId block = bitstream_manager.add_block(block_name);
+    bitstream_manager.add_path_id_to_block(block, path_id);
+    if (false == input_net_ids.empty()) {
+      bitstream_manager.add_input_net_id_to_block(block, input_net_ids);
+    }
+    if (false == output_net_ids.empty()) {
+      bitstream_manager.add_output_net_id_to_block(block, output_net_ids);
+    }
+  }
+
+  for (const ConfigBlockId& block : bitstream_manager.blocks()) {
+    size_t num_children = reader.get<uint32_t>();
+    if ( (false == reader.good())
+      || (num_blocks < num_children) ) {
+      return false;
+    }
+    bitstream_manager.reserve_child_blocks(block, num_children);
+    for (size_t ichild = 0; ichild < num_children; ++ichild) {
+      ConfigBlockId child = ConfigBlockId(reader.get<uint32_t>());
+      if ( (false == reader.good())
+        || (false == bitstream_manager.valid_block_id(child))
+        || (ConfigBlockId::INVALID() != bitstream_manager.block_parent(child)) ) {
+        return false;
+      }
+      bitstream_manager.add_child_block(block, child);
+    }
+  }
+
+  size_t num_bit_blocks = reader.get<uint32_t>();
+  if (false == reader.good()) {
+    return false;
+  }
+  for (size_t iblock = 0; iblock < num_bit_blocks; ++iblock) {
+    ConfigBlockId block = ConfigBlockId(reader.get<uint32_t>());
+    size_t num_bits = reader.get<uint32_t>();
+    if ( (false == reader.good())
+      || (false == bitstream_manager.valid_block_id(block))
+      || (0 == num_bits)
+      || (false == bitstream_manager.block_bits(block).empty()) ) {
+      return false;
+    }
+    std::vector<bool> block_bitstream(num_bits, false);
+    for (size_t ibit = 0; ibit < num_bits; ibit += 8) {
+      uint8_t packed_bits = reader.get<uint8_t>();
+      for (size_t ipack = 0; (ipack < 8) && (ibit + ipack < num_bits); ++ipack) {
+        block_bitstream[ibit + ipack] = (0 != (packed_bits & (1 << ipack)));
+      }
+    }
+    if (false == reader.good()) {
+      return false;
+    }
+    bitstream_manager.add_block_bits(block, block_bitstream);
+  }
+
+  return true;
+}
+
+/********************************************************************
+ * Save the module graph and the architecture bitstream of OpenFPGA context
+ * to a checkpoint file
+ * The checkpoint is written to a temporary file and then renamed, 
+ * so that other runs never see a partial file
+ *******************************************************************/
+int save_context(const OpenfpgaContext& openfpga_ctx,
+                 const Command& cmd, const CommandContext& cmd_context) { 
+
+  CommandOptionId opt_file = cmd.option("file");
+  CommandOptionId opt_verbose = cmd.option("verbose");
+  VTR_ASSERT(true == cmd_context.option_enable(cmd, opt_file));
+  std::string fname = cmd_context.option_value(cmd, opt_file);
+  VTR_ASSERT(false == fname.empty());
+
+  std::string arch_hash = compute_context_checkpoint_arch_hash(fname, openfpga_ctx);
+
+  vtr::ScopedStartFinishTimer timer("Write OpenFPGA context to checkpoint '" + fname + "'");
+
+  bool has_fabric = (0 < openfpga_ctx.module_graph().num_modules());
+  bool has_bitstream = (0 < openfpga_ctx.bitstream_manager().num_blocks());
+
+  uint8_t flags = 0;
+  if (true == has_fabric) {
+    flags |= CONTEXT_CHECKPOINT_HAS_FABRIC;
+  }
+  if (true == openfpga_ctx.flow_manager().compress_routing()) {
+    flags |= CONTEXT_CHECKPOINT_COMPRESS_ROUTING;
+  }
+  if (true == has_bitstream) {
+    flags |= CONTEXT_CHECKPOINT_HAS_BITSTREAM;
+  }
+  if (true == openfpga_ctx.flow_manager().group_tile()) {
+    flags |= CONTEXT_CHECKPOINT_GROUP_TILE;
+  }
+
+  std::string tmp_fname = fname + std::string(".tmp");
+  create_directory(find_path_dir_name(fname));
+  std::fstream fp;
+  fp.open(tmp_fname, std::fstream::out | std::fstream::trunc | std::fstream::binary);
+  if (false == fp.is_open()) {
+    VTR_LOG_ERROR("Fail to open checkpoint file '%s'!\n",
+                  tmp_fname.c_str());
+    return CMD_EXEC_FATAL_ERROR;
+  }
+
+  BinaryWriter writer(fp);
+  writer(std::string(CONTEXT_CHECKPOINT_MAGIC), CONTEXT_CHECKPOINT_VERSION, arch_hash, flags);
+
+  if (true == has_fabric) {
+    encode_fabric_cache(writer, arch_hash, openfpga_ctx.module_graph(), openfpga_ctx.decoder_lib());
+  }
+
+  if (true == has_bitstream) {
+    /* Checkpoints store all the blocks and bits, so shared bitstreams are copied to each block */
+    if (true == openfpga_ctx.bitstream_manager().has_shared_blocks()) {
+      BitstreamManager bitstream_manager = openfpga_ctx.bitstream_manager();
+      bitstream_manager.materialize_shared_blocks();
+      write_bitstream_manager_to_checkpoint(writer, bitstream_manager);
+    } else {
+      write_bitstream_manager_to_checkpoint(writer, openfpga_ctx.bitstream_manager());
+    }
+  }
+
+  bool written = writer.good();
+  fp.close();
+  if (false == written) {
+    VTR_LOG_ERROR("Fail to write checkpoint file '%s'!\n",
+                  tmp_fname.c_str());
+    std::remove(tmp_fname.c_str());
+    return CMD_EXEC_FATAL_ERROR;
+  }
+
+  if (0 != std::rename(tmp_fname.c_str(), fname.c_str())) {
+    VTR_LOG_ERROR("Fail to rename checkpoint file '%s' to '%s'!\n",
+                  tmp_fname.c_str(), fname.c_str());
+    std::remove(tmp_fname.c_str());
+    return CMD_EXEC_FATAL_ERROR;
+  }
+
+  VTR_LOGV(cmd_context.option_enable(cmd, opt_verbose),
+           "Saved %lu modules and %lu bits to checkpoint '%s'\n",
+           openfpga_ctx.module_graph().num_modules(),
+           openfpga_ctx.bitstream_manager().num_bits(),
+           fname.c_str());
+
+  return CMD_EXEC_SUCCESS;
+}
+
+/********************************************************************
+ * Load the module graph and the architecture bitstream of OpenFPGA context
+ * from a checkpoint file, and rebuild the data derived from the module graph
+ * The context is updated only when the whole checkpoint is decoded successfully
+ *******************************************************************/
+int load_context(OpenfpgaContext& openfpga_ctx,
+                 const Command& cmd, const CommandContext& cmd_context) { 
+
+  CommandOptionId opt_file = cmd.option("file");
+  CommandOptionId opt_verbose = cmd.option("verbose");
+  VTR_ASSERT(true == cmd_context.option_enable(cmd, opt_file));
+  std::string fname = cmd_context.option_value(cmd, opt_file);
+  VTR_ASSERT(false == fname.empty());
+
+  /* The fabric builders require the intermediate data of GSBs */
+  if (true == openfpga_ctx.flow_manager().scratch_released()) {
+    VTR_LOG_ERROR("Intermediate data of builders have been released by '--release_scratch'! Please run 'link_openfpga_arch' again before loading context\n");
+    return CMD_EXEC_FATAL_ERROR;
+  }
+
+  std::ifstream fp(fname, std::ifstream::in | std::ifstream::binary);
+  if (false == fp.is_open()) {
+    VTR_LOG_ERROR("Fail to open checkpoint file '%s'!\n",
+                  fname.c_str());
+    return CMD_EXEC_FATAL_ERROR;
+  }
+
+  std::string arch_hash = compute_context_checkpoint_arch_hash(fname, openfpga_ctx);
+
+  vtr::ScopedStartFinishTimer timer("Read OpenFPGA context from checkpoint '" + fname + "'");
+
+  BinaryReader reader(fp);
+  std::string magic = reader.get<std::string>();
+  uint32_t version = reader.get<uint32_t>();
+  std::string checkpoint_arch_hash = reader.get<std::string>();
+  uint8_t flags = reader.get<uint8_t>();
+  if ( (false == reader.good())
+    || (std::string(CONTEXT_CHECKPOINT_MAGIC) != magic)
+    || (CONTEXT_CHECKPOINT_VERSION != version) ) {
+    VTR_LOG_ERROR("Checkpoint '%s' is not a valid checkpoint of this version of OpenFPGA!\n",
+                  fname.c_str());
+    return CMD_EXEC_FATAL_ERROR;
+  }
+  if (arch_hash != checkpoint_arch_hash) {
+    VTR_LOG_ERROR("Checkpoint '%s' does not match the VPR and OpenFPGA architectures!\n",
+                  fname.c_str());
+    return CMD_EXEC_FATAL_ERROR;
+  }
+
+  ModuleManager module_manager;
+  DecoderLibrary decoder_lib;
+  if (0 != (flags & CONTEXT_CHECKPOINT_HAS_FABRIC)) {
+    if (0 != decode_fabric_cache(reader, arch_hash, module_manager, decoder_lib)) {
+      VTR_LOG_ERROR("Checkpoint '%s' is corrupted!\n",
+                    fname.c_str());
+      return CMD_EXEC_FATAL_ERROR;
+    }
+  }
+
+  BitstreamManager bitstream_manager;
+  if ( (0 != (flags & CONTEXT_CHECKPOINT_HAS_BITSTREAM))
+    && (false == read_bitstream_manager_from_checkpoint(reader, bitstream_manager)) ) {
+    VTR_LOG_ERROR("Checkpoint '%s' is corrupted!\n",
+                  fname.c_str());
+    return CMD_EXEC_FATAL_ERROR;
+  }
+
+  if (false == reader.at_end()) {
+    VTR_LOG_ERROR("Checkpoint '%s' is corrupted!\n",
+                  fname.c_str());
+    return CMD_EXEC_FATAL_ERROR;
+  }
+
+  if (0 != (flags & CONTEXT_CHECKPOINT_HAS_FABRIC)) {
+    if (0 != (flags & CONTEXT_CHECKPOINT_COMPRESS_ROUTING)) {
+      compress_routing_hierarchy(openfpga_ctx, 1, cmd_context.option_enable(cmd, opt_verbose));
+      openfpga_ctx.mutable_flow_manager().set_compress_routing(true);
+    }
+    openfpga_ctx.mutable_flow_manager().set_group_tile(0 != (flags & CONTEXT_CHECKPOINT_GROUP_TILE));
+    openfpga_ctx.mutable_module_graph() = std::move(module_manager);
+    openfpga_ctx.mutable_decoder_lib() = std::move(decoder_lib);
+    build_fabric_annotations(openfpga_ctx, 1);
+  }
+
+  if (0 != (flags & CONTEXT_CHECKPOINT_HAS_BITSTREAM)) {
+    openfpga_ctx.mutable_bitstream_manager() = std::move(bitstream_manager);
+    /* The implementation results of the loaded bitstream are unknown */
+    openfpga_ctx.mutable_bitstream_build_snapshot().clear();
+  }
+
+  VTR_LOGV(cmd_context.option_enable(cmd, opt_verbose),
+           "Loaded %lu modules and %lu bits from checkpoint '%s'\n",
+           openfpga_ctx.module_graph().num_modules(),
+           openfpga_ctx.bitstream_manager().num_bits(),
+           fname.c_str());
+
+  return CMD_EXEC_SUCCESS;
+}
+
+} /* end namespace openfpga */
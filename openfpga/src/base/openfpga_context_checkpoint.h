@@ -0,0 +1,26 @@
+#ifndef OPENFPGA_CONTEXT_CHECKPOINT_H
+#define OPENFPGA_CONTEXT_CHECKPOINT_H
+
+/********************************************************************
+ * Include header files that are required by function declaration
+ *******************************************************************/
+#include "command.h"
+#include "command_context.h"
+#include "openfpga_context.h"
+
+/********************************************************************
+ * Function declaration
+ *******************************************************************/
+
+/* begin namespace openfpga */
+namespace openfpga {
+
+int save_context(const OpenfpgaContext& openfpga_ctx,
+                 const Command& cmd, const CommandContext& cmd_context); 
+
+int load_context(OpenfpgaContext& openfpga_ctx,
+                 const Command& cmd, const CommandContext& cmd_context); 
+
+} /* end namespace openfpga */
+
+#endif
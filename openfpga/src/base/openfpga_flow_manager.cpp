@@ -14,6 +14,8 @@ namespace openfpga {
 FlowManager::FlowManager() {
   /* Turn off compress_routing as default */
   compress_routing_ = false;
+  group_tile_ = false;
+  scratch_released_ = false;
 }
 
 /**************************************************
@@ -23,6 +25,14 @@ bool FlowManager::compress_routing() const {
   return compress_routing_;
 }
 
+bool FlowManager::group_tile() const {
+  return group_tile_;
+}
+
+bool FlowManager::scratch_released() const {
+  return scratch_released_;
+}
+
 /******************************************************************************
  * Private Mutators
  ******************************************************************************/
@@ -30,5 +40,13 @@ void FlowManager::set_compress_routing(const bool& enabled) {
   compress_routing_ = enabled;
 }
 
+void FlowManager::set_group_tile(const bool& enabled) {
+  group_tile_ = enabled;
+}
+
+void FlowManager::set_scratch_released(const bool& released) {
+  scratch_released_ = released;
+}
+
 
 } /* end namespace openfpga */
@@ -19,10 +19,23 @@ class FlowManager {
     FlowManager();
   public: /* Public accessors */
     bool compress_routing() const;
+    /* Identify if the grids and routing blocks of the top module
+     * are grouped into tile modules
+     */
+    bool group_tile() const;
+    /* Identify if the intermediate data used by the builders of fabric and bitstream
+     * have been released. If so, the builders must not be called
+     * until the data are created again by link_openfpga_arch
+     */
+    bool scratch_released() const;
   public: /* Public mutators */
     void set_compress_routing(const bool& enabled);
+    void set_group_tile(const bool& enabled);
+    void set_scratch_released(const bool& released);
   private: /* Internal Data */
     bool compress_routing_;
+    bool group_tile_;
+    bool scratch_released_;
 };
 
 } /* End namespace openfpga*/
@@ -3,6 +3,8 @@
  * which are built on the libarchopenfpga library
  *******************************************************************/
 
+#include <cstdlib>
+
 /* Headers from vtrutil library */
 #include "vtr_time.h"
 #include "vtr_assert.h"
@@ -10,6 +12,7 @@
 
 /* Headers from openfpgashell library */
 #include "command_exit_codes.h"
+#include "command_threads.h"
 
 /* Headers from vpr library */
 #include "read_activity.h"
@@ -71,8 +74,15 @@ int link_arch(OpenfpgaContext& openfpga_ctx,
 
   CommandOptionId opt_activity_file = cmd.option("activity_file");
   CommandOptionId opt_sort_edge = cmd.option("sort_gsb_chan_node_in_edges");
+  CommandOptionId opt_threads = cmd.option("threads");
   CommandOptionId opt_verbose = cmd.option("verbose");
 
+  /* Use the default number of threads of the shell unless specified */
+  size_t num_threads = 1;
+  if (false == find_command_num_threads(cmd, cmd_context, opt_threads, num_threads)) {
+    return CMD_EXEC_FATAL_ERROR;
+  }
+
   /* Build fast look-up between physical tile pin index and port information */
   build_physical_tile_pin2port_info(g_vpr_ctx.device(),
                                     openfpga_ctx.mutable_vpr_device_annotation());
@@ -105,14 +115,30 @@ int link_arch(OpenfpgaContext& openfpga_ctx,
    * - net mapping to each rr_node 
    * - previous nodes driving each rr_node 
    */
+  /* The routed nodes of nets are loaded by VPR at the end of routing,
+   * they are loaded here if the routing was obtained in another way
+   */
+  if (g_vpr_ctx.routing().routed_net_nodes.num_nets() != g_vpr_ctx.routing().trace.size()) {
+    g_vpr_ctx.mutable_routing().routed_net_nodes.load(g_vpr_ctx.routing().trace);
+  }
+
   openfpga_ctx.mutable_vpr_routing_annotation().init(g_vpr_ctx.device().rr_graph);
 
+  /* Nets assigned to the global ports of tiles are skipped in the annotation of routing results */
+  if (CMD_EXEC_FATAL_ERROR == annotate_global_net_tile_ports(g_vpr_ctx.device(), g_vpr_ctx.clustering(), g_vpr_ctx.placement(),
+                                                             openfpga_ctx.arch().tile_annotations,
+                                                             openfpga_ctx.mutable_vpr_routing_annotation(),
+                                                             cmd_context.option_enable(cmd, opt_verbose))) {
+    return CMD_EXEC_FATAL_ERROR;
+  }
+
   annotate_rr_node_nets(g_vpr_ctx.device(), g_vpr_ctx.clustering(), g_vpr_ctx.routing(), 
                         openfpga_ctx.mutable_vpr_routing_annotation(),
                         cmd_context.option_enable(cmd, opt_verbose));
 
   annotate_rr_node_previous_nodes(g_vpr_ctx.device(), g_vpr_ctx.clustering(), g_vpr_ctx.routing(), 
                                   openfpga_ctx.mutable_vpr_routing_annotation(),
+                                  num_threads,
                                   cmd_context.option_enable(cmd, opt_verbose));
 
 
@@ -126,17 +152,32 @@ int link_arch(OpenfpgaContext& openfpga_ctx,
 
   annotate_device_rr_gsb(g_vpr_ctx.device(),
                          openfpga_ctx.mutable_device_rr_gsb(),
+                         num_threads,
                          cmd_context.option_enable(cmd, opt_verbose));
+  /* The intermediate data of builders are created again */
+  openfpga_ctx.mutable_flow_manager().set_scratch_released(false);
 
   if (true == cmd_context.option_enable(cmd, opt_sort_edge)) {
     sort_device_rr_gsb_chan_node_in_edges(g_vpr_ctx.device().rr_graph,
                                           openfpga_ctx.mutable_device_rr_gsb(),
+                                          num_threads,
                                           cmd_context.option_enable(cmd, opt_verbose));
   } 
 
+  /* Resolve the drivers of routing multiplexers, in the sequence of the (sorted) incoming edges */
+  openfpga_ctx.mutable_device_rr_gsb().build_mux_drivers(g_vpr_ctx.device().rr_graph,
+                                                         num_threads);
+
+  /* Count the used nodes of each GSB, so that unused GSBs can be found in O(1) */
+  annotate_gsb_used_nodes(openfpga_ctx.device_rr_gsb(),
+                          openfpga_ctx.mutable_vpr_routing_annotation(),
+                          num_threads,
+                          cmd_context.option_enable(cmd, opt_verbose));
+
   /* Build multiplexer library */
   openfpga_ctx.mutable_mux_lib() = build_device_mux_library(g_vpr_ctx.device(),
-                                                            const_cast<const OpenfpgaContext&>(openfpga_ctx)); 
+                                                            const_cast<const OpenfpgaContext&>(openfpga_ctx),
+                                                            num_threads); 
 
   /* Build tile direct annotation */
   openfpga_ctx.mutable_tile_direct() = build_device_tile_direct(g_vpr_ctx.device(),
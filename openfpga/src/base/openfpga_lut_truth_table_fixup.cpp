@@ -2,6 +2,10 @@
  * This file includes functions to fix up the pb pin mapping results 
  * after routing optimization
  *******************************************************************/
+#include <cstdlib>
+#include <utility>
+#include <vector>
+
 /* Headers from vtrutil library */
 #include "vtr_time.h"
 #include "vtr_assert.h"
@@ -9,10 +13,14 @@
 
 /* Headers from openfpgashell library */
 #include "command_exit_codes.h"
+#include "command_threads.h"
 
 /* Headers from vpr library */
 #include "vpr_utils.h"
 
+/* Headers from openfpgautil library */
+#include "openfpga_parallel.h"
+
 #include "pb_type_utils.h"
 #include "lut_utils.h"
 #include "openfpga_lut_truth_table_fixup.h"
@@ -29,12 +37,14 @@ namespace openfpga {
  *
  * Note: 
  *   - pb must represents a LUT pb in the graph and it should be primitive
+ *   - The adapted truth tables are recorded with their pbs, 
+ *     which are added to the clustering annotation by the caller
  *******************************************************************/
 static 
 void fix_up_lut_atom_block_truth_table(const AtomContext& atom_ctx,
                                        t_pb* pb,
                                        const t_pb_routes& pb_route,
-                                       VprClusteringAnnotation& vpr_clustering_annotation,
+                                       std::vector<std::pair<t_pb*, AtomNetlist::TruthTable>>& adapted_truth_tables,
                                        const bool& verbose) {
   t_pb_graph_node* pb_graph_node = pb->pb_graph_node;
   t_pb_type* pb_type = pb->pb_graph_node->pb_type;
@@ -89,7 +99,7 @@ void fix_up_lut_atom_block_truth_table(const AtomContext& atom_ctx,
      */
     const AtomNetlist::TruthTable& orig_tt = atom_ctx.nlist.block_truth_table(atom_blk);
     const AtomNetlist::TruthTable& adapt_tt = lut_truth_table_adaption(orig_tt, rotated_pin_map); 
-    vpr_clustering_annotation.adapt_truth_table(pb, adapt_tt);
+    adapted_truth_tables.push_back(std::make_pair(pb, adapt_tt));
 
     /* Print info is in the verbose mode */
     VTR_LOGV(verbose, "Original truth table\n");
@@ -135,7 +145,7 @@ static
 void rec_adapt_lut_pb_tt(const AtomContext& atom_ctx,
                          t_pb* pb,
                          const t_pb_routes& pb_route,
-                         VprClusteringAnnotation& vpr_clustering_annotation,
+                         std::vector<std::pair<t_pb*, AtomNetlist::TruthTable>>& adapted_truth_tables,
                          const bool& verbose) {
   t_pb_graph_node* pb_graph_node = pb->pb_graph_node; 
 
@@ -149,7 +159,7 @@ void rec_adapt_lut_pb_tt(const AtomContext& atom_ctx,
        * mode 1 is the regular mode
        */
       if (1 == pb->mode) {
-        fix_up_lut_atom_block_truth_table(atom_ctx, pb->child_pbs[0], pb_route, vpr_clustering_annotation, verbose);
+        fix_up_lut_atom_block_truth_table(atom_ctx, pb->child_pbs[0], pb_route, adapted_truth_tables, verbose);
       }
     }
     return;
@@ -162,7 +172,7 @@ void rec_adapt_lut_pb_tt(const AtomContext& atom_ctx,
     for (int jpb = 0; jpb < mapped_mode->pb_type_children[ipb].num_pb; ++jpb) {
       /* See if we still have any pb children to walk through */
       if ((pb->child_pbs[ipb] != nullptr) && (pb->child_pbs[ipb][jpb].name != nullptr)) {
-        rec_adapt_lut_pb_tt(atom_ctx, &(pb->child_pbs[ipb][jpb]), pb_route, vpr_clustering_annotation, verbose);
+        rec_adapt_lut_pb_tt(atom_ctx, &(pb->child_pbs[ipb][jpb]), pb_route, adapted_truth_tables, verbose);
       }
     }
   }
@@ -171,18 +181,32 @@ void rec_adapt_lut_pb_tt(const AtomContext& atom_ctx,
 /********************************************************************
  * Main function to fix up truth table for each LUT used in FPGA
  * This function will walk through each clustered block
+ *
+ * The clustered blocks are fixed up independently on multiple threads,
+ * while the truth tables are added to clustering annotation in the sequence
+ * of clustered blocks, so that the results are the same whatever number of threads is used.
+ * Verbose outputs of different clustered blocks may interleave 
+ * when multiple threads are used
  *******************************************************************/
 static 
 void update_lut_tt_with_post_packing_results(const AtomContext& atom_ctx,
                                              const ClusteringContext& clustering_ctx,
                                              VprClusteringAnnotation& vpr_clustering_annotation,
+                                             const size_t& num_threads,
                                              const bool& verbose) {
-  for (auto blk_id : clustering_ctx.clb_nlist.blocks()) {
-    rec_adapt_lut_pb_tt(atom_ctx,
-                        clustering_ctx.clb_nlist.block_pb(blk_id),
-                        clustering_ctx.clb_nlist.block_pb(blk_id)->pb_route,
-                        vpr_clustering_annotation, verbose);
-  }
+  typedef std::vector<std::pair<t_pb*, AtomNetlist::TruthTable>> t_adapted_truth_tables;
+  parallel_map_reduce<t_adapted_truth_tables>(clustering_ctx.clb_nlist.blocks(), num_threads,
+    [&](const ClusterBlockId& blk_id, t_adapted_truth_tables& adapted_truth_tables) {
+      rec_adapt_lut_pb_tt(atom_ctx,
+                          clustering_ctx.clb_nlist.block_pb(blk_id),
+                          clustering_ctx.clb_nlist.block_pb(blk_id)->pb_route,
+                          adapted_truth_tables, verbose);
+    },
+    [&](const ClusterBlockId& /*blk_id*/, t_adapted_truth_tables& adapted_truth_tables) {
+      for (const std::pair<t_pb*, AtomNetlist::TruthTable>& adapted_truth_table : adapted_truth_tables) {
+        vpr_clustering_annotation.adapt_truth_table(adapted_truth_table.first, adapted_truth_table.second);
+      }
+    });
 }
 
 /********************************************************************
@@ -201,12 +225,20 @@ int lut_truth_table_fixup(OpenfpgaContext& openfpga_context,
 
   vtr::ScopedStartFinishTimer timer("Fix up LUT truth tables after packing optimization");
 
+  CommandOptionId opt_threads = cmd.option("threads");
   CommandOptionId opt_verbose = cmd.option("verbose");
 
+  /* Use the default number of threads of the shell unless specified */
+  size_t num_threads = 1;
+  if (false == find_command_num_threads(cmd, cmd_context, opt_threads, num_threads)) {
+    return CMD_EXEC_FATAL_ERROR;
+  }
+
   /* Apply fix-up to each packed block */
   update_lut_tt_with_post_packing_results(g_vpr_ctx.atom(), 
                                           g_vpr_ctx.clustering(),
                                           openfpga_context.mutable_vpr_clustering_annotation(),
+                                          num_threads,
                                           cmd_context.option_enable(cmd, opt_verbose));
 
   /* TODO: should identify the error code from internal function execution */
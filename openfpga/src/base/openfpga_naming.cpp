@@ -184,6 +184,28 @@ std::string generate_memory_decoder_with_data_in_subckt_name(const size_t& addr_
   return subckt_name;
 } 
 
+/************************************************
+ * Generate the module name of a shift register
+ * which drives the bit-lines of memories
+ ***********************************************/
+std::string generate_bl_shift_register_subckt_name(const size_t& data_size) {
+  std::string subckt_name = "bl_shift_register_size";
+  subckt_name += std::to_string(data_size);
+
+  return subckt_name;
+} 
+
+/************************************************
+ * Generate the module name of a run-length decompressor
+ * which feeds the head of a configuration chain
+ ***********************************************/
+std::string generate_config_chain_decompressor_subckt_name(const size_t& run_length_width) {
+  std::string subckt_name = "ccff_rle_decompressor_size";
+  subckt_name += std::to_string(run_length_width);
+
+  return subckt_name;
+} 
+
 /************************************************
  * Generate the module name of a routing track wire
  ***********************************************/
@@ -278,20 +300,61 @@ std::string generate_connection_block_netlist_name(const t_rr_type& cb_type,
 }
 
 /*********************************************************************
- * Generate the module name for a unique routing channel
+ * Find the prefix of a routing channel, which is used by the names of
+ * routing channel modules and routing track ports
+ * Return a constant string rather than creating a map of strings,
+ * as the names are generated for every routing track
  *********************************************************************/
-std::string generate_routing_channel_module_name(const t_rr_type& chan_type, 
-                                                 const size_t& block_id) {
+static 
+const char* generate_routing_channel_prefix(const t_rr_type& chan_type) {
   /* Channel must be either CHANX or CHANY */
   VTR_ASSERT( (CHANX == chan_type) || (CHANY == chan_type) );
 
-  /* Create a map between chan_type and module_prefix */
-  std::map<t_rr_type, std::string> module_prefix_map;
-  /* TODO: use a constexpr string to replace the fixed name? */
-  module_prefix_map[CHANX] = std::string("chanx");
-  module_prefix_map[CHANY] = std::string("chany");
+  if (CHANX == chan_type) {
+    return "chanx";
+  }
+  return "chany";
+}
+
+/*********************************************************************
+ * Find the name of a port direction used by routing track ports
+ *********************************************************************/
+static 
+const char* generate_routing_track_port_direction_name(const PORTS& port_direction) {
+  switch (port_direction) {
+  case OUT_PORT:
+    return "out"; 
+  case IN_PORT:
+    return "in"; 
+  default:
+    VTR_LOG_ERROR("Invalid direction of chan_rr_node!\n");
+    exit(1);
+  }
+}
+
+/*********************************************************************
+ * Append a coordinate in the format of <x>__<y>_ to a name
+ *********************************************************************/
+static 
+void append_coordinate_to_name(std::string& name,
+                               const vtr::Point<size_t>& coordinate) {
+  name += std::to_string(coordinate.x());
+  name += "__";
+  name += std::to_string(coordinate.y());
+  name += '_';
+}
+
+/*********************************************************************
+ * Generate the module name for a unique routing channel
+ *********************************************************************/
+std::string generate_routing_channel_module_name(const t_rr_type& chan_type, 
+                                                 const size_t& block_id) {
+  std::string module_name(generate_routing_channel_prefix(chan_type));
+  module_name += '_';
+  module_name += std::to_string(block_id);
+  module_name += '_';
 
-  return std::string( module_prefix_map[chan_type] + std::string("_") + std::to_string(block_id) + std::string("_") );
+  return module_name;
 }
 
 /*********************************************************************
@@ -299,16 +362,13 @@ std::string generate_routing_channel_module_name(const t_rr_type& chan_type,
  *********************************************************************/
 std::string generate_routing_channel_module_name(const t_rr_type& chan_type, 
                                                  const vtr::Point<size_t>& coordinate) {
-  /* Channel must be either CHANX or CHANY */
-  VTR_ASSERT( (CHANX == chan_type) || (CHANY == chan_type) );
-
-  /* Create a map between chan_type and module_prefix */
-  std::map<t_rr_type, std::string> module_prefix_map;
-  /* TODO: use a constexpr string to replace the fixed name? */
-  module_prefix_map[CHANX] = std::string("chanx");
-  module_prefix_map[CHANY] = std::string("chany");
+  std::string module_name(generate_routing_channel_prefix(chan_type));
+  module_name += std::to_string(coordinate.x());
+  module_name += '_';
+  module_name += std::to_string(coordinate.y());
+  module_name += '_';
 
-  return std::string( module_prefix_map[chan_type] + std::to_string(coordinate.x()) + std::string("_") + std::to_string(coordinate.y()) + std::string("_") );
+  return module_name;
 }
 
 /*********************************************************************
@@ -321,32 +381,17 @@ std::string generate_routing_track_port_name(const t_rr_type& chan_type,
                                              const vtr::Point<size_t>& coordinate,
                                              const size_t& track_id,
                                              const PORTS& port_direction) {
-  /* Channel must be either CHANX or CHANY */
-  VTR_ASSERT( (CHANX == chan_type) || (CHANY == chan_type) );
-
-  /* Create a map between chan_type and module_prefix */
-  std::map<t_rr_type, std::string> module_prefix_map;
-  /* TODO: use a constexpr string to replace the fixed name? */
-  module_prefix_map[CHANX] = std::string("chanx");
-  module_prefix_map[CHANY] = std::string("chany");
+  std::string port_name(generate_routing_channel_prefix(chan_type));
+  port_name += '_';
+  append_coordinate_to_name(port_name, coordinate);
+  port_name += '_';
 
-  std::string port_name = module_prefix_map[chan_type]; 
-  port_name += std::string("_" + std::to_string(coordinate.x()) + std::string("__") + std::to_string(coordinate.y()) + std::string("__"));
-
-  switch (port_direction) {
-  case OUT_PORT:
-    port_name += std::string("out_"); 
-    break;
-  case IN_PORT:
-    port_name += std::string("in_"); 
-    break;
-  default:
-    VTR_LOG_ERROR("Invalid direction of chan_rr_node!\n");
-    exit(1);
-  }
+  port_name += generate_routing_track_port_direction_name(port_direction);
+  port_name += '_';
 
   /* Add the track id to the port name */
-  port_name += std::to_string(track_id) + std::string("_");
+  port_name += std::to_string(track_id);
+  port_name += '_';
 
   return port_name;
 }
@@ -359,39 +404,42 @@ std::string generate_routing_track_port_name(const t_rr_type& chan_type,
  * Instead, we use the relative location of the pins in the context of routing modules
  * so that each module can be instanciated across the fabric
  * Even though, port direction must be provided!
+ *
+ * There are only a few such names, which are created once
+ * and then copied for each call
  *********************************************************************/
 std::string generate_sb_module_track_port_name(const t_rr_type& chan_type, 
                                                const e_side& module_side,
                                                const PORTS& port_direction) {
   /* Channel must be either CHANX or CHANY */
   VTR_ASSERT( (CHANX == chan_type) || (CHANY == chan_type) );
+  /* Error out for invalid directions */
+  generate_routing_track_port_direction_name(port_direction);
+  VTR_ASSERT(NUM_SIDES > module_side);
+
+  /* Names are indexed by [chan_type][side][is_input], built once in a thread-safe way */
+  static const std::vector<std::string> port_names = []() {
+    std::vector<std::string> names;
+    for (const t_rr_type& curr_chan_type : {CHANX, CHANY}) {
+      for (size_t side = 0; side < NUM_SIDES; ++side) {
+        for (const PORTS& curr_direction : {OUT_PORT, IN_PORT}) {
+          std::string name(generate_routing_channel_prefix(curr_chan_type));
+          name += '_';
+          name += SideManager(side).to_string();
+          name += '_';
+          name += generate_routing_track_port_direction_name(curr_direction);
+          names.push_back(name);
+        }
+      }
+    }
+    return names;
+  }();
 
-  /* Create a map between chan_type and module_prefix */
-  std::map<t_rr_type, std::string> module_prefix_map;
-  /* TODO: use a constexpr string to replace the fixed name? */
-  module_prefix_map[CHANX] = std::string("chanx");
-  module_prefix_map[CHANY] = std::string("chany");
-
-  std::string port_name = module_prefix_map[chan_type]; 
-  port_name += std::string("_");
-
-  SideManager side_manager(module_side);
-  port_name += std::string(side_manager.to_string());
-  port_name += std::string("_");
+  size_t name_index = (CHANX == chan_type) ? 0 : 1;
+  name_index = name_index * NUM_SIDES + size_t(module_side);
+  name_index = name_index * 2 + ((IN_PORT == port_direction) ? 1 : 0);
 
-  switch (port_direction) {
-  case OUT_PORT:
-    port_name += std::string("out"); 
-    break;
-  case IN_PORT:
-    port_name += std::string("in"); 
-    break;
-  default:
-    VTR_LOG_ERROR("Invalid direction of chan_rr_node!\n");
-    exit(1);
-  }
-
-  return port_name;
+  return port_names[name_index];
 }
 
 /*********************************************************************
@@ -419,28 +467,15 @@ std::string generate_cb_module_track_port_name(const t_rr_type& chan_type,
   /* Channel must be either CHANX or CHANY */
   VTR_ASSERT( (CHANX == chan_type) || (CHANY == chan_type) );
 
-  /* Create a map between chan_type and module_prefix */
-  std::map<t_rr_type, std::map<bool, std::string>> module_prefix_map;
-  /* TODO: use a constexpr string to replace the fixed name? */
-  module_prefix_map[CHANX][true] = std::string("chanx_left");
-  module_prefix_map[CHANX][false] = std::string("chanx_right");
-  module_prefix_map[CHANY][true] = std::string("chany_bottom");
-  module_prefix_map[CHANY][false] = std::string("chany_top");
-
-  std::string port_name = module_prefix_map[chan_type][upper_location];
-  port_name += std::string("_");
-
-  switch (port_direction) {
-  case OUT_PORT:
-    port_name += std::string("out"); 
-    break;
-  case IN_PORT:
-    port_name += std::string("in"); 
-    break;
-  default:
-    VTR_LOG_ERROR("Invalid direction of chan_rr_node!\n");
-    exit(1);
+  std::string port_name;
+  if (CHANX == chan_type) {
+    port_name = (true == upper_location) ? "chanx_left" : "chanx_right";
+  } else {
+    port_name = (true == upper_location) ? "chany_bottom" : "chany_top";
   }
+  port_name += '_';
+
+  port_name += generate_routing_track_port_direction_name(port_direction);
 
   return port_name;
 }
@@ -452,22 +487,16 @@ std::string generate_cb_module_track_port_name(const t_rr_type& chan_type,
 std::string generate_routing_track_middle_output_port_name(const t_rr_type& chan_type, 
                                                            const vtr::Point<size_t>& coordinate,
                                                            const size_t& track_id) {
-  /* Channel must be either CHANX or CHANY */
-  VTR_ASSERT( (CHANX == chan_type) || (CHANY == chan_type) );
-
-  /* Create a map between chan_type and module_prefix */
-  std::map<t_rr_type, std::string> module_prefix_map;
-  /* TODO: use a constexpr string to replace the fixed name? */
-  module_prefix_map[CHANX] = std::string("chanx");
-  module_prefix_map[CHANY] = std::string("chany");
-
-  std::string port_name = module_prefix_map[chan_type]; 
-  port_name += std::string("_" + std::to_string(coordinate.x()) + std::string("__") + std::to_string(coordinate.y()) + std::string("__"));
+  std::string port_name(generate_routing_channel_prefix(chan_type));
+  port_name += '_';
+  append_coordinate_to_name(port_name, coordinate);
+  port_name += '_';
 
-  port_name += std::string("midout_"); 
+  port_name += "midout_"; 
 
   /* Add the track id to the port name */
-  port_name += std::to_string(track_id) + std::string("_");
+  port_name += std::to_string(track_id);
+  port_name += '_';
 
   return port_name;
 }
@@ -476,7 +505,10 @@ std::string generate_routing_track_middle_output_port_name(const t_rr_type& chan
  * Generate the module name for a switch block with a given coordinate
  *********************************************************************/
 std::string generate_switch_block_module_name(const vtr::Point<size_t>& coordinate) {
-  return std::string( "sb_" + std::to_string(coordinate.x()) + std::string("__") + std::to_string(coordinate.y()) + std::string("_") );
+  std::string module_name("sb_");
+  append_coordinate_to_name(module_name, coordinate);
+
+  return module_name;
 }
 
 /*********************************************************************
@@ -484,20 +516,33 @@ std::string generate_switch_block_module_name(const vtr::Point<size_t>& coordina
  *********************************************************************/
 std::string generate_connection_block_module_name(const t_rr_type& cb_type, 
                                                   const vtr::Point<size_t>& coordinate) {
-  std::string prefix("cb");
+  std::string module_name("cb");
   switch (cb_type) {
   case CHANX:
-    prefix += std::string("x_");
+    module_name += "x_";
     break;
   case CHANY:
-    prefix += std::string("y_");
+    module_name += "y_";
     break;
   default:
     VTR_LOG_ERROR("Invalid type of connection block!\n");
     exit(1);
   }
 
-  return std::string( prefix + std::to_string(coordinate.x()) + std::string("__") + std::to_string(coordinate.y()) + std::string("_") );
+  append_coordinate_to_name(module_name, coordinate);
+
+  return module_name;
+}
+
+/*********************************************************************
+ * Generate the module name for a tile, which groups a grid 
+ * and its adjacent routing blocks, with a given coordinate
+ *********************************************************************/
+std::string generate_tile_module_name(const vtr::Point<size_t>& coordinate) {
+  std::string module_name("tile_");
+  append_coordinate_to_name(module_name, coordinate);
+
+  return module_name;
 }
 
 /*********************************************************************
@@ -57,6 +57,10 @@ std::string generate_memory_decoder_subckt_name(const size_t& addr_size,
 std::string generate_memory_decoder_with_data_in_subckt_name(const size_t& addr_size, 
                                                              const size_t& data_size);
 
+std::string generate_bl_shift_register_subckt_name(const size_t& data_size);
+
+std::string generate_config_chain_decompressor_subckt_name(const size_t& run_length_width);
+
 std::string generate_segment_wire_subckt_name(const std::string& wire_model_name, 
                                               const size_t& segment_id); 
 
@@ -107,6 +111,8 @@ std::string generate_switch_block_module_name(const vtr::Point<size_t>& coordina
 std::string generate_connection_block_module_name(const t_rr_type& cb_type, 
                                                   const vtr::Point<size_t>& coordinate);
 
+std::string generate_tile_module_name(const vtr::Point<size_t>& coordinate);
+
 std::string generate_sb_mux_instance_name(const std::string& prefix,
                                           const e_side& sb_side, 
                                           const size_t& track_id, 
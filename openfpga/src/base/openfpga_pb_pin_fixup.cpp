@@ -2,6 +2,9 @@
  * This file includes functions to fix up the pb pin mapping results 
  * after routing optimization
  *******************************************************************/
+#include <cstdlib>
+#include <vector>
+
 /* Headers from vtrutil library */
 #include "vtr_time.h"
 #include "vtr_assert.h"
@@ -9,12 +12,14 @@
 
 /* Headers from openfpgashell library */
 #include "command_exit_codes.h"
+#include "command_threads.h"
 
 /* Headers from vpr library */
 #include "vpr_utils.h"
 
 /* Headers from openfpgautil library */
 #include "openfpga_side_manager.h"
+#include "openfpga_parallel.h"
 
 #include "pb_type_utils.h"
 #include "openfpga_physical_tile_utils.h"
@@ -32,13 +37,17 @@ namespace openfpga {
  *    - find a corresponding node in RRGraph object
  *    - find the net id for the node in routing context
  *    - find the net id for the node in clustering context
- *    - if the net id does not match, we update the clustering context
+ *    - if the net id does not match, we record the pin and the net id of routing results
+ *
+ * This function only reads the shared contexts and annotations,
+ * so that clustered blocks can be fixed up in parallel.
+ * The caller is in charge of renaming the recorded nets in clustering annotation
  *******************************************************************/
 static 
 void update_cluster_pin_with_post_routing_results(const DeviceContext& device_ctx,
                                                   const ClusteringContext& clustering_ctx,
                                                   const VprRoutingAnnotation& vpr_routing_annotation,
-                                                  VprClusteringAnnotation& vpr_clustering_annotation,
+                                                  std::vector<std::pair<int, ClusterNetId>>& renamed_nets,
                                                   const vtr::Point<size_t>& grid_coord,
                                                   const ClusterBlockId& blk_id,
                                                   const e_side& border_side,
@@ -143,7 +152,7 @@ void update_cluster_pin_with_post_routing_results(const DeviceContext& device_ct
     }
 
     /* Add to net modification */
-    vpr_clustering_annotation.rename_net(blk_id, j, routing_net_id);
+    renamed_nets.push_back(std::make_pair(j, routing_net_id));
  
     std::string routing_net_name("unmapped");
     if (ClusterNetId::INVALID() != routing_net_id) {
@@ -171,6 +180,12 @@ void update_cluster_pin_with_post_routing_results(const DeviceContext& device_ct
 /********************************************************************
  * Main function to fix up the pb pin mapping results 
  * This function will walk through each grid
+ *
+ * The clustered blocks are fixed up independently on multiple threads,
+ * while the nets are renamed in clustering annotation in the sequence
+ * of grids, so that the results are the same whatever number of threads is used.
+ * Verbose outputs of different clustered blocks may interleave 
+ * when multiple threads are used
  *******************************************************************/
 static 
 void update_pb_pin_with_post_routing_results(const DeviceContext& device_ctx,
@@ -178,7 +193,13 @@ void update_pb_pin_with_post_routing_results(const DeviceContext& device_ctx,
                                              const PlacementContext& placement_ctx,
                                              const VprRoutingAnnotation& vpr_routing_annotation,
                                              VprClusteringAnnotation& vpr_clustering_annotation,
+                                             const size_t& num_threads,
                                              const bool& verbose) {
+  /* Collect the clustered blocks with their grid coordinates and border sides */
+  std::vector<vtr::Point<size_t>> blk_coords;
+  std::vector<ClusterBlockId> blk_ids;
+  std::vector<e_side> blk_border_sides;
+
   /* Update the core logic (center blocks of the FPGA) */
   for (size_t x = 1; x < device_ctx.grid.width() - 1; ++x) {
     for (size_t y = 1; y < device_ctx.grid.height() - 1; ++y) {
@@ -193,13 +214,9 @@ void update_pb_pin_with_post_routing_results(const DeviceContext& device_ctx,
           continue;
         }
         /* We know the entrance to grid info and mapping results, do the fix-up for this block */
-        vtr::Point<size_t> grid_coord(x, y);
-        update_cluster_pin_with_post_routing_results(device_ctx, clustering_ctx, 
-                                                     vpr_routing_annotation,
-                                                     vpr_clustering_annotation,
-                                                     grid_coord, cluster_blk_id, NUM_SIDES,
-                                                     placement_ctx.block_locs[cluster_blk_id].loc.z,
-                                                     verbose);
+        blk_coords.push_back(vtr::Point<size_t>(x, y));
+        blk_ids.push_back(cluster_blk_id);
+        blk_border_sides.push_back(NUM_SIDES);
       } 
     }
   }
@@ -242,15 +259,34 @@ void update_pb_pin_with_post_routing_results(const DeviceContext& device_ctx,
           continue;
         }
         /* Update on I/O grid */
-        update_cluster_pin_with_post_routing_results(device_ctx, clustering_ctx, 
-                                                     vpr_routing_annotation,
-                                                     vpr_clustering_annotation,
-                                                     io_coord, cluster_blk_id, io_side,
-                                                     placement_ctx.block_locs[cluster_blk_id].loc.z,
-                                                     verbose);
+        blk_coords.push_back(io_coord);
+        blk_ids.push_back(cluster_blk_id);
+        blk_border_sides.push_back(io_side);
       }
     }
   }
+
+  /* Build the fast look-up of routing resource graph before threads query it */
+  device_ctx.rr_graph.initialize_fast_node_lookup();
+
+  /* Find the nets to be renamed for each clustered block */
+  std::vector<std::vector<std::pair<int, ClusterNetId>>> blk_renamed_nets(blk_ids.size());
+  parallel_for(blk_ids.size(), num_threads,
+               [&](const size_t& iblk) {
+                 update_cluster_pin_with_post_routing_results(device_ctx, clustering_ctx, 
+                                                              vpr_routing_annotation,
+                                                              blk_renamed_nets[iblk],
+                                                              blk_coords[iblk], blk_ids[iblk], blk_border_sides[iblk],
+                                                              placement_ctx.block_locs[blk_ids[iblk]].loc.z,
+                                                              verbose);
+               });
+
+  /* Rename the nets in the same order as sequential flow */
+  for (size_t iblk = 0; iblk < blk_ids.size(); ++iblk) {
+    for (const std::pair<int, ClusterNetId>& renamed_net : blk_renamed_nets[iblk]) {
+      vpr_clustering_annotation.rename_net(blk_ids[iblk], renamed_net.first, renamed_net.second);
+    }
+  }
 }
 
 /********************************************************************
@@ -269,14 +305,22 @@ int pb_pin_fixup(OpenfpgaContext& openfpga_context,
 
   vtr::ScopedStartFinishTimer timer("Fix up pb pin mapping results after routing optimization");
 
+  CommandOptionId opt_threads = cmd.option("threads");
   CommandOptionId opt_verbose = cmd.option("verbose");
 
+  /* Use the default number of threads of the shell unless specified */
+  size_t num_threads = 1;
+  if (false == find_command_num_threads(cmd, cmd_context, opt_threads, num_threads)) {
+    return CMD_EXEC_FATAL_ERROR;
+  }
+
   /* Apply fix-up to each grid */
   update_pb_pin_with_post_routing_results(g_vpr_ctx.device(),
                                           g_vpr_ctx.clustering(),
                                           g_vpr_ctx.placement(), 
                                           openfpga_context.vpr_routing_annotation(),
                                           openfpga_context.mutable_vpr_clustering_annotation(),
+                                          num_threads,
                                           cmd_context.option_enable(cmd, opt_verbose));
 
   /* TODO: should identify the error code from internal function execution */
@@ -14,6 +14,7 @@
 #include "circuit_library_utils.h"
 #include "check_tile_annotation.h"
 #include "write_xml_openfpga_arch.h"
+#include "openfpga_arch_image.h"
 
 #include "openfpga_read_arch.h"
 
@@ -42,26 +43,54 @@ int read_arch(OpenfpgaContext& openfpga_context,
 
   std::string arch_file_name = cmd_context.option_value(cmd, opt_file);
 
-  VTR_LOG("Reading XML architecture '%s'...\n",
-          arch_file_name.c_str());
-  openfpga_context.mutable_arch() = read_xml_openfpga_arch(arch_file_name.c_str());
+  CommandOptionId opt_image = cmd.option("image");
+  std::string image_file_name;
+  if (true == cmd_context.option_enable(cmd, opt_image)) {
+    image_file_name = cmd_context.option_value(cmd, opt_image);
+  }
 
-  /* Check the architecture:
-   * 1. Circuit library
-   * 2. Tile annotation
-   * 3. Technology library (TODO)
-   * 4. Simulation settings (TODO)
+  /* An up-to-date image has passed the checks on the circuit library
+   * when it was created, so that the checks can be skipped
    */
-  if (false == check_circuit_library(openfpga_context.arch().circuit_lib)) {
-    return CMD_EXEC_FATAL_ERROR;
+  bool load_image = false;
+  if (false == image_file_name.empty()) {
+    VTR_LOG("Reading architecture image '%s'...\n",
+            image_file_name.c_str());
+    load_image = read_openfpga_arch_image(image_file_name.c_str(),
+                                          arch_file_name.c_str(),
+                                          openfpga_context.mutable_arch());
   }
 
-  if (false == check_configurable_memory_circuit_model(openfpga_context.arch().config_protocol.type(),
-                                                       openfpga_context.arch().circuit_lib,
-                                                       openfpga_context.arch().config_protocol.memory_model())) {
-    return CMD_EXEC_FATAL_ERROR;
+  if (false == load_image) {
+    VTR_LOG("Reading XML architecture '%s'...\n",
+            arch_file_name.c_str());
+    openfpga_context.mutable_arch() = read_xml_openfpga_arch(arch_file_name.c_str());
+
+    /* Check the architecture:
+     * 1. Circuit library
+     * 2. Tile annotation
+     * 3. Technology library (TODO)
+     * 4. Simulation settings (TODO)
+     */
+    if (false == check_circuit_library(openfpga_context.arch().circuit_lib)) {
+      return CMD_EXEC_FATAL_ERROR;
+    }
+
+    if (false == check_configurable_memory_circuit_model(openfpga_context.arch().config_protocol.type(),
+                                                         openfpga_context.arch().circuit_lib,
+                                                         openfpga_context.arch().config_protocol.memory_model())) {
+      return CMD_EXEC_FATAL_ERROR;
+    }
+
+    if (false == image_file_name.empty()) {
+      write_openfpga_arch_image(image_file_name.c_str(),
+                                arch_file_name.c_str(),
+                                openfpga_context.arch());
+    }
   }
 
+  /* Tile annotation depends on the VPR architecture, which is not part of the image */
+
   if (false == check_tile_annotation(openfpga_context.arch().tile_annotations,
                                      openfpga_context.arch().circuit_lib,
                                      g_vpr_ctx.device().physical_tile_types)) {
@@ -1,12 +1,15 @@
 /********************************************************************
  * This file includes functions to compress the hierachy of routing architecture
  *******************************************************************/
+#include <cstdlib>
+
 /* Headers from vtrutil library */
 #include "vtr_time.h"
 #include "vtr_log.h"
 
 /* Headers from openfpgashell library */
 #include "command_exit_codes.h"
+#include "command_threads.h"
 
 /* Headers from librepackdc library */
 #include "repack_design_constraints.h"
@@ -30,8 +33,17 @@ int repack(OpenfpgaContext& openfpga_ctx,
            const Command& cmd, const CommandContext& cmd_context) {
 
   CommandOptionId opt_design_constraints = cmd.option("design_constraints");
+  CommandOptionId opt_lb_rr_graph_cache = cmd.option("lb_rr_graph_cache");
+  CommandOptionId opt_threads = cmd.option("threads");
+  CommandOptionId opt_lookahead = cmd.option("lookahead");
   CommandOptionId opt_verbose = cmd.option("verbose");
 
+  /* Use the default number of threads of the shell unless specified */
+  size_t num_threads = 1;
+  if (false == find_command_num_threads(cmd, cmd_context, opt_threads, num_threads)) {
+    return CMD_EXEC_FATAL_ERROR;
+  }
+
   /* Load design constraints from file */
   RepackDesignConstraints repack_design_constraints;
   if (true == cmd_context.option_enable(cmd, opt_design_constraints)) {
@@ -40,6 +52,13 @@ int repack(OpenfpgaContext& openfpga_ctx,
     repack_design_constraints = read_xml_repack_design_constraints(dc_fname.c_str());
   }
 
+  /* Use no cache for the physical lb_rr_graphs unless specified */
+  std::string lb_rr_graph_cache_dir;
+  if (true == cmd_context.option_enable(cmd, opt_lb_rr_graph_cache)) {
+    lb_rr_graph_cache_dir = cmd_context.option_value(cmd, opt_lb_rr_graph_cache);
+    VTR_ASSERT(false == lb_rr_graph_cache_dir.empty());
+  }
+
   pack_physical_pbs(g_vpr_ctx.device(),
                     g_vpr_ctx.atom(),
                     g_vpr_ctx.clustering(),
@@ -48,6 +67,9 @@ int repack(OpenfpgaContext& openfpga_ctx,
                     openfpga_ctx.vpr_bitstream_annotation(),
                     repack_design_constraints,
                     openfpga_ctx.arch().circuit_lib,
+                    lb_rr_graph_cache_dir,
+                    num_threads,
+                    cmd_context.option_enable(cmd, opt_lookahead),
                     cmd_context.option_enable(cmd, opt_verbose));
 
   build_physical_lut_truth_tables(openfpga_ctx.mutable_vpr_clustering_annotation(),
@@ -0,0 +1,99 @@
+/********************************************************************
+ * This file includes functions to report the memory usage 
+ * of the databases in OpenFPGA context
+ *******************************************************************/
+#include <string>
+
+/* Headers from vtrutil library */
+#include "vtr_time.h"
+#include "vtr_log.h"
+#include "vtr_rusage.h"
+
+/* Headers from openfpgashell library */
+#include "command_exit_codes.h"
+
+#include "openfpga_report_memory.h"
+
+/* begin namespace openfpga */
+namespace openfpga {
+
+/* Convert bytes to MiB */
+constexpr double BYTES_PER_MIB = 1024. * 1024.;
+
+/********************************************************************
+ * Print the memory usage of a database on a line
+ *******************************************************************/
+static 
+void report_database_memory(const std::string& database_name,
+                            const size_t& num_bytes,
+                            const size_t& indent) {
+  VTR_LOG("%*s%-*s: %12.2f\n",
+          int(indent), "",
+          int(48 - indent), database_name.c_str(),
+          num_bytes / BYTES_PER_MIB);
+}
+
+/********************************************************************
+ * Release the memory which is reserved but not used by the databases 
+ * that are finished, i.e., the module graph and the bitstreams.
+ * The nets of the module graph are packed into compact storage, 
+ * so that no more nets can be added afterwards
+ *******************************************************************/
+static 
+void compact_openfpga_databases(OpenfpgaContext& openfpga_ctx) {
+  vtr::ScopedStartFinishTimer timer("Compact OpenFPGA databases");
+
+  openfpga_ctx.mutable_module_graph().freeze_nets();
+  openfpga_ctx.mutable_bitstream_manager().shrink_to_fit();
+  openfpga_ctx.mutable_fabric_bitstream().shrink_to_fit();
+}
+
+/********************************************************************
+ * Report the approximate heap memory held by each database in OpenFPGA context
+ * The memory is estimated from the capacity of the containers in each database,
+ * which does not include the overhead of memory allocators.
+ * The peak memory of the process is also reported as a reference
+ *******************************************************************/
+int report_memory(OpenfpgaContext& openfpga_ctx,
+                  const Command& cmd, const CommandContext& cmd_context) { 
+
+  CommandOptionId opt_compact = cmd.option("compact");
+
+  if (true == cmd_context.option_enable(cmd, opt_compact)) {
+    compact_openfpga_databases(openfpga_ctx);
+  }
+
+  const VprDeviceAnnotation& vpr_device_annotation = openfpga_ctx.vpr_device_annotation();
+  const ModuleManager& module_manager = openfpga_ctx.module_graph();
+
+  size_t device_annotation_bytes = vpr_device_annotation.memory_usage();
+  size_t lb_rr_graph_bytes = vpr_device_annotation.physical_lb_rr_graph_memory_usage();
+  size_t device_rr_gsb_bytes = openfpga_ctx.device_rr_gsb().memory_usage();
+  size_t module_graph_bytes = module_manager.memory_usage();
+  size_t bitstream_manager_bytes = openfpga_ctx.bitstream_manager().memory_usage();
+  size_t fabric_bitstream_bytes = openfpga_ctx.fabric_bitstream().memory_usage();
+  size_t verilog_netlists_bytes = openfpga_ctx.verilog_netlists().memory_usage();
+  size_t spice_netlists_bytes = openfpga_ctx.spice_netlists().memory_usage();
+
+  VTR_LOG("Approximate memory usage of OpenFPGA databases (MiB):\n");
+  report_database_memory("Annotation to VPR device", device_annotation_bytes, 2);
+  report_database_memory("Physical routing graphs of logical blocks", lb_rr_graph_bytes, 2);
+  report_database_memory("General switch blocks", device_rr_gsb_bytes, 2);
+  report_database_memory("Module graph", module_graph_bytes, 2);
+  report_database_memory("Ports", module_manager.port_memory_usage(), 4);
+  report_database_memory("Nets", module_manager.net_memory_usage(), 4);
+  report_database_memory("Architecture bitstream", bitstream_manager_bytes, 2);
+  report_database_memory("Fabric bitstream", fabric_bitstream_bytes, 2);
+  report_database_memory("Verilog netlists", verilog_netlists_bytes, 2);
+  report_database_memory("SPICE netlists", spice_netlists_bytes, 2);
+  report_database_memory("Total",
+                         device_annotation_bytes + lb_rr_graph_bytes + device_rr_gsb_bytes
+                         + module_graph_bytes + bitstream_manager_bytes + fabric_bitstream_bytes
+                         + verilog_netlists_bytes + spice_netlists_bytes,
+                         0);
+  report_database_memory("Peak memory of the process", vtr::get_max_rss(), 0);
+
+  return CMD_EXEC_SUCCESS;
+} 
+
+} /* end namespace openfpga */
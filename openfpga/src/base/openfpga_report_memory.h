@@ -0,0 +1,23 @@
+#ifndef OPENFPGA_REPORT_MEMORY_H
+#define OPENFPGA_REPORT_MEMORY_H
+
+/********************************************************************
+ * Include header files that are required by function declaration
+ *******************************************************************/
+#include "command.h"
+#include "command_context.h"
+#include "openfpga_context.h"
+
+/********************************************************************
+ * Function declaration
+ *******************************************************************/
+
+/* begin namespace openfpga */
+namespace openfpga {
+
+int report_memory(OpenfpgaContext& openfpga_ctx,
+                  const Command& cmd, const CommandContext& cmd_context); 
+
+} /* end namespace openfpga */
+
+#endif
@@ -1,12 +1,15 @@
 /********************************************************************
  * This file includes functions to compress the hierachy of routing architecture
  *******************************************************************/
+#include <cstdlib>
+
 /* Headers from vtrutil library */
 #include "vtr_time.h"
 #include "vtr_log.h"
 
 /* Headers from openfpgashell library */
 #include "command_exit_codes.h"
+#include "command_threads.h"
 
 /* Headers from openfpgautil library */
 #include "openfpga_scale.h"
@@ -17,6 +20,7 @@
 #include "analysis_sdc_writer.h"
 #include "configuration_chain_sdc_writer.h"
 #include "configure_port_sdc_writer.h"
+#include "fabric_timing_estimator.h"
 #include "openfpga_sdc.h"
 
 /* Include global variables of VPR */
@@ -30,10 +34,17 @@ namespace openfpga {
  *******************************************************************/
 int write_pnr_sdc(const OpenfpgaContext& openfpga_ctx,
                   const Command& cmd, const CommandContext& cmd_context) {
+  /* Constraints are written on the blocks of the top-level module, which are grouped in tiles */
+  if (true == openfpga_ctx.flow_manager().group_tile()) {
+    VTR_LOG_ERROR("Writing SDC is not supported when the fabric is built with '--group_tile'!\n");
+    return CMD_EXEC_FATAL_ERROR;
+  }
+
 
   CommandOptionId opt_output_dir = cmd.option("file");
   CommandOptionId opt_flatten_names = cmd.option("flatten_names");
   CommandOptionId opt_hierarchical = cmd.option("hierarchical");
+  CommandOptionId opt_unique_modules = cmd.option("unique_modules");
   CommandOptionId opt_time_unit = cmd.option("time_unit");
   CommandOptionId opt_output_hierarchy = cmd.option("output_hierarchy");
   CommandOptionId opt_constrain_global_port = cmd.option("constrain_global_port");
@@ -45,6 +56,7 @@ int write_pnr_sdc(const OpenfpgaContext& openfpga_ctx,
   CommandOptionId opt_constrain_routing_multiplexer_outputs = cmd.option("constrain_routing_multiplexer_outputs");
   CommandOptionId opt_constrain_switch_block_outputs = cmd.option("constrain_switch_block_outputs");
   CommandOptionId opt_constrain_zero_delay_paths = cmd.option("constrain_zero_delay_paths");
+  CommandOptionId opt_threads = cmd.option("threads");
 
   /* This is an intermediate data structure which is designed to modularize the FPGA-SDC
    * Keep it independent from any other outside data structures
@@ -58,6 +70,18 @@ int write_pnr_sdc(const OpenfpgaContext& openfpga_ctx,
 
   options.set_flatten_names(cmd_context.option_enable(cmd, opt_flatten_names));
   options.set_hierarchical(cmd_context.option_enable(cmd, opt_hierarchical));
+  options.set_unique_modules(cmd_context.option_enable(cmd, opt_unique_modules));
+
+  /* The SDC files of modules can be applied to their instances only when they are written without full paths */
+  if ( (true == options.unique_modules())
+    && (false == options.hierarchical()) ) {
+    VTR_LOG_ERROR("Option '--unique_modules' requires '--hierarchical' to be enabled!\n");
+    return CMD_EXEC_FATAL_ERROR;
+  }
+  if ( (true == options.unique_modules())
+    && (false == openfpga_ctx.flow_manager().compress_routing()) ) {
+    VTR_LOG_WARN("Routing blocks are not compressed, each of which is still constrained by its own SDC file. Enable '--compress_routing' in 'build_fabric' to constrain unique routing blocks only\n");
+  }
   
   if (true == cmd_context.option_enable(cmd, opt_time_unit)) {
     options.set_time_unit(string_to_time_unit(cmd_context.option_value(cmd, opt_time_unit)));
@@ -74,6 +98,12 @@ int write_pnr_sdc(const OpenfpgaContext& openfpga_ctx,
   options.set_constrain_routing_multiplexer_outputs(cmd_context.option_enable(cmd, opt_constrain_routing_multiplexer_outputs));
   options.set_constrain_switch_block_outputs(cmd_context.option_enable(cmd, opt_constrain_switch_block_outputs));
   options.set_constrain_zero_delay_paths(cmd_context.option_enable(cmd, opt_constrain_zero_delay_paths));
+  /* Use the default number of threads of the shell unless specified */
+  size_t num_threads = 1;
+  if (false == find_command_num_threads(cmd, cmd_context, opt_threads, num_threads)) {
+    return CMD_EXEC_FATAL_ERROR;
+  }
+  options.set_num_threads(num_threads);
 
   /* We first turn on default sdc option and then disable part of them by following users' options */
   if (false == options.generate_sdc_pnr()) {
@@ -86,6 +116,7 @@ int write_pnr_sdc(const OpenfpgaContext& openfpga_ctx,
                   g_vpr_ctx.device(),
                   openfpga_ctx.vpr_device_annotation(),
                   openfpga_ctx.device_rr_gsb(),
+                  openfpga_ctx.device_rr_gsb_module_ports(),
                   openfpga_ctx.module_graph(),
                   openfpga_ctx.mux_lib(),
                   openfpga_ctx.arch().circuit_lib,
@@ -166,9 +197,16 @@ int write_sdc_disable_timing_configure_ports(const OpenfpgaContext& openfpga_ctx
  *******************************************************************/
 int write_analysis_sdc(const OpenfpgaContext& openfpga_ctx,
                        const Command& cmd, const CommandContext& cmd_context) {
+  /* Constraints are written on the blocks of the top-level module, which are grouped in tiles */
+  if (true == openfpga_ctx.flow_manager().group_tile()) {
+    VTR_LOG_ERROR("Writing SDC is not supported when the fabric is built with '--group_tile'!\n");
+    return CMD_EXEC_FATAL_ERROR;
+  }
+
 
   CommandOptionId opt_output_dir = cmd.option("file");
   CommandOptionId opt_flatten_names = cmd.option("flatten_names");
+  CommandOptionId opt_group_ports = cmd.option("group_ports");
   CommandOptionId opt_time_unit = cmd.option("time_unit");
 
   /* This is an intermediate data structure which is designed to modularize the FPGA-SDC
@@ -182,6 +220,7 @@ int write_analysis_sdc(const OpenfpgaContext& openfpga_ctx,
   AnalysisSdcOption options(sdc_dir_path);
   options.set_generate_sdc_analysis(true);
   options.set_flatten_names(cmd_context.option_enable(cmd, opt_flatten_names));
+  options.set_group_ports(cmd_context.option_enable(cmd, opt_group_ports));
 
   if (true == cmd_context.option_enable(cmd, opt_time_unit)) {
     options.set_time_unit(string_to_time_unit(cmd_context.option_value(cmd, opt_time_unit)));
@@ -199,4 +238,46 @@ int write_analysis_sdc(const OpenfpgaContext& openfpga_ctx,
   return CMD_EXEC_SUCCESS;
 }
 
+/********************************************************************
+ * A wrapper function to estimate the timing of the routed connections
+ * in the fabric, with the delays of the switches as in PnR SDC files
+ *******************************************************************/
+int report_fabric_timing(const OpenfpgaContext& openfpga_ctx,
+                         const Command& cmd, const CommandContext& cmd_context) {
+
+  CommandOptionId opt_file = cmd.option("file");
+  CommandOptionId opt_num_paths = cmd.option("num_paths");
+  CommandOptionId opt_verbose = cmd.option("verbose");
+
+  std::string fname;
+  if (true == cmd_context.option_enable(cmd, opt_file)) {
+    fname = cmd_context.option_value(cmd, opt_file);
+    create_directory(find_path_dir_name(fname));
+  }
+
+  size_t num_paths = 10;
+  if (true == cmd_context.option_enable(cmd, opt_num_paths)) {
+    int num_paths_requested = std::atoi(cmd_context.option_value(cmd, opt_num_paths).c_str());
+    if (0 >= num_paths_requested) {
+      VTR_LOG_ERROR("Invalid number of paths '%d' which should be a positive number!\n",
+                    num_paths_requested);
+      return CMD_EXEC_FATAL_ERROR;
+    }
+    num_paths = size_t(num_paths_requested);
+  }
+
+  int status = estimate_fabric_timing(fname,
+                                      g_vpr_ctx.device(),
+                                      g_vpr_ctx.clustering(),
+                                      openfpga_ctx.vpr_routing_annotation(),
+                                      1./openfpga_ctx.simulation_setting().default_operating_clock_frequency(),
+                                      num_paths,
+                                      cmd_context.option_enable(cmd, opt_verbose));
+
+  if (0 != status) {
+    return CMD_EXEC_FATAL_ERROR;
+  }
+  return CMD_EXEC_SUCCESS;
+}
+
 } /* end namespace openfpga */
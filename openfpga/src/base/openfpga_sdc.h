@@ -27,6 +27,9 @@ int write_sdc_disable_timing_configure_ports(const OpenfpgaContext& openfpga_ctx
 int write_analysis_sdc(const OpenfpgaContext& openfpga_ctx,
                        const Command& cmd, const CommandContext& cmd_context);
 
+int report_fabric_timing(const OpenfpgaContext& openfpga_ctx,
+                         const Command& cmd, const CommandContext& cmd_context);
+
 } /* end namespace openfpga */
 
 #endif
@@ -3,6 +3,7 @@
  * in purpose of generate SDC files
  * - write_pnr_sdc : generate SDC to constrain the back-end flow for FPGA fabric
  * - write_analysis_sdc: TODO: generate SDC based on users' implementations
+ * - report_fabric_timing : estimate the timing of the routed connections in FPGA fabric
  *******************************************************************/
 #include "openfpga_sdc.h"
 #include "openfpga_sdc_command.h"
@@ -32,6 +33,9 @@ ShellCommandId add_openfpga_write_pnr_sdc_command(openfpga::Shell<OpenfpgaContex
   /* Add an option '--hierarchical' */
   shell_cmd.add_option("hierarchical", false, "Output SDC files hierachically (without full path in hierarchy)");
 
+  /* Add an option '--unique_modules' */
+  shell_cmd.add_option("unique_modules", false, "Output a top-level SDC file which applies the SDC file of each unique module to all its instances. Valid only when '--hierarchical' is enabled");
+
   /* Add an option '--output_hierarchy' */
   shell_cmd.add_option("output_hierarchy", false, "Output hierachy of Multiple-Instance-Blocks (MIBs) to plain text file. This is applied to constrain timing for grid, SBs and CBs");
 
@@ -66,6 +70,10 @@ ShellCommandId add_openfpga_write_pnr_sdc_command(openfpga::Shell<OpenfpgaContex
   /* Add an option '--constrain_zero_delay_paths' */
   shell_cmd.add_option("constrain_zero_delay_paths", false, "Constrain zero-delay paths in FPGA fabric");
 
+  /* Add an option '--threads' */
+  CommandOptionId threads_opt = shell_cmd.add_option("threads", false, "Set the number of threads to write the SDC files of routing blocks. Default value is given by the '--threads' option of the shell, which is 1 unless specified. Use 0 to take all the hardware threads");
+  shell_cmd.set_option_require_value(threads_opt, openfpga::OPT_INT);
+
   /* Add an option '--verbose' */
   shell_cmd.add_option("verbose", false, "Enable verbose output");
   
@@ -174,6 +182,9 @@ ShellCommandId add_openfpga_write_analysis_sdc_command(openfpga::Shell<OpenfpgaC
   /* Add an option '--flatten_name' */
   shell_cmd.add_option("flatten_names", false, "Use flatten names (no wildcards) in SDC files");
 
+  /* Add an option '--group_ports' */
+  shell_cmd.add_option("group_ports", false, "Group the contiguous pins of a port to be disabled into buses in SDC files");
+
   /* Add an option '--time_unit' */
   CommandOptionId time_unit_opt = shell_cmd.add_option("time_unit", false, "Specify the time unit in SDC files. Acceptable is [a|f|p|n|u|m|kM]s");
   shell_cmd.set_option_require_value(time_unit_opt, openfpga::OPT_STRING);
@@ -189,6 +200,40 @@ ShellCommandId add_openfpga_write_analysis_sdc_command(openfpga::Shell<OpenfpgaC
   return shell_cmd_id;
 }
 
+/********************************************************************
+ * - Add a command to Shell environment: report_fabric_timing
+ * - Add associated options 
+ * - Add command dependency
+ *******************************************************************/
+static 
+ShellCommandId add_openfpga_report_fabric_timing_command(openfpga::Shell<OpenfpgaContext>& shell,
+                                                         const ShellCommandClassId& cmd_class_id,
+                                                         const std::vector<ShellCommandId>& dependent_cmds) {
+  Command shell_cmd("report_fabric_timing");
+
+  /* Add an option '--file' in short '-f'*/
+  CommandOptionId output_opt = shell_cmd.add_option("file", false, "Specify the file path to output the critical paths");
+  shell_cmd.set_option_short_name(output_opt, "f");
+  shell_cmd.set_option_require_value(output_opt, openfpga::OPT_STRING);
+
+  /* Add an option '--num_paths' */
+  CommandOptionId num_paths_opt = shell_cmd.add_option("num_paths", false, "Specify the number of critical paths to output. Default value is 10");
+  shell_cmd.set_option_require_value(num_paths_opt, openfpga::OPT_INT);
+
+  /* Add an option '--verbose' */
+  shell_cmd.add_option("verbose", false, "Enable verbose output");
+
+  /* Add command 'report_fabric_timing' to the Shell */
+  ShellCommandId shell_cmd_id = shell.add_command(shell_cmd, "estimate the timing of the routed connections in the FPGA fabric with the switch delays of the architecture");
+  shell.set_command_class(shell_cmd_id, cmd_class_id);
+  shell.set_command_const_execute_function(shell_cmd_id, report_fabric_timing);
+
+  /* Add command dependency to the Shell */
+  shell.set_command_dependency(shell_cmd_id, dependent_cmds);
+
+  return shell_cmd_id;
+}
+
 void add_openfpga_sdc_commands(openfpga::Shell<OpenfpgaContext>& shell) {
   /* Get the unique id of 'build_fabric' command which is to be used in creating the dependency graph */
   const ShellCommandId& build_fabric_id = shell.command(std::string("build_fabric"));
@@ -236,6 +281,16 @@ void add_openfpga_sdc_commands(openfpga::Shell<OpenfpgaContext>& shell) {
                                           openfpga_sdc_cmd_class,
                                           analysis_sdc_cmd_dependency);
 
+  /******************************** 
+   * Command 'report_fabric_timing' 
+   */
+  /* The 'report_fabric_timing' command should NOT be executed before 'build_fabric' */
+  std::vector<ShellCommandId> fabric_timing_cmd_dependency;
+  fabric_timing_cmd_dependency.push_back(build_fabric_id);
+  add_openfpga_report_fabric_timing_command(shell,
+                                            openfpga_sdc_cmd_class,
+                                            fabric_timing_cmd_dependency);
+
 } 
 
 } /* end namespace openfpga */
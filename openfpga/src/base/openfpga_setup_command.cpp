@@ -10,6 +10,8 @@
 #include "check_netlist_naming_conflict.h"
 #include "openfpga_build_fabric.h"
 #include "openfpga_write_gsb.h"
+#include "openfpga_report_memory.h"
+#include "openfpga_context_checkpoint.h"
 #include "openfpga_setup_command.h"
 
 /* begin namespace openfpga */
@@ -30,6 +32,10 @@ ShellCommandId add_openfpga_read_arch_command(openfpga::Shell<OpenfpgaContext>&
   shell_cmd.set_option_short_name(opt_arch_file, "f");
   shell_cmd.set_option_require_value(opt_arch_file, openfpga::OPT_STRING);
 
+  /* Add an option '--image' */
+  CommandOptionId opt_image_file = shell_cmd.add_option("image", false, "file path to a binary image of the architecture, which is loaded instead of the XML when it is up-to-date, and is created otherwise");
+  shell_cmd.set_option_require_value(opt_image_file, openfpga::OPT_STRING);
+
   /* Add command 'read_openfpga_arch' to the Shell */
   ShellCommandId shell_cmd_id = shell.add_command(shell_cmd, "read OpenFPGA architecture file");
   shell.set_command_class(shell_cmd_id, cmd_class_id);
@@ -180,6 +186,10 @@ ShellCommandId add_openfpga_link_arch_command(openfpga::Shell<OpenfpgaContext>&
   /* Add an option '--sort_gsb_chan_node_in_edges'*/
   shell_cmd.add_option("sort_gsb_chan_node_in_edges", false, "Sort all the incoming edges for each routing track output node in General Switch Blocks (GSBs)");
 
+  /* Add an option '--threads' */
+  CommandOptionId opt_threads = shell_cmd.add_option("threads", false, "Set the number of threads to annotate routing results, build and sort General Switch Blocks (GSBs), and collect the routing multiplexers. Default value is given by the '--threads' option of the shell, which is 1 unless specified. Use 0 to take all the hardware threads");
+  shell_cmd.set_option_require_value(opt_threads, openfpga::OPT_INT);
+
   /* Add an option '--verbose' */
   shell_cmd.add_option("verbose", false, "Show verbose outputs");
   
@@ -209,6 +219,13 @@ ShellCommandId add_openfpga_write_gsb_command(openfpga::Shell<OpenfpgaContext>&
   shell_cmd.set_option_short_name(opt_file, "f");
   shell_cmd.set_option_require_value(opt_file, openfpga::OPT_STRING);
 
+  /* Add an option '--unique' */
+  shell_cmd.add_option("unique", false, "Only write the unique switch blocks, which requires 'build_fabric --compress_routing'");
+
+  /* Add an option '--threads' */
+  CommandOptionId opt_threads = shell_cmd.add_option("threads", false, "Set the number of threads to write the XML files. Default value is given by the '--threads' option of the shell, which is 1 unless specified. Use 0 to take all the hardware threads");
+  shell_cmd.set_option_require_value(opt_threads, openfpga::OPT_INT);
+
   /* Add an option '--verbose' */
   shell_cmd.add_option("verbose", false, "Show verbose outputs");
 
@@ -223,6 +240,84 @@ ShellCommandId add_openfpga_write_gsb_command(openfpga::Shell<OpenfpgaContext>&
   return shell_cmd_id;
 }
 
+/********************************************************************
+ * - Add a command to Shell environment: report_memory
+ * - Add associated options 
+ *******************************************************************/
+static 
+ShellCommandId add_openfpga_report_memory_command(openfpga::Shell<OpenfpgaContext>& shell,
+                                                  const ShellCommandClassId& cmd_class_id) {
+  Command shell_cmd("report_memory");
+
+  /* Add an option '--compact' */
+  shell_cmd.add_option("compact", false, "Release the unused memory of the module graph and the bitstreams before reporting. No more nets can be added to the module graph afterwards");
+
+  /* Add command 'report_memory' to the Shell */
+  ShellCommandId shell_cmd_id = shell.add_command(shell_cmd, "report the approximate memory usage of each OpenFPGA database");
+  shell.set_command_class(shell_cmd_id, cmd_class_id);
+  shell.set_command_execute_function(shell_cmd_id, report_memory);
+
+  return shell_cmd_id;
+}
+
+/********************************************************************
+ * - Add a command to Shell environment: save_context
+ * - Add associated options 
+ * - Add command dependency
+ *******************************************************************/
+static 
+ShellCommandId add_openfpga_save_context_command(openfpga::Shell<OpenfpgaContext>& shell,
+                                                 const ShellCommandClassId& cmd_class_id,
+                                                 const std::vector<ShellCommandId>& dependent_cmds) {
+  Command shell_cmd("save_context");
+  /* Add an option '--file' in short '-f'*/
+  CommandOptionId opt_file = shell_cmd.add_option("file", true, "file path to the checkpoint");
+  shell_cmd.set_option_short_name(opt_file, "f");
+  shell_cmd.set_option_require_value(opt_file, openfpga::OPT_STRING);
+
+  /* Add an option '--verbose' */
+  shell_cmd.add_option("verbose", false, "Show verbose outputs");
+
+  /* Add command 'save_context' to the Shell */
+  ShellCommandId shell_cmd_id = shell.add_command(shell_cmd, "save the fabric and the architecture bitstream to a checkpoint file");
+  shell.set_command_class(shell_cmd_id, cmd_class_id);
+  shell.set_command_const_execute_function(shell_cmd_id, save_context);
+
+  /* Add command dependency to the Shell */
+  shell.set_command_dependency(shell_cmd_id, dependent_cmds);
+
+  return shell_cmd_id;
+}
+
+/********************************************************************
+ * - Add a command to Shell environment: load_context
+ * - Add associated options 
+ * - Add command dependency
+ *******************************************************************/
+static 
+ShellCommandId add_openfpga_load_context_command(openfpga::Shell<OpenfpgaContext>& shell,
+                                                 const ShellCommandClassId& cmd_class_id,
+                                                 const std::vector<ShellCommandId>& dependent_cmds) {
+  Command shell_cmd("load_context");
+  /* Add an option '--file' in short '-f'*/
+  CommandOptionId opt_file = shell_cmd.add_option("file", true, "file path to the checkpoint");
+  shell_cmd.set_option_short_name(opt_file, "f");
+  shell_cmd.set_option_require_value(opt_file, openfpga::OPT_STRING);
+
+  /* Add an option '--verbose' */
+  shell_cmd.add_option("verbose", false, "Show verbose outputs");
+
+  /* Add command 'load_context' to the Shell */
+  ShellCommandId shell_cmd_id = shell.add_command(shell_cmd, "restore the fabric and the architecture bitstream from a checkpoint file");
+  shell.set_command_class(shell_cmd_id, cmd_class_id);
+  shell.set_command_execute_function(shell_cmd_id, load_context);
+
+  /* Add command dependency to the Shell */
+  shell.set_command_dependency(shell_cmd_id, dependent_cmds);
+
+  return shell_cmd_id;
+}
+
 /********************************************************************
  * - Add a command to Shell environment: check_netlist_naming_conflict
  * - Add associated options 
@@ -242,6 +337,10 @@ ShellCommandId add_openfpga_check_netlist_naming_conflict_command(openfpga::Shel
   CommandOptionId opt_rpt = shell_cmd.add_option("report", false, "Output a report file about what any correction applied");
   shell_cmd.set_option_require_value(opt_rpt, openfpga::OPT_STRING);
 
+  /* Add an option '--threads' */
+  CommandOptionId opt_threads = shell_cmd.add_option("threads", false, "Set the number of threads to check the names of blocks and nets. Default value is given by the '--threads' option of the shell, which is 1 unless specified. Use 0 to take all the hardware threads");
+  shell_cmd.set_option_require_value(opt_threads, openfpga::OPT_INT);
+
   /* Add command 'check_netlist_naming_conflict' to the Shell */
   ShellCommandId shell_cmd_id = shell.add_command(shell_cmd, "Check any block/net naming in users' BLIF netlist violates the syntax of fabric generator");
   shell.set_command_class(shell_cmd_id, cmd_class_id);
@@ -265,6 +364,10 @@ ShellCommandId add_openfpga_pb_pin_fixup_command(openfpga::Shell<OpenfpgaContext
 
   Command shell_cmd("pb_pin_fixup");
 
+  /* Add an option '--threads' */
+  CommandOptionId opt_threads = shell_cmd.add_option("threads", false, "Set the number of threads to fix up clustered blocks. Default value is given by the '--threads' option of the shell, which is 1 unless specified. Use 0 to take all the hardware threads");
+  shell_cmd.set_option_require_value(opt_threads, openfpga::OPT_INT);
+
   /* Add an option '--verbose' */
   shell_cmd.add_option("verbose", false, "Show verbose outputs");
 
@@ -290,6 +393,11 @@ ShellCommandId add_openfpga_lut_truth_table_fixup_command(openfpga::Shell<Openfp
                                                           const std::vector<ShellCommandId>& dependent_cmds) {
 
   Command shell_cmd("lut_truth_table_fixup");
+
+  /* Add an option '--threads' */
+  CommandOptionId opt_threads = shell_cmd.add_option("threads", false, "Set the number of threads to fix up clustered blocks. Default value is given by the '--threads' option of the shell, which is 1 unless specified. Use 0 to take all the hardware threads");
+  shell_cmd.set_option_require_value(opt_threads, openfpga::OPT_INT);
+
   /* Add an option '--verbose' */
   shell_cmd.add_option("verbose", false, "Show verbose outputs");
 
@@ -325,6 +433,12 @@ ShellCommandId add_openfpga_build_fabric_command(openfpga::Shell<OpenfpgaContext
   /* Add an option '--duplicate_grid_pin' */
   shell_cmd.add_option("duplicate_grid_pin", false, "Duplicate the pins on the same side of a grid");
 
+  /* Add an option '--dedup_pb_modules' */
+  shell_cmd.add_option("dedup_pb_modules", false, "Merge the modules of pb_types which are identical in ports, child instances and nets inside each logical tile, so that their netlists are written only once");
+
+  /* Add an option '--group_tile' */
+  shell_cmd.add_option("group_tile", false, "Group each grid and its adjacent routing blocks into a tile module, so that the top module only instanciates tiles. Identical tiles share the same module");
+
   /* Add an option '--load_fabric_key' */
   CommandOptionId opt_load_fkey = shell_cmd.add_option("load_fabric_key", false, "load the fabric key from the given file");
   shell_cmd.set_option_require_value(opt_load_fkey, openfpga::OPT_STRING);
@@ -333,9 +447,34 @@ ShellCommandId add_openfpga_build_fabric_command(openfpga::Shell<OpenfpgaContext
   CommandOptionId opt_write_fkey = shell_cmd.add_option("write_fabric_key", false, "output current fabric key to a file");
   shell_cmd.set_option_require_value(opt_write_fkey, openfpga::OPT_STRING);
 
+  /* Add an option '--fabric_key_format' */
+  CommandOptionId opt_fkey_format = shell_cmd.add_option("fabric_key_format", false, "file format of the fabric keys to load and write [xml|bin]. Default: xml");
+  shell_cmd.set_option_require_value(opt_fkey_format, openfpga::OPT_STRING);
+
   /* Add an option '--generate_random_fabric_key' */
   shell_cmd.add_option("generate_random_fabric_key", false, "Create a random fabric key which will shuffle the memory address for encryption purpose");
 
+  /* Add an option '--compact_nets' */
+  shell_cmd.add_option("compact_nets", false, "Pack the nets of all the modules into compact storage after the fabric is built, which reduces memory footprint");
+
+  /* Add an option '--net_arena' */
+  shell_cmd.add_option("net_arena", false, "Allocate the sources and sinks of module nets from an arena of large memory chunks, which speeds up building large fabrics");
+
+  /* Add an option '--hugepage' */
+  shell_cmd.add_option("hugepage", false, "Advise the kernel to back the arena of module nets by transparent huge pages (Linux only). Only applicable when '--net_arena' is enabled");
+
+  /* Add an option '--load_cache' */
+  CommandOptionId opt_load_cache = shell_cmd.add_option("load_cache", false, "Load the fabric from the given cache file when it matches the architecture; otherwise build the fabric from scratch");
+  shell_cmd.set_option_require_value(opt_load_cache, openfpga::OPT_STRING);
+
+  /* Add an option '--write_cache' */
+  CommandOptionId opt_write_cache = shell_cmd.add_option("write_cache", false, "Save the fabric to the given cache file, which can be loaded by later runs on the same architecture");
+  shell_cmd.set_option_require_value(opt_write_cache, openfpga::OPT_STRING);
+
+  /* Add an option '--threads' */
+  CommandOptionId opt_threads = shell_cmd.add_option("threads", false, "Set the number of threads to build grid and routing modules, identify unique routing modules, connect them in the top module and resolve their ports. Default value is given by the '--threads' option of the shell, which is 1 unless specified. Use 0 to take all the hardware threads");
+  shell_cmd.set_option_require_value(opt_threads, openfpga::OPT_INT);
+
   /* Add an option '--verbose' */
   shell_cmd.add_option("verbose", false, "Show verbose outputs");
 
@@ -371,6 +510,9 @@ ShellCommandId add_openfpga_write_fabric_hierarchy_command(openfpga::Shell<Openf
   CommandOptionId opt_depth = shell_cmd.add_option("depth", false, "Specify the depth of hierarchy to which the writer should stop");
   shell_cmd.set_option_require_value(opt_depth, openfpga::OPT_INT);
 
+  /* Add an option '--compact' */
+  shell_cmd.add_option("compact", false, "Output the hierarchy of each unique module only once, which is referred by the other instances with a YAML alias");
+
   /* Add an option '--verbose' */
   shell_cmd.add_option("verbose", false, "Show verbose outputs");
 
@@ -512,6 +654,35 @@ void add_openfpga_setup_commands(openfpga::Shell<OpenfpgaContext>& shell) {
   add_openfpga_write_fabric_hierarchy_command(shell,
                                               openfpga_setup_cmd_class,
                                               write_fabric_hie_dependent_cmds);
+
+  /******************************** 
+   * Command 'save_context' 
+   */
+  /* The 'save_context' command should NOT be executed before 'link_openfpga_arch' */
+  std::vector<ShellCommandId> save_context_dependent_cmds;
+  save_context_dependent_cmds.push_back(link_arch_cmd_id);
+  add_openfpga_save_context_command(shell,
+                                    openfpga_setup_cmd_class,
+                                    save_context_dependent_cmds);
+
+  /******************************** 
+   * Command 'load_context' 
+   */
+  /* The 'load_context' command should NOT be executed before 'link_openfpga_arch' */
+  std::vector<ShellCommandId> load_context_dependent_cmds;
+  load_context_dependent_cmds.push_back(link_arch_cmd_id);
+  ShellCommandId load_context_cmd_id = add_openfpga_load_context_command(shell,
+                                                                         openfpga_setup_cmd_class,
+                                                                         load_context_dependent_cmds);
+  /* The fabric can be restored by 'load_context' */
+  shell.set_command_substitutes(load_context_cmd_id, std::vector<ShellCommandId>(1, build_fabric_cmd_id));
+
+  /******************************** 
+   * Command 'report_memory' 
+   */
+  /* The 'report_memory' command can be executed at any time */
+  add_openfpga_report_memory_command(shell,
+                                     openfpga_setup_cmd_class);
 } 
 
 } /* end namespace openfpga */
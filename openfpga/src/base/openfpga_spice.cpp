@@ -1,12 +1,15 @@
 /********************************************************************
  * This file includes functions to compress the hierachy of routing architecture
  *******************************************************************/
+#include <cstdlib>
+
 /* Headers from vtrutil library */
 #include "vtr_time.h"
 #include "vtr_log.h"
 
 /* Headers from openfpgashell library */
 #include "command_exit_codes.h"
+#include "command_threads.h"
 
 #include "spice_api.h"
 #include "openfpga_spice.h"
@@ -25,6 +28,7 @@ int write_fabric_spice(OpenfpgaContext& openfpga_ctx,
 
   CommandOptionId opt_output_dir = cmd.option("file");
   CommandOptionId opt_explicit_port_mapping = cmd.option("explicit_port_mapping");
+  CommandOptionId opt_threads = cmd.option("threads");
   CommandOptionId opt_verbose = cmd.option("verbose");
 
   /* This is an intermediate data structure which is designed to modularize the FPGA-SPICE
@@ -33,6 +37,12 @@ int write_fabric_spice(OpenfpgaContext& openfpga_ctx,
   FabricSpiceOption options;
   options.set_output_directory(cmd_context.option_value(cmd, opt_output_dir));
   options.set_explicit_port_mapping(cmd_context.option_enable(cmd, opt_explicit_port_mapping));
+  /* Use the default number of threads of the shell unless specified */
+  size_t num_threads = 1;
+  if (false == find_command_num_threads(cmd, cmd_context, opt_threads, num_threads)) {
+    return CMD_EXEC_FATAL_ERROR;
+  }
+  options.set_num_threads(num_threads);
   options.set_verbose_output(cmd_context.option_enable(cmd, opt_verbose));
   options.set_compress_routing(openfpga_ctx.flow_manager().compress_routing());
   
@@ -49,4 +59,37 @@ int write_fabric_spice(OpenfpgaContext& openfpga_ctx,
   return status;
 } 
 
+/********************************************************************
+ * A wrapper function to call the tile testbench generator of FPGA-SPICE
+ *******************************************************************/
+int write_spice_tile_testbench(OpenfpgaContext& openfpga_ctx,
+                               const Command& cmd, const CommandContext& cmd_context) {
+
+  CommandOptionId opt_output_dir = cmd.option("file");
+  CommandOptionId opt_threads = cmd.option("threads");
+  CommandOptionId opt_verbose = cmd.option("verbose");
+
+  /* Unique routing modules are characterized, which requires a compressed routing */
+  if (false == openfpga_ctx.flow_manager().compress_routing()) {
+    VTR_LOG_ERROR("Tile testbenches require unique routing modules! Please run 'compress_routing' before building the fabric\n");
+    return CMD_EXEC_FATAL_ERROR; 
+  }
+
+  /* Use the default number of threads of the shell unless specified */
+  size_t num_threads = 1;
+  if (false == find_command_num_threads(cmd, cmd_context, opt_threads, num_threads)) {
+    return CMD_EXEC_FATAL_ERROR;
+  }
+
+  return fpga_spice_tile_testbench(openfpga_ctx.module_graph(),
+                                   openfpga_ctx.mutable_spice_netlists(),
+                                   openfpga_ctx.arch(),
+                                   openfpga_ctx.simulation_setting(),
+                                   g_vpr_ctx.device(),
+                                   openfpga_ctx.device_rr_gsb(),
+                                   cmd_context.option_value(cmd, opt_output_dir),
+                                   num_threads,
+                                   cmd_context.option_enable(cmd, opt_verbose));
+} 
+
 } /* end namespace openfpga */
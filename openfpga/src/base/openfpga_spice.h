@@ -18,6 +18,9 @@ namespace openfpga {
 int write_fabric_spice(OpenfpgaContext& openfpga_ctx,
                          const Command& cmd, const CommandContext& cmd_context); 
 
+int write_spice_tile_testbench(OpenfpgaContext& openfpga_ctx,
+                               const Command& cmd, const CommandContext& cmd_context); 
+
 } /* end namespace openfpga */
 
 #endif
@@ -4,6 +4,7 @@
  * This is one of the core engine of openfpga, including:
  * - generate_fabric_spice : generate Verilog netlists about FPGA fabric 
  * - TODO: generate_spice_top_testbench : generate SPICE testbenches for top-level module
+ * - write_spice_tile_testbench : generate SPICE testbenches for each unique tile
  * - TODO: generate_spice_grid_testbench : generate SPICE testbenches for grids
  * - TODO: generate_spice_cb_testbench : generate SPICE testbenches for connection blocks
  * - TODO: generate_spice_sb_testbench : generate SPICE testbenches for switch blocks
@@ -38,6 +39,10 @@ ShellCommandId add_openfpga_write_fabric_spice_command(openfpga::Shell<OpenfpgaC
   /* Add an option '--explicit_port_mapping' */
   shell_cmd.add_option("explicit_port_mapping", false, "Use explicit port mapping in Verilog netlists");
 
+  /* Add an option '--threads' */
+  CommandOptionId threads_opt = shell_cmd.add_option("threads", false, "Set the number of threads to write independent netlists. Default value is given by the '--threads' option of the shell, which is 1 unless specified. Use 0 to take all the hardware threads");
+  shell_cmd.set_option_require_value(threads_opt, openfpga::OPT_INT);
+
   /* Add an option '--verbose' */
   shell_cmd.add_option("verbose", false, "Enable verbose output");
   
@@ -52,6 +57,40 @@ ShellCommandId add_openfpga_write_fabric_spice_command(openfpga::Shell<OpenfpgaC
   return shell_cmd_id;
 }
 
+/********************************************************************
+ * - Add a command to Shell environment: write SPICE testbenches for unique tiles
+ * - Add associated options 
+ * - Add command dependency
+ *******************************************************************/
+static 
+ShellCommandId add_openfpga_write_spice_tile_testbench_command(openfpga::Shell<OpenfpgaContext>& shell,
+                                                               const ShellCommandClassId& cmd_class_id,
+                                                               const std::vector<ShellCommandId>& dependent_cmds) {
+  Command shell_cmd("write_spice_tile_testbench");
+
+  /* Add an option '--file' in short '-f'*/
+  CommandOptionId output_opt = shell_cmd.add_option("file", true, "Specify the output directory for SPICE testbenches");
+  shell_cmd.set_option_short_name(output_opt, "f");
+  shell_cmd.set_option_require_value(output_opt, openfpga::OPT_STRING);
+
+  /* Add an option '--threads' */
+  CommandOptionId threads_opt = shell_cmd.add_option("threads", false, "Set the number of threads to write independent testbenches. Default value is given by the '--threads' option of the shell, which is 1 unless specified. Use 0 to take all the hardware threads");
+  shell_cmd.set_option_require_value(threads_opt, openfpga::OPT_INT);
+
+  /* Add an option '--verbose' */
+  shell_cmd.add_option("verbose", false, "Enable verbose output");
+  
+  /* Add command 'write_spice_tile_testbench' to the Shell */
+  ShellCommandId shell_cmd_id = shell.add_command(shell_cmd, "generate SPICE testbenches to characterize each unique tile of FPGA fabric");
+  shell.set_command_class(shell_cmd_id, cmd_class_id);
+  shell.set_command_execute_function(shell_cmd_id, write_spice_tile_testbench);
+
+  /* Add command dependency to the Shell */
+  shell.set_command_dependency(shell_cmd_id, dependent_cmds);
+
+  return shell_cmd_id;
+}
+
 void add_openfpga_spice_commands(openfpga::Shell<OpenfpgaContext>& shell) {
   /* Get the unique id of 'build_fabric' command which is to be used in creating the dependency graph */
   const ShellCommandId& build_fabric_cmd_id = shell.command(std::string("build_fabric"));
@@ -65,9 +104,21 @@ void add_openfpga_spice_commands(openfpga::Shell<OpenfpgaContext>& shell) {
   /* The 'write_fabric_spice' command should NOT be executed before 'build_fabric' */
   std::vector<ShellCommandId> fabric_spice_dependent_cmds;
   fabric_spice_dependent_cmds.push_back(build_fabric_cmd_id);
-  add_openfpga_write_fabric_spice_command(shell,
-                                          openfpga_spice_cmd_class,
-                                          fabric_spice_dependent_cmds);
+  ShellCommandId write_fabric_spice_cmd_id = add_openfpga_write_fabric_spice_command(shell,
+                                                                                    openfpga_spice_cmd_class,
+                                                                                    fabric_spice_dependent_cmds);
+
+  /******************************** 
+   * Command 'write_spice_tile_testbench' 
+   */
+  /* The 'write_spice_tile_testbench' command should NOT be executed before 'write_fabric_spice',
+   * as the testbenches include the fabric netlists
+   */
+  std::vector<ShellCommandId> tile_testbench_dependent_cmds;
+  tile_testbench_dependent_cmds.push_back(write_fabric_spice_cmd_id);
+  add_openfpga_write_spice_tile_testbench_command(shell,
+                                                  openfpga_spice_cmd_class,
+                                                  tile_testbench_dependent_cmds);
 
   /******************************** 
    * TODO: Command 'write_spice_top_testbench' 
@@ -7,6 +7,10 @@
 
 /* Headers from openfpgashell library */
 #include "command_exit_codes.h"
+#include "command_threads.h"
+
+/* Headers from openfpgautil library */
+#include "openfpga_compressed_stream.h"
 
 #include "verilog_api.h"
 #include "openfpga_verilog.h"
@@ -29,8 +33,18 @@ int write_fabric_verilog(OpenfpgaContext& openfpga_ctx,
   CommandOptionId opt_output_dir = cmd.option("file");
   CommandOptionId opt_explicit_port_mapping = cmd.option("explicit_port_mapping");
   CommandOptionId opt_include_timing = cmd.option("include_timing");
+  CommandOptionId opt_include_signal_init = cmd.option("include_signal_init");
   CommandOptionId opt_print_user_defined_template = cmd.option("print_user_defined_template");
   CommandOptionId opt_default_net_type = cmd.option("default_net_type");
+  CommandOptionId opt_share_routing_bodies = cmd.option("share_routing_bodies");
+  CommandOptionId opt_compact_mux_branches = cmd.option("compact_mux_branches");
+  CommandOptionId opt_merge_netlists = cmd.option("merge_netlists");
+  CommandOptionId opt_remove_module_netlists = cmd.option("remove_module_netlists");
+  CommandOptionId opt_resolve_defines = cmd.option("resolve_defines");
+  CommandOptionId opt_keep_unchanged_netlists = cmd.option("keep_unchanged_netlists");
+  CommandOptionId opt_prune_unused_for_design = cmd.option("prune_unused_for_design");
+  CommandOptionId opt_threads = cmd.option("threads");
+  CommandOptionId opt_compress = cmd.option("compress");
   CommandOptionId opt_verbose = cmd.option("verbose");
 
   /* This is an intermediate data structure which is designed to modularize the FPGA-Verilog
@@ -40,25 +54,63 @@ int write_fabric_verilog(OpenfpgaContext& openfpga_ctx,
   options.set_output_directory(cmd_context.option_value(cmd, opt_output_dir));
   options.set_explicit_port_mapping(cmd_context.option_enable(cmd, opt_explicit_port_mapping));
   options.set_include_timing(cmd_context.option_enable(cmd, opt_include_timing));
+  options.set_include_signal_init(cmd_context.option_enable(cmd, opt_include_signal_init));
   options.set_print_user_defined_template(cmd_context.option_enable(cmd, opt_print_user_defined_template));
   if (true == cmd_context.option_enable(cmd, opt_default_net_type)) {
     options.set_default_net_type(cmd_context.option_value(cmd, opt_default_net_type));
   }
+  options.set_share_routing_bodies(cmd_context.option_enable(cmd, opt_share_routing_bodies));
+  options.set_compact_mux_branches(cmd_context.option_enable(cmd, opt_compact_mux_branches));
+  options.set_merge_netlists(cmd_context.option_enable(cmd, opt_merge_netlists));
+  if (true == cmd_context.option_enable(cmd, opt_remove_module_netlists)) {
+    /* Error out if the module netlists are not merged, which would be removed for nothing */
+    if (false == options.merge_netlists()) {
+      VTR_LOG_ERROR("Option '--remove_module_netlists' requires option '--merge_netlists'!\n");
+      return CMD_EXEC_FATAL_ERROR; 
+    }
+    options.set_remove_module_netlists(true);
+  }
+  if (true == cmd_context.option_enable(cmd, opt_resolve_defines)) {
+    options.set_resolved_defines(cmd_context.option_value(cmd, opt_resolve_defines));
+  }
+  options.set_keep_unchanged_netlists(cmd_context.option_enable(cmd, opt_keep_unchanged_netlists));
+  if (true == cmd_context.option_enable(cmd, opt_prune_unused_for_design)) {
+    /* Error out if the nets of the design have not been annotated to the routing resources */
+    if (false == openfpga_ctx.vpr_routing_annotation().has_gsb_num_used_nodes()) {
+      VTR_LOG_ERROR("Option '--prune_unused_for_design' requires the routing results of a design, which are annotated by 'link_openfpga_arch'!\n");
+      return CMD_EXEC_FATAL_ERROR; 
+    }
+    options.set_prune_unused_for_design(true);
+  }
+  /* Use the default number of threads of the shell unless specified */
+  size_t num_threads = 1;
+  if (false == find_command_num_threads(cmd, cmd_context, opt_threads, num_threads)) {
+    return CMD_EXEC_FATAL_ERROR;
+  }
+  options.set_num_threads(num_threads);
+  if (true == cmd_context.option_enable(cmd, opt_compress)) {
+    e_file_compression compression = find_supported_file_compression(cmd_context.option_value(cmd, opt_compress));
+    if (NUM_FILE_COMPRESSIONS == compression) {
+      return CMD_EXEC_FATAL_ERROR;
+    }
+    options.set_compression(compression);
+  }
   options.set_verbose_output(cmd_context.option_enable(cmd, opt_verbose));
   options.set_compress_routing(openfpga_ctx.flow_manager().compress_routing());
   
-  fpga_fabric_verilog(openfpga_ctx.mutable_module_graph(),
-                      openfpga_ctx.mutable_verilog_netlists(),
-                      openfpga_ctx.arch().circuit_lib,
-                      openfpga_ctx.mux_lib(),
-                      openfpga_ctx.decoder_lib(),
-                      g_vpr_ctx.device(),
-                      openfpga_ctx.vpr_device_annotation(),
-                      openfpga_ctx.device_rr_gsb(),
-                      options);
-
-  /* TODO: should identify the error code from internal function execution */
-  return CMD_EXEC_SUCCESS;
+  return fpga_fabric_verilog(openfpga_ctx.mutable_module_graph(),
+                             openfpga_ctx.mutable_verilog_netlists(),
+                             openfpga_ctx.arch().circuit_lib,
+                             openfpga_ctx.mux_lib(),
+                             openfpga_ctx.decoder_lib(),
+                             g_vpr_ctx.device(),
+                             openfpga_ctx.vpr_device_annotation(),
+                             openfpga_ctx.device_rr_gsb(),
+                             openfpga_ctx.vpr_placement_annotation(),
+                             openfpga_ctx.vpr_routing_annotation(),
+                             openfpga_ctx.fabric_global_port_info(),
+                             openfpga_ctx.arch().config_protocol,
+                             options);
 } 
 
 /********************************************************************
@@ -72,13 +124,20 @@ int write_verilog_testbench(OpenfpgaContext& openfpga_ctx,
   CommandOptionId opt_pcf = cmd.option("pin_constraints_file");
   CommandOptionId opt_reference_benchmark = cmd.option("reference_benchmark_file_path");
   CommandOptionId opt_print_top_testbench = cmd.option("print_top_testbench");
+  CommandOptionId opt_print_runtime_top_testbench = cmd.option("print_runtime_top_testbench");
   CommandOptionId opt_fast_configuration = cmd.option("fast_configuration");
+  CommandOptionId opt_use_bitstream_memory_file = cmd.option("use_bitstream_memory_file");
   CommandOptionId opt_print_formal_verification_top_netlist = cmd.option("print_formal_verification_top_netlist");
+  CommandOptionId opt_print_tile_formal_verification_netlists = cmd.option("print_tile_formal_verification_netlists");
+  CommandOptionId opt_use_preconfig_bitstream_memory_file = cmd.option("use_preconfig_bitstream_memory_file");
   CommandOptionId opt_print_preconfig_top_testbench = cmd.option("print_preconfig_top_testbench");
+  CommandOptionId opt_print_verilator_harness = cmd.option("print_verilator_harness");
   CommandOptionId opt_print_simulation_ini = cmd.option("print_simulation_ini");
   CommandOptionId opt_explicit_port_mapping = cmd.option("explicit_port_mapping");
   CommandOptionId opt_include_signal_init = cmd.option("include_signal_init");
+  CommandOptionId opt_fabric_signal_init = cmd.option("fabric_signal_init");
   CommandOptionId opt_support_icarus_simulator = cmd.option("support_icarus_simulator");
+  CommandOptionId opt_compress = cmd.option("compress");
   CommandOptionId opt_verbose = cmd.option("verbose");
 
   /* This is an intermediate data structure which is designed to modularize the FPGA-Verilog
@@ -89,13 +148,26 @@ int write_verilog_testbench(OpenfpgaContext& openfpga_ctx,
   options.set_fabric_netlist_file_path(cmd_context.option_value(cmd, opt_fabric_netlist));
   options.set_reference_benchmark_file_path(cmd_context.option_value(cmd, opt_reference_benchmark));
   options.set_print_formal_verification_top_netlist(cmd_context.option_enable(cmd, opt_print_formal_verification_top_netlist));
+  options.set_print_tile_formal_verification_netlists(cmd_context.option_enable(cmd, opt_print_tile_formal_verification_netlists));
+  options.set_use_preconfig_bitstream_memory_file(cmd_context.option_enable(cmd, opt_use_preconfig_bitstream_memory_file));
   options.set_print_preconfig_top_testbench(cmd_context.option_enable(cmd, opt_print_preconfig_top_testbench));
+  options.set_print_verilator_harness(cmd_context.option_enable(cmd, opt_print_verilator_harness));
   options.set_fast_configuration(cmd_context.option_enable(cmd, opt_fast_configuration));
+  options.set_use_bitstream_memory_file(cmd_context.option_enable(cmd, opt_use_bitstream_memory_file));
   options.set_print_top_testbench(cmd_context.option_enable(cmd, opt_print_top_testbench));
+  options.set_print_runtime_top_testbench(cmd_context.option_enable(cmd, opt_print_runtime_top_testbench));
   options.set_print_simulation_ini(cmd_context.option_value(cmd, opt_print_simulation_ini));
   options.set_explicit_port_mapping(cmd_context.option_enable(cmd, opt_explicit_port_mapping));
   options.set_include_signal_init(cmd_context.option_enable(cmd, opt_include_signal_init));
+  options.set_fabric_signal_init(cmd_context.option_enable(cmd, opt_fabric_signal_init));
   options.set_support_icarus_simulator(cmd_context.option_enable(cmd, opt_support_icarus_simulator));
+  if (true == cmd_context.option_enable(cmd, opt_compress)) {
+    e_file_compression compression = find_supported_file_compression(cmd_context.option_value(cmd, opt_compress));
+    if (NUM_FILE_COMPRESSIONS == compression) {
+      return CMD_EXEC_FATAL_ERROR;
+    }
+    options.set_compression(compression);
+  }
   options.set_verbose_output(cmd_context.option_enable(cmd, opt_verbose));
 
   /* If pin constraints are enabled by command options, read the file */
@@ -107,8 +179,13 @@ int write_verilog_testbench(OpenfpgaContext& openfpga_ctx,
   return fpga_verilog_testbench(openfpga_ctx.module_graph(),
                                 openfpga_ctx.bitstream_manager(),
                                 openfpga_ctx.fabric_bitstream(),
+                                openfpga_ctx.fabric_bitstream_by_address(),
                                 g_vpr_ctx.atom(),
                                 g_vpr_ctx.placement(),
+                                g_vpr_ctx.device(),
+                                openfpga_ctx.vpr_device_annotation(),
+                                openfpga_ctx.vpr_placement_annotation(),
+                                openfpga_ctx.vpr_routing_annotation(),
                                 pin_constraints,
                                 openfpga_ctx.io_location_map(),
                                 openfpga_ctx.fabric_global_port_info(),
@@ -33,6 +33,9 @@ ShellCommandId add_openfpga_write_fabric_verilog_command(openfpga::Shell<Openfpg
   /* Add an option '--include_timing' */
   shell_cmd.add_option("include_timing", false, "Enable timing annotation in Verilog netlists");
 
+  /* Add an option '--include_signal_init' */
+  shell_cmd.add_option("include_signal_init", false, "Initialize the drivers inside the primitive modules of Verilog netlists");
+
   /* Add an option '--print_user_defined_template' */
   shell_cmd.add_option("print_user_defined_template", false, "Generate a template Verilog files for user-defined circuit models");
 
@@ -40,6 +43,36 @@ ShellCommandId add_openfpga_write_fabric_verilog_command(openfpga::Shell<Openfpg
   CommandOptionId default_net_type_opt = shell_cmd.add_option("default_net_type", false, "Set the default net type for Verilog netlists. Default value is 'none'");
   shell_cmd.set_option_require_value(default_net_type_opt, openfpga::OPT_STRING);
 
+  /* Add an option '--share_routing_bodies' */
+  shell_cmd.add_option("share_routing_bodies", false, "Write the contents of identical routing modules only once, when routing modules are not compressed");
+
+  /* Add an option '--compact_mux_branches' */
+  shell_cmd.add_option("compact_mux_branches", false, "Write the behavioral branches of multiplexers with a loop over the inputs instead of a case for each input");
+
+  /* Add an option '--merge_netlists' */
+  shell_cmd.add_option("merge_netlists", false, "Merge the netlists of primitive modules, logic blocks and routing modules into one netlist per category");
+
+  /* Add an option '--remove_module_netlists' */
+  shell_cmd.add_option("remove_module_netlists", false, "Remove the netlists of each module after merging them. Only applicable when '--merge_netlists' is enabled");
+
+  /* Add an option '--resolve_defines' */
+  CommandOptionId resolve_defines_opt = shell_cmd.add_option("resolve_defines", false, "Resolve the preprocessing conditions of the netlists, where only the given flags, separated by commas, are defined");
+  shell_cmd.set_option_require_value(resolve_defines_opt, openfpga::OPT_STRING);
+
+  /* Add an option '--keep_unchanged_netlists' */
+  shell_cmd.add_option("keep_unchanged_netlists", false, "Keep the existing netlists whose contents are unchanged, so that their modification time is kept for incremental flows");
+
+  /* Add an option '--prune_unused_for_design' */
+  shell_cmd.add_option("prune_unused_for_design", false, "Replace the grids and routing blocks unused by the implemented design with stubs driving constant outputs, which speeds up the simulation of full fabrics. The netlists are then specific to the design");
+
+  /* Add an option '--threads' */
+  CommandOptionId threads_opt = shell_cmd.add_option("threads", false, "Set the number of threads to write independent netlists. Default value is given by the '--threads' option of the shell, which is 1 unless specified. Use 0 to take all the hardware threads");
+  shell_cmd.set_option_require_value(threads_opt, openfpga::OPT_INT);
+
+  /* Add an option '--compress' */
+  CommandOptionId compress_opt = shell_cmd.add_option("compress", false, "Compress the netlists as they are written. Can be [none|gzip]. Default value is 'none'");
+  shell_cmd.set_option_require_value(compress_opt, openfpga::OPT_STRING);
+
   /* Add an option '--verbose' */
   shell_cmd.add_option("verbose", false, "Enable verbose output");
   
@@ -86,15 +119,30 @@ ShellCommandId add_openfpga_write_verilog_testbench_command(openfpga::Shell<Open
   /* Add an option '--print_top_testbench' */
   shell_cmd.add_option("print_top_testbench", false, "Generate a full testbench for top-level fabric module with autocheck capability");
 
+  /* Add an option '--print_runtime_top_testbench' */
+  shell_cmd.add_option("print_runtime_top_testbench", false, "Generate a testbench for top-level fabric module which loads the bitstream and I/O vectors at run time from files given by plusargs, so that it can be compiled once for all the designs");
+
   /* Add an option '--fast_configuration' */
   shell_cmd.add_option("fast_configuration", false, "Reduce the period of configuration by skip zero data points");
 
+  /* Add an option '--use_bitstream_memory_file' */
+  shell_cmd.add_option("use_bitstream_memory_file", false, "Load the bitstream of the full testbench from a memory file with $readmemb, instead of writing it inline");
+
   /* Add an option '--print_formal_verification_top_netlist' */
   shell_cmd.add_option("print_formal_verification_top_netlist", false, "Generate a top-level module which can be used in formal verification");
 
+  /* Add an option '--print_tile_formal_verification_netlists' */
+  shell_cmd.add_option("print_tile_formal_verification_netlists", false, "Generate a pre-configured module and a reference sub-netlist for each grid used by the design, which can be checked by formal verification in independent jobs");
+
+  /* Add an option '--use_preconfig_bitstream_memory_file' */
+  shell_cmd.add_option("use_preconfig_bitstream_memory_file", false, "Load the bitstream of the formal verification top netlist from a memory file with $readmemb, instead of writing it inline");
+
   /* Add an option '--print_preconfig_top_testbench' */
   shell_cmd.add_option("print_preconfig_top_testbench", false, "Generate a pre-configured testbench for top-level fabric module with autocheck capability");
 
+  /* Add an option '--print_verilator_harness' */
+  shell_cmd.add_option("print_verilator_harness", false, "Generate a top-level module and a C++ harness to verify the pre-configured fabric with the Verilator simulator");
+
   /* Add an option '--print_simulation_ini' */
   CommandOptionId sim_ini_opt = shell_cmd.add_option("print_simulation_ini", false, "Generate a .ini file as an exchangeable file to enable HDL simulations");
   shell_cmd.set_option_require_value(sim_ini_opt, openfpga::OPT_STRING);
@@ -105,9 +153,16 @@ ShellCommandId add_openfpga_write_verilog_testbench_command(openfpga::Shell<Open
   /* Add an option '--include_signal_init' */
   shell_cmd.add_option("include_signal_init", false, "Initialize all the signals in Verilog testbenches");
 
+  /* Add an option '--fabric_signal_init' */
+  shell_cmd.add_option("fabric_signal_init", false, "Rely on the signal initialization inside the fabric netlists, written by 'write_fabric_verilog --include_signal_init', instead of depositing each primitive instance in Verilog testbenches");
+
   /* Add an option '--support_icarus_simulator' */
   shell_cmd.add_option("support_icarus_simulator", false, "Fine-tune Verilog testbenches to support icarus simulator");
 
+  /* Add an option '--compress' */
+  CommandOptionId compress_opt = shell_cmd.add_option("compress", false, "Compress the netlists as they are written. Can be [none|gzip]. Default value is 'none'");
+  shell_cmd.set_option_require_value(compress_opt, openfpga::OPT_STRING);
+
   /* Add an option '--verbose' */
   shell_cmd.add_option("verbose", false, "Enable verbose output");
   
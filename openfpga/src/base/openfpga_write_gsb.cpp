@@ -1,12 +1,15 @@
 /********************************************************************
  * This file includes functions to compress the hierachy of routing architecture
  *******************************************************************/
+#include <cstdlib>
+
 /* Headers from vtrutil library */
 #include "vtr_time.h"
 #include "vtr_log.h"
 
 /* Headers from openfpgashell library */
 #include "command_exit_codes.h"
+#include "command_threads.h"
 
 #include "write_xml_device_rr_gsb.h"
 
@@ -33,13 +36,37 @@ int write_gsb(const OpenfpgaContext& openfpga_ctx,
   VTR_ASSERT(true == cmd_context.option_enable(cmd, opt_file));
   VTR_ASSERT(false == cmd_context.option_value(cmd, opt_file).empty());
 
+  CommandOptionId opt_unique = cmd.option("unique");
+  CommandOptionId opt_threads = cmd.option("threads");
   CommandOptionId opt_verbose = cmd.option("verbose");
 
+  /* The incoming edges of GSBs are required */
+  if (true == openfpga_ctx.flow_manager().scratch_released()) {
+    VTR_LOG_ERROR("Intermediate data of builders have been released by '--release_scratch'! Please run 'link_openfpga_arch' again before writing GSBs\n");
+    return CMD_EXEC_FATAL_ERROR;
+  }
+
+  /* The unique mirrors are identified only when routing hierarchy is compressed */
+  bool unique = cmd_context.option_enable(cmd, opt_unique);
+  if ( (true == unique)
+    && (false == openfpga_ctx.flow_manager().compress_routing()) ) {
+    VTR_LOG_ERROR("Unique switch blocks are not identified! Please run 'build_fabric --compress_routing' before writing unique GSBs\n");
+    return CMD_EXEC_FATAL_ERROR;
+  }
+
+  /* Use the default number of threads of the shell unless specified */
+  size_t num_threads = 1;
+  if (false == find_command_num_threads(cmd, cmd_context, opt_threads, num_threads)) {
+    return CMD_EXEC_FATAL_ERROR;
+  }
+
   std::string sb_file_name = cmd_context.option_value(cmd, opt_file);
 
   write_device_rr_gsb_to_xml(sb_file_name.c_str(),
                              g_vpr_ctx.device().rr_graph,
                              openfpga_ctx.device_rr_gsb(),
+                             unique,
+                             num_threads,
                              cmd_context.option_enable(cmd, opt_verbose));
 
   /* TODO: should identify the error code from internal function execution */
@@ -187,6 +187,95 @@ ModuleId build_wl_memory_decoder_module(ModuleManager& module_manager,
   return module_id;
 }
 
+/***************************************************************************************
+ * Create a module for a shift register driving Bit-Lines with a given output size
+ *
+ *                 +-------------------+
+ *      data_in -->|  Shift register   |
+ *    bl_sr_clk -->|                   |
+ *                 +-------------------+
+ *                   | |   ...     | |
+ *                   v v           v v
+ *                      Data Outputs
+ *               
+ *  At each rising edge of the clock, data_in is shifted into data_out[0],
+ *  and data_out[i] is shifted into data_out[i+1]
+ *  Unlike the BL decoder, all the data outputs are driven at any time, so that
+ *  all the memory cells of a Word-Line are written at the same time
+ ***************************************************************************************/
+ModuleId build_bl_shift_register_module(ModuleManager& module_manager,
+                                        const size_t& data_size) {
+  /* Create a name for the shift register */
+  std::string module_name = generate_bl_shift_register_subckt_name(data_size);
+
+  /* Create a Verilog Module based on the circuit model, and add to module manager */
+  ModuleId module_id = module_manager.add_module(module_name); 
+  VTR_ASSERT(true == module_manager.valid_module_id(module_id));
+
+  /* Add clock port */
+  BasicPort clk_port(std::string(BL_SHIFT_REGISTER_CLOCK_PORT_NAME), 1);
+  module_manager.add_port(module_id, clk_port, ModuleManager::MODULE_INPUT_PORT);
+  /* Add data_in port */
+  BasicPort din_port(std::string(DECODER_DATA_IN_PORT_NAME), 1);
+  module_manager.add_port(module_id, din_port, ModuleManager::MODULE_INPUT_PORT);
+  /* Add each output port */
+  BasicPort data_port(std::string(DECODER_DATA_OUT_PORT_NAME), data_size);
+  module_manager.add_port(module_id, data_port, ModuleManager::MODULE_OUTPUT_PORT);
+
+  /* Data port is registered. It should be outputted as 
+   *   output reg [lsb:msb] data 
+   */
+  module_manager.set_port_is_register(module_id, data_port.get_name(), true);
+
+  return module_id;
+}
+
+/***************************************************************************************
+ * Create a module for a run-length decompressor feeding the head of a configuration chain
+ *
+ *                        +----------------+
+ *         data_in ------>|                |
+ * ccff_run_length ------>|  Run-length    |---> data_out --> head of configuration chain
+ *  ccff_rle_reset ------>|  decompressor  |
+ *    ccff_rle_clk ------>|                |
+ *                        +----------------+
+ *
+ *  A run of N + 1 identical bits is given as the bit value on data_in and
+ *  N on ccff_run_length, which are sampled at the first clock cycle of the run.
+ *  The bit value is repeated on data_out in the next N clock cycles,
+ *  during which data_in and ccff_run_length are not used.
+ *  The decompressor is clocked by the clock of the configuration chain,
+ *  so that a bit is still shifted into the chain at each clock cycle.
+ *  The reset is asynchronous and makes the decompressor wait for a new run
+ ***************************************************************************************/
+ModuleId build_config_chain_decompressor_module(ModuleManager& module_manager,
+                                                const size_t& run_length_width) {
+  /* Create a name for the decompressor */
+  std::string module_name = generate_config_chain_decompressor_subckt_name(run_length_width);
+
+  /* Create a Verilog Module based on the circuit model, and add to module manager */
+  ModuleId module_id = module_manager.add_module(module_name); 
+  VTR_ASSERT(true == module_manager.valid_module_id(module_id));
+
+  /* Add clock port */
+  BasicPort clk_port(std::string(CONFIG_CHAIN_DECOMPRESSOR_CLOCK_PORT_NAME), 1);
+  module_manager.add_port(module_id, clk_port, ModuleManager::MODULE_INPUT_PORT);
+  /* Add reset port */
+  BasicPort reset_port(std::string(CONFIG_CHAIN_DECOMPRESSOR_RESET_PORT_NAME), 1);
+  module_manager.add_port(module_id, reset_port, ModuleManager::MODULE_INPUT_PORT);
+  /* Add data_in port */
+  BasicPort din_port(std::string(DECODER_DATA_IN_PORT_NAME), 1);
+  module_manager.add_port(module_id, din_port, ModuleManager::MODULE_INPUT_PORT);
+  /* Add run length port */
+  BasicPort run_length_port(std::string(CONFIG_CHAIN_RUN_LENGTH_PORT_NAME), run_length_width);
+  module_manager.add_port(module_id, run_length_port, ModuleManager::MODULE_INPUT_PORT);
+  /* Add data output port */
+  BasicPort data_port(std::string(DECODER_DATA_OUT_PORT_NAME), 1);
+  module_manager.add_port(module_id, data_port, ModuleManager::MODULE_OUTPUT_PORT);
+
+  return module_id;
+}
+
 /***************************************************************************************
  * Create a module for a decoder with a given output size
  *
@@ -277,6 +366,11 @@ void build_mux_local_decoder_modules(ModuleManager& module_manager,
 
   /* Create a library for local encoders with different sizes */
   DecoderLibrary decoder_lib;
+
+  /* The decoder of a branch only depends on its number of memory bits, 
+   * so the branches visited are shared by all the circuit models
+   */
+  std::set<std::pair<size_t, size_t>> visited_branches;
   
   /* Find unique local decoders for unique branches shared by the multiplexers */
   for (auto mux : mux_lib.muxes()) {
@@ -288,10 +382,10 @@ void build_mux_local_decoder_modules(ModuleManager& module_manager,
     }
 
     const MuxGraph& mux_graph = mux_lib.mux_graph(mux);
-    /* Create a mux graph for the branch circuit */
-    std::vector<MuxGraph> branch_mux_graphs = mux_graph.build_mux_branch_graphs();
+    /* Create a mux graph for the branch circuits which are not visited yet */
+    std::vector<MuxGraph> branch_mux_graphs = mux_graph.build_mux_branch_graphs(visited_branches);
     /* Add the decoder to the decoder library */
-    for (auto branch_mux_graph : branch_mux_graphs) {
+    for (const MuxGraph& branch_mux_graph : branch_mux_graphs) {
       /* The decoder size depends on the number of memories of a branch MUX.
        * Note that only when there are >=2 memories, a decoder is needed
        */
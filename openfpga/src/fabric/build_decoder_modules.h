@@ -28,6 +28,12 @@ ModuleId build_wl_memory_decoder_module(ModuleManager& module_manager,
                                         const DecoderLibrary& decoder_lib,
                                         const DecoderId& decoder);
 
+ModuleId build_bl_shift_register_module(ModuleManager& module_manager,
+                                        const size_t& data_size);
+
+ModuleId build_config_chain_decompressor_module(ModuleManager& module_manager,
+                                                const size_t& run_length_width);
+
 void build_mux_local_decoder_modules(ModuleManager& module_manager,
                                      const MuxLibrary& mux_lib,
                                      const CircuitLibrary& circuit_lib);
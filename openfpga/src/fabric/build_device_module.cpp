@@ -36,8 +36,11 @@ int build_device_module_graph(ModuleManager& module_manager,
                               const bool& frame_view,
                               const bool& compress_routing,
                               const bool& duplicate_grid_pin,
+                              const bool& dedup_pb_modules,
+                              const bool& group_tile,
                               const FabricKey& fabric_key,
                               const bool& generate_random_fabric_key,
+                              const size_t& num_threads,
                               const bool& verbose) {
   vtr::ScopedStartFinishTimer timer("Build fabric module graph");
 
@@ -76,7 +79,8 @@ int build_device_module_graph(ModuleManager& module_manager,
                        decoder_lib,
                        openfpga_ctx.mux_lib(), 
                        openfpga_ctx.arch().circuit_lib,
-                       openfpga_ctx.arch().config_protocol.type());
+                       openfpga_ctx.arch().config_protocol.type(),
+                       openfpga_ctx.arch().config_protocol.frame_data_width());
 
   /* Build grid and programmable block modules */
   build_grid_modules(module_manager,
@@ -86,7 +90,9 @@ int build_device_module_graph(ModuleManager& module_manager,
                      openfpga_ctx.arch().circuit_lib,
                      openfpga_ctx.mux_lib(),
                      openfpga_ctx.arch().config_protocol.type(),
-                     sram_model, duplicate_grid_pin, verbose);
+                     sram_model, duplicate_grid_pin,
+                     dedup_pb_modules,
+                     num_threads, verbose);
 
   if (true == compress_routing) {
     build_unique_routing_modules(module_manager,
@@ -96,7 +102,7 @@ int build_device_module_graph(ModuleManager& module_manager,
                                  openfpga_ctx.device_rr_gsb(),
                                  openfpga_ctx.arch().circuit_lib,
                                  openfpga_ctx.arch().config_protocol.type(),
-                                 sram_model, verbose);
+                                 sram_model, num_threads, verbose);
   } else {
     VTR_ASSERT_SAFE(false == compress_routing);
     build_flatten_routing_modules(module_manager,
@@ -106,7 +112,7 @@ int build_device_module_graph(ModuleManager& module_manager,
                                   openfpga_ctx.device_rr_gsb(),
                                   openfpga_ctx.arch().circuit_lib,
                                   openfpga_ctx.arch().config_protocol.type(),
-                                  sram_model, verbose);
+                                  sram_model, num_threads, verbose);
   }
 
   /* Build FPGA fabric top-level module */
@@ -122,8 +128,9 @@ int build_device_module_graph(ModuleManager& module_manager,
                             openfpga_ctx.arch().arch_direct, 
                             openfpga_ctx.arch().config_protocol,
                             sram_model,
-                            frame_view, compress_routing, duplicate_grid_pin,
-                            fabric_key, generate_random_fabric_key);
+                            frame_view, compress_routing, duplicate_grid_pin, group_tile,
+                            fabric_key, generate_random_fabric_key,
+                            num_threads);
 
   if (CMD_EXEC_FATAL_ERROR == status) {
     return status;
@@ -138,6 +145,14 @@ int build_device_module_graph(ModuleManager& module_manager,
    */
   rename_primitive_module_port_names(module_manager, openfpga_ctx.arch().circuit_lib);
 
+  /* Report the memory footprint of the fast look-up for nets */
+  VTR_LOGV(verbose,
+           "Memory footprint of net look-up in %s layout: %.2f MB (estimated with all the pins allocated, nested layout: %.2f MB; flat layout: %.2f MB)\n",
+           module_manager.flat_net_lookup() ? "flat" : "nested",
+           module_manager.net_lookup_memory() / 1048576.,
+           module_manager.nested_net_lookup_memory() / 1048576.,
+           module_manager.flat_net_lookup_memory() / 1048576.);
+
   return status;
 }
 
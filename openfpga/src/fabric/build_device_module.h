@@ -22,8 +22,11 @@ int build_device_module_graph(ModuleManager& module_manager,
                               const bool& frame_view,
                               const bool& compress_routing,
                               const bool& duplicate_grid_pin,
+                              const bool& dedup_pb_modules,
+                              const bool& group_tile,
                               const FabricKey& fabric_key,
                               const bool& generate_random_fabric_key,
+                              const size_t& num_threads,
                               const bool& verbose);
 
 } /* end namespace openfpga */
@@ -0,0 +1,185 @@
+/********************************************************************
+ * This file includes functions that are used to resolve the module ports
+ * of switch blocks and connection blocks from the rr_nodes of GSBs
+ * The ports are resolved once after the module graph is built,
+ * and then shared by the netlist and SDC writers
+ *******************************************************************/
+/* Headers from vtrutil library */
+#include "vtr_assert.h"
+#include "vtr_time.h"
+#include "vtr_log.h"
+
+/* Headers from openfpgautil library */
+#include "openfpga_side_manager.h"
+#include "openfpga_parallel.h"
+
+#include "openfpga_naming.h"
+#include "openfpga_rr_graph_utils.h"
+
+#include "build_routing_module_utils.h"
+#include "build_device_rr_gsb_module_ports.h"
+
+/* begin namespace openfpga */
+namespace openfpga {
+
+/********************************************************************
+ * Resolve the ports of the switch block module built from a GSB
+ *******************************************************************/
+static 
+void build_sb_module_ports(DeviceRRGSBModulePorts& gsb_module_ports,
+                           const ModuleManager& module_manager,
+                           const ModuleId& sb_module,
+                           const DeviceGrid& grids,
+                           const VprDeviceAnnotation& device_annotation,
+                           const RRGraph& rr_graph,
+                           const RRGSB& rr_gsb) {
+  gsb_module_ports.add_sb_module_ports(rr_gsb);
+
+  for (size_t side = 0; side < rr_gsb.get_num_sides(); ++side) {
+    SideManager side_manager(side);
+
+    /* Routing tracks and the drivers of routing multiplexers */
+    for (size_t itrack = 0; itrack < rr_gsb.get_chan_width(side_manager.get_side()); ++itrack) {
+      const RRNodeId& chan_rr_node = rr_gsb.get_chan_node(side_manager.get_side(), itrack);
+      PORTS chan_direction = rr_gsb.get_chan_node_direction(side_manager.get_side(), itrack);
+      gsb_module_ports.set_sb_chan_port(rr_gsb, side_manager.get_side(), itrack,
+                                        find_switch_block_module_chan_port(module_manager, sb_module,
+                                                                           rr_graph, rr_gsb,
+                                                                           side_manager.get_side(),
+                                                                           chan_rr_node,
+                                                                           chan_direction));
+
+      /* Only the outputs which are driven by multiplexers have drivers to resolve */
+      if ( (OUT_PORT != chan_direction)
+        || (true == rr_gsb.is_sb_node_passing_wire(rr_graph, side_manager.get_side(), itrack)) ) {
+        continue;
+      }
+      gsb_module_ports.set_sb_chan_driver_ports(rr_gsb, side_manager.get_side(), itrack,
+                                                find_switch_block_module_input_ports(module_manager, sb_module,
+                                                                                     grids, device_annotation,
+                                                                                     rr_graph, rr_gsb,
+                                                                                     rr_gsb.get_chan_node_driver_nodes(rr_graph, side_manager.get_side(), itrack)));
+    }
+
+    /* Grid output pins */
+    for (size_t inode = 0; inode < rr_gsb.get_num_opin_nodes(side_manager.get_side()); ++inode) {
+      const RRNodeId& opin_node = rr_gsb.get_opin_node(side_manager.get_side(), inode);
+      std::string port_name = generate_sb_module_grid_port_name(side_manager.get_side(), 
+                                                                rr_graph.node_side(opin_node),
+                                                                grids,
+                                                                device_annotation,
+                                                                rr_graph,
+                                                                opin_node); 
+      gsb_module_ports.set_sb_opin_port(rr_gsb, side_manager.get_side(), inode,
+                                        module_manager.find_module_port(sb_module, port_name));
+    }
+  }
+}
+
+/********************************************************************
+ * Resolve the ports of the connection block module built from a GSB
+ *******************************************************************/
+static 
+void build_cb_module_ports(DeviceRRGSBModulePorts& gsb_module_ports,
+                           const ModuleManager& module_manager,
+                           const ModuleId& cb_module,
+                           const DeviceGrid& grids,
+                           const VprDeviceAnnotation& device_annotation,
+                           const RRGraph& rr_graph,
+                           const RRGSB& rr_gsb,
+                           const t_rr_type& cb_type) {
+  gsb_module_ports.add_cb_module_ports(cb_type, rr_gsb);
+
+  /* Routing tracks, whose ports are shared by the tracks of the same parity */
+  ModulePortId chan_ports[2][2];
+  for (const PORTS& port_direction : {IN_PORT, OUT_PORT}) {
+    for (const bool& odd_track : {false, true}) {
+      std::string port_name = generate_cb_module_track_port_name(cb_type, port_direction, false == odd_track);
+      ModulePortId port_id = module_manager.find_module_port(cb_module, port_name);
+      VTR_ASSERT(true == module_manager.valid_module_port_id(cb_module, port_id));
+      chan_ports[IN_PORT == port_direction ? 0 : 1][odd_track ? 1 : 0] = port_id;
+    }
+  }
+  for (size_t itrack = 0; itrack < rr_gsb.get_cb_chan_width(cb_type); ++itrack) {
+    gsb_module_ports.set_cb_chan_port(cb_type, rr_gsb, itrack, IN_PORT,
+                                      ModulePinInfo(chan_ports[0][itrack % 2], itrack / 2));
+    gsb_module_ports.set_cb_chan_port(cb_type, rr_gsb, itrack, OUT_PORT,
+                                      ModulePinInfo(chan_ports[1][itrack % 2], itrack / 2));
+  }
+
+  /* Grid input pins and the drivers of routing multiplexers */
+  for (const e_side& cb_ipin_side : rr_gsb.get_cb_ipin_sides(cb_type)) {
+    for (size_t inode = 0; inode < rr_gsb.get_num_ipin_nodes(cb_ipin_side); ++inode) {
+      const RRNodeId& ipin_node = rr_gsb.get_ipin_node(cb_ipin_side, inode);
+      std::string port_name = generate_cb_module_grid_port_name(cb_ipin_side,
+                                                                grids,
+                                                                device_annotation,
+                                                                rr_graph,
+                                                                ipin_node); 
+      gsb_module_ports.set_cb_ipin_port(cb_type, rr_gsb, cb_ipin_side, inode,
+                                        module_manager.find_module_port(cb_module, port_name));
+
+      /* Direct connections from OPINs are built in the top module rather than by multiplexers */
+      std::vector<RRNodeId> driver_rr_nodes = rr_gsb.get_ipin_node_driver_nodes(rr_graph, cb_ipin_side, inode);
+      if ( (true == driver_rr_nodes.empty())
+        || (true == is_ipin_direct_connected_opin(rr_graph, ipin_node)) ) {
+        continue;
+      }
+      gsb_module_ports.set_cb_ipin_driver_ports(cb_type, rr_gsb, cb_ipin_side, inode,
+                                                find_connection_block_module_input_ports(module_manager, cb_module,
+                                                                                         rr_graph, rr_gsb,
+                                                                                         cb_type,
+                                                                                         driver_rr_nodes));
+    }
+  }
+}
+
+/********************************************************************
+ * Resolve the ports of all the routing modules in the module graph
+ * A routing module is named after the GSB which it is built from, 
+ * so the GSBs without their own modules, i.e., the mirrors under
+ * a compact routing hierarchy, are skipped
+ *******************************************************************/
+DeviceRRGSBModulePorts build_device_rr_gsb_module_ports(const ModuleManager& module_manager,
+                                                        const DeviceRRGSB& device_rr_gsb,
+                                                        const DeviceGrid& grids,
+                                                        const VprDeviceAnnotation& device_annotation,
+                                                        const RRGraph& rr_graph,
+                                                        const size_t& num_threads) {
+  vtr::ScopedStartFinishTimer timer("Resolve module ports of routing blocks");
+
+  DeviceRRGSBModulePorts gsb_module_ports;
+
+  vtr::Point<size_t> gsb_range = device_rr_gsb.get_gsb_range();
+  gsb_module_ports.reserve(gsb_range);
+
+  /* Each GSB has its own storage, so they can be resolved in parallel */
+  parallel_for(gsb_range.x() * gsb_range.y(), num_threads, [&](const size_t& igsb) {
+    const RRGSB& rr_gsb = device_rr_gsb.get_gsb(igsb / gsb_range.y(), igsb % gsb_range.y());
+
+    if (true == rr_gsb.is_sb_exist()) {
+      vtr::Point<size_t> sb_coordinate(rr_gsb.get_sb_x(), rr_gsb.get_sb_y());
+      ModuleId sb_module = module_manager.find_module(generate_switch_block_module_name(sb_coordinate));
+      if (true == module_manager.valid_module_id(sb_module)) {
+        build_sb_module_ports(gsb_module_ports, module_manager, sb_module,
+                              grids, device_annotation, rr_graph, rr_gsb);
+      }
+    }
+
+    for (const t_rr_type& cb_type : {CHANX, CHANY}) {
+      if (false == rr_gsb.is_cb_exist(cb_type)) {
+        continue;
+      }
+      vtr::Point<size_t> cb_coordinate(rr_gsb.get_cb_x(cb_type), rr_gsb.get_cb_y(cb_type));
+      ModuleId cb_module = module_manager.find_module(generate_connection_block_module_name(cb_type, cb_coordinate));
+      if (true == module_manager.valid_module_id(cb_module)) {
+        build_cb_module_ports(gsb_module_ports, module_manager, cb_module,
+                              grids, device_annotation, rr_graph, rr_gsb, cb_type);
+      }
+    }
+  });
+
+  return gsb_module_ports;
+}
+
+} /* end namespace openfpga */
@@ -0,0 +1,30 @@
+#ifndef BUILD_DEVICE_RR_GSB_MODULE_PORTS_H
+#define BUILD_DEVICE_RR_GSB_MODULE_PORTS_H
+
+/********************************************************************
+ * Include header files that are required by function declaration
+ *******************************************************************/
+#include "device_grid.h"
+#include "rr_graph_obj.h"
+#include "vpr_device_annotation.h"
+#include "device_rr_gsb.h"
+#include "module_manager.h"
+#include "device_rr_gsb_module_ports.h"
+
+/********************************************************************
+ * Function declaration
+ *******************************************************************/
+
+/* begin namespace openfpga */
+namespace openfpga {
+
+DeviceRRGSBModulePorts build_device_rr_gsb_module_ports(const ModuleManager& module_manager,
+                                                        const DeviceRRGSB& device_rr_gsb,
+                                                        const DeviceGrid& grids,
+                                                        const VprDeviceAnnotation& device_annotation,
+                                                        const RRGraph& rr_graph,
+                                                        const size_t& num_threads);
+
+} /* end namespace openfpga */
+
+#endif
@@ -4,6 +4,8 @@
  *******************************************************************/
 #include <ctime>
 #include <vector>
+#include <set>
+#include <unordered_map>
 
 /* Headers from vtrutil library */
 #include "vtr_geometry.h"
@@ -285,12 +287,25 @@ void build_primitive_block_module(ModuleManager& module_manager,
                                               num_shared_config_bits); 
   }
 
+  /* Find the associated memory module, which is built before the primitive module */
+  std::string memory_module_name = generate_memory_module_name(circuit_lib, primitive_model, sram_model, std::string(MEMORY_MODULE_POSTFIX));
+  ModuleId memory_module = module_manager.find_module(memory_module_name);
+
   /* Regular (independent) SRAM ports */
   size_t num_config_bits = find_circuit_num_config_bits(sram_orgz_type, circuit_lib, primitive_model);
+  size_t frame_data_width = 0;
+  if ( (CONFIG_MEM_FRAME_BASED == sram_orgz_type)
+    && (ModuleId::INVALID() != memory_module) ) {
+    /* For frame-based memories, the address and data input ports should match the memory module,
+     * as the address size depends on the number of bits loaded per frame
+     */
+    num_config_bits = find_module_num_config_bits(module_manager, memory_module, circuit_lib, sram_model, sram_orgz_type);
+    frame_data_width = find_module_frame_data_width(module_manager, memory_module);
+  }
   if (0 < num_config_bits) {
     add_sram_ports_to_module_manager(module_manager, primitive_module,
                                      circuit_lib, sram_model, sram_orgz_type,
-                                     num_config_bits);
+                                     num_config_bits, frame_data_width);
   }
 
   /* Find the module id in the module manager */
@@ -306,11 +321,9 @@ void build_primitive_block_module(ModuleManager& module_manager,
                                     circuit_lib, primitive_pb_graph_node->pb_type,
                                     device_annotation);
 
-  /* Add the associated memory module as a child of primitive module */
-  std::string memory_module_name = generate_memory_module_name(circuit_lib, primitive_model, sram_model, std::string(MEMORY_MODULE_POSTFIX));
-  ModuleId memory_module = module_manager.find_module(memory_module_name);
-
-  /* If there is no memory module required, we can skip the assocated net addition */
+  /* Add the associated memory module as a child of primitive module
+   * If there is no memory module required, we can skip the assocated net addition
+   */
   if (ModuleId::INVALID() != memory_module) {
     size_t memory_instance_id = module_manager.num_instance(primitive_module, memory_module); 
     /* Add the memory module as a child of primitive module */
@@ -802,6 +815,62 @@ void add_module_pb_graph_interc(ModuleManager& module_manager,
   }
 }
 
+/********************************************************************
+ * Merge the modules of the child pb_types under a physical mode 
+ * into the identical modules which have been built for the logical tile,
+ * so that the netlists of identical pb_types are written only once.
+ * The modules of child pb_types are compared by their ports, 
+ * child instances and nets, after their own child modules have been merged.
+ *
+ * Note:
+ *   - The instances of child pb_types are identified by their modules
+ *     and placement indices. Therefore, two child pb_types of 
+ *     the same mode are never merged into the same module, 
+ *     and a child pb_type is never merged into another one of the mode
+ *   - Modules which are not merged are added to the list of unique modules
+ *******************************************************************/
+static 
+void dedup_child_pb_type_modules(ModuleManager& module_manager,
+                                 std::unordered_map<size_t, std::vector<ModuleId>>& unique_pb_modules,
+                                 t_mode* physical_mode,
+                                 const bool& verbose) {
+  /* Modules which are instanciated by the parent pb_type */
+  std::set<ModuleId> sibling_modules;
+
+  for (int ichild = 0; ichild < physical_mode->num_pb_type_children; ++ichild) {
+    std::string child_pb_module_name = generate_physical_block_module_name(&(physical_mode->pb_type_children[ichild]));
+    ModuleId child_pb_module = module_manager.find_module(child_pb_module_name);
+    VTR_ASSERT(true == module_manager.valid_module_id(child_pb_module));
+
+    size_t module_hash = module_body_hash(module_manager, child_pb_module);
+    std::vector<ModuleId>& candidates = unique_pb_modules[module_hash];
+    ModuleId identical_module = ModuleId::INVALID();
+    for (const ModuleId& candidate : candidates) {
+      if (true == module_bodies_identical(module_manager, candidate, child_pb_module)) {
+        identical_module = candidate;
+        break;
+      }
+    }
+
+    if (false == module_manager.valid_module_id(identical_module)) {
+      candidates.push_back(child_pb_module);
+      sibling_modules.insert(child_pb_module);
+      continue;
+    }
+
+    if (0 < sibling_modules.count(identical_module)) {
+      continue;
+    }
+
+    VTR_LOGV(verbose,
+             "Merged module '%s' into '%s'\n",
+             child_pb_module_name.c_str(),
+             module_manager.module_name(identical_module).c_str());
+    module_manager.merge_module(child_pb_module, identical_module);
+    sibling_modules.insert(identical_module);
+  }
+}
+
 /********************************************************************
  * Print Verilog modules of physical blocks inside a grid (CLB, I/O. etc.)
  * This function will traverse the graph of complex logic block (t_pb_graph_node)
@@ -826,6 +895,8 @@ void rec_build_logical_tile_modules(ModuleManager& module_manager,
                                     const e_config_protocol_type& sram_orgz_type,
                                     const CircuitModelId& sram_model,
                                     t_pb_graph_node* physical_pb_graph_node,
+                                    const bool& dedup_pb_modules,
+                                    std::unordered_map<size_t, std::vector<ModuleId>>& unique_pb_modules,
                                     const bool& verbose) {
   /* Check cur_pb_graph_node*/
   VTR_ASSERT(nullptr != physical_pb_graph_node);
@@ -847,8 +918,15 @@ void rec_build_logical_tile_modules(ModuleManager& module_manager,
                                      circuit_lib, mux_lib, 
                                      sram_orgz_type, sram_model, 
                                      &(physical_pb_graph_node->child_pb_graph_nodes[physical_mode->index][ipb][0]),
+                                     dedup_pb_modules, unique_pb_modules,
                                      verbose);
     }
+
+    /* Merge the child modules before they are instanciated */
+    if (true == dedup_pb_modules) {
+      dedup_child_pb_type_modules(module_manager, unique_pb_modules,
+                                  physical_mode, verbose);
+    }
   }
 
   /* For leaf node, a primitive Verilog module will be generated */
@@ -957,7 +1035,8 @@ void rec_build_logical_tile_modules(ModuleManager& module_manager,
    */
   size_t module_num_config_bits = find_module_num_config_bits_from_child_modules(module_manager, pb_module, circuit_lib, sram_model, sram_orgz_type); 
   if (0 < module_num_config_bits) {
-    add_sram_ports_to_module_manager(module_manager, pb_module, circuit_lib, sram_model, sram_orgz_type, module_num_config_bits);
+    add_sram_ports_to_module_manager(module_manager, pb_module, circuit_lib, sram_model, sram_orgz_type, module_num_config_bits,
+                                     find_module_frame_data_width_from_child_modules(module_manager, pb_module));
   }
 
   /* Add module nets to connect memory cells inside
@@ -1114,7 +1193,8 @@ void build_physical_tile_module(ModuleManager& module_manager,
    */
   size_t module_num_config_bits = find_module_num_config_bits_from_child_modules(module_manager, grid_module, circuit_lib, sram_model, sram_orgz_type); 
   if (0 < module_num_config_bits) {
-    add_sram_ports_to_module_manager(module_manager, grid_module, circuit_lib, sram_model, sram_orgz_type, module_num_config_bits);
+    add_sram_ports_to_module_manager(module_manager, grid_module, circuit_lib, sram_model, sram_orgz_type, module_num_config_bits,
+                                     find_module_frame_data_width_from_child_modules(module_manager, grid_module));
   }
 
   /* Add module nets to connect memory cells inside
@@ -1149,6 +1229,8 @@ void build_grid_modules(ModuleManager& module_manager,
                         const e_config_protocol_type& sram_orgz_type,
                         const CircuitModelId& sram_model,
                         const bool& duplicate_grid_pin,
+                        const bool& dedup_pb_modules,
+                        const size_t& num_threads,
                         const bool& verbose) {
   /* Start time count */
   vtr::ScopedStartFinishTimer timer("Build grid modules");
@@ -1160,28 +1242,56 @@ void build_grid_modules(ModuleManager& module_manager,
    * DFS can guarantee that all the sub-modules can be registered properly
    * to its parent in module manager  
    */
-  /* Build modules starting from the top-level pb_type/pb_graph_node, and traverse the graph in a recursive way */
+  /* Build modules starting from the top-level pb_type/pb_graph_node, and traverse the graph in a recursive way
+   * Logical tiles do not share any module except decoders,
+   * so that each of them can be built independently on a fragment of the module graph
+   * For the same reason, identical modules are merged only inside a logical tile,
+   * which makes the merging independent from the number of threads
+   */
   VTR_LOG("Building logical tiles...");
   VTR_LOGV(verbose, "\n");
+  std::vector<t_pb_graph_node*> logical_tile_heads;
   for (const t_logical_block_type& logical_tile : device_ctx.logical_block_types) {
     /* Bypass empty pb_graph */
     if (nullptr == logical_tile.pb_graph_head) {
       continue;
     }
-    rec_build_logical_tile_modules(module_manager, decoder_lib,
-                                   device_annotation,
-                                   circuit_lib, mux_lib,
-                                   sram_orgz_type, sram_model, 
-                                   logical_tile.pb_graph_head,
-                                   verbose);
+    logical_tile_heads.push_back(logical_tile.pb_graph_head);
   }
+  build_modules_on_fragments(module_manager, decoder_lib,
+                             logical_tile_heads.size(), num_threads,
+                             std::string("Building logical tiles"),
+                             [&](ModuleManager& task_module_manager,
+                                 DecoderLibrary& task_decoder_lib,
+                                 const size_t& itile) {
+                               std::unordered_map<size_t, std::vector<ModuleId>> unique_pb_modules;
+                               rec_build_logical_tile_modules(task_module_manager, task_decoder_lib,
+                                                              device_annotation,
+                                                              circuit_lib, mux_lib,
+                                                              sram_orgz_type, sram_model, 
+                                                              logical_tile_heads[itile],
+                                                              dedup_pb_modules, unique_pb_modules,
+                                                              verbose);
+                             });
   VTR_LOG("Done\n");
 
+  if (true == dedup_pb_modules) {
+    size_t num_merged_modules = 0;
+    for (const ModuleId& module : module_manager.modules()) {
+      if (true == module_manager.valid_module_id(module_manager.merged_module(module))) {
+        num_merged_modules++;
+      }
+    }
+    VTR_LOG("Merged %lu logical tile modules into identical modules\n",
+            num_merged_modules);
+  }
+
   /* Enumerate the types of physical tiles
    * Use the logical tile module to build the physical tiles
    */
   VTR_LOG("Building physical tiles...");
   VTR_LOGV(verbose, "\n");
+  std::vector<std::pair<t_physical_tile_type_ptr, e_side>> physical_tiles;
   for (const t_physical_tile_type& physical_tile : device_ctx.physical_tile_types) {
     /* Bypass empty type or nullptr */
     if (true == is_empty_type(&physical_tile)) {
@@ -1198,27 +1308,28 @@ void build_grid_modules(ModuleManager& module_manager,
       std::set<e_side> io_type_sides = find_physical_io_tile_located_sides(device_ctx.grid,
                                                                            &physical_tile);
       for (const e_side& io_type_side : io_type_sides) {
-        build_physical_tile_module(module_manager, decoder_lib,
-                                   device_annotation,
-                                   circuit_lib,
-                                   sram_orgz_type, sram_model,
-                                   &physical_tile,
-                                   io_type_side,
-                                   duplicate_grid_pin,
-                                   verbose);
+        physical_tiles.push_back(std::make_pair(&physical_tile, io_type_side));
       } 
     } else {
       /* For CLB and heterogenenous blocks */
-      build_physical_tile_module(module_manager, decoder_lib,
-                                 device_annotation,
-                                 circuit_lib, 
-                                 sram_orgz_type, sram_model,
-                                 &physical_tile,
-                                 NUM_SIDES,
-                                 duplicate_grid_pin,
-                                 verbose);
+      physical_tiles.push_back(std::make_pair(&physical_tile, NUM_SIDES));
     }
   }
+  build_modules_on_fragments(module_manager, decoder_lib,
+                             physical_tiles.size(), num_threads,
+                             std::string("Building physical tiles"),
+                             [&](ModuleManager& task_module_manager,
+                                 DecoderLibrary& task_decoder_lib,
+                                 const size_t& itile) {
+                               build_physical_tile_module(task_module_manager, task_decoder_lib,
+                                                          device_annotation,
+                                                          circuit_lib,
+                                                          sram_orgz_type, sram_model,
+                                                          physical_tiles[itile].first,
+                                                          physical_tiles[itile].second,
+                                                          duplicate_grid_pin,
+                                                          verbose);
+                             });
   VTR_LOG("Done\n");
 }
 
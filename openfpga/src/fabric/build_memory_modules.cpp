@@ -585,6 +585,10 @@ void build_memory_chain_module(ModuleManager& module_manager,
  *      +------------------------------------+
  *      |   Multiplexer Configuration port   |
  *
+ * When each frame loads W bits (W = frame_data_width),
+ * the data input is W-bit wide and the decoder selects ceil(N/W) frames:
+ * SRAM[i] is enabled by the decoder output [i / W]
+ * and loads the data input [i % W]
  ********************************************************************/
 static 
 void build_frame_memory_module(ModuleManager& module_manager,
@@ -592,7 +596,8 @@ void build_frame_memory_module(ModuleManager& module_manager,
                                const CircuitLibrary& circuit_lib,
                                const std::string& module_name,
                                const CircuitModelId& sram_model,
-                               const size_t& num_mems) {
+                               const size_t& num_mems,
+                               const size_t& frame_data_width) {
 
   /* Get the global ports required by the SRAM */
   std::vector<enum e_circuit_model_port_type> global_port_types;
@@ -635,9 +640,10 @@ void build_frame_memory_module(ModuleManager& module_manager,
   /* Find the specification of the decoder:
    * Size of address port and data input 
    */
-  size_t addr_size = find_mux_local_decoder_addr_size(num_mems);
-  /* Data input should match the WL (data_in) of a SRAM */
-  size_t data_size = num_mems * circuit_lib.port_size(sram_bl_ports[0]); 
+  /* Each frame loads a number of SRAMs in parallel through the data input */
+  size_t data_size = find_frame_memory_decoder_data_size(num_mems * circuit_lib.port_size(sram_bl_ports[0]),
+                                                         frame_data_width);
+  size_t addr_size = find_mux_local_decoder_addr_size(data_size);
   bool use_data_inv = (0 < sram_blb_ports.size()); 
  
   /* Search the decoder library
@@ -670,7 +676,7 @@ void build_frame_memory_module(ModuleManager& module_manager,
   ModulePortId mem_addr_port = module_manager.add_port(mem_module, addr_port, ModuleManager::MODULE_INPUT_PORT);
 
   /* Input: Data port */
-  BasicPort data_port(std::string(DECODER_DATA_IN_PORT_NAME), 1);
+  BasicPort data_port(std::string(DECODER_DATA_IN_PORT_NAME), frame_data_width);
   ModulePortId mem_data_port = module_manager.add_port(mem_module, data_port, ModuleManager::MODULE_INPUT_PORT);
 
   /* Should have only 1 or 2 output port */
@@ -718,25 +724,27 @@ void build_frame_memory_module(ModuleManager& module_manager,
 
     /* Wire data_in port to SRAM BL port */
     ModulePortId sram_bl_port = module_manager.find_module_port(sram_mem_module, circuit_lib.port_prefix(sram_bl_ports[0]));
-    add_module_bus_nets(module_manager, mem_module,
-                        mem_module, 0, mem_data_port,
-                        sram_mem_module, sram_instance, sram_bl_port);
+    ModuleNetId bl_net = create_module_source_pin_net(module_manager, mem_module,
+                                                      mem_module, 0, mem_data_port,
+                                                      data_port.pins()[sram_instance % frame_data_width]);
+    module_manager.add_module_net_sink(mem_module, bl_net, sram_mem_module, sram_instance, sram_bl_port, 0);
 
     /* Wire decoder data_out port to sram WL ports */
     ModulePortId sram_wl_port = module_manager.find_module_port(sram_mem_module, circuit_lib.port_prefix(sram_wl_ports[0]));
     ModulePortId decoder_data_port = module_manager.find_module_port(decoder_module, std::string(DECODER_DATA_OUT_PORT_NAME));
-    ModuleNetId wl_net = module_manager.create_module_net(mem_module);
-    /* Source node of the input net is the input of memory module */
-    module_manager.add_module_net_source(mem_module, wl_net, decoder_module, 0, decoder_data_port, sram_instance);
+    /* The SRAMs in the same frame share the decoder output */
+    ModuleNetId wl_net = create_module_source_pin_net(module_manager, mem_module,
+                                                      decoder_module, 0, decoder_data_port,
+                                                      sram_instance / frame_data_width);
     module_manager.add_module_net_sink(mem_module, wl_net, sram_mem_module, sram_instance, sram_wl_port, 0);
 
     /* Optional: Wire decoder data_out inverted port to sram WLB ports */
     if (true == use_data_inv) {
       ModulePortId sram_wlb_port = module_manager.find_module_port(sram_mem_module, circuit_lib.port_lib_name(sram_wlb_ports[0]));
       ModulePortId decoder_data_inv_port = module_manager.find_module_port(decoder_module, std::string(DECODER_DATA_OUT_INV_PORT_NAME));
-      ModuleNetId wlb_net = module_manager.create_module_net(mem_module);
-      /* Source node of the input net is the input of memory module */
-      module_manager.add_module_net_source(mem_module, wlb_net, decoder_module, 0, decoder_data_inv_port, sram_instance);
+      ModuleNetId wlb_net = create_module_source_pin_net(module_manager, mem_module,
+                                                         decoder_module, 0, decoder_data_inv_port,
+                                                         sram_instance / frame_data_width);
       module_manager.add_module_net_sink(mem_module, wlb_net, sram_mem_module, sram_instance, sram_wlb_port, 0);
     }
 
@@ -781,6 +789,7 @@ void build_memory_module(ModuleManager& module_manager,
                          DecoderLibrary& arch_decoder_lib,
                          const CircuitLibrary& circuit_lib,
                          const e_config_protocol_type& sram_orgz_type,
+                         const size_t& frame_data_width,
                          const std::string& module_name,
                          const CircuitModelId& sram_model,
                          const size_t& num_mems) {
@@ -796,7 +805,7 @@ void build_memory_module(ModuleManager& module_manager,
     break;
   case CONFIG_MEM_FRAME_BASED:
     build_frame_memory_module(module_manager, arch_decoder_lib, circuit_lib,
-                              module_name, sram_model, num_mems);
+                              module_name, sram_model, num_mems, frame_data_width);
     break;
   default:
     VTR_LOGF_ERROR(__FILE__, __LINE__,
@@ -824,6 +833,7 @@ void build_mux_memory_module(ModuleManager& module_manager,
                              DecoderLibrary& arch_decoder_lib,
                              const CircuitLibrary& circuit_lib,
                              const e_config_protocol_type& sram_orgz_type,
+                             const size_t& frame_data_width,
                              const CircuitModelId& mux_model,
                              const MuxGraph& mux_graph) {
   /* Find the actual number of configuration bits, based on the mux graph 
@@ -843,7 +853,8 @@ void build_mux_memory_module(ModuleManager& module_manager,
     VTR_ASSERT( 1 == sram_models.size() );
 
     build_memory_module(module_manager, arch_decoder_lib,
-                        circuit_lib, sram_orgz_type, module_name, sram_models[0], num_config_bits);
+                        circuit_lib, sram_orgz_type, frame_data_width,
+                        module_name, sram_models[0], num_config_bits);
     break;
   }
   case CIRCUIT_MODEL_DESIGN_RRAM:
@@ -880,7 +891,8 @@ void build_memory_modules(ModuleManager& module_manager,
                           DecoderLibrary& arch_decoder_lib,
                           const MuxLibrary& mux_lib,
                           const CircuitLibrary& circuit_lib,
-                          const e_config_protocol_type& sram_orgz_type) {
+                          const e_config_protocol_type& sram_orgz_type,
+                          const size_t& frame_data_width) {
   vtr::ScopedStartFinishTimer timer("Build memory modules");
   
   /* Create the memory circuits for the multiplexer */
@@ -896,7 +908,8 @@ void build_memory_modules(ModuleManager& module_manager,
     }
     /* Create a Verilog module for the memories used by the multiplexer */
     build_mux_memory_module(module_manager, arch_decoder_lib, 
-                            circuit_lib, sram_orgz_type, mux_model, mux_graph);
+                            circuit_lib, sram_orgz_type, frame_data_width,
+                            mux_model, mux_graph);
   }
 
   /* Create the memory circuits for non-MUX circuit models.
@@ -929,7 +942,8 @@ void build_memory_modules(ModuleManager& module_manager,
 
     /* Create a Verilog module for the memories used by the circuit model */
     build_memory_module(module_manager, arch_decoder_lib, 
-                        circuit_lib, sram_orgz_type, module_name, sram_models[0], num_mems);
+                        circuit_lib, sram_orgz_type, frame_data_width,
+                        module_name, sram_models[0], num_mems);
   }
 }
 
@@ -6,6 +6,8 @@
  * and the full multiplexer
  **********************************************/
 #include <string>
+#include <map>
+#include <set>
 #include <algorithm>
 
 /* Headers from vtrutil library */
@@ -1438,14 +1440,19 @@ void build_mux_modules(ModuleManager& module_manager,
                        const CircuitLibrary& circuit_lib) {
   vtr::ScopedStartFinishTimer timer("Building multiplexer modules");
 
+  /* Record the branches which have been built for each circuit model,
+   * since different sizes of multiplexers may share the same branch module
+   */
+  std::map<CircuitModelId, std::set<std::pair<size_t, size_t>>> built_branches;
+
   /* Generate basis sub-circuit for unique branches shared by the multiplexers */
   for (auto mux : mux_lib.muxes()) {
     const MuxGraph& mux_graph = mux_lib.mux_graph(mux);
     CircuitModelId mux_circuit_model = mux_lib.mux_circuit_model(mux); 
-    /* Create a mux graph for the branch circuit */
-    std::vector<MuxGraph> branch_mux_graphs = mux_graph.build_mux_branch_graphs();
+    /* Create a mux graph for the branch circuits which are not built yet */
+    std::vector<MuxGraph> branch_mux_graphs = mux_graph.build_mux_branch_graphs(built_branches[mux_circuit_model]);
     /* Create branch circuits, which are N:1 one-level or 2:1 tree-like MUXes */
-    for (auto branch_mux_graph : branch_mux_graphs) {
+    for (const MuxGraph& branch_mux_graph : branch_mux_graphs) {
       build_mux_branch_module(module_manager, circuit_lib, mux_circuit_model, 
                               branch_mux_graph);
     }
@@ -228,7 +228,7 @@ void build_switch_block_interc_modules(ModuleManager& module_manager,
 
   /* Determine if the interc lies inside a channel wire, that is interc between segments */
   if (false == rr_gsb.is_sb_node_passing_wire(rr_graph, chan_side, chan_node_id)) {
-    driver_rr_nodes = get_rr_gsb_chan_node_configurable_driver_nodes(rr_graph, rr_gsb, chan_side, chan_node_id);
+    driver_rr_nodes = rr_gsb.get_chan_node_driver_nodes(rr_graph, chan_side, chan_node_id);
     /* Special: if there are zero-driver nodes. We skip here */
     if (0 == driver_rr_nodes.size()) {
       return; 
@@ -462,7 +462,8 @@ void build_switch_block_module(ModuleManager& module_manager,
    */
   size_t module_num_config_bits = find_module_num_config_bits_from_child_modules(module_manager, sb_module, circuit_lib, sram_model, sram_orgz_type); 
   if (0 < module_num_config_bits) {
-    add_sram_ports_to_module_manager(module_manager, sb_module, circuit_lib, sram_model, sram_orgz_type, module_num_config_bits);
+    add_sram_ports_to_module_manager(module_manager, sb_module, circuit_lib, sram_model, sram_orgz_type, module_num_config_bits,
+                                     find_module_frame_data_width_from_child_modules(module_manager, sb_module));
   }
 
   /* Add all the nets to connect configuration ports from memory module to primitive modules
@@ -488,10 +489,13 @@ void build_connection_block_module_short_interc(ModuleManager& module_manager,
                                                 const RRGraph& rr_graph,
                                                 const RRGSB& rr_gsb,
                                                 const t_rr_type& cb_type,
-                                                const RRNodeId& src_rr_node,
+                                                const e_side& cb_ipin_side,
+                                                const size_t& ipin_index,
                                                 const std::map<ModulePinInfo, ModuleNetId>& input_port_to_module_nets) {
+  const RRNodeId& src_rr_node = rr_gsb.get_ipin_node(cb_ipin_side, ipin_index);
+
   /* Ensure we have only one 1 driver node */
-  std::vector<RRNodeId> driver_rr_nodes = get_rr_graph_configurable_driver_nodes(rr_graph, src_rr_node);
+  std::vector<RRNodeId> driver_rr_nodes = rr_gsb.get_ipin_node_driver_nodes(rr_graph, cb_ipin_side, ipin_index);
 
   /* We have OPINs since we may have direct connections:
    * These connections should be handled by other functions in the compact_netlist.c 
@@ -558,7 +562,7 @@ void build_connection_block_mux_module(ModuleManager& module_manager,
   VTR_ASSERT(IPIN == rr_graph.node_type(cur_rr_node));
 
   /* Build a vector of driver rr_nodes */
-  std::vector<RRNodeId> driver_rr_nodes = get_rr_graph_configurable_driver_nodes(rr_graph, cur_rr_node);
+  std::vector<RRNodeId> driver_rr_nodes = rr_gsb.get_ipin_node_driver_nodes(rr_graph, cb_ipin_side, ipin_index);
 
   std::vector<RRSwitchId> driver_switches = get_rr_graph_driver_switches(rr_graph, cur_rr_node);
   VTR_ASSERT(1 == driver_switches.size());
@@ -673,7 +677,7 @@ void build_connection_block_interc_modules(ModuleManager& module_manager,
     return; /* This port has no driver, skip it */
   } else if (1 == rr_graph.node_in_edges(src_rr_node).size()) {
     /* Print a direct connection */
-    build_connection_block_module_short_interc(module_manager, cb_module, device_annotation, grids, rr_graph, rr_gsb, cb_type, src_rr_node, input_port_to_module_nets);
+    build_connection_block_module_short_interc(module_manager, cb_module, device_annotation, grids, rr_graph, rr_gsb, cb_type, cb_ipin_side, ipin_index, input_port_to_module_nets);
 
   } else if (1 < rr_graph.node_in_edges(src_rr_node).size()) {
     /* Print the multiplexer, fan_in >= 2 */
@@ -890,7 +894,8 @@ void build_connection_block_module(ModuleManager& module_manager,
    */
   size_t module_num_config_bits = find_module_num_config_bits_from_child_modules(module_manager, cb_module, circuit_lib, sram_model, sram_orgz_type); 
   if (0 < module_num_config_bits) {
-    add_sram_ports_to_module_manager(module_manager, cb_module, circuit_lib, sram_model, sram_orgz_type, module_num_config_bits);
+    add_sram_ports_to_module_manager(module_manager, cb_module, circuit_lib, sram_model, sram_orgz_type, module_num_config_bits,
+                                     find_module_frame_data_width_from_child_modules(module_manager, cb_module));
   }
 
   /* Add all the nets to connect configuration ports from memory module to primitive modules
@@ -906,47 +911,6 @@ void build_connection_block_module(ModuleManager& module_manager,
 }
 
 
-/********************************************************************
- * Iterate over all the connection blocks in a device
- * and build a module for each of them 
- *******************************************************************/
-static 
-void build_flatten_connection_block_modules(ModuleManager& module_manager, 
-                                            DecoderLibrary& decoder_lib,
-                                            const DeviceContext& device_ctx,
-                                            const VprDeviceAnnotation& device_annotation,
-                                            const DeviceRRGSB& device_rr_gsb,
-                                            const CircuitLibrary& circuit_lib,
-                                            const e_config_protocol_type& sram_orgz_type,
-                                            const CircuitModelId& sram_model,
-                                            const t_rr_type& cb_type,
-                                            const bool& verbose) {
-  /* Build unique X-direction connection block modules */
-  vtr::Point<size_t> cb_range = device_rr_gsb.get_gsb_range();
-
-  for (size_t ix = 0; ix < cb_range.x(); ++ix) {
-    for (size_t iy = 0; iy < cb_range.y(); ++iy) {
-      /* Check if the connection block exists in the device!
-       * Some of them do NOT exist due to heterogeneous blocks (height > 1) 
-       * We will skip those modules
-       */
-      const RRGSB& rr_gsb = device_rr_gsb.get_gsb(ix, iy);
-      if (false == rr_gsb.is_cb_exist(cb_type)) {
-        continue;
-      }
-      build_connection_block_module(module_manager, 
-                                    decoder_lib,
-                                    device_annotation,
-                                    device_ctx.grid,
-                                    device_ctx.rr_graph,
-                                    circuit_lib, 
-                                    sram_orgz_type, sram_model, 
-                                    rr_gsb, cb_type,
-                                    verbose);
-    }
-  }
-}
-
 /********************************************************************
  * A top-level function of this file
  * Build all the modules for global routing architecture of a FPGA fabric
@@ -955,6 +919,10 @@ void build_flatten_connection_block_modules(ModuleManager& module_manager,
  * Covering:
  * 1. Connection blocks
  * 2. Switch blocks
+ *
+ * Each module is built by an independent task, and tasks are 
+ * executed on multiple threads when requested.
+ * Modules are created in the same sequence whatever number of threads is used
  *******************************************************************/
 void build_flatten_routing_modules(ModuleManager& module_manager,
                                    DecoderLibrary& decoder_lib,
@@ -964,50 +932,67 @@ void build_flatten_routing_modules(ModuleManager& module_manager,
                                    const CircuitLibrary& circuit_lib,
                                    const e_config_protocol_type& sram_orgz_type,
                                    const CircuitModelId& sram_model,
+                                   const size_t& num_threads,
                                    const bool& verbose) {
 
   vtr::ScopedStartFinishTimer timer("Build routing modules...");
 
-  vtr::Point<size_t> sb_range = device_rr_gsb.get_gsb_range();
+  vtr::Point<size_t> gsb_range = device_rr_gsb.get_gsb_range();
 
-  /* Build unique switch block modules */
-  for (size_t ix = 0; ix < sb_range.x(); ++ix) {
-    for (size_t iy = 0; iy < sb_range.y(); ++iy) {
-      const RRGSB& rr_gsb = device_rr_gsb.get_gsb(ix, iy);
-      if (false == rr_gsb.is_sb_exist()) {
-        continue;
+  /* Collect the switch blocks and the connection blocks which exist in the device,
+   * Some of them do NOT exist due to heterogeneous blocks (height > 1) 
+   * We will skip those modules
+   * Switch blocks come first, followed by X-direction and Y-direction connection blocks
+   */
+  std::vector<std::pair<t_rr_type, vtr::Point<size_t>>> routing_blocks;
+  for (size_t ix = 0; ix < gsb_range.x(); ++ix) {
+    for (size_t iy = 0; iy < gsb_range.y(); ++iy) {
+      if (true == device_rr_gsb.get_gsb(ix, iy).is_sb_exist()) {
+        routing_blocks.push_back(std::make_pair(NUM_RR_TYPES, vtr::Point<size_t>(ix, iy)));
+      }
+    }
+  }
+  for (const t_rr_type& cb_type : {CHANX, CHANY}) {
+    for (size_t ix = 0; ix < gsb_range.x(); ++ix) {
+      for (size_t iy = 0; iy < gsb_range.y(); ++iy) {
+        if (true == device_rr_gsb.get_gsb(ix, iy).is_cb_exist(cb_type)) {
+          routing_blocks.push_back(std::make_pair(cb_type, vtr::Point<size_t>(ix, iy)));
+        }
       }
-      build_switch_block_module(module_manager,
-                                decoder_lib,
-                                device_annotation,
-                                device_ctx.grid,
-                                device_ctx.rr_graph,
-                                circuit_lib, 
-                                sram_orgz_type, sram_model, 
-                                rr_gsb,
-                                verbose);
     }
   }
 
-  build_flatten_connection_block_modules(module_manager,
-                                         decoder_lib,
-                                         device_ctx, 
-                                         device_annotation, 
-                                         device_rr_gsb, 
-                                         circuit_lib, 
-                                         sram_orgz_type, sram_model, 
-                                         CHANX,
-                                         verbose);
-
-  build_flatten_connection_block_modules(module_manager,
-                                         decoder_lib,
-                                         device_ctx, 
-                                         device_annotation, 
-                                         device_rr_gsb, 
-                                         circuit_lib,
-                                         sram_orgz_type, sram_model, 
-                                         CHANY,
-                                         verbose);
+  build_modules_on_fragments(module_manager, decoder_lib,
+                             routing_blocks.size(), num_threads,
+                             std::string("Building routing modules"),
+                             [&](ModuleManager& task_module_manager,
+                                 DecoderLibrary& task_decoder_lib,
+                                 const size_t& iblock) {
+                               const t_rr_type& block_type = routing_blocks[iblock].first;
+                               const vtr::Point<size_t>& coord = routing_blocks[iblock].second;
+                               const RRGSB& rr_gsb = device_rr_gsb.get_gsb(coord.x(), coord.y());
+                               if (NUM_RR_TYPES == block_type) {
+                                 build_switch_block_module(task_module_manager,
+                                                           task_decoder_lib,
+                                                           device_annotation,
+                                                           device_ctx.grid,
+                                                           device_ctx.rr_graph,
+                                                           circuit_lib, 
+                                                           sram_orgz_type, sram_model, 
+                                                           rr_gsb,
+                                                           verbose);
+                               } else {
+                                 build_connection_block_module(task_module_manager, 
+                                                               task_decoder_lib,
+                                                               device_annotation,
+                                                               device_ctx.grid,
+                                                               device_ctx.rr_graph,
+                                                               circuit_lib, 
+                                                               sram_orgz_type, sram_model, 
+                                                               rr_gsb, block_type,
+                                                               verbose);
+                               }
+                             });
 }
 
 /********************************************************************
@@ -1018,6 +1003,10 @@ void build_flatten_routing_modules(ModuleManager& module_manager,
  * 1. Connection blocks
  * 2. Switch blocks
  *
+ * Each module is built by an independent task, and tasks are 
+ * executed on multiple threads when requested.
+ * Modules are created in the same sequence whatever number of threads is used
+ *
  * Note: this function SHOULD be called only when 
  * the option compact_routing_hierarchy is turned on!!!
  *******************************************************************/
@@ -1029,53 +1018,54 @@ void build_unique_routing_modules(ModuleManager& module_manager,
                                   const CircuitLibrary& circuit_lib,
                                   const e_config_protocol_type& sram_orgz_type,
                                   const CircuitModelId& sram_model,
+                                  const size_t& num_threads,
                                   const bool& verbose) {
 
   vtr::ScopedStartFinishTimer timer("Build unique routing modules...");
 
-  /* Build unique switch block modules */
-  for (size_t isb = 0; isb < device_rr_gsb.get_num_sb_unique_module(); ++isb) {
-    const RRGSB& unique_mirror = device_rr_gsb.get_sb_unique_module(isb);
-    build_switch_block_module(module_manager,
-                              decoder_lib,
-                              device_annotation,
-                              device_ctx.grid,
-                              device_ctx.rr_graph,
-                              circuit_lib, 
-                              sram_orgz_type, sram_model, 
-                              unique_mirror,
-                              verbose);
-  }
-
-  /* Build unique X-direction connection block modules */
-  for (size_t icb = 0; icb < device_rr_gsb.get_num_cb_unique_module(CHANX); ++icb) {
-    const RRGSB& unique_mirror = device_rr_gsb.get_cb_unique_module(CHANX, icb);
-
-    build_connection_block_module(module_manager, 
-                                  decoder_lib,
-                                  device_annotation,
-                                  device_ctx.grid,
-                                  device_ctx.rr_graph,
-                                  circuit_lib,  
-                                  sram_orgz_type, sram_model, 
-                                  unique_mirror, CHANX,
-                                  verbose);
-  }
-
-  /* Build unique X-direction connection block modules */
-  for (size_t icb = 0; icb < device_rr_gsb.get_num_cb_unique_module(CHANY); ++icb) {
-    const RRGSB& unique_mirror = device_rr_gsb.get_cb_unique_module(CHANY, icb);
-
-    build_connection_block_module(module_manager, 
-                                  decoder_lib,
-                                  device_annotation,
-                                  device_ctx.grid,
-                                  device_ctx.rr_graph,
-                                  circuit_lib, 
-                                  sram_orgz_type, sram_model, 
-                                  unique_mirror, CHANY,
-                                  verbose);
-  }
+  /* Unique switch blocks come first, 
+   * followed by X-direction and Y-direction connection blocks 
+   */
+  size_t num_sb = device_rr_gsb.get_num_sb_unique_module();
+  size_t num_cbx = device_rr_gsb.get_num_cb_unique_module(CHANX);
+  size_t num_cby = device_rr_gsb.get_num_cb_unique_module(CHANY);
+
+  build_modules_on_fragments(module_manager, decoder_lib,
+                             num_sb + num_cbx + num_cby, num_threads,
+                             std::string("Building unique routing modules"),
+                             [&](ModuleManager& task_module_manager,
+                                 DecoderLibrary& task_decoder_lib,
+                                 const size_t& iblock) {
+                               if (iblock < num_sb) {
+                                 const RRGSB& unique_mirror = device_rr_gsb.get_sb_unique_module(iblock);
+                                 build_switch_block_module(task_module_manager,
+                                                           task_decoder_lib,
+                                                           device_annotation,
+                                                           device_ctx.grid,
+                                                           device_ctx.rr_graph,
+                                                           circuit_lib, 
+                                                           sram_orgz_type, sram_model, 
+                                                           unique_mirror,
+                                                           verbose);
+                                 return;
+                               }
+                               t_rr_type cb_type = CHANX;
+                               size_t icb = iblock - num_sb;
+                               if (icb >= num_cbx) {
+                                 cb_type = CHANY;
+                                 icb -= num_cbx;
+                               }
+                               const RRGSB& unique_mirror = device_rr_gsb.get_cb_unique_module(cb_type, icb);
+                               build_connection_block_module(task_module_manager, 
+                                                             task_decoder_lib,
+                                                             device_annotation,
+                                                             device_ctx.grid,
+                                                             device_ctx.rr_graph,
+                                                             circuit_lib,  
+                                                             sram_orgz_type, sram_model, 
+                                                             unique_mirror, cb_type,
+                                                             verbose);
+                             });
 }
 
 } /* end namespace openfpga */
@@ -0,0 +1,769 @@
+/********************************************************************
+ * This file includes functions that are used to group the blocks
+ * of the top-level module into tiles.
+ * Each tile includes a grid and the routing blocks which are
+ * configured together with the grid, i.e.,
+ * the Switch Block (SB), X-directional Connection Block (CBX) and
+ * Y-directional Connection Block (CBY) of the GSB[x][y-1]
+ * (see organize_top_module_memory_modules() for details)
+ *
+ *       Tile[x][y]
+ *     +---------------+----------+
+ *     |               |          |
+ *     |    Grid       |   CBY    |
+ *     |               |          |
+ *     +---------------+----------+
+ *     |    CBX        |   SB     |
+ *     |               |          |
+ *     +---------------+----------+
+ *
+ * Tiles whose blocks and inner connections are the same share the
+ * same tile module, so that the top-level module only instanciates
+ * a few unique tile modules
+ *******************************************************************/
+#include <algorithm>
+#include <array>
+#include <map>
+#include <set>
+
+/* Headers from vtrutil library */
+#include "vtr_assert.h"
+#include "vtr_log.h"
+#include "vtr_time.h"
+
+/* Headers from vpr library */
+#include "vpr_utils.h"
+
+/* Headers from openfpgashell library */
+#include "command_exit_codes.h"
+
+/* Headers from openfpgautil library */
+#include "openfpga_parallel.h"
+#include "openfpga_reserved_words.h"
+
+#include "openfpga_naming.h"
+#include "openfpga_device_grid_utils.h"
+#include "memory_utils.h"
+#include "module_manager_utils.h"
+#include "build_tile_modules.h"
+
+/* begin namespace openfpga */
+namespace openfpga {
+
+/* A pin of a block in a tile: [member_id, port_id, pin_id] */
+typedef std::array<size_t, 3> t_tile_pin;
+/* A port of a block in a tile: [member_id, port_id] */
+typedef std::array<size_t, 2> t_tile_port;
+/* A pin in the top-level module: [module_id, instance_id, port_id, pin_id] */
+typedef std::array<size_t, 4> t_top_pin;
+
+/* A net between the blocks of a tile */
+struct t_tile_net {
+  t_tile_pin source;
+  std::vector<t_tile_pin> sinks;
+};
+
+/* A net of the top-level module after grouping tiles */
+struct t_top_net {
+  std::string name;
+  t_top_pin source;
+  std::vector<t_top_pin> sinks;
+};
+
+constexpr size_t INVALID_TILE_ID = size_t(-1);
+
+/********************************************************************
+ * Add a grid to the blocks of a tile
+ * The naming follows the grid instances of the top-level module
+ *******************************************************************/
+static
+void add_tile_grid_member(std::vector<TileMember>& tile_members,
+                          const DeviceGrid& grids,
+                          const vtr::Point<size_t>& grid_coord,
+                          const e_side& border_side) {
+  t_physical_tile_type_ptr grid_type = grids[grid_coord.x()][grid_coord.y()].type;
+  /* Bypass EMPTY grid */
+  if (true == is_empty_type(grid_type)) {
+    return;
+  }
+  /* Skip width or height > 1 tiles, which are included in the tile of their root */
+  if ( (0 < grids[grid_coord.x()][grid_coord.y()].width_offset)
+    || (0 < grids[grid_coord.x()][grid_coord.y()].height_offset)) {
+    return;
+  }
+
+  std::string grid_module_name_prefix(GRID_MODULE_NAME_PREFIX);
+  TileMember tile_member;
+  tile_member.role = std::string(TILE_GRID_INSTANCE_NAME);
+  tile_member.module_name = generate_grid_block_module_name(grid_module_name_prefix, std::string(grid_type->name), is_io_type(grid_type), border_side);
+  tile_member.instance_name = generate_grid_block_instance_name(grid_module_name_prefix, std::string(grid_type->name), is_io_type(grid_type), border_side, grid_coord);
+  tile_members.push_back(tile_member);
+}
+
+/********************************************************************
+ * Add a connection block of a GSB to the blocks of a tile
+ * The naming follows the connection block instances of the top-level module
+ *******************************************************************/
+static
+void add_tile_cb_member(std::vector<TileMember>& tile_members,
+                        const DeviceRRGSB& device_rr_gsb,
+                        const RRGSB& rr_gsb,
+                        const t_rr_type& cb_type,
+                        const bool& compact_routing_hierarchy) {
+  if (false == rr_gsb.is_cb_exist(cb_type)) {
+    return;
+  }
+  vtr::Point<size_t> cb_coord(rr_gsb.get_cb_x(cb_type), rr_gsb.get_cb_y(cb_type));
+  vtr::Point<size_t> cb_module_coord = cb_coord;
+  if (true == compact_routing_hierarchy) {
+    /* Note: use GSB coordinate when inquire for unique modules!!! */
+    const RRGSB& unique_mirror = device_rr_gsb.get_cb_unique_module(cb_type, vtr::Point<size_t>(rr_gsb.get_x(), rr_gsb.get_y()));
+    cb_module_coord.set_x(unique_mirror.get_cb_x(cb_type));
+    cb_module_coord.set_y(unique_mirror.get_cb_y(cb_type));
+  }
+
+  TileMember tile_member;
+  tile_member.role = (CHANX == cb_type) ? std::string(TILE_CBX_INSTANCE_NAME) : std::string(TILE_CBY_INSTANCE_NAME);
+  tile_member.module_name = generate_connection_block_module_name(cb_type, cb_module_coord);
+  tile_member.instance_name = generate_connection_block_module_name(cb_type, cb_coord);
+  tile_members.push_back(tile_member);
+}
+
+/********************************************************************
+ * Find the blocks of each tile across the fabric,
+ * in the order of SB, CBX, CBY and grid, which is the same as
+ * the configuration order inside a tile of the top-level module
+ * Coordinates without any block have an empty list
+ *******************************************************************/
+vtr::Matrix<std::vector<TileMember>> find_fabric_tile_members(const DeviceGrid& grids,
+                                                              const DeviceRRGSB& device_rr_gsb,
+                                                              const bool& compact_routing_hierarchy) {
+  vtr::Matrix<std::vector<TileMember>> tile_members({grids.width(), grids.height()});
+
+  /* Routing blocks of GSB[x][y] belong to the tile[x][y+1] */
+  vtr::Point<size_t> gsb_range = device_rr_gsb.get_gsb_range();
+  for (size_t ix = 0; ix < gsb_range.x(); ++ix) {
+    for (size_t iy = 0; iy < gsb_range.y(); ++iy) {
+      VTR_ASSERT(iy + 1 < grids.height());
+      std::vector<TileMember>& members = tile_members[ix][iy + 1];
+      const RRGSB& rr_gsb = device_rr_gsb.get_gsb(ix, iy);
+
+      if (true == rr_gsb.is_sb_exist()) {
+        vtr::Point<size_t> sb_coord(rr_gsb.get_sb_x(), rr_gsb.get_sb_y());
+        vtr::Point<size_t> sb_module_coord = sb_coord;
+        if (true == compact_routing_hierarchy) {
+          const RRGSB& unique_mirror = device_rr_gsb.get_sb_unique_module(sb_coord);
+          sb_module_coord.set_x(unique_mirror.get_sb_x());
+          sb_module_coord.set_y(unique_mirror.get_sb_y());
+        }
+        TileMember tile_member;
+        tile_member.role = std::string(TILE_SB_INSTANCE_NAME);
+        tile_member.module_name = generate_switch_block_module_name(sb_module_coord);
+        tile_member.instance_name = generate_switch_block_module_name(sb_coord);
+        members.push_back(tile_member);
+      }
+
+      add_tile_cb_member(members, device_rr_gsb, rr_gsb, CHANX, compact_routing_hierarchy);
+      add_tile_cb_member(members, device_rr_gsb, rr_gsb, CHANY, compact_routing_hierarchy);
+    }
+  }
+
+  /* Core grids */
+  for (size_t ix = 1; ix < grids.width() - 1; ++ix) {
+    for (size_t iy = 1; iy < grids.height() - 1; ++iy) {
+      add_tile_grid_member(tile_members[ix][iy], grids, vtr::Point<size_t>(ix, iy), NUM_SIDES);
+    }
+  }
+
+  /* I/O grids */
+  std::map<e_side, std::vector<vtr::Point<size_t>>> io_coordinates = generate_perimeter_grid_coordinates(grids);
+  for (const e_side& io_side : FPGA_SIDES_CLOCKWISE) {
+    for (const vtr::Point<size_t>& io_coordinate : io_coordinates[io_side]) {
+      add_tile_grid_member(tile_members[io_coordinate.x()][io_coordinate.y()], grids, io_coordinate, io_side);
+    }
+  }
+
+  return tile_members;
+}
+
+/********************************************************************
+ * Build a tile module from the blocks and inner connections of a tile
+ * - Each block is instanciated with its role as the instance name
+ * - Each port of the blocks which is connected outside the tile
+ *   is exposed as a port of the tile, named by <role>_<port_name>
+ * - Global, GPIO and configuration ports are built in the same way
+ *   as other modules, e.g., grid modules
+ *******************************************************************/
+static
+ModuleId build_tile_module(ModuleManager& module_manager,
+                           DecoderLibrary& decoder_lib,
+                           const CircuitLibrary& circuit_lib,
+                           const CircuitModelId& sram_model,
+                           const e_config_protocol_type& sram_orgz_type,
+                           const vtr::Point<size_t>& tile_coord,
+                           const std::vector<TileMember>& members,
+                           const std::vector<ModuleId>& member_modules,
+                           const std::vector<size_t>& config_members,
+                           const std::vector<t_tile_port>& exposed_ports,
+                           const std::vector<t_tile_net>& tile_nets,
+                           std::map<t_tile_port, ModulePortId>& tile_ports) {
+  ModuleId tile_module = module_manager.add_module(generate_tile_module_name(tile_coord));
+  VTR_ASSERT(true == module_manager.valid_module_id(tile_module));
+  module_manager.set_module_usage(tile_module, ModuleManager::MODULE_TILE);
+
+  for (size_t imember = 0; imember < member_modules.size(); ++imember) {
+    module_manager.add_child_module(tile_module, member_modules[imember]);
+    module_manager.set_child_instance_name(tile_module, member_modules[imember], 0, members[imember].role);
+  }
+
+  for (const t_tile_port& exposed_port : exposed_ports) {
+    ModuleId member_module = member_modules[exposed_port[0]];
+    ModulePortId member_port = ModulePortId(exposed_port[1]);
+    BasicPort member_port_info = module_manager.module_port(member_module, member_port);
+    BasicPort tile_port_info(members[exposed_port[0]].role + std::string("_") + member_port_info.get_name(), member_port_info.get_width());
+    ModulePortId tile_port = module_manager.add_port(tile_module, tile_port_info, module_manager.port_type(member_module, member_port));
+    module_manager.set_port_preproc_flag(tile_module, tile_port, module_manager.port_preproc_flag(member_module, member_port));
+    tile_ports[exposed_port] = tile_port;
+  }
+
+  add_module_global_ports_from_child_modules(module_manager, tile_module);
+  add_module_gpio_ports_from_child_modules(module_manager, tile_module);
+
+  for (const size_t& member : config_members) {
+    module_manager.add_configurable_child(tile_module, member_modules[member], 0);
+  }
+
+  size_t module_num_shared_config_bits = find_module_num_shared_config_bits_from_child_modules(module_manager, tile_module);
+  if (0 < module_num_shared_config_bits) {
+    add_reserved_sram_ports_to_module_manager(module_manager, tile_module, module_num_shared_config_bits);
+  }
+
+  size_t module_num_config_bits = find_module_num_config_bits_from_child_modules(module_manager, tile_module, circuit_lib, sram_model, sram_orgz_type);
+  if (0 < module_num_config_bits) {
+    add_sram_ports_to_module_manager(module_manager, tile_module, circuit_lib, sram_model, sram_orgz_type, module_num_config_bits,
+                                     find_module_frame_data_width_from_child_modules(module_manager, tile_module));
+  }
+
+  if (0 < module_manager.configurable_children(tile_module).size()) {
+    add_module_nets_memory_config_bus(module_manager, decoder_lib, tile_module,
+                                      sram_orgz_type, circuit_lib.design_tech_type(sram_model));
+  }
+
+  /* Inner connections, which also drive the exposed ports if needed */
+  std::set<t_tile_pin> driven_pins;
+  std::set<t_tile_pin> source_pins;
+  for (const t_tile_net& tile_net : tile_nets) {
+    ModuleNetId net = module_manager.create_module_net(tile_module);
+    module_manager.add_module_net_source(tile_module, net,
+                                         member_modules[tile_net.source[0]], 0,
+                                         ModulePortId(tile_net.source[1]), tile_net.source[2]);
+    for (const t_tile_pin& sink : tile_net.sinks) {
+      module_manager.add_module_net_sink(tile_module, net,
+                                         member_modules[sink[0]], 0,
+                                         ModulePortId(sink[1]), sink[2]);
+      driven_pins.insert(sink);
+    }
+    auto port_result = tile_ports.find({tile_net.source[0], tile_net.source[1]});
+    if (port_result != tile_ports.end()) {
+      module_manager.add_module_net_sink(tile_module, net, tile_module, 0, port_result->second, tile_net.source[2]);
+    }
+    source_pins.insert(tile_net.source);
+  }
+
+  /* Connect the remaining pins of exposed ports to the tile ports */
+  for (const t_tile_port& exposed_port : exposed_ports) {
+    ModuleId member_module = member_modules[exposed_port[0]];
+    ModulePortId member_port = ModulePortId(exposed_port[1]);
+    ModulePortId tile_port = tile_ports.at(exposed_port);
+    bool is_output = (ModuleManager::MODULE_OUTPUT_PORT == module_manager.port_type(member_module, member_port));
+    size_t port_width = module_manager.module_port(member_module, member_port).get_width();
+    for (size_t ipin = 0; ipin < port_width; ++ipin) {
+      t_tile_pin member_pin = {exposed_port[0], exposed_port[1], ipin};
+      if (true == is_output) {
+        if (0 < source_pins.count(member_pin)) {
+          continue;
+        }
+        ModuleNetId net = module_manager.create_module_net(tile_module);
+        module_manager.add_module_net_source(tile_module, net, member_module, 0, member_port, ipin);
+        module_manager.add_module_net_sink(tile_module, net, tile_module, 0, tile_port, ipin);
+      } else {
+        if (0 < driven_pins.count(member_pin)) {
+          continue;
+        }
+        ModuleNetId net = module_manager.create_module_net(tile_module);
+        module_manager.add_module_net_source(tile_module, net, tile_module, 0, tile_port, ipin);
+        module_manager.add_module_net_sink(tile_module, net, member_module, 0, member_port, ipin);
+      }
+    }
+  }
+
+  return tile_module;
+}
+
+/********************************************************************
+ * Group the blocks of the top-level module into tiles
+ * This function should be called after the top-level module is
+ * completely built, including the nets and configurable children.
+ * - The nets between the blocks of a tile are moved into the tile module
+ * - The nets between tiles and other blocks remain in the top-level
+ *   module and are connected to the ports of tiles
+ * - Each tile becomes a configurable child of the top-level module,
+ *   and its blocks are configured in the same order as before.
+ *   Therefore, the configurable blocks of each tile must be consecutive
+ *   in the configuration order and in the same configurable region
+ * - The ports of the top-level module are not changed
+ *******************************************************************/
+int build_top_module_tiles(ModuleManager& module_manager,
+                           DecoderLibrary& decoder_lib,
+                           const ModuleId& top_module,
+                           const CircuitLibrary& circuit_lib,
+                           const CircuitModelId& sram_model,
+                           const e_config_protocol_type& sram_orgz_type,
+                           const DeviceGrid& grids,
+                           const DeviceRRGSB& device_rr_gsb,
+                           const bool& compact_routing_hierarchy,
+                           const size_t& num_threads) {
+  vtr::ScopedStartFinishTimer timer("Group blocks into tiles in top module");
+
+  vtr::Matrix<std::vector<TileMember>> fabric_tile_members = find_fabric_tile_members(grids, device_rr_gsb, compact_routing_hierarchy);
+
+  /* Find the instances of blocks in each tile, and the tile of each instance */
+  std::vector<vtr::Point<size_t>> tile_coords;
+  std::vector<std::vector<ModuleId>> tile_modules;
+  vtr::vector<ModuleId, std::vector<size_t>> instance_tiles(module_manager.num_modules());
+  for (const ModuleId& child : module_manager.child_modules(top_module)) {
+    instance_tiles[child].resize(module_manager.num_instance(top_module, child), INVALID_TILE_ID);
+  }
+  size_t num_members = 0;
+  for (size_t ix = 0; ix < grids.width(); ++ix) {
+    for (size_t iy = 0; iy < grids.height(); ++iy) {
+      if (true == fabric_tile_members[ix][iy].empty()) {
+        continue;
+      }
+      size_t tile = tile_coords.size();
+      tile_coords.push_back(vtr::Point<size_t>(ix, iy));
+      tile_modules.emplace_back();
+      for (const TileMember& member : fabric_tile_members[ix][iy]) {
+        ModuleId member_module = module_manager.find_module(member.module_name);
+        VTR_ASSERT(true == module_manager.valid_module_id(member_module));
+        size_t member_instance = module_manager.instance_id(top_module, member_module, member.instance_name);
+        VTR_ASSERT(size_t(-1) != member_instance);
+        /* A module is instanciated only once in a tile, as the blocks are named by their roles */
+        VTR_ASSERT(tile_modules[tile].end() == std::find(tile_modules[tile].begin(), tile_modules[tile].end(), member_module));
+        VTR_ASSERT(INVALID_TILE_ID == instance_tiles[member_module][member_instance]);
+        instance_tiles[member_module][member_instance] = tile;
+        tile_modules[tile].push_back(member_module);
+        num_members++;
+      }
+    }
+  }
+  size_t num_tiles = tile_coords.size();
+
+  auto find_pin_tile = [&](const ModuleId& module, const size_t& instance) {
+    if (top_module == module) {
+      return INVALID_TILE_ID;
+    }
+    return instance_tiles[module][instance];
+  };
+  auto find_tile_member = [&](const size_t& tile, const ModuleId& module) {
+    auto it = std::find(tile_modules[tile].begin(), tile_modules[tile].end(), module);
+    VTR_ASSERT(it != tile_modules[tile].end());
+    return size_t(it - tile_modules[tile].begin());
+  };
+
+  /* Global, GPIO and configuration ports of blocks are connected by
+   * the tile modules in the same way as other modules.
+   * Other ports are connected through the ports exposed by tiles
+   */
+  std::vector<std::string> config_port_names = generate_sram_port_names(circuit_lib, sram_model, sram_orgz_type);
+  vtr::vector<ModuleId, std::vector<bool>> utility_ports(module_manager.num_modules());
+  for (const std::vector<ModuleId>& members : tile_modules) {
+    for (const ModuleId& member_module : members) {
+      if (false == utility_ports[member_module].empty()) {
+        continue;
+      }
+      for (const ModulePortId& port : module_manager.module_ports(member_module)) {
+        ModuleManager::e_module_port_type port_type = module_manager.port_type(member_module, port);
+        std::string port_name = module_manager.module_port(member_module, port).get_name();
+        bool is_utility = (ModuleManager::MODULE_GLOBAL_PORT == port_type)
+                       || (ModuleManager::MODULE_GPIN_PORT == port_type)
+                       || (ModuleManager::MODULE_GPOUT_PORT == port_type)
+                       || (ModuleManager::MODULE_GPIO_PORT == port_type)
+                       || (config_port_names.end() != std::find(config_port_names.begin(), config_port_names.end(), port_name));
+        utility_ports[member_module].push_back(is_utility);
+      }
+    }
+  }
+  auto is_utility_pin = [&](const size_t& tile, const ModuleId& module, const ModulePortId& port) {
+    return (INVALID_TILE_ID != tile) && (true == utility_ports[module][size_t(port)]);
+  };
+  /* A connection is moved into a tile, if both pins are in the tile,
+   * and are either generic pins or pins connected by the tile module
+   */
+  auto is_inner_connection = [&](const size_t& src_tile, const bool& src_utility,
+                                 const size_t& sink_tile, const bool& sink_utility) {
+    return (INVALID_TILE_ID != src_tile) && (src_tile == sink_tile) && (src_utility == sink_utility);
+  };
+
+  /* Classify the nets of the top-level module */
+  std::vector<std::vector<t_tile_net>> tile_nets(num_tiles);
+  std::vector<std::vector<t_tile_port>> tile_exposed_ports(num_tiles);
+  std::vector<ModuleNetId> outer_nets;
+  for (const ModuleNetId& net : module_manager.module_nets(top_module)) {
+    vtr::vector<ModuleNetSrcId, ModuleId> src_modules = module_manager.net_source_modules(top_module, net);
+    vtr::vector<ModuleNetSinkId, ModuleId> sink_modules = module_manager.net_sink_modules(top_module, net);
+    if ( (true == src_modules.empty()) && (true == sink_modules.empty()) ) {
+      continue;
+    }
+    if (1 != src_modules.size()) {
+      VTR_LOG_ERROR("Net '%lu' of the top-level module has %lu sources, while grouping tiles requires one source per net!\n",
+                    size_t(net), src_modules.size());
+      return CMD_EXEC_FATAL_ERROR;
+    }
+    ModuleId src_module = src_modules[ModuleNetSrcId(0)];
+    size_t src_instance = module_manager.net_source_instance(top_module, net, ModuleNetSrcId(0));
+    ModulePortId src_port = module_manager.net_source_port(top_module, net, ModuleNetSrcId(0));
+    size_t src_pin = module_manager.net_source_pin(top_module, net, ModuleNetSrcId(0));
+    size_t src_tile = find_pin_tile(src_module, src_instance);
+    bool src_utility = is_utility_pin(src_tile, src_module, src_port);
+
+    vtr::vector<ModuleNetSinkId, size_t> sink_instances = module_manager.net_sink_instances(top_module, net);
+    vtr::vector<ModuleNetSinkId, ModulePortId> sink_ports = module_manager.net_sink_ports(top_module, net);
+    vtr::vector<ModuleNetSinkId, size_t> sink_pins = module_manager.net_sink_pins(top_module, net);
+
+    t_tile_net tile_net;
+    bool is_outer = false;
+    for (const ModuleNetSinkId& sink : module_manager.module_net_sinks(top_module, net)) {
+      size_t sink_tile = find_pin_tile(sink_modules[sink], sink_instances[sink]);
+      bool sink_utility = is_utility_pin(sink_tile, sink_modules[sink], sink_ports[sink]);
+      if (true == is_inner_connection(src_tile, src_utility, sink_tile, sink_utility)) {
+        /* Connections between utility pins are built by the tile module */
+        if (false == src_utility) {
+          tile_net.sinks.push_back({find_tile_member(sink_tile, sink_modules[sink]), size_t(sink_ports[sink]), sink_pins[sink]});
+        }
+        continue;
+      }
+      is_outer = true;
+      if ( (INVALID_TILE_ID != sink_tile) && (false == sink_utility) ) {
+        tile_exposed_ports[sink_tile].push_back({find_tile_member(sink_tile, sink_modules[sink]), size_t(sink_ports[sink])});
+      }
+    }
+
+    if ( (INVALID_TILE_ID == src_tile) || (true == src_utility) ) {
+      if (true == is_outer) {
+        outer_nets.push_back(net);
+      }
+      continue;
+    }
+    t_tile_pin tile_src_pin = {find_tile_member(src_tile, src_module), size_t(src_port), src_pin};
+    if (true == is_outer) {
+      outer_nets.push_back(net);
+      tile_exposed_ports[src_tile].push_back({tile_src_pin[0], tile_src_pin[1]});
+    }
+    if (false == tile_net.sinks.empty()) {
+      tile_net.source = tile_src_pin;
+      tile_nets[src_tile].push_back(tile_net);
+    }
+  }
+
+  /* The configurable blocks of each tile should be consecutive and in the same region,
+   * so that the configuration order is kept
+   */
+  std::vector<ModuleId> config_children = module_manager.configurable_children(top_module);
+  std::vector<size_t> config_child_instances = module_manager.configurable_child_instances(top_module);
+  std::vector<std::vector<size_t>> tile_config_members(num_tiles);
+  size_t last_config_tile = INVALID_TILE_ID;
+  for (size_t ichild = 0; ichild < config_children.size(); ++ichild) {
+    size_t tile = find_pin_tile(config_children[ichild], config_child_instances[ichild]);
+    if ( (INVALID_TILE_ID != tile)
+      && (tile != last_config_tile)
+      && (false == tile_config_members[tile].empty()) ) {
+      VTR_LOG_ERROR("Configurable blocks of tile [%lu][%lu] are not consecutive in the configuration order, which is required by grouping tiles!\n",
+                    tile_coords[tile].x(), tile_coords[tile].y());
+      return CMD_EXEC_FATAL_ERROR;
+    }
+    if (INVALID_TILE_ID != tile) {
+      tile_config_members[tile].push_back(find_tile_member(tile, config_children[ichild]));
+    }
+    last_config_tile = tile;
+  }
+
+  std::vector<std::vector<std::pair<ModuleId, size_t>>> region_children;
+  std::vector<ConfigRegionId> tile_regions(num_tiles, ConfigRegionId::INVALID());
+  for (const ConfigRegionId& config_region : module_manager.regions(top_module)) {
+    std::vector<ModuleId> region_modules = module_manager.region_configurable_children(top_module, config_region);
+    std::vector<size_t> region_instances = module_manager.region_configurable_child_instances(top_module, config_region);
+    region_children.emplace_back();
+    for (size_t ichild = 0; ichild < region_modules.size(); ++ichild) {
+      region_children.back().push_back(std::make_pair(region_modules[ichild], region_instances[ichild]));
+      size_t tile = find_pin_tile(region_modules[ichild], region_instances[ichild]);
+      if (INVALID_TILE_ID == tile) {
+        continue;
+      }
+      if ( (ConfigRegionId::INVALID() != tile_regions[tile])
+        && (config_region != tile_regions[tile]) ) {
+        VTR_LOG_ERROR("Configurable blocks of tile [%lu][%lu] are in different configurable regions, which is not allowed by grouping tiles!\n",
+                      tile_coords[tile].x(), tile_coords[tile].y());
+        return CMD_EXEC_FATAL_ERROR;
+      }
+      tile_regions[tile] = config_region;
+    }
+  }
+
+  /* Find the unique tiles: tiles are the same if they have the same blocks,
+   * configuration order, exposed ports and inner connections
+   */
+  std::vector<std::vector<size_t>> tile_signatures(num_tiles);
+  parallel_for(num_tiles, num_threads, [&](const size_t& tile) {
+    std::vector<t_tile_port>& exposed_ports = tile_exposed_ports[tile];
+    std::sort(exposed_ports.begin(), exposed_ports.end());
+    exposed_ports.erase(std::unique(exposed_ports.begin(), exposed_ports.end()), exposed_ports.end());
+    for (t_tile_net& tile_net : tile_nets[tile]) {
+      std::sort(tile_net.sinks.begin(), tile_net.sinks.end());
+    }
+    std::sort(tile_nets[tile].begin(), tile_nets[tile].end(),
+              [](const t_tile_net& a, const t_tile_net& b) { return a.source < b.source; });
+
+    std::vector<size_t>& signature = tile_signatures[tile];
+    signature.push_back(tile_modules[tile].size());
+    for (const ModuleId& member_module : tile_modules[tile]) {
+      signature.push_back(size_t(member_module));
+    }
+    signature.push_back(tile_config_members[tile].size());
+    signature.insert(signature.end(), tile_config_members[tile].begin(), tile_config_members[tile].end());
+    signature.push_back(exposed_ports.size());
+    for (const t_tile_port& exposed_port : exposed_ports) {
+      signature.insert(signature.end(), exposed_port.begin(), exposed_port.end());
+    }
+    signature.push_back(tile_nets[tile].size());
+    for (const t_tile_net& tile_net : tile_nets[tile]) {
+      signature.insert(signature.end(), tile_net.source.begin(), tile_net.source.end());
+      signature.push_back(tile_net.sinks.size());
+      for (const t_tile_pin& sink : tile_net.sinks) {
+        signature.insert(signature.end(), sink.begin(), sink.end());
+      }
+    }
+  });
+
+  std::vector<size_t> tile_unique_ids(num_tiles);
+  std::vector<size_t> unique_tiles;
+  {
+    std::map<std::vector<size_t>, size_t> unique_tile_lookup;
+    for (size_t tile = 0; tile < num_tiles; ++tile) {
+      auto result = unique_tile_lookup.emplace(std::move(tile_signatures[tile]), unique_tiles.size());
+      if (true == result.second) {
+        unique_tiles.push_back(tile);
+      }
+      tile_unique_ids[tile] = result.first->second;
+      tile_signatures[tile].clear();
+      tile_signatures[tile].shrink_to_fit();
+    }
+  }
+
+  /* Build a module for each unique tile */
+  std::vector<ModuleId> unique_tile_modules;
+  std::vector<std::map<t_tile_port, ModulePortId>> unique_tile_ports(unique_tiles.size());
+  for (size_t iunique = 0; iunique < unique_tiles.size(); ++iunique) {
+    size_t tile = unique_tiles[iunique];
+    unique_tile_modules.push_back(build_tile_module(module_manager, decoder_lib,
+                                                    circuit_lib, sram_model, sram_orgz_type,
+                                                    tile_coords[tile],
+                                                    fabric_tile_members[tile_coords[tile].x()][tile_coords[tile].y()],
+                                                    tile_modules[tile],
+                                                    tile_config_members[tile],
+                                                    tile_exposed_ports[tile],
+                                                    tile_nets[tile],
+                                                    unique_tile_ports[iunique]));
+  }
+  tile_nets.clear();
+  tile_exposed_ports.clear();
+
+  /* Instance ids in the new top-level module:
+   * tiles are instanciated first, followed by the other blocks in their original order
+   */
+  std::vector<size_t> tile_instance_ids(num_tiles);
+  std::vector<size_t> num_unique_tile_instances(unique_tiles.size(), 0);
+  for (size_t tile = 0; tile < num_tiles; ++tile) {
+    tile_instance_ids[tile] = num_unique_tile_instances[tile_unique_ids[tile]]++;
+  }
+  std::vector<std::pair<ModuleId, std::string>> other_instances;
+  vtr::vector<ModuleId, std::vector<size_t>> other_instance_ids(module_manager.num_modules());
+  for (const ModuleId& child : module_manager.child_modules(top_module)) {
+    size_t num_other_instances = 0;
+    for (size_t instance = 0; instance < module_manager.num_instance(top_module, child); ++instance) {
+      other_instance_ids[child].push_back(size_t(-1));
+      if (INVALID_TILE_ID != instance_tiles[child][instance]) {
+        continue;
+      }
+      other_instance_ids[child][instance] = num_other_instances++;
+      other_instances.push_back(std::make_pair(child, module_manager.instance_name(top_module, child, instance)));
+    }
+  }
+
+  /* Find the pin of the new top-level module which replaces a pin of the original one */
+  const t_top_pin INVALID_TOP_PIN = {size_t(-1), size_t(-1), size_t(-1), size_t(-1)};
+  auto find_new_top_pin = [&](const ModuleId& module, const size_t& instance,
+                              const ModulePortId& port, const size_t& pin,
+                              const bool& is_source) {
+    size_t tile = find_pin_tile(module, instance);
+    if (top_module == module) {
+      return t_top_pin({size_t(module), instance, size_t(port), pin});
+    }
+    if (INVALID_TILE_ID == tile) {
+      return t_top_pin({size_t(module), other_instance_ids[module][instance], size_t(port), pin});
+    }
+    size_t unique_id = tile_unique_ids[tile];
+    ModuleId tile_module = unique_tile_modules[unique_id];
+    if (false == utility_ports[module][size_t(port)]) {
+      auto it = unique_tile_ports[unique_id].find({find_tile_member(tile, module), size_t(port)});
+      VTR_ASSERT(it != unique_tile_ports[unique_id].end());
+      return t_top_pin({size_t(tile_module), tile_instance_ids[tile], size_t(it->second), pin});
+    }
+    /* Find the tile port which is connected to the pin inside the tile module */
+    ModuleNetId tile_net = module_manager.module_instance_port_net(tile_module, module, 0, port, pin);
+    if (false == module_manager.valid_module_net_id(tile_module, tile_net)) {
+      return INVALID_TOP_PIN;
+    }
+    if (true == is_source) {
+      for (const ModuleNetSinkId& sink : module_manager.module_net_sinks(tile_module, tile_net)) {
+        if (tile_module == module_manager.net_sink_module(tile_module, tile_net, sink)) {
+          return t_top_pin({size_t(tile_module), tile_instance_ids[tile],
+                            size_t(module_manager.net_sink_port(tile_module, tile_net, sink)),
+                            module_manager.net_sink_pin(tile_module, tile_net, sink)});
+        }
+      }
+    } else {
+      for (const ModuleNetSrcId& src : module_manager.module_net_sources(tile_module, tile_net)) {
+        if (tile_module == module_manager.net_source_module(tile_module, tile_net, src)) {
+          return t_top_pin({size_t(tile_module), tile_instance_ids[tile],
+                            size_t(module_manager.net_source_port(tile_module, tile_net, src)),
+                            module_manager.net_source_pin(tile_module, tile_net, src)});
+        }
+      }
+    }
+    return INVALID_TOP_PIN;
+  };
+
+  std::vector<t_top_net> top_nets(outer_nets.size());
+  for (size_t inet = 0; inet < outer_nets.size(); ++inet) {
+    const ModuleNetId& net = outer_nets[inet];
+    t_top_net& top_net = top_nets[inet];
+    top_net.name = module_manager.net_name(top_module, net);
+
+    ModuleId src_module = module_manager.net_source_module(top_module, net, ModuleNetSrcId(0));
+    size_t src_instance = module_manager.net_source_instance(top_module, net, ModuleNetSrcId(0));
+    ModulePortId src_port = module_manager.net_source_port(top_module, net, ModuleNetSrcId(0));
+    size_t src_pin = module_manager.net_source_pin(top_module, net, ModuleNetSrcId(0));
+    size_t src_tile = find_pin_tile(src_module, src_instance);
+    bool src_utility = is_utility_pin(src_tile, src_module, src_port);
+    top_net.source = find_new_top_pin(src_module, src_instance, src_port, src_pin, true);
+    if (INVALID_TOP_PIN == top_net.source) {
+      VTR_LOG_ERROR("Unable to connect pin '%s[%lu]' of block '%s' to a port of its tile!\n",
+                    module_manager.module_port(src_module, src_port).get_name().c_str(), src_pin,
+                    module_manager.instance_name(top_module, src_module, src_instance).c_str());
+      return CMD_EXEC_FATAL_ERROR;
+    }
+
+    vtr::vector<ModuleNetSinkId, ModuleId> sink_modules = module_manager.net_sink_modules(top_module, net);
+    vtr::vector<ModuleNetSinkId, size_t> sink_instances = module_manager.net_sink_instances(top_module, net);
+    vtr::vector<ModuleNetSinkId, ModulePortId> sink_ports = module_manager.net_sink_ports(top_module, net);
+    vtr::vector<ModuleNetSinkId, size_t> sink_pins = module_manager.net_sink_pins(top_module, net);
+    for (const ModuleNetSinkId& sink : module_manager.module_net_sinks(top_module, net)) {
+      size_t sink_tile = find_pin_tile(sink_modules[sink], sink_instances[sink]);
+      bool sink_utility = is_utility_pin(sink_tile, sink_modules[sink], sink_ports[sink]);
+      if (true == is_inner_connection(src_tile, src_utility, sink_tile, sink_utility)) {
+        continue;
+      }
+      t_top_pin top_sink = find_new_top_pin(sink_modules[sink], sink_instances[sink], sink_ports[sink], sink_pins[sink], false);
+      if (INVALID_TOP_PIN == top_sink) {
+        VTR_LOG_ERROR("Unable to connect pin '%s[%lu]' of block '%s' to a port of its tile!\n",
+                      module_manager.module_port(sink_modules[sink], sink_ports[sink]).get_name().c_str(), sink_pins[sink],
+                      module_manager.instance_name(top_module, sink_modules[sink], sink_instances[sink]).c_str());
+        return CMD_EXEC_FATAL_ERROR;
+      }
+      top_net.sinks.push_back(top_sink);
+    }
+    /* Blocks of a tile may share a tile port, e.g., global ports */
+    std::sort(top_net.sinks.begin(), top_net.sinks.end());
+    top_net.sinks.erase(std::unique(top_net.sinks.begin(), top_net.sinks.end()), top_net.sinks.end());
+  }
+
+  /* Rebuild the top-level module with tiles */
+  module_manager.clear_child_modules_and_nets(top_module);
+
+  for (size_t tile = 0; tile < num_tiles; ++tile) {
+    ModuleId tile_module = unique_tile_modules[tile_unique_ids[tile]];
+    VTR_ASSERT(tile_instance_ids[tile] == module_manager.num_instance(top_module, tile_module));
+    module_manager.add_child_module(top_module, tile_module);
+    module_manager.set_child_instance_name(top_module, tile_module, tile_instance_ids[tile], generate_tile_module_name(tile_coords[tile]));
+  }
+  for (const std::pair<ModuleId, std::string>& other_instance : other_instances) {
+    size_t instance = module_manager.num_instance(top_module, other_instance.first);
+    module_manager.add_child_module(top_module, other_instance.first);
+    module_manager.set_child_instance_name(top_module, other_instance.first, instance, other_instance.second);
+  }
+
+  module_manager.reserve_module_nets(top_module, top_nets.size());
+  for (const t_top_net& top_net : top_nets) {
+    ModuleNetId net = module_manager.create_module_net(top_module);
+    if (false == top_net.name.empty()) {
+      module_manager.set_net_name(top_module, net, top_net.name);
+    }
+    module_manager.add_module_net_source(top_module, net,
+                                         ModuleId(top_net.source[0]), top_net.source[1],
+                                         ModulePortId(top_net.source[2]), top_net.source[3]);
+    for (const t_top_pin& sink : top_net.sinks) {
+      module_manager.add_module_net_sink(top_module, net,
+                                         ModuleId(sink[0]), sink[1],
+                                         ModulePortId(sink[2]), sink[3]);
+    }
+  }
+  top_nets.clear();
+
+  /* Each tile replaces its configurable blocks */
+  std::map<std::pair<ModuleId, size_t>, size_t> config_child_lookup;
+  std::vector<size_t> tile_config_child_ids(num_tiles, size_t(-1));
+  std::vector<ModuleId> new_config_children;
+  std::vector<size_t> new_config_child_instances;
+  for (size_t ichild = 0; ichild < config_children.size(); ++ichild) {
+    const ModuleId& child = config_children[ichild];
+    const size_t& instance = config_child_instances[ichild];
+    size_t tile = find_pin_tile(child, instance);
+    if (INVALID_TILE_ID == tile) {
+      config_child_lookup[std::make_pair(child, instance)] = new_config_children.size();
+      new_config_children.push_back(child);
+      new_config_child_instances.push_back(other_instance_ids[child][instance]);
+      continue;
+    }
+    if (size_t(-1) == tile_config_child_ids[tile]) {
+      tile_config_child_ids[tile] = new_config_children.size();
+      new_config_children.push_back(unique_tile_modules[tile_unique_ids[tile]]);
+      new_config_child_instances.push_back(tile_instance_ids[tile]);
+    }
+    config_child_lookup[std::make_pair(child, instance)] = tile_config_child_ids[tile];
+  }
+  module_manager.set_configurable_children(top_module, new_config_children, new_config_child_instances);
+
+  for (const std::vector<std::pair<ModuleId, size_t>>& children : region_children) {
+    ConfigRegionId config_region = module_manager.add_config_region(top_module);
+    std::vector<bool> child_added(new_config_children.size(), false);
+    for (const std::pair<ModuleId, size_t>& child : children) {
+      size_t config_child_id = config_child_lookup.at(child);
+      if (true == child_added[config_child_id]) {
+        continue;
+      }
+      module_manager.add_configurable_child_to_region(top_module, config_region,
+                                                      new_config_children[config_child_id],
+                                                      new_config_child_instances[config_child_id],
+                                                      config_child_id);
+      child_added[config_child_id] = true;
+    }
+  }
+
+  VTR_LOG("Grouped %lu blocks into %lu tiles, built from %lu unique tile modules\n",
+          num_members, num_tiles, unique_tiles.size());
+
+  return CMD_EXEC_SUCCESS;
+}
+
+} /* end namespace openfpga */
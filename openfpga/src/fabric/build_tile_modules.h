@@ -0,0 +1,54 @@
+#ifndef BUILD_TILE_MODULES_H
+#define BUILD_TILE_MODULES_H
+
+/********************************************************************
+ * Include header files that are required by function declaration
+ *******************************************************************/
+#include <string>
+#include <vector>
+#include "vtr_geometry.h"
+#include "vtr_ndmatrix.h"
+#include "device_grid.h"
+#include "device_rr_gsb.h"
+#include "circuit_library.h"
+#include "decoder_library.h"
+#include "config_protocol.h"
+#include "module_manager.h"
+
+/********************************************************************
+ * Function declaration
+ *******************************************************************/
+
+/* begin namespace openfpga */
+namespace openfpga {
+
+/* A block (grid, switch block or connection block) grouped in a tile */
+struct TileMember {
+  /* Instance name of the block in the tile module, 
+   * which is also the name of its block in bitstream
+   */
+  std::string role;
+  /* Name of the module of the block */
+  std::string module_name;
+  /* Instance name of the block in the top-level module without tiles */
+  std::string instance_name;
+};
+
+vtr::Matrix<std::vector<TileMember>> find_fabric_tile_members(const DeviceGrid& grids,
+                                                              const DeviceRRGSB& device_rr_gsb,
+                                                              const bool& compact_routing_hierarchy);
+
+int build_top_module_tiles(ModuleManager& module_manager,
+                           DecoderLibrary& decoder_lib,
+                           const ModuleId& top_module,
+                           const CircuitLibrary& circuit_lib,
+                           const CircuitModelId& sram_model,
+                           const e_config_protocol_type& sram_orgz_type,
+                           const DeviceGrid& grids,
+                           const DeviceRRGSB& device_rr_gsb,
+                           const bool& compact_routing_hierarchy,
+                           const size_t& num_threads);
+
+} /* end namespace openfpga */
+
+#endif
@@ -24,6 +24,7 @@
 #include "build_top_module_connection.h"
 #include "build_top_module_memory.h"
 #include "build_top_module_directs.h"
+#include "build_tile_modules.h"
 
 #include "build_module_graph_utils.h"
 #include "openfpga_device_grid_utils.h"
@@ -296,8 +297,10 @@ int build_top_module(ModuleManager& module_manager,
                      const bool& frame_view,
                      const bool& compact_routing_hierarchy,
                      const bool& duplicate_grid_pin,
+                     const bool& group_tile,
                      const FabricKey& fabric_key,
-                     const bool& generate_random_fabric_key) {
+                     const bool& generate_random_fabric_key,
+                     const size_t& num_threads) {
 
   vtr::ScopedStartFinishTimer timer("Build FPGA fabric module");
 
@@ -333,7 +336,8 @@ int build_top_module(ModuleManager& module_manager,
                                                vpr_device_annotation, 
                                                grids, grid_instance_ids, 
                                                rr_graph, device_rr_gsb, sb_instance_ids, cb_instance_ids,
-                                               compact_routing_hierarchy, duplicate_grid_pin);
+                                               compact_routing_hierarchy, duplicate_grid_pin,
+                                               num_threads);
     /* Add inter-CLB direct connections */
     add_top_module_nets_tile_direct_connections(module_manager, top_module, circuit_lib, 
                                                 vpr_device_annotation,
@@ -391,7 +395,7 @@ int build_top_module(ModuleManager& module_manager,
 
   /* Shuffle the configurable children in a random sequence */
   if (true == generate_random_fabric_key) {
-    shuffle_top_module_configurable_children(module_manager, top_module, config_protocol);
+    shuffle_top_module_configurable_children(module_manager, top_module, circuit_lib, config_protocol);
   }
 
   /* Add shared SRAM ports from the sub-modules under this Verilog module
@@ -426,6 +430,16 @@ int build_top_module(ModuleManager& module_manager,
                                           top_module_num_config_bits);
   }
 
+  /* Group the grids and routing blocks into tiles, 
+   * now that all the connections of the top-level module are built
+   */
+  if (true == group_tile) {
+    status = build_top_module_tiles(module_manager, decoder_lib, top_module,
+                                    circuit_lib, sram_model, config_protocol.type(),
+                                    grids, device_rr_gsb, compact_routing_hierarchy,
+                                    num_threads);
+  }
+
   return status;
 }
 
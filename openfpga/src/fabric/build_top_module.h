@@ -42,8 +42,10 @@ int build_top_module(ModuleManager& module_manager,
                      const bool& frame_view,
                      const bool& compact_routing_hierarchy,
                      const bool& duplicate_grid_pin,
+                     const bool& group_tile,
                      const FabricKey& fabric_key,
-                     const bool& generate_random_fabric_key);
+                     const bool& generate_random_fabric_key,
+                     const size_t& num_threads);
 
 } /* end namespace openfpga */
 
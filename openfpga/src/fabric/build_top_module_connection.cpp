@@ -11,6 +11,7 @@
 
 /* Headers from openfpgautil library */
 #include "openfpga_side_manager.h"
+#include "openfpga_parallel.h"
 
 /* Headers from vpr library */
 #include "vpr_utils.h"
@@ -30,6 +31,33 @@
 /* begin namespace openfpga */
 namespace openfpga {
 
+/********************************************************************
+ * A connection between two ports of child modules in the top module,
+ * where each source pin is wired to the sink pin in the same position
+ * The connections of a GSB are collected by read-only searches on the 
+ * module graph, so that different GSBs can be visited in parallel.
+ * The nets are then created in a fixed sequence, which is independent 
+ * from the number of threads
+ *******************************************************************/
+struct TopModuleNetConnection {
+  TopModuleNetConnection(const ModuleId& src_module_id, const size_t& src_instance_id,
+                         const ModulePortId& src_port_id, const std::vector<size_t>& src_pin_ids,
+                         const ModuleId& sink_module_id, const size_t& sink_instance_id,
+                         const ModulePortId& sink_port_id, const std::vector<size_t>& sink_pin_ids)
+    : src_module(src_module_id), src_instance(src_instance_id), src_port(src_port_id), src_pins(src_pin_ids),
+      sink_module(sink_module_id), sink_instance(sink_instance_id), sink_port(sink_port_id), sink_pins(sink_pin_ids) {
+  }
+
+  ModuleId src_module;
+  size_t src_instance;
+  ModulePortId src_port;
+  std::vector<size_t> src_pins;
+  ModuleId sink_module;
+  size_t sink_instance;
+  ModulePortId sink_port;
+  std::vector<size_t> sink_pins;
+};
+
 /********************************************************************
  * Add module nets to connect a GSB to adjacent grid ports/pins 
  * as well as connection blocks
@@ -63,8 +91,8 @@ namespace openfpga {
  *
  *******************************************************************/
 static 
-void add_top_module_nets_connect_grids_and_sb(ModuleManager& module_manager, 
-                                              const ModuleId& top_module, 
+void add_top_module_nets_connect_grids_and_sb(std::vector<TopModuleNetConnection>& connections,
+                                              const ModuleManager& module_manager, 
                                               const VprDeviceAnnotation& vpr_device_annotation,
                                               const DeviceGrid& grids,
                                               const vtr::Matrix<size_t>& grid_instance_ids,
@@ -146,11 +174,8 @@ void add_top_module_nets_connect_grids_and_sb(ModuleManager& module_manager,
       VTR_ASSERT(src_grid_port.get_width() == sink_sb_port.get_width());
       
       /* Create a net for each pin */
-      for (size_t pin_id = 0; pin_id < src_grid_port.pins().size(); ++pin_id) {
-        ModuleNetId net = create_module_source_pin_net(module_manager, top_module, src_grid_module, src_grid_instance, src_grid_port_id, src_grid_port.pins()[pin_id]);
-        /* Configure the net sink */
-        module_manager.add_module_net_sink(top_module, net, sink_sb_module, sink_sb_instance, sink_sb_port_id, sink_sb_port.pins()[pin_id]);
-      }
+      connections.push_back(TopModuleNetConnection(src_grid_module, src_grid_instance, src_grid_port_id, src_grid_port.pins(),
+                                                   sink_sb_module, sink_sb_instance, sink_sb_port_id, sink_sb_port.pins()));
     } 
   }
 }
@@ -192,8 +217,8 @@ void add_top_module_nets_connect_grids_and_sb(ModuleManager& module_manager,
  *
  *******************************************************************/
 static 
-void add_top_module_nets_connect_grids_and_sb_with_duplicated_pins(ModuleManager& module_manager, 
-                                                                   const ModuleId& top_module, 
+void add_top_module_nets_connect_grids_and_sb_with_duplicated_pins(std::vector<TopModuleNetConnection>& connections,
+                                                                   const ModuleManager& module_manager, 
                                                                    const VprDeviceAnnotation& vpr_device_annotation,
                                                                    const DeviceGrid& grids,
                                                                    const vtr::Matrix<size_t>& grid_instance_ids,
@@ -299,11 +324,8 @@ void add_top_module_nets_connect_grids_and_sb_with_duplicated_pins(ModuleManager
       VTR_ASSERT(src_grid_port.get_width() == sink_sb_port.get_width());
       
       /* Create a net for each pin */
-      for (size_t pin_id = 0; pin_id < src_grid_port.pins().size(); ++pin_id) {
-        ModuleNetId net = create_module_source_pin_net(module_manager, top_module, src_grid_module, src_grid_instance, src_grid_port_id, src_grid_port.pins()[pin_id]);
-        /* Configure the net sink */
-        module_manager.add_module_net_sink(top_module, net, sink_sb_module, sink_sb_instance, sink_sb_port_id, sink_sb_port.pins()[pin_id]);
-      }
+      connections.push_back(TopModuleNetConnection(src_grid_module, src_grid_instance, src_grid_port_id, src_grid_port.pins(),
+                                                   sink_sb_module, sink_sb_instance, sink_sb_port_id, sink_sb_port.pins()));
     } 
   }
 }
@@ -364,8 +386,8 @@ void add_top_module_nets_connect_grids_and_sb_with_duplicated_pins(ModuleManager
  *
  *******************************************************************/
 static 
-void add_top_module_nets_connect_grids_and_cb(ModuleManager& module_manager, 
-                                              const ModuleId& top_module, 
+void add_top_module_nets_connect_grids_and_cb(std::vector<TopModuleNetConnection>& connections,
+                                              const ModuleManager& module_manager, 
                                               const VprDeviceAnnotation& vpr_device_annotation,
                                               const DeviceGrid& grids,
                                               const vtr::Matrix<size_t>& grid_instance_ids,
@@ -457,11 +479,8 @@ void add_top_module_nets_connect_grids_and_cb(ModuleManager& module_manager,
       VTR_ASSERT(src_cb_port.get_width() == sink_grid_port.get_width());
       
       /* Create a net for each pin */
-      for (size_t pin_id = 0; pin_id < src_cb_port.pins().size(); ++pin_id) {
-        ModuleNetId net = create_module_source_pin_net(module_manager, top_module, src_cb_module, src_cb_instance, src_cb_port_id, src_cb_port.pins()[pin_id]);
-        /* Configure the net sink */
-        module_manager.add_module_net_sink(top_module, net, sink_grid_module, sink_grid_instance, sink_grid_port_id, sink_grid_port.pins()[pin_id]);
-      }
+      connections.push_back(TopModuleNetConnection(src_cb_module, src_cb_instance, src_cb_port_id, src_cb_port.pins(),
+                                                   sink_grid_module, sink_grid_instance, sink_grid_port_id, sink_grid_port.pins()));
     }
   }
 }
@@ -506,8 +525,8 @@ void add_top_module_nets_connect_grids_and_cb(ModuleManager& module_manager,
  *
  *******************************************************************/
 static 
-void add_top_module_nets_connect_sb_and_cb(ModuleManager& module_manager, 
-                                           const ModuleId& top_module, 
+void add_top_module_nets_connect_sb_and_cb(std::vector<TopModuleNetConnection>& connections,
+                                           const ModuleManager& module_manager, 
                                            const RRGraph& rr_graph,
                                            const DeviceRRGSB& device_rr_gsb,
                                            const RRGSB& rr_gsb, 
@@ -624,17 +643,67 @@ void add_top_module_nets_connect_sb_and_cb(ModuleManager& module_manager,
        * If sb port is an input (sink), cb port is an output (source) 
        */
       if (OUT_PORT == module_sb.get_chan_node_direction(side_manager.get_side(), itrack)) {
-        ModuleNetId net = create_module_source_pin_net(module_manager, top_module, sb_module_id, sb_instance, sb_port_id, itrack / 2);
-        module_manager.add_module_net_sink(top_module, net, cb_module_id, cb_instance, cb_port_id, itrack / 2);
+        connections.push_back(TopModuleNetConnection(sb_module_id, sb_instance, sb_port_id, std::vector<size_t>(1, itrack / 2),
+                                                     cb_module_id, cb_instance, cb_port_id, std::vector<size_t>(1, itrack / 2)));
       } else {
         VTR_ASSERT(IN_PORT == module_sb.get_chan_node_direction(side_manager.get_side(), itrack));
-        ModuleNetId net = create_module_source_pin_net(module_manager, top_module, cb_module_id, cb_instance, cb_port_id, itrack / 2);
-        module_manager.add_module_net_sink(top_module, net, sb_module_id, sb_instance, sb_port_id, itrack / 2);
+        connections.push_back(TopModuleNetConnection(cb_module_id, cb_instance, cb_port_id, std::vector<size_t>(1, itrack / 2),
+                                                     sb_module_id, sb_instance, sb_port_id, std::vector<size_t>(1, itrack / 2)));
       }
     }
   }
 }
 
+/********************************************************************
+ * Collect the connections between a GSB and its adjacent grids
+ * as well as the connections between its switch block and connection blocks
+ *******************************************************************/
+static 
+void add_top_module_gsb_net_connections(std::vector<TopModuleNetConnection>& connections,
+                                        const ModuleManager& module_manager, 
+                                        const VprDeviceAnnotation& vpr_device_annotation,
+                                        const DeviceGrid& grids,
+                                        const vtr::Matrix<size_t>& grid_instance_ids,
+                                        const RRGraph& rr_graph,
+                                        const DeviceRRGSB& device_rr_gsb,
+                                        const RRGSB& rr_gsb,
+                                        const vtr::Matrix<size_t>& sb_instance_ids,
+                                        const std::map<t_rr_type, vtr::Matrix<size_t>>& cb_instance_ids,
+                                        const bool& compact_routing_hierarchy,
+                                        const bool& duplicate_grid_pin) {
+  /* Connect the grid pins of the GSB to adjacent grids */
+  if (false == duplicate_grid_pin) {
+    add_top_module_nets_connect_grids_and_sb(connections, module_manager, 
+                                             vpr_device_annotation,
+                                             grids, grid_instance_ids,
+                                             rr_graph, device_rr_gsb, rr_gsb, sb_instance_ids, 
+                                             compact_routing_hierarchy);
+  } else {
+    VTR_ASSERT_SAFE(true == duplicate_grid_pin);
+    add_top_module_nets_connect_grids_and_sb_with_duplicated_pins(connections, module_manager, 
+                                                                  vpr_device_annotation,
+                                                                  grids, grid_instance_ids,
+                                                                  rr_graph, device_rr_gsb, rr_gsb, sb_instance_ids, 
+                                                                  compact_routing_hierarchy);
+  }
+
+  add_top_module_nets_connect_grids_and_cb(connections, module_manager, 
+                                           vpr_device_annotation,
+                                           grids, grid_instance_ids,
+                                           rr_graph, device_rr_gsb, rr_gsb, CHANX, cb_instance_ids.at(CHANX),
+                                           compact_routing_hierarchy);
+
+  add_top_module_nets_connect_grids_and_cb(connections, module_manager, 
+                                           vpr_device_annotation,
+                                           grids, grid_instance_ids,
+                                           rr_graph, device_rr_gsb, rr_gsb, CHANY, cb_instance_ids.at(CHANY),
+                                           compact_routing_hierarchy);
+
+  add_top_module_nets_connect_sb_and_cb(connections, module_manager, 
+                                        rr_graph, device_rr_gsb, rr_gsb, sb_instance_ids, cb_instance_ids,
+                                        compact_routing_hierarchy);
+}
+
 /********************************************************************
  * Add module nets to connect the grid ports/pins to Connection Blocks
  * and Switch Blocks
@@ -678,49 +747,37 @@ void add_top_module_nets_connect_grids_and_gsbs(ModuleManager& module_manager,
                                                 const vtr::Matrix<size_t>& sb_instance_ids,
                                                 const std::map<t_rr_type, vtr::Matrix<size_t>>& cb_instance_ids,
                                                 const bool& compact_routing_hierarchy,
-                                                const bool& duplicate_grid_pin) {
+                                                const bool& duplicate_grid_pin,
+                                                const size_t& num_threads) {
 
   vtr::ScopedStartFinishTimer timer("Add module nets between grids and GSBs");
 
   vtr::Point<size_t> gsb_range = device_rr_gsb.get_gsb_range();
 
-  for (size_t ix = 0; ix < gsb_range.x(); ++ix) {
+  /* Collect the connections of GSBs row by row (GSBs sharing the same x), where each row is a task */
+  std::vector<std::vector<TopModuleNetConnection>> row_connections(gsb_range.x());
+  parallel_for(gsb_range.x(), num_threads, [&](const size_t& ix) {
     for (size_t iy = 0; iy < gsb_range.y(); ++iy) {
-      vtr::Point<size_t> gsb_coordinate(ix, iy);
       const RRGSB& rr_gsb = device_rr_gsb.get_gsb(ix, iy);
+      add_top_module_gsb_net_connections(row_connections[ix], module_manager,
+                                         vpr_device_annotation,
+                                         grids, grid_instance_ids,
+                                         rr_graph, device_rr_gsb, rr_gsb,
+                                         sb_instance_ids, cb_instance_ids,
+                                         compact_routing_hierarchy, duplicate_grid_pin);
+    }
+  });
 
-      /* Connect the grid pins of the GSB to adjacent grids */
-      if (false == duplicate_grid_pin) {
-        add_top_module_nets_connect_grids_and_sb(module_manager, top_module, 
-                                                 vpr_device_annotation,
-                                                 grids, grid_instance_ids,
-                                                 rr_graph, device_rr_gsb, rr_gsb, sb_instance_ids, 
-                                                 compact_routing_hierarchy);
-      } else {
-        VTR_ASSERT_SAFE(true == duplicate_grid_pin);
-        add_top_module_nets_connect_grids_and_sb_with_duplicated_pins(module_manager, top_module, 
-                                                                      vpr_device_annotation,
-                                                                      grids, grid_instance_ids,
-                                                                      rr_graph, device_rr_gsb, rr_gsb, sb_instance_ids, 
-                                                                      compact_routing_hierarchy);
-      }
-
-      add_top_module_nets_connect_grids_and_cb(module_manager, top_module, 
-                                               vpr_device_annotation,
-                                               grids, grid_instance_ids,
-                                               rr_graph, device_rr_gsb, rr_gsb, CHANX, cb_instance_ids.at(CHANX),
-                                               compact_routing_hierarchy);
-
-      add_top_module_nets_connect_grids_and_cb(module_manager, top_module, 
-                                               vpr_device_annotation,
-                                               grids, grid_instance_ids,
-                                               rr_graph, device_rr_gsb, rr_gsb, CHANY, cb_instance_ids.at(CHANY),
-                                               compact_routing_hierarchy);
-
-      add_top_module_nets_connect_sb_and_cb(module_manager, top_module, 
-                                            rr_graph, device_rr_gsb, rr_gsb, sb_instance_ids, cb_instance_ids,
-                                            compact_routing_hierarchy);
-
+  /* Create the nets in the sequence of rows, so that net ids are deterministic
+   * and the same as visiting the GSBs one by one
+   */
+  for (const std::vector<TopModuleNetConnection>& connections : row_connections) {
+    for (const TopModuleNetConnection& connection : connections) {
+      module_manager.add_module_nets_between_pins(top_module,
+                                                  connection.src_module, connection.src_instance,
+                                                  connection.src_port, connection.src_pins,
+                                                  connection.sink_module, connection.sink_instance,
+                                                  connection.sink_port, connection.sink_pins);
     }
   }
 }
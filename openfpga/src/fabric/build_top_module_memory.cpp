@@ -3,6 +3,7 @@
  * in the top module of FPGA fabric
  *******************************************************************/
 #include <cmath>
+#include <unordered_map>
 
 /* Headers from vtrutil library */
 #include "vtr_assert.h"
@@ -177,6 +178,122 @@ void organize_top_module_tile_memory_modules(ModuleManager& module_manager,
 }
 
 
+/********************************************************************
+ * Find the starting configurable child of each region, so that
+ * the regions, each of which consists of consecutive children,
+ * have numbers of configuration bits as close as possible.
+ * The largest number of configuration bits among the regions,
+ * i.e., the length of the longest configuration chain, is minimized
+ * by a binary search, and each region has at least one child
+ *******************************************************************/
+static 
+std::vector<size_t> find_balanced_region_first_children(const std::vector<size_t>& child_num_config_bits,
+                                                        const size_t& num_regions) {
+  VTR_ASSERT(num_regions <= child_num_config_bits.size());
+
+  /* Split the children greedily and return the starting child of each region,
+   * where a region is closed when it would exceed the capacity,
+   * or when each of the remaining regions can only get one child
+   */
+  auto split_children = [&](const size_t& capacity) {
+    std::vector<size_t> first_children(1, 0);
+    size_t region_num_config_bits = 0;
+    for (size_t ichild = 0; ichild < child_num_config_bits.size(); ++ichild) {
+      size_t num_remaining_children = child_num_config_bits.size() - ichild;
+      bool region_full = (region_num_config_bits + child_num_config_bits[ichild] > capacity)
+                      || (num_remaining_children == num_regions - first_children.size());
+      if ((0 < ichild) && (first_children.size() < num_regions) && (true == region_full)) {
+        first_children.push_back(ichild);
+        region_num_config_bits = 0;
+      }
+      region_num_config_bits += child_num_config_bits[ichild];
+    }
+    return first_children;
+  };
+
+  /* Check if the children can be split into the regions without exceeding the capacity */
+  auto fit_capacity = [&](const size_t& capacity) {
+    size_t num_used_regions = 1;
+    size_t region_num_config_bits = 0;
+    for (const size_t& num_config_bits : child_num_config_bits) {
+      if (capacity < num_config_bits) {
+        return false;
+      }
+      if (region_num_config_bits + num_config_bits > capacity) {
+        num_used_regions++;
+        region_num_config_bits = 0;
+      }
+      region_num_config_bits += num_config_bits;
+    }
+    return num_used_regions <= num_regions;
+  };
+
+  size_t min_capacity = 0;
+  size_t max_capacity = 0;
+  for (const size_t& num_config_bits : child_num_config_bits) {
+    max_capacity += num_config_bits;
+  }
+  while (min_capacity < max_capacity) {
+    size_t capacity = min_capacity + (max_capacity - min_capacity) / 2;
+    if (true == fit_capacity(capacity)) {
+      max_capacity = capacity;
+    } else {
+      min_capacity = capacity + 1;
+    }
+  }
+
+  std::vector<size_t> first_children = split_children(max_capacity);
+  VTR_ASSERT(num_regions == first_children.size());
+  return first_children;
+}
+
+/********************************************************************
+ * Split memory modules into different configurable regions,
+ * so that each region has a similar number of configuration bits.
+ * The sequence of configurable children is kept, i.e., a region
+ * consists of consecutive children, as they are chained in this sequence
+ *******************************************************************/
+static  
+void build_top_module_balanced_configurable_regions(ModuleManager& module_manager,
+                                                    const ModuleId& top_module,
+                                                    const CircuitLibrary& circuit_lib,
+                                                    const ConfigProtocol& config_protocol) {
+  std::vector<ModuleId> configurable_children = module_manager.configurable_children(top_module);
+  std::vector<size_t> configurable_child_instances = module_manager.configurable_child_instances(top_module);
+
+  std::vector<size_t> child_num_config_bits;
+  child_num_config_bits.reserve(configurable_children.size());
+  for (const ModuleId& child_module : configurable_children) {
+    child_num_config_bits.push_back(find_module_num_config_bits(module_manager, child_module,
+                                                                circuit_lib, config_protocol.memory_model(),
+                                                                config_protocol.type()));
+  }
+
+  std::vector<size_t> first_children = find_balanced_region_first_children(child_num_config_bits, config_protocol.num_regions());
+
+  ConfigRegionId curr_region = ConfigRegionId::INVALID();
+  size_t max_region_num_config_bits = 0;
+  size_t region_num_config_bits = 0;
+  for (size_t ichild = 0; ichild < configurable_children.size(); ++ichild) {
+    if ( (size_t(curr_region) + 1 < first_children.size())
+      && (ichild == first_children[size_t(curr_region) + 1]) ) {
+      curr_region = module_manager.add_config_region(top_module);
+      region_num_config_bits = 0;
+    }
+
+    module_manager.add_configurable_child_to_region(top_module,
+                                                    curr_region,
+                                                    configurable_children[ichild],
+                                                    configurable_child_instances[ichild],
+                                                    ichild);
+    region_num_config_bits += child_num_config_bits[ichild];
+    max_region_num_config_bits = std::max(max_region_num_config_bits, region_num_config_bits);
+  }
+
+  VTR_LOG("Balanced %d configurable regions with at most %lu configuration bits per region\n",
+          config_protocol.num_regions(), max_region_num_config_bits);
+}
+
 /********************************************************************
  * Split memory modules into different configurable regions
  * This function will create regions based on the definition
@@ -219,6 +336,7 @@ void organize_top_module_tile_memory_modules(ModuleManager& module_manager,
 static  
 void build_top_module_configurable_regions(ModuleManager& module_manager,
                                            const ModuleId& top_module,
+                                           const CircuitLibrary& circuit_lib,
                                            const ConfigProtocol& config_protocol) {
 
   vtr::ScopedStartFinishTimer timer("Build configurable regions for the top module");
@@ -229,8 +347,20 @@ void build_top_module_configurable_regions(ModuleManager& module_manager,
   /* Ensure that our region definition is valid */
   VTR_ASSERT(1 <= config_protocol.num_regions());
 
+  if (true == config_protocol.balance_regions()) {
+    /* Only configuration chains have no decoders among the configurable children */
+    VTR_ASSERT(CONFIG_MEM_SCAN_CHAIN == config_protocol.type());
+    build_top_module_balanced_configurable_regions(module_manager, top_module, circuit_lib, config_protocol);
+    VTR_ASSERT((size_t)config_protocol.num_regions() == module_manager.regions(top_module).size());
+    return;
+  }
+
+  /* Cache the configurable children, rather than copying them for each child */
+  std::vector<ModuleId> configurable_children = module_manager.configurable_children(top_module);
+  std::vector<size_t> configurable_child_instances = module_manager.configurable_child_instances(top_module);
+
   /* Exclude decoders from the list */
-  size_t num_configurable_children = module_manager.configurable_children(top_module).size();
+  size_t num_configurable_children = configurable_children.size();
   if (CONFIG_MEM_MEMORY_BANK == config_protocol.type()) {
     num_configurable_children -= 2;
   } else if (CONFIG_MEM_FRAME_BASED == config_protocol.type()) {
@@ -242,7 +372,7 @@ void build_top_module_configurable_regions(ModuleManager& module_manager,
   size_t region_child_counter = 0;
   bool create_region = true;
   ConfigRegionId curr_region = ConfigRegionId::INVALID();
-  for (size_t ichild = 0; ichild < module_manager.configurable_children(top_module).size(); ++ichild) {
+  for (size_t ichild = 0; ichild < configurable_children.size(); ++ichild) {
     if (true == create_region) {
       curr_region = module_manager.add_config_region(top_module);
     }
@@ -250,8 +380,8 @@ void build_top_module_configurable_regions(ModuleManager& module_manager,
     /* Add the child to a region */
     module_manager.add_configurable_child_to_region(top_module,
                                                     curr_region,
-                                                    module_manager.configurable_children(top_module)[ichild],
-                                                    module_manager.configurable_child_instances(top_module)[ichild],
+                                                    configurable_children[ichild],
+                                                    configurable_child_instances[ichild],
                                                     ichild);
 
     /* See if the current region is full or not:
@@ -464,7 +594,7 @@ void organize_top_module_memory_modules(ModuleManager& module_manager,
   }
 
   /* Split memory modules into different regions */
-  build_top_module_configurable_regions(module_manager, top_module, config_protocol);  
+  build_top_module_configurable_regions(module_manager, top_module, circuit_lib, config_protocol);  
 }
 
 
@@ -483,6 +613,7 @@ void organize_top_module_memory_modules(ModuleManager& module_manager,
  ********************************************************************/
 void shuffle_top_module_configurable_children(ModuleManager& module_manager, 
                                               const ModuleId& top_module,
+                                              const CircuitLibrary& circuit_lib,
                                               const ConfigProtocol& config_protocol) {
   size_t num_keys = module_manager.configurable_children(top_module).size();
   std::vector<size_t> shuffled_keys;
@@ -493,22 +624,14 @@ void shuffle_top_module_configurable_children(ModuleManager& module_manager,
 
   std::random_shuffle(shuffled_keys.begin(), shuffled_keys.end());
 
-  /* Cache the configurable children and their instances */
-  std::vector<ModuleId> orig_configurable_children = module_manager.configurable_children(top_module);
-  std::vector<size_t> orig_configurable_child_instances = module_manager.configurable_child_instances(top_module);
- 
-  /* Reorganize the configurable children */
-  module_manager.clear_configurable_children(top_module);
-
-  for (size_t ikey = 0; ikey < num_keys; ++ikey) {
-    module_manager.add_configurable_child(top_module,
-                                          orig_configurable_children[shuffled_keys[ikey]],
-                                          orig_configurable_child_instances[shuffled_keys[ikey]]);
-  }
-
-  /* Reset configurable regions */
+  /* Reorganize the configurable children in place,
+   * the regions have to be reset as they are built on the ids of configurable children
+   */
   module_manager.clear_config_region(top_module);
-  build_top_module_configurable_regions(module_manager, top_module, config_protocol);  
+  module_manager.permute_configurable_children(top_module, shuffled_keys);
+
+  /* Rebuild configurable regions */
+  build_top_module_configurable_regions(module_manager, top_module, circuit_lib, config_protocol);  
 }
 
 /********************************************************************
@@ -528,6 +651,29 @@ int load_top_module_memory_modules_from_fabric_key(ModuleManager& module_manager
                                                    const FabricKey& fabric_key) {
   /* Ensure a clean start */
   module_manager.clear_configurable_children(top_module);
+  module_manager.reserve_configurable_child(top_module, fabric_key.keys().size());
+
+  /* Keys with an alias but without a name have to be searched among all the child instances.
+   * Index the instance names of the top module once for all, rather than searching for each key.
+   * The first child module and the smallest instance id take an instance name, which is the same
+   * as find_module_manager_instance_module_info()
+   */
+  std::unordered_map<std::string, std::pair<ModuleId, size_t>> instance_alias_index;
+  for (const FabricKeyId& key : fabric_key.keys()) {
+    if ( (!fabric_key.key_alias(key).empty())
+      && (fabric_key.key_name(key).empty()) ) {
+      for (const ModuleId& child : module_manager.child_modules(top_module)) {
+        for (const size_t& child_instance : module_manager.child_module_instances(top_module, child)) {
+          instance_alias_index.emplace(module_manager.instance_name(top_module, child, child_instance),
+                                       std::make_pair(child, child_instance));
+        }
+      }
+      break;
+    }
+  }
+
+  /* Number of configuration bits of the child modules, which are found once per module */
+  std::unordered_map<ModuleId, size_t> child_num_config_bits;
 
   size_t curr_configurable_child_id = 0;
 
@@ -540,13 +686,16 @@ int load_top_module_memory_modules_from_fabric_key(ModuleManager& module_manager
       /* If we have an alias, we try to find a instance in this name */
       if (!fabric_key.key_alias(key).empty()) {
         /* If we have the key, we can quickly spot instance id.
-         * Otherwise, we have to exhaustively find the module id and instance id
+         * Otherwise, we find the module id and instance id in the index
          */
         if (!fabric_key.key_name(key).empty()) {
           instance_info.first = module_manager.find_module(fabric_key.key_name(key));
           instance_info.second = module_manager.instance_id(top_module, instance_info.first, fabric_key.key_alias(key));
         } else {
-          instance_info = find_module_manager_instance_module_info(module_manager, top_module, fabric_key.key_alias(key)); 
+          auto alias_result = instance_alias_index.find(fabric_key.key_alias(key));
+          if (alias_result != instance_alias_index.end()) {
+            instance_info = alias_result->second;
+          }
         }
       } else { 
         /* If we do not have an alias, we use the name and value to build the info deck */
@@ -577,9 +726,14 @@ int load_top_module_memory_modules_from_fabric_key(ModuleManager& module_manager
       }
 
       /* If the the child has not configuration bits, error out */
-      if (0 == find_module_num_config_bits(module_manager, instance_info.first,
-                                           circuit_lib, config_protocol.memory_model(), 
-                                           config_protocol.type())) {
+      auto num_config_bits_result = child_num_config_bits.find(instance_info.first);
+      if (num_config_bits_result == child_num_config_bits.end()) {
+        num_config_bits_result = child_num_config_bits.emplace(instance_info.first,
+                                                               find_module_num_config_bits(module_manager, instance_info.first,
+                                                                                           circuit_lib, config_protocol.memory_model(), 
+                                                                                           config_protocol.type())).first;
+      }
+      if (0 == num_config_bits_result->second) {
         if (!fabric_key.key_alias(key).empty()) {
           VTR_LOG_ERROR("Invalid key alias '%s' which has zero configuration bits!\n",
                         fabric_key.key_alias(key).c_str()); 
@@ -677,6 +831,9 @@ vtr::vector<ConfigRegionId, size_t> find_top_module_regional_num_config_bit(cons
  *    IMPORTANT: the port size will be limited by the number of configurable regions
  * 3. Memory decoders:
  *    use the suggested port_size 
+ * 4. Frame-based memory:
+ *    the data input has a group of bits per configurable region,
+ *    as many as the bits loaded per frame
  ********************************************************************/
 static 
 size_t generate_top_module_sram_port_size(const ConfigProtocol& config_protocol,
@@ -688,10 +845,12 @@ size_t generate_top_module_sram_port_size(const ConfigProtocol& config_protocol,
     break;
   case CONFIG_MEM_SCAN_CHAIN: 
   case CONFIG_MEM_MEMORY_BANK:
-  case CONFIG_MEM_FRAME_BASED:
     /* CCFF head/tail, data input could be multi-bit ports */
     sram_port_size = config_protocol.num_regions();
     break;
+  case CONFIG_MEM_FRAME_BASED:
+    sram_port_size = config_protocol.num_regions() * config_protocol.frame_data_width();
+    break;
   default:
     VTR_LOGF_ERROR(__FILE__, __LINE__,
                    "Invalid type of SRAM organization!\n");
@@ -713,16 +872,20 @@ size_t generate_top_module_sram_port_size(const ConfigProtocol& config_protocol,
  *    and the tail of scan-chain
  *    IMPORTANT: the port size will be forced to 1 in this case 
  *               because the head and tail are both 1-bit ports!!!
+ *    When the bitstreams are run-length compressed, a run length port,
+ *    a reset port and a clock port of the decompressors are added as well
  * 3. Memory decoders:
  *    - An enable signal
- *    - A BL address port
+ *    - A BL address port, or a clock port of the BL shift registers
+ *      when the BLs are driven by shift registers
  *    - A WL address port
  *    - A data-in port for the BL decoder
  * 4. Frame-based memory:
  *    - An Enable signal
  *    - An address port, whose size depends on the number of config bits 
  *      and the maximum size of address ports of configurable children
- *    - An data_in port (single-bit)
+ *    - An data_in port, whose bits [i * W : (i + 1) * W - 1] are loaded
+ *      to the configurable region i, where W is the number of bits per frame
  ********************************************************************/
 void add_top_module_sram_ports(ModuleManager& module_manager, 
                                const ModuleId& module_id,
@@ -751,13 +914,20 @@ void add_top_module_sram_ports(ModuleManager& module_manager,
     BasicPort en_port(std::string(DECODER_ENABLE_PORT_NAME), 1);
     module_manager.add_port(module_id, en_port, ModuleManager::MODULE_INPUT_PORT);
 
-    /* BL address size is the largest among all the regions */
-    size_t bl_addr_size = 0;
-    for (const ConfigRegionId& config_region : module_manager.regions(module_id)) {
-       bl_addr_size = std::max(bl_addr_size, find_memory_decoder_addr_size(num_config_bits[config_region]));
+    if (BLWL_PROTOCOL_SHIFT_REGISTER == config_protocol.bl_protocol_type()) {
+      /* BL shift registers are not addressed but clocked */
+      BasicPort bl_sr_clk_port(std::string(BL_SHIFT_REGISTER_CLOCK_PORT_NAME), 1);
+      module_manager.add_port(module_id, bl_sr_clk_port, ModuleManager::MODULE_INPUT_PORT);
+    } else {
+      VTR_ASSERT(BLWL_PROTOCOL_DECODER == config_protocol.bl_protocol_type());
+      /* BL address size is the largest among all the regions */
+      size_t bl_addr_size = 0;
+      for (const ConfigRegionId& config_region : module_manager.regions(module_id)) {
+         bl_addr_size = std::max(bl_addr_size, find_memory_decoder_addr_size(num_config_bits[config_region]));
+      }
+      BasicPort bl_addr_port(std::string(DECODER_BL_ADDRESS_PORT_NAME), bl_addr_size);
+      module_manager.add_port(module_id, bl_addr_port, ModuleManager::MODULE_INPUT_PORT);
     }
-    BasicPort bl_addr_port(std::string(DECODER_BL_ADDRESS_PORT_NAME), bl_addr_size);
-    module_manager.add_port(module_id, bl_addr_port, ModuleManager::MODULE_INPUT_PORT);
 
     /* WL address size is the largest among all the regions */
     size_t wl_addr_size = 0;
@@ -791,6 +961,18 @@ void add_top_module_sram_ports(ModuleManager& module_manager,
       }
       port_counter++;
     }
+
+    /* The run lengths are shared by the decompressors of all the regions,
+     * while each region has its own bit value on the chain head
+     */
+    if (CONFIG_CHAIN_COMPRESSION_RUN_LENGTH == config_protocol.chain_compression_type()) {
+      BasicPort run_length_port(std::string(CONFIG_CHAIN_RUN_LENGTH_PORT_NAME), config_protocol.run_length_width());
+      module_manager.add_port(module_id, run_length_port, ModuleManager::MODULE_INPUT_PORT);
+      BasicPort rle_reset_port(std::string(CONFIG_CHAIN_DECOMPRESSOR_RESET_PORT_NAME), 1);
+      module_manager.add_port(module_id, rle_reset_port, ModuleManager::MODULE_INPUT_PORT);
+      BasicPort rle_clk_port(std::string(CONFIG_CHAIN_DECOMPRESSOR_CLOCK_PORT_NAME), 1);
+      module_manager.add_port(module_id, rle_clk_port, ModuleManager::MODULE_INPUT_PORT);
+    }
     break;
   }
   case CONFIG_MEM_FRAME_BASED: { 
@@ -905,12 +1087,21 @@ void add_top_module_sram_ports(ModuleManager& module_manager,
  *  data_in ---->|         |  WL[0]          WL[1]              WL[i]
  *               +---------+
  *
+ * When the BLs are driven by shift registers, the Bit Line Decoder of each
+ * memory bank is replaced by a shift register, whose data_in is the same
+ * as the BL decoder's and whose clock is the BL shift register clock of
+ * the top module. There is no BL address, and the enable signal only drives
+ * the WL decoders. A WL of memory cells is written when its WL is enabled
+ *
  **********************************************************************/
 static 
 void add_top_module_nets_cmos_memory_bank_config_bus(ModuleManager& module_manager,
                                                      DecoderLibrary& decoder_lib,
                                                      const ModuleId& top_module,
+                                                     const ConfigProtocol& config_protocol,
                                                      const vtr::vector<ConfigRegionId, size_t>& num_config_bits) {
+  bool use_bl_shift_register = (BLWL_PROTOCOL_SHIFT_REGISTER == config_protocol.bl_protocol_type());
+
   /* Find Enable port from the top-level module */ 
   ModulePortId en_port = module_manager.find_module_port(top_module, std::string(DECODER_ENABLE_PORT_NAME));
   BasicPort en_port_info = module_manager.module_port(top_module, en_port);
@@ -922,15 +1113,22 @@ void add_top_module_nets_cmos_memory_bank_config_bus(ModuleManager& module_manag
   /* Data in port should match the number of configuration regions */
   VTR_ASSERT(din_port_info.get_width() == module_manager.regions(top_module).size());
 
-  /* Find BL and WL address port from the top-level module */ 
-  ModulePortId bl_addr_port = module_manager.find_module_port(top_module, std::string(DECODER_BL_ADDRESS_PORT_NAME));
-  BasicPort bl_addr_port_info = module_manager.module_port(top_module, bl_addr_port);
+  /* Find BL address port (or BL shift register clock port) and WL address port from the top-level module */ 
+  ModulePortId bl_addr_port = ModulePortId::INVALID();
+  ModulePortId bl_sr_clk_port = ModulePortId::INVALID();
+  size_t bl_addr_size = 0;
+  if (true == use_bl_shift_register) {
+    bl_sr_clk_port = module_manager.find_module_port(top_module, std::string(BL_SHIFT_REGISTER_CLOCK_PORT_NAME));
+    VTR_ASSERT(true == module_manager.valid_module_port_id(top_module, bl_sr_clk_port));
+  } else {
+    bl_addr_port = module_manager.find_module_port(top_module, std::string(DECODER_BL_ADDRESS_PORT_NAME));
+    bl_addr_size = module_manager.module_port(top_module, bl_addr_port).get_width();
+  }
 
   ModulePortId wl_addr_port = module_manager.find_module_port(top_module, std::string(DECODER_WL_ADDRESS_PORT_NAME));
   BasicPort wl_addr_port_info = module_manager.module_port(top_module, wl_addr_port);
 
-  /* Find the top-level number of BLs and WLs required to access each memory bit */
-  size_t bl_addr_size = bl_addr_port_info.get_width();
+  /* Find the top-level number of WLs required to access each memory bit */
   size_t wl_addr_size = wl_addr_port_info.get_width();
 
   /* Each memory bank has a unified number of BL/WLs */
@@ -947,28 +1145,39 @@ void add_top_module_nets_cmos_memory_bank_config_bus(ModuleManager& module_manag
   /* Create separated memory bank circuitry, i.e., BL/WL decoders for each region */
   for (const ConfigRegionId& config_region : module_manager.regions(top_module)) {
     /************************************************************** 
-     * Add the BL decoder module 
+     * Add the BL decoder module, or the BL shift register module
      * Search the decoder library
      * If we find one, we use the module.
      * Otherwise, we create one and add it to the decoder library
      */
-    DecoderId bl_decoder_id = decoder_lib.find_decoder(bl_addr_size, num_bls,
-                                                       true, true, false);
-    if (DecoderId::INVALID() == bl_decoder_id) {
-      bl_decoder_id = decoder_lib.add_decoder(bl_addr_size, num_bls, true, true, false);
-    }
-    VTR_ASSERT(DecoderId::INVALID() != bl_decoder_id);
-
-    /* Create a module if not existed yet */
-    std::string bl_decoder_module_name = generate_memory_decoder_with_data_in_subckt_name(bl_addr_size, num_bls);
-    ModuleId bl_decoder_module = module_manager.find_module(bl_decoder_module_name);
-    if (ModuleId::INVALID() == bl_decoder_module) {
-      /* BL decoder has the same ports as the frame-based decoders
-       * We reuse it here
-       */
-      bl_decoder_module = build_bl_memory_decoder_module(module_manager,
-                                                         decoder_lib,
-                                                         bl_decoder_id);
+    ModuleId bl_decoder_module = ModuleId::INVALID();
+    if (true == use_bl_shift_register) {
+      if (false == decoder_lib.find_shift_register(num_bls)) {
+        decoder_lib.add_shift_register(num_bls);
+      }
+      bl_decoder_module = module_manager.find_module(generate_bl_shift_register_subckt_name(num_bls));
+      if (ModuleId::INVALID() == bl_decoder_module) {
+        bl_decoder_module = build_bl_shift_register_module(module_manager, num_bls);
+      }
+    } else {
+      DecoderId bl_decoder_id = decoder_lib.find_decoder(bl_addr_size, num_bls,
+                                                         true, true, false);
+      if (DecoderId::INVALID() == bl_decoder_id) {
+        bl_decoder_id = decoder_lib.add_decoder(bl_addr_size, num_bls, true, true, false);
+      }
+      VTR_ASSERT(DecoderId::INVALID() != bl_decoder_id);
+
+      /* Create a module if not existed yet */
+      std::string bl_decoder_module_name = generate_memory_decoder_with_data_in_subckt_name(bl_addr_size, num_bls);
+      bl_decoder_module = module_manager.find_module(bl_decoder_module_name);
+      if (ModuleId::INVALID() == bl_decoder_module) {
+        /* BL decoder has the same ports as the frame-based decoders
+         * We reuse it here
+         */
+        bl_decoder_module = build_bl_memory_decoder_module(module_manager,
+                                                           decoder_lib,
+                                                           bl_decoder_id);
+      }
     }
     VTR_ASSERT(ModuleId::INVALID() != bl_decoder_module);
     size_t curr_bl_decoder_instance_id = module_manager.num_instance(top_module, bl_decoder_module);
@@ -1005,29 +1214,36 @@ void add_top_module_nets_cmos_memory_bank_config_bus(ModuleManager& module_manag
     /************************************************************** 
      * Add module nets from the top module to BL decoder's inputs
      */
-    ModulePortId bl_decoder_en_port = module_manager.find_module_port(bl_decoder_module, std::string(DECODER_ENABLE_PORT_NAME));
-    BasicPort bl_decoder_en_port_info = module_manager.module_port(bl_decoder_module, bl_decoder_en_port);
-
-    ModulePortId bl_decoder_addr_port = module_manager.find_module_port(bl_decoder_module, std::string(DECODER_ADDRESS_PORT_NAME));
-    BasicPort bl_decoder_addr_port_info = module_manager.module_port(bl_decoder_module, bl_decoder_addr_port);
-
     ModulePortId bl_decoder_din_port = module_manager.find_module_port(bl_decoder_module, std::string(DECODER_DATA_IN_PORT_NAME));
     BasicPort bl_decoder_din_port_info = module_manager.module_port(bl_decoder_module, bl_decoder_din_port);
 
     /* Data in port of the local BL decoder should always be 1 */
     VTR_ASSERT(1 == bl_decoder_din_port_info.get_width());
 
-    /* Top module Enable port -> BL Decoder Enable port */
-    add_module_bus_nets(module_manager,
-                        top_module,
-                        top_module, 0, en_port,
-                        bl_decoder_module, curr_bl_decoder_instance_id, bl_decoder_en_port);
+    if (true == use_bl_shift_register) {
+      ModulePortId bl_sr_clk_child_port = module_manager.find_module_port(bl_decoder_module, std::string(BL_SHIFT_REGISTER_CLOCK_PORT_NAME));
 
-    /* Top module Address port -> BL Decoder Address port */
-    add_module_bus_nets(module_manager,
-                        top_module,
-                        top_module, 0, bl_addr_port,
-                        bl_decoder_module, curr_bl_decoder_instance_id, bl_decoder_addr_port);
+      /* Top module BL shift register clock port -> BL shift register clock port */
+      add_module_bus_nets(module_manager,
+                          top_module,
+                          top_module, 0, bl_sr_clk_port,
+                          bl_decoder_module, curr_bl_decoder_instance_id, bl_sr_clk_child_port);
+    } else {
+      ModulePortId bl_decoder_en_port = module_manager.find_module_port(bl_decoder_module, std::string(DECODER_ENABLE_PORT_NAME));
+      ModulePortId bl_decoder_addr_port = module_manager.find_module_port(bl_decoder_module, std::string(DECODER_ADDRESS_PORT_NAME));
+
+      /* Top module Enable port -> BL Decoder Enable port */
+      add_module_bus_nets(module_manager,
+                          top_module,
+                          top_module, 0, en_port,
+                          bl_decoder_module, curr_bl_decoder_instance_id, bl_decoder_en_port);
+
+      /* Top module Address port -> BL Decoder Address port */
+      add_module_bus_nets(module_manager,
+                          top_module,
+                          top_module, 0, bl_addr_port,
+                          bl_decoder_module, curr_bl_decoder_instance_id, bl_decoder_addr_port);
+    }
 
     /* Top module data_in port -> BL Decoder data_in port:
      * Note that each region has independent data_in connection from the top-level module 
@@ -1049,7 +1265,6 @@ void add_top_module_nets_cmos_memory_bank_config_bus(ModuleManager& module_manag
     BasicPort wl_decoder_en_port_info = module_manager.module_port(wl_decoder_module, wl_decoder_en_port);
 
     ModulePortId wl_decoder_addr_port = module_manager.find_module_port(wl_decoder_module, std::string(DECODER_ADDRESS_PORT_NAME));
-    BasicPort wl_decoder_addr_port_info = module_manager.module_port(wl_decoder_module, bl_decoder_addr_port);
 
     /* Top module Enable port -> WL Decoder Enable port */
     add_module_bus_nets(module_manager,
@@ -1079,28 +1294,24 @@ void add_top_module_nets_cmos_memory_bank_config_bus(ModuleManager& module_manag
       ModulePortId child_bl_port = module_manager.find_module_port(child_module, std::string(MEMORY_BL_PORT_NAME));
       BasicPort child_bl_port_info = module_manager.module_port(child_module, child_bl_port);
 
-      for (const size_t& sink_bl_pin : child_bl_port_info.pins()) {
+      std::vector<size_t> src_bl_pins;
+      src_bl_pins.reserve(child_bl_port_info.get_width());
+      for (size_t isink = 0; isink < child_bl_port_info.get_width(); ++isink) {
         /* Find the BL decoder data index: 
          * It should be the residual when divided by the number of BLs
          */
         size_t bl_pin_id = std::floor(cur_bl_index / num_bls);
-        if (!(bl_pin_id < bl_decoder_dout_port_info.pins().size()))
-          VTR_ASSERT(bl_pin_id < bl_decoder_dout_port_info.pins().size());
-
-        /* Create net */
-        ModuleNetId net = create_module_source_pin_net(module_manager, top_module,
-                                                       bl_decoder_module, curr_bl_decoder_instance_id,
-                                                       bl_decoder_dout_port,
-                                                       bl_decoder_dout_port_info.pins()[bl_pin_id]);
-        VTR_ASSERT(ModuleNetId::INVALID() != net);
-
-        /* Add net sink */
-        module_manager.add_module_net_sink(top_module, net,
-                                           child_module, child_instance, child_bl_port, sink_bl_pin);
+        VTR_ASSERT(bl_pin_id < bl_decoder_dout_port_info.pins().size());
+        src_bl_pins.push_back(bl_decoder_dout_port_info.pins()[bl_pin_id]);
 
         /* Increment the BL index */
         cur_bl_index++;
       }
+
+      /* Create nets from the BL decoder data out to the BL port */
+      module_manager.add_module_nets_between_pins(top_module,
+                                                  bl_decoder_module, curr_bl_decoder_instance_id, bl_decoder_dout_port, src_bl_pins,
+                                                  child_module, child_instance, child_bl_port, child_bl_port_info.pins());
     }
 
     /************************************************************** 
@@ -1119,26 +1330,23 @@ void add_top_module_nets_cmos_memory_bank_config_bus(ModuleManager& module_manag
       ModulePortId child_wl_port = module_manager.find_module_port(child_module, std::string(MEMORY_WL_PORT_NAME));
       BasicPort child_wl_port_info = module_manager.module_port(child_module, child_wl_port);
 
-      for (const size_t& sink_wl_pin : child_wl_port_info.pins()) {
+      std::vector<size_t> src_wl_pins;
+      src_wl_pins.reserve(child_wl_port_info.get_width());
+      for (size_t isink = 0; isink < child_wl_port_info.get_width(); ++isink) {
         /* Find the BL decoder data index: 
          * It should be the residual when divided by the number of BLs
          */
         size_t wl_pin_id = cur_wl_index % num_wls;
-
-        /* Create net */
-        ModuleNetId net = create_module_source_pin_net(module_manager, top_module,
-                                                       wl_decoder_module, curr_wl_decoder_instance_id,
-                                                       wl_decoder_dout_port,
-                                                       wl_decoder_dout_port_info.pins()[wl_pin_id]);
-        VTR_ASSERT(ModuleNetId::INVALID() != net);
-
-        /* Add net sink */
-        module_manager.add_module_net_sink(top_module, net,
-                                           child_module, child_instance, child_wl_port, sink_wl_pin);
+        src_wl_pins.push_back(wl_decoder_dout_port_info.pins()[wl_pin_id]);
 
         /* Increment the WL index */
         cur_wl_index++;
       }
+
+      /* Create nets from the WL decoder data out to the WL port */
+      module_manager.add_module_nets_between_pins(top_module,
+                                                  wl_decoder_module, curr_wl_decoder_instance_id, wl_decoder_dout_port, src_wl_pins,
+                                                  child_module, child_instance, child_wl_port, child_wl_port_info.pins());
     }
 
     /************************************************************** 
@@ -1185,12 +1393,69 @@ void add_top_module_nets_cmos_memory_bank_config_bus(ModuleManager& module_manag
  *  For the rest of memory modules:
  *    net source is the configuration chain tail of the previous memory module
  *    net sink is the configuration chain head of the next memory module
+ *
+ *  When the bitstreams are run-length compressed, a decompressor is
+ *  inserted between the configuration chain head of each region
+ *  and its 1st memory module. All the decompressors share the run length,
+ *  the reset and the clock ports of the top module
+ *
+ *                     ccff_run_length
+ *                           |
+ *                           v
+ *                   +--------------+    +--------+
+ *  ccff_head[0] --->| Decompressor |--->| Memory |---> ...
+ *                   +--------------+    | Module |
+ *                                       |   [0]  |
+ *                                       +--------+
  *********************************************************************/
 static 
 void add_top_module_nets_cmos_memory_chain_config_bus(ModuleManager& module_manager,
+                                                      DecoderLibrary& decoder_lib,
                                                       const ModuleId& parent_module,
                                                       const ConfigProtocol& config_protocol) {
+  bool use_decompressor = (CONFIG_CHAIN_COMPRESSION_RUN_LENGTH == config_protocol.chain_compression_type());
+
+  ModuleId decompressor_module = ModuleId::INVALID();
+  if (true == use_decompressor) {
+    if (false == decoder_lib.find_decompressor(config_protocol.run_length_width())) {
+      decoder_lib.add_decompressor(config_protocol.run_length_width());
+    }
+    decompressor_module = module_manager.find_module(generate_config_chain_decompressor_subckt_name(config_protocol.run_length_width()));
+    if (ModuleId::INVALID() == decompressor_module) {
+      decompressor_module = build_config_chain_decompressor_module(module_manager, config_protocol.run_length_width());
+    }
+    VTR_ASSERT(ModuleId::INVALID() != decompressor_module);
+  }
+
   for (const ConfigRegionId& config_region : module_manager.regions(parent_module)) {
+    /* Instanciate the decompressor of the region */
+    size_t decompressor_instance_id = 0;
+    if (true == use_decompressor) {
+      decompressor_instance_id = module_manager.num_instance(parent_module, decompressor_module);
+      module_manager.add_child_module(parent_module, decompressor_module);
+
+      /* Top module run length, reset and clock ports -> decompressor ports */
+      for (const std::string& port_name : {std::string(CONFIG_CHAIN_RUN_LENGTH_PORT_NAME),
+                                           std::string(CONFIG_CHAIN_DECOMPRESSOR_RESET_PORT_NAME),
+                                           std::string(CONFIG_CHAIN_DECOMPRESSOR_CLOCK_PORT_NAME)}) {
+        add_module_bus_nets(module_manager,
+                            parent_module,
+                            parent_module, 0, module_manager.find_module_port(parent_module, port_name),
+                            decompressor_module, decompressor_instance_id, module_manager.find_module_port(decompressor_module, port_name));
+      }
+
+      /* Top module configuration chain head -> decompressor data input */
+      std::string head_port_name = generate_sram_port_name(config_protocol.type(), CIRCUIT_MODEL_PORT_INPUT);
+      ModulePortId head_port_id = module_manager.find_module_port(parent_module, head_port_name); 
+      BasicPort head_port = module_manager.module_port(parent_module, head_port_id); 
+      VTR_ASSERT(size_t(config_region) < head_port.get_width());
+      ModuleNetId din_net = create_module_source_pin_net(module_manager, parent_module,
+                                                         parent_module, 0,
+                                                         head_port_id, head_port.pins()[size_t(config_region)]);
+      ModulePortId din_port_id = module_manager.find_module_port(decompressor_module, std::string(DECODER_DATA_IN_PORT_NAME));
+      module_manager.add_module_net_sink(parent_module, din_net, decompressor_module, decompressor_instance_id, din_port_id, 0);
+    }
+
     for (size_t mem_index = 0; mem_index < module_manager.region_configurable_children(parent_module, config_region).size(); ++mem_index) {
       ModuleId net_src_module_id;
       size_t net_src_instance_id;
@@ -1202,7 +1467,20 @@ void add_top_module_nets_cmos_memory_chain_config_bus(ModuleManager& module_mana
       ModulePortId net_sink_port_id;
       size_t net_sink_pin_id;
 
-      if (0 == mem_index) {
+      if ((0 == mem_index) && (true == use_decompressor)) {
+        /* The data output of the decompressor drives the chain */
+        net_src_module_id = decompressor_module; 
+        net_src_instance_id = decompressor_instance_id;
+        net_src_port_id = module_manager.find_module_port(net_src_module_id, std::string(DECODER_DATA_OUT_PORT_NAME)); 
+        net_src_pin_id = 0;
+
+        /* Find the port name of next memory module */
+        std::string sink_port_name = generate_configuration_chain_head_name();
+        net_sink_module_id = module_manager.region_configurable_children(parent_module, config_region)[mem_index]; 
+        net_sink_instance_id = module_manager.region_configurable_child_instances(parent_module, config_region)[mem_index];
+        net_sink_port_id = module_manager.find_module_port(net_sink_module_id, sink_port_name); 
+        net_sink_pin_id = 0;
+      } else if (0 == mem_index) {
         /* Find the port name of configuration chain head */
         std::string src_port_name = generate_sram_port_name(config_protocol.type(), CIRCUIT_MODEL_PORT_INPUT);
         net_src_module_id = parent_module; 
@@ -1339,18 +1617,20 @@ void add_top_module_nets_cmos_memory_frame_short_config_bus(ModuleManager& modul
   BasicPort child_din_port_info = module_manager.module_port(child_module, child_din_port);
 
   /* Ensure pin indices are in range! */
-  VTR_ASSERT(size_t(config_region) < parent_din_port_info.get_width());
-  VTR_ASSERT(1 == child_din_port_info.get_width());
-
-  /* Create a net for the Din[config_region] pin */
-  ModuleNetId din_net = create_module_source_pin_net(module_manager, top_module, 
-                                                     top_module, 0, 
-                                                     parent_din_port,
-                                                     parent_din_port_info.pins()[size_t(config_region)]);
-  VTR_ASSERT(ModuleNetId::INVALID() != din_net);
-
-  /* Configure the net sink */
-  module_manager.add_module_net_sink(top_module, din_net, child_module, child_instance, child_din_port, child_din_port_info.pins()[0]);
+  size_t frame_data_width = child_din_port_info.get_width();
+  VTR_ASSERT((size_t(config_region) + 1) * frame_data_width <= parent_din_port_info.get_width());
+
+  for (size_t ipin = 0; ipin < frame_data_width; ++ipin) {
+    /* Create a net for the Din[config_region * W + ipin] pin */
+    ModuleNetId din_net = create_module_source_pin_net(module_manager, top_module, 
+                                                       top_module, 0, 
+                                                       parent_din_port,
+                                                       parent_din_port_info.pins()[size_t(config_region) * frame_data_width + ipin]);
+    VTR_ASSERT(ModuleNetId::INVALID() != din_net);
+
+    /* Configure the net sink */
+    module_manager.add_module_net_sink(top_module, din_net, child_module, child_instance, child_din_port, child_din_port_info.pins()[ipin]);
+  }
 }
 
 /********************************************************************
@@ -1514,18 +1794,20 @@ void add_top_module_nets_cmos_memory_frame_decoder_config_bus(ModuleManager& mod
     BasicPort child_din_port_info = module_manager.module_port(child_module, child_din_port);
 
     /* Ensure pin indices are in range! */
-    VTR_ASSERT(size_t(config_region) < parent_din_port_info.get_width());
-    VTR_ASSERT(1 == child_din_port_info.get_width());
+    size_t frame_data_width = child_din_port_info.get_width();
+    VTR_ASSERT((size_t(config_region) + 1) * frame_data_width <= parent_din_port_info.get_width());
 
-    /* Create a net for the Din[config_region] pin */
-    ModuleNetId din_net = create_module_source_pin_net(module_manager, parent_module, 
-                                                       parent_module, 0, 
-                                                       parent_din_port,
-                                                       parent_din_port_info.pins()[size_t(config_region)]);
-    VTR_ASSERT(ModuleNetId::INVALID() != din_net);
+    for (size_t ipin = 0; ipin < frame_data_width; ++ipin) {
+      /* Create a net for the Din[config_region * W + ipin] pin */
+      ModuleNetId din_net = create_module_source_pin_net(module_manager, parent_module, 
+                                                         parent_module, 0, 
+                                                         parent_din_port,
+                                                         parent_din_port_info.pins()[size_t(config_region) * frame_data_width + ipin]);
+      VTR_ASSERT(ModuleNetId::INVALID() != din_net);
 
-    /* Configure the net sink */
-    module_manager.add_module_net_sink(parent_module, din_net, child_module, child_instance, child_din_port, child_din_port_info.pins()[0]);
+      /* Configure the net sink */
+      module_manager.add_module_net_sink(parent_module, din_net, child_module, child_instance, child_din_port, child_din_port_info.pins()[ipin]);
+    }
   }
 
   /* Connect the data_out port of the decoder module 
@@ -1664,11 +1946,11 @@ void add_top_module_nets_cmos_memory_config_bus(ModuleManager& module_manager,
                                                    config_protocol.type(), CIRCUIT_MODEL_PORT_WL);
     break;
   case CONFIG_MEM_SCAN_CHAIN: {
-    add_top_module_nets_cmos_memory_chain_config_bus(module_manager, parent_module, config_protocol);
+    add_top_module_nets_cmos_memory_chain_config_bus(module_manager, decoder_lib, parent_module, config_protocol);
     break;
   }
   case CONFIG_MEM_MEMORY_BANK:
-    add_top_module_nets_cmos_memory_bank_config_bus(module_manager, decoder_lib, parent_module, num_config_bits);
+    add_top_module_nets_cmos_memory_bank_config_bus(module_manager, decoder_lib, parent_module, config_protocol, num_config_bits);
     break;
   case CONFIG_MEM_FRAME_BASED:
     add_top_module_nets_cmos_memory_frame_config_bus(module_manager, decoder_lib, parent_module, num_config_bits);
@@ -0,0 +1,243 @@
+/************************************************************************
+ * Member functions for class DeviceRRGSBModulePorts
+ ***********************************************************************/
+#include "vtr_assert.h"
+
+#include "device_rr_gsb_module_ports.h"
+
+/* namespace openfpga begins */
+namespace openfpga {
+
+/************************************************************************
+ * Constructors
+ ***********************************************************************/
+DeviceRRGSBModulePorts::DeviceRRGSBModulePorts() {
+  return;
+}
+
+/************************************************************************
+ * Public Accessors
+ ***********************************************************************/
+bool DeviceRRGSBModulePorts::has_sb_module_ports(const RRGSB& rr_gsb) const {
+  if (false == valid_gsb_coordinate(rr_gsb)) {
+    return false;
+  }
+  return sb_module_ports_[rr_gsb.get_x()][rr_gsb.get_y()].valid;
+}
+
+ModulePinInfo DeviceRRGSBModulePorts::sb_chan_port(const RRGSB& rr_gsb,
+                                                   const e_side& side,
+                                                   const size_t& track_id) const {
+  const SbModulePorts& module_ports = sb_module_ports(rr_gsb);
+  VTR_ASSERT(track_id < module_ports.chan_ports[size_t(side)].size());
+  return module_ports.chan_ports[size_t(side)][track_id];
+}
+
+ModulePortId DeviceRRGSBModulePorts::sb_opin_port(const RRGSB& rr_gsb,
+                                                  const e_side& side,
+                                                  const size_t& node_id) const {
+  const SbModulePorts& module_ports = sb_module_ports(rr_gsb);
+  VTR_ASSERT(node_id < module_ports.opin_ports[size_t(side)].size());
+  return module_ports.opin_ports[size_t(side)][node_id];
+}
+
+const std::vector<ModulePinInfo>& DeviceRRGSBModulePorts::sb_chan_driver_ports(const RRGSB& rr_gsb,
+                                                                               const e_side& side,
+                                                                               const size_t& track_id) const {
+  const SbModulePorts& module_ports = sb_module_ports(rr_gsb);
+  VTR_ASSERT(track_id < module_ports.chan_driver_ports[size_t(side)].size());
+  return module_ports.chan_driver_ports[size_t(side)][track_id];
+}
+
+bool DeviceRRGSBModulePorts::has_cb_module_ports(const t_rr_type& cb_type,
+                                                 const RRGSB& rr_gsb) const {
+  if (false == valid_gsb_coordinate(rr_gsb)) {
+    return false;
+  }
+  return cb_module_ports(cb_type, rr_gsb).valid;
+}
+
+ModulePinInfo DeviceRRGSBModulePorts::cb_chan_port(const t_rr_type& cb_type,
+                                                   const RRGSB& rr_gsb,
+                                                   const size_t& track_id,
+                                                   const PORTS& port_direction) const {
+  VTR_ASSERT(true == has_cb_module_ports(cb_type, rr_gsb));
+  const CbModulePorts& module_ports = cb_module_ports(cb_type, rr_gsb);
+  VTR_ASSERT(track_id < module_ports.chan_input_ports.size());
+  if (IN_PORT == port_direction) {
+    return module_ports.chan_input_ports[track_id];
+  }
+  VTR_ASSERT(OUT_PORT == port_direction);
+  return module_ports.chan_output_ports[track_id];
+}
+
+ModulePortId DeviceRRGSBModulePorts::cb_ipin_port(const t_rr_type& cb_type,
+                                                  const RRGSB& rr_gsb,
+                                                  const e_side& side,
+                                                  const size_t& node_id) const {
+  VTR_ASSERT(true == has_cb_module_ports(cb_type, rr_gsb));
+  const CbModulePorts& module_ports = cb_module_ports(cb_type, rr_gsb);
+  VTR_ASSERT(node_id < module_ports.ipin_ports[size_t(side)].size());
+  return module_ports.ipin_ports[size_t(side)][node_id];
+}
+
+const std::vector<ModulePinInfo>& DeviceRRGSBModulePorts::cb_ipin_driver_ports(const t_rr_type& cb_type,
+                                                                               const RRGSB& rr_gsb,
+                                                                               const e_side& side,
+                                                                               const size_t& node_id) const {
+  VTR_ASSERT(true == has_cb_module_ports(cb_type, rr_gsb));
+  const CbModulePorts& module_ports = cb_module_ports(cb_type, rr_gsb);
+  VTR_ASSERT(node_id < module_ports.ipin_driver_ports[size_t(side)].size());
+  return module_ports.ipin_driver_ports[size_t(side)][node_id];
+}
+
+/************************************************************************
+ * Public Mutators
+ ***********************************************************************/
+void DeviceRRGSBModulePorts::reserve(const vtr::Point<size_t>& gsb_range) {
+  sb_module_ports_.assign(gsb_range.x(), std::vector<SbModulePorts>(gsb_range.y()));
+  cbx_module_ports_.assign(gsb_range.x(), std::vector<CbModulePorts>(gsb_range.y()));
+  cby_module_ports_.assign(gsb_range.x(), std::vector<CbModulePorts>(gsb_range.y()));
+}
+
+void DeviceRRGSBModulePorts::clear() {
+  sb_module_ports_.clear();
+  cbx_module_ports_.clear();
+  cby_module_ports_.clear();
+}
+
+void DeviceRRGSBModulePorts::add_sb_module_ports(const RRGSB& rr_gsb) {
+  VTR_ASSERT(true == valid_gsb_coordinate(rr_gsb));
+  SbModulePorts& module_ports = sb_module_ports_[rr_gsb.get_x()][rr_gsb.get_y()];
+
+  module_ports.valid = true;
+  module_ports.chan_ports.resize(NUM_SIDES);
+  module_ports.opin_ports.resize(NUM_SIDES);
+  module_ports.chan_driver_ports.resize(NUM_SIDES);
+  for (size_t side = 0; side < rr_gsb.get_num_sides(); ++side) {
+    e_side curr_side = e_side(side);
+    module_ports.chan_ports[side].assign(rr_gsb.get_chan_width(curr_side), ModulePinInfo(ModulePortId::INVALID(), 0));
+    module_ports.opin_ports[side].assign(rr_gsb.get_num_opin_nodes(curr_side), ModulePortId::INVALID());
+    module_ports.chan_driver_ports[side].assign(rr_gsb.get_chan_width(curr_side), std::vector<ModulePinInfo>());
+  }
+}
+
+void DeviceRRGSBModulePorts::set_sb_chan_port(const RRGSB& rr_gsb,
+                                              const e_side& side,
+                                              const size_t& track_id,
+                                              const ModulePinInfo& chan_port) {
+  SbModulePorts& module_ports = mutable_sb_module_ports(rr_gsb);
+  VTR_ASSERT(track_id < module_ports.chan_ports[size_t(side)].size());
+  module_ports.chan_ports[size_t(side)][track_id] = chan_port;
+}
+
+void DeviceRRGSBModulePorts::set_sb_opin_port(const RRGSB& rr_gsb,
+                                              const e_side& side,
+                                              const size_t& node_id,
+                                              const ModulePortId& opin_port) {
+  SbModulePorts& module_ports = mutable_sb_module_ports(rr_gsb);
+  VTR_ASSERT(node_id < module_ports.opin_ports[size_t(side)].size());
+  module_ports.opin_ports[size_t(side)][node_id] = opin_port;
+}
+
+void DeviceRRGSBModulePorts::set_sb_chan_driver_ports(const RRGSB& rr_gsb,
+                                                      const e_side& side,
+                                                      const size_t& track_id,
+                                                      const std::vector<ModulePinInfo>& driver_ports) {
+  SbModulePorts& module_ports = mutable_sb_module_ports(rr_gsb);
+  VTR_ASSERT(track_id < module_ports.chan_driver_ports[size_t(side)].size());
+  module_ports.chan_driver_ports[size_t(side)][track_id] = driver_ports;
+}
+
+void DeviceRRGSBModulePorts::add_cb_module_ports(const t_rr_type& cb_type, const RRGSB& rr_gsb) {
+  VTR_ASSERT(true == valid_gsb_coordinate(rr_gsb));
+  CbModulePorts& module_ports = mutable_cb_module_ports(cb_type, rr_gsb);
+
+  module_ports.valid = true;
+  module_ports.chan_input_ports.assign(rr_gsb.get_cb_chan_width(cb_type), ModulePinInfo(ModulePortId::INVALID(), 0));
+  module_ports.chan_output_ports.assign(rr_gsb.get_cb_chan_width(cb_type), ModulePinInfo(ModulePortId::INVALID(), 0));
+  module_ports.ipin_ports.resize(NUM_SIDES);
+  module_ports.ipin_driver_ports.resize(NUM_SIDES);
+  for (const e_side& side : rr_gsb.get_cb_ipin_sides(cb_type)) {
+    module_ports.ipin_ports[size_t(side)].assign(rr_gsb.get_num_ipin_nodes(side), ModulePortId::INVALID());
+    module_ports.ipin_driver_ports[size_t(side)].assign(rr_gsb.get_num_ipin_nodes(side), std::vector<ModulePinInfo>());
+  }
+}
+
+void DeviceRRGSBModulePorts::set_cb_chan_port(const t_rr_type& cb_type,
+                                              const RRGSB& rr_gsb,
+                                              const size_t& track_id,
+                                              const PORTS& port_direction,
+                                              const ModulePinInfo& chan_port) {
+  VTR_ASSERT(true == has_cb_module_ports(cb_type, rr_gsb));
+  CbModulePorts& module_ports = mutable_cb_module_ports(cb_type, rr_gsb);
+  VTR_ASSERT(track_id < module_ports.chan_input_ports.size());
+  if (IN_PORT == port_direction) {
+    module_ports.chan_input_ports[track_id] = chan_port;
+  } else {
+    VTR_ASSERT(OUT_PORT == port_direction);
+    module_ports.chan_output_ports[track_id] = chan_port;
+  }
+}
+
+void DeviceRRGSBModulePorts::set_cb_ipin_port(const t_rr_type& cb_type,
+                                              const RRGSB& rr_gsb,
+                                              const e_side& side,
+                                              const size_t& node_id,
+                                              const ModulePortId& ipin_port) {
+  VTR_ASSERT(true == has_cb_module_ports(cb_type, rr_gsb));
+  CbModulePorts& module_ports = mutable_cb_module_ports(cb_type, rr_gsb);
+  VTR_ASSERT(node_id < module_ports.ipin_ports[size_t(side)].size());
+  module_ports.ipin_ports[size_t(side)][node_id] = ipin_port;
+}
+
+void DeviceRRGSBModulePorts::set_cb_ipin_driver_ports(const t_rr_type& cb_type,
+                                                      const RRGSB& rr_gsb,
+                                                      const e_side& side,
+                                                      const size_t& node_id,
+                                                      const std::vector<ModulePinInfo>& driver_ports) {
+  VTR_ASSERT(true == has_cb_module_ports(cb_type, rr_gsb));
+  CbModulePorts& module_ports = mutable_cb_module_ports(cb_type, rr_gsb);
+  VTR_ASSERT(node_id < module_ports.ipin_driver_ports[size_t(side)].size());
+  module_ports.ipin_driver_ports[size_t(side)][node_id] = driver_ports;
+}
+
+/************************************************************************
+ * Internal validators and helpers
+ ***********************************************************************/
+const DeviceRRGSBModulePorts::SbModulePorts& DeviceRRGSBModulePorts::sb_module_ports(const RRGSB& rr_gsb) const {
+  VTR_ASSERT(true == has_sb_module_ports(rr_gsb));
+  return sb_module_ports_[rr_gsb.get_x()][rr_gsb.get_y()];
+}
+
+DeviceRRGSBModulePorts::SbModulePorts& DeviceRRGSBModulePorts::mutable_sb_module_ports(const RRGSB& rr_gsb) {
+  VTR_ASSERT(true == has_sb_module_ports(rr_gsb));
+  return sb_module_ports_[rr_gsb.get_x()][rr_gsb.get_y()];
+}
+
+const DeviceRRGSBModulePorts::CbModulePorts& DeviceRRGSBModulePorts::cb_module_ports(const t_rr_type& cb_type,
+                                                                                     const RRGSB& rr_gsb) const {
+  VTR_ASSERT(true == valid_gsb_coordinate(rr_gsb));
+  if (CHANX == cb_type) {
+    return cbx_module_ports_[rr_gsb.get_x()][rr_gsb.get_y()];
+  }
+  VTR_ASSERT(CHANY == cb_type);
+  return cby_module_ports_[rr_gsb.get_x()][rr_gsb.get_y()];
+}
+
+DeviceRRGSBModulePorts::CbModulePorts& DeviceRRGSBModulePorts::mutable_cb_module_ports(const t_rr_type& cb_type,
+                                                                                       const RRGSB& rr_gsb) {
+  VTR_ASSERT(true == valid_gsb_coordinate(rr_gsb));
+  if (CHANX == cb_type) {
+    return cbx_module_ports_[rr_gsb.get_x()][rr_gsb.get_y()];
+  }
+  VTR_ASSERT(CHANY == cb_type);
+  return cby_module_ports_[rr_gsb.get_x()][rr_gsb.get_y()];
+}
+
+bool DeviceRRGSBModulePorts::valid_gsb_coordinate(const RRGSB& rr_gsb) const {
+  return (rr_gsb.get_x() < sb_module_ports_.size())
+      && (rr_gsb.get_y() < sb_module_ports_[rr_gsb.get_x()].size());
+}
+
+} /* namespace openfpga ends */
@@ -0,0 +1,117 @@
+#ifndef DEVICE_RR_GSB_MODULE_PORTS_H
+#define DEVICE_RR_GSB_MODULE_PORTS_H
+
+/********************************************************************
+ * Include header files required by the data structure definition
+ *******************************************************************/
+#include <vector>
+
+#include "vtr_geometry.h"
+#include "rr_gsb.h"
+#include "module_manager.h"
+#include "build_routing_module_utils.h"
+
+/* namespace openfpga begins */
+namespace openfpga {
+
+/********************************************************************
+ * A data structure to store the module ports of the switch blocks
+ * and connection blocks, which are resolved from the rr_nodes of GSBs
+ *
+ * The ports of a routing module are stored for the GSB which
+ * the module is built from, i.e., the unique mirror under a compact
+ * routing hierarchy or the GSB itself under a flatten routing hierarchy
+ *
+ * The ports are resolved once the module graph is built, so that
+ * netlist and SDC writers can find them without name-based searches
+ *
+ * Typical usage:
+ *   // Find the port of a routing track in a switch block module
+ *   // where rr_gsb is the GSB which the module is built from
+ *   ModulePinInfo chan_port = gsb_module_ports.sb_chan_port(rr_gsb, side, itrack);
+ *******************************************************************/
+class DeviceRRGSBModulePorts {
+  public:  /* Constructor */
+    DeviceRRGSBModulePorts();
+  public:  /* Public accessors */
+    /* Check if the ports of a switch block module have been resolved for a GSB */
+    bool has_sb_module_ports(const RRGSB& rr_gsb) const;
+    /* Port of a routing track in the switch block module */
+    ModulePinInfo sb_chan_port(const RRGSB& rr_gsb, const e_side& side, const size_t& track_id) const;
+    /* Port of a grid output pin in the switch block module */
+    ModulePortId sb_opin_port(const RRGSB& rr_gsb, const e_side& side, const size_t& node_id) const;
+    /* Ports driving a routing multiplexer in the switch block module,
+     * in the same order as the configurable incoming edges of the routing track
+     * Empty for input tracks and passing wires
+     */
+    const std::vector<ModulePinInfo>& sb_chan_driver_ports(const RRGSB& rr_gsb, const e_side& side, const size_t& track_id) const;
+
+    /* Check if the ports of a connection block module have been resolved for a GSB */
+    bool has_cb_module_ports(const t_rr_type& cb_type, const RRGSB& rr_gsb) const;
+    /* Port of a routing track in the connection block module */
+    ModulePinInfo cb_chan_port(const t_rr_type& cb_type, const RRGSB& rr_gsb, const size_t& track_id, const PORTS& port_direction) const;
+    /* Port of a grid input pin in the connection block module */
+    ModulePortId cb_ipin_port(const t_rr_type& cb_type, const RRGSB& rr_gsb, const e_side& side, const size_t& node_id) const;
+    /* Ports driving a routing multiplexer in the connection block module,
+     * in the same order as the configurable incoming edges of the grid input pin
+     * Empty for the grid input pins without multiplexers
+     */
+    const std::vector<ModulePinInfo>& cb_ipin_driver_ports(const t_rr_type& cb_type, const RRGSB& rr_gsb, const e_side& side, const size_t& node_id) const;
+  public: /* Public mutators */
+    /* Allocate the storage for all the GSBs of a device */
+    void reserve(const vtr::Point<size_t>& gsb_range);
+    void clear();
+
+    /* Allocate the ports of a switch block module, which are sized by the GSB */
+    void add_sb_module_ports(const RRGSB& rr_gsb);
+    void set_sb_chan_port(const RRGSB& rr_gsb, const e_side& side, const size_t& track_id,
+                          const ModulePinInfo& chan_port);
+    void set_sb_opin_port(const RRGSB& rr_gsb, const e_side& side, const size_t& node_id,
+                          const ModulePortId& opin_port);
+    void set_sb_chan_driver_ports(const RRGSB& rr_gsb, const e_side& side, const size_t& track_id,
+                                  const std::vector<ModulePinInfo>& driver_ports);
+
+    /* Allocate the ports of a connection block module, which are sized by the GSB */
+    void add_cb_module_ports(const t_rr_type& cb_type, const RRGSB& rr_gsb);
+    void set_cb_chan_port(const t_rr_type& cb_type, const RRGSB& rr_gsb, const size_t& track_id,
+                          const PORTS& port_direction, const ModulePinInfo& chan_port);
+    void set_cb_ipin_port(const t_rr_type& cb_type, const RRGSB& rr_gsb, const e_side& side, const size_t& node_id,
+                          const ModulePortId& ipin_port);
+    void set_cb_ipin_driver_ports(const t_rr_type& cb_type, const RRGSB& rr_gsb, const e_side& side, const size_t& node_id,
+                                  const std::vector<ModulePinInfo>& driver_ports);
+  private: /* Internal types */
+    struct SbModulePorts {
+      bool valid = false;
+      /* [side][track_id] */
+      std::vector<std::vector<ModulePinInfo>> chan_ports;
+      /* [side][node_id] */
+      std::vector<std::vector<ModulePortId>> opin_ports;
+      /* [side][track_id][driver] */
+      std::vector<std::vector<std::vector<ModulePinInfo>>> chan_driver_ports;
+    };
+    struct CbModulePorts {
+      bool valid = false;
+      /* [track_id] */
+      std::vector<ModulePinInfo> chan_input_ports;
+      std::vector<ModulePinInfo> chan_output_ports;
+      /* [side][node_id] */
+      std::vector<std::vector<ModulePortId>> ipin_ports;
+      /* [side][node_id][driver] */
+      std::vector<std::vector<std::vector<ModulePinInfo>>> ipin_driver_ports;
+    };
+  private: /* Internal validators and helpers */
+    const SbModulePorts& sb_module_ports(const RRGSB& rr_gsb) const;
+    SbModulePorts& mutable_sb_module_ports(const RRGSB& rr_gsb);
+    const CbModulePorts& cb_module_ports(const t_rr_type& cb_type, const RRGSB& rr_gsb) const;
+    CbModulePorts& mutable_cb_module_ports(const t_rr_type& cb_type, const RRGSB& rr_gsb);
+    bool valid_gsb_coordinate(const RRGSB& rr_gsb) const;
+  private: /* Internal data */
+    /* Ports of the routing modules built from each GSB: [x][y] */
+    std::vector<std::vector<SbModulePorts>> sb_module_ports_;
+    std::vector<std::vector<CbModulePorts>> cbx_module_ports_;
+    std::vector<std::vector<CbModulePorts>> cby_module_ports_;
+};
+
+} /* namespace openfpga ends */
+
+#endif
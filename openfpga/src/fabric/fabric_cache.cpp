@@ -0,0 +1,817 @@
+/***************************************************************************************
+ * This file includes functions to save the module graph of an FPGA fabric to a binary
+ * cache file and to load it back, so that the fabric is built only once per architecture
+ * when many benchmarks are implemented on it
+ *
+ * The module graph depends only on the architectures and the options of build_fabric,
+ * so the cache is keyed by a hash of
+ *   - the device grid, the routing resource graph and the pb_types of VPR
+ *   - the OpenFPGA architecture, which is hashed through its XML description
+ *   - the options of build_fabric and the content of the fabric key file
+ *
+ * The module graph is replayed through the public mutators of the module manager,
+ * so that all the internal look-ups are rebuilt as if the fabric is built from scratch
+ * Data which are derived from the module graph, e.g., I/O location map and
+ * global port information, are not cached but rebuilt by the caller
+ *
+ * Layout of the cache, which is written by the binary archives of openfpga_binary_io.h
+ *   - magic:                string "OFPGAFAB"
+ *   - version:              uint32
+ *   - architecture hash:    string, the hex digits of a SHA-256 digest
+ *   - number of decoders:   uint32
+ *   - decoders:             address size (uint32), data size (uint32), flags (uint8)
+ *   - number of modules:    uint32
+ *   - modules:              name (string), usage (uint8)
+ *   - for each module, its ports:
+ *     - number of ports:    uint32
+ *     - ports:              name (string), lsb (uint32), msb (uint32),
+ *                           origin port width (uint64), type (uint8), flags (uint8),
+ *                           pre-processing flag (string)
+ *   - for each module, its children and nets:
+ *     - number of children: uint32
+ *     - children:           module (uint32), number of instances (uint32),
+ *                           instance names (string)
+ *     - number of configurable children: uint32
+ *     - configurable children: module (uint32), instance (uint32)
+ *     - number of configuration regions: uint32
+ *     - regions:            number of children (uint32),
+ *                           index of each child in the configurable children (uint32)
+ *     - number of nets:     uint32
+ *     - nets:               name (string), number of sources (uint32), sources,
+ *                           number of sinks (uint32), sinks
+ *       where each terminal is module (uint32), instance (uint32), port (uint32), pin (uint32)
+ *   - for each module, the module which it is merged into (uint32),
+ *     whose value is UINT32_MAX if it is not merged
+ *   Integers are in the byte order of the machine, and a string is stored as
+ *   its length (uint64) followed by its characters
+ ***************************************************************************************/
+#include <cstdio>
+#include <fstream>
+#include <map>
+#include <random>
+#include <sstream>
+
+/* Headers from vtrutil library */
+#include "vtr_log.h"
+#include "vtr_assert.h"
+#include "vtr_time.h"
+#include "vtr_util.h"
+#include "vtr_digest.h"
+
+/* Headers from openfpgautil library */
+#include "openfpga_digest.h"
+#include "openfpga_binary_io.h"
+
+/* Headers from archopenfpga library */
+#include "simulation_setting.h"
+#include "bitstream_setting.h"
+#include "write_xml_openfpga_arch.h"
+
+#include "fabric_cache.h"
+
+/* begin namespace openfpga */
+namespace openfpga {
+
+constexpr char FABRIC_CACHE_MAGIC[] = "OFPGAFAB";
+constexpr uint32_t FABRIC_CACHE_VERSION = 7;
+constexpr uint32_t FABRIC_CACHE_INVALID_ID = UINT32_MAX;
+
+/* Flags of a decoder */
+constexpr uint8_t FABRIC_CACHE_DECODER_USE_ENABLE = 1 << 0;
+constexpr uint8_t FABRIC_CACHE_DECODER_USE_DATA_IN = 1 << 1;
+constexpr uint8_t FABRIC_CACHE_DECODER_USE_DATA_INV_PORT = 1 << 2;
+
+/* Flags of a module port */
+constexpr uint8_t FABRIC_CACHE_PORT_IS_WIRE = 1 << 0;
+constexpr uint8_t FABRIC_CACHE_PORT_IS_MAPPABLE_IO = 1 << 1;
+constexpr uint8_t FABRIC_CACHE_PORT_IS_REGISTER = 1 << 2;
+
+/***************************************************************************************
+ * Add a string of VPR, which can be null, to the data to hash
+ ***************************************************************************************/
+static
+void hash_c_string(BinaryWriter& hasher, const char* str) {
+  hasher(nullptr != str);
+  if (nullptr != str) {
+    hasher(std::string(str));
+  }
+}
+
+/***************************************************************************************
+ * Add a pb_type and its child pb_types, whose ports and modes are modelled
+ * by the modules of grids, to the data to hash
+ ***************************************************************************************/
+static
+void rec_hash_pb_type(BinaryWriter& hasher, const t_pb_type* pb_type) {
+  hash_c_string(hasher, pb_type->name);
+  hash_c_string(hasher, pb_type->blif_model);
+  hasher(pb_type->num_pb);
+
+  hasher(pb_type->num_ports);
+  for (int iport = 0; iport < pb_type->num_ports; ++iport) {
+    const t_port& port = pb_type->ports[iport];
+    hash_c_string(hasher, port.name);
+    hasher(port.type, port.num_pins, port.is_clock);
+  }
+
+  hasher(pb_type->num_modes);
+  for (int imode = 0; imode < pb_type->num_modes; ++imode) {
+    const t_mode& mode = pb_type->modes[imode];
+    hash_c_string(hasher, mode.name);
+    hasher(mode.num_interconnect);
+    for (int iinterc = 0; iinterc < mode.num_interconnect; ++iinterc) {
+      const t_interconnect& interc = mode.interconnect[iinterc];
+      hash_c_string(hasher, interc.name);
+      hasher(interc.type);
+      hash_c_string(hasher, interc.input_string);
+      hash_c_string(hasher, interc.output_string);
+    }
+    hasher(mode.num_pb_type_children);
+    for (int ichild = 0; ichild < mode.num_pb_type_children; ++ichild) {
+      rec_hash_pb_type(hasher, &(mode.pb_type_children[ichild]));
+    }
+  }
+}
+
+/***************************************************************************************
+ * Add the device of VPR: grid, routing resource graph and pb_types to the data to hash
+ ***************************************************************************************/
+static
+void hash_vpr_device(BinaryWriter& hasher, const DeviceContext& device_ctx) {
+  /* Device grid */
+  const DeviceGrid& grids = device_ctx.grid;
+  hasher(grids.width(), grids.height());
+  for (size_t ix = 0; ix < grids.width(); ++ix) {
+    for (size_t iy = 0; iy < grids.height(); ++iy) {
+      hash_c_string(hasher, grids[ix][iy].type->name);
+      hasher(grids[ix][iy].width_offset, grids[ix][iy].height_offset);
+    }
+  }
+
+  /* Logical blocks */
+  hasher(device_ctx.logical_block_types.size());
+  for (const t_logical_block_type& lb_type : device_ctx.logical_block_types) {
+    hash_c_string(hasher, lb_type.name);
+    if (nullptr != lb_type.pb_type) {
+      rec_hash_pb_type(hasher, lb_type.pb_type);
+    }
+  }
+
+  /* Routing resource graph */
+  const RRGraph& rr_graph = device_ctx.rr_graph;
+  hasher(device_ctx.rr_switch_inf.size());
+  for (const t_rr_switch_inf& rr_switch : device_ctx.rr_switch_inf) {
+    hash_c_string(hasher, rr_switch.name);
+  }
+  for (const RRNodeId& node : rr_graph.nodes()) {
+    t_rr_type node_type = rr_graph.node_type(node);
+    hasher(node_type,
+           rr_graph.node_xlow(node), rr_graph.node_ylow(node),
+           rr_graph.node_xhigh(node), rr_graph.node_yhigh(node),
+           rr_graph.node_ptc_num(node), rr_graph.node_capacity(node));
+    if ( (CHANX == node_type) || (CHANY == node_type) ) {
+      hasher(rr_graph.node_direction(node), size_t(rr_graph.node_segment(node)));
+    }
+    if ( (IPIN == node_type) || (OPIN == node_type) ) {
+      hasher(rr_graph.node_side(node));
+    }
+    for (const RREdgeId& edge : rr_graph.node_out_edges(node)) {
+      hasher(size_t(rr_graph.edge_sink_node(edge)), size_t(rr_graph.edge_switch(edge)));
+    }
+  }
+}
+
+/***************************************************************************************
+ * Compute the hash of the architectures and options which the module graph depends on
+ * The OpenFPGA architecture is hashed through its XML description, which is written
+ * to a temporary file next to the cache file
+ * A fabric key file which cannot be read is hashed by its name,
+ * as build_fabric errors out on it anyway
+ ***************************************************************************************/
+std::string compute_fabric_cache_arch_hash(const std::string& cache_fname,
+                                           const DeviceContext& device_ctx,
+                                           const Arch& openfpga_arch,
+                                           const std::string& build_options,
+                                           const std::string& fabric_key_fname) {
+  vtr::ScopedStartFinishTimer timer("Compute the hash of architectures for fabric cache");
+
+  std::ostringstream hash_data;
+  BinaryWriter hasher(hash_data);
+  hasher(FABRIC_CACHE_VERSION, build_options);
+
+  if (false == fabric_key_fname.empty()) {
+    if (true == vtr::file_exists(fabric_key_fname.c_str())) {
+      hasher(vtr::secure_digest_file(fabric_key_fname));
+    } else {
+      hasher(fabric_key_fname);
+    }
+  }
+
+  hash_vpr_device(hasher, device_ctx);
+
+  /* Use a random suffix for the temporary file to avoid conflicts between concurrent runs */
+  std::random_device rand_dev;
+  std::string arch_fname = cache_fname + std::string(".arch.tmp") + std::to_string(rand_dev());
+  create_directory(find_path_dir_name(cache_fname));
+  write_xml_openfpga_arch(arch_fname.c_str(), openfpga_arch);
+  hasher(vtr::secure_digest_file(arch_fname));
+  std::remove(arch_fname.c_str());
+
+  return secure_digest_hex(hash_data.str());
+}
+
+/***************************************************************************************
+ * Encode the decoder library
+ ***************************************************************************************/
+static
+void write_decoder_library_to_cache(BinaryWriter& writer,
+                                    const DecoderLibrary& decoder_lib) {
+  writer(static_cast<uint32_t>(decoder_lib.decoders().size()));
+  for (const DecoderId& decoder : decoder_lib.decoders()) {
+    writer(static_cast<uint32_t>(decoder_lib.addr_size(decoder)));
+    writer(static_cast<uint32_t>(decoder_lib.data_size(decoder)));
+    uint8_t flags = 0;
+    if (true == decoder_lib.use_enable(decoder)) {
+      flags |= FABRIC_CACHE_DECODER_USE_ENABLE;
+    }
+    if (true == decoder_lib.use_data_in(decoder)) {
+      flags |= FABRIC_CACHE_DECODER_USE_DATA_IN;
+    }
+    if (true == decoder_lib.use_data_inv_port(decoder)) {
+      flags |= FABRIC_CACHE_DECODER_USE_DATA_INV_PORT;
+    }
+    writer(static_cast<uint8_t>(flags));
+  }
+  writer(static_cast<uint32_t>(decoder_lib.shift_registers().size()));
+  for (const size_t& shift_register_size : decoder_lib.shift_registers()) {
+    writer(static_cast<uint32_t>(shift_register_size));
+  }
+  writer(static_cast<uint32_t>(decoder_lib.decompressors().size()));
+  for (const size_t& run_length_width : decoder_lib.decompressors()) {
+    writer(static_cast<uint32_t>(run_length_width));
+  }
+}
+
+/***************************************************************************************
+ * Decode the decoder library
+ * Return false if the cache is corrupted
+ ***************************************************************************************/
+static
+bool read_decoder_library_from_cache(BinaryReader& reader,
+                                     DecoderLibrary& decoder_lib) {
+  size_t num_decoders = reader.get<uint32_t>();
+  for (size_t idecoder = 0; idecoder < num_decoders; ++idecoder) {
+    size_t addr_size = reader.get<uint32_t>();
+    size_t data_size = reader.get<uint32_t>();
+    uint8_t flags = reader.get<uint8_t>();
+    if (false == reader.good()) {
+      return false;
+    }
+    decoder_lib.add_decoder(addr_size, data_size,
+                            0 != (flags & FABRIC_CACHE_DECODER_USE_ENABLE),
+                            0 != (flags & FABRIC_CACHE_DECODER_USE_DATA_IN),
+                            0 != (flags & FABRIC_CACHE_DECODER_USE_DATA_INV_PORT));
+  }
+  size_t num_shift_registers = reader.get<uint32_t>();
+  for (size_t ishift_register = 0; ishift_register < num_shift_registers; ++ishift_register) {
+    size_t data_size = reader.get<uint32_t>();
+    if ( (false == reader.good())
+      || (true == decoder_lib.find_shift_register(data_size)) ) {
+      return false;
+    }
+    decoder_lib.add_shift_register(data_size);
+  }
+  size_t num_decompressors = reader.get<uint32_t>();
+  for (size_t idecompressor = 0; idecompressor < num_decompressors; ++idecompressor) {
+    size_t run_length_width = reader.get<uint32_t>();
+    if ( (false == reader.good())
+      || (true == decoder_lib.find_decompressor(run_length_width)) ) {
+      return false;
+    }
+    decoder_lib.add_decompressor(run_length_width);
+  }
+  return true == reader.good();
+}
+
+/***************************************************************************************
+ * Encode the terminals of a net
+ ***************************************************************************************/
+static
+void write_net_terminals_to_cache(BinaryWriter& writer,
+                                  const size_t& num_terminals,
+                                  const std::vector<ModuleId>& terminal_modules,
+                                  const std::vector<size_t>& terminal_instances,
+                                  const std::vector<ModulePortId>& terminal_ports,
+                                  const std::vector<size_t>& terminal_pins) {
+  writer(static_cast<uint32_t>(num_terminals));
+  for (size_t iterm = 0; iterm < num_terminals; ++iterm) {
+    writer(static_cast<uint32_t>(size_t(terminal_modules[iterm])));
+    writer(static_cast<uint32_t>(terminal_instances[iterm]));
+    writer(static_cast<uint32_t>(size_t(terminal_ports[iterm])));
+    writer(static_cast<uint32_t>(terminal_pins[iterm]));
+  }
+}
+
+/***************************************************************************************
+ * Encode the module graph
+ ***************************************************************************************/
+static
+void write_module_manager_to_cache(BinaryWriter& writer,
+                                   const ModuleManager& module_manager) {
+  /* Modules */
+  writer(static_cast<uint32_t>(module_manager.num_modules()));
+  for (const ModuleId& module : module_manager.modules()) {
+    writer(module_manager.module_name(module));
+    writer(static_cast<uint8_t>(module_manager.module_usage(module)));
+  }
+
+  /* Ports of each module */
+  for (const ModuleId& module : module_manager.modules()) {
+    writer(static_cast<uint32_t>(module_manager.module_ports(module).size()));
+    for (const ModulePortId& port : module_manager.module_ports(module)) {
+      const BasicPort& port_info = module_manager.module_port(module, port);
+      writer(port_info.get_name());
+      writer(static_cast<uint32_t>(port_info.get_lsb()));
+      writer(static_cast<uint32_t>(port_info.get_msb()));
+      writer(static_cast<uint64_t>(port_info.get_origin_port_width()));
+      writer(static_cast<uint8_t>(module_manager.port_type(module, port)));
+      uint8_t flags = 0;
+      if (true == module_manager.port_is_wire(module, port)) {
+        flags |= FABRIC_CACHE_PORT_IS_WIRE;
+      }
+      if (true == module_manager.port_is_mappable_io(module, port)) {
+        flags |= FABRIC_CACHE_PORT_IS_MAPPABLE_IO;
+      }
+      if (true == module_manager.port_is_register(module, port)) {
+        flags |= FABRIC_CACHE_PORT_IS_REGISTER;
+      }
+      writer(static_cast<uint8_t>(flags));
+      writer(module_manager.port_preproc_flag(module, port));
+    }
+  }
+
+  /* Children and nets of each module */
+  for (const ModuleId& module : module_manager.modules()) {
+    const vtr::small_vector<ModuleId>& children = module_manager.child_modules(module);
+    writer(static_cast<uint32_t>(children.size()));
+    for (const ModuleId& child : children) {
+      writer(static_cast<uint32_t>(size_t(child)));
+      size_t num_instances = module_manager.num_instance(module, child);
+      writer(static_cast<uint32_t>(num_instances));
+      for (size_t inst = 0; inst < num_instances; ++inst) {
+        writer(module_manager.instance_name(module, child, inst));
+      }
+    }
+
+    std::vector<ModuleId> config_children = module_manager.configurable_children(module);
+    std::vector<size_t> config_child_instances = module_manager.configurable_child_instances(module);
+    VTR_ASSERT(config_children.size() == config_child_instances.size());
+    writer(static_cast<uint32_t>(config_children.size()));
+    std::map<std::pair<ModuleId, size_t>, size_t> config_child_indices;
+    for (size_t ichild = 0; ichild < config_children.size(); ++ichild) {
+      writer(static_cast<uint32_t>(size_t(config_children[ichild])));
+      writer(static_cast<uint32_t>(config_child_instances[ichild]));
+      config_child_indices[std::make_pair(config_children[ichild], config_child_instances[ichild])] = ichild;
+    }
+
+    writer(static_cast<uint32_t>(module_manager.regions(module).size()));
+    for (const ConfigRegionId& region : module_manager.regions(module)) {
+      std::vector<ModuleId> region_children = module_manager.region_configurable_children(module, region);
+      std::vector<size_t> region_child_instances = module_manager.region_configurable_child_instances(module, region);
+      writer(static_cast<uint32_t>(region_children.size()));
+      for (size_t ichild = 0; ichild < region_children.size(); ++ichild) {
+        writer(static_cast<uint32_t>(config_child_indices.at(std::make_pair(region_children[ichild], region_child_instances[ichild]))));
+      }
+    }
+
+    writer(static_cast<uint32_t>(module_manager.num_nets(module)));
+    for (const ModuleNetId& net : module_manager.module_nets(module)) {
+      VTR_ASSERT(true == module_manager.valid_module_net_id(module, net));
+      writer(module_manager.net_name(module, net));
+
+      vtr::vector<ModuleNetSrcId, ModuleId> src_modules = module_manager.net_source_modules(module, net);
+      vtr::vector<ModuleNetSrcId, size_t> src_instances = module_manager.net_source_instances(module, net);
+      vtr::vector<ModuleNetSrcId, ModulePortId> src_ports = module_manager.net_source_ports(module, net);
+      vtr::vector<ModuleNetSrcId, size_t> src_pins = module_manager.net_source_pins(module, net);
+      write_net_terminals_to_cache(writer, src_modules.size(),
+                                   std::vector<ModuleId>(src_modules.begin(), src_modules.end()),
+                                   std::vector<size_t>(src_instances.begin(), src_instances.end()),
+                                   std::vector<ModulePortId>(src_ports.begin(), src_ports.end()),
+                                   std::vector<size_t>(src_pins.begin(), src_pins.end()));
+
+      vtr::vector<ModuleNetSinkId, ModuleId> sink_modules = module_manager.net_sink_modules(module, net);
+      vtr::vector<ModuleNetSinkId, size_t> sink_instances = module_manager.net_sink_instances(module, net);
+      vtr::vector<ModuleNetSinkId, ModulePortId> sink_ports = module_manager.net_sink_ports(module, net);
+      vtr::vector<ModuleNetSinkId, size_t> sink_pins = module_manager.net_sink_pins(module, net);
+      write_net_terminals_to_cache(writer, sink_modules.size(),
+                                   std::vector<ModuleId>(sink_modules.begin(), sink_modules.end()),
+                                   std::vector<size_t>(sink_instances.begin(), sink_instances.end()),
+                                   std::vector<ModulePortId>(sink_ports.begin(), sink_ports.end()),
+                                   std::vector<size_t>(sink_pins.begin(), sink_pins.end()));
+    }
+  }
+
+  /* Merged modules, which are replayed after all the modules are in place */
+  for (const ModuleId& module : module_manager.modules()) {
+    ModuleId merged_module = module_manager.merged_module(module);
+    if (true == module_manager.valid_module_id(merged_module)) {
+      writer(static_cast<uint32_t>(size_t(merged_module)));
+    } else {
+      writer(static_cast<uint32_t>(FABRIC_CACHE_INVALID_ID));
+    }
+  }
+}
+
+/***************************************************************************************
+ * Decode a terminal of a net and check that it exists in the module graph
+ * Return false if the cache is corrupted
+ ***************************************************************************************/
+static
+bool read_net_terminal_from_cache(BinaryReader& reader,
+                                  const ModuleManager& module_manager,
+                                  const ModuleId& parent_module,
+                                  ModuleId& term_module,
+                                  size_t& term_instance,
+                                  ModulePortId& term_port,
+                                  size_t& term_pin) {
+  term_module = ModuleId(reader.get<uint32_t>());
+  term_instance = reader.get<uint32_t>();
+  term_port = ModulePortId(reader.get<uint32_t>());
+  term_pin = reader.get<uint32_t>();
+  if ( (false == reader.good())
+    || (false == module_manager.valid_module_id(term_module))
+    || (false == module_manager.valid_module_port_id(term_module, term_port))
+    || (term_pin >= module_manager.module_port(term_module, term_port).get_width()) ) {
+    return false;
+  }
+  if (parent_module == term_module) {
+    return 0 == term_instance;
+  }
+  return module_manager.valid_module_instance_id(parent_module, term_module, term_instance);
+}
+
+/***************************************************************************************
+ * Decode the children, configurable children and nets of a module
+ * Return false if the cache is corrupted
+ ***************************************************************************************/
+static
+bool read_module_graph_from_cache(BinaryReader& reader,
+                                  ModuleManager& module_manager,
+                                  const ModuleId& module) {
+  size_t num_children = reader.get<uint32_t>();
+  for (size_t ichild = 0; ichild < num_children; ++ichild) {
+    ModuleId child = ModuleId(reader.get<uint32_t>());
+    size_t num_instances = reader.get<uint32_t>();
+    if ( (false == reader.good())
+      || (false == module_manager.valid_module_id(child))
+      || (module == child) ) {
+      return false;
+    }
+    for (size_t inst = 0; inst < num_instances; ++inst) {
+      std::string instance_name = reader.get<std::string>();
+      if (false == reader.good()) {
+        return false;
+      }
+      module_manager.add_child_module(module, child);
+      if (false == instance_name.empty()) {
+        module_manager.set_child_instance_name(module, child, inst, instance_name);
+      }
+    }
+  }
+
+  size_t num_config_children = reader.get<uint32_t>();
+  if (false == reader.good()) {
+    return false;
+  }
+  module_manager.reserve_configurable_child(module, num_config_children);
+  std::vector<ModuleId> config_children;
+  std::vector<size_t> config_child_instances;
+  for (size_t ichild = 0; ichild < num_config_children; ++ichild) {
+    ModuleId child = ModuleId(reader.get<uint32_t>());
+    size_t inst = reader.get<uint32_t>();
+    if ( (false == reader.good())
+      || (false == module_manager.valid_module_id(child))
+      || (false == module_manager.valid_module_instance_id(module, child, inst)) ) {
+      return false;
+    }
+    module_manager.add_configurable_child(module, child, inst);
+    config_children.push_back(child);
+    config_child_instances.push_back(inst);
+  }
+
+  size_t num_regions = reader.get<uint32_t>();
+  if (false == reader.good()) {
+    return false;
+  }
+  for (size_t iregion = 0; iregion < num_regions; ++iregion) {
+    ConfigRegionId region = module_manager.add_config_region(module);
+    size_t num_region_children = reader.get<uint32_t>();
+    for (size_t ichild = 0; ichild < num_region_children; ++ichild) {
+      size_t config_child_id = reader.get<uint32_t>();
+      if ( (false == reader.good())
+        || (config_child_id >= config_children.size()) ) {
+        return false;
+      }
+      module_manager.add_configurable_child_to_region(module, region,
+                                                      config_children[config_child_id],
+                                                      config_child_instances[config_child_id],
+                                                      config_child_id);
+    }
+  }
+
+  size_t num_nets = reader.get<uint32_t>();
+  if (false == reader.good()) {
+    return false;
+  }
+  module_manager.reserve_module_nets(module, num_nets);
+  for (size_t inet = 0; inet < num_nets; ++inet) {
+    ModuleNetId net = module_manager.create_module_net(module);
+    std::string net_name = reader.get<std::string>();
+    if (false == reader.good()) {
+      return false;
+    }
+    if (false == net_name.empty()) {
+      module_manager.set_net_name(module, net, net_name);
+    }
+
+    size_t num_sources = reader.get<uint32_t>();
+    if (false == reader.good()) {
+      return false;
+    }
+    module_manager.reserve_module_net_sources(module, net, num_sources);
+    for (size_t isrc = 0; isrc < num_sources; ++isrc) {
+      ModuleId src_module;
+      size_t src_instance;
+      ModulePortId src_port;
+      size_t src_pin;
+      if (false == read_net_terminal_from_cache(reader, module_manager, module,
+                                                src_module, src_instance, src_port, src_pin)) {
+        return false;
+      }
+      module_manager.add_module_net_source(module, net, src_module, src_instance, src_port, src_pin);
+    }
+
+    size_t num_sinks = reader.get<uint32_t>();
+    if (false == reader.good()) {
+      return false;
+    }
+    module_manager.reserve_module_net_sinks(module, net, num_sinks);
+    for (size_t isink = 0; isink < num_sinks; ++isink) {
+      ModuleId sink_module;
+      size_t sink_instance;
+      ModulePortId sink_port;
+      size_t sink_pin;
+      if (false == read_net_terminal_from_cache(reader, module_manager, module,
+                                                sink_module, sink_instance, sink_port, sink_pin)) {
+        return false;
+      }
+      module_manager.add_module_net_sink(module, net, sink_module, sink_instance, sink_port, sink_pin);
+    }
+  }
+
+  return true;
+}
+
+/***************************************************************************************
+ * Decode the module graph
+ * Return false if the cache is corrupted
+ ***************************************************************************************/
+static
+bool read_module_manager_from_cache(BinaryReader& reader,
+                                    ModuleManager& module_manager) {
+  /* Modules */
+  size_t num_modules = reader.get<uint32_t>();
+  if (false == reader.good()) {
+    return false;
+  }
+  for (size_t imodule = 0; imodule < num_modules; ++imodule) {
+    std::string module_name = reader.get<std::string>();
+    size_t usage = reader.get<uint8_t>();
+    if ( (false == reader.good())
+      || (ModuleManager::NUM_MODULE_USAGE_TYPES < usage) ) {
+      return false;
+    }
+    ModuleId module = module_manager.add_module(module_name);
+    if (ModuleId(imodule) != module) {
+      return false;
+    }
+    if (ModuleManager::NUM_MODULE_USAGE_TYPES != usage) {
+      module_manager.set_module_usage(module, ModuleManager::e_module_usage_type(usage));
+    }
+  }
+
+  /* Ports of each module, which should be in place before any instance is added */
+  for (const ModuleId& module : module_manager.modules()) {
+    size_t num_ports = reader.get<uint32_t>();
+    if (false == reader.good()) {
+      return false;
+    }
+    for (size_t iport = 0; iport < num_ports; ++iport) {
+      std::string port_name = reader.get<std::string>();
+      size_t lsb = reader.get<uint32_t>();
+      size_t msb = reader.get<uint32_t>();
+      size_t origin_port_width = reader.get<uint64_t>();
+      size_t port_type = reader.get<uint8_t>();
+      uint8_t flags = reader.get<uint8_t>();
+      std::string preproc_flag = reader.get<std::string>();
+      if ( (false == reader.good())
+        || (lsb > msb)
+        || (ModuleManager::NUM_MODULE_PORT_TYPES <= port_type) ) {
+        return false;
+      }
+      BasicPort port_info(port_name, lsb, msb);
+      port_info.set_origin_port_width(origin_port_width);
+      ModulePortId port = module_manager.add_port(module, port_info, ModuleManager::e_module_port_type(port_type));
+      if (ModulePortId(iport) != port) {
+        return false;
+      }
+      if (0 != (flags & FABRIC_CACHE_PORT_IS_WIRE)) {
+        module_manager.set_port_is_wire(module, port_name, true);
+      }
+      if (0 != (flags & FABRIC_CACHE_PORT_IS_MAPPABLE_IO)) {
+        module_manager.set_port_is_mappable_io(module, port, true);
+      }
+      if (0 != (flags & FABRIC_CACHE_PORT_IS_REGISTER)) {
+        module_manager.set_port_is_register(module, port_name, true);
+      }
+      if (false == preproc_flag.empty()) {
+        module_manager.set_port_preproc_flag(module, port, preproc_flag);
+      }
+    }
+  }
+
+  /* Children and nets of each module */
+  for (const ModuleId& module : module_manager.modules()) {
+    if (false == read_module_graph_from_cache(reader, module_manager, module)) {
+      return false;
+    }
+  }
+
+  /* Merged modules */
+  for (const ModuleId& module : module_manager.modules()) {
+    size_t merged_module = reader.get<uint32_t>();
+    if (false == reader.good()) {
+      return false;
+    }
+    if (FABRIC_CACHE_INVALID_ID == merged_module) {
+      continue;
+    }
+    if ( (num_modules <= merged_module)
+      || (module == ModuleId(merged_module))
+      || (true == module_manager.valid_module_id(module_manager.merged_module(ModuleId(merged_module)))) ) {
+      return false;
+    }
+    module_manager.merge_module(module, ModuleId(merged_module));
+  }
+
+  return true;
+}
+
+/***************************************************************************************
+ * Decode the module graph and the decoder library from a cache,
+ * which can be embedded in other files, e.g., a checkpoint of OpenFPGA context
+ * The module graph and the decoder library are updated only when the whole cache
+ * is decoded successfully
+ *
+ * Return:
+ *  - 0 if succeed
+ *  - 1 if the cache does not match the architecture or is corrupted
+ ***************************************************************************************/
+int decode_fabric_cache(BinaryReader& reader,
+                        const std::string& arch_hash,
+                        ModuleManager& module_manager,
+                        DecoderLibrary& decoder_lib) {
+  std::string magic = reader.get<std::string>();
+  uint32_t version = reader.get<uint32_t>();
+  std::string cached_arch_hash = reader.get<std::string>();
+  if ( (false == reader.good())
+    || (std::string(FABRIC_CACHE_MAGIC) != magic)
+    || (FABRIC_CACHE_VERSION != version)
+    || (arch_hash != cached_arch_hash) ) {
+    return 1;
+  }
+
+  DecoderLibrary cached_decoder_lib;
+  ModuleManager cached_module_manager;
+  if ( (false == read_decoder_library_from_cache(reader, cached_decoder_lib))
+    || (false == read_module_manager_from_cache(reader, cached_module_manager)) ) {
+    return 1;
+  }
+
+  decoder_lib = std::move(cached_decoder_lib);
+  module_manager = std::move(cached_module_manager);
+
+  return 0;
+}
+
+/***************************************************************************************
+ * Encode the module graph and the decoder library to a cache
+ ***************************************************************************************/
+void encode_fabric_cache(BinaryWriter& writer,
+                         const std::string& arch_hash,
+                         const ModuleManager& module_manager,
+                         const DecoderLibrary& decoder_lib) {
+  writer(std::string(FABRIC_CACHE_MAGIC), FABRIC_CACHE_VERSION, arch_hash);
+
+  write_decoder_library_to_cache(writer, decoder_lib);
+  write_module_manager_to_cache(writer, module_manager);
+}
+
+/***************************************************************************************
+ * Load the module graph and the decoder library from a cache file
+ * The module graph and the decoder library are updated only when the whole cache
+ * is decoded successfully
+ *
+ * Return:
+ *  - 0 if succeed
+ *  - 1 if the cache is missing or does not match the architecture
+ ***************************************************************************************/
+int read_fabric_cache(const std::string& fname,
+                      const std::string& arch_hash,
+                      ModuleManager& module_manager,
+                      DecoderLibrary& decoder_lib,
+                      const bool& verbose) {
+  std::ifstream fp(fname, std::ifstream::in | std::ifstream::binary);
+  if (false == fp.is_open()) {
+    VTR_LOGV(verbose,
+             "No cache of fabric found at '%s'\n",
+             fname.c_str());
+    return 1;
+  }
+
+  vtr::ScopedStartFinishTimer timer("Read fabric from cache '" + fname + "'");
+
+  BinaryReader reader(fp);
+  if ( (0 != decode_fabric_cache(reader, arch_hash, module_manager, decoder_lib))
+    || (false == reader.at_end()) ) {
+    VTR_LOG_WARN("Cache '%s' does not match the architecture or is corrupted, and is ignored\n",
+                 fname.c_str());
+    return 1;
+  }
+
+  VTR_LOGV(verbose,
+           "Loaded %lu modules and %lu decoders from cache '%s'\n",
+           module_manager.num_modules(), decoder_lib.decoders().size(), fname.c_str());
+
+  return 0;
+}
+
+/***************************************************************************************
+ * Save the module graph and the decoder library to a cache file
+ * The cache is written to a temporary file and then renamed, so that concurrent runs
+ * sharing the same cache never see a partial file
+ *
+ * Return:
+ *  - 0 if succeed
+ *  - 1 if critical errors occured
+ ***************************************************************************************/
+int write_fabric_cache(const std::string& fname,
+                       const std::string& arch_hash,
+                       const ModuleManager& module_manager,
+                       const DecoderLibrary& decoder_lib,
+                       const bool& verbose) {
+  vtr::ScopedStartFinishTimer timer("Write fabric to cache '" + fname + "'");
+
+  /* Use a random suffix for the temporary file to avoid conflicts between concurrent runs */
+  std::random_device rand_dev;
+  std::string tmp_fname = fname + std::string(".tmp") + std::to_string(rand_dev());
+
+  std::fstream fp;
+  fp.open(tmp_fname, std::fstream::out | std::fstream::trunc | std::fstream::binary);
+  if (false == fp.is_open()) {
+    /* The cache directory may not exist yet, create it and try again */
+    create_directory(find_path_dir_name(fname));
+    fp.open(tmp_fname, std::fstream::out | std::fstream::trunc | std::fstream::binary);
+  }
+  if (false == fp.is_open()) {
+    VTR_LOG_ERROR("Fail to open cache file '%s'!\n",
+                  tmp_fname.c_str());
+    return 1;
+  }
+
+  BinaryWriter writer(fp);
+  encode_fabric_cache(writer, arch_hash, module_manager, decoder_lib);
+  bool written = writer.good();
+  fp.close();
+  if (false == written) {
+    VTR_LOG_ERROR("Fail to write cache file '%s'!\n",
+                  tmp_fname.c_str());
+    std::remove(tmp_fname.c_str());
+    return 1;
+  }
+
+  if (0 != std::rename(tmp_fname.c_str(), fname.c_str())) {
+    VTR_LOG_ERROR("Fail to rename cache file '%s' to '%s'!\n",
+                  tmp_fname.c_str(), fname.c_str());
+    std::remove(tmp_fname.c_str());
+    return 1;
+  }
+
+  VTR_LOGV(verbose,
+           "Saved %lu modules and %lu decoders to cache '%s'\n",
+           module_manager.num_modules(), decoder_lib.decoders().size(), fname.c_str());
+
+  return 0;
+}
+
+} /* end namespace openfpga */
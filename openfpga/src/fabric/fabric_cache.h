@@ -0,0 +1,51 @@
+#ifndef FABRIC_CACHE_H
+#define FABRIC_CACHE_H
+
+/********************************************************************
+ * Include header files that are required by function declaration
+ *******************************************************************/
+#include <string>
+#include "vpr_context.h"
+#include "openfpga_arch.h"
+#include "module_manager.h"
+#include "decoder_library.h"
+#include "openfpga_binary_io.h"
+
+/********************************************************************
+ * Function declaration
+ *******************************************************************/
+
+/* begin namespace openfpga */
+namespace openfpga {
+
+std::string compute_fabric_cache_arch_hash(const std::string& cache_fname,
+                                           const DeviceContext& device_ctx,
+                                           const Arch& openfpga_arch,
+                                           const std::string& build_options,
+                                           const std::string& fabric_key_fname);
+
+int decode_fabric_cache(BinaryReader& reader,
+                        const std::string& arch_hash,
+                        ModuleManager& module_manager,
+                        DecoderLibrary& decoder_lib);
+
+void encode_fabric_cache(BinaryWriter& writer,
+                         const std::string& arch_hash,
+                         const ModuleManager& module_manager,
+                         const DecoderLibrary& decoder_lib);
+
+int read_fabric_cache(const std::string& fname,
+                      const std::string& arch_hash,
+                      ModuleManager& module_manager,
+                      DecoderLibrary& decoder_lib,
+                      const bool& verbose);
+
+int write_fabric_cache(const std::string& fname,
+                       const std::string& arch_hash,
+                       const ModuleManager& module_manager,
+                       const DecoderLibrary& decoder_lib,
+                       const bool& verbose);
+
+} /* end namespace openfpga */
+
+#endif
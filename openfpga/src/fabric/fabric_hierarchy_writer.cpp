@@ -1,6 +1,10 @@
 /***************************************************************************************
  * Output internal structure of Module Graph hierarchy to file formats
  ***************************************************************************************/
+#include <map>
+#include <set>
+#include <string>
+
 /* Headers from vtrutil library */
 #include "vtr_log.h"
 #include "vtr_assert.h"
@@ -17,33 +21,49 @@
 namespace openfpga {
 
 /***************************************************************************************
- * Recursively output child module of the parent_module to a text file
+ * Recursively output child module of the parent_module to a text buffer
  * We use Depth-First Search (DFS) here so that we can output a tree down to leaf first
  * Add space (indent) based on the depth in hierarchy
  * e.g. depth = 1 means a space as indent
+ *
+ * A module appears many times in a fabric, e.g., the grid tiles, 
+ * while its subtree is the same at the same depth.
+ * - In the default mode, the subtree of each module at each depth is generated 
+ *   only once and then copied from a cache for the other instances
+ * - In the compact mode, the subtree of each module is output only once, 
+ *   with an anchor, while the other instances refer to it with a YAML alias.
+ *   When the hierarchy is cut at a given depth, the subtree also depends on
+ *   the depth of the module, which is then a part of the anchor name
  ***************************************************************************************/
 static 
-int rec_output_module_hierarchy_to_text_file(std::fstream& fp,
-                                             const size_t& hie_depth_to_stop,
-                                             const size_t& current_hie_depth,
-                                             const ModuleManager& module_manager,  
-                                             const ModuleId& parent_module,
-                                             const bool& verbose) {
+int rec_output_module_hierarchy_to_text_buffer(std::string& buffer,
+                                               const size_t& hie_depth_to_stop,
+                                               const size_t& current_hie_depth,
+                                               const ModuleManager& module_manager,  
+                                               const ModuleId& parent_module,
+                                               const bool& compact,
+                                               std::map<std::pair<ModuleId, size_t>, std::string>& subtree_cache,
+                                               std::set<std::pair<ModuleId, size_t>>& anchored_subtrees,
+                                               const bool& verbose) {
   /* Stop if hierarchy depth is beyond the stop line */
   if (hie_depth_to_stop < current_hie_depth) {
     return 0;
   }
 
-  if (false == valid_file_stream(fp)) {
-    return 2;
+  /* Reuse the subtree if it has been generated at the same depth */
+  std::pair<ModuleId, size_t> subtree_key(parent_module, current_hie_depth);
+  if (false == compact) {
+    auto cache_result = subtree_cache.find(subtree_key);
+    if (cache_result != subtree_cache.end()) {
+      buffer += cache_result->second;
+      return 0;
+    }
   }
 
+  std::string subtree;
+
   /* Iterate over all the child module */
   for (const ModuleId& child_module : module_manager.child_modules(parent_module)) {
-    if (false == write_space_to_file(fp, current_hie_depth * 2)) {
-      return 2;
-    }
-
     if (true != module_manager.valid_module_id(child_module)) {
       VTR_LOGV_ERROR(verbose,
                      "Unable to find the child module '%u'!\n",
@@ -51,30 +71,58 @@ int rec_output_module_hierarchy_to_text_file(std::fstream& fp,
       return 1;
     }
 
-    fp << "- ";
-    fp << module_manager.module_name(child_module);
+    subtree.append(current_hie_depth * 2, ' ');
+    subtree += "- ";
+    subtree += module_manager.module_name(child_module);
 
     /* If this is the leaf node, we leave a new line 
      * Otherwise, we will leave a ':' to be compatible to YAML file format 
      */
-    if ( (0 != module_manager.child_modules(child_module).size())
-      && (hie_depth_to_stop >= current_hie_depth + 1) ) {
-      fp << ":";
+    bool expand_child = (0 != module_manager.child_modules(child_module).size())
+                     && (hie_depth_to_stop >= current_hie_depth + 1);
+    if (false == expand_child) {
+      subtree += "\n";
+      continue;
     }
-    fp << "\n";
+    subtree += ":";
+
+    if (true == compact) {
+      /* Without a depth limit, the subtree of a module is the same at any depth */
+      std::pair<ModuleId, size_t> anchor_key(child_module, 0);
+      std::string anchor_name = module_manager.module_name(child_module);
+      if (size_t(-1) != hie_depth_to_stop) {
+        anchor_key.second = current_hie_depth;
+        anchor_name += std::string("_depth") + std::to_string(current_hie_depth);
+      }
+      if (0 < anchored_subtrees.count(anchor_key)) {
+        subtree += " *" + anchor_name + "\n";
+        continue;
+      }
+      anchored_subtrees.insert(anchor_key);
+      subtree += " &" + anchor_name;
+    }
+    subtree += "\n";
 
     /* Go to next level */
-    int status = rec_output_module_hierarchy_to_text_file(fp,
-                                                          hie_depth_to_stop,
-                                                          current_hie_depth + 1, /* Increment the depth for the next level */
-                                                          module_manager,
-                                                          child_module,
-                                                          verbose);
+    int status = rec_output_module_hierarchy_to_text_buffer(subtree,
+                                                            hie_depth_to_stop,
+                                                            current_hie_depth + 1, /* Increment the depth for the next level */
+                                                            module_manager,
+                                                            child_module,
+                                                            compact,
+                                                            subtree_cache,
+                                                            anchored_subtrees,
+                                                            verbose);
     if (0 != status) {
       return status;
     }
   }
 
+  buffer += subtree;
+  if (false == compact) {
+    subtree_cache[subtree_key] = subtree;
+  }
+
   return 0;
 }
 
@@ -86,6 +134,8 @@ int rec_output_module_hierarchy_to_text_file(std::fstream& fp,
  *        ...
  * This file is mainly used by hierarchical P&R flow 
  *
+ * The hierarchy is generated in a buffer and then written to the file at once
+ *
  * Return 0 if successful
  * Return 1 if there are more serious bugs in the architecture 
  * Return 2 if fail when creating files
@@ -93,6 +143,7 @@ int rec_output_module_hierarchy_to_text_file(std::fstream& fp,
 int write_fabric_hierarchy_to_text_file(const ModuleManager& module_manager,
                                         const std::string& fname,
                                         const size_t& hie_depth_to_stop,
+                                        const bool& compact,
                                         const bool& verbose) {
   std::string timer_message = std::string("Write fabric hierarchy to plain-text file '") + fname + std::string("'");
 
@@ -135,12 +186,25 @@ int write_fabric_hierarchy_to_text_file(const ModuleManager& module_manager,
   fp << top_module_name << ":" << "\n";
 
   /* Visit child module recursively and output the hierarchy */
-  int err_code = rec_output_module_hierarchy_to_text_file(fp,
-                                                          hie_depth_to_stop,
-                                                          hie_depth + 1, /* Start with level 1 */
-                                                          module_manager,  
-                                                          top_module,
-                                                          verbose);
+  std::string buffer;
+  std::map<std::pair<ModuleId, size_t>, std::string> subtree_cache;
+  std::set<std::pair<ModuleId, size_t>> anchored_subtrees;
+  int err_code = rec_output_module_hierarchy_to_text_buffer(buffer,
+                                                            hie_depth_to_stop,
+                                                            hie_depth + 1, /* Start with level 1 */
+                                                            module_manager,  
+                                                            top_module,
+                                                            compact,
+                                                            subtree_cache,
+                                                            anchored_subtrees,
+                                                            verbose);
+
+  if (0 == err_code) {
+    fp << buffer;
+    if (false == valid_file_stream(fp)) {
+      err_code = 2;
+    }
+  }
 
   /* close a file */
   fp.close();
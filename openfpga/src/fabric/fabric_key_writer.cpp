@@ -9,8 +9,8 @@
 /* Headers from openfpgautil library */
 #include "openfpga_digest.h"
 
-/* Headers from archopenfpga library */
-#include "write_xml_fabric_key.h"
+/* Headers from fabrickey library */
+#include "fabric_key_stream_writer.h"
 
 #include "openfpga_naming.h"
 
@@ -20,17 +20,21 @@
 namespace openfpga {
 
 /***************************************************************************************
- * Write the fabric key of top module to an XML file
+ * Write the fabric key of top module to a file in the given format
+ * The keys are streamed to the file while visiting the configurable children,
+ * rather than collected in a FabricKey, as secure fabrics
+ * may have millions of configurable children
  * We will use the writer API in libfabrickey
  *
  * Return 0 if successful
  * Return 1 if there are more serious bugs in the architecture 
  * Return 2 if fail when creating files
  ***************************************************************************************/
-int write_fabric_key_to_xml_file(const ModuleManager& module_manager,
-                                 const std::string& fname,
-                                 const bool& verbose) {
-  std::string timer_message = std::string("Write fabric key to XML file '") + fname + std::string("'");
+int write_fabric_key_to_file(const ModuleManager& module_manager,
+                             const std::string& fname,
+                             const e_fabric_key_format& format,
+                             const bool& verbose) {
+  std::string timer_message = std::string("Write fabric key to ") + std::string(FABRIC_KEY_FORMAT_STRING[format]) + std::string(" file '") + fname + std::string("'");
 
   std::string dir_path = format_dir_path(find_path_dir_name(fname));
 
@@ -53,45 +57,37 @@ int write_fabric_key_to_xml_file(const ModuleManager& module_manager,
     return 1;
   }
   
-  /* Build a fabric key database by visiting all the configurable children */
-  FabricKey fabric_key;
   size_t num_keys = module_manager.configurable_children(top_module).size(); 
-
-  fabric_key.reserve_keys(num_keys);
-
   size_t num_regions = module_manager.regions(top_module).size();
-  fabric_key.reserve_regions(num_regions);
-
-  /* Create regions for the keys and load keys by region */
-  for (const ConfigRegionId& config_region : module_manager.regions(top_module)) {
-    FabricRegionId fabric_region = fabric_key.create_region();
-    fabric_key.reserve_region_keys(fabric_region, module_manager.region_configurable_children(top_module, config_region).size());
-
-    for (size_t ichild = 0; ichild < module_manager.region_configurable_children(top_module, config_region).size(); ++ichild) {
-      ModuleId child_module = module_manager.region_configurable_children(top_module, config_region)[ichild];
-      size_t child_instance = module_manager.region_configurable_child_instances(top_module, config_region)[ichild];
 
-      FabricKeyId key = fabric_key.create_key();
-      fabric_key.set_key_name(key, module_manager.module_name(child_module));
-      fabric_key.set_key_value(key, child_instance);
+  FabricKeyStreamWriter writer(fname, format, num_regions, num_keys);
 
-      if (false == module_manager.instance_name(top_module, child_module, child_instance).empty()) {
-        fabric_key.set_key_alias(key, module_manager.instance_name(top_module, child_module, child_instance));
-      }
-
-      /* Add keys to the region */
-      fabric_key.add_key_to_region(fabric_region, key);
+  /* Write the keys region by region, where the keys are numbered in sequence */
+  size_t curr_key = 0;
+  for (const ConfigRegionId& config_region : module_manager.regions(top_module)) {
+    std::vector<ModuleId> region_children = module_manager.region_configurable_children(top_module, config_region);
+    std::vector<size_t> region_child_instances = module_manager.region_configurable_child_instances(top_module, config_region);
+    writer.begin_region(region_children.size());
+
+    for (size_t ichild = 0; ichild < region_children.size(); ++ichild) {
+      ModuleId child_module = region_children[ichild];
+      size_t child_instance = region_child_instances[ichild];
+
+      writer.write_key(curr_key,
+                       module_manager.module_name(child_module),
+                       child_instance,
+                       module_manager.instance_name(top_module, child_module, child_instance));
+      ++curr_key;
     }
+
+    writer.end_region();
   }
 
   VTR_LOGV(verbose,
-           "Created %lu regions and %lu keys for the top module %s.\n",
-           num_regions, num_keys, top_module_name.c_str());
-
-  /* Call the XML writer for fabric key */
-  int err_code = write_xml_fabric_key(fname.c_str(), fabric_key);
+           "Wrote %lu regions and %lu keys for the top module %s.\n",
+           num_regions, curr_key, top_module_name.c_str());
 
-  return err_code;
+  return writer.finish();
 }
 
 } /* end namespace openfpga */
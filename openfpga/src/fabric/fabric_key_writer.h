@@ -6,6 +6,7 @@
  *******************************************************************/
 #include "vpr_context.h"
 #include "openfpga_context.h"
+#include "fabric_key_stream_writer.h"
 
 /********************************************************************
  * Function declaration
@@ -14,9 +15,10 @@
 /* begin namespace openfpga */
 namespace openfpga {
 
-int write_fabric_key_to_xml_file(const ModuleManager& module_manager,
-                                 const std::string& fname,
-                                 const bool& verbose);
+int write_fabric_key_to_file(const ModuleManager& module_manager,
+                             const std::string& fname,
+                             const e_fabric_key_format& format,
+                             const bool& verbose);
 
 } /* end namespace openfpga */
 
@@ -4,9 +4,13 @@
 #include <string>
 #include <numeric>
 #include <algorithm>
+#include <limits>
 #include "vtr_assert.h"
 #include "vtr_log.h"
 
+#include "openfpga_memory_usage.h"
+#include "openfpga_hot_path_counters.h"
+
 #include "circuit_library.h"
 #include "module_manager.h"
 
@@ -41,25 +45,26 @@ ModuleManager::module_net_range ModuleManager::module_nets(const ModuleId& modul
 }
 
 /* Find all the child modules under a parent module */
-std::vector<ModuleId> ModuleManager::child_modules(const ModuleId& parent_module) const {
+const vtr::small_vector<ModuleId>& ModuleManager::child_modules(const ModuleId& parent_module) const {
   /* Validate the module_id */
   VTR_ASSERT(valid_module_id(parent_module));
   return children_[parent_module];
 }
 
+/* Find all the parent modules which include a child module */
+const vtr::small_vector<ModuleId>& ModuleManager::parent_modules(const ModuleId& child_module) const {
+  /* Validate the module_id */
+  VTR_ASSERT(valid_module_id(child_module));
+  return parents_[child_module];
+}
+
 /* Find all the instances under a parent module */
 std::vector<size_t> ModuleManager::child_module_instances(const ModuleId& parent_module, const ModuleId& child_module) const {
   /* Validate the module_id */
   VTR_ASSERT(valid_module_id(parent_module));
   /* Ensure that the child module is in the child list of parent module */
-  size_t child_index = children_[parent_module].size();
-  for (size_t i = 0; i < children_[parent_module].size(); ++i) {
-    if (child_module == children_[parent_module][i]) {
-      child_index = i;
-      break;
-    } 
-  }
-  VTR_ASSERT(child_index != children_[parent_module].size());
+  size_t child_index = find_child_module_index_in_parent_module(parent_module, child_module);
+  VTR_ASSERT(size_t(-1) != child_index);
   
   /* Create a vector, with sequentially increasing numbers */
   std::vector<size_t> instance_range(num_child_instances_[parent_module][child_index], 0);
@@ -69,7 +74,7 @@ std::vector<size_t> ModuleManager::child_module_instances(const ModuleId& parent
 }
 
 /* Find all the configurable child modules under a parent module */
-std::vector<ModuleId> ModuleManager::configurable_children(const ModuleId& parent_module) const {
+const std::vector<ModuleId>& ModuleManager::configurable_children(const ModuleId& parent_module) const {
   /* Validate the module_id */
   VTR_ASSERT(valid_module_id(parent_module));
 
@@ -77,7 +82,7 @@ std::vector<ModuleId> ModuleManager::configurable_children(const ModuleId& paren
 }
 
 /* Find all the instances of configurable child modules under a parent module */
-std::vector<size_t> ModuleManager::configurable_child_instances(const ModuleId& parent_module) const {
+const std::vector<size_t>& ModuleManager::configurable_child_instances(const ModuleId& parent_module) const {
   /* Validate the module_id */
   VTR_ASSERT(valid_module_id(parent_module));
 
@@ -88,14 +93,16 @@ std::vector<size_t> ModuleManager::configurable_child_instances(const ModuleId&
 ModuleManager::module_net_src_range ModuleManager::module_net_sources(const ModuleId& module, const ModuleNetId& net) const {
   /* Validate the module_id */
   VTR_ASSERT(valid_module_net_id(module, net));
-  return vtr::make_range(net_src_ids_[module][net].begin(), net_src_ids_[module][net].end());
+  return vtr::make_range(module_net_src_iterator(ModuleNetSrcId(0)),
+                         module_net_src_iterator(ModuleNetSrcId(num_net_sources(module, net))));
 }
 
 /* Find the sink ids of modules */
 ModuleManager::module_net_sink_range ModuleManager::module_net_sinks(const ModuleId& module, const ModuleNetId& net) const {
   /* Validate the module_id */
   VTR_ASSERT(valid_module_net_id(module, net));
-  return vtr::make_range(net_sink_ids_[module][net].begin(), net_sink_ids_[module][net].end());
+  return vtr::make_range(module_net_sink_iterator(ModuleNetSinkId(0)),
+                         module_net_sink_iterator(ModuleNetSinkId(num_net_sinks(module, net))));
 }
 
 ModuleManager::region_range ModuleManager::regions(const ModuleId& module) const {
@@ -163,6 +170,12 @@ ModuleManager::e_module_usage_type ModuleManager::module_usage(const ModuleId& m
   return usages_[module_id];
 }
 
+ModuleId ModuleManager::merged_module(const ModuleId& module_id) const {
+  /* Validate the module_id */
+  VTR_ASSERT(valid_module_id(module_id));
+  return merged_modules_[module_id];
+}
+
 /* Get the string of a module port type */
 std::string ModuleManager::module_port_type_str(const enum e_module_port_type& port_type) const {
   std::array<const char*, NUM_MODULE_PORT_TYPES> MODULE_PORT_TYPE_STRING = {{"GLOBAL PORTS", "GPIN PORTS", "GPOUT PORTS", "GPIO PORTS", "INOUT PORTS", "INPUT PORTS", "OUTPUT PORTS", "CLOCK PORTS"}};
@@ -208,13 +221,13 @@ std::vector<ModulePortId> ModuleManager::module_port_ids_by_type(const ModuleId&
 ModulePortId ModuleManager::find_module_port(const ModuleId& module_id, const std::string& port_name) const {
   /* Validate the module id */
   VTR_ASSERT(valid_module_id(module_id));
+  OPENFPGA_COUNT_HOT_PATH_CALL(HOT_PATH_FIND_MODULE_PORT);
 
-  /* Iterate over the ports of the module */
-  for (const auto& port : port_ids_[module_id]) {
-    if (0 == port_name.compare(ports_[module_id][port].get_name())) {
-      /* Find it, return the id */
-      return port; 
-    }
+  const auto& result = port_name_lookup_[module_id].find(port_name);
+  if (result != port_name_lookup_[module_id].end()) {
+    /* Find it, return the id */
+    OPENFPGA_COUNT_HOT_PATH_HIT(HOT_PATH_FIND_MODULE_PORT);
+    return result->second; 
   }
   /* Not found, return an invalid id */
   return ModulePortId::INVALID();
@@ -274,16 +287,15 @@ size_t ModuleManager::instance_id(const ModuleId& parent_module, const ModuleId&
   size_t child_index = find_child_module_index_in_parent_module(parent_module, child_module);
   VTR_ASSERT (child_index < children_[parent_module].size());
 
-  /* Search the instance name list and try to find a match */
-  for (size_t name_id = 0; name_id < child_instance_names_[parent_module][child_index].size(); ++name_id) {
-    const std::string& name = child_instance_names_[parent_module][child_index][name_id];
-    if (0 == name.compare(instance_name)) {
-      return name_id;
-    }
+  /* Search the fast look-up of instance names and try to find a match */
+  const std::unordered_map<std::string, size_t>& name_lookup = child_instance_name_lookup_[parent_module][child_index];
+  std::unordered_map<std::string, size_t>::const_iterator result = name_lookup.find(instance_name);
+  if (result == name_lookup.end()) {
+    /* Not found, return an invalid name */
+    return size_t(-1);
   }
-  
-  /* Not found, return an invalid name */
-  return size_t(-1);
+
+  return result->second;
 }
 
 ModuleManager::e_module_port_type ModuleManager::port_type(const ModuleId& module, const ModulePortId& port) const {
@@ -343,8 +355,29 @@ ModuleNetId ModuleManager::module_instance_port_net(const ModuleId& parent_modul
 
   /* Validate child_pin */
   VTR_ASSERT(child_pin < module_port(child_module, child_port).get_width());
+  OPENFPGA_COUNT_HOT_PATH_CALL(HOT_PATH_MODULE_INSTANCE_PORT_NET);
   
-  return net_lookup_[parent_module][child_module][child_instance][child_port][child_pin];
+#ifdef OPENFPGA_USE_FLAT_NET_LOOKUP
+  ModuleNetId net = net_lookup_entry(parent_module, child_module, child_instance, child_port, child_pin);
+  if (ModuleNetId::INVALID() != net) {
+    OPENFPGA_COUNT_HOT_PATH_HIT(HOT_PATH_MODULE_INSTANCE_PORT_NET);
+  }
+  return net;
+#else
+  /* Use only read-only look-ups on the maps, so that concurrent readers are safe
+   * Pins of a port are allocated when the first net is connected to the port,
+   * so a port which is not found has no nets
+   */
+  const std::map<ModulePortId, std::vector<ModuleNetId>>& port_nets = net_lookup_[parent_module].at(child_module)[child_instance];
+  std::map<ModulePortId, std::vector<ModuleNetId>>::const_iterator result = port_nets.find(child_port);
+  if (result == port_nets.end()) {
+    return ModuleNetId::INVALID();
+  }
+  if (ModuleNetId::INVALID() != result->second[child_pin]) {
+    OPENFPGA_COUNT_HOT_PATH_HIT(HOT_PATH_MODULE_INSTANCE_PORT_NET);
+  }
+  return result->second[child_pin];
+#endif
 }
 
 /* Find the name of net */
@@ -352,7 +385,81 @@ std::string ModuleManager::net_name(const ModuleId& module, const ModuleNetId& n
   /* Validate module net */
   VTR_ASSERT(valid_module_net_id(module, net));
 
-  return net_names_[module][net];
+  uint32_t name_id = net_name_ids_[module][net];
+  if (0 == name_id) {
+    return std::string();
+  }
+  return net_name_pool_[name_id - 1];
+}
+
+/* Find the name of the wire of a net, which is built from its source if the net has no name */
+std::string ModuleManager::net_wire_name(const ModuleId& module, const ModuleNetId& net) const {
+  std::string wire_name = net_name(module, net);
+  if (false == wire_name.empty()) {
+    return wire_name;
+  }
+
+  VTR_ASSERT(0 < num_net_sources(module, net));
+  ModuleId src_module = net_source_module(module, net, ModuleNetSrcId(0));
+  size_t src_instance = net_source_instance(module, net, ModuleNetSrcId(0));
+  ModulePortId src_port = net_source_port(module, net, ModuleNetSrcId(0));
+
+  wire_name = module_name(src_module);
+  wire_name += std::string("_") + std::to_string(src_instance) + std::string("_");
+  wire_name += module_port(src_module, src_port).get_name();
+  return wire_name;
+}
+
+/* Find the source module of a net */
+ModuleId ModuleManager::net_source_module(const ModuleId& module, const ModuleNetId& net, const ModuleNetSrcId& net_src) const {
+  return net_terminal_storage_[net_source_terminal_id(module, net, net_src)].first;
+}
+
+/* Find the id of the source instance of a net */
+size_t ModuleManager::net_source_instance(const ModuleId& module, const ModuleNetId& net, const ModuleNetSrcId& net_src) const {
+  if (true == net_frozen_[module]) {
+    return net_src_csr_[module].instance_ids[net_src_csr_[module].offsets[size_t(net)] + size_t(net_src)];
+  }
+  return net_src_instance_ids_[module][net][net_src];
+}
+
+/* Find the source port of a net */
+ModulePortId ModuleManager::net_source_port(const ModuleId& module, const ModuleNetId& net, const ModuleNetSrcId& net_src) const {
+  return net_terminal_storage_[net_source_terminal_id(module, net, net_src)].second;
+}
+
+/* Find the source pin index of a net */
+size_t ModuleManager::net_source_pin(const ModuleId& module, const ModuleNetId& net, const ModuleNetSrcId& net_src) const {
+  if (true == net_frozen_[module]) {
+    return net_src_csr_[module].pin_ids[net_src_csr_[module].offsets[size_t(net)] + size_t(net_src)];
+  }
+  return net_src_pin_ids_[module][net][net_src];
+}
+
+/* Find the sink module of a net */
+ModuleId ModuleManager::net_sink_module(const ModuleId& module, const ModuleNetId& net, const ModuleNetSinkId& net_sink) const {
+  return net_terminal_storage_[net_sink_terminal_id(module, net, net_sink)].first;
+}
+
+/* Find the id of the sink instance of a net */
+size_t ModuleManager::net_sink_instance(const ModuleId& module, const ModuleNetId& net, const ModuleNetSinkId& net_sink) const {
+  if (true == net_frozen_[module]) {
+    return net_sink_csr_[module].instance_ids[net_sink_csr_[module].offsets[size_t(net)] + size_t(net_sink)];
+  }
+  return net_sink_instance_ids_[module][net][net_sink];
+}
+
+/* Find the sink port of a net */
+ModulePortId ModuleManager::net_sink_port(const ModuleId& module, const ModuleNetId& net, const ModuleNetSinkId& net_sink) const {
+  return net_terminal_storage_[net_sink_terminal_id(module, net, net_sink)].second;
+}
+
+/* Find the sink pin index of a net */
+size_t ModuleManager::net_sink_pin(const ModuleId& module, const ModuleNetId& net, const ModuleNetSinkId& net_sink) const {
+  if (true == net_frozen_[module]) {
+    return net_sink_csr_[module].pin_ids[net_sink_csr_[module].offsets[size_t(net)] + size_t(net_sink)];
+  }
+  return net_sink_pin_ids_[module][net][net_sink];
 }
 
 /* Find the source modules of a net */
@@ -361,9 +468,9 @@ vtr::vector<ModuleNetSrcId, ModuleId> ModuleManager::net_source_modules(const Mo
   VTR_ASSERT(valid_module_net_id(module, net));
 
   vtr::vector<ModuleNetSrcId, ModuleId> src_modules;
-  src_modules.reserve(net_src_terminal_ids_[module][net].size());
-  for (const size_t& id : net_src_terminal_ids_[module][net]) {
-    src_modules.push_back(net_terminal_storage_[id].first);
+  src_modules.reserve(num_net_sources(module, net));
+  for (const ModuleNetSrcId& net_src : module_net_sources(module, net)) {
+    src_modules.push_back(net_terminal_storage_[net_source_terminal_id(module, net, net_src)].first);
   }
 
   return src_modules;
@@ -374,7 +481,19 @@ vtr::vector<ModuleNetSrcId, size_t> ModuleManager::net_source_instances(const Mo
   /* Validate module net */
   VTR_ASSERT(valid_module_net_id(module, net));
 
-  return net_src_instance_ids_[module][net];
+  if (false == net_frozen_[module]) {
+    const NetSrcTerminalIds& instances = net_src_instance_ids_[module][net];
+    return vtr::vector<ModuleNetSrcId, size_t>(instances.begin(), instances.end());
+  }
+
+  const NetTerminalCsr& csr = net_src_csr_[module];
+  vtr::vector<ModuleNetSrcId, size_t> instances;
+  instances.reserve(num_net_sources(module, net));
+  for (size_t i = csr.offsets[size_t(net)]; i < csr.offsets[size_t(net) + 1]; ++i) {
+    instances.push_back(csr.instance_ids[i]);
+  }
+
+  return instances;
 }
 
 /* Find the source ports of a net */
@@ -383,9 +502,9 @@ vtr::vector<ModuleNetSrcId, ModulePortId> ModuleManager::net_source_ports(const
   VTR_ASSERT(valid_module_net_id(module, net));
 
   vtr::vector<ModuleNetSrcId, ModulePortId> src_ports;
-  src_ports.reserve(net_src_terminal_ids_[module][net].size());
-  for (const size_t& id : net_src_terminal_ids_[module][net]) {
-    src_ports.push_back(net_terminal_storage_[id].second);
+  src_ports.reserve(num_net_sources(module, net));
+  for (const ModuleNetSrcId& net_src : module_net_sources(module, net)) {
+    src_ports.push_back(net_terminal_storage_[net_source_terminal_id(module, net, net_src)].second);
   }
 
   return src_ports;
@@ -396,7 +515,19 @@ vtr::vector<ModuleNetSrcId, size_t> ModuleManager::net_source_pins(const ModuleI
   /* Validate module net */
   VTR_ASSERT(valid_module_net_id(module, net));
 
-  return net_src_pin_ids_[module][net];
+  if (false == net_frozen_[module]) {
+    const NetSrcTerminalIds& pins = net_src_pin_ids_[module][net];
+    return vtr::vector<ModuleNetSrcId, size_t>(pins.begin(), pins.end());
+  }
+
+  const NetTerminalCsr& csr = net_src_csr_[module];
+  vtr::vector<ModuleNetSrcId, size_t> pins;
+  pins.reserve(num_net_sources(module, net));
+  for (size_t i = csr.offsets[size_t(net)]; i < csr.offsets[size_t(net) + 1]; ++i) {
+    pins.push_back(csr.pin_ids[i]);
+  }
+
+  return pins;
 }
 
 /* Identify if a pin of a port in a module already exists in the net source list*/
@@ -410,11 +541,14 @@ bool ModuleManager::net_source_exist(const ModuleId& module, const ModuleNetId&
    * If a net source has the same src_module, instance_id, src_port and src_pin,
    * we can say that the source has already been added to this net!
    */
+  vtr::vector<ModuleNetSrcId, size_t> src_instances = net_source_instances(module, net);
+  vtr::vector<ModuleNetSrcId, size_t> src_pins = net_source_pins(module, net);
   for (const ModuleNetSrcId& net_src : module_net_sources(module, net)) {
-    if ( (src_module == net_terminal_storage_[net_src_terminal_ids_[module][net][net_src]].first) 
-      && (instance_id == net_source_instances(module, net)[net_src])   
-      && (src_port == net_terminal_storage_[net_src_terminal_ids_[module][net][net_src]].second) 
-      && (src_pin == net_source_pins(module, net)[net_src]) ) {
+    const std::pair<ModuleId, ModulePortId>& terminal = net_terminal_storage_[net_source_terminal_id(module, net, net_src)];
+    if ( (src_module == terminal.first) 
+      && (instance_id == src_instances[net_src])   
+      && (src_port == terminal.second) 
+      && (src_pin == src_pins[net_src]) ) {
       return true;
     }
   }
@@ -429,9 +563,9 @@ vtr::vector<ModuleNetSinkId, ModuleId> ModuleManager::net_sink_modules(const Mod
   VTR_ASSERT(valid_module_net_id(module, net));
 
   vtr::vector<ModuleNetSinkId, ModuleId> sink_modules;
-  sink_modules.reserve(net_sink_terminal_ids_[module][net].size());
-  for (const size_t& id : net_sink_terminal_ids_[module][net]) {
-    sink_modules.push_back(net_terminal_storage_[id].first);
+  sink_modules.reserve(num_net_sinks(module, net));
+  for (const ModuleNetSinkId& net_sink : module_net_sinks(module, net)) {
+    sink_modules.push_back(net_terminal_storage_[net_sink_terminal_id(module, net, net_sink)].first);
   }
 
   return sink_modules;
@@ -442,7 +576,19 @@ vtr::vector<ModuleNetSinkId, size_t> ModuleManager::net_sink_instances(const Mod
   /* Validate module net */
   VTR_ASSERT(valid_module_net_id(module, net));
 
-  return net_sink_instance_ids_[module][net];
+  if (false == net_frozen_[module]) {
+    const NetSinkTerminalIds& instances = net_sink_instance_ids_[module][net];
+    return vtr::vector<ModuleNetSinkId, size_t>(instances.begin(), instances.end());
+  }
+
+  const NetTerminalCsr& csr = net_sink_csr_[module];
+  vtr::vector<ModuleNetSinkId, size_t> instances;
+  instances.reserve(num_net_sinks(module, net));
+  for (size_t i = csr.offsets[size_t(net)]; i < csr.offsets[size_t(net) + 1]; ++i) {
+    instances.push_back(csr.instance_ids[i]);
+  }
+
+  return instances;
 }
 
 /* Find the sink ports of a net */
@@ -451,9 +597,9 @@ vtr::vector<ModuleNetSinkId, ModulePortId> ModuleManager::net_sink_ports(const M
   VTR_ASSERT(valid_module_net_id(module, net));
 
   vtr::vector<ModuleNetSinkId, ModulePortId> sink_ports;
-  sink_ports.reserve(net_sink_terminal_ids_[module][net].size());
-  for (const size_t& id : net_sink_terminal_ids_[module][net]) {
-    sink_ports.push_back(net_terminal_storage_[id].second);
+  sink_ports.reserve(num_net_sinks(module, net));
+  for (const ModuleNetSinkId& net_sink : module_net_sinks(module, net)) {
+    sink_ports.push_back(net_terminal_storage_[net_sink_terminal_id(module, net, net_sink)].second);
   }
 
   return sink_ports;
@@ -464,7 +610,19 @@ vtr::vector<ModuleNetSinkId, size_t> ModuleManager::net_sink_pins(const ModuleId
   /* Validate module net */
   VTR_ASSERT(valid_module_net_id(module, net));
 
-  return net_sink_pin_ids_[module][net];
+  if (false == net_frozen_[module]) {
+    const NetSinkTerminalIds& pins = net_sink_pin_ids_[module][net];
+    return vtr::vector<ModuleNetSinkId, size_t>(pins.begin(), pins.end());
+  }
+
+  const NetTerminalCsr& csr = net_sink_csr_[module];
+  vtr::vector<ModuleNetSinkId, size_t> pins;
+  pins.reserve(num_net_sinks(module, net));
+  for (size_t i = csr.offsets[size_t(net)]; i < csr.offsets[size_t(net) + 1]; ++i) {
+    pins.push_back(csr.pin_ids[i]);
+  }
+
+  return pins;
 }
 
 /* Identify if a pin of a port in a module already exists in the net sink list*/
@@ -478,11 +636,14 @@ bool ModuleManager::net_sink_exist(const ModuleId& module, const ModuleNetId& ne
    * If a net sink has the same sink_module, instance_id, sink_port and sink_pin,
    * we can say that the sink has already been added to this net!
    */
+  vtr::vector<ModuleNetSinkId, size_t> sink_instances = net_sink_instances(module, net);
+  vtr::vector<ModuleNetSinkId, size_t> sink_pins = net_sink_pins(module, net);
   for (const ModuleNetSinkId& net_sink : module_net_sinks(module, net)) {
-    if ( (sink_module == net_terminal_storage_[net_sink_terminal_ids_[module][net][net_sink]].first) 
-      && (instance_id == net_sink_instances(module, net)[net_sink])   
-      && (sink_port == net_terminal_storage_[net_sink_terminal_ids_[module][net][net_sink]].second) 
-      && (sink_pin == net_sink_pins(module, net)[net_sink]) ) {
+    const std::pair<ModuleId, ModulePortId>& terminal = net_terminal_storage_[net_sink_terminal_id(module, net, net_sink)];
+    if ( (sink_module == terminal.first) 
+      && (instance_id == sink_instances[net_sink])   
+      && (sink_port == terminal.second) 
+      && (sink_pin == sink_pins[net_sink]) ) {
       return true;
     }
   }
@@ -491,6 +652,168 @@ bool ModuleManager::net_sink_exist(const ModuleId& module, const ModuleNetId& ne
   return false;
 }
 
+bool ModuleManager::module_nets_frozen(const ModuleId& module) const {
+  VTR_ASSERT(valid_module_id(module));
+  return net_frozen_[module];
+}
+
+bool ModuleManager::flat_net_lookup() const {
+#ifdef OPENFPGA_USE_FLAT_NET_LOOKUP
+  return true;
+#else
+  return false;
+#endif
+}
+
+/* Estimate the memory of the nested layout, 
+ * [parent][child][instance][port][pin], where the look-ups on children and ports are maps
+ * All the pins are assumed to be allocated
+ * Each map node is assumed to cost 4 pointers on top of its key and value
+ */
+size_t ModuleManager::nested_net_lookup_memory() const {
+  const size_t map_node_overhead = 4 * sizeof(void*);
+  typedef std::map<ModulePortId, std::vector<ModuleNetId>> PortNetMap;
+
+  size_t num_bytes = 0;
+  for (const ModuleId& parent : modules()) {
+    num_bytes += sizeof(std::map<ModuleId, std::vector<PortNetMap>>);
+    /* The module itself is stored as instance 0 */
+    num_bytes += map_node_overhead + sizeof(ModuleId) + sizeof(std::vector<PortNetMap>) + sizeof(PortNetMap);
+    for (const ModulePortId& port : port_ids_[parent]) {
+      num_bytes += map_node_overhead + sizeof(ModulePortId) + sizeof(std::vector<ModuleNetId>)
+                 + ports_[parent][port].get_width() * sizeof(ModuleNetId);
+    }
+    for (size_t child_index = 0; child_index < children_[parent].size(); ++child_index) {
+      const ModuleId& child = children_[parent][child_index];
+      size_t instance_bytes = sizeof(PortNetMap);
+      for (const ModulePortId& port : port_ids_[child]) {
+        instance_bytes += map_node_overhead + sizeof(ModulePortId) + sizeof(std::vector<ModuleNetId>)
+                        + ports_[child][port].get_width() * sizeof(ModuleNetId);
+      }
+      num_bytes += map_node_overhead + sizeof(ModuleId) + sizeof(std::vector<PortNetMap>)
+                 + num_child_instances_[parent][child_index] * instance_bytes;
+    }
+  }
+
+  return num_bytes;
+}
+
+/* Measure the memory of the fast look-up for nets in the layout which is in use
+ * In the nested layout, only the pins which have been allocated are counted
+ */
+size_t ModuleManager::net_lookup_memory() const {
+#ifdef OPENFPGA_USE_FLAT_NET_LOOKUP
+  return flat_net_lookup_memory();
+#else
+  const size_t map_node_overhead = 4 * sizeof(void*);
+  typedef std::map<ModulePortId, std::vector<ModuleNetId>> PortNetMap;
+
+  size_t num_bytes = 0;
+  for (const ModuleId& parent : modules()) {
+    num_bytes += sizeof(std::map<ModuleId, std::vector<PortNetMap>>);
+    for (const auto& child_instances : net_lookup_[parent]) {
+      num_bytes += map_node_overhead + sizeof(ModuleId) + sizeof(std::vector<PortNetMap>);
+      for (const PortNetMap& port_nets : child_instances.second) {
+        num_bytes += sizeof(PortNetMap);
+        for (const auto& pin_nets : port_nets) {
+          num_bytes += map_node_overhead + sizeof(ModulePortId) + sizeof(std::vector<ModuleNetId>)
+                     + pin_nets.second.capacity() * sizeof(ModuleNetId);
+        }
+      }
+    }
+  }
+
+  return num_bytes;
+#endif
+}
+
+size_t ModuleManager::NetTerminalCsr::memory_usage() const {
+  return openfpga::memory_usage(offsets)
+       + openfpga::memory_usage(terminal_ids)
+       + openfpga::memory_usage(instance_ids)
+       + openfpga::memory_usage(pin_ids);
+}
+
+size_t ModuleManager::port_memory_usage() const {
+  return openfpga::memory_usage(port_ids_)
+       + openfpga::memory_usage(ports_)
+       + openfpga::memory_usage(port_types_)
+       + openfpga::memory_usage(port_is_mappable_io_)
+       + openfpga::memory_usage(port_is_wire_)
+       + openfpga::memory_usage(port_is_register_)
+       + openfpga::memory_usage(port_preproc_flags_)
+       + openfpga::memory_usage(port_lookup_)
+       + openfpga::memory_usage(port_name_lookup_);
+}
+
+size_t ModuleManager::net_memory_usage() const {
+  size_t num_bytes = openfpga::memory_usage(num_nets_)
+                   + openfpga::memory_usage(invalid_net_ids_)
+                   + openfpga::memory_usage(net_name_ids_)
+                   + openfpga::memory_usage(net_name_pool_)
+                   + openfpga::memory_usage(net_name_pool_lookup_)
+                   + net_arena_.memory_usage()
+                   + openfpga::memory_usage(net_src_terminal_ids_)
+                   + openfpga::memory_usage(net_src_instance_ids_)
+                   + openfpga::memory_usage(net_src_pin_ids_)
+                   + openfpga::memory_usage(net_sink_terminal_ids_)
+                   + openfpga::memory_usage(net_sink_instance_ids_)
+                   + openfpga::memory_usage(net_sink_pin_ids_)
+                   + openfpga::memory_usage(net_frozen_)
+                   + openfpga::memory_usage(net_src_csr_)
+                   + openfpga::memory_usage(net_sink_csr_)
+                   + openfpga::memory_usage(net_lookup_)
+                   + openfpga::memory_usage(net_terminal_storage_)
+                   + openfpga::memory_usage(net_terminal_lookup_);
+#ifdef OPENFPGA_USE_FLAT_NET_LOOKUP
+  num_bytes += openfpga::memory_usage(port_pin_offsets_)
+             + openfpga::memory_usage(self_net_lookup_)
+             + openfpga::memory_usage(child_instance_pin_offsets_);
+#endif
+  return num_bytes;
+}
+
+size_t ModuleManager::memory_usage() const {
+  return openfpga::memory_usage(ids_)
+       + openfpga::memory_usage(names_)
+       + openfpga::memory_usage(usages_)
+       + openfpga::memory_usage(merged_modules_)
+       + openfpga::memory_usage(parents_)
+       + openfpga::memory_usage(children_)
+       + openfpga::memory_usage(num_child_instances_)
+       + openfpga::memory_usage(child_instance_names_)
+       + openfpga::memory_usage(configurable_children_)
+       + openfpga::memory_usage(configurable_child_instances_)
+       + openfpga::memory_usage(configurable_child_regions_)
+       + openfpga::memory_usage(config_region_ids_)
+       + openfpga::memory_usage(config_region_children_)
+       + openfpga::memory_usage(name_id_map_)
+       + openfpga::memory_usage(child_index_lookup_)
+       + openfpga::memory_usage(child_instance_name_lookup_)
+       + port_memory_usage()
+       + net_memory_usage();
+}
+
+/* Estimate the memory of the flat layout, 
+ * which costs one net id per pin and one offset per port and instance
+ */
+size_t ModuleManager::flat_net_lookup_memory() const {
+  size_t num_bytes = 0;
+  for (const ModuleId& parent : modules()) {
+    /* Port offsets and the pins of the module itself */
+    num_bytes += 2 * sizeof(std::vector<size_t>) + (port_ids_[parent].size() + 1) * sizeof(size_t)
+               + num_module_pins(parent) * sizeof(ModuleNetId);
+    num_bytes += sizeof(std::vector<std::vector<size_t>>) + sizeof(std::vector<ModuleNetId>);
+    for (size_t child_index = 0; child_index < children_[parent].size(); ++child_index) {
+      const ModuleId& child = children_[parent][child_index];
+      num_bytes += sizeof(std::vector<size_t>)
+                 + num_child_instances_[parent][child_index] * (sizeof(size_t) + num_module_pins(child) * sizeof(ModuleNetId));
+    }
+  }
+
+  return num_bytes;
+}
+
 /******************************************************************************
  * Private Accessors
  ******************************************************************************/
@@ -498,15 +821,147 @@ size_t ModuleManager::find_child_module_index_in_parent_module(const ModuleId& p
   /* validate both module ids */
   VTR_ASSERT(valid_module_id(parent_module));
   VTR_ASSERT(valid_module_id(child_module));
-  /* Try to find the child_module in the children list of parent_module*/
-  for (size_t i = 0; i < children_[parent_module].size(); ++i) {
-    if (child_module == children_[parent_module][i]) {
-      /* Found, return the number of instances */
-      return i; 
+  /* Try to find the child_module in the fast look-up of parent_module*/
+  std::unordered_map<ModuleId, size_t>::const_iterator result = child_index_lookup_[parent_module].find(child_module);
+  if (result == child_index_lookup_[parent_module].end()) {
+    /* Not found: return an valid value */
+    return size_t(-1);
+  }
+  /* Found, return the index in the child list */
+  return result->second;
+}
+
+void ModuleManager::update_child_instance_name_lookup(const ModuleId& parent_module,
+                                                      const size_t& child_index,
+                                                      const size_t& instance_id,
+                                                      const std::string& old_name) {
+  std::unordered_map<std::string, size_t>& name_lookup = child_instance_name_lookup_[parent_module][child_index];
+  const std::vector<std::string>& instance_names = child_instance_names_[parent_module][child_index];
+
+  /* Remove the old name if it is recorded by this instance.
+   * Instances with larger ids may share the old name, the smallest one takes the record
+   */
+  std::unordered_map<std::string, size_t>::iterator old_result = name_lookup.find(old_name);
+  if ( (old_result != name_lookup.end())
+    && (instance_id == old_result->second) ) {
+    name_lookup.erase(old_result);
+    for (size_t next_id = instance_id + 1; next_id < instance_names.size(); ++next_id) {
+      if (old_name == instance_names[next_id]) {
+        name_lookup.emplace(old_name, next_id);
+        break;
+      }
     }
   }
-  /* Not found: return an valid value */
-  return size_t(-1);
+
+  /* Record the new name unless an instance with a smaller id has used it */
+  std::pair<std::unordered_map<std::string, size_t>::iterator, bool> new_result = name_lookup.emplace(instance_names[instance_id], instance_id);
+  if ( (false == new_result.second)
+    && (instance_id < new_result.first->second) ) {
+    new_result.first->second = instance_id;
+  }
+}
+
+void ModuleManager::build_port_name_lookup(const ModuleId& module) {
+  port_name_lookup_[module].clear();
+  port_name_lookup_[module].reserve(port_ids_[module].size());
+  for (const ModulePortId& port : port_ids_[module]) {
+    port_name_lookup_[module].emplace(ports_[module][port].get_name(), port);
+  }
+}
+
+size_t ModuleManager::num_module_pins(const ModuleId& module) const {
+  size_t num_pins = 0;
+  for (const BasicPort& port : ports_[module]) {
+    num_pins += port.get_width();
+  }
+  return num_pins;
+}
+
+ModuleNetId& ModuleManager::net_lookup_entry(const ModuleId& parent_module, 
+                                             const ModuleId& child_module, const size_t& child_instance,
+                                             const ModulePortId& child_port, const size_t& child_pin) const {
+#ifdef OPENFPGA_USE_FLAT_NET_LOOKUP
+  size_t pin_offset = port_pin_offsets_[child_module][size_t(child_port)] + child_pin;
+  if (child_module == parent_module) {
+    return self_net_lookup_[parent_module][pin_offset];
+  }
+  size_t child_index = find_child_module_index_in_parent_module(parent_module, child_module);
+  VTR_ASSERT_SAFE(size_t(-1) != child_index);
+  return net_lookup_[parent_module][child_instance_pin_offsets_[parent_module][child_index][child_instance] + pin_offset];
+#else
+  /* Allocate the pins of the port when it is touched for the first time */
+  std::vector<ModuleNetId>& pin_nets = net_lookup_[parent_module][child_module][child_instance][child_port];
+  if (true == pin_nets.empty()) {
+    pin_nets.resize(ports_[child_module][child_port].get_width(), ModuleNetId::INVALID());
+  }
+  return pin_nets[child_pin];
+#endif
+}
+
+size_t ModuleManager::num_net_sources(const ModuleId& module, const ModuleNetId& net) const {
+  if (true == net_frozen_[module]) {
+    return net_src_csr_[module].offsets[size_t(net) + 1] - net_src_csr_[module].offsets[size_t(net)];
+  }
+  return net_src_terminal_ids_[module][net].size();
+}
+
+size_t ModuleManager::num_net_sinks(const ModuleId& module, const ModuleNetId& net) const {
+  if (true == net_frozen_[module]) {
+    return net_sink_csr_[module].offsets[size_t(net) + 1] - net_sink_csr_[module].offsets[size_t(net)];
+  }
+  return net_sink_terminal_ids_[module][net].size();
+}
+
+size_t ModuleManager::net_source_terminal_id(const ModuleId& module, const ModuleNetId& net, const ModuleNetSrcId& net_src) const {
+  if (true == net_frozen_[module]) {
+    return net_src_csr_[module].terminal_ids[net_src_csr_[module].offsets[size_t(net)] + size_t(net_src)];
+  }
+  return net_src_terminal_ids_[module][net][net_src];
+}
+
+size_t ModuleManager::net_sink_terminal_id(const ModuleId& module, const ModuleNetId& net, const ModuleNetSinkId& net_sink) const {
+  if (true == net_frozen_[module]) {
+    return net_sink_csr_[module].terminal_ids[net_sink_csr_[module].offsets[size_t(net)] + size_t(net_sink)];
+  }
+  return net_sink_terminal_ids_[module][net][net_sink];
+}
+
+/* Find the id of a pair of module and port in the storage of net terminals
+ * If not found, add the pair to the storage
+ */
+size_t ModuleManager::find_or_add_net_terminal(const ModuleId& module, const ModulePortId& port) {
+  std::pair<ModuleId, ModulePortId> terminal(module, port);
+  std::pair<std::map<std::pair<ModuleId, ModulePortId>, size_t>::iterator, bool> result = net_terminal_lookup_.emplace(terminal, net_terminal_storage_.size());
+  if (true == result.second) {
+    net_terminal_storage_.push_back(terminal);
+  }
+  return result.first->second;
+}
+
+/* Append a source to a net and update the fast look-up, without any validation */
+void ModuleManager::push_module_net_source(const ModuleId& module, const ModuleNetId& net,
+                                           const size_t& terminal_id,
+                                           const ModuleId& src_module, const size_t& instance_id,
+                                           const ModulePortId& src_port, const size_t& src_pin) {
+  net_src_terminal_ids_[module][net].push_back(terminal_id);
+  net_src_instance_ids_[module][net].push_back(instance_id);
+  net_src_pin_ids_[module][net].push_back(src_pin);
+
+  /* Update fast look-up for nets */
+  net_lookup_entry(module, src_module, instance_id, src_port, src_pin) = net;
+}
+
+/* Append a sink to a net and update the fast look-up, without any validation */
+void ModuleManager::push_module_net_sink(const ModuleId& module, const ModuleNetId& net,
+                                         const size_t& terminal_id,
+                                         const ModuleId& sink_module, const size_t& instance_id,
+                                         const ModulePortId& sink_port, const size_t& sink_pin) {
+  net_sink_terminal_ids_[module][net].push_back(terminal_id);
+  net_sink_instance_ids_[module][net].push_back(instance_id);
+  net_sink_pin_ids_[module][net].push_back(sink_pin);
+
+  /* Update fast look-up for nets */
+  net_lookup_entry(module, sink_module, instance_id, sink_port, sink_pin) = net;
 }
 
 /******************************************************************************
@@ -527,10 +982,13 @@ ModuleId ModuleManager::add_module(const std::string& name) {
   /* Allocate other attributes */
   names_.push_back(name);
   usages_.push_back(NUM_MODULE_USAGE_TYPES);
+  merged_modules_.push_back(ModuleId::INVALID());
   parents_.emplace_back();
   children_.emplace_back();
   num_child_instances_.emplace_back();
   child_instance_names_.emplace_back();
+  child_index_lookup_.emplace_back();
+  child_instance_name_lookup_.emplace_back();
   configurable_children_.emplace_back();
   configurable_child_instances_.emplace_back();
   configurable_child_regions_.emplace_back();
@@ -548,28 +1006,37 @@ ModuleId ModuleManager::add_module(const std::string& name) {
 
   num_nets_.emplace_back(0);
   invalid_net_ids_.emplace_back();
-  net_names_.emplace_back();
-  net_src_ids_.emplace_back();
+  net_name_ids_.emplace_back();
   net_src_terminal_ids_.emplace_back();
   net_src_instance_ids_.emplace_back();
   net_src_pin_ids_.emplace_back();
 
-  net_sink_ids_.emplace_back();
   net_sink_terminal_ids_.emplace_back();
   net_sink_instance_ids_.emplace_back();
   net_sink_pin_ids_.emplace_back();
 
+  net_frozen_.push_back(false);
+  net_src_csr_.emplace_back();
+  net_sink_csr_.emplace_back();
+
   /* Register in the name-to-id map */
   name_id_map_[name] = module;
 
   /* Build port lookup */
   port_lookup_.emplace_back();
   port_lookup_[module].resize(NUM_MODULE_PORT_TYPES);
+  port_name_lookup_.emplace_back();
 
   /* Build fast look-up for nets */
   net_lookup_.emplace_back();
+#ifdef OPENFPGA_USE_FLAT_NET_LOOKUP
+  port_pin_offsets_.emplace_back(1, 0);
+  self_net_lookup_.emplace_back();
+  child_instance_pin_offsets_.emplace_back();
+#else
   /* Reserve the instance 0 for the module */
   net_lookup_[module][module].emplace_back();
+#endif
 
   /* Return the new id */
   return module;
@@ -593,10 +1060,17 @@ ModulePortId ModuleManager::add_port(const ModuleId& module,
 
   /* Update fast look-up for port */
   port_lookup_[module][port_type].push_back(port);
+  /* Do not overwrite an existing port which has the same name */
+  port_name_lookup_[module].emplace(port_info.get_name(), port);
 
   /* Update fast look-up for nets */
+#ifdef OPENFPGA_USE_FLAT_NET_LOOKUP
+  port_pin_offsets_[module].push_back(port_pin_offsets_[module].back() + port_info.get_width());
+  self_net_lookup_[module].resize(port_pin_offsets_[module].back(), ModuleNetId::INVALID());
+#else
   VTR_ASSERT_SAFE(1 == net_lookup_[module][module].size());
   net_lookup_[module][module][0][port].resize(port_info.get_width(), ModuleNetId::INVALID());
+#endif
 
   return port;
 }
@@ -608,6 +1082,9 @@ void ModuleManager::set_module_port_name(const ModuleId& module, const ModulePor
   VTR_ASSERT( valid_module_port_id(module, module_port) );
   
   ports_[module][module_port].set_name(port_name);
+
+  /* Other ports may share the old name, so rebuild the name look-up */
+  build_port_name_lookup(module);
 }
 
 /* Set a name for a module */
@@ -661,34 +1138,43 @@ void ModuleManager::add_child_module(const ModuleId& parent_module, const Module
   VTR_ASSERT ( valid_module_id(parent_module) );
   VTR_ASSERT ( valid_module_id(child_module) );
 
-  /* Try to find if the parent module is already in the list */
-  std::vector<ModuleId>::iterator parent_it = std::find(parents_[child_module].begin(), parents_[child_module].end(), parent_module);
-  if (parent_it == parents_[child_module].end()) {
+  /* Try to find if the child module is already in the list
+   * The parent list of child module is updated together with the child list,
+   * so the parent module is in the list if and only if the child module is found
+   */
+  std::pair<std::unordered_map<ModuleId, size_t>::iterator, bool> child_result = child_index_lookup_[parent_module].emplace(child_module, children_[parent_module].size());
+  size_t child_index = child_result.first->second;
+  if (true == child_result.second) {
     /* Update the parent module of child module */
     parents_[child_module].push_back(parent_module);
-  }
-
-  std::vector<ModuleId>::iterator child_it = std::find(children_[parent_module].begin(), children_[parent_module].end(), child_module);
-  if (child_it == children_[parent_module].end()) {
     /* Update the child module of parent module */
     children_[parent_module].push_back(child_module);
     num_child_instances_[parent_module].push_back(1); /* By default give one */
     /* Update the instance name list */
     child_instance_names_[parent_module].emplace_back();
-    child_instance_names_[parent_module].back().emplace_back();
+    child_instance_name_lookup_[parent_module].emplace_back();
   } else {
     /* Increase the counter of instances */
-    num_child_instances_[parent_module][child_it - children_[parent_module].begin()]++;
-    child_instance_names_[parent_module][child_it - children_[parent_module].begin()].emplace_back();
+    num_child_instances_[parent_module][child_index]++;
   }
+  /* The new instance has an empty name by default */
+  child_instance_names_[parent_module][child_index].emplace_back();
+  child_instance_name_lookup_[parent_module][child_index].emplace(std::string(), child_instance_names_[parent_module][child_index].size() - 1);
 
   /* Update fast look-up for nets */
-  size_t instance_id = net_lookup_[parent_module][child_module].size();
+#ifdef OPENFPGA_USE_FLAT_NET_LOOKUP
+  /* Pins of the new instance are appended to the flat array */
+  if (child_instance_pin_offsets_[parent_module].size() <= child_index) {
+    child_instance_pin_offsets_[parent_module].resize(child_index + 1);
+  }
+  child_instance_pin_offsets_[parent_module][child_index].push_back(net_lookup_[parent_module].size());
+  net_lookup_[parent_module].resize(net_lookup_[parent_module].size() + port_pin_offsets_[child_module].back(), ModuleNetId::INVALID());
+#else
+  /* Pins of the new instance are not allocated until a net is connected to them,
+   * as many pins of large modules, e.g., the top module, are left unconnected
+   */
   net_lookup_[parent_module][child_module].emplace_back();
-  /* Find the ports for the child module and update the fast look-up */
-  for (ModulePortId child_port : port_ids_[child_module]) {
-    net_lookup_[parent_module][child_module][instance_id][child_port].resize(ports_[child_module][child_port].get_width(), ModuleNetId::INVALID());
-  } 
+#endif
 }
 
 /* Set the instance name of a child module */
@@ -706,7 +1192,9 @@ void ModuleManager::set_child_instance_name(const ModuleId& parent_module,
   /* We must find something! */
   VTR_ASSERT(size_t(-1) != child_index);
   /* Set the name */
+  std::string old_name = child_instance_names_[parent_module][child_index][instance_id];
   child_instance_names_[parent_module][child_index][instance_id] = instance_name;
+  update_child_instance_name_lookup(parent_module, child_index, instance_id, old_name);
 }
 
 /* Add a configurable child module to module
@@ -738,11 +1226,70 @@ void ModuleManager::reserve_configurable_child(const ModuleId& parent_module,
   if (num_children > configurable_child_instances_[parent_module].size()) {
     configurable_child_instances_[parent_module].reserve(num_children);
   }
-  if (num_children > configurable_child_instances_[parent_module].size()) {
+  if (num_children > configurable_child_regions_[parent_module].size()) {
     configurable_child_regions_[parent_module].reserve(num_children);
   }
 }
 
+void ModuleManager::set_configurable_children(const ModuleId& parent_module,
+                                              const std::vector<ModuleId>& child_modules,
+                                              const std::vector<size_t>& child_instances) {
+  VTR_ASSERT ( valid_module_id(parent_module) );
+  VTR_ASSERT ( child_modules.size() == child_instances.size() );
+  VTR_ASSERT ( true == config_region_ids_[parent_module].empty() );
+
+  for (size_t ichild = 0; ichild < child_modules.size(); ++ichild) {
+    VTR_ASSERT ( valid_module_id(child_modules[ichild]) );
+    VTR_ASSERT ( child_instances[ichild] < num_instance(parent_module, child_modules[ichild]) );
+  }
+
+  configurable_children_[parent_module] = child_modules;
+  configurable_child_instances_[parent_module] = child_instances;
+  configurable_child_regions_[parent_module].assign(child_modules.size(), ConfigRegionId::INVALID());
+}
+
+void ModuleManager::permute_configurable_children(const ModuleId& parent_module,
+                                                  const std::vector<size_t>& order) {
+  VTR_ASSERT ( valid_module_id(parent_module) );
+  VTR_ASSERT ( true == config_region_ids_[parent_module].empty() );
+
+  std::vector<ModuleId>& children = configurable_children_[parent_module];
+  std::vector<size_t>& child_instances = configurable_child_instances_[parent_module];
+  VTR_ASSERT ( order.size() == children.size() );
+
+  /* Ensure that each configurable child is used once and only once */
+  std::vector<bool> visited(order.size(), false);
+  for (const size_t& child_id : order) {
+    VTR_ASSERT ( child_id < order.size() );
+    VTR_ASSERT ( false == visited[child_id] );
+    visited[child_id] = true;
+  }
+
+  /* Walk through each cycle of the permutation,
+   * so that every child is moved only once
+   */
+  visited.assign(order.size(), false);
+  for (size_t start = 0; start < order.size(); ++start) {
+    if (true == visited[start]) {
+      continue;
+    }
+    ModuleId start_child = children[start];
+    size_t start_instance = child_instances[start];
+    size_t curr = start;
+    while (start != order[curr]) {
+      visited[curr] = true;
+      children[curr] = children[order[curr]];
+      child_instances[curr] = child_instances[order[curr]];
+      curr = order[curr];
+    }
+    visited[curr] = true;
+    children[curr] = start_child;
+    child_instances[curr] = start_instance;
+  }
+
+  configurable_child_regions_[parent_module].assign(children.size(), ConfigRegionId::INVALID());
+}
+
 ConfigRegionId ModuleManager::add_config_region(const ModuleId& module) {
   /* Validate the module id */
   VTR_ASSERT ( valid_module_id(module) );
@@ -767,8 +1314,8 @@ void ModuleManager::add_configurable_child_to_region(const ModuleId& parent_modu
   VTR_ASSERT ( valid_region_id(parent_module, config_region) );
 
   /* Ensure that the child module is in the configurable children list */
-  VTR_ASSERT(child_module == configurable_children(parent_module)[config_child_id]);
-  VTR_ASSERT(child_instance == configurable_child_instances(parent_module)[config_child_id]);
+  VTR_ASSERT(child_module == configurable_children_[parent_module][config_child_id]);
+  VTR_ASSERT(child_instance == configurable_child_instances_[parent_module][config_child_id]);
 
   /* If the child is already in another region, error out */
   if ( (true == valid_region_id(parent_module, configurable_child_regions_[parent_module][config_child_id]))
@@ -786,18 +1333,21 @@ void ModuleManager::add_configurable_child_to_region(const ModuleId& parent_modu
   config_region_children_[parent_module][config_region].push_back(config_child_id);
 }
 
+void ModuleManager::enable_net_arena(const bool& use_hugepage) {
+  net_arena_.enable(use_hugepage);
+}
+
 void ModuleManager::reserve_module_nets(const ModuleId& module,
                                         const size_t& num_nets) {
   /* Validate the module id */
   VTR_ASSERT ( valid_module_id(module) );
+  VTR_ASSERT ( false == net_frozen_[module] );
 
-  net_names_[module].reserve(num_nets);
-  net_src_ids_[module].reserve(num_nets);
+  net_name_ids_[module].reserve(num_nets);
   net_src_terminal_ids_[module].reserve(num_nets);
   net_src_instance_ids_[module].reserve(num_nets);
   net_src_pin_ids_[module].reserve(num_nets);
 
-  net_sink_ids_[module].reserve(num_nets);
   net_sink_terminal_ids_[module].reserve(num_nets);
   net_sink_instance_ids_[module].reserve(num_nets);
   net_sink_pin_ids_[module].reserve(num_nets);
@@ -807,25 +1357,25 @@ void ModuleManager::reserve_module_nets(const ModuleId& module,
 ModuleNetId ModuleManager::create_module_net(const ModuleId& module) {
   /* Validate the module id */
   VTR_ASSERT ( valid_module_id(module) );
+  /* No more nets can be added to a frozen module */
+  VTR_ASSERT ( false == net_frozen_[module] );
 
   /* Create an new id */
   ModuleNetId net = ModuleNetId(num_nets_[module]);
   num_nets_[module]++;
   
   /* Allocate net-related data structures */
-  net_names_[module].emplace_back();
-  net_src_ids_[module].emplace_back();
-  net_src_terminal_ids_[module].emplace_back();
-  net_src_instance_ids_[module].emplace_back();
-  net_src_pin_ids_[module].emplace_back();
+  net_name_ids_[module].emplace_back(0);
+  net_src_terminal_ids_[module].emplace_back(net_arena_.allocator<size_t>());
+  net_src_instance_ids_[module].emplace_back(net_arena_.allocator<size_t>());
+  net_src_pin_ids_[module].emplace_back(net_arena_.allocator<size_t>());
 
   /* Reserve a source */
   reserve_module_net_sources(module, net, 1);
 
-  net_sink_ids_[module].emplace_back();
-  net_sink_terminal_ids_[module].emplace_back();
-  net_sink_instance_ids_[module].emplace_back();
-  net_sink_pin_ids_[module].emplace_back();
+  net_sink_terminal_ids_[module].emplace_back(net_arena_.allocator<size_t>());
+  net_sink_instance_ids_[module].emplace_back(net_arena_.allocator<size_t>());
+  net_sink_pin_ids_[module].emplace_back(net_arena_.allocator<size_t>());
 
   /* Reserve a source */
   reserve_module_net_sinks(module, net, 1);
@@ -839,15 +1389,27 @@ void ModuleManager::set_net_name(const ModuleId& module, const ModuleNetId& net,
   /* Validate module net */
   VTR_ASSERT(valid_module_net_id(module, net));
 
-  net_names_[module][net] = name;
+  if (true == name.empty()) {
+    net_name_ids_[module][net] = 0;
+    return;
+  }
+
+  /* Share the name with other nets if it is in the pool */
+  auto result = net_name_pool_lookup_.find(name);
+  if (result == net_name_pool_lookup_.end()) {
+    VTR_ASSERT(net_name_pool_.size() < size_t(std::numeric_limits<uint32_t>::max()));
+    net_name_pool_.push_back(name);
+    result = net_name_pool_lookup_.emplace(name, uint32_t(net_name_pool_.size())).first;
+  }
+  net_name_ids_[module][net] = result->second;
 }
 
 void ModuleManager::reserve_module_net_sources(const ModuleId& module, const ModuleNetId& net,
                                                const size_t& num_sources) {
   /* Validate module net */
   VTR_ASSERT(valid_module_net_id(module, net));
+  VTR_ASSERT(false == net_frozen_[module]);
 
-  net_src_ids_[module][net].reserve(num_sources);
   net_src_terminal_ids_[module][net].reserve(num_sources);
   net_src_instance_ids_[module][net].reserve(num_sources);
   net_src_pin_ids_[module][net].reserve(num_sources);
@@ -859,10 +1421,11 @@ ModuleNetSrcId ModuleManager::add_module_net_source(const ModuleId& module, cons
                                                     const ModulePortId& src_port, const size_t& src_pin) {
   /* Validate the module and net id */
   VTR_ASSERT(valid_module_net_id(module, net));
+  /* No more sources can be added to a frozen module */
+  VTR_ASSERT(false == net_frozen_[module]);
 
   /* Create a new id for src node */
-  ModuleNetSrcId net_src = ModuleNetSrcId(net_src_ids_[module][net].size());
-  net_src_ids_[module][net].push_back(net_src);
+  ModuleNetSrcId net_src = ModuleNetSrcId(net_src_terminal_ids_[module][net].size());
 
   /* Validate the source module */
   VTR_ASSERT(valid_module_id(src_module));
@@ -870,39 +1433,20 @@ ModuleNetSrcId ModuleManager::add_module_net_source(const ModuleId& module, cons
   /* Validate the port exists in the src module */
   VTR_ASSERT(valid_module_port_id(src_module, src_port));
 
-  /* Create pair of module and port
-   * Search in the storage. If found, use the existing pair
-   * Otherwise, add the pair
-   */
-  std::pair<ModuleId, ModulePortId> terminal(src_module, src_port);
-  std::vector<std::pair<ModuleId, ModulePortId>>::iterator it = std::find(net_terminal_storage_.begin(),
-                                                                          net_terminal_storage_.end(),
-                                                                          terminal);
-  if (it == net_terminal_storage_.end()) {
-    net_src_terminal_ids_[module][net].push_back(net_terminal_storage_.size());
-    net_terminal_storage_.push_back(terminal);
-  } else {
-   VTR_ASSERT_SAFE(it != net_terminal_storage_.end());
-   net_src_terminal_ids_[module][net].push_back(std::distance(net_terminal_storage_.begin(), it));
-  }
-
   /* if it has the same id as module, our instance id will be by default 0 */
   size_t src_instance_id = instance_id;
   if (src_module == module) {
     src_instance_id = 0;
-    net_src_instance_ids_[module][net].push_back(src_instance_id);
   } else {
     /* Check the instance id of the src module */
     VTR_ASSERT (src_instance_id < num_instance(module, src_module));
-    net_src_instance_ids_[module][net].push_back(src_instance_id);
   } 
 
   /* Validate the pin id is in the range of the port width */
   VTR_ASSERT(src_pin < module_port(src_module, src_port).get_width());
-  net_src_pin_ids_[module][net].push_back(src_pin);
 
-  /* Update fast look-up for nets */
-  net_lookup_[module][src_module][src_instance_id][src_port][src_pin] = net;
+  push_module_net_source(module, net, find_or_add_net_terminal(src_module, src_port),
+                         src_module, src_instance_id, src_port, src_pin);
 
   return net_src;
 }
@@ -911,8 +1455,8 @@ void ModuleManager::reserve_module_net_sinks(const ModuleId& module, const Modul
                                              const size_t& num_sinks) {
   /* Validate module net */
   VTR_ASSERT(valid_module_net_id(module, net));
+  VTR_ASSERT(false == net_frozen_[module]);
 
-  net_sink_ids_[module][net].reserve(num_sinks);
   net_sink_terminal_ids_[module][net].reserve(num_sinks);
   net_sink_instance_ids_[module][net].reserve(num_sinks);
   net_sink_pin_ids_[module][net].reserve(num_sinks);
@@ -924,10 +1468,11 @@ ModuleNetSinkId ModuleManager::add_module_net_sink(const ModuleId& module, const
                                                    const ModulePortId& sink_port, const size_t& sink_pin) {
   /* Validate the module and net id */
   VTR_ASSERT(valid_module_net_id(module, net));
+  /* No more sinks can be added to a frozen module */
+  VTR_ASSERT(false == net_frozen_[module]);
 
   /* Create a new id for sink node */
-  ModuleNetSinkId net_sink = ModuleNetSinkId(net_sink_ids_[module][net].size());
-  net_sink_ids_[module][net].push_back(net_sink);
+  ModuleNetSinkId net_sink = ModuleNetSinkId(net_sink_terminal_ids_[module][net].size());
 
   /* Validate the source module */
   VTR_ASSERT(valid_module_id(sink_module));
@@ -935,43 +1480,139 @@ ModuleNetSinkId ModuleManager::add_module_net_sink(const ModuleId& module, const
   /* Validate the port exists in the sink module */
   VTR_ASSERT(valid_module_port_id(sink_module, sink_port));
 
-  /* Create pair of module and port
-   * Search in the storage. If found, use the existing pair
-   * Otherwise, add the pair
-   */
-  std::pair<ModuleId, ModulePortId> terminal(sink_module, sink_port);
-  std::vector<std::pair<ModuleId, ModulePortId>>::iterator it = std::find(net_terminal_storage_.begin(),
-                                                                          net_terminal_storage_.end(),
-                                                                          terminal);
-  if (it == net_terminal_storage_.end()) {
-    net_sink_terminal_ids_[module][net].push_back(net_terminal_storage_.size());
-    net_terminal_storage_.push_back(terminal);
-  } else {
-   VTR_ASSERT_SAFE(it != net_terminal_storage_.end());
-   net_sink_terminal_ids_[module][net].push_back(std::distance(net_terminal_storage_.begin(), it));
-  }
-
   /* if it has the same id as module, our instance id will be by default 0 */
   size_t sink_instance_id = instance_id;
   if (sink_module == module) {
     sink_instance_id = 0;
-    net_sink_instance_ids_[module][net].push_back(sink_instance_id);
   } else {
     /* Check the instance id of the src module */
     VTR_ASSERT (sink_instance_id < num_instance(module, sink_module));
-    net_sink_instance_ids_[module][net].push_back(sink_instance_id);
   } 
 
   /* Validate the pin id is in the range of the port width */
   VTR_ASSERT(sink_pin < module_port(sink_module, sink_port).get_width());
-  net_sink_pin_ids_[module][net].push_back(sink_pin);
 
-  /* Update fast look-up for nets */
-  net_lookup_[module][sink_module][sink_instance_id][sink_port][sink_pin] = net;
+  push_module_net_sink(module, net, find_or_add_net_terminal(sink_module, sink_port),
+                       sink_module, sink_instance_id, sink_port, sink_pin);
 
   return net_sink;
 }
 
+/* Connect pairs of pins between a source port and a sink port
+ * The validation on modules, instances and ports is done once for all the pairs
+ */
+void ModuleManager::add_module_nets_between_pins(const ModuleId& module,
+                                                 const ModuleId& src_module, const size_t& src_instance,
+                                                 const ModulePortId& src_port, const std::vector<size_t>& src_pins,
+                                                 const ModuleId& sink_module, const size_t& sink_instance,
+                                                 const ModulePortId& sink_port, const std::vector<size_t>& sink_pins) {
+  /* Validate the module id */
+  VTR_ASSERT(valid_module_id(module));
+  /* No more nets can be added to a frozen module */
+  VTR_ASSERT(false == net_frozen_[module]);
+
+  /* Validate the ports */
+  VTR_ASSERT(valid_module_port_id(src_module, src_port));
+  VTR_ASSERT(valid_module_port_id(sink_module, sink_port));
+
+  /* Each source pin is paired with a sink pin */
+  VTR_ASSERT(src_pins.size() == sink_pins.size());
+
+  /* if it has the same id as module, our instance id will be by default 0 */
+  size_t src_instance_id = src_instance;
+  if (src_module == module) {
+    src_instance_id = 0;
+  } else {
+    VTR_ASSERT(src_instance_id < num_instance(module, src_module));
+  }
+  size_t sink_instance_id = sink_instance;
+  if (sink_module == module) {
+    sink_instance_id = 0;
+  } else {
+    VTR_ASSERT(sink_instance_id < num_instance(module, sink_module));
+  }
+
+  size_t src_terminal = find_or_add_net_terminal(src_module, src_port);
+  size_t sink_terminal = find_or_add_net_terminal(sink_module, sink_port);
+  size_t src_port_width = ports_[src_module][src_port].get_width();
+  size_t sink_port_width = ports_[sink_module][sink_port].get_width();
+
+  for (size_t ipair = 0; ipair < src_pins.size(); ++ipair) {
+    /* Validate the pin ids are in the range of the port widths */
+    VTR_ASSERT(src_pins[ipair] < src_port_width);
+    VTR_ASSERT(sink_pins[ipair] < sink_port_width);
+
+    /* Reuse the net driven by the source pin if there is any */
+    ModuleNetId net = net_lookup_entry(module, src_module, src_instance_id, src_port, src_pins[ipair]);
+    if (ModuleNetId::INVALID() == net) {
+      net = create_module_net(module);
+      push_module_net_source(module, net, src_terminal,
+                             src_module, src_instance_id, src_port, src_pins[ipair]);
+    }
+    push_module_net_sink(module, net, sink_terminal,
+                         sink_module, sink_instance_id, sink_port, sink_pins[ipair]);
+  }
+}
+
+/* Pack the per-net terminal lists of a module into CSR storage
+ * and release the per-net lists
+ */
+template<class TerminalId, class Allocator>
+static 
+void pack_module_net_terminals(std::vector<size_t>& offsets,
+                               std::vector<size_t>& flat_ids,
+                               vtr::vector<ModuleNetId, vtr::vector<TerminalId, size_t, Allocator>>& net_ids) {
+  size_t num_terminals = 0;
+  for (const auto& terminal_ids : net_ids) {
+    num_terminals += terminal_ids.size();
+  }
+
+  offsets.clear();
+  offsets.reserve(net_ids.size() + 1);
+  flat_ids.clear();
+  flat_ids.reserve(num_terminals);
+
+  offsets.push_back(0);
+  for (const auto& terminal_ids : net_ids) {
+    flat_ids.insert(flat_ids.end(), terminal_ids.begin(), terminal_ids.end());
+    offsets.push_back(flat_ids.size());
+  }
+
+  /* Release the per-net lists */
+  net_ids.clear();
+  net_ids.shrink_to_fit();
+}
+
+void ModuleManager::freeze_module_nets(const ModuleId& module) {
+  VTR_ASSERT(valid_module_id(module));
+
+  if (true == net_frozen_[module]) {
+    return;
+  }
+
+  /* The offset arrays of each attribute are identical, only one copy is kept */
+  NetTerminalCsr& src_csr = net_src_csr_[module];
+  std::vector<size_t> offsets;
+  pack_module_net_terminals(src_csr.offsets, src_csr.terminal_ids, net_src_terminal_ids_[module]);
+  pack_module_net_terminals(offsets, src_csr.instance_ids, net_src_instance_ids_[module]);
+  pack_module_net_terminals(offsets, src_csr.pin_ids, net_src_pin_ids_[module]);
+
+  NetTerminalCsr& sink_csr = net_sink_csr_[module];
+  pack_module_net_terminals(sink_csr.offsets, sink_csr.terminal_ids, net_sink_terminal_ids_[module]);
+  pack_module_net_terminals(offsets, sink_csr.instance_ids, net_sink_instance_ids_[module]);
+  pack_module_net_terminals(offsets, sink_csr.pin_ids, net_sink_pin_ids_[module]);
+
+  net_frozen_[module] = true;
+}
+
+void ModuleManager::freeze_nets() {
+  for (const ModuleId& module : modules()) {
+    freeze_module_nets(module);
+  }
+  /* All the per-net lists are released, so is the arena */
+  net_arena_.clear();
+}
+
 /******************************************************************************
  * Public Deconstructor
  ******************************************************************************/
@@ -990,6 +1631,76 @@ void ModuleManager::clear_config_region(const ModuleId& parent_module) {
   config_region_children_[parent_module].clear();
 }
 
+void ModuleManager::clear_child_modules_and_nets(const ModuleId& parent_module) {
+  VTR_ASSERT(valid_module_id(parent_module));
+
+  /* Detach the parent module from its children */
+  for (const ModuleId& child : children_[parent_module]) {
+    auto it = std::find(parents_[child].begin(), parents_[child].end(), parent_module);
+    VTR_ASSERT(it != parents_[child].end());
+    parents_[child].erase(it);
+  }
+  children_[parent_module].clear();
+  num_child_instances_[parent_module].clear();
+  child_instance_names_[parent_module].clear();
+  child_index_lookup_[parent_module].clear();
+  child_instance_name_lookup_[parent_module].clear();
+
+  clear_configurable_children(parent_module);
+  clear_config_region(parent_module);
+
+  /* Remove all the nets */
+  num_nets_[parent_module] = 0;
+  invalid_net_ids_[parent_module] = vtr::tombstone_bitmap<ModuleNetId>();
+  net_name_ids_[parent_module].clear();
+  net_src_terminal_ids_[parent_module].clear();
+  net_src_instance_ids_[parent_module].clear();
+  net_src_pin_ids_[parent_module].clear();
+  net_sink_terminal_ids_[parent_module].clear();
+  net_sink_instance_ids_[parent_module].clear();
+  net_sink_pin_ids_[parent_module].clear();
+  net_name_ids_[parent_module].shrink_to_fit();
+  net_src_terminal_ids_[parent_module].shrink_to_fit();
+  net_src_instance_ids_[parent_module].shrink_to_fit();
+  net_src_pin_ids_[parent_module].shrink_to_fit();
+  net_sink_terminal_ids_[parent_module].shrink_to_fit();
+  net_sink_instance_ids_[parent_module].shrink_to_fit();
+  net_sink_pin_ids_[parent_module].shrink_to_fit();
+  net_frozen_[parent_module] = false;
+  net_src_csr_[parent_module] = NetTerminalCsr();
+  net_sink_csr_[parent_module] = NetTerminalCsr();
+
+  /* Only the pins of the module itself remain in the fast look-up */
+#ifdef OPENFPGA_USE_FLAT_NET_LOOKUP
+  std::fill(self_net_lookup_[parent_module].begin(), self_net_lookup_[parent_module].end(), ModuleNetId::INVALID());
+  child_instance_pin_offsets_[parent_module].clear();
+  net_lookup_[parent_module].clear();
+  net_lookup_[parent_module].shrink_to_fit();
+#else
+  net_lookup_[parent_module].clear();
+  net_lookup_[parent_module][parent_module].emplace_back();
+  for (const ModulePortId& port : port_ids_[parent_module]) {
+    net_lookup_[parent_module][parent_module][0][port].resize(ports_[parent_module][port].get_width(), ModuleNetId::INVALID());
+  }
+#endif
+}
+
+void ModuleManager::merge_module(const ModuleId& module, const ModuleId& target_module) {
+  VTR_ASSERT(valid_module_id(module));
+  VTR_ASSERT(valid_module_id(target_module));
+  VTR_ASSERT(module != target_module);
+  /* Merging should not be chained, so that any name refers to a module in use */
+  VTR_ASSERT(ModuleId::INVALID() == merged_modules_[module]);
+  VTR_ASSERT(ModuleId::INVALID() == merged_modules_[target_module]);
+  /* No parent module should refer to the module any more */
+  VTR_ASSERT(true == parents_[module].empty());
+
+  clear_child_modules_and_nets(module);
+
+  name_id_map_[names_[module]] = target_module;
+  merged_modules_[module] = target_module;
+}
+
 /******************************************************************************
  * Private validators/invalidators
  ******************************************************************************/
@@ -1035,10 +1746,15 @@ void ModuleManager::invalidate_name2id_map() {
 
 void ModuleManager::invalidate_port_lookup() {
   port_lookup_.clear();
+  port_name_lookup_.clear();
 }
 
 void ModuleManager::invalidate_net_lookup() {
   net_lookup_.clear();
+#ifdef OPENFPGA_USE_FLAT_NET_LOOKUP
+  self_net_lookup_.clear();
+  child_instance_pin_offsets_.clear();
+#endif
 }
 
 } /* end namespace openfpga */
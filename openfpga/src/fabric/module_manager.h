@@ -4,10 +4,12 @@
 #include <string>
 #include <map>
 #include <tuple>
-#include <unordered_set>
 #include <unordered_map>
 
 #include "vtr_vector.h"
+#include "vtr_arena.h"
+#include "vtr_small_vector.h"
+#include "vtr_lazy_id_iterator.h"
 #include "module_manager_fwd.h"
 #include "openfpga_port.h"
 
@@ -62,68 +64,18 @@ class ModuleManager {
       MODULE_IO,           /* I/O modules */
       MODULE_VDD,          /* Local VDD lines to generate constant voltages */
       MODULE_VSS,          /* Local VSS lines to generate constant voltages */
+      MODULE_TILE,         /* Tiles which group a grid and its adjacent routing blocks */
       NUM_MODULE_USAGE_TYPES
     };
 
   public: /* Public Constructors */
 
-  public: /* Type implementations */
-    /*
-     * This class (forward delcared above) is a template used to represent a lazily calculated 
-     * iterator of the specified ID type. The key assumption made is that the ID space is 
-     * contiguous and can be walked by incrementing the underlying ID value. To account for 
-     * invalid IDs, it keeps a reference to the invalid ID set and returns ID::INVALID() for
-     * ID values in the set.
-     *
-     * It is used to lazily create an iteration range (e.g. as returned by RRGraph::edges() RRGraph::nodes())
-     * just based on the count of allocated elements (i.e. RRGraph::num_nodes_ or RRGraph::num_edges_),
-     * and the set of any invalid IDs (i.e. RRGraph::invalid_node_ids_, RRGraph::invalid_edge_ids_).
-     */
-    template<class ID>
-    class lazy_id_iterator : public std::iterator<std::bidirectional_iterator_tag, ID> {
-      public:
-        //Since we pass ID as a template to std::iterator we need to use an explicit 'typename'
-        //to bring the value_type and iterator names into scope
-        typedef typename std::iterator<std::bidirectional_iterator_tag, ID>::value_type value_type;
-        typedef typename std::iterator<std::bidirectional_iterator_tag, ID>::iterator iterator;
-
-        lazy_id_iterator(value_type init, const std::unordered_set<ID>& invalid_ids)
-            : value_(init)
-            , invalid_ids_(invalid_ids) {}
-
-        //Advance to the next ID value
-        iterator operator++() {
-            value_ = ID(size_t(value_) + 1);
-            return *this;
-        }
-
-        //Advance to the previous ID value
-        iterator operator--() {
-            value_ = ID(size_t(value_) - 1);
-            return *this;
-        }
-
-        //Dereference the iterator
-        value_type operator*() const { return (invalid_ids_.count(value_)) ? ID::INVALID() : value_; }
-
-        friend bool operator==(const lazy_id_iterator<ID> lhs, const lazy_id_iterator<ID> rhs) { return lhs.value_ == rhs.value_; }
-        friend bool operator!=(const lazy_id_iterator<ID> lhs, const lazy_id_iterator<ID> rhs) { return !(lhs == rhs); }
-
-      private:
-        value_type value_;
-        const std::unordered_set<ID>& invalid_ids_;
-    };
-
   public: /* Types and ranges */
-    //Lazy iterator utility forward declaration
-    template<class ID>
-    class lazy_id_iterator;
-
     typedef vtr::vector<ModuleId, ModuleId>::const_iterator module_iterator;
     typedef vtr::vector<ModulePortId, ModulePortId>::const_iterator module_port_iterator;
-    typedef lazy_id_iterator<ModuleNetId> module_net_iterator;
-    typedef vtr::vector<ModuleNetSrcId, ModuleNetSrcId>::const_iterator module_net_src_iterator;
-    typedef vtr::vector<ModuleNetSinkId, ModuleNetSinkId>::const_iterator module_net_sink_iterator;
+    typedef vtr::lazy_id_iterator<ModuleNetId> module_net_iterator;
+    typedef vtr::vector<ModuleNetSrcId, ModuleNetSrcId>::key_iterator module_net_src_iterator;
+    typedef vtr::vector<ModuleNetSinkId, ModuleNetSinkId>::key_iterator module_net_sink_iterator;
     typedef vtr::vector<ConfigRegionId, ConfigRegionId>::const_iterator region_iterator;
 
     typedef vtr::Range<module_iterator> module_range;
@@ -141,13 +93,15 @@ class ModuleManager {
     /* Find all the nets belonging to a module */
     module_net_range module_nets(const ModuleId& module) const;
     /* Find all the child modules under a parent module */
-    std::vector<ModuleId> child_modules(const ModuleId& parent_module) const;
+    const vtr::small_vector<ModuleId>& child_modules(const ModuleId& parent_module) const;
+    /* Find all the parent modules which include a child module */
+    const vtr::small_vector<ModuleId>& parent_modules(const ModuleId& child_module) const;
     /* Find all the instances under a parent module */
     std::vector<size_t> child_module_instances(const ModuleId& parent_module, const ModuleId& child_module) const;
     /* Find all the configurable child modules under a parent module */
-    std::vector<ModuleId> configurable_children(const ModuleId& parent_module) const;
+    const std::vector<ModuleId>& configurable_children(const ModuleId& parent_module) const;
     /* Find all the instances of configurable child modules under a parent module */
-    std::vector<size_t> configurable_child_instances(const ModuleId& parent_module) const;
+    const std::vector<size_t>& configurable_child_instances(const ModuleId& parent_module) const;
     /* Find the source ids of modules */
     module_net_src_range module_net_sources(const ModuleId& module, const ModuleNetId& net) const;
     /* Find the sink ids of modules */
@@ -167,6 +121,10 @@ class ModuleManager {
     size_t num_nets(const ModuleId& module) const;
     std::string module_name(const ModuleId& module_id) const;
     e_module_usage_type module_usage(const ModuleId& module_id) const;
+    /* Find the module which a module has been merged into, see merge_module()
+     * An invalid id is returned if the module is not merged
+     */
+    ModuleId merged_module(const ModuleId& module_id) const;
     std::string module_port_type_str(const enum e_module_port_type& port_type) const;
     std::vector<BasicPort> module_ports_by_type(const ModuleId& module_id, const enum e_module_port_type& port_type) const;
     std::vector<ModulePortId> module_port_ids_by_type(const ModuleId& module_id, const enum e_module_port_type& port_type) const;
@@ -198,8 +156,28 @@ class ModuleManager {
     ModuleNetId module_instance_port_net(const ModuleId& parent_module, 
                                          const ModuleId& child_module, const size_t& child_instance,
                                          const ModulePortId& child_port, const size_t& child_pin) const;
-    /* Find the name of net */
+    /* Find the name of net given by set_net_name(), which is empty if not set */
     std::string net_name(const ModuleId& module, const ModuleNetId& net) const;
+    /* Find the name of the wire of a net in netlists, which is the name of the net if set,
+     * or a name built from the first source of the net otherwise:
+     *   <source_module_name>_<source_instance>_<source_port_name>
+     */
+    std::string net_wire_name(const ModuleId& module, const ModuleNetId& net) const;
+    /* Find the number of sources and sinks of a net */
+    size_t num_net_sources(const ModuleId& module, const ModuleNetId& net) const;
+    size_t num_net_sinks(const ModuleId& module, const ModuleNetId& net) const;
+    /* Find the module, instance, port and pin of a source of a net, 
+     * without copying the list of all the sources as net_source_modules() etc. 
+     */
+    ModuleId net_source_module(const ModuleId& module, const ModuleNetId& net, const ModuleNetSrcId& net_src) const;
+    size_t net_source_instance(const ModuleId& module, const ModuleNetId& net, const ModuleNetSrcId& net_src) const;
+    ModulePortId net_source_port(const ModuleId& module, const ModuleNetId& net, const ModuleNetSrcId& net_src) const;
+    size_t net_source_pin(const ModuleId& module, const ModuleNetId& net, const ModuleNetSrcId& net_src) const;
+    /* Find the module, instance, port and pin of a sink of a net */
+    ModuleId net_sink_module(const ModuleId& module, const ModuleNetId& net, const ModuleNetSinkId& net_sink) const;
+    size_t net_sink_instance(const ModuleId& module, const ModuleNetId& net, const ModuleNetSinkId& net_sink) const;
+    ModulePortId net_sink_port(const ModuleId& module, const ModuleNetId& net, const ModuleNetSinkId& net_sink) const;
+    size_t net_sink_pin(const ModuleId& module, const ModuleNetId& net, const ModuleNetSinkId& net_sink) const;
     /* Find the source modules of a net */
     vtr::vector<ModuleNetSrcId, ModuleId> net_source_modules(const ModuleId& module, const ModuleNetId& net) const;
     /* Find the ids of source instances of a net */
@@ -225,9 +203,61 @@ class ModuleManager {
     bool net_sink_exist(const ModuleId& module, const ModuleNetId& net,
                         const ModuleId& sink_module, const size_t& instance_id,
                         const ModulePortId& sink_port, const size_t& sink_pin);
+    /* Identify if the nets of a module have been packed into compact storage */
+    bool module_nets_frozen(const ModuleId& module) const;
+    /* Identify if the flat layout is used by the fast look-up for nets.
+     * The layout is selected at build time 
+     */
+    bool flat_net_lookup() const;
+    /* Estimate the memory footprint (in bytes) of the fast look-up for nets 
+     * in the nested layout and in the flat layout
+     * Both estimations are available whatever layout is used,
+     * so that they can be compared
+     */
+    size_t nested_net_lookup_memory() const;
+    size_t flat_net_lookup_memory() const;
+    /* Measure the memory footprint (in bytes) of the fast look-up for nets 
+     * in the layout which is in use. Pins are allocated in the nested layout 
+     * only when they are connected to nets, so this can be much smaller than 
+     * the estimation
+     */
+    size_t net_lookup_memory() const;
+    /* Estimate the heap memory (in bytes) held by the ports and the nets of all the modules,
+     * including their fast look-ups
+     */
+    size_t port_memory_usage() const;
+    size_t net_memory_usage() const;
+    /* Estimate the heap memory (in bytes) held by the whole module graph */
+    size_t memory_usage() const;
 
   private: /* Private accessors */
     size_t find_child_module_index_in_parent_module(const ModuleId& parent_module, const ModuleId& child_module) const;
+    size_t net_source_terminal_id(const ModuleId& module, const ModuleNetId& net, const ModuleNetSrcId& net_src) const;
+    size_t net_sink_terminal_id(const ModuleId& module, const ModuleNetId& net, const ModuleNetSinkId& net_sink) const;
+    /* Rebuild the name-to-port look-up of a module */
+    void build_port_name_lookup(const ModuleId& module);
+    /* Find the id of a pair of module and port in the storage of net terminals, add it if not found */
+    size_t find_or_add_net_terminal(const ModuleId& module, const ModulePortId& port);
+    /* Append a terminal to a net without validation */
+    void push_module_net_source(const ModuleId& module, const ModuleNetId& net,
+                                const size_t& terminal_id,
+                                const ModuleId& src_module, const size_t& instance_id,
+                                const ModulePortId& src_port, const size_t& src_pin);
+    void push_module_net_sink(const ModuleId& module, const ModuleNetId& net,
+                              const size_t& terminal_id,
+                              const ModuleId& sink_module, const size_t& instance_id,
+                              const ModulePortId& sink_port, const size_t& sink_pin);
+    /* Update the name-to-instance look-up after an instance is renamed */
+    void update_child_instance_name_lookup(const ModuleId& parent_module,
+                                           const size_t& child_index,
+                                           const size_t& instance_id,
+                                           const std::string& old_name);
+    /* Find the total width of all the ports of a module */
+    size_t num_module_pins(const ModuleId& module) const;
+    /* Find the net stored in the fast look-up for a pin of a child module instance */
+    ModuleNetId& net_lookup_entry(const ModuleId& parent_module, 
+                                  const ModuleId& child_module, const size_t& child_instance,
+                                  const ModulePortId& child_port, const size_t& child_pin) const;
   public: /* Public mutators */
     /* Add a module */
     ModuleId add_module(const std::string& name);
@@ -258,6 +288,23 @@ class ModuleManager {
      * for memory efficiency
      */
     void reserve_configurable_child(const ModuleId& module, const size_t& num_children);
+    /* Replace all the configurable children of a module at once
+     * The i-th configurable child is the instance child_instances[i] of child_modules[i]
+     * Note:
+     *   - The module must not have any configurable region,
+     *     as regions are built on the ids of configurable children
+     */
+    void set_configurable_children(const ModuleId& module,
+                                   const std::vector<ModuleId>& child_modules,
+                                   const std::vector<size_t>& child_instances);
+    /* Reorder the configurable children of a module in place,
+     * where the i-th configurable child becomes the child which was at order[i]
+     * Note:
+     *   - The order must be a permutation of the ids of configurable children
+     *   - The module must not have any configurable region,
+     *     as regions are built on the ids of configurable children
+     */
+    void permute_configurable_children(const ModuleId& module, const std::vector<size_t>& order);
 
     /* Create a new configurable region under a module */
     ConfigRegionId add_config_region(const ModuleId& module);
@@ -272,6 +319,16 @@ class ModuleManager {
                                           const size_t& child_instance,
                                           const size_t& config_child_id);
 
+    /* Allocate the sources and sinks of the nets created afterwards
+     * from an arena of large memory chunks, instead of one heap allocation
+     * per terminal list. This avoids the allocator churn when building
+     * large modules, e.g., the top module, while the memory is only
+     * released when all the nets are frozen or the module manager is cleared
+     * When use_hugepage is enabled, the kernel is advised to back the arena
+     * by transparent huge pages (Linux only)
+     */
+    void enable_net_arena(const bool& use_hugepage);
+
     /* Reserved a number of module nets for a given module
      * for memory efficiency
      */
@@ -304,6 +361,28 @@ class ModuleManager {
     ModuleNetSinkId add_module_net_sink(const ModuleId& module, const ModuleNetId& net,
                                         const ModuleId& sink_module, const size_t& instance_id,
                                         const ModulePortId& sink_port, const size_t& sink_pin);
+
+    /* Connect each source pin to the sink pin in the same position of the lists,
+     * which is the bulk version of create_module_net(), add_module_net_source() 
+     * and add_module_net_sink() when wiring two ports of a module.
+     * A net is created for a source pin only when it does not drive any net,
+     * otherwise the sink is added to the existing net
+     */
+    void add_module_nets_between_pins(const ModuleId& module,
+                                      const ModuleId& src_module, const size_t& src_instance,
+                                      const ModulePortId& src_port, const std::vector<size_t>& src_pins,
+                                      const ModuleId& sink_module, const size_t& sink_instance,
+                                      const ModulePortId& sink_port, const std::vector<size_t>& sink_pins);
+
+    /* Pack the sources and sinks of all the nets of a module into 
+     * compact storage (one offset array plus flat terminal arrays)
+     * Accessors remain functional on a frozen module,
+     * but no more nets, sources or sinks can be added to it
+     * Call this only when the connections of the module are finalized
+     */
+    void freeze_module_nets(const ModuleId& module);
+    /* Freeze the nets of all the modules */
+    void freeze_nets();
   public: /* Public deconstructors */
     /* This is a strong function which will remove all the configurable children 
      * under a given parent module
@@ -318,6 +397,24 @@ class ModuleManager {
      * Do NOT use unless you know what you are doing!!!
      */
     void clear_config_region(const ModuleId& parent_module);
+
+    /* This is a strong function which will remove all the child modules,
+     * configurable children, configurable regions and nets
+     * under a given parent module, while its ports are kept
+     * It is mainly used by grouping tiles
+     * Do NOT use unless you know what you are doing!!!
+     */
+    void clear_child_modules_and_nets(const ModuleId& parent_module);
+
+    /* This is a strong function which will merge a module into another module
+     * whose contents are the same. The name of the module is then 
+     * a name of the other module, i.e., find_module() returns the other module,
+     * while the module itself is left without any child module or net 
+     * The module should not be instanciated by any module
+     * It is mainly used by deduplicating logical tile modules
+     * Do NOT use unless you know what you are doing!!!
+     */
+    void merge_module(const ModuleId& module, const ModuleId& target_module);
   public: /* Public validators/invalidators */
     bool valid_module_id(const ModuleId& module) const;
     bool valid_module_port_id(const ModuleId& module, const ModulePortId& port) const;
@@ -336,8 +433,9 @@ class ModuleManager {
     vtr::vector<ModuleId, ModuleId> ids_;                                  /* Unique identifier for each Module */
     vtr::vector<ModuleId, std::string> names_;                             /* Unique identifier for each Module */
     vtr::vector<ModuleId, e_module_usage_type> usages_;                     /* Usage of each module */
-    vtr::vector<ModuleId, std::vector<ModuleId>> parents_;                 /* Parent modules that include the module */
-    vtr::vector<ModuleId, std::vector<ModuleId>> children_;                /* Child modules that this module contain */
+    vtr::vector<ModuleId, ModuleId> merged_modules_;                        /* Module that each module has been merged into */
+    vtr::vector<ModuleId, vtr::small_vector<ModuleId>> parents_;                 /* Parent modules that include the module */
+    vtr::vector<ModuleId, vtr::small_vector<ModuleId>> children_;                /* Child modules that this module contain */
     vtr::vector<ModuleId, std::vector<size_t>> num_child_instances_;          /* Number of children instance in each child module */
     vtr::vector<ModuleId, std::vector<std::vector<std::string>>> child_instance_names_;          /* Number of children instance in each child module */
 
@@ -373,34 +471,89 @@ class ModuleManager {
      * To enable fast look-up on pins, we create a fast look-up
      */
     vtr::vector<ModuleId, size_t> num_nets_;    /* List of nets for each Module */ 
-    vtr::vector<ModuleId, std::unordered_set<ModuleNetId>> invalid_net_ids_;   /* Invalid net ids */
-    vtr::vector<ModuleId, vtr::vector<ModuleNetId, std::string>> net_names_;    /* Name of net */ 
+    vtr::vector<ModuleId, vtr::tombstone_bitmap<ModuleNetId>> invalid_net_ids_;   /* Invalid net ids */
+    /* Names of nets, as indices in the pool of net names plus one, where 0 means no name.
+     * Most nets have no name, while the named nets use a few names in different modules,
+     * so that each name is stored only once
+     */
+    vtr::vector<ModuleId, vtr::vector<ModuleNetId, uint32_t>> net_name_ids_;
+    std::vector<std::string> net_name_pool_;
+    std::unordered_map<std::string, uint32_t> net_name_pool_lookup_;
+
+    /* Per-net lists of terminals, which are allocated from the arena if enabled */
+    typedef vtr::vector<ModuleNetSrcId, size_t, vtr::arena_allocator<size_t>> NetSrcTerminalIds;
+    typedef vtr::vector<ModuleNetSinkId, size_t, vtr::arena_allocator<size_t>> NetSinkTerminalIds;
+    vtr::arena_holder net_arena_;    /* Arena of the per-net lists of terminals */
 
-    vtr::vector<ModuleId, vtr::vector<ModuleNetId, vtr::vector<ModuleNetSrcId, ModuleNetSrcId>>> net_src_ids_;  /* Unique id of the source that drive the net */ 
-    vtr::vector<ModuleId, vtr::vector<ModuleNetId, vtr::vector<ModuleNetSrcId, size_t>>> net_src_terminal_ids_;  /* Pin ids that drive the net */ 
-    vtr::vector<ModuleId, vtr::vector<ModuleNetId, vtr::vector<ModuleNetSrcId, size_t>>> net_src_instance_ids_;  /* Pin ids that drive the net */ 
-    vtr::vector<ModuleId, vtr::vector<ModuleNetId, vtr::vector<ModuleNetSrcId, size_t>>> net_src_pin_ids_;  /* Pin ids that drive the net */ 
+    vtr::vector<ModuleId, vtr::vector<ModuleNetId, NetSrcTerminalIds>> net_src_terminal_ids_;  /* Pin ids that drive the net */ 
+    vtr::vector<ModuleId, vtr::vector<ModuleNetId, NetSrcTerminalIds>> net_src_instance_ids_;  /* Pin ids that drive the net */ 
+    vtr::vector<ModuleId, vtr::vector<ModuleNetId, NetSrcTerminalIds>> net_src_pin_ids_;  /* Pin ids that drive the net */ 
 
 
-    vtr::vector<ModuleId, vtr::vector<ModuleNetId, vtr::vector<ModuleNetSinkId, ModuleNetSinkId>>> net_sink_ids_;  /* Unique ids of the sink that the net drives */ 
-    vtr::vector<ModuleId, vtr::vector<ModuleNetId, vtr::vector<ModuleNetSinkId, size_t>>> net_sink_terminal_ids_;  /* Pin ids that the net drives */ 
-    vtr::vector<ModuleId, vtr::vector<ModuleNetId, vtr::vector<ModuleNetSinkId, size_t>>> net_sink_instance_ids_;  /* Pin ids that drive the net */ 
-    vtr::vector<ModuleId, vtr::vector<ModuleNetId, vtr::vector<ModuleNetSinkId, size_t>>> net_sink_pin_ids_;  /* Pin ids that drive the net */ 
+    vtr::vector<ModuleId, vtr::vector<ModuleNetId, NetSinkTerminalIds>> net_sink_terminal_ids_;  /* Pin ids that the net drives */ 
+    vtr::vector<ModuleId, vtr::vector<ModuleNetId, NetSinkTerminalIds>> net_sink_instance_ids_;  /* Pin ids that drive the net */ 
+    vtr::vector<ModuleId, vtr::vector<ModuleNetId, NetSinkTerminalIds>> net_sink_pin_ids_;  /* Pin ids that drive the net */ 
+
+    /* Compact storage of net terminals in Compressed Sparse Row (CSR) format
+     * The terminals of net i are stored in [offsets[i], offsets[i + 1])
+     * of the flat arrays.
+     * Once a module is frozen, its per-net terminal lists above are released
+     * and all the accessors are served by the compact storage
+     */
+    struct NetTerminalCsr {
+      std::vector<size_t> offsets;
+      std::vector<size_t> terminal_ids;
+      std::vector<size_t> instance_ids;
+      std::vector<size_t> pin_ids;
+
+      size_t memory_usage() const;
+    };
+    vtr::vector<ModuleId, bool> net_frozen_;    /* If the nets of a module are in compact storage */
+    vtr::vector<ModuleId, NetTerminalCsr> net_src_csr_;    /* Compact storage of net sources */
+    vtr::vector<ModuleId, NetTerminalCsr> net_sink_csr_;    /* Compact storage of net sinks */
 
     /* fast look-up for module */
     std::map<std::string, ModuleId> name_id_map_;
+    /* fast look-up for child modules and their instances
+     * Kept up-to-date by add_child_module() and set_child_instance_name(),
+     * so that the assembly of large modules, e.g., the top module, does not
+     * need to search the child list each time an instance is added
+     * When instances share a name, the smallest instance id is recorded
+     */
+    vtr::vector<ModuleId, std::unordered_map<ModuleId, size_t>> child_index_lookup_; /* [parent_modules][child_modules]: index in the child list */ 
+    vtr::vector<ModuleId, std::vector<std::unordered_map<std::string, size_t>>> child_instance_name_lookup_; /* [parent_modules][child_index][instance_names]: instance ids */ 
     /* fast look-up for ports */
     typedef vtr::vector<ModuleId, std::vector<std::vector<ModulePortId>>> PortLookup;
     mutable PortLookup port_lookup_; /* [module_ids][port_types][port_ids] */ 
+    /* fast look-up for ports by name 
+     * Kept up-to-date by any mutator on ports, so that concurrent readers are safe
+     * When ports share a name, the first port is recorded
+     */
+    vtr::vector<ModuleId, std::unordered_map<std::string, ModulePortId>> port_name_lookup_; /* [module_ids][port_names] */ 
 
     /* fast look-up for nets */
+#ifdef OPENFPGA_USE_FLAT_NET_LOOKUP
+    /* Flat layout: the pins of each module are numbered by port offsets,
+     * and each instance of a child module occupies a contiguous range 
+     * of pins in a flat array of the parent module
+     * The net of a pin is found at 
+     *   net_lookup_[parent][instance_offset + port_offset + pin]
+     */
+    vtr::vector<ModuleId, std::vector<size_t>> port_pin_offsets_; /* [module_ids][port_ids]: index of the first pin of each port, the last element is the total number of pins */ 
+    mutable vtr::vector<ModuleId, std::vector<ModuleNetId>> self_net_lookup_; /* [module_ids][pin_ids]: nets of the pins of the module itself */ 
+    vtr::vector<ModuleId, std::vector<std::vector<size_t>>> child_instance_pin_offsets_; /* [module_ids][child_index][instance_ids] */ 
+    typedef vtr::vector<ModuleId, std::vector<ModuleNetId>> NetLookup;
+    mutable NetLookup net_lookup_; /* [module_ids][pin_ids] */ 
+#else
     typedef vtr::vector<ModuleId, std::map<ModuleId, std::vector<std::map<ModulePortId, std::vector<ModuleNetId>>>>> NetLookup;
     mutable NetLookup net_lookup_; /* [module_ids][module_ids][instance_ids][port_ids][pin_ids] */ 
+#endif
 
     /* Store pairs of a module and a port, which are frequently used in net terminals
      * (either source or sink)
      */
     std::vector<std::pair<ModuleId, ModulePortId>> net_terminal_storage_;
+    std::map<std::pair<ModuleId, ModulePortId>, size_t> net_terminal_lookup_; /* Ids of pairs in the storage */
 };
 
 } /* end namespace openfpga */
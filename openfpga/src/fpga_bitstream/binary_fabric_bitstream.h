@@ -0,0 +1,55 @@
+#ifndef BINARY_FABRIC_BITSTREAM_H
+#define BINARY_FABRIC_BITSTREAM_H
+
+/********************************************************************
+ * This file includes the constants and the data structure of the
+ * binary container of fabric bitstream, which is written by
+ * write_fabric_bitstream_to_binary_file() and read by
+ * read_binary_fabric_bitstream()
+ *
+ * Layout of the container (all the integers are little-endian)
+ *   - magic:             8 bytes "OFPGABIT"
+ *   - version:           uint32
+ *   - protocol type:     uint32, value of e_config_protocol_type
+ *   - number of regions: uint32, or the number of data bits per record
+ *                        when each frame loads multiple bits
+ *   - address width:     uint32, BL address or frame address, 0 if no address
+ *                        For run-length compressed configuration chains,
+ *                        the address is the length of the run minus 1
+ *   - WL address width:  uint32, 0 if no WL address
+ *   - number of records: uint64
+ *   - records, packed back-to-back in a bit stream and padded to a byte
+ *     at the end. Each record consists of
+ *       <address bits> <WL address bits> <data bit of region 0, 1, ...>
+ *     The i-th bit of the stream is bit (i % 8) of byte (i / 8)
+ *******************************************************************/
+#include <cstdint>
+#include <string>
+#include <vector>
+#include "circuit_types.h"
+
+/* begin namespace openfpga */
+namespace openfpga {
+
+constexpr char BINARY_FABRIC_BITSTREAM_MAGIC[] = "OFPGABIT";
+constexpr size_t BINARY_FABRIC_BITSTREAM_MAGIC_SIZE = 8;
+constexpr uint32_t BINARY_FABRIC_BITSTREAM_VERSION = 1;
+
+/* Decoded content of a binary fabric bitstream file
+ * Each record has an address, a WL address and one data bit per region.
+ * The addresses are strings of '0' and '1', same as the plain text file
+ */
+struct BinaryFabricBitstream {
+  e_config_protocol_type config_protocol_type = NUM_CONFIG_PROTOCOL_TYPES;
+  size_t num_regions = 0;
+  size_t address_width = 0;
+  size_t wl_address_width = 0;
+
+  std::vector<std::string> addresses;
+  std::vector<std::string> wl_addresses;
+  std::vector<std::vector<bool>> data;
+};
+
+} /* end namespace openfpga */
+
+#endif
@@ -0,0 +1,79 @@
+/************************************************************************
+ * Member functions for class BitstreamBuildSnapshot
+ ***********************************************************************/
+#include "bitstream_build_snapshot.h"
+
+/* namespace openfpga begins */
+namespace openfpga {
+
+/************************************************************************
+ * Public accessors
+ ***********************************************************************/
+bool BitstreamBuildSnapshot::empty() const {
+  return 0 == num_bitstream_blocks_;
+}
+
+const std::string& BitstreamBuildSnapshot::atom_netlist_id() const {
+  return atom_netlist_id_;
+}
+
+const std::string& BitstreamBuildSnapshot::clustered_netlist_id() const {
+  return clustered_netlist_id_;
+}
+
+vtr::Point<size_t> BitstreamBuildSnapshot::grid_size() const {
+  return grid_size_;
+}
+
+size_t BitstreamBuildSnapshot::num_rr_nodes() const {
+  return num_rr_nodes_;
+}
+
+size_t BitstreamBuildSnapshot::num_bitstream_blocks() const {
+  return num_bitstream_blocks_;
+}
+
+size_t BitstreamBuildSnapshot::num_bitstream_bits() const {
+  return num_bitstream_bits_;
+}
+
+const VprPlacementAnnotation& BitstreamBuildSnapshot::placement_annotation() const {
+  return placement_annotation_;
+}
+
+const VprRoutingAnnotation& BitstreamBuildSnapshot::routing_annotation() const {
+  return routing_annotation_;
+}
+
+/************************************************************************
+ * Public mutators
+ ***********************************************************************/
+void BitstreamBuildSnapshot::take(const std::string& atom_netlist_id,
+                                  const std::string& clustered_netlist_id,
+                                  const vtr::Point<size_t>& grid_size,
+                                  const size_t& num_rr_nodes,
+                                  const VprPlacementAnnotation& placement_annotation,
+                                  const VprRoutingAnnotation& routing_annotation,
+                                  const BitstreamManager& bitstream_manager) {
+  atom_netlist_id_ = atom_netlist_id;
+  clustered_netlist_id_ = clustered_netlist_id;
+  grid_size_ = grid_size;
+  num_rr_nodes_ = num_rr_nodes;
+  num_bitstream_blocks_ = bitstream_manager.num_blocks();
+  num_bitstream_bits_ = bitstream_manager.num_bits();
+  placement_annotation_ = placement_annotation;
+  routing_annotation_ = routing_annotation;
+}
+
+void BitstreamBuildSnapshot::clear() {
+  atom_netlist_id_.clear();
+  clustered_netlist_id_.clear();
+  grid_size_ = vtr::Point<size_t>();
+  num_rr_nodes_ = 0;
+  num_bitstream_blocks_ = 0;
+  num_bitstream_bits_ = 0;
+  placement_annotation_ = VprPlacementAnnotation();
+  routing_annotation_ = VprRoutingAnnotation();
+}
+
+} /* End namespace openfpga*/
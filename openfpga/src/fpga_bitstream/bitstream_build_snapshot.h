@@ -0,0 +1,63 @@
+#ifndef BITSTREAM_BUILD_SNAPSHOT_H
+#define BITSTREAM_BUILD_SNAPSHOT_H
+
+/********************************************************************
+ * Include header files required by the data structure definition
+ *******************************************************************/
+#include <string>
+
+#include "vtr_geometry.h"
+#include "bitstream_manager.h"
+#include "vpr_placement_annotation.h"
+#include "vpr_routing_annotation.h"
+
+/* Begin namespace openfpga */
+namespace openfpga {
+
+/********************************************************************
+ * A snapshot of the implementation results from which an architecture
+ * bitstream is built, including
+ * - the ids of the atom and clustered netlists
+ * - the placement and routing annotation
+ * - the size of the bitstream
+ *
+ * The snapshot is compared with the implementation results of a next run,
+ * e.g., after an Engineering Change Order (ECO) which re-places and re-routes
+ * a few nets, to find the grids and GSBs whose bitstreams should be built again.
+ * Only the results which vary between runs on the same netlists are recorded.
+ * A snapshot is valid only for the bitstream it is taken with
+ *******************************************************************/
+class BitstreamBuildSnapshot {
+  public:  /* Public accessors */
+    bool empty() const;
+    const std::string& atom_netlist_id() const;
+    const std::string& clustered_netlist_id() const;
+    vtr::Point<size_t> grid_size() const;
+    size_t num_rr_nodes() const;
+    size_t num_bitstream_blocks() const;
+    size_t num_bitstream_bits() const;
+    const VprPlacementAnnotation& placement_annotation() const;
+    const VprRoutingAnnotation& routing_annotation() const;
+  public:  /* Public mutators */
+    void take(const std::string& atom_netlist_id,
+              const std::string& clustered_netlist_id,
+              const vtr::Point<size_t>& grid_size,
+              const size_t& num_rr_nodes,
+              const VprPlacementAnnotation& placement_annotation,
+              const VprRoutingAnnotation& routing_annotation,
+              const BitstreamManager& bitstream_manager);
+    void clear();
+  private: /* Internal data */
+    std::string atom_netlist_id_;
+    std::string clustered_netlist_id_;
+    vtr::Point<size_t> grid_size_;
+    size_t num_rr_nodes_ = 0;
+    size_t num_bitstream_blocks_ = 0;
+    size_t num_bitstream_bits_ = 0;
+    VprPlacementAnnotation placement_annotation_;
+    VprRoutingAnnotation routing_annotation_;
+};
+
+} /* End namespace openfpga*/
+
+#endif
@@ -4,7 +4,9 @@
  * We decode the bitstream from configuration of routing multiplexers 
  * and Look-Up Tables (LUTs) which locate in CLBs and global routing architecture
  *******************************************************************/
+#include <map>
 #include <vector>
+#include <unordered_set>
 
 /* Headers from vtrutil library */
 #include "vtr_log.h"
@@ -12,11 +14,14 @@
 #include "vtr_time.h"
 
 #include "openfpga_naming.h"
+#include "openfpga_side_manager.h"
 
 #include "module_manager_utils.h"
+#include "bitstream_manager_utils.h"
 
 #include "build_grid_bitstream.h"
 #include "build_routing_bitstream.h"
+#include "build_tile_modules.h"
 #include "build_device_bitstream.h"
 
 /* begin namespace openfpga */
@@ -53,6 +58,47 @@ size_t rec_estimate_device_bitstream_num_blocks(const ModuleManager& module_mana
   return num_blocks;
 }
 
+/********************************************************************
+ * Collect the unique names of the blocks to be added to the whole device bitstream
+ * The names of blocks are the instance names of configurable children,
+ * so that each unique module is visited only once
+ *******************************************************************/
+static 
+void rec_collect_device_bitstream_block_names(const ModuleManager& module_manager,
+                                              const ModuleId& parent_module,
+                                              std::unordered_set<ModuleId>& visited_modules,
+                                              std::unordered_set<std::string>& block_names) {
+  if (false == visited_modules.insert(parent_module).second) {
+    return;
+  }
+
+  std::vector<ModuleId> configurable_children = module_manager.configurable_children(parent_module);
+  std::vector<size_t> configurable_child_instances = module_manager.configurable_child_instances(parent_module);
+  for (size_t ichild = 0; ichild < configurable_children.size(); ++ichild) {
+    const ModuleId& child_module = configurable_children[ichild];
+    /* Memory elements are not blocks */
+    if (0 == module_manager.configurable_children(child_module).size()) {
+      continue;
+    }
+    block_names.insert(module_manager.instance_name(parent_module, child_module, configurable_child_instances[ichild]));
+    rec_collect_device_bitstream_block_names(module_manager, child_module, visited_modules, block_names);
+  }
+}
+
+/********************************************************************
+ * Estimate the number of unique block names to be added to the whole device bitstream
+ *******************************************************************/
+static 
+size_t estimate_device_bitstream_num_block_names(const ModuleManager& module_manager,
+                                                 const ModuleId& top_module) {
+  std::unordered_set<ModuleId> visited_modules;
+  std::unordered_set<std::string> block_names;
+  rec_collect_device_bitstream_block_names(module_manager, top_module, visited_modules, block_names);
+
+  /* Count the name of top block as well as the empty name */
+  return block_names.size() + 2;
+}
+
 /********************************************************************
  * Estimate the number of configuration bits to be added to the whole device bitstream
  * This function will recursively walk through the module graph 
@@ -129,6 +175,107 @@ size_t rec_estimate_device_bitstream_num_bits(const ModuleManager& module_manage
   return num_bits;
 }
 
+/********************************************************************
+ * Copy a block and all its child blocks from another bitstream
+ * under a given parent block, while the copied block is renamed
+ * A shared block is copied as a shared block referring to the same contents
+ *******************************************************************/
+static 
+void rec_copy_bitstream_block(BitstreamManager& bitstream_manager,
+                              const ConfigBlockId& parent_block,
+                              const BitstreamManager& src_bitstream_manager,
+                              const ConfigBlockId& src_block,
+                              const std::string& block_name) {
+  if (true == src_bitstream_manager.is_shared_block(src_block)) {
+    bitstream_manager.add_shared_block(parent_block, block_name,
+                                       src_bitstream_manager.shared_block_bitstream(src_block),
+                                       src_bitstream_manager.shared_block_source(src_block));
+    return;
+  }
+
+  ConfigBlockId block = bitstream_manager.add_block(block_name);
+  bitstream_manager.add_child_block(parent_block, block);
+
+  bitstream_manager.add_path_id_to_block(block, src_bitstream_manager.block_path_id(src_block));
+  bitstream_manager.add_input_net_id_to_block(block, src_bitstream_manager.block_input_net_ids(src_block));
+  bitstream_manager.add_output_net_id_to_block(block, src_bitstream_manager.block_output_net_ids(src_block));
+
+  std::vector<bool> block_bitstream;
+  for (const ConfigBitId& bit : src_bitstream_manager.block_bits(src_block)) {
+    block_bitstream.push_back(src_bitstream_manager.bit_value(bit));
+  }
+  bitstream_manager.add_block_bits(block, block_bitstream);
+
+  std::vector<ConfigBlockId> src_child_blocks = src_bitstream_manager.block_children(src_block);
+  bitstream_manager.reserve_child_blocks(block, src_child_blocks.size());
+  for (const ConfigBlockId& src_child_block : src_child_blocks) {
+    rec_copy_bitstream_block(bitstream_manager, block,
+                             src_bitstream_manager, src_child_block,
+                             src_bitstream_manager.block_name(src_child_block));
+  }
+}
+
+/********************************************************************
+ * Group the blocks of grids and routing blocks into tiles,
+ * in the same way as the top-level module is organized with tiles.
+ * Each tile is a block under the top-level block, 
+ * and the blocks of a tile are named by their roles in the tile
+ *******************************************************************/
+static 
+BitstreamManager build_tile_device_bitstream(const BitstreamManager& src_bitstream_manager,
+                                             const DeviceGrid& grids,
+                                             const DeviceRRGSB& device_rr_gsb,
+                                             const bool& compact_routing_hierarchy,
+                                             const size_t& num_blocks_to_reserve,
+                                             const size_t& num_block_names_to_reserve,
+                                             const size_t& num_bits_to_reserve) {
+  vtr::ScopedStartFinishTimer timer("Group bitstream blocks into tiles");
+
+  std::vector<ConfigBlockId> src_top_blocks = find_bitstream_manager_top_blocks(src_bitstream_manager);
+  VTR_ASSERT(1 == src_top_blocks.size());
+  std::map<std::string, ConfigBlockId> src_top_child_blocks;
+  for (const ConfigBlockId& child_block : src_bitstream_manager.block_children(src_top_blocks[0])) {
+    src_top_child_blocks[src_bitstream_manager.block_name(child_block)] = child_block;
+  }
+
+  BitstreamManager bitstream_manager;
+  bitstream_manager.reserve_blocks(num_blocks_to_reserve);
+  bitstream_manager.reserve_block_names(num_block_names_to_reserve);
+  bitstream_manager.reserve_bits(num_bits_to_reserve);
+  ConfigBlockId top_block = bitstream_manager.add_block(src_bitstream_manager.block_name(src_top_blocks[0]));
+
+  size_t num_grouped_blocks = 0;
+  vtr::Matrix<std::vector<TileMember>> tile_members = find_fabric_tile_members(grids, device_rr_gsb, compact_routing_hierarchy);
+  for (size_t ix = 0; ix < grids.width(); ++ix) {
+    for (size_t iy = 0; iy < grids.height(); ++iy) {
+      /* Only blocks with configuration bits are in the bitstream */
+      std::vector<std::pair<std::string, ConfigBlockId>> member_blocks;
+      for (const TileMember& member : tile_members[ix][iy]) {
+        auto result = src_top_child_blocks.find(member.instance_name);
+        if (result != src_top_child_blocks.end()) {
+          member_blocks.push_back(std::make_pair(member.role, result->second));
+        }
+      }
+      if (true == member_blocks.empty()) {
+        continue;
+      }
+      ConfigBlockId tile_block = bitstream_manager.add_block(generate_tile_module_name(vtr::Point<size_t>(ix, iy)));
+      bitstream_manager.add_child_block(top_block, tile_block);
+      bitstream_manager.reserve_child_blocks(tile_block, member_blocks.size());
+      for (const std::pair<std::string, ConfigBlockId>& member_block : member_blocks) {
+        rec_copy_bitstream_block(bitstream_manager, tile_block,
+                                 src_bitstream_manager, member_block.second,
+                                 member_block.first);
+      }
+      num_grouped_blocks += member_blocks.size();
+    }
+  }
+  /* All the blocks should be in tiles */
+  VTR_ASSERT(num_grouped_blocks == src_top_child_blocks.size());
+
+  return bitstream_manager;
+}
+
 /********************************************************************
  * A top-level function to build a bistream from the FPGA device
  * 1. It will organize the bitstream w.r.t. the hierarchy of module graphs 
@@ -141,9 +288,14 @@ size_t rec_estimate_device_bitstream_num_bits(const ModuleManager& module_manage
  * Note: this function create a bitstream which is binding to the module graphs
  * of the FPGA fabric that FPGA-X2P generates!
  * But it can be used to output a generic bitstream for VPR mapping FPGA
+ *
+ * When the bitstreams of unused grids are shared, the blocks and bits
+ * are not all stored, and thus not reserved
  *******************************************************************/
 BitstreamManager build_device_bitstream(const VprContext& vpr_ctx,
                                         const OpenfpgaContext& openfpga_ctx,
+                                        const bool& share_unused_grids,
+                                        const size_t& num_threads,
                                         const bool& verbose) {
 
   std::string timer_message = std::string("\nBuild fabric-independent bitstream for implementation '") + vpr_ctx.atom().nlist.netlist_name() + std::string("'\n");
@@ -163,16 +315,26 @@ BitstreamManager build_device_bitstream(const VprContext& vpr_ctx,
   /* Estimate the number of blocks to be added to the database */
   size_t num_blocks_to_reserve = rec_estimate_device_bitstream_num_blocks(openfpga_ctx.module_graph(),
                                                                           top_module);
-  bitstream_manager.reserve_blocks(num_blocks_to_reserve);
-  VTR_LOGV(verbose, "Reserved %lu configurable blocks\n", num_blocks_to_reserve);
+  if (false == share_unused_grids) {
+    bitstream_manager.reserve_blocks(num_blocks_to_reserve);
+    VTR_LOGV(verbose, "Reserved %lu configurable blocks\n", num_blocks_to_reserve);
+  }
+
+  /* Estimate the number of unique block names to be added to the database */
+  size_t num_block_names_to_reserve = estimate_device_bitstream_num_block_names(openfpga_ctx.module_graph(),
+                                                                                top_module);
+  bitstream_manager.reserve_block_names(num_block_names_to_reserve);
+  VTR_LOGV(verbose, "Reserved %lu unique block names\n", num_block_names_to_reserve);
 
   /* Estimate the number of bits to be added to the database */
   size_t num_bits_to_reserve = rec_estimate_device_bitstream_num_bits(openfpga_ctx.module_graph(),
                                                                       top_module,
                                                                       top_module,
                                                                       openfpga_ctx.arch().config_protocol.type());
-  bitstream_manager.reserve_bits(num_bits_to_reserve);
-  VTR_LOGV(verbose, "Reserved %lu configuration bits\n", num_bits_to_reserve);
+  if (false == share_unused_grids) {
+    bitstream_manager.reserve_bits(num_bits_to_reserve);
+    VTR_LOGV(verbose, "Reserved %lu configuration bits\n", num_bits_to_reserve);
+  }
 
   /* Reserve child blocks for the top level block */
   bitstream_manager.reserve_child_blocks(top_block,
@@ -190,6 +352,8 @@ BitstreamManager build_device_bitstream(const VprContext& vpr_ctx,
                        openfpga_ctx.vpr_clustering_annotation(),
                        openfpga_ctx.vpr_placement_annotation(),
                        openfpga_ctx.vpr_bitstream_annotation(),
+                       share_unused_grids,
+                       num_threads,
                        verbose);
   VTR_LOGV(verbose, "Done\n");
 
@@ -204,9 +368,28 @@ BitstreamManager build_device_bitstream(const VprContext& vpr_ctx,
                           openfpga_ctx.vpr_routing_annotation(),
                           vpr_ctx.device().rr_graph,
                           openfpga_ctx.device_rr_gsb(),
-                          openfpga_ctx.flow_manager().compress_routing());
+                          openfpga_ctx.flow_manager().compress_routing(),
+                          num_threads);
   VTR_LOGV(verbose, "Done\n");
 
+  /* Organize the blocks in the same way as the top-level module with tiles */
+  if (true == openfpga_ctx.flow_manager().group_tile()) {
+    bitstream_manager = build_tile_device_bitstream(bitstream_manager,
+                                                    vpr_ctx.device().grid,
+                                                    openfpga_ctx.device_rr_gsb(),
+                                                    openfpga_ctx.flow_manager().compress_routing(),
+                                                    (true == share_unused_grids) ? 0 : num_blocks_to_reserve,
+                                                    num_block_names_to_reserve,
+                                                    (true == share_unused_grids) ? 0 : num_bits_to_reserve);
+  }
+
+  if (true == share_unused_grids) {
+    VTR_LOGV(verbose,
+             "Decoded configuration bits into %lu blocks, where the bitstreams of unused grids are shared\n",
+             bitstream_manager.num_blocks());
+    return bitstream_manager;
+  }
+
   VTR_LOGV(verbose,
            "Decoded %lu configuration bits into %lu blocks\n",
            bitstream_manager.num_bits(),
@@ -218,4 +401,216 @@ BitstreamManager build_device_bitstream(const VprContext& vpr_ctx,
   return bitstream_manager;
 }
 
+
+/********************************************************************
+ * Check if the snapshot of a previous bitstream build can be used
+ * to update the architecture bitstream incrementally:
+ * the bitstream should be built from the same netlists on the same fabric,
+ * which is not changed since the snapshot is taken
+ *******************************************************************/
+static 
+bool is_bitstream_build_snapshot_usable(const BitstreamManager& bitstream_manager,
+                                        const BitstreamBuildSnapshot& snapshot,
+                                        const VprContext& vpr_ctx) {
+  if (true == snapshot.empty()) {
+    VTR_LOG("No bitstream has been built incrementally before\n");
+    return false;
+  }
+
+  if ( (snapshot.num_bitstream_blocks() != bitstream_manager.num_blocks())
+    || (snapshot.num_bitstream_bits() != bitstream_manager.num_bits()) ) {
+    VTR_LOG("Architecture bitstream has been changed since it was built\n");
+    return false;
+  }
+
+  if ( (snapshot.atom_netlist_id() != vpr_ctx.atom().nlist.netlist_id())
+    || (snapshot.clustered_netlist_id() != vpr_ctx.clustering().clb_nlist.netlist_id()) ) {
+    VTR_LOG("Netlists have been changed since the bitstream was built\n");
+    return false;
+  }
+
+  if ( (snapshot.grid_size() != vtr::Point<size_t>(vpr_ctx.device().grid.width(), vpr_ctx.device().grid.height()))
+    || (snapshot.num_rr_nodes() != vpr_ctx.device().rr_graph.nodes().size()) ) {
+    VTR_LOG("Device has been changed since the bitstream was built\n");
+    return false;
+  }
+
+  return true;
+}
+
+/********************************************************************
+ * Compare the implementation results with a snapshot and find
+ * - the grids whose mapped blocks or pins are changed
+ * - the GSBs where any of routing resource nodes is changed
+ * A routing resource node is changed when its net or its previous node
+ * in the routing tree is changed
+ *******************************************************************/
+static 
+void find_device_bitstream_changes(const BitstreamBuildSnapshot& snapshot,
+                                   const VprContext& vpr_ctx,
+                                   const OpenfpgaContext& openfpga_ctx,
+                                   vtr::Matrix<bool>& changed_grids,
+                                   vtr::Matrix<bool>& changed_gsbs) {
+  const DeviceGrid& grids = vpr_ctx.device().grid;
+  const RRGraph& rr_graph = vpr_ctx.device().rr_graph;
+  const VprRoutingAnnotation& routing_annotation = openfpga_ctx.vpr_routing_annotation();
+
+  /* Find changed nodes */
+  vtr::vector<RRNodeId, bool> changed_nodes(rr_graph.nodes().size(), false);
+  for (const RRNodeId& node : rr_graph.nodes()) {
+    if ( (routing_annotation.rr_node_net(node) != snapshot.routing_annotation().rr_node_net(node))
+      || (routing_annotation.rr_node_prev_node(node) != snapshot.routing_annotation().rr_node_prev_node(node)) ) {
+      changed_nodes[node] = true;
+    }
+  }
+
+  /* A grid is changed when its mapped blocks or the nets of its pins are changed.
+   * The changes are marked at the root of the grid, which is where the bitstream is built
+   */
+  changed_grids.resize({grids.width(), grids.height()}, false);
+  for (size_t ix = 0; ix < grids.width(); ++ix) {
+    for (size_t iy = 0; iy < grids.height(); ++iy) {
+      vtr::Point<size_t> grid_coord(ix, iy);
+      if (openfpga_ctx.vpr_placement_annotation().grid_blocks(grid_coord) 
+          != snapshot.placement_annotation().grid_blocks(grid_coord)) {
+        changed_grids[ix - grids[ix][iy].width_offset][iy - grids[ix][iy].height_offset] = true;
+      }
+    }
+  }
+  for (const RRNodeId& node : rr_graph.nodes()) {
+    if ( (false == changed_nodes[node])
+      || ((IPIN != rr_graph.node_type(node)) && (OPIN != rr_graph.node_type(node))) ) {
+      continue;
+    }
+    size_t ix = rr_graph.node_xlow(node);
+    size_t iy = rr_graph.node_ylow(node);
+    changed_grids[ix - grids[ix][iy].width_offset][iy - grids[ix][iy].height_offset] = true;
+  }
+
+  /* A GSB is changed when any of its nodes is changed,
+   * which includes the inputs and outputs of all the routing multiplexers inside
+   */
+  const DeviceRRGSB& device_rr_gsb = openfpga_ctx.device_rr_gsb();
+  vtr::Point<size_t> gsb_range = device_rr_gsb.get_gsb_range();
+  changed_gsbs.resize({gsb_range.x(), gsb_range.y()}, false);
+  for (size_t ix = 0; ix < gsb_range.x(); ++ix) {
+    for (size_t iy = 0; iy < gsb_range.y(); ++iy) {
+      const RRGSB& rr_gsb = device_rr_gsb.get_gsb(ix, iy);
+      bool gsb_changed = false;
+      for (size_t side = 0; side < rr_gsb.get_num_sides() && (false == gsb_changed); ++side) {
+        SideManager side_manager(side);
+        for (size_t itrack = 0; itrack < rr_gsb.get_chan_width(side_manager.get_side()); ++itrack) {
+          gsb_changed |= changed_nodes[rr_gsb.get_chan_node(side_manager.get_side(), itrack)];
+        }
+        for (size_t inode = 0; inode < rr_gsb.get_num_ipin_nodes(side_manager.get_side()); ++inode) {
+          gsb_changed |= changed_nodes[rr_gsb.get_ipin_node(side_manager.get_side(), inode)];
+        }
+        for (size_t inode = 0; inode < rr_gsb.get_num_opin_nodes(side_manager.get_side()); ++inode) {
+          gsb_changed |= changed_nodes[rr_gsb.get_opin_node(side_manager.get_side(), inode)];
+        }
+      }
+      changed_gsbs[ix][iy] = gsb_changed;
+    }
+  }
+}
+
+/********************************************************************
+ * Update the architecture bitstream of the FPGA device incrementally,
+ * e.g., after an Engineering Change Order (ECO) which re-places or re-routes
+ * a few nets. The implementation results are compared with the snapshot
+ * taken when the bitstream was built, and only the bitstreams of
+ * the changed grids and GSBs are built again, which overwrite their blocks
+ * in the bitstream. The blocks and bits of the bitstream are kept, so that 
+ * the result is the same as building the bitstream from scratch
+ *
+ * Return false if the snapshot cannot be used, in which case the bitstream
+ * should be built from scratch
+ *******************************************************************/
+bool update_device_bitstream(BitstreamManager& bitstream_manager,
+                             const BitstreamBuildSnapshot& snapshot,
+                             const VprContext& vpr_ctx,
+                             const OpenfpgaContext& openfpga_ctx,
+                             const size_t& num_threads,
+                             const bool& verbose) {
+  if (false == is_bitstream_build_snapshot_usable(bitstream_manager, snapshot, vpr_ctx)) {
+    return false;
+  }
+
+  std::string timer_message = std::string("\nUpdate fabric-independent bitstream for implementation '") + vpr_ctx.atom().nlist.netlist_name() + std::string("'\n");
+  vtr::ScopedStartFinishTimer timer(timer_message);
+
+  vtr::Matrix<bool> changed_grids;
+  vtr::Matrix<bool> changed_gsbs;
+  find_device_bitstream_changes(snapshot, vpr_ctx, openfpga_ctx, changed_grids, changed_gsbs);
+
+  /* Find the blocks of grids and routing modules by their names */
+  std::vector<ConfigBlockId> top_blocks = find_bitstream_manager_top_blocks(bitstream_manager);
+  VTR_ASSERT(1 == top_blocks.size());
+  std::map<std::string, ConfigBlockId> top_child_blocks;
+  for (const ConfigBlockId& child_block : bitstream_manager.block_children(top_blocks[0])) {
+    top_child_blocks[bitstream_manager.block_name(child_block)] = child_block;
+  }
+  /* When grouped in tiles, the blocks are found in the tile blocks by their roles */
+  if (true == openfpga_ctx.flow_manager().group_tile()) {
+    std::map<std::string, ConfigBlockId> tile_blocks;
+    tile_blocks.swap(top_child_blocks);
+    vtr::Matrix<std::vector<TileMember>> tile_members = find_fabric_tile_members(vpr_ctx.device().grid,
+                                                                                 openfpga_ctx.device_rr_gsb(),
+                                                                                 openfpga_ctx.flow_manager().compress_routing());
+    for (size_t ix = 0; ix < vpr_ctx.device().grid.width(); ++ix) {
+      for (size_t iy = 0; iy < vpr_ctx.device().grid.height(); ++iy) {
+        auto tile_result = tile_blocks.find(generate_tile_module_name(vtr::Point<size_t>(ix, iy)));
+        if (tile_result == tile_blocks.end()) {
+          continue;
+        }
+        for (const TileMember& member : tile_members[ix][iy]) {
+          for (const ConfigBlockId& member_block : bitstream_manager.block_children(tile_result->second)) {
+            if (member.role == bitstream_manager.block_name(member_block)) {
+              top_child_blocks[member.instance_name] = member_block;
+            }
+          }
+        }
+      }
+    }
+  }
+
+  size_t num_changed_bits = 0;
+
+  VTR_LOGV(verbose, "Updating grid bitstream...\n");
+  num_changed_bits += update_grid_bitstream(bitstream_manager, top_child_blocks,
+                                            openfpga_ctx.module_graph(),
+                                            openfpga_ctx.arch().circuit_lib,
+                                            openfpga_ctx.mux_lib(),
+                                            vpr_ctx.device().grid,
+                                            vpr_ctx.atom(),
+                                            openfpga_ctx.vpr_device_annotation(),
+                                            openfpga_ctx.vpr_clustering_annotation(),
+                                            openfpga_ctx.vpr_placement_annotation(),
+                                            openfpga_ctx.vpr_bitstream_annotation(),
+                                            changed_grids,
+                                            num_threads,
+                                            verbose);
+  VTR_LOGV(verbose, "Done\n");
+
+  VTR_LOGV(verbose, "Updating routing bitstream...\n");
+  num_changed_bits += update_routing_bitstream(bitstream_manager, top_child_blocks,
+                                               openfpga_ctx.module_graph(),
+                                               openfpga_ctx.arch().circuit_lib,
+                                               openfpga_ctx.mux_lib(),
+                                               vpr_ctx.atom(),
+                                               openfpga_ctx.vpr_device_annotation(),
+                                               openfpga_ctx.vpr_routing_annotation(),
+                                               vpr_ctx.device().rr_graph,
+                                               openfpga_ctx.device_rr_gsb(),
+                                               openfpga_ctx.flow_manager().compress_routing(),
+                                               changed_gsbs,
+                                               num_threads);
+  VTR_LOGV(verbose, "Done\n");
+
+  VTR_LOG("Changed %lu out of %lu configuration bits\n",
+          num_changed_bits, bitstream_manager.num_bits());
+
+  return true;
+}
+
 } /* end namespace openfpga */
@@ -7,6 +7,7 @@
 #include <vector>
 #include "vpr_context.h"
 #include "openfpga_context.h"
+#include "bitstream_build_snapshot.h"
 
 /********************************************************************
  * Function declaration
@@ -17,8 +18,17 @@ namespace openfpga {
 
 BitstreamManager build_device_bitstream(const VprContext& vpr_ctx,
                                         const OpenfpgaContext& openfpga_ctx,
+                                        const bool& share_unused_grids,
+                                        const size_t& num_threads,
                                         const bool& verbose);
 
+bool update_device_bitstream(BitstreamManager& bitstream_manager,
+                             const BitstreamBuildSnapshot& snapshot,
+                             const VprContext& vpr_ctx,
+                             const OpenfpgaContext& openfpga_ctx,
+                             const size_t& num_threads,
+                             const bool& verbose);
+
 } /* end namespace openfpga */
 
 #endif
@@ -4,6 +4,7 @@
 #include <string>
 #include <cmath>
 #include <algorithm>
+#include <unordered_map>
 
 /* Headers from vtrutil library */
 #include "vtr_assert.h"
@@ -12,17 +13,55 @@
 
 /* Headers from openfpgautil library */
 #include "openfpga_decode.h"
+#include "openfpga_parallel.h"
 
 #include "openfpga_reserved_words.h"
 #include "openfpga_naming.h"
 
 #include "decoder_library_utils.h"
+#include "module_manager_utils.h"
 #include "bitstream_manager_utils.h"
 #include "build_fabric_bitstream.h"
 
 /* begin namespace openfpga */
 namespace openfpga {
 
+/********************************************************************
+ * Find the blocks in bitstream manager which correspond to the configurable
+ * children of a module, in the same order as the configurable children.
+ * The child blocks are indexed by their names once for each parent block,
+ * so that each child is found in constant time, rather than by comparing
+ * its instance name with the names of all the child blocks
+ * Configurable children without any block, e.g., decoders, get an invalid id
+ *******************************************************************/
+static 
+std::vector<ConfigBlockId> find_configurable_child_blocks(const BitstreamManager& bitstream_manager,
+                                                          const ConfigBlockId& parent_block,
+                                                          const ModuleManager& module_manager,
+                                                          const ModuleId& parent_module,
+                                                          const std::vector<ModuleId>& configurable_children,
+                                                          const std::vector<size_t>& configurable_child_instances) {
+  VTR_ASSERT(configurable_children.size() == configurable_child_instances.size());
+
+  std::unordered_map<std::string, ConfigBlockId> child_block_lookup;
+  child_block_lookup.reserve(bitstream_manager.num_block_children(parent_block));
+  for (const ConfigBlockId& child_block : bitstream_manager.block_children(parent_block)) {
+    child_block_lookup[bitstream_manager.block_name(child_block)] = child_block;
+  }
+
+  std::vector<ConfigBlockId> child_blocks(configurable_children.size(), ConfigBlockId::INVALID());
+  for (size_t child_id = 0; child_id < configurable_children.size(); ++child_id) {
+    /* Get the instance name and ensure it is not empty */
+    std::string instance_name = module_manager.instance_name(parent_module, configurable_children[child_id], configurable_child_instances[child_id]);
+    auto result = child_block_lookup.find(instance_name);
+    if (child_block_lookup.end() != result) {
+      child_blocks[child_id] = result->second;
+    }
+  }
+
+  return child_blocks;
+}
+
 /********************************************************************
  * This function aims to build a bitstream for configuration chain-like protocol
  * It will walk through all the configurable children under a module
@@ -47,50 +86,37 @@ void rec_build_module_fabric_dependent_chain_bitstream(const BitstreamManager& b
   /* Depth-first search: if we have any children in the parent_block, 
    * we dive to the next level first! 
    */
-  if (0 < bitstream_manager.block_children(parent_block).size()) {
+  if (0 < bitstream_manager.num_block_children(parent_block)) {
+    std::vector<ModuleId> configurable_children;
+    std::vector<size_t> configurable_child_instances;
     if (parent_module == top_module) {
-      for (size_t child_id = 0; child_id < module_manager.region_configurable_children(parent_module, config_region).size(); ++child_id) {
-        ModuleId child_module = module_manager.region_configurable_children(parent_module, config_region)[child_id]; 
-        size_t child_instance = module_manager.region_configurable_child_instances(parent_module, config_region)[child_id]; 
-        /* Get the instance name and ensure it is not empty */
-        std::string instance_name = module_manager.instance_name(parent_module, child_module, child_instance);
-         
-        /* Find the child block that matches the instance name! */ 
-        ConfigBlockId child_block = bitstream_manager.find_child_block(parent_block, instance_name); 
-        /* We must have one valid block id! */
-        VTR_ASSERT(true == bitstream_manager.valid_block_id(child_block));
-
-        /* Go recursively */
-        rec_build_module_fabric_dependent_chain_bitstream(bitstream_manager, child_block,
-                                                          module_manager, top_module,
-                                                          child_module,
-                                                          config_region,
-                                                          fabric_bitstream,
-                                                          fabric_bitstream_region);
-      }
+      configurable_children = module_manager.region_configurable_children(parent_module, config_region);
+      configurable_child_instances = module_manager.region_configurable_child_instances(parent_module, config_region);
     } else { 
-      for (size_t child_id = 0; child_id < module_manager.configurable_children(parent_module).size(); ++child_id) {
-        ModuleId child_module = module_manager.configurable_children(parent_module)[child_id]; 
-        size_t child_instance = module_manager.configurable_child_instances(parent_module)[child_id]; 
-        /* Get the instance name and ensure it is not empty */
-        std::string instance_name = module_manager.instance_name(parent_module, child_module, child_instance);
-         
-        /* Find the child block that matches the instance name! */ 
-        ConfigBlockId child_block = bitstream_manager.find_child_block(parent_block, instance_name); 
-        /* We must have one valid block id! */
-        VTR_ASSERT(true == bitstream_manager.valid_block_id(child_block));
-
-        /* Go recursively */
-        rec_build_module_fabric_dependent_chain_bitstream(bitstream_manager, child_block,
-                                                          module_manager, top_module,
-                                                          child_module,
-                                                          config_region,
-                                                          fabric_bitstream,
-                                                          fabric_bitstream_region);
-      }
+      configurable_children = module_manager.configurable_children(parent_module);
+      configurable_child_instances = module_manager.configurable_child_instances(parent_module);
+    }
+
+    /* Find the child blocks that match the instance names! */ 
+    std::vector<ConfigBlockId> child_blocks = find_configurable_child_blocks(bitstream_manager, parent_block,
+                                                                            module_manager, parent_module,
+                                                                            configurable_children,
+                                                                            configurable_child_instances);
+
+    for (size_t child_id = 0; child_id < configurable_children.size(); ++child_id) {
+      /* We must have one valid block id! */
+      VTR_ASSERT(true == bitstream_manager.valid_block_id(child_blocks[child_id]));
+
+      /* Go recursively */
+      rec_build_module_fabric_dependent_chain_bitstream(bitstream_manager, child_blocks[child_id],
+                                                        module_manager, top_module,
+                                                        configurable_children[child_id],
+                                                        config_region,
+                                                        fabric_bitstream,
+                                                        fabric_bitstream_region);
     }
     /* Ensure that there should be no configuration bits in the parent block */
-    VTR_ASSERT(0 == bitstream_manager.block_bits(parent_block).size());
+    VTR_ASSERT(0 == bitstream_manager.num_block_bits(parent_block));
   }
 
   /* Note that, reach here, it means that this is a leaf node. 
@@ -125,8 +151,6 @@ void rec_build_module_fabric_dependent_memory_bank_bitstream(const BitstreamMana
                                                              const ModuleId& top_module,
                                                              const ModuleId& parent_module,
                                                              const ConfigRegionId& config_region,
-                                                             const size_t& bl_addr_size,
-                                                             const size_t& wl_addr_size,
                                                              const size_t& num_bls,
                                                              const size_t& num_wls, 
                                                              size_t& cur_mem_index,
@@ -136,88 +160,61 @@ void rec_build_module_fabric_dependent_memory_bank_bitstream(const BitstreamMana
   /* Depth-first search: if we have any children in the parent_block, 
    * we dive to the next level first! 
    */
-  if (0 < bitstream_manager.block_children(parent_block).size()) {
-    /* For top module:
-     *   - Use regional configurable children
-     *   - we will skip the two decoders at the end of the configurable children list
-     */
+  if (0 < bitstream_manager.num_block_children(parent_block)) {
+    std::vector<ModuleId> configurable_children;
+    std::vector<size_t> configurable_child_instances;
+    size_t num_configurable_children = 0;
     if (parent_module == top_module) {
-      std::vector<ModuleId> configurable_children = module_manager.region_configurable_children(parent_module, config_region);
+      /* For top module:
+       *   - Use regional configurable children
+       *   - we will skip the two decoders at the end of the configurable children list
+       */
+      configurable_children = module_manager.region_configurable_children(parent_module, config_region);
+      configurable_child_instances = module_manager.region_configurable_child_instances(parent_module, config_region);
 
       VTR_ASSERT(2 <= configurable_children.size()); 
-      size_t num_configurable_children = configurable_children.size() - 2;
-
-      /* Early exit if there is no configurable children */
-      if (0 == num_configurable_children) {
-        /* Ensure that there should be no configuration bits in the parent block */
-        VTR_ASSERT(0 == bitstream_manager.block_bits(parent_block).size());
-        return;
-      }
-
-      for (size_t child_id = 0; child_id < num_configurable_children; ++child_id) {
-        ModuleId child_module = configurable_children[child_id]; 
-        size_t child_instance = module_manager.region_configurable_child_instances(parent_module, config_region)[child_id]; 
-
-        /* Get the instance name and ensure it is not empty */
-        std::string instance_name = module_manager.instance_name(parent_module, child_module, child_instance);
-         
-        /* Find the child block that matches the instance name! */ 
-        ConfigBlockId child_block = bitstream_manager.find_child_block(parent_block, instance_name); 
-        /* We must have one valid block id! */
-        VTR_ASSERT(true == bitstream_manager.valid_block_id(child_block));
-
-        /* Go recursively */
-        rec_build_module_fabric_dependent_memory_bank_bitstream(bitstream_manager, child_block,
-                                                                module_manager, top_module, child_module,
-                                                                config_region,
-                                                                bl_addr_size, wl_addr_size,
-                                                                num_bls, num_wls,
-                                                                cur_mem_index,
-                                                                fabric_bitstream,
-                                                                fabric_bitstream_region);
-      }
+      num_configurable_children = configurable_children.size() - 2;
     } else {
       VTR_ASSERT(parent_module != top_module);
       /* For other modules:
        *   - Use configurable children directly
        *   - no need to exclude decoders as they are not there
        */
-      std::vector<ModuleId> configurable_children = module_manager.configurable_children(parent_module);
+      configurable_children = module_manager.configurable_children(parent_module);
+      configurable_child_instances = module_manager.configurable_child_instances(parent_module);
 
-      size_t num_configurable_children = configurable_children.size();
+      num_configurable_children = configurable_children.size();
+    }
 
-      /* Early exit if there is no configurable children */
-      if (0 == num_configurable_children) {
-        /* Ensure that there should be no configuration bits in the parent block */
-        VTR_ASSERT(0 == bitstream_manager.block_bits(parent_block).size());
-        return;
-      }
+    /* Early exit if there is no configurable children */
+    if (0 == num_configurable_children) {
+      /* Ensure that there should be no configuration bits in the parent block */
+      VTR_ASSERT(0 == bitstream_manager.num_block_bits(parent_block));
+      return;
+    }
 
-      for (size_t child_id = 0; child_id < num_configurable_children; ++child_id) {
-        ModuleId child_module = configurable_children[child_id]; 
-        size_t child_instance = module_manager.configurable_child_instances(parent_module)[child_id]; 
-
-        /* Get the instance name and ensure it is not empty */
-        std::string instance_name = module_manager.instance_name(parent_module, child_module, child_instance);
-         
-        /* Find the child block that matches the instance name! */ 
-        ConfigBlockId child_block = bitstream_manager.find_child_block(parent_block, instance_name); 
-        /* We must have one valid block id! */
-        VTR_ASSERT(true == bitstream_manager.valid_block_id(child_block));
-
-        /* Go recursively */
-        rec_build_module_fabric_dependent_memory_bank_bitstream(bitstream_manager, child_block,
-                                                                module_manager, top_module, child_module,
-                                                                config_region,
-                                                                bl_addr_size, wl_addr_size,
-                                                                num_bls, num_wls,
-                                                                cur_mem_index,
-                                                                fabric_bitstream,
-                                                                fabric_bitstream_region);
-      }
+    /* Find the child blocks that match the instance names! */ 
+    std::vector<ConfigBlockId> child_blocks = find_configurable_child_blocks(bitstream_manager, parent_block,
+                                                                            module_manager, parent_module,
+                                                                            configurable_children,
+                                                                            configurable_child_instances);
+
+    for (size_t child_id = 0; child_id < num_configurable_children; ++child_id) {
+      /* We must have one valid block id! */
+      VTR_ASSERT(true == bitstream_manager.valid_block_id(child_blocks[child_id]));
+
+      /* Go recursively */
+      rec_build_module_fabric_dependent_memory_bank_bitstream(bitstream_manager, child_blocks[child_id],
+                                                              module_manager, top_module,
+                                                              configurable_children[child_id],
+                                                              config_region,
+                                                              num_bls, num_wls,
+                                                              cur_mem_index,
+                                                              fabric_bitstream,
+                                                              fabric_bitstream_region);
     }
     /* Ensure that there should be no configuration bits in the parent block */
-    VTR_ASSERT(0 == bitstream_manager.block_bits(parent_block).size());
+    VTR_ASSERT(0 == bitstream_manager.num_block_bits(parent_block));
 
     return;
   }
@@ -230,18 +227,16 @@ void rec_build_module_fabric_dependent_memory_bank_bitstream(const BitstreamMana
     FabricBitId fabric_bit = fabric_bitstream.add_bit(config_bit);
   
     /* Find BL address */
-    size_t cur_bl_index = std::floor(cur_mem_index / num_bls);
-    std::vector<char> bl_addr_bits_vec = itobin_charvec(cur_bl_index, bl_addr_size);
+    size_t cur_bl_index = cur_mem_index / num_bls;
 
     /* Find WL address */
     size_t cur_wl_index = cur_mem_index % num_wls;
-    std::vector<char> wl_addr_bits_vec = itobin_charvec(cur_wl_index, wl_addr_size);
 
     /* Set BL address */
-    fabric_bitstream.set_bit_bl_address(fabric_bit, bl_addr_bits_vec);
+    fabric_bitstream.set_bit_bl_address(fabric_bit, cur_bl_index);
 
     /* Set WL address */
-    fabric_bitstream.set_bit_wl_address(fabric_bit, wl_addr_bits_vec);
+    fabric_bitstream.set_bit_wl_address(fabric_bit, cur_wl_index);
     
     /* Set data input */
     fabric_bitstream.set_bit_din(fabric_bit, bitstream_manager.bit_value(config_bit));
@@ -276,6 +271,10 @@ void rec_build_module_fabric_dependent_memory_bank_bitstream(const BitstreamMana
  *
  * For each configuration bit, the data_in for the frame-based decoders will be 
  * the same as the configuration bit in bitstream manager.
+ *
+ * When each frame loads W bits (the width of data_in of memory modules),
+ * the i-th bit of a memory module is loaded by the data_in[i % W]
+ * of the frame (i / W). This is co-designed with build_frame_memory_module()
  *******************************************************************/
 static 
 void rec_build_module_fabric_dependent_frame_bitstream(const BitstreamManager& bitstream_manager,
@@ -292,7 +291,7 @@ void rec_build_module_fabric_dependent_frame_bitstream(const BitstreamManager& b
   /* Depth-first search: if we have any children in the parent_block, 
    * we dive to the next level first! 
    */
-  if (0 < bitstream_manager.block_children(parent_blocks.back()).size()) {
+  if (0 < bitstream_manager.num_block_children(parent_blocks.back())) {
     const ConfigBlockId& parent_block = parent_blocks.back();
     const ModuleId& parent_module = parent_modules.back();
 
@@ -316,7 +315,7 @@ void rec_build_module_fabric_dependent_frame_bitstream(const BitstreamManager& b
     /* Early exit if there is no configurable children */
     if (0 == num_configurable_children) {
       /* Ensure that there should be no configuration bits in the parent block */
-      VTR_ASSERT(0 == bitstream_manager.block_bits(parent_block).size());
+      VTR_ASSERT(0 == bitstream_manager.num_block_bits(parent_block));
       return;
     }
 
@@ -348,14 +347,15 @@ void rec_build_module_fabric_dependent_frame_bitstream(const BitstreamManager& b
       }
     }
 
+    /* Find the child blocks that match the instance names! */ 
+    std::vector<ConfigBlockId> configurable_child_blocks = find_configurable_child_blocks(bitstream_manager, parent_block,
+                                                                                         module_manager, parent_module,
+                                                                                         configurable_children,
+                                                                                         configurable_child_instances);
+
     for (size_t child_id = 0; child_id < num_configurable_children; ++child_id) {
       ModuleId child_module = configurable_children[child_id]; 
-      size_t child_instance = configurable_child_instances[child_id]; 
-      /* Get the instance name and ensure it is not empty */
-      std::string instance_name = module_manager.instance_name(parent_module, child_module, child_instance);
-       
-      /* Find the child block that matches the instance name! */ 
-      ConfigBlockId child_block = bitstream_manager.find_child_block(parent_block, instance_name); 
+      ConfigBlockId child_block = configurable_child_blocks[child_id]; 
       /* We must have one valid block id! */
       VTR_ASSERT(true == bitstream_manager.valid_block_id(child_block));
 
@@ -437,7 +437,7 @@ void rec_build_module_fabric_dependent_frame_bitstream(const BitstreamManager& b
                                                         fabric_bitstream_region);
     }
     /* Ensure that there should be no configuration bits in the parent block */
-    VTR_ASSERT(0 == bitstream_manager.block_bits(parent_block).size());
+    VTR_ASSERT(0 == bitstream_manager.num_block_bits(parent_block));
    
     return;
   }
@@ -461,14 +461,29 @@ void rec_build_module_fabric_dependent_frame_bitstream(const BitstreamManager& b
   const ModulePortId& decoder_addr_port_id = module_manager.find_module_port(decoder_module, std::string(DECODER_ADDRESS_PORT_NAME));
   const BasicPort& decoder_addr_port = module_manager.module_port(decoder_module, decoder_addr_port_id);
 
-  for (size_t ibit = 0; ibit < bitstream_manager.block_bits(parent_blocks.back()).size(); ++ibit) {
-    
-    ConfigBitId config_bit = bitstream_manager.block_bits(parent_blocks.back())[ibit];
-    std::vector<char> addr_bits_vec = itobin_charvec(ibit, decoder_addr_port.get_width());
+  /* Find the number of bits loaded per frame */
+  size_t frame_data_width = find_module_frame_data_width(module_manager, parent_modules.back());
+  VTR_ASSERT(0 < frame_data_width);
 
-    std::vector<char> child_addr_code = addr_code;
+  /* The address of each bit is the frame address in the head, followed by the address code of the parents.
+   * A single address is reused for all the bits, where only the head is updated for each frame
+   */
+  size_t frame_addr_size = decoder_addr_port.get_width();
+  std::vector<char> child_addr_code(frame_addr_size, '0');
+  child_addr_code.insert(child_addr_code.end(), addr_code.begin(), addr_code.end());
 
-    child_addr_code.insert(child_addr_code.begin(), addr_bits_vec.begin(), addr_bits_vec.end());
+  std::vector<ConfigBitId> block_bits = bitstream_manager.block_bits(parent_blocks.back());
+  for (size_t ibit = 0; ibit < block_bits.size(); ++ibit) {
+    
+    ConfigBitId config_bit = block_bits[ibit];
+    if (0 == ibit % frame_data_width) {
+      size_t frame_addr = ibit / frame_data_width;
+      /* Make sure we do not have any overflow! */
+      VTR_ASSERT((frame_addr_size >= 8 * sizeof(size_t)) || (frame_addr < (size_t(1) << frame_addr_size)));
+      for (size_t iaddr = 0; iaddr < frame_addr_size; ++iaddr) {
+        child_addr_code[iaddr] = ( (iaddr < 8 * sizeof(size_t)) && (1 == ((frame_addr >> iaddr) & 1)) ) ? '1' : '0';
+      }
+    }
 
     const FabricBitId& fabric_bit = fabric_bitstream.add_bit(config_bit);
 
@@ -477,6 +492,7 @@ void rec_build_module_fabric_dependent_frame_bitstream(const BitstreamManager& b
     
     /* Set data input */
     fabric_bitstream.set_bit_din(fabric_bit, bitstream_manager.bit_value(config_bit));
+    fabric_bitstream.set_bit_din_index(fabric_bit, ibit % frame_data_width);
 
     /* Add the bit to the region */
     fabric_bitstream.add_bit_to_region(fabric_bitstream_region, fabric_bit);
@@ -484,116 +500,250 @@ void rec_build_module_fabric_dependent_frame_bitstream(const BitstreamManager& b
 }
 
 /********************************************************************
- * Main function to build a fabric-dependent bitstream
- * by considering the configuration protocol types 
+ * Count the number of configuration bits under a block of bitstream manager,
+ * including the bits of all its child blocks
  *******************************************************************/
 static 
-void build_module_fabric_dependent_bitstream(const ConfigProtocol& config_protocol,
+size_t rec_count_bitstream_block_num_bits(const BitstreamManager& bitstream_manager,
+                                          const ConfigBlockId& block) {
+  size_t num_bits = bitstream_manager.num_block_bits(block);
+  for (const ConfigBlockId& child_block : bitstream_manager.block_children(block)) {
+    num_bits += rec_count_bitstream_block_num_bits(bitstream_manager, child_block);
+  }
+  return num_bits;
+}
+
+/********************************************************************
+ * Count the number of configuration bits which will be added to 
+ * the fabric bitstream of a configurable region of the top module,
+ * so that the bit list of the region can be reserved before build-up 
+ * The configurable children without any block, e.g., decoders, are skipped 
+ *******************************************************************/
+static 
+size_t count_fabric_bitstream_region_num_bits(const BitstreamManager& bitstream_manager,
+                                              const ConfigBlockId& top_block,
+                                              const ModuleManager& module_manager,
+                                              const ModuleId& top_module,
+                                              const ConfigRegionId& config_region) {
+  size_t num_bits = 0;
+
+  std::vector<ModuleId> configurable_children = module_manager.region_configurable_children(top_module, config_region);
+  std::vector<size_t> configurable_child_instances = module_manager.region_configurable_child_instances(top_module, config_region);
+  for (const ConfigBlockId& child_block : find_configurable_child_blocks(bitstream_manager, top_block,
+                                                                         module_manager, top_module,
+                                                                         configurable_children,
+                                                                         configurable_child_instances)) {
+    if (false == bitstream_manager.valid_block_id(child_block)) {
+      continue;
+    }
+    num_bits += rec_count_bitstream_block_num_bits(bitstream_manager, child_block);
+  }
+
+  return num_bits;
+}
+
+/********************************************************************
+ * Build the fabric-dependent bitstream of a configurable region
+ * of the top module by considering the configuration protocol types 
+ * The fabric bitstream should have been set up for the protocol
+ * A region is added to the fabric bitstream unless it is not configurable
+ * Return false on errors, so that the caller can stop after
+ * all the worker threads are joined
+ *******************************************************************/
+static 
+bool build_region_fabric_dependent_bitstream(const ConfigProtocol& config_protocol,
                                              const BitstreamManager& bitstream_manager,
                                              const ConfigBlockId& top_block,
                                              const ModuleManager& module_manager,
                                              const ModuleId& top_module,
+                                             const ConfigRegionId& config_region,
+                                             const size_t& max_decoder_addr_size,
+                                             const char& bitstream_dont_care_char,
                                              FabricBitstream& fabric_bitstream) {
-
   switch (config_protocol.type()) {
   case CONFIG_MEM_STANDALONE: {
-    /* Reserve bits before build-up */
-    fabric_bitstream.reserve_bits(bitstream_manager.num_bits());
+    FabricBitRegionId fabric_bitstream_region = fabric_bitstream.add_region();
+    fabric_bitstream.reserve_region_bits(fabric_bitstream_region,
+                                         count_fabric_bitstream_region_num_bits(bitstream_manager, top_block,
+                                                                                module_manager, top_module,
+                                                                                config_region));
+    rec_build_module_fabric_dependent_chain_bitstream(bitstream_manager, top_block,
+                                                      module_manager, top_module, 
+                                                      top_module,
+                                                      config_region,
+                                                      fabric_bitstream,
+                                                      fabric_bitstream_region);
+    break;
+  }
+  case CONFIG_MEM_SCAN_CHAIN: { 
+    FabricBitRegionId fabric_bitstream_region = fabric_bitstream.add_region();
+    fabric_bitstream.reserve_region_bits(fabric_bitstream_region,
+                                         count_fabric_bitstream_region_num_bits(bitstream_manager, top_block,
+                                                                                module_manager, top_module,
+                                                                                config_region));
+    rec_build_module_fabric_dependent_chain_bitstream(bitstream_manager, top_block,
+                                                      module_manager, top_module, 
+                                                      top_module,
+                                                      config_region,
+                                                      fabric_bitstream,
+                                                      fabric_bitstream_region);
+    fabric_bitstream.reverse_region_bits(fabric_bitstream_region);
+    break;
+  }
+  case CONFIG_MEM_MEMORY_BANK: { 
+    size_t cur_mem_index = 0;
+
+    /* Find port information for local BL and WL decoder in this region */
+    std::vector<ModuleId> configurable_children = module_manager.region_configurable_children(top_module, config_region);
+    VTR_ASSERT(2 <= configurable_children.size()); 
+    ModuleId bl_decoder_module = configurable_children[configurable_children.size() - 2];
+    ModuleId wl_decoder_module = configurable_children[configurable_children.size() - 1];
+
+    ModulePortId bl_port = module_manager.find_module_port(bl_decoder_module, std::string(DECODER_DATA_OUT_PORT_NAME));
+    BasicPort bl_port_info = module_manager.module_port(bl_decoder_module, bl_port);
+
+    ModulePortId wl_port = module_manager.find_module_port(wl_decoder_module, std::string(DECODER_DATA_OUT_PORT_NAME));
+    BasicPort wl_port_info = module_manager.module_port(wl_decoder_module, wl_port);
+
+    /* Build the bitstream for all the blocks in this region */
+    FabricBitRegionId fabric_bitstream_region = fabric_bitstream.add_region();
+    fabric_bitstream.reserve_region_bits(fabric_bitstream_region,
+                                         count_fabric_bitstream_region_num_bits(bitstream_manager, top_block,
+                                                                                module_manager, top_module,
+                                                                                config_region));
+    rec_build_module_fabric_dependent_memory_bank_bitstream(bitstream_manager, top_block,
+                                                            module_manager, top_module, top_module, 
+                                                            config_region,
+                                                            bl_port_info.get_width(),
+                                                            wl_port_info.get_width(),
+                                                            cur_mem_index,
+                                                            fabric_bitstream,
+                                                            fabric_bitstream_region);
+    break;
+  }
+  case CONFIG_MEM_FRAME_BASED: {
+    std::vector<ModuleId> configurable_children = module_manager.region_configurable_children(top_module, config_region);
 
-    for (const ConfigRegionId& config_region : module_manager.regions(top_module)) {
-      FabricBitRegionId fabric_bitstream_region = fabric_bitstream.add_region();
-      rec_build_module_fabric_dependent_chain_bitstream(bitstream_manager, top_block,
-                                                        module_manager, top_module, 
-                                                        top_module,
-                                                        config_region,
-                                                        fabric_bitstream,
-                                                        fabric_bitstream_region);
+    /* Bypass non-configurable regions */
+    if (0 == configurable_children.size()) {
+      break;
     }
 
+    /* Find the idle address bit which should be added to the head of the address bit
+     * This depends on the number of address bits required by this region
+     * For example:
+     *   Top-level address is addr[0:4]
+     *   There are 4 decoders in the top-level module, whose address sizes are
+     *     decoder A: addr[0:4]
+     *     decoder B: addr[0:3]
+     *     decoder C: addr[0:2]
+     *     decoder D: addr[0:3]
+     *   For decoder A, the address fit well
+     *   For decoder B, an idle bit should be added '0' + addr[0:3] 
+     *   For decoder C, two idle bits should be added '00' + addr[0:2] 
+     *   For decoder D, an idle bit should be added '0' + addr[0:3] 
+     */
+    ModuleId decoder_module = configurable_children.back();
+    ModulePortId decoder_addr_port_id = module_manager.find_module_port(decoder_module, DECODER_ADDRESS_PORT_NAME);
+    BasicPort decoder_addr_port = module_manager.module_port(decoder_module, decoder_addr_port_id);
+    VTR_ASSERT(max_decoder_addr_size >= decoder_addr_port.get_width());
+    std::vector<char> idle_addr_bits(max_decoder_addr_size - decoder_addr_port.get_width(), bitstream_dont_care_char);
+   
+    FabricBitRegionId fabric_bitstream_region = fabric_bitstream.add_region();
+    fabric_bitstream.reserve_region_bits(fabric_bitstream_region,
+                                         count_fabric_bitstream_region_num_bits(bitstream_manager, top_block,
+                                                                                module_manager, top_module,
+                                                                                config_region));
+    rec_build_module_fabric_dependent_frame_bitstream(bitstream_manager,
+                                                      std::vector<ConfigBlockId>(1, top_block),
+                                                      module_manager,
+                                                      top_module,
+                                                      config_region,
+                                                      std::vector<ModuleId>(1, top_module),
+                                                      idle_addr_bits,
+                                                      bitstream_dont_care_char,
+                                                      fabric_bitstream,
+                                                      fabric_bitstream_region);
     break;
   }
-  case CONFIG_MEM_SCAN_CHAIN: { 
-    /* Reserve bits before build-up */
-    fabric_bitstream.reserve_bits(bitstream_manager.num_bits());
+  default:
+    VTR_LOGF_ERROR(__FILE__, __LINE__,
+                   "Invalid SRAM organization.\n");
+    return false;
+  }
 
-    for (const ConfigRegionId& config_region : module_manager.regions(top_module)) {
-      FabricBitRegionId fabric_bitstream_region = fabric_bitstream.add_region();
-      rec_build_module_fabric_dependent_chain_bitstream(bitstream_manager, top_block,
-                                                        module_manager, top_module, 
-                                                        top_module,
-                                                        config_region,
-                                                        fabric_bitstream,
-                                                        fabric_bitstream_region);
-      fabric_bitstream.reverse_region_bits(fabric_bitstream_region);
-    }
+  return true;
+}
+
+/********************************************************************
+ * Main function to build a fabric-dependent bitstream
+ * by considering the configuration protocol types 
+ *
+ * Each configurable region of the top module has its own configurable children,
+ * and thus its own bits. When multiple threads are requested, 
+ * the bitstream of each region is built into a local fabric bitstream 
+ * on a worker thread. The local bitstreams are then added to the fabric bitstream
+ * in the sequence of regions, so that the bits and regions are exactly the same
+ * as the single-thread flow
+ *******************************************************************/
+static 
+void build_module_fabric_dependent_bitstream(const ConfigProtocol& config_protocol,
+                                             const BitstreamManager& bitstream_manager,
+                                             const ConfigBlockId& top_block,
+                                             const ModuleManager& module_manager,
+                                             const ModuleId& top_module,
+                                             const size_t& num_threads,
+                                             FabricBitstream& fabric_bitstream) {
+
+  /* Reserve regions before build-up */
+  fabric_bitstream.reserve_regions(module_manager.regions(top_module).size());
+
+  /* Frame-based protocol: address size and don't care bits shared by all the regions */
+  size_t max_decoder_addr_size = 0;
+  char bitstream_dont_care_char = DONT_CARE_CHAR;
+
+  switch (config_protocol.type()) {
+  case CONFIG_MEM_STANDALONE:
+  case CONFIG_MEM_SCAN_CHAIN: { 
     break;
   }
   case CONFIG_MEM_MEMORY_BANK: { 
-    /* Find global BL address port size */
-    ModulePortId bl_addr_port = module_manager.find_module_port(top_module, std::string(DECODER_BL_ADDRESS_PORT_NAME));
-    BasicPort bl_addr_port_info = module_manager.module_port(top_module, bl_addr_port);
-
     /* Find global WL address port size */
     ModulePortId wl_addr_port = module_manager.find_module_port(top_module, std::string(DECODER_WL_ADDRESS_PORT_NAME));
     BasicPort wl_addr_port_info = module_manager.module_port(top_module, wl_addr_port);
 
-    /* Reserve bits before build-up */
+    /* Find global BL address port size
+     * BL shift registers have no address port, but the bits are still addressed
+     * by their BL indices, as the WL addresses, so that the testbench can
+     * group the bits of each WL. Each memory bank has the same number of BLs and WLs
+     */
+    size_t bl_addr_size = wl_addr_port_info.get_width();
+    if (BLWL_PROTOCOL_DECODER == config_protocol.bl_protocol_type()) {
+      ModulePortId bl_addr_port = module_manager.find_module_port(top_module, std::string(DECODER_BL_ADDRESS_PORT_NAME));
+      bl_addr_size = module_manager.module_port(top_module, bl_addr_port).get_width();
+    }
+
     fabric_bitstream.set_use_address(true);
     fabric_bitstream.set_use_wl_address(true);
-    fabric_bitstream.set_bl_address_length(bl_addr_port_info.get_width());
+    fabric_bitstream.set_bl_address_length(bl_addr_size);
     fabric_bitstream.set_wl_address_length(wl_addr_port_info.get_width());
-    fabric_bitstream.reserve_bits(bitstream_manager.num_bits());
-
-    /* Build bitstreams by region */
-    for (const ConfigRegionId& config_region : module_manager.regions(top_module)) {
-      size_t cur_mem_index = 0;
-
-      /* Find port information for local BL and WL decoder in this region */
-      std::vector<ModuleId> configurable_children = module_manager.region_configurable_children(top_module, config_region);
-      VTR_ASSERT(2 <= configurable_children.size()); 
-      ModuleId bl_decoder_module = configurable_children[configurable_children.size() - 2];
-      ModuleId wl_decoder_module = configurable_children[configurable_children.size() - 1];
-
-      ModulePortId bl_port = module_manager.find_module_port(bl_decoder_module, std::string(DECODER_DATA_OUT_PORT_NAME));
-      BasicPort bl_port_info = module_manager.module_port(bl_decoder_module, bl_port);
-
-      ModulePortId wl_port = module_manager.find_module_port(wl_decoder_module, std::string(DECODER_DATA_OUT_PORT_NAME));
-      BasicPort wl_port_info = module_manager.module_port(wl_decoder_module, wl_port);
-
-      /* Build the bitstream for all the blocks in this region */
-      FabricBitRegionId fabric_bitstream_region = fabric_bitstream.add_region();
-      rec_build_module_fabric_dependent_memory_bank_bitstream(bitstream_manager, top_block,
-                                                              module_manager, top_module, top_module, 
-                                                              config_region,
-                                                              bl_addr_port_info.get_width(),
-                                                              wl_addr_port_info.get_width(),
-                                                              bl_port_info.get_width(),
-                                                              wl_port_info.get_width(),
-                                                              cur_mem_index,
-                                                              fabric_bitstream,
-                                                              fabric_bitstream_region);
-    }
     break;
   }
   case CONFIG_MEM_FRAME_BASED: {
-
     /* Find address port size */
     ModulePortId addr_port = module_manager.find_module_port(top_module, std::string(DECODER_ADDRESS_PORT_NAME));
     BasicPort addr_port_info = module_manager.module_port(top_module, addr_port);
 
-    /* Reserve bits before build-up */
     fabric_bitstream.set_use_address(true);
-    fabric_bitstream.reserve_bits(bitstream_manager.num_bits());
     fabric_bitstream.set_address_length(addr_port_info.get_width());
+    fabric_bitstream.set_data_width(config_protocol.frame_data_width());
 
     /* Avoid use don't care if there is only a region */
-    char bitstream_dont_care_char = DONT_CARE_CHAR;
     if (1 == module_manager.regions(top_module).size()) {
       bitstream_dont_care_char = '0';
     }
 
     /* Find the maximum decoder address among all the configurable regions */
-    size_t max_decoder_addr_size = 0;
     for (const ConfigRegionId& config_region : module_manager.regions(top_module)) {
       std::vector<ModuleId> configurable_children = module_manager.region_configurable_children(top_module, config_region);
       /* Bypass the regions that have no decoders */
@@ -606,47 +756,6 @@ void build_module_fabric_dependent_bitstream(const ConfigProtocol& config_protoc
       BasicPort decoder_addr_port = module_manager.module_port(decoder_module, decoder_addr_port_id);
       max_decoder_addr_size = std::max(max_decoder_addr_size, decoder_addr_port.get_width()); 
     }
-
-    for (const ConfigRegionId& config_region : module_manager.regions(top_module)) {
-      std::vector<ModuleId> configurable_children = module_manager.region_configurable_children(top_module, config_region);
-
-      /* Bypass non-configurable regions */
-      if (0 == configurable_children.size()) {
-        continue;
-      }
-
-      /* Find the idle address bit which should be added to the head of the address bit
-       * This depends on the number of address bits required by this region
-       * For example:
-       *   Top-level address is addr[0:4]
-       *   There are 4 decoders in the top-level module, whose address sizes are
-       *     decoder A: addr[0:4]
-       *     decoder B: addr[0:3]
-       *     decoder C: addr[0:2]
-       *     decoder D: addr[0:3]
-       *   For decoder A, the address fit well
-       *   For decoder B, an idle bit should be added '0' + addr[0:3] 
-       *   For decoder C, two idle bits should be added '00' + addr[0:2] 
-       *   For decoder D, an idle bit should be added '0' + addr[0:3] 
-       */
-      ModuleId decoder_module = configurable_children.back();
-      ModulePortId decoder_addr_port_id = module_manager.find_module_port(decoder_module, DECODER_ADDRESS_PORT_NAME);
-      BasicPort decoder_addr_port = module_manager.module_port(decoder_module, decoder_addr_port_id);
-      VTR_ASSERT(max_decoder_addr_size >= decoder_addr_port.get_width());
-      std::vector<char> idle_addr_bits(max_decoder_addr_size - decoder_addr_port.get_width(), bitstream_dont_care_char);
-     
-      FabricBitRegionId fabric_bitstream_region = fabric_bitstream.add_region();
-      rec_build_module_fabric_dependent_frame_bitstream(bitstream_manager,
-                                                        std::vector<ConfigBlockId>(1, top_block),
-                                                        module_manager,
-                                                        top_module,
-                                                        config_region,
-                                                        std::vector<ModuleId>(1, top_module),
-	  												    idle_addr_bits,
-                                                        bitstream_dont_care_char,
-                                                        fabric_bitstream,
-                                                        fabric_bitstream_region);
-    }
     break;
   }
   default:
@@ -655,6 +764,56 @@ void build_module_fabric_dependent_bitstream(const ConfigProtocol& config_protoc
     exit(1);
   }
 
+  std::vector<ConfigRegionId> config_regions;
+  for (const ConfigRegionId& config_region : module_manager.regions(top_module)) {
+    config_regions.push_back(config_region);
+  }
+
+  /* Single thread: build the bitstream of each region directly in the fabric bitstream */
+  if ( (1 >= num_threads)
+    || (1 >= config_regions.size()) ) {
+    /* Reserve bits before build-up */
+    fabric_bitstream.reserve_bits(bitstream_manager.num_bits());
+    for (const ConfigRegionId& config_region : config_regions) {
+      if (false == build_region_fabric_dependent_bitstream(config_protocol,
+                                                           bitstream_manager, top_block,
+                                                           module_manager, top_module,
+                                                           config_region,
+                                                           max_decoder_addr_size,
+                                                           bitstream_dont_care_char,
+                                                           fabric_bitstream)) {
+        exit(1);
+      }
+    }
+  } else {
+    /* Each region has its own fabric bitstream, which has the same setup as the fabric bitstream */
+    std::vector<FabricBitstream> region_bitstreams(config_regions.size(), fabric_bitstream);
+    /* Failures are recorded by the workers and handled after all of them are joined */
+    std::vector<char> region_success(config_regions.size(), false);
+    parallel_for(config_regions.size(), num_threads,
+                 [&](const size_t& iregion) {
+                   region_success[iregion] = build_region_fabric_dependent_bitstream(config_protocol,
+                                                                                     bitstream_manager, top_block,
+                                                                                     module_manager, top_module,
+                                                                                     config_regions[iregion],
+                                                                                     max_decoder_addr_size,
+                                                                                     bitstream_dont_care_char,
+                                                                                     region_bitstreams[iregion]);
+                 });
+    /* The errors have been printed when the workers were joined */
+    if (region_success.end() != std::find(region_success.begin(), region_success.end(), false)) {
+      exit(1);
+    }
+
+    /* Add the region bitstreams in the sequence of regions */
+    fabric_bitstream.reserve_bits(bitstream_manager.num_bits());
+    for (FabricBitstream& region_bitstream : region_bitstreams) {
+      fabric_bitstream.add_sub_bitstream(region_bitstream);
+      /* Release memory as soon as possible */
+      region_bitstream = FabricBitstream();
+    }
+  }
+
   /* Time-consuming sanity check: Uncomment these codes only for debugging!!!
    * Check which configuration bits are not touched 
    */
@@ -691,10 +850,14 @@ void build_module_fabric_dependent_bitstream(const ConfigProtocol& config_protoc
  * This function can be called ONLY after the function build_device_bitstream() 
  * Note that this function does NOT decode bitstreams from circuit implementation
  * It was done in the function build_device_bitstream() 
+ *
+ * The configurable regions of the top module are built in parallel
+ * when multiple threads are requested
  *******************************************************************/
 FabricBitstream build_fabric_dependent_bitstream(const BitstreamManager& bitstream_manager,
                                                  const ModuleManager& module_manager,
                                                  const ConfigProtocol& config_protocol,
+                                                 const size_t& num_threads,
                                                  const bool& verbose) {
   FabricBitstream fabric_bitstream; 
 
@@ -715,6 +878,7 @@ FabricBitstream build_fabric_dependent_bitstream(const BitstreamManager& bitstre
   build_module_fabric_dependent_bitstream(config_protocol,
                                           bitstream_manager, top_block[0],
                                           module_manager, top_module, 
+                                          num_threads,
                                           fabric_bitstream);
 
   VTR_LOGV(verbose,
@@ -724,4 +888,26 @@ FabricBitstream build_fabric_dependent_bitstream(const BitstreamManager& bitstre
   return fabric_bitstream;
 }
 
+
+/********************************************************************
+ * Update the data inputs of a fabric bitstream in place, after
+ * the values of bits in the bitstream database are changed, e.g.,
+ * by an incremental build of the architecture bitstream.
+ * The fabric bitstream should have been built from the same bitstream database,
+ * whose blocks and bits are not changed
+ *******************************************************************/
+void update_fabric_dependent_bitstream(FabricBitstream& fabric_bitstream,
+                                       const BitstreamManager& bitstream_manager) {
+  /* Only the protocols with addresses store the data inputs, 
+   * others refer to the values in the bitstream database
+   */
+  if (false == fabric_bitstream.use_address()) {
+    return;
+  }
+
+  for (const FabricBitId& fabric_bit : fabric_bitstream.bits()) {
+    fabric_bitstream.set_bit_din(fabric_bit, bitstream_manager.bit_value(fabric_bitstream.config_bit(fabric_bit)));
+  }
+}
+
 } /* end namespace openfpga */
@@ -2,7 +2,10 @@
  * This file includes functions that are used for building bitstreams
  * for grids (CLBs, heterogenerous blocks, I/Os, etc.)
  *******************************************************************/
+#include <algorithm>
 #include <cmath>
+#include <map>
+#include <memory>
 #include <string>
 
 /* Headers from vtrutil library */
@@ -27,7 +30,10 @@
 #include "module_manager_utils.h"
 
 #include "build_mux_bitstream.h"
+#include "lut_bitstream_cache.h"
 #include "openfpga_device_grid_utils.h"
+#include "openfpga_parallel.h"
+#include "openfpga_progress.h"
 
 #include "build_grid_bitstream.h"
 
@@ -54,7 +60,7 @@ std::vector<bool> generate_mode_select_bitstream(const std::vector<size_t>& mode
  * Generate bitstream for a primitive node and add it to bitstream manager
  *******************************************************************/
 static 
-void build_primitive_bitstream(BitstreamManager& bitstream_manager,
+bool build_primitive_bitstream(BitstreamManager& bitstream_manager,
                                const ConfigBlockId& parent_configurable_block,
                                const ModuleManager& module_manager,
                                const CircuitLibrary& circuit_lib,
@@ -67,7 +73,7 @@ void build_primitive_bitstream(BitstreamManager& bitstream_manager,
   if (nullptr == primitive_pb_type) {
     VTR_LOGF_ERROR(__FILE__, __LINE__,
                    "Invalid primitive_pb_type!\n");
-    exit(1);
+    return false;
   }
 
   CircuitModelId primitive_model = device_annotation.pb_type_circuit_model(primitive_pb_type);
@@ -85,7 +91,7 @@ void build_primitive_bitstream(BitstreamManager& bitstream_manager,
 
   /* Generate bitstream for mode-select ports */
   if (0 == primitive_mode_select_ports.size()) {
-    return; /* Nothing to do, return directly */
+    return true; /* Nothing to do, return directly */
   }
 
   std::vector<bool> mode_select_bitstream;
@@ -110,6 +116,8 @@ void build_primitive_bitstream(BitstreamManager& bitstream_manager,
 
   /* Add the bitstream to the bitstream manager */
   bitstream_manager.add_block_bits(mem_block, mode_select_bitstream);
+
+  return true;
 }
 
 /********************************************************************
@@ -122,7 +130,7 @@ void build_primitive_bitstream(BitstreamManager& bitstream_manager,
  *                         input_pins,   edges,       output_pins
  *******************************************************************/
 static 
-void build_physical_block_pin_interc_bitstream(BitstreamManager& bitstream_manager,
+bool build_physical_block_pin_interc_bitstream(BitstreamManager& bitstream_manager,
                                                const ConfigBlockId& parent_configurable_block,
                                                const ModuleManager& module_manager,
                                                const CircuitLibrary& circuit_lib,
@@ -139,7 +147,7 @@ void build_physical_block_pin_interc_bitstream(BitstreamManager& bitstream_manag
 
   if ((nullptr == cur_interc) || (0 == fan_in)) { 
     /* No interconnection matched */
-    return;
+    return true;
   }
 
   /* Identify pin interconnection type */
@@ -257,8 +265,10 @@ void build_physical_block_pin_interc_bitstream(BitstreamManager& bitstream_manag
     VTR_LOGF_ERROR(__FILE__, __LINE__,
                    "Invalid interconnection type for %s (Arch[LINE%d])!\n",
                    cur_interc->name, cur_interc->line_num);
-    exit(1);
+    return false;
   }
+
+  return true;
 }
 
 /********************************************************************
@@ -266,7 +276,7 @@ void build_physical_block_pin_interc_bitstream(BitstreamManager& bitstream_manag
  * multiplexers in a pb_graph node 
  *******************************************************************/
 static 
-void build_physical_block_interc_port_bitstream(BitstreamManager& bitstream_manager,
+bool build_physical_block_interc_port_bitstream(BitstreamManager& bitstream_manager,
                                                 const ConfigBlockId& parent_configurable_block,
                                                 const ModuleManager& module_manager,
                                                 const CircuitLibrary& circuit_lib,
@@ -282,36 +292,42 @@ void build_physical_block_interc_port_bitstream(BitstreamManager& bitstream_mana
   case CIRCUIT_PB_PORT_INPUT:
     for (int iport = 0; iport < physical_pb_graph_node->num_input_ports; ++iport) {
       for (int ipin = 0; ipin < physical_pb_graph_node->num_input_pins[iport]; ++ipin) {
-        build_physical_block_pin_interc_bitstream(bitstream_manager, parent_configurable_block,
-                                                  module_manager, circuit_lib, mux_lib,
-                                                  atom_ctx, device_annotation, bitstream_annotation,
-                                                  physical_pb,
-                                                  &(physical_pb_graph_node->input_pins[iport][ipin]),
-                                                  physical_mode);
+        if (false == build_physical_block_pin_interc_bitstream(bitstream_manager, parent_configurable_block,
+                                                               module_manager, circuit_lib, mux_lib,
+                                                               atom_ctx, device_annotation, bitstream_annotation,
+                                                               physical_pb,
+                                                               &(physical_pb_graph_node->input_pins[iport][ipin]),
+                                                               physical_mode)) {
+          return false;
+        }
       }
     }
     break;
   case CIRCUIT_PB_PORT_OUTPUT:
     for (int iport = 0; iport < physical_pb_graph_node->num_output_ports; ++iport) {
       for (int ipin = 0; ipin < physical_pb_graph_node->num_output_pins[iport]; ++ipin) {
-        build_physical_block_pin_interc_bitstream(bitstream_manager, parent_configurable_block,
-                                                  module_manager, circuit_lib, mux_lib,
-                                                  atom_ctx, device_annotation, bitstream_annotation,
-                                                  physical_pb,
-                                                  &(physical_pb_graph_node->output_pins[iport][ipin]),
-                                                  physical_mode);
+        if (false == build_physical_block_pin_interc_bitstream(bitstream_manager, parent_configurable_block,
+                                                               module_manager, circuit_lib, mux_lib,
+                                                               atom_ctx, device_annotation, bitstream_annotation,
+                                                               physical_pb,
+                                                               &(physical_pb_graph_node->output_pins[iport][ipin]),
+                                                               physical_mode)) {
+          return false;
+        }
       }
     }
     break;
   case CIRCUIT_PB_PORT_CLOCK:
     for (int iport = 0; iport < physical_pb_graph_node->num_clock_ports; ++iport) {
       for (int ipin = 0; ipin < physical_pb_graph_node->num_clock_pins[iport]; ++ipin) {
-        build_physical_block_pin_interc_bitstream(bitstream_manager, parent_configurable_block,
-                                                  module_manager, circuit_lib, mux_lib,
-                                                  atom_ctx, device_annotation, bitstream_annotation,
-                                                  physical_pb,
-                                                  &(physical_pb_graph_node->clock_pins[iport][ipin]),
-                                                  physical_mode);
+        if (false == build_physical_block_pin_interc_bitstream(bitstream_manager, parent_configurable_block,
+                                                               module_manager, circuit_lib, mux_lib,
+                                                               atom_ctx, device_annotation, bitstream_annotation,
+                                                               physical_pb,
+                                                               &(physical_pb_graph_node->clock_pins[iport][ipin]),
+                                                               physical_mode)) {
+          return false;
+        }
 
       }
     }
@@ -319,8 +335,10 @@ void build_physical_block_interc_port_bitstream(BitstreamManager& bitstream_mana
   default:
     VTR_LOGF_ERROR(__FILE__, __LINE__,
                    "Invalid pb port type!\n");
-    exit(1);
+    return false;
   }
+
+  return true;
 }
 
 /********************************************************************
@@ -328,7 +346,7 @@ void build_physical_block_interc_port_bitstream(BitstreamManager& bitstream_mana
  * multiplexers in a pb_graph node 
  *******************************************************************/
 static 
-void build_physical_block_interc_bitstream(BitstreamManager& bitstream_manager,
+bool build_physical_block_interc_bitstream(BitstreamManager& bitstream_manager,
                                            const ConfigBlockId& parent_configurable_block,
                                            const ModuleManager& module_manager,
                                            const CircuitLibrary& circuit_lib,
@@ -343,7 +361,7 @@ void build_physical_block_interc_bitstream(BitstreamManager& bitstream_manager,
   if (nullptr == physical_pb_graph_node) {
     VTR_LOGF_ERROR(__FILE__, __LINE__,
                    "Invalid physical_pb_graph_node.\n"); 
-    exit(1);
+    return false;
   }
 
   /* We check output_pins of physical_pb_graph_node and its the input_edges
@@ -355,11 +373,13 @@ void build_physical_block_interc_bitstream(BitstreamManager& bitstream_manager,
    *                         input_pins,   edges,       output_pins
    * Note: it is not applied to primitive pb_type!
    */ 
-  build_physical_block_interc_port_bitstream(bitstream_manager, parent_configurable_block,
-                                             module_manager, circuit_lib, mux_lib, 
-                                             atom_ctx, device_annotation, bitstream_annotation, 
-                                             physical_pb_graph_node, physical_pb,  
-                                             CIRCUIT_PB_PORT_OUTPUT, physical_mode);
+  if (false == build_physical_block_interc_port_bitstream(bitstream_manager, parent_configurable_block,
+                                                          module_manager, circuit_lib, mux_lib, 
+                                                          atom_ctx, device_annotation, bitstream_annotation, 
+                                                          physical_pb_graph_node, physical_pb,  
+                                                          CIRCUIT_PB_PORT_OUTPUT, physical_mode)) {
+    return false;
+  }
  
   /* We check input_pins of child_pb_graph_node and its the input_edges
    * Iterate over the interconnections between inputs of physical_pb_graph_node 
@@ -374,19 +394,25 @@ void build_physical_block_interc_bitstream(BitstreamManager& bitstream_manager,
       t_pb_graph_node* child_pb_graph_node = &(physical_pb_graph_node->child_pb_graph_nodes[physical_mode->index][ipb][jpb]);
 
       /* For each child_pb_graph_node input pins*/
-      build_physical_block_interc_port_bitstream(bitstream_manager, parent_configurable_block,
-                                                 module_manager, circuit_lib, mux_lib, 
-                                                 atom_ctx, device_annotation, bitstream_annotation,
-                                                 child_pb_graph_node, physical_pb,  
-                                                 CIRCUIT_PB_PORT_INPUT, physical_mode);
+      if (false == build_physical_block_interc_port_bitstream(bitstream_manager, parent_configurable_block,
+                                                              module_manager, circuit_lib, mux_lib, 
+                                                              atom_ctx, device_annotation, bitstream_annotation,
+                                                              child_pb_graph_node, physical_pb,  
+                                                              CIRCUIT_PB_PORT_INPUT, physical_mode)) {
+        return false;
+      }
       /* For clock pins, we should do the same work */
-      build_physical_block_interc_port_bitstream(bitstream_manager, parent_configurable_block,
-                                                 module_manager, circuit_lib, mux_lib, 
-                                                 atom_ctx, device_annotation, bitstream_annotation, 
-                                                 child_pb_graph_node, physical_pb,  
-                                                 CIRCUIT_PB_PORT_CLOCK, physical_mode);
+      if (false == build_physical_block_interc_port_bitstream(bitstream_manager, parent_configurable_block,
+                                                              module_manager, circuit_lib, mux_lib, 
+                                                              atom_ctx, device_annotation, bitstream_annotation, 
+                                                              child_pb_graph_node, physical_pb,  
+                                                              CIRCUIT_PB_PORT_CLOCK, physical_mode)) {
+        return false;
+      }
     }
   }
+
+  return true;
 }
 
 /********************************************************************
@@ -394,7 +420,7 @@ void build_physical_block_interc_bitstream(BitstreamManager& bitstream_manager,
  * This function supports both single-output and fracturable LUTs
  *******************************************************************/
 static 
-void build_lut_bitstream(BitstreamManager& bitstream_manager,
+bool build_lut_bitstream(BitstreamManager& bitstream_manager,
                          const ConfigBlockId& parent_configurable_block,
                          const VprDeviceAnnotation& device_annotation,
                          const ModuleManager& module_manager,
@@ -402,13 +428,14 @@ void build_lut_bitstream(BitstreamManager& bitstream_manager,
                          const MuxLibrary& mux_lib,
                          const PhysicalPb& physical_pb,
                          const PhysicalPbId& lut_pb_id,
-                         t_pb_type* lut_pb_type) {
+                         t_pb_type* lut_pb_type,
+                         LutBitstreamCache& lut_bitstream_cache) {
 
   /* Ensure a valid physical pritimive pb */ 
   if (nullptr == lut_pb_type) {
     VTR_LOGF_ERROR(__FILE__, __LINE__,
                    "Invalid lut_pb_type!\n");
-    exit(1);
+    return false;
   }
 
   CircuitModelId lut_model = device_annotation.pb_type_circuit_model(lut_pb_type);
@@ -449,11 +476,11 @@ void build_lut_bitstream(BitstreamManager& bitstream_manager,
     /* Ensure the LUT MUX has the expected input and SRAM port sizes */
     VTR_ASSERT(mux_graph.num_memory_bits() == lut_size);
     VTR_ASSERT(mux_graph.num_inputs() == (size_t)pow(2., lut_size));
-    /* Generate LUT bitstream */
-    lut_bitstream = build_frac_lut_bitstream(circuit_lib, mux_graph,
-                                             device_annotation,
-                                             physical_pb.truth_tables(lut_pb_id),
-                                             circuit_lib.port_default_value(lut_regular_sram_ports[0]));
+    /* Generate LUT bitstream, which is shared by the LUTs with the same truth tables */
+    lut_bitstream = lut_bitstream_cache.find_or_build(circuit_lib, lut_model, mux_graph,
+                                                      device_annotation,
+                                                      physical_pb.truth_tables(lut_pb_id),
+                                                      circuit_lib.port_default_value(lut_regular_sram_ports[0]));
     /* If the physical pb contains fixed bitstream, overload here */
     if (false == physical_pb.fixed_bitstream(lut_pb_id).empty()) {
       std::string fixed_bitstream = physical_pb.fixed_bitstream(lut_pb_id);
@@ -463,7 +490,7 @@ void build_lut_bitstream(BitstreamManager& bitstream_manager,
         VTR_LOG_ERROR("Unmatched length of fixed bitstream %s!Expected to be less than %ld bits\n",
                       fixed_bitstream.c_str(),
                       lut_bitstream.size() - start_index); 
-        exit(1);
+        return false;
       }
       /* Overload the bitstream here */
       for (size_t bit_index = 0; bit_index < lut_bitstream.size(); ++bit_index) {
@@ -488,7 +515,7 @@ void build_lut_bitstream(BitstreamManager& bitstream_manager,
           VTR_LOG_ERROR("Unmatched length of fixed mode_select_bitstream %s!Expected to be less than %ld bits\n",
                         fixed_mode_select_bitstream.c_str(),
                         mode_select_bitstream.size() - mode_bits_start_index); 
-          exit(1);
+          return false;
         }
         /* Overload the bitstream here */
         for (size_t bit_index = 0; bit_index < fixed_mode_select_bitstream.size(); ++bit_index) {
@@ -522,6 +549,8 @@ void build_lut_bitstream(BitstreamManager& bitstream_manager,
 
   /* Add the bitstream to the bitstream manager */
   bitstream_manager.add_block_bits(mem_block, lut_bitstream);
+
+  return true;
 }
 
 /********************************************************************
@@ -536,7 +565,7 @@ void build_lut_bitstream(BitstreamManager& bitstream_manager,
  * For more details, you may refer to function rec_build_physical_block_modules()
  *******************************************************************/
 static 
-void rec_build_physical_block_bitstream(BitstreamManager& bitstream_manager,
+bool rec_build_physical_block_bitstream(BitstreamManager& bitstream_manager,
                                         const ConfigBlockId& parent_configurable_block,
                                         const ModuleManager& module_manager,
                                         const CircuitLibrary& circuit_lib,
@@ -548,7 +577,8 @@ void rec_build_physical_block_bitstream(BitstreamManager& bitstream_manager,
                                         const PhysicalPb& physical_pb, 
                                         const PhysicalPbId& pb_id, 
                                         t_pb_graph_node* physical_pb_graph_node,
-                                        const size_t& pb_graph_node_index) {
+                                        const size_t& pb_graph_node_index,
+                                        LutBitstreamCache& lut_bitstream_cache) {
   /* Get the physical pb_type that is linked to the pb_graph node */
   t_pb_type* physical_pb_type = physical_pb_graph_node->pb_type;
 
@@ -562,7 +592,7 @@ void rec_build_physical_block_bitstream(BitstreamManager& bitstream_manager,
  
   /* Skip module with no configurable children */
   if (0 == module_manager.configurable_children(pb_module).size()) {
-    return;
+    return true;
   }
 
   /* Create a block for the physical block under the grid block in bitstream manager */
@@ -585,14 +615,16 @@ void rec_build_physical_block_bitstream(BitstreamManager& bitstream_manager,
           VTR_ASSERT(true == physical_pb.valid_pb_id(child_pb));
         }
         /* Go recursively */
-        rec_build_physical_block_bitstream(bitstream_manager, pb_configurable_block,
-                                           module_manager, circuit_lib, mux_lib, 
-                                           atom_ctx,
-                                           device_annotation, bitstream_annotation, 
-                                           border_side, 
-                                           physical_pb, child_pb,
-                                           &(physical_pb_graph_node->child_pb_graph_nodes[physical_mode->index][ipb][jpb]),
-                                           jpb);
+        if (false == rec_build_physical_block_bitstream(bitstream_manager, pb_configurable_block,
+                                                        module_manager, circuit_lib, mux_lib, 
+                                                        atom_ctx,
+                                                        device_annotation, bitstream_annotation, 
+                                                        border_side, 
+                                                        physical_pb, child_pb,
+                                                        &(physical_pb_graph_node->child_pb_graph_nodes[physical_mode->index][ipb][jpb]),
+                                                        jpb, lut_bitstream_cache)) {
+          return false;
+        }
       }
     }
   }
@@ -606,36 +638,41 @@ void rec_build_physical_block_bitstream(BitstreamManager& bitstream_manager,
       /* Special case for LUT !!!
        * Mapped logical block information is stored in child_pbs of this pb!!!
        */
-      build_lut_bitstream(bitstream_manager, pb_configurable_block,
-                          device_annotation, 
-                          module_manager, circuit_lib, mux_lib, 
-                          physical_pb, pb_id, physical_pb_type);
+      if (false == build_lut_bitstream(bitstream_manager, pb_configurable_block,
+                                       device_annotation, 
+                                       module_manager, circuit_lib, mux_lib, 
+                                       physical_pb, pb_id, physical_pb_type,
+                                       lut_bitstream_cache)) {
+        return false;
+      }
       break;
     case CIRCUIT_MODEL_FF:
     case CIRCUIT_MODEL_HARDLOGIC:
     case CIRCUIT_MODEL_IOPAD:
       /* For other types of blocks, we can apply a generic therapy */
-      build_primitive_bitstream(bitstream_manager, pb_configurable_block,
-                                module_manager, circuit_lib, device_annotation, 
-                                physical_pb, pb_id, physical_pb_type);
+      if (false == build_primitive_bitstream(bitstream_manager, pb_configurable_block,
+                                             module_manager, circuit_lib, device_annotation, 
+                                             physical_pb, pb_id, physical_pb_type)) {
+        return false;
+      }
       break;  
     default:
       VTR_LOGF_ERROR(__FILE__, __LINE__, 
                      "Unknown circuit model type of pb_type '%s'!\n",
                      physical_pb_type->name);
-      exit(1);
+      return false;
     }
     /* Finish for primitive node, return */
-    return;
+    return true;
   }
 
   /* Generate the bitstream for the interconnection in this physical block */
-  build_physical_block_interc_bitstream(bitstream_manager, pb_configurable_block,
-                                        module_manager, circuit_lib, mux_lib,
-                                        atom_ctx,
-                                        device_annotation, bitstream_annotation,
-                                        physical_pb_graph_node, physical_pb,
-                                        physical_mode);
+  return build_physical_block_interc_bitstream(bitstream_manager, pb_configurable_block,
+                                               module_manager, circuit_lib, mux_lib,
+                                               atom_ctx,
+                                               device_annotation, bitstream_annotation,
+                                               physical_pb_graph_node, physical_pb,
+                                               physical_mode);
 }
 
 /********************************************************************
@@ -643,9 +680,11 @@ void rec_build_physical_block_bitstream(BitstreamManager& bitstream_manager,
  * CLB, a heterogenerous block, an I/O, etc.
  * Note that each grid may contain a number of physical blocks,
  * this function will iterate over them
+ * Return false on errors, which have been reported, so that the caller
+ * can stop after all the worker threads are joined
  *******************************************************************/
 static 
-void build_physical_block_bitstream(BitstreamManager& bitstream_manager,
+bool build_physical_block_bitstream(BitstreamManager& bitstream_manager,
                                     const ConfigBlockId& top_block,
                                     const ModuleManager& module_manager,
                                     const CircuitLibrary& circuit_lib,
@@ -657,7 +696,8 @@ void build_physical_block_bitstream(BitstreamManager& bitstream_manager,
                                     const VprBitstreamAnnotation& bitstream_annotation,
                                     const DeviceGrid& grids,
                                     const vtr::Point<size_t>& grid_coord,
-                                    const e_side& border_side) {
+                                    const e_side& border_side,
+                                    LutBitstreamCache& lut_bitstream_cache) {
   /* Create a block for the grid in bitstream manager */
   t_physical_tile_type_ptr grid_type = grids[grid_coord.x()][grid_coord.y()].type;
   std::string grid_module_name_prefix(GRID_MODULE_NAME_PREFIX);
@@ -670,7 +710,7 @@ void build_physical_block_bitstream(BitstreamManager& bitstream_manager,
  
   /* Skip module with no configurable children */
   if (0 == module_manager.configurable_children(grid_module).size()) {
-    return;
+    return true;
   }
 
   std::string grid_block_name = generate_grid_block_instance_name(grid_module_name_prefix, std::string(grid_type->name), 
@@ -700,13 +740,15 @@ void build_physical_block_bitstream(BitstreamManager& bitstream_manager,
 
       if (ClusterBlockId::INVALID() == place_annotation.grid_blocks(grid_coord)[z]) {
         /* Recursively traverse the pb_graph and generate bitstream */
-        rec_build_physical_block_bitstream(bitstream_manager, grid_configurable_block, 
-                                           module_manager, circuit_lib, mux_lib, 
-                                           atom_ctx,
-                                           device_annotation, bitstream_annotation,
-                                           border_side, 
-                                           PhysicalPb(), PhysicalPbId::INVALID(),
-                                           lb_type->pb_graph_head, z);
+        if (false == rec_build_physical_block_bitstream(bitstream_manager, grid_configurable_block, 
+                                                        module_manager, circuit_lib, mux_lib, 
+                                                        atom_ctx,
+                                                        device_annotation, bitstream_annotation,
+                                                        border_side, 
+                                                        PhysicalPb(), PhysicalPbId::INVALID(),
+                                                        lb_type->pb_graph_head, z, lut_bitstream_cache)) {
+          return false;
+        }
       } else {
         const PhysicalPb& phy_pb = cluster_annotation.physical_pb(place_annotation.grid_blocks(grid_coord)[z]);
 
@@ -716,39 +758,33 @@ void build_physical_block_bitstream(BitstreamManager& bitstream_manager,
         const PhysicalPbId& top_pb_id = phy_pb.find_pb(pb_graph_head);
 
         /* Recursively traverse the pb_graph and generate bitstream */
-        rec_build_physical_block_bitstream(bitstream_manager, grid_configurable_block, 
-                                           module_manager, circuit_lib, mux_lib, 
-                                           atom_ctx,
-                                           device_annotation, bitstream_annotation,
-                                           border_side, 
-                                           phy_pb, top_pb_id, pb_graph_head, z);
+        if (false == rec_build_physical_block_bitstream(bitstream_manager, grid_configurable_block, 
+                                                        module_manager, circuit_lib, mux_lib, 
+                                                        atom_ctx,
+                                                        device_annotation, bitstream_annotation,
+                                                        border_side, 
+                                                        phy_pb, top_pb_id, pb_graph_head, z, lut_bitstream_cache)) {
+          return false;
+        }
       }
     }
   } 
+
+  return true;
 }
 
 
 /********************************************************************
- * Top-level function of this file: 
- * Generate bitstreams for all the grids, including 
+ * Collect the grids whose bitstreams are built, including 
  * 1. core grids that sit in the center of the fabric
  * 2. side grids (I/O grids) that sit in the borders for the fabric
+ * The sequence is the same as the blocks in bitstream
+ * Return the number of core grids, which are the first part of the list
  *******************************************************************/
-void build_grid_bitstream(BitstreamManager& bitstream_manager,
-                          const ConfigBlockId& top_block,
-                          const ModuleManager& module_manager,
-                          const CircuitLibrary& circuit_lib,
-                          const MuxLibrary& mux_lib,
-                          const DeviceGrid& grids,
-                          const AtomContext& atom_ctx,
-                          const VprDeviceAnnotation& device_annotation,
-                          const VprClusteringAnnotation& cluster_annotation,
-                          const VprPlacementAnnotation& place_annotation,
-                          const VprBitstreamAnnotation& bitstream_annotation,
-                          const bool& verbose) {
-
-  VTR_LOGV(verbose, "Generating bitstream for core grids...");
-
+static 
+size_t collect_grid_bitstream_coordinates(const DeviceGrid& grids,
+                                          std::vector<vtr::Point<size_t>>& grid_coords,
+                                          std::vector<e_side>& grid_border_sides) {
   /* Generate bitstream for the core logic block one by one */
   for (size_t ix = 1; ix < grids.width() - 1; ++ix) {
     for (size_t iy = 1; iy < grids.height() - 1; ++iy) {
@@ -761,24 +797,15 @@ void build_grid_bitstream(BitstreamManager& bitstream_manager,
         || (0 < grids[ix][iy].height_offset) ) {
         continue;
       }
-      /* Add a grid module to top_module*/
-      vtr::Point<size_t> grid_coord(ix, iy);
-      build_physical_block_bitstream(bitstream_manager, top_block, module_manager,
-                                     circuit_lib, mux_lib,
-                                     atom_ctx,
-                                     device_annotation, cluster_annotation,
-                                     place_annotation, bitstream_annotation,
-                                     grids, grid_coord, NUM_SIDES);
+      grid_coords.push_back(vtr::Point<size_t>(ix, iy));
+      grid_border_sides.push_back(NUM_SIDES);
     }
   }
-  VTR_LOGV(verbose, "Done\n");
-
-  VTR_LOGV(verbose, "Generating bitstream for I/O grids...");
+  size_t num_core_grids = grid_coords.size();
 
   /* Create the coordinate range for each side of FPGA fabric */
   std::map<e_side, std::vector<vtr::Point<size_t>>> io_coordinates = generate_perimeter_grid_coordinates( grids);
 
-  /* Add instances of I/O grids to top_module */
   for (const e_side& io_side : FPGA_SIDES_CLOCKWISE) {
     for (const vtr::Point<size_t>& io_coordinate : io_coordinates[io_side]) {
       /* Bypass EMPTY grid */
@@ -790,15 +817,346 @@ void build_grid_bitstream(BitstreamManager& bitstream_manager,
         || (0 < grids[io_coordinate.x()][io_coordinate.y()].height_offset) ) {
         continue;
       }
-      build_physical_block_bitstream(bitstream_manager, top_block, module_manager,
-                                     circuit_lib, mux_lib,
-                                     atom_ctx,
-                                     device_annotation, cluster_annotation, 
-                                     place_annotation, bitstream_annotation,
-                                     grids, io_coordinate, io_side);
+      grid_coords.push_back(io_coordinate);
+      grid_border_sides.push_back(io_side);
+    }
+  }
+
+  return num_core_grids;
+}
+
+/********************************************************************
+ * The bitstreams of the grids without any block placed,
+ * which depend only on the type of the grid and its border side
+ *******************************************************************/
+typedef std::map<std::pair<t_physical_tile_type_ptr, e_side>, std::shared_ptr<BitstreamManager>> UnusedGridBitstreams;
+
+/********************************************************************
+ * Find if no cluster block is placed in any sub tile of a grid
+ *******************************************************************/
+static 
+bool is_grid_unused(const VprPlacementAnnotation& place_annotation,
+                    const vtr::Point<size_t>& grid_coord) {
+  for (const ClusterBlockId& grid_block : place_annotation.grid_blocks(grid_coord)) {
+    if (ClusterBlockId::INVALID() != grid_block) {
+      return false;
     }
   }
+  return true;
+}
+
+/********************************************************************
+ * Build a template of bitstream for each pair of grid type and border side
+ * which is found among the unused grids.
+ * Each template is a bitstream manager whose first block is a placeholder
+ * of the top block, as the bitstreams built by the worker threads
+ *******************************************************************/
+static 
+UnusedGridBitstreams build_unused_grid_bitstream_templates(const ModuleManager& module_manager,
+                                                           const CircuitLibrary& circuit_lib,
+                                                           const MuxLibrary& mux_lib,
+                                                           const DeviceGrid& grids,
+                                                           const AtomContext& atom_ctx,
+                                                           const VprDeviceAnnotation& device_annotation,
+                                                           const VprClusteringAnnotation& cluster_annotation,
+                                                           const VprPlacementAnnotation& place_annotation,
+                                                           const VprBitstreamAnnotation& bitstream_annotation,
+                                                           const std::vector<vtr::Point<size_t>>& grid_coords,
+                                                           const std::vector<e_side>& grid_border_sides,
+                                                           LutBitstreamCache& lut_bitstream_cache) {
+  UnusedGridBitstreams grid_templates;
+  for (size_t igrid = 0; igrid < grid_coords.size(); ++igrid) {
+    if (false == is_grid_unused(place_annotation, grid_coords[igrid])) {
+      continue;
+    }
+    std::pair<t_physical_tile_type_ptr, e_side> template_key(grids[grid_coords[igrid].x()][grid_coords[igrid].y()].type,
+                                                             grid_border_sides[igrid]);
+    if (0 < grid_templates.count(template_key)) {
+      continue;
+    }
+    grid_templates[template_key] = std::make_shared<BitstreamManager>();
+    BitstreamManager& grid_template = *(grid_templates[template_key]);
+    ConfigBlockId sub_top_block = grid_template.create_block();
+    if (false == build_physical_block_bitstream(grid_template, sub_top_block, module_manager,
+                                                circuit_lib, mux_lib,
+                                                atom_ctx,
+                                                device_annotation, cluster_annotation,
+                                                place_annotation, bitstream_annotation,
+                                                grids, grid_coords[igrid], grid_border_sides[igrid],
+                                                lut_bitstream_cache)) {
+      exit(1);
+    }
+  }
+  return grid_templates;
+}
+
+/********************************************************************
+ * Add the bitstream of an unused grid by copying its template,
+ * and then give the grid block the name of its coordinate
+ * When the templates are shared, the grid block only refers to
+ * the grid block of its template
+ *******************************************************************/
+static 
+void add_unused_grid_bitstream(BitstreamManager& bitstream_manager,
+                               const ConfigBlockId& top_block,
+                               const UnusedGridBitstreams& grid_templates,
+                               const DeviceGrid& grids,
+                               const vtr::Point<size_t>& grid_coord,
+                               const e_side& border_side,
+                               const bool& share_unused_grids) {
+  t_physical_tile_type_ptr grid_type = grids[grid_coord.x()][grid_coord.y()].type;
+  auto result = grid_templates.find(std::make_pair(grid_type, border_side));
+  VTR_ASSERT(result != grid_templates.end());
+  const BitstreamManager& grid_template = *(result->second);
+
+  /* Grids without any configurable child have no block */
+  if (1 == grid_template.num_blocks()) {
+    return;
+  }
+
+  if (true == share_unused_grids) {
+    /* The grid block is the only child of the placeholder */
+    VTR_ASSERT(1 == grid_template.num_block_children(ConfigBlockId(0)));
+    bitstream_manager.add_shared_block(top_block,
+                                       generate_grid_block_instance_name(std::string(GRID_MODULE_NAME_PREFIX), std::string(grid_type->name),
+                                                                         is_io_type(grid_type), border_side, grid_coord),
+                                       result->second,
+                                       grid_template.block_children(ConfigBlockId(0))[0]);
+    return;
+  }
+
+  /* The grid block is the first block of the template after the placeholder,
+   * and thus the first block to be added
+   */
+  ConfigBlockId grid_configurable_block = ConfigBlockId(bitstream_manager.num_blocks());
+  bitstream_manager.add_sub_bitstream(top_block, grid_template, ConfigBlockId(0));
+  bitstream_manager.set_block_name(grid_configurable_block,
+                                   generate_grid_block_instance_name(std::string(GRID_MODULE_NAME_PREFIX), std::string(grid_type->name),
+                                                                     is_io_type(grid_type), border_side, grid_coord));
+}
+
+/********************************************************************
+ * Top-level function of this file: 
+ * Generate bitstreams for all the grids, including 
+ * 1. core grids that sit in the center of the fabric
+ * 2. side grids (I/O grids) that sit in the borders for the fabric
+ *
+ * When multiple threads are requested, the bitstream of each grid is
+ * built into a local bitstream manager on a worker thread.
+ * The local bitstreams are then added to the bitstream manager
+ * in the same order as the sequential flow, so that the block and bit ids
+ * are exactly the same as the single-thread flow
+ *
+ * The bitstreams of unused grids are built once for each type of grid
+ * and copied to each of the unused grids, or shared by all the unused grids 
+ * of the same type when requested
+ *******************************************************************/
+void build_grid_bitstream(BitstreamManager& bitstream_manager,
+                          const ConfigBlockId& top_block,
+                          const ModuleManager& module_manager,
+                          const CircuitLibrary& circuit_lib,
+                          const MuxLibrary& mux_lib,
+                          const DeviceGrid& grids,
+                          const AtomContext& atom_ctx,
+                          const VprDeviceAnnotation& device_annotation,
+                          const VprClusteringAnnotation& cluster_annotation,
+                          const VprPlacementAnnotation& place_annotation,
+                          const VprBitstreamAnnotation& bitstream_annotation,
+                          const bool& share_unused_grids,
+                          const size_t& num_threads,
+                          const bool& verbose) {
+
+  /* Collect the grids to be visited, the sequence is the same as the blocks in bitstream */
+  std::vector<vtr::Point<size_t>> grid_coords;
+  std::vector<e_side> grid_border_sides;
+  size_t num_core_grids = collect_grid_bitstream_coordinates(grids, grid_coords, grid_border_sides);
+
+  /* The bitstreams of LUTs are shared by all the grids and threads */
+  LutBitstreamCache lut_bitstream_cache;
+
+  UnusedGridBitstreams grid_templates = build_unused_grid_bitstream_templates(module_manager, circuit_lib, mux_lib,
+                                                                              grids, atom_ctx,
+                                                                              device_annotation, cluster_annotation,
+                                                                              place_annotation, bitstream_annotation,
+                                                                              grid_coords, grid_border_sides,
+                                                                              lut_bitstream_cache);
+  VTR_LOGV(verbose, "Built bitstream templates for %lu types of unused grids\n",
+           grid_templates.size());
+
+  ProgressReporter progress("Generating bitstream for grids", grid_coords.size());
+
+  /* Single thread: build the bitstream directly in the bitstream manager */
+  if (1 >= num_threads) {
+    VTR_LOGV(verbose, "Generating bitstream for core grids...");
+    for (size_t igrid = 0; igrid < num_core_grids; ++igrid) {
+      if (true == is_grid_unused(place_annotation, grid_coords[igrid])) {
+        add_unused_grid_bitstream(bitstream_manager, top_block, grid_templates,
+                                  grids, grid_coords[igrid], grid_border_sides[igrid],
+                                  share_unused_grids);
+      } else {
+        if (false == build_physical_block_bitstream(bitstream_manager, top_block, module_manager,
+                                                    circuit_lib, mux_lib,
+                                                    atom_ctx,
+                                                    device_annotation, cluster_annotation,
+                                                    place_annotation, bitstream_annotation,
+                                                    grids, grid_coords[igrid], grid_border_sides[igrid],
+                                                    lut_bitstream_cache)) {
+          exit(1);
+        }
+      }
+      progress.advance();
+    }
+    VTR_LOGV(verbose, "Done\n");
+
+    VTR_LOGV(verbose, "Generating bitstream for I/O grids...");
+    for (size_t igrid = num_core_grids; igrid < grid_coords.size(); ++igrid) {
+      if (true == is_grid_unused(place_annotation, grid_coords[igrid])) {
+        add_unused_grid_bitstream(bitstream_manager, top_block, grid_templates,
+                                  grids, grid_coords[igrid], grid_border_sides[igrid],
+                                  share_unused_grids);
+      } else {
+        if (false == build_physical_block_bitstream(bitstream_manager, top_block, module_manager,
+                                                    circuit_lib, mux_lib,
+                                                    atom_ctx,
+                                                    device_annotation, cluster_annotation,
+                                                    place_annotation, bitstream_annotation,
+                                                    grids, grid_coords[igrid], grid_border_sides[igrid],
+                                                    lut_bitstream_cache)) {
+          exit(1);
+        }
+      }
+      progress.advance();
+    }
+    VTR_LOGV(verbose, "Done\n");
+    VTR_LOGV(verbose, "Found %lu out of %lu LUT bitstreams in cache\n",
+             lut_bitstream_cache.num_hits(), lut_bitstream_cache.num_lookups());
+    return;
+  }
+
+  VTR_LOGV(verbose, "Generating bitstream for %lu grids using %lu threads...",
+           grid_coords.size(), num_threads);
+
+  /* Each grid has its own bitstream manager, whose first block is a placeholder of the top block */
+  std::vector<BitstreamManager> grid_bitstreams(grid_coords.size());
+  /* Failures are recorded by the workers and handled after all of them are joined */
+  std::vector<char> grid_success(grid_coords.size(), true);
+  parallel_for(grid_coords.size(), num_threads,
+               [&](const size_t& igrid) {
+                 /* Unused grids are copied from templates when adding the bitstreams */
+                 if (true == is_grid_unused(place_annotation, grid_coords[igrid])) {
+                   progress.advance();
+                   return;
+                 }
+                 BitstreamManager& grid_bitstream = grid_bitstreams[igrid];
+                 ConfigBlockId sub_top_block = grid_bitstream.create_block();
+                 grid_success[igrid] = build_physical_block_bitstream(grid_bitstream, sub_top_block, module_manager,
+                                                                      circuit_lib, mux_lib,
+                                                                      atom_ctx,
+                                                                      device_annotation, cluster_annotation,
+                                                                      place_annotation, bitstream_annotation,
+                                                                      grids, grid_coords[igrid], grid_border_sides[igrid],
+                                                                      lut_bitstream_cache);
+                 progress.advance();
+               });
+  /* The errors have been printed when the workers were joined */
+  if (grid_success.end() != std::find(grid_success.begin(), grid_success.end(), false)) {
+    exit(1);
+  }
+
+  /* Add the grid bitstreams in the same order as sequential flow */
+  for (size_t igrid = 0; igrid < grid_coords.size(); ++igrid) {
+    if (true == is_grid_unused(place_annotation, grid_coords[igrid])) {
+      add_unused_grid_bitstream(bitstream_manager, top_block, grid_templates,
+                                grids, grid_coords[igrid], grid_border_sides[igrid],
+                                share_unused_grids);
+      continue;
+    }
+    bitstream_manager.add_sub_bitstream(top_block, grid_bitstreams[igrid], ConfigBlockId(0));
+    /* Release memory as soon as possible */
+    grid_bitstreams[igrid] = BitstreamManager();
+  }
   VTR_LOGV(verbose, "Done\n");
+  VTR_LOGV(verbose, "Found %lu out of %lu LUT bitstreams in cache\n",
+           lut_bitstream_cache.num_hits(), lut_bitstream_cache.num_lookups());
+}
+
+/********************************************************************
+ * Build again the bitstreams of the grids which are marked as changed,
+ * and overwrite the blocks of these grids in an existing bitstream,
+ * which has been built by build_grid_bitstream() on the same fabric.
+ * The blocks of grids are found by their names among the given child blocks
+ * of the top block.
+ * Return the number of bits whose values are changed
+ *******************************************************************/
+size_t update_grid_bitstream(BitstreamManager& bitstream_manager,
+                             const std::map<std::string, ConfigBlockId>& top_child_blocks,
+                             const ModuleManager& module_manager,
+                             const CircuitLibrary& circuit_lib,
+                             const MuxLibrary& mux_lib,
+                             const DeviceGrid& grids,
+                             const AtomContext& atom_ctx,
+                             const VprDeviceAnnotation& device_annotation,
+                             const VprClusteringAnnotation& cluster_annotation,
+                             const VprPlacementAnnotation& place_annotation,
+                             const VprBitstreamAnnotation& bitstream_annotation,
+                             const vtr::Matrix<bool>& changed_grids,
+                             const size_t& num_threads,
+                             const bool& verbose) {
+  std::vector<vtr::Point<size_t>> grid_coords;
+  std::vector<e_side> grid_border_sides;
+  collect_grid_bitstream_coordinates(grids, grid_coords, grid_border_sides);
+
+  /* The bitstreams of LUTs are shared by all the grids and threads */
+  LutBitstreamCache lut_bitstream_cache;
+
+  /* Keep only the grids to be updated */
+  std::vector<size_t> changed_grid_ids;
+  for (size_t igrid = 0; igrid < grid_coords.size(); ++igrid) {
+    if (true == changed_grids[grid_coords[igrid].x()][grid_coords[igrid].y()]) {
+      changed_grid_ids.push_back(igrid);
+    }
+  }
+
+  VTR_LOGV(verbose, "Updating bitstream for %lu out of %lu grids...",
+           changed_grid_ids.size(), grid_coords.size());
+
+  /* Each grid has its own bitstream manager, whose first block is a placeholder of the top block */
+  std::vector<BitstreamManager> grid_bitstreams(changed_grid_ids.size());
+  /* Failures are recorded by the workers and handled after all of them are joined */
+  std::vector<char> grid_success(changed_grid_ids.size(), true);
+  parallel_for(changed_grid_ids.size(), num_threads,
+               [&](const size_t& ichanged) {
+                 size_t igrid = changed_grid_ids[ichanged];
+                 BitstreamManager& grid_bitstream = grid_bitstreams[ichanged];
+                 ConfigBlockId sub_top_block = grid_bitstream.create_block();
+                 grid_success[ichanged] = build_physical_block_bitstream(grid_bitstream, sub_top_block, module_manager,
+                                                                         circuit_lib, mux_lib,
+                                                                         atom_ctx,
+                                                                         device_annotation, cluster_annotation,
+                                                                         place_annotation, bitstream_annotation,
+                                                                         grids, grid_coords[igrid], grid_border_sides[igrid],
+                                                                         lut_bitstream_cache);
+               });
+  /* The errors have been printed when the workers were joined */
+  if (grid_success.end() != std::find(grid_success.begin(), grid_success.end(), false)) {
+    exit(1);
+  }
+
+  /* Overwrite the grid blocks in a fixed order */
+  size_t num_changed_bits = 0;
+  for (BitstreamManager& grid_bitstream : grid_bitstreams) {
+    /* Grids without any configurable child have no block */
+    for (const ConfigBlockId& grid_block : grid_bitstream.block_children(ConfigBlockId(0))) {
+      auto result = top_child_blocks.find(grid_bitstream.block_name(grid_block));
+      VTR_ASSERT(result != top_child_blocks.end());
+      num_changed_bits += bitstream_manager.overwrite_block_bitstream(result->second, grid_bitstream, grid_block);
+    }
+    /* Release memory as soon as possible */
+    grid_bitstream = BitstreamManager();
+  }
+  VTR_LOGV(verbose, "Done\n");
+
+  return num_changed_bits;
 }
 
 } /* end namespace openfpga */
@@ -4,7 +4,10 @@
 /********************************************************************
  * Include header files that are required by function declaration
  *******************************************************************/
+#include <map>
+#include <string>
 #include <vector>
+#include "vtr_ndmatrix.h"
 #include "vpr_context.h"
 #include "device_grid.h"
 #include "bitstream_manager.h"
@@ -34,8 +37,25 @@ void build_grid_bitstream(BitstreamManager& bitstream_manager,
                           const VprClusteringAnnotation& cluster_annotation,
                           const VprPlacementAnnotation& place_annotation,
                           const VprBitstreamAnnotation& bitstream_annotation,
+                          const bool& share_unused_grids,
+                          const size_t& num_threads,
                           const bool& verbose);
 
+size_t update_grid_bitstream(BitstreamManager& bitstream_manager,
+                             const std::map<std::string, ConfigBlockId>& top_child_blocks,
+                             const ModuleManager& module_manager,
+                             const CircuitLibrary& circuit_lib,
+                             const MuxLibrary& mux_lib,
+                             const DeviceGrid& grids,
+                             const AtomContext& atom_ctx,
+                             const VprDeviceAnnotation& device_annotation,
+                             const VprClusteringAnnotation& cluster_annotation,
+                             const VprPlacementAnnotation& place_annotation,
+                             const VprBitstreamAnnotation& bitstream_annotation,
+                             const vtr::Matrix<bool>& changed_grids,
+                             const size_t& num_threads,
+                             const bool& verbose);
+
 } /* end namespace openfpga */
 
 #endif
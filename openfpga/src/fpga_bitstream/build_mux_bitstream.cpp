@@ -70,7 +70,7 @@ std::vector<bool> build_cmos_mux_bitstream(const CircuitLibrary& circuit_lib,
   size_t implemented_mux_size = find_mux_implementation_num_inputs(circuit_lib, mux_model, mux_size);
   /* Note that the mux graph is indexed using datapath MUX size!!!! */
   MuxId mux_graph_id = mux_lib.mux_graph(mux_model, mux_size);
-  const MuxGraph mux_graph = mux_lib.mux_graph(mux_graph_id);
+  const MuxGraph& mux_graph = mux_lib.mux_graph(mux_graph_id);
 
   size_t datapath_id = path_id;
 
@@ -85,21 +85,16 @@ std::vector<bool> build_cmos_mux_bitstream(const CircuitLibrary& circuit_lib,
   /* We should have only one output for this MUX! */
   VTR_ASSERT(1 == mux_graph.outputs().size());
 
-  /* Generate the memory bits */
-  vtr::vector<MuxMemId, bool> raw_bitstream = mux_graph.decode_memory_bits(MuxInputId(datapath_id), mux_graph.output_id(mux_graph.outputs()[0]));
-
-  std::vector<bool> mux_bitstream;
-  for (const bool& bit : raw_bitstream) {
-    mux_bitstream.push_back(bit);
-  }
+  /* Find the memory bits, which have been decoded by the MUX library */
+  const std::vector<bool>& raw_bitstream = mux_lib.mux_memory_bits(mux_graph_id, MuxInputId(datapath_id));
 
   /* Consider local encoder support, we need further encode the bitstream */
   if (false == circuit_lib.mux_use_local_encoder(mux_model)) {
-    return mux_bitstream;
+    return raw_bitstream;
   }
 
-  /* Clear the mux_bitstream, we need to apply encoding */
-  mux_bitstream.clear();
+  /* We need to apply encoding */
+  std::vector<bool> mux_bitstream;
 
   /* Encode the memory bits level by level,
    * One local encoder is used for each level of multiplexers 
@@ -110,17 +105,18 @@ std::vector<bool> build_cmos_mux_bitstream(const CircuitLibrary& circuit_lib,
      * the sram_bits will be the 2-digit binary number of 3: 10
      */
     std::vector<size_t> encoder_data;
+    std::vector<MuxMemId> level_mems = mux_graph.memories_at_level(level);
 
     /* Exception: there is only 1 memory at this level, bitstream will not be changed!!! */
-    if (1 == mux_graph.memories_at_level(level).size()) {
-      mux_bitstream.push_back(raw_bitstream[mux_graph.memories_at_level(level)[0]]);
+    if (1 == level_mems.size()) {
+      mux_bitstream.push_back(raw_bitstream[size_t(level_mems[0])]);
       continue;
     }
 
     /* Otherwise: we follow a regular recipe */
-    for (size_t mem_index = 0; mem_index < mux_graph.memories_at_level(level).size(); ++mem_index) {
+    for (size_t mem_index = 0; mem_index < level_mems.size(); ++mem_index) {
       /* Conversion rule: true = 1, false = 0 */
-      if (true == raw_bitstream[mux_graph.memories_at_level(level)[mem_index]]) {
+      if (true == raw_bitstream[size_t(level_mems[mem_index])]) {
         encoder_data.push_back(mem_index);
       } 
     }
@@ -129,10 +125,10 @@ std::vector<bool> build_cmos_mux_bitstream(const CircuitLibrary& circuit_lib,
     /* Convert to encoded bits */
     std::vector<size_t> encoder_addr;
     if (0 == encoder_data.size()) { 
-      encoder_addr = itobin_vec(0, find_mux_local_decoder_addr_size(mux_graph.memories_at_level(level).size()));
+      encoder_addr = itobin_vec(0, find_mux_local_decoder_addr_size(level_mems.size()));
     } else {
       VTR_ASSERT(1 == encoder_data.size());
-      encoder_addr = itobin_vec(encoder_data[0], find_mux_local_decoder_addr_size(mux_graph.memories_at_level(level).size()));
+      encoder_addr = itobin_vec(encoder_data[0], find_mux_local_decoder_addr_size(level_mems.size()));
     }
     /* Build final mux bitstream */
     for (const size_t& bit : encoder_addr) {
@@ -170,4 +166,34 @@ std::vector<bool> build_mux_bitstream(const CircuitLibrary& circuit_lib,
   return mux_bitstream;
 }
 
+/********************************************************************
+ * This function generates the bitstream of the default path
+ * for each multiplexer in the library, indexed by the MUX ids.
+ * Most of the routing multiplexers in a fabric are not used by a design
+ * and share these bitstreams, which are built only once.
+ * No bitstream is built for the LUTs in the library
+ *******************************************************************/
+vtr::vector<MuxId, std::vector<bool>> build_mux_default_bitstreams(const CircuitLibrary& circuit_lib,
+                                                                   const MuxLibrary& mux_lib) {
+  vtr::vector<MuxId, std::vector<bool>> default_bitstreams(mux_lib.muxes().size());
+
+  for (const MuxId& mux : mux_lib.muxes()) {
+    CircuitModelId mux_model = mux_lib.mux_circuit_model(mux);
+    if (CIRCUIT_MODEL_MUX != circuit_lib.model_type(mux_model)) {
+      continue;
+    }
+    /* The library is indexed by the datapath MUX size, 
+     * which excludes the constant input of the implementation 
+     */
+    size_t mux_size = mux_lib.mux_graph(mux).num_inputs();
+    if (true == circuit_lib.mux_add_const_input(mux_model)) {
+      mux_size--;
+    }
+    VTR_ASSERT(mux == mux_lib.mux_graph(mux_model, mux_size));
+    default_bitstreams[mux] = build_mux_bitstream(circuit_lib, mux_model, mux_lib, mux_size, DEFAULT_PATH_ID);
+  }
+
+  return default_bitstreams;
+}
+
 } /* end namespace openfpga */
@@ -5,6 +5,7 @@
  * Include header files that are required by function declaration
  *******************************************************************/
 #include <vector>
+#include "vtr_vector.h"
 #include "circuit_library.h"
 #include "mux_library.h"
 
@@ -25,6 +26,9 @@ std::vector<bool> build_mux_bitstream(const CircuitLibrary& circuit_lib,
                                       const size_t& mux_size,
                                       const int& path_id);
 
+vtr::vector<MuxId, std::vector<bool>> build_mux_default_bitstreams(const CircuitLibrary& circuit_lib,
+                                                                   const MuxLibrary& mux_lib);
+
 } /* end namespace openfpga */
 
 #endif
@@ -5,6 +5,7 @@
  * which locate in global routing architecture
  *******************************************************************/
 #include <vector>
+#include <functional>
 
 /* Headers from vtrutil library */
 #include "vtr_assert.h"
@@ -12,6 +13,8 @@
 
 /* Headers from openfpgautil library */
 #include "openfpga_side_manager.h"
+#include "openfpga_parallel.h"
+#include "openfpga_progress.h"
 
 #include "mux_utils.h"
 #include "rr_gsb_utils.h"
@@ -27,6 +30,38 @@
 /* begin namespace openfpga */
 namespace openfpga {
 
+/********************************************************************
+ * Find the name of the atom net mapped to a routing net
+ * Unmapped nodes are resolved without the look-up of atom nets,
+ * which are the majority of the rr_nodes in a fabric
+ *******************************************************************/
+static 
+std::string find_routing_net_name(const AtomContext& atom_ctx,
+                                  const ClusterNetId& net) {
+  if (ClusterNetId::INVALID() == net) {
+    return std::string("unmapped");
+  }
+  AtomNetId atom_net = atom_ctx.lookup.atom_net(net);
+  if (true == atom_ctx.nlist.valid_net_id(atom_net)) {
+    return atom_ctx.nlist.net_name(atom_net);
+  }
+  return std::string("unmapped");
+}
+
+/********************************************************************
+ * Find if any node of a GSB is mapped to a net, in O(1) when
+ * the used nodes of GSBs have been counted.
+ * Otherwise, the GSB is considered as used and its nodes are visited
+ *******************************************************************/
+static 
+bool is_gsb_used(const VprRoutingAnnotation& routing_annotation,
+                 const vtr::Point<size_t>& gsb_coord) {
+  if (false == routing_annotation.has_gsb_num_used_nodes()) {
+    return true;
+  }
+  return 0 < routing_annotation.gsb_num_used_nodes(gsb_coord);
+}
+
 /********************************************************************
  * This function generates bitstream for a routing multiplexer
  * This function will identify if a node indicates a routing multiplexer
@@ -39,12 +74,18 @@ void build_switch_block_mux_bitstream(BitstreamManager& bitstream_manager,
                                       const ModuleManager& module_manager,
                                       const CircuitLibrary& circuit_lib,
                                       const MuxLibrary& mux_lib,
+                                      const vtr::vector<MuxId, std::vector<bool>>& mux_default_bitstreams,
                                       const RRGraph& rr_graph,
-                                      const RRNodeId& cur_rr_node,
+                                      const RRGSB& rr_gsb,
+                                      const e_side& chan_side,
+                                      const size_t& chan_node_id,
                                       const std::vector<RRNodeId>& drive_rr_nodes,
                                       const AtomContext& atom_ctx,
                                       const VprDeviceAnnotation& device_annotation,
-                                      const VprRoutingAnnotation& routing_annotation) {
+                                      const VprRoutingAnnotation& routing_annotation,
+                                      const bool& gsb_used) {
+  const RRNodeId& cur_rr_node = rr_gsb.get_chan_node(chan_side, chan_node_id);
+
   /* Check current rr_node is CHANX or CHANY*/
   VTR_ASSERT( (CHANX == rr_graph.node_type(cur_rr_node))
            || (CHANY == rr_graph.node_type(cur_rr_node)));
@@ -54,7 +95,11 @@ void build_switch_block_mux_bitstream(BitstreamManager& bitstream_manager,
 
   /* Cache input and output nets */
   std::vector<ClusterNetId> input_nets;
-  ClusterNetId output_net = routing_annotation.rr_node_net(cur_rr_node);
+  /* No net is mapped to any node of an unused GSB */
+  ClusterNetId output_net = ClusterNetId::INVALID();
+  if (true == gsb_used) {
+    output_net = routing_annotation.rr_node_net(cur_rr_node);
+  }
   for (size_t inode = 0; inode < drive_rr_nodes.size(); ++inode) {
     input_nets.push_back(routing_annotation.rr_node_net(drive_rr_nodes[inode]));
   }
@@ -64,17 +109,17 @@ void build_switch_block_mux_bitstream(BitstreamManager& bitstream_manager,
    * Two conditions to be considered:
    * - There is no net mapped to cur_rr_node: we use default path id
    * - There is a net mapped to cur_rr_node: we find the path id
+   *   of the previous node among the resolved drivers of the GSB
    */
   int path_id = DEFAULT_PATH_ID;
   if (ClusterNetId::INVALID() != output_net) {
     /* We must have a valid previous node that is supposed to drive the source node! */
     VTR_ASSERT(routing_annotation.rr_node_prev_node(cur_rr_node));
-    for (size_t inode = 0; inode < drive_rr_nodes.size(); ++inode) {
-      if ( (input_nets[inode] == output_net)
-        && (drive_rr_nodes[inode] == routing_annotation.rr_node_prev_node(cur_rr_node)) ) {
-        path_id = (int)inode;
-        break;
-      }
+    size_t driver_path_id = rr_gsb.find_chan_node_driver_path_id(rr_graph, chan_side, chan_node_id,
+                                                                 routing_annotation.rr_node_prev_node(cur_rr_node));
+    if ( (size_t(-1) != driver_path_id)
+      && (input_nets[driver_path_id] == output_net) ) {
+      path_id = (int)driver_path_id;
     }
   }
 
@@ -88,8 +133,15 @@ void build_switch_block_mux_bitstream(BitstreamManager& bitstream_manager,
   VTR_ASSERT(1 == driver_switches.size());
   CircuitModelId mux_model = device_annotation.rr_switch_circuit_model(driver_switches[0]);
 
-  /* Generate bitstream depend on both technology and structure of this MUX */
-  std::vector<bool> mux_bitstream = build_mux_bitstream(circuit_lib, mux_model, mux_lib, datapath_mux_size, path_id); 
+  /* Generate bitstream depend on both technology and structure of this MUX 
+   * The bitstream of an unused MUX is the one of its default path, which is built in advance
+   */
+  std::vector<bool> mux_bitstream;
+  if (DEFAULT_PATH_ID == path_id) {
+    mux_bitstream = mux_default_bitstreams[mux_lib.mux_graph(mux_model, datapath_mux_size)];
+  } else {
+    mux_bitstream = build_mux_bitstream(circuit_lib, mux_model, mux_lib, datapath_mux_size, path_id); 
+  }
 
   /* Find the module in module manager and ensure the bitstream size matches! */
   std::string mem_module_name = generate_mux_subckt_name(circuit_lib, mux_model, datapath_mux_size, std::string(MEMORY_MODULE_POSTFIX)); 
@@ -111,24 +163,14 @@ void build_switch_block_mux_bitstream(BitstreamManager& bitstream_manager,
     if (true == need_splitter) {
       input_net_ids += std::string(" ");
     }
-    AtomNetId input_atom_net = atom_ctx.lookup.atom_net(input_net);
-    if (true == atom_ctx.nlist.valid_net_id(input_atom_net)) {
-      input_net_ids += atom_ctx.nlist.net_name(input_atom_net);
-    } else {
-      input_net_ids += std::string("unmapped");
-    }
+    input_net_ids += find_routing_net_name(atom_ctx, input_net);
     need_splitter = true;
   }
   bitstream_manager.add_input_net_id_to_block(mux_mem_block, input_net_ids);
 
   /* Add output nets */
   std::string output_net_ids;
-  AtomNetId output_atom_net = atom_ctx.lookup.atom_net(output_net);
-  if (true == atom_ctx.nlist.valid_net_id(output_atom_net)) {
-    output_net_ids += atom_ctx.nlist.net_name(output_atom_net);
-  } else {
-    output_net_ids += std::string("unmapped");
-  }
+  output_net_ids += find_routing_net_name(atom_ctx, output_net);
   bitstream_manager.add_output_net_id_to_block(mux_mem_block, output_net_ids);
 }
 
@@ -145,22 +187,21 @@ void build_switch_block_interc_bitstream(BitstreamManager& bitstream_manager,
                                          const ModuleManager& module_manager,
                                          const CircuitLibrary& circuit_lib,
                                          const MuxLibrary& mux_lib,
+                                         const vtr::vector<MuxId, std::vector<bool>>& mux_default_bitstreams,
                                          const RRGraph& rr_graph,
                                          const AtomContext& atom_ctx,
                                          const VprDeviceAnnotation& device_annotation,
                                          const VprRoutingAnnotation& routing_annotation,
                                          const RRGSB& rr_gsb,
                                          const e_side& chan_side,
-                                         const size_t& chan_node_id) {
+                                         const size_t& chan_node_id,
+                                         const bool& gsb_used) {
 
   std::vector<RRNodeId> driver_rr_nodes;
 
-  /* Get the node */
-  const RRNodeId& cur_rr_node = rr_gsb.get_chan_node(chan_side, chan_node_id);
-
   /* Determine if the interc lies inside a channel wire, that is interc between segments */
   if (false == rr_gsb.is_sb_node_passing_wire(rr_graph, chan_side, chan_node_id)) {
-    driver_rr_nodes = get_rr_gsb_chan_node_configurable_driver_nodes(rr_graph, rr_gsb, chan_side, chan_node_id);
+    driver_rr_nodes = rr_gsb.get_chan_node_driver_nodes(rr_graph, chan_side, chan_node_id);
     /* Special: if there are zero-driver nodes. We skip here */
     if (0 == driver_rr_nodes.size()) {
       return; 
@@ -178,9 +219,10 @@ void build_switch_block_interc_bitstream(BitstreamManager& bitstream_manager,
     bitstream_manager.add_child_block(sb_configurable_block, mux_mem_block);
     /* This is a routing multiplexer! Generate bitstream */
     build_switch_block_mux_bitstream(bitstream_manager, mux_mem_block, module_manager,
-                                     circuit_lib, mux_lib, rr_graph, 
-                                     cur_rr_node, driver_rr_nodes, 
-                                     atom_ctx, device_annotation, routing_annotation);
+                                     circuit_lib, mux_lib, mux_default_bitstreams, rr_graph, 
+                                     rr_gsb, chan_side, chan_node_id, driver_rr_nodes, 
+                                     atom_ctx, device_annotation, routing_annotation,
+                                     gsb_used);
   } /*Nothing should be done else*/ 
 }
 
@@ -201,11 +243,13 @@ void build_switch_block_bitstream(BitstreamManager& bitstream_manager,
                                   const ModuleManager& module_manager,
                                   const CircuitLibrary& circuit_lib,
                                   const MuxLibrary& mux_lib,
+                                  const vtr::vector<MuxId, std::vector<bool>>& mux_default_bitstreams,
                                   const AtomContext& atom_ctx,
                                   const VprDeviceAnnotation& device_annotation,
                                   const VprRoutingAnnotation& routing_annotation,
                                   const RRGraph& rr_graph,
-                                  const RRGSB& rr_gsb) {
+                                  const RRGSB& rr_gsb,
+                                  const bool& gsb_used) {
 
   /* Iterate over all the multiplexers */
   for (size_t side = 0; side < rr_gsb.get_num_sides(); ++side) {
@@ -219,9 +263,10 @@ void build_switch_block_bitstream(BitstreamManager& bitstream_manager,
       }
       build_switch_block_interc_bitstream(bitstream_manager, sb_config_block, 
                                           module_manager, 
-                                          circuit_lib, mux_lib, rr_graph,
+                                          circuit_lib, mux_lib, mux_default_bitstreams, rr_graph,
                                           atom_ctx, device_annotation, routing_annotation,
-                                          rr_gsb, side_manager.get_side(), itrack);
+                                          rr_gsb, side_manager.get_side(), itrack,
+                                          gsb_used);
     }
   }
 }
@@ -239,43 +284,49 @@ void build_connection_block_mux_bitstream(BitstreamManager& bitstream_manager,
                                           const ModuleManager& module_manager,
                                           const CircuitLibrary& circuit_lib,
                                           const MuxLibrary& mux_lib,
+                                          const vtr::vector<MuxId, std::vector<bool>>& mux_default_bitstreams,
                                           const AtomContext& atom_ctx,
                                           const VprDeviceAnnotation& device_annotation,
                                           const VprRoutingAnnotation& routing_annotation,
                                           const RRGraph& rr_graph,
-                                          const RRNodeId& src_rr_node) {
+                                          const RRGSB& rr_gsb,
+                                          const e_side& cb_ipin_side,
+                                          const size_t& ipin_index,
+                                          const std::vector<RRNodeId>& drive_rr_nodes,
+                                          const bool& gsb_used) {
+  const RRNodeId& src_rr_node = rr_gsb.get_ipin_node(cb_ipin_side, ipin_index);
 
-  /* Find drive_rr_nodes*/
-  size_t datapath_mux_size = rr_graph.node_fan_in(src_rr_node);
+  /* Find the input size of the implementation of a routing multiplexer */
+  size_t datapath_mux_size = drive_rr_nodes.size();
 
   /* Cache input and output nets */
   std::vector<ClusterNetId> input_nets;
-  ClusterNetId output_net = routing_annotation.rr_node_net(src_rr_node);
-  for (const RREdgeId& edge : rr_graph.node_in_edges(src_rr_node)) {
-    RRNodeId driver_node = rr_graph.edge_src_node(edge);
+  /* No net is mapped to any node of an unused GSB */
+  ClusterNetId output_net = ClusterNetId::INVALID();
+  if (true == gsb_used) {
+    output_net = routing_annotation.rr_node_net(src_rr_node);
+  }
+  for (const RRNodeId& driver_node : drive_rr_nodes) {
     input_nets.push_back(routing_annotation.rr_node_net(driver_node));
   }
 
   /* Configuration bits for MUX*/
   int path_id = DEFAULT_PATH_ID;
-  int edge_index = 0;
 
   /* Find which path is connected to the output of this routing multiplexer
    * Two conditions to be considered:
    * - There is no net mapped to src_rr_node: we use default path id
    * - There is a net mapped to src_rr_node: we find the path id
+   *   of the previous node among the resolved drivers of the GSB
    */
   if (ClusterNetId::INVALID() != output_net) {
-    for (const RREdgeId& edge : rr_graph.node_in_edges(src_rr_node)) {
-      RRNodeId driver_node = rr_graph.edge_src_node(edge);
-      /* We must have a valid previous node that is supposed to drive the source node! */
-      VTR_ASSERT(routing_annotation.rr_node_prev_node(src_rr_node));
-      if ( (routing_annotation.rr_node_net(driver_node) == output_net) 
-         && (driver_node == routing_annotation.rr_node_prev_node(src_rr_node)) ) {
-        path_id = edge_index;
-        break;
-      }
-      edge_index++;
+    /* We must have a valid previous node that is supposed to drive the source node! */
+    VTR_ASSERT(routing_annotation.rr_node_prev_node(src_rr_node));
+    size_t driver_path_id = rr_gsb.find_ipin_node_driver_path_id(rr_graph, cb_ipin_side, ipin_index,
+                                                                 routing_annotation.rr_node_prev_node(src_rr_node));
+    if ( (size_t(-1) != driver_path_id)
+      && (input_nets[driver_path_id] == output_net) ) {
+      path_id = (int)driver_path_id;
     }
   }
 
@@ -289,8 +340,15 @@ void build_connection_block_mux_bitstream(BitstreamManager& bitstream_manager,
   VTR_ASSERT(1 == driver_switches.size());
   CircuitModelId mux_model = device_annotation.rr_switch_circuit_model(driver_switches[0]);
 
-  /* Generate bitstream depend on both technology and structure of this MUX */
-  std::vector<bool> mux_bitstream = build_mux_bitstream(circuit_lib, mux_model, mux_lib, datapath_mux_size, path_id); 
+  /* Generate bitstream depend on both technology and structure of this MUX 
+   * The bitstream of an unused MUX is the one of its default path, which is built in advance
+   */
+  std::vector<bool> mux_bitstream;
+  if (DEFAULT_PATH_ID == path_id) {
+    mux_bitstream = mux_default_bitstreams[mux_lib.mux_graph(mux_model, datapath_mux_size)];
+  } else {
+    mux_bitstream = build_mux_bitstream(circuit_lib, mux_model, mux_lib, datapath_mux_size, path_id); 
+  }
 
   /* Find the module in module manager and ensure the bitstream size matches! */
   std::string mem_module_name = generate_mux_subckt_name(circuit_lib, mux_model, datapath_mux_size, std::string(MEMORY_MODULE_POSTFIX)); 
@@ -312,24 +370,14 @@ void build_connection_block_mux_bitstream(BitstreamManager& bitstream_manager,
     if (true == need_splitter) {
       input_net_ids += std::string(" ");
     }
-    AtomNetId input_atom_net = atom_ctx.lookup.atom_net(input_net);
-    if (true == atom_ctx.nlist.valid_net_id(input_atom_net)) {
-      input_net_ids += atom_ctx.nlist.net_name(input_atom_net);
-    } else {
-      input_net_ids += std::string("unmapped");
-    }
+    input_net_ids += find_routing_net_name(atom_ctx, input_net);
     need_splitter = true;
   }
   bitstream_manager.add_input_net_id_to_block(mux_mem_block, input_net_ids);
 
   /* Add output nets */
   std::string output_net_ids;
-  AtomNetId output_atom_net = atom_ctx.lookup.atom_net(output_net);
-  if (true == atom_ctx.nlist.valid_net_id(output_atom_net)) {
-    output_net_ids += atom_ctx.nlist.net_name(output_atom_net);
-  } else {
-    output_net_ids += std::string("unmapped");
-  }
+  output_net_ids += find_routing_net_name(atom_ctx, output_net);
   bitstream_manager.add_output_net_id_to_block(mux_mem_block, output_net_ids);
 
 }
@@ -347,18 +395,20 @@ void build_connection_block_interc_bitstream(BitstreamManager& bitstream_manager
                                          const ModuleManager& module_manager,
                                          const CircuitLibrary& circuit_lib,
                                          const MuxLibrary& mux_lib,
+                                         const vtr::vector<MuxId, std::vector<bool>>& mux_default_bitstreams,
                                          const AtomContext& atom_ctx,
                                          const VprDeviceAnnotation& device_annotation,
                                          const VprRoutingAnnotation& routing_annotation,
                                          const RRGraph& rr_graph,
                                          const RRGSB& rr_gsb,
                                          const e_side& cb_ipin_side, 
-                                         const size_t& ipin_index) {
+                                         const size_t& ipin_index,
+                                         const bool& gsb_used) {
 
   RRNodeId src_rr_node = rr_gsb.get_ipin_node(cb_ipin_side, ipin_index);
 
   /* Consider configurable edges only */
-  std::vector<RRNodeId> driver_rr_nodes = get_rr_graph_configurable_driver_nodes(rr_graph, src_rr_node);
+  std::vector<RRNodeId> driver_rr_nodes = rr_gsb.get_ipin_node_driver_nodes(rr_graph, cb_ipin_side, ipin_index);
 
   if (1 == driver_rr_nodes.size()) {
     /* No bitstream generation required by a special direct connection*/
@@ -369,9 +419,10 @@ void build_connection_block_interc_bitstream(BitstreamManager& bitstream_manager
     bitstream_manager.add_child_block(cb_configurable_block, mux_mem_block);
     /* This is a routing multiplexer! Generate bitstream */
     build_connection_block_mux_bitstream(bitstream_manager, mux_mem_block, 
-                                         module_manager, circuit_lib, mux_lib, 
+                                         module_manager, circuit_lib, mux_lib, mux_default_bitstreams, 
                                          atom_ctx, device_annotation, routing_annotation,
-                                         rr_graph, src_rr_node);
+                                         rr_graph, rr_gsb, cb_ipin_side, ipin_index,
+                                         driver_rr_nodes, gsb_used);
   } /*Nothing should be done else*/ 
 }
 
@@ -392,12 +443,14 @@ void build_connection_block_bitstream(BitstreamManager& bitstream_manager,
                                       const ModuleManager& module_manager,
                                       const CircuitLibrary& circuit_lib,
                                       const MuxLibrary& mux_lib,
+                                      const vtr::vector<MuxId, std::vector<bool>>& mux_default_bitstreams,
                                       const AtomContext& atom_ctx,
                                       const VprDeviceAnnotation& device_annotation,
                                       const VprRoutingAnnotation& routing_annotation,
                                       const RRGraph& rr_graph,
                                       const RRGSB& rr_gsb,
-                                      const t_rr_type& cb_type) {
+                                      const t_rr_type& cb_type,
+                                      const bool& gsb_used) {
    
   /* Find routing multiplexers on the sides of a Connection block where IPIN nodes locate */
   std::vector<enum e_side> cb_sides = rr_gsb.get_cb_ipin_sides(cb_type);
@@ -407,82 +460,191 @@ void build_connection_block_bitstream(BitstreamManager& bitstream_manager,
     SideManager side_manager(cb_ipin_side);
     for (size_t inode = 0; inode < rr_gsb.get_num_ipin_nodes(cb_ipin_side); ++inode) { 
       build_connection_block_interc_bitstream(bitstream_manager, cb_configurable_block,
-                                              module_manager, circuit_lib, mux_lib, 
+                                              module_manager, circuit_lib, mux_lib, mux_default_bitstreams, 
                                               atom_ctx, device_annotation, routing_annotation,
                                               rr_graph, rr_gsb,
-                                              cb_ipin_side, inode);
+                                              cb_ipin_side, inode, gsb_used);
     }
   }
 }
 
 /********************************************************************
- * Create bitstream for a X-direction or Y-direction Connection Blocks
+ * Create bitstream for a X-direction or Y-direction Connection Block
+ * in a GSB at a given coordinate
  *******************************************************************/
 static 
-void build_connection_block_bitstreams(BitstreamManager& bitstream_manager,
-                                       const ConfigBlockId& top_configurable_block,
-                                       const ModuleManager& module_manager,
-                                       const CircuitLibrary& circuit_lib,
-                                       const MuxLibrary& mux_lib,
-                                       const AtomContext& atom_ctx,
-                                       const VprDeviceAnnotation& device_annotation,
-                                       const VprRoutingAnnotation& routing_annotation,
-                                       const RRGraph& rr_graph,
-                                       const DeviceRRGSB& device_rr_gsb,
-                                       const bool& compact_routing_hierarchy,
-                                       const t_rr_type& cb_type) {
-
-  vtr::Point<size_t> cb_range = device_rr_gsb.get_gsb_range();
-
-  for (size_t ix = 0; ix < cb_range.x(); ++ix) {
-    for (size_t iy = 0; iy < cb_range.y(); ++iy) {
-      const RRGSB& rr_gsb = device_rr_gsb.get_gsb(ix, iy);
-      /* Check if the connection block exists in the device!
-       * Some of them do NOT exist due to heterogeneous blocks (height > 1) 
-       * We will skip those modules
-       */
-      if (false == rr_gsb.is_cb_exist(cb_type)) {
-        continue;
-      }
-      /* Skip if the cb does not contain any configuration bits! */
-      if (true == connection_block_contain_only_routing_tracks(rr_gsb, cb_type)) {
-        continue;
-      }
+void build_gsb_connection_block_bitstream(BitstreamManager& bitstream_manager,
+                                          const ConfigBlockId& top_configurable_block,
+                                          const ModuleManager& module_manager,
+                                          const CircuitLibrary& circuit_lib,
+                                          const MuxLibrary& mux_lib,
+                                          const vtr::vector<MuxId, std::vector<bool>>& mux_default_bitstreams,
+                                          const AtomContext& atom_ctx,
+                                          const VprDeviceAnnotation& device_annotation,
+                                          const VprRoutingAnnotation& routing_annotation,
+                                          const RRGraph& rr_graph,
+                                          const DeviceRRGSB& device_rr_gsb,
+                                          const bool& compact_routing_hierarchy,
+                                          const t_rr_type& cb_type,
+                                          const vtr::Point<size_t>& gsb_coord) {
+  const RRGSB& rr_gsb = device_rr_gsb.get_gsb(gsb_coord.x(), gsb_coord.y());
+  /* Check if the connection block exists in the device!
+   * Some of them do NOT exist due to heterogeneous blocks (height > 1) 
+   * We will skip those modules
+   */
+  if (false == rr_gsb.is_cb_exist(cb_type)) {
+    return;
+  }
+  /* Skip if the cb does not contain any configuration bits! */
+  if (true == connection_block_contain_only_routing_tracks(rr_gsb, cb_type)) {
+    return;
+  }
 
-      /* Find the cb module so that we can precisely reserve child blocks */
-      vtr::Point<size_t> cb_coord(rr_gsb.get_cb_x(cb_type), rr_gsb.get_cb_y(cb_type));
-      std::string cb_module_name = generate_connection_block_module_name(cb_type, cb_coord);
-      if (true == compact_routing_hierarchy) {
-        vtr::Point<size_t> unique_cb_coord(ix, iy);
-        /* Note: use GSB coordinate when inquire for unique modules!!! */
-        const RRGSB& unique_mirror = device_rr_gsb.get_cb_unique_module(cb_type, unique_cb_coord);
-        unique_cb_coord.set_x(unique_mirror.get_cb_x(cb_type)); 
-        unique_cb_coord.set_y(unique_mirror.get_cb_y(cb_type)); 
-        cb_module_name = generate_connection_block_module_name(cb_type, unique_cb_coord);
-      } 
-      ModuleId cb_module = module_manager.find_module(cb_module_name);
-      VTR_ASSERT(true == module_manager.valid_module_id(cb_module));
-
-      /* Bypass empty blocks which have none configurable children */
-      if (0 == count_module_manager_module_configurable_children(module_manager, cb_module)) {
-        continue;
-      } 
+  /* Find the cb module so that we can precisely reserve child blocks */
+  vtr::Point<size_t> cb_coord(rr_gsb.get_cb_x(cb_type), rr_gsb.get_cb_y(cb_type));
+  std::string cb_module_name = generate_connection_block_module_name(cb_type, cb_coord);
+  if (true == compact_routing_hierarchy) {
+    vtr::Point<size_t> unique_cb_coord(gsb_coord);
+    /* Note: use GSB coordinate when inquire for unique modules!!! */
+    const RRGSB& unique_mirror = device_rr_gsb.get_cb_unique_module(cb_type, unique_cb_coord);
+    unique_cb_coord.set_x(unique_mirror.get_cb_x(cb_type)); 
+    unique_cb_coord.set_y(unique_mirror.get_cb_y(cb_type)); 
+    cb_module_name = generate_connection_block_module_name(cb_type, unique_cb_coord);
+  } 
+  ModuleId cb_module = module_manager.find_module(cb_module_name);
+  VTR_ASSERT(true == module_manager.valid_module_id(cb_module));
+
+  /* Bypass empty blocks which have none configurable children */
+  if (0 == count_module_manager_module_configurable_children(module_manager, cb_module)) {
+    return;
+  } 
 
-      /* Create a block for the bitstream which corresponds to the Switch block */
-      ConfigBlockId cb_configurable_block = bitstream_manager.add_block(generate_connection_block_module_name(cb_type, cb_coord));
-      /* Set switch block as a child of top block */
-      bitstream_manager.add_child_block(top_configurable_block, cb_configurable_block);
+  /* Create a block for the bitstream which corresponds to the Switch block */
+  ConfigBlockId cb_configurable_block = bitstream_manager.add_block(generate_connection_block_module_name(cb_type, cb_coord));
+  /* Set switch block as a child of top block */
+  bitstream_manager.add_child_block(top_configurable_block, cb_configurable_block);
 
-      /* Reserve child blocks for new created block */
-      bitstream_manager.reserve_child_blocks(cb_configurable_block,
-                                             count_module_manager_module_configurable_children(module_manager, cb_module)); 
-  
-      build_connection_block_bitstream(bitstream_manager, cb_configurable_block, module_manager,  
-                                       circuit_lib, mux_lib,
-                                       atom_ctx, device_annotation, routing_annotation,
-                                       rr_graph,
-                                       rr_gsb, cb_type);
+  /* Reserve child blocks for new created block */
+  bitstream_manager.reserve_child_blocks(cb_configurable_block,
+                                         count_module_manager_module_configurable_children(module_manager, cb_module)); 
+
+  build_connection_block_bitstream(bitstream_manager, cb_configurable_block, module_manager,  
+                                   circuit_lib, mux_lib, mux_default_bitstreams,
+                                   atom_ctx, device_annotation, routing_annotation,
+                                   rr_graph,
+                                   rr_gsb, cb_type,
+                                   is_gsb_used(routing_annotation, gsb_coord));
+}
+
+/********************************************************************
+ * Create bitstream for a Switch Block in a GSB at a given coordinate
+ *******************************************************************/
+static 
+void build_gsb_switch_block_bitstream(BitstreamManager& bitstream_manager,
+                                      const ConfigBlockId& top_configurable_block,
+                                      const ModuleManager& module_manager,
+                                      const CircuitLibrary& circuit_lib,
+                                      const MuxLibrary& mux_lib,
+                                      const vtr::vector<MuxId, std::vector<bool>>& mux_default_bitstreams,
+                                      const AtomContext& atom_ctx,
+                                      const VprDeviceAnnotation& device_annotation,
+                                      const VprRoutingAnnotation& routing_annotation,
+                                      const RRGraph& rr_graph,
+                                      const DeviceRRGSB& device_rr_gsb,
+                                      const bool& compact_routing_hierarchy,
+                                      const vtr::Point<size_t>& gsb_coord) {
+  const RRGSB& rr_gsb = device_rr_gsb.get_gsb(gsb_coord.x(), gsb_coord.y());
+  /* Check if the switch block exists in the device!
+   * Some of them do NOT exist due to heterogeneous blocks (width > 1) 
+   * We will skip those modules
+   */
+  if (false == rr_gsb.is_sb_exist()) {
+    return;
+  }
+
+  vtr::Point<size_t> sb_coord(rr_gsb.get_sb_x(), rr_gsb.get_sb_y());
+
+  /* Find the sb module so that we can precisely reserve child blocks */
+  std::string sb_module_name = generate_switch_block_module_name(sb_coord);
+  if (true == compact_routing_hierarchy) {
+    vtr::Point<size_t> unique_sb_coord(gsb_coord);
+    const RRGSB& unique_mirror = device_rr_gsb.get_sb_unique_module(sb_coord);
+    unique_sb_coord.set_x(unique_mirror.get_sb_x()); 
+    unique_sb_coord.set_y(unique_mirror.get_sb_y()); 
+    sb_module_name = generate_switch_block_module_name(unique_sb_coord);
+  } 
+  ModuleId sb_module = module_manager.find_module(sb_module_name);
+  VTR_ASSERT(true == module_manager.valid_module_id(sb_module));
+
+  /* Bypass empty blocks which have none configurable children */
+  if (0 == count_module_manager_module_configurable_children(module_manager, sb_module)) {
+    return;
+  } 
+
+  /* Create a block for the bitstream which corresponds to the Switch block */
+  ConfigBlockId sb_configurable_block = bitstream_manager.add_block(generate_switch_block_module_name(sb_coord));
+  /* Set switch block as a child of top block */
+  bitstream_manager.add_child_block(top_configurable_block, sb_configurable_block);
+
+  /* Reserve child blocks for new created block */
+  bitstream_manager.reserve_child_blocks(sb_configurable_block,
+                                         count_module_manager_module_configurable_children(module_manager, sb_module)); 
+
+  build_switch_block_bitstream(bitstream_manager, sb_configurable_block, module_manager,  
+                               circuit_lib, mux_lib, mux_default_bitstreams,
+                               atom_ctx, device_annotation, routing_annotation,
+                               rr_graph,
+                               rr_gsb,
+                               is_gsb_used(routing_annotation, gsb_coord));
+}
+
+/********************************************************************
+ * Visit every GSB of the device in the order of x and then y
+ * and build its bitstream with a given builder
+ *
+ * When multiple threads are requested, each GSB is built into 
+ * a local bitstream manager on a worker thread, whose first block
+ * is a placeholder of the top block.
+ * The local bitstreams are then added to the bitstream manager
+ * in the same order as the sequential flow, so that
+ * the block and bit ids are exactly the same as the single-thread flow
+ *******************************************************************/
+static 
+void build_gsb_bitstreams(BitstreamManager& bitstream_manager,
+                          const ConfigBlockId& top_configurable_block,
+                          const DeviceRRGSB& device_rr_gsb,
+                          const size_t& num_threads,
+                          const std::string& phase_name,
+                          const std::function<void(BitstreamManager&, const ConfigBlockId&, const vtr::Point<size_t>&)>& gsb_builder) {
+  vtr::Point<size_t> gsb_range = device_rr_gsb.get_gsb_range();
+  size_t num_gsbs = gsb_range.x() * gsb_range.y();
+
+  ProgressReporter progress(phase_name, num_gsbs);
+
+  if (1 >= num_threads) {
+    for (size_t ix = 0; ix < gsb_range.x(); ++ix) {
+      for (size_t iy = 0; iy < gsb_range.y(); ++iy) {
+        gsb_builder(bitstream_manager, top_configurable_block, vtr::Point<size_t>(ix, iy));
+        progress.advance();
+      }
     }
+    return;
+  }
+
+  std::vector<BitstreamManager> gsb_bitstreams(num_gsbs);
+  parallel_for(num_gsbs, num_threads,
+               [&](const size_t& igsb) {
+                 BitstreamManager& gsb_bitstream = gsb_bitstreams[igsb];
+                 ConfigBlockId sub_top_block = gsb_bitstream.create_block();
+                 gsb_builder(gsb_bitstream, sub_top_block,
+                             vtr::Point<size_t>(igsb / gsb_range.y(), igsb % gsb_range.y()));
+                 progress.advance();
+               });
+
+  for (BitstreamManager& gsb_bitstream : gsb_bitstreams) {
+    bitstream_manager.add_sub_bitstream(top_configurable_block, gsb_bitstream, ConfigBlockId(0));
+    /* Release memory as soon as possible */
+    gsb_bitstream = BitstreamManager();
   }
 }
 
@@ -502,88 +664,139 @@ void build_routing_bitstream(BitstreamManager& bitstream_manager,
                              const VprRoutingAnnotation& routing_annotation,
                              const RRGraph& rr_graph,
                              const DeviceRRGSB& device_rr_gsb,
-                             const bool& compact_routing_hierarchy) {
+                             const bool& compact_routing_hierarchy,
+                             const size_t& num_threads) {
+
+  /* The bitstreams of unused multiplexers are shared by all the routing blocks */
+  vtr::vector<MuxId, std::vector<bool>> mux_default_bitstreams = build_mux_default_bitstreams(circuit_lib, mux_lib);
 
   /* Generate bitstream for each switch blocks
    * To organize the bitstream in blocks, we create a block for each switch block 
    * and give names which are same as they are in top-level module managers
    */
   VTR_LOG("Generating bitstream for Switch blocks...");
-  vtr::Point<size_t> sb_range = device_rr_gsb.get_gsb_range();
-  for (size_t ix = 0; ix < sb_range.x(); ++ix) {
-    for (size_t iy = 0; iy < sb_range.y(); ++iy) {
-      const RRGSB& rr_gsb = device_rr_gsb.get_gsb(ix, iy);
-      /* Check if the switch block exists in the device!
-       * Some of them do NOT exist due to heterogeneous blocks (width > 1) 
-       * We will skip those modules
-       */
-      if (false == rr_gsb.is_sb_exist()) {
-        continue;
-      }
+  build_gsb_bitstreams(bitstream_manager, top_configurable_block, device_rr_gsb, num_threads,
+                       std::string("Generating bitstream for Switch blocks"),
+                       [&](BitstreamManager& gsb_bitstream, const ConfigBlockId& gsb_top_block, const vtr::Point<size_t>& gsb_coord) {
+                         build_gsb_switch_block_bitstream(gsb_bitstream, gsb_top_block, module_manager,
+                                                          circuit_lib, mux_lib, mux_default_bitstreams,
+                                                          atom_ctx, device_annotation, routing_annotation,
+                                                          rr_graph,
+                                                          device_rr_gsb,
+                                                          compact_routing_hierarchy,
+                                                          gsb_coord);
+                       });
+  VTR_LOG("Done\n");
 
-      vtr::Point<size_t> sb_coord(rr_gsb.get_sb_x(), rr_gsb.get_sb_y());
-
-      /* Find the sb module so that we can precisely reserve child blocks */
-      std::string sb_module_name = generate_switch_block_module_name(sb_coord);
-      if (true == compact_routing_hierarchy) {
-        vtr::Point<size_t> unique_sb_coord(ix, iy);
-        const RRGSB& unique_mirror = device_rr_gsb.get_sb_unique_module(sb_coord);
-        unique_sb_coord.set_x(unique_mirror.get_sb_x()); 
-        unique_sb_coord.set_y(unique_mirror.get_sb_y()); 
-        sb_module_name = generate_switch_block_module_name(unique_sb_coord);
-      } 
-      ModuleId sb_module = module_manager.find_module(sb_module_name);
-      VTR_ASSERT(true == module_manager.valid_module_id(sb_module));
-
-      /* Bypass empty blocks which have none configurable children */
-      if (0 == count_module_manager_module_configurable_children(module_manager, sb_module)) {
-        continue;
-      } 
+  /* Generate bitstream for each connection blocks
+   * To organize the bitstream in blocks, we create a block for each connection block 
+   * and give names which are same as they are in top-level module managers
+   */
+  for (const t_rr_type& cb_type : {CHANX, CHANY}) {
+    if (CHANX == cb_type) {
+      VTR_LOG("Generating bitstream for X-direction Connection blocks ...");
+    } else {
+      VTR_LOG("Generating bitstream for Y-direction Connection blocks ...");
+    }
 
-      /* Create a block for the bitstream which corresponds to the Switch block */
-      ConfigBlockId sb_configurable_block = bitstream_manager.add_block(generate_switch_block_module_name(sb_coord));
-      /* Set switch block as a child of top block */
-      bitstream_manager.add_child_block(top_configurable_block, sb_configurable_block);
+    build_gsb_bitstreams(bitstream_manager, top_configurable_block, device_rr_gsb, num_threads,
+                         std::string(CHANX == cb_type ? "Generating bitstream for X-direction Connection blocks" : "Generating bitstream for Y-direction Connection blocks"),
+                         [&](BitstreamManager& gsb_bitstream, const ConfigBlockId& gsb_top_block, const vtr::Point<size_t>& gsb_coord) {
+                           build_gsb_connection_block_bitstream(gsb_bitstream, gsb_top_block, module_manager,
+                                                                circuit_lib, mux_lib, mux_default_bitstreams,
+                                                                atom_ctx, device_annotation, routing_annotation,
+                                                                rr_graph,
+                                                                device_rr_gsb,
+                                                                compact_routing_hierarchy,
+                                                                cb_type,
+                                                                gsb_coord);
+                         });
+    VTR_LOG("Done\n");
+  }
+}
 
-      /* Reserve child blocks for new created block */
-      bitstream_manager.reserve_child_blocks(sb_configurable_block,
-                                             count_module_manager_module_configurable_children(module_manager, sb_module)); 
 
-      build_switch_block_bitstream(bitstream_manager, sb_configurable_block, module_manager,  
-                                   circuit_lib, mux_lib,
-                                   atom_ctx, device_annotation, routing_annotation,
-                                   rr_graph,
-                                   rr_gsb);
+/********************************************************************
+ * Build again the bitstreams of the Switch Blocks and Connection Blocks
+ * of the GSBs which are marked as changed, and overwrite their blocks
+ * in an existing bitstream, which has been built by build_routing_bitstream()
+ * on the same fabric.
+ * The blocks of routing modules are found by their names among the given
+ * child blocks of the top block.
+ * Return the number of bits whose values are changed
+ *******************************************************************/
+size_t update_routing_bitstream(BitstreamManager& bitstream_manager,
+                                const std::map<std::string, ConfigBlockId>& top_child_blocks,
+                                const ModuleManager& module_manager,
+                                const CircuitLibrary& circuit_lib,
+                                const MuxLibrary& mux_lib,
+                                const AtomContext& atom_ctx,
+                                const VprDeviceAnnotation& device_annotation,
+                                const VprRoutingAnnotation& routing_annotation,
+                                const RRGraph& rr_graph,
+                                const DeviceRRGSB& device_rr_gsb,
+                                const bool& compact_routing_hierarchy,
+                                const vtr::Matrix<bool>& changed_gsbs,
+                                const size_t& num_threads) {
+  vtr::Point<size_t> gsb_range = device_rr_gsb.get_gsb_range();
+
+  /* Keep only the GSBs to be updated */
+  std::vector<vtr::Point<size_t>> changed_gsb_coords;
+  for (size_t ix = 0; ix < gsb_range.x(); ++ix) {
+    for (size_t iy = 0; iy < gsb_range.y(); ++iy) {
+      if (true == changed_gsbs[ix][iy]) {
+        changed_gsb_coords.push_back(vtr::Point<size_t>(ix, iy));
+      }
     }
   }
-  VTR_LOG("Done\n");
 
-  /* Generate bitstream for each connection blocks
-   * To organize the bitstream in blocks, we create a block for each connection block 
-   * and give names which are same as they are in top-level module managers
-   */
-  VTR_LOG("Generating bitstream for X-direction Connection blocks ...");
-
-  build_connection_block_bitstreams(bitstream_manager, top_configurable_block, module_manager,  
-                                    circuit_lib, mux_lib,
-                                    atom_ctx, device_annotation, routing_annotation,
-                                    rr_graph,
-                                    device_rr_gsb,
-                                    compact_routing_hierarchy,
-                                    CHANX);
-  VTR_LOG("Done\n");
+  VTR_LOG("Updating bitstream for routing blocks of %lu out of %lu GSBs...",
+          changed_gsb_coords.size(), gsb_range.x() * gsb_range.y());
 
-  VTR_LOG("Generating bitstream for Y-direction Connection blocks ...");
+  /* The bitstreams of unused multiplexers are shared by all the routing blocks */
+  vtr::vector<MuxId, std::vector<bool>> mux_default_bitstreams = build_mux_default_bitstreams(circuit_lib, mux_lib);
 
-  build_connection_block_bitstreams(bitstream_manager, top_configurable_block, module_manager,  
-                                    circuit_lib, mux_lib,
-                                    atom_ctx, device_annotation, routing_annotation,
-                                    rr_graph,
-                                    device_rr_gsb,
-                                    compact_routing_hierarchy,
-                                    CHANY);
+  /* Each GSB has its own bitstream manager, whose first block is a placeholder of the top block,
+   * which includes the Switch Block and both Connection Blocks
+   */
+  std::vector<BitstreamManager> gsb_bitstreams(changed_gsb_coords.size());
+  parallel_for(changed_gsb_coords.size(), num_threads,
+               [&](const size_t& igsb) {
+                 BitstreamManager& gsb_bitstream = gsb_bitstreams[igsb];
+                 ConfigBlockId sub_top_block = gsb_bitstream.create_block();
+                 build_gsb_switch_block_bitstream(gsb_bitstream, sub_top_block, module_manager,
+                                                  circuit_lib, mux_lib, mux_default_bitstreams,
+                                                  atom_ctx, device_annotation, routing_annotation,
+                                                  rr_graph,
+                                                  device_rr_gsb,
+                                                  compact_routing_hierarchy,
+                                                  changed_gsb_coords[igsb]);
+                 for (const t_rr_type& cb_type : {CHANX, CHANY}) {
+                   build_gsb_connection_block_bitstream(gsb_bitstream, sub_top_block, module_manager,
+                                                        circuit_lib, mux_lib, mux_default_bitstreams,
+                                                        atom_ctx, device_annotation, routing_annotation,
+                                                        rr_graph,
+                                                        device_rr_gsb,
+                                                        compact_routing_hierarchy,
+                                                        cb_type,
+                                                        changed_gsb_coords[igsb]);
+                 }
+               });
+
+  /* Overwrite the routing blocks in a fixed order */
+  size_t num_changed_bits = 0;
+  for (BitstreamManager& gsb_bitstream : gsb_bitstreams) {
+    for (const ConfigBlockId& routing_block : gsb_bitstream.block_children(ConfigBlockId(0))) {
+      auto result = top_child_blocks.find(gsb_bitstream.block_name(routing_block));
+      VTR_ASSERT(result != top_child_blocks.end());
+      num_changed_bits += bitstream_manager.overwrite_block_bitstream(result->second, gsb_bitstream, routing_block);
+    }
+    /* Release memory as soon as possible */
+    gsb_bitstream = BitstreamManager();
+  }
   VTR_LOG("Done\n");
 
+  return num_changed_bits;
 }
 
 } /* end namespace openfpga */
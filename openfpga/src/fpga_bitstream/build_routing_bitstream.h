@@ -7,7 +7,10 @@
 /********************************************************************
  * Include header files that are required by function declaration
  *******************************************************************/
+#include <map>
+#include <string>
 #include <vector>
+#include "vtr_ndmatrix.h"
 #include "bitstream_manager.h"
 #include "vpr_context.h"
 #include "module_manager.h"
@@ -34,7 +37,22 @@ void build_routing_bitstream(BitstreamManager& bitstream_manager,
                              const VprRoutingAnnotation& routing_annotation,
                              const RRGraph& rr_graph,
                              const DeviceRRGSB& device_rr_gsb,
-                             const bool& compact_routing_hierarchy);
+                             const bool& compact_routing_hierarchy,
+                             const size_t& num_threads);
+
+size_t update_routing_bitstream(BitstreamManager& bitstream_manager,
+                                const std::map<std::string, ConfigBlockId>& top_child_blocks,
+                                const ModuleManager& module_manager,
+                                const CircuitLibrary& circuit_lib,
+                                const MuxLibrary& mux_lib,
+                                const AtomContext& atom_ctx,
+                                const VprDeviceAnnotation& device_annotation,
+                                const VprRoutingAnnotation& routing_annotation,
+                                const RRGraph& rr_graph,
+                                const DeviceRRGSB& device_rr_gsb,
+                                const bool& compact_routing_hierarchy,
+                                const vtr::Matrix<bool>& changed_gsbs,
+                                const size_t& num_threads);
 
 } /* end namespace openfpga */
 
@@ -0,0 +1,97 @@
+/******************************************************************************
+ * This file includes member functions for data structure ConfigChainFabricBitstream
+ ******************************************************************************/
+#include <algorithm>
+
+#include "vtr_assert.h"
+#include "config_chain_fabric_bitstream.h"
+
+/* begin namespace openfpga */
+namespace openfpga {
+
+/**************************************************
+ * Public Constructor
+ *************************************************/
+ConfigChainFabricBitstream::ConfigChainFabricBitstream(const BitstreamManager& bitstream_manager,
+                                                       const FabricBitstream& fabric_bitstream)
+  : ConfigChainFabricBitstream(bitstream_manager,
+                               fabric_bitstream,
+                               std::vector<size_t>(fabric_bitstream.num_regions(), 0),
+                               false) {
+}
+
+ConfigChainFabricBitstream::ConfigChainFabricBitstream(const BitstreamManager& bitstream_manager,
+                                                       const FabricBitstream& fabric_bitstream,
+                                                       const std::vector<size_t>& regional_num_bits_to_skip,
+                                                       const bool& padding_value)
+  : bitstream_manager_(bitstream_manager),
+    fabric_bitstream_(fabric_bitstream),
+    region_skips_(regional_num_bits_to_skip),
+    padding_value_(padding_value) {
+  VTR_ASSERT(region_skips_.size() == fabric_bitstream_.num_regions());
+
+  /* Find the longest bitstream after skipping */
+  num_cycles_ = 0;
+  for (const FabricBitRegionId& region : fabric_bitstream_.regions()) {
+    VTR_ASSERT(region_skips_[size_t(region)] <= fabric_bitstream_.region_bits(region).size());
+    num_cycles_ = std::max(num_cycles_, fabric_bitstream_.region_bits(region).size() - region_skips_[size_t(region)]);
+  }
+
+  /* Shorter bitstreams start after the padding bits */
+  region_offsets_.reserve(fabric_bitstream_.num_regions());
+  for (const FabricBitRegionId& region : fabric_bitstream_.regions()) {
+    region_offsets_.push_back(num_cycles_ - (fabric_bitstream_.region_bits(region).size() - region_skips_[size_t(region)]));
+  }
+}
+
+/**************************************************
+ * Public Accessors
+ *************************************************/
+size_t ConfigChainFabricBitstream::num_cycles() const {
+  return num_cycles_;
+}
+
+size_t ConfigChainFabricBitstream::num_regions() const {
+  return region_offsets_.size();
+}
+
+bool ConfigChainFabricBitstream::bit_value(const size_t& cycle, const size_t& region) const {
+  VTR_ASSERT(cycle < num_cycles_);
+  VTR_ASSERT(region < region_offsets_.size());
+
+  if (cycle < region_offsets_[region]) {
+    return padding_value_;
+  }
+
+  const FabricBitId& bit_id = fabric_bitstream_.region_bits(FabricBitRegionId(region))[cycle - region_offsets_[region] + region_skips_[region]];
+  return bitstream_manager_.bit_value(fabric_bitstream_.config_bit(bit_id));
+}
+
+std::vector<size_t> ConfigChainFabricBitstream::run_lengths(const size_t& max_run_length) const {
+  VTR_ASSERT(0 < max_run_length);
+
+  std::vector<size_t> lengths;
+  size_t run_start = 0;
+  while (run_start < num_cycles_) {
+    size_t run_end = run_start + 1;
+    while ((run_end < num_cycles_) && (run_end - run_start < max_run_length)) {
+      bool same_bits = true;
+      for (size_t iregion = 0; iregion < num_regions(); ++iregion) {
+        if (bit_value(run_end, iregion) != bit_value(run_start, iregion)) {
+          same_bits = false;
+          break;
+        }
+      }
+      if (false == same_bits) {
+        break;
+      }
+      run_end++;
+    }
+    lengths.push_back(run_end - run_start);
+    run_start = run_end;
+  }
+
+  return lengths;
+}
+
+} /* end namespace openfpga */
@@ -0,0 +1,100 @@
+/******************************************************************************
+ * This file introduces a data structure to view a fabric-dependent bitstream
+ * as it is loaded to configuration chains (either single-head or multi-bit)
+ *
+ * General concept
+ * ---------------
+ * The bitstreams of all the regions are aligned to the longest one,
+ * and loaded in parallel, one bit of each region per clock cycle:
+ *
+ *   Region 0: 000000001111101010 <- max. bitstream length
+ *   Region 1:     00000011010101 <- shorter bitstream than the max.; zeros at the head
+ *   Region 2:   0010101111000110 <- shorter bitstream than the max.; zeros at the head
+ *
+ * For fast configuration, the leading bits of each region, which are the same
+ * as the configuration memories after reset, can be skipped region by region.
+ * The remaining bits are aligned to the longest remaining bitstream,
+ * and the padding bits are the skipped value:
+ *
+ *   Region 0:   00000000|    1111101010 -> 4 padding bits
+ *   Region 1:       000000|      11010101 -> 6 padding bits
+ *   Region 2:           00|10101111000110 -> 14 cycles, limited by region 2
+ *
+ * The padding bits of a region are shifted into its skipped tail,
+ * so the chain contents are the same as loading the full bitstream
+ *
+ * For run-length compression, the clock cycles can be split into runs,
+ * where the bits of all the regions stay the same:
+ *
+ *   Region 0: 000|11|0
+ *   Region 1: 111|00|0 -> 3 runs of 3, 2 and 1 clock cycles
+ *
+ * The bit values are read from the fabric bitstream and the bitstream manager
+ * on request, so that no copy of the bitstream is created
+ * The view is valid as long as the fabric bitstream and the bitstream manager are alive
+ *
+ * Typical usage:
+ *   ConfigChainFabricBitstream regional_bitstreams(bitstream_manager, fabric_bitstream);
+ *   for (size_t icycle = 0; icycle < regional_bitstreams.num_cycles(); ++icycle) {
+ *     for (size_t iregion = 0; iregion < regional_bitstreams.num_regions(); ++iregion) {
+ *       regional_bitstreams.bit_value(icycle, iregion);
+ *     }
+ *   }
+ *
+ ******************************************************************************/
+#ifndef CONFIG_CHAIN_FABRIC_BITSTREAM_H
+#define CONFIG_CHAIN_FABRIC_BITSTREAM_H
+
+#include <vector>
+#include "bitstream_manager.h"
+#include "fabric_bitstream.h"
+
+/* begin namespace openfpga */
+namespace openfpga {
+
+class ConfigChainFabricBitstream {
+  public: /* Public constructor */
+    ConfigChainFabricBitstream(const BitstreamManager& bitstream_manager,
+                               const FabricBitstream& fabric_bitstream);
+
+    /* Skip a number of bits at the head of each regional bitstream,
+     * and fill the padding bits with a given value
+     */
+    ConfigChainFabricBitstream(const BitstreamManager& bitstream_manager,
+                               const FabricBitstream& fabric_bitstream,
+                               const std::vector<size_t>& regional_num_bits_to_skip,
+                               const bool& padding_value);
+
+  public:  /* Public Accessors */
+    /* Number of clock cycles to load the bitstream, i.e., the longest regional bitstream size after skipping */
+    size_t num_cycles() const;
+    size_t num_regions() const;
+
+    /* Find the value of the bit to be loaded to a region in a clock cycle
+     * Padding bits at the head of shorter regional bitstreams are the padding value,
+     * which is logic '0' by default
+     */
+    bool bit_value(const size_t& cycle, const size_t& region) const;
+
+    /* Split the clock cycles into runs, where the bit values of all the regions
+     * are the same as the first cycle of the run.
+     * Each run has at most max_run_length clock cycles
+     * Return the number of clock cycles of each run, whose sum is the number of clock cycles
+     */
+    std::vector<size_t> run_lengths(const size_t& max_run_length) const;
+
+  private: /* Internal data */
+    const BitstreamManager& bitstream_manager_;
+    const FabricBitstream& fabric_bitstream_;
+
+    size_t num_cycles_;
+    /* Number of padding bits at the head of each regional bitstream */
+    std::vector<size_t> region_offsets_;
+    /* Number of bits skipped at the head of each regional bitstream */
+    std::vector<size_t> region_skips_;
+    bool padding_value_;
+};
+
+} /* end namespace openfpga */
+
+#endif
@@ -5,11 +5,53 @@
 
 #include "vtr_assert.h"
 #include "openfpga_decode.h"
+#include "openfpga_memory_usage.h"
 #include "fabric_bitstream.h"
 
 /* begin namespace openfpga */
 namespace openfpga {
 
+/**************************************************
+ * Member functions of FabricBitAddressView
+ *************************************************/
+FabricBitAddressView::FabricBitAddressView(const std::vector<bool>& arena,
+                                           const size_t& offset,
+                                           const size_t& length)
+  : arena_(arena)
+  , offset_(offset)
+  , length_(length) {
+  VTR_ASSERT(offset_ + 2 * length_ <= arena_.size());
+}
+
+size_t FabricBitAddressView::size() const {
+  return length_;
+}
+
+char FabricBitAddressView::operator[](const size_t& index) const {
+  VTR_ASSERT_SAFE(index < length_);
+  /* Each address bit is encoded as (value, don't care) */
+  if (true == arena_[offset_ + 2 * index + 1]) {
+    return DONT_CARE_CHAR;
+  }
+  return arena_[offset_ + 2 * index] ? '1' : '0';
+}
+
+FabricBitAddressView::const_iterator FabricBitAddressView::begin() const {
+  return const_iterator(*this, 0);
+}
+
+FabricBitAddressView::const_iterator FabricBitAddressView::end() const {
+  return const_iterator(*this, length_);
+}
+
+std::string FabricBitAddressView::to_string() const {
+  std::string addr_str(length_, '0');
+  for (size_t i = 0; i < length_; ++i) {
+    addr_str[i] = (*this)[i];
+  }
+  return addr_str;
+}
+
 /**************************************************
  * Public Constructor
  *************************************************/
@@ -18,6 +60,7 @@ FabricBitstream::FabricBitstream() {
   invalid_bit_ids_.clear();
   address_length_ = 0;
   wl_address_length_ = 0;
+  data_width_ = 1;
 
   num_regions_ = 0;
   invalid_region_ids_.clear();
@@ -49,7 +92,7 @@ FabricBitstream::fabric_bit_region_range FabricBitstream::regions() const {
                          fabric_bit_region_iterator(FabricBitRegionId(num_regions_), invalid_region_ids_));
 }
 
-std::vector<FabricBitId> FabricBitstream::region_bits(const FabricBitRegionId& region_id) const {
+const std::vector<FabricBitId>& FabricBitstream::region_bits(const FabricBitRegionId& region_id) const {
   /* Ensure a valid id */
   VTR_ASSERT(true == valid_region_id(region_id));
 
@@ -66,25 +109,25 @@ ConfigBitId FabricBitstream::config_bit(const FabricBitId& bit_id) const {
   return config_bit_ids_[bit_id];
 }
 
-std::vector<char> FabricBitstream::bit_address(const FabricBitId& bit_id) const {
+FabricBitAddressView FabricBitstream::bit_address(const FabricBitId& bit_id) const {
   /* Ensure a valid id */
   VTR_ASSERT(true == valid_bit_id(bit_id));
   VTR_ASSERT(true == use_address_);
 
-  return bit_addresses_[bit_id];
+  return FabricBitAddressView(bit_addresses_, size_t(bit_id) * 2 * address_length_, address_length_);
 }
 
-std::vector<char> FabricBitstream::bit_bl_address(const FabricBitId& bit_id) const {
+FabricBitAddressView FabricBitstream::bit_bl_address(const FabricBitId& bit_id) const {
   return bit_address(bit_id);
 }
 
-std::vector<char> FabricBitstream::bit_wl_address(const FabricBitId& bit_id) const {
+FabricBitAddressView FabricBitstream::bit_wl_address(const FabricBitId& bit_id) const {
   /* Ensure a valid id */
   VTR_ASSERT(true == valid_bit_id(bit_id));
   VTR_ASSERT(true == use_address_);
   VTR_ASSERT(true == use_wl_address_);
 
-  return bit_wl_addresses_[bit_id];
+  return FabricBitAddressView(bit_wl_addresses_, size_t(bit_id) * 2 * wl_address_length_, wl_address_length_);
 }
 
 char FabricBitstream::bit_din(const FabricBitId& bit_id) const {
@@ -95,6 +138,21 @@ char FabricBitstream::bit_din(const FabricBitId& bit_id) const {
   return bit_dins_[bit_id];
 }
 
+size_t FabricBitstream::bit_din_index(const FabricBitId& bit_id) const {
+  /* Ensure a valid id */
+  VTR_ASSERT(true == valid_bit_id(bit_id));
+  VTR_ASSERT(true == use_address_);
+
+  if (1 == data_width_) {
+    return 0;
+  }
+  return bit_din_indices_[bit_id];
+}
+
+size_t FabricBitstream::data_width() const {
+  return data_width_;
+}
+
 bool FabricBitstream::use_address() const {
   return use_address_;
 }
@@ -103,6 +161,17 @@ bool FabricBitstream::use_wl_address() const {
   return use_wl_address_;
 }
 
+size_t FabricBitstream::memory_usage() const {
+  return openfpga::memory_usage(invalid_region_ids_)
+       + openfpga::memory_usage(region_bit_ids_)
+       + openfpga::memory_usage(invalid_bit_ids_)
+       + openfpga::memory_usage(config_bit_ids_)
+       + openfpga::memory_usage(bit_addresses_)
+       + openfpga::memory_usage(bit_wl_addresses_)
+       + openfpga::memory_usage(bit_dins_)
+       + openfpga::memory_usage(bit_din_indices_);
+}
+
 /******************************************************************************
  * Public Mutators
  ******************************************************************************/
@@ -110,11 +179,14 @@ void FabricBitstream::reserve_bits(const size_t& num_bits) {
   config_bit_ids_.reserve(num_bits);
  
   if (true == use_address_) {
-    bit_addresses_.reserve(num_bits);
+    bit_addresses_.reserve(num_bits * 2 * address_length_);
     bit_dins_.reserve(num_bits);
+    if (1 < data_width_) {
+      bit_din_indices_.reserve(num_bits);
+    }
  
     if (true == use_wl_address_) {
-      bit_wl_addresses_.reserve(num_bits);
+      bit_wl_addresses_.reserve(num_bits * 2 * wl_address_length_);
     }
   }
 }
@@ -126,11 +198,14 @@ FabricBitId FabricBitstream::add_bit(const ConfigBitId& config_bit_id) {
   config_bit_ids_.push_back(config_bit_id);
 
   if (true == use_address_) {
-    bit_addresses_.emplace_back();
+    bit_addresses_.resize(bit_addresses_.size() + 2 * address_length_, false);
     bit_dins_.emplace_back();
+    if (1 < data_width_) {
+      bit_din_indices_.push_back(0);
+    }
  
     if (true == use_wl_address_) {
-      bit_wl_addresses_.emplace_back();
+      bit_wl_addresses_.resize(bit_wl_addresses_.size() + 2 * wl_address_length_, false);
     }
   }
 
@@ -143,7 +218,7 @@ void FabricBitstream::set_bit_address(const FabricBitId& bit_id,
   VTR_ASSERT(true == valid_bit_id(bit_id));
   VTR_ASSERT(true == use_address_);
   VTR_ASSERT(address_length_ == address.size());
-  bit_addresses_[bit_id] = address;
+  set_arena_address(bit_addresses_, size_t(bit_id) * 2 * address_length_, address);
 }
 
 void FabricBitstream::set_bit_bl_address(const FabricBitId& bit_id,
@@ -157,7 +232,22 @@ void FabricBitstream::set_bit_wl_address(const FabricBitId& bit_id,
   VTR_ASSERT(true == use_address_);
   VTR_ASSERT(true == use_wl_address_);
   VTR_ASSERT(wl_address_length_ == address.size());
-  bit_wl_addresses_[bit_id] = address;
+  set_arena_address(bit_wl_addresses_, size_t(bit_id) * 2 * wl_address_length_, address);
+}
+
+void FabricBitstream::set_bit_bl_address(const FabricBitId& bit_id,
+                                         const size_t& address) {
+  VTR_ASSERT(true == valid_bit_id(bit_id));
+  VTR_ASSERT(true == use_address_);
+  set_arena_address(bit_addresses_, size_t(bit_id) * 2 * address_length_, address_length_, address);
+}
+
+void FabricBitstream::set_bit_wl_address(const FabricBitId& bit_id,
+                                         const size_t& address) {
+  VTR_ASSERT(true == valid_bit_id(bit_id));
+  VTR_ASSERT(true == use_address_);
+  VTR_ASSERT(true == use_wl_address_);
+  set_arena_address(bit_wl_addresses_, size_t(bit_id) * 2 * wl_address_length_, wl_address_length_, address);
 }
 
 void FabricBitstream::set_bit_din(const FabricBitId& bit_id,
@@ -167,6 +257,16 @@ void FabricBitstream::set_bit_din(const FabricBitId& bit_id,
   bit_dins_[bit_id] = din;
 }
 
+void FabricBitstream::set_bit_din_index(const FabricBitId& bit_id,
+                                        const size_t& din_index) {
+  VTR_ASSERT(true == valid_bit_id(bit_id));
+  VTR_ASSERT(true == use_address_);
+  VTR_ASSERT(din_index < data_width_);
+  if (1 < data_width_) {
+    bit_din_indices_[bit_id] = din_index;
+  }
+}
+
 void FabricBitstream::set_use_address(const bool& enable) {
   /* Add a lock, only can be modified when num bits are zero*/
   if (0 == num_bits_) {
@@ -175,7 +275,8 @@ void FabricBitstream::set_use_address(const bool& enable) {
 }
 
 void FabricBitstream::set_address_length(const size_t& length) {
-  if (true == use_address_) {
+  /* Add a lock, only can be modified when num bits are zero, as it is the stride of address arena */
+  if ((true == use_address_) && (0 == num_bits_)) {
     address_length_ = length; 
   }
 }
@@ -192,11 +293,20 @@ void FabricBitstream::set_use_wl_address(const bool& enable) {
 }
 
 void FabricBitstream::set_wl_address_length(const size_t& length) {
-  if (true == use_address_) {
+  /* Add a lock, only can be modified when num bits are zero, as it is the stride of address arena */
+  if ((true == use_address_) && (0 == num_bits_)) {
     wl_address_length_ = length; 
   }
 }
 
+void FabricBitstream::set_data_width(const size_t& width) {
+  /* Add a lock, only can be modified when num bits are zero, as it decides the allocation of data input indices */
+  VTR_ASSERT(0 < width);
+  if ((true == use_address_) && (0 == num_bits_)) {
+    data_width_ = width;
+  }
+}
+
 void FabricBitstream::reserve_regions(const size_t& num_regions) {
   region_bit_ids_.reserve(num_regions);
 }
@@ -210,6 +320,13 @@ FabricBitRegionId FabricBitstream::add_region() {
   return region; 
 }
 
+void FabricBitstream::reserve_region_bits(const FabricBitRegionId& region_id,
+                                          const size_t& num_bits) {
+  VTR_ASSERT(true == valid_region_id(region_id));
+
+  region_bit_ids_[region_id].reserve(num_bits);
+}
+
 void FabricBitstream::add_bit_to_region(const FabricBitRegionId& region_id,
                                         const FabricBitId& bit_id) {
   VTR_ASSERT(true == valid_region_id(region_id));
@@ -222,11 +339,12 @@ void FabricBitstream::reverse() {
   std::reverse(config_bit_ids_.begin(), config_bit_ids_.end());
 
   if (true == use_address_) {
-    std::reverse(bit_addresses_.begin(), bit_addresses_.end());
+    reverse_arena(bit_addresses_, 2 * address_length_);
     std::reverse(bit_dins_.begin(), bit_dins_.end());
+    std::reverse(bit_din_indices_.begin(), bit_din_indices_.end());
 
     if (true == use_wl_address_) {
-      std::reverse(bit_wl_addresses_.begin(), bit_wl_addresses_.end());
+      reverse_arena(bit_wl_addresses_, 2 * wl_address_length_);
     }
   }
 }
@@ -237,6 +355,87 @@ void FabricBitstream::reverse_region_bits(const FabricBitRegionId& region_id) {
   std::reverse(region_bit_ids_[region_id].begin(), region_bit_ids_[region_id].end());
 }
 
+void FabricBitstream::add_sub_bitstream(const FabricBitstream& sub_bitstream) {
+  VTR_ASSERT(use_address_ == sub_bitstream.use_address_);
+  VTR_ASSERT(use_wl_address_ == sub_bitstream.use_wl_address_);
+  VTR_ASSERT(address_length_ == sub_bitstream.address_length_);
+  VTR_ASSERT(wl_address_length_ == sub_bitstream.wl_address_length_);
+  VTR_ASSERT(data_width_ == sub_bitstream.data_width_);
+
+  /* Bits are appended in their original order, so the ids of bits are simply shifted */
+  size_t bit_id_offset = num_bits_;
+  for (const FabricBitRegionId& sub_region : sub_bitstream.regions()) {
+    FabricBitRegionId region = add_region();
+    region_bit_ids_[region].reserve(sub_bitstream.region_bit_ids_[sub_region].size());
+    for (const FabricBitId& sub_bit : sub_bitstream.region_bit_ids_[sub_region]) {
+      region_bit_ids_[region].push_back(FabricBitId(size_t(sub_bit) + bit_id_offset));
+    }
+  }
+
+  num_bits_ += sub_bitstream.num_bits_;
+  config_bit_ids_.insert(config_bit_ids_.end(), sub_bitstream.config_bit_ids_.begin(), sub_bitstream.config_bit_ids_.end());
+  bit_addresses_.insert(bit_addresses_.end(), sub_bitstream.bit_addresses_.begin(), sub_bitstream.bit_addresses_.end());
+  bit_wl_addresses_.insert(bit_wl_addresses_.end(), sub_bitstream.bit_wl_addresses_.begin(), sub_bitstream.bit_wl_addresses_.end());
+  bit_dins_.insert(bit_dins_.end(), sub_bitstream.bit_dins_.begin(), sub_bitstream.bit_dins_.end());
+  bit_din_indices_.insert(bit_din_indices_.end(), sub_bitstream.bit_din_indices_.begin(), sub_bitstream.bit_din_indices_.end());
+}
+
+void FabricBitstream::shrink_to_fit() {
+  for (std::vector<FabricBitId>& region_bits : region_bit_ids_) {
+    region_bits.shrink_to_fit();
+  }
+  region_bit_ids_.shrink_to_fit();
+  config_bit_ids_.shrink_to_fit();
+  bit_addresses_.shrink_to_fit();
+  bit_wl_addresses_.shrink_to_fit();
+  bit_dins_.shrink_to_fit();
+  bit_din_indices_.shrink_to_fit();
+}
+
+/******************************************************************************
+ * Private mutators
+ ******************************************************************************/
+void FabricBitstream::set_arena_address(std::vector<bool>& arena,
+                                        const size_t& offset,
+                                        const std::vector<char>& address) {
+  for (size_t i = 0; i < address.size(); ++i) {
+    VTR_ASSERT(('0' == address[i]) || ('1' == address[i]) || (DONT_CARE_CHAR == address[i]));
+    arena[offset + 2 * i] = ('1' == address[i]);
+    arena[offset + 2 * i + 1] = (DONT_CARE_CHAR == address[i]);
+  }
+}
+
+/* Encode an integer address, where the i-th bit of the integer is the i-th address bit */
+void FabricBitstream::set_arena_address(std::vector<bool>& arena,
+                                        const size_t& offset,
+                                        const size_t& length,
+                                        const size_t& address) {
+  /* Make sure we do not have any overflow! */
+  VTR_ASSERT((length >= 8 * sizeof(size_t)) || (address < (size_t(1) << length)));
+  for (size_t i = 0; i < length; ++i) {
+    arena[offset + 2 * i] = (i < 8 * sizeof(size_t)) && (1 == ((address >> i) & 1));
+    arena[offset + 2 * i + 1] = false;
+  }
+}
+
+/* Reverse the sequence of addresses in the arena, while keeping the bit order inside each address */
+void FabricBitstream::reverse_arena(std::vector<bool>& arena,
+                                    const size_t& stride) {
+  if (0 == stride) {
+    return;
+  }
+  size_t num_addresses = arena.size() / stride;
+  for (size_t iaddr = 0; iaddr < num_addresses / 2; ++iaddr) {
+    size_t head = iaddr * stride;
+    size_t tail = (num_addresses - 1 - iaddr) * stride;
+    for (size_t ibit = 0; ibit < stride; ++ibit) {
+      bool head_bit = arena[head + ibit];
+      arena[head + ibit] = arena[tail + ibit];
+      arena[tail + ibit] = head_bit;
+    }
+  }
+}
+
 /******************************************************************************
  * Public Validators
  ******************************************************************************/
@@ -29,9 +29,11 @@
 #define FABRIC_BITSTREAM_H
 
 #include <vector>
-#include <unordered_set>
+#include <string>
+#include <iterator>
 #include <unordered_map>
 #include "vtr_vector.h"
+#include "vtr_lazy_id_iterator.h"
 
 #include "bitstream_manager_fwd.h"
 #include "fabric_bitstream_fwd.h"
@@ -39,61 +41,59 @@
 /* begin namespace openfpga */
 namespace openfpga {
 
-class FabricBitstream {
+/******************************************************************************
+ * A lightweight read-only view on the address of a configuration bit
+ * which is stored in the packed address arena of FabricBitstream
+ * Each address bit is decoded to a character '0', '1' or 'x' (don't care)
+ * The view is valid as long as the fabric bitstream is not modified
+ ******************************************************************************/
+class FabricBitAddressView {
   public: /* Type implementations */
-    /*
-     * This class (forward delcared above) is a template used to represent a lazily calculated 
-     * iterator of the specified ID type. The key assumption made is that the ID space is 
-     * contiguous and can be walked by incrementing the underlying ID value. To account for 
-     * invalid IDs, it keeps a reference to the invalid ID set and returns ID::INVALID() for
-     * ID values in the set.
-     *
-     * It is used to lazily create an iteration range (e.g. as returned by RRGraph::edges() RRGraph::nodes())
-     * just based on the count of allocated elements (i.e. RRGraph::num_nodes_ or RRGraph::num_edges_),
-     * and the set of any invalid IDs (i.e. RRGraph::invalid_node_ids_, RRGraph::invalid_edge_ids_).
-     */
-    template<class ID>
-    class lazy_id_iterator : public std::iterator<std::bidirectional_iterator_tag, ID> {
+    class const_iterator : public std::iterator<std::forward_iterator_tag, char> {
       public:
-        //Since we pass ID as a template to std::iterator we need to use an explicit 'typename'
-        //to bring the value_type and iterator names into scope
-        typedef typename std::iterator<std::bidirectional_iterator_tag, ID>::value_type value_type;
-        typedef typename std::iterator<std::bidirectional_iterator_tag, ID>::iterator iterator;
-
-        lazy_id_iterator(value_type init, const std::unordered_set<ID>& invalid_ids)
-            : value_(init)
-            , invalid_ids_(invalid_ids) {}
-
-        //Advance to the next ID value
-        iterator operator++() {
-            value_ = ID(size_t(value_) + 1);
-            return *this;
-        }
+        const_iterator(const FabricBitAddressView& view, const size_t& index)
+            : view_(view)
+            , index_(index) {}
 
-        //Advance to the previous ID value
-        iterator operator--() {
-            value_ = ID(size_t(value_) - 1);
+        const_iterator& operator++() {
+            ++index_;
             return *this;
         }
 
-        //Dereference the iterator
-        value_type operator*() const { return (invalid_ids_.count(value_)) ? ID::INVALID() : value_; }
+        char operator*() const { return view_[index_]; }
 
-        friend bool operator==(const lazy_id_iterator<ID> lhs, const lazy_id_iterator<ID> rhs) { return lhs.value_ == rhs.value_; }
-        friend bool operator!=(const lazy_id_iterator<ID> lhs, const lazy_id_iterator<ID> rhs) { return !(lhs == rhs); }
+        friend bool operator==(const const_iterator& lhs, const const_iterator& rhs) { return lhs.index_ == rhs.index_; }
+        friend bool operator!=(const const_iterator& lhs, const const_iterator& rhs) { return !(lhs == rhs); }
 
       private:
-        value_type value_;
-        const std::unordered_set<ID>& invalid_ids_;
+        const FabricBitAddressView& view_;
+        size_t index_;
     };
 
-  public: /* Types and ranges */
-    //Lazy iterator utility forward declaration
-    template<class ID>
-    class lazy_id_iterator;
+  public: /* Public constructor */
+    FabricBitAddressView(const std::vector<bool>& arena,
+                         const size_t& offset,
+                         const size_t& length);
+
+  public: /* Public accessors */
+    size_t size() const;
+    char operator[](const size_t& index) const;
+    const_iterator begin() const;
+    const_iterator end() const;
 
-    typedef lazy_id_iterator<FabricBitId> fabric_bit_iterator;
-    typedef lazy_id_iterator<FabricBitRegionId> fabric_bit_region_iterator;
+    /* Convert the address to a string, e.g., "01x0" */
+    std::string to_string() const;
+
+  private: /* Internal data */
+    const std::vector<bool>& arena_;
+    size_t offset_;
+    size_t length_;
+};
+
+class FabricBitstream {
+  public: /* Types and ranges */
+    typedef vtr::lazy_id_iterator<FabricBitId> fabric_bit_iterator;
+    typedef vtr::lazy_id_iterator<FabricBitRegionId> fabric_bit_region_iterator;
 
     typedef vtr::Range<fabric_bit_iterator> fabric_bit_range;
     typedef vtr::Range<fabric_bit_region_iterator> fabric_bit_region_range;
@@ -109,24 +109,37 @@ class FabricBitstream {
     /* Find all the configuration regions */
     size_t num_regions() const;
     fabric_bit_region_range regions() const;
-    std::vector<FabricBitId> region_bits(const FabricBitRegionId& region_id) const;
+    const std::vector<FabricBitId>& region_bits(const FabricBitRegionId& region_id) const;
 
   public:  /* Public Accessors */
     /* Find the configuration bit id in architecture bitstream database */
     ConfigBitId config_bit(const FabricBitId& bit_id) const;
 
     /* Find the address of bitstream */
-    std::vector<char> bit_address(const FabricBitId& bit_id) const;
-    std::vector<char> bit_bl_address(const FabricBitId& bit_id) const;
-    std::vector<char> bit_wl_address(const FabricBitId& bit_id) const;
+    FabricBitAddressView bit_address(const FabricBitId& bit_id) const;
+    FabricBitAddressView bit_bl_address(const FabricBitId& bit_id) const;
+    FabricBitAddressView bit_wl_address(const FabricBitId& bit_id) const;
 
     /* Find the data-in of bitstream */
     char bit_din(const FabricBitId& bit_id) const;
 
+    /* Find the index of the data input which loads the bit,
+     * among the data inputs sharing the same address of a region
+     */
+    size_t bit_din_index(const FabricBitId& bit_id) const;
+
+    /* Number of data inputs sharing the same address in each region,
+     * i.e., the number of bits loaded per frame for frame-based protocol
+     */
+    size_t data_width() const;
+
     /* Check if address data is accessible or not*/
     bool use_address() const;
     bool use_wl_address() const;
 
+    /* Estimate the heap memory (in bytes) held by the bitstream database */
+    size_t memory_usage() const;
+
   public:  /* Public Mutators */
     /* Reserve config bits */
     void reserve_bits(const size_t& num_bits);
@@ -143,21 +156,44 @@ class FabricBitstream {
     void set_bit_wl_address(const FabricBitId& bit_id,
                             const std::vector<char>& address);
 
+    /* Set the BL/WL addresses of a bit from integers
+     * The i-th address bit is the i-th bit of the integer, the same as itobin_charvec()
+     * This avoids creating an address vector for each bit
+     */
+    void set_bit_bl_address(const FabricBitId& bit_id,
+                            const size_t& address);
+
+    void set_bit_wl_address(const FabricBitId& bit_id,
+                            const size_t& address);
+
     void set_bit_din(const FabricBitId& bit_id,
                      const char& din);
 
+    void set_bit_din_index(const FabricBitId& bit_id,
+                           const size_t& din_index);
+
     /* Reserve regions */
     void reserve_regions(const size_t& num_regions);
 
     /* Add a new configuration region */
     FabricBitRegionId add_region();
 
+    /* Reserve a number of bits for a region */
+    void reserve_region_bits(const FabricBitRegionId& region_id,
+                             const size_t& num_bits);
+
     void add_bit_to_region(const FabricBitRegionId& region_id,
                            const FabricBitId& bit_id);
 
     /* Reserve bits by region */
     void reverse_region_bits(const FabricBitRegionId& region_id);
 
+    /* Append all the bits and regions of another fabric bitstream, 
+     * e.g., the bitstream of a region built on its own.
+     * Both fabric bitstreams should use the same addresses and data width
+     */
+    void add_sub_bitstream(const FabricBitstream& sub_bitstream);
+
     /* Reverse bit sequence of the fabric bitstream
      * This is required by configuration chain protocol 
      */
@@ -168,7 +204,7 @@ class FabricBitstream {
      * and users can access/modify the data
      * Otherwise, it will NOT be allocated and accessible.
      *
-     * This function is only applicable before any bits are added
+     * These functions are only applicable before any bits are added
      */
     void set_use_address(const bool& enable);
     void set_address_length(const size_t& length);
@@ -180,19 +216,40 @@ class FabricBitstream {
     void set_use_wl_address(const bool& enable);
     void set_wl_address_length(const size_t& length);
 
+    /* Set the number of data inputs sharing the same address in each region
+     * Same priniciple as the set_use_address()
+     */
+    void set_data_width(const size_t& width);
+
+    /* Release the memory reserved but not used by the bits and regions
+     * Call this only when the bitstream is finished
+     */
+    void shrink_to_fit();
+
   public:  /* Public Validators */
     bool valid_bit_id(const FabricBitId& bit_id) const;
     bool valid_region_id(const FabricBitRegionId& bit_id) const;
 
+  private: /* Internal address arena helpers */
+    static void set_arena_address(std::vector<bool>& arena,
+                                  const size_t& offset,
+                                  const std::vector<char>& address);
+    static void set_arena_address(std::vector<bool>& arena,
+                                  const size_t& offset,
+                                  const size_t& length,
+                                  const size_t& address);
+    static void reverse_arena(std::vector<bool>& arena,
+                              const size_t& stride);
+
   private: /* Internal data */
     /* Unique id of a region in the Bitstream */
     size_t num_regions_; 
-    std::unordered_set<FabricBitRegionId> invalid_region_ids_;
+    vtr::tombstone_bitmap<FabricBitRegionId> invalid_region_ids_;
     vtr::vector<FabricBitRegionId, std::vector<FabricBitId>> region_bit_ids_; 
 
     /* Unique id of a bit in the Bitstream */
     size_t num_bits_; 
-    std::unordered_set<FabricBitId> invalid_bit_ids_;
+    vtr::tombstone_bitmap<FabricBitId> invalid_bit_ids_;
     vtr::vector<FabricBitId, ConfigBitId> config_bit_ids_; 
 
     /* Flags to indicate if the addresses and din should be enabled */
@@ -201,22 +258,27 @@ class FabricBitstream {
 
     size_t address_length_;
     size_t wl_address_length_;
+    size_t data_width_;
 
     /* Address bits: this is designed for memory decoders
      * Here we store the binary format of the address, which can be loaded
      * to the configuration protocol directly 
      *
-     * We use a 2-element array, as we may have a BL address and a WL address
-     *
-     * TODO: use nested vector may cause large memory footprint 
-     *       when bitstream size increases
-     *       NEED TO THINK ABOUT A COMPACT MODELING
+     * We may have a BL address and a WL address.
+     * The addresses of all the bits are packed in a contiguous arena
+     * with a fixed stride of 2 * address length, 
+     * where each address bit is encoded by a pair of (value, don't care) bits
      */
-    vtr::vector<FabricBitId, std::vector<char>> bit_addresses_;
-    vtr::vector<FabricBitId, std::vector<char>> bit_wl_addresses_;
+    std::vector<bool> bit_addresses_;
+    std::vector<bool> bit_wl_addresses_;
 
     /* Data input (Din) bits: this is designed for memory decoders */
     vtr::vector<FabricBitId, char> bit_dins_;
+
+    /* Index of the data input of each bit, which is allocated only when
+     * multiple data inputs share the same address, i.e., data_width_ > 1
+     */
+    vtr::vector<FabricBitId, size_t> bit_din_indices_;
 };
 
 } /* end namespace openfpga */
@@ -0,0 +1,253 @@
+/******************************************************************************
+ * This file includes member functions for data structure FabricBitstreamByAddress
+ ******************************************************************************/
+#include <algorithm>
+#include <numeric>
+
+#include "vtr_assert.h"
+#include "openfpga_decode.h"
+#include "fabric_bitstream_by_address.h"
+
+/* begin namespace openfpga */
+namespace openfpga {
+
+/* Number of bits to encode an address character */
+constexpr size_t ADDRESS_CHAR_NUM_BITS = 2;
+/* Number of address characters that an integer can store */
+constexpr size_t ADDRESS_INTEGER_NUM_CHARS = 64 / ADDRESS_CHAR_NUM_BITS;
+/* Number of bits of a digit in radix sort */
+constexpr size_t ADDRESS_DIGIT_NUM_BITS = 8;
+constexpr size_t ADDRESS_DIGIT_NUM_VALUES = 1 << ADDRESS_DIGIT_NUM_BITS;
+
+/**************************************************
+ * Public Constructor
+ *************************************************/
+FabricBitstreamByAddress::FabricBitstreamByAddress() {
+  reset(0, 0, 0);
+}
+
+/**************************************************
+ * Public Accessors
+ *************************************************/
+size_t FabricBitstreamByAddress::num_words() const {
+  return num_words_;
+}
+
+size_t FabricBitstreamByAddress::num_regions() const {
+  return num_regions_;
+}
+
+size_t FabricBitstreamByAddress::address_length() const {
+  return address_length_;
+}
+
+size_t FabricBitstreamByAddress::wl_address_length() const {
+  return wl_address_length_;
+}
+
+std::string FabricBitstreamByAddress::word_address(const size_t& word) const {
+  return decode_address(word, 0, address_length_);
+}
+
+std::string FabricBitstreamByAddress::word_wl_address(const size_t& word) const {
+  return decode_address(word, address_length_, wl_address_length_);
+}
+
+size_t FabricBitstreamByAddress::word_address_value(const size_t& word) const {
+  VTR_ASSERT(word < num_words_);
+  VTR_ASSERT(address_length_ <= 8 * sizeof(size_t));
+  size_t total_length = address_length_ + wl_address_length_;
+
+  size_t value = 0;
+  for (size_t ichar = 0; ichar < address_length_; ++ichar) {
+    size_t pos = ADDRESS_CHAR_NUM_BITS * (total_length - 1 - ichar);
+    uint64_t code = (word_addresses_[word * num_address_integers() + pos / 64] >> (pos % 64)) & 3;
+    VTR_ASSERT(2 != code);
+    value |= size_t(code) << ichar;
+  }
+  return value;
+}
+
+bool FabricBitstreamByAddress::word_din(const size_t& word, const size_t& region) const {
+  VTR_ASSERT(word < num_words_);
+  VTR_ASSERT(region < num_regions_);
+  return region_dins_[region][word];
+}
+
+std::vector<bool> FabricBitstreamByAddress::word_dins(const size_t& word) const {
+  VTR_ASSERT(word < num_words_);
+  std::vector<bool> dins(num_regions_, false);
+  for (size_t region = 0; region < num_regions_; ++region) {
+    dins[region] = region_dins_[region][word];
+  }
+  return dins;
+}
+
+bool FabricBitstreamByAddress::word_dins_equal(const size_t& word, const bool& value) const {
+  VTR_ASSERT(word < num_words_);
+  for (size_t region = 0; region < num_regions_; ++region) {
+    if (value != region_dins_[region][word]) {
+      return false;
+    }
+  }
+  return true;
+}
+
+/**************************************************
+ * Public Mutators
+ *************************************************/
+void FabricBitstreamByAddress::reset(const size_t& address_length,
+                                     const size_t& wl_address_length,
+                                     const size_t& num_regions) {
+  address_length_ = address_length;
+  wl_address_length_ = wl_address_length;
+  num_regions_ = num_regions;
+  num_words_ = 0;
+
+  word_addresses_.clear();
+  region_dins_.assign(num_regions_, std::vector<bool>());
+
+  bit_addresses_.clear();
+  bit_regions_.clear();
+  bit_dins_.clear();
+  bit_words_.clear();
+}
+
+void FabricBitstreamByAddress::add_bit(const std::string& address,
+                                       const size_t& region,
+                                       const bool& din) {
+  size_t total_length = address_length_ + wl_address_length_;
+  VTR_ASSERT(total_length == address.length());
+  VTR_ASSERT(region < num_regions_);
+
+  /* Encode the address, where the first character is the most significant one.
+   * The codes of characters follow their ASCII order,
+   * so that the addresses are sorted in the same order as strings
+   */
+  size_t offset = bit_addresses_.size();
+  bit_addresses_.resize(offset + num_address_integers(), 0);
+  for (size_t ichar = 0; ichar < total_length; ++ichar) {
+    uint64_t code = 0;
+    if ('1' == address[ichar]) {
+      code = 1;
+    } else if (DONT_CARE_CHAR == address[ichar]) {
+      code = 2;
+    } else {
+      VTR_ASSERT('0' == address[ichar]);
+    }
+    size_t pos = ADDRESS_CHAR_NUM_BITS * (total_length - 1 - ichar);
+    bit_addresses_[offset + pos / 64] |= code << (pos % 64);
+  }
+
+  bit_regions_.push_back(region);
+  bit_dins_.push_back(din);
+}
+
+void FabricBitstreamByAddress::set_bit_din(const size_t& bit,
+                                           const bool& din) {
+  /* The words of bits should have been kept */
+  VTR_ASSERT(bit < bit_words_.size());
+  region_dins_[bit_regions_[bit]][bit_words_[bit]] = din;
+}
+
+/********************************************************************
+ * Sort the bits which have been added by their addresses with
+ * a stable LSD radix sort, and merge those sharing the same addresses into words
+ * As the sort is stable, the bits of the same region and address are visited
+ * in the order they are added, and the last one is kept
+ *******************************************************************/
+void FabricBitstreamByAddress::build_words(const bool& keep_bit_words) {
+  size_t num_ints = num_address_integers();
+  size_t num_bits = bit_regions_.size();
+  size_t num_digits = (ADDRESS_CHAR_NUM_BITS * (address_length_ + wl_address_length_) + ADDRESS_DIGIT_NUM_BITS - 1) / ADDRESS_DIGIT_NUM_BITS;
+
+  std::vector<size_t> order(num_bits);
+  std::iota(order.begin(), order.end(), 0);
+  std::vector<size_t> sorted(num_bits);
+  std::vector<size_t> bucket_offsets(ADDRESS_DIGIT_NUM_VALUES + 1);
+
+  for (size_t digit = 0; digit < num_digits; ++digit) {
+    std::fill(bucket_offsets.begin(), bucket_offsets.end(), 0);
+    for (const size_t& ibit : order) {
+      bucket_offsets[address_digit(bit_addresses_, ibit, digit) + 1]++;
+    }
+    /* Bypass the digit if all the bits are in the same bucket */
+    if (num_bits == *std::max_element(bucket_offsets.begin(), bucket_offsets.end())) {
+      continue;
+    }
+    std::partial_sum(bucket_offsets.begin(), bucket_offsets.end(), bucket_offsets.begin());
+    for (const size_t& ibit : order) {
+      sorted[bucket_offsets[address_digit(bit_addresses_, ibit, digit)]++] = ibit;
+    }
+    order.swap(sorted);
+  }
+
+  /* Merge the bits with the same address into words */
+  word_addresses_.clear();
+  region_dins_.assign(num_regions_, std::vector<bool>());
+  num_words_ = 0;
+  bit_words_.clear();
+  if (true == keep_bit_words) {
+    bit_words_.resize(num_bits);
+  }
+  for (const size_t& ibit : order) {
+    auto bit_addr_begin = bit_addresses_.begin() + ibit * num_ints;
+    if ( (0 == num_words_)
+      || (false == std::equal(bit_addr_begin, bit_addr_begin + num_ints,
+                              word_addresses_.end() - num_ints)) ) {
+      /* This is a new word, deposit '0' to the data inputs of all the regions */
+      word_addresses_.insert(word_addresses_.end(), bit_addr_begin, bit_addr_begin + num_ints);
+      for (std::vector<bool>& dins : region_dins_) {
+        dins.push_back(false);
+      }
+      num_words_++;
+    }
+    region_dins_[bit_regions_[ibit]][num_words_ - 1] = bit_dins_[ibit];
+    if (true == keep_bit_words) {
+      bit_words_[ibit] = num_words_ - 1;
+    }
+  }
+
+  /* Release the memory of the bits, except their regions and words when kept */
+  bit_addresses_ = std::vector<uint64_t>();
+  if (false == keep_bit_words) {
+    bit_regions_ = std::vector<size_t>();
+  }
+  bit_dins_ = std::vector<bool>();
+}
+
+/**************************************************
+ * Internal helpers
+ *************************************************/
+size_t FabricBitstreamByAddress::num_address_integers() const {
+  return (address_length_ + wl_address_length_ + ADDRESS_INTEGER_NUM_CHARS - 1) / ADDRESS_INTEGER_NUM_CHARS;
+}
+
+size_t FabricBitstreamByAddress::address_digit(const std::vector<uint64_t>& addresses,
+                                               const size_t& index,
+                                               const size_t& digit) const {
+  size_t pos = ADDRESS_DIGIT_NUM_BITS * digit;
+  return (addresses[index * num_address_integers() + pos / 64] >> (pos % 64)) & (ADDRESS_DIGIT_NUM_VALUES - 1);
+}
+
+std::string FabricBitstreamByAddress::decode_address(const size_t& word,
+                                                     const size_t& offset,
+                                                     const size_t& length) const {
+  VTR_ASSERT(word < num_words_);
+  size_t total_length = address_length_ + wl_address_length_;
+  VTR_ASSERT(offset + length <= total_length);
+
+  std::string addr_str(length, '0');
+  for (size_t ichar = 0; ichar < length; ++ichar) {
+    size_t pos = ADDRESS_CHAR_NUM_BITS * (total_length - 1 - offset - ichar);
+    uint64_t code = (word_addresses_[word * num_address_integers() + pos / 64] >> (pos % 64)) & 3;
+    if (1 == code) {
+      addr_str[ichar] = '1';
+    } else if (2 == code) {
+      addr_str[ichar] = DONT_CARE_CHAR;
+    }
+  }
+  return addr_str;
+}
+
+} /* end namespace openfpga */
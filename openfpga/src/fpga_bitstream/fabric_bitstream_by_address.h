@@ -0,0 +1,150 @@
+/******************************************************************************
+ * This file introduces a data structure to store a fabric-dependent bitstream
+ * organized by addresses, which is required by the configuration protocols
+ * where configuration bits are addressed, i.e., frame-based and memory banks
+ *
+ * General concept
+ * ---------------
+ * The bits of all the configuration regions which share the same address
+ * are loaded in the same programming cycle. Such bits are grouped into a word:
+ *
+ *   <address> <din_values_from_different_regions>
+ *   An example:
+ *   000000  1011
+ *
+ * For memory banks, the address of a word is the BL address followed by the WL address
+ *
+ * For frame-based protocol where each frame loads multiple bits,
+ * each region has as many data inputs as the bits per frame.
+ * These data inputs are stored as regions of their own,
+ * following the data input port of the top-level module
+ *
+ * Words are sorted by addresses in an ascending order, and each address is unique
+ *
+ * Storage
+ * -------
+ * Each address character ('0', '1' or 'x') is encoded by 2 bits
+ * so that the addresses are stored in a flat array of integers
+ * The data inputs of each region are stored in a contiguous array
+ * indexed by words
+ *
+ * Typical usage:
+ *   FabricBitstreamByAddress fabric_bits_by_addr;
+ *   fabric_bits_by_addr.reset(address_length, wl_address_length, num_regions);
+ *   // Add bits
+ *   fabric_bits_by_addr.add_bit(...);
+ *   ...
+ *   // Sort and merge the bits into words, before any access
+ *   fabric_bits_by_addr.build_words();
+ *
+ * To update the data inputs of another bitstream on the same addresses:
+ *   fabric_bits_by_addr.build_words(true);
+ *   // Update the bits in the same sequence as they were added
+ *   fabric_bits_by_addr.set_bit_din(0, ...);
+ *   ...
+ *
+ ******************************************************************************/
+#ifndef FABRIC_BITSTREAM_BY_ADDRESS_H
+#define FABRIC_BITSTREAM_BY_ADDRESS_H
+
+#include <cstdint>
+#include <string>
+#include <vector>
+
+/* begin namespace openfpga */
+namespace openfpga {
+
+class FabricBitstreamByAddress {
+  public: /* Public constructor */
+    FabricBitstreamByAddress();
+
+  public:  /* Public Accessors */
+    size_t num_words() const;
+    size_t num_regions() const;
+
+    /* Length of the address (the BL address for memory banks) */
+    size_t address_length() const;
+    /* Length of the WL address, which is 0 except for memory banks */
+    size_t wl_address_length() const;
+
+    /* Find the address (the BL address for memory banks) of a word, e.g., "0101" */
+    std::string word_address(const size_t& word) const;
+    /* Find the WL address of a word, which is empty except for memory banks */
+    std::string word_wl_address(const size_t& word) const;
+    /* Find the address (the BL address for memory banks) of a word as an integer,
+     * where the i-th address character is the i-th bit, the same as bintoi_charvec()
+     * The address should not contain any don't care bit
+     */
+    size_t word_address_value(const size_t& word) const;
+
+    /* Find the data input of a region in a word */
+    bool word_din(const size_t& word, const size_t& region) const;
+    /* Find the data inputs of all the regions in a word */
+    std::vector<bool> word_dins(const size_t& word) const;
+    /* Check if the data inputs of all the regions in a word are the same as a given value */
+    bool word_dins_equal(const size_t& word, const bool& value) const;
+
+  public:  /* Public Mutators */
+    /* Clear all the contents, and set the lengths of addresses and the number of regions */
+    void reset(const size_t& address_length,
+               const size_t& wl_address_length,
+               const size_t& num_regions);
+
+    /* Add a configuration bit, which is stored until the words are built
+     * The address is the BL address followed by the WL address for memory banks
+     * When a bit of the same region is added to an address multiple times,
+     * the last one is kept
+     */
+    void add_bit(const std::string& address,
+                 const size_t& region,
+                 const bool& din);
+
+    /* Sort the added bits by addresses and merge the bits with the same address into words
+     * When the words of bits are kept, the data inputs can be updated later
+     * by set_bit_din(), e.g., to load another bitstream on the same addresses,
+     * without sorting the addresses again
+     */
+    void build_words(const bool& keep_bit_words = false);
+
+    /* Update the data input of a bit, which is indexed in the sequence the bits were added.
+     * The words of bits should have been kept by build_words(). 
+     * As in add_bit(), the bits of the same region and address should be updated
+     * in the sequence they were added, so that the last one is kept
+     */
+    void set_bit_din(const size_t& bit, const bool& din);
+
+  private: /* Internal helpers */
+    /* Number of integers to store an address */
+    size_t num_address_integers() const;
+    /* Find a digit of an address, where digit 0 is the least significant one */
+    size_t address_digit(const std::vector<uint64_t>& addresses,
+                         const size_t& index,
+                         const size_t& digit) const;
+    std::string decode_address(const size_t& word,
+                               const size_t& offset,
+                               const size_t& length) const;
+
+  private: /* Internal data */
+    size_t address_length_;
+    size_t wl_address_length_;
+    size_t num_regions_;
+    size_t num_words_;
+
+    /* Encoded addresses of the words, with a stride of num_address_integers() */
+    std::vector<uint64_t> word_addresses_;
+
+    /* Data inputs of the words: [region][word] */
+    std::vector<std::vector<bool>> region_dins_;
+
+    /* Bits which are added but not yet merged into words */
+    std::vector<uint64_t> bit_addresses_;
+    std::vector<size_t> bit_regions_;
+    std::vector<bool> bit_dins_;
+
+    /* Word of each added bit, which is kept with the regions of bits upon request */
+    std::vector<size_t> bit_words_;
+};
+
+} /* end namespace openfpga */
+
+#endif
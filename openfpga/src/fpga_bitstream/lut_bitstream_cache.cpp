@@ -0,0 +1,98 @@
+/************************************************************************
+ * Member functions for class LutBitstreamCache
+ ***********************************************************************/
+/* Headers from vtrutil library */
+#include "vtr_hash.h"
+
+#include "lut_utils.h"
+#include "lut_bitstream_cache.h"
+
+/* namespace openfpga begins */
+namespace openfpga {
+
+/************************************************************************
+ * Public accessors
+ ***********************************************************************/
+size_t LutBitstreamCache::num_lookups() const {
+  std::lock_guard<std::mutex> lock(mutex_);
+  return num_lookups_;
+}
+
+size_t LutBitstreamCache::num_hits() const {
+  std::lock_guard<std::mutex> lock(mutex_);
+  return num_hits_;
+}
+
+/************************************************************************
+ * Public mutators
+ ***********************************************************************/
+std::vector<bool> LutBitstreamCache::find_or_build(const CircuitLibrary& circuit_lib,
+                                                   const CircuitModelId& lut_model,
+                                                   const MuxGraph& lut_mux_graph,
+                                                   const VprDeviceAnnotation& device_annotation,
+                                                   const std::map<const t_pb_graph_pin*, AtomNetlist::TruthTable>& truth_tables,
+                                                   const size_t& default_sram_bit_value) {
+  /* Keep the sequence of the truth tables, 
+   * which is the sequence that build_frac_lut_bitstream() fills the bitstream in
+   */
+  t_key key;
+  key.lut_model = lut_model;
+  key.default_sram_bit_value = default_sram_bit_value;
+  key.truth_tables.reserve(truth_tables.size());
+  for (const auto& element : truth_tables) {
+    key.truth_tables.emplace_back(device_annotation.pb_circuit_port(element.first->port),
+                                  size_t(element.first->pin_number),
+                                  element.second);
+  }
+
+  {
+    std::lock_guard<std::mutex> lock(mutex_);
+    ++num_lookups_;
+    auto result = bitstreams_.find(key);
+    if (result != bitstreams_.end()) {
+      ++num_hits_;
+      return result->second;
+    }
+  }
+
+  /* Build the bitstream without locking the cache, 
+   * another thread may build the same one in the meantime, which is harmless
+   */
+  std::vector<bool> lut_bitstream = build_frac_lut_bitstream(circuit_lib, lut_mux_graph,
+                                                             device_annotation,
+                                                             truth_tables,
+                                                             default_sram_bit_value);
+
+  std::lock_guard<std::mutex> lock(mutex_);
+  bitstreams_.emplace(std::move(key), lut_bitstream);
+  return lut_bitstream;
+}
+
+/************************************************************************
+ * Internal functions for the keys
+ ***********************************************************************/
+bool LutBitstreamCache::t_key::operator==(const t_key& other) const {
+  return (lut_model == other.lut_model)
+      && (default_sram_bit_value == other.default_sram_bit_value)
+      && (truth_tables == other.truth_tables);
+}
+
+size_t LutBitstreamCache::t_key_hash::operator()(const t_key& key) const {
+  size_t hash = 0;
+  vtr::hash_combine(hash, key.lut_model);
+  vtr::hash_combine(hash, key.default_sram_bit_value);
+  for (const t_output_truth_table& truth_table : key.truth_tables) {
+    vtr::hash_combine(hash, std::get<0>(truth_table));
+    vtr::hash_combine(hash, std::get<1>(truth_table));
+    for (const std::vector<vtr::LogicValue>& row : std::get<2>(truth_table)) {
+      for (const vtr::LogicValue& value : row) {
+        vtr::hash_combine(hash, size_t(value));
+      }
+      /* Separate the rows, so that the shape of the truth table matters */
+      vtr::hash_combine(hash, size_t(-1));
+    }
+  }
+  return hash;
+}
+
+} /* namespace openfpga ends */
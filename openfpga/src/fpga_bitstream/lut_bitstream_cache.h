@@ -0,0 +1,74 @@
+#ifndef LUT_BITSTREAM_CACHE_H
+#define LUT_BITSTREAM_CACHE_H
+
+/********************************************************************
+ * Include header files required by the data structure definition
+ *******************************************************************/
+#include <map>
+#include <mutex>
+#include <tuple>
+#include <unordered_map>
+#include <vector>
+
+#include "atom_netlist.h"
+#include "circuit_library.h"
+#include "mux_graph.h"
+#include "physical_types.h"
+#include "vpr_device_annotation.h"
+
+/* Begin namespace openfpga */
+namespace openfpga {
+
+/********************************************************************
+ * A cache of the bitstreams of used LUTs
+ *
+ * Most LUTs of a design share a small set of truth tables,
+ * e.g., LUTs used as wires, AND/XOR gates or constant drivers.
+ * The bitstream of a LUT only depends on
+ * - the circuit model of the LUT
+ * - the output port of the circuit model and the pin of each truth table,
+ *   which decide the fracturable level and the output mask
+ * - the contents of each truth table, where the pin rotation has 
+ *   already been applied during repacking
+ * - the default value of the SRAMs
+ * so that the bitstream is built only once for each combination
+ * and copied from the cache for the other LUTs
+ *
+ * The cache can be shared by multiple threads
+ *******************************************************************/
+class LutBitstreamCache {
+  public: /* Public accessors */
+    size_t num_lookups() const;
+    size_t num_hits() const;
+  public: /* Public mutators */
+    /* Find the bitstream of a LUT in the cache, 
+     * or build it by build_frac_lut_bitstream() if not found
+     */
+    std::vector<bool> find_or_build(const CircuitLibrary& circuit_lib,
+                                    const CircuitModelId& lut_model,
+                                    const MuxGraph& lut_mux_graph,
+                                    const VprDeviceAnnotation& device_annotation,
+                                    const std::map<const t_pb_graph_pin*, AtomNetlist::TruthTable>& truth_tables,
+                                    const size_t& default_sram_bit_value);
+  private: /* Internal data types */
+    /* The truth table of an output pin, identified by its circuit port and pin index */
+    typedef std::tuple<CircuitPortId, size_t, AtomNetlist::TruthTable> t_output_truth_table;
+    struct t_key {
+      CircuitModelId lut_model;
+      size_t default_sram_bit_value;
+      std::vector<t_output_truth_table> truth_tables;
+      bool operator==(const t_key& other) const;
+    };
+    struct t_key_hash {
+      size_t operator()(const t_key& key) const;
+    };
+  private: /* Internal data */
+    std::unordered_map<t_key, std::vector<bool>, t_key_hash> bitstreams_;
+    size_t num_lookups_ = 0;
+    size_t num_hits_ = 0;
+    mutable std::mutex mutex_;
+};
+
+} /* End namespace openfpga*/
+
+#endif
@@ -0,0 +1,131 @@
+/********************************************************************
+ * This file includes functions that read a fabric-dependent
+ * bitstream from a binary container written by
+ * write_fabric_bitstream_to_binary_file()
+ * See binary_fabric_bitstream.h for the layout of the container
+ *******************************************************************/
+#include <cstring>
+#include <fstream>
+#include <iterator>
+
+/* Headers from vtrutil library */
+#include "vtr_assert.h"
+#include "vtr_log.h"
+#include "vtr_time.h"
+
+#include "read_binary_fabric_bitstream.h"
+
+/* begin namespace openfpga */
+namespace openfpga {
+
+/********************************************************************
+ * Decode an unsigned integer in little-endian from a byte array
+ *******************************************************************/
+static
+uint64_t decode_binary_uint(const std::vector<char>& bytes,
+                            const size_t& offset,
+                            const size_t& num_bytes) {
+  uint64_t value = 0;
+  for (size_t ibyte = 0; ibyte < num_bytes; ++ibyte) {
+    value |= uint64_t(static_cast<unsigned char>(bytes[offset + ibyte])) << (8 * ibyte);
+  }
+  return value;
+}
+
+/********************************************************************
+ * Read a fabric bitstream from a binary file
+ *
+ * Return:
+ *  - 0 if succeed
+ *  - 1 if critical errors occured
+ *******************************************************************/
+int read_binary_fabric_bitstream(const std::string& fname,
+                                 BinaryFabricBitstream& fabric_bitstream) {
+  vtr::ScopedStartFinishTimer timer("Read fabric bitstream from binary file '" + fname + "'");
+
+  std::ifstream fp(fname, std::ifstream::in | std::ifstream::binary);
+  if (false == fp.is_open()) {
+    VTR_LOG_ERROR("Fail to open binary fabric bitstream file '%s'!\n",
+                  fname.c_str());
+    return 1;
+  }
+  std::vector<char> bytes((std::istreambuf_iterator<char>(fp)),
+                          std::istreambuf_iterator<char>());
+  fp.close();
+
+  /* Decode the header */
+  constexpr size_t header_size = BINARY_FABRIC_BITSTREAM_MAGIC_SIZE + 5 * 4 + 8;
+  if ( (bytes.size() < header_size)
+    || (0 != std::memcmp(bytes.data(), BINARY_FABRIC_BITSTREAM_MAGIC, BINARY_FABRIC_BITSTREAM_MAGIC_SIZE)) ) {
+    VTR_LOG_ERROR("File '%s' is not a binary fabric bitstream!\n",
+                  fname.c_str());
+    return 1;
+  }
+
+  size_t offset = BINARY_FABRIC_BITSTREAM_MAGIC_SIZE;
+  uint64_t version = decode_binary_uint(bytes, offset, 4);
+  offset += 4;
+  if (BINARY_FABRIC_BITSTREAM_VERSION != version) {
+    VTR_LOG_ERROR("Unsupported version '%lu' of binary fabric bitstream '%s'!\n",
+                  size_t(version), fname.c_str());
+    return 1;
+  }
+
+  uint64_t config_protocol_type = decode_binary_uint(bytes, offset, 4);
+  offset += 4;
+  if (NUM_CONFIG_PROTOCOL_TYPES <= config_protocol_type) {
+    VTR_LOG_ERROR("Invalid configuration protocol type '%lu' in binary fabric bitstream '%s'!\n",
+                  size_t(config_protocol_type), fname.c_str());
+    return 1;
+  }
+  fabric_bitstream.config_protocol_type = static_cast<e_config_protocol_type>(config_protocol_type);
+  fabric_bitstream.num_regions = decode_binary_uint(bytes, offset, 4);
+  offset += 4;
+  fabric_bitstream.address_width = decode_binary_uint(bytes, offset, 4);
+  offset += 4;
+  fabric_bitstream.wl_address_width = decode_binary_uint(bytes, offset, 4);
+  offset += 4;
+  size_t num_records = decode_binary_uint(bytes, offset, 8);
+  offset += 8;
+  VTR_ASSERT(header_size == offset);
+
+  /* Ensure the file contains all the records */
+  size_t record_size = fabric_bitstream.address_width
+                     + fabric_bitstream.wl_address_width
+                     + fabric_bitstream.num_regions;
+  if ((bytes.size() - header_size) * 8 < num_records * record_size) {
+    VTR_LOG_ERROR("Binary fabric bitstream '%s' is truncated: expect %lu records of %lu bits!\n",
+                  fname.c_str(), num_records, record_size);
+    return 1;
+  }
+
+  /* Decode the records */
+  fabric_bitstream.addresses.assign(num_records, std::string());
+  fabric_bitstream.wl_addresses.assign(num_records, std::string());
+  fabric_bitstream.data.assign(num_records, std::vector<bool>(fabric_bitstream.num_regions, false));
+
+  size_t cur_bit = 0;
+  auto read_bit = [&]() -> bool {
+    bool bit = (static_cast<unsigned char>(bytes[header_size + cur_bit / 8]) >> (cur_bit % 8)) & 1;
+    ++cur_bit;
+    return bit;
+  };
+
+  for (size_t irecord = 0; irecord < num_records; ++irecord) {
+    fabric_bitstream.addresses[irecord].resize(fabric_bitstream.address_width);
+    for (char& addr_bit : fabric_bitstream.addresses[irecord]) {
+      addr_bit = read_bit() ? '1' : '0';
+    }
+    fabric_bitstream.wl_addresses[irecord].resize(fabric_bitstream.wl_address_width);
+    for (char& addr_bit : fabric_bitstream.wl_addresses[irecord]) {
+      addr_bit = read_bit() ? '1' : '0';
+    }
+    for (size_t iregion = 0; iregion < fabric_bitstream.num_regions; ++iregion) {
+      fabric_bitstream.data[irecord][iregion] = read_bit();
+    }
+  }
+
+  return 0;
+}
+
+} /* end namespace openfpga */
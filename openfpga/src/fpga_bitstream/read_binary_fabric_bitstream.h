@@ -0,0 +1,22 @@
+#ifndef READ_BINARY_FABRIC_BITSTREAM_H
+#define READ_BINARY_FABRIC_BITSTREAM_H
+
+/********************************************************************
+ * Include header files that are required by function declaration
+ *******************************************************************/
+#include <string>
+#include "binary_fabric_bitstream.h"
+
+/********************************************************************
+ * Function declaration
+ *******************************************************************/
+
+/* begin namespace openfpga */
+namespace openfpga {
+
+int read_binary_fabric_bitstream(const std::string& fname,
+                                 BinaryFabricBitstream& fabric_bitstream);
+
+} /* end namespace openfpga */
+
+#endif
@@ -0,0 +1,313 @@
+/********************************************************************
+ * This file includes functions that output a fabric-dependent
+ * bitstream database to files in a compact binary container
+ * See binary_fabric_bitstream.h for the layout of the container
+ *******************************************************************/
+#include <fstream>
+
+/* Headers from vtrutil library */
+#include "vtr_assert.h"
+#include "vtr_log.h"
+#include "vtr_time.h"
+
+/* Headers from openfpgautil library */
+#include "openfpga_digest.h"
+#include "openfpga_decode.h"
+
+#include "fabric_bitstream_utils.h"
+#include "config_chain_fabric_bitstream.h"
+#include "binary_fabric_bitstream.h"
+#include "write_binary_fabric_bitstream.h"
+
+/* begin namespace openfpga */
+namespace openfpga {
+
+/********************************************************************
+ * Write an unsigned integer to a binary file in little-endian
+ *******************************************************************/
+static
+void write_binary_uint(std::fstream& fp,
+                       const uint64_t& value,
+                       const size_t& num_bytes) {
+  for (size_t ibyte = 0; ibyte < num_bytes; ++ibyte) {
+    fp.put(static_cast<char>((value >> (8 * ibyte)) & 0xff));
+  }
+}
+
+/********************************************************************
+ * Pack a stream of bits into bytes and write them to a binary file
+ * through a buffer, so that the file stream is accessed by large chunks
+ *******************************************************************/
+class BinaryBitStreamWriter {
+  public:
+    explicit BinaryBitStreamWriter(std::fstream& fp)
+      : fp_(fp)
+      , cur_byte_(0)
+      , num_cur_bits_(0) {
+      buffer_.reserve(BUFFER_SIZE);
+    }
+
+    void write_bit(const bool& bit) {
+      if (true == bit) {
+        cur_byte_ |= (1 << num_cur_bits_);
+      }
+      ++num_cur_bits_;
+      if (8 == num_cur_bits_) {
+        push_byte();
+      }
+    }
+
+    /* Write a string of '0' and '1' */
+    void write_bits(const std::string& bits) {
+      for (const char& bit : bits) {
+        VTR_ASSERT(('0' == bit) || ('1' == bit));
+        write_bit('1' == bit);
+      }
+    }
+
+    /* Pad the last byte with zeros and flush the buffer to the file */
+    void finish() {
+      if (0 < num_cur_bits_) {
+        push_byte();
+      }
+      flush();
+    }
+
+  private:
+    void push_byte() {
+      buffer_.push_back(static_cast<char>(cur_byte_));
+      cur_byte_ = 0;
+      num_cur_bits_ = 0;
+      if (BUFFER_SIZE == buffer_.size()) {
+        flush();
+      }
+    }
+
+    void flush() {
+      fp_.write(buffer_.data(), buffer_.size());
+      buffer_.clear();
+    }
+
+  private:
+    static constexpr size_t BUFFER_SIZE = 1 << 16;
+    std::fstream& fp_;
+    std::vector<char> buffer_;
+    unsigned char cur_byte_;
+    size_t num_cur_bits_;
+};
+
+/********************************************************************
+ * Write the header of the binary container
+ *******************************************************************/
+static
+void write_binary_fabric_bitstream_header(std::fstream& fp,
+                                          const e_config_protocol_type& config_protocol_type,
+                                          const size_t& num_regions,
+                                          const size_t& address_width,
+                                          const size_t& wl_address_width,
+                                          const size_t& num_records) {
+  fp.write(BINARY_FABRIC_BITSTREAM_MAGIC, BINARY_FABRIC_BITSTREAM_MAGIC_SIZE);
+  write_binary_uint(fp, BINARY_FABRIC_BITSTREAM_VERSION, 4);
+  write_binary_uint(fp, size_t(config_protocol_type), 4);
+  write_binary_uint(fp, num_regions, 4);
+  write_binary_uint(fp, address_width, 4);
+  write_binary_uint(fp, wl_address_width, 4);
+  write_binary_uint(fp, num_records, 8);
+}
+
+/********************************************************************
+ * Write the flatten fabric bitstream to a binary file
+ * Each configuration bit is a record of 1 bit
+ *******************************************************************/
+static
+int write_flatten_fabric_bitstream_to_binary_file(std::fstream& fp,
+                                                  const BitstreamManager& bitstream_manager,
+                                                  const FabricBitstream& fabric_bitstream) {
+  write_binary_fabric_bitstream_header(fp, CONFIG_MEM_STANDALONE,
+                                       1, 0, 0,
+                                       fabric_bitstream.num_bits());
+
+  BinaryBitStreamWriter bit_writer(fp);
+  for (const FabricBitId& fabric_bit : fabric_bitstream.bits()) {
+    bit_writer.write_bit(bitstream_manager.bit_value(fabric_bitstream.config_bit(fabric_bit)));
+  }
+  bit_writer.finish();
+
+  return 0;
+}
+
+/********************************************************************
+ * Write the fabric bitstream fitting a configuration chain protocol
+ * to a binary file
+ * Each record contains the bits of all the regions at the same position
+ * of configuration chains, same as a line of the plain text file
+ * For run-length compression, each record is a run, whose address is
+ * the length of the run minus 1
+ *******************************************************************/
+static
+int write_config_chain_fabric_bitstream_to_binary_file(std::fstream& fp,
+                                                       const BitstreamManager& bitstream_manager,
+                                                       const FabricBitstream& fabric_bitstream,
+                                                       const ConfigProtocol& config_protocol) {
+  ConfigChainFabricBitstream regional_bitstreams(bitstream_manager, fabric_bitstream);
+
+  if (CONFIG_CHAIN_COMPRESSION_RUN_LENGTH == config_protocol.chain_compression_type()) {
+    const size_t& run_length_width = config_protocol.run_length_width();
+    std::vector<size_t> run_lengths = regional_bitstreams.run_lengths(size_t(1) << run_length_width);
+
+    write_binary_fabric_bitstream_header(fp, CONFIG_MEM_SCAN_CHAIN,
+                                         regional_bitstreams.num_regions(), run_length_width, 0,
+                                         run_lengths.size());
+
+    BinaryBitStreamWriter bit_writer(fp);
+    size_t icycle = 0;
+    for (const size_t& run_length : run_lengths) {
+      std::vector<char> run_length_bits = itobin_charvec(run_length - 1, run_length_width);
+      bit_writer.write_bits(std::string(run_length_bits.rbegin(), run_length_bits.rend()));
+      for (size_t iregion = 0; iregion < regional_bitstreams.num_regions(); ++iregion) {
+        bit_writer.write_bit(regional_bitstreams.bit_value(icycle, iregion));
+      }
+      icycle += run_length;
+    }
+    bit_writer.finish();
+
+    return 0;
+  }
+
+  write_binary_fabric_bitstream_header(fp, CONFIG_MEM_SCAN_CHAIN,
+                                       regional_bitstreams.num_regions(), 0, 0,
+                                       regional_bitstreams.num_cycles());
+
+  BinaryBitStreamWriter bit_writer(fp);
+  for (size_t ibit = 0; ibit < regional_bitstreams.num_cycles(); ++ibit) {
+    for (size_t iregion = 0; iregion < regional_bitstreams.num_regions(); ++iregion) {
+      bit_writer.write_bit(regional_bitstreams.bit_value(ibit, iregion));
+    }
+  }
+  bit_writer.finish();
+
+  return 0;
+}
+
+/********************************************************************
+ * Write the fabric bitstream fitting a memory bank protocol
+ * to a binary file
+ *******************************************************************/
+static
+int write_memory_bank_fabric_bitstream_to_binary_file(std::fstream& fp,
+                                                       const FabricBitstreamByAddress& fabric_bits_by_addr) {
+  write_binary_fabric_bitstream_header(fp, CONFIG_MEM_MEMORY_BANK,
+                                       fabric_bits_by_addr.num_regions(),
+                                       fabric_bits_by_addr.address_length(),
+                                       fabric_bits_by_addr.wl_address_length(),
+                                       fabric_bits_by_addr.num_words());
+
+  BinaryBitStreamWriter bit_writer(fp);
+  for (size_t iword = 0; iword < fabric_bits_by_addr.num_words(); ++iword) {
+    bit_writer.write_bits(fabric_bits_by_addr.word_address(iword));
+    bit_writer.write_bits(fabric_bits_by_addr.word_wl_address(iword));
+    for (size_t iregion = 0; iregion < fabric_bits_by_addr.num_regions(); ++iregion) {
+      bit_writer.write_bit(fabric_bits_by_addr.word_din(iword, iregion));
+    }
+  }
+  bit_writer.finish();
+
+  return 0;
+}
+
+/********************************************************************
+ * Write the fabric bitstream fitting a frame-based protocol
+ * to a binary file
+ * Note that don't care bits in addresses have been expanded,
+ * so that each address consists of only '0' and '1'
+ *******************************************************************/
+static
+int write_frame_based_fabric_bitstream_to_binary_file(std::fstream& fp,
+                                                      const FabricBitstreamByAddress& fabric_bits_by_addr) {
+  write_binary_fabric_bitstream_header(fp, CONFIG_MEM_FRAME_BASED,
+                                       fabric_bits_by_addr.num_regions(),
+                                       fabric_bits_by_addr.address_length(), 0,
+                                       fabric_bits_by_addr.num_words());
+
+  BinaryBitStreamWriter bit_writer(fp);
+  for (size_t iword = 0; iword < fabric_bits_by_addr.num_words(); ++iword) {
+    bit_writer.write_bits(fabric_bits_by_addr.word_address(iword));
+    for (size_t iregion = 0; iregion < fabric_bits_by_addr.num_regions(); ++iregion) {
+      bit_writer.write_bit(fabric_bits_by_addr.word_din(iword, iregion));
+    }
+  }
+  bit_writer.finish();
+
+  return 0;
+}
+
+/********************************************************************
+ * Write the fabric bitstream to a binary file
+ * The records are the same as the lines of the plain text file,
+ * but the bits are packed
+ *
+ * Return:
+ *  - 0 if succeed
+ *  - 1 if critical errors occured
+ *******************************************************************/
+int write_fabric_bitstream_to_binary_file(const BitstreamManager& bitstream_manager,
+                                          const FabricBitstream& fabric_bitstream,
+                                          const FabricBitstreamByAddress& fabric_bitstream_by_address,
+                                          const ConfigProtocol& config_protocol,
+                                          const std::string& fname,
+                                          const bool& verbose) {
+  /* Ensure that we have a valid file name */
+  if (true == fname.empty()) {
+    VTR_LOG_ERROR("Received empty file name to output bitstream!\n\tPlease specify a valid file name.\n");
+    return 1;
+  }
+
+  std::string timer_message = std::string("Write ") + std::to_string(fabric_bitstream.num_bits()) + std::string(" fabric bitstream into binary file '") + fname + std::string("'");
+  vtr::ScopedStartFinishTimer timer(timer_message);
+
+  /* Create the file stream */
+  std::fstream fp;
+  fp.open(fname, std::fstream::out | std::fstream::trunc | std::fstream::binary);
+
+  check_file_stream(fname.c_str(), fp);
+
+  /* Output fabric bitstream to the file */
+  int status = 0;
+  switch (config_protocol.type()) {
+  case CONFIG_MEM_STANDALONE:
+    status = write_flatten_fabric_bitstream_to_binary_file(fp,
+                                                           bitstream_manager,
+                                                           fabric_bitstream);
+    break;
+  case CONFIG_MEM_SCAN_CHAIN:
+    status = write_config_chain_fabric_bitstream_to_binary_file(fp,
+                                                                bitstream_manager,
+                                                                fabric_bitstream,
+                                                                config_protocol);
+    break;
+  case CONFIG_MEM_MEMORY_BANK:
+    status = write_memory_bank_fabric_bitstream_to_binary_file(fp,
+                                                               fabric_bitstream_by_address);
+    break;
+  case CONFIG_MEM_FRAME_BASED:
+    status = write_frame_based_fabric_bitstream_to_binary_file(fp,
+                                                               fabric_bitstream_by_address);
+    break;
+  default:
+    VTR_LOGF_ERROR(__FILE__, __LINE__,
+                   "Invalid configuration protocol type!\n");
+    status = 1;
+  }
+
+  /* Close file handler */
+  fp.close();
+
+  VTR_LOGV(verbose,
+           "Outputted %lu configuration bits to binary file: %s\n",
+           fabric_bitstream.bits().size(),
+           fname.c_str());
+
+  return status;
+}
+
+} /* end namespace openfpga */
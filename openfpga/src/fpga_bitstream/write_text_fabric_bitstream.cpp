@@ -5,6 +5,8 @@
 #include <chrono>
 #include <ctime>
 #include <fstream>
+#include <sstream>
+#include <unordered_map>
 
 /* Headers from vtrutil library */
 #include "vtr_assert.h"
@@ -13,16 +15,80 @@
 
 /* Headers from openfpgautil library */
 #include "openfpga_digest.h"
+#include "openfpga_decode.h"
+#include "openfpga_buffered_file_stream.h"
 
 #include "openfpga_naming.h"
 
 #include "bitstream_manager_utils.h"
 #include "fabric_bitstream_utils.h"
+#include "config_chain_fabric_bitstream.h"
 #include "write_text_fabric_bitstream.h"
 
 /* begin namespace openfpga */
 namespace openfpga {
 
+/********************************************************************
+ * A buffer to output a plain text file by large chunks
+ * The file stream is accessed only when the buffer is full,
+ * instead of formatting each character through the stream operators
+ *******************************************************************/
+class TextFileBuffer {
+  public:
+    explicit TextFileBuffer(std::fstream& fp)
+      : fp_(fp) {
+      buffer_.reserve(BUFFER_SIZE);
+    }
+
+    void write_char(const char& c) {
+      buffer_.push_back(c);
+      flush_if_full();
+    }
+
+    void write_bit(const bool& bit) {
+      write_char(bit ? '1' : '0');
+    }
+
+    void write_string(const std::string& str) {
+      buffer_.append(str);
+      flush_if_full();
+    }
+
+    /* Convert a block of bits to ASCII at once */
+    void write_bits(const std::vector<bool>& bits) {
+      size_t start = buffer_.size();
+      buffer_.resize(start + bits.size());
+      for (size_t ibit = 0; ibit < bits.size(); ++ibit) {
+        buffer_[start + ibit] = bits[ibit] ? '1' : '0';
+      }
+      flush_if_full();
+    }
+
+    void write_address(const FabricBitAddressView& address) {
+      for (const char addr_bit : address) {
+        buffer_.push_back(addr_bit);
+      }
+      flush_if_full();
+    }
+
+    void flush() {
+      fp_.write(buffer_.data(), buffer_.size());
+      buffer_.clear();
+    }
+
+  private:
+    void flush_if_full() {
+      if (BUFFER_SIZE <= buffer_.size()) {
+        flush();
+      }
+    }
+
+  private:
+    static constexpr size_t BUFFER_SIZE = 1 << 20;
+    std::fstream& fp_;
+    std::string buffer_;
+};
+
 /********************************************************************
  * Write a configuration bit into a plain text file
  * The format depends on the type of configuration protocol
@@ -36,40 +102,30 @@ namespace openfpga {
  *  - 1 if critical errors occured
  *******************************************************************/
 static 
-int write_fabric_config_bit_to_text_file(std::fstream& fp,
+int write_fabric_config_bit_to_text_file(TextFileBuffer& fp,
                                          const BitstreamManager& bitstream_manager,
                                          const FabricBitstream& fabric_bitstream,
                                          const FabricBitId& fabric_bit,
                                          const e_config_protocol_type& config_type) {
-  if (false == valid_file_stream(fp)) {
-    return 1;
-  }
-
   switch (config_type) {
   case CONFIG_MEM_STANDALONE: 
   case CONFIG_MEM_SCAN_CHAIN:
-    fp << bitstream_manager.bit_value(fabric_bitstream.config_bit(fabric_bit));
+    fp.write_bit(bitstream_manager.bit_value(fabric_bitstream.config_bit(fabric_bit)));
     break;
   case CONFIG_MEM_MEMORY_BANK: { 
-    for (const char& addr_bit : fabric_bitstream.bit_bl_address(fabric_bit)) {
-      fp << addr_bit;
-    }
-    write_space_to_file(fp, 1);
-    for (const char& addr_bit : fabric_bitstream.bit_wl_address(fabric_bit)) {
-      fp << addr_bit;
-    }
-    write_space_to_file(fp, 1);
-    fp << bitstream_manager.bit_value(fabric_bitstream.config_bit(fabric_bit));
-    fp << "\n";
+    fp.write_address(fabric_bitstream.bit_bl_address(fabric_bit));
+    fp.write_char(' ');
+    fp.write_address(fabric_bitstream.bit_wl_address(fabric_bit));
+    fp.write_char(' ');
+    fp.write_bit(bitstream_manager.bit_value(fabric_bitstream.config_bit(fabric_bit)));
+    fp.write_char('\n');
     break;
   }
   case CONFIG_MEM_FRAME_BASED: {
-    for (const char& addr_bit : fabric_bitstream.bit_address(fabric_bit)) {
-      fp << addr_bit;
-    }
-    write_space_to_file(fp, 1);
-    fp << bitstream_manager.bit_value(fabric_bitstream.config_bit(fabric_bit));
-    fp << "\n";
+    fp.write_address(fabric_bitstream.bit_address(fabric_bit));
+    fp.write_char(' ');
+    fp.write_bit(bitstream_manager.bit_value(fabric_bitstream.config_bit(fabric_bit)));
+    fp.write_char('\n');
     break;
   }
   default:
@@ -90,7 +146,7 @@ int write_fabric_config_bit_to_text_file(std::fstream& fp,
  *  - 1 if critical errors occured
  *******************************************************************/
 static 
-int write_flatten_fabric_bitstream_to_text_file(std::fstream& fp,
+int write_flatten_fabric_bitstream_to_text_file(TextFileBuffer& fp,
                                                 const BitstreamManager& bitstream_manager,
                                                 const FabricBitstream& fabric_bitstream,
                                                 const ConfigProtocol& config_protocol) {
@@ -117,19 +173,43 @@ int write_flatten_fabric_bitstream_to_text_file(std::fstream& fp,
  *  - 1 if critical errors occured
  *******************************************************************/
 static 
-int write_config_chain_fabric_bitstream_to_text_file(std::fstream& fp,
+int write_config_chain_fabric_bitstream_to_text_file(TextFileBuffer& fp,
                                                      const BitstreamManager& bitstream_manager,
-                                                     const FabricBitstream& fabric_bitstream) {
+                                                     const FabricBitstream& fabric_bitstream,
+                                                     const ConfigProtocol& config_protocol) {
   int status = 0;
 
-  size_t regional_bitstream_max_size = find_fabric_regional_bitstream_max_size(fabric_bitstream);
-  ConfigChainFabricBitstream regional_bitstreams = build_config_chain_fabric_bitstream_by_region(bitstream_manager, fabric_bitstream);
+  ConfigChainFabricBitstream regional_bitstreams(bitstream_manager, fabric_bitstream);
+
+  std::vector<bool> line_bits(regional_bitstreams.num_regions());
+
+  /* For run-length compression, each line contains the length of a run minus 1,
+   * with the most significant bit first, and the bits of all the regions in the run
+   */
+  if (CONFIG_CHAIN_COMPRESSION_RUN_LENGTH == config_protocol.chain_compression_type()) {
+    const size_t& run_length_width = config_protocol.run_length_width();
+    size_t icycle = 0;
+    for (const size_t& run_length : regional_bitstreams.run_lengths(size_t(1) << run_length_width)) {
+      std::vector<char> run_length_bits = itobin_charvec(run_length - 1, run_length_width);
+      fp.write_string(std::string(run_length_bits.rbegin(), run_length_bits.rend()));
+      fp.write_char(' ');
+      for (size_t iregion = 0; iregion < regional_bitstreams.num_regions(); ++iregion) {
+        line_bits[iregion] = regional_bitstreams.bit_value(icycle, iregion);
+      }
+      fp.write_bits(line_bits);
+      fp.write_char('\n');
+      icycle += run_length;
+    }
+    return status;
+  }
 
-  for (size_t ibit = 0; ibit < regional_bitstream_max_size; ++ibit) { 
-    for (const auto& region_bitstream : regional_bitstreams) {
-      fp << region_bitstream[ibit];
+  /* Each line contains the bits of all the regions at the same position */
+  for (size_t ibit = 0; ibit < regional_bitstreams.num_cycles(); ++ibit) { 
+    for (size_t iregion = 0; iregion < regional_bitstreams.num_regions(); ++iregion) {
+      line_bits[iregion] = regional_bitstreams.bit_value(ibit, iregion);
     }
-    fp << std::endl;
+    fp.write_bits(line_bits);
+    fp.write_char('\n');
   }
 
   return status;
@@ -144,26 +224,22 @@ int write_config_chain_fabric_bitstream_to_text_file(std::fstream& fp,
  *  - 1 if critical errors occured
  *******************************************************************/
 static 
-int write_memory_bank_fabric_bitstream_to_text_file(std::fstream& fp,
-                                                     const FabricBitstream& fabric_bitstream) {
+int write_memory_bank_fabric_bitstream_to_text_file(TextFileBuffer& fp,
+                                                     const FabricBitstreamByAddress& fabric_bits_by_addr) {
   int status = 0;
 
-  MemoryBankFabricBitstream fabric_bits_by_addr = build_memory_bank_fabric_bitstream_by_address(fabric_bitstream);
-
-  for (const auto& addr_din_pair : fabric_bits_by_addr) {
+  for (size_t iword = 0; iword < fabric_bits_by_addr.num_words(); ++iword) {
     /* Write BL address code */
-    fp << addr_din_pair.first.first;
-    fp << " ";
+    fp.write_string(fabric_bits_by_addr.word_address(iword));
+    fp.write_char(' ');
 
     /* Write WL address code */
-    fp << addr_din_pair.first.second;
-    fp << " ";
+    fp.write_string(fabric_bits_by_addr.word_wl_address(iword));
+    fp.write_char(' ');
 
     /* Write data input */
-    for (const bool& din_value : addr_din_pair.second) {
-      fp << din_value;
-    }
-    fp << std::endl;
+    fp.write_bits(fabric_bits_by_addr.word_dins(iword));
+    fp.write_char('\n');
   }
 
   return status;
@@ -178,22 +254,18 @@ int write_memory_bank_fabric_bitstream_to_text_file(std::fstream& fp,
  *  - 1 if critical errors occured
  *******************************************************************/
 static 
-int write_frame_based_fabric_bitstream_to_text_file(std::fstream& fp,
-                                                    const FabricBitstream& fabric_bitstream) {
+int write_frame_based_fabric_bitstream_to_text_file(TextFileBuffer& fp,
+                                                    const FabricBitstreamByAddress& fabric_bits_by_addr) {
   int status = 0;
 
-  FrameFabricBitstream fabric_bits_by_addr = build_frame_based_fabric_bitstream_by_address(fabric_bitstream);
-
-  for (const auto& addr_din_pair : fabric_bits_by_addr) {
+  for (size_t iword = 0; iword < fabric_bits_by_addr.num_words(); ++iword) {
     /* Write address code */
-    fp << addr_din_pair.first;
-    fp << " ";
+    fp.write_string(fabric_bits_by_addr.word_address(iword));
+    fp.write_char(' ');
 
     /* Write data input */
-    for (const bool& din_value : addr_din_pair.second) {
-      fp << din_value;
-    }
-    fp << std::endl;
+    fp.write_bits(fabric_bits_by_addr.word_dins(iword));
+    fp.write_char('\n');
   }
 
   return status;
@@ -213,44 +285,49 @@ int write_frame_based_fabric_bitstream_to_text_file(std::fstream& fp,
  *******************************************************************/
 int write_fabric_bitstream_to_text_file(const BitstreamManager& bitstream_manager,
                                         const FabricBitstream& fabric_bitstream,
+                                        const FabricBitstreamByAddress& fabric_bitstream_by_address,
                                         const ConfigProtocol& config_protocol,
                                         const std::string& fname,
+                                        const e_file_compression& compression,
                                         const bool& verbose) {
   /* Ensure that we have a valid file name */
   if (true == fname.empty()) {
     VTR_LOG_ERROR("Received empty file name to output bitstream!\n\tPlease specify a valid file name.\n");
   }
 
-  std::string timer_message = std::string("Write ") + std::to_string(fabric_bitstream.num_bits()) + std::string(" fabric bitstream into plain text file '") + fname + std::string("'");
+  std::string timer_message = std::string("Write ") + std::to_string(fabric_bitstream.num_bits()) + std::string(" fabric bitstream into plain text file '") + compressed_file_name(fname, compression) + std::string("'");
   vtr::ScopedStartFinishTimer timer(timer_message);
 
-  /* Create the file stream */
-  std::fstream fp;
-  fp.open(fname, std::fstream::out | std::fstream::trunc);
+  /* Create the file stream, which compresses the contents if required */
+  BufferedFileStream fp(fname, compression);
 
-  check_file_stream(fname.c_str(), fp);
+  check_file_stream(fp.file_name().c_str(), fp.stream());
+
+  /* All the contents go through a buffer, which is flushed to the file by large chunks */
+  TextFileBuffer fp_buffer(fp.stream());
 
   /* Output fabric bitstream to the file */
   int status = 0;
   switch (config_protocol.type()) {
   case CONFIG_MEM_STANDALONE: 
-    status = write_flatten_fabric_bitstream_to_text_file(fp,
+    status = write_flatten_fabric_bitstream_to_text_file(fp_buffer,
                                                          bitstream_manager,
                                                          fabric_bitstream,
                                                          config_protocol);
     break;
   case CONFIG_MEM_SCAN_CHAIN:
-    status = write_config_chain_fabric_bitstream_to_text_file(fp,
+    status = write_config_chain_fabric_bitstream_to_text_file(fp_buffer,
                                                               bitstream_manager,
-                                                              fabric_bitstream);
+                                                              fabric_bitstream,
+                                                              config_protocol);
     break;
   case CONFIG_MEM_MEMORY_BANK: 
-    status = write_memory_bank_fabric_bitstream_to_text_file(fp,
-                                                             fabric_bitstream);
+    status = write_memory_bank_fabric_bitstream_to_text_file(fp_buffer,
+                                                             fabric_bitstream_by_address);
     break;
   case CONFIG_MEM_FRAME_BASED:
-    status = write_frame_based_fabric_bitstream_to_text_file(fp,
-                                                             fabric_bitstream);
+    status = write_frame_based_fabric_bitstream_to_text_file(fp_buffer,
+                                                             fabric_bitstream_by_address);
     break;
   default:
     VTR_LOGF_ERROR(__FILE__, __LINE__,
@@ -260,7 +337,8 @@ int write_fabric_bitstream_to_text_file(const BitstreamManager& bitstream_manage
 
 
   /* Print an end to the file here */
-  fp << std::endl;
+  fp_buffer.write_char('\n');
+  fp_buffer.flush();
 
   /* Close file handler */
   fp.close();
@@ -268,9 +346,160 @@ int write_fabric_bitstream_to_text_file(const BitstreamManager& bitstream_manage
   VTR_LOGV(verbose,
            "Outputted %lu configuration bits to plain text file: %s\n",
            fabric_bitstream.bits().size(),
-           fname.c_str());
+           fp.file_name().c_str());
 
   return status;
 }
 
+
+/********************************************************************
+ * Read the words of a fabric bitstream from a plain text file
+ * which is written for a memory bank or a frame-based protocol:
+ * - Memory bank :  <BL address> <WL address> <data inputs>
+ * - Frame-based configuration protocol :  <address> <data inputs>
+ * The words are indexed by their addresses, where the BL and WL addresses
+ * are separated by a space
+ *
+ * Return:
+ *  - 0 if succeed
+ *  - 1 if critical errors occured
+ *******************************************************************/
+static 
+int read_fabric_bitstream_words_from_text_file(const std::string& fname,
+                                               const e_config_protocol_type& config_type,
+                                               std::unordered_map<std::string, std::string>& words) {
+  /* The reference may be compressed, as written by 'write_fabric_bitstream --compress' */
+  std::string contents;
+  if (false == read_file_contents(fname, contents)) {
+    VTR_LOG_ERROR("Unable to open reference bitstream file '%s'!\n",
+                  fname.c_str());
+    return 1;
+  }
+  std::istringstream fp(contents);
+
+  size_t num_addresses = (CONFIG_MEM_MEMORY_BANK == config_type) ? 2 : 1;
+
+  std::string line;
+  size_t line_num = 0;
+  while (std::getline(fp, line)) {
+    line_num++;
+    std::istringstream line_stream(line);
+    std::vector<std::string> tokens;
+    std::string token;
+    while (line_stream >> token) {
+      tokens.push_back(token);
+    }
+    /* Skip empty lines, e.g., the end of the file */
+    if (true == tokens.empty()) {
+      continue;
+    }
+    if (num_addresses + 1 != tokens.size()) {
+      VTR_LOG_ERROR("Invalid line %lu in reference bitstream file '%s', which should contain %lu addresses and the data inputs!\n",
+                    line_num, fname.c_str(), num_addresses);
+      return 1;
+    }
+    std::string address = tokens[0];
+    if (2 == num_addresses) {
+      address += std::string(" ") + tokens[1];
+    }
+    words[address] = tokens.back();
+  }
+
+  return 0;
+}
+
+/********************************************************************
+ * Write the words of a fabric bitstream which differ from a reference
+ * fabric bitstream to a plain text file, so that only the changed words
+ * are loaded when reprogramming an FPGA which has been configured
+ * by the reference bitstream.
+ * The reference bitstream is a plain text file written for the same fabric,
+ * and the output file is in the same format.
+ * Only the configuration protocols where words are addressed are supported,
+ * i.e., memory banks and frame-based protocols
+ *
+ * Return:
+ *  - 0 if succeed
+ *  - 1 if critical errors occured
+ *******************************************************************/
+int write_fabric_bitstream_diff_to_text_file(const FabricBitstreamByAddress& fabric_bitstream_by_address,
+                                             const ConfigProtocol& config_protocol,
+                                             const std::string& reference_fname,
+                                             const std::string& fname,
+                                             const bool& verbose) {
+  if ( (CONFIG_MEM_MEMORY_BANK != config_protocol.type())
+    && (CONFIG_MEM_FRAME_BASED != config_protocol.type()) ) {
+    VTR_LOG_ERROR("Differential bitstream is only applicable to memory bank and frame-based configuration protocols!\n");
+    return 1;
+  }
+
+  std::string timer_message = std::string("Write differential fabric bitstream against '") + reference_fname + std::string("' into plain text file '") + fname + std::string("'");
+  vtr::ScopedStartFinishTimer timer(timer_message);
+
+  std::unordered_map<std::string, std::string> reference_words;
+  if (0 != read_fabric_bitstream_words_from_text_file(reference_fname, config_protocol.type(), reference_words)) {
+    return 1;
+  }
+
+  /* Create the file stream */
+  std::fstream fp;
+  fp.open(fname, std::fstream::out | std::fstream::trunc);
+
+  check_file_stream(fname.c_str(), fp);
+
+  TextFileBuffer fp_buffer(fp);
+
+  size_t num_diff_words = 0;
+  size_t num_ref_words_found = 0;
+  std::string word_dins;
+  for (size_t iword = 0; iword < fabric_bitstream_by_address.num_words(); ++iword) {
+    std::string address = fabric_bitstream_by_address.word_address(iword);
+    if (CONFIG_MEM_MEMORY_BANK == config_protocol.type()) {
+      address += std::string(" ") + fabric_bitstream_by_address.word_wl_address(iword);
+    }
+
+    std::vector<bool> dins = fabric_bitstream_by_address.word_dins(iword);
+    word_dins.resize(dins.size());
+    for (size_t ibit = 0; ibit < dins.size(); ++ibit) {
+      word_dins[ibit] = dins[ibit] ? '1' : '0';
+    }
+
+    /* Skip the words which are the same as the reference */
+    auto result = reference_words.find(address);
+    if (result != reference_words.end()) {
+      num_ref_words_found++;
+      if (result->second == word_dins) {
+        continue;
+      }
+    }
+
+    fp_buffer.write_string(address);
+    fp_buffer.write_char(' ');
+    fp_buffer.write_string(word_dins);
+    fp_buffer.write_char('\n');
+    num_diff_words++;
+  }
+
+  /* Print an end to the file here */
+  fp_buffer.write_char('\n');
+  fp_buffer.flush();
+
+  /* Close file handler */
+  fp.close();
+
+  if (num_ref_words_found != reference_words.size()) {
+    VTR_LOG_WARN("%lu words of reference bitstream '%s' are not found in the fabric bitstream. The reference may be written for another fabric\n",
+                 reference_words.size() - num_ref_words_found,
+                 reference_fname.c_str());
+  }
+
+  VTR_LOGV(verbose,
+           "Outputted %lu out of %lu words which differ from the reference to plain text file: %s\n",
+           num_diff_words,
+           fabric_bitstream_by_address.num_words(),
+           fname.c_str());
+
+  return 0;
+}
+
 } /* end namespace openfpga */
@@ -8,7 +8,9 @@
 #include <vector>
 #include "bitstream_manager.h"
 #include "fabric_bitstream.h"
+#include "fabric_bitstream_by_address.h"
 #include "config_protocol.h"
+#include "openfpga_compressed_stream.h"
 
 /********************************************************************
  * Function declaration
@@ -19,10 +21,18 @@ namespace openfpga {
 
 int write_fabric_bitstream_to_text_file(const BitstreamManager& bitstream_manager,
                                         const FabricBitstream& fabric_bitstream,
+                                        const FabricBitstreamByAddress& fabric_bitstream_by_address,
                                         const ConfigProtocol& config_protocol,
                                         const std::string& fname,
+                                        const e_file_compression& compression,
                                         const bool& verbose);
 
+int write_fabric_bitstream_diff_to_text_file(const FabricBitstreamByAddress& fabric_bitstream_by_address,
+                                             const ConfigProtocol& config_protocol,
+                                             const std::string& reference_fname,
+                                             const std::string& fname,
+                                             const bool& verbose);
+
 } /* end namespace openfpga */
 
 #endif
@@ -13,6 +13,7 @@
 
 /* Headers from openfpgautil library */
 #include "openfpga_digest.h"
+#include "openfpga_buffered_file_stream.h"
 
 /* Headers from archopenfpga library */
 
@@ -43,8 +44,59 @@ void write_fabric_bitstream_xml_file_head(std::fstream& fp) {
   fp << std::endl;
 }
 
+/* Size of the output buffer, above which the buffer is written to the file */
+constexpr size_t XML_FABRIC_BITSTREAM_BUFFER_SIZE = 1 << 20;
+
+/********************************************************************
+ * Find the hierarchical path prefix of each block, i.e., the names of
+ * the block and all its parent blocks separated by dots, and the first
+ * configuration bit of each block, by walking the block tree once top-down
+ * The prefix of a block is built from the prefix of its parent,
+ * so that the hierarchy is not traversed again for each configuration bit
+ *******************************************************************/
+static 
+void rec_find_bitstream_block_path_prefixes(const BitstreamManager& bitstream_manager,
+                                            const ConfigBlockId& block,
+                                            const std::string& parent_prefix,
+                                            vtr::vector<ConfigBlockId, std::string>& block_path_prefixes,
+                                            vtr::vector<ConfigBlockId, size_t>& block_first_bits) {
+  std::string block_prefix = parent_prefix + bitstream_manager.block_name(block) + std::string(".");
+
+  /* Only the blocks which contain bits are output, so store the prefixes of them only */
+  std::vector<ConfigBitId> block_bits = bitstream_manager.block_bits(block);
+  if (false == block_bits.empty()) {
+    block_path_prefixes[block] = block_prefix;
+    block_first_bits[block] = size_t(block_bits.front());
+  }
+
+  for (const ConfigBlockId& child_block : bitstream_manager.block_children(block)) {
+    rec_find_bitstream_block_path_prefixes(bitstream_manager, child_block,
+                                           block_prefix,
+                                           block_path_prefixes,
+                                           block_first_bits);
+  }
+}
+
 /********************************************************************
- * Write a configuration bit into a plain text file
+ * Write the address of a configuration bit to a buffer
+ *******************************************************************/
+static 
+void write_fabric_bit_address_to_xml_buffer(std::string& buffer,
+                                            const char* address_tag,
+                                            const FabricBitAddressView& address,
+                                            const int& xml_hierarchy_depth) {
+  buffer.append(xml_hierarchy_depth, '\t');
+  buffer += '<';
+  buffer += address_tag;
+  buffer += " address=\"";
+  for (const char addr_bit : address) {
+    buffer += addr_bit;
+  }
+  buffer += "\"/>\n";
+}
+
+/********************************************************************
+ * Write a configuration bit into a buffer of XML file
  * General format
  *   <bit id="<fabric_bit>" value="<config_bit_value>">
  *     <hierarchy>
@@ -61,43 +113,39 @@ void write_fabric_bitstream_xml_file_head(std::fstream& fp) {
  *     <wl address="<wl_address_value>"/>
  * - Frame-based configuration protocol :
  *     <frame address="<frame_address_value>"/>
+ *     <din index="<index_in_frame>"/>, only when each frame loads multiple bits
  *
  * Return:
  *  - 0 if succeed
  *  - 1 if critical errors occured
  *******************************************************************/
 static 
-int write_fabric_config_bit_to_xml_file(std::fstream& fp,
-                                        const BitstreamManager& bitstream_manager,
-                                        const FabricBitstream& fabric_bitstream,
-                                        const FabricBitId& fabric_bit,
-                                        const e_config_protocol_type& config_type,
-                                        const int& xml_hierarchy_depth) {
-  if (false == valid_file_stream(fp)) {
-    return 1;
-  }
-
-  write_tab_to_file(fp, xml_hierarchy_depth);
-  fp << "<bit id=\"" << size_t(fabric_bit) << "\"";
-  fp << " value=\"";
-  fp << bitstream_manager.bit_value(fabric_bitstream.config_bit(fabric_bit));
-  fp << "\"";
-
-  /* Output hierarchy of this parent*/
+int write_fabric_config_bit_to_xml_buffer(std::string& buffer,
+                                          const BitstreamManager& bitstream_manager,
+                                          const FabricBitstream& fabric_bitstream,
+                                          const FabricBitId& fabric_bit,
+                                          const e_config_protocol_type& config_type,
+                                          const vtr::vector<ConfigBlockId, std::string>& block_path_prefixes,
+                                          const vtr::vector<ConfigBlockId, size_t>& block_first_bits,
+                                          const std::string& mem_out_name,
+                                          const int& xml_hierarchy_depth) {
   const ConfigBitId& config_bit = fabric_bitstream.config_bit(fabric_bit);
   const ConfigBlockId& config_block = bitstream_manager.bit_parent_block(config_bit);
-  std::vector<ConfigBlockId> block_hierarchy = find_bitstream_manager_block_hierarchy(bitstream_manager, config_block); 
-  std::string hie_path;
-  for (const ConfigBlockId& temp_block : block_hierarchy) {
-    hie_path += bitstream_manager.block_name(temp_block);
-    hie_path += std::string(".");
-  }
-  hie_path += generate_configurable_memory_data_out_name();
-  hie_path += std::string("[");
-  hie_path += std::to_string(find_bitstream_manager_config_bit_index_in_parent_block(bitstream_manager, config_bit));
-  hie_path += std::string("]");
 
-  fp << " path=\"" << hie_path << "\">\n";
+  buffer.append(xml_hierarchy_depth, '\t');
+  buffer += "<bit id=\"";
+  buffer += std::to_string(size_t(fabric_bit));
+  buffer += "\" value=\"";
+  buffer += (true == bitstream_manager.bit_value(config_bit)) ? '1' : '0';
+  buffer += "\"";
+
+  /* Output hierarchy of this parent*/
+  buffer += " path=\"";
+  buffer += block_path_prefixes[config_block];
+  buffer += mem_out_name;
+  buffer += '[';
+  buffer += std::to_string(size_t(config_bit) - block_first_bits[config_block]);
+  buffer += "]\">\n";
 
   switch (config_type) {
   case CONFIG_MEM_STANDALONE: 
@@ -105,28 +153,20 @@ int write_fabric_config_bit_to_xml_file(std::fstream& fp,
     break;
   case CONFIG_MEM_MEMORY_BANK: { 
     /* Bit line address */
-    write_tab_to_file(fp, xml_hierarchy_depth + 1);
-    fp << "<bl address=\"";
-    for (const char& addr_bit : fabric_bitstream.bit_bl_address(fabric_bit)) {
-      fp << addr_bit;
-    }
-    fp << "\"/>\n";   
- 
-    write_tab_to_file(fp, xml_hierarchy_depth + 1);
-    fp << "<wl address=\"";
-    for (const char& addr_bit : fabric_bitstream.bit_wl_address(fabric_bit)) {
-      fp << addr_bit;
-    }
-    fp << "\"/>\n";   
+    write_fabric_bit_address_to_xml_buffer(buffer, "bl", fabric_bitstream.bit_bl_address(fabric_bit), xml_hierarchy_depth + 1);
+    /* Word line address */
+    write_fabric_bit_address_to_xml_buffer(buffer, "wl", fabric_bitstream.bit_wl_address(fabric_bit), xml_hierarchy_depth + 1);
     break;
   }
   case CONFIG_MEM_FRAME_BASED: {
-    write_tab_to_file(fp, xml_hierarchy_depth + 1);
-    fp << "<frame address=\"";
-    for (const char& addr_bit : fabric_bitstream.bit_address(fabric_bit)) {
-      fp << addr_bit;
+    write_fabric_bit_address_to_xml_buffer(buffer, "frame", fabric_bitstream.bit_address(fabric_bit), xml_hierarchy_depth + 1);
+    /* Index of the bit in the frame, when each frame loads multiple bits */
+    if (1 < fabric_bitstream.data_width()) {
+      buffer.append(xml_hierarchy_depth + 1, '\t');
+      buffer += "<din index=\"";
+      buffer += std::to_string(fabric_bitstream.bit_din_index(fabric_bit));
+      buffer += "\"/>\n";
     }
-    fp << "\"/>\n";   
     break;
   }
   default:
@@ -135,14 +175,16 @@ int write_fabric_config_bit_to_xml_file(std::fstream& fp,
     return 1;
   }
 
-  write_tab_to_file(fp, xml_hierarchy_depth);
-  fp << "</bit>\n";
+  buffer.append(xml_hierarchy_depth, '\t');
+  buffer += "</bit>\n";
 
   return 0;
 }
 
 /********************************************************************
  * Write the fabric bitstream in a specific configuration region to an XML file 
+ * The bits are formatted in a buffer, which is written to the file
+ * whenever it is full
  *
  * Return:
  *  - 0 if succeed
@@ -154,6 +196,8 @@ int write_fabric_regional_config_bit_to_xml_file(std::fstream& fp,
                                                  const FabricBitstream& fabric_bitstream,
                                                  const FabricBitRegionId& fabric_region,
                                                  const e_config_protocol_type& config_type,
+                                                 const vtr::vector<ConfigBlockId, std::string>& block_path_prefixes,
+                                                 const vtr::vector<ConfigBlockId, size_t>& block_first_bits,
                                                  const int& xml_hierarchy_depth) {
   if (false == valid_file_stream(fp)) {
     return 1;
@@ -168,16 +212,28 @@ int write_fabric_regional_config_bit_to_xml_file(std::fstream& fp,
   fp << "\"";
   fp << ">\n";
 
+  const std::string mem_out_name = generate_configurable_memory_data_out_name();
+
+  std::string buffer;
+  buffer.reserve(2 * XML_FABRIC_BITSTREAM_BUFFER_SIZE);
   for (const FabricBitId& fabric_bit : fabric_bitstream.region_bits(fabric_region)) {
-    status = write_fabric_config_bit_to_xml_file(fp, bitstream_manager,
-                                                 fabric_bitstream,
-                                                 fabric_bit,
-                                                 config_type,
-                                                 xml_hierarchy_depth + 1);
+    status = write_fabric_config_bit_to_xml_buffer(buffer, bitstream_manager,
+                                                   fabric_bitstream,
+                                                   fabric_bit,
+                                                   config_type,
+                                                   block_path_prefixes,
+                                                   block_first_bits,
+                                                   mem_out_name,
+                                                   xml_hierarchy_depth + 1);
     if (1 == status) {
       return status;
     }
+    if (XML_FABRIC_BITSTREAM_BUFFER_SIZE <= buffer.size()) {
+      fp.write(buffer.data(), buffer.size());
+      buffer.clear();
+    }
   }
+  fp.write(buffer.data(), buffer.size());
 
   write_tab_to_file(fp, xml_hierarchy_depth);
   fp << "</region>\n";
@@ -200,24 +256,35 @@ int write_fabric_bitstream_to_xml_file(const BitstreamManager& bitstream_manager
                                        const FabricBitstream& fabric_bitstream,
                                        const ConfigProtocol& config_protocol,
                                        const std::string& fname,
+                                       const e_file_compression& compression,
                                        const bool& verbose) {
   /* Ensure that we have a valid file name */
   if (true == fname.empty()) {
     VTR_LOG_ERROR("Received empty file name to output bitstream!\n\tPlease specify a valid file name.\n");
   }
 
-  std::string timer_message = std::string("Write ") + std::to_string(fabric_bitstream.num_bits()) + std::string(" fabric bitstream into xml file '") + fname + std::string("'");
+  std::string timer_message = std::string("Write ") + std::to_string(fabric_bitstream.num_bits()) + std::string(" fabric bitstream into xml file '") + compressed_file_name(fname, compression) + std::string("'");
   vtr::ScopedStartFinishTimer timer(timer_message);
 
-  /* Create the file stream */
-  std::fstream fp;
-  fp.open(fname, std::fstream::out | std::fstream::trunc);
+  /* Create the file stream, which compresses the contents if required */
+  BufferedFileStream fp_stream(fname, compression);
+  std::fstream& fp = fp_stream.stream();
 
-  check_file_stream(fname.c_str(), fp);
+  check_file_stream(fp_stream.file_name().c_str(), fp);
 
   /* Write XML head */
   write_fabric_bitstream_xml_file_head(fp);
 
+  /* Find the path prefixes of all the blocks in one pass */
+  vtr::vector<ConfigBlockId, std::string> block_path_prefixes(bitstream_manager.num_blocks());
+  vtr::vector<ConfigBlockId, size_t> block_first_bits(bitstream_manager.num_blocks(), 0);
+  for (const ConfigBlockId& top_block : find_bitstream_manager_top_blocks(bitstream_manager)) {
+    rec_find_bitstream_block_path_prefixes(bitstream_manager, top_block,
+                                           std::string(),
+                                           block_path_prefixes,
+                                           block_first_bits);
+  }
+
   int xml_hierarchy_depth = 0;
   fp << "<fabric_bitstream>\n";
 
@@ -228,6 +295,8 @@ int write_fabric_bitstream_to_xml_file(const BitstreamManager& bitstream_manager
                                                           fabric_bitstream,
                                                           region,
                                                           config_protocol.type(),
+                                                          block_path_prefixes,
+                                                          block_first_bits,
                                                           xml_hierarchy_depth + 1);
     if (1 == status) {
       break;
@@ -238,12 +307,12 @@ int write_fabric_bitstream_to_xml_file(const BitstreamManager& bitstream_manager
   fp << "</fabric_bitstream>\n";
 
   /* Close file handler */
-  fp.close();
+  fp_stream.close();
 
   VTR_LOGV(verbose,
            "Outputted %lu configuration bits to XML file: %s\n",
            fabric_bitstream.bits().size(),
-           fname.c_str());
+           fp_stream.file_name().c_str());
 
   return status;
 }
@@ -9,6 +9,7 @@
 #include "bitstream_manager.h"
 #include "fabric_bitstream.h"
 #include "config_protocol.h"
+#include "openfpga_compressed_stream.h"
 
 /********************************************************************
  * Function declaration
@@ -21,6 +22,7 @@ int write_fabric_bitstream_to_xml_file(const BitstreamManager& bitstream_manager
                                        const FabricBitstream& fabric_bitstream,
                                        const ConfigProtocol& config_protocol,
                                        const std::string& fname,
+                                       const e_file_compression& compression,
                                        const bool& verbose);
 
 } /* end namespace openfpga */
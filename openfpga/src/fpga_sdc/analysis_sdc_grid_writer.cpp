@@ -19,6 +19,7 @@
 #include "openfpga_device_grid_utils.h"
 
 #include "sdc_writer_utils.h" 
+#include "sdc_disable_timing_buffer.h" 
 #include "analysis_sdc_writer_utils.h" 
 #include "analysis_sdc_grid_writer.h" 
 
@@ -91,16 +92,13 @@ void rec_print_analysis_sdc_disable_unused_pb_graph_nodes(std::fstream& fp,
  * Disable an unused pin of a pb_graph_node (parent_module) 
  *******************************************************************/
 static
-void disable_pb_graph_node_unused_pin(std::fstream& fp, 
+void disable_pb_graph_node_unused_pin(SdcDisableTimingBuffer& disable_timing_buffer, 
                                       const ModuleManager& module_manager,
                                       const ModuleId& parent_module,
                                       const std::string& hierarchy_name,
                                       const t_pb_graph_pin* pb_graph_pin,
                                       const PhysicalPb& physical_pb,
                                       const PhysicalPbId& pb_id) {
-  /* Validate file stream */
-  valid_file_stream(fp);
-    
   /* Identify if the pb_graph_pin has been used or not
    * TODO: identify if this is a parasitic net
    */ 
@@ -117,10 +115,7 @@ void disable_pb_graph_node_unused_pin(std::fstream& fp,
   BasicPort port_to_disable = module_manager.module_port(parent_module, module_port);
   port_to_disable.set_width(pb_graph_pin->pin_number, pb_graph_pin->pin_number);
 
-  fp << "set_disable_timing ";
-  fp << hierarchy_name; 
-  fp << generate_sdc_port(port_to_disable);
-  fp << std::endl;
+  disable_timing_buffer.add_port(hierarchy_name, port_to_disable);
 }
 
 /********************************************************************
@@ -136,7 +131,8 @@ void disable_pb_graph_node_unused_pins(std::fstream& fp,
                                        const ModuleId& parent_module,
                                        const std::string& hierarchy_name,
                                        t_pb_graph_node* physical_pb_graph_node,
-                                       const PhysicalPb& physical_pb) {
+                                       const PhysicalPb& physical_pb,
+                                       const bool& group_ports) {
   const PhysicalPbId& pb_id = physical_pb.find_pb(physical_pb_graph_node);
   VTR_ASSERT(true == physical_pb.valid_pb_id(pb_id));
 
@@ -144,10 +140,13 @@ void disable_pb_graph_node_unused_pins(std::fstream& fp,
   fp << "# Disable unused pins for pb_graph_node " << physical_pb_graph_node->pb_type->name << "[" << physical_pb_graph_node->placement_index << "]" << std::endl;
   fp << "#######################################" << std::endl; 
 
+  /* Buffer the pins to disable, so that they can be grouped into buses */
+  SdcDisableTimingBuffer disable_timing_buffer(fp, group_ports);
+
   /* Disable unused input pins */
   for (int iport = 0; iport < physical_pb_graph_node->num_input_ports; ++iport) {
     for (int ipin = 0; ipin < physical_pb_graph_node->num_input_pins[iport]; ++ipin) {
-      disable_pb_graph_node_unused_pin(fp, module_manager, parent_module,
+      disable_pb_graph_node_unused_pin(disable_timing_buffer, module_manager, parent_module,
                                        hierarchy_name,
                                        &(physical_pb_graph_node->input_pins[iport][ipin]),
                                        physical_pb, pb_id);
@@ -157,7 +156,7 @@ void disable_pb_graph_node_unused_pins(std::fstream& fp,
   /* Disable unused output pins */
   for (int iport = 0; iport < physical_pb_graph_node->num_output_ports; ++iport) {
     for (int ipin = 0; ipin < physical_pb_graph_node->num_output_pins[iport]; ++ipin) {
-      disable_pb_graph_node_unused_pin(fp, module_manager, parent_module,
+      disable_pb_graph_node_unused_pin(disable_timing_buffer, module_manager, parent_module,
                                        hierarchy_name,
                                        &(physical_pb_graph_node->output_pins[iport][ipin]),
                                        physical_pb, pb_id);
@@ -167,12 +166,14 @@ void disable_pb_graph_node_unused_pins(std::fstream& fp,
   /* Disable unused clock pins */
   for (int iport = 0; iport < physical_pb_graph_node->num_clock_ports; ++iport) {
     for (int ipin = 0; ipin < physical_pb_graph_node->num_clock_pins[iport]; ++ipin) {
-      disable_pb_graph_node_unused_pin(fp, module_manager, parent_module,
+      disable_pb_graph_node_unused_pin(disable_timing_buffer, module_manager, parent_module,
                                        hierarchy_name,
                                        &(physical_pb_graph_node->clock_pins[iport][ipin]),
                                        physical_pb, pb_id);
     }
   }
+
+  disable_timing_buffer.flush();
 }
 
 /********************************************************************
@@ -187,12 +188,16 @@ void disable_pb_graph_node_unused_mux_inputs(std::fstream& fp,
                                              const ModuleId& parent_module,
                                              const std::string& hierarchy_name,
                                              t_pb_graph_node* physical_pb_graph_node,
-                                             const PhysicalPb& physical_pb) {
+                                             const PhysicalPb& physical_pb,
+                                             const bool& group_ports) {
 
   fp << "#######################################" << std::endl; 
   fp << "# Disable unused mux_inputs for pb_graph_node " << physical_pb_graph_node->pb_type->name << "[" << physical_pb_graph_node->placement_index << "]" << std::endl;
   fp << "#######################################" << std::endl; 
 
+  /* Buffer the pins to disable, so that they can be grouped into buses */
+  SdcDisableTimingBuffer disable_timing_buffer(fp, group_ports);
+
   t_pb_type* physical_pb_type = physical_pb_graph_node->pb_type;
 
   t_mode* physical_mode = device_annotation.physical_mode(physical_pb_type);
@@ -261,7 +266,7 @@ void disable_pb_graph_node_unused_mux_inputs(std::fstream& fp,
         continue;
       }
 
-      disable_analysis_module_input_pin_net_sinks(fp, module_manager, parent_module,
+      disable_analysis_module_input_pin_net_sinks(disable_timing_buffer, module_manager, parent_module,
                                                   hierarchy_name,
                                                   module_port, ipin,
                                                   mapped_net,
@@ -287,7 +292,7 @@ void disable_pb_graph_node_unused_mux_inputs(std::fstream& fp,
         continue;
       }
 
-      disable_analysis_module_input_pin_net_sinks(fp, module_manager, parent_module,
+      disable_analysis_module_input_pin_net_sinks(disable_timing_buffer, module_manager, parent_module,
                                                   hierarchy_name,
                                                   module_port, ipin,
                                                   mapped_net,
@@ -322,7 +327,7 @@ void disable_pb_graph_node_unused_mux_inputs(std::fstream& fp,
             continue;
           }
 
-          disable_analysis_module_output_pin_net_sinks(fp, module_manager, parent_module,
+          disable_analysis_module_output_pin_net_sinks(disable_timing_buffer, module_manager, parent_module,
                                                        hierarchy_name,
                                                        child_module, inst, 
                                                        module_port, ipin,
@@ -332,6 +337,8 @@ void disable_pb_graph_node_unused_mux_inputs(std::fstream& fp,
       }
     }
   }
+
+  disable_timing_buffer.flush();
 }
 
 /********************************************************************
@@ -397,12 +404,14 @@ void rec_print_analysis_sdc_disable_pb_graph_node_unused_resources(std::fstream&
                                                                    const ModuleId& parent_module,
                                                                    const std::string& hierarchy_name,
                                                                    t_pb_graph_node* physical_pb_graph_node,
-                                                                   const PhysicalPb& physical_pb) {
+                                                                   const PhysicalPb& physical_pb,
+                                                                   const bool& group_ports) {
   t_pb_type* physical_pb_type = physical_pb_graph_node->pb_type;
 
   /* Disable unused input ports and output ports of this pb_graph_node (parent_module) */
   disable_pb_graph_node_unused_pins(fp, module_manager, parent_module,
-                                    hierarchy_name, physical_pb_graph_node, physical_pb); 
+                                    hierarchy_name, physical_pb_graph_node, physical_pb,
+                                    group_ports); 
 
   /* Return if this is the primitive pb_type 
    * Note: this must return before we disable any unused inputs of routing multiplexer!
@@ -416,7 +425,7 @@ void rec_print_analysis_sdc_disable_pb_graph_node_unused_resources(std::fstream&
   disable_pb_graph_node_unused_mux_inputs(fp, device_annotation,
                                           module_manager, parent_module, 
                                           hierarchy_name, physical_pb_graph_node,
-                                          physical_pb);
+                                          physical_pb, group_ports);
 
 
   t_mode* physical_mode = device_annotation.physical_mode(physical_pb_type);
@@ -440,7 +449,7 @@ void rec_print_analysis_sdc_disable_pb_graph_node_unused_resources(std::fstream&
       rec_print_analysis_sdc_disable_pb_graph_node_unused_resources(fp, device_annotation,
                                                                     module_manager, child_module, updated_hierarchy_name, 
                                                                     &(physical_pb_graph_node->child_pb_graph_nodes[physical_mode->index][ichild][inst]), 
-                                                                    physical_pb); 
+                                                                    physical_pb, group_ports); 
     }
   }
 }
@@ -471,7 +480,8 @@ void print_analysis_sdc_disable_pb_block_unused_resources(std::fstream& fp,
                                                           const std::string& grid_instance_name,
                                                           const size_t& grid_z,
                                                           const PhysicalPb& physical_pb,
-                                                          const bool& unused_block) {
+                                                          const bool& unused_block,
+                                                          const bool& group_ports) {
   /* If the block is partially unused, we should have a physical pb */
   if (false == unused_block) {
     VTR_ASSERT(false == physical_pb.empty());
@@ -514,7 +524,7 @@ void print_analysis_sdc_disable_pb_block_unused_resources(std::fstream& fp,
     VTR_ASSERT_SAFE(false == unused_block);
     rec_print_analysis_sdc_disable_pb_graph_node_unused_resources(fp, device_annotation,
                                                                   module_manager, pb_module, hierarchy_name,
-                                                                  pb_graph_head, physical_pb); 
+                                                                  pb_graph_head, physical_pb, group_ports); 
   }
 }
 
@@ -531,7 +541,8 @@ void print_analysis_sdc_disable_unused_grid(std::fstream& fp,
                                             const VprClusteringAnnotation& cluster_annotation,
                                             const VprPlacementAnnotation& place_annotation,
                                             const ModuleManager& module_manager,
-                                            const e_side& border_side) {
+                                            const e_side& border_side,
+                                            const bool& group_ports) {
   /* Validate file stream */
   valid_file_stream(fp);
 
@@ -573,14 +584,14 @@ void print_analysis_sdc_disable_unused_grid(std::fstream& fp,
       print_analysis_sdc_disable_pb_block_unused_resources(fp, grid_type, grid_coordinate,
                                                            device_annotation,
                                                            module_manager, grid_instance_name, grid_z,
-                                                           physical_pb, false);
+                                                           physical_pb, false, group_ports);
     } else {
       VTR_ASSERT(ClusterBlockId::INVALID() == blk_id);
       /* For unused grid, disable all the pins in the physical_pb_type */
       print_analysis_sdc_disable_pb_block_unused_resources(fp, grid_type, grid_coordinate,
                                                            device_annotation, 
                                                            module_manager, grid_instance_name, grid_z,
-                                                           PhysicalPb(), true);
+                                                           PhysicalPb(), true, group_ports);
     }
     grid_z++;
   }
@@ -613,14 +624,15 @@ void print_analysis_sdc_disable_unused_grids(std::fstream& fp,
                                              const VprDeviceAnnotation& device_annotation,
                                              const VprClusteringAnnotation& cluster_annotation,
                                              const VprPlacementAnnotation& place_annotation,
-                                             const ModuleManager& module_manager) {
+                                             const ModuleManager& module_manager,
+                                             const bool& group_ports) {
 
   /* Process unused core grids */
   for (size_t ix = 1; ix < grids.width() - 1; ++ix) {
     for (size_t iy = 1; iy < grids.height() - 1; ++iy) {
       print_analysis_sdc_disable_unused_grid(fp, vtr::Point<size_t>(ix, iy),
                                              grids, device_annotation, cluster_annotation, place_annotation,
-                                             module_manager, NUM_SIDES);
+                                             module_manager, NUM_SIDES, group_ports);
     }
   }
 
@@ -633,7 +645,7 @@ void print_analysis_sdc_disable_unused_grids(std::fstream& fp,
     for (const vtr::Point<size_t>& io_coordinate : io_coordinates[io_side]) {
       print_analysis_sdc_disable_unused_grid(fp, io_coordinate,
                                              grids, device_annotation, cluster_annotation, place_annotation,
-                                             module_manager, io_side);
+                                             module_manager, io_side, group_ports);
     }
   }
 }
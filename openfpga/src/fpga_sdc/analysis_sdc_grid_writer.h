@@ -24,7 +24,8 @@ void print_analysis_sdc_disable_unused_grids(std::fstream& fp,
                                              const VprDeviceAnnotation& device_annotation,
                                              const VprClusteringAnnotation& cluster_annotation,
                                              const VprPlacementAnnotation& place_annotation,
-                                             const ModuleManager& module_manager);
+                                             const ModuleManager& module_manager,
+                                             const bool& group_ports);
 
 } /* end namespace openfpga */
 
@@ -12,6 +12,7 @@ namespace openfpga {
 AnalysisSdcOption::AnalysisSdcOption(const std::string& sdc_dir) {
   sdc_dir_ = sdc_dir;
   flatten_names_ = false;
+  group_ports_ = false;
   time_unit_ = 1.;
   generate_sdc_analysis_ = false;
 }
@@ -27,6 +28,10 @@ bool AnalysisSdcOption::flatten_names() const {
   return flatten_names_;
 }
 
+bool AnalysisSdcOption::group_ports() const {
+  return group_ports_;
+}
+
 float AnalysisSdcOption::time_unit() const {
   return time_unit_;
 }
@@ -46,6 +51,10 @@ void AnalysisSdcOption::set_flatten_names(const bool& flatten_names) {
   flatten_names_ = flatten_names;
 }
 
+void AnalysisSdcOption::set_group_ports(const bool& group_ports) {
+  group_ports_ = group_ports;
+}
+
 void AnalysisSdcOption::set_time_unit(const float& time_unit) {
   time_unit_ = time_unit;
 }
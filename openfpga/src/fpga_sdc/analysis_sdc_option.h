@@ -17,17 +17,20 @@ class AnalysisSdcOption {
   public: /* Public accessors */
     std::string sdc_dir() const;
     bool flatten_names() const;
+    bool group_ports() const;
     float time_unit() const;
     bool generate_sdc_analysis() const;
   public: /* Public mutators */
     void set_sdc_dir(const std::string& sdc_dir);
     void set_flatten_names(const bool& flatten_names);
+    void set_group_ports(const bool& group_ports);
     void set_time_unit(const float& time_unit);
     void set_generate_sdc_analysis(const bool& generate_sdc_analysis);
   private: /* Internal data */
     std::string sdc_dir_;
     bool generate_sdc_analysis_; 
     bool flatten_names_; 
+    bool group_ports_; 
     float time_unit_;
 };
 
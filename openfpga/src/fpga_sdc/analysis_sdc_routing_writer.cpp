@@ -18,6 +18,7 @@
 
 #include "build_routing_module_utils.h"
 #include "sdc_writer_utils.h"
+#include "sdc_disable_timing_buffer.h"
 #include "analysis_sdc_writer_utils.h"
 #include "analysis_sdc_routing_writer.h"
 
@@ -34,14 +35,14 @@ static
 void print_analysis_sdc_disable_cb_unused_resources(std::fstream& fp, 
                                                     const AtomContext& atom_ctx, 
                                                     const ModuleManager& module_manager, 
-                                                    const VprDeviceAnnotation& device_annotation, 
-                                                    const DeviceGrid& grids, 
+                                                    const DeviceRRGSBModulePorts& gsb_module_ports, 
                                                     const RRGraph& rr_graph, 
                                                     const VprRoutingAnnotation& routing_annotation, 
                                                     const DeviceRRGSB& device_rr_gsb,
                                                     const RRGSB& rr_gsb, 
                                                     const t_rr_type& cb_type,
-                                                    const bool& compact_routing_hierarchy) {
+                                                    const bool& compact_routing_hierarchy,
+                                                    const bool& group_ports) {
   /* Validate file stream */
   valid_file_stream(fp);
 
@@ -59,6 +60,11 @@ void print_analysis_sdc_disable_cb_unused_resources(std::fstream& fp,
     cb_coordinate.set_y(unique_mirror.get_cb_y(cb_type)); 
   }
 
+  /* The ports of the module are resolved from the GSB which the module is built from */
+  const RRGSB& module_gsb = (true == compact_routing_hierarchy)
+                          ? device_rr_gsb.get_cb_unique_module(cb_type, vtr::Point<size_t>(rr_gsb.get_x(), rr_gsb.get_y()))
+                          : rr_gsb;
+
   std::string cb_module_name = generate_connection_block_module_name(cb_type, cb_coordinate);
 
   ModuleId cb_module = module_manager.find_module(cb_module_name);
@@ -69,6 +75,9 @@ void print_analysis_sdc_disable_cb_unused_resources(std::fstream& fp,
   fp << "# Disable timing for Connection block " << cb_module_name << std::endl;
   fp << "##################################################" << std::endl; 
 
+  /* Buffer the pins to disable, so that they can be grouped into buses */
+  SdcDisableTimingBuffer disable_timing_buffer(fp, group_ports);
+
   /* Disable all the input port (routing tracks), which are not used by benchmark */
   for (size_t itrack = 0; itrack < rr_gsb.get_cb_chan_width(cb_type); ++itrack) {
     const RRNodeId& chan_node = rr_gsb.get_chan_node(rr_gsb.get_cb_chan_side(cb_type), itrack);
@@ -78,20 +87,14 @@ void print_analysis_sdc_disable_cb_unused_resources(std::fstream& fp,
     }
 
     /* Disable both input of the routing track if it is not used! */
-    std::string port_name = generate_cb_module_track_port_name(cb_type,
-                                                               IN_PORT,
-                                                               0 == itrack % 2);
+    ModulePinInfo chan_port_info = gsb_module_ports.cb_chan_port(cb_type, module_gsb, itrack, IN_PORT);
 
     /* Ensure we have this port in the module! */
-    ModulePortId module_port = module_manager.find_module_port(cb_module, port_name);
-    VTR_ASSERT(true == module_manager.valid_module_port_id(cb_module, module_port));
-    BasicPort chan_port(module_manager.module_port(cb_module, module_port).get_name(),
-                        itrack / 2, itrack / 2);
-
-    fp << "set_disable_timing ";
-    fp << cb_instance_name << "/";
-    fp << generate_sdc_port(chan_port);
-    fp << std::endl;
+    VTR_ASSERT(true == module_manager.valid_module_port_id(cb_module, chan_port_info.first));
+    BasicPort chan_port(module_manager.module_port(cb_module, chan_port_info.first).get_name(),
+                        chan_port_info.second, chan_port_info.second);
+
+    disable_timing_buffer.add_port(cb_instance_name + std::string("/"), chan_port);
   }
 
   /* Disable all the output port (routing tracks), which are not used by benchmark */
@@ -103,20 +106,14 @@ void print_analysis_sdc_disable_cb_unused_resources(std::fstream& fp,
     }
 
     /* Disable both input of the routing track if it is not used! */
-    std::string port_name = generate_cb_module_track_port_name(cb_type,
-                                                               OUT_PORT,
-                                                               0 == itrack % 2);
+    ModulePinInfo chan_port_info = gsb_module_ports.cb_chan_port(cb_type, module_gsb, itrack, OUT_PORT);
 
     /* Ensure we have this port in the module! */
-    ModulePortId module_port = module_manager.find_module_port(cb_module, port_name);
-    VTR_ASSERT(true == module_manager.valid_module_port_id(cb_module, module_port));
-    BasicPort chan_port(module_manager.module_port(cb_module, module_port).get_name(),
-                        itrack / 2, itrack / 2);
-
-    fp << "set_disable_timing ";
-    fp << cb_instance_name << "/";
-    fp << generate_sdc_port(chan_port);
-    fp << std::endl;
+    VTR_ASSERT(true == module_manager.valid_module_port_id(cb_module, chan_port_info.first));
+    BasicPort chan_port(module_manager.module_port(cb_module, chan_port_info.first).get_name(),
+                        chan_port_info.second, chan_port_info.second);
+
+    disable_timing_buffer.add_port(cb_instance_name + std::string("/"), chan_port);
   }
 
   /* Build a map between mux_instance name and net_num */
@@ -138,37 +135,17 @@ void print_analysis_sdc_disable_cb_unused_resources(std::fstream& fp,
         continue;
       }
 
-      if (0 == std::distance(rr_graph.node_configurable_in_edges(ipin_node).begin(), rr_graph.node_configurable_in_edges(ipin_node).end())) {
+      if (true == rr_gsb.get_ipin_node_driver_edges(cb_ipin_side, inode).empty()) {
         continue;
       }
 
-      std::string port_name = generate_cb_module_grid_port_name(cb_ipin_side,
-                                                                grids,
-                                                                device_annotation,
-                                                                rr_graph,
-                                                                ipin_node); 
-
       /* Find the port in unique mirror! */
-      if (true == compact_routing_hierarchy) {
-        /* Note: use GSB coordinate when inquire for unique modules!!! */
-        vtr::Point<size_t> cb_coord(rr_gsb.get_x(), rr_gsb.get_y());
-        const RRGSB& unique_mirror = device_rr_gsb.get_cb_unique_module(cb_type, cb_coord);
-        const RRNodeId& unique_mirror_ipin_node = unique_mirror.get_ipin_node(cb_ipin_side, inode);
-        port_name = generate_cb_module_grid_port_name(cb_ipin_side, 
-                                                      grids,
-                                                      device_annotation,
-                                                      rr_graph,
-                                                      unique_mirror_ipin_node); 
-      }
+      ModulePortId module_port = gsb_module_ports.cb_ipin_port(cb_type, module_gsb, cb_ipin_side, inode);
 
       /* Ensure we have this port in the module! */
-      ModulePortId module_port = module_manager.find_module_port(cb_module, port_name);
       VTR_ASSERT(true == module_manager.valid_module_port_id(cb_module, module_port));
 
-      fp << "set_disable_timing ";
-      fp << cb_instance_name << "/";
-      fp << generate_sdc_port(module_manager.module_port(cb_module, module_port));
-      fp << std::endl;
+      disable_timing_buffer.add_port(cb_instance_name + std::string("/"), module_manager.module_port(cb_module, module_port));
     }
   }
 
@@ -193,23 +170,22 @@ void print_analysis_sdc_disable_cb_unused_resources(std::fstream& fp,
     const RRNodeId& chan_node = rr_gsb.get_chan_node(rr_gsb.get_cb_chan_side(cb_type), itrack);
 
     /* Disable both input of the routing track if it is not used! */
-    std::string port_name = generate_cb_module_track_port_name(cb_type,
-                                                               OUT_PORT,
-                                                               0 == itrack % 2);
+    ModulePinInfo chan_port_info = gsb_module_ports.cb_chan_port(cb_type, module_gsb, itrack, OUT_PORT);
 
     /* Ensure we have this port in the module! */
-    ModulePortId module_port = module_manager.find_module_port(cb_module, port_name);
-    VTR_ASSERT(true == module_manager.valid_module_port_id(cb_module, module_port));
+    VTR_ASSERT(true == module_manager.valid_module_port_id(cb_module, chan_port_info.first));
 
     AtomNetId mapped_atom_net = atom_ctx.lookup.atom_net(routing_annotation.rr_node_net(chan_node)); 
 
-    disable_analysis_module_input_pin_net_sinks(fp, module_manager, cb_module,
+    disable_analysis_module_input_pin_net_sinks(disable_timing_buffer, module_manager, cb_module,
                                                 cb_instance_name,
-                                                module_port, itrack / 2,
+                                                chan_port_info.first, chan_port_info.second,
                                                 mapped_atom_net,
                                                 mux_instance_to_net_map);
 
   }
+
+  disable_timing_buffer.flush();
 }
 
 /********************************************************************
@@ -220,13 +196,13 @@ static
 void print_analysis_sdc_disable_unused_cb_ports(std::fstream& fp,
                                                 const AtomContext& atom_ctx, 
                                                 const ModuleManager& module_manager, 
-                                                const VprDeviceAnnotation& device_annotation, 
-                                                const DeviceGrid& grids, 
+                                                const DeviceRRGSBModulePorts& gsb_module_ports, 
                                                 const RRGraph& rr_graph, 
                                                 const VprRoutingAnnotation& routing_annotation, 
                                                 const DeviceRRGSB& device_rr_gsb,
                                                 const t_rr_type& cb_type,
-                                                const bool& compact_routing_hierarchy) {
+                                                const bool& compact_routing_hierarchy,
+                                                const bool& group_ports) {
   /* Build unique X-direction connection block modules */
   vtr::Point<size_t> cb_range = device_rr_gsb.get_gsb_range();
 
@@ -244,14 +220,14 @@ void print_analysis_sdc_disable_unused_cb_ports(std::fstream& fp,
       print_analysis_sdc_disable_cb_unused_resources(fp, 
                                                      atom_ctx, 
                                                      module_manager, 
-                                                     device_annotation,
-                                                     grids,
+                                                     gsb_module_ports,
                                                      rr_graph, 
                                                      routing_annotation, 
                                                      device_rr_gsb, 
                                                      rr_gsb, 
                                                      cb_type,
-                                                     compact_routing_hierarchy);
+                                                     compact_routing_hierarchy,
+                                                     group_ports);
     }
   }
 }
@@ -263,30 +239,28 @@ void print_analysis_sdc_disable_unused_cb_ports(std::fstream& fp,
 void print_analysis_sdc_disable_unused_cbs(std::fstream& fp,
                                            const AtomContext& atom_ctx, 
                                            const ModuleManager& module_manager, 
-                                           const VprDeviceAnnotation& device_annotation, 
-                                           const DeviceGrid& grids, 
+                                           const DeviceRRGSBModulePorts& gsb_module_ports, 
                                            const RRGraph& rr_graph, 
                                            const VprRoutingAnnotation& routing_annotation, 
                                            const DeviceRRGSB& device_rr_gsb,
-                                           const bool& compact_routing_hierarchy) {
+                                           const bool& compact_routing_hierarchy,
+                                           const bool& group_ports) {
 
   print_analysis_sdc_disable_unused_cb_ports(fp, atom_ctx,
                                              module_manager, 
-                                             device_annotation, 
-                                             grids, 
+                                             gsb_module_ports,
                                              rr_graph, 
                                              routing_annotation,
                                              device_rr_gsb,
-                                             CHANX, compact_routing_hierarchy);
+                                             CHANX, compact_routing_hierarchy, group_ports);
 
   print_analysis_sdc_disable_unused_cb_ports(fp, atom_ctx,
                                              module_manager, 
-                                             device_annotation, 
-                                             grids, 
+                                             gsb_module_ports,
                                              rr_graph, 
                                              routing_annotation,
                                              device_rr_gsb,
-                                             CHANY, compact_routing_hierarchy);
+                                             CHANY, compact_routing_hierarchy, group_ports);
 }
 
 /********************************************************************
@@ -299,13 +273,12 @@ static
 void print_analysis_sdc_disable_sb_unused_resources(std::fstream& fp, 
                                                     const AtomContext& atom_ctx, 
                                                     const ModuleManager& module_manager, 
-                                                    const VprDeviceAnnotation& device_annotation, 
-                                                    const DeviceGrid& grids, 
-                                                    const RRGraph& rr_graph, 
+                                                    const DeviceRRGSBModulePorts& gsb_module_ports, 
                                                     const VprRoutingAnnotation& routing_annotation, 
                                                     const DeviceRRGSB& device_rr_gsb,
                                                     const RRGSB& rr_gsb, 
-                                                    const bool& compact_routing_hierarchy) {
+                                                    const bool& compact_routing_hierarchy,
+                                                    const bool& group_ports) {
   /* Validate file stream */
   valid_file_stream(fp);
 
@@ -323,6 +296,11 @@ void print_analysis_sdc_disable_sb_unused_resources(std::fstream& fp,
     sb_coordinate.set_y(unique_mirror.get_sb_y()); 
   }
 
+  /* The ports of the module are resolved from the GSB which the module is built from */
+  const RRGSB& module_gsb = (true == compact_routing_hierarchy)
+                          ? device_rr_gsb.get_sb_unique_module(vtr::Point<size_t>(rr_gsb.get_x(), rr_gsb.get_y()))
+                          : rr_gsb;
+
   std::string sb_module_name = generate_switch_block_module_name(sb_coordinate);
 
   ModuleId sb_module = module_manager.find_module(sb_module_name);
@@ -333,6 +311,9 @@ void print_analysis_sdc_disable_sb_unused_resources(std::fstream& fp,
   fp << "# Disable timing for Switch block " << sb_module_name << std::endl;
   fp << "##################################################" << std::endl; 
 
+  /* Buffer the pins to disable, so that they can be grouped into buses */
+  SdcDisableTimingBuffer disable_timing_buffer(fp, group_ports);
+
   /* Build a map between mux_instance name and net_num */
   std::map<std::string, AtomNetId> mux_instance_to_net_map;
 
@@ -343,22 +324,9 @@ void print_analysis_sdc_disable_sb_unused_resources(std::fstream& fp,
     for (size_t itrack = 0; itrack < rr_gsb.get_chan_width(side_manager.get_side()); ++itrack) {
       const RRNodeId& chan_node = rr_gsb.get_chan_node(side_manager.get_side(), itrack);
 
-      std::string port_name = generate_sb_module_track_port_name(rr_graph.node_type(rr_gsb.get_chan_node(side_manager.get_side(), itrack)),
-                                                                 side_manager.get_side(), 
-                                                                 rr_gsb.get_chan_node_direction(side_manager.get_side(), itrack));
-
-      if (true == compact_routing_hierarchy) {
-        /* Note: use GSB coordinate when inquire for unique modules!!! */
-        vtr::Point<size_t> sb_coord(rr_gsb.get_x(), rr_gsb.get_y());
-        const RRGSB& unique_mirror = device_rr_gsb.get_sb_unique_module(sb_coord);
-        port_name = generate_sb_module_track_port_name(rr_graph.node_type(unique_mirror.get_chan_node(side_manager.get_side(), itrack)),
-                                                       side_manager.get_side(),  
-                                                       unique_mirror.get_chan_node_direction(side_manager.get_side(), itrack));
-      }
-
       /* Ensure we have this port in the module! */
-      ModulePortId module_port = module_manager.find_module_port(sb_module, port_name);
-      VTR_ASSERT(true == module_manager.valid_module_port_id(sb_module, module_port));
+      ModulePinInfo chan_port_info = gsb_module_ports.sb_chan_port(module_gsb, side_manager.get_side(), itrack);
+      VTR_ASSERT(true == module_manager.valid_module_port_id(sb_module, chan_port_info.first));
 
       /* Cache the net name for routing tracks which are outputs of the switch block */
       if (OUT_PORT == rr_gsb.get_chan_node_direction(side_manager.get_side(), itrack)) {
@@ -372,13 +340,10 @@ void print_analysis_sdc_disable_sb_unused_resources(std::fstream& fp,
         continue;
       }
 
-      BasicPort sb_port(module_manager.module_port(sb_module, module_port).get_name(),
-                        itrack / 2, itrack / 2);
+      BasicPort sb_port(module_manager.module_port(sb_module, chan_port_info.first).get_name(),
+                        chan_port_info.second, chan_port_info.second);
 
-      fp << "set_disable_timing ";
-      fp << sb_instance_name << "/";
-      fp << generate_sdc_port(sb_port);
-      fp << std::endl;
+      disable_timing_buffer.add_port(sb_instance_name + std::string("/"), sb_port);
     }
   }
 
@@ -389,30 +354,8 @@ void print_analysis_sdc_disable_sb_unused_resources(std::fstream& fp,
     for (size_t inode = 0; inode < rr_gsb.get_num_opin_nodes(side_manager.get_side()); ++inode) {
       const RRNodeId& opin_node = rr_gsb.get_opin_node(side_manager.get_side(), inode);
 
-      std::string port_name = generate_sb_module_grid_port_name(side_manager.get_side(), 
-                                                                rr_graph.node_side(opin_node),
-                                                                grids,
-                                                                device_annotation,
-                                                                rr_graph,
-                                                                opin_node); 
-
-      if (true == compact_routing_hierarchy) {
-        /* Note: use GSB coordinate when inquire for unique modules!!! */
-        vtr::Point<size_t> sb_coord(rr_gsb.get_x(), rr_gsb.get_y());
-        const RRGSB& unique_mirror = device_rr_gsb.get_sb_unique_module(sb_coord);
-        const RRNodeId& unique_mirror_opin_node = unique_mirror.get_opin_node(side_manager.get_side(), inode);
-
-        port_name = generate_sb_module_grid_port_name(side_manager.get_side(),
-                                                      rr_graph.node_side(unique_mirror_opin_node),
-                                                      grids,
-                                                      device_annotation,
-                                                      rr_graph,
-                                                      unique_mirror_opin_node); 
-      }
-
-
       /* Ensure we have this port in the module! */
-      ModulePortId module_port = module_manager.find_module_port(sb_module, port_name);
+      ModulePortId module_port = gsb_module_ports.sb_opin_port(module_gsb, side_manager.get_side(), inode);
       VTR_ASSERT(true == module_manager.valid_module_port_id(sb_module, module_port));
 
       /* Check if this node is used by benchmark  */
@@ -420,10 +363,7 @@ void print_analysis_sdc_disable_sb_unused_resources(std::fstream& fp,
         continue;
       }
 
-      fp << "set_disable_timing ";
-      fp << sb_instance_name << "/";
-      fp << generate_sdc_port(module_manager.module_port(sb_module, module_port));
-      fp << std::endl;
+      disable_timing_buffer.add_port(sb_instance_name + std::string("/"), module_manager.module_port(sb_module, module_port));
     }
   }
 
@@ -457,35 +397,13 @@ void print_analysis_sdc_disable_sb_unused_resources(std::fstream& fp,
     for (size_t inode = 0; inode < rr_gsb.get_num_opin_nodes(side_manager.get_side()); ++inode) {
       const RRNodeId& opin_node = rr_gsb.get_opin_node(side_manager.get_side(), inode);
 
-      std::string port_name = generate_sb_module_grid_port_name(side_manager.get_side(),
-                                                                rr_graph.node_side(opin_node),
-                                                                grids,
-                                                                device_annotation,
-                                                                rr_graph,
-                                                                opin_node); 
-
-      if (true == compact_routing_hierarchy) {
-        /* Note: use GSB coordinate when inquire for unique modules!!! */
-        vtr::Point<size_t> sb_coord(rr_gsb.get_x(), rr_gsb.get_y());
-        const RRGSB& unique_mirror = device_rr_gsb.get_sb_unique_module(sb_coord);
-        const RRNodeId& unique_mirror_opin_node = unique_mirror.get_opin_node(side_manager.get_side(), inode);
-
-        port_name = generate_sb_module_grid_port_name(side_manager.get_side(),
-                                                      rr_graph.node_side(unique_mirror_opin_node),
-                                                      grids,
-                                                      device_annotation,
-                                                      rr_graph,
-                                                      unique_mirror_opin_node); 
-      }
-
-
       /* Ensure we have this port in the module! */
-      ModulePortId module_port = module_manager.find_module_port(sb_module, port_name);
+      ModulePortId module_port = gsb_module_ports.sb_opin_port(module_gsb, side_manager.get_side(), inode);
       VTR_ASSERT(true == module_manager.valid_module_port_id(sb_module, module_port));
 
       AtomNetId mapped_atom_net = atom_ctx.lookup.atom_net(routing_annotation.rr_node_net(opin_node));
 
-      disable_analysis_module_input_port_net_sinks(fp, module_manager,
+      disable_analysis_module_input_port_net_sinks(disable_timing_buffer, module_manager,
                                                    sb_module,
                                                    sb_instance_name,
                                                    module_port,
@@ -506,35 +424,21 @@ void print_analysis_sdc_disable_sb_unused_resources(std::fstream& fp,
 
       const RRNodeId& chan_node = rr_gsb.get_chan_node(side_manager.get_side(), itrack);
 
-      std::string port_name = generate_sb_module_track_port_name(rr_graph.node_type(chan_node),
-                                                                 side_manager.get_side(),  
-                                                                 rr_gsb.get_chan_node_direction(side_manager.get_side(), itrack));
-
-      if (true == compact_routing_hierarchy) {
-        /* Note: use GSB coordinate when inquire for unique modules!!! */
-        vtr::Point<size_t> sb_coord(rr_gsb.get_x(), rr_gsb.get_y());
-        const RRGSB& unique_mirror = device_rr_gsb.get_sb_unique_module(sb_coord);
-        const RRNodeId& unique_mirror_chan_node = unique_mirror.get_chan_node(side_manager.get_side(), itrack);
-
-        port_name = generate_sb_module_track_port_name(rr_graph.node_type(unique_mirror_chan_node),
-                                                       side_manager.get_side(), 
-                                                       unique_mirror.get_chan_node_direction(side_manager.get_side(), itrack));
-      }
-
-
       /* Ensure we have this port in the module! */
-      ModulePortId module_port = module_manager.find_module_port(sb_module, port_name);
-      VTR_ASSERT(true == module_manager.valid_module_port_id(sb_module, module_port));
+      ModulePinInfo chan_port_info = gsb_module_ports.sb_chan_port(module_gsb, side_manager.get_side(), itrack);
+      VTR_ASSERT(true == module_manager.valid_module_port_id(sb_module, chan_port_info.first));
 
       AtomNetId mapped_atom_net = atom_ctx.lookup.atom_net(routing_annotation.rr_node_net(chan_node));
 
-      disable_analysis_module_input_pin_net_sinks(fp, module_manager, sb_module,
+      disable_analysis_module_input_pin_net_sinks(disable_timing_buffer, module_manager, sb_module,
                                                   sb_instance_name,
-                                                  module_port, itrack / 2,
+                                                  chan_port_info.first, chan_port_info.second,
                                                   mapped_atom_net,
                                                   mux_instance_to_net_map);
     }
   }
+
+  disable_timing_buffer.flush();
 }
 
 
@@ -545,12 +449,11 @@ void print_analysis_sdc_disable_sb_unused_resources(std::fstream& fp,
 void print_analysis_sdc_disable_unused_sbs(std::fstream& fp,
                                            const AtomContext& atom_ctx, 
                                            const ModuleManager& module_manager, 
-                                           const VprDeviceAnnotation& device_annotation, 
-                                           const DeviceGrid& grids, 
-                                           const RRGraph& rr_graph, 
+                                           const DeviceRRGSBModulePorts& gsb_module_ports, 
                                            const VprRoutingAnnotation& routing_annotation, 
                                            const DeviceRRGSB& device_rr_gsb,
-                                           const bool& compact_routing_hierarchy) {
+                                           const bool& compact_routing_hierarchy,
+                                           const bool& group_ports) {
 
   /* Build unique X-direction connection block modules */
   vtr::Point<size_t> sb_range = device_rr_gsb.get_gsb_range();
@@ -569,13 +472,12 @@ void print_analysis_sdc_disable_unused_sbs(std::fstream& fp,
       print_analysis_sdc_disable_sb_unused_resources(fp,
                                                      atom_ctx, 
                                                      module_manager, 
-                                                     device_annotation,
-                                                     grids, 
-                                                     rr_graph, 
+                                                     gsb_module_ports,
                                                      routing_annotation, 
                                                      device_rr_gsb, 
                                                      rr_gsb, 
-                                                     compact_routing_hierarchy);
+                                                     compact_routing_hierarchy,
+                                                     group_ports);
     }
   }
 }
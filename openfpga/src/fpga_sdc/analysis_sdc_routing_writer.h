@@ -10,6 +10,7 @@
 #include "module_manager.h"
 #include "device_grid.h"
 #include "device_rr_gsb.h"
+#include "device_rr_gsb_module_ports.h"
 #include "vpr_routing_annotation.h"
 
 /********************************************************************
@@ -22,22 +23,21 @@ namespace openfpga {
 void print_analysis_sdc_disable_unused_cbs(std::fstream& fp,
                                            const AtomContext& atom_ctx, 
                                            const ModuleManager& module_manager, 
-                                           const VprDeviceAnnotation& device_annotation, 
-                                           const DeviceGrid& grids, 
+                                           const DeviceRRGSBModulePorts& gsb_module_ports, 
                                            const RRGraph& rr_graph, 
                                            const VprRoutingAnnotation& routing_annotation, 
                                            const DeviceRRGSB& device_rr_gsb,
-                                           const bool& compact_routing_hierarchy);
+                                           const bool& compact_routing_hierarchy,
+                                           const bool& group_ports);
 
 void print_analysis_sdc_disable_unused_sbs(std::fstream& fp,
                                            const AtomContext& atom_ctx, 
                                            const ModuleManager& module_manager, 
-                                           const VprDeviceAnnotation& device_annotation, 
-                                           const DeviceGrid& grids, 
-                                           const RRGraph& rr_graph, 
+                                           const DeviceRRGSBModulePorts& gsb_module_ports, 
                                            const VprRoutingAnnotation& routing_annotation, 
                                            const DeviceRRGSB& device_rr_gsb,
-                                           const bool& compact_routing_hierarchy);
+                                           const bool& compact_routing_hierarchy,
+                                           const bool& group_ports);
 
 } /* end namespace openfpga */
 
@@ -267,23 +267,22 @@ void print_analysis_sdc(const AnalysisSdcOption& option,
   print_analysis_sdc_disable_unused_cbs(fp,
                                         vpr_ctx.atom(), 
                                         openfpga_ctx.module_graph(),
-                                        openfpga_ctx.vpr_device_annotation(),
-                                        vpr_ctx.device().grid,
+                                        openfpga_ctx.device_rr_gsb_module_ports(),
                                         vpr_ctx.device().rr_graph,
                                         openfpga_ctx.vpr_routing_annotation(),
                                         openfpga_ctx.device_rr_gsb(), 
-                                        compact_routing_hierarchy);
+                                        compact_routing_hierarchy,
+                                        option.group_ports());
 
   /* Disable timing for unused routing resources in switch blocks */
   print_analysis_sdc_disable_unused_sbs(fp,
                                         vpr_ctx.atom(), 
                                         openfpga_ctx.module_graph(),
-                                        openfpga_ctx.vpr_device_annotation(),
-                                        vpr_ctx.device().grid,
-                                        vpr_ctx.device().rr_graph,
+                                        openfpga_ctx.device_rr_gsb_module_ports(),
                                         openfpga_ctx.vpr_routing_annotation(),
                                         openfpga_ctx.device_rr_gsb(), 
-                                        compact_routing_hierarchy);
+                                        compact_routing_hierarchy,
+                                        option.group_ports());
 
   /* Disable timing for unused routing resources in grids (programmable blocks) */
   print_analysis_sdc_disable_unused_grids(fp,
@@ -291,7 +290,8 @@ void print_analysis_sdc(const AnalysisSdcOption& option,
                                           openfpga_ctx.vpr_device_annotation(),
                                           openfpga_ctx.vpr_clustering_annotation(),
                                           openfpga_ctx.vpr_placement_annotation(),
-                                          openfpga_ctx.module_graph());
+                                          openfpga_ctx.module_graph(),
+                                          option.group_ports());
 
   /* Close file handler */
   fp.close();
@@ -0,0 +1,355 @@
+/********************************************************************
+ * This file includes functions to estimate the timing of a FPGA fabric
+ * with the routing results, without running a full static timing analysis
+ * on the netlists of the fabric.
+ *
+ * The module graph of the fabric is cyclic across the switch blocks,
+ * so that it can not be levelized as it is. Instead, a timing graph is built
+ * on the routing trees of the nets, which are acyclic, where each edge is
+ * annotated with the same delay as the one constrained in the PnR SDC files,
+ * i.e., the maximum delay of the switch driving each routing node.
+ * The timing graph is then analyzed by the setup and hold analyzers of tatum.
+ *******************************************************************/
+#include <algorithm>
+#include <fstream>
+
+/* Headers from vtrutil library */
+#include "vtr_assert.h"
+#include "vtr_log.h"
+#include "vtr_time.h"
+#include "vtr_vector.h"
+
+/* Headers from openfpgautil library */
+#include "openfpga_digest.h"
+
+/* Headers from tatum library */
+#include "tatum/TimingGraph.hpp"
+#include "tatum/TimingConstraints.hpp"
+#include "tatum/analyzer_factory.hpp"
+#include "tatum/delay_calc/FixedDelayCalculator.hpp"
+
+#include "sdc_writer_utils.h"
+#include "fabric_timing_estimator.h"
+
+/* begin namespace openfpga */
+namespace openfpga {
+
+/* Times are reported in nanoseconds */
+constexpr float FABRIC_TIMING_REPORT_TIME_UNIT = 1e-9;
+
+/********************************************************************
+ * Timing graph built on the routing trees of the nets
+ * Each routed node of the routing resource graph is a node of the timing graph:
+ * - the first node of a routing tree, i.e., an OPIN, is a SOURCE
+ * - the input pins of the routing trees are SINKs
+ * - the other routing nodes are intermediate nodes
+ *******************************************************************/
+struct t_fabric_timing_graph {
+  tatum::TimingGraph timing_graph;
+  vtr::vector<RRNodeId, tatum::NodeId> rr_node_tnodes;
+  tatum::util::linear_map<tatum::NodeId, RRNodeId> tnode_rr_nodes;
+  tatum::util::linear_map<tatum::EdgeId, tatum::Time> edge_delays;
+  std::vector<tatum::NodeId> sources;
+  std::vector<tatum::NodeId> sinks;
+};
+
+/* Timing of a connection, from the driver of a net to one of its input pins */
+struct t_connection_timing {
+  tatum::NodeId sink;
+  float arrival;
+  float slack;
+  float min_arrival;
+};
+
+/********************************************************************
+ * A node starts a routing tree when it has no previous node in the routing
+ * trees, i.e., it is driven by a SOURCE which is not part of the timing graph
+ *******************************************************************/
+static
+bool is_routing_tree_root(const RRGraph& rr_graph,
+                          const VprRoutingAnnotation& vpr_routing_annotation,
+                          const RRNodeId& rr_node) {
+  const RRNodeId& prev_node = vpr_routing_annotation.rr_node_prev_node(rr_node);
+  if (false == rr_graph.valid_node_id(prev_node)) {
+    return true;
+  }
+  return ClusterNetId::INVALID() == vpr_routing_annotation.rr_node_net(prev_node);
+}
+
+/********************************************************************
+ * Find the maximum delay of the switch from a node to another,
+ * which is the same as the one in the PnR SDC files
+ *******************************************************************/
+static
+float find_routing_edge_tmax(const RRGraph& rr_graph,
+                             const RRNodeId& src_node,
+                             const RRNodeId& sink_node) {
+  float tmax = 0.;
+  for (const RREdgeId& edge : rr_graph.find_edges(src_node, sink_node)) {
+    tmax = std::max(tmax, find_pnr_sdc_switch_tmax(rr_graph.get_switch(rr_graph.edge_switch(edge))));
+  }
+  return tmax;
+}
+
+/********************************************************************
+ * Build the timing graph on the routing trees of all the routed nets
+ *******************************************************************/
+static
+void build_fabric_timing_graph(t_fabric_timing_graph& fabric_timing_graph,
+                               const RRGraph& rr_graph,
+                               const VprRoutingAnnotation& vpr_routing_annotation) {
+  tatum::TimingGraph& timing_graph = fabric_timing_graph.timing_graph;
+  fabric_timing_graph.rr_node_tnodes.resize(rr_graph.nodes().size(), tatum::NodeId::INVALID());
+
+  /* Create a node for each routed node */
+  for (const RRNodeId& rr_node : rr_graph.nodes()) {
+    if (ClusterNetId::INVALID() == vpr_routing_annotation.rr_node_net(rr_node)) {
+      continue;
+    }
+    tatum::NodeType node_type = tatum::NodeType::IPIN;
+    if (true == is_routing_tree_root(rr_graph, vpr_routing_annotation, rr_node)) {
+      node_type = tatum::NodeType::SOURCE;
+    } else if (IPIN == rr_graph.node_type(rr_node)) {
+      node_type = tatum::NodeType::SINK;
+    }
+    tatum::NodeId tnode = timing_graph.add_node(node_type);
+    fabric_timing_graph.rr_node_tnodes[rr_node] = tnode;
+    fabric_timing_graph.tnode_rr_nodes.push_back(rr_node);
+    VTR_ASSERT(size_t(tnode) + 1 == fabric_timing_graph.tnode_rr_nodes.size());
+
+    if (tatum::NodeType::SOURCE == node_type) {
+      fabric_timing_graph.sources.push_back(tnode);
+    } else if (tatum::NodeType::SINK == node_type) {
+      fabric_timing_graph.sinks.push_back(tnode);
+    }
+  }
+
+  /* Connect each node to its previous node in the routing trees */
+  for (const tatum::NodeId& tnode : timing_graph.nodes()) {
+    if (tatum::NodeType::SOURCE == timing_graph.node_type(tnode)) {
+      continue;
+    }
+    const RRNodeId& rr_node = fabric_timing_graph.tnode_rr_nodes[tnode];
+    const RRNodeId& prev_node = vpr_routing_annotation.rr_node_prev_node(rr_node);
+    tatum::NodeId prev_tnode = fabric_timing_graph.rr_node_tnodes[prev_node];
+    VTR_ASSERT(prev_tnode);
+    tatum::EdgeId tedge = timing_graph.add_edge(tatum::EdgeType::INTERCONNECT, prev_tnode, tnode);
+    fabric_timing_graph.edge_delays.push_back(tatum::Time(find_routing_edge_tmax(rr_graph, prev_node, rr_node)));
+    VTR_ASSERT(size_t(tedge) + 1 == fabric_timing_graph.edge_delays.size());
+  }
+
+  timing_graph.levelize();
+}
+
+/********************************************************************
+ * Constrain all the connections with a single clock:
+ * the nets are launched at the beginning of the clock period
+ * and captured at the end of it
+ *******************************************************************/
+static
+tatum::TimingConstraints build_fabric_timing_constraints(const t_fabric_timing_graph& fabric_timing_graph,
+                                                         const float& clock_period) {
+  tatum::TimingConstraints timing_constraints;
+  tatum::DomainId clock_domain = timing_constraints.create_clock_domain("fabric_clock");
+  timing_constraints.set_setup_constraint(clock_domain, clock_domain, tatum::Time(clock_period));
+  timing_constraints.set_hold_constraint(clock_domain, clock_domain, tatum::Time(0.));
+
+  for (const tatum::NodeId& source : fabric_timing_graph.sources) {
+    timing_constraints.set_input_constraint(source, clock_domain, tatum::DelayType::MAX, tatum::Time(0.));
+    timing_constraints.set_input_constraint(source, clock_domain, tatum::DelayType::MIN, tatum::Time(0.));
+  }
+  for (const tatum::NodeId& sink : fabric_timing_graph.sinks) {
+    timing_constraints.set_output_constraint(sink, clock_domain, tatum::DelayType::MAX, tatum::Time(0.));
+    timing_constraints.set_output_constraint(sink, clock_domain, tatum::DelayType::MIN, tatum::Time(0.));
+  }
+
+  return timing_constraints;
+}
+
+/********************************************************************
+ * Find the latest arrival time of the tags, or the earliest one
+ *******************************************************************/
+static
+float find_timing_tags_time(const tatum::TimingTags::tag_range& tags,
+                            const bool& find_max) {
+  float time = 0.;
+  bool first = true;
+  for (const tatum::TimingTag& tag : tags) {
+    float tag_time = tag.time().value();
+    if ( (true == first)
+      || ((true == find_max) && (tag_time > time))
+      || ((false == find_max) && (tag_time < time)) ) {
+      time = tag_time;
+    }
+    first = false;
+  }
+  return time;
+}
+
+/********************************************************************
+ * Output the rr_nodes of the routing path to a sink, from the driver of the net
+ *******************************************************************/
+static
+void print_fabric_timing_path(std::fstream& fp,
+                              const RRGraph& rr_graph,
+                              const VprRoutingAnnotation& vpr_routing_annotation,
+                              const t_fabric_timing_graph& fabric_timing_graph,
+                              const tatum::SetupHoldTimingAnalyzer& timing_analyzer,
+                              const tatum::NodeId& sink) {
+  std::vector<RRNodeId> path;
+  RRNodeId rr_node = fabric_timing_graph.tnode_rr_nodes[sink];
+  while (true) {
+    path.push_back(rr_node);
+    if (tatum::NodeType::SOURCE == fabric_timing_graph.timing_graph.node_type(fabric_timing_graph.rr_node_tnodes[rr_node])) {
+      break;
+    }
+    rr_node = vpr_routing_annotation.rr_node_prev_node(rr_node);
+  }
+  std::reverse(path.begin(), path.end());
+
+  float prev_arrival = 0.;
+  for (const RRNodeId& path_node : path) {
+    float arrival = find_timing_tags_time(timing_analyzer.setup_tags(fabric_timing_graph.rr_node_tnodes[path_node], tatum::TagType::DATA_ARRIVAL), true);
+    fp << "\t" << rr_node_typename[rr_graph.node_type(path_node)];
+    fp << " (" << rr_graph.node_xlow(path_node) << "," << rr_graph.node_ylow(path_node) << ")";
+    if ( (rr_graph.node_xlow(path_node) != rr_graph.node_xhigh(path_node))
+      || (rr_graph.node_ylow(path_node) != rr_graph.node_yhigh(path_node)) ) {
+      fp << "->(" << rr_graph.node_xhigh(path_node) << "," << rr_graph.node_yhigh(path_node) << ")";
+    }
+    fp << " ptc " << rr_graph.node_ptc_num(path_node);
+    fp << "\t+" << (arrival - prev_arrival) / FABRIC_TIMING_REPORT_TIME_UNIT;
+    fp << "\t" << arrival / FABRIC_TIMING_REPORT_TIME_UNIT << "\n";
+    prev_arrival = arrival;
+  }
+}
+
+/********************************************************************
+ * Estimate the timing of all the routed connections in the fabric
+ * and report the most critical ones
+ * - A summary is reported in the log
+ * - The details of the critical paths are written to a file, if specified
+ *
+ * Return:
+ *  - 0 if succeed
+ *  - 1 if critical errors occured
+ *******************************************************************/
+int estimate_fabric_timing(const std::string& fname,
+                           const DeviceContext& device_ctx,
+                           const ClusteringContext& clustering_ctx,
+                           const VprRoutingAnnotation& vpr_routing_annotation,
+                           const float& clock_period,
+                           const size_t& num_paths,
+                           const bool& verbose) {
+  vtr::ScopedStartFinishTimer timer("Estimate fabric timing");
+
+  const RRGraph& rr_graph = device_ctx.rr_graph;
+
+  t_fabric_timing_graph fabric_timing_graph;
+  build_fabric_timing_graph(fabric_timing_graph, rr_graph, vpr_routing_annotation);
+
+  VTR_LOGV(verbose,
+           "Built timing graph with %lu nodes, %lu edges and %lu levels\n",
+           fabric_timing_graph.timing_graph.nodes().size(),
+           fabric_timing_graph.timing_graph.edges().size(),
+           fabric_timing_graph.timing_graph.levels().size());
+
+  if (true == fabric_timing_graph.sinks.empty()) {
+    VTR_LOG_WARN("No routed connection is found to estimate fabric timing!\n");
+    return 0;
+  }
+
+  /* Analyze setup and hold timing on multiple threads */
+  tatum::TimingConstraints timing_constraints = build_fabric_timing_constraints(fabric_timing_graph, clock_period);
+  tatum::util::linear_map<tatum::EdgeId, tatum::Time> setup_times(fabric_timing_graph.edge_delays.size(), tatum::Time(0.));
+  tatum::FixedDelayCalculator delay_calculator(fabric_timing_graph.edge_delays, setup_times);
+  auto timing_analyzer = tatum::AnalyzerFactory<tatum::SetupHoldAnalysis, tatum::ParallelWalker>::make(fabric_timing_graph.timing_graph,
+                                                                                                      timing_constraints,
+                                                                                                      delay_calculator);
+  timing_analyzer->update_timing();
+
+  /* Collect the timing of each connection */
+  std::vector<t_connection_timing> connections;
+  connections.reserve(fabric_timing_graph.sinks.size());
+  for (const tatum::NodeId& sink : fabric_timing_graph.sinks) {
+    t_connection_timing connection;
+    connection.sink = sink;
+    connection.arrival = find_timing_tags_time(timing_analyzer->setup_tags(sink, tatum::TagType::DATA_ARRIVAL), true);
+    connection.slack = find_timing_tags_time(timing_analyzer->setup_slacks(sink), false);
+    connection.min_arrival = find_timing_tags_time(timing_analyzer->hold_tags(sink, tatum::TagType::DATA_ARRIVAL), false);
+    connections.push_back(connection);
+  }
+  /* Most critical connections first, in the sequence of nodes for identical delays */
+  std::stable_sort(connections.begin(), connections.end(),
+                   [](const t_connection_timing& a, const t_connection_timing& b) {
+                     return a.arrival > b.arrival;
+                   });
+
+  float total_negative_slack = 0.;
+  size_t num_failing_connections = 0;
+  float min_arrival = connections.front().min_arrival;
+  for (const t_connection_timing& connection : connections) {
+    if (0. > connection.slack) {
+      total_negative_slack += connection.slack;
+      num_failing_connections++;
+    }
+    min_arrival = std::min(min_arrival, connection.min_arrival);
+  }
+
+  VTR_LOG("Fabric timing of %lu routed connections with a clock period of %g ns:\n",
+          connections.size(), clock_period / FABRIC_TIMING_REPORT_TIME_UNIT);
+  VTR_LOG("\tLongest connection delay (setup): %g ns\n",
+          connections.front().arrival / FABRIC_TIMING_REPORT_TIME_UNIT);
+  VTR_LOG("\tShortest connection delay (hold): %g ns\n",
+          min_arrival / FABRIC_TIMING_REPORT_TIME_UNIT);
+  VTR_LOG("\tWorst negative slack: %g ns\n",
+          std::min(0.f, connections.front().slack) / FABRIC_TIMING_REPORT_TIME_UNIT);
+  VTR_LOG("\tTotal negative slack: %g ns\n",
+          total_negative_slack / FABRIC_TIMING_REPORT_TIME_UNIT);
+  VTR_LOG("\tFailing connections: %lu\n", num_failing_connections);
+
+  if (true == fname.empty()) {
+    return 0;
+  }
+
+  /* Output the critical connections to a file */
+  std::fstream fp;
+  fp.open(fname, std::fstream::out | std::fstream::trunc);
+  check_file_stream(fname.c_str(), fp);
+
+  fp << "Fabric timing report\n";
+  fp << "Clock period (ns): " << clock_period / FABRIC_TIMING_REPORT_TIME_UNIT << "\n";
+  fp << "Routed connections: " << connections.size() << "\n";
+  fp << "Failing connections: " << num_failing_connections << "\n";
+  fp << "Total negative slack (ns): " << total_negative_slack / FABRIC_TIMING_REPORT_TIME_UNIT << "\n";
+  fp << "\n";
+
+  size_t num_reported_paths = std::min(num_paths, connections.size());
+  for (size_t ipath = 0; ipath < num_reported_paths; ++ipath) {
+    const t_connection_timing& connection = connections[ipath];
+    const RRNodeId& sink_rr_node = fabric_timing_graph.tnode_rr_nodes[connection.sink];
+    const ClusterNetId& net = vpr_routing_annotation.rr_node_net(sink_rr_node);
+    const ClusterBlockId& driver_block = clustering_ctx.clb_nlist.net_driver_block(net);
+    const t_grid_tile& sink_tile = device_ctx.grid[rr_graph.node_xlow(sink_rr_node)][rr_graph.node_ylow(sink_rr_node)];
+
+    fp << "#" << ipath + 1 << " net '" << clustering_ctx.clb_nlist.net_name(net) << "'";
+    fp << " from block '" << clustering_ctx.clb_nlist.block_name(driver_block) << "'";
+    fp << " to tile '" << sink_tile.type->name << "'";
+    fp << " delay (ns): " << connection.arrival / FABRIC_TIMING_REPORT_TIME_UNIT;
+    fp << " slack (ns): " << connection.slack / FABRIC_TIMING_REPORT_TIME_UNIT << "\n";
+    fp << "\tNode\tIncrement (ns)\tArrival (ns)\n";
+    print_fabric_timing_path(fp, rr_graph, vpr_routing_annotation,
+                             fabric_timing_graph, *timing_analyzer,
+                             connection.sink);
+    fp << "\n";
+  }
+
+  fp.close();
+
+  VTR_LOGV(verbose,
+           "Reported %lu critical connections to '%s'\n",
+           num_reported_paths, fname.c_str());
+
+  return 0;
+}
+
+} /* end namespace openfpga */
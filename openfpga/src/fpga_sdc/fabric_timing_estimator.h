@@ -0,0 +1,28 @@
+#ifndef FABRIC_TIMING_ESTIMATOR_H
+#define FABRIC_TIMING_ESTIMATOR_H
+
+/********************************************************************
+ * Include header files that are required by function declaration
+ *******************************************************************/
+#include <string>
+#include "vpr_context.h"
+#include "vpr_routing_annotation.h"
+
+/********************************************************************
+ * Function declaration
+ *******************************************************************/
+
+/* begin namespace openfpga */
+namespace openfpga {
+
+int estimate_fabric_timing(const std::string& fname,
+                           const DeviceContext& device_ctx,
+                           const ClusteringContext& clustering_ctx,
+                           const VprRoutingAnnotation& vpr_routing_annotation,
+                           const float& clock_period,
+                           const size_t& num_paths,
+                           const bool& verbose);
+
+} /* end namespace openfpga */
+
+#endif
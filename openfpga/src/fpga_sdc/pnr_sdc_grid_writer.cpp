@@ -9,6 +9,7 @@
  *******************************************************************/
 #include <ctime>
 #include <fstream>
+#include <algorithm>
 
 /* Headers from vtrutil library */
 #include "vtr_log.h"
@@ -242,9 +243,10 @@ void print_pnr_sdc_constrain_pb_interc_timing(std::fstream& fp,
  * 1. input port of parent_pb_graph_node and input port of child_pb_graph_nodes
  * 2. output port of parent_pb_graph_node and output port of child_pb_graph_nodes
  * 3. output port of child_pb_graph_node and input port of child_pb_graph_nodes
+ * Return true if a SDC file is written for the pb_type
  *******************************************************************/
 static 
-void print_pnr_sdc_constrain_pb_graph_node_timing(const std::string& sdc_dir,
+bool print_pnr_sdc_constrain_pb_graph_node_timing(const std::string& sdc_dir,
                                                   const float& time_unit,
                                                   const bool& hierarchical,
                                                   const std::string& module_path,
@@ -261,6 +263,11 @@ void print_pnr_sdc_constrain_pb_graph_node_timing(const std::string& sdc_dir,
   ModuleId pb_module = module_manager.find_module(pb_module_name);
   VTR_ASSERT(true == module_manager.valid_module_id(pb_module));
 
+  /* Bypass the module which is merged into an identical module, which is constrained on its own */
+  if (pb_module_name != module_manager.module_name(pb_module)) {
+    return false;
+  }
+
   /* Create the file name for SDC */
   std::string sdc_fname(sdc_dir + pb_module_name + std::string(SDC_FILE_NAME_POSTFIX));
 
@@ -319,6 +326,8 @@ void print_pnr_sdc_constrain_pb_graph_node_timing(const std::string& sdc_dir,
   
   /* Close file handler */
   fp.close();
+
+  return true;
 }
 
 /********************************************************************
@@ -328,9 +337,11 @@ void print_pnr_sdc_constrain_pb_graph_node_timing(const std::string& sdc_dir,
  *
  * This is designed for LUT, adder or other hard IPs
  * When PnR the modules, we want to minimize the interconnect delay
+ *
+ * Return true if a SDC file is written for the pb_type
  *******************************************************************/
 static 
-void print_pnr_sdc_constrain_primitive_pb_graph_node(const std::string& sdc_dir,
+bool print_pnr_sdc_constrain_primitive_pb_graph_node(const std::string& sdc_dir,
                                                      const float& time_unit,
                                                      const bool& hierarchical,
                                                      const std::string& module_path,
@@ -370,7 +381,7 @@ void print_pnr_sdc_constrain_primitive_pb_graph_node(const std::string& sdc_dir,
 
   /* We can directly return if there is no timing annotation defined */
   if (0 == primitive_pb_type->num_annotations) {
-    return;
+    return false;
   } 
 
   /* Get the pb_type definition related to the node */
@@ -381,6 +392,11 @@ void print_pnr_sdc_constrain_primitive_pb_graph_node(const std::string& sdc_dir,
   ModuleId pb_module = module_manager.find_module(pb_module_name);
   VTR_ASSERT(true == module_manager.valid_module_id(pb_module));
 
+  /* Bypass the module which is merged into an identical module, which is constrained on its own */
+  if (pb_module_name != module_manager.module_name(pb_module)) {
+    return false;
+  }
+
   /* Create the file name for SDC */
   std::string sdc_fname(sdc_dir + pb_module_name + std::string(SDC_FILE_NAME_POSTFIX));
 
@@ -461,12 +477,27 @@ void print_pnr_sdc_constrain_primitive_pb_graph_node(const std::string& sdc_dir,
 
   /* Close file handler */
   fp.close();
+
+  return true;
+}
+
+/********************************************************************
+ * Add a module name to the list of constrained modules, unless it is already there.
+ * The same pb_type may be visited several times, e.g., for the I/O blocks on each side
+ *******************************************************************/
+static 
+void add_pnr_sdc_module_name(std::vector<std::string>& sdc_module_names,
+                             const std::string& module_name) {
+  if (sdc_module_names.end() == std::find(sdc_module_names.begin(), sdc_module_names.end(), module_name)) {
+    sdc_module_names.push_back(module_name);
+  }
 }
 
 /********************************************************************
  * Recursively print SDC timing constraints for a pb_type
  * This function will generate a SDC file for each pb_type,
  * constraining the pin-to-pin timing
+ * The name of each module constrained is added to sdc_module_names
  *******************************************************************/
 static 
 void rec_print_pnr_sdc_constrain_pb_graph_timing(const std::string& sdc_dir,
@@ -476,7 +507,8 @@ void rec_print_pnr_sdc_constrain_pb_graph_timing(const std::string& sdc_dir,
                                                  const ModuleManager& module_manager,
                                                  const VprDeviceAnnotation& device_annotation,
                                                  t_pb_graph_node* parent_pb_graph_node,
-                                                 const bool& constrain_zero_delay_paths) {
+                                                 const bool& constrain_zero_delay_paths,
+                                                 std::vector<std::string>& sdc_module_names) {
   /* Validate pb_graph node */
   if (nullptr == parent_pb_graph_node) {
     VTR_LOGF_ERROR(__FILE__, __LINE__,
@@ -489,13 +521,15 @@ void rec_print_pnr_sdc_constrain_pb_graph_timing(const std::string& sdc_dir,
 
   /* Constrain the primitive node if a timing matrix is defined */
   if (true == is_primitive_pb_type(parent_pb_type)) {
-    print_pnr_sdc_constrain_primitive_pb_graph_node(sdc_dir,
-                                                    time_unit,
-                                                    hierarchical,
-                                                    module_path,
-                                                    module_manager,
-                                                    parent_pb_graph_node,
-                                                    constrain_zero_delay_paths);
+    if (true == print_pnr_sdc_constrain_primitive_pb_graph_node(sdc_dir,
+                                                                time_unit,
+                                                                hierarchical,
+                                                                module_path,
+                                                                module_manager,
+                                                                parent_pb_graph_node,
+                                                                constrain_zero_delay_paths)) {
+      add_pnr_sdc_module_name(sdc_module_names, generate_physical_block_module_name(parent_pb_type));
+    }
     return;
   }
 
@@ -505,14 +539,16 @@ void rec_print_pnr_sdc_constrain_pb_graph_timing(const std::string& sdc_dir,
   t_mode* physical_mode = device_annotation.physical_mode(parent_pb_type);  
 
   /* Write a SDC file for this pb_type */
-  print_pnr_sdc_constrain_pb_graph_node_timing(sdc_dir,
-                                               time_unit,
-                                               hierarchical,
-                                               module_path,
-                                               module_manager,
-                                               parent_pb_graph_node,
-                                               physical_mode,
-                                               constrain_zero_delay_paths);
+  if (true == print_pnr_sdc_constrain_pb_graph_node_timing(sdc_dir,
+                                                           time_unit,
+                                                           hierarchical,
+                                                           module_path,
+                                                           module_manager,
+                                                           parent_pb_graph_node,
+                                                           physical_mode,
+                                                           constrain_zero_delay_paths)) {
+    add_pnr_sdc_module_name(sdc_module_names, generate_physical_block_module_name(parent_pb_type));
+  }
 
   /* Go recursively to the lower level in the pb_graph
    * Note that we assume a full hierarchical P&R, we will only visit pb_graph_node of unique pb_type 
@@ -525,25 +561,30 @@ void rec_print_pnr_sdc_constrain_pb_graph_timing(const std::string& sdc_dir,
                                                 module_manager, 
                                                 device_annotation,
                                                 &(parent_pb_graph_node->child_pb_graph_nodes[physical_mode->index][ipb][0]),
-                                                constrain_zero_delay_paths);
+                                                constrain_zero_delay_paths,
+                                                sdc_module_names);
   }
 }
 
 /********************************************************************
  * Top-level function to print timing constraints for pb_types
+ * Return the names of the modules which have their own SDC files,
+ * each of which appears only once
  *******************************************************************/
-void print_pnr_sdc_constrain_grid_timing(const std::string& sdc_dir,
-                                         const float& time_unit,
-                                         const bool& hierarchical,
-                                         const DeviceContext& device_ctx,
-                                         const VprDeviceAnnotation& device_annotation,
-                                         const ModuleManager& module_manager,
-                                         const ModuleId& top_module,
-                                         const bool& constrain_zero_delay_paths) {
+std::vector<std::string> print_pnr_sdc_constrain_grid_timing(const std::string& sdc_dir,
+                                                             const float& time_unit,
+                                                             const bool& hierarchical,
+                                                             const DeviceContext& device_ctx,
+                                                             const VprDeviceAnnotation& device_annotation,
+                                                             const ModuleManager& module_manager,
+                                                             const ModuleId& top_module,
+                                                             const bool& constrain_zero_delay_paths) {
 
   /* Start time count */
   vtr::ScopedStartFinishTimer timer("Write SDC for constraining grid timing for P&R flow");
 
+  std::vector<std::string> sdc_module_names;
+
   std::string root_path = format_dir_path(module_manager.module_name(top_module));
 
   for (const t_physical_tile_type& physical_tile : device_ctx.physical_tile_types) {
@@ -590,7 +631,8 @@ void print_pnr_sdc_constrain_grid_timing(const std::string& sdc_dir,
                                                     module_manager, 
                                                     device_annotation,
                                                     pb_graph_head,
-                                                    constrain_zero_delay_paths);
+                                                    constrain_zero_delay_paths,
+                                                    sdc_module_names);
       }
     } else {
       /* For CLB and heterogenenous blocks */
@@ -611,9 +653,12 @@ void print_pnr_sdc_constrain_grid_timing(const std::string& sdc_dir,
                                                   module_manager, 
                                                   device_annotation,
                                                   pb_graph_head,
-                                                  constrain_zero_delay_paths);
+                                                  constrain_zero_delay_paths,
+                                                  sdc_module_names);
     }
   }
+
+  return sdc_module_names;
 }
 
 } /* end namespace openfpga */
@@ -17,14 +17,14 @@
 /* begin namespace openfpga */
 namespace openfpga {
 
-void print_pnr_sdc_constrain_grid_timing(const std::string& sdc_dir,
-                                         const float& time_unit,
-                                         const bool& hierarchical,
-                                         const DeviceContext& device_ctx,
-                                         const VprDeviceAnnotation& device_annotation,
-                                         const ModuleManager& module_manager,
-                                         const ModuleId& top_module,
-                                         const bool& constrain_zero_delay_paths);
+std::vector<std::string> print_pnr_sdc_constrain_grid_timing(const std::string& sdc_dir,
+                                                             const float& time_unit,
+                                                             const bool& hierarchical,
+                                                             const DeviceContext& device_ctx,
+                                                             const VprDeviceAnnotation& device_annotation,
+                                                             const ModuleManager& module_manager,
+                                                             const ModuleId& top_module,
+                                                             const bool& constrain_zero_delay_paths);
 
 } /* end namespace openfpga */
 
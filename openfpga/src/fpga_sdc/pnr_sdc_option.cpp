@@ -12,6 +12,7 @@ namespace openfpga {
 PnrSdcOption::PnrSdcOption(const std::string& sdc_dir) {
   sdc_dir_ = sdc_dir;
   hierarchical_ = false;
+  unique_modules_ = false;
   flatten_names_ = false;
   time_unit_ = 1.;
   constrain_global_port_ = false;
@@ -23,6 +24,7 @@ PnrSdcOption::PnrSdcOption(const std::string& sdc_dir) {
   constrain_routing_multiplexer_outputs_ = false;
   constrain_switch_block_outputs_ = false;
   constrain_zero_delay_paths_ = false;
+  num_threads_ = 1;
 }
 
 /********************************************************************
@@ -40,6 +42,10 @@ bool PnrSdcOption::hierarchical() const {
   return hierarchical_;
 }
 
+bool PnrSdcOption::unique_modules() const {
+  return unique_modules_;
+}
+
 float PnrSdcOption::time_unit() const {
   return time_unit_;
 }
@@ -94,6 +100,10 @@ bool PnrSdcOption::constrain_zero_delay_paths() const {
   return constrain_zero_delay_paths_;
 }
 
+size_t PnrSdcOption::num_threads() const {
+  return num_threads_;
+}
+
 /********************************************************************
  * Public mutators
  ********************************************************************/
@@ -109,6 +119,10 @@ void PnrSdcOption::set_hierarchical(const bool& hierarchical) {
   hierarchical_ = hierarchical;
 }
 
+void PnrSdcOption::set_unique_modules(const bool& unique_modules) {
+  unique_modules_ = unique_modules;
+}
+
 void PnrSdcOption::set_time_unit(const float& time_unit) {
   time_unit_ = time_unit;
 }
@@ -163,4 +177,8 @@ void PnrSdcOption::set_constrain_zero_delay_paths(const bool& constrain_zero_del
   constrain_zero_delay_paths_ = constrain_zero_delay_paths;
 }
 
+void PnrSdcOption::set_num_threads(const size_t& num_threads) {
+  num_threads_ = num_threads;
+}
+
 } /* end namespace openfpga */
@@ -18,6 +18,7 @@ class PnrSdcOption {
     std::string sdc_dir() const;
     bool flatten_names() const;
     bool hierarchical() const;
+    bool unique_modules() const;
     float time_unit() const;
     bool output_hierarchy() const;
     bool generate_sdc_pnr() const;
@@ -30,10 +31,12 @@ class PnrSdcOption {
     bool constrain_routing_multiplexer_outputs() const;
     bool constrain_switch_block_outputs() const;
     bool constrain_zero_delay_paths() const;
+    size_t num_threads() const;
   public: /* Public mutators */
     void set_sdc_dir(const std::string& sdc_dir);
     void set_flatten_names(const bool& flatten_names);
     void set_hierarchical(const bool& hierarchical);
+    void set_unique_modules(const bool& unique_modules);
     void set_time_unit(const float& time_unit);
     void set_output_hierarchy(const bool& output_hierarchy);
     void set_generate_sdc_pnr(const bool& generate_sdc_pnr);
@@ -46,10 +49,13 @@ class PnrSdcOption {
     void set_constrain_routing_multiplexer_outputs(const bool& constrain_routing_mux_outputs);
     void set_constrain_switch_block_outputs(const bool& constrain_sb_outputs);
     void set_constrain_zero_delay_paths(const bool& constrain_zero_delay_paths);
+    void set_num_threads(const size_t& num_threads);
   private: /* Internal data */
     std::string sdc_dir_;
     bool flatten_names_;
     bool hierarchical_;
+    /* Write a top-level SDC file which applies the SDC file of each module to all its instances */
+    bool unique_modules_;
     float time_unit_;
     bool output_hierarchy_;
     bool constrain_global_port_; 
@@ -61,6 +67,8 @@ class PnrSdcOption {
     bool constrain_routing_multiplexer_outputs_;
     bool constrain_switch_block_outputs_;
     bool constrain_zero_delay_paths_;
+    /* Number of threads to write the SDC files of routing blocks */
+    size_t num_threads_;
 };
 
 } /* end namespace openfpga */
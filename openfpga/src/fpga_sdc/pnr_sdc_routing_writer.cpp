@@ -20,6 +20,8 @@
 #include "openfpga_port.h"
 #include "openfpga_side_manager.h"
 #include "openfpga_digest.h"
+#include "openfpga_parallel.h"
+#include "openfpga_progress.h"
 
 #include "mux_utils.h"
 
@@ -35,15 +37,6 @@
 /* begin namespace openfpga */
 namespace openfpga {
 
-/********************************************************************
- * Find the timing constraints between the inputs and outputs of a routing
- * multiplexer in a Switch Block
- *******************************************************************/
-static 
-float find_pnr_sdc_switch_tmax(const t_rr_switch_inf& switch_inf) {
-  return switch_inf.R * switch_inf.Cout + switch_inf.Tdel;
-}
-
 /********************************************************************
  * Set timing constraints between the inputs and outputs of a routing
  * multiplexer in a Switch Block
@@ -55,52 +48,41 @@ void print_pnr_sdc_constrain_sb_mux_timing(std::fstream& fp,
                                            const std::string& module_path,
                                            const ModuleManager& module_manager,
                                            const ModuleId& sb_module, 
-                                           const VprDeviceAnnotation& device_annotation,
-                                           const DeviceGrid& grids,
+                                           const DeviceRRGSBModulePorts& gsb_module_ports,
                                            const RRGraph& rr_graph,
                                            const RRGSB& rr_gsb,
                                            const e_side& output_node_side,
-                                           const RRNodeId& output_rr_node,
+                                           const size_t& output_track_id,
                                            const bool& constrain_zero_delay_paths) {
   /* Validate file stream */
   valid_file_stream(fp);
 
+  const RRNodeId& output_rr_node = rr_gsb.get_chan_node(output_node_side, output_track_id);
   VTR_ASSERT(  ( CHANX == rr_graph.node_type(output_rr_node) )
             || ( CHANY == rr_graph.node_type(output_rr_node) ));
 
   /* Find the module port corresponding to the output rr_node */
-  ModulePinInfo module_output_port = find_switch_block_module_chan_port(module_manager, 
-                                                                        sb_module,
-                                                                        rr_graph, 
-                                                                        rr_gsb, 
-                                                                        output_node_side,
-                                                                        output_rr_node,
-                                                                        OUT_PORT);
+  ModulePinInfo module_output_port = gsb_module_ports.sb_chan_port(rr_gsb, output_node_side, output_track_id);
 
   /* Find the module port corresponding to the fan-in rr_nodes of the output rr_node */
-  std::vector<ModulePinInfo> module_input_ports = find_switch_block_module_input_ports(module_manager,
-                                                                                       sb_module, 
-                                                                                       grids, 
-                                                                                       device_annotation, 
-                                                                                       rr_graph, 
-                                                                                       rr_gsb, 
-                                                                                       get_rr_graph_configurable_driver_nodes(rr_graph, output_rr_node));
-
-  /* Find timing constraints for each path (edge) */
-  std::map<ModulePinInfo, float> switch_delays;
-  size_t edge_counter = 0;
-  for (const RREdgeId& edge : rr_graph.node_configurable_in_edges(output_rr_node)) {
+  const std::vector<ModulePinInfo>& module_input_ports = gsb_module_ports.sb_chan_driver_ports(rr_gsb, output_node_side, output_track_id);
+
+  /* Find timing constraints for each path (edge), in the same order as the input ports */
+  std::vector<float> switch_delays;
+  switch_delays.reserve(module_input_ports.size());
+  for (const RREdgeId& edge : rr_gsb.get_chan_node_driver_edges(output_node_side, output_track_id)) {
     /* Get the switch delay */
     const RRSwitchId& driver_switch = rr_graph.edge_switch(edge);
-    switch_delays[module_input_ports[edge_counter]] = find_pnr_sdc_switch_tmax(rr_graph.get_switch(driver_switch));
-    edge_counter++;
+    switch_delays.push_back(find_pnr_sdc_switch_tmax(rr_graph.get_switch(driver_switch)));
   }
+  VTR_ASSERT(switch_delays.size() == module_input_ports.size());
 
   /* Find the starting points */
-  for (const ModulePinInfo& module_input_port : module_input_ports) {
+  for (size_t iedge = 0; iedge < module_input_ports.size(); ++iedge) {
+    const ModulePinInfo& module_input_port = module_input_ports[iedge];
     /* If we have a zero-delay path to contrain, we will skip unless users want so */
     if ( (false == constrain_zero_delay_paths)
-      && (0. == switch_delays[module_input_port]) ) {
+      && (0. == switch_delays[iedge]) ) {
       continue;
     }
 
@@ -119,7 +101,7 @@ void print_pnr_sdc_constrain_sb_mux_timing(std::fstream& fp,
                                         generate_sdc_port(src_port),
                                         module_path,
                                         generate_sdc_port(sink_port),
-                                        switch_delays[module_input_port] / time_unit);
+                                        switch_delays[iedge] / time_unit);
 
     } else {
       VTR_ASSERT_SAFE(true == hierarchical);
@@ -128,7 +110,7 @@ void print_pnr_sdc_constrain_sb_mux_timing(std::fstream& fp,
                                         generate_sdc_port(src_port),
                                         std::string(),
                                         generate_sdc_port(sink_port),
-                                        switch_delays[module_input_port] / time_unit);
+                                        switch_delays[iedge] / time_unit);
     }
   }
 }
@@ -147,8 +129,7 @@ void print_pnr_sdc_constrain_sb_timing(const std::string& sdc_dir,
                                        const bool& hierarchical,
                                        const std::string& module_path,
                                        const ModuleManager& module_manager,
-                                       const VprDeviceAnnotation& device_annotation,
-                                       const DeviceGrid& grids,
+                                       const DeviceRRGSBModulePorts& gsb_module_ports,
                                        const RRGraph& rr_graph,
                                        const RRGSB& rr_gsb,
                                        const bool& constrain_zero_delay_paths) {
@@ -177,7 +158,6 @@ void print_pnr_sdc_constrain_sb_timing(const std::string& sdc_dir,
   for (size_t side = 0; side < rr_gsb.get_num_sides(); ++side) {
     SideManager side_manager(side);
     for (size_t itrack = 0; itrack < rr_gsb.get_chan_width(side_manager.get_side()); ++itrack) {
-      const RRNodeId& chan_rr_node = rr_gsb.get_chan_node(side_manager.get_side(), itrack);
       /* We only care the output port and it should indicate a SB mux */
       if (OUT_PORT != rr_gsb.get_chan_node_direction(side_manager.get_side(), itrack)) { 
         continue; 
@@ -192,12 +172,11 @@ void print_pnr_sdc_constrain_sb_timing(const std::string& sdc_dir,
                                             hierarchical,
                                             module_path,
                                             module_manager, sb_module, 
-                                            device_annotation,
-                                            grids,
+                                            gsb_module_ports,
                                             rr_graph,
                                             rr_gsb,
                                             side_manager.get_side(),
-                                            chan_rr_node,
+                                            itrack,
                                             constrain_zero_delay_paths);
     }
   }
@@ -215,11 +194,11 @@ void print_pnr_sdc_flatten_routing_constrain_sb_timing(const std::string& sdc_di
                                                        const bool& hierarchical,
                                                        const ModuleManager& module_manager,
                                                        const ModuleId& top_module,
-                                                       const VprDeviceAnnotation& device_annotation,
-                                                       const DeviceGrid& grids,
+                                                       const DeviceRRGSBModulePorts& gsb_module_ports,
                                                        const RRGraph& rr_graph,
                                                        const DeviceRRGSB& device_rr_gsb,
-                                                       const bool& constrain_zero_delay_paths) {
+                                                       const bool& constrain_zero_delay_paths,
+                                                       const size_t& num_threads) {
 
   /* Start time count */
   vtr::ScopedStartFinishTimer timer("Write SDC for constrain Switch Block timing for P&R flow");
@@ -228,34 +207,42 @@ void print_pnr_sdc_flatten_routing_constrain_sb_timing(const std::string& sdc_di
 
   /* Get the range of SB array */
   vtr::Point<size_t> sb_range = device_rr_gsb.get_gsb_range();
-  /* Go for each SB */
+  /* Collect all the SBs, so that their SDC files can be written in parallel */
+  std::vector<const RRGSB*> sb_gsbs;
   for (size_t ix = 0; ix < sb_range.x(); ++ix) {
     for (size_t iy = 0; iy < sb_range.y(); ++iy) {
       const RRGSB& rr_gsb = device_rr_gsb.get_gsb(ix, iy);
       if (false == rr_gsb.is_sb_exist()) {
         continue;
       }
+      sb_gsbs.push_back(&rr_gsb);
+    }
+  }
 
-      vtr::Point<size_t> gsb_coordinate(rr_gsb.get_sb_x(), rr_gsb.get_sb_y());
-      std::string sb_instance_name = generate_switch_block_module_name(gsb_coordinate); 
+  /* Go for each SB */
+  ProgressReporter progress("Writing SDC for Switch Blocks", sb_gsbs.size());
+  parallel_for(sb_gsbs.size(), num_threads, [&](const size_t& isb) {
+    const RRGSB& rr_gsb = *(sb_gsbs[isb]);
 
-      ModuleId sb_module = module_manager.find_module(sb_instance_name);
-      VTR_ASSERT(true == module_manager.valid_module_id(sb_module));
+    vtr::Point<size_t> gsb_coordinate(rr_gsb.get_sb_x(), rr_gsb.get_sb_y());
+    std::string sb_instance_name = generate_switch_block_module_name(gsb_coordinate); 
 
-      std::string module_path = format_dir_path(root_path) + sb_instance_name;
+    ModuleId sb_module = module_manager.find_module(sb_instance_name);
+    VTR_ASSERT(true == module_manager.valid_module_id(sb_module));
 
-      print_pnr_sdc_constrain_sb_timing(sdc_dir,
-                                        time_unit,
-                                        hierarchical,
-                                        module_path,
-                                        module_manager,
-                                        device_annotation,
-                                        grids,
-                                        rr_graph,
-                                        rr_gsb,
-                                        constrain_zero_delay_paths);
-    }
-  }
+    std::string module_path = format_dir_path(root_path) + sb_instance_name;
+
+    print_pnr_sdc_constrain_sb_timing(sdc_dir,
+                                      time_unit,
+                                      hierarchical,
+                                      module_path,
+                                      module_manager,
+                                      gsb_module_ports,
+                                      rr_graph,
+                                      rr_gsb,
+                                      constrain_zero_delay_paths);
+    progress.advance();
+  });
 }
 
 /********************************************************************
@@ -267,21 +254,22 @@ void print_pnr_sdc_compact_routing_constrain_sb_timing(const std::string& sdc_di
                                                        const bool& hierarchical,
                                                        const ModuleManager& module_manager,
                                                        const ModuleId& top_module,
-                                                       const VprDeviceAnnotation& device_annotation,
-                                                       const DeviceGrid& grids,
+                                                       const DeviceRRGSBModulePorts& gsb_module_ports,
                                                        const RRGraph& rr_graph,
                                                        const DeviceRRGSB& device_rr_gsb,
-                                                       const bool& constrain_zero_delay_paths) {
+                                                       const bool& constrain_zero_delay_paths,
+                                                       const size_t& num_threads) {
 
   /* Start time count */
   vtr::ScopedStartFinishTimer timer("Write SDC for constrain Switch Block timing for P&R flow");
 
   std::string root_path = module_manager.module_name(top_module);
 
-  for (size_t isb = 0; isb < device_rr_gsb.get_num_sb_unique_module(); ++isb) {
+  /* Each unique SB has its own SDC file, which can be written in parallel */
+  parallel_for(device_rr_gsb.get_num_sb_unique_module(), num_threads, [&](const size_t& isb) {
     const RRGSB& rr_gsb = device_rr_gsb.get_sb_unique_module(isb);
     if (false == rr_gsb.is_sb_exist()) {
-      continue;
+      return;
     }
 
     /* Find all the sb instance under this module
@@ -300,12 +288,11 @@ void print_pnr_sdc_compact_routing_constrain_sb_timing(const std::string& sdc_di
                                       hierarchical,
                                       module_path,
                                       module_manager,
-                                      device_annotation,
-                                      grids,
+                                      gsb_module_ports,
                                       rr_graph,
                                       rr_gsb,
                                       constrain_zero_delay_paths);
-  }
+  });
 }
 
 /********************************************************************
@@ -319,72 +306,50 @@ void print_pnr_sdc_constrain_cb_mux_timing(std::fstream& fp,
                                            const std::string& module_path,
                                            const ModuleManager& module_manager,
                                            const ModuleId& cb_module, 
-                                           const VprDeviceAnnotation& device_annotation,
-                                           const DeviceGrid& grids,
+                                           const DeviceRRGSBModulePorts& gsb_module_ports,
                                            const RRGraph& rr_graph,
                                            const RRGSB& rr_gsb,
                                            const t_rr_type& cb_type,
-                                           const RRNodeId& output_rr_node,
+                                           const e_side& output_node_side,
+                                           const size_t& output_node_id,
                                            const bool& constrain_zero_delay_paths) {
   /* Validate file stream */
   valid_file_stream(fp);
 
+  const RRNodeId& output_rr_node = rr_gsb.get_ipin_node(output_node_side, output_node_id);
   VTR_ASSERT(IPIN == rr_graph.node_type(output_rr_node));
   
-  /* We have OPINs since we may have direct connections:
+  /* Find the module port corresponding to the fan-in rr_nodes of the output rr_node
+   *
+   * We have OPINs since we may have direct connections:
    * These connections should be handled by other functions in the compact_netlist.c 
-   * So we just return here for OPINs 
+   * So there is no input port for those IPINs, as well as those without configurable drivers
    */
-  std::vector<RRNodeId> input_rr_nodes = get_rr_graph_configurable_driver_nodes(rr_graph, output_rr_node);
-
-  if (0 == input_rr_nodes.size()) {
-    return;
-  }
-
-  /* Xifan Tang: VPR considers delayless switch to be configurable
-   * As a result, the direct connection is considered to be configurable...
-   * Here, I simply kick out OPINs in CB connection because they should be built
-   * in the top mopdule.
-   * 
-   * Note: this MUST BE reconsidered if we do have OPIN connected to IPINs 
-   * through a programmable multiplexer!!!
-   */
-  if (true == is_ipin_direct_connected_opin(rr_graph, output_rr_node)) {
+  const std::vector<ModulePinInfo>& module_input_ports = gsb_module_ports.cb_ipin_driver_ports(cb_type, rr_gsb, output_node_side, output_node_id);
+  if (0 == module_input_ports.size()) {
     return;
   }
 
   /* Find the module port corresponding to the output rr_node */
-  ModulePortId module_output_port = find_connection_block_module_ipin_port(module_manager, 
-                                                                           cb_module,
-                                                                           grids,
-                                                                           device_annotation,
-                                                                           rr_graph, 
-                                                                           rr_gsb, 
-                                                                           output_rr_node);
+  ModulePortId module_output_port = gsb_module_ports.cb_ipin_port(cb_type, rr_gsb, output_node_side, output_node_id);
+  VTR_ASSERT(true == module_manager.valid_module_port_id(cb_module, module_output_port));
 
-  /* Find the module port corresponding to the fan-in rr_nodes of the output rr_node */
-  std::vector<ModulePinInfo> module_input_ports = find_connection_block_module_input_ports(module_manager,
-                                                                                           cb_module, 
-                                                                                           rr_graph, 
-                                                                                           rr_gsb, 
-                                                                                           cb_type,
-                                                                                           input_rr_nodes);
-
-  /* Find timing constraints for each path (edge) */
-  std::map<ModulePinInfo, float> switch_delays;
-  size_t edge_counter = 0;
-  for (const RREdgeId& edge : rr_graph.node_configurable_in_edges(output_rr_node)) {
+  /* Find timing constraints for each path (edge), in the same order as the input ports */
+  std::vector<float> switch_delays;
+  switch_delays.reserve(module_input_ports.size());
+  for (const RREdgeId& edge : rr_gsb.get_ipin_node_driver_edges(output_node_side, output_node_id)) {
     /* Get the switch delay */
     const RRSwitchId& driver_switch = rr_graph.edge_switch(edge);
-    switch_delays[module_input_ports[edge_counter]] = find_pnr_sdc_switch_tmax(rr_graph.get_switch(driver_switch));
-    edge_counter++;
+    switch_delays.push_back(find_pnr_sdc_switch_tmax(rr_graph.get_switch(driver_switch)));
   }
+  VTR_ASSERT(switch_delays.size() == module_input_ports.size());
 
   /* Find the starting points */
-  for (const ModulePinInfo& module_input_port : module_input_ports) {
+  for (size_t iedge = 0; iedge < module_input_ports.size(); ++iedge) {
+    const ModulePinInfo& module_input_port = module_input_ports[iedge];
     /* If we have a zero-delay path to contrain, we will skip unless users want so */
     if ( (false == constrain_zero_delay_paths)
-      && (0. == switch_delays[module_input_port]) ) {
+      && (0. == switch_delays[iedge]) ) {
       continue;
     }
 
@@ -400,7 +365,7 @@ void print_pnr_sdc_constrain_cb_mux_timing(std::fstream& fp,
                                         generate_sdc_port(input_port),
                                         std::string(),
                                         generate_sdc_port(output_port),
-                                        switch_delays[module_input_port] / time_unit);
+                                        switch_delays[iedge] / time_unit);
 
     } else {
       VTR_ASSERT_SAFE(false == hierarchical);
@@ -409,7 +374,7 @@ void print_pnr_sdc_constrain_cb_mux_timing(std::fstream& fp,
                                         generate_sdc_port(input_port),
                                         std::string(module_path),
                                         generate_sdc_port(output_port),
-                                        switch_delays[module_input_port] / time_unit);
+                                        switch_delays[iedge] / time_unit);
 
     }
   }
@@ -425,8 +390,7 @@ void print_pnr_sdc_constrain_cb_timing(const std::string& sdc_dir,
                                        const bool& hierarchical,
                                        const std::string& module_path,
                                        const ModuleManager& module_manager,
-                                       const VprDeviceAnnotation& device_annotation,
-                                       const DeviceGrid& grids,
+                                       const DeviceRRGSBModulePorts& gsb_module_ports,
                                        const RRGraph& rr_graph,
                                        const RRGSB& rr_gsb, 
                                        const t_rr_type& cb_type,
@@ -457,20 +421,14 @@ void print_pnr_sdc_constrain_cb_timing(const std::string& sdc_dir,
   /* Contrain each routing track inside the connection block */
   for (size_t itrack = 0; itrack < rr_gsb.get_cb_chan_width(cb_type); ++itrack) {
     /* Create a port description for the input */
-    std::string input_port_name = generate_cb_module_track_port_name(cb_type,
-                                                                     IN_PORT,
-                                                                     0 == itrack % 2);
-    ModulePortId input_port_id = module_manager.find_module_port(cb_module, input_port_name);
-    BasicPort input_port(module_manager.module_port(cb_module, input_port_id).get_name(),
-                         itrack / 2, itrack / 2);
+    ModulePinInfo input_port_info = gsb_module_ports.cb_chan_port(cb_type, rr_gsb, itrack, IN_PORT);
+    BasicPort input_port(module_manager.module_port(cb_module, input_port_info.first).get_name(),
+                         input_port_info.second, input_port_info.second);
 
     /* Create a port description for the output */
-    std::string output_port_name = generate_cb_module_track_port_name(cb_type,
-                                                                      OUT_PORT,
-                                                                      0 == itrack % 2);
-    ModulePortId output_port_id = module_manager.find_module_port(cb_module, output_port_name);
-    BasicPort output_port(module_manager.module_port(cb_module, output_port_id).get_name(),
-                          itrack / 2, itrack / 2);
+    ModulePinInfo output_port_info = gsb_module_ports.cb_chan_port(cb_type, rr_gsb, itrack, OUT_PORT);
+    BasicPort output_port(module_manager.module_port(cb_module, output_port_info.first).get_name(),
+                          output_port_info.second, output_port_info.second);
 
     /* Connection block routing segment ids for each track */
     RRSegmentId segment_id = rr_gsb.get_chan_node_segment(rr_gsb.get_cb_chan_side(cb_type), itrack);
@@ -516,15 +474,13 @@ void print_pnr_sdc_constrain_cb_timing(const std::string& sdc_dir,
     enum e_side cb_ipin_side = cb_sides[side];
     SideManager side_manager(cb_ipin_side);
     for (size_t inode = 0; inode < rr_gsb.get_num_ipin_nodes(cb_ipin_side); ++inode) {
-      const RRNodeId& ipin_rr_node = rr_gsb.get_ipin_node(cb_ipin_side, inode);
       print_pnr_sdc_constrain_cb_mux_timing(fp,
                                             time_unit,
                                             hierarchical, module_path,
                                             module_manager, cb_module, 
-                                            device_annotation,
-                                            grids,
+                                            gsb_module_ports,
                                             rr_graph, rr_gsb, cb_type,
-                                            ipin_rr_node,
+                                            cb_ipin_side, inode,
                                             constrain_zero_delay_paths);
     }
   }
@@ -543,17 +499,19 @@ void print_pnr_sdc_flatten_routing_constrain_cb_timing(const std::string& sdc_di
                                                        const bool& hierarchical,
                                                        const ModuleManager& module_manager, 
                                                        const ModuleId& top_module,
-                                                       const VprDeviceAnnotation& device_annotation,
-                                                       const DeviceGrid& grids,
+                                                       const DeviceRRGSBModulePorts& gsb_module_ports,
                                                        const RRGraph& rr_graph,
                                                        const DeviceRRGSB& device_rr_gsb,
                                                        const t_rr_type& cb_type,
-                                                       const bool& constrain_zero_delay_paths) {
+                                                       const bool& constrain_zero_delay_paths,
+                                                       const size_t& num_threads) {
   /* Build unique X-direction connection block modules */
   vtr::Point<size_t> cb_range = device_rr_gsb.get_gsb_range();
 
   std::string root_path = module_manager.module_name(top_module);
 
+  /* Collect all the connection blocks, so that their SDC files can be written in parallel */
+  std::vector<const RRGSB*> cb_gsbs;
   for (size_t ix = 0; ix < cb_range.x(); ++ix) {
     for (size_t iy = 0; iy < cb_range.y(); ++iy) {
       /* Check if the connection block exists in the device!
@@ -564,31 +522,36 @@ void print_pnr_sdc_flatten_routing_constrain_cb_timing(const std::string& sdc_di
       if (false == rr_gsb.is_cb_exist(cb_type)) {
         continue;
       }
+      cb_gsbs.push_back(&rr_gsb);
+    }
+  }
 
-      /* Find all the cb instance under this module
-       * Create a regular expression to include these instance names 
-       */
-      vtr::Point<size_t> gsb_coordinate(rr_gsb.get_cb_x(cb_type), rr_gsb.get_cb_y(cb_type));
-      std::string cb_instance_name = generate_connection_block_module_name(cb_type, gsb_coordinate); 
-      ModuleId cb_module = module_manager.find_module(cb_instance_name);
-      VTR_ASSERT(true == module_manager.valid_module_id(cb_module));
+  ProgressReporter progress("Writing SDC for Connection Blocks", cb_gsbs.size());
+  parallel_for(cb_gsbs.size(), num_threads, [&](const size_t& icb) {
+    const RRGSB& rr_gsb = *(cb_gsbs[icb]);
 
-      std::string module_path = format_dir_path(root_path) + cb_instance_name;
+    /* Find all the cb instance under this module
+     * Create a regular expression to include these instance names 
+     */
+    vtr::Point<size_t> gsb_coordinate(rr_gsb.get_cb_x(cb_type), rr_gsb.get_cb_y(cb_type));
+    std::string cb_instance_name = generate_connection_block_module_name(cb_type, gsb_coordinate); 
+    ModuleId cb_module = module_manager.find_module(cb_instance_name);
+    VTR_ASSERT(true == module_manager.valid_module_id(cb_module));
 
-      print_pnr_sdc_constrain_cb_timing(sdc_dir,
-                                        time_unit,
-                                        hierarchical,
-                                        module_path,
-                                        module_manager,
-                                        device_annotation, 
-                                        grids, 
-                                        rr_graph, 
-                                        rr_gsb, 
-                                        cb_type,
-                                        constrain_zero_delay_paths);
+    std::string module_path = format_dir_path(root_path) + cb_instance_name;
 
-    }
-  }
+    print_pnr_sdc_constrain_cb_timing(sdc_dir,
+                                      time_unit,
+                                      hierarchical,
+                                      module_path,
+                                      module_manager,
+                                      gsb_module_ports,
+                                      rr_graph, 
+                                      rr_gsb, 
+                                      cb_type,
+                                      constrain_zero_delay_paths);
+    progress.advance();
+  });
 }
 
 /********************************************************************
@@ -600,11 +563,11 @@ void print_pnr_sdc_flatten_routing_constrain_cb_timing(const std::string& sdc_di
                                                        const bool& hierarchical,
                                                        const ModuleManager& module_manager, 
                                                        const ModuleId& top_module,
-                                                       const VprDeviceAnnotation& device_annotation,
-                                                       const DeviceGrid& grids,
+                                                       const DeviceRRGSBModulePorts& gsb_module_ports,
                                                        const RRGraph& rr_graph,
                                                        const DeviceRRGSB& device_rr_gsb,
-                                                       const bool& constrain_zero_delay_paths) {
+                                                       const bool& constrain_zero_delay_paths,
+                                                       const size_t& num_threads) {
 
   /* Start time count */
   vtr::ScopedStartFinishTimer timer("Write SDC for constrain Connection Block timing for P&R flow");
@@ -612,22 +575,22 @@ void print_pnr_sdc_flatten_routing_constrain_cb_timing(const std::string& sdc_di
   print_pnr_sdc_flatten_routing_constrain_cb_timing(sdc_dir, time_unit,
                                                     hierarchical,
                                                     module_manager, top_module,
-                                                    device_annotation, 
-                                                    grids, 
+                                                    gsb_module_ports,
                                                     rr_graph,
                                                     device_rr_gsb,
                                                     CHANX,
-                                                    constrain_zero_delay_paths);
+                                                    constrain_zero_delay_paths,
+                                                    num_threads);
 
   print_pnr_sdc_flatten_routing_constrain_cb_timing(sdc_dir, time_unit,
                                                     hierarchical, 
                                                     module_manager, top_module,
-                                                    device_annotation, 
-                                                    grids, 
+                                                    gsb_module_ports,
                                                     rr_graph,
                                                     device_rr_gsb,
                                                     CHANY,
-                                                    constrain_zero_delay_paths);
+                                                    constrain_zero_delay_paths,
+                                                    num_threads);
 }
 
 /********************************************************************
@@ -639,11 +602,11 @@ void print_pnr_sdc_compact_routing_constrain_cb_timing(const std::string& sdc_di
                                                        const bool& hierarchical,
                                                        const ModuleManager& module_manager,
                                                        const ModuleId& top_module,
-                                                       const VprDeviceAnnotation& device_annotation,
-                                                       const DeviceGrid& grids,
+                                                       const DeviceRRGSBModulePorts& gsb_module_ports,
                                                        const RRGraph& rr_graph,
                                                        const DeviceRRGSB& device_rr_gsb,
-                                                       const bool& constrain_zero_delay_paths) {
+                                                       const bool& constrain_zero_delay_paths,
+                                                       const size_t& num_threads) {
 
   /* Start time count */
   vtr::ScopedStartFinishTimer timer("Write SDC for constrain Connection Block timing for P&R flow");
@@ -651,7 +614,7 @@ void print_pnr_sdc_compact_routing_constrain_cb_timing(const std::string& sdc_di
   std::string root_path = module_manager.module_name(top_module);
 
   /* Print SDC for unique X-direction connection block modules */
-  for (size_t icb = 0; icb < device_rr_gsb.get_num_cb_unique_module(CHANX); ++icb) {
+  parallel_for(device_rr_gsb.get_num_cb_unique_module(CHANX), num_threads, [&](const size_t& icb) {
     const RRGSB& unique_mirror = device_rr_gsb.get_cb_unique_module(CHANX, icb);
 
     /* Find all the cb instance under this module
@@ -669,16 +632,15 @@ void print_pnr_sdc_compact_routing_constrain_cb_timing(const std::string& sdc_di
                                       hierarchical,
                                       module_path,
                                       module_manager,
-                                      device_annotation, 
-                                      grids, 
+                                      gsb_module_ports,
                                       rr_graph, 
                                       unique_mirror, 
                                       CHANX,
                                       constrain_zero_delay_paths);
-  }
+  });
 
   /* Print SDC for unique Y-direction connection block modules */
-  for (size_t icb = 0; icb < device_rr_gsb.get_num_cb_unique_module(CHANY); ++icb) {
+  parallel_for(device_rr_gsb.get_num_cb_unique_module(CHANY), num_threads, [&](const size_t& icb) {
     const RRGSB& unique_mirror = device_rr_gsb.get_cb_unique_module(CHANY, icb);
 
     /* Find all the cb instance under this module
@@ -696,13 +658,12 @@ void print_pnr_sdc_compact_routing_constrain_cb_timing(const std::string& sdc_di
                                       hierarchical,
                                       module_path,
                                       module_manager,
-                                      device_annotation, 
-                                      grids, 
+                                      gsb_module_ports,
                                       rr_graph, 
                                       unique_mirror, 
                                       CHANY,
                                       constrain_zero_delay_paths);
-  }
+  });
 }
 
 } /* end namespace openfpga */
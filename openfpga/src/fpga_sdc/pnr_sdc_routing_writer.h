@@ -10,7 +10,7 @@
 #include "device_rr_gsb.h"
 #include "rr_graph_obj.h"
 #include "device_grid.h"
-#include "vpr_device_annotation.h"
+#include "device_rr_gsb_module_ports.h"
 
 /********************************************************************
  * Function declaration
@@ -24,44 +24,44 @@ void print_pnr_sdc_flatten_routing_constrain_sb_timing(const std::string& sdc_di
                                                        const bool& hierarchical,
                                                        const ModuleManager& module_manager,
                                                        const ModuleId& top_module,
-                                                       const VprDeviceAnnotation& device_annotation,
-                                                       const DeviceGrid& grids,
+                                                       const DeviceRRGSBModulePorts& gsb_module_ports,
                                                        const RRGraph& rr_graph,
                                                        const DeviceRRGSB& device_rr_gsb,
-                                                       const bool& constrain_zero_delay_paths);
+                                                       const bool& constrain_zero_delay_paths,
+                                                       const size_t& num_threads);
 
 void print_pnr_sdc_compact_routing_constrain_sb_timing(const std::string& sdc_dir,
                                                        const float& time_unit,
                                                        const bool& hierarchical,
                                                        const ModuleManager& module_manager,
                                                        const ModuleId& top_module,
-                                                       const VprDeviceAnnotation& device_annotation,
-                                                       const DeviceGrid& grids,
+                                                       const DeviceRRGSBModulePorts& gsb_module_ports,
                                                        const RRGraph& rr_graph,
                                                        const DeviceRRGSB& device_rr_gsb,
-                                                       const bool& constrain_zero_delay_paths);
+                                                       const bool& constrain_zero_delay_paths,
+                                                       const size_t& num_threads);
 
 void print_pnr_sdc_flatten_routing_constrain_cb_timing(const std::string& sdc_dir,
                                                        const float& time_unit,
                                                        const bool& hierarchical,
                                                        const ModuleManager& module_manager, 
                                                        const ModuleId& top_module,
-                                                       const VprDeviceAnnotation& device_annotation,
-                                                       const DeviceGrid& grids,
+                                                       const DeviceRRGSBModulePorts& gsb_module_ports,
                                                        const RRGraph& rr_graph,
                                                        const DeviceRRGSB& device_rr_gsb,
-                                                       const bool& constrain_zero_delay_paths);
+                                                       const bool& constrain_zero_delay_paths,
+                                                       const size_t& num_threads);
 
 void print_pnr_sdc_compact_routing_constrain_cb_timing(const std::string& sdc_dir,
                                                        const float& time_unit,
                                                        const bool& hierarchical,
                                                        const ModuleManager& module_manager,
                                                        const ModuleId& top_module,
-                                                       const VprDeviceAnnotation& device_annotation,
-                                                       const DeviceGrid& grids,
+                                                       const DeviceRRGSBModulePorts& gsb_module_ports,
                                                        const RRGraph& rr_graph,
                                                        const DeviceRRGSB& device_rr_gsb,
-                                                       const bool& constrain_zero_delay_paths);
+                                                       const bool& constrain_zero_delay_paths,
+                                                       const size_t& num_threads);
 
 } /* end namespace openfpga */
 
@@ -322,6 +322,7 @@ void print_pnr_sdc(const PnrSdcOption& sdc_options,
                    const DeviceContext& device_ctx,
                    const VprDeviceAnnotation& device_annotation,
                    const DeviceRRGSB& device_rr_gsb,
+                   const DeviceRRGSBModulePorts& gsb_module_ports,
                    const ModuleManager& module_manager,
                    const MuxLibrary& mux_lib,
                    const CircuitLibrary& circuit_lib,
@@ -382,11 +383,11 @@ void print_pnr_sdc(const PnrSdcOption& sdc_options,
                                                         sdc_options.hierarchical(),
                                                         module_manager,
                                                         top_module,
-                                                        device_annotation,
-                                                        device_ctx.grid,
+                                                        gsb_module_ports,
                                                         device_ctx.rr_graph,
                                                         device_rr_gsb,
-                                                        sdc_options.constrain_zero_delay_paths());
+                                                        sdc_options.constrain_zero_delay_paths(),
+                                                        sdc_options.num_threads());
     } else {
 	  VTR_ASSERT_SAFE (false == compact_routing_hierarchy);
       print_pnr_sdc_flatten_routing_constrain_sb_timing(sdc_options.sdc_dir(),
@@ -394,11 +395,11 @@ void print_pnr_sdc(const PnrSdcOption& sdc_options,
                                                         sdc_options.hierarchical(),
                                                         module_manager,
                                                         top_module,
-                                                        device_annotation,
-                                                        device_ctx.grid,
+                                                        gsb_module_ports,
                                                         device_ctx.rr_graph,
                                                         device_rr_gsb,
-                                                        sdc_options.constrain_zero_delay_paths());
+                                                        sdc_options.constrain_zero_delay_paths(),
+                                                        sdc_options.num_threads());
     }
   }
 
@@ -420,11 +421,11 @@ void print_pnr_sdc(const PnrSdcOption& sdc_options,
                                                         sdc_options.hierarchical(),
                                                         module_manager,
                                                         top_module,
-                                                        device_annotation,
-                                                        device_ctx.grid,
+                                                        gsb_module_ports,
                                                         device_ctx.rr_graph,
                                                         device_rr_gsb,
-                                                        sdc_options.constrain_zero_delay_paths());
+                                                        sdc_options.constrain_zero_delay_paths(),
+                                                        sdc_options.num_threads());
     } else {
 	  VTR_ASSERT_SAFE (false == compact_routing_hierarchy);
       print_pnr_sdc_flatten_routing_constrain_cb_timing(sdc_options.sdc_dir(),
@@ -432,11 +433,11 @@ void print_pnr_sdc(const PnrSdcOption& sdc_options,
                                                         sdc_options.hierarchical(),
                                                         module_manager, 
                                                         top_module,
-                                                        device_annotation,
-                                                        device_ctx.grid,
+                                                        gsb_module_ports,
                                                         device_ctx.rr_graph,
                                                         device_rr_gsb,
-                                                        sdc_options.constrain_zero_delay_paths());
+                                                        sdc_options.constrain_zero_delay_paths(),
+                                                        sdc_options.num_threads());
     }
   }
 
@@ -458,15 +459,16 @@ void print_pnr_sdc(const PnrSdcOption& sdc_options,
   }
 
   /* Output Timing constraints for Programmable blocks */
+  std::vector<std::string> grid_module_names;
   if (true == sdc_options.constrain_grid()) {
-    print_pnr_sdc_constrain_grid_timing(sdc_options.sdc_dir(),
-                                        sdc_options.time_unit(),
-                                        sdc_options.hierarchical(),
-                                        device_ctx,
-                                        device_annotation,
-                                        module_manager,
-                                        top_module,
-                                        sdc_options.constrain_zero_delay_paths());
+    grid_module_names = print_pnr_sdc_constrain_grid_timing(sdc_options.sdc_dir(),
+                                                            sdc_options.time_unit(),
+                                                            sdc_options.hierarchical(),
+                                                            device_ctx,
+                                                            device_annotation,
+                                                            module_manager,
+                                                            top_module,
+                                                            sdc_options.constrain_zero_delay_paths());
   }
 
   if ( (true == sdc_options.constrain_grid())
@@ -478,6 +480,17 @@ void print_pnr_sdc(const PnrSdcOption& sdc_options,
                                  top_module);
 
   }
+
+  /* Output a top-level SDC file which applies the SDC files of modules to their instances */
+  if (true == sdc_options.unique_modules()) {
+    VTR_ASSERT(true == sdc_options.hierarchical());
+    print_pnr_sdc_unique_module_top(sdc_options,
+                                    module_manager,
+                                    top_module,
+                                    device_rr_gsb,
+                                    grid_module_names,
+                                    compact_routing_hierarchy);
+  }
 }
 
 } /* end namespace openfpga */
@@ -9,6 +9,7 @@
 #include "vpr_context.h"
 #include "vpr_device_annotation.h"
 #include "device_rr_gsb.h"
+#include "device_rr_gsb_module_ports.h"
 #include "module_manager.h"
 #include "mux_library.h"
 #include "circuit_library.h"
@@ -27,6 +28,7 @@ void print_pnr_sdc(const PnrSdcOption& sdc_options,
                    const DeviceContext& device_ctx,
                    const VprDeviceAnnotation& device_annotation,
                    const DeviceRRGSB& device_rr_gsb,
+                   const DeviceRRGSBModulePorts& gsb_module_ports,
                    const ModuleManager& module_manager,
                    const MuxLibrary& mux_lib,
                    const CircuitLibrary& circuit_lib,
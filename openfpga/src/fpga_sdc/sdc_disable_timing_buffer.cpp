@@ -0,0 +1,97 @@
+/********************************************************************
+ * Member functions for data structure SdcDisableTimingBuffer
+ ********************************************************************/
+#include <algorithm>
+
+/* Headers from vtrutil library */
+#include "vtr_assert.h"
+
+/* Headers from openfpgautil library */
+#include "openfpga_digest.h"
+
+#include "sdc_writer_utils.h"
+#include "sdc_disable_timing_buffer.h"
+
+/* begin namespace openfpga */
+namespace openfpga {
+
+/********************************************************************
+ * Public Constructors
+ ********************************************************************/
+SdcDisableTimingBuffer::SdcDisableTimingBuffer(std::fstream& fp, const bool& group_ports)
+  : fp_(fp),
+    group_ports_(group_ports) {
+}
+
+/********************************************************************
+ * Public mutators
+ ********************************************************************/
+void SdcDisableTimingBuffer::add_port(const std::string& hierarchy_name, const BasicPort& port) {
+  if (false == group_ports_) {
+    print_disable_timing(hierarchy_name, port);
+    return;
+  }
+
+  auto result = hierarchy_name_indices_.find(hierarchy_name);
+  if (result == hierarchy_name_indices_.end()) {
+    hierarchy_name_indices_[hierarchy_name] = hierarchy_names_.size();
+    hierarchy_names_.push_back(hierarchy_name);
+    hierarchy_ports_.emplace_back();
+    hierarchy_ports_.back().push_back(port);
+    return;
+  }
+  hierarchy_ports_[result->second].push_back(port);
+}
+
+/********************************************************************
+ * Output the buffered ports hierarchy by hierarchy, in the order
+ * the hierarchies are added. Under each hierarchy, the ports are
+ * sorted by names and LSBs, so that the overlapped or contiguous pins
+ * of a port can be merged into a bus
+ ********************************************************************/
+void SdcDisableTimingBuffer::flush() {
+  for (size_t ihier = 0; ihier < hierarchy_names_.size(); ++ihier) {
+    std::vector<BasicPort>& ports = hierarchy_ports_[ihier];
+    std::stable_sort(ports.begin(), ports.end(),
+                     [](const BasicPort& a, const BasicPort& b) {
+                       if (a.get_name() != b.get_name()) {
+                         return a.get_name() < b.get_name();
+                       }
+                       return a.get_lsb() < b.get_lsb();
+                     });
+
+    std::vector<BasicPort> merged_ports;
+    for (const BasicPort& port : ports) {
+      if ( (false == merged_ports.empty())
+        && (true == port.mergeable(merged_ports.back()))
+        && (port.get_lsb() <= merged_ports.back().get_msb() + 1) ) {
+        merged_ports.back().set_msb(std::max(merged_ports.back().get_msb(), port.get_msb()));
+        continue;
+      } 
+      merged_ports.push_back(port);
+    }
+
+    for (const BasicPort& port : merged_ports) {
+      print_disable_timing(hierarchy_names_[ihier], port);
+    }
+  }
+
+  hierarchy_names_.clear();
+  hierarchy_ports_.clear();
+  hierarchy_name_indices_.clear();
+}
+
+/********************************************************************
+ * Internal helpers
+ ********************************************************************/
+void SdcDisableTimingBuffer::print_disable_timing(const std::string& hierarchy_name, const BasicPort& port) {
+  /* Validate file stream */
+  valid_file_stream(fp_);
+
+  fp_ << "set_disable_timing ";
+  fp_ << hierarchy_name;
+  fp_ << generate_sdc_port(port);
+  fp_ << std::endl;
+}
+
+} /* end namespace openfpga */
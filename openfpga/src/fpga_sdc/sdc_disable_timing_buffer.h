@@ -0,0 +1,63 @@
+#ifndef SDC_DISABLE_TIMING_BUFFER_H
+#define SDC_DISABLE_TIMING_BUFFER_H
+
+/********************************************************************
+ * Include header files required by the data structure definition
+ *******************************************************************/
+#include <fstream>
+#include <string>
+#include <vector>
+#include <map>
+
+#include "openfpga_port.h"
+
+/* begin namespace openfpga */
+namespace openfpga {
+
+/********************************************************************
+ * A data structure to output the SDC commands which disable timing
+ * for the pins under instance hierarchies, e.g.,
+ *   set_disable_timing <hierarchy_name><port_name>[<pin>]
+ *
+ * When the pins are grouped, they are buffered until flush() is called,
+ * where the contiguous pins of a port under the same hierarchy
+ * are merged into a bus. For example, the commands
+ *   set_disable_timing cbx_1__1_/chanx_left_in[0]
+ *   set_disable_timing cbx_1__1_/chanx_left_in[1]
+ *   set_disable_timing cbx_1__1_/chanx_left_in[2]
+ * are grouped into 
+ *   set_disable_timing cbx_1__1_/chanx_left_in[0:2]
+ *
+ * When the pins are not grouped, each command is output
+ * as soon as the pin is added
+ *
+ * Typical usage:
+ *   SdcDisableTimingBuffer disable_timing_buffer(fp, group_ports);
+ *   disable_timing_buffer.add_port(hierarchy_name, port);
+ *   ...
+ *   disable_timing_buffer.flush();
+ *******************************************************************/
+class SdcDisableTimingBuffer {
+  public: /* Public constructor */
+    SdcDisableTimingBuffer(std::fstream& fp, const bool& group_ports);
+  public: /* Public mutators */
+    /* Disable timing for a port under a hierarchy, which should end with a '/' */
+    void add_port(const std::string& hierarchy_name, const BasicPort& port);
+    /* Output all the ports which are buffered */
+    void flush();
+  private: /* Internal helpers */
+    void print_disable_timing(const std::string& hierarchy_name, const BasicPort& port);
+  private: /* Internal data */
+    std::fstream& fp_;
+    bool group_ports_;
+
+    /* Hierarchy names in the order they are added and the ports under each of them */
+    std::vector<std::string> hierarchy_names_;
+    std::vector<std::vector<BasicPort>> hierarchy_ports_;
+    /* Fast look-up from a hierarchy name to its index */
+    std::map<std::string, size_t> hierarchy_name_indices_;
+};
+
+} /* end namespace openfpga */
+
+#endif
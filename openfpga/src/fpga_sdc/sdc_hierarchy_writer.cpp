@@ -16,6 +16,7 @@
 #include "openfpga_physical_tile_utils.h"
 
 #include "sdc_writer_naming.h"
+#include "sdc_writer_utils.h"
 #include "sdc_hierarchy_writer.h"
 
 /* begin namespace openfpga */
@@ -208,7 +209,7 @@ void rec_print_pnr_sdc_grid_pb_graph_hierarchy(std::fstream& fp,
   VTR_ASSERT(true == module_manager.valid_module_id(pb_module));
 
   write_space_to_file(fp, depth * 2);
-  fp << "- " << pb_module_name << ":" << "\n";
+  fp << "- " << module_manager.module_name(pb_module) << ":" << "\n";
 
   /* Go through all the instance */
   for (const size_t& instance_id : module_manager.child_module_instances(parent_pb_module, pb_module)) {
@@ -378,4 +379,143 @@ void print_pnr_sdc_grid_hierarchy(const std::string& sdc_dir,
 }
 
 
+/********************************************************************
+ * Apply the SDC file of a module to all its instances in the fabric.
+ * The instances are found by their module (reference) name,
+ * so that the number of lines does not depend on the number of instances
+ * e.g.,
+ *   foreach inst [get_object_name [get_cells -hierarchical -filter "ref_name == sb_1__1_"]] {
+ *     current_instance $inst
+ *     source ${sdc_dir}/sb_1__1_.sdc
+ *     current_instance
+ *   }
+ *******************************************************************/
+static 
+void print_pnr_sdc_source_module(std::fstream& fp,
+                                 const std::string& module_name) {
+  VTR_ASSERT(true == valid_file_stream(fp));
+
+  fp << "foreach inst [get_object_name [get_cells -hierarchical -filter \"ref_name == " << module_name << "\"]] {" << "\n";
+  fp << "  current_instance $inst" << "\n";
+  fp << "  source ${sdc_dir}/" << module_name << SDC_FILE_NAME_POSTFIX << "\n";
+  fp << "  current_instance" << "\n";
+  fp << "}" << "\n";
+}
+
+/********************************************************************
+ * Write a top-level SDC file for a hierarchical P&R flow, which
+ * - sources the SDC files written for the top-level module as they are
+ * - applies the SDC file of each unique grid, Switch Block and Connection Block
+ *   module to all its instances
+ * The module-level SDC files are written only once for each unique module,
+ * so that the SDC volume is reduced by the compression ratio of the fabric
+ *******************************************************************/
+void print_pnr_sdc_unique_module_top(const PnrSdcOption& sdc_options,
+                                     const ModuleManager& module_manager,
+                                     const ModuleId& top_module,
+                                     const DeviceRRGSB& device_rr_gsb,
+                                     const std::vector<std::string>& grid_module_names,
+                                     const bool& compact_routing_hierarchy) {
+  std::string fname(sdc_options.sdc_dir() + std::string(SDC_PNR_TOP_FILE_NAME));
+
+  std::string timer_message = std::string("Write top-level SDC sourcing the SDC files of unique modules to '") + fname + std::string("'");
+
+  /* Start time count */
+  vtr::ScopedStartFinishTimer timer(timer_message);
+
+  /* Create a file handler*/
+  std::fstream fp;
+  /* Open a file */
+  fp.open(fname, std::fstream::out | std::fstream::trunc);
+
+  /* Validate the file stream */
+  check_file_stream(fname.c_str(), fp);
+
+  print_sdc_file_header(fp, std::string("Top-level timing constraints for unique modules of " + module_manager.module_name(top_module) + " in PnR"));
+
+  /* The SDC files are looked up in the directory of this file, wherever the backend tool is run */
+  fp << "set sdc_dir [file dirname [file normalize [info script]]]" << "\n";
+  fp << "\n";
+
+  /* Constraints on the top-level module with full paths */
+  std::vector<std::string> top_sdc_fnames;
+  if (true == sdc_options.constrain_global_port()) {
+    top_sdc_fnames.push_back(std::string(SDC_GLOBAL_PORTS_FILE_NAME));
+  }
+  if (true == sdc_options.constrain_configurable_memory_outputs()) {
+    top_sdc_fnames.push_back(std::string(SDC_DISABLE_CONFIG_MEM_OUTPUTS_FILE_NAME));
+  }
+  if (true == sdc_options.constrain_routing_multiplexer_outputs()) {
+    top_sdc_fnames.push_back(std::string(SDC_DISABLE_MUX_OUTPUTS_FILE_NAME));
+  }
+  if (true == sdc_options.constrain_switch_block_outputs()) {
+    top_sdc_fnames.push_back(std::string(SDC_DISABLE_SB_OUTPUTS_FILE_NAME));
+  }
+  for (const std::string& top_sdc_fname : top_sdc_fnames) {
+    fp << "source ${sdc_dir}/" << top_sdc_fname << "\n";
+  }
+  fp << "\n";
+
+  /* Constraints on the grid modules */
+  if (true == sdc_options.constrain_grid()) {
+    for (const std::string& grid_module_name : grid_module_names) {
+      print_pnr_sdc_source_module(fp, grid_module_name);
+    }
+  }
+
+  /* Constraints on the Switch Block modules, one for each unique module only when routing is compressed */
+  if (true == sdc_options.constrain_sb()) {
+    std::vector<const RRGSB*> sb_gsbs;
+    if (true == compact_routing_hierarchy) {
+      for (size_t isb = 0; isb < device_rr_gsb.get_num_sb_unique_module(); ++isb) {
+        sb_gsbs.push_back(&(device_rr_gsb.get_sb_unique_module(isb)));
+      }
+    } else {
+      vtr::Point<size_t> sb_range = device_rr_gsb.get_gsb_range();
+      for (size_t ix = 0; ix < sb_range.x(); ++ix) {
+        for (size_t iy = 0; iy < sb_range.y(); ++iy) {
+          sb_gsbs.push_back(&(device_rr_gsb.get_gsb(ix, iy)));
+        }
+      }
+    }
+    for (const RRGSB* rr_gsb : sb_gsbs) {
+      if (false == rr_gsb->is_sb_exist()) {
+        continue;
+      }
+      vtr::Point<size_t> gsb_coordinate(rr_gsb->get_sb_x(), rr_gsb->get_sb_y());
+      print_pnr_sdc_source_module(fp, generate_switch_block_module_name(gsb_coordinate));
+    }
+  }
+
+  /* Constraints on the Connection Block modules, one for each unique module only when routing is compressed */
+  if (true == sdc_options.constrain_cb()) {
+    for (const t_rr_type& cb_type : {CHANX, CHANY}) {
+      std::vector<const RRGSB*> cb_gsbs;
+      if (true == compact_routing_hierarchy) {
+        for (size_t icb = 0; icb < device_rr_gsb.get_num_cb_unique_module(cb_type); ++icb) {
+          cb_gsbs.push_back(&(device_rr_gsb.get_cb_unique_module(cb_type, icb)));
+        }
+      } else {
+        vtr::Point<size_t> cb_range = device_rr_gsb.get_gsb_range();
+        for (size_t ix = 0; ix < cb_range.x(); ++ix) {
+          for (size_t iy = 0; iy < cb_range.y(); ++iy) {
+            const RRGSB& rr_gsb = device_rr_gsb.get_gsb(ix, iy);
+            if (false == rr_gsb.is_cb_exist(cb_type)) {
+              continue;
+            }
+            cb_gsbs.push_back(&rr_gsb);
+          }
+        }
+      }
+      for (const RRGSB* rr_gsb : cb_gsbs) {
+        vtr::Point<size_t> gsb_coordinate(rr_gsb->get_cb_x(cb_type), rr_gsb->get_cb_y(cb_type));
+        print_pnr_sdc_source_module(fp, generate_connection_block_module_name(cb_type, gsb_coordinate));
+      }
+    }
+  }
+
+  /* close a file */
+  fp.close();
+}
+
 } /* end namespace openfpga */
@@ -4,8 +4,11 @@
 /********************************************************************
  * Include header files that are required by function declaration
  *******************************************************************/
+#include <string>
+#include <vector>
 #include "vpr_context.h"
 #include "openfpga_context.h"
+#include "pnr_sdc_option.h"
 
 /********************************************************************
  * Function declaration
@@ -31,6 +34,12 @@ void print_pnr_sdc_grid_hierarchy(const std::string& sdc_dir,
                                   const ModuleManager& module_manager,
                                   const ModuleId& top_module);
 
+void print_pnr_sdc_unique_module_top(const PnrSdcOption& sdc_options,
+                                     const ModuleManager& module_manager,
+                                     const ModuleId& top_module,
+                                     const DeviceRRGSB& device_rr_gsb,
+                                     const std::vector<std::string>& grid_module_names,
+                                     const bool& compact_routing_hierarchy);
 
 } /* end namespace openfpga */
 
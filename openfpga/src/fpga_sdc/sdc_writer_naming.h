@@ -12,6 +12,7 @@ constexpr char* SDC_DISABLE_CONFIG_MEM_OUTPUTS_FILE_NAME = "disable_configurable
 constexpr char* SDC_DISABLE_MUX_OUTPUTS_FILE_NAME = "disable_routing_multiplexer_outputs.sdc";
 constexpr char* SDC_DISABLE_SB_OUTPUTS_FILE_NAME = "disable_sb_outputs.sdc";
 constexpr char* SDC_CB_FILE_NAME = "cb.sdc";
+constexpr char* SDC_PNR_TOP_FILE_NAME = "fpga_top_pnr.sdc";
 
 constexpr char* SDC_GRID_HIERARCHY_FILE_NAME = "grid_hierarchy.txt";
 constexpr char* SDC_SB_HIERARCHY_FILE_NAME = "sb_hierarchy.txt";
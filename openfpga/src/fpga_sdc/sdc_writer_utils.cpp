@@ -14,12 +14,21 @@
 #include "openfpga_wildcard_string.h"
 
 #include "openfpga_naming.h"
+#include "module_manager_utils.h"
 
 #include "sdc_writer_utils.h"
 
 /* begin namespace openfpga */
 namespace openfpga {
 
+/********************************************************************
+ * Find the timing constraints between the inputs and outputs of a routing
+ * multiplexer, from the delay of its switch
+ *******************************************************************/
+float find_pnr_sdc_switch_tmax(const t_rr_switch_inf& switch_inf) {
+  return switch_inf.R * switch_inf.Cout + switch_inf.Tdel;
+}
+
 /********************************************************************
  * Write a head (description) in SDC file 
  *******************************************************************/
@@ -306,6 +315,7 @@ void print_sdc_set_port_output_delay(std::fstream& fp,
  * using a Depth-First Search (DFS) strategy
  * It will iterate over all the configurable children under each module
  * and print a SDC command to disable its outputs
+ * Only the child modules which include the module to disable are visited
  *
  * Return code:
  *   0: success
@@ -319,9 +329,11 @@ void print_sdc_set_port_output_delay(std::fstream& fp,
  *     This function will try to apply wildcard to names
  *     so that SDC file size can be minimal 
  *******************************************************************/
+static 
 int rec_print_sdc_disable_timing_for_module_ports(std::fstream& fp, 
                                                   const bool& flatten_names,
                                                   const ModuleManager& module_manager, 
+                                                  const vtr::vector<ModuleId, bool>& modules_including,
                                                   const ModuleId& parent_module,
                                                   const ModuleId& module_to_disable,
                                                   const std::string& parent_module_path,
@@ -340,6 +352,11 @@ int rec_print_sdc_disable_timing_for_module_ports(std::fstream& fp,
   /* For each child, we will go one level down in priority */
   for (const ModuleId& child_module : module_manager.child_modules(parent_module)) {
 
+    /* Skip the children which do not include the module to disable at any level */
+    if (false == modules_including[child_module]) {
+      continue;
+    }
+
     /* Iterate over the child instances*/
     for (const size_t& child_instance : module_manager.child_module_instances(parent_module, child_module)) {
       std::string child_module_path = parent_module_path;
@@ -379,6 +396,7 @@ int rec_print_sdc_disable_timing_for_module_ports(std::fstream& fp,
       if (module_to_disable != child_module) {
         int status = rec_print_sdc_disable_timing_for_module_ports(fp, flatten_names,
                                                                    module_manager, 
+                                                                   modules_including,
                                                                    child_module, 
                                                                    module_to_disable,
                                                                    child_module_path,
@@ -406,4 +424,31 @@ int rec_print_sdc_disable_timing_for_module_ports(std::fstream& fp,
   return 0; /* Success */
 }
 
+/********************************************************************
+ * Print SDC commands to disable a given port of modules
+ * in a given module id 
+ * The modules including the module to disable are found once
+ * from the parents of each module, so that the recursion only
+ * goes through the branches of the hierarchy leading to the module
+ *
+ * Return code:
+ *   0: success
+ *   1: fatal error occurred
+ *******************************************************************/
+int rec_print_sdc_disable_timing_for_module_ports(std::fstream& fp, 
+                                                  const bool& flatten_names,
+                                                  const ModuleManager& module_manager, 
+                                                  const ModuleId& parent_module,
+                                                  const ModuleId& module_to_disable,
+                                                  const std::string& parent_module_path,
+                                                  const std::string& disable_port_name) {
+  return rec_print_sdc_disable_timing_for_module_ports(fp, flatten_names,
+                                                       module_manager,
+                                                       find_modules_including_module(module_manager, module_to_disable),
+                                                       parent_module,
+                                                       module_to_disable,
+                                                       parent_module_path,
+                                                       disable_port_name);
+}
+
 } /* end namespace openfpga */
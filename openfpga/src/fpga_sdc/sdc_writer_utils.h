@@ -8,6 +8,7 @@
 #include <string>
 #include "openfpga_port.h"
 #include "module_manager.h"
+#include "physical_types.h"
 
 /********************************************************************
  * Function declaration
@@ -24,6 +25,8 @@ void print_sdc_timescale(std::fstream& fp,
 
 std::string generate_sdc_port(const BasicPort& port);
 
+float find_pnr_sdc_switch_tmax(const t_rr_switch_inf& switch_inf);
+
 void print_pnr_sdc_constrain_max_delay(std::fstream& fp,
                                        const std::string& src_instance_name,
                                        const std::string& src_port_name,
@@ -20,6 +20,7 @@
 #include "spice_grid.h"
 #include "spice_top_module.h"
 #include "spice_auxiliary_netlists.h"
+#include "spice_tile_testbench.h"
 
 /* Header file for this source file */
 #include "spice_api.h"
@@ -93,13 +94,15 @@ int fpga_fabric_spice(const ModuleManager& module_manager,
     print_spice_unique_routing_modules(netlist_manager,
                                        module_manager,
                                        device_rr_gsb,
-                                       rr_dir_path);
+                                       rr_dir_path,
+                                       options);
   } else {
     VTR_ASSERT(false == options.compress_routing());
     print_spice_flatten_routing_modules(netlist_manager,
                                         module_manager,
                                         device_rr_gsb,
-                                        rr_dir_path);
+                                        rr_dir_path,
+                                        options);
   }
 
   /* Generate grids */
@@ -107,6 +110,7 @@ int fpga_fabric_spice(const ModuleManager& module_manager,
                     module_manager,
                     device_ctx, device_annotation,
                     lb_dir_path,
+                    options,
                     options.verbose_output());
 
   /* Generate FPGA fabric */
@@ -127,4 +131,39 @@ int fpga_fabric_spice(const ModuleManager& module_manager,
   return CMD_EXEC_SUCCESS;
 }
 
+/********************************************************************
+ * A top-level function of FPGA-SPICE which focuses on testbench generation
+ * for characterizing each unique tile of the fabric in isolation.
+ * This function will generate a run-ready SPICE deck for
+ *  - each unique Switch Block (SB) and Connection Block (CB)
+ *  - each type of grid
+ * which includes the fabric netlists written by fpga_fabric_spice()
+ * and is driven by stimuli derived from the simulation settings
+ ********************************************************************/
+int fpga_spice_tile_testbench(const ModuleManager& module_manager,
+                              NetlistManager& netlist_manager,
+                              const Arch& openfpga_arch,
+                              const SimulationSetting& sim_setting,
+                              const DeviceContext &device_ctx,
+                              const DeviceRRGSB &device_rr_gsb,
+                              const std::string& output_dir,
+                              const size_t& num_threads,
+                              const bool& verbose) {
+  std::string testbench_dir_path = format_dir_path(output_dir);
+
+  /* Create directories */
+  create_directory(testbench_dir_path);
+
+  return print_spice_tile_testbenches(netlist_manager,
+                                      module_manager,
+                                      device_ctx,
+                                      device_rr_gsb,
+                                      openfpga_arch.circuit_lib,
+                                      openfpga_arch.tech_lib,
+                                      sim_setting,
+                                      testbench_dir_path,
+                                      num_threads,
+                                      verbose);
+}
+
 } /* end namespace openfpga */
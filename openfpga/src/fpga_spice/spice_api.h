@@ -15,6 +15,7 @@
 #include "vpr_device_annotation.h"
 #include "device_rr_gsb.h"
 #include "fabric_spice_options.h"
+#include "simulation_setting.h"
 
 /********************************************************************
  * Function declaration
@@ -32,6 +33,16 @@ int fpga_fabric_spice(const ModuleManager& module_manager,
                       const DeviceRRGSB &device_rr_gsb,
                       const FabricSpiceOption& options);
 
+int fpga_spice_tile_testbench(const ModuleManager& module_manager,
+                              NetlistManager& netlist_manager,
+                              const Arch& openfpga_arch,
+                              const SimulationSetting& sim_setting,
+                              const DeviceContext &device_ctx,
+                              const DeviceRRGSB &device_rr_gsb,
+                              const std::string& output_dir,
+                              const size_t& num_threads,
+                              const bool& verbose);
+
 } /* end namespace openfpga */
 
 #endif
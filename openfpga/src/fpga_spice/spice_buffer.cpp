@@ -224,8 +224,8 @@ int print_spice_powergated_inverter_subckt(std::fstream& fp,
    * we do NOT support global ports here, 
    * it should be handled in another type of inverter subckt (power-gated)
    */
-  std::vector<CircuitPortId> input_ports = circuit_lib.model_ports_by_type(circuit_model, CIRCUIT_MODEL_PORT_INPUT, true);
-  std::vector<CircuitPortId> output_ports = circuit_lib.model_ports_by_type(circuit_model, CIRCUIT_MODEL_PORT_OUTPUT, true);
+  const std::vector<CircuitPortId>& input_ports = circuit_lib.model_ports_by_type(circuit_model, CIRCUIT_MODEL_PORT_INPUT, true);
+  const std::vector<CircuitPortId>& output_ports = circuit_lib.model_ports_by_type(circuit_model, CIRCUIT_MODEL_PORT_OUTPUT, true);
 
   /* Make sure:
    * There is only 1 input port and 1 output port, 
@@ -425,8 +425,8 @@ int print_spice_regular_inverter_subckt(std::fstream& fp,
    * we do NOT support global ports here, 
    * it should be handled in another type of inverter subckt (power-gated)
    */
-  std::vector<CircuitPortId> input_ports = circuit_lib.model_ports_by_type(circuit_model, CIRCUIT_MODEL_PORT_INPUT, true);
-  std::vector<CircuitPortId> output_ports = circuit_lib.model_ports_by_type(circuit_model, CIRCUIT_MODEL_PORT_OUTPUT, true);
+  const std::vector<CircuitPortId>& input_ports = circuit_lib.model_ports_by_type(circuit_model, CIRCUIT_MODEL_PORT_INPUT, true);
+  const std::vector<CircuitPortId>& output_ports = circuit_lib.model_ports_by_type(circuit_model, CIRCUIT_MODEL_PORT_OUTPUT, true);
 
   /* Make sure:
    * There is only 1 input port and 1 output port, 
@@ -596,8 +596,8 @@ int print_spice_powergated_buffer_subckt(std::fstream& fp,
    * we do NOT support global ports here, 
    * it should be handled in another type of inverter subckt (power-gated)
    */
-  std::vector<CircuitPortId> input_ports = circuit_lib.model_ports_by_type(circuit_model, CIRCUIT_MODEL_PORT_INPUT, true);
-  std::vector<CircuitPortId> output_ports = circuit_lib.model_ports_by_type(circuit_model, CIRCUIT_MODEL_PORT_OUTPUT, true);
+  const std::vector<CircuitPortId>& input_ports = circuit_lib.model_ports_by_type(circuit_model, CIRCUIT_MODEL_PORT_INPUT, true);
+  const std::vector<CircuitPortId>& output_ports = circuit_lib.model_ports_by_type(circuit_model, CIRCUIT_MODEL_PORT_OUTPUT, true);
 
   /* Make sure:
    * There is only 1 input port and 1 output port, 
@@ -759,8 +759,8 @@ int print_spice_regular_buffer_subckt(std::fstream& fp,
    * we do NOT support global ports here, 
    * it should be handled in another type of inverter subckt (power-gated)
    */
-  std::vector<CircuitPortId> input_ports = circuit_lib.model_ports_by_type(circuit_model, CIRCUIT_MODEL_PORT_INPUT, true);
-  std::vector<CircuitPortId> output_ports = circuit_lib.model_ports_by_type(circuit_model, CIRCUIT_MODEL_PORT_OUTPUT, true);
+  const std::vector<CircuitPortId>& input_ports = circuit_lib.model_ports_by_type(circuit_model, CIRCUIT_MODEL_PORT_INPUT, true);
+  const std::vector<CircuitPortId>& output_ports = circuit_lib.model_ports_by_type(circuit_model, CIRCUIT_MODEL_PORT_OUTPUT, true);
 
   /* Make sure:
    * There is only 1 input port and 1 output port, 
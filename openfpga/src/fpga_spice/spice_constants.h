@@ -26,4 +26,7 @@ constexpr char* SB_SPICE_FILE_NAME_PREFIX = "sb_";
 constexpr char* LOGICAL_MODULE_SPICE_FILE_NAME_PREFIX = "logical_tile_";
 constexpr char* GRID_SPICE_FILE_NAME_PREFIX = "grid_";
 
+constexpr char* SPICE_TILE_TESTBENCH_POSTFIX = "_tile_testbench";
+constexpr char* SPICE_TILE_TESTBENCH_LIST_FILE_NAME = "tile_testbenches.list";
+
 #endif
@@ -5,8 +5,10 @@
  * logic gates etc. 
  ***********************************************/
 #include <fstream>
+#include <sstream>
 #include <cmath>
 #include <iomanip>
+#include <map>
 
 /* Headers from vtrutil library */
 #include "vtr_assert.h"
@@ -118,12 +120,124 @@ int print_spice_supply_wrappers(NetlistManager& netlist_manager,
   return status;
 }
 
+/********************************************************************
+ * Generate a signature for the SPICE subckt of an essential gate,
+ * which covers every parameter that the transistor-level netlist depends on,
+ * i.e., the topology, the transistor sizing, the technology model and
+ * the sequence of ports.
+ * Circuit models with the same signature have identical subckt bodies 
+ * except their names, so that the body can be written only once.
+ *
+ * Return an empty signature for the circuit models whose subckt 
+ * can not be shared, e.g., power-gated gates and logic gates
+ *******************************************************************/
+static 
+std::string generate_spice_essential_gate_subckt_signature(const CircuitLibrary& circuit_lib,
+                                                           const CircuitModelId& circuit_model,
+                                                           const TechnologyModelId& tech_model) {
+  std::stringstream signature;
+
+  if ( (CIRCUIT_MODEL_INVBUF != circuit_lib.model_type(circuit_model))
+    && (CIRCUIT_MODEL_PASSGATE != circuit_lib.model_type(circuit_model))) {
+    return std::string();
+  }
+
+  /* Each port is mapped by its position when referring to a shared subckt,
+   * global ports are excluded as their order is not guaranteed
+   */
+  for (const CircuitPortId& port : circuit_lib.model_ports(circuit_model)) {
+    if (true == circuit_lib.port_is_global(port)) {
+      return std::string();
+    }
+    signature << "port:" << circuit_lib.port_type(port) << "[" << circuit_lib.port_size(port) << "];";
+  }
+
+  signature << "type:" << circuit_lib.model_type(circuit_model) << ";";
+  signature << "tech:" << size_t(tech_model) << ";";
+  signature << std::setprecision(10);
+
+  if (CIRCUIT_MODEL_INVBUF == circuit_lib.model_type(circuit_model)) {
+    if (true == circuit_lib.is_power_gated(circuit_model)) {
+      return std::string();
+    }
+    signature << "buffer:" << circuit_lib.buffer_type(circuit_model) << ";";
+    signature << "size:" << circuit_lib.buffer_size(circuit_model) << ";";
+    if (CIRCUIT_MODEL_BUF_BUF == circuit_lib.buffer_type(circuit_model)) {
+      signature << "levels:" << circuit_lib.buffer_num_levels(circuit_model) << ";";
+      signature << "f_per_stage:" << circuit_lib.buffer_f_per_stage(circuit_model) << ";";
+    }
+  } else {
+    VTR_ASSERT(CIRCUIT_MODEL_PASSGATE == circuit_lib.model_type(circuit_model));
+    signature << "pass_gate:" << circuit_lib.pass_gate_logic_type(circuit_model) << ";";
+    signature << "nmos_size:" << circuit_lib.pass_gate_logic_nmos_size(circuit_model) << ";";
+    if (CIRCUIT_MODEL_PASS_GATE_TRANSMISSION == circuit_lib.pass_gate_logic_type(circuit_model)) {
+      signature << "pmos_size:" << circuit_lib.pass_gate_logic_pmos_size(circuit_model) << ";";
+    }
+  }
+
+  return signature.str();
+}
+
+/********************************************************************
+ * Generate the SPICE subckt for an essential gate which refers to
+ * an identical subckt that has been written already.
+ * The subckt contains only an instance of the shared subckt,
+ * whose ports are mapped to the ports of the module in sequence
+ *
+ *   +--------------------------+
+ *   |  module                  |
+ *   |     +---------------+    |
+ *   |---->| shared subckt |--->|
+ *   |     +---------------+    |
+ *   +--------------------------+
+ *
+ *******************************************************************/
+static 
+int print_spice_shared_subckt_reference(std::fstream& fp,
+                                        const ModuleManager& module_manager,
+                                        const ModuleId& module_id,
+                                        const ModuleId& shared_module_id) {
+  if (false == valid_file_stream(fp)) {
+    return CMD_EXEC_FATAL_ERROR;
+  }
+
+  print_spice_subckt_definition(fp, module_manager, module_id); 
+
+  /* Map the ports of the shared subckt to the ports of the module in sequence */
+  std::map<std::string, BasicPort> port2port_name_map;
+  for (int port_type = ModuleManager::MODULE_GLOBAL_PORT;
+       port_type < ModuleManager::NUM_MODULE_PORT_TYPES;
+       ++port_type) {
+    std::vector<BasicPort> module_ports = module_manager.module_ports_by_type(module_id, static_cast<ModuleManager::e_module_port_type>(port_type));
+    std::vector<BasicPort> shared_module_ports = module_manager.module_ports_by_type(shared_module_id, static_cast<ModuleManager::e_module_port_type>(port_type));
+    VTR_ASSERT(module_ports.size() == shared_module_ports.size());
+    for (size_t iport = 0; iport < module_ports.size(); ++iport) {
+      VTR_ASSERT(module_ports[iport].get_width() == shared_module_ports[iport].get_width());
+      port2port_name_map[shared_module_ports[iport].get_name()] = module_ports[iport];
+    }
+  }
+
+  print_spice_subckt_instance(fp, 
+                              module_manager, 
+                              shared_module_id,
+                              module_manager.module_name(shared_module_id),
+                              port2port_name_map);
+
+  print_spice_subckt_end(fp, module_manager.module_name(module_id)); 
+
+  return CMD_EXEC_SUCCESS;
+}
+
 /********************************************************************
  * Generate the SPICE netlist for essential gates:
  * - inverters and their templates
  * - buffers and their templates
  * - pass-transistor or transmission gates
  * - logic gates
+ *
+ * Circuit models with identical sizing and topology share one subckt:
+ * the first one is written in full while the others only refer to it,
+ * which reduces the netlist size and the parsing time of simulators
  *******************************************************************/
 int print_spice_essential_gates(NetlistManager& netlist_manager,
                                 const ModuleManager& module_manager,
@@ -133,6 +247,9 @@ int print_spice_essential_gates(NetlistManager& netlist_manager,
                                 const std::string& submodule_dir) {
   int status = CMD_EXEC_SUCCESS;
 
+  /* Record the module of the first subckt written for each signature */
+  std::map<std::string, ModuleId> shared_subckts;
+
   /* Iterate over the circuit models */
   for (const CircuitModelId& circuit_model : circuit_lib.models()) {
     /* Bypass models require extern netlists */
@@ -190,8 +307,28 @@ int print_spice_essential_gates(NetlistManager& netlist_manager,
     /* A flag to record if any logic has been filled to the netlist */
     bool netlist_filled = false;
 
+    /* Refer to an identical subckt if it has been written */
+    std::string signature = generate_spice_essential_gate_subckt_signature(circuit_lib, circuit_model, tech_model);
+    if (false == signature.empty()) {
+      auto shared_result = shared_subckts.find(signature);
+      if (shared_result != shared_subckts.end()) {
+        VTR_ASSERT(true == module_manager.valid_module_id(module_id));
+        status = print_spice_shared_subckt_reference(fp,
+                                                     module_manager, module_id,
+                                                     shared_result->second);
+        netlist_filled = true;
+
+        if (CMD_EXEC_FATAL_ERROR == status) {
+          break;
+        }
+      } else {
+        shared_subckts[signature] = module_id;
+      }
+    }
+
     /* Now branch on netlist writing: for inverter/buffers */
-    if (CIRCUIT_MODEL_INVBUF == circuit_lib.model_type(circuit_model)) {
+    if ( (false == netlist_filled) 
+      && (CIRCUIT_MODEL_INVBUF == circuit_lib.model_type(circuit_model))) {
       if (CIRCUIT_MODEL_BUF_INV == circuit_lib.buffer_type(circuit_model)) {
         VTR_ASSERT(true == module_manager.valid_module_id(module_id));
         status = print_spice_inverter_subckt(fp,
@@ -214,7 +351,8 @@ int print_spice_essential_gates(NetlistManager& netlist_manager,
     }
 
     /* Now branch on netlist writing: for pass-gate logic */
-    if (CIRCUIT_MODEL_PASSGATE == circuit_lib.model_type(circuit_model)) {
+    if ( (false == netlist_filled) 
+      && (CIRCUIT_MODEL_PASSGATE == circuit_lib.model_type(circuit_model))) {
       status = print_spice_passgate_subckt(fp,
                                            module_manager, module_id,
                                            circuit_lib, circuit_model,
@@ -17,6 +17,7 @@
 /* Headers from openfpgautil library */
 #include "openfpga_digest.h"
 #include "openfpga_side_manager.h"
+#include "openfpga_parallel.h"
 
 /* Headers from vpr library */
 #include "vpr_utils.h"
@@ -75,6 +76,19 @@ void print_spice_primitive_block(NetlistManager& netlist_manager,
     exit(1);
   }
 
+  /* Generate the module name for this primitive pb_graph_node*/
+  std::string primitive_module_name = generate_physical_block_module_name(primitive_pb_graph_node->pb_type);
+
+  /* Create a module of the primitive LUT and register it to module manager */
+  ModuleId primitive_module = module_manager.find_module(primitive_module_name);
+  /* Ensure that the module has been created and thus unique! */
+  VTR_ASSERT(true == module_manager.valid_module_id(primitive_module));
+
+  /* Bypass the module which is merged into an identical module, which is written on its own */
+  if (primitive_module_name != module_manager.module_name(primitive_module)) {
+    return;
+  }
+
   /* Give a name to the Verilog netlist */
   /* Create the file name for Verilog */
   std::string spice_fname(subckt_dir 
@@ -93,14 +107,6 @@ void print_spice_primitive_block(NetlistManager& netlist_manager,
 
   print_spice_file_header(fp, std::string("SPICE subckts for primitive pb_type: " + std::string(primitive_pb_graph_node->pb_type->name))); 
 
-  /* Generate the module name for this primitive pb_graph_node*/
-  std::string primitive_module_name = generate_physical_block_module_name(primitive_pb_graph_node->pb_type);
-
-  /* Create a module of the primitive LUT and register it to module manager */
-  ModuleId primitive_module = module_manager.find_module(primitive_module_name);
-  /* Ensure that the module has been created and thus unique! */
-  VTR_ASSERT(true == module_manager.valid_module_id(primitive_module));
-
   VTR_LOGV(verbose,
           "Writing SPICE codes of logical tile primitive block '%s'...",
            module_manager.module_name(primitive_module).c_str());
@@ -183,6 +189,18 @@ void rec_print_spice_logical_tile(NetlistManager& netlist_manager,
     return;
   }
 
+  /* Generate the name of the SPICE subckt for this pb_type */
+  std::string pb_module_name = generate_physical_block_module_name(physical_pb_type);
+
+  /* Register the SPICE subckt in module manager */
+  ModuleId pb_module = module_manager.find_module(pb_module_name);
+  VTR_ASSERT(true == module_manager.valid_module_id(pb_module));
+
+  /* Bypass the module which is merged into an identical module, which is written on its own */
+  if (pb_module_name != module_manager.module_name(pb_module)) {
+    return;
+  }
+
   /* Give a name to the Verilog netlist */
   /* Create the file name for Verilog */
   std::string spice_fname(subckt_dir 
@@ -201,13 +219,6 @@ void rec_print_spice_logical_tile(NetlistManager& netlist_manager,
 
   print_spice_file_header(fp, std::string("SPICE subckts for pb_type: " + std::string(physical_pb_type->name))); 
 
-  /* Generate the name of the SPICE subckt for this pb_type */
-  std::string pb_module_name = generate_physical_block_module_name(physical_pb_type);
-
-  /* Register the SPICE subckt in module manager */
-  ModuleId pb_module = module_manager.find_module(pb_module_name);
-  VTR_ASSERT(true == module_manager.valid_module_id(pb_module));
-
   VTR_LOGV(verbose,
           "Writing SPICE codes of pb_type '%s'...",
            module_manager.module_name(pb_module).c_str());
@@ -274,11 +285,10 @@ void print_spice_logical_tile_netlist(NetlistManager& netlist_manager,
  * the I/O block locates at.
  *****************************************************************************/
 static 
-void print_spice_physical_tile_netlist(NetlistManager& netlist_manager,
-                                       const ModuleManager& module_manager,
-                                       const std::string& subckt_dir,
-                                       t_physical_tile_type_ptr phy_block_type,
-                                       const e_side& border_side) {
+std::string print_spice_physical_tile_netlist(const ModuleManager& module_manager,
+                                              const std::string& subckt_dir,
+                                              t_physical_tile_type_ptr phy_block_type,
+                                              const e_side& border_side) {
   /* Check code: if this is an IO block, the border side MUST be valid */
   if (true == is_io_type(phy_block_type)) {
     VTR_ASSERT(NUM_SIDES != border_side);
@@ -293,17 +303,6 @@ void print_spice_physical_tile_netlist(NetlistManager& netlist_manager,
                                                              std::string(SPICE_NETLIST_FILE_POSTFIX))
                            );
 
-  /* Echo status */
-  if (true == is_io_type(phy_block_type)) {
-    SideManager side_manager(border_side);
-    VTR_LOG("Writing SPICE Netlist '%s' for physical tile '%s' at %s side ...",
-            spice_fname.c_str(), phy_block_type->name, 
-            side_manager.c_str());
-  } else { 
-    VTR_LOG("Writing SPICE Netlist '%s' for physical_tile '%s'...",
-            spice_fname.c_str(), phy_block_type->name);
-  }
-
   /* Create the file stream */
   std::fstream fp;
   fp.open(spice_fname, std::fstream::out | std::fstream::trunc);
@@ -329,12 +328,7 @@ void print_spice_physical_tile_netlist(NetlistManager& netlist_manager,
   /* Close file handler */
   fp.close();
 
-  /* Add fname to the netlist name list */
-  NetlistId nlist_id = netlist_manager.add_netlist(spice_fname);
-  VTR_ASSERT(NetlistId::INVALID() != nlist_id);
-  netlist_manager.set_netlist_type(nlist_id, NetlistManager::LOGIC_BLOCK_NETLIST);
-
-  VTR_LOG("Done\n");
+  return spice_fname;
 }
 
 /*****************************************************************************
@@ -348,6 +342,7 @@ void print_spice_grids(NetlistManager& netlist_manager,
                        const DeviceContext& device_ctx,
                        const VprDeviceAnnotation& device_annotation,
                        const std::string& subckt_dir,
+                       const FabricSpiceOption& options,
                        const bool& verbose) {
   /* Create a vector to contain all the Verilog netlist names that have been generated in this function */
   std::vector<std::string> netlist_names;
@@ -383,6 +378,8 @@ void print_spice_grids(NetlistManager& netlist_manager,
    */
   VTR_LOG("Building physical tiles...");
   VTR_LOGV(verbose, "\n");
+  std::vector<t_physical_tile_type_ptr> physical_tiles;
+  std::vector<e_side> border_sides;
   for (const t_physical_tile_type& physical_tile : device_ctx.physical_tile_types) {
     /* Bypass empty type or nullptr */
     if (true == is_empty_type(&physical_tile)) {
@@ -399,21 +396,45 @@ void print_spice_grids(NetlistManager& netlist_manager,
       std::set<e_side> io_type_sides = find_physical_io_tile_located_sides(device_ctx.grid,
                                                                            &physical_tile);
       for (const e_side& io_type_side : io_type_sides) {
-        print_spice_physical_tile_netlist(netlist_manager,
-                                          module_manager,
-                                          subckt_dir, 
-                                          &physical_tile,
-                                          io_type_side);
+        physical_tiles.push_back(&physical_tile);
+        border_sides.push_back(io_type_side);
       } 
       continue;
     } else {
       /* For CLB and heterogenenous blocks */
-      print_spice_physical_tile_netlist(netlist_manager,
-                                        module_manager,
-                                        subckt_dir, 
-                                        &physical_tile,
-                                        NUM_SIDES);
+      physical_tiles.push_back(&physical_tile);
+      border_sides.push_back(NUM_SIDES);
+    }
+  }
+
+  /* Physical tile netlists are independent files, which can be written on multiple threads.
+   * Only the file names are stored by the workers
+   */
+  std::vector<std::string> spice_fnames(physical_tiles.size());
+  parallel_for(physical_tiles.size(), options.num_threads(),
+               [&](const size_t& itile) {
+                 spice_fnames[itile] = print_spice_physical_tile_netlist(module_manager,
+                                                                         subckt_dir, 
+                                                                         physical_tiles[itile],
+                                                                         border_sides[itile]);
+               });
+
+  for (size_t itile = 0; itile < physical_tiles.size(); ++itile) {
+    /* Echo status */
+    if (true == is_io_type(physical_tiles[itile])) {
+      SideManager side_manager(border_sides[itile]);
+      VTR_LOG("Written SPICE Netlist '%s' for physical tile '%s' at %s side\n",
+              spice_fnames[itile].c_str(), physical_tiles[itile]->name, 
+              side_manager.c_str());
+    } else { 
+      VTR_LOG("Written SPICE Netlist '%s' for physical_tile '%s'\n",
+              spice_fnames[itile].c_str(), physical_tiles[itile]->name);
     }
+
+    /* Add fname to the netlist name list, in the order of the physical tiles */
+    NetlistId nlist_id = netlist_manager.add_netlist(spice_fnames[itile]);
+    VTR_ASSERT(NetlistId::INVALID() != nlist_id);
+    netlist_manager.set_netlist_type(nlist_id, NetlistManager::LOGIC_BLOCK_NETLIST);
   }
   VTR_LOG("Building physical tiles...");
   VTR_LOG("Done\n");
@@ -73,8 +73,8 @@ int print_spice_and_gate_subckt(std::fstream& fp,
    * we do NOT support global ports here, 
    * it should be handled in another type of inverter subckt (power-gated)
    */
-  std::vector<CircuitPortId> input_ports = circuit_lib.model_ports_by_type(circuit_model, CIRCUIT_MODEL_PORT_INPUT, true);
-  std::vector<CircuitPortId> output_ports = circuit_lib.model_ports_by_type(circuit_model, CIRCUIT_MODEL_PORT_OUTPUT, true);
+  const std::vector<CircuitPortId>& input_ports = circuit_lib.model_ports_by_type(circuit_model, CIRCUIT_MODEL_PORT_INPUT, true);
+  const std::vector<CircuitPortId>& output_ports = circuit_lib.model_ports_by_type(circuit_model, CIRCUIT_MODEL_PORT_OUTPUT, true);
 
   /* Make sure:
    * There are at least 2 input ports and 1 output port, 
@@ -231,8 +231,8 @@ int print_spice_or_gate_subckt(std::fstream& fp,
    * we do NOT support global ports here, 
    * it should be handled in another type of inverter subckt (power-gated)
    */
-  std::vector<CircuitPortId> input_ports = circuit_lib.model_ports_by_type(circuit_model, CIRCUIT_MODEL_PORT_INPUT, true);
-  std::vector<CircuitPortId> output_ports = circuit_lib.model_ports_by_type(circuit_model, CIRCUIT_MODEL_PORT_OUTPUT, true);
+  const std::vector<CircuitPortId>& input_ports = circuit_lib.model_ports_by_type(circuit_model, CIRCUIT_MODEL_PORT_INPUT, true);
+  const std::vector<CircuitPortId>& output_ports = circuit_lib.model_ports_by_type(circuit_model, CIRCUIT_MODEL_PORT_OUTPUT, true);
 
   /* Make sure:
    * There are at least 2 input ports and 1 output port, 
@@ -143,7 +143,7 @@ int print_spice_submodule_memories(NetlistManager& netlist_manager,
       continue;
     }
     /* Bypass those modules without any SRAM ports */
-    std::vector<CircuitPortId> sram_ports = circuit_lib.model_ports_by_type(model, CIRCUIT_MODEL_PORT_SRAM, true);
+    const std::vector<CircuitPortId>& sram_ports = circuit_lib.model_ports_by_type(model, CIRCUIT_MODEL_PORT_SRAM, true);
     if (0 == sram_ports.size()) {
       continue;
     }
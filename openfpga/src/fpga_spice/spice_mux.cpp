@@ -7,6 +7,7 @@
  **********************************************/
 #include <string>
 #include <map>
+#include <set>
 #include <algorithm>
 
 /* Headers from vtrutil library */
@@ -167,15 +168,17 @@ int print_spice_submodule_mux_primitives(NetlistManager& netlist_manager,
    * since different sizes of routing multiplexers may share the same branch module
    */
   std::map<std::string, bool> branch_mux_module_is_outputted;
+  /* Skip extracting the branches which have been visited for a circuit model */
+  std::map<CircuitModelId, std::set<std::pair<size_t, size_t>>> built_branches;
 
   /* Generate basis sub-circuit for unique branches shared by the multiplexers */
   for (auto mux : mux_lib.muxes()) {
     const MuxGraph& mux_graph = mux_lib.mux_graph(mux);
     CircuitModelId mux_circuit_model = mux_lib.mux_circuit_model(mux); 
-    /* Create a mux graph for the branch circuit */
-    std::vector<MuxGraph> branch_mux_graphs = mux_graph.build_mux_branch_graphs();
+    /* Create a mux graph for the branch circuits which are not outputted yet */
+    std::vector<MuxGraph> branch_mux_graphs = mux_graph.build_mux_branch_graphs(built_branches[mux_circuit_model]);
     /* Create branch circuits, which are N:1 one-level or 2:1 tree-like MUXes */
-    for (auto branch_mux_graph : branch_mux_graphs) {
+    for (const MuxGraph& branch_mux_graph : branch_mux_graphs) {
       generate_spice_mux_branch_subckt(module_manager, circuit_lib, fp, mux_circuit_model, 
                                        branch_mux_graph,
                                        branch_mux_module_is_outputted);
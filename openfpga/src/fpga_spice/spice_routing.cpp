@@ -9,6 +9,7 @@
 
 /* Headers from openfpgautil library */
 #include "openfpga_digest.h"
+#include "openfpga_parallel.h"
 
 /* Include FPGA-Verilog header files*/
 #include "openfpga_naming.h"
@@ -75,11 +76,10 @@ namespace openfpga {
  *              
  ********************************************************************/
 static 
-void print_spice_routing_connection_box_unique_module(NetlistManager& netlist_manager,
-                                                      const ModuleManager& module_manager, 
-                                                      const std::string& subckt_dir, 
-                                                      const RRGSB& rr_gsb,
-                                                      const t_rr_type& cb_type) {
+std::string print_spice_routing_connection_box_unique_module(const ModuleManager& module_manager, 
+                                                             const std::string& subckt_dir, 
+                                                             const RRGSB& rr_gsb,
+                                                             const t_rr_type& cb_type) {
   /* Create the netlist */
   vtr::Point<size_t> gsb_coordinate(rr_gsb.get_cb_x(cb_type), rr_gsb.get_cb_y(cb_type));
   std::string spice_fname(subckt_dir + generate_connection_block_netlist_name(cb_type, gsb_coordinate, std::string(SPICE_NETLIST_FILE_POSTFIX)));
@@ -105,10 +105,7 @@ void print_spice_routing_connection_box_unique_module(NetlistManager& netlist_ma
   /* Close file handler */
   fp.close();
 
-  /* Add fname to the netlist name list */
-  NetlistId nlist_id = netlist_manager.add_netlist(spice_fname);
-  VTR_ASSERT(NetlistId::INVALID() != nlist_id);
-  netlist_manager.set_netlist_type(nlist_id, NetlistManager::ROUTING_MODULE_NETLIST);
+  return spice_fname;
 }
 
 /*********************************************************************
@@ -175,10 +172,9 @@ void print_spice_routing_connection_box_unique_module(NetlistManager& netlist_ma
  *
  ********************************************************************/
 static 
-void print_spice_routing_switch_box_unique_module(NetlistManager& netlist_manager,
-                                                  const ModuleManager& module_manager, 
-                                                  const std::string& subckt_dir, 
-                                                  const RRGSB& rr_gsb) {
+std::string print_spice_routing_switch_box_unique_module(const ModuleManager& module_manager, 
+                                                         const std::string& subckt_dir, 
+                                                         const RRGSB& rr_gsb) {
   /* Create the netlist */
   vtr::Point<size_t> gsb_coordinate(rr_gsb.get_sb_x(), rr_gsb.get_sb_y());
   std::string spice_fname(subckt_dir + generate_routing_block_netlist_name(SB_SPICE_FILE_NAME_PREFIX, gsb_coordinate, std::string(SPICE_NETLIST_FILE_POSTFIX)));
@@ -201,22 +197,56 @@ void print_spice_routing_switch_box_unique_module(NetlistManager& netlist_manage
   /* Close file handler */
   fp.close();
 
-  /* Add fname to the netlist name list */
-  NetlistId nlist_id = netlist_manager.add_netlist(spice_fname);
-  VTR_ASSERT(NetlistId::INVALID() != nlist_id);
-  netlist_manager.set_netlist_type(nlist_id, NetlistManager::ROUTING_MODULE_NETLIST);
+  return spice_fname;
+}
+
+/********************************************************************
+ * Write the netlists for a list of routing blocks
+ * - A block whose type is NUM_RR_TYPES is a switch block,
+ *   otherwise it is a connection block of the given type
+ * - Each netlist is an independent file, so they are written
+ *   on multiple threads when requested
+ *******************************************************************/
+static 
+void print_spice_routing_block_netlists(NetlistManager& netlist_manager,
+                                        const ModuleManager& module_manager, 
+                                        const std::vector<const RRGSB*>& rr_gsbs,
+                                        const std::vector<t_rr_type>& block_types,
+                                        const std::string& subckt_dir,
+                                        const FabricSpiceOption& options) {
+  VTR_ASSERT(rr_gsbs.size() == block_types.size());
+
+  std::vector<std::string> spice_fnames(rr_gsbs.size());
+  parallel_for(rr_gsbs.size(), options.num_threads(),
+               [&](const size_t& iblock) {
+                 if (NUM_RR_TYPES == block_types[iblock]) {
+                   spice_fnames[iblock] = print_spice_routing_switch_box_unique_module(module_manager, 
+                                                                                       subckt_dir, 
+                                                                                       *(rr_gsbs[iblock]));
+                 } else {
+                   spice_fnames[iblock] = print_spice_routing_connection_box_unique_module(module_manager,
+                                                                                           subckt_dir, 
+                                                                                           *(rr_gsbs[iblock]), block_types[iblock]);
+                 }
+               });
+
+  /* Add fname to the netlist name list, once all the workers are joined */
+  for (const std::string& spice_fname : spice_fnames) {
+    NetlistId nlist_id = netlist_manager.add_netlist(spice_fname);
+    VTR_ASSERT(NetlistId::INVALID() != nlist_id);
+    netlist_manager.set_netlist_type(nlist_id, NetlistManager::ROUTING_MODULE_NETLIST);
+  }
 }
 
 /********************************************************************
  * Iterate over all the connection blocks in a device
- * and build a module for each of them 
+ * and collect the blocks for which a module should be built 
  *******************************************************************/
 static 
-void print_spice_flatten_connection_block_modules(NetlistManager& netlist_manager,
-                                                  const ModuleManager& module_manager, 
-                                                  const DeviceRRGSB& device_rr_gsb,
-                                                  const std::string& subckt_dir,
-                                                  const t_rr_type& cb_type) {
+void collect_flatten_connection_block_modules(std::vector<const RRGSB*>& rr_gsbs,
+                                              std::vector<t_rr_type>& block_types,
+                                              const DeviceRRGSB& device_rr_gsb,
+                                              const t_rr_type& cb_type) {
   /* Build unique X-direction connection block modules */
   vtr::Point<size_t> cb_range = device_rr_gsb.get_gsb_range();
 
@@ -230,10 +260,8 @@ void print_spice_flatten_connection_block_modules(NetlistManager& netlist_manage
       if (true != rr_gsb.is_cb_exist(cb_type)) {
         continue;
       }
-      print_spice_routing_connection_box_unique_module(netlist_manager, 
-                                                       module_manager,
-                                                       subckt_dir, 
-                                                       rr_gsb, cb_type);
+      rr_gsbs.push_back(&rr_gsb);
+      block_types.push_back(cb_type);
     }
   }
 }
@@ -250,12 +278,16 @@ void print_spice_flatten_connection_block_modules(NetlistManager& netlist_manage
 void print_spice_flatten_routing_modules(NetlistManager& netlist_manager,
                                          const ModuleManager& module_manager,
                                          const DeviceRRGSB& device_rr_gsb,
-                                         const std::string& subckt_dir) {
+                                         const std::string& subckt_dir,
+                                         const FabricSpiceOption& options) {
   /* Create a vector to contain all the Verilog netlist names that have been generated in this function */
   std::vector<std::string> netlist_names;
 
   vtr::Point<size_t> sb_range = device_rr_gsb.get_gsb_range();
 
+  std::vector<const RRGSB*> rr_gsbs;
+  std::vector<t_rr_type> block_types;
+
   /* Build unique switch block modules */
   for (size_t ix = 0; ix < sb_range.x(); ++ix) {
     for (size_t iy = 0; iy < sb_range.y(); ++iy) {
@@ -263,16 +295,24 @@ void print_spice_flatten_routing_modules(NetlistManager& netlist_manager,
       if (true != rr_gsb.is_sb_exist()) {
         continue;
       }
-      print_spice_routing_switch_box_unique_module(netlist_manager,
-                                                   module_manager, 
-                                                   subckt_dir, 
-                                                   rr_gsb);
+      rr_gsbs.push_back(&rr_gsb);
+      block_types.push_back(NUM_RR_TYPES);
     }
   }
 
-  print_spice_flatten_connection_block_modules(netlist_manager, module_manager, device_rr_gsb, subckt_dir, CHANX);
+  collect_flatten_connection_block_modules(rr_gsbs, block_types,
+                                           device_rr_gsb,
+                                           CHANX);
+
+  collect_flatten_connection_block_modules(rr_gsbs, block_types,
+                                           device_rr_gsb,
+                                           CHANY);
 
-  print_spice_flatten_connection_block_modules(netlist_manager, module_manager, device_rr_gsb, subckt_dir, CHANY);
+  print_spice_routing_block_netlists(netlist_manager,
+                                     module_manager,
+                                     rr_gsbs, block_types,
+                                     subckt_dir,
+                                     options);
 
   /*
   VTR_LOG("Writing header file for routing submodules '%s'...",
@@ -299,39 +339,41 @@ void print_spice_flatten_routing_modules(NetlistManager& netlist_manager,
 void print_spice_unique_routing_modules(NetlistManager& netlist_manager,
                                           const ModuleManager& module_manager,
                                           const DeviceRRGSB& device_rr_gsb,
-                                          const std::string& subckt_dir) {
+                                          const std::string& subckt_dir,
+                                          const FabricSpiceOption& options) {
   /* Create a vector to contain all the Verilog netlist names that have been generated in this function */
   std::vector<std::string> netlist_names;
 
+  std::vector<const RRGSB*> rr_gsbs;
+  std::vector<t_rr_type> block_types;
+
   /* Build unique switch block modules */
   for (size_t isb = 0; isb < device_rr_gsb.get_num_sb_unique_module(); ++isb) {
     const RRGSB& unique_mirror = device_rr_gsb.get_sb_unique_module(isb);
-    print_spice_routing_switch_box_unique_module(netlist_manager,
-                                                 module_manager,
-                                                 subckt_dir, 
-                                                 unique_mirror);
+    rr_gsbs.push_back(&unique_mirror);
+    block_types.push_back(NUM_RR_TYPES);
   }
 
   /* Build unique X-direction connection block modules */
   for (size_t icb = 0; icb < device_rr_gsb.get_num_cb_unique_module(CHANX); ++icb) {
     const RRGSB& unique_mirror = device_rr_gsb.get_cb_unique_module(CHANX, icb);
-
-    print_spice_routing_connection_box_unique_module(netlist_manager,
-                                                     module_manager,
-                                                     subckt_dir, 
-                                                     unique_mirror, CHANX);
+    rr_gsbs.push_back(&unique_mirror);
+    block_types.push_back(CHANX);
   }
 
   /* Build unique X-direction connection block modules */
   for (size_t icb = 0; icb < device_rr_gsb.get_num_cb_unique_module(CHANY); ++icb) {
     const RRGSB& unique_mirror = device_rr_gsb.get_cb_unique_module(CHANY, icb);
-
-    print_spice_routing_connection_box_unique_module(netlist_manager, 
-                                                     module_manager,
-                                                     subckt_dir, 
-                                                     unique_mirror, CHANY);
+    rr_gsbs.push_back(&unique_mirror);
+    block_types.push_back(CHANY);
   }
 
+  print_spice_routing_block_netlists(netlist_manager,
+                                     module_manager,
+                                     rr_gsbs, block_types,
+                                     subckt_dir,
+                                     options);
+
   /*
   VTR_LOG("Writing header file for routing submodules '%s'...",
           ROUTING_VERILOG_FILE_NAME);
@@ -71,20 +71,20 @@ BasicPort generate_spice_port_for_module_net(const ModuleManager& module_manager
    * if we have a source module is the current module, this is not local wire 
    */
   for (ModuleNetSrcId src_id : module_manager.module_net_sources(module_id, module_net)) {
-    if (module_id == module_manager.net_source_modules(module_id, module_net)[src_id]) {
+    if (module_id == module_manager.net_source_module(module_id, module_net, src_id)) {
       /* Here, this is not a local wire, return the port name of the src_port */
-      ModulePortId net_src_port = module_manager.net_source_ports(module_id, module_net)[src_id];
-      size_t src_pin_index = module_manager.net_source_pins(module_id, module_net)[src_id];
+      ModulePortId net_src_port = module_manager.net_source_port(module_id, module_net, src_id);
+      size_t src_pin_index = module_manager.net_source_pin(module_id, module_net, src_id);
       return BasicPort(module_manager.module_port(module_id, net_src_port).get_name(), src_pin_index, src_pin_index);
     }
   }
 
   /* Check all the sink modules of the net */
   for (ModuleNetSinkId sink_id : module_manager.module_net_sinks(module_id, module_net)) {
-    if (module_id == module_manager.net_sink_modules(module_id, module_net)[sink_id]) {
+    if (module_id == module_manager.net_sink_module(module_id, module_net, sink_id)) {
       /* Here, this is not a local wire, return the port name of the sink_port */
-      ModulePortId net_sink_port = module_manager.net_sink_ports(module_id, module_net)[sink_id];
-      size_t sink_pin_index = module_manager.net_sink_pins(module_id, module_net)[sink_id];
+      ModulePortId net_sink_port = module_manager.net_sink_port(module_id, module_net, sink_id);
+      size_t sink_pin_index = module_manager.net_sink_pin(module_id, module_net, sink_id);
       return BasicPort(module_manager.module_port(module_id, net_sink_port).get_name(), sink_pin_index, sink_pin_index);
     }
   }
@@ -93,25 +93,13 @@ BasicPort generate_spice_port_for_module_net(const ModuleManager& module_manager
   std::string net_name;
 
   /* Each net must only one 1 source */ 
-  VTR_ASSERT(1 == module_manager.net_source_modules(module_id, module_net).size());
-
-  /* Get the source module */
-  ModuleId net_src_module = module_manager.net_source_modules(module_id, module_net)[ModuleNetSrcId(0)];
-  /* Get the instance id */
-  size_t net_src_instance = module_manager.net_source_instances(module_id, module_net)[ModuleNetSrcId(0)]; 
-  /* Get the port id */
-  ModulePortId net_src_port = module_manager.net_source_ports(module_id, module_net)[ModuleNetSrcId(0)]; 
+  VTR_ASSERT(1 == module_manager.num_net_sources(module_id, module_net));
+
   /* Get the pin id */
-  size_t net_src_pin = module_manager.net_source_pins(module_id, module_net)[ModuleNetSrcId(0)]; 
+  size_t net_src_pin = module_manager.net_source_pin(module_id, module_net, ModuleNetSrcId(0)); 
 
-  /* Load user-defined name if we have it */
-  if (false == module_manager.net_name(module_id, module_net).empty()) {
-    net_name = module_manager.net_name(module_id, module_net);
-  } else {
-    net_name  = module_manager.module_name(net_src_module); 
-    net_name += std::string("_") + std::to_string(net_src_instance) + std::string("_");
-    net_name += module_manager.module_port(net_src_module, net_src_port).get_name();
-  }
+  /* Load user-defined name if we have it, otherwise the name is built from the source */
+  net_name = module_manager.net_wire_name(module_id, module_net);
   
   return BasicPort(net_name, net_src_pin, net_src_pin);
 }
@@ -136,14 +124,14 @@ void print_spice_subckt_output_short_connection(std::fstream& fp,
 
   /* We have found a module input, now check all the sink modules of the net */
   for (ModuleNetSinkId net_sink : module_manager.module_net_sinks(module_id, module_net)) {
-    ModuleId sink_module = module_manager.net_sink_modules(module_id, module_net)[net_sink];
+    ModuleId sink_module = module_manager.net_sink_module(module_id, module_net, net_sink);
     if (module_id != sink_module) {
       continue;
     }
 
     /* Find the sink port and pin information */
-    ModulePortId sink_port_id = module_manager.net_sink_ports(module_id, module_net)[net_sink];
-    size_t sink_pin = module_manager.net_sink_pins(module_id, module_net)[net_sink];
+    ModulePortId sink_port_id = module_manager.net_sink_port(module_id, module_net, net_sink);
+    size_t sink_pin = module_manager.net_sink_pin(module_id, module_net, net_sink);
     BasicPort sink_port(module_manager.module_port(module_id, sink_port_id).get_name(), sink_pin, sink_pin);
 
     /* For the first module output, this is the source port, we do nothing and go to the next */
@@ -183,27 +171,27 @@ void print_spice_subckt_local_short_connection(std::fstream& fp,
   VTR_ASSERT(true == valid_file_stream(fp));
 
   for (ModuleNetSrcId net_src : module_manager.module_net_sources(module_id, module_net)) {
-    ModuleId src_module = module_manager.net_source_modules(module_id, module_net)[net_src];
+    ModuleId src_module = module_manager.net_source_module(module_id, module_net, net_src);
     if (module_id != src_module) {
       continue;
     }
     /* Find the source port and pin information */
     print_spice_comment(fp, std::string("Net source id " + std::to_string(size_t(net_src))));
-    ModulePortId src_port_id = module_manager.net_source_ports(module_id, module_net)[net_src];
-    size_t src_pin = module_manager.net_source_pins(module_id, module_net)[net_src];
+    ModulePortId src_port_id = module_manager.net_source_port(module_id, module_net, net_src);
+    size_t src_pin = module_manager.net_source_pin(module_id, module_net, net_src);
     BasicPort src_port(module_manager.module_port(module_id, src_port_id).get_name(), src_pin, src_pin);
 
     /* We have found a module input, now check all the sink modules of the net */
     for (ModuleNetSinkId net_sink : module_manager.module_net_sinks(module_id, module_net)) {
-      ModuleId sink_module = module_manager.net_sink_modules(module_id, module_net)[net_sink];
+      ModuleId sink_module = module_manager.net_sink_module(module_id, module_net, net_sink);
       if (module_id != sink_module) {
         continue;
       }
 
       /* Find the sink port and pin information */
       print_spice_comment(fp, std::string("Net sink id " + std::to_string(size_t(net_sink))));
-      ModulePortId sink_port_id = module_manager.net_sink_ports(module_id, module_net)[net_sink];
-      size_t sink_pin = module_manager.net_sink_pins(module_id, module_net)[net_sink];
+      ModulePortId sink_port_id = module_manager.net_sink_port(module_id, module_net, net_sink);
+      size_t sink_pin = module_manager.net_sink_pin(module_id, module_net, net_sink);
       BasicPort sink_port(module_manager.module_port(module_id, sink_port_id).get_name(), sink_pin, sink_pin);
 
       /* We need to print a wire connection here */
@@ -0,0 +1,335 @@
+/********************************************************************
+ * This file includes functions to print SPICE testbenches
+ * which characterize each unique tile of a FPGA fabric in isolation, i.e.,
+ * - one testbench for each unique switch block
+ * - one testbench for each unique connection block
+ * - one testbench for each type of grid
+ * Each testbench is a run-ready SPICE deck, so that the characterization
+ * can be run in parallel rather than simulating the full fabric
+ *******************************************************************/
+#include <vector>
+#include <fstream>
+#include <iomanip>
+#include <algorithm>
+
+/* Headers from vtrutil library */
+#include "vtr_assert.h"
+#include "vtr_log.h"
+#include "vtr_time.h"
+
+/* Headers from openfpgashell library */
+#include "command_exit_codes.h"
+
+/* Headers from openfpgautil library */
+#include "openfpga_digest.h"
+#include "openfpga_parallel.h"
+
+/* Headers from vpr library */
+#include "vpr_utils.h"
+
+#include "openfpga_reserved_words.h"
+#include "openfpga_naming.h"
+#include "openfpga_physical_tile_utils.h"
+#include "circuit_library_utils.h"
+
+#include "spice_constants.h"
+#include "spice_writer_utils.h"
+#include "spice_tile_testbench.h"
+
+/* begin namespace openfpga */
+namespace openfpga {
+
+/********************************************************************
+ * Find the modules to be characterized, i.e.,
+ * - the unique switch blocks
+ * - the unique connection blocks in both X- and Y-direction
+ * - the grids for each type of physical tile and each border side of I/Os
+ * which are the same modules as those written by write_fabric_spice
+ *******************************************************************/
+static
+std::vector<ModuleId> find_spice_tile_testbench_modules(const ModuleManager& module_manager,
+                                                        const DeviceContext& device_ctx,
+                                                        const DeviceRRGSB& device_rr_gsb) {
+  std::vector<ModuleId> tile_modules;
+
+  /* Unique switch blocks */
+  for (size_t isb = 0; isb < device_rr_gsb.get_num_sb_unique_module(); ++isb) {
+    const RRGSB& unique_mirror = device_rr_gsb.get_sb_unique_module(isb);
+    vtr::Point<size_t> gsb_coordinate(unique_mirror.get_sb_x(), unique_mirror.get_sb_y());
+    ModuleId sb_module = module_manager.find_module(generate_switch_block_module_name(gsb_coordinate));
+    VTR_ASSERT(true == module_manager.valid_module_id(sb_module));
+    tile_modules.push_back(sb_module);
+  }
+
+  /* Unique connection blocks */
+  for (const t_rr_type& cb_type : {CHANX, CHANY}) {
+    for (size_t icb = 0; icb < device_rr_gsb.get_num_cb_unique_module(cb_type); ++icb) {
+      const RRGSB& unique_mirror = device_rr_gsb.get_cb_unique_module(cb_type, icb);
+      vtr::Point<size_t> gsb_coordinate(unique_mirror.get_cb_x(cb_type), unique_mirror.get_cb_y(cb_type));
+      ModuleId cb_module = module_manager.find_module(generate_connection_block_module_name(cb_type, gsb_coordinate));
+      VTR_ASSERT(true == module_manager.valid_module_id(cb_module));
+      tile_modules.push_back(cb_module);
+    }
+  }
+
+  /* Grids: I/O blocks have one module for each border side where they are located */
+  for (const t_physical_tile_type& physical_tile : device_ctx.physical_tile_types) {
+    if (true == is_empty_type(&physical_tile)) {
+      continue;
+    }
+    std::vector<e_side> border_sides;
+    if (true == is_io_type(&physical_tile)) {
+      for (const e_side& io_type_side : find_physical_io_tile_located_sides(device_ctx.grid, &physical_tile)) {
+        border_sides.push_back(io_type_side);
+      }
+    } else {
+      border_sides.push_back(NUM_SIDES);
+    }
+    for (const e_side& border_side : border_sides) {
+      std::string grid_module_name = generate_grid_block_module_name(std::string(GRID_SPICE_FILE_NAME_PREFIX), std::string(physical_tile.name), is_io_type(&physical_tile), border_side);
+      ModuleId grid_module = module_manager.find_module(grid_module_name);
+      VTR_ASSERT(true == module_manager.valid_module_id(grid_module));
+      tile_modules.push_back(grid_module);
+    }
+  }
+
+  return tile_modules;
+}
+
+/********************************************************************
+ * Convert a time in the simulation settings to an absolute value in seconds
+ * A fractional value is a fraction of the operating clock period
+ *******************************************************************/
+static
+float find_spice_testbench_time(const SimulationSetting& sim_setting,
+                                const e_sim_accuracy_type& time_type,
+                                const float& time_value) {
+  if (SIM_ACCURACY_FRAC == time_type) {
+    return time_value / sim_setting.default_operating_clock_frequency();
+  }
+  VTR_ASSERT(SIM_ACCURACY_ABS == time_type);
+  return time_value;
+}
+
+/********************************************************************
+ * Print a voltage source for each pin of a port
+ * - A constant value when the period is zero
+ * - Otherwise, a pulse starting from the ground voltage
+ *******************************************************************/
+static
+void print_spice_testbench_port_stimuli(std::fstream& fp,
+                                        const BasicPort& port,
+                                        const float& period,
+                                        const float& rise_slew,
+                                        const float& fall_slew) {
+  for (const size_t& pin : port.pins()) {
+    BasicPort port_pin(port.get_name(), pin, pin);
+    bool omit_pin_zero = (1 == port.pins().size()) && (0 == pin);
+    std::string node_name = generate_spice_port(port_pin, omit_pin_zero);
+
+    fp << "V" << node_name << " " << node_name << " 0";
+    if (0. == period) {
+      fp << " 0";
+    } else {
+      fp << " pulse(0 vsp 0";
+      fp << " " << std::setprecision(10) << rise_slew;
+      fp << " " << std::setprecision(10) << fall_slew;
+      fp << " " << std::setprecision(10) << period / 2. - (rise_slew + fall_slew) / 2.;
+      fp << " " << std::setprecision(10) << period;
+      fp << ")";
+    }
+    fp << std::endl;
+  }
+}
+
+/********************************************************************
+ * Print a SPICE testbench to characterize a tile module
+ *
+ *              +--------------+
+ *    clock --->|              |
+ *   inputs --->|   tile DUT   |---> outputs
+ *  globals --->|              |
+ *              +--------------+
+ *                 |        |
+ *                VDD      VSS
+ *
+ * - Clock ports are driven by pulses at the operating clock frequency
+ * - Input ports toggle once per clock cycle
+ * - Global ports, e.g., resets and configuration enables, are tied to ground
+ * - The average power drawn from VDD is measured over the transient simulation
+ *
+ * Return the file name of the testbench
+ *******************************************************************/
+static
+std::string print_spice_tile_testbench(const NetlistManager& netlist_manager,
+                                       const ModuleManager& module_manager,
+                                       const ModuleId& tile_module,
+                                       const CircuitLibrary& circuit_lib,
+                                       const TechnologyLibrary& tech_lib,
+                                       const SimulationSetting& sim_setting,
+                                       const std::string& testbench_dir) {
+  std::string module_name = module_manager.module_name(tile_module);
+  std::string spice_fname = testbench_dir + module_name + std::string(SPICE_TILE_TESTBENCH_POSTFIX) + std::string(SPICE_NETLIST_FILE_POSTFIX);
+
+  /* Create the file stream */
+  std::fstream fp;
+  fp.open(spice_fname, std::fstream::out | std::fstream::trunc);
+
+  check_file_stream(spice_fname.c_str(), fp);
+
+  print_spice_file_header(fp, std::string("Characterization testbench for " + module_name));
+
+  /* Include the transistor models and take the supply voltage of the first one */
+  float vdd = 0.;
+  bool vdd_found = false;
+  print_spice_comment(fp, std::string("Include technology libraries"));
+  for (const TechnologyModelId& tech_model : tech_lib.models()) {
+    if (TECH_LIB_MODEL_TRANSISTOR != tech_lib.model_type(tech_model)) {
+      continue;
+    }
+    fp << ".lib \"" << tech_lib.model_lib_path(tech_model) << "\" " << tech_lib.model_corner(tech_model) << std::endl;
+    if (false == vdd_found) {
+      vdd = tech_lib.model_vdd(tech_model);
+      vdd_found = true;
+    }
+  }
+  fp << std::endl;
+
+  /* Include the fabric netlists except the top-level module, which is not needed */
+  print_spice_comment(fp, std::string("Include user-defined netlists"));
+  for (const std::string& user_defined_netlist : find_circuit_library_unique_spice_netlists(circuit_lib)) {
+    print_spice_include_netlist(fp, user_defined_netlist);
+  }
+  print_spice_comment(fp, std::string("Include fabric netlists"));
+  for (const NetlistManager::e_netlist_type& netlist_type : {NetlistManager::SUBMODULE_NETLIST,
+                                                             NetlistManager::LOGIC_BLOCK_NETLIST,
+                                                             NetlistManager::ROUTING_MODULE_NETLIST}) {
+    for (const NetlistId& nlist_id : netlist_manager.netlists_by_type(netlist_type)) {
+      print_spice_include_netlist(fp, netlist_manager.netlist_name(nlist_id));
+    }
+  }
+  fp << std::endl;
+
+  /* Simulation parameters */
+  float clock_period = 1. / sim_setting.default_operating_clock_frequency();
+  /* Simulate a single clock cycle when the number of clock cycles is selected automatically,
+   * as there is no benchmark to find the number of cycles from
+   */
+  size_t num_clock_cycles = std::max(size_t(1), sim_setting.num_clock_cycles());
+  float sim_time = num_clock_cycles * clock_period;
+  float sim_step = find_spice_testbench_time(sim_setting, sim_setting.simulation_accuracy_type(), sim_setting.simulation_accuracy());
+
+  print_spice_comment(fp, std::string("Simulation parameters"));
+  fp << ".param vsp=" << std::setprecision(10) << vdd << std::endl;
+  fp << ".temp " << std::setprecision(10) << sim_setting.simulation_temperature() << std::endl;
+  fp << std::endl;
+
+  /* Supply voltages */
+  print_spice_comment(fp, std::string("Supply voltages"));
+  fp << "Vsupply " << SPICE_SUBCKT_VDD_PORT_NAME << " 0 vsp" << std::endl;
+  fp << "Vground " << SPICE_SUBCKT_GND_PORT_NAME << " 0 0" << std::endl;
+  fp << std::endl;
+
+  /* Device under test, whose ports are connected to the nodes of the same names */
+  print_spice_comment(fp, std::string("Device under test"));
+  print_spice_subckt_instance(fp, module_manager, tile_module, std::string("dut"), std::map<std::string, BasicPort>());
+  fp << std::endl;
+
+  /* Stimuli */
+  print_spice_comment(fp, std::string("Stimuli"));
+  float clock_rise_slew = find_spice_testbench_time(sim_setting, sim_setting.stimuli_clock_slew_type(SIM_SIGNAL_RISE), sim_setting.stimuli_clock_slew(SIM_SIGNAL_RISE));
+  float clock_fall_slew = find_spice_testbench_time(sim_setting, sim_setting.stimuli_clock_slew_type(SIM_SIGNAL_FALL), sim_setting.stimuli_clock_slew(SIM_SIGNAL_FALL));
+  float input_rise_slew = find_spice_testbench_time(sim_setting, sim_setting.stimuli_input_slew_type(SIM_SIGNAL_RISE), sim_setting.stimuli_input_slew(SIM_SIGNAL_RISE));
+  float input_fall_slew = find_spice_testbench_time(sim_setting, sim_setting.stimuli_input_slew_type(SIM_SIGNAL_FALL), sim_setting.stimuli_input_slew(SIM_SIGNAL_FALL));
+
+  for (const BasicPort& port : module_manager.module_ports_by_type(tile_module, ModuleManager::MODULE_GLOBAL_PORT)) {
+    print_spice_testbench_port_stimuli(fp, port, 0., 0., 0.);
+  }
+  for (const BasicPort& port : module_manager.module_ports_by_type(tile_module, ModuleManager::MODULE_CLOCK_PORT)) {
+    print_spice_testbench_port_stimuli(fp, port, clock_period, clock_rise_slew, clock_fall_slew);
+  }
+  for (const ModuleManager::e_module_port_type& port_type : {ModuleManager::MODULE_GPIN_PORT,
+                                                             ModuleManager::MODULE_GPIO_PORT,
+                                                             ModuleManager::MODULE_INOUT_PORT,
+                                                             ModuleManager::MODULE_INPUT_PORT}) {
+    for (const BasicPort& port : module_manager.module_ports_by_type(tile_module, port_type)) {
+      print_spice_testbench_port_stimuli(fp, port, 2. * clock_period, input_rise_slew, input_fall_slew);
+    }
+  }
+  fp << std::endl;
+
+  /* Transient simulation and measurements */
+  print_spice_comment(fp, std::string("Transient simulation and measurements"));
+  fp << ".tran " << std::setprecision(10) << sim_step << " " << std::setprecision(10) << sim_time << std::endl;
+  fp << ".meas tran avg_supply_current avg I(Vsupply) from=0 to=" << std::setprecision(10) << sim_time << std::endl;
+  fp << ".meas tran avg_power param='-avg_supply_current*vsp'" << std::endl;
+  fp << ".end" << std::endl;
+
+  /* Close file handler */
+  fp.close();
+
+  return spice_fname;
+}
+
+/********************************************************************
+ * Print the characterization testbenches for all the unique tiles
+ * - Each testbench is an independent file, so they are written
+ *   on multiple threads when requested
+ * - A list of all the testbenches is written to the testbench directory,
+ *   which can be used to dispatch the simulations
+ *******************************************************************/
+int print_spice_tile_testbenches(NetlistManager& netlist_manager,
+                                 const ModuleManager& module_manager,
+                                 const DeviceContext& device_ctx,
+                                 const DeviceRRGSB& device_rr_gsb,
+                                 const CircuitLibrary& circuit_lib,
+                                 const TechnologyLibrary& tech_lib,
+                                 const SimulationSetting& sim_setting,
+                                 const std::string& testbench_dir,
+                                 const size_t& num_threads,
+                                 const bool& verbose) {
+  vtr::ScopedStartFinishTimer timer("Write SPICE testbenches for unique tiles\n");
+
+  std::vector<ModuleId> tile_modules = find_spice_tile_testbench_modules(module_manager, device_ctx, device_rr_gsb);
+
+  std::vector<std::string> spice_fnames(tile_modules.size());
+  parallel_for(tile_modules.size(), num_threads,
+               [&](const size_t& itile) {
+                 spice_fnames[itile] = print_spice_tile_testbench(const_cast<const NetlistManager&>(netlist_manager),
+                                                                  module_manager,
+                                                                  tile_modules[itile],
+                                                                  circuit_lib, tech_lib, sim_setting,
+                                                                  testbench_dir);
+               });
+
+  for (size_t itile = 0; itile < tile_modules.size(); ++itile) {
+    VTR_LOGV(verbose,
+             "Written SPICE testbench '%s' for module '%s'\n",
+             spice_fnames[itile].c_str(),
+             module_manager.module_name(tile_modules[itile]).c_str());
+
+    /* Add fname to the netlist name list, in the order of the tile modules which is also
+     * the order of the testbench list below
+     */
+    NetlistId nlist_id = netlist_manager.add_netlist(spice_fnames[itile]);
+    VTR_ASSERT(NetlistId::INVALID() != nlist_id);
+    netlist_manager.set_netlist_type(nlist_id, NetlistManager::TESTBENCH_NETLIST);
+  }
+
+  /* Write a list of the testbenches, one file per line */
+  std::string list_fname = testbench_dir + std::string(SPICE_TILE_TESTBENCH_LIST_FILE_NAME);
+  std::fstream fp;
+  fp.open(list_fname, std::fstream::out | std::fstream::trunc);
+  check_file_stream(list_fname.c_str(), fp);
+  for (const std::string& spice_fname : spice_fnames) {
+    fp << spice_fname << std::endl;
+  }
+  fp.close();
+
+  VTR_LOG("Written %lu SPICE testbenches for unique tiles, listed in '%s'\n",
+          spice_fnames.size(), list_fname.c_str());
+
+  return CMD_EXEC_SUCCESS;
+}
+
+} /* end namespace openfpga */
@@ -0,0 +1,36 @@
+#ifndef SPICE_TILE_TESTBENCH_H
+#define SPICE_TILE_TESTBENCH_H
+
+/********************************************************************
+ * Include header files that are required by function declaration
+ *******************************************************************/
+#include <string>
+#include "vpr_context.h"
+#include "module_manager.h"
+#include "netlist_manager.h"
+#include "device_rr_gsb.h"
+#include "circuit_library.h"
+#include "technology_library.h"
+#include "simulation_setting.h"
+
+/********************************************************************
+ * Function declaration
+ *******************************************************************/
+
+/* begin namespace openfpga */
+namespace openfpga {
+
+int print_spice_tile_testbenches(NetlistManager& netlist_manager,
+                                 const ModuleManager& module_manager,
+                                 const DeviceContext& device_ctx,
+                                 const DeviceRRGSB& device_rr_gsb,
+                                 const CircuitLibrary& circuit_lib,
+                                 const TechnologyLibrary& tech_lib,
+                                 const SimulationSetting& sim_setting,
+                                 const std::string& testbench_dir,
+                                 const size_t& num_threads,
+                                 const bool& verbose);
+
+} /* end namespace openfpga */
+
+#endif
@@ -56,6 +56,16 @@ void print_spice_top_module(NetlistManager& netlist_manager,
 
   print_spice_file_header(fp, std::string("Top-level SPICE subckt for FPGA")); 
 
+  /* Write the tile modules, if any, which are only instanciated by the top-level module */
+  for (const ModuleId& module : module_manager.modules()) {
+    if (ModuleManager::MODULE_TILE != module_manager.module_usage(module)) {
+      continue;
+    }
+    write_spice_subckt_to_file(fp, module_manager, module);
+    /* Add an empty line as a splitter */
+    fp << std::endl;
+  }
+
   /* Write the module content in Verilog format */
   write_spice_subckt_to_file(fp, module_manager, top_module);
 
@@ -3,8 +3,10 @@
  * outputting wrapper SPICE netlists for transistor
  ***********************************************/
 #include <fstream>
+#include <sstream>
 #include <cmath>
 #include <iomanip>
+#include <map>
 
 /* Headers from vtrutil library */
 #include "vtr_assert.h"
@@ -27,11 +29,16 @@ namespace openfpga {
 
 /********************************************************************
  * Print a SPICE model wrapper for a transistor model
+ *
+ * A wrapper is skipped if an identical one, i.e., the same name 
+ * and the same sizing, has been written by another technology model,
+ * so that each transistor wrapper is defined only once
  *******************************************************************/
 static 
 int print_spice_transistor_model_wrapper(std::fstream& fp,
                                          const TechnologyLibrary& tech_lib,
-                                         const TechnologyModelId& model) {
+                                         const TechnologyModelId& model,
+                                         std::map<std::string, std::string>& written_wrappers) {
 
   if (false == valid_file_stream(fp)) {
     return CMD_EXEC_FATAL_ERROR;
@@ -47,6 +54,19 @@ int print_spice_transistor_model_wrapper(std::fstream& fp,
        itype < NUM_TECH_LIB_TRANSISTOR_TYPES;
        ++itype) {
     const e_tech_lib_transistor_type& trans_type = static_cast<e_tech_lib_transistor_type>(itype); 
+
+    std::string wrapper_name = tech_lib.transistor_model_name(model, trans_type) + std::string(TRANSISTOR_WRAPPER_POSTFIX);
+    std::stringstream wrapper_signature;
+    wrapper_signature << tech_lib.model_ref(model);
+    wrapper_signature << " L=" << std::setprecision(10) << tech_lib.transistor_model_chan_length(model, trans_type);
+    wrapper_signature << " W=" << std::setprecision(10) << tech_lib.transistor_model_min_width(model, trans_type);
+    auto written_result = written_wrappers.find(wrapper_name);
+    if ( (written_result != written_wrappers.end())
+      && (written_result->second == wrapper_signature.str()) ) {
+      continue;
+    }
+    written_wrappers[wrapper_name] = wrapper_signature.str();
+
     fp << ".subckt ";
     fp << tech_lib.transistor_model_name(model, trans_type) << TRANSISTOR_WRAPPER_POSTFIX; 
     fp << " drain gate source bulk";
@@ -89,6 +109,9 @@ int print_spice_transistor_wrapper(NetlistManager& netlist_manager,
 
   print_spice_file_header(fp, std::string("Transistor wrappers"));
 
+  /* Record the transistor wrappers which have been written */
+  std::map<std::string, std::string> written_wrappers;
+
   /* Iterate over the transistor models */
   for (const TechnologyModelId& model : tech_lib.models()) {
     /* Focus on transistor model */
@@ -96,7 +119,7 @@ int print_spice_transistor_wrapper(NetlistManager& netlist_manager,
       continue;
     }
     /* Write a wrapper for the transistor model */
-    if (CMD_EXEC_SUCCESS != print_spice_transistor_model_wrapper(fp, tech_lib, model)) {
+    if (CMD_EXEC_SUCCESS != print_spice_transistor_model_wrapper(fp, tech_lib, model, written_wrappers)) {
       return CMD_EXEC_FATAL_ERROR;
     }
   } 
@@ -262,7 +262,7 @@ void print_spice_subckt_instance(std::fstream& fp,
   }
 
   /* Print instance name */
-  std::string instance_head_line = "X " + instance_name + " ";
+  std::string instance_head_line = "X" + instance_name + " ";
   fp << instance_head_line;
   
   /* Port sequence: global, inout, input, output and clock ports, */
@@ -300,13 +300,13 @@ void print_spice_subckt_instance(std::fstream& fp,
           write_space_to_file(fp, 1);
         }
         
-        BasicPort port_pin(port.get_name(), pin, pin);
+        BasicPort port_pin(port_to_print.get_name(), pin, pin);
 
         /* For single-bit port,
          * we can print the port name directly
          */
         bool omit_pin_zero = false;
-        if ((1 == port.pins().size())
+        if ((1 == port_to_print.pins().size())
            && (0 == pin)) {
           omit_pin_zero = true;
         }
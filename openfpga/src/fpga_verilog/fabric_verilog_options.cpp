@@ -4,6 +4,9 @@
 #include "vtr_assert.h"
 #include "vtr_log.h"
 
+/* Headers from openfpgautil library */
+#include "openfpga_tokenizer.h"
+
 #include "fabric_verilog_options.h"
 
 /* begin namespace openfpga */
@@ -15,10 +18,21 @@ namespace openfpga {
 FabricVerilogOption::FabricVerilogOption() {
   output_directory_.clear();
   include_timing_ = false;
+  include_signal_init_ = false;
   explicit_port_mapping_ = false;
   compress_routing_ = false;
   print_user_defined_template_ = false;
   default_net_type_ = VERILOG_DEFAULT_NET_TYPE_NONE;
+  share_routing_bodies_ = false;
+  compact_mux_branches_ = false;
+  merge_netlists_ = false;
+  remove_module_netlists_ = false;
+  resolve_defines_ = false;
+  resolved_defines_.clear();
+  keep_unchanged_netlists_ = false;
+  prune_unused_for_design_ = false;
+  num_threads_ = 1;
+  compression_ = FILE_COMPRESSION_NONE;
   verbose_output_ = false;
 }
 
@@ -33,6 +47,10 @@ bool FabricVerilogOption::include_timing() const {
   return include_timing_;
 }
 
+bool FabricVerilogOption::include_signal_init() const {
+  return include_signal_init_;
+}
+
 bool FabricVerilogOption::explicit_port_mapping() const {
   return explicit_port_mapping_;
 }
@@ -49,6 +67,53 @@ e_verilog_default_net_type FabricVerilogOption::default_net_type() const {
   return default_net_type_;
 }
 
+bool FabricVerilogOption::share_routing_bodies() const {
+  return share_routing_bodies_;
+}
+
+bool FabricVerilogOption::compact_mux_branches() const {
+  return compact_mux_branches_;
+}
+
+bool FabricVerilogOption::merge_netlists() const {
+  return merge_netlists_;
+}
+
+bool FabricVerilogOption::remove_module_netlists() const {
+  return remove_module_netlists_;
+}
+
+bool FabricVerilogOption::resolve_defines() const {
+  return resolve_defines_;
+}
+
+const std::set<std::string>& FabricVerilogOption::resolved_defines() const {
+  return resolved_defines_;
+}
+
+bool FabricVerilogOption::keep_unchanged_netlists() const {
+  return keep_unchanged_netlists_;
+}
+
+bool FabricVerilogOption::prune_unused_for_design() const {
+  return prune_unused_for_design_;
+}
+
+e_file_update FabricVerilogOption::netlist_update() const {
+  if (true == keep_unchanged_netlists_) {
+    return FILE_UPDATE_IF_CHANGED;
+  }
+  return FILE_UPDATE_ALWAYS;
+}
+
+size_t FabricVerilogOption::num_threads() const {
+  return num_threads_;
+}
+
+e_file_compression FabricVerilogOption::compression() const {
+  return compression_;
+}
+
 bool FabricVerilogOption::verbose_output() const {
   return verbose_output_;
 }
@@ -64,6 +129,10 @@ void FabricVerilogOption::set_include_timing(const bool& enabled) {
   include_timing_ = enabled;
 }
 
+void FabricVerilogOption::set_include_signal_init(const bool& enabled) {
+  include_signal_init_ = enabled;
+}
+
 void FabricVerilogOption::set_explicit_port_mapping(const bool& enabled) {
   explicit_port_mapping_ = enabled;
 }
@@ -90,6 +159,49 @@ void FabricVerilogOption::set_default_net_type(const std::string& default_net_ty
   }
 }
 
+void FabricVerilogOption::set_share_routing_bodies(const bool& enabled) {
+  share_routing_bodies_ = enabled;
+}
+
+void FabricVerilogOption::set_compact_mux_branches(const bool& enabled) {
+  compact_mux_branches_ = enabled;
+}
+
+void FabricVerilogOption::set_merge_netlists(const bool& enabled) {
+  merge_netlists_ = enabled;
+}
+
+void FabricVerilogOption::set_remove_module_netlists(const bool& enabled) {
+  remove_module_netlists_ = enabled;
+}
+
+void FabricVerilogOption::set_resolved_defines(const std::string& defines) {
+  resolve_defines_ = true;
+  resolved_defines_.clear();
+  /* Empty tokens, e.g., from an empty string, are skipped */
+  for (const std::string& define : StringToken(defines).split(',')) {
+    if (false == define.empty()) {
+      resolved_defines_.insert(define);
+    }
+  }
+}
+
+void FabricVerilogOption::set_keep_unchanged_netlists(const bool& enabled) {
+  keep_unchanged_netlists_ = enabled;
+}
+
+void FabricVerilogOption::set_prune_unused_for_design(const bool& enabled) {
+  prune_unused_for_design_ = enabled;
+}
+
+void FabricVerilogOption::set_num_threads(const size_t& num_threads) {
+  num_threads_ = num_threads;
+}
+
+void FabricVerilogOption::set_compression(const e_file_compression& compression) {
+  compression_ = compression;
+}
+
 void FabricVerilogOption::set_verbose_output(const bool& enabled) {
   verbose_output_ = enabled;
 }
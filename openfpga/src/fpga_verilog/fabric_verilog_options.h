@@ -4,7 +4,10 @@
 /********************************************************************
  * Include header files required by the data structure definition
  *******************************************************************/
+#include <set>
 #include <string>
+#include "openfpga_compressed_stream.h"
+#include "openfpga_buffered_file_stream.h"
 #include "verilog_port_types.h"
 
 /* Begin namespace openfpga */
@@ -20,26 +23,62 @@ class FabricVerilogOption {
   public: /* Public accessors */
     std::string output_directory() const;
     bool include_timing() const;
+    bool include_signal_init() const;
     bool explicit_port_mapping() const;
     bool compress_routing() const;
     e_verilog_default_net_type default_net_type() const;
     bool print_user_defined_template() const;
+    bool share_routing_bodies() const;
+    bool compact_mux_branches() const;
+    bool merge_netlists() const;
+    bool remove_module_netlists() const;
+    bool resolve_defines() const;
+    const std::set<std::string>& resolved_defines() const;
+    bool keep_unchanged_netlists() const;
+    /* Replace the tiles unused by the implemented design with stubs */
+    bool prune_unused_for_design() const;
+    /* How the netlists are updated by the file streams */
+    e_file_update netlist_update() const;
+    size_t num_threads() const;
+    e_file_compression compression() const;
     bool verbose_output() const;
   public: /* Public mutators */
     void set_output_directory(const std::string& output_dir);
     void set_include_timing(const bool& enabled);
+    void set_include_signal_init(const bool& enabled);
     void set_explicit_port_mapping(const bool& enabled);
     void set_compress_routing(const bool& enabled);
     void set_print_user_defined_template(const bool& enabled);
     void set_default_net_type(const std::string& default_net_type);
+    void set_share_routing_bodies(const bool& enabled);
+    void set_compact_mux_branches(const bool& enabled);
+    void set_merge_netlists(const bool& enabled);
+    void set_remove_module_netlists(const bool& enabled);
+    /* Resolve the preprocessing conditions with the flags separated by commas */
+    void set_resolved_defines(const std::string& defines);
+    void set_keep_unchanged_netlists(const bool& enabled);
+    void set_prune_unused_for_design(const bool& enabled);
+    void set_num_threads(const size_t& num_threads);
+    void set_compression(const e_file_compression& compression);
     void set_verbose_output(const bool& enabled);
   private: /* Internal Data */
     std::string output_directory_;
     bool include_timing_;
+    bool include_signal_init_;
     bool explicit_port_mapping_;
     bool compress_routing_;
     bool print_user_defined_template_;
     e_verilog_default_net_type default_net_type_;
+    bool share_routing_bodies_;
+    bool compact_mux_branches_;
+    bool merge_netlists_;
+    bool remove_module_netlists_;
+    bool resolve_defines_;
+    std::set<std::string> resolved_defines_;
+    bool keep_unchanged_netlists_;
+    bool prune_unused_for_design_;
+    size_t num_threads_;
+    e_file_compression compression_;
     bool verbose_output_;
 };
 
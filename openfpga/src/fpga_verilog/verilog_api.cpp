@@ -16,15 +16,19 @@
 #include "openfpga_reserved_words.h"
 
 #include "device_rr_gsb.h"
+#include "openfpga_naming.h"
 #include "verilog_constants.h"
 #include "verilog_auxiliary_netlists.h"
 #include "verilog_submodule.h"
 #include "verilog_routing.h"
 #include "verilog_grid.h"
+#include "verilog_stub_modules.h"
 #include "verilog_top_module.h"
 
 #include "verilog_preconfig_top_module.h"
+#include "verilog_preconfig_tile_module.h"
 #include "verilog_formal_random_top_testbench.h"
+#include "verilog_verilator_harness.h"
 #include "verilog_top_testbench.h"
 #include "verilog_simulation_info_writer.h"
 
@@ -54,15 +58,19 @@ namespace openfpga
  * The only exception now is the user-defined modules.
  * We should think clearly about how to handle them for both Verilog and SPICE generators!
  ********************************************************************/
-void fpga_fabric_verilog(ModuleManager &module_manager,
-                         NetlistManager &netlist_manager,
-                         const CircuitLibrary &circuit_lib,
-                         const MuxLibrary &mux_lib,
-                         const DecoderLibrary &decoder_lib,
-                         const DeviceContext &device_ctx,
-                         const VprDeviceAnnotation &device_annotation,
-                         const DeviceRRGSB &device_rr_gsb,
-                         const FabricVerilogOption &options) {
+int fpga_fabric_verilog(ModuleManager &module_manager,
+                        NetlistManager &netlist_manager,
+                        const CircuitLibrary &circuit_lib,
+                        const MuxLibrary &mux_lib,
+                        const DecoderLibrary &decoder_lib,
+                        const DeviceContext &device_ctx,
+                        const VprDeviceAnnotation &device_annotation,
+                        const DeviceRRGSB &device_rr_gsb,
+                        const VprPlacementAnnotation &place_annotation,
+                        const VprRoutingAnnotation &routing_annotation,
+                        const FabricGlobalPortInfo &global_ports,
+                        const ConfigProtocol &config_protocol,
+                        const FabricVerilogOption &options) {
 
   vtr::ScopedStartFinishTimer timer("Write Verilog netlists for FPGA fabric\n");
 
@@ -123,21 +131,66 @@ void fpga_fabric_verilog(ModuleManager &module_manager,
                       options,
                       options.verbose_output());
 
+  /* Find the instances unused by the design, which are replaced by stubs */
+  std::map<ModuleId, std::vector<bool>> stubbed_instances;
+  std::string config_chain_clock_name;
+  if (true == options.prune_unused_for_design()) {
+    /* The instances of tiles are shared by the used and unused grids, which cannot be replaced */
+    for (const ModuleId &module : module_manager.modules()) {
+      if (ModuleManager::MODULE_TILE == module_manager.module_usage(module)) {
+        VTR_LOG_ERROR("Option '--prune_unused_for_design' does not support fabrics built with tiles!\n");
+        return CMD_EXEC_FATAL_ERROR;
+      }
+    }
+    config_chain_clock_name = find_verilog_stub_config_chain_clock_name(const_cast<const ModuleManager &>(module_manager),
+                                                                        global_ports,
+                                                                        config_protocol.type());
+    stubbed_instances = find_verilog_top_module_unused_instances(const_cast<const ModuleManager &>(module_manager),
+                                                                 device_ctx.grid,
+                                                                 device_rr_gsb,
+                                                                 place_annotation,
+                                                                 routing_annotation,
+                                                                 config_protocol.type(),
+                                                                 config_chain_clock_name,
+                                                                 options.verbose_output());
+  }
+
   /* Generate FPGA fabric */
   print_verilog_top_module(netlist_manager,
                            const_cast<const ModuleManager &>(module_manager),
+                           stubbed_instances,
+                           config_chain_clock_name,
                            src_dir_path,
                            options);
 
+  /* Resolve the preprocessing conditions of the netlists, if required */
+  if (true == options.resolve_defines()) {
+    int status = resolve_verilog_netlists_preprocessing_conditions(const_cast<const NetlistManager &>(netlist_manager),
+                                                                   options);
+    if (CMD_EXEC_SUCCESS != status) {
+      return status;
+    }
+  }
+
+  /* Merge the netlists of each category into one, if required */
+  if (true == options.merge_netlists()) {
+    print_verilog_merged_netlists(const_cast<const NetlistManager &>(netlist_manager),
+                                  src_dir_path,
+                                  options);
+  }
+
   /* Generate an netlist including all the fabric-related netlists */
   print_verilog_fabric_include_netlist(const_cast<const NetlistManager &>(netlist_manager),
                                        src_dir_path,
-                                       circuit_lib);
+                                       circuit_lib,
+                                       options);
 
   /* Given a brief stats on how many Verilog modules have been written to files */
   VTR_LOGV(options.verbose_output(),
            "Written %lu Verilog modules in total\n",
            module_manager.num_modules());
+
+  return CMD_EXEC_SUCCESS;
 }
 
 /********************************************************************
@@ -152,8 +205,13 @@ void fpga_fabric_verilog(ModuleManager &module_manager,
 int fpga_verilog_testbench(const ModuleManager &module_manager,
                            const BitstreamManager &bitstream_manager,
                            const FabricBitstream &fabric_bitstream,
+                           const FabricBitstreamByAddress &fabric_bitstream_by_address,
                            const AtomContext &atom_ctx,
                            const PlacementContext &place_ctx,
+                           const DeviceContext &device_ctx,
+                           const VprDeviceAnnotation &device_annotation,
+                           const VprPlacementAnnotation &place_annotation,
+                           const VprRoutingAnnotation &routing_annotation,
                            const PinConstraints& pin_constraints,
                            const IoLocationMap &io_location_map,
                            const FabricGlobalPortInfo &fabric_global_port_info,
@@ -181,6 +239,11 @@ int fpga_verilog_testbench(const ModuleManager &module_manager,
   /* Generate wrapper module for FPGA fabric (mapped by the input benchmark and pre-configured testbench for verification */
   if (true == options.print_formal_verification_top_netlist()) {
     std::string formal_verification_top_netlist_file_path = src_dir_path + netlist_name + std::string(FORMAL_VERIFICATION_VERILOG_FILE_POSTFIX);
+    /* The bitstream is written to a memory file only when required */
+    std::string formal_verification_bitstream_memory_file_path;
+    if (true == options.use_preconfig_bitstream_memory_file()) {
+      formal_verification_bitstream_memory_file_path = src_dir_path + netlist_name + std::string(FORMAL_VERIFICATION_BITSTREAM_MEMORY_FILE_POSTFIX);
+    }
     status = print_verilog_preconfig_top_module(module_manager, bitstream_manager,
                                                 config_protocol,
                                                 circuit_lib, fabric_global_port_info,
@@ -190,7 +253,39 @@ int fpga_verilog_testbench(const ModuleManager &module_manager,
                                                 netlist_annotation,
                                                 netlist_name,
                                                 formal_verification_top_netlist_file_path,
-                                                options.explicit_port_mapping());
+                                                formal_verification_bitstream_memory_file_path,
+                                                options.explicit_port_mapping(),
+                                                options.fabric_signal_init(),
+                                                options.compression());
+    if (status == CMD_EXEC_FATAL_ERROR) {
+      return status;
+    }
+  }
+
+  /* Generate pre-configured grids and their reference sub-netlists, to be verified in independent jobs */
+  if (true == options.print_tile_formal_verification_netlists()) {
+    /* The grids should be instanciated directly by the top module, which is the hierarchy of the bitstream */
+    for (const ModuleId &module : module_manager.modules()) {
+      if (ModuleManager::MODULE_TILE == module_manager.module_usage(module)) {
+        VTR_LOG_ERROR("Option '--print_tile_formal_verification_netlists' does not support fabrics built with tiles!\n");
+        return CMD_EXEC_FATAL_ERROR;
+      }
+    }
+    status = print_verilog_preconfig_tile_modules(module_manager, bitstream_manager,
+                                                  config_protocol,
+                                                  circuit_lib, fabric_global_port_info,
+                                                  atom_ctx, device_ctx,
+                                                  device_annotation,
+                                                  place_annotation,
+                                                  routing_annotation,
+                                                  pin_constraints,
+                                                  netlist_annotation,
+                                                  netlist_name,
+                                                  src_dir_path,
+                                                  options.explicit_port_mapping(),
+                                                  options.fabric_signal_init(),
+                                                  options.compression(),
+                                                  options.verbose_output());
     if (status == CMD_EXEC_FATAL_ERROR) {
       return status;
     }
@@ -210,11 +305,36 @@ int fpga_verilog_testbench(const ModuleManager &module_manager,
                                        options.explicit_port_mapping());
   }
 
+  /* Generate top-level module and C++ harness for the Verilator simulator */
+  if (true == options.print_verilator_harness()) {
+    print_verilog_verilator_top_module(src_dir_path,
+                                       netlist_name,
+                                       options.fabric_netlist_file_path(),
+                                       options.reference_benchmark_file_path(),
+                                       atom_ctx,
+                                       netlist_annotation,
+                                       options.explicit_port_mapping());
+    print_verilator_harness(src_dir_path,
+                            netlist_name,
+                            atom_ctx,
+                            netlist_annotation,
+                            module_manager,
+                            fabric_global_port_info,
+                            pin_constraints,
+                            simulation_setting);
+  }
+
   /* Generate full testbench for verification, including configuration phase and operating phase */
   if (true == options.print_top_testbench()) {
     std::string top_testbench_file_path = src_dir_path + netlist_name + std::string(AUTOCHECK_TOP_TESTBENCH_VERILOG_FILE_POSTFIX);
+    /* The bitstream is written to a memory file only when required */
+    std::string bitstream_memory_file_path;
+    if (true == options.use_bitstream_memory_file()) {
+      bitstream_memory_file_path = src_dir_path + netlist_name + std::string(AUTOCHECK_TOP_TESTBENCH_BITSTREAM_MEMORY_FILE_POSTFIX);
+    }
     print_verilog_top_testbench(module_manager,
                                 bitstream_manager, fabric_bitstream,
+                                fabric_bitstream_by_address,
                                 circuit_lib,
                                 config_protocol,
                                 fabric_global_port_info,
@@ -224,10 +344,32 @@ int fpga_verilog_testbench(const ModuleManager &module_manager,
                                 netlist_annotation,
                                 netlist_name,
                                 top_testbench_file_path,
+                                bitstream_memory_file_path,
                                 simulation_setting,
                                 options);
   }
 
+  /* Generate a testbench which loads the bitstream and I/O vectors at run time,
+   * which is named after the fabric as it is independent from the design
+   */
+  if (true == options.print_runtime_top_testbench()) {
+    std::string runtime_testbench_file_path = src_dir_path + generate_fpga_top_module_name() + std::string(RUNTIME_TOP_TESTBENCH_VERILOG_FILE_POSTFIX);
+    std::string bitstream_memory_file_path = src_dir_path + netlist_name + std::string(RUNTIME_TOP_TESTBENCH_BITSTREAM_MEMORY_FILE_POSTFIX);
+    status = print_verilog_runtime_top_testbench(module_manager,
+                                                 bitstream_manager, fabric_bitstream,
+                                                 fabric_bitstream_by_address,
+                                                 circuit_lib,
+                                                 config_protocol,
+                                                 fabric_global_port_info,
+                                                 runtime_testbench_file_path,
+                                                 bitstream_memory_file_path,
+                                                 simulation_setting,
+                                                 options);
+    if (status == CMD_EXEC_FATAL_ERROR) {
+      return status;
+    }
+  }
+
   /* Generate exchangeable files which contains simulation settings */
   if (true == options.print_simulation_ini()) {
     std::string simulation_ini_file_name = options.simulation_ini_path();
@@ -13,11 +13,14 @@
 #include "config_protocol.h"
 #include "vpr_context.h"
 #include "vpr_device_annotation.h"
+#include "vpr_placement_annotation.h"
+#include "vpr_routing_annotation.h"
 #include "device_rr_gsb.h"
 #include "netlist_manager.h"
 #include "module_manager.h"
 #include "bitstream_manager.h"
 #include "fabric_bitstream.h"
+#include "fabric_bitstream_by_address.h"
 #include "simulation_setting.h"
 #include "pin_constraints.h"
 #include "io_location_map.h"
@@ -33,21 +36,30 @@
 /* begin namespace openfpga */
 namespace openfpga {
 
-void fpga_fabric_verilog(ModuleManager& module_manager,
-                         NetlistManager& netlist_manager,
-                         const CircuitLibrary& circuit_lib,
-                         const MuxLibrary& mux_lib,
-                         const DecoderLibrary& decoder_lib,
-                         const DeviceContext& device_ctx, 
-                         const VprDeviceAnnotation& device_annotation, 
-                         const DeviceRRGSB& device_rr_gsb,
-                         const FabricVerilogOption& options);
+int fpga_fabric_verilog(ModuleManager& module_manager,
+                        NetlistManager& netlist_manager,
+                        const CircuitLibrary& circuit_lib,
+                        const MuxLibrary& mux_lib,
+                        const DecoderLibrary& decoder_lib,
+                        const DeviceContext& device_ctx, 
+                        const VprDeviceAnnotation& device_annotation, 
+                        const DeviceRRGSB& device_rr_gsb,
+                        const VprPlacementAnnotation& place_annotation,
+                        const VprRoutingAnnotation& routing_annotation,
+                        const FabricGlobalPortInfo& global_ports,
+                        const ConfigProtocol& config_protocol,
+                        const FabricVerilogOption& options);
 
 int fpga_verilog_testbench(const ModuleManager& module_manager,
                            const BitstreamManager& bitstream_manager, 
                            const FabricBitstream& fabric_bitstream, 
+                           const FabricBitstreamByAddress& fabric_bitstream_by_address, 
                            const AtomContext& atom_ctx, 
                            const PlacementContext& place_ctx, 
+                           const DeviceContext& device_ctx,
+                           const VprDeviceAnnotation& device_annotation,
+                           const VprPlacementAnnotation& place_annotation,
+                           const VprRoutingAnnotation& routing_annotation,
                            const PinConstraints& pin_constraints,
                            const IoLocationMap& io_location_map,
                            const FabricGlobalPortInfo &fabric_global_port_info,
@@ -3,18 +3,28 @@
  * or code blocks, with a focus on 
  * `include user-defined or auto-generated netlists in Verilog format
  *******************************************************************/
+#include <cstdio>
 #include <fstream>
+#include <vector>
 
 /* Headers from vtrutil library */
 #include "vtr_assert.h"
+#include "vtr_log.h"
+#include "vtr_time.h"
 
 /* Headers from openfpgautil library */
 #include "openfpga_digest.h"
+#include "openfpga_buffered_file_stream.h"
+#include "openfpga_compressed_stream.h"
+#include "openfpga_parallel.h"
+
+#include "command_exit_codes.h"
 
 #include "openfpga_naming.h"
 #include "circuit_library_utils.h"
 #include "verilog_constants.h"
 #include "verilog_writer_utils.h"
+#include "verilog_preprocessor.h"
 #include "verilog_auxiliary_netlists.h"
 
 /* begin namespace openfpga */
@@ -23,32 +33,187 @@ namespace openfpga {
 /********************************************************************
  * Local constant variables
  *******************************************************************/
+/* Categories of netlists which can be merged, and the names of the merged netlists */
+static const std::vector<std::pair<NetlistManager::e_netlist_type, std::string>> MERGEABLE_NETLISTS = {
+  {NetlistManager::SUBMODULE_NETLIST, MERGED_SUBMODULE_VERILOG_NETLIST_FILE_NAME},
+  {NetlistManager::LOGIC_BLOCK_NETLIST, MERGED_LOGIC_BLOCK_VERILOG_NETLIST_FILE_NAME},
+  {NetlistManager::ROUTING_MODULE_NETLIST, MERGED_ROUTING_MODULE_VERILOG_NETLIST_FILE_NAME}
+};
+
+/********************************************************************
+ * Find the name of the merged netlist for a category of netlists
+ * Return an empty string if the category is not merged
+ *******************************************************************/
+static 
+std::string find_merged_netlist_name(const std::string& src_dir,
+                                     const NetlistManager::e_netlist_type& netlist_type) {
+  for (const auto& mergeable_netlist : MERGEABLE_NETLISTS) {
+    if (netlist_type == mergeable_netlist.first) {
+      return src_dir + mergeable_netlist.second;
+    }
+  }
+  return std::string();
+}
+
+/********************************************************************
+ * Find the path of the file of a netlist registered in the netlist manager
+ * Netlists written with compression are named after the uncompressed files,
+ * while some netlists are never compressed, e.g., those of primitive modules
+ *******************************************************************/
+static 
+std::string find_verilog_netlist_file_path(const std::string& nlist_fname,
+                                           const e_file_compression& compression) {
+  if (true == std::ifstream(nlist_fname).good()) {
+    return nlist_fname;
+  }
+  return compressed_file_name(nlist_fname, compression);
+}
+
+/********************************************************************
+ * Resolve the preprocessing conditions of the fabric netlists, 
+ * i.e., primitive modules, logic blocks, routing modules and the top module,
+ * considering that only the flags given in options are defined
+ * - Each netlist is rewritten in place without the branches not taken,
+ *   and with the same compression
+ * - Netlists are independent files, which are resolved on multiple threads
+ * Note that the files included by the netlists, e.g., the shared contents 
+ * of routing modules, are not resolved
+ *
+ * Return an error code if any netlist cannot be resolved
+ *******************************************************************/
+int resolve_verilog_netlists_preprocessing_conditions(const NetlistManager& netlist_manager,
+                                                     const FabricVerilogOption& options) {
+  vtr::ScopedStartFinishTimer timer("Resolve preprocessing conditions of Verilog netlists");
+
+  std::vector<NetlistId> netlists;
+  for (const NetlistManager::e_netlist_type& netlist_type : {NetlistManager::SUBMODULE_NETLIST,
+                                                            NetlistManager::LOGIC_BLOCK_NETLIST,
+                                                            NetlistManager::ROUTING_MODULE_NETLIST,
+                                                            NetlistManager::TOP_MODULE_NETLIST}) {
+    for (const NetlistId& nlist_id : netlist_manager.netlists_by_type(netlist_type)) {
+      netlists.push_back(nlist_id);
+    }
+  }
+
+  std::vector<bool> resolved(netlists.size(), false);
+  parallel_for(netlists.size(), options.num_threads(),
+               [&](const size_t& inlist) {
+                 std::string nlist_fname = netlist_manager.netlist_name(netlists[inlist]);
+                 std::string nlist_file_path = find_verilog_netlist_file_path(nlist_fname, options.compression());
+                 std::string contents;
+                 std::string resolved_contents;
+                 if ( (false == read_file_contents(nlist_file_path, contents))
+                   || (false == resolve_verilog_preprocessing_conditions(contents, options.resolved_defines(), resolved_contents)) ) {
+                   return;
+                 }
+                 contents.clear();
+                 /* Keep the compression of the file, which may not be the one in options */
+                 e_file_compression compression = (nlist_file_path == nlist_fname) ? FILE_COMPRESSION_NONE : options.compression();
+                 BufferedFileStream netlist_file(nlist_fname, compression, options.netlist_update());
+                 netlist_file.stream() << resolved_contents;
+                 close_verilog_netlist_file(netlist_file);
+                 resolved[inlist] = true;
+               });
+
+  int status = CMD_EXEC_SUCCESS;
+  for (size_t inlist = 0; inlist < netlists.size(); ++inlist) {
+    if (false == resolved[inlist]) {
+      VTR_LOG_ERROR("Fail to resolve the preprocessing conditions of netlist '%s'!\n",
+                    netlist_manager.netlist_name(netlists[inlist]).c_str());
+      status = CMD_EXEC_FATAL_ERROR;
+    }
+  }
+
+  VTR_LOGV(options.verbose_output(),
+           "Resolved the preprocessing conditions of %lu netlists\n",
+           netlists.size());
+
+  return status;
+}
+
+/********************************************************************
+ * Merge the netlists of each category, i.e., primitive modules, 
+ * logic blocks and routing modules, into one netlist,
+ * so that simulators and synthesis tools open a few large files 
+ * instead of thousands of small files
+ * - The contents of the netlists are copied one by one, in the order of
+ *   the netlist manager, which is the order they are included otherwise 
+ * - Netlists written with compression are read from the compressed files, 
+ *   and the merged netlists are written with the same compression 
+ * - The netlists of each module are removed after merging when required,
+ *   while the files they include, e.g., the shared contents of routing modules,
+ *   are kept
+ *******************************************************************/
+void print_verilog_merged_netlists(const NetlistManager& netlist_manager,
+                                   const std::string& src_dir,
+                                   const FabricVerilogOption& options) {
+  vtr::ScopedStartFinishTimer timer("Merge Verilog netlists");
+
+  for (const auto& mergeable_netlist : MERGEABLE_NETLISTS) {
+    std::string verilog_fname = find_merged_netlist_name(src_dir, mergeable_netlist.first);
+    std::vector<NetlistId> netlists = netlist_manager.netlists_by_type(mergeable_netlist.first);
+
+    BufferedFileStream netlist_file(verilog_fname, options.compression(), options.netlist_update());
+    std::fstream& fp = netlist_file.stream();
+    check_file_stream(verilog_fname.c_str(), fp);
+
+    print_verilog_file_header(fp, std::string("Merged Netlists"), false == options.keep_unchanged_netlists()); 
+
+    std::string contents;
+    for (const NetlistId& nlist_id : netlists) {
+      std::string nlist_fname = netlist_manager.netlist_name(nlist_id);
+      std::string nlist_file_path = find_verilog_netlist_file_path(nlist_fname, options.compression());
+      if (false == read_file_contents(nlist_file_path, contents)) {
+        VTR_LOG_ERROR("Fail to read netlist '%s' to merge!\n",
+                      nlist_file_path.c_str());
+        exit(1);
+      }
+      print_verilog_comment(fp, std::string("------ Merged from netlist '" + nlist_fname + "' -----"));
+      fp << contents << "\n";
+
+      if ( (true == options.remove_module_netlists())
+        && (0 != std::remove(nlist_file_path.c_str())) ) {
+        VTR_LOG_WARN("Fail to remove netlist '%s' after merging!\n",
+                     nlist_file_path.c_str());
+      }
+    }
+
+    close_verilog_netlist_file(netlist_file);
+
+    VTR_LOGV(options.verbose_output(),
+             "Merged %lu netlists into '%s'\n",
+             netlists.size(), netlist_file.file_name().c_str());
+  }
+}
 
 /********************************************************************
  * Print a file that includes all the fabric netlists 
  * that have been generated  and user-defined.
  * This does NOT include any testbenches!
  * Some netlists are open to compile under specific preprocessing flags
+ * When the netlists are merged, the merged netlists are included instead
+ * of the netlists of each module
  *******************************************************************/
 void print_verilog_fabric_include_netlist(const NetlistManager& netlist_manager,
                                           const std::string& src_dir,
-                                          const CircuitLibrary& circuit_lib) {
+                                          const CircuitLibrary& circuit_lib,
+                                          const FabricVerilogOption& options) {
   std::string verilog_fname = src_dir + std::string(FABRIC_INCLUDE_VERILOG_NETLIST_FILE_NAME);
 
   /* Create the file stream */
-  std::fstream fp;
-  fp.open(verilog_fname, std::fstream::out | std::fstream::trunc);
+  BufferedFileStream netlist_file(verilog_fname, FILE_COMPRESSION_NONE, options.netlist_update());
+  std::fstream& fp = netlist_file.stream();
 
   /* Validate the file stream */
   check_file_stream(verilog_fname.c_str(), fp);
 
   /* Print the title */
-  print_verilog_file_header(fp, std::string("Fabric Netlist Summary")); 
+  print_verilog_file_header(fp, std::string("Fabric Netlist Summary"), false == options.keep_unchanged_netlists()); 
 
   /* Print preprocessing flags */
   print_verilog_comment(fp, std::string("------ Include defines: preproc flags -----"));
   print_verilog_include_netlist(fp, std::string(src_dir + std::string(DEFINES_VERILOG_FILE_NAME)));
-  fp << std::endl;
+  fp << "\n";
 
   /* Include all the user-defined netlists */
   print_verilog_comment(fp, std::string("------ Include user-defined netlists -----"));
@@ -58,34 +223,46 @@ void print_verilog_fabric_include_netlist(const NetlistManager& netlist_manager,
 
   /* Include all the primitive modules */
   print_verilog_comment(fp, std::string("------ Include primitive module netlists -----"));
-  for (const NetlistId& nlist_id : netlist_manager.netlists_by_type(NetlistManager::SUBMODULE_NETLIST)) {
-    print_verilog_include_netlist(fp, netlist_manager.netlist_name(nlist_id));
+  if (true == options.merge_netlists()) {
+    print_verilog_include_netlist(fp, find_merged_netlist_name(src_dir, NetlistManager::SUBMODULE_NETLIST));
+  } else {
+    for (const NetlistId& nlist_id : netlist_manager.netlists_by_type(NetlistManager::SUBMODULE_NETLIST)) {
+      print_verilog_include_netlist(fp, netlist_manager.netlist_name(nlist_id));
+    }
   }
-  fp << std::endl;
+  fp << "\n";
 
   /* Include all the CLB, heterogeneous block modules */
   print_verilog_comment(fp, std::string("------ Include logic block netlists -----"));
-  for (const NetlistId& nlist_id : netlist_manager.netlists_by_type(NetlistManager::LOGIC_BLOCK_NETLIST)) {
-    print_verilog_include_netlist(fp, netlist_manager.netlist_name(nlist_id));
+  if (true == options.merge_netlists()) {
+    print_verilog_include_netlist(fp, find_merged_netlist_name(src_dir, NetlistManager::LOGIC_BLOCK_NETLIST));
+  } else {
+    for (const NetlistId& nlist_id : netlist_manager.netlists_by_type(NetlistManager::LOGIC_BLOCK_NETLIST)) {
+      print_verilog_include_netlist(fp, netlist_manager.netlist_name(nlist_id));
+    }
   }
-  fp << std::endl;
+  fp << "\n";
 
   /* Include all the routing architecture modules */
   print_verilog_comment(fp, std::string("------ Include routing module netlists -----"));
-  for (const NetlistId& nlist_id : netlist_manager.netlists_by_type(NetlistManager::ROUTING_MODULE_NETLIST)) {
-    print_verilog_include_netlist(fp, netlist_manager.netlist_name(nlist_id));
+  if (true == options.merge_netlists()) {
+    print_verilog_include_netlist(fp, find_merged_netlist_name(src_dir, NetlistManager::ROUTING_MODULE_NETLIST));
+  } else {
+    for (const NetlistId& nlist_id : netlist_manager.netlists_by_type(NetlistManager::ROUTING_MODULE_NETLIST)) {
+      print_verilog_include_netlist(fp, netlist_manager.netlist_name(nlist_id));
+    }
   }
-  fp << std::endl;
+  fp << "\n";
 
   /* Include FPGA top module */
   print_verilog_comment(fp, std::string("------ Include fabric top-level netlists -----"));
   for (const NetlistId& nlist_id : netlist_manager.netlists_by_type(NetlistManager::TOP_MODULE_NETLIST)) {
     print_verilog_include_netlist(fp, netlist_manager.netlist_name(nlist_id));
   }
-  fp << std::endl;
+  fp << "\n";
 
   /* Close the file stream */
-  fp.close();
+  close_verilog_netlist_file(netlist_file);
 }
 
 /********************************************************************
@@ -113,7 +290,7 @@ void print_verilog_testbench_include_netlists(const std::string& src_dir,
   /* Print preprocessing flags */
   print_verilog_comment(fp, std::string("------ Include simulation defines -----"));
   print_verilog_include_netlist(fp, src_dir + std::string(DEFINES_VERILOG_SIMULATION_FILE_NAME));
-  fp << std::endl;
+  fp << "\n";
 
   /* Include FPGA top module */
   print_verilog_comment(fp, std::string("------ Include fabric top-level netlists -----"));
@@ -123,14 +300,14 @@ void print_verilog_testbench_include_netlists(const std::string& src_dir,
     VTR_ASSERT_SAFE(false == fabric_netlist_file.empty());
     print_verilog_include_netlist(fp, fabric_netlist_file);
   }
-  fp << std::endl;
+  fp << "\n";
 
   /* Include reference benchmark netlist only when auto-check flag is enabled */
   print_verilog_preprocessing_flag(fp, std::string(AUTOCHECKED_SIMULATION_FLAG));
   fp << "\t";
   print_verilog_include_netlist(fp, std::string(reference_benchmark_file));
   print_verilog_endif(fp);
-  fp << std::endl;
+  fp << "\n";
 
   /* Include formal verification netlists only when formal verification flag is enable */
   print_verilog_preprocessing_flag(fp, std::string(VERILOG_FORMAL_VERIFICATION_PREPROC_FLAG));
@@ -146,14 +323,14 @@ void print_verilog_testbench_include_netlists(const std::string& src_dir,
   print_verilog_endif(fp);
   
   print_verilog_endif(fp);
-  fp << std::endl;
+  fp << "\n";
 
   /* Include top-level testbench only when auto-check flag is enabled */
   print_verilog_preprocessing_flag(fp, std::string(AUTOCHECKED_SIMULATION_FLAG));
   fp << "\t";
   print_verilog_include_netlist(fp, src_dir + circuit_name + std::string(AUTOCHECK_TOP_TESTBENCH_VERILOG_FILE_POSTFIX));
   print_verilog_endif(fp);
-  fp << std::endl;
+  fp << "\n";
 
   /* Close the file stream */
   fp.close();
@@ -169,23 +346,23 @@ void print_verilog_preprocessing_flags_netlist(const std::string& src_dir,
   std::string verilog_fname = src_dir + std::string(DEFINES_VERILOG_FILE_NAME);
 
   /* Create the file stream */
-  std::fstream fp;
-  fp.open(verilog_fname, std::fstream::out | std::fstream::trunc);
+  BufferedFileStream netlist_file(verilog_fname, FILE_COMPRESSION_NONE, fabric_verilog_opts.netlist_update());
+  std::fstream& fp = netlist_file.stream();
 
   /* Validate the file stream */
   check_file_stream(verilog_fname.c_str(), fp);
 
   /* Print the title */
-  print_verilog_file_header(fp, std::string("Preprocessing flags to enable/disable features in FPGA Verilog modules")); 
+  print_verilog_file_header(fp, std::string("Preprocessing flags to enable/disable features in FPGA Verilog modules"), false == fabric_verilog_opts.keep_unchanged_netlists()); 
 
   /* To enable timing */
   if (true == fabric_verilog_opts.include_timing()) {
     print_verilog_define_flag(fp, std::string(VERILOG_TIMING_PREPROC_FLAG), 1);
-    fp << std::endl;
+    fp << "\n";
   } 
 
   /* Close the file stream */
-  fp.close();
+  close_verilog_netlist_file(netlist_file);
 }
 
 /********************************************************************
@@ -206,41 +383,42 @@ void print_verilog_simulation_preprocessing_flags(const std::string& src_dir,
   /* Print the title */
   print_verilog_file_header(fp, std::string("Preprocessing flags to enable/disable simulation features")); 
 
-  /* To enable signal initialization */
-  if (true == verilog_testbench_opts.include_signal_init()) {
+  /* To enable signal initialization, either in testbenches or inside the fabric netlists */
+  if ( (true == verilog_testbench_opts.include_signal_init())
+    || (true == verilog_testbench_opts.fabric_signal_init()) ) {
     print_verilog_define_flag(fp, std::string(VERILOG_SIGNAL_INIT_PREPROC_FLAG), 1);
-    fp << std::endl;
+    fp << "\n";
   } 
 
   /* To enable functional verfication with Icarus */
   if (true == verilog_testbench_opts.support_icarus_simulator()) {
     print_verilog_define_flag(fp, std::string(ICARUS_SIMULATOR_FLAG), 1);
-    fp << std::endl;
+    fp << "\n";
   } 
 
   /* To enable manualy checked simulation */
   if (true == verilog_testbench_opts.print_top_testbench()) {
     print_verilog_define_flag(fp, std::string(INITIAL_SIMULATION_FLAG), 1);
-    fp << std::endl;
+    fp << "\n";
   } 
 
   /* To enable auto-checked simulation */
   if ( (true == verilog_testbench_opts.print_preconfig_top_testbench())
     || (true == verilog_testbench_opts.print_top_testbench()) ) {
     print_verilog_define_flag(fp, std::string(AUTOCHECKED_SIMULATION_FLAG), 1);
-    fp << std::endl;
+    fp << "\n";
   } 
 
   /* To enable pre-configured FPGA simulation */
   if (true == verilog_testbench_opts.print_formal_verification_top_netlist()) {
     print_verilog_define_flag(fp, std::string(VERILOG_FORMAL_VERIFICATION_PREPROC_FLAG), 1);
-    fp << std::endl;
+    fp << "\n";
   } 
 
   /* To enable pre-configured FPGA simulation */
   if (true == verilog_testbench_opts.print_preconfig_top_testbench()) {
     print_verilog_define_flag(fp, std::string(FORMAL_SIMULATION_FLAG), 1);
-    fp << std::endl;
+    fp << "\n";
   } 
 
   /* Close the file stream */
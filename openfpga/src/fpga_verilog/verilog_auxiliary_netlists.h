@@ -17,9 +17,17 @@
 /* begin namespace openfpga */
 namespace openfpga {
 
+int resolve_verilog_netlists_preprocessing_conditions(const NetlistManager& netlist_manager,
+                                                     const FabricVerilogOption& options);
+
+void print_verilog_merged_netlists(const NetlistManager& netlist_manager,
+                                   const std::string& src_dir,
+                                   const FabricVerilogOption& options);
+
 void print_verilog_fabric_include_netlist(const NetlistManager& netlist_manager,
                                           const std::string& src_dir,
-                                          const CircuitLibrary& circuit_lib);
+                                          const CircuitLibrary& circuit_lib,
+                                          const FabricVerilogOption& options);
 
 void print_verilog_testbench_include_netlists(const std::string& src_dir,
                                               const std::string& circuit_name,
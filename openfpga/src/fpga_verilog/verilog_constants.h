@@ -4,6 +4,7 @@
 /* global parameters for dumping synthesizable verilog */
 
 constexpr char* VERILOG_NETLIST_FILE_POSTFIX = ".v";
+constexpr char* VERILOG_SHARED_BODY_FILE_POSTFIX = "_body.vh"; // the contents of a module which are shared by identical modules
 constexpr float VERILOG_SIM_TIMESCALE = 1e-9; // Verilog Simulation time scale (minimum time unit) : 1ns
 
 constexpr char* VERILOG_TIMING_PREPROC_FLAG = "ENABLE_TIMING"; // the flag to enable timing definition during compilation
@@ -19,13 +20,29 @@ constexpr char* MODELSIM_SIMULATION_TIME_UNIT = "ms";
 constexpr char* ICARUS_SIMULATOR_FLAG = "ICARUS_SIMULATOR"; // the flag to enable specific Verilog code in testbenches
 // End of Icarus variables and flag
 
+// Verilator variables and flag
+constexpr char* VERILATOR_SIMULATOR_FLAG = "VERILATOR"; // the flag predefined by Verilator
+constexpr char* ASSIGN_PRECONFIG_BITSTREAM_FLAG = "ASSIGN_PRECONFIG_BITSTREAM"; // the flag to impose the bitstream with 'assign' instead of '$deposit', for the simulators which do not support the latter
+// End of Verilator variables and flag
+
 constexpr char* FABRIC_INCLUDE_VERILOG_NETLIST_FILE_NAME = "fabric_netlists.v";
+constexpr char* MERGED_SUBMODULE_VERILOG_NETLIST_FILE_NAME = "fabric_primitives.v"; // the netlists of primitive modules merged in one file
+constexpr char* MERGED_LOGIC_BLOCK_VERILOG_NETLIST_FILE_NAME = "fabric_logic_blocks.v"; // the netlists of logic blocks merged in one file
+constexpr char* MERGED_ROUTING_MODULE_VERILOG_NETLIST_FILE_NAME = "fabric_routing.v"; // the netlists of routing modules merged in one file
 constexpr char* TOP_VERILOG_TESTBENCH_INCLUDE_NETLIST_FILE_NAME_POSTFIX = "_include_netlists.v";
 constexpr char* VERILOG_TOP_POSTFIX = "_top.v";
 constexpr char* FORMAL_VERIFICATION_VERILOG_FILE_POSTFIX = "_top_formal_verification.v"; 
+constexpr char* FORMAL_VERIFICATION_BITSTREAM_MEMORY_FILE_POSTFIX = "_top_formal_verification_bitstream.mem"; 
+constexpr char* FORMAL_VERIFICATION_TILE_VERILOG_FILE_POSTFIX = "_tile_formal_verification.v"; /* one file per used grid, named after the design and the grid instance */
+constexpr char* FORMAL_VERIFICATION_TILE_REFERENCE_VERILOG_FILE_POSTFIX = "_tile_reference.v"; 
 constexpr char* TOP_TESTBENCH_VERILOG_FILE_POSTFIX = "_top_tb.v"; /* !!! must be consist with the modelsim_testbench_module_postfix */ 
 constexpr char* AUTOCHECK_TOP_TESTBENCH_VERILOG_FILE_POSTFIX = "_autocheck_top_tb.v"; /* !!! must be consist with the modelsim_autocheck_testbench_module_postfix */ 
+constexpr char* AUTOCHECK_TOP_TESTBENCH_BITSTREAM_MEMORY_FILE_POSTFIX = "_autocheck_top_tb_bitstream.mem"; 
+constexpr char* RUNTIME_TOP_TESTBENCH_VERILOG_FILE_POSTFIX = "_runtime_top_tb.v"; /* the testbench is named after the fabric rather than a design */
+constexpr char* RUNTIME_TOP_TESTBENCH_BITSTREAM_MEMORY_FILE_POSTFIX = "_runtime_top_tb_bitstream.mem"; 
 constexpr char* RANDOM_TOP_TESTBENCH_VERILOG_FILE_POSTFIX = "_formal_random_top_tb.v"; 
+constexpr char* VERILATOR_TOP_VERILOG_FILE_POSTFIX = "_verilator_top.v"; 
+constexpr char* VERILATOR_HARNESS_FILE_POSTFIX = "_verilator_harness.cpp"; 
 constexpr char* DEFINES_VERILOG_FILE_NAME = "fpga_defines.v";
 constexpr char* DEFINES_VERILOG_SIMULATION_FILE_NAME = "define_simulation.v";
 constexpr char* SUBMODULE_VERILOG_FILE_NAME = "sub_module.v";
@@ -42,6 +59,7 @@ constexpr char* ESSENTIALS_VERILOG_FILE_NAME = "inv_buf_passgate.v";
 constexpr char* CONFIG_PERIPHERAL_VERILOG_FILE_NAME = "config_peripherals.v";
 constexpr char* USER_DEFINED_TEMPLATE_VERILOG_FILE_NAME = "user_defined_templates.v";
 
+constexpr char* VERILOG_STUB_MODULE_POSTFIX = "_stub"; // the stubs of modules replacing the instances unused by a design
 constexpr char* VERILOG_MUX_BASIS_POSTFIX = "_basis";
 constexpr char* VERILOG_MEM_POSTFIX = "_mem";
 
@@ -52,8 +70,12 @@ constexpr char* GRID_VERILOG_FILE_NAME_PREFIX = "grid_";
 constexpr char* FORMAL_VERIFICATION_TOP_MODULE_POSTFIX = "_top_formal_verification";
 constexpr char* FORMAL_VERIFICATION_TOP_MODULE_PORT_POSTFIX = "_fm";
 constexpr char* FORMAL_VERIFICATION_TOP_MODULE_UUT_NAME = "U0_formal_verification";
+constexpr char* FORMAL_VERIFICATION_TOP_MODULE_BITSTREAM_MEMORY_NAME = "preconfig_bitstream_memory";
+constexpr char* FORMAL_VERIFICATION_TILE_MODULE_POSTFIX = "_tile_formal_verification";
+constexpr char* FORMAL_VERIFICATION_TILE_REFERENCE_MODULE_POSTFIX = "_tile_reference";
 
 constexpr char* FORMAL_RANDOM_TOP_TESTBENCH_POSTFIX = "_top_formal_verification_random_tb";
+constexpr char* VERILATOR_TOP_MODULE_POSTFIX = "_verilator_top";
 
 #define VERILOG_DEFAULT_SIGNAL_INIT_VALUE 0
 
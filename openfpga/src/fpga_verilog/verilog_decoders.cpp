@@ -112,19 +112,19 @@ void print_verilog_mux_local_decoder_module(std::fstream& fp,
    * The rest of addr codes 3'b110, 3'b111 will be decoded to data=8'b0_0000;
    */
 
-  fp << "\t" << "always@(" << generate_verilog_port(VERILOG_PORT_CONKT, addr_port) << ")" << std::endl;
-  fp << "\t" << "case (" << generate_verilog_port(VERILOG_PORT_CONKT, addr_port) << ")" << std::endl;
+  fp << "\t" << "always@(" << generate_verilog_port(VERILOG_PORT_CONKT, addr_port) << ")\n";
+  fp << "\t" << "case (" << generate_verilog_port(VERILOG_PORT_CONKT, addr_port) << ")\n";
   /* Create a string for addr and data */
   for (size_t i = 0; i < data_size; ++i) {
     fp << "\t\t" << generate_verilog_constant_values(itobin_vec(i, addr_size)); 
     fp << " : ";
     fp << generate_verilog_port_constant_values(data_port, ito1hot_vec(i, data_size)); 
-    fp << ";" << std::endl;
+    fp << ";\n";
   }
   fp << "\t\t" << "default : ";
   fp << generate_verilog_port_constant_values(data_port, ito1hot_vec(data_size - 1, data_size)); 
-  fp << ";" << std::endl;
-  fp << "\t" << "endcase" << std::endl;
+  fp << ";\n";
+  fp << "\t" << "endcase\n";
 
   print_verilog_wire_connection(fp, data_inv_port, data_port, true);
   
@@ -183,6 +183,11 @@ void print_verilog_submodule_mux_local_decoders(const ModuleManager& module_mana
 
   /* Create a library for local encoders with different sizes */
   DecoderLibrary decoder_lib;
+
+  /* The decoder of a branch only depends on its number of memory bits, 
+   * so the branches visited are shared by all the circuit models
+   */
+  std::set<std::pair<size_t, size_t>> visited_branches;
   
   /* Find unique local decoders for unique branches shared by the multiplexers */
   for (auto mux : mux_lib.muxes()) {
@@ -194,10 +199,10 @@ void print_verilog_submodule_mux_local_decoders(const ModuleManager& module_mana
     }
 
     const MuxGraph& mux_graph = mux_lib.mux_graph(mux);
-    /* Create a mux graph for the branch circuit */
-    std::vector<MuxGraph> branch_mux_graphs = mux_graph.build_mux_branch_graphs();
+    /* Create a mux graph for the branch circuits which are not visited yet */
+    std::vector<MuxGraph> branch_mux_graphs = mux_graph.build_mux_branch_graphs(visited_branches);
     /* Add the decoder to the decoder library */
-    for (auto branch_mux_graph : branch_mux_graphs) {
+    for (const MuxGraph& branch_mux_graph : branch_mux_graphs) {
       /* The decoder size depends on the number of memories of a branch MUX.
        * Note that only when there are >=2 memories, a decoder is needed
        */
@@ -228,6 +233,22 @@ void print_verilog_submodule_mux_local_decoders(const ModuleManager& module_mana
   VTR_LOG("Done\n");
 }
 
+/***************************************************************************************
+ * Generate the index of the data output selected by the address of a decoder
+ * The address is LSB-first, i.e., the first address bit is the least significant bit 
+ * of the index, the same as the addresses of configuration bits in bitstreams.
+ * As the first bit of a port [lsb:msb] is the most significant bit in Verilog,
+ * the address bits are concatenated in the reversed order: {addr[msb], ..., addr[lsb]}
+ ***************************************************************************************/
+static 
+std::string generate_verilog_decoder_data_index(const BasicPort& addr_port) {
+  std::vector<BasicPort> addr_bits;
+  for (size_t ipin = addr_port.get_width(); ipin > 0; --ipin) {
+    addr_bits.push_back(BasicPort(addr_port.get_name(), addr_port.get_lsb() + ipin - 1, addr_port.get_lsb() + ipin - 1));
+  }
+  return generate_verilog_ports(addr_bits);
+}
+
 /***************************************************************************************
  * Create a Verilog module for a decoder used as a configuration protocol 
  * in FPGA architecture
@@ -305,15 +326,15 @@ void print_verilog_arch_decoder_module(std::fstream& fp,
   if (1 == data_size) {
     fp << "always@(" << generate_verilog_port(VERILOG_PORT_CONKT, addr_port);
     fp << " or " << generate_verilog_port(VERILOG_PORT_CONKT, enable_port);
-    fp << ") begin" << std::endl;
+    fp << ") begin\n";
     fp << "\tif ((" << generate_verilog_port(VERILOG_PORT_CONKT, enable_port) << " == 1'b1) && ("; 
     fp << generate_verilog_port(VERILOG_PORT_CONKT, addr_port) << " == 1'b0))"; 
-    fp << " begin" << std::endl;
-    fp << "\t\t" << generate_verilog_port_constant_values(data_port, std::vector<size_t>(1, 1)) << ";" << std::endl; 
-    fp << "\t" << "end else begin" << std::endl;
-    fp << "\t\t" << generate_verilog_port_constant_values(data_port, std::vector<size_t>(1, 0)) << ";" << std::endl; 
-    fp << "\t" << "end" << std::endl;
-    fp << "end" << std::endl;
+    fp << " begin\n";
+    fp << "\t\t" << generate_verilog_port_constant_values(data_port, std::vector<size_t>(1, 1)) << ";\n"; 
+    fp << "\t" << "end else begin\n";
+    fp << "\t\t" << generate_verilog_port_constant_values(data_port, std::vector<size_t>(1, 0)) << ";\n"; 
+    fp << "\t" << "end\n";
+    fp << "end\n";
 
     /* Depend on if the inverted data output port is needed or not */
     if (true == decoder_lib.use_data_inv_port(decoder)) {
@@ -327,51 +348,31 @@ void print_verilog_arch_decoder_module(std::fstream& fp,
     return;
   }
 
-  /* We use a magic number -1 as the addr=1 should be mapped to ...1
-   * Otherwise addr will map addr=1 to ..10 
-   * Note that there should be a range for the shift operators
-   * We should narrow the encoding to be applied to a given set of data
-   * This will lead to that any addr which falls out of the op code of data
-   * will give a all-zero code
+  /* The data output selected by the address is set by indexing the data port
+   * with the address, rather than by a case statement over all the addresses,
+   * so that the netlist grows linearly with the number of data outputs.
+   * Any address which falls out of the data outputs selects nothing,
+   * which gives an all-zero code
    * For example: 
    * data is 5-bit while addr is 3-bit 
-   * data=8'b0_0000 will be encoded to addr=3'b001;
-   * data=8'b0_0001 will be encoded to addr=3'b010;
-   * data=8'b0_0010 will be encoded to addr=3'b011;
-   * data=8'b0_0100 will be encoded to addr=3'b100;
-   * data=8'b0_1000 will be encoded to addr=3'b101;
-   * data=8'b1_0000 will be encoded to addr=3'b110;
-   * The rest of addr codes 3'b110, 3'b111 will be decoded to data=8'b0_0000;
+   * addr=3'b000 will be decoded to data[0] = 1'b1;
+   * addr=3'b100 will be decoded to data[1] = 1'b1, as the first address bit is the LSB;
+   * ...
+   * The rest of addr codes 3'b101, 3'b011, 3'b111 will be decoded to data=5'b0_0000;
    */
+  std::string zero_str = "{" + std::to_string(data_port.get_width()) + "{1'b0}}";
 
   fp << "always@(" << generate_verilog_port(VERILOG_PORT_CONKT, addr_port);
   fp << " or " << generate_verilog_port(VERILOG_PORT_CONKT, enable_port);
-  fp << ") begin" << std::endl;
-  fp << "\tif (" << generate_verilog_port(VERILOG_PORT_CONKT, enable_port) << " == 1'b1) begin" << std::endl;
-  fp << "\t\t" << "case (" << generate_verilog_port(VERILOG_PORT_CONKT, addr_port) << ")" << std::endl;
-  /* Create a string for addr and data */
-  for (size_t i = 0; i < data_size; ++i) {
-    fp << "\t\t\t" << generate_verilog_constant_values(itobin_vec(i, addr_size)); 
-    fp << " : ";
-    fp << generate_verilog_port_constant_values(data_port, ito1hot_vec(i, data_size)); 
-    fp << ";" << std::endl;
-  }
-  /* Different from MUX decoder, we assign default values which is all zero */
-  fp << "\t\t\t" << "default"; 
-  fp << " : ";
-  fp << generate_verilog_port_constant_values(data_port, ito1hot_vec(data_size, data_size)); 
-  fp << ";" << std::endl;
-
-  fp << "\t\t" << "endcase" << std::endl;
-  fp << "\t" << "end" << std::endl;
-
+  fp << ") begin\n";
   /* If enable is not active, we should give all zero */
-  fp << "\t" << "else begin" << std::endl;
-  fp << "\t\t" << generate_verilog_port_constant_values(data_port, ito1hot_vec(data_size, data_size)); 
-  fp << ";" << std::endl;
-  fp << "\t" << "end" << std::endl;
-  
-  fp << "end" << std::endl;
+  fp << "\t" << generate_verilog_port(VERILOG_PORT_CONKT, data_port); 
+  fp << " = " << zero_str << ";\n";
+  fp << "\tif (" << generate_verilog_port(VERILOG_PORT_CONKT, enable_port) << " == 1'b1) begin\n";
+  fp << "\t\t" << data_port.get_name() << "[" << generate_verilog_decoder_data_index(addr_port) << "]";
+  fp << " = 1'b1;\n";
+  fp << "\t" << "end\n";
+  fp << "end\n";
 
   if (true == decoder_lib.use_data_inv_port(decoder)) {
     print_verilog_wire_connection(fp, data_inv_port, data_port, true);
@@ -462,13 +463,13 @@ void print_verilog_arch_decoder_with_data_in_module(std::fstream& fp,
   if (1 == data_size) {
     fp << "always@(" << generate_verilog_port(VERILOG_PORT_CONKT, addr_port);
     fp << " or " << generate_verilog_port(VERILOG_PORT_CONKT, enable_port);
-    fp << ") begin" << std::endl;
-    fp << "\tif (" << generate_verilog_port(VERILOG_PORT_CONKT, enable_port) << " == 1'b1) begin" << std::endl;
-    fp << "\t\t" << generate_verilog_port(VERILOG_PORT_CONKT, din_port) << ";" << std::endl; 
-    fp << "\t" << "end else begin" << std::endl;
-    fp << "\t\t" << generate_verilog_port_constant_values(data_port, std::vector<size_t>(1, 0)) << ";" << std::endl; 
-    fp << "\t" << "end" << std::endl;
-    fp << "end" << std::endl;
+    fp << ") begin\n";
+    fp << "\tif (" << generate_verilog_port(VERILOG_PORT_CONKT, enable_port) << " == 1'b1) begin\n";
+    fp << "\t\t" << generate_verilog_port(VERILOG_PORT_CONKT, din_port) << ";\n"; 
+    fp << "\t" << "end else begin\n";
+    fp << "\t\t" << generate_verilog_port_constant_values(data_port, std::vector<size_t>(1, 0)) << ";\n"; 
+    fp << "\t" << "end\n";
+    fp << "end\n";
 
     /* Depend on if the inverted data output port is needed or not */
     if (true == decoder_lib.use_data_inv_port(decoder)) {
@@ -483,50 +484,24 @@ void print_verilog_arch_decoder_with_data_in_module(std::fstream& fp,
   }
 
   /* Only the selected data output bit will be set to the value of data_in, 
-   * other data output bits will be '0'
+   * other data output bits will be in high resistance
+   * The selected data output is indexed by the address, as the decoder without data_in
    */
+  std::string high_res_str = "{" + std::to_string(data_port.get_width()) + "{1'bz}}";
+
   fp << "always@(" << generate_verilog_port(VERILOG_PORT_CONKT, addr_port);
   fp << ", " << generate_verilog_port(VERILOG_PORT_CONKT, enable_port);
   fp << ", " << generate_verilog_port(VERILOG_PORT_CONKT, din_port);
-  fp << ") begin" << std::endl;
-
-  fp << "\tif (" << generate_verilog_port(VERILOG_PORT_CONKT, enable_port) << " == 1'b1) begin" << std::endl;
-  fp << "\t\t" << generate_verilog_port(VERILOG_PORT_CONKT, data_port); 
-  fp << " = ";
-  std::string high_res_str = "{" + std::to_string(data_port.get_width()) + "{1'bz}}";
-  fp << high_res_str;
-  fp << ";" << std::endl;
-  fp << "\t\t" << "case (" << generate_verilog_port(VERILOG_PORT_CONKT, addr_port) << ")" << std::endl;
-  /* Create a string for addr and data */
-  for (size_t i = 0; i < data_size; ++i) {
-    BasicPort cur_data_port(data_port.get_name(), i, i);
-    fp << "\t\t\t" << generate_verilog_constant_values(itobin_vec(i, addr_size)); 
-    fp << " : ";
-    fp << generate_verilog_port(VERILOG_PORT_CONKT, cur_data_port); 
-    fp << " = ";
-    fp << generate_verilog_port(VERILOG_PORT_CONKT, din_port); 
-    fp << ";" << std::endl;
-  }
-  /* Different from MUX decoder, we assign default values which is all zero */
-  fp << "\t\t\t" << "default"; 
-  fp << " : ";
-  fp << "\t\t" << generate_verilog_port(VERILOG_PORT_CONKT, data_port); 
-  fp << " = ";
-  fp << high_res_str;
-  fp << ";" << std::endl;
+  fp << ") begin\n";
 
-  fp << "\t\t" << "endcase" << std::endl;
-  fp << "\t" << "end" << std::endl;
-
-  /* If enable is not active, we should give all zero */
-  fp << "\t" << "else begin" << std::endl;
-  fp << "\t\t" << generate_verilog_port(VERILOG_PORT_CONKT, data_port); 
-  fp << " = ";
-  fp << high_res_str;
-  fp << ";" << std::endl;
-  fp << "\t" << "end" << std::endl;
-  
-  fp << "end" << std::endl;
+  /* If enable is not active, we should give high resistance */
+  fp << "\t" << generate_verilog_port(VERILOG_PORT_CONKT, data_port); 
+  fp << " = " << high_res_str << ";\n";
+  fp << "\tif (" << generate_verilog_port(VERILOG_PORT_CONKT, enable_port) << " == 1'b1) begin\n";
+  fp << "\t\t" << data_port.get_name() << "[" << generate_verilog_decoder_data_index(addr_port) << "]";
+  fp << " = " << generate_verilog_port(VERILOG_PORT_CONKT, din_port) << ";\n";
+  fp << "\t" << "end\n";
+  fp << "end\n";
 
 
   if (true == decoder_lib.use_data_inv_port(decoder)) {
@@ -539,6 +514,143 @@ void print_verilog_arch_decoder_with_data_in_module(std::fstream& fp,
   print_verilog_module_end(fp, module_name);
 }
 
+/***************************************************************************************
+ * Create a Verilog module for a shift register driving the Bit-Lines of memory banks
+ *
+ *                 +-------------------+
+ *      data_in -->|  Shift register   |
+ *    bl_sr_clk -->|                   |
+ *                 +-------------------+
+ *                   | |   ...     | |
+ *                   v v           v v
+ *                      Data output
+ *
+ *  At each rising edge of the clock, data_in is shifted into the first data output,
+ *  while the other data outputs are shifted by one bit.
+ *  There is no enable signal: the data outputs are always driven
+ ***************************************************************************************/
+static 
+void print_verilog_arch_bl_shift_register_module(std::fstream& fp, 
+                                                 const ModuleManager& module_manager,
+                                                 const size_t& data_size,
+                                                 const e_verilog_default_net_type& default_net_type) {
+  /* Validate the FILE handler */
+  VTR_ASSERT(true == valid_file_stream(fp));
+
+  /* Create a name for the shift register */
+  std::string module_name = generate_bl_shift_register_subckt_name(data_size);
+
+  ModuleId module_id = module_manager.find_module(module_name); 
+  VTR_ASSERT(true == module_manager.valid_module_id(module_id));
+  /* Find module ports */
+  ModulePortId clk_port_id = module_manager.find_module_port(module_id, std::string(BL_SHIFT_REGISTER_CLOCK_PORT_NAME));
+  BasicPort clk_port = module_manager.module_port(module_id, clk_port_id);
+  ModulePortId din_port_id = module_manager.find_module_port(module_id, std::string(DECODER_DATA_IN_PORT_NAME));
+  BasicPort din_port = module_manager.module_port(module_id, din_port_id);
+  ModulePortId data_port_id = module_manager.find_module_port(module_id, std::string(DECODER_DATA_OUT_PORT_NAME));
+  BasicPort data_port = module_manager.module_port(module_id, data_port_id);
+
+  /* dump module definition + ports */
+  print_verilog_module_declaration(fp, module_manager, module_id, default_net_type);
+
+  print_verilog_comment(fp, std::string("----- BEGIN Verilog codes for " + std::to_string(data_size) + "-bit shift register driving Bit-Lines -----"));
+
+  fp << "always@(posedge " << generate_verilog_port(VERILOG_PORT_CONKT, clk_port) << ") begin\n";
+  fp << "\t" << generate_verilog_port(VERILOG_PORT_CONKT, data_port);
+  fp << " <= ";
+  if (1 == data_size) {
+    fp << generate_verilog_port(VERILOG_PORT_CONKT, din_port);
+  } else {
+    BasicPort shifted_data_port(data_port.get_name(), data_port.get_lsb(), data_port.get_msb() - 1);
+    fp << "{" << generate_verilog_port(VERILOG_PORT_CONKT, din_port);
+    fp << ", " << generate_verilog_port(VERILOG_PORT_CONKT, shifted_data_port) << "}";
+  }
+  fp << ";\n";
+  fp << "end\n";
+
+  print_verilog_comment(fp, std::string("----- END Verilog codes for " + std::to_string(data_size) + "-bit shift register driving Bit-Lines -----"));
+
+  /* Put an end to the Verilog module */
+  print_verilog_module_end(fp, module_name);
+}
+
+/***************************************************************************************
+ * Generate Verilog modules for the run-length decompressors
+ * feeding the heads of configuration chains
+ *
+ *                        +----------------+
+ *         data_in ------>|                |
+ * ccff_run_length ------>|  Run-length    |---> data_out
+ *  ccff_rle_reset ------>|  decompressor  |
+ *    ccff_rle_clk ------>|                |
+ *                        +----------------+
+ *
+ *  When no run is being repeated, data_in is passed to data_out, while
+ *  data_in and ccff_run_length are sampled at the rising edge of the clock.
+ *  The sampled bit value is then repeated on data_out during the number of
+ *  clock cycles given by the sampled run length
+ ***************************************************************************************/
+static 
+void print_verilog_arch_config_chain_decompressor_module(std::fstream& fp, 
+                                                         const ModuleManager& module_manager,
+                                                         const size_t& run_length_width,
+                                                         const e_verilog_default_net_type& default_net_type) {
+  /* Validate the FILE handler */
+  VTR_ASSERT(true == valid_file_stream(fp));
+
+  /* Create a name for the decompressor */
+  std::string module_name = generate_config_chain_decompressor_subckt_name(run_length_width);
+
+  ModuleId module_id = module_manager.find_module(module_name); 
+  VTR_ASSERT(true == module_manager.valid_module_id(module_id));
+  /* Find module ports */
+  ModulePortId clk_port_id = module_manager.find_module_port(module_id, std::string(CONFIG_CHAIN_DECOMPRESSOR_CLOCK_PORT_NAME));
+  BasicPort clk_port = module_manager.module_port(module_id, clk_port_id);
+  ModulePortId reset_port_id = module_manager.find_module_port(module_id, std::string(CONFIG_CHAIN_DECOMPRESSOR_RESET_PORT_NAME));
+  BasicPort reset_port = module_manager.module_port(module_id, reset_port_id);
+  ModulePortId din_port_id = module_manager.find_module_port(module_id, std::string(DECODER_DATA_IN_PORT_NAME));
+  BasicPort din_port = module_manager.module_port(module_id, din_port_id);
+  ModulePortId run_length_port_id = module_manager.find_module_port(module_id, std::string(CONFIG_CHAIN_RUN_LENGTH_PORT_NAME));
+  BasicPort run_length_port = module_manager.module_port(module_id, run_length_port_id);
+  ModulePortId data_port_id = module_manager.find_module_port(module_id, std::string(DECODER_DATA_OUT_PORT_NAME));
+  BasicPort data_port = module_manager.module_port(module_id, data_port_id);
+
+  /* dump module definition + ports */
+  print_verilog_module_declaration(fp, module_manager, module_id, default_net_type);
+
+  print_verilog_comment(fp, std::string("----- BEGIN Verilog codes for " + std::to_string(run_length_width) + "-bit run-length decompressor -----"));
+
+  /* Internal registers: the remaining length of the run and its bit value */
+  BasicPort run_count_port(std::string("run_count"), run_length_width);
+  BasicPort run_value_port(std::string("run_value"), 1);
+  fp << generate_verilog_port(VERILOG_PORT_REG, run_count_port) << ";\n";
+  fp << generate_verilog_port(VERILOG_PORT_REG, run_value_port) << ";\n";
+
+  std::string run_count_name = generate_verilog_port(VERILOG_PORT_CONKT, run_count_port);
+  fp << "always@(posedge " << generate_verilog_port(VERILOG_PORT_CONKT, clk_port);
+  fp << " or posedge " << generate_verilog_port(VERILOG_PORT_CONKT, reset_port) << ") begin\n";
+  fp << "\tif (" << generate_verilog_port(VERILOG_PORT_CONKT, reset_port) << ") begin\n";
+  fp << "\t\t" << run_count_name << " <= 0;\n";
+  fp << "\tend else if (0 == " << run_count_name << ") begin\n";
+  fp << "\t\t" << run_count_name << " <= " << generate_verilog_port(VERILOG_PORT_CONKT, run_length_port) << ";\n";
+  fp << "\t\t" << generate_verilog_port(VERILOG_PORT_CONKT, run_value_port);
+  fp << " <= " << generate_verilog_port(VERILOG_PORT_CONKT, din_port) << ";\n";
+  fp << "\tend else begin\n";
+  fp << "\t\t" << run_count_name << " <= " << run_count_name << " - 1;\n";
+  fp << "\tend\n";
+  fp << "end\n";
+
+  fp << "assign " << generate_verilog_port(VERILOG_PORT_CONKT, data_port);
+  fp << " = (0 == " << run_count_name << ") ? ";
+  fp << generate_verilog_port(VERILOG_PORT_CONKT, din_port) << " : ";
+  fp << generate_verilog_port(VERILOG_PORT_CONKT, run_value_port) << ";\n";
+
+  print_verilog_comment(fp, std::string("----- END Verilog codes for " + std::to_string(run_length_width) + "-bit run-length decompressor -----"));
+
+  /* Put an end to the Verilog module */
+  print_verilog_module_end(fp, module_name);
+}
+
 /***************************************************************************************
  * This function will generate all the unique Verilog modules of decoders for 
  * configuration protocols in a FPGA fabric
@@ -577,6 +689,16 @@ void print_verilog_submodule_arch_decoders(const ModuleManager& module_manager,
     }
   }
 
+  /* Generate Verilog modules for the shift registers driving Bit-Lines */
+  for (const size_t& shift_register_size : decoder_lib.shift_registers()) {
+    print_verilog_arch_bl_shift_register_module(fp, module_manager, shift_register_size, default_net_type);
+  }
+
+  /* Generate Verilog modules for the decompressors of configuration chains */
+  for (const size_t& run_length_width : decoder_lib.decompressors()) {
+    print_verilog_arch_config_chain_decompressor_module(fp, module_manager, run_length_width, default_net_type);
+  }
+
   /* Close the file stream */
   fp.close();
 
@@ -43,7 +43,7 @@ void print_verilog_power_gated_invbuf_body(std::fstream& fp,
   print_verilog_comment(fp, std::string("----- Verilog codes of a power-gated inverter -----"));
 
   /* Create a sensitive list */
-  fp << "\treg " << circuit_lib.port_lib_name(output_port) << "_reg;" << std::endl;
+  fp << "\treg " << circuit_lib.port_lib_name(output_port) << "_reg;\n";
 
   fp << "\talways @(";
   /* Power-gate port first*/
@@ -55,7 +55,7 @@ void print_verilog_power_gated_invbuf_body(std::fstream& fp,
     fp << circuit_lib.port_lib_name(power_gate_port);
     fp << ", ";
   }
-  fp << circuit_lib.port_lib_name(input_port) << ") begin" << std::endl; 
+  fp << circuit_lib.port_lib_name(input_port) << ") begin\n"; 
 
   /* Dump the case of power-gated */
   fp << "\t\tif (";
@@ -68,7 +68,7 @@ void print_verilog_power_gated_invbuf_body(std::fstream& fp,
     }
     for (const auto& power_gate_pin : circuit_lib.pins(power_gate_port)) {
       if (0 < port_cnt) { 
-        fp << std::endl << "\t\t&&";
+        fp << "\n" << "\t\t&&";
       }
       fp << "(";
 
@@ -85,7 +85,7 @@ void print_verilog_power_gated_invbuf_body(std::fstream& fp,
     }
   }
 
-  fp << ") begin" << std::endl;
+  fp << ") begin\n";
   fp << "\t\t\tassign " << circuit_lib.port_lib_name(output_port) << "_reg = "; 
 
   /* Branch on the type of inverter/buffer: 
@@ -101,12 +101,12 @@ void print_verilog_power_gated_invbuf_body(std::fstream& fp,
     fp << "~";
   } 
 
-  fp << circuit_lib.port_lib_name(input_port) << ";" << std::endl;
-  fp << "\t\tend else begin" << std::endl;
-  fp << "\t\t\tassign " << circuit_lib.port_lib_name(output_port) << "_reg = 1'bz;" << std::endl;
-  fp << "\t\tend" << std::endl;
-  fp << "\tend" << std::endl;
-  fp << "\tassign " << circuit_lib.port_lib_name(output_port) << " = " << circuit_lib.port_lib_name(output_port) << "_reg;" << std::endl;
+  fp << circuit_lib.port_lib_name(input_port) << ";\n";
+  fp << "\t\tend else begin\n";
+  fp << "\t\t\tassign " << circuit_lib.port_lib_name(output_port) << "_reg = 1'bz;\n";
+  fp << "\t\tend\n";
+  fp << "\tend\n";
+  fp << "\tassign " << circuit_lib.port_lib_name(output_port) << " = " << circuit_lib.port_lib_name(output_port) << "_reg;\n";
 }
 
 /************************************************
@@ -139,7 +139,7 @@ void print_verilog_invbuf_body(std::fstream& fp,
     fp << "~";
   } 
 
-  fp << circuit_lib.port_lib_name(input_port) << ";" << std::endl;
+  fp << circuit_lib.port_lib_name(input_port) << ";\n";
 }
 
 /************************************************
@@ -209,7 +209,8 @@ void print_verilog_passgate_module(const ModuleManager& module_manager,
                                    std::fstream& fp,
                                    const CircuitLibrary& circuit_lib,
                                    const CircuitModelId& circuit_model,
-                                   const e_verilog_default_net_type& default_net_type) {
+                                   const e_verilog_default_net_type& default_net_type,
+                                   const bool& include_signal_init) {
   /* Ensure a valid file handler*/
   VTR_ASSERT(true == valid_file_stream(fp));
 
@@ -265,11 +266,16 @@ void print_verilog_passgate_module(const ModuleManager& module_manager,
    */
   fp << "\tassign " << circuit_lib.port_lib_name(output_ports[0]) << " = ";
   fp << circuit_lib.port_lib_name(input_ports[1]) << " ? " << circuit_lib.port_lib_name(input_ports[0]);
-  fp << " : 1'bz;" << std::endl;
+  fp << " : 1'bz;\n";
 
   /* Print timing info */
   print_verilog_submodule_timing(fp, circuit_lib, circuit_model);
 
+  /* Print driver initialization, so that testbenches do not need to deposit each instance */
+  if (true == include_signal_init) {
+    print_verilog_submodule_signal_init(fp, circuit_lib, circuit_model);
+  }
+
   /* Put an end to the Verilog module */
   print_verilog_module_end(fp, circuit_lib.model_name(circuit_model));
 }
@@ -326,7 +332,7 @@ void print_verilog_and_or_gate_body(std::fstream& fp,
           port_cnt++;
         }
       }
-      fp << ";" << std::endl;
+      fp << ";\n";
     }
   }
 }
@@ -403,7 +409,7 @@ void print_verilog_mux2_gate_body(std::fstream& fp,
   fp << generate_verilog_port(VERILOG_PORT_CONKT, in0_port_info);
   fp << " : ";
   fp << generate_verilog_port(VERILOG_PORT_CONKT, in1_port_info);
-  fp << ";" << std::endl;
+  fp << ";\n";
 }
 
 /************************************************
@@ -419,7 +425,8 @@ void print_verilog_gate_module(const ModuleManager& module_manager,
                                std::fstream& fp,
                                const CircuitLibrary& circuit_lib,
                                const CircuitModelId& circuit_model,
-                               const e_verilog_default_net_type& default_net_type) {
+                               const e_verilog_default_net_type& default_net_type,
+                               const bool& include_signal_init) {
   /* Ensure a valid file handler*/
   VTR_ASSERT(true == valid_file_stream(fp));
 
@@ -461,6 +468,11 @@ void print_verilog_gate_module(const ModuleManager& module_manager,
   /* Print timing info */
   print_verilog_submodule_timing(fp, circuit_lib, circuit_model);
 
+  /* Print driver initialization (ONLY for MUX2), so that testbenches do not need to deposit each instance */
+  if (true == include_signal_init) {
+    print_verilog_submodule_signal_init(fp, circuit_lib, circuit_model);
+  }
+
   /* Put an end to the Verilog module */
   print_verilog_module_end(fp, circuit_lib.model_name(circuit_model));
 }
@@ -505,7 +517,8 @@ void print_verilog_submodule_essentials(const ModuleManager& module_manager,
                                         NetlistManager& netlist_manager,
                                         const std::string& submodule_dir,
                                         const CircuitLibrary& circuit_lib,
-                                        const e_verilog_default_net_type& default_net_type) {
+                                        const e_verilog_default_net_type& default_net_type,
+                                        const bool& include_signal_init) {
   /* TODO: remove .bak when this part is completed and tested */
   std::string verilog_fname = submodule_dir + std::string(ESSENTIALS_VERILOG_FILE_NAME);
 
@@ -538,11 +551,11 @@ void print_verilog_submodule_essentials(const ModuleManager& module_manager,
       continue;
     }
     if (CIRCUIT_MODEL_PASSGATE == circuit_lib.model_type(circuit_model)) {
-      print_verilog_passgate_module(module_manager, fp, circuit_lib, circuit_model, default_net_type);
+      print_verilog_passgate_module(module_manager, fp, circuit_lib, circuit_model, default_net_type, include_signal_init);
       continue;
     }
     if (CIRCUIT_MODEL_GATE == circuit_lib.model_type(circuit_model)) {
-      print_verilog_gate_module(module_manager, fp, circuit_lib, circuit_model, default_net_type);
+      print_verilog_gate_module(module_manager, fp, circuit_lib, circuit_model, default_net_type, include_signal_init);
       continue;
     }
   }
@@ -21,7 +21,8 @@ void print_verilog_submodule_essentials(const ModuleManager& module_manager,
                                         NetlistManager& netlist_manager,
                                         const std::string& submodule_dir,
                                         const CircuitLibrary& circuit_lib,
-                                        const e_verilog_default_net_type& default_net_type);
+                                        const e_verilog_default_net_type& default_net_type,
+                                        const bool& include_signal_init);
 
 } /* end namespace openfpga */
 
@@ -64,7 +64,7 @@ void print_verilog_top_random_testbench_ports(std::fstream& fp,
                                              VERILOG_DEFAULT_NET_TYPE_NONE);
  
   /* Print the declaration for the module */
-  fp << "module " << circuit_name << FORMAL_RANDOM_TOP_TESTBENCH_POSTFIX << ";" << std::endl;
+  fp << "module " << circuit_name << FORMAL_RANDOM_TOP_TESTBENCH_POSTFIX << ";\n";
 
   /* Create a clock port if the benchmark does not have one! 
    * The clock is used for counting and synchronizing input stimulus 
@@ -72,11 +72,11 @@ void print_verilog_top_random_testbench_ports(std::fstream& fp,
   std::vector<BasicPort> clock_ports = generate_verilog_testbench_clock_port(clock_port_names, std::string(DEFAULT_CLOCK_NAME));
   print_verilog_comment(fp, std::string("----- Default clock port is added here since benchmark does not contain one -------"));
   for (const BasicPort& clock_port : clock_ports) {
-    fp << "\t" << generate_verilog_port(VERILOG_PORT_REG, clock_port) << ";" << std::endl;
+    fp << "\t" << generate_verilog_port(VERILOG_PORT_REG, clock_port) << ";\n";
   }
 
   /* Add an empty line as splitter */
-  fp << std::endl;
+  fp << "\n";
 
   print_verilog_testbench_shared_ports(fp, atom_ctx, netlist_annotation,
                                        clock_port_names,
@@ -89,10 +89,10 @@ void print_verilog_top_random_testbench_ports(std::fstream& fp,
    * and determine if the simulation succeed or failed 
    */
   print_verilog_comment(fp, std::string("----- Error counter -------"));
-  fp << "\tinteger " << ERROR_COUNTER << "= 0;" << std::endl;
+  fp << "\tinteger " << ERROR_COUNTER << "= 0;\n";
 
   /* Add an empty line as splitter */
-  fp << std::endl;
+  fp << "\n";
 }
 
 /********************************************************************
@@ -130,13 +130,13 @@ void print_verilog_top_random_testbench_benchmark_instance(std::fstream& fp,
   print_verilog_comment(fp, std::string("----- End reference Benchmark Instanication -------"));
 
   /* Add an empty line as splitter */
-  fp << std::endl;
+  fp << "\n";
 
   /* Condition ends for the benchmark instanciation */
   print_verilog_endif(fp);
 
   /* Add an empty line as splitter */
-  fp << std::endl;
+  fp << "\n";
 }
 
 /********************************************************************
@@ -166,7 +166,7 @@ void print_verilog_random_testbench_fpga_instance(std::fstream& fp,
   print_verilog_comment(fp, std::string("----- End FPGA Fabric Instanication -------"));
 
   /* Add an empty line as splitter */
-  fp << std::endl;
+  fp << "\n";
 }
 
 /********************************************************************
@@ -220,13 +220,13 @@ void print_verilog_random_testbench_reset_stimuli(std::fstream& fp,
       initial_value = 0;
     }
 
-    fp << "initial" << std::endl;
-    fp << "\tbegin" << std::endl;
+    fp << "initial\n";
+    fp << "\tbegin\n";
     fp << "\t";
     std::vector<size_t> initial_values(reset_port.get_width(), initial_value);
     fp << "\t";
     fp << generate_verilog_port_constant_values(reset_port, initial_values);
-    fp << ";" << std::endl;
+    fp << ";\n";
 
     /* Flip the reset at the second negative edge of the clock port
      * So the generic reset stimuli is applicable to both synchronous reset and asynchronous reset
@@ -234,15 +234,15 @@ void print_verilog_random_testbench_reset_stimuli(std::fstream& fp,
      * This gaurantees that even for synchronous reset, the reset can be sensed in the 1st rising/falling 
      * edge of the clock signal
      */
-    fp << "\t@(negedge " << generate_verilog_port(VERILOG_PORT_CONKT, clock_port) << ");" << std::endl;
-    fp << "\t@(negedge " << generate_verilog_port(VERILOG_PORT_CONKT, clock_port) << ");" << std::endl;
+    fp << "\t@(negedge " << generate_verilog_port(VERILOG_PORT_CONKT, clock_port) << ");\n";
+    fp << "\t@(negedge " << generate_verilog_port(VERILOG_PORT_CONKT, clock_port) << ");\n";
     print_verilog_wire_connection(fp, reset_port, reset_port, true);
-    fp << "\tend" << std::endl;
+    fp << "\tend\n";
   }
 
   print_verilog_comment(fp, "----- End reset signal generation -----");
 
-  fp << std::endl;
+  fp << "\n";
 }
 
 /*********************************************************************
@@ -3,6 +3,7 @@
  * (CLBs, I/Os, heterogeneous blocks etc.) 
  *******************************************************************/
 /* System header files */
+#include <set>
 #include <vector>
 #include <fstream>
 
@@ -16,7 +17,10 @@
 
 /* Headers from openfpgautil library */
 #include "openfpga_digest.h"
+#include "openfpga_buffered_file_stream.h"
 #include "openfpga_side_manager.h"
+#include "openfpga_parallel.h"
+#include "openfpga_progress.h"
 
 /* Headers from vpr library */
 #include "vpr_utils.h"
@@ -52,7 +56,7 @@ namespace openfpga {
  *
  *       Primitive block
  *     +---------------------------------------+
- *     |                                       | 
+ *     |                                       |
  *     |      +---------+    +---------+       |
  *  in |----->|         |--->|         |<------|configuration lines
  *     |      |  Logic  |... |  Memory |       |
@@ -64,20 +68,20 @@ namespace openfpga {
  * Note that the primitive may be mapped to a standard cell, we force to use 
  * explict port mapping. This aims to avoid any port sequence issues!!!
  *
+ * Return the name of the netlist written
  *******************************************************************/
 static 
-void print_verilog_primitive_block(NetlistManager& netlist_manager,
-                                   const ModuleManager& module_manager,
-                                   const std::string& subckt_dir,
-                                   t_pb_graph_node* primitive_pb_graph_node,
-                                   const FabricVerilogOption& options,
-                                   const bool& verbose) {
-  /* Ensure a valid pb_graph_node */ 
-  if (nullptr == primitive_pb_graph_node) {
-    VTR_LOGF_ERROR(__FILE__, __LINE__,
-                   "Invalid primitive_pb_graph_node!\n");
-    exit(1);
-  }
+std::string print_verilog_primitive_block(const ModuleManager& module_manager,
+                                          const std::string& subckt_dir,
+                                          t_pb_graph_node* primitive_pb_graph_node,
+                                          const FabricVerilogOption& options) {
+  /* Generate the module name for this primitive pb_graph_node*/
+  std::string primitive_module_name = generate_physical_block_module_name(primitive_pb_graph_node->pb_type);
+
+  /* Create a module of the primitive LUT and register it to module manager */
+  ModuleId primitive_module = module_manager.find_module(primitive_module_name);
+  /* Ensure that the module has been created and thus unique! */
+  VTR_ASSERT(true == module_manager.valid_module_id(primitive_module));
 
   /* Give a name to the Verilog netlist */
   /* Create the file name for Verilog */
@@ -85,30 +89,14 @@ void print_verilog_primitive_block(NetlistManager& netlist_manager,
                           + generate_logical_tile_netlist_name(std::string(), primitive_pb_graph_node, std::string(VERILOG_NETLIST_FILE_POSTFIX))
                            );
 
-  VTR_LOG("Writing Verilog netlist '%s' for primitive pb_type '%s' ...",
-          verilog_fname.c_str(), primitive_pb_graph_node->pb_type->name);
-  VTR_LOGV(verbose, "\n");
-
   /* Create the file stream */
-  std::fstream fp;
-  fp.open(verilog_fname, std::fstream::out | std::fstream::trunc);
+  BufferedFileStream netlist_file(verilog_fname, options.compression(), options.netlist_update());
+  std::fstream& fp = netlist_file.stream();
 
   check_file_stream(verilog_fname.c_str(), fp);
 
-  print_verilog_file_header(fp, std::string("Verilog modules for primitive pb_type: " + std::string(primitive_pb_graph_node->pb_type->name))); 
-
-  /* Generate the module name for this primitive pb_graph_node*/
-  std::string primitive_module_name = generate_physical_block_module_name(primitive_pb_graph_node->pb_type);
+  print_verilog_file_header(fp, std::string("Verilog modules for primitive pb_type: " + std::string(primitive_pb_graph_node->pb_type->name)), false == options.keep_unchanged_netlists()); 
 
-  /* Create a module of the primitive LUT and register it to module manager */
-  ModuleId primitive_module = module_manager.find_module(primitive_module_name);
-  /* Ensure that the module has been created and thus unique! */
-  VTR_ASSERT(true == module_manager.valid_module_id(primitive_module));
-
-  VTR_LOGV(verbose,
-          "Writing Verilog codes of logical tile primitive block '%s'...",
-           module_manager.module_name(primitive_module).c_str());
-  
   /* Write the verilog module */
   write_verilog_module_to_file(fp,
                                module_manager,
@@ -117,79 +105,29 @@ void print_verilog_primitive_block(NetlistManager& netlist_manager,
                                options.default_net_type());
 
   /* Close file handler */
-  fp.close();
-
-  /* Add fname to the netlist name list */
-  NetlistId nlist_id = netlist_manager.add_netlist(verilog_fname);
-  VTR_ASSERT(NetlistId::INVALID() != nlist_id);
-  netlist_manager.set_netlist_type(nlist_id, NetlistManager::LOGIC_BLOCK_NETLIST);
+  close_verilog_netlist_file(netlist_file);
 
-  VTR_LOGV(verbose, "Done\n");
+  return verilog_fname;
 }
 
 /********************************************************************
- * Print Verilog modules of physical blocks inside a grid (CLB, I/O. etc.)
- * This function will traverse the graph of complex logic block (t_pb_graph_node)
- * in a recursive way, using a Depth First Search (DFS) algorithm.
- * As such, primitive physical blocks (LUTs, FFs, etc.), leaf node of the pb_graph
- * will be printed out first, while the top-level will be printed out in the last
- *
- * Note: this function will print a unique Verilog module for each type of 
- * t_pb_graph_node, i.e., t_pb_type, in the graph, in order to enable highly 
- * hierarchical Verilog organization as well as simplify the Verilog file sizes.
- *
- * Note: DFS is the right way. Do NOT use BFS.
- * DFS can guarantee that all the sub-modules can be registered properly
- * to its parent in module manager  
+ * Print Verilog modules of a non-primitive node in the pb_graph_node graph
+ * Return the name of the netlist written
  *******************************************************************/
 static 
-void rec_print_verilog_logical_tile(NetlistManager& netlist_manager,
-                                    const ModuleManager& module_manager,
-                                    const VprDeviceAnnotation& device_annotation,
-                                    const std::string& subckt_dir,
-                                    t_pb_graph_node* physical_pb_graph_node,
-                                    const FabricVerilogOption& options,
-                                    const bool& verbose) {
-
-  /* Check cur_pb_graph_node*/
-  if (nullptr == physical_pb_graph_node) {
-    VTR_LOGF_ERROR(__FILE__, __LINE__,
-                   "Invalid physical_pb_graph_node\n"); 
-    exit(1);
-  }
-
+std::string print_verilog_physical_pb_block(const ModuleManager& module_manager,
+                                            const std::string& subckt_dir,
+                                            t_pb_graph_node* physical_pb_graph_node,
+                                            const FabricVerilogOption& options) {
   /* Get the pb_type definition related to the node */
   t_pb_type* physical_pb_type = physical_pb_graph_node->pb_type; 
 
-  /* Find the mode that physical implementation of a pb_type */
-  t_mode* physical_mode = device_annotation.physical_mode(physical_pb_type);
-
-  /* For non-leaf node in the pb_type graph: 
-   * Recursively Depth-First Generate all the child pb_type at the level 
-   */
-  if (false == is_primitive_pb_type(physical_pb_type)) { 
-    for (int ipb = 0; ipb < physical_mode->num_pb_type_children; ++ipb) {
-      /* Go recursive to visit the children */
-      rec_print_verilog_logical_tile(netlist_manager,
-                                     module_manager, device_annotation,
-                                     subckt_dir, 
-                                     &(physical_pb_graph_node->child_pb_graph_nodes[physical_mode->index][ipb][0]),
-                                     options,
-                                     verbose);
-    }
-  }
+  /* Generate the name of the Verilog module for this pb_type */
+  std::string pb_module_name = generate_physical_block_module_name(physical_pb_type);
 
-  /* For leaf node, a primitive Verilog module will be generated. */
-  if (true == is_primitive_pb_type(physical_pb_type)) { 
-    print_verilog_primitive_block(netlist_manager,
-                                  module_manager,
-                                  subckt_dir,
-                                  physical_pb_graph_node, 
-                                  options, 
-                                  verbose);
-    /* Finish for primitive node, return */
-    return;
-  }
+  /* Register the Verilog module in module manager */
+  ModuleId pb_module = module_manager.find_module(pb_module_name);
+  VTR_ASSERT(true == module_manager.valid_module_id(pb_module));
 
   /* Give a name to the Verilog netlist */
   /* Create the file name for Verilog */
@@ -197,28 +135,13 @@ void rec_print_verilog_logical_tile(NetlistManager& netlist_manager,
                           + generate_logical_tile_netlist_name(std::string(), physical_pb_graph_node, std::string(VERILOG_NETLIST_FILE_POSTFIX))
                            );
 
-  VTR_LOG("Writing Verilog netlist '%s' for pb_type '%s' ...",
-          verilog_fname.c_str(), physical_pb_type->name);
-  VTR_LOGV(verbose, "\n");
-
   /* Create the file stream */
-  std::fstream fp;
-  fp.open(verilog_fname, std::fstream::out | std::fstream::trunc);
+  BufferedFileStream netlist_file(verilog_fname, options.compression(), options.netlist_update());
+  std::fstream& fp = netlist_file.stream();
 
   check_file_stream(verilog_fname.c_str(), fp);
 
-  print_verilog_file_header(fp, std::string("Verilog modules for pb_type: " + std::string(physical_pb_type->name))); 
-
-  /* Generate the name of the Verilog module for this pb_type */
-  std::string pb_module_name = generate_physical_block_module_name(physical_pb_type);
-
-  /* Register the Verilog module in module manager */
-  ModuleId pb_module = module_manager.find_module(pb_module_name);
-  VTR_ASSERT(true == module_manager.valid_module_id(pb_module));
-
-  VTR_LOGV(verbose,
-          "Writing Verilog codes of pb_type '%s'...",
-           module_manager.module_name(pb_module).c_str());
+  print_verilog_file_header(fp, std::string("Verilog modules for pb_type: " + std::string(physical_pb_type->name)), false == options.keep_unchanged_netlists()); 
 
   /* Comment lines */
   print_verilog_comment(fp, std::string("----- BEGIN Physical programmable logic block Verilog module: " + std::string(physical_pb_type->name) + " -----"));
@@ -233,50 +156,77 @@ void rec_print_verilog_logical_tile(NetlistManager& netlist_manager,
   print_verilog_comment(fp, std::string("----- END Physical programmable logic block Verilog module: " + std::string(physical_pb_type->name) + " -----"));
 
   /* Close file handler */
-  fp.close();
+  close_verilog_netlist_file(netlist_file);
 
-  /* Add fname to the netlist name list */
-  NetlistId nlist_id = netlist_manager.add_netlist(verilog_fname);
-  VTR_ASSERT(NetlistId::INVALID() != nlist_id);
-  netlist_manager.set_netlist_type(nlist_id, NetlistManager::LOGIC_BLOCK_NETLIST);
-
-  VTR_LOGV(verbose, "Done\n");
+  return verilog_fname;
 }
 
-/*****************************************************************************
- * This function will create a Verilog file and print out a Verilog netlist 
- * for the logical tile (pb_graph/pb_type) 
- *****************************************************************************/
+/********************************************************************
+ * Collect the nodes of the graph of complex logic block (t_pb_graph_node)
+ * whose Verilog modules are to be written, in a recursive way, 
+ * using a Depth First Search (DFS) algorithm.
+ * As such, primitive physical blocks (LUTs, FFs, etc.), leaf node of the pb_graph
+ * will be listed first, while the top-level will be listed in the last
+ *
+ * Note: this function will list a unique Verilog module for each type of 
+ * t_pb_graph_node, i.e., t_pb_type, in the graph, in order to enable highly 
+ * hierarchical Verilog organization as well as simplify the Verilog file sizes.
+ * Modules which have been visited, e.g., through another logical tile,
+ * and modules which are merged into an identical module, which is written on its own,
+ * are not listed
+ *
+ * Note: DFS is the right way. Do NOT use BFS.
+ * DFS can guarantee that all the sub-modules can be registered properly
+ * to its parent in module manager  
+ *******************************************************************/
 static 
-void print_verilog_logical_tile_netlist(NetlistManager& netlist_manager,
-                                        const ModuleManager& module_manager,
-                                        const VprDeviceAnnotation& device_annotation,
-                                        const std::string& subckt_dir,
-                                        t_pb_graph_node* pb_graph_head,
-                                        const FabricVerilogOption& options,
-                                        const bool& verbose) {
-
-  VTR_LOG("Writing Verilog netlists for logic tile '%s' ...",
-          pb_graph_head->pb_type->name);
-  VTR_LOG("\n");
+void rec_find_verilog_logical_tile_nodes(const ModuleManager& module_manager,
+                                         const VprDeviceAnnotation& device_annotation,
+                                         t_pb_graph_node* physical_pb_graph_node,
+                                         std::vector<t_pb_graph_node*>& pb_graph_nodes,
+                                         std::set<ModuleId>& visited_modules) {
 
-  /* Print Verilog modules for all the pb_types/pb_graph_nodes
-   * use a Depth-First Search Algorithm to print the sub-modules 
-   * Note: DFS is the right way. Do NOT use BFS.
-   * DFS can guarantee that all the sub-modules can be registered properly
-   * to its parent in module manager  
+  /* Check cur_pb_graph_node*/
+  if (nullptr == physical_pb_graph_node) {
+    VTR_LOGF_ERROR(__FILE__, __LINE__,
+                   "Invalid physical_pb_graph_node\n"); 
+    exit(1);
+  }
+
+  /* Get the pb_type definition related to the node */
+  t_pb_type* physical_pb_type = physical_pb_graph_node->pb_type; 
+
+  /* For non-leaf node in the pb_type graph: 
+   * Recursively Depth-First visit all the child pb_type at the level 
    */
-  /* Print Verilog modules starting from the top-level pb_type/pb_graph_node, and traverse the graph in a recursive way */
-  rec_print_verilog_logical_tile(netlist_manager,
-                                 module_manager,
-                                 device_annotation, 
-                                 subckt_dir,
-                                 pb_graph_head,
-                                 options,
-                                 verbose);
+  if (false == is_primitive_pb_type(physical_pb_type)) { 
+    /* Find the mode that physical implementation of a pb_type */
+    t_mode* physical_mode = device_annotation.physical_mode(physical_pb_type);
+    for (int ipb = 0; ipb < physical_mode->num_pb_type_children; ++ipb) {
+      /* Go recursive to visit the children */
+      rec_find_verilog_logical_tile_nodes(module_manager, device_annotation,
+                                          &(physical_pb_graph_node->child_pb_graph_nodes[physical_mode->index][ipb][0]),
+                                          pb_graph_nodes,
+                                          visited_modules);
+    }
+  }
 
-  VTR_LOG("Done\n");
-  VTR_LOG("\n");
+  /* Generate the name of the Verilog module for this pb_type */
+  std::string pb_module_name = generate_physical_block_module_name(physical_pb_type);
+  ModuleId pb_module = module_manager.find_module(pb_module_name);
+  VTR_ASSERT(true == module_manager.valid_module_id(pb_module));
+
+  /* Bypass the module which is merged into an identical module, which is written on its own */
+  if (pb_module_name != module_manager.module_name(pb_module)) {
+    return;
+  }
+
+  /* Bypass the module which has been visited */
+  if (false == visited_modules.insert(pb_module).second) {
+    return;
+  }
+
+  pb_graph_nodes.push_back(physical_pb_graph_node);
 }
 
 /*****************************************************************************
@@ -288,8 +238,7 @@ void print_verilog_logical_tile_netlist(NetlistManager& netlist_manager,
  * the I/O block locates at.
  *****************************************************************************/
 static 
-void print_verilog_physical_tile_netlist(NetlistManager& netlist_manager,
-                                         const ModuleManager& module_manager,
+std::string print_verilog_physical_tile_netlist(const ModuleManager& module_manager,
                                          const std::string& subckt_dir,
                                          t_physical_tile_type_ptr phy_block_type,
                                          const e_side& border_side,
@@ -303,24 +252,13 @@ void print_verilog_physical_tile_netlist(NetlistManager& netlist_manager,
                                                              std::string(VERILOG_NETLIST_FILE_POSTFIX))
                            );
 
-  /* Echo status */
-  if (true == is_io_type(phy_block_type)) {
-    SideManager side_manager(border_side);
-    VTR_LOG("Writing Verilog Netlist '%s' for physical tile '%s' at %s side ...",
-            verilog_fname.c_str(), phy_block_type->name, 
-            side_manager.c_str());
-  } else { 
-    VTR_LOG("Writing Verilog Netlist '%s' for physical_tile '%s'...",
-            verilog_fname.c_str(), phy_block_type->name);
-  }
-
   /* Create the file stream */
-  std::fstream fp;
-  fp.open(verilog_fname, std::fstream::out | std::fstream::trunc);
+  BufferedFileStream netlist_file(verilog_fname, options.compression(), options.netlist_update());
+  std::fstream& fp = netlist_file.stream();
 
   check_file_stream(verilog_fname.c_str(), fp);
 
-  print_verilog_file_header(fp, std::string("Verilog modules for physical tile: " + std::string(phy_block_type->name) + "]")); 
+  print_verilog_file_header(fp, std::string("Verilog modules for physical tile: " + std::string(phy_block_type->name) + "]"), false == options.keep_unchanged_netlists()); 
 
   /* Create a Verilog Module for the top-level physical block, and add to module manager */
   std::string grid_module_name = generate_grid_block_module_name(std::string(GRID_VERILOG_FILE_NAME_PREFIX), std::string(phy_block_type->name), is_io_type(phy_block_type), border_side);
@@ -338,17 +276,12 @@ void print_verilog_physical_tile_netlist(NetlistManager& netlist_manager,
   print_verilog_comment(fp, std::string("----- END Grid Verilog module: " + module_manager.module_name(grid_module) + " -----"));
 
   /* Add an empty line as a splitter */
-  fp << std::endl;
+  fp << "\n";
 
   /* Close file handler */
-  fp.close();
+  close_verilog_netlist_file(netlist_file);
 
-  /* Add fname to the netlist name list */
-  NetlistId nlist_id = netlist_manager.add_netlist(verilog_fname);
-  VTR_ASSERT(NetlistId::INVALID() != nlist_id);
-  netlist_manager.set_netlist_type(nlist_id, NetlistManager::LOGIC_BLOCK_NETLIST);
-
-  VTR_LOG("Done\n");
+  return verilog_fname;
 }
 
 /*****************************************************************************
@@ -376,18 +309,50 @@ void print_verilog_grids(NetlistManager& netlist_manager,
    */
   VTR_LOG("Writing logical tiles...");
   VTR_LOGV(verbose, "\n");
+  std::vector<t_pb_graph_node*> pb_graph_nodes;
+  std::set<ModuleId> visited_modules;
   for (const t_logical_block_type& logical_tile : device_ctx.logical_block_types) {
     /* Bypass empty pb_graph */
     if (nullptr == logical_tile.pb_graph_head) {
       continue;
     }
-    print_verilog_logical_tile_netlist(netlist_manager,
-                                       module_manager,
-                                       device_annotation,
-                                       subckt_dir,
-                                       logical_tile.pb_graph_head,
-                                       options,
-                                       verbose);
+    rec_find_verilog_logical_tile_nodes(module_manager,
+                                        device_annotation,
+                                        logical_tile.pb_graph_head,
+                                        pb_graph_nodes,
+                                        visited_modules);
+  }
+
+  /* Logical tile netlists are independent files, which can be written on multiple threads
+   * Netlists are registered in the order of DFS, whatever number of threads is used
+   */
+  ProgressReporter lb_progress("Writing logical tiles", pb_graph_nodes.size());
+  std::vector<std::string> lb_verilog_fnames(pb_graph_nodes.size());
+  parallel_for(pb_graph_nodes.size(), options.num_threads(),
+               [&](const size_t& inode) {
+                 if (true == is_primitive_pb_type(pb_graph_nodes[inode]->pb_type)) {
+                   lb_verilog_fnames[inode] = print_verilog_primitive_block(module_manager,
+                                                                            subckt_dir,
+                                                                            pb_graph_nodes[inode],
+                                                                            options);
+                 } else {
+                   lb_verilog_fnames[inode] = print_verilog_physical_pb_block(module_manager,
+                                                                              subckt_dir,
+                                                                              pb_graph_nodes[inode],
+                                                                              options);
+                 }
+                 lb_progress.advance();
+               });
+
+  for (size_t inode = 0; inode < pb_graph_nodes.size(); ++inode) {
+    VTR_LOGV(verbose,
+             "Written Verilog netlist '%s' for pb_type '%s'\n",
+             lb_verilog_fnames[inode].c_str(), pb_graph_nodes[inode]->pb_type->name);
+
+    /* Add fname to the netlist name list */
+    NetlistId nlist_id = netlist_manager.add_netlist(lb_verilog_fnames[inode]);
+    VTR_ASSERT(NetlistId::INVALID() != nlist_id);
+    netlist_manager.set_netlist_type(nlist_id, NetlistManager::LOGIC_BLOCK_NETLIST);
   }
   VTR_LOG("Writing logical tiles...");
   VTR_LOG("Done\n");
@@ -399,6 +364,8 @@ void print_verilog_grids(NetlistManager& netlist_manager,
    */
   VTR_LOG("Building physical tiles...");
   VTR_LOGV(verbose, "\n");
+  std::vector<t_physical_tile_type_ptr> physical_tiles;
+  std::vector<e_side> border_sides;
   for (const t_physical_tile_type& physical_tile : device_ctx.physical_tile_types) {
     /* Bypass empty type or nullptr */
     if (true == is_empty_type(&physical_tile)) {
@@ -415,24 +382,47 @@ void print_verilog_grids(NetlistManager& netlist_manager,
       std::set<e_side> io_type_sides = find_physical_io_tile_located_sides(device_ctx.grid,
                                                                            &physical_tile);
       for (const e_side& io_type_side : io_type_sides) {
-        print_verilog_physical_tile_netlist(netlist_manager,
-                                            module_manager,
-                                            subckt_dir, 
-                                            &physical_tile,
-                                            io_type_side,
-                                            options);
+        physical_tiles.push_back(&physical_tile);
+        border_sides.push_back(io_type_side);
       } 
       continue;
     } else {
       /* For CLB and heterogenenous blocks */
-      print_verilog_physical_tile_netlist(netlist_manager,
-                                          module_manager,
-                                          subckt_dir, 
-                                          &physical_tile,
-                                          NUM_SIDES,
-                                          options);
+      physical_tiles.push_back(&physical_tile);
+      border_sides.push_back(NUM_SIDES);
     }
   }
+
+  /* Physical tile netlists are independent files, which can be written on multiple threads */
+  ProgressReporter progress("Writing physical tiles", physical_tiles.size());
+  std::vector<std::string> verilog_fnames(physical_tiles.size());
+  parallel_for(physical_tiles.size(), options.num_threads(),
+               [&](const size_t& itile) {
+                 verilog_fnames[itile] = print_verilog_physical_tile_netlist(module_manager,
+                                                                             subckt_dir, 
+                                                                             physical_tiles[itile],
+                                                                             border_sides[itile],
+                                                                             options);
+                 progress.advance();
+               });
+
+  for (size_t itile = 0; itile < physical_tiles.size(); ++itile) {
+    /* Echo status */
+    if (true == is_io_type(physical_tiles[itile])) {
+      SideManager side_manager(border_sides[itile]);
+      VTR_LOG("Written Verilog Netlist '%s' for physical tile '%s' at %s side\n",
+              verilog_fnames[itile].c_str(), physical_tiles[itile]->name, 
+              side_manager.c_str());
+    } else { 
+      VTR_LOG("Written Verilog Netlist '%s' for physical_tile '%s'\n",
+              verilog_fnames[itile].c_str(), physical_tiles[itile]->name);
+    }
+
+    /* Add fname to the netlist name list, here on the calling thread in the order of the tiles */
+    NetlistId nlist_id = netlist_manager.add_netlist(verilog_fnames[itile]);
+    VTR_ASSERT(NetlistId::INVALID() != nlist_id);
+    netlist_manager.set_netlist_type(nlist_id, NetlistManager::LOGIC_BLOCK_NETLIST);
+  }
   VTR_LOG("Building physical tiles...");
   VTR_LOG("Done\n");
   VTR_LOG("\n");
@@ -63,7 +63,7 @@ void print_verilog_mux_memory_module(const ModuleManager& module_manager,
                                  options.default_net_type());
 
     /* Add an empty line as a splitter */
-    fp << std::endl;
+    fp << "\n";
     break;
   }
   case CIRCUIT_MODEL_DESIGN_RRAM:
@@ -184,7 +184,7 @@ void print_verilog_submodule_memories(const ModuleManager& module_manager,
                                  options.default_net_type());
 
     /* Add an empty line as a splitter */
-    fp << std::endl;
+    fp << "\n";
   }
 
   /* Close the file stream */
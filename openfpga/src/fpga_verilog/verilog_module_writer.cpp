@@ -8,6 +8,7 @@
  * Please use const keyword to restrict this!
  *******************************************************************/
 #include <algorithm>
+#include <unordered_map>
 
 /* Headers from vtrutil library */
 #include "vtr_assert.h"
@@ -19,6 +20,7 @@
 #include "openfpga_naming.h"
 
 #include "module_manager_utils.h"
+#include "verilog_constants.h"
 #include "verilog_port_types.h"
 #include "verilog_writer_utils.h"
 #include "verilog_module_writer.h"
@@ -66,14 +68,15 @@ BasicPort generate_verilog_port_for_module_net(const ModuleManager& module_manag
                                                const ModuleId& module_id,
                                                const ModuleNetId& module_net) {
   BasicPort port_to_return;
+
   /* Check all the sink modules of the net, 
    * if we have a source module is the current module, this is not local wire 
    */
   for (ModuleNetSrcId src_id : module_manager.module_net_sources(module_id, module_net)) {
-    if (module_id == module_manager.net_source_modules(module_id, module_net)[src_id]) {
+    if (module_id == module_manager.net_source_module(module_id, module_net, src_id)) {
       /* Here, this is not a local wire, return the port name of the src_port */
-      ModulePortId net_src_port = module_manager.net_source_ports(module_id, module_net)[src_id];
-      size_t src_pin_index = module_manager.net_source_pins(module_id, module_net)[src_id];
+      ModulePortId net_src_port = module_manager.net_source_port(module_id, module_net, src_id);
+      size_t src_pin_index = module_manager.net_source_pin(module_id, module_net, src_id);
       port_to_return.set(module_manager.module_port(module_id, net_src_port));
       port_to_return.set_width(src_pin_index, src_pin_index);
       port_to_return.set_origin_port_width(module_manager.module_port(module_id, net_src_port).get_width());
@@ -83,10 +86,10 @@ BasicPort generate_verilog_port_for_module_net(const ModuleManager& module_manag
 
   /* Check all the sink modules of the net */
   for (ModuleNetSinkId sink_id : module_manager.module_net_sinks(module_id, module_net)) {
-    if (module_id == module_manager.net_sink_modules(module_id, module_net)[sink_id]) {
+    if (module_id == module_manager.net_sink_module(module_id, module_net, sink_id)) {
       /* Here, this is not a local wire, return the port name of the sink_port */
-      ModulePortId net_sink_port = module_manager.net_sink_ports(module_id, module_net)[sink_id];
-      size_t sink_pin_index = module_manager.net_sink_pins(module_id, module_net)[sink_id];
+      ModulePortId net_sink_port = module_manager.net_sink_port(module_id, module_net, sink_id);
+      size_t sink_pin_index = module_manager.net_sink_pin(module_id, module_net, sink_id);
       port_to_return.set(module_manager.module_port(module_id, net_sink_port));
       port_to_return.set_width(sink_pin_index, sink_pin_index);
       port_to_return.set_origin_port_width(module_manager.module_port(module_id, net_sink_port).get_width());
@@ -98,25 +101,17 @@ BasicPort generate_verilog_port_for_module_net(const ModuleManager& module_manag
   std::string net_name;
 
   /* Each net must only one 1 source */ 
-  VTR_ASSERT(1 == module_manager.net_source_modules(module_id, module_net).size());
+  VTR_ASSERT(1 == module_manager.num_net_sources(module_id, module_net));
 
   /* Get the source module */
-  ModuleId net_src_module = module_manager.net_source_modules(module_id, module_net)[ModuleNetSrcId(0)];
-  /* Get the instance id */
-  size_t net_src_instance = module_manager.net_source_instances(module_id, module_net)[ModuleNetSrcId(0)]; 
+  ModuleId net_src_module = module_manager.net_source_module(module_id, module_net, ModuleNetSrcId(0));
   /* Get the port id */
-  ModulePortId net_src_port = module_manager.net_source_ports(module_id, module_net)[ModuleNetSrcId(0)]; 
+  ModulePortId net_src_port = module_manager.net_source_port(module_id, module_net, ModuleNetSrcId(0)); 
   /* Get the pin id */
-  size_t net_src_pin = module_manager.net_source_pins(module_id, module_net)[ModuleNetSrcId(0)]; 
+  size_t net_src_pin = module_manager.net_source_pin(module_id, module_net, ModuleNetSrcId(0)); 
 
-  /* Load user-defined name if we have it */
-  if (false == module_manager.net_name(module_id, module_net).empty()) {
-    net_name = module_manager.net_name(module_id, module_net);
-  } else {
-    net_name  = module_manager.module_name(net_src_module); 
-    net_name += std::string("_") + std::to_string(net_src_instance) + std::string("_");
-    net_name += module_manager.module_port(net_src_module, net_src_port).get_name();
-  }
+  /* Load user-defined name if we have it, otherwise the name is built from the source */
+  net_name = module_manager.net_wire_name(module_id, module_net);
 
   port_to_return.set_name(net_name);
   port_to_return.set_width(net_src_pin, net_src_pin);
@@ -124,11 +119,69 @@ BasicPort generate_verilog_port_for_module_net(const ModuleManager& module_manag
   return port_to_return;
 }
 
+/********************************************************************
+ * Find the pins of the child module instances which are connected to any net
+ * of a module, in a bitmap for each instance: [child_index][instance][pin]
+ * The pins of a child module are numbered by the sequence of its ports,
+ * whose first pins are given in the port offsets: [child_index][port]
+ * The bitmaps are built by visiting the terminals of each net once,
+ * rather than looking up the net of each pin
+ *******************************************************************/
+static 
+std::vector<std::vector<std::vector<bool>>> find_verilog_module_connected_child_pins(const ModuleManager& module_manager,
+                                                                                    const ModuleId& module_id,
+                                                                                    std::vector<std::vector<size_t>>& child_port_offsets) {
+  const vtr::small_vector<ModuleId>& children = module_manager.child_modules(module_id);
+
+  std::unordered_map<ModuleId, size_t> child_indices;
+  std::vector<std::vector<std::vector<bool>>> connected_pins(children.size());
+  child_port_offsets.assign(children.size(), std::vector<size_t>());
+  for (size_t ichild = 0; ichild < children.size(); ++ichild) {
+    const ModuleId& child = children[ichild];
+    child_indices[child] = ichild;
+    size_t num_pins = 0;
+    for (const ModulePortId& child_port_id : module_manager.module_ports(child)) {
+      VTR_ASSERT(size_t(child_port_id) == child_port_offsets[ichild].size());
+      child_port_offsets[ichild].push_back(num_pins);
+      num_pins += module_manager.module_port(child, child_port_id).get_width();
+    }
+    connected_pins[ichild].assign(module_manager.num_instance(module_id, child), std::vector<bool>(num_pins, false));
+  }
+
+  for (const ModuleNetId& module_net : module_manager.module_nets(module_id)) {
+    for (const ModuleNetSrcId& net_src : module_manager.module_net_sources(module_id, module_net)) {
+      ModuleId src_module = module_manager.net_source_module(module_id, module_net, net_src);
+      if (module_id == src_module) {
+        continue;
+      }
+      size_t ichild = child_indices.at(src_module);
+      size_t pin = child_port_offsets[ichild][size_t(module_manager.net_source_port(module_id, module_net, net_src))]
+                 + module_manager.net_source_pin(module_id, module_net, net_src);
+      connected_pins[ichild][module_manager.net_source_instance(module_id, module_net, net_src)][pin] = true;
+    }
+    for (const ModuleNetSinkId& net_sink : module_manager.module_net_sinks(module_id, module_net)) {
+      ModuleId sink_module = module_manager.net_sink_module(module_id, module_net, net_sink);
+      if (module_id == sink_module) {
+        continue;
+      }
+      size_t ichild = child_indices.at(sink_module);
+      size_t pin = child_port_offsets[ichild][size_t(module_manager.net_sink_port(module_id, module_net, net_sink))]
+                 + module_manager.net_sink_pin(module_id, module_net, net_sink);
+      connected_pins[ichild][module_manager.net_sink_instance(module_id, module_net, net_sink)][pin] = true;
+    }
+  }
+
+  return connected_pins;
+}
+
 /********************************************************************
  * Find all the nets that are going to be local wires
  * And organize it in a vector of ports
  * Verilog wire writter function will use the output of this function
  * to write up local wire declaration in Verilog format
+ *
+ * All the local wires sharing a name are merged into one port,
+ * spanning from the minimum LSB to the maximum MSB
  *******************************************************************/
 static 
 std::map<std::string, std::vector<BasicPort>> find_verilog_module_local_wires(const ModuleManager& module_manager,
@@ -143,8 +196,8 @@ std::map<std::string, std::vector<BasicPort>> find_verilog_module_local_wires(co
      * But I do want the module graph create is nice and clean !!! 
      */
     /*
-    if ( (0 == module_manager.net_source_modules(module_id, module_net).size()) 
-      && (0 == module_manager.net_source_modules(module_id, module_net).size()) ) {
+    if ( (0 == module_manager.num_net_sources(module_id, module_net)) 
+      && (0 == module_manager.num_net_sinks(module_id, module_net)) ) {
       continue;
     }
     */
@@ -155,55 +208,52 @@ std::map<std::string, std::vector<BasicPort>> find_verilog_module_local_wires(co
     }
     /* Find the name for this local wire */
     BasicPort local_wire_candidate = generate_verilog_port_for_module_net(module_manager, module_id, module_net);
-    /* Cache the net name, try to find it in the cache.
-     * If you can find one, it means this port may be mergeable, try to do merging. If merge fail, add to the local wire list
-     * If you cannot find one, it means that this port is not mergeable, add to the local wire list immediately.
+    /* Add the port if no local wire has the name yet.
+     * Otherwise, the port can always be merged to the local wire, which has the same name
      */
-    std::map<std::string, std::vector<BasicPort>>::iterator it = local_wires.find(local_wire_candidate.get_name());
-    bool merged = false;
-    if (it != local_wires.end()) {
-      /* Try to merge to one the port in the list that can absorb the current local wire */
-      for (BasicPort& local_wire : local_wires[local_wire_candidate.get_name()]) {
-        /* check if the candidate can be combined to an existing local wire */
-        if (true == two_verilog_ports_mergeable(local_wire, local_wire_candidate)) {
-          /* Merge the ports */
-          local_wire = merge_two_verilog_ports(local_wire, local_wire_candidate);
-          merged = true;
-          break;
-        } 
-      }
-    }
-
-    /* If not merged/not found in the cache, push the port to the list */
-    if (false == merged) {
-      local_wires[local_wire_candidate.get_name()].push_back(local_wire_candidate);
+    auto result = local_wires.emplace(local_wire_candidate.get_name(), std::vector<BasicPort>(1, local_wire_candidate));
+    if (false == result.second) {
+      BasicPort& local_wire = result.first->second.front();
+      local_wire = merge_two_verilog_ports(local_wire, local_wire_candidate);
     }
   }
 
   /* Local wires could also happen for undriven ports of child module */
-  for (const ModuleId& child : module_manager.child_modules(module_id)) {
-    for (size_t instance : module_manager.child_module_instances(module_id, child)) {
+  std::vector<std::vector<size_t>> child_port_offsets;
+  std::vector<std::vector<std::vector<bool>>> connected_pins = find_verilog_module_connected_child_pins(module_manager, module_id, child_port_offsets);
+
+  const vtr::small_vector<ModuleId>& children = module_manager.child_modules(module_id);
+  for (size_t ichild = 0; ichild < children.size(); ++ichild) {
+    const ModuleId& child = children[ichild];
+    for (size_t instance = 0; instance < connected_pins[ichild].size(); ++instance) {
+      const std::vector<bool>& instance_connected_pins = connected_pins[ichild][instance];
       for (const ModulePortId& child_port_id : module_manager.module_ports(child)) {
         BasicPort child_port = module_manager.module_port(child, child_port_id);
-        std::vector<size_t> undriven_pins;
+        size_t port_offset = child_port_offsets[ichild][size_t(child_port_id)];
+        /* Find the range of undriven pins */
+        bool port_undriven = false;
+        size_t undriven_lsb = 0;
+        size_t undriven_msb = 0;
         for (size_t child_pin : child_port.pins()) {
-          /* Find the net linked to the pin */
-          ModuleNetId net = module_manager.module_instance_port_net(module_id, child, instance, 
-                                                                    child_port_id, child_pin);
           /* We only care undriven ports */
-          if (ModuleNetId::INVALID() == net) {
-            undriven_pins.push_back(child_pin);
+          if (true == instance_connected_pins[port_offset + child_pin]) {
+            continue;
+          }
+          if (false == port_undriven) {
+            undriven_lsb = child_pin;
           }
+          undriven_lsb = std::min(undriven_lsb, child_pin);
+          undriven_msb = std::max(undriven_msb, child_pin);
+          port_undriven = true;
         }
-        if (true == undriven_pins.empty()) {
+        if (false == port_undriven) {
           continue;
         }
         /* Reach here, we need a local wire, we will create a port only for the undriven pins of the port! */
         BasicPort instance_port;
         instance_port.set_name(generate_verilog_undriven_local_wire_name(module_manager, module_id, child, instance, child_port_id));
         /* We give the same port name as child module, this case happens to global ports */
-        instance_port.set_width(*std::min_element(undriven_pins.begin(), undriven_pins.end()),
-                                *std::max_element(undriven_pins.begin(), undriven_pins.end())); 
+        instance_port.set_width(undriven_lsb, undriven_msb); 
 
         local_wires[instance_port.get_name()].push_back(instance_port);
       }
@@ -214,34 +264,30 @@ std::map<std::string, std::vector<BasicPort>> find_verilog_module_local_wires(co
 }
 
 /********************************************************************
- * Print a Verilog wire connection 
+ * Collect the wire connections of an output short connection 
  * We search all the sinks of the net, 
  * if we find a module output, we try to find the next module output 
  * among the sinks of the net
- * For each module output (except the first one), we print a wire connection 
+ * For each module output (except the first one), we need a wire connection 
  *******************************************************************/
 static 
-void print_verilog_module_output_short_connection(std::fstream& fp, 
-                                                  const ModuleManager& module_manager,
-                                                  const ModuleId& module_id,
-                                                  const ModuleNetId& module_net) {
-  /* Ensure a valid file stream */
-  VTR_ASSERT(true == valid_file_stream(fp));
-
+void collect_verilog_module_output_short_connection(std::vector<BasicPort>& output_pins,
+                                                    std::vector<BasicPort>& input_pins,
+                                                    const ModuleManager& module_manager,
+                                                    const ModuleId& module_id,
+                                                    const ModuleNetId& module_net) {
   bool first_port = true;
   BasicPort src_port;
 
   /* We have found a module input, now check all the sink modules of the net */
   for (ModuleNetSinkId net_sink : module_manager.module_net_sinks(module_id, module_net)) {
-    ModuleId sink_module = module_manager.net_sink_modules(module_id, module_net)[net_sink];
-    if (module_id != sink_module) {
+    if (module_id != module_manager.net_sink_module(module_id, module_net, net_sink)) {
       continue;
     }
 
     /* Find the sink port and pin information */
-    ModulePortId sink_port_id = module_manager.net_sink_ports(module_id, module_net)[net_sink];
-    size_t sink_pin = module_manager.net_sink_pins(module_id, module_net)[net_sink];
-    BasicPort sink_port(module_manager.module_port(module_id, sink_port_id).get_name(), sink_pin, sink_pin);
+    size_t sink_pin = module_manager.net_sink_pin(module_id, module_net, net_sink);
+    BasicPort sink_port(module_manager.module_port(module_id, module_manager.net_sink_port(module_id, module_net, net_sink)).get_name(), sink_pin, sink_pin);
 
     /* For the first module output, this is the source port, we do nothing and go to the next */
     if (true == first_port) {
@@ -251,53 +297,47 @@ void print_verilog_module_output_short_connection(std::fstream& fp,
       continue;
     }
 
-    /* We need to print a wire connection here */
-    print_verilog_wire_connection(fp, sink_port, src_port, false);
+    /* We need a wire connection here */
+    output_pins.push_back(sink_port);
+    input_pins.push_back(src_port);
   }
 }
 
 
 /********************************************************************
- * Print a Verilog wire connection 
+ * Collect the wire connections of a local short connection 
  * We search all the sources of the net, 
  * if we find a module input, we try to find a module output 
  * among the sinks of the net
- * If we find such a pair, we print a wire connection 
+ * For each such a pair, we need a wire connection 
  *******************************************************************/
 static 
-void print_verilog_module_local_short_connection(std::fstream& fp, 
-                                                 const ModuleManager& module_manager,
-                                                 const ModuleId& module_id,
-                                                 const ModuleNetId& module_net) {
-  /* Ensure a valid file stream */
-  VTR_ASSERT(true == valid_file_stream(fp));
-
+void collect_verilog_module_local_short_connection(std::vector<BasicPort>& output_pins,
+                                                   std::vector<BasicPort>& input_pins,
+                                                   const ModuleManager& module_manager,
+                                                   const ModuleId& module_id,
+                                                   const ModuleNetId& module_net) {
   for (ModuleNetSrcId net_src : module_manager.module_net_sources(module_id, module_net)) {
-    ModuleId src_module = module_manager.net_source_modules(module_id, module_net)[net_src];
-    if (module_id != src_module) {
+    if (module_id != module_manager.net_source_module(module_id, module_net, net_src)) {
       continue;
     }
     /* Find the source port and pin information */
-    print_verilog_comment(fp, std::string("----- Net source id " + std::to_string(size_t(net_src)) + " -----"));
-    ModulePortId src_port_id = module_manager.net_source_ports(module_id, module_net)[net_src];
-    size_t src_pin = module_manager.net_source_pins(module_id, module_net)[net_src];
-    BasicPort src_port(module_manager.module_port(module_id, src_port_id).get_name(), src_pin, src_pin);
+    size_t src_pin = module_manager.net_source_pin(module_id, module_net, net_src);
+    BasicPort src_port(module_manager.module_port(module_id, module_manager.net_source_port(module_id, module_net, net_src)).get_name(), src_pin, src_pin);
 
     /* We have found a module input, now check all the sink modules of the net */
     for (ModuleNetSinkId net_sink : module_manager.module_net_sinks(module_id, module_net)) {
-      ModuleId sink_module = module_manager.net_sink_modules(module_id, module_net)[net_sink];
-      if (module_id != sink_module) {
+      if (module_id != module_manager.net_sink_module(module_id, module_net, net_sink)) {
         continue;
       }
 
       /* Find the sink port and pin information */
-      print_verilog_comment(fp, std::string("----- Net sink id " + std::to_string(size_t(net_sink)) + " -----"));
-      ModulePortId sink_port_id = module_manager.net_sink_ports(module_id, module_net)[net_sink];
-      size_t sink_pin = module_manager.net_sink_pins(module_id, module_net)[net_sink];
-      BasicPort sink_port(module_manager.module_port(module_id, sink_port_id).get_name(), sink_pin, sink_pin);
+      size_t sink_pin = module_manager.net_sink_pin(module_id, module_net, net_sink);
+      BasicPort sink_port(module_manager.module_port(module_id, module_manager.net_sink_port(module_id, module_net, net_sink)).get_name(), sink_pin, sink_pin);
 
-      /* We need to print a wire connection here */
-      print_verilog_wire_connection(fp, sink_port, src_port, false);
+      /* We need a wire connection here */
+      output_pins.push_back(sink_port);
+      input_pins.push_back(src_port);
     }
   }
 }
@@ -308,6 +348,7 @@ void print_verilog_module_local_short_connection(std::fstream& fp,
  * between an input port of the module and an output port of the module
  * This type of connection is not covered when printing Verilog instances
  * Therefore, they are covered in this function 
+ * Connections of all the nets are merged into bus-level assignments
  *
  *            module
  *            +-----------------------------+
@@ -322,15 +363,17 @@ static
 void print_verilog_module_local_short_connections(std::fstream& fp, 
                                                   const ModuleManager& module_manager,
                                                   const ModuleId& module_id) {
+  std::vector<BasicPort> output_pins;
+  std::vector<BasicPort> input_pins;
   /* Local wires come from the child modules */
   for (ModuleNetId module_net : module_manager.module_nets(module_id)) {
     /* We only care the nets that indicate short connections */ 
     if (false == module_net_include_local_short_connection(module_manager, module_id, module_net)) {
       continue;
     }
-    print_verilog_comment(fp, std::string("----- Local connection due to Wire " + std::to_string(size_t(module_net)) + " -----"));
-    print_verilog_module_local_short_connection(fp, module_manager, module_id, module_net); 
+    collect_verilog_module_local_short_connection(output_pins, input_pins, module_manager, module_id, module_net); 
   }
+  print_verilog_wire_connections(fp, output_pins, input_pins);
 }
 
 /********************************************************************
@@ -339,6 +382,7 @@ void print_verilog_module_local_short_connections(std::fstream& fp,
  * between two output ports of the module
  * This type of connection is not covered when printing Verilog instances
  * Therefore, they are covered in this function 
+ * Connections of all the nets are merged into bus-level assignments
  *
  *            module
  *            +-----------------------------+
@@ -353,14 +397,41 @@ static
 void print_verilog_module_output_short_connections(std::fstream& fp, 
                                                    const ModuleManager& module_manager,
                                                    const ModuleId& module_id) {
+  std::vector<BasicPort> output_pins;
+  std::vector<BasicPort> input_pins;
   /* Local wires come from the child modules */
   for (ModuleNetId module_net : module_manager.module_nets(module_id)) {
     /* We only care the nets that indicate short connections */ 
     if (false == module_net_include_output_short_connection(module_manager, module_id, module_net)) {
       continue;
     }
-    print_verilog_module_output_short_connection(fp, module_manager, module_id, module_net); 
+    collect_verilog_module_output_short_connection(output_pins, input_pins, module_manager, module_id, module_net); 
   }
+  print_verilog_wire_connections(fp, output_pins, input_pins);
+}
+
+/********************************************************************
+ * Generate the name of the stub of a module, which replaces
+ * the instances of the module that are not used by a design
+ *******************************************************************/
+static 
+std::string generate_verilog_stub_module_name(const ModuleManager& module_manager,
+                                              const ModuleId& module_id) {
+  return module_manager.module_name(module_id) + std::string(VERILOG_STUB_MODULE_POSTFIX);
+}
+
+/********************************************************************
+ * Identify if a Verilog port covers exactly a port of a module
+ *******************************************************************/
+static 
+bool verilog_port_is_whole_module_port(const ModuleManager& module_manager,
+                                       const ModuleId& module_id,
+                                       const BasicPort& verilog_port) {
+  ModulePortId module_port = module_manager.find_module_port(module_id, verilog_port.get_name());
+  if (false == module_manager.valid_module_port_id(module_id, module_port)) {
+    return false;
+  }
+  return module_manager.module_port(module_id, module_port) == verilog_port;
 }
 
 /********************************************************************
@@ -386,20 +457,25 @@ void write_verilog_instance_to_file(std::fstream& fp,
                                     const ModuleId& parent_module,
                                     const ModuleId& child_module,
                                     const size_t& instance_id,
-                                    const bool& use_explicit_port_map) {
+                                    const bool& use_explicit_port_map,
+                                    const bool& use_stub) {
   /* Ensure a valid file stream */
   VTR_ASSERT(true == valid_file_stream(fp));
 
   /* Print module name */
-  fp << "\t" << module_manager.module_name(child_module) << " ";
+  if (true == use_stub) {
+    fp << "\t" << generate_verilog_stub_module_name(module_manager, child_module) << " ";
+  } else {
+    fp << "\t" << module_manager.module_name(child_module) << " ";
+  }
   /* Print instance name: 
    * if we have an instance name, use it;
    * if not, we use a default name <name>_<num_instance_in_parent_module> 
    */
   if (true == module_manager.instance_name(parent_module, child_module, instance_id).empty()) {
-    fp << generate_instance_name(module_manager.module_name(child_module), instance_id) << " (" << std::endl;
+    fp << generate_instance_name(module_manager.module_name(child_module), instance_id) << " (\n";
   } else {
-    fp << module_manager.instance_name(parent_module, child_module, instance_id) << " (" << std::endl;
+    fp << module_manager.instance_name(parent_module, child_module, instance_id) << " (\n";
   }
 
   /* Print each port with/without explicit port map */
@@ -421,7 +497,7 @@ void write_verilog_instance_to_file(std::fstream& fp,
       BasicPort child_port = module_manager.module_port(child_module, child_port_id);
       if (0 != port_cnt) {
         /* Do not dump a comma for the first port */
-        fp << "," << std::endl; 
+        fp << ",\n"; 
       }
       /* Print port */
       fp << "\t\t";
@@ -453,8 +529,17 @@ void write_verilog_instance_to_file(std::fstream& fp,
       /* Try to merge the ports */
       std::vector<BasicPort> merged_ports = combine_verilog_ports(instance_ports); 
 
-      /* Print a verilog port by combining the instance ports */
-      fp << generate_verilog_ports(merged_ports);
+      /* Print a verilog port by combining the instance ports
+       * When the instance port is connected to a whole port of the parent module, 
+       * print only the port name 
+       */
+      if ( (1 == merged_ports.size())
+        && (1 < merged_ports[0].get_width())
+        && (true == verilog_port_is_whole_module_port(module_manager, parent_module, merged_ports[0]))) {
+        fp << merged_ports[0].get_name();
+      } else {
+        fp << generate_verilog_ports(merged_ports);
+      }
 
       /* if explicit port map is required, output the pair of branket */
       if (true == use_explicit_port_map) {
@@ -465,30 +550,36 @@ void write_verilog_instance_to_file(std::fstream& fp,
   }
   
   /* Print an end to the instance */
-  fp << ");" << std::endl;
+  fp << ");\n";
 }
 
 /********************************************************************
- * Write a Verilog module to a file
- * This is a key function, maybe most frequently called in our Verilog writer
+ * Write the contents of a Verilog module to a file, 
+ * i.e., everything between the module definition and the endmodule,
+ * including port declarations, local wires, short connections and instances
+ * The contents do not depend on the module name,
+ * so that they can be shared by modules which are different only in names
+ * The instances flagged in the stubbed instances instanciate 
+ * the stubs of their modules, see write_verilog_stub_module_to_file()
  * Note that file stream must be valid 
  *******************************************************************/
-void write_verilog_module_to_file(std::fstream& fp,
-                                  const ModuleManager& module_manager,
-                                  const ModuleId& module_id,
-                                  const bool& use_explicit_port_map,
-                                  const e_verilog_default_net_type& default_net_type) {
+void write_verilog_module_body_to_file(std::fstream& fp,
+                                       const ModuleManager& module_manager,
+                                       const ModuleId& module_id,
+                                       const bool& use_explicit_port_map,
+                                       const e_verilog_default_net_type& default_net_type,
+                                       const std::map<ModuleId, std::vector<bool>>& stubbed_instances) {
 
   VTR_ASSERT(true == valid_file_stream(fp));
 
   /* Ensure we have a valid module_id */
   VTR_ASSERT(module_manager.valid_module_id(module_id)); 
 
-  /* Print module declaration */
-  print_verilog_module_declaration(fp, module_manager, module_id, default_net_type);
+  /* Print port declaration */
+  print_verilog_module_ports(fp, module_manager, module_id, default_net_type);
 
   /* Print an empty line as splitter */
-  fp << std::endl;
+  fp << "\n";
    
   /* Print internal wires */
   std::map<std::string, std::vector<BasicPort>> local_wires = find_verilog_module_local_wires(module_manager, module_id);
@@ -500,12 +591,12 @@ void write_verilog_module_to_file(std::fstream& fp,
         && (0 == local_wire.get_lsb())) {
         continue;
       }
-      fp << generate_verilog_port(VERILOG_PORT_WIRE, local_wire) << ";" << std::endl;
+      fp << generate_verilog_port(VERILOG_PORT_WIRE, local_wire) << ";\n";
     }
   }
 
   /* Print an empty line as splitter */
-  fp << std::endl;
+  fp << "\n";
 
   /* Print local connection (from module inputs to output! */
   print_verilog_comment(fp, std::string("----- BEGIN Local short connections -----"));
@@ -517,26 +608,218 @@ void write_verilog_module_to_file(std::fstream& fp,
  
   print_verilog_comment(fp, std::string("----- END Local output short connections -----"));
   /* Print an empty line as splitter */
-  fp << std::endl;
+  fp << "\n";
 
   /* Print instances */
   for (ModuleId child_module : module_manager.child_modules(module_id)) {
+    auto stubbed_result = stubbed_instances.find(child_module);
     for (size_t instance : module_manager.child_module_instances(module_id, child_module)) {
+      bool use_stub = (stubbed_result != stubbed_instances.end())
+                   && (instance < stubbed_result->second.size())
+                   && (true == stubbed_result->second[instance]);
       /* Print an instance */
-      write_verilog_instance_to_file(fp, module_manager, module_id, child_module, instance, use_explicit_port_map); 
+      write_verilog_instance_to_file(fp, module_manager, module_id, child_module, instance, use_explicit_port_map, use_stub); 
       /* Print an empty line as splitter */
-      fp << std::endl;
+      fp << "\n";
     }
   }
+}
+
+/********************************************************************
+ * Write a Verilog module to a file
+ * This is a key function, maybe most frequently called in our Verilog writer
+ * Note that file stream must be valid 
+ *******************************************************************/
+void write_verilog_module_to_file(std::fstream& fp,
+                                  const ModuleManager& module_manager,
+                                  const ModuleId& module_id,
+                                  const bool& use_explicit_port_map,
+                                  const e_verilog_default_net_type& default_net_type,
+                                  const std::map<ModuleId, std::vector<bool>>& stubbed_instances) {
+
+  VTR_ASSERT(true == valid_file_stream(fp));
+
+  /* Ensure we have a valid module_id */
+  VTR_ASSERT(module_manager.valid_module_id(module_id)); 
+
+  /* Apply default net type from user's option */
+  print_verilog_default_net_type_declaration(fp,
+                                             default_net_type); 
+
+  /* Print module definition */
+  print_verilog_module_definition(fp, module_manager, module_id);
+
+  /* Print module contents */
+  write_verilog_module_body_to_file(fp, module_manager, module_id, use_explicit_port_map, default_net_type, stubbed_instances);
+
+  /* Print an end for the module */
+  print_verilog_module_end(fp, module_manager.module_name(module_id)); 
+
+  /* Print an empty line as splitter */
+  fp << "\n";
+
+  /* Print an empty line as splitter */
+  fp << "\n";
+}
+
+/********************************************************************
+ * Write a Verilog module to a file, whose contents are included
+ * from a file written by write_verilog_module_body_to_file()
+ * The module name and ports are the same as write_verilog_module_to_file()
+ * Note that file stream must be valid 
+ *******************************************************************/
+void write_verilog_module_with_shared_body_to_file(std::fstream& fp,
+                                                   const ModuleManager& module_manager,
+                                                   const ModuleId& module_id,
+                                                   const std::string& body_file_name,
+                                                   const e_verilog_default_net_type& default_net_type) {
+
+  VTR_ASSERT(true == valid_file_stream(fp));
+
+  /* Ensure we have a valid module_id */
+  VTR_ASSERT(module_manager.valid_module_id(module_id)); 
+
+  /* Apply default net type from user's option */
+  print_verilog_default_net_type_declaration(fp,
+                                             default_net_type); 
+
+  /* Print module definition */
+  print_verilog_module_definition(fp, module_manager, module_id);
+
+  /* Include the shared contents */
+  print_verilog_include_netlist(fp, body_file_name);
 
   /* Print an end for the module */
   print_verilog_module_end(fp, module_manager.module_name(module_id)); 
 
   /* Print an empty line as splitter */
-  fp << std::endl;
+  fp << "\n";
+}
+
+/********************************************************************
+ * Write the stub of a Verilog module to a file, which has the same ports
+ * as the module but drives constant zeros to the outputs,
+ * so that the module costs almost nothing in simulation.
+ * The stub keeps
+ * - the short connections from the inputs to the outputs, e.g., 
+ *   the routing tracks passing through connection blocks
+ * - the configuration chain, as a shift register of the configuration bits 
+ *   of the module clocked by the given configuration chain clock,
+ *   so that the bitstream of the fabric can still be loaded.
+ *   The chain is kept only when the clock is given 
+ * Note that file stream must be valid 
+ *******************************************************************/
+void write_verilog_stub_module_to_file(std::fstream& fp,
+                                       const ModuleManager& module_manager,
+                                       const ModuleId& module_id,
+                                       const std::string& config_chain_clock_name,
+                                       const size_t& num_config_chain_bits,
+                                       const e_verilog_default_net_type& default_net_type) {
+
+  VTR_ASSERT(true == valid_file_stream(fp));
+
+  /* Ensure we have a valid module_id */
+  VTR_ASSERT(module_manager.valid_module_id(module_id)); 
+
+  std::string stub_module_name = generate_verilog_stub_module_name(module_manager, module_id);
+
+  /* Apply default net type from user's option */
+  print_verilog_default_net_type_declaration(fp,
+                                             default_net_type); 
+
+  /* Print module definition */
+  print_verilog_module_definition(fp, module_manager, module_id, stub_module_name);
+
+  /* Print port declaration */
+  print_verilog_module_ports(fp, module_manager, module_id, default_net_type);
+
+  /* Print an empty line as splitter */
+  fp << "\n";
+
+  /* Print local connection (from module inputs to output! */
+  std::vector<BasicPort> output_pins;
+  std::vector<BasicPort> input_pins;
+  for (ModuleNetId module_net : module_manager.module_nets(module_id)) {
+    if (false == module_net_include_local_short_connection(module_manager, module_id, module_net)) {
+      continue;
+    }
+    collect_verilog_module_local_short_connection(output_pins, input_pins, module_manager, module_id, module_net); 
+  }
+  print_verilog_comment(fp, std::string("----- BEGIN Local short connections -----"));
+  print_verilog_wire_connections(fp, output_pins, input_pins);
+  print_verilog_comment(fp, std::string("----- END Local short connections -----"));
+
+  /* Record the output pins which have been driven */
+  std::map<std::string, std::vector<bool>> driven_output_pins;
+  for (const BasicPort& output_pin : output_pins) {
+    std::vector<bool>& driven_pins = driven_output_pins[output_pin.get_name()];
+    if (driven_pins.size() <= output_pin.get_lsb()) {
+      driven_pins.resize(output_pin.get_lsb() + 1, false);
+    }
+    driven_pins[output_pin.get_lsb()] = true;
+  }
+
+  /* Shift the configuration bits through a register chain */
+  ModulePortId chain_head_port = module_manager.find_module_port(module_id, generate_configuration_chain_head_name());
+  ModulePortId chain_tail_port = module_manager.find_module_port(module_id, generate_configuration_chain_tail_name());
+  ModulePortId chain_clock_port = module_manager.find_module_port(module_id, config_chain_clock_name);
+  if ( (false == config_chain_clock_name.empty())
+    && (true == module_manager.valid_module_port_id(module_id, chain_head_port))
+    && (true == module_manager.valid_module_port_id(module_id, chain_tail_port))
+    && (true == module_manager.valid_module_port_id(module_id, chain_clock_port)) ) {
+    BasicPort head_port = module_manager.module_port(module_id, chain_head_port);
+    BasicPort tail_port = module_manager.module_port(module_id, chain_tail_port);
+    BasicPort clock_port = module_manager.module_port(module_id, chain_clock_port);
+    VTR_ASSERT(1 == head_port.get_width());
+    VTR_ASSERT(1 == tail_port.get_width());
+    clock_port.set_width(clock_port.get_lsb(), clock_port.get_lsb());
+
+    print_verilog_comment(fp, std::string("----- BEGIN Configuration chain of " + std::to_string(num_config_chain_bits) + " bits -----"));
+    if (0 == num_config_chain_bits) {
+      print_verilog_wire_connection(fp, tail_port, head_port, false);
+    } else {
+      BasicPort chain_regs(std::string("ccff_stub_regs"), num_config_chain_bits);
+      fp << generate_verilog_port(VERILOG_PORT_REG, chain_regs) << ";\n";
+      fp << "\talways @(posedge " << generate_verilog_port(VERILOG_PORT_CONKT, clock_port) << ") begin\n";
+      if (1 == num_config_chain_bits) {
+        fp << "\t\t" << generate_verilog_port(VERILOG_PORT_CONKT, chain_regs) << " <= " << generate_verilog_port(VERILOG_PORT_CONKT, head_port) << ";\n";
+      } else {
+        BasicPort shifted_regs(chain_regs.get_name(), 0, num_config_chain_bits - 2);
+        fp << "\t\t" << generate_verilog_port(VERILOG_PORT_CONKT, chain_regs) << " <= {" << generate_verilog_port(VERILOG_PORT_CONKT, head_port) << ", " << generate_verilog_port(VERILOG_PORT_CONKT, shifted_regs) << "};\n";
+      }
+      fp << "\tend\n";
+      BasicPort last_reg(chain_regs.get_name(), chain_regs.get_msb(), chain_regs.get_msb());
+      print_verilog_wire_connection(fp, tail_port, last_reg, false);
+    }
+    print_verilog_comment(fp, std::string("----- END Configuration chain -----"));
+    driven_output_pins[tail_port.get_name()].assign(tail_port.get_width(), true);
+  }
+
+  /* Drive the other outputs to constant zeros */
+  print_verilog_comment(fp, std::string("----- BEGIN Constant outputs -----"));
+  for (const ModuleManager::e_module_port_type& port_type : {ModuleManager::MODULE_GPOUT_PORT, ModuleManager::MODULE_OUTPUT_PORT}) {
+    for (const BasicPort& output_port : module_manager.module_ports_by_type(module_id, port_type)) {
+      auto driven_result = driven_output_pins.find(output_port.get_name());
+      if (driven_result == driven_output_pins.end()) {
+        print_verilog_wire_constant_values(fp, output_port, std::vector<size_t>(output_port.get_width(), 0));
+        continue;
+      }
+      for (const size_t& pin : output_port.pins()) {
+        if ( (pin < driven_result->second.size())
+          && (true == driven_result->second[pin]) ) {
+          continue;
+        }
+        print_verilog_wire_constant_values(fp, BasicPort(output_port.get_name(), pin, pin), std::vector<size_t>(1, 0));
+      }
+    }
+  }
+  print_verilog_comment(fp, std::string("----- END Constant outputs -----"));
+
+  /* Print an end for the module */
+  print_verilog_module_end(fp, stub_module_name); 
 
   /* Print an empty line as splitter */
-  fp << std::endl;
+  fp << "\n";
 }
 
 } /* end namespace openfpga */
@@ -5,6 +5,9 @@
  * Include header files that are required by function declaration
  *******************************************************************/
 #include <fstream>
+#include <map>
+#include <string>
+#include <vector>
 #include "module_manager.h"
 #include "verilog_port_types.h"
 
@@ -15,11 +18,32 @@
 /* begin namespace openfpga */
 namespace openfpga {
 
+void write_verilog_module_body_to_file(std::fstream& fp,
+                                       const ModuleManager& module_manager,
+                                       const ModuleId& module_id,
+                                       const bool& use_explicit_port_map,
+                                       const e_verilog_default_net_type& default_net_type,
+                                       const std::map<ModuleId, std::vector<bool>>& stubbed_instances = std::map<ModuleId, std::vector<bool>>());
+
+void write_verilog_module_with_shared_body_to_file(std::fstream& fp,
+                                                   const ModuleManager& module_manager,
+                                                   const ModuleId& module_id,
+                                                   const std::string& body_file_name,
+                                                   const e_verilog_default_net_type& default_net_type);
+
 void write_verilog_module_to_file(std::fstream& fp,
                                   const ModuleManager& module_manager,
                                   const ModuleId& module_id,
                                   const bool& use_explicit_port_map,
-                                  const e_verilog_default_net_type& default_net_type);
+                                  const e_verilog_default_net_type& default_net_type,
+                                  const std::map<ModuleId, std::vector<bool>>& stubbed_instances = std::map<ModuleId, std::vector<bool>>());
+
+void write_verilog_stub_module_to_file(std::fstream& fp,
+                                       const ModuleManager& module_manager,
+                                       const ModuleId& module_id,
+                                       const std::string& config_chain_clock_name,
+                                       const size_t& num_config_chain_bits,
+                                       const e_verilog_default_net_type& default_net_type);
 
 } /* end namespace openfpga */
 
@@ -7,6 +7,7 @@
  **********************************************/
 #include <string>
 #include <map>
+#include <set>
 #include <algorithm>
 
 /* Headers from vtrutil library */
@@ -58,11 +59,11 @@ void generate_verilog_cmos_mux_branch_body_behavioral(std::fstream& fp,
   /* Add an internal register for the output */
   BasicPort outreg_port("out_reg", mux_graph.num_outputs());
   /* Print the port */
-  fp << "\t" << generate_verilog_port(VERILOG_PORT_REG, outreg_port) << ";" << std::endl; 
+  fp << "\t" << generate_verilog_port(VERILOG_PORT_REG, outreg_port) << ";\n"; 
 
   /* Generate the case-switch table */
-  fp << "\talways @(" << generate_verilog_port(VERILOG_PORT_CONKT, input_port) << ", " << generate_verilog_port(VERILOG_PORT_CONKT, mem_port) << ")" << std::endl; 
-  fp << "\tcase (" << generate_verilog_port(VERILOG_PORT_CONKT, mem_port) << ")" << std::endl;
+  fp << "\talways @(" << generate_verilog_port(VERILOG_PORT_CONKT, input_port) << ", " << generate_verilog_port(VERILOG_PORT_CONKT, mem_port) << ")\n"; 
+  fp << "\tcase (" << generate_verilog_port(VERILOG_PORT_CONKT, mem_port) << ")\n";
 
   /* Output the netlist following the connections in mux_graph */
   /* Iterate over the inputs */
@@ -93,21 +94,110 @@ void generate_verilog_cmos_mux_branch_body_behavioral(std::fstream& fp,
         case_code[size_t(mux_mem)] = '0';
       }
       fp << case_code << ": " << generate_verilog_port(VERILOG_PORT_CONKT, outreg_port) << " <= ";
-      fp << generate_verilog_port(VERILOG_PORT_CONKT, cur_input_port) << ";" << std::endl;
+      fp << generate_verilog_port(VERILOG_PORT_CONKT, cur_input_port) << ";\n";
     }
   }
 
   /* Default case: outputs are at high-impedance state 'z' */
   std::string default_case(mux_graph.num_outputs(), 'z');
   fp << "\t\tdefault: " << generate_verilog_port(VERILOG_PORT_CONKT, outreg_port) << " <= ";
-  fp << mux_graph.num_outputs() << "'b" << default_case << ";" << std::endl;
+  fp << mux_graph.num_outputs() << "'b" << default_case << ";\n";
 
   /* End the case */
-  fp << "\tendcase" << std::endl;
+  fp << "\tendcase\n";
 
   /* Wire registers to output ports */
   fp << "\tassign " << generate_verilog_port(VERILOG_PORT_CONKT, output_port) << " = ";
-  fp << generate_verilog_port(VERILOG_PORT_CONKT, outreg_port) << ";" << std::endl;
+  fp << generate_verilog_port(VERILOG_PORT_CONKT, outreg_port) << ";\n";
+}
+
+/*********************************************************************
+ * Generate behavior-level Verilog codes modeling an branch circuit 
+ * with a loop over the inputs, instead of a case for each input.
+ * This is only applicable when the branch is regular, i.e.,
+ * the i-th input is selected by flipping the i-th memory bit,
+ * and all the inputs use either the regular or inverted memory bits.
+ * For example, a regular 4-input branch with memory bits defaulted to '0'
+ * selects in[i] when mem is 4'b1000 >> i.
+ *
+ * Return false without printing anything if the branch is not regular,
+ * so that the caller can fall back to the case-switch table
+ *********************************************************************/
+static 
+bool generate_verilog_cmos_mux_branch_body_compact(std::fstream& fp,
+                                                   const BasicPort& input_port,
+                                                   const BasicPort& output_port,
+                                                   const BasicPort& mem_port,
+                                                   const MuxGraph& mux_graph,
+                                                   const size_t& default_mem_val) {
+  /* Make sure we have a valid file handler*/
+  VTR_ASSERT(true == valid_file_stream(fp));
+
+  if ( (2 > mux_graph.num_inputs())
+    || (mux_graph.num_inputs() != mux_graph.num_memory_bits())
+    || (1 != mux_graph.num_outputs()) ) {
+    return false;
+  }
+
+  /* Check each input is selected by the memory bit with the same index */
+  MuxNodeId mux_output = mux_graph.outputs()[0];
+  std::set<bool> use_inv_mem;
+  for (const auto& mux_input : mux_graph.inputs()) {
+    std::vector<MuxEdgeId> edges = mux_graph.find_edges(mux_input, mux_output);
+    if (1 != edges.size()) {
+      return false;
+    }
+    if (size_t(mux_graph.find_edge_mem(edges[0])) != size_t(mux_graph.input_id(mux_input))) {
+      return false;
+    }
+    use_inv_mem.insert(mux_graph.is_edge_use_inv_mem(edges[0]));
+  }
+  if (1 != use_inv_mem.size()) {
+    return false;
+  }
+  /* The selecting code must differ from the default one */
+  char sel_mem_val = (true == *use_inv_mem.begin()) ? '0' : '1';
+  if (sel_mem_val == char(default_mem_val)) {
+    return false;
+  }
+
+  /* Verilog Behavior description for a MUX */
+  print_verilog_comment(fp, std::string("---- Behavioral-level description -----"));
+
+  /* Add an internal register for the output */
+  BasicPort outreg_port("out_reg", mux_graph.num_outputs());
+  fp << "\t" << generate_verilog_port(VERILOG_PORT_REG, outreg_port) << ";\n"; 
+
+  /* Add a loop variable */
+  std::string loop_var("iin");
+  fp << "\tinteger " << loop_var << ";\n";
+
+  /* The code selecting the first input, i.e., the first memory bit flipped */
+  size_t num_mems = mem_port.get_width();
+  std::string first_code = std::string("{1'b1, {") + std::to_string(num_mems - 1) + std::string("{1'b0}}}");
+  std::string sel_code = std::string("(") + first_code + std::string(" >> ") + loop_var + std::string(")");
+  if ('0' == sel_mem_val) {
+    sel_code = std::string("~") + sel_code;
+  }
+
+  fp << "\talways @(" << generate_verilog_port(VERILOG_PORT_CONKT, input_port) << ", " << generate_verilog_port(VERILOG_PORT_CONKT, mem_port) << ") begin\n"; 
+  /* Outputs are at high-impedance state 'z' unless an input is selected */
+  std::string default_case(mux_graph.num_outputs(), 'z');
+  fp << "\t\t" << generate_verilog_port(VERILOG_PORT_CONKT, outreg_port) << " = ";
+  fp << mux_graph.num_outputs() << "'b" << default_case << ";\n";
+  fp << "\t\tfor (" << loop_var << " = 0; " << loop_var << " < " << mux_graph.num_inputs() << "; " << loop_var << " = " << loop_var << " + 1) begin\n";
+  fp << "\t\t\tif (" << generate_verilog_port(VERILOG_PORT_CONKT, mem_port) << " == " << sel_code << ") begin\n";
+  fp << "\t\t\t\t" << generate_verilog_port(VERILOG_PORT_CONKT, outreg_port) << " = ";
+  fp << input_port.get_name() << "[" << loop_var << "];\n";
+  fp << "\t\t\tend\n";
+  fp << "\t\tend\n";
+  fp << "\tend\n";
+
+  /* Wire registers to output ports */
+  fp << "\tassign " << generate_verilog_port(VERILOG_PORT_CONKT, output_port) << " = ";
+  fp << generate_verilog_port(VERILOG_PORT_CONKT, outreg_port) << ";\n";
+
+  return true;
 }
 
 /*********************************************************************
@@ -122,7 +212,8 @@ void print_verilog_cmos_mux_branch_module_behavioral(ModuleManager& module_manag
                                                      const CircuitModelId& mux_model, 
                                                      const std::string& module_name, 
                                                      const MuxGraph& mux_graph,
-                                                     const e_verilog_default_net_type& default_net_type) {
+                                                     const e_verilog_default_net_type& default_net_type,
+                                                     const bool& compact_mux_branches) {
   /* Get the tgate model */
   CircuitModelId tgate_model = circuit_lib.pass_gate_logic_model(mux_model);
 
@@ -170,7 +261,10 @@ void print_verilog_cmos_mux_branch_module_behavioral(ModuleManager& module_manag
   std::string mem_default_val = std::to_string(circuit_lib.port_default_value(regular_sram_ports[0]));
   /* Mem string must be only 1-bit! */
   VTR_ASSERT(1 == mem_default_val.length());
-  generate_verilog_cmos_mux_branch_body_behavioral(fp, input_port, output_port, mem_port, mux_graph, mem_default_val[0]);
+  if ( (false == compact_mux_branches)
+    || (false == generate_verilog_cmos_mux_branch_body_compact(fp, input_port, output_port, mem_port, mux_graph, mem_default_val[0])) ) {
+    generate_verilog_cmos_mux_branch_body_behavioral(fp, input_port, output_port, mem_port, mux_graph, mem_default_val[0]);
+  }
 
   /* Put an end to the Verilog module */
   print_verilog_module_end(fp, module_name);
@@ -411,7 +505,7 @@ void generate_verilog_rram_mux_branch_body_behavioral(std::fstream& fp,
   /* Add an internal register for the output */
   BasicPort outreg_port("out_reg", mux_graph.num_inputs());
   /* Print the port */
-  fp << "\t" << generate_verilog_port(VERILOG_PORT_REG, outreg_port) << ";" << std::endl; 
+  fp << "\t" << generate_verilog_port(VERILOG_PORT_REG, outreg_port) << ";\n"; 
 
   /* Print the internal logics */
   fp << "\t" << "always @(";
@@ -419,7 +513,7 @@ void generate_verilog_rram_mux_branch_body_behavioral(std::fstream& fp,
   fp << ", ";
   fp << generate_verilog_port(VERILOG_PORT_CONKT, wl_port); 
   fp << ")";
-  fp << " begin" << std::endl;
+  fp << " begin\n";
 
   /* Only when the last bit of wl is enabled, 
    * the propagating path can be changed 
@@ -465,7 +559,7 @@ void generate_verilog_rram_mux_branch_body_behavioral(std::fstream& fp,
   }
 
   /* Finish the if clause */
-  fp << ") begin" << std::endl;
+  fp << ") begin\n";
 
   for (const auto& mux_input : mux_graph.inputs()) {
     /* First if clause need tabs */
@@ -476,26 +570,26 @@ void generate_verilog_rram_mux_branch_body_behavioral(std::fstream& fp,
     /* Create a temp port of a BLB bit */
     BasicPort cur_blb_port(blb_port.get_name(), size_t(mux_graph.input_id(mux_input)), size_t(mux_graph.input_id(mux_input)));
     fp << generate_verilog_port(VERILOG_PORT_CONKT, cur_blb_port); 
-    fp << ") begin" << std::endl;
+    fp << ") begin\n";
     fp << "\t\t\t\t" << "assign ";
   fp << outreg_port.get_name(); 
-    fp << " = " << size_t(mux_graph.input_id(mux_input)) << ";" << std::endl;
+    fp << " = " << size_t(mux_graph.input_id(mux_input)) << ";\n";
     fp << "\t\t\t" << "end else ";
   }
-  fp << "begin" << std::endl;
+  fp << "begin\n";
   fp << "\t\t\t\t" << "assign ";
   fp << outreg_port.get_name(); 
-  fp << " = 0;" << std::endl;
-  fp << "\t\t\t" << "end" << std::endl;
-  fp << "\t\t" << "end" << std::endl;
-  fp << "\t" << "end" << std::endl;
+  fp << " = 0;\n";
+  fp << "\t\t\t" << "end\n";
+  fp << "\t\t" << "end\n";
+  fp << "\t" << "end\n";
  
   fp << "\t" << "assign ";
   fp << generate_verilog_port(VERILOG_PORT_CONKT, output_port);
   fp << " = "; 
   fp << input_port.get_name() << "[";
   fp << outreg_port.get_name(); 
-  fp << "];" << std::endl;
+  fp << "];\n";
 }
 
 /*********************************************************************
@@ -586,6 +680,7 @@ void generate_verilog_mux_branch_module(ModuleManager& module_manager,
                                         const MuxGraph& mux_graph,
                                         const bool& use_explicit_port_map,
                                         const e_verilog_default_net_type& default_net_type,
+                                        const bool& compact_mux_branches,
                                         std::map<std::string, bool>& branch_mux_module_is_outputted) {
   std::string module_name = generate_mux_branch_subckt_name(circuit_lib, mux_model, mux_graph.num_inputs(), mux_graph.num_memory_bits(), VERILOG_MUX_BASIS_POSTFIX);
 
@@ -614,7 +709,7 @@ void generate_verilog_mux_branch_module(ModuleManager& module_manager,
                                    use_explicit_port_map || circuit_lib.dump_explicit_port_map(mux_model),
                                    default_net_type);
       /* Add an empty line as a splitter */
-      fp << std::endl;
+      fp << "\n";
     } else {
       /* Behavioral verilog requires customized generation */
       print_verilog_cmos_mux_branch_module_behavioral(module_manager,
@@ -623,7 +718,8 @@ void generate_verilog_mux_branch_module(ModuleManager& module_manager,
                                                       mux_model,
                                                       module_name,
                                                       mux_graph,
-                                                      default_net_type);
+                                                      default_net_type,
+                                                      compact_mux_branches);
     }
     break;
   case CIRCUIT_MODEL_DESIGN_RRAM:
@@ -707,7 +803,7 @@ void generate_verilog_cmos_mux_module_input_buffers(ModuleManager& module_manage
       print_verilog_comment(fp, std::string("---- BEGIN short-wire a multiplexing structure input to a constant value -----"));
       print_verilog_wire_constant_values(fp, instance_output_port, std::vector<size_t>(1, const_value));
       print_verilog_comment(fp, std::string("---- END short-wire a multiplexing structure input to a constant value -----"));
-      fp << std::endl;
+      fp << "\n";
       continue; /* Finish here */
     }
 
@@ -719,7 +815,7 @@ void generate_verilog_cmos_mux_module_input_buffers(ModuleManager& module_manage
       print_verilog_wire_connection(fp, instance_output_port, instance_input_port, false);      
 
       print_verilog_comment(fp, std::string("---- END short-wire a multiplexing structure input to MUX module input -----"));
-      fp << std::endl;
+      fp << "\n";
       continue; /* Finish here */
     }
 
@@ -734,7 +830,7 @@ void generate_verilog_cmos_mux_module_input_buffers(ModuleManager& module_manage
     print_verilog_buffer_instance(fp, module_manager, circuit_lib, module_id, buffer_model, instance_input_port, instance_output_port);
 
     print_verilog_comment(fp, std::string("---- END Instanciation of an input buffer module -----"));
-    fp << std::endl;
+    fp << "\n";
   } 
 }
 
@@ -798,7 +894,7 @@ void generate_verilog_cmos_mux_module_output_buffers(ModuleManager& module_manag
         print_verilog_wire_connection(fp, instance_output_port, instance_input_port, false);      
 
         print_verilog_comment(fp, std::string("---- END short-wire a multiplexing structure output to MUX module output -----"));
-        fp << std::endl;
+        fp << "\n";
         continue; /* Finish here */
       }
 
@@ -813,7 +909,7 @@ void generate_verilog_cmos_mux_module_output_buffers(ModuleManager& module_manag
       print_verilog_buffer_instance(fp, module_manager, circuit_lib, module_id, buffer_model, instance_input_port, instance_output_port);
 
       print_verilog_comment(fp, std::string("---- END Instanciation of an output buffer module -----"));
-      fp << std::endl;
+      fp << "\n";
     }
   }
 }
@@ -853,16 +949,16 @@ void generate_verilog_rram_mux_module_multiplexing_structure(ModuleManager& modu
   for (size_t level = 0; level < mux_graph.num_levels(); ++level) {
     /* Print the internal wires located at this level */
     BasicPort internal_wire_port(generate_mux_node_name(level, false), mux_graph.num_nodes_at_level(level));
-    fp << "\t" << generate_verilog_port(VERILOG_PORT_WIRE, internal_wire_port) << ";" << std::endl;
+    fp << "\t" << generate_verilog_port(VERILOG_PORT_WIRE, internal_wire_port) << ";\n";
     /* Identify if an intermediate buffer is needed */
     if (false == inter_buffer_location_map[level]) { 
       continue;
     }
     BasicPort internal_wire_buffered_port(generate_mux_node_name(level, true), mux_graph.num_nodes_at_level(level));
-    fp << "\t" << generate_verilog_port(VERILOG_PORT_WIRE, internal_wire_buffered_port) << std::endl;
+    fp << "\t" << generate_verilog_port(VERILOG_PORT_WIRE, internal_wire_buffered_port) << "\n";
   }
   print_verilog_comment(fp, std::string("---- END Internal wires of a RRAM-based MUX module -----"));
-  fp << std::endl;
+  fp << "\n";
 
   /* Iterate over all the internal nodes and output nodes in the mux graph */
   for (const auto& node : mux_graph.non_input_nodes()) {
@@ -927,7 +1023,7 @@ void generate_verilog_rram_mux_module_multiplexing_structure(ModuleManager& modu
      * output a local wire */
     if (1 < combine_verilog_ports(branch_node_input_ports).size()) {
       /* Print a local wire for the merged ports */
-      fp << "\t" << generate_verilog_local_wire(instance_input_port, branch_node_input_ports) << std::endl;
+      fp << "\t" << generate_verilog_local_wire(instance_input_port, branch_node_input_ports) << "\n";
     } else {
       /* Safety check */
       VTR_ASSERT(1 == combine_verilog_ports(branch_node_input_ports).size());
@@ -979,7 +1075,7 @@ void generate_verilog_rram_mux_module_multiplexing_structure(ModuleManager& modu
      * output a local wire */
     if (1 < combine_verilog_ports(branch_node_blb_ports).size()) {
       /* Print a local wire for the merged ports */
-      fp << "\t" << generate_verilog_local_wire(instance_blb_port, branch_node_blb_ports) << std::endl;
+      fp << "\t" << generate_verilog_local_wire(instance_blb_port, branch_node_blb_ports) << "\n";
     } else {
       /* Safety check */
       VTR_ASSERT(1 == combine_verilog_ports(branch_node_blb_ports).size());
@@ -1020,7 +1116,7 @@ void generate_verilog_rram_mux_module_multiplexing_structure(ModuleManager& modu
      * output a local wire */
     if (1 < combine_verilog_ports(branch_node_wl_ports).size()) {
       /* Print a local wire for the merged ports */
-      fp << "\t" << generate_verilog_local_wire(instance_wl_port, branch_node_wl_ports) << std::endl;
+      fp << "\t" << generate_verilog_local_wire(instance_wl_port, branch_node_wl_ports) << "\n";
     } else {
       /* Safety check */
       VTR_ASSERT(1 == combine_verilog_ports(branch_node_wl_ports).size());
@@ -1041,7 +1137,7 @@ void generate_verilog_rram_mux_module_multiplexing_structure(ModuleManager& modu
     module_manager.add_child_module(module_id, branch_module_id);
 
     print_verilog_comment(fp, std::string("---- END Instanciation of a branch RRAM-based MUX module -----"));
-    fp << std::endl;
+    fp << "\n";
 
     if (false == inter_buffer_location_map[output_node_level]) {
       continue; /* No need for intermediate buffers */
@@ -1060,11 +1156,11 @@ void generate_verilog_rram_mux_module_multiplexing_structure(ModuleManager& modu
     print_verilog_buffer_instance(fp, module_manager, circuit_lib, module_id, buffer_model, buffer_instance_input_port, buffer_instance_output_port);
 
     print_verilog_comment(fp, std::string("---- END Instanciation of an intermediate buffer module -----"));
-    fp << std::endl;
+    fp << "\n";
   }
 
   print_verilog_comment(fp, std::string("---- END Internal Logic of a RRAM-based MUX module -----"));
-  fp << std::endl;
+  fp << "\n";
 }
 
 /*********************************************************************
@@ -1229,7 +1325,7 @@ void generate_verilog_mux_module(ModuleManager& module_manager,
                                  || circuit_lib.dump_explicit_port_map(circuit_lib.pass_gate_logic_model(mux_model)) ), 
                                  default_net_type);
     /* Add an empty line as a splitter */
-    fp << std::endl;
+    fp << "\n";
     break;
   }
   case CIRCUIT_MODEL_DESIGN_RRAM:
@@ -1280,19 +1376,22 @@ void print_verilog_submodule_mux_primitives(ModuleManager& module_manager,
    * since different sizes of routing multiplexers may share the same branch module
    */
   std::map<std::string, bool> branch_mux_module_is_outputted;
+  /* Skip extracting the branches which have been visited for a circuit model */
+  std::map<CircuitModelId, std::set<std::pair<size_t, size_t>>> built_branches;
 
   /* Generate basis sub-circuit for unique branches shared by the multiplexers */
   for (auto mux : mux_lib.muxes()) {
     const MuxGraph& mux_graph = mux_lib.mux_graph(mux);
     CircuitModelId mux_circuit_model = mux_lib.mux_circuit_model(mux); 
-    /* Create a mux graph for the branch circuit */
-    std::vector<MuxGraph> branch_mux_graphs = mux_graph.build_mux_branch_graphs();
+    /* Create a mux graph for the branch circuits which are not outputted yet */
+    std::vector<MuxGraph> branch_mux_graphs = mux_graph.build_mux_branch_graphs(built_branches[mux_circuit_model]);
     /* Create branch circuits, which are N:1 one-level or 2:1 tree-like MUXes */
-    for (auto branch_mux_graph : branch_mux_graphs) {
+    for (const MuxGraph& branch_mux_graph : branch_mux_graphs) {
       generate_verilog_mux_branch_module(module_manager, circuit_lib, fp, mux_circuit_model, 
                                          branch_mux_graph,
                                          options.explicit_port_mapping(),
                                          options.default_net_type(),
+                                         options.compact_mux_branches(),
                                          branch_mux_module_is_outputted);
     }
   }
@@ -0,0 +1,860 @@
+/********************************************************************
+ * This file includes functions that are used to generate,
+ * for each grid used by a design,
+ * - a Verilog module of the pre-configured grid, whose pins are cut
+ *   from the routing and exposed as the nets of the design
+ * - a Verilog module of the sub-netlist of the design mapped to the grid,
+ *   which has the same ports
+ * The pairs of modules can be checked by formal equivalence tools
+ * in independent jobs, instead of checking the full fabric at once
+ *******************************************************************/
+#include <fstream>
+#include <map>
+#include <set>
+
+/* Headers from vtrutil library */
+#include "vtr_assert.h"
+#include "vtr_log.h"
+#include "vtr_ndmatrix.h"
+#include "vtr_time.h"
+
+/* Headers from vpr library */
+#include "atom_netlist_utils.h"
+#include "vpr_utils.h"
+
+#include "command_exit_codes.h"
+
+/* Headers from openfpgautil library */
+#include "openfpga_port.h"
+#include "openfpga_digest.h"
+#include "openfpga_buffered_file_stream.h"
+#include "openfpga_reserved_words.h"
+
+#include "bitstream_manager_utils.h"
+#include "openfpga_atom_netlist_utils.h"
+
+#include "openfpga_naming.h"
+#include "build_top_module_utils.h"
+
+#include "verilog_constants.h"
+#include "verilog_writer_utils.h"
+#include "verilog_testbench_utils.h"
+#include "verilog_preconfig_top_module.h"
+#include "verilog_preconfig_tile_module.h"
+
+/* begin namespace openfpga */
+namespace openfpga {
+
+/********************************************************************
+ * The atoms of a design mapped to a grid, and the nets at the
+ * boundary of the grid
+ * - inputs: nets driven outside the grid
+ * - outputs: nets driven inside the grid and consumed outside
+ * - internal nets: nets driven and consumed only inside the grid
+ *******************************************************************/
+struct PreconfigTileNetlist {
+  std::vector<AtomBlockId> atoms;
+  std::set<AtomNetId> inputs;
+  std::set<AtomNetId> outputs;
+  std::set<AtomNetId> internal_nets;
+};
+
+/********************************************************************
+ * Find the nets at the boundary of the atoms mapped to the clusters of a grid
+ *******************************************************************/
+static
+PreconfigTileNetlist build_preconfig_tile_netlist(const AtomContext& atom_ctx,
+                                                  const std::set<ClusterBlockId>& grid_clusters,
+                                                  const std::vector<AtomBlockId>& grid_atoms) {
+  PreconfigTileNetlist tile_netlist;
+  tile_netlist.atoms = grid_atoms;
+
+  auto is_tile_atom = [&](const AtomBlockId& atom_blk) {
+    return 0 < grid_clusters.count(atom_ctx.lookup.atom_clb(atom_blk));
+  };
+
+  for (const AtomBlockId& atom_blk : grid_atoms) {
+    for (const AtomPinId& atom_pin : atom_ctx.nlist.block_pins(atom_blk)) {
+      AtomNetId atom_net = atom_ctx.nlist.pin_net(atom_pin);
+      if (AtomNetId::INVALID() == atom_net) {
+        continue;
+      }
+      AtomPinId driver_pin = atom_ctx.nlist.net_driver(atom_net);
+      if ( (AtomPinId::INVALID() == driver_pin)
+        || (false == is_tile_atom(atom_ctx.nlist.pin_block(driver_pin))) ) {
+        tile_netlist.inputs.insert(atom_net);
+        continue;
+      }
+      bool consumed_outside = false;
+      for (const AtomPinId& sink_pin : atom_ctx.nlist.net_sinks(atom_net)) {
+        if (false == is_tile_atom(atom_ctx.nlist.pin_block(sink_pin))) {
+          consumed_outside = true;
+          break;
+        }
+      }
+      if (true == consumed_outside) {
+        tile_netlist.outputs.insert(atom_net);
+      } else {
+        tile_netlist.internal_nets.insert(atom_net);
+      }
+    }
+  }
+
+  return tile_netlist;
+}
+
+/********************************************************************
+ * Find the name of a net in the design
+ *******************************************************************/
+static
+std::string find_preconfig_tile_net_name(const AtomContext& atom_ctx,
+                                         const VprNetlistAnnotation& netlist_annotation,
+                                         const AtomNetId& atom_net) {
+  /* The net may be renamed as it contains special characters which violate Verilog syntax */
+  if (true == netlist_annotation.is_net_renamed(atom_net)) {
+    return netlist_annotation.net_name(atom_net);
+  }
+  return atom_ctx.nlist.net_name(atom_net);
+}
+
+/********************************************************************
+ * Generate the name of a net in the modules of a grid,
+ * which is the same as the port of the pre-configured FPGA top module
+ * Unconnected pins are tied to constant zero
+ *******************************************************************/
+static
+std::string generate_preconfig_tile_net_name(const AtomContext& atom_ctx,
+                                             const VprNetlistAnnotation& netlist_annotation,
+                                             const AtomNetId& atom_net) {
+  if (AtomNetId::INVALID() == atom_net) {
+    return std::string("1'b0");
+  }
+  return find_preconfig_tile_net_name(atom_ctx, netlist_annotation, atom_net) + std::string(FORMAL_VERIFICATION_TOP_MODULE_PORT_POSTFIX);
+}
+
+/********************************************************************
+ * Print module declaration and ports, which are the boundary nets of a grid
+ * The pre-configured grid and the reference sub-netlist share the same ports
+ *******************************************************************/
+static
+void print_verilog_preconfig_tile_module_declaration(std::fstream& fp,
+                                                     const std::string& module_name,
+                                                     const AtomContext& atom_ctx,
+                                                     const VprNetlistAnnotation& netlist_annotation,
+                                                     const PreconfigTileNetlist& tile_netlist) {
+  /* Validate the file stream */
+  valid_file_stream(fp);
+
+  fp << "module " << module_name;
+  fp << " (\n";
+
+  size_t port_counter = 0;
+  auto print_ports = [&](const std::set<AtomNetId>& atom_nets, const e_dump_verilog_port_type& port_type) {
+    for (const AtomNetId& atom_net : atom_nets) {
+      if (0 < port_counter) {
+        fp << ",\n";
+      }
+      BasicPort module_port(generate_preconfig_tile_net_name(atom_ctx, netlist_annotation, atom_net), 1);
+      fp << generate_verilog_port(port_type, module_port);
+      port_counter++;
+    }
+  };
+  print_ports(tile_netlist.inputs, VERILOG_PORT_INPUT);
+  print_ports(tile_netlist.outputs, VERILOG_PORT_OUTPUT);
+
+  fp << ");\n";
+
+  /* Add an empty line as a splitter */
+  fp << "\n";
+}
+
+/********************************************************************
+ * Generate the name of the grid module port which is modeled by
+ * a pin node of the routing resource graph
+ * Note: the name must be consistent with the ports added in build_grid_modules()!!!
+ *******************************************************************/
+static
+std::string generate_preconfig_tile_grid_port_name(const DeviceGrid& grids,
+                                                   const RRGraph& rr_graph,
+                                                   const VprDeviceAnnotation& device_annotation,
+                                                   const RRNodeId& pin_node) {
+  t_physical_tile_type_ptr grid_type = grids[rr_graph.node_xlow(pin_node)][rr_graph.node_ylow(pin_node)].type;
+  size_t grid_pin_index = rr_graph.node_pin_num(pin_node);
+  BasicPort grid_pin_info = device_annotation.physical_tile_pin_port_info(grid_type, grid_pin_index);
+  VTR_ASSERT(true == grid_pin_info.is_valid());
+  int subtile_index = device_annotation.physical_tile_pin_subtile_index(grid_type, grid_pin_index);
+  VTR_ASSERT(OPEN != subtile_index && subtile_index < grid_type->capacity);
+  return generate_grid_port_name(grid_type->pin_width_offset[grid_pin_index],
+                                 grid_type->pin_height_offset[grid_pin_index],
+                                 subtile_index,
+                                 rr_graph.node_side(pin_node),
+                                 grid_pin_info);
+}
+
+/********************************************************************
+ * Connect the global ports of a grid module to constants except
+ * the ports which are wired to the input nets of the grid, i.e.,
+ * - operating clocks, which follow the benchmark clocks as in the
+ *   pre-configured FPGA top module
+ * - global ports which are constrained to the nets of the benchmark
+ * The global ports of a grid module share the names of the global ports
+ * of the FPGA top module
+ *******************************************************************/
+static
+int print_verilog_preconfig_tile_module_connect_global_ports(std::fstream& fp,
+                                                             const ModuleManager& module_manager,
+                                                             const ModuleId& top_module,
+                                                             const ModuleId& grid_module,
+                                                             const PinConstraints& pin_constraints,
+                                                             const FabricGlobalPortInfo& fabric_global_ports,
+                                                             const std::vector<std::string>& benchmark_clock_port_names,
+                                                             const std::map<std::string, AtomNetId>& input_nets,
+                                                             std::set<AtomNetId>& connected_inputs) {
+  /* Validate the file stream */
+  valid_file_stream(fp);
+
+  print_verilog_comment(fp, std::string("----- Begin Connect Global ports of grid module -----"));
+
+  for (const FabricGlobalPortId& global_port_id : fabric_global_ports.global_ports()) {
+    BasicPort module_global_port = module_manager.module_port(top_module, fabric_global_ports.global_module_port(global_port_id));
+    ModulePortId grid_global_port_id = module_manager.find_module_port(grid_module, module_global_port.get_name());
+    if (false == module_manager.valid_module_port_id(grid_module, grid_global_port_id)) {
+      continue;
+    }
+    BasicPort grid_global_port = module_manager.module_port(grid_module, grid_global_port_id);
+    bool is_operating_clock = (true == fabric_global_ports.global_port_is_clock(global_port_id))
+                           && (false == fabric_global_ports.global_port_is_prog(global_port_id));
+
+    for (const size_t& pin : grid_global_port.pins()) {
+      BasicPort grid_global_pin(grid_global_port.get_name(), pin, pin);
+
+      /* If the global port name is in the pin constraints, we should wire it to the constrained pin */
+      std::string constrained_net_name = pin_constraints.pin_net(grid_global_pin);
+
+      std::string net_name_to_connect;
+      if ( (false == pin_constraints.unconstrained_net(constrained_net_name))
+        && (false == pin_constraints.unmapped_net(constrained_net_name)) ) {
+        net_name_to_connect = constrained_net_name;
+      } else if ( (true == is_operating_clock)
+               && (true == pin_constraints.unconstrained_net(constrained_net_name))
+               && (false == benchmark_clock_port_names.empty()) ) {
+        /* Otherwise, we must have a clear one-to-one clock net corresponding!!! */
+        if (benchmark_clock_port_names.size() != module_global_port.get_width()) {
+          VTR_LOG_ERROR("Unable to map %lu benchmark clocks to %lu clock pins of FPGA!\nRequire clear pin constraints!\n",
+                        benchmark_clock_port_names.size(),
+                        module_global_port.get_width());
+          return CMD_EXEC_FATAL_ERROR;
+        }
+        net_name_to_connect = benchmark_clock_port_names[pin - module_global_port.get_lsb()];
+      }
+
+      /* The net is wired only when the atoms of the grid consume it, otherwise give a default value */
+      auto result = input_nets.find(net_name_to_connect);
+      if (result != input_nets.end()) {
+        BasicPort benchmark_pin(net_name_to_connect + std::string(FORMAL_VERIFICATION_TOP_MODULE_PORT_POSTFIX), 1);
+        print_verilog_wire_connection(fp, grid_global_pin, benchmark_pin, false);
+        connected_inputs.insert(result->second);
+      } else {
+        std::vector<size_t> default_values(1, fabric_global_ports.global_port_default_value(global_port_id));
+        print_verilog_wire_constant_values(fp, grid_global_pin, default_values);
+      }
+    }
+  }
+
+  print_verilog_comment(fp, std::string("----- End Connect Global ports of grid module -----"));
+
+  /* Add an empty line as a splitter */
+  fp << "\n";
+
+  return CMD_EXEC_SUCCESS;
+}
+
+/********************************************************************
+ * Connect the pins of a grid module to the boundary nets
+ * - the output pins routed to the output nets drive the output ports
+ * - the input pins routed to the input nets are driven by the input ports
+ * - the input pins routed to the nets driven by the grid itself
+ *   are fed back from the output pins
+ * - the other input pins, including the configuration ports, are
+ *   connected to constant zero, as the bitstream is imposed directly
+ *******************************************************************/
+static
+int print_verilog_preconfig_tile_module_connect_pins(std::fstream& fp,
+                                                     const ModuleManager& module_manager,
+                                                     const ModuleId& grid_module,
+                                                     const std::string& grid_instance_name,
+                                                     const AtomContext& atom_ctx,
+                                                     const DeviceContext& device_ctx,
+                                                     const VprDeviceAnnotation& device_annotation,
+                                                     const VprRoutingAnnotation& routing_annotation,
+                                                     const VprNetlistAnnotation& netlist_annotation,
+                                                     const std::vector<RRNodeId>& grid_pin_nodes,
+                                                     const PreconfigTileNetlist& tile_netlist,
+                                                     std::set<AtomNetId>& connected_inputs) {
+  /* Validate the file stream */
+  valid_file_stream(fp);
+
+  print_verilog_comment(fp, std::string("----- Begin Connect pins of grid module -----"));
+
+  std::set<std::string> connected_ports;
+  /* The first output pin which carries a net, used to drive the output port and the feedback */
+  std::map<AtomNetId, BasicPort> net_output_pins;
+
+  /* Output pins come first, so that the feedback can be found by the input pins */
+  for (const t_rr_type& pin_type : {OPIN, IPIN}) {
+    for (const RRNodeId& pin_node : grid_pin_nodes) {
+      if (pin_type != device_ctx.rr_graph.node_type(pin_node)) {
+        continue;
+      }
+      std::string grid_port_name = generate_preconfig_tile_grid_port_name(device_ctx.grid, device_ctx.rr_graph,
+                                                                          device_annotation, pin_node);
+      ModulePortId grid_port_id = module_manager.find_module_port(grid_module, grid_port_name);
+      if (false == module_manager.valid_module_port_id(grid_module, grid_port_id)) {
+        VTR_LOG_ERROR("Unable to find the pin '%s' in grid '%s'!\nGrids with duplicated pins are not supported\n",
+                      grid_port_name.c_str(), grid_instance_name.c_str());
+        return CMD_EXEC_FATAL_ERROR;
+      }
+      BasicPort grid_port = module_manager.module_port(grid_module, grid_port_id);
+      AtomNetId atom_net = atom_ctx.lookup.atom_net(routing_annotation.rr_node_net(pin_node));
+      VTR_ASSERT(true == atom_ctx.nlist.valid_net_id(atom_net));
+      BasicPort net_port(generate_preconfig_tile_net_name(atom_ctx, netlist_annotation, atom_net), 1);
+
+      if (OPIN == pin_type) {
+        if ( (0 < tile_netlist.outputs.count(atom_net))
+          && (net_output_pins.end() == net_output_pins.find(atom_net)) ) {
+          print_verilog_wire_connection(fp, net_port, grid_port, false);
+        }
+        net_output_pins.insert(std::make_pair(atom_net, grid_port));
+        continue;
+      }
+
+      VTR_ASSERT(IPIN == pin_type);
+      if (0 < tile_netlist.inputs.count(atom_net)) {
+        print_verilog_wire_connection(fp, grid_port, net_port, false);
+        connected_inputs.insert(atom_net);
+      } else if (net_output_pins.end() != net_output_pins.find(atom_net)) {
+        print_verilog_wire_connection(fp, grid_port, net_output_pins.at(atom_net), false);
+      } else {
+        VTR_LOG_ERROR("Net '%s' is routed to pin '%s' of grid '%s' but is neither driven outside nor by an output pin of the grid!\n",
+                      atom_ctx.nlist.net_name(atom_net).c_str(), grid_port_name.c_str(), grid_instance_name.c_str());
+        return CMD_EXEC_FATAL_ERROR;
+      }
+      connected_ports.insert(grid_port_name);
+    }
+  }
+
+  /* Output nets which are not routed are left undriven */
+  for (const AtomNetId& atom_net : tile_netlist.outputs) {
+    if (net_output_pins.end() == net_output_pins.find(atom_net)) {
+      VTR_LOG_WARN("Output net '%s' of grid '%s' is not routed to any of its pins!\n",
+                   atom_ctx.nlist.net_name(atom_net).c_str(), grid_instance_name.c_str());
+    }
+  }
+
+  for (const BasicPort& grid_port : module_manager.module_ports_by_type(grid_module, ModuleManager::MODULE_INPUT_PORT)) {
+    if (0 < connected_ports.count(grid_port.get_name())) {
+      continue;
+    }
+    std::vector<size_t> default_values(grid_port.get_width(), 0);
+    print_verilog_wire_constant_values(fp, grid_port, default_values);
+  }
+
+  print_verilog_comment(fp, std::string("----- End Connect pins of grid module -----"));
+
+  /* Add an empty line as a splitter */
+  fp << "\n";
+
+  return CMD_EXEC_SUCCESS;
+}
+
+/********************************************************************
+ * Print a Verilog module which instanciates a pre-configured grid
+ *
+ *   Pre-configured grid
+ *                        +--------------------------------------------
+ *                        |
+ *                        |          Grid module
+ *                        |          +-------------------------------+
+ *                        |  0/1---->|Global ports                   |
+ *   benchmark_clock----->|--------->|Clock                          |
+ *   input_nets---------->|--------->|Input pins                     |
+ *   output_nets<---------|<---------|Output pins ---+               |
+ *                        |          |Input pins <---+ feedback      |
+ *                        |    0---->|Unused input pins              |
+ *   grid_bitstream------>|--------->|Internal_configuration_ports   |
+ *                        |          +-------------------------------+
+ *                        +-------------------------------------------
+ *******************************************************************/
+static
+int print_verilog_preconfig_tile_module(const ModuleManager& module_manager,
+                                        const BitstreamManager& bitstream_manager,
+                                        const ConfigBlockId& grid_block,
+                                        const ConfigProtocol& config_protocol,
+                                        const CircuitLibrary& circuit_lib,
+                                        const FabricGlobalPortInfo& global_ports,
+                                        const AtomContext& atom_ctx,
+                                        const DeviceContext& device_ctx,
+                                        const VprDeviceAnnotation& device_annotation,
+                                        const VprRoutingAnnotation& routing_annotation,
+                                        const PinConstraints& pin_constraints,
+                                        const VprNetlistAnnotation& netlist_annotation,
+                                        const std::vector<std::string>& benchmark_clock_port_names,
+                                        const ModuleId& top_module,
+                                        const ModuleId& grid_module,
+                                        const std::string& grid_instance_name,
+                                        const std::vector<RRNodeId>& grid_pin_nodes,
+                                        const PreconfigTileNetlist& tile_netlist,
+                                        const std::string& module_name,
+                                        const std::string& verilog_fname,
+                                        const bool& explicit_port_mapping,
+                                        const bool& fabric_signal_init,
+                                        const e_file_compression& compression) {
+  int status = CMD_EXEC_SUCCESS;
+
+  /* Create the file stream */
+  BufferedFileStream netlist_file(verilog_fname, compression);
+  std::fstream& fp = netlist_file.stream();
+
+  /* Validate the file stream */
+  check_file_stream(verilog_fname.c_str(), fp);
+
+  /* Generate a brief description on the Verilog file*/
+  std::string title = std::string("Verilog netlist for pre-configured grid '") + grid_instance_name + std::string("' by design: ") + atom_ctx.nlist.netlist_name();
+  print_verilog_file_header(fp, title);
+
+  print_verilog_default_net_type_declaration(fp,
+                                             VERILOG_DEFAULT_NET_TYPE_NONE);
+
+  /* Print module declaration and ports */
+  print_verilog_preconfig_tile_module_declaration(fp, module_name, atom_ctx, netlist_annotation, tile_netlist);
+
+  /* Print internal wires */
+  print_verilog_preconfig_top_module_internal_wires(fp, module_manager, grid_module);
+
+  /* Instanciate the grid module */
+  print_verilog_testbench_fpga_instance(fp, module_manager, grid_module,
+                                        std::string(FORMAL_VERIFICATION_TOP_MODULE_UUT_NAME),
+                                        explicit_port_mapping);
+
+  std::map<std::string, AtomNetId> input_nets;
+  for (const AtomNetId& atom_net : tile_netlist.inputs) {
+    input_nets[find_preconfig_tile_net_name(atom_ctx, netlist_annotation, atom_net)] = atom_net;
+  }
+  std::set<AtomNetId> connected_inputs;
+
+  status = print_verilog_preconfig_tile_module_connect_global_ports(fp, module_manager, top_module, grid_module,
+                                                                    pin_constraints, global_ports,
+                                                                    benchmark_clock_port_names,
+                                                                    input_nets, connected_inputs);
+  if (CMD_EXEC_FATAL_ERROR == status) {
+    return status;
+  }
+
+  status = print_verilog_preconfig_tile_module_connect_pins(fp, module_manager, grid_module, grid_instance_name,
+                                                            atom_ctx, device_ctx, device_annotation,
+                                                            routing_annotation, netlist_annotation,
+                                                            grid_pin_nodes, tile_netlist,
+                                                            connected_inputs);
+  if (CMD_EXEC_FATAL_ERROR == status) {
+    return status;
+  }
+
+  /* Input nets which are not wired are consumed by nothing in the pre-configured grid */
+  for (const AtomNetId& atom_net : tile_netlist.inputs) {
+    if (0 == connected_inputs.count(atom_net)) {
+      VTR_LOG_WARN("Input net '%s' of grid '%s' is not wired to any of its pins!\n",
+                   atom_ctx.nlist.net_name(atom_net).c_str(), grid_instance_name.c_str());
+    }
+  }
+
+  /* Assign the SRAM model applied to the FPGA fabric */
+  CircuitModelId sram_model = config_protocol.memory_model();
+  VTR_ASSERT(true == circuit_lib.valid_model_id(sram_model));
+
+  /* Assign the internal SRAM/Memory ports of the grid to bitstream values.
+   * A grid without any configuration bit has no block in the bitstream
+   */
+  if (true == bitstream_manager.valid_block_id(grid_block)) {
+    print_verilog_preconfig_top_module_load_bitstream(fp, circuit_lib, sram_model,
+                                                      bitstream_manager,
+                                                      grid_block,
+                                                      std::string());
+  }
+
+  /* Add signal initialization, only for the primitives with user-defined netlists
+   * when the primitive modules of the fabric initialize their own drivers
+   */
+  print_verilog_testbench_signal_initialization(fp,
+                                                std::string(FORMAL_VERIFICATION_TOP_MODULE_UUT_NAME),
+                                                circuit_lib,
+                                                module_manager,
+                                                grid_module,
+                                                fabric_signal_init);
+
+  print_verilog_module_end(fp, module_name);
+
+  /* Close the file stream */
+  netlist_file.close();
+
+  return status;
+}
+
+/********************************************************************
+ * Print the logic of a LUT of the design as a sum of products,
+ * where the columns of the truth table follow the input pins,
+ * as in the BLIF written by VPR
+ *******************************************************************/
+static
+void print_verilog_preconfig_tile_reference_lut(std::fstream& fp,
+                                                const AtomContext& atom_ctx,
+                                                const VprNetlistAnnotation& netlist_annotation,
+                                                const AtomBlockId& atom_blk) {
+  auto output_pins = atom_ctx.nlist.block_output_pins(atom_blk);
+  if (1 != output_pins.size()) {
+    return;
+  }
+  AtomNetId output_net = atom_ctx.nlist.pin_net(*output_pins.begin());
+  if (AtomNetId::INVALID() == output_net) {
+    return;
+  }
+
+  std::vector<std::string> input_names;
+  for (const AtomPinId& input_pin : atom_ctx.nlist.block_input_pins(atom_blk)) {
+    input_names.push_back(generate_preconfig_tile_net_name(atom_ctx, netlist_annotation, atom_ctx.nlist.pin_net(input_pin)));
+  }
+
+  const AtomNetlist::TruthTable& truth_table = atom_ctx.nlist.block_truth_table(atom_blk);
+  bool on_set = truth_table_encodes_on_set(truth_table);
+
+  std::string cover;
+  for (const std::vector<vtr::LogicValue>& row : truth_table) {
+    VTR_ASSERT(row.size() == input_names.size() + 1);
+    std::string cube;
+    for (size_t icol = 0; icol < input_names.size(); ++icol) {
+      if (vtr::LogicValue::DONT_CARE == row[icol]) {
+        continue;
+      }
+      if (false == cube.empty()) {
+        cube += std::string(" & ");
+      }
+      if (vtr::LogicValue::FALSE == row[icol]) {
+        cube += std::string("~");
+      }
+      cube += input_names[icol];
+    }
+    /* A cube without any literal covers all the input values */
+    if (true == cube.empty()) {
+      cube = std::string("1'b1");
+    }
+    if (false == cover.empty()) {
+      cover += std::string(" | ");
+    }
+    cover += std::string("(") + cube + std::string(")");
+  }
+  /* An empty cover is a constant zero */
+  if (true == cover.empty()) {
+    cover = std::string("1'b0");
+  }
+
+  fp << "\tassign " << generate_preconfig_tile_net_name(atom_ctx, netlist_annotation, output_net) << " = ";
+  if (false == on_set) {
+    fp << "~(" << cover << ")";
+  } else {
+    fp << cover;
+  }
+  fp << ";\n";
+}
+
+/********************************************************************
+ * Print a latch of the design as a rising-edge flip-flop
+ *******************************************************************/
+static
+void print_verilog_preconfig_tile_reference_latch(std::fstream& fp,
+                                                  const AtomContext& atom_ctx,
+                                                  const VprNetlistAnnotation& netlist_annotation,
+                                                  const AtomBlockId& atom_blk,
+                                                  const size_t& latch_index) {
+  auto input_pins = atom_ctx.nlist.block_input_pins(atom_blk);
+  auto output_pins = atom_ctx.nlist.block_output_pins(atom_blk);
+  auto clock_pins = atom_ctx.nlist.block_clock_pins(atom_blk);
+  if ( (1 != input_pins.size()) || (1 != output_pins.size()) || (1 != clock_pins.size()) ) {
+    VTR_LOG_WARN("Skip latch '%s' which does not have its data, clock and output connected\n",
+                 atom_ctx.nlist.block_name(atom_blk).c_str());
+    return;
+  }
+
+  BasicPort reg_port(std::string("latch_") + std::to_string(latch_index) + std::string("_q"), 1);
+  fp << "\t" << generate_verilog_port(VERILOG_PORT_REG, reg_port) << ";\n";
+  fp << "\talways @(posedge " << generate_preconfig_tile_net_name(atom_ctx, netlist_annotation, atom_ctx.nlist.pin_net(*clock_pins.begin())) << ") begin\n";
+  fp << "\t\t" << reg_port.get_name() << " <= " << generate_preconfig_tile_net_name(atom_ctx, netlist_annotation, atom_ctx.nlist.pin_net(*input_pins.begin())) << ";\n";
+  fp << "\tend\n";
+  fp << "\tassign " << generate_preconfig_tile_net_name(atom_ctx, netlist_annotation, atom_ctx.nlist.pin_net(*output_pins.begin()));
+  fp << " = " << reg_port.get_name() << ";\n";
+}
+
+/********************************************************************
+ * Print an instance of a black-box model of the design
+ * The module of the model is defined by the user library
+ * Unconnected input bits are tied to constant zero, while
+ * unconnected output bits are wired to dangling wires
+ *******************************************************************/
+static
+void print_verilog_preconfig_tile_reference_subckt(std::fstream& fp,
+                                                   const AtomContext& atom_ctx,
+                                                   const VprNetlistAnnotation& netlist_annotation,
+                                                   const AtomBlockId& atom_blk,
+                                                   const size_t& subckt_index) {
+  std::string instance_name = std::string(atom_ctx.nlist.block_model(atom_blk)->name) + std::string("_") + std::to_string(subckt_index);
+
+  /* Declare dangling wires for the unconnected output bits */
+  for (const AtomPortId& atom_port : atom_ctx.nlist.block_output_ports(atom_blk)) {
+    for (size_t bit = 0; bit < atom_ctx.nlist.port_width(atom_port); ++bit) {
+      if (AtomNetId::INVALID() == atom_ctx.nlist.port_net(atom_port, bit)) {
+        BasicPort dangling_wire(instance_name + std::string("_") + atom_ctx.nlist.port_name(atom_port) + std::string("_") + std::to_string(bit), 1);
+        fp << "\t" << generate_verilog_port(VERILOG_PORT_WIRE, dangling_wire) << ";\n";
+      }
+    }
+  }
+
+  fp << "\t" << atom_ctx.nlist.block_model(atom_blk)->name << " " << instance_name << " (";
+  size_t port_counter = 0;
+  for (const AtomPortId& atom_port : atom_ctx.nlist.block_ports(atom_blk)) {
+    if (0 < port_counter) {
+      fp << ",";
+    }
+    fp << "\n\t\t." << atom_ctx.nlist.port_name(atom_port) << "({";
+    /* Concatenate from the MSB to the LSB */
+    for (size_t bit = atom_ctx.nlist.port_width(atom_port); bit > 0; --bit) {
+      if (bit < atom_ctx.nlist.port_width(atom_port)) {
+        fp << ", ";
+      }
+      AtomNetId atom_net = atom_ctx.nlist.port_net(atom_port, bit - 1);
+      if (AtomNetId::INVALID() != atom_net) {
+        fp << generate_preconfig_tile_net_name(atom_ctx, netlist_annotation, atom_net);
+      } else if (PortType::OUTPUT == atom_ctx.nlist.port_type(atom_port)) {
+        fp << instance_name << "_" << atom_ctx.nlist.port_name(atom_port) << "_" << bit - 1;
+      } else {
+        fp << "1'b0";
+      }
+    }
+    fp << "})";
+    port_counter++;
+  }
+  fp << ");\n";
+}
+
+/********************************************************************
+ * Print a Verilog module of the sub-netlist of the design mapped to a grid
+ * - LUTs are written as sums of products of their truth tables
+ * - Latches are written as rising-edge flip-flops
+ * - Other models are instanciated as black boxes,
+ *   whose modules should be defined by the user library
+ *******************************************************************/
+static
+void print_verilog_preconfig_tile_reference_module(const AtomContext& atom_ctx,
+                                                   const VprNetlistAnnotation& netlist_annotation,
+                                                   const std::string& grid_instance_name,
+                                                   const PreconfigTileNetlist& tile_netlist,
+                                                   const std::string& module_name,
+                                                   const std::string& verilog_fname,
+                                                   const e_file_compression& compression) {
+  /* Create the file stream */
+  BufferedFileStream netlist_file(verilog_fname, compression);
+  std::fstream& fp = netlist_file.stream();
+
+  /* Validate the file stream */
+  check_file_stream(verilog_fname.c_str(), fp);
+
+  /* Generate a brief description on the Verilog file*/
+  std::string title = std::string("Verilog netlist of the design '") + atom_ctx.nlist.netlist_name() + std::string("' mapped to grid '") + grid_instance_name + std::string("'");
+  print_verilog_file_header(fp, title);
+
+  print_verilog_default_net_type_declaration(fp,
+                                             VERILOG_DEFAULT_NET_TYPE_NONE);
+
+  /* Print module declaration and ports */
+  print_verilog_preconfig_tile_module_declaration(fp, module_name, atom_ctx, netlist_annotation, tile_netlist);
+
+  print_verilog_comment(fp, std::string("----- Local wires of the design -----"));
+  for (const AtomNetId& atom_net : tile_netlist.internal_nets) {
+    BasicPort net_wire(generate_preconfig_tile_net_name(atom_ctx, netlist_annotation, atom_net), 1);
+    fp << "\t" << generate_verilog_port(VERILOG_PORT_WIRE, net_wire) << ";\n";
+  }
+  /* Add an empty line as a splitter */
+  fp << "\n";
+
+  size_t num_latches = 0;
+  size_t num_subckts = 0;
+  for (const AtomBlockId& atom_blk : tile_netlist.atoms) {
+    std::string model_name(atom_ctx.nlist.block_model(atom_blk)->name);
+    if (model_name == std::string(MODEL_NAMES)) {
+      print_verilog_preconfig_tile_reference_lut(fp, atom_ctx, netlist_annotation, atom_blk);
+    } else if (model_name == std::string(MODEL_LATCH)) {
+      print_verilog_preconfig_tile_reference_latch(fp, atom_ctx, netlist_annotation, atom_blk, num_latches);
+      num_latches++;
+    } else {
+      print_verilog_preconfig_tile_reference_subckt(fp, atom_ctx, netlist_annotation, atom_blk, num_subckts);
+      num_subckts++;
+    }
+  }
+
+  print_verilog_module_end(fp, module_name);
+
+  /* Close the file stream */
+  netlist_file.close();
+}
+
+/********************************************************************
+ * Top-level function to generate, for each grid used by a design,
+ * a pre-configured grid module and the reference sub-netlist of the design,
+ * which are named after the design and the instance of the grid:
+ *   <circuit_name>_<grid_instance_name>_tile_formal_verification
+ *   <circuit_name>_<grid_instance_name>_tile_reference
+ *
+ * The boundary nets are the ports of both modules, so that the grids
+ * can be checked by formal equivalence tools in independent jobs
+ * The I/O grids, and the grids which contain any I/O of the design,
+ * are skipped, since they are the boundary of the pre-configured FPGA top module
+ *
+ * Note that the top-level module should instanciate the grids
+ * directly, i.e., without tiles, and that grids with duplicated pins
+ * are not supported
+ *******************************************************************/
+int print_verilog_preconfig_tile_modules(const ModuleManager& module_manager,
+                                         const BitstreamManager& bitstream_manager,
+                                         const ConfigProtocol& config_protocol,
+                                         const CircuitLibrary& circuit_lib,
+                                         const FabricGlobalPortInfo& global_ports,
+                                         const AtomContext& atom_ctx,
+                                         const DeviceContext& device_ctx,
+                                         const VprDeviceAnnotation& device_annotation,
+                                         const VprPlacementAnnotation& place_annotation,
+                                         const VprRoutingAnnotation& routing_annotation,
+                                         const PinConstraints& pin_constraints,
+                                         const VprNetlistAnnotation& netlist_annotation,
+                                         const std::string& circuit_name,
+                                         const std::string& verilog_dir,
+                                         const bool& explicit_port_mapping,
+                                         const bool& fabric_signal_init,
+                                         const e_file_compression& compression,
+                                         const bool& verbose) {
+  std::string timer_message = std::string("Write pre-configured grid Verilog netlists for design '") + circuit_name + std::string("'");
+
+  int status = CMD_EXEC_SUCCESS;
+
+  /* Start time count */
+  vtr::ScopedStartFinishTimer timer(timer_message);
+
+  const DeviceGrid& grids = device_ctx.grid;
+  const RRGraph& rr_graph = device_ctx.rr_graph;
+
+  /* Find the top_module */
+  ModuleId top_module = module_manager.find_module(generate_fpga_top_module_name());
+  VTR_ASSERT(true == module_manager.valid_module_id(top_module));
+
+  /* Ensure that the top block is the module we want to replace! */
+  std::vector<ConfigBlockId> top_blocks = find_bitstream_manager_top_blocks(bitstream_manager);
+  VTR_ASSERT(1 == top_blocks.size());
+  VTR_ASSERT(0 == module_manager.module_name(top_module).compare(bitstream_manager.block_name(top_blocks[0])));
+
+  /* Collect the atoms of each cluster */
+  std::map<ClusterBlockId, std::vector<AtomBlockId>> cluster_atoms;
+  for (const AtomBlockId& atom_blk : atom_ctx.nlist.blocks()) {
+    cluster_atoms[atom_ctx.lookup.atom_clb(atom_blk)].push_back(atom_blk);
+  }
+
+  /* Collect the routed pins of each grid, indexed by the root of the grid */
+  vtr::Matrix<std::vector<RRNodeId>> grid_pin_nodes({grids.width(), grids.height()});
+  for (const RRNodeId& node : rr_graph.nodes()) {
+    if ( (IPIN != rr_graph.node_type(node)) && (OPIN != rr_graph.node_type(node)) ) {
+      continue;
+    }
+    if (ClusterNetId::INVALID() == routing_annotation.rr_node_net(node)) {
+      continue;
+    }
+    size_t ix = rr_graph.node_xlow(node);
+    size_t iy = rr_graph.node_ylow(node);
+    grid_pin_nodes[ix - grids[ix][iy].width_offset][iy - grids[ix][iy].height_offset].push_back(node);
+  }
+
+  /* Find clock ports in benchmark */
+  std::vector<std::string> benchmark_clock_port_names = find_atom_netlist_clock_port_names(atom_ctx.nlist, netlist_annotation);
+
+  size_t num_tiles = 0;
+  vtr::Point<size_t> device_size(grids.width(), grids.height());
+  std::string grid_module_name_prefix(GRID_MODULE_NAME_PREFIX);
+  for (size_t ix = 0; ix < grids.width(); ++ix) {
+    for (size_t iy = 0; iy < grids.height(); ++iy) {
+      t_physical_tile_type_ptr grid_type = grids[ix][iy].type;
+      if ( (true == is_empty_type(grid_type))
+        || (true == is_io_type(grid_type))
+        || (0 < grids[ix][iy].width_offset)
+        || (0 < grids[ix][iy].height_offset) ) {
+        continue;
+      }
+      vtr::Point<size_t> grid_coord(ix, iy);
+
+      /* Collect the atoms mapped to the grid, and skip the grids with any I/O of the design */
+      std::set<ClusterBlockId> grid_clusters;
+      std::vector<AtomBlockId> grid_atoms;
+      bool contain_io = false;
+      for (const ClusterBlockId& grid_block : place_annotation.grid_blocks(grid_coord)) {
+        if (ClusterBlockId::INVALID() == grid_block) {
+          continue;
+        }
+        grid_clusters.insert(grid_block);
+        for (const AtomBlockId& atom_blk : cluster_atoms[grid_block]) {
+          contain_io |= (AtomBlockType::BLOCK != atom_ctx.nlist.block_type(atom_blk));
+          grid_atoms.push_back(atom_blk);
+        }
+      }
+      if ( (true == grid_atoms.empty()) || (true == contain_io) ) {
+        continue;
+      }
+
+      /* Note: the names must be consistent with the instance names used in build_top_module()!!! */
+      e_side border_side = find_grid_border_side(device_size, grid_coord);
+      std::string grid_instance_name = generate_grid_block_instance_name(grid_module_name_prefix, std::string(grid_type->name), is_io_type(grid_type), border_side, grid_coord);
+      ModuleId grid_module = module_manager.find_module(generate_grid_block_module_name_in_top_module(grid_module_name_prefix, grids, grid_coord));
+      VTR_ASSERT(true == module_manager.valid_module_id(grid_module));
+
+      PreconfigTileNetlist tile_netlist = build_preconfig_tile_netlist(atom_ctx, grid_clusters, grid_atoms);
+
+      std::string tile_name = circuit_name + std::string("_") + grid_instance_name;
+      status = print_verilog_preconfig_tile_module(module_manager, bitstream_manager,
+                                                   bitstream_manager.find_child_block(top_blocks[0], grid_instance_name),
+                                                   config_protocol, circuit_lib, global_ports,
+                                                   atom_ctx, device_ctx, device_annotation,
+                                                   routing_annotation, pin_constraints, netlist_annotation,
+                                                   benchmark_clock_port_names,
+                                                   top_module, grid_module, grid_instance_name,
+                                                   grid_pin_nodes[ix][iy], tile_netlist,
+                                                   tile_name + std::string(FORMAL_VERIFICATION_TILE_MODULE_POSTFIX),
+                                                   verilog_dir + tile_name + std::string(FORMAL_VERIFICATION_TILE_VERILOG_FILE_POSTFIX),
+                                                   explicit_port_mapping,
+                                                   fabric_signal_init,
+                                                   compression);
+      if (CMD_EXEC_FATAL_ERROR == status) {
+        return status;
+      }
+
+      print_verilog_preconfig_tile_reference_module(atom_ctx, netlist_annotation,
+                                                    grid_instance_name, tile_netlist,
+                                                    tile_name + std::string(FORMAL_VERIFICATION_TILE_REFERENCE_MODULE_POSTFIX),
+                                                    verilog_dir + tile_name + std::string(FORMAL_VERIFICATION_TILE_REFERENCE_VERILOG_FILE_POSTFIX),
+                                                    compression);
+
+      VTR_LOGV(verbose,
+               "Written pre-configured grid '%s' with %lu atoms, %lu inputs and %lu outputs\n",
+               grid_instance_name.c_str(), grid_atoms.size(),
+               tile_netlist.inputs.size(), tile_netlist.outputs.size());
+      num_tiles++;
+    }
+  }
+
+  VTR_LOG("Written %lu pre-configured grids and their reference netlists\n", num_tiles);
+
+  return status;
+}
+
+} /* end namespace openfpga */
@@ -0,0 +1,49 @@
+#ifndef VERILOG_PRECONFIG_TILE_MODULE_H
+#define VERILOG_PRECONFIG_TILE_MODULE_H
+
+/********************************************************************
+ * Include header files that are required by function declaration
+ *******************************************************************/
+#include <string>
+#include "openfpga_compressed_stream.h"
+#include "circuit_library.h"
+#include "vpr_context.h"
+#include "module_manager.h"
+#include "bitstream_manager.h"
+#include "pin_constraints.h"
+#include "fabric_global_port_info.h"
+#include "config_protocol.h"
+#include "vpr_device_annotation.h"
+#include "vpr_netlist_annotation.h"
+#include "vpr_placement_annotation.h"
+#include "vpr_routing_annotation.h"
+
+/********************************************************************
+ * Function declaration
+ *******************************************************************/
+
+/* begin namespace openfpga */
+namespace openfpga {
+
+int print_verilog_preconfig_tile_modules(const ModuleManager& module_manager,
+                                         const BitstreamManager& bitstream_manager,
+                                         const ConfigProtocol& config_protocol,
+                                         const CircuitLibrary& circuit_lib,
+                                         const FabricGlobalPortInfo& global_ports,
+                                         const AtomContext& atom_ctx,
+                                         const DeviceContext& device_ctx,
+                                         const VprDeviceAnnotation& device_annotation,
+                                         const VprPlacementAnnotation& place_annotation,
+                                         const VprRoutingAnnotation& routing_annotation,
+                                         const PinConstraints& pin_constraints,
+                                         const VprNetlistAnnotation& netlist_annotation,
+                                         const std::string& circuit_name,
+                                         const std::string& verilog_dir,
+                                         const bool& explicit_port_mapping,
+                                         const bool& fabric_signal_init,
+                                         const e_file_compression& compression,
+                                         const bool& verbose);
+
+} /* end namespace openfpga */
+
+#endif
@@ -2,6 +2,7 @@
  * This file includes functions that are used to generate
  * a Verilog module of a pre-configured FPGA fabric
  *******************************************************************/
+#include <algorithm>
 #include <fstream>
 
 /* Headers from vtrutil library */
@@ -14,6 +15,7 @@
 /* Headers from openfpgautil library */
 #include "openfpga_port.h"
 #include "openfpga_digest.h"
+#include "openfpga_buffered_file_stream.h"
 
 #include "bitstream_manager_utils.h"
 #include "openfpga_atom_netlist_utils.h"
@@ -44,7 +46,7 @@ void print_verilog_preconfig_top_module_ports(std::fstream &fp,
 
   /* Module declaration */
   fp << "module " << circuit_name << std::string(FORMAL_VERIFICATION_TOP_MODULE_POSTFIX);
-  fp << " (" << std::endl;
+  fp << " (\n";
 
   /* Add module ports */
   size_t port_counter = 0;
@@ -68,7 +70,7 @@ void print_verilog_preconfig_top_module_ports(std::fstream &fp,
     }
 
     if (0 < port_counter) {
-      fp << "," << std::endl;
+      fp << ",\n";
     }
     /* Both input and output ports have only size of 1 */
     BasicPort module_port(std::string(block_name + std::string(FORMAL_VERIFICATION_TOP_MODULE_PORT_POSTFIX)), 1);
@@ -78,10 +80,10 @@ void print_verilog_preconfig_top_module_ports(std::fstream &fp,
     port_counter++;
   }
 
-  fp << ");" << std::endl;
+  fp << ");\n";
 
   /* Add an empty line as a splitter */
-  fp << std::endl;
+  fp << "\n";
 }
 
 /********************************************************************
@@ -89,7 +91,6 @@ void print_verilog_preconfig_top_module_ports(std::fstream &fp,
  * The internal wires are tailored for the ports of FPGA top module
  * which will be different in various configuration protocols
  *******************************************************************/
-static 
 void print_verilog_preconfig_top_module_internal_wires(std::fstream &fp,
                                                        const ModuleManager &module_manager,
                                                        const ModuleId &top_module) {
@@ -100,10 +101,10 @@ void print_verilog_preconfig_top_module_internal_wires(std::fstream &fp,
   print_verilog_comment(fp, std::string("----- Local wires for FPGA fabric -----"));
   for (const ModulePortId &module_port_id : module_manager.module_ports(top_module)) {
     BasicPort module_port = module_manager.module_port(top_module, module_port_id);
-    fp << generate_verilog_port(VERILOG_PORT_WIRE, module_port) << ";" << std::endl;
+    fp << generate_verilog_port(VERILOG_PORT_WIRE, module_port) << ";\n";
   }
   /* Add an empty line as a splitter */
-  fp << std::endl;
+  fp << "\n";
 }
 
 /********************************************************************
@@ -193,11 +194,65 @@ int print_verilog_preconfig_top_module_connect_global_ports(std::fstream &fp,
   print_verilog_comment(fp, std::string("----- End Connect Global ports of FPGA top module -----"));
 
   /* Add an empty line as a splitter */
-  fp << std::endl;
+  fp << "\n";
 
   return CMD_EXEC_SUCCESS;
 }
 
+/********************************************************************
+ * Visit the blocks with configuration bits in the bitstream manager
+ * with the hierarchical path of their configuration memories, i.e.,
+ *   <uut_instance>.<block>. ... .<block>.
+ * The root block is replaced by the instance name of the module under test,
+ * which is either the FPGA top module or one of its grids
+ *******************************************************************/
+static 
+void visit_preconfig_top_module_config_blocks(const BitstreamManager &bitstream_manager,
+                                              const ConfigBlockId &root_block,
+                                              const BitstreamBlockPathVisitor& visitor) {
+  visit_bitstream_manager_block_paths(bitstream_manager, root_block,
+                                      std::string(FORMAL_VERIFICATION_TOP_MODULE_UUT_NAME),
+                                      std::string("."),
+                                      [&](const ConfigBlockId& config_block_id, const std::string& block_path) {
+                                        /* We only cares blocks with configuration bits */
+                                        if (0 == bitstream_manager.block_bits(config_block_id).size()) {
+                                          return;
+                                        }
+                                        visitor(config_block_id, block_path + std::string("."));
+                                      });
+}
+
+/********************************************************************
+ * Generate the value to be imposed on the configuration memories of a block
+ * - Without memory file, the values are constants in the netlist
+ * - With memory file, the values are the word of the block in the memory,
+ *   where the first bit of the block is the MSB of the word
+ *******************************************************************/
+static 
+std::string generate_preconfig_top_module_bitstream_values(const BitstreamManager &bitstream_manager,
+                                                           const std::vector<ConfigBitId>& block_bits,
+                                                           const bool& use_bitstream_memory,
+                                                           const size_t& word_index,
+                                                           const bool& inverted) {
+  if (false == use_bitstream_memory) {
+    std::vector<size_t> config_data_values;
+    config_data_values.reserve(block_bits.size());
+    for (const ConfigBitId config_bit : block_bits) {
+      config_data_values.push_back(inverted != bitstream_manager.bit_value(config_bit));
+    }
+    return generate_verilog_constant_values(config_data_values);
+  }
+
+  std::string word_value;
+  if (true == inverted) {
+    word_value += std::string("~");
+  }
+  word_value += std::string(FORMAL_VERIFICATION_TOP_MODULE_BITSTREAM_MEMORY_NAME);
+  word_value += std::string("[") + std::to_string(word_index) + std::string("]");
+  word_value += std::string("[") + std::to_string(block_bits.size() - 1) + std::string(":0]");
+  return word_value;
+}
+
 /********************************************************************
  * Impose the bitstream on the configuration memories
  * This function uses 'assign' syntax to impost the bitstream at mem port
@@ -205,80 +260,50 @@ int print_verilog_preconfig_top_module_connect_global_ports(std::fstream &fp,
  *******************************************************************/
 static 
 void print_verilog_preconfig_top_module_assign_bitstream(std::fstream &fp,
-                                                         const ModuleManager &module_manager,
-                                                         const ModuleId &top_module,
                                                          const BitstreamManager &bitstream_manager,
+                                                         const ConfigBlockId &root_block,
+                                                         const bool& use_bitstream_memory,
                                                          const bool& output_datab_bits) {
   /* Validate the file stream */
   valid_file_stream(fp);
 
   print_verilog_comment(fp, std::string("----- Begin assign bitstream to configuration memories -----"));
 
-  for (const ConfigBlockId &config_block_id : bitstream_manager.blocks()) {
-    /* We only cares blocks with configuration bits */
-    if (0 == bitstream_manager.block_bits(config_block_id).size()) {
-      continue;
-    }
-    /* Build the hierarchical path of the configuration bit in modules */
-    std::vector<ConfigBlockId> block_hierarchy = find_bitstream_manager_block_hierarchy(bitstream_manager, config_block_id);
-    /* Drop the first block, which is the top module, it should be replaced by the instance name here */
-    /* Ensure that this is the module we want to drop! */
-    VTR_ASSERT(0 == module_manager.module_name(top_module).compare(bitstream_manager.block_name(block_hierarchy[0])));
-    block_hierarchy.erase(block_hierarchy.begin());
-    /* Build the full hierarchy path */
-    std::string bit_hierarchy_path(FORMAL_VERIFICATION_TOP_MODULE_UUT_NAME);
-    for (const ConfigBlockId &temp_block : block_hierarchy) {
-      bit_hierarchy_path += std::string(".");
-      bit_hierarchy_path += bitstream_manager.block_name(temp_block);
-    }
-    bit_hierarchy_path += std::string(".");
+  size_t word_index = 0;
+  visit_preconfig_top_module_config_blocks(bitstream_manager, root_block,
+                                           [&](const ConfigBlockId& config_block_id, const std::string& bit_hierarchy_path) {
+    std::vector<ConfigBitId> block_bits = bitstream_manager.block_bits(config_block_id);
 
     /* Find the bit index in the parent block */
     BasicPort config_data_port(bit_hierarchy_path + generate_configurable_memory_data_out_name(),
-                               bitstream_manager.block_bits(config_block_id).size());
+                               block_bits.size());
 
     /* Wire it to the configuration bit: access both data out and data outb ports */
-    std::vector<size_t> config_data_values;
-    for (const ConfigBitId config_bit : bitstream_manager.block_bits(config_block_id)) {
-      config_data_values.push_back(bitstream_manager.bit_value(config_bit));
-    }
-    print_verilog_wire_constant_values(fp, config_data_port, config_data_values);
-  }
+    fp << "\tassign " << generate_verilog_port(VERILOG_PORT_CONKT, config_data_port) << " = ";
+    fp << generate_preconfig_top_module_bitstream_values(bitstream_manager, block_bits, use_bitstream_memory, word_index, false);
+    fp << ";\n";
+    word_index++;
+  });
 
   if (true == output_datab_bits) {
-    fp << "initial begin" << std::endl;
+    fp << "initial begin\n";
 
-    for (const ConfigBlockId &config_block_id : bitstream_manager.blocks()) {
-      /* We only cares blocks with configuration bits */
-      if (0 == bitstream_manager.block_bits(config_block_id).size()) {
-        continue;
-      }
-      /* Build the hierarchical path of the configuration bit in modules */
-      std::vector<ConfigBlockId> block_hierarchy = find_bitstream_manager_block_hierarchy(bitstream_manager, config_block_id);
-      /* Drop the first block, which is the top module, it should be replaced by the instance name here */
-      /* Ensure that this is the module we want to drop! */
-      VTR_ASSERT(0 == module_manager.module_name(top_module).compare(bitstream_manager.block_name(block_hierarchy[0])));
-      block_hierarchy.erase(block_hierarchy.begin());
-      /* Build the full hierarchy path */
-      std::string bit_hierarchy_path(FORMAL_VERIFICATION_TOP_MODULE_UUT_NAME);
-      for (const ConfigBlockId &temp_block : block_hierarchy) {
-        bit_hierarchy_path += std::string(".");
-        bit_hierarchy_path += bitstream_manager.block_name(temp_block);
-      }
-      bit_hierarchy_path += std::string(".");
+    word_index = 0;
+    visit_preconfig_top_module_config_blocks(bitstream_manager, root_block,
+                                             [&](const ConfigBlockId& config_block_id, const std::string& bit_hierarchy_path) {
+      std::vector<ConfigBitId> block_bits = bitstream_manager.block_bits(config_block_id);
 
       /* Find the bit index in the parent block */
       BasicPort config_datab_port(bit_hierarchy_path + generate_configurable_memory_inverted_data_out_name(),
-                                  bitstream_manager.block_bits(config_block_id).size());
+                                  block_bits.size());
 
-      std::vector<size_t> config_datab_values;
-      for (const ConfigBitId config_bit : bitstream_manager.block_bits(config_block_id)) {
-        config_datab_values.push_back(!bitstream_manager.bit_value(config_bit));
-      }
-      print_verilog_force_wire_constant_values(fp, config_datab_port, config_datab_values);
-    }
+      fp << "\tforce " << generate_verilog_port(VERILOG_PORT_CONKT, config_datab_port) << " = ";
+      fp << generate_preconfig_top_module_bitstream_values(bitstream_manager, block_bits, use_bitstream_memory, word_index, true);
+      fp << ";\n";
+      word_index++;
+    });
 
-    fp << "end" << std::endl;
+    fp << "end\n";
   }
 
   print_verilog_comment(fp, std::string("----- End assign bitstream to configuration memories -----"));
@@ -287,84 +312,131 @@ void print_verilog_preconfig_top_module_assign_bitstream(std::fstream &fp,
 /********************************************************************
  * Impose the bitstream on the configuration memories
  * This function uses '$deposit' syntax to do so
+ * Since $deposit is applied only once, the memory file, if used,
+ * should be read in the same initial block before any $deposit
  *******************************************************************/
 static 
 void print_verilog_preconfig_top_module_deposit_bitstream(std::fstream &fp,
-                                                          const ModuleManager &module_manager,
-                                                          const ModuleId &top_module,
                                                           const BitstreamManager &bitstream_manager,
+                                                          const ConfigBlockId &root_block,
+                                                          const std::string& bitstream_memory_fname,
                                                           const bool& output_datab_bits) {
   /* Validate the file stream */
   valid_file_stream(fp);
 
+  bool use_bitstream_memory = !bitstream_memory_fname.empty();
+
   print_verilog_comment(fp, std::string("----- Begin deposit bitstream to configuration memories -----"));
 
-  fp << "initial begin" << std::endl;
+  fp << "initial begin\n";
 
-  for (const ConfigBlockId &config_block_id : bitstream_manager.blocks()) {
-    /* We only cares blocks with configuration bits */
-    if (0 == bitstream_manager.block_bits(config_block_id).size()) {
-      continue;
-    }
-    /* Build the hierarchical path of the configuration bit in modules */
-    std::vector<ConfigBlockId> block_hierarchy = find_bitstream_manager_block_hierarchy(bitstream_manager, config_block_id);
-    /* Drop the first block, which is the top module, it should be replaced by the instance name here */
-    /* Ensure that this is the module we want to drop! */
-    VTR_ASSERT(0 == module_manager.module_name(top_module).compare(bitstream_manager.block_name(block_hierarchy[0])));
-    block_hierarchy.erase(block_hierarchy.begin());
-    /* Build the full hierarchy path */
-    std::string bit_hierarchy_path(FORMAL_VERIFICATION_TOP_MODULE_UUT_NAME);
-    for (const ConfigBlockId &temp_block : block_hierarchy) {
-      bit_hierarchy_path += std::string(".");
-      bit_hierarchy_path += bitstream_manager.block_name(temp_block);
-    }
-    bit_hierarchy_path += std::string(".");
+  if (true == use_bitstream_memory) {
+    fp << "\t$readmemb(\"" << bitstream_memory_fname << "\", " << std::string(FORMAL_VERIFICATION_TOP_MODULE_BITSTREAM_MEMORY_NAME) << ");\n";
+  }
+
+  size_t word_index = 0;
+  visit_preconfig_top_module_config_blocks(bitstream_manager, root_block,
+                                           [&](const ConfigBlockId& config_block_id, const std::string& bit_hierarchy_path) {
+    std::vector<ConfigBitId> block_bits = bitstream_manager.block_bits(config_block_id);
 
     /* Find the bit index in the parent block */
     BasicPort config_data_port(bit_hierarchy_path + generate_configurable_memory_data_out_name(),
-                               bitstream_manager.block_bits(config_block_id).size());
+                               block_bits.size());
 
     /* Wire it to the configuration bit: access both data out and data outb ports */
-    std::vector<size_t> config_data_values;
-    for (const ConfigBitId config_bit : bitstream_manager.block_bits(config_block_id)) {
-      config_data_values.push_back(bitstream_manager.bit_value(config_bit));
-    }
-    print_verilog_deposit_wire_constant_values(fp, config_data_port, config_data_values);
+    fp << "\t$deposit(" << generate_verilog_port(VERILOG_PORT_CONKT, config_data_port) << ", ";
+    fp << generate_preconfig_top_module_bitstream_values(bitstream_manager, block_bits, use_bitstream_memory, word_index, false);
+    fp << ");\n";
 
     /* Skip datab ports if specified */
-    if (false == output_datab_bits) {
-      continue;
+    if (true == output_datab_bits) {
+      BasicPort config_datab_port(bit_hierarchy_path + generate_configurable_memory_inverted_data_out_name(),
+                                  block_bits.size());
+
+      fp << "\t$deposit(" << generate_verilog_port(VERILOG_PORT_CONKT, config_datab_port) << ", ";
+      fp << generate_preconfig_top_module_bitstream_values(bitstream_manager, block_bits, use_bitstream_memory, word_index, true);
+      fp << ");\n";
     }
 
-    BasicPort config_datab_port(bit_hierarchy_path + generate_configurable_memory_inverted_data_out_name(),
-                                bitstream_manager.block_bits(config_block_id).size());
+    word_index++;
+  });
+
+  fp << "end\n";
 
+  print_verilog_comment(fp, std::string("----- End deposit bitstream to configuration memories -----"));
+}
 
-    std::vector<size_t> config_datab_values;
+/********************************************************************
+ * Write the bitstream of each block with configuration bits to a memory file,
+ * one word per line in binary format, in the sequence that the blocks 
+ * are visited when imposing the bitstream. 
+ * The first bit of a block is the MSB of its word, and words are aligned to 
+ * the LSB, so that a word is sliced by the number of bits of the block
+ *
+ * Print the declaration of the memory, which is read by $readmemb
+ * Return the number of words in the memory
+ *******************************************************************/
+static 
+size_t print_verilog_preconfig_top_module_bitstream_memory(std::fstream &fp,
+                                                           const BitstreamManager &bitstream_manager,
+                                                           const ConfigBlockId &root_block,
+                                                           const std::string& bitstream_memory_fname) {
+  /* Validate the file stream */
+  valid_file_stream(fp);
+
+  std::fstream mem_fp;
+  mem_fp.open(bitstream_memory_fname, std::fstream::out | std::fstream::trunc);
+  check_file_stream(bitstream_memory_fname.c_str(), mem_fp);
+
+  size_t num_words = 0;
+  size_t word_width = 0;
+  std::string word;
+  visit_preconfig_top_module_config_blocks(bitstream_manager, root_block,
+                                           [&](const ConfigBlockId& config_block_id, const std::string&) {
+    word.clear();
     for (const ConfigBitId config_bit : bitstream_manager.block_bits(config_block_id)) {
-      config_datab_values.push_back(!bitstream_manager.bit_value(config_bit));
+      word.push_back(true == bitstream_manager.bit_value(config_bit) ? '1' : '0');
     }
-    print_verilog_deposit_wire_constant_values(fp, config_datab_port, config_datab_values);
+    mem_fp << word << "\n";
+    word_width = std::max(word_width, word.length());
+    num_words++;
+  });
+  mem_fp.close();
+
+  VTR_LOG("Written %lu configurable memories to bitstream memory file '%s'\n",
+          num_words, bitstream_memory_fname.c_str());
+
+  /* Nothing to load */
+  if (0 == num_words) {
+    return num_words;
   }
 
-  fp << "end" << std::endl;
+  print_verilog_comment(fp, std::string("----- Bitstream loaded from memory file '" + bitstream_memory_fname + "' -----"));
+  fp << "\treg [" << word_width - 1 << ":0] " << std::string(FORMAL_VERIFICATION_TOP_MODULE_BITSTREAM_MEMORY_NAME);
+  fp << "[0:" << num_words - 1 << "];\n";
 
-  print_verilog_comment(fp, std::string("----- End deposit bitstream to configuration memories -----"));
+  return num_words;
 }
 
 /********************************************************************
  * Impose the bitstream on the configuration memories
  * We branch here for different simulators:
- * 1. iVerilog Icarus prefers using 'assign' syntax to force the values
+ * 1. iVerilog Icarus and Verilator prefer using 'assign' syntax to force the values
  * 2. Mentor Modelsim prefers using '$deposit' syntax to do so
+ *
+ * When a memory file is given, the bitstream is written to the memory file
+ * and loaded by $readmemb during simulation, instead of being part of the netlist.
+ * The netlist then depends only on the fabric, not on the bitstream
+ *
+ * The bitstream is imposed on the blocks under the root block,
+ * whose module is instanciated as FORMAL_VERIFICATION_TOP_MODULE_UUT_NAME
  *******************************************************************/
-static 
 void print_verilog_preconfig_top_module_load_bitstream(std::fstream &fp,
-                                                       const ModuleManager &module_manager,
-                                                       const ModuleId &top_module,
                                                        const CircuitLibrary& circuit_lib,
                                                        const CircuitModelId& mem_model,
-                                                       const BitstreamManager &bitstream_manager) {
+                                                       const BitstreamManager &bitstream_manager,
+                                                       const ConfigBlockId &root_block,
+                                                       const std::string& bitstream_memory_fname) {
 
   /* Skip the datab port if there is only 1 output port in memory model
    * Currently, it assumes that the data output port is always defined while datab is optional
@@ -379,18 +451,42 @@ void print_verilog_preconfig_top_module_load_bitstream(std::fstream &fp,
 
   print_verilog_comment(fp, std::string("----- Begin load bitstream to configuration memories -----"));
 
-  print_verilog_preprocessing_flag(fp, std::string(ICARUS_SIMULATOR_FLAG));
+  /* Use the memory only when there is anything to load */
+  std::string memory_fname;
+  if ( (false == bitstream_memory_fname.empty())
+    && (0 < print_verilog_preconfig_top_module_bitstream_memory(fp, bitstream_manager,
+                                                                root_block,
+                                                                bitstream_memory_fname)) ) {
+    memory_fname = bitstream_memory_fname;
+  }
 
-  /* Use assign syntax for Icarus simulator */
-  print_verilog_preconfig_top_module_assign_bitstream(fp, module_manager, top_module,
-                                                      bitstream_manager,
+  /* Verilator does not support '$deposit' */
+  for (const std::string& simulator_flag : {std::string(ICARUS_SIMULATOR_FLAG), std::string(VERILATOR_SIMULATOR_FLAG)}) {
+    print_verilog_preprocessing_flag(fp, simulator_flag);
+    fp << "\t";
+    print_verilog_define_flag(fp, std::string(ASSIGN_PRECONFIG_BITSTREAM_FLAG), 1);
+    print_verilog_endif(fp);
+  }
+
+  print_verilog_preprocessing_flag(fp, std::string(ASSIGN_PRECONFIG_BITSTREAM_FLAG));
+
+  /* Assigned and forced values follow the memory once it is read */
+  if (false == memory_fname.empty()) {
+    fp << "initial $readmemb(\"" << memory_fname << "\", " << std::string(FORMAL_VERIFICATION_TOP_MODULE_BITSTREAM_MEMORY_NAME) << ");\n";
+  }
+
+  /* Use assign syntax for Icarus and Verilator simulators */
+  print_verilog_preconfig_top_module_assign_bitstream(fp, bitstream_manager,
+                                                      root_block,
+                                                      !memory_fname.empty(),
                                                       output_datab_bits);
 
-  fp << "`else" << std::endl;
+  fp << "`else\n";
 
-  /* Use assign syntax for Icarus simulator */
-  print_verilog_preconfig_top_module_deposit_bitstream(fp, module_manager, top_module,
-                                                       bitstream_manager,
+  /* Use deposit syntax for other simulators */
+  print_verilog_preconfig_top_module_deposit_bitstream(fp, bitstream_manager,
+                                                       root_block,
+                                                       memory_fname,
                                                        output_datab_bits);
 
   print_verilog_endif(fp);
@@ -442,7 +538,10 @@ int print_verilog_preconfig_top_module(const ModuleManager &module_manager,
                                        const VprNetlistAnnotation &netlist_annotation,
                                        const std::string &circuit_name,
                                        const std::string &verilog_fname,
-                                       const bool &explicit_port_mapping) {
+                                       const std::string &bitstream_memory_fname,
+                                       const bool &explicit_port_mapping,
+                                       const bool &fabric_signal_init,
+                                       const e_file_compression &compression) {
   std::string timer_message = std::string("Write pre-configured FPGA top-level Verilog netlist for design '") + circuit_name + std::string("'");
 
   int status = CMD_EXEC_SUCCESS;
@@ -451,8 +550,8 @@ int print_verilog_preconfig_top_module(const ModuleManager &module_manager,
   vtr::ScopedStartFinishTimer timer(timer_message);
 
   /* Create the file stream */
-  std::fstream fp;
-  fp.open(verilog_fname, std::fstream::out | std::fstream::trunc);
+  BufferedFileStream netlist_file(verilog_fname, compression);
+  std::fstream& fp = netlist_file.stream();
 
   /* Validate the file stream */
   check_file_stream(verilog_fname.c_str(), fp);
@@ -502,23 +601,32 @@ int print_verilog_preconfig_top_module(const ModuleManager &module_manager,
   CircuitModelId sram_model = config_protocol.memory_model();  
   VTR_ASSERT(true == circuit_lib.valid_model_id(sram_model));
 
+  /* Ensure that the top block is the module we want to replace! */
+  std::vector<ConfigBlockId> top_blocks = find_bitstream_manager_top_blocks(bitstream_manager);
+  VTR_ASSERT(1 == top_blocks.size());
+  VTR_ASSERT(0 == module_manager.module_name(top_module).compare(bitstream_manager.block_name(top_blocks[0])));
+
   /* Assign FPGA internal SRAM/Memory ports to bitstream values */
-  print_verilog_preconfig_top_module_load_bitstream(fp, module_manager, top_module,
-                                                    circuit_lib, sram_model, 
-                                                    bitstream_manager);
+  print_verilog_preconfig_top_module_load_bitstream(fp, circuit_lib, sram_model, 
+                                                    bitstream_manager,
+                                                    top_blocks[0],
+                                                    bitstream_memory_fname);
 
-  /* Add signal initialization */
+  /* Add signal initialization, only for the primitives with user-defined netlists
+   * when the primitive modules of the fabric initialize their own drivers
+   */
   print_verilog_testbench_signal_initialization(fp,
                                                 std::string(FORMAL_VERIFICATION_TOP_MODULE_UUT_NAME),
                                                 circuit_lib,
                                                 module_manager,
-                                                top_module);
+                                                top_module,
+                                                fabric_signal_init);
 
   /* Testbench ends*/
   print_verilog_module_end(fp, std::string(circuit_name) + std::string(FORMAL_VERIFICATION_TOP_MODULE_POSTFIX));
 
   /* Close the file stream */
-  fp.close();
+  netlist_file.close();
 
   return status;
 }
@@ -4,8 +4,10 @@
 /********************************************************************
  * Include header files that are required by function declaration
  *******************************************************************/
+#include <fstream>
 #include <vector>
 #include <string>
+#include "openfpga_compressed_stream.h"
 #include "circuit_library.h"
 #include "vpr_context.h"
 #include "module_manager.h"
@@ -23,6 +25,17 @@
 /* begin namespace openfpga */
 namespace openfpga {
 
+void print_verilog_preconfig_top_module_internal_wires(std::fstream &fp,
+                                                       const ModuleManager &module_manager,
+                                                       const ModuleId &top_module);
+
+void print_verilog_preconfig_top_module_load_bitstream(std::fstream &fp,
+                                                       const CircuitLibrary& circuit_lib,
+                                                       const CircuitModelId& mem_model,
+                                                       const BitstreamManager &bitstream_manager,
+                                                       const ConfigBlockId &root_block,
+                                                       const std::string& bitstream_memory_fname);
+
 int print_verilog_preconfig_top_module(const ModuleManager& module_manager,
                                        const BitstreamManager& bitstream_manager,
                                        const ConfigProtocol &config_protocol,
@@ -35,7 +48,10 @@ int print_verilog_preconfig_top_module(const ModuleManager& module_manager,
                                        const VprNetlistAnnotation& netlist_annotation,
                                        const std::string& circuit_name,
                                        const std::string& verilog_fname,
-                                       const bool& explicit_port_mapping);
+                                       const std::string& bitstream_memory_fname,
+                                       const bool& explicit_port_mapping,
+                                       const bool& fabric_signal_init,
+                                       const e_file_compression& compression);
 
 } /* end namespace openfpga */
 
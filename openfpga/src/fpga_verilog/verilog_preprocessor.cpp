@@ -0,0 +1,134 @@
+/********************************************************************
+ * This file includes functions to resolve the preprocessing conditions,
+ * i.e., `ifdef, `ifndef, `elsif, `else and `endif, of Verilog netlists
+ * for a given set of flags, so that the netlists can be parsed without
+ * evaluating the conditions again
+ *******************************************************************/
+#include <cctype>
+#include <vector>
+
+#include "verilog_preprocessor.h"
+
+/* begin namespace openfpga */
+namespace openfpga {
+
+/********************************************************************
+ * A level of nested conditions
+ *******************************************************************/
+struct t_verilog_condition {
+  /* If the level is reachable, i.e., all the parent levels are active */
+  bool parent_active;
+  /* If a branch of the level has been taken */
+  bool taken;
+  /* If the current branch is active */
+  bool active;
+};
+
+/********************************************************************
+ * Find the identifier starting from a position in a line,
+ * after any whitespace, and move the position to the end of the identifier
+ *******************************************************************/
+static 
+std::string find_verilog_identifier(const std::string& line,
+                                    size_t& pos) {
+  while ( (pos < line.length())
+       && ((' ' == line[pos]) || ('\t' == line[pos])) ) {
+    ++pos;
+  }
+  size_t start = pos;
+  while ( (pos < line.length())
+       && (('_' == line[pos]) || ('$' == line[pos]) || (0 != std::isalnum(static_cast<unsigned char>(line[pos])))) ) {
+    ++pos;
+  }
+  return line.substr(start, pos - start);
+}
+
+/********************************************************************
+ * Resolve the preprocessing conditions of Verilog contents,
+ * considering that only the given flags are defined, in addition to
+ * the flags defined by `define in the active branches of the contents
+ * - The directives of conditions are removed, as well as the branches
+ *   which are not taken 
+ * - Directives other than conditions, e.g., `define and `include, are kept
+ * - Directives are expected at the beginning of lines, after any whitespace,
+ *   which is the way the netlists are written
+ *
+ * Return false if the conditions are not balanced
+ *******************************************************************/
+bool resolve_verilog_preprocessing_conditions(const std::string& contents,
+                                              const std::set<std::string>& defined_flags,
+                                              std::string& resolved_contents) {
+  resolved_contents.clear();
+  resolved_contents.reserve(contents.length());
+
+  std::set<std::string> flags = defined_flags;
+  std::vector<t_verilog_condition> conditions;
+
+  size_t line_start = 0;
+  while (line_start < contents.length()) {
+    size_t line_end = contents.find('\n', line_start);
+    line_end = (std::string::npos == line_end) ? contents.length() : line_end + 1;
+    const std::string line = contents.substr(line_start, line_end - line_start);
+    line_start = line_end;
+
+    bool active = (true == conditions.empty()) || (true == conditions.back().active);
+
+    std::string directive;
+    size_t pos = line.find_first_not_of(" \t");
+    if ( (std::string::npos != pos) && ('`' == line[pos]) ) {
+      ++pos;
+      directive = find_verilog_identifier(line, pos);
+    }
+
+    if ( (std::string("ifdef") == directive)
+      || (std::string("ifndef") == directive) ) {
+      bool cond = (0 < flags.count(find_verilog_identifier(line, pos)));
+      if (std::string("ifndef") == directive) {
+        cond = !cond;
+      }
+      conditions.push_back({active, cond, active && cond});
+      continue;
+    }
+    if (std::string("elsif") == directive) {
+      if (true == conditions.empty()) {
+        return false;
+      }
+      t_verilog_condition& condition = conditions.back();
+      bool cond = (0 < flags.count(find_verilog_identifier(line, pos)));
+      condition.active = condition.parent_active && !condition.taken && cond;
+      condition.taken = condition.taken || cond;
+      continue;
+    }
+    if (std::string("else") == directive) {
+      if (true == conditions.empty()) {
+        return false;
+      }
+      t_verilog_condition& condition = conditions.back();
+      condition.active = condition.parent_active && !condition.taken;
+      condition.taken = true;
+      continue;
+    }
+    if (std::string("endif") == directive) {
+      if (true == conditions.empty()) {
+        return false;
+      }
+      conditions.pop_back();
+      continue;
+    }
+
+    if (false == active) {
+      continue;
+    }
+    /* Track the flags defined or undefined by the contents */
+    if (std::string("define") == directive) {
+      flags.insert(find_verilog_identifier(line, pos));
+    } else if (std::string("undef") == directive) {
+      flags.erase(find_verilog_identifier(line, pos));
+    }
+    resolved_contents += line;
+  }
+
+  return true == conditions.empty();
+}
+
+} /* end namespace openfpga */
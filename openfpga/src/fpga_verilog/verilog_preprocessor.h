@@ -0,0 +1,23 @@
+#ifndef VERILOG_PREPROCESSOR_H
+#define VERILOG_PREPROCESSOR_H
+
+/********************************************************************
+ * Include header files that are required by function declaration
+ *******************************************************************/
+#include <set>
+#include <string>
+
+/********************************************************************
+ * Function declaration
+ *******************************************************************/
+
+/* begin namespace openfpga */
+namespace openfpga {
+
+bool resolve_verilog_preprocessing_conditions(const std::string& contents,
+                                              const std::set<std::string>& defined_flags,
+                                              std::string& resolved_contents);
+
+} /* end namespace openfpga */
+
+#endif
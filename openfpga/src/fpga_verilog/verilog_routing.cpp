@@ -2,6 +2,8 @@
  * This file includes functions that are used for 
  * Verilog generation of FPGA routing architecture (global routing) 
  *********************************************************************/
+#include <unordered_map>
+
 /* Headers from vtrutil library */
 #include "vtr_assert.h"
 #include "vtr_time.h"
@@ -9,9 +11,13 @@
 
 /* Headers from openfpgautil library */
 #include "openfpga_digest.h"
+#include "openfpga_buffered_file_stream.h"
+#include "openfpga_parallel.h"
+#include "openfpga_progress.h"
 
 /* Include FPGA-Verilog header files*/
 #include "openfpga_naming.h"
+#include "module_manager_utils.h"
 #include "verilog_constants.h"
 #include "verilog_writer_utils.h"
 #include "verilog_module_writer.h"
@@ -75,8 +81,7 @@ namespace openfpga {
  *              
  ********************************************************************/
 static 
-void print_verilog_routing_connection_box_unique_module(NetlistManager& netlist_manager,
-                                                        const ModuleManager& module_manager, 
+std::string print_verilog_routing_connection_box_unique_module(const ModuleManager& module_manager, 
                                                         const std::string& subckt_dir, 
                                                         const RRGSB& rr_gsb,
                                                         const t_rr_type& cb_type,
@@ -86,12 +91,12 @@ void print_verilog_routing_connection_box_unique_module(NetlistManager& netlist_
   std::string verilog_fname(subckt_dir + generate_connection_block_netlist_name(cb_type, gsb_coordinate, std::string(VERILOG_NETLIST_FILE_POSTFIX)));
 
   /* Create the file stream */
-  std::fstream fp;
-  fp.open(verilog_fname, std::fstream::out | std::fstream::trunc);
+  BufferedFileStream netlist_file(verilog_fname, options.compression(), options.netlist_update());
+  std::fstream& fp = netlist_file.stream();
 
   check_file_stream(verilog_fname.c_str(), fp);
 
-  print_verilog_file_header(fp, std::string("Verilog modules for Unique Connection Blocks[" + std::to_string(rr_gsb.get_cb_x(cb_type)) + "]["+ std::to_string(rr_gsb.get_cb_y(cb_type)) + "]")); 
+  print_verilog_file_header(fp, std::string("Verilog modules for Unique Connection Blocks[" + std::to_string(rr_gsb.get_cb_x(cb_type)) + "]["+ std::to_string(rr_gsb.get_cb_y(cb_type)) + "]"), false == options.keep_unchanged_netlists()); 
 
   /* Create a Verilog Module based on the circuit model, and add to module manager */
   ModuleId cb_module = module_manager.find_module(generate_connection_block_module_name(cb_type, gsb_coordinate)); 
@@ -104,15 +109,12 @@ void print_verilog_routing_connection_box_unique_module(NetlistManager& netlist_
                                options.default_net_type());
  
   /* Add an empty line as a splitter */
-  fp << std::endl;
+  fp << "\n";
 
   /* Close file handler */
-  fp.close();
+  close_verilog_netlist_file(netlist_file);
 
-  /* Add fname to the netlist name list */
-  NetlistId nlist_id = netlist_manager.add_netlist(verilog_fname);
-  VTR_ASSERT(NetlistId::INVALID() != nlist_id);
-  netlist_manager.set_netlist_type(nlist_id, NetlistManager::ROUTING_MODULE_NETLIST);
+  return verilog_fname;
 }
 
 /*********************************************************************
@@ -179,8 +181,7 @@ void print_verilog_routing_connection_box_unique_module(NetlistManager& netlist_
  *
  ********************************************************************/
 static 
-void print_verilog_routing_switch_box_unique_module(NetlistManager& netlist_manager,
-                                                    const ModuleManager& module_manager, 
+std::string print_verilog_routing_switch_box_unique_module(const ModuleManager& module_manager, 
                                                     const std::string& subckt_dir, 
                                                     const RRGSB& rr_gsb,
                                                     const FabricVerilogOption& options) {
@@ -189,12 +190,12 @@ void print_verilog_routing_switch_box_unique_module(NetlistManager& netlist_mana
   std::string verilog_fname(subckt_dir + generate_routing_block_netlist_name(SB_VERILOG_FILE_NAME_PREFIX, gsb_coordinate, std::string(VERILOG_NETLIST_FILE_POSTFIX)));
 
   /* Create the file stream */
-  std::fstream fp;
-  fp.open(verilog_fname, std::fstream::out | std::fstream::trunc);
+  BufferedFileStream netlist_file(verilog_fname, options.compression(), options.netlist_update());
+  std::fstream& fp = netlist_file.stream();
 
   check_file_stream(verilog_fname.c_str(), fp);
 
-  print_verilog_file_header(fp, std::string("Verilog modules for Unique Switch Blocks[" + std::to_string(rr_gsb.get_sb_x()) + "]["+ std::to_string(rr_gsb.get_sb_y()) + "]")); 
+  print_verilog_file_header(fp, std::string("Verilog modules for Unique Switch Blocks[" + std::to_string(rr_gsb.get_sb_x()) + "]["+ std::to_string(rr_gsb.get_sb_y()) + "]"), false == options.keep_unchanged_netlists()); 
 
   /* Create a Verilog Module based on the circuit model, and add to module manager */
   ModuleId sb_module = module_manager.find_module(generate_switch_block_module_name(gsb_coordinate)); 
@@ -208,25 +209,200 @@ void print_verilog_routing_switch_box_unique_module(NetlistManager& netlist_mana
                                options.default_net_type());
  
   /* Close file handler */
-  fp.close();
+  close_verilog_netlist_file(netlist_file);
+
+  return verilog_fname;
+}
 
-  /* Add fname to the netlist name list */
-  NetlistId nlist_id = netlist_manager.add_netlist(verilog_fname);
-  VTR_ASSERT(NetlistId::INVALID() != nlist_id);
-  netlist_manager.set_netlist_type(nlist_id, NetlistManager::ROUTING_MODULE_NETLIST);
+/********************************************************************
+ * Write the netlists for a list of routing blocks
+ * - A block whose type is NUM_RR_TYPES is a switch block,
+ *   otherwise it is a connection block of the given type
+ * - Each netlist is an independent file, so they are written
+ *   on multiple threads when requested
+ *******************************************************************/
+static 
+void print_verilog_routing_block_netlists(NetlistManager& netlist_manager,
+                                          const ModuleManager& module_manager, 
+                                          const std::vector<const RRGSB*>& rr_gsbs,
+                                          const std::vector<t_rr_type>& block_types,
+                                          const std::string& subckt_dir,
+                                          const FabricVerilogOption& options) {
+  VTR_ASSERT(rr_gsbs.size() == block_types.size());
+
+  ProgressReporter progress("Writing routing modules", rr_gsbs.size());
+  std::vector<std::string> verilog_fnames(rr_gsbs.size());
+  parallel_for(rr_gsbs.size(), options.num_threads(),
+               [&](const size_t& iblock) {
+                 if (NUM_RR_TYPES == block_types[iblock]) {
+                   verilog_fnames[iblock] = print_verilog_routing_switch_box_unique_module(module_manager, 
+                                                                                           subckt_dir, 
+                                                                                           *(rr_gsbs[iblock]), 
+                                                                                           options);
+                 } else {
+                   verilog_fnames[iblock] = print_verilog_routing_connection_box_unique_module(module_manager,
+                                                                                               subckt_dir, 
+                                                                                               *(rr_gsbs[iblock]), block_types[iblock],  
+                                                                                               options);
+                 }
+                 progress.advance();
+               });
+
+  /* Add fname to the netlist name list, by block index rather than in the order the writers finish */
+  for (const std::string& verilog_fname : verilog_fnames) {
+    NetlistId nlist_id = netlist_manager.add_netlist(verilog_fname);
+    VTR_ASSERT(NetlistId::INVALID() != nlist_id);
+    netlist_manager.set_netlist_type(nlist_id, NetlistManager::ROUTING_MODULE_NETLIST);
+  }
+}
+
+/********************************************************************
+ * Find the module and the netlist name of a routing block
+ * - A block whose type is NUM_RR_TYPES is a switch block,
+ *   otherwise it is a connection block of the given type
+ *******************************************************************/
+static 
+ModuleId find_routing_block_module(const ModuleManager& module_manager, 
+                                   const RRGSB& rr_gsb,
+                                   const t_rr_type& block_type) {
+  ModuleId block_module = ModuleId::INVALID();
+  if (NUM_RR_TYPES == block_type) {
+    vtr::Point<size_t> gsb_coordinate(rr_gsb.get_sb_x(), rr_gsb.get_sb_y());
+    block_module = module_manager.find_module(generate_switch_block_module_name(gsb_coordinate)); 
+  } else {
+    vtr::Point<size_t> gsb_coordinate(rr_gsb.get_cb_x(block_type), rr_gsb.get_cb_y(block_type));
+    block_module = module_manager.find_module(generate_connection_block_module_name(block_type, gsb_coordinate)); 
+  }
+  VTR_ASSERT(true == module_manager.valid_module_id(block_module));
+  return block_module;
+}
+
+static 
+std::string generate_routing_block_verilog_netlist_name(const std::string& subckt_dir, 
+                                                        const RRGSB& rr_gsb,
+                                                        const t_rr_type& block_type) {
+  if (NUM_RR_TYPES == block_type) {
+    vtr::Point<size_t> gsb_coordinate(rr_gsb.get_sb_x(), rr_gsb.get_sb_y());
+    return subckt_dir + generate_routing_block_netlist_name(SB_VERILOG_FILE_NAME_PREFIX, gsb_coordinate, std::string(VERILOG_NETLIST_FILE_POSTFIX));
+  }
+  vtr::Point<size_t> gsb_coordinate(rr_gsb.get_cb_x(block_type), rr_gsb.get_cb_y(block_type));
+  return subckt_dir + generate_connection_block_netlist_name(block_type, gsb_coordinate, std::string(VERILOG_NETLIST_FILE_POSTFIX));
+}
+
+/********************************************************************
+ * Write the netlists for a list of routing blocks,
+ * where the contents of identical modules are shared:
+ * - Routing modules which are different only in names are grouped.
+ *   The contents of each group are written once to a file,
+ *   which is named after the first module of the group 
+ * - The netlist of each routing block declares its own module,
+ *   with the same name and ports, and includes the shared contents.
+ *   Therefore, the hierarchy and naming are the same as 
+ *   when each module is written as a whole
+ *******************************************************************/
+static 
+void print_verilog_routing_block_netlists_with_shared_bodies(NetlistManager& netlist_manager,
+                                                             const ModuleManager& module_manager, 
+                                                             const std::vector<const RRGSB*>& rr_gsbs,
+                                                             const std::vector<t_rr_type>& block_types,
+                                                             const std::string& subckt_dir,
+                                                             const FabricVerilogOption& options) {
+  VTR_ASSERT(rr_gsbs.size() == block_types.size());
+
+  std::vector<ModuleId> block_modules(rr_gsbs.size(), ModuleId::INVALID());
+  std::vector<size_t> block_hashes(rr_gsbs.size(), 0);
+  parallel_for(rr_gsbs.size(), options.num_threads(),
+               [&](const size_t& iblock) {
+                 block_modules[iblock] = find_routing_block_module(module_manager, *(rr_gsbs[iblock]), block_types[iblock]);
+                 block_hashes[iblock] = module_body_hash(module_manager, block_modules[iblock]);
+               });
+
+  /* Group the blocks by their contents, in the order of the list
+   * The first block of each group owns the shared body
+   */
+  std::vector<size_t> block_body_owners(rr_gsbs.size());
+  std::vector<size_t> body_owners;
+  std::unordered_map<size_t, std::vector<size_t>> body_owners_by_hash;
+  for (size_t iblock = 0; iblock < rr_gsbs.size(); ++iblock) {
+    std::vector<size_t>& candidates = body_owners_by_hash[block_hashes[iblock]];
+    bool found_body = false;
+    for (const size_t& candidate : candidates) {
+      if (true == module_bodies_identical(module_manager, block_modules[candidate], block_modules[iblock])) {
+        block_body_owners[iblock] = candidate;
+        found_body = true;
+        break;
+      }
+    }
+    if (false == found_body) {
+      candidates.push_back(iblock);
+      body_owners.push_back(iblock);
+      block_body_owners[iblock] = iblock;
+    }
+  }
+
+  std::vector<std::string> body_fnames(rr_gsbs.size());
+  for (const size_t& owner : body_owners) {
+    body_fnames[owner] = subckt_dir + module_manager.module_name(block_modules[owner]) + std::string(VERILOG_SHARED_BODY_FILE_POSTFIX);
+  }
+
+  /* Write shared bodies */
+  parallel_for(body_owners.size(), options.num_threads(),
+               [&](const size_t& ibody) {
+                 const size_t& owner = body_owners[ibody];
+                 BufferedFileStream body_file(body_fnames[owner], options.compression(), options.netlist_update());
+                 std::fstream& fp = body_file.stream();
+                 check_file_stream(body_fnames[owner].c_str(), fp);
+
+                 print_verilog_comment(fp, std::string("----- Contents shared by routing modules identical to " + module_manager.module_name(block_modules[owner]) + " -----"));
+                 write_verilog_module_body_to_file(fp,
+                                                   module_manager, block_modules[owner],
+                                                   options.explicit_port_mapping(),
+                                                   options.default_net_type());
+                 close_verilog_netlist_file(body_file);
+               });
+
+  /* Write the module of each block */
+  ProgressReporter progress("Writing routing modules", rr_gsbs.size());
+  std::vector<std::string> verilog_fnames(rr_gsbs.size());
+  parallel_for(rr_gsbs.size(), options.num_threads(),
+               [&](const size_t& iblock) {
+                 verilog_fnames[iblock] = generate_routing_block_verilog_netlist_name(subckt_dir, *(rr_gsbs[iblock]), block_types[iblock]);
+                 BufferedFileStream netlist_file(verilog_fnames[iblock], options.compression(), options.netlist_update());
+                 std::fstream& fp = netlist_file.stream();
+                 check_file_stream(verilog_fnames[iblock].c_str(), fp);
+
+                 print_verilog_file_header(fp, std::string("Verilog modules for " + module_manager.module_name(block_modules[iblock])), false == options.keep_unchanged_netlists()); 
+                 write_verilog_module_with_shared_body_to_file(fp,
+                                                               module_manager, block_modules[iblock],
+                                                               body_fnames[block_body_owners[iblock]],
+                                                               options.default_net_type());
+                 close_verilog_netlist_file(netlist_file);
+                 progress.advance();
+               });
+
+  /* Add fname to the netlist name list. The shared bodies are only included
+   * by these netlists, so they are not registered themselves
+   */
+  for (const std::string& verilog_fname : verilog_fnames) {
+    NetlistId nlist_id = netlist_manager.add_netlist(verilog_fname);
+    VTR_ASSERT(NetlistId::INVALID() != nlist_id);
+    netlist_manager.set_netlist_type(nlist_id, NetlistManager::ROUTING_MODULE_NETLIST);
+  }
+
+  VTR_LOGV(options.verbose_output(),
+           "Shared the contents of %lu routing modules in %lu files\n",
+           rr_gsbs.size(), body_owners.size());
 }
 
 /********************************************************************
  * Iterate over all the connection blocks in a device
- * and build a module for each of them 
+ * and collect the blocks for which a module should be built 
  *******************************************************************/
 static 
-void print_verilog_flatten_connection_block_modules(NetlistManager& netlist_manager,
-                                                    const ModuleManager& module_manager, 
-                                                    const DeviceRRGSB& device_rr_gsb,
-                                                    const std::string& subckt_dir,
-                                                    const t_rr_type& cb_type,
-                                                    const FabricVerilogOption& options) {
+void collect_flatten_connection_block_modules(std::vector<const RRGSB*>& rr_gsbs,
+                                              std::vector<t_rr_type>& block_types,
+                                              const DeviceRRGSB& device_rr_gsb,
+                                              const t_rr_type& cb_type) {
   /* Build unique X-direction connection block modules */
   vtr::Point<size_t> cb_range = device_rr_gsb.get_gsb_range();
 
@@ -240,11 +416,8 @@ void print_verilog_flatten_connection_block_modules(NetlistManager& netlist_mana
       if (true != rr_gsb.is_cb_exist(cb_type)) {
         continue;
       }
-      print_verilog_routing_connection_box_unique_module(netlist_manager, 
-                                                         module_manager,
-                                                         subckt_dir, 
-                                                         rr_gsb, cb_type,  
-                                                         options);
+      rr_gsbs.push_back(&rr_gsb);
+      block_types.push_back(cb_type);
     }
   }
 }
@@ -257,6 +430,8 @@ void print_verilog_flatten_connection_block_modules(NetlistManager& netlist_mana
  * Covering:
  * 1. Connection blocks
  * 2. Switch blocks
+ * When requested, the contents of identical modules are written only once
+ * and shared by the modules 
  *******************************************************************/
 void print_verilog_flatten_routing_modules(NetlistManager& netlist_manager,
                                            const ModuleManager& module_manager,
@@ -268,6 +443,9 @@ void print_verilog_flatten_routing_modules(NetlistManager& netlist_manager,
 
   vtr::Point<size_t> sb_range = device_rr_gsb.get_gsb_range();
 
+  std::vector<const RRGSB*> rr_gsbs;
+  std::vector<t_rr_type> block_types;
+
   /* Build unique switch block modules */
   for (size_t ix = 0; ix < sb_range.x(); ++ix) {
     for (size_t iy = 0; iy < sb_range.y(); ++iy) {
@@ -275,27 +453,32 @@ void print_verilog_flatten_routing_modules(NetlistManager& netlist_manager,
       if (true != rr_gsb.is_sb_exist()) {
         continue;
       }
-      print_verilog_routing_switch_box_unique_module(netlist_manager,
-                                                     module_manager, 
-                                                     subckt_dir, 
-                                                     rr_gsb, 
-                                                     options);
+      rr_gsbs.push_back(&rr_gsb);
+      block_types.push_back(NUM_RR_TYPES);
     }
   }
 
-  print_verilog_flatten_connection_block_modules(netlist_manager,
-                                                 module_manager,
-                                                 device_rr_gsb,
-                                                 subckt_dir,
-                                                 CHANX,
-                                                 options);
-
-  print_verilog_flatten_connection_block_modules(netlist_manager,
-                                                 module_manager,
-                                                 device_rr_gsb,
-                                                 subckt_dir,
-                                                 CHANY,
-                                                 options);
+  collect_flatten_connection_block_modules(rr_gsbs, block_types,
+                                           device_rr_gsb,
+                                           CHANX);
+
+  collect_flatten_connection_block_modules(rr_gsbs, block_types,
+                                           device_rr_gsb,
+                                           CHANY);
+
+  if (true == options.share_routing_bodies()) {
+    print_verilog_routing_block_netlists_with_shared_bodies(netlist_manager,
+                                                            module_manager,
+                                                            rr_gsbs, block_types,
+                                                            subckt_dir,
+                                                            options);
+  } else {
+    print_verilog_routing_block_netlists(netlist_manager,
+                                         module_manager,
+                                         rr_gsbs, block_types,
+                                         subckt_dir,
+                                         options);
+  }
 
   /*
   VTR_LOG("Writing header file for routing submodules '%s'...",
@@ -327,38 +510,33 @@ void print_verilog_unique_routing_modules(NetlistManager& netlist_manager,
   /* Create a vector to contain all the Verilog netlist names that have been generated in this function */
   std::vector<std::string> netlist_names;
 
+  std::vector<const RRGSB*> rr_gsbs;
+  std::vector<t_rr_type> block_types;
+
   /* Build unique switch block modules */
   for (size_t isb = 0; isb < device_rr_gsb.get_num_sb_unique_module(); ++isb) {
-    const RRGSB& unique_mirror = device_rr_gsb.get_sb_unique_module(isb);
-    print_verilog_routing_switch_box_unique_module(netlist_manager,
-                                                   module_manager,
-                                                   subckt_dir, 
-                                                   unique_mirror, 
-                                                   options);
+    rr_gsbs.push_back(&device_rr_gsb.get_sb_unique_module(isb));
+    block_types.push_back(NUM_RR_TYPES);
   }
 
   /* Build unique X-direction connection block modules */
   for (size_t icb = 0; icb < device_rr_gsb.get_num_cb_unique_module(CHANX); ++icb) {
-    const RRGSB& unique_mirror = device_rr_gsb.get_cb_unique_module(CHANX, icb);
-
-    print_verilog_routing_connection_box_unique_module(netlist_manager,
-                                                       module_manager,
-                                                       subckt_dir, 
-                                                       unique_mirror, CHANX,  
-                                                       options);
+    rr_gsbs.push_back(&device_rr_gsb.get_cb_unique_module(CHANX, icb));
+    block_types.push_back(CHANX);
   }
 
-  /* Build unique X-direction connection block modules */
+  /* Build unique Y-direction connection block modules */
   for (size_t icb = 0; icb < device_rr_gsb.get_num_cb_unique_module(CHANY); ++icb) {
-    const RRGSB& unique_mirror = device_rr_gsb.get_cb_unique_module(CHANY, icb);
-
-    print_verilog_routing_connection_box_unique_module(netlist_manager, 
-                                                       module_manager,
-                                                       subckt_dir, 
-                                                       unique_mirror, CHANY,  
-                                                       options);
+    rr_gsbs.push_back(&device_rr_gsb.get_cb_unique_module(CHANY, icb));
+    block_types.push_back(CHANY);
   }
 
+  print_verilog_routing_block_netlists(netlist_manager,
+                                       module_manager,
+                                       rr_gsbs, block_types,
+                                       subckt_dir,
+                                       options);
+
   /*
   VTR_LOG("Writing header file for routing submodules '%s'...",
           ROUTING_VERILOG_FILE_NAME);
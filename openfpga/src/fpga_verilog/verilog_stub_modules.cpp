@@ -0,0 +1,269 @@
+/********************************************************************
+ * This file includes functions to find the instances of the top-level
+ * module which are not used by a design, and to print the stubs
+ * of their modules, so that a design-specific fabric netlist can be
+ * simulated without the cost of the unused tiles
+ *******************************************************************/
+#include <unordered_map>
+
+/* Headers from vtrutil library */
+#include "vtr_assert.h"
+#include "vtr_log.h"
+
+/* Headers from vpr library */
+#include "vpr_utils.h"
+
+/* Headers from openfpgautil library */
+#include "openfpga_side_manager.h"
+#include "openfpga_reserved_words.h"
+
+#include "openfpga_naming.h"
+
+#include "verilog_module_writer.h"
+#include "verilog_stub_modules.h"
+
+/* begin namespace openfpga */
+namespace openfpga {
+
+/********************************************************************
+ * Find the name of the clock port which drives the configuration chain
+ * of the fabric, i.e., the first global port which is both a programming
+ * port and a clock.
+ * Return an empty name if the configuration protocol is not a chain
+ *******************************************************************/
+std::string find_verilog_stub_config_chain_clock_name(const ModuleManager& module_manager,
+                                                      const FabricGlobalPortInfo& global_ports,
+                                                      const e_config_protocol_type& config_protocol_type) {
+  if (CONFIG_MEM_SCAN_CHAIN != config_protocol_type) {
+    return std::string();
+  }
+
+  ModuleId top_module = module_manager.find_module(generate_fpga_top_module_name());
+  VTR_ASSERT(true == module_manager.valid_module_id(top_module));
+
+  for (const FabricGlobalPortId& global_port : global_ports.global_ports()) {
+    if ( (true == global_ports.global_port_is_prog(global_port))
+      && (true == global_ports.global_port_is_clock(global_port)) ) {
+      return module_manager.module_port(top_module, global_ports.global_module_port(global_port)).get_name();
+    }
+  }
+
+  return std::string();
+}
+
+/********************************************************************
+ * Count the configuration bits in the chain of a module, i.e.,
+ * the number of configurable memories under the module,
+ * where the configurable children without any configurable child
+ * are the flip-flops of the chain
+ *******************************************************************/
+static
+size_t count_module_config_chain_bits(const ModuleManager& module_manager,
+                                      const ModuleId& module_id,
+                                      std::unordered_map<size_t, size_t>& num_module_bits) {
+  auto result = num_module_bits.find(size_t(module_id));
+  if (result != num_module_bits.end()) {
+    return result->second;
+  }
+
+  size_t num_bits = 0;
+  for (const ModuleId& child : module_manager.configurable_children(module_id)) {
+    if (true == module_manager.configurable_children(child).empty()) {
+      num_bits++;
+    } else {
+      num_bits += count_module_config_chain_bits(module_manager, child, num_module_bits);
+    }
+  }
+  num_module_bits[size_t(module_id)] = num_bits;
+
+  return num_bits;
+}
+
+/********************************************************************
+ * Identify if the instances of a module can be replaced by a stub
+ * For a configuration chain, the stub must keep the chain
+ * by its clock, otherwise the bitstream cannot be loaded
+ *******************************************************************/
+static
+bool verilog_stub_module_is_supported(const ModuleManager& module_manager,
+                                      const ModuleId& module_id,
+                                      const e_config_protocol_type& config_protocol_type,
+                                      const std::string& config_chain_clock_name) {
+  if (CONFIG_MEM_SCAN_CHAIN != config_protocol_type) {
+    return true;
+  }
+
+  ModulePortId chain_head_port = module_manager.find_module_port(module_id, generate_configuration_chain_head_name());
+  if (false == module_manager.valid_module_port_id(module_id, chain_head_port)) {
+    /* No configuration bit */
+    return true;
+  }
+  ModulePortId chain_tail_port = module_manager.find_module_port(module_id, generate_configuration_chain_tail_name());
+  ModulePortId chain_clock_port = module_manager.find_module_port(module_id, config_chain_clock_name);
+
+  return (false == config_chain_clock_name.empty())
+      && (true == module_manager.valid_module_port_id(module_id, chain_tail_port))
+      && (true == module_manager.valid_module_port_id(module_id, chain_clock_port))
+      && (1 == module_manager.module_port(module_id, chain_head_port).get_width())
+      && (1 == module_manager.module_port(module_id, chain_tail_port).get_width());
+}
+
+/********************************************************************
+ * Find the instances of the top-level module which are not used by
+ * the implementation of a design, which are
+ * - grids without any placed block
+ * - switch blocks whose routing tracks and grid outputs are not mapped to nets
+ * - connection blocks whose grid inputs are not mapped to nets.
+ *   Note that the routing tracks passing through a connection block
+ *   are kept by its stub
+ *
+ * Return the flags of the instances indexed by their modules
+ * Note that the top-level module should instanciate the grids
+ * and the routing blocks directly, i.e., without tiles
+ *******************************************************************/
+std::map<ModuleId, std::vector<bool>> find_verilog_top_module_unused_instances(const ModuleManager& module_manager,
+                                                                               const DeviceGrid& grids,
+                                                                               const DeviceRRGSB& device_rr_gsb,
+                                                                               const VprPlacementAnnotation& place_annotation,
+                                                                               const VprRoutingAnnotation& routing_annotation,
+                                                                               const e_config_protocol_type& config_protocol_type,
+                                                                               const std::string& config_chain_clock_name,
+                                                                               const bool& verbose) {
+  std::map<ModuleId, std::vector<bool>> unused_instances;
+
+  ModuleId top_module = module_manager.find_module(generate_fpga_top_module_name());
+  VTR_ASSERT(true == module_manager.valid_module_id(top_module));
+
+  /* Index the child instances by their names */
+  std::unordered_map<std::string, std::pair<ModuleId, size_t>> child_instances;
+  for (const ModuleId& child_module : module_manager.child_modules(top_module)) {
+    for (const size_t& instance : module_manager.child_module_instances(top_module, child_module)) {
+      child_instances[module_manager.instance_name(top_module, child_module, instance)] = std::make_pair(child_module, instance);
+    }
+  }
+
+  size_t num_unused_instances = 0;
+  auto mark_unused_instance = [&](const std::string& instance_name) {
+    auto result = child_instances.find(instance_name);
+    VTR_ASSERT(result != child_instances.end());
+    const ModuleId& child_module = result->second.first;
+    if (false == verilog_stub_module_is_supported(module_manager, child_module, config_protocol_type, config_chain_clock_name)) {
+      return;
+    }
+    std::vector<bool>& child_flags = unused_instances[child_module];
+    if (true == child_flags.empty()) {
+      child_flags.resize(module_manager.num_instance(top_module, child_module), false);
+    }
+    child_flags[result->second.second] = true;
+    num_unused_instances++;
+    VTR_LOGV(verbose,
+             "Replace unused instance '%s' with a stub\n",
+             instance_name.c_str());
+  };
+
+  auto is_used_node = [&](const RRNodeId& node) {
+    return ClusterNetId::INVALID() != routing_annotation.rr_node_net(node);
+  };
+
+  /* Grids: only the roots of the grids are instanciated, and the corners are not
+   * Note: the names must be consistent with the instance names used in build_top_module()!!!
+   */
+  vtr::Point<size_t> device_size(grids.width(), grids.height());
+  std::string grid_module_name_prefix(GRID_MODULE_NAME_PREFIX);
+  for (size_t ix = 0; ix < grids.width(); ++ix) {
+    for (size_t iy = 0; iy < grids.height(); ++iy) {
+      if ( ((0 == ix) || (grids.width() - 1 == ix))
+        && ((0 == iy) || (grids.height() - 1 == iy)) ) {
+        continue;
+      }
+      t_physical_tile_type_ptr grid_type = grids[ix][iy].type;
+      if ( (true == is_empty_type(grid_type))
+        || (0 < grids[ix][iy].width_offset)
+        || (0 < grids[ix][iy].height_offset) ) {
+        continue;
+      }
+      vtr::Point<size_t> grid_coord(ix, iy);
+      bool grid_used = false;
+      for (const ClusterBlockId& grid_block : place_annotation.grid_blocks(grid_coord)) {
+        if (ClusterBlockId::INVALID() != grid_block) {
+          grid_used = true;
+          break;
+        }
+      }
+      if (true == grid_used) {
+        continue;
+      }
+      /* Core grids are named without border sides */
+      e_side border_side = find_grid_border_side(device_size, grid_coord);
+      mark_unused_instance(generate_grid_block_instance_name(grid_module_name_prefix, std::string(grid_type->name), is_io_type(grid_type), border_side, grid_coord));
+    }
+  }
+
+  /* Routing blocks */
+  vtr::Point<size_t> gsb_range = device_rr_gsb.get_gsb_range();
+  for (size_t ix = 0; ix < gsb_range.x(); ++ix) {
+    for (size_t iy = 0; iy < gsb_range.y(); ++iy) {
+      const RRGSB& rr_gsb = device_rr_gsb.get_gsb(ix, iy);
+
+      if (true == rr_gsb.is_sb_exist()) {
+        bool sb_used = false;
+        for (size_t side = 0; side < rr_gsb.get_num_sides(); ++side) {
+          SideManager side_manager(side);
+          for (size_t itrack = 0; itrack < rr_gsb.get_chan_width(side_manager.get_side()); ++itrack) {
+            sb_used |= is_used_node(rr_gsb.get_chan_node(side_manager.get_side(), itrack));
+          }
+          for (size_t inode = 0; inode < rr_gsb.get_num_opin_nodes(side_manager.get_side()); ++inode) {
+            sb_used |= is_used_node(rr_gsb.get_opin_node(side_manager.get_side(), inode));
+          }
+        }
+        if (false == sb_used) {
+          mark_unused_instance(generate_switch_block_module_name(vtr::Point<size_t>(rr_gsb.get_sb_x(), rr_gsb.get_sb_y())));
+        }
+      }
+
+      for (const t_rr_type& cb_type : {CHANX, CHANY}) {
+        if (false == rr_gsb.is_cb_exist(cb_type)) {
+          continue;
+        }
+        bool cb_used = false;
+        for (const e_side& cb_ipin_side : rr_gsb.get_cb_ipin_sides(cb_type)) {
+          for (size_t inode = 0; inode < rr_gsb.get_num_ipin_nodes(cb_ipin_side); ++inode) {
+            cb_used |= is_used_node(rr_gsb.get_ipin_node(cb_ipin_side, inode));
+          }
+        }
+        if (false == cb_used) {
+          mark_unused_instance(generate_connection_block_module_name(cb_type, vtr::Point<size_t>(rr_gsb.get_cb_x(cb_type), rr_gsb.get_cb_y(cb_type))));
+        }
+      }
+    }
+  }
+
+  VTR_LOG("Replace %lu unused instances out of %lu in the top-level module with stubs\n",
+          num_unused_instances, child_instances.size());
+
+  return unused_instances;
+}
+
+/********************************************************************
+ * Print the stubs of the modules whose instances are replaced
+ *******************************************************************/
+void print_verilog_stub_modules(std::fstream& fp,
+                                const ModuleManager& module_manager,
+                                const std::map<ModuleId, std::vector<bool>>& stubbed_instances,
+                                const std::string& config_chain_clock_name,
+                                const e_verilog_default_net_type& default_net_type) {
+  std::unordered_map<size_t, size_t> num_module_bits;
+
+  for (const auto& kv : stubbed_instances) {
+    write_verilog_stub_module_to_file(fp,
+                                      module_manager,
+                                      kv.first,
+                                      config_chain_clock_name,
+                                      count_module_config_chain_bits(module_manager, kv.first, num_module_bits),
+                                      default_net_type);
+    /* Add an empty line as a splitter */
+    fp << "\n";
+  }
+}
+
+} /* end namespace openfpga */
@@ -0,0 +1,48 @@
+#ifndef VERILOG_STUB_MODULES_H
+#define VERILOG_STUB_MODULES_H
+
+/********************************************************************
+ * Include header files that are required by function declaration
+ *******************************************************************/
+#include <fstream>
+#include <map>
+#include <string>
+#include <vector>
+#include "config_protocol.h"
+#include "device_grid.h"
+#include "device_rr_gsb.h"
+#include "module_manager.h"
+#include "fabric_global_port_info.h"
+#include "vpr_placement_annotation.h"
+#include "vpr_routing_annotation.h"
+#include "verilog_port_types.h"
+
+/********************************************************************
+ * Function declaration
+ *******************************************************************/
+
+/* begin namespace openfpga */
+namespace openfpga {
+
+std::string find_verilog_stub_config_chain_clock_name(const ModuleManager& module_manager,
+                                                      const FabricGlobalPortInfo& global_ports,
+                                                      const e_config_protocol_type& config_protocol_type);
+
+std::map<ModuleId, std::vector<bool>> find_verilog_top_module_unused_instances(const ModuleManager& module_manager,
+                                                                               const DeviceGrid& grids,
+                                                                               const DeviceRRGSB& device_rr_gsb,
+                                                                               const VprPlacementAnnotation& place_annotation,
+                                                                               const VprRoutingAnnotation& routing_annotation,
+                                                                               const e_config_protocol_type& config_protocol_type,
+                                                                               const std::string& config_chain_clock_name,
+                                                                               const bool& verbose);
+
+void print_verilog_stub_modules(std::fstream& fp,
+                                const ModuleManager& module_manager,
+                                const std::map<ModuleId, std::vector<bool>>& stubbed_instances,
+                                const std::string& config_chain_clock_name,
+                                const e_verilog_default_net_type& default_net_type);
+
+} /* end namespace openfpga */
+
+#endif
@@ -3,10 +3,16 @@
  * and print them to files
  ********************************************************************/
 
+#include <functional>
+#include <vector>
+
 /* Headers from vtrutil library */
 #include "vtr_assert.h"
 #include "vtr_log.h"
 
+/* Headers from openfpgautil library */
+#include "openfpga_parallel.h"
+
 #include "verilog_submodule_utils.h"
 #include "verilog_essential_gates.h"
 #include "verilog_decoders.h"
@@ -22,6 +28,28 @@
 /* begin namespace openfpga */
 namespace openfpga {
 
+/*********************************************************************
+ * Register the netlists of a netlist manager to another one,
+ * in the same order, with their types, modules and preprocessing flags
+ * The writers are merged one after another on the calling thread,
+ * so the netlist list does not depend on which writer finishes first
+ ********************************************************************/
+static 
+void merge_verilog_submodule_netlists(NetlistManager& netlist_manager,
+                                      const NetlistManager& task_netlist_manager) {
+  for (const NetlistId& task_nlist : task_netlist_manager.netlists()) {
+    NetlistId nlist_id = netlist_manager.add_netlist(task_netlist_manager.netlist_name(task_nlist));
+    VTR_ASSERT(NetlistId::INVALID() != nlist_id);
+    netlist_manager.set_netlist_type(nlist_id, task_netlist_manager.netlist_type(task_nlist));
+    for (const ModuleId& module : task_netlist_manager.netlist_modules(task_nlist)) {
+      netlist_manager.add_netlist_module(nlist_id, module);
+    }
+    for (const std::string& flag : task_netlist_manager.netlist_preprocessing_flags(task_nlist)) {
+      netlist_manager.add_netlist_preprocessing_flag(nlist_id, flag);
+    }
+  }
+}
+
 /*********************************************************************
  * Top-level function to generate primitive modules:
  * 1. Logic gates: AND/OR, inverter, buffer and transmission-gate/pass-transistor
@@ -30,6 +58,15 @@ namespace openfpga {
  * 4. Wires
  * 5. Configuration memory blocks
  * 6. Verilog template
+ *
+ * Each kind of primitive modules is written to its own files,
+ * so that the files are written on multiple threads when requested:
+ * - Each writer registers its netlists to its own netlist manager,
+ *   which are merged in the order of the writers afterwards
+ * - Routing multiplexers are written ahead of the others,
+ *   as the writer may add modules to the module manager (for RRAM-based multiplexers),
+ *   while the other writers only read the module manager
+ * - The log messages of the writers may interleave when multiple threads are used
  ********************************************************************/
 void print_verilog_submodule(ModuleManager& module_manager, 
                              NetlistManager& netlist_manager,
@@ -45,58 +82,93 @@ void print_verilog_submodule(ModuleManager& module_manager,
    */
   //add_user_defined_verilog_modules(module_manager, circuit_lib);
 
-  print_verilog_submodule_essentials(const_cast<const ModuleManager&>(module_manager), 
-                                     netlist_manager,
-                                     submodule_dir,
-                                     circuit_lib,
-                                     fpga_verilog_opts.default_net_type());
+  /* Writers in the order of their netlists */
+  std::vector<std::function<void(NetlistManager&)>> writers;
+
+  writers.push_back([&](NetlistManager& task_netlist_manager) {
+    print_verilog_submodule_essentials(const_cast<const ModuleManager&>(module_manager), 
+                                       task_netlist_manager,
+                                       submodule_dir,
+                                       circuit_lib,
+                                       fpga_verilog_opts.default_net_type(),
+                                       fpga_verilog_opts.include_signal_init());
+  });
 
   /* Decoders for architecture */
-  print_verilog_submodule_arch_decoders(const_cast<const ModuleManager&>(module_manager),
-                                        netlist_manager, 
-                                        decoder_lib, 
-                                        submodule_dir,
-                                        fpga_verilog_opts.default_net_type());
+  writers.push_back([&](NetlistManager& task_netlist_manager) {
+    print_verilog_submodule_arch_decoders(const_cast<const ModuleManager&>(module_manager),
+                                          task_netlist_manager, 
+                                          decoder_lib, 
+                                          submodule_dir,
+                                          fpga_verilog_opts.default_net_type());
+  });
 
   /* Routing multiplexers */
   /* NOTE: local decoders generation must go before the MUX generation!!! 
    *       because local decoders modules will be instanciated in the MUX modules 
    */
-  print_verilog_submodule_mux_local_decoders(const_cast<const ModuleManager&>(module_manager),
-                                             netlist_manager, 
-                                             mux_lib, circuit_lib, 
-                                             submodule_dir,
-                                             fpga_verilog_opts.default_net_type());
-  print_verilog_submodule_muxes(module_manager, netlist_manager, mux_lib, circuit_lib,
-                                submodule_dir,
-                                fpga_verilog_opts);
+  writers.push_back([&](NetlistManager& task_netlist_manager) {
+    print_verilog_submodule_mux_local_decoders(const_cast<const ModuleManager&>(module_manager),
+                                               task_netlist_manager, 
+                                               mux_lib, circuit_lib, 
+                                               submodule_dir,
+                                               fpga_verilog_opts.default_net_type());
+  });
 
+  size_t mux_writer_index = writers.size();
+  writers.push_back([&](NetlistManager& task_netlist_manager) {
+    print_verilog_submodule_muxes(module_manager, task_netlist_manager, mux_lib, circuit_lib,
+                                  submodule_dir,
+                                  fpga_verilog_opts);
+  });
  
   /* LUTes */
-  print_verilog_submodule_luts(const_cast<const ModuleManager&>(module_manager),
-                               netlist_manager, circuit_lib,
-                               submodule_dir,
-                               fpga_verilog_opts);
+  writers.push_back([&](NetlistManager& task_netlist_manager) {
+    print_verilog_submodule_luts(const_cast<const ModuleManager&>(module_manager),
+                                 task_netlist_manager, circuit_lib,
+                                 submodule_dir,
+                                 fpga_verilog_opts);
+  });
 
   /* Hard wires */
-  print_verilog_submodule_wires(const_cast<const ModuleManager&>(module_manager),
-                                netlist_manager, circuit_lib,
-                                submodule_dir,
-                                fpga_verilog_opts.default_net_type());
+  writers.push_back([&](NetlistManager& task_netlist_manager) {
+    print_verilog_submodule_wires(const_cast<const ModuleManager&>(module_manager),
+                                  task_netlist_manager, circuit_lib,
+                                  submodule_dir,
+                                  fpga_verilog_opts.default_net_type());
+  });
 
   /* 4. Memories */
-  print_verilog_submodule_memories(const_cast<const ModuleManager&>(module_manager),
-                                   netlist_manager,
-                                   mux_lib, circuit_lib, 
-                                   submodule_dir,
-                                   fpga_verilog_opts);
+  writers.push_back([&](NetlistManager& task_netlist_manager) {
+    print_verilog_submodule_memories(const_cast<const ModuleManager&>(module_manager),
+                                     task_netlist_manager,
+                                     mux_lib, circuit_lib, 
+                                     submodule_dir,
+                                     fpga_verilog_opts);
+  });
 
   /* 5. Dump template for all the modules */
   if (true == fpga_verilog_opts.print_user_defined_template()) { 
-    print_verilog_submodule_templates(const_cast<const ModuleManager&>(module_manager),
-                                      circuit_lib,
-                                      submodule_dir,
-                                      fpga_verilog_opts.default_net_type());
+    writers.push_back([&](NetlistManager& task_netlist_manager) {
+      (void)task_netlist_manager;
+      print_verilog_submodule_templates(const_cast<const ModuleManager&>(module_manager),
+                                        circuit_lib,
+                                        submodule_dir,
+                                        fpga_verilog_opts.default_net_type());
+    });
+  }
+
+  std::vector<NetlistManager> task_netlist_managers(writers.size());
+  writers[mux_writer_index](task_netlist_managers[mux_writer_index]);
+  parallel_for(writers.size(), fpga_verilog_opts.num_threads(),
+               [&](const size_t& iwriter) {
+                 if (iwriter != mux_writer_index) {
+                   writers[iwriter](task_netlist_managers[iwriter]);
+                 }
+               });
+
+  for (const NetlistManager& task_netlist_manager : task_netlist_managers) {
+    merge_verilog_submodule_netlists(netlist_manager, task_netlist_manager);
   }
 
   /* Create a header file to include all the subckts */
@@ -56,10 +56,10 @@ void print_verilog_submodule_timing(std::fstream& fp,
   /* Ensure a valid file handler*/
   VTR_ASSERT(true == valid_file_stream(fp));
 
-  fp << std::endl;
-  fp << "`ifdef " << VERILOG_TIMING_PREPROC_FLAG << std::endl;
+  fp << "\n";
+  fp << "`ifdef " << VERILOG_TIMING_PREPROC_FLAG << "\n";
   print_verilog_comment(fp, std::string("------ BEGIN Pin-to-pin Timing constraints -----"));
-  fp << "\tspecify" << std::endl;
+  fp << "\tspecify\n";
 
   /* Read out pin-to-pin delays by finding out all the edges belonging to a circuit model */
   for (const auto& timing_edge : circuit_lib.timing_edges_by_model(circuit_model)) {
@@ -81,15 +81,116 @@ void print_verilog_submodule_timing(std::fstream& fp,
      fp << "(" << std::setprecision(FLOAT_PRECISION) << circuit_lib.timing_edge_delay(timing_edge, CIRCUIT_MODEL_DELAY_RISE) / VERILOG_SIM_TIMESCALE;
      fp << ", ";
      fp << std::setprecision(FLOAT_PRECISION) << circuit_lib.timing_edge_delay(timing_edge, CIRCUIT_MODEL_DELAY_FALL) / VERILOG_SIM_TIMESCALE << ")";
-     fp << ";" << std::endl;
+     fp << ";\n";
   }
 
-  fp << "\tendspecify" << std::endl;
+  fp << "\tendspecify\n";
   print_verilog_comment(fp, std::string("------ END Pin-to-pin Timing constraints -----"));
-  fp << "`endif" << std::endl;
+  fp << "`endif\n";
 
 }
 
+/************************************************
+ * Find the input ports of a circuit model whose signals
+ * should be initialized in simulation:
+ * - Passgate: the datapath input, i.e., the first port
+ * - Logic gates (ONLY for MUX2): the datapath inputs, i.e., the first two ports
+ * Return an empty list if the circuit model does not require any initialization
+ ***********************************************/
+std::vector<CircuitPortId> find_circuit_model_signal_init_ports(const CircuitLibrary& circuit_lib,
+                                                                const CircuitModelId& circuit_model) {
+  std::vector<CircuitPortId> signal_init_ports;
+
+  if (CIRCUIT_MODEL_PASSGATE == circuit_lib.model_type(circuit_model)) {
+    std::vector<CircuitPortId> input_ports = circuit_lib.model_input_ports(circuit_model);
+    VTR_ASSERT(0 < input_ports.size());
+    signal_init_ports.push_back(input_ports[0]); 
+  }
+
+  if ( (CIRCUIT_MODEL_GATE == circuit_lib.model_type(circuit_model))
+    && (CIRCUIT_MODEL_GATE_MUX2 == circuit_lib.gate_type(circuit_model)) ) {
+    std::vector<CircuitPortId> input_ports = circuit_lib.model_input_ports(circuit_model);
+    VTR_ASSERT(1 < input_ports.size());
+    signal_init_ports.push_back(input_ports[0]); 
+    signal_init_ports.push_back(input_ports[1]); 
+  }
+
+  return signal_init_ports;
+}
+
+/************************************************
+ * Print the deposition of initial values for the input ports
+ * of a primitive module, whose instance is at the given hierarchical path
+ * An empty path denotes the ports of the module itself, i.e.,
+ * when the initialization is printed inside the module body
+ ***********************************************/
+void print_verilog_signal_init_deposits(std::fstream& fp, 
+                                        const CircuitLibrary& circuit_lib,
+                                        const std::vector<CircuitPortId>& input_ports,
+                                        const std::string& hie_path) {
+  /* Ensure a valid file handler*/
+  VTR_ASSERT(true == valid_file_stream(fp));
+
+  std::string port_prefix;
+  if (false == hie_path.empty()) {
+    port_prefix = hie_path + ".";
+  }
+
+  print_verilog_comment(fp, std::string("------ BEGIN driver initialization -----"));
+  fp << "\tinitial begin\n";
+  fp << "\t`ifdef " << VERILOG_FORMAL_VERIFICATION_PREPROC_FLAG << "\n";
+
+  for (const auto& input_port : input_ports) {
+    /* Only for formal verification: deposite a zero signal values */
+    /* Initialize each input port */
+    BasicPort input_port_info(circuit_lib.port_lib_name(input_port), circuit_lib.port_size(input_port));
+    input_port_info.set_origin_port_width(input_port_info.get_width());
+    fp << "\t\t$deposit(";
+    fp << port_prefix;
+    fp << generate_verilog_port(VERILOG_PORT_CONKT, input_port_info, false);
+    fp << ", " <<  circuit_lib.port_size(input_port) << "'b" << std::string(circuit_lib.port_size(input_port), '0');
+    fp << ");\n";
+  }
+  fp << "\t`else\n";
+
+  /* Regular case: deposite initial signal values: a random value */
+  for (const auto& input_port : input_ports) {
+    BasicPort input_port_info(circuit_lib.port_lib_name(input_port), circuit_lib.port_size(input_port));
+    input_port_info.set_origin_port_width(input_port_info.get_width());
+    fp << "\t\t$deposit(";
+    fp << port_prefix;
+    fp << generate_verilog_port(VERILOG_PORT_CONKT, input_port_info, false);
+    fp << ", $random % 2 ? 1'b1 : 1'b0);\n";
+  }
+
+  fp << "\t`endif\n\n";
+  fp << "\tend\n";
+  print_verilog_comment(fp, std::string("------ END driver initialization -----"));
+}
+
+/************************************************
+ * Print signal initialization inside the body of a primitive module,
+ * which is enabled by the preprocessing flag of signal initialization
+ * As it is instanciated with the module, testbenches do not need
+ * to walk through the hierarchy of the fabric to initialize each instance
+ ***********************************************/
+void print_verilog_submodule_signal_init(std::fstream& fp, 
+                                         const CircuitLibrary& circuit_lib,
+                                         const CircuitModelId& circuit_model) {
+  std::vector<CircuitPortId> signal_init_ports = find_circuit_model_signal_init_ports(circuit_lib, circuit_model);
+  if (true == signal_init_ports.empty()) {
+    return;
+  }
+
+  /* Ensure a valid file handler*/
+  VTR_ASSERT(true == valid_file_stream(fp));
+
+  fp << "\n";
+  fp << "`ifdef " << VERILOG_SIGNAL_INIT_PREPROC_FLAG << "\n";
+  print_verilog_signal_init_deposits(fp, circuit_lib, signal_init_ports, std::string());
+  fp << "`endif\n";
+}
+
 /*********************************************************************
  * Register all the user-defined modules in the module manager
  * Walk through the circuit library and add user-defined circuit models
@@ -153,7 +254,7 @@ void print_one_verilog_template_module(const ModuleManager& module_manager,
   print_verilog_comment(fp, std::string("----- Internal logic should start here -----"));
 
   /* Add some empty lines as placeholders for the internal logic*/
-  fp << std::endl << std::endl;
+  fp << "\n\n";
  
   print_verilog_comment(fp, std::string("----- Internal logic should end here -----"));
 
@@ -161,7 +262,7 @@ void print_one_verilog_template_module(const ModuleManager& module_manager,
   print_verilog_module_end(fp, module_name);
 
   /* Add an empty line as a splitter */
-  fp << std::endl;
+  fp << "\n";
 }
 
 /*********************************************************************
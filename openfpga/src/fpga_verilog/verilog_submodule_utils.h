@@ -6,6 +6,7 @@
  *******************************************************************/
 #include <fstream>
 #include <string>
+#include <vector>
 #include "module_manager.h"
 #include "circuit_library.h"
 #include "verilog_port_types.h"
@@ -21,6 +22,18 @@ void print_verilog_submodule_timing(std::fstream& fp,
                                     const CircuitLibrary& circuit_lib,
                                     const CircuitModelId& circuit_model);
 
+std::vector<CircuitPortId> find_circuit_model_signal_init_ports(const CircuitLibrary& circuit_lib,
+                                                                const CircuitModelId& circuit_model);
+
+void print_verilog_signal_init_deposits(std::fstream& fp, 
+                                        const CircuitLibrary& circuit_lib,
+                                        const std::vector<CircuitPortId>& input_ports,
+                                        const std::string& hie_path);
+
+void print_verilog_submodule_signal_init(std::fstream& fp, 
+                                         const CircuitLibrary& circuit_lib,
+                                         const CircuitModelId& circuit_model);
+
 void add_user_defined_verilog_modules(ModuleManager& module_manager, 
                                       const CircuitLibrary& circuit_lib);
 
@@ -18,11 +18,18 @@ VerilogTestbenchOption::VerilogTestbenchOption() {
   reference_benchmark_file_path_.clear();
   print_preconfig_top_testbench_ = false;
   print_formal_verification_top_netlist_ = false;
+  print_tile_formal_verification_netlists_ = false;
   print_top_testbench_ = false;
+  print_runtime_top_testbench_ = false;
+  print_verilator_harness_ = false;
+  use_bitstream_memory_file_ = false;
+  use_preconfig_bitstream_memory_file_ = false;
   simulation_ini_path_.clear();
   explicit_port_mapping_ = false;
   support_icarus_simulator_ = false;
   include_signal_init_ = false;
+  fabric_signal_init_ = false;
+  compression_ = FILE_COMPRESSION_NONE;
   verbose_output_ = false;
 }
 
@@ -45,6 +52,10 @@ bool VerilogTestbenchOption::print_formal_verification_top_netlist() const {
   return print_formal_verification_top_netlist_;
 }
 
+bool VerilogTestbenchOption::print_tile_formal_verification_netlists() const {
+  return print_tile_formal_verification_netlists_;
+}
+
 bool VerilogTestbenchOption::print_preconfig_top_testbench() const {
   return print_preconfig_top_testbench_;
 }
@@ -53,10 +64,26 @@ bool VerilogTestbenchOption::print_top_testbench() const {
   return print_top_testbench_;
 }
 
+bool VerilogTestbenchOption::print_runtime_top_testbench() const {
+  return print_runtime_top_testbench_;
+}
+
+bool VerilogTestbenchOption::print_verilator_harness() const {
+  return print_verilator_harness_;
+}
+
 bool VerilogTestbenchOption::fast_configuration() const {
   return fast_configuration_;
 }
 
+bool VerilogTestbenchOption::use_bitstream_memory_file() const {
+  return use_bitstream_memory_file_;
+}
+
+bool VerilogTestbenchOption::use_preconfig_bitstream_memory_file() const {
+  return use_preconfig_bitstream_memory_file_;
+}
+
 bool VerilogTestbenchOption::print_simulation_ini() const {
   return !simulation_ini_path_.empty();
 }
@@ -73,10 +100,18 @@ bool VerilogTestbenchOption::include_signal_init() const {
   return include_signal_init_;
 }
 
+bool VerilogTestbenchOption::fabric_signal_init() const {
+  return fabric_signal_init_;
+}
+
 bool VerilogTestbenchOption::support_icarus_simulator() const {
   return support_icarus_simulator_;
 }
 
+e_file_compression VerilogTestbenchOption::compression() const {
+  return compression_;
+}
+
 bool VerilogTestbenchOption::verbose_output() const {
   return verbose_output_;
 }
@@ -99,16 +134,29 @@ void VerilogTestbenchOption::set_reference_benchmark_file_path(const std::string
    */
   set_print_preconfig_top_testbench(print_preconfig_top_testbench_); 
   set_print_top_testbench(print_top_testbench_); 
+  set_print_verilator_harness(print_verilator_harness_); 
 }
  
 void VerilogTestbenchOption::set_print_formal_verification_top_netlist(const bool& enabled) {
   print_formal_verification_top_netlist_ = enabled;
 }
 
+void VerilogTestbenchOption::set_print_tile_formal_verification_netlists(const bool& enabled) {
+  print_tile_formal_verification_netlists_ = enabled;
+}
+
 void VerilogTestbenchOption::set_fast_configuration(const bool& enabled) {
   fast_configuration_ = enabled;
 }
 
+void VerilogTestbenchOption::set_use_bitstream_memory_file(const bool& enabled) {
+  use_bitstream_memory_file_ = enabled;
+}
+
+void VerilogTestbenchOption::set_use_preconfig_bitstream_memory_file(const bool& enabled) {
+  use_preconfig_bitstream_memory_file_ = enabled;
+}
+
 void VerilogTestbenchOption::set_print_preconfig_top_testbench(const bool& enabled) {
   print_preconfig_top_testbench_ = enabled
                                  && (!reference_benchmark_file_path_.empty());
@@ -125,6 +173,22 @@ void VerilogTestbenchOption::set_print_top_testbench(const bool& enabled) {
   print_top_testbench_ = enabled && (!reference_benchmark_file_path_.empty());
 }
 
+void VerilogTestbenchOption::set_print_runtime_top_testbench(const bool& enabled) {
+  print_runtime_top_testbench_ = enabled;
+}
+
+void VerilogTestbenchOption::set_print_verilator_harness(const bool& enabled) {
+  print_verilator_harness_ = enabled
+                           && (!reference_benchmark_file_path_.empty());
+  /* Enable print formal verification top_netlist if this is enabled */
+  if (true == print_verilator_harness_) {
+    if (false == print_formal_verification_top_netlist_) { 
+      VTR_LOG_WARN("Forcely enable to print top-level Verilog netlist in formal verification purpose as print Verilator harness is enabled\n");
+      print_formal_verification_top_netlist_ = true;
+    }
+  }
+}
+
 void VerilogTestbenchOption::set_print_simulation_ini(const std::string& simulation_ini_path) {
   simulation_ini_path_ = simulation_ini_path;
 }
@@ -137,10 +201,18 @@ void VerilogTestbenchOption::set_include_signal_init(const bool& enabled) {
   include_signal_init_ = enabled;
 }
 
+void VerilogTestbenchOption::set_fabric_signal_init(const bool& enabled) {
+  fabric_signal_init_ = enabled;
+}
+
 void VerilogTestbenchOption::set_support_icarus_simulator(const bool& enabled) {
   support_icarus_simulator_ = enabled;
 }
 
+void VerilogTestbenchOption::set_compression(const e_file_compression& compression) {
+  compression_ = compression;
+}
+
 void VerilogTestbenchOption::set_verbose_output(const bool& enabled) {
   verbose_output_ = enabled;
 }
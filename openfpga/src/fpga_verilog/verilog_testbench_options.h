@@ -5,6 +5,7 @@
  * Include header files required by the data structure definition
  *******************************************************************/
 #include <string>
+#include "openfpga_compressed_stream.h"
 
 /* Begin namespace openfpga */
 namespace openfpga {
@@ -26,14 +27,21 @@ class VerilogTestbenchOption {
     std::string fabric_netlist_file_path() const;
     std::string reference_benchmark_file_path() const;
     bool fast_configuration() const;
+    bool use_bitstream_memory_file() const;
+    bool use_preconfig_bitstream_memory_file() const;
     bool print_formal_verification_top_netlist() const;
+    bool print_tile_formal_verification_netlists() const;
     bool print_preconfig_top_testbench() const;
     bool print_top_testbench() const;
+    bool print_runtime_top_testbench() const;
+    bool print_verilator_harness() const;
     bool print_simulation_ini() const;
     std::string simulation_ini_path() const;
     bool explicit_port_mapping() const;
     bool include_signal_init() const;
+    bool fabric_signal_init() const;
     bool support_icarus_simulator() const;
+    e_file_compression compression() const;
     bool verbose_output() const;
   public: /* Public validator */
     bool validate() const;
@@ -50,28 +58,59 @@ class VerilogTestbenchOption {
      */
     void set_fabric_netlist_file_path(const std::string& fabric_netlist_file_path);
     void set_print_formal_verification_top_netlist(const bool& enabled);
+    /* Print a pre-configured module and a reference sub-netlist for each grid used by the design,
+     * so that the grids can be checked by formal equivalence in independent jobs
+     */
+    void set_print_tile_formal_verification_netlists(const bool& enabled);
     /* The preconfig top testbench generation can be enabled only when formal verification top netlist is enabled */
     void set_print_preconfig_top_testbench(const bool& enabled);
     void set_fast_configuration(const bool& enabled);
+    /* Write the bitstream of the full testbench to a memory file,
+     * which is loaded by $readmemb during simulation
+     */
+    void set_use_bitstream_memory_file(const bool& enabled);
+    /* Write the bitstream of the formal verification top netlist to a memory file,
+     * which is loaded by $readmemb during simulation
+     */
+    void set_use_preconfig_bitstream_memory_file(const bool& enabled);
     void set_print_top_testbench(const bool& enabled);
+    /* The testbench loading bitstreams and I/O vectors at run time
+     * depends only on the fabric, so that it does not require the reference benchmark
+     */
+    void set_print_runtime_top_testbench(const bool& enabled);
+    /* The Verilator harness generation can be enabled only when formal verification top netlist is enabled */
+    void set_print_verilator_harness(const bool& enabled);
     void set_print_simulation_ini(const std::string& simulation_ini_path);
     void set_explicit_port_mapping(const bool& enabled);
     void set_include_signal_init(const bool& enabled);
+    /* The drivers are initialized inside the primitive modules of the fabric netlists,
+     * so that the testbenches only enable the initialization,
+     * instead of depositing each instance across the hierarchy
+     */
+    void set_fabric_signal_init(const bool& enabled);
     void set_support_icarus_simulator(const bool& enabled);
+    void set_compression(const e_file_compression& compression);
     void set_verbose_output(const bool& enabled);
   private: /* Internal Data */
     std::string output_directory_;
     std::string fabric_netlist_file_path_;
     std::string reference_benchmark_file_path_;
     bool fast_configuration_;
+    bool use_bitstream_memory_file_;
+    bool use_preconfig_bitstream_memory_file_;
     bool print_formal_verification_top_netlist_;
+    bool print_tile_formal_verification_netlists_;
     bool print_preconfig_top_testbench_;
     bool print_top_testbench_;
+    bool print_runtime_top_testbench_;
+    bool print_verilator_harness_;
     /* Print simulation ini is enabled only when the path is not empty */
     std::string simulation_ini_path_;
     bool explicit_port_mapping_;
     bool support_icarus_simulator_;
     bool include_signal_init_;
+    bool fabric_signal_init_;
+    e_file_compression compression_;
     bool verbose_output_;
 };
 
@@ -25,6 +25,7 @@
 
 #include "verilog_constants.h"
 #include "verilog_writer_utils.h"
+#include "verilog_submodule_utils.h"
 #include "verilog_testbench_utils.h"
 
 /* begin namespace openfpga */
@@ -54,7 +55,7 @@ void print_verilog_testbench_fpga_instance(std::fstream& fp,
                                 explicit_port_mapping); 
 
   /* Add an empty line as a splitter */
-  fp << std::endl;
+  fp << "\n";
 }
 
 /********************************************************************
@@ -73,7 +74,7 @@ void print_verilog_testbench_benchmark_instance(std::fstream& fp,
   /* Validate the file stream */
   valid_file_stream(fp);
 
-  fp << "\t" << module_name << " " << instance_name << "(" << std::endl;
+  fp << "\t" << module_name << " " << instance_name << "(\n";
 
   size_t port_counter = 0;
   for (const AtomBlockId& atom_blk : atom_ctx.nlist.blocks()) {
@@ -91,7 +92,7 @@ void print_verilog_testbench_benchmark_instance(std::fstream& fp,
 
     /* The first port does not need a comma */
     if(0 < port_counter){
-      fp << "," << std::endl;
+      fp << ",\n";
     }
     /* Input port follows the logical block name while output port requires a special postfix */
     if (AtomBlockType::INPAD == atom_ctx.nlist.block_type(atom_blk)) {
@@ -130,7 +131,7 @@ void print_verilog_testbench_benchmark_instance(std::fstream& fp,
     /* Update the counter */
     port_counter++;
   }
-  fp << "\t);" << std::endl;
+  fp << "\t);\n";
 }
 
 /********************************************************************
@@ -138,7 +139,8 @@ void print_verilog_testbench_benchmark_instance(std::fstream& fp,
  * 1. For mapped I/Os, this function will wire them to the input ports
  *    of the pre-configured FPGA top module
  * 2. For unmapped I/Os, this function will assign a constant value
- *    by default 
+ *    by default. Consecutive unmapped I/Os of a port are assigned
+ *    at once, as most of the I/Os are unused for small benchmarks
  *******************************************************************/
 void print_verilog_testbench_connect_fpga_ios(std::fstream& fp,
                                               const ModuleManager& module_manager,
@@ -165,11 +167,11 @@ void print_verilog_testbench_connect_fpga_ios(std::fstream& fp,
     }
   }
 
-  /* Keep tracking which I/Os have been used */
-  std::map<ModulePortId, std::vector<bool>> io_used;
+  /* Keep tracking which atom block is mapped to each I/O: [port][io_index] */
+  std::map<ModulePortId, std::vector<AtomBlockId>> io_atom_blocks;
   for (const ModulePortId& module_io_port_id :  module_io_ports) {
     const BasicPort& module_io_port = module_manager.module_port(top_module, module_io_port_id);
-    io_used[module_io_port_id] = std::vector<bool>(module_io_port.get_width(), false);
+    io_atom_blocks[module_io_port_id] = std::vector<AtomBlockId>(module_io_port.get_width(), AtomBlockId::INVALID());
   }
 
   /* Type mapping between VPR block and Module port */
@@ -259,37 +261,44 @@ void print_verilog_testbench_connect_fpga_ios(std::fstream& fp,
     }
 
     /* Mark this I/O has been used/wired */
-    io_used[mapped_module_io_info.first][io_index] = true;
+    io_atom_blocks[mapped_module_io_info.first][io_index] = atom_blk;
 
     /* Add an empty line as a splitter */
-    fp << std::endl;
+    fp << "\n";
   }
 
   /* Wire the unused iopads to a constant */
   print_verilog_comment(fp, std::string("----- Wire unused FPGA I/Os to constants -----"));
   for (const ModulePortId& module_io_port_id : module_io_ports) {
-    for (size_t io_index = 0; io_index < io_used[module_io_port_id].size(); ++io_index) {
+    /* Unused output pads are not wired */
+    const std::vector<AtomBlockId>& port_atom_blocks = io_atom_blocks[module_io_port_id];
+    size_t io_index = 0;
+    while ( (ModuleManager::MODULE_GPOUT_PORT != module_manager.port_type(top_module, module_io_port_id))
+         && (io_index < port_atom_blocks.size()) ) {
       /* Bypass used iopads */
-      if (true == io_used[module_io_port_id][io_index]) {
+      if (AtomBlockId::INVALID() != port_atom_blocks[io_index]) {
+        ++io_index;
         continue;
       }
 
-      /* Bypass unused output pads */
-      if (ModuleManager::MODULE_GPOUT_PORT == module_manager.port_type(top_module, module_io_port_id)) {
-        continue;
+      /* Find the range of consecutive unused iopads */
+      size_t lsb = io_index;
+      while ( (io_index < port_atom_blocks.size())
+           && (AtomBlockId::INVALID() == port_atom_blocks[io_index]) ) {
+        ++io_index;
       }
 
       /* Wire to a contant */
       BasicPort module_unused_io_port = module_manager.module_port(top_module, module_io_port_id);
-      /* Set the port pin index */ 
-      module_unused_io_port.set_width(io_index, io_index);
+      /* Set the port pin indices */ 
+      module_unused_io_port.set_width(lsb, io_index - 1);
 
       std::vector<size_t> default_values(module_unused_io_port.get_width(), unused_io_value);
       print_verilog_wire_constant_values(fp, module_unused_io_port, default_values);
     }
 
     /* Add an empty line as a splitter */
-    fp << std::endl;
+    fp << "\n";
   }
 }
 
@@ -314,10 +323,10 @@ void print_verilog_timeout_and_vcd(std::fstream& fp,
 
   print_verilog_comment(fp, std::string("----- Begin Icarus requirement -------"));
 
-  fp << "\tinitial begin" << std::endl;
-  fp << "\t\t$dumpfile(\"" << vcd_fname << "\");" << std::endl;
-  fp << "\t\t$dumpvars(1, " << module_name << ");" << std::endl;
-  fp << "\tend" << std::endl;
+  fp << "\tinitial begin\n";
+  fp << "\t\t$dumpfile(\"" << vcd_fname << "\");\n";
+  fp << "\t\t$dumpvars(1, " << module_name << ");\n";
+  fp << "\tend\n";
 
   /* Condition ends for the Icarus requirement */
   print_verilog_endif(fp);
@@ -325,26 +334,26 @@ void print_verilog_timeout_and_vcd(std::fstream& fp,
   print_verilog_comment(fp, std::string("----- END Icarus requirement -------"));
 
   /* Add an empty line as splitter */
-  fp << std::endl;
+  fp << "\n";
 
   BasicPort sim_start_port(simulation_start_counter_name, 1);
 
-  fp << "initial begin" << std::endl;
-  fp << "\t" << generate_verilog_port(VERILOG_PORT_CONKT, sim_start_port) << " <= 1'b1;" << std::endl;
-  fp << "\t$timeformat(-9, 2, \"ns\", 20);" << std::endl;
-  fp << "\t$display(\"Simulation start\");" << std::endl;
+  fp << "initial begin\n";
+  fp << "\t" << generate_verilog_port(VERILOG_PORT_CONKT, sim_start_port) << " <= 1'b1;\n";
+  fp << "\t$timeformat(-9, 2, \"ns\", 20);\n";
+  fp << "\t$display(\"Simulation start\");\n";
   print_verilog_comment(fp, std::string("----- Can be changed by the user for his/her need -------"));
-  fp << "\t#" << std::setprecision(10) << simulation_time << std::endl;
-  fp << "\tif(" << error_counter_name << " == 0) begin" << std::endl;
-  fp << "\t\t$display(\"Simulation Succeed\");" << std::endl;
-  fp << "\tend else begin" << std::endl;
-  fp << "\t\t$display(\"Simulation Failed with " << std::string("%d") << " error(s)\", " << error_counter_name << ");" << std::endl;
-  fp << "\tend" << std::endl;
-  fp << "\t$finish;" << std::endl;
-  fp << "end" << std::endl;
+  fp << "\t#" << std::setprecision(10) << simulation_time << "\n";
+  fp << "\tif(" << error_counter_name << " == 0) begin\n";
+  fp << "\t\t$display(\"Simulation Succeed\");\n";
+  fp << "\tend else begin\n";
+  fp << "\t\t$display(\"Simulation Failed with " << std::string("%d") << " error(s)\", " << error_counter_name << ");\n";
+  fp << "\tend\n";
+  fp << "\t$finish;\n";
+  fp << "end\n";
 
   /* Add an empty line as splitter */
-  fp << std::endl;
+  fp << "\n";
 }
 
 /********************************************************************
@@ -398,8 +407,8 @@ void print_verilog_testbench_check(std::fstream& fp,
 
   BasicPort sim_start_port(simulation_start_counter_name, 1);
 
-  fp << "\t" << generate_verilog_port(VERILOG_PORT_REG, sim_start_port) << ";" << std::endl;
-  fp << std::endl;
+  fp << "\t" << generate_verilog_port(VERILOG_PORT_REG, sim_start_port) << ";\n";
+  fp << "\n";
 
   /* TODO: This is limitation when multiple clock signals exist
    * Ideally, all the input signals are generated by different clock edges, 
@@ -408,11 +417,11 @@ void print_verilog_testbench_check(std::fstream& fp,
    */
   VTR_ASSERT(1 <= clock_ports.size());
 
-  fp << "\talways@(negedge " << generate_verilog_port(VERILOG_PORT_CONKT, clock_ports[0]) << ") begin" << std::endl;
-  fp << "\t\tif (1'b1 == " << generate_verilog_port(VERILOG_PORT_CONKT, sim_start_port) << ") begin" << std::endl;
+  fp << "\talways@(negedge " << generate_verilog_port(VERILOG_PORT_CONKT, clock_ports[0]) << ") begin\n";
+  fp << "\t\tif (1'b1 == " << generate_verilog_port(VERILOG_PORT_CONKT, sim_start_port) << ") begin\n";
   fp << "\t\t";
   print_verilog_register_connection(fp, sim_start_port, sim_start_port, true);
-  fp << "\t\tend else begin" << std::endl;
+  fp << "\t\tend else begin\n";
 
   for (const AtomBlockId& atom_blk : atom_ctx.nlist.blocks()) {
     /* Bypass non-I/O atom blocks ! */
@@ -431,18 +440,18 @@ void print_verilog_testbench_check(std::fstream& fp,
      fp << "\t\t\tif(!(" << block_name << fpga_port_postfix;
      fp << " === " << block_name << benchmark_port_postfix;
      fp << ") && !(" << block_name << benchmark_port_postfix;
-     fp << " === 1'bx)) begin" << std::endl;
-     fp << "\t\t\t\t" << block_name << check_flag_port_postfix << " <= 1'b1;" << std::endl;
-     fp << "\t\t\tend else begin" << std::endl;
-     fp << "\t\t\t\t" << block_name << check_flag_port_postfix << "<= 1'b0;" << std::endl;
-     fp << "\t\t\tend" << std::endl; 
+     fp << " === 1'bx)) begin\n";
+     fp << "\t\t\t\t" << block_name << check_flag_port_postfix << " <= 1'b1;\n";
+     fp << "\t\t\tend else begin\n";
+     fp << "\t\t\t\t" << block_name << check_flag_port_postfix << "<= 1'b0;\n";
+     fp << "\t\t\tend\n"; 
     }
   } 
-  fp << "\t\tend" << std::endl;
-  fp << "\tend" << std::endl;
+  fp << "\t\tend\n";
+  fp << "\tend\n";
 
   /* Add an empty line as splitter */
-  fp << std::endl;
+  fp << "\n";
 
   for (const AtomBlockId& atom_blk : atom_ctx.nlist.blocks()) {
     /* Only care about output atom blocks ! */
@@ -456,22 +465,22 @@ void print_verilog_testbench_check(std::fstream& fp,
       block_name = netlist_annotation.block_name(atom_blk);
     } 
 
-    fp << "\talways@(posedge " << block_name << check_flag_port_postfix << ") begin" << std::endl;
-    fp << "\t\tif(" << block_name << check_flag_port_postfix << ") begin" << std::endl;
-    fp << "\t\t\t" << error_counter_name << " = " << error_counter_name << " + 1;" << std::endl;
-    fp << "\t\t\t$display(\"Mismatch on " << block_name << fpga_port_postfix << " at time = " << std::string("%t") << "\", $realtime);" << std::endl;
-    fp << "\t\tend" << std::endl;
-    fp << "\tend" << std::endl;
+    fp << "\talways@(posedge " << block_name << check_flag_port_postfix << ") begin\n";
+    fp << "\t\tif(" << block_name << check_flag_port_postfix << ") begin\n";
+    fp << "\t\t\t" << error_counter_name << " = " << error_counter_name << " + 1;\n";
+    fp << "\t\t\t$display(\"Mismatch on " << block_name << fpga_port_postfix << " at time = " << std::string("%t") << "\", $realtime);\n";
+    fp << "\t\tend\n";
+    fp << "\tend\n";
 
     /* Add an empty line as splitter */
-    fp << std::endl;
+    fp << "\n";
   }
 
   /* Condition ends */
   print_verilog_endif(fp);
 
   /* Add an empty line as splitter */
-  fp << std::endl;
+  fp << "\n";
 }
 
 /********************************************************************
@@ -513,21 +522,21 @@ void print_verilog_testbench_clock_stimuli(std::fstream& fp,
       }
     }
 
-    fp << "\tinitial begin" << std::endl;
+    fp << "\tinitial begin\n";
     /* Create clock stimuli */
-    fp << "\t\t" << generate_verilog_port(VERILOG_PORT_CONKT, clock_port) << " <= 1'b0;" << std::endl;
-    fp << "\t\twhile(1) begin" << std::endl;
-    fp << "\t\t\t#" << std::setprecision(10) << clk_freq_to_use << std::endl;
+    fp << "\t\t" << generate_verilog_port(VERILOG_PORT_CONKT, clock_port) << " <= 1'b0;\n";
+    fp << "\t\twhile(1) begin\n";
+    fp << "\t\t\t#" << std::setprecision(10) << clk_freq_to_use << "\n";
     fp << "\t\t\t" << generate_verilog_port(VERILOG_PORT_CONKT, clock_port);
     fp << " <= !";
     fp << generate_verilog_port(VERILOG_PORT_CONKT, clock_port);
-    fp << ";" << std::endl;
-    fp << "\t\tend" << std::endl;
+    fp << ";\n";
+    fp << "\t\tend\n";
 
-    fp << "\tend" << std::endl;
+    fp << "\tend\n";
 
     /* Add an empty line as splitter */
-    fp << std::endl;
+    fp << "\n";
   }
 }
 
@@ -549,7 +558,7 @@ void print_verilog_testbench_random_stimuli(std::fstream& fp,
 
   print_verilog_comment(fp, std::string("----- Input Initialization -------"));
 
-  fp << "\tinitial begin" << std::endl;
+  fp << "\tinitial begin\n";
 
   for (const AtomBlockId& atom_blk : atom_ctx.nlist.blocks()) {
     /* Bypass non-I/O atom blocks ! */
@@ -578,12 +587,12 @@ void print_verilog_testbench_random_stimuli(std::fstream& fp,
 
     /* TODO: find the clock inputs will be initialized later */
     if (AtomBlockType::INPAD == atom_ctx.nlist.block_type(atom_blk)) {
-      fp << "\t\t" << block_name << " <= 1'b0;" << std::endl;
+      fp << "\t\t" << block_name << " <= 1'b0;\n";
     }
   }
 
   /* Add an empty line as splitter */
-  fp << std::endl;
+  fp << "\n";
   
   /* Set 0 to registers for checking flags */
   for (const AtomBlockId& atom_blk : atom_ctx.nlist.blocks()) {
@@ -600,14 +609,14 @@ void print_verilog_testbench_random_stimuli(std::fstream& fp,
 
     /* Each logical block assumes a single-width port */
     BasicPort output_port(std::string(block_name + check_flag_port_postfix), 1); 
-    fp << "\t\t" << generate_verilog_port(VERILOG_PORT_CONKT, output_port) << " <= 1'b0;" << std::endl;
+    fp << "\t\t" << generate_verilog_port(VERILOG_PORT_CONKT, output_port) << " <= 1'b0;\n";
   }
 
-  fp << "\tend" << std::endl;
+  fp << "\tend\n";
   /* Finish initialization */
 
   /* Add an empty line as splitter */
-  fp << std::endl;
+  fp << "\n";
 
   print_verilog_comment(fp, std::string("----- Input Stimulus -------"));
   /* TODO: This is limitation when multiple clock signals exist
@@ -616,7 +625,7 @@ void print_verilog_testbench_random_stimuli(std::fstream& fp,
    * Currently, as we lack the information, we only use the first clock signal
    */
   VTR_ASSERT(1 <= clock_ports.size());
-  fp << "\talways@(negedge " << generate_verilog_port(VERILOG_PORT_CONKT, clock_ports[0]) << ") begin" << std::endl;
+  fp << "\talways@(negedge " << generate_verilog_port(VERILOG_PORT_CONKT, clock_ports[0]) << ") begin\n";
 
   for (const AtomBlockId& atom_blk : atom_ctx.nlist.blocks()) {
     /* Bypass non-I/O atom blocks ! */
@@ -645,14 +654,14 @@ void print_verilog_testbench_random_stimuli(std::fstream& fp,
 
     /* TODO: find the clock inputs will be initialized later */
     if (AtomBlockType::INPAD == atom_ctx.nlist.block_type(atom_blk)) {
-      fp << "\t\t" << block_name << " <= $random;" << std::endl;
+      fp << "\t\t" << block_name << " <= $random;\n";
     }
   }
 
-  fp << "\tend" << std::endl;
+  fp << "\tend\n";
 
   /* Add an empty line as splitter */
-  fp << std::endl;
+  fp << "\n";
 }
 
 /********************************************************************
@@ -696,11 +705,11 @@ void print_verilog_testbench_shared_ports(std::fstream& fp,
    
     /* Each logical block assumes a single-width port */
     BasicPort input_port(block_name, 1); 
-    fp << "\t" << generate_verilog_port(VERILOG_PORT_REG, input_port) << ";" << std::endl;
+    fp << "\t" << generate_verilog_port(VERILOG_PORT_REG, input_port) << ";\n";
   }
 
   /* Add an empty line as splitter */
-  fp << std::endl;
+  fp << "\n";
 
   /* Instantiate wires for FPGA fabric outputs */
   print_verilog_comment(fp, std::string("----- FPGA fabric outputs -------"));
@@ -719,17 +728,17 @@ void print_verilog_testbench_shared_ports(std::fstream& fp,
 
     /* Each logical block assumes a single-width port */
     BasicPort output_port(std::string(block_name + fpga_output_port_postfix), 1); 
-    fp << "\t" << generate_verilog_port(VERILOG_PORT_WIRE, output_port) << ";" << std::endl;
+    fp << "\t" << generate_verilog_port(VERILOG_PORT_WIRE, output_port) << ";\n";
   }
 
   /* Add an empty line as splitter */
-  fp << std::endl;
+  fp << "\n";
 
   /* Benchmark is instanciated conditionally: only when a preprocessing flag is enable */
   print_verilog_preprocessing_flag(fp, std::string(autocheck_preprocessing_flag)); 
 
   /* Add an empty line as splitter */
-  fp << std::endl;
+  fp << "\n";
 
   /* Instantiate wire for benchmark output */
   print_verilog_comment(fp, std::string("----- Benchmark outputs -------"));
@@ -747,11 +756,11 @@ void print_verilog_testbench_shared_ports(std::fstream& fp,
 
     /* Each logical block assumes a single-width port */
     BasicPort output_port(std::string(block_name + benchmark_output_port_postfix), 1); 
-    fp << "\t" << generate_verilog_port(VERILOG_PORT_WIRE, output_port) << ";" << std::endl;
+    fp << "\t" << generate_verilog_port(VERILOG_PORT_WIRE, output_port) << ";\n";
   }
 
   /* Add an empty line as splitter */
-  fp << std::endl;
+  fp << "\n";
 
   /* Instantiate register for output comparison */
   print_verilog_comment(fp, std::string("----- Output vectors checking flags -------"));
@@ -769,17 +778,17 @@ void print_verilog_testbench_shared_ports(std::fstream& fp,
 
     /* Each logical block assumes a single-width port */
     BasicPort output_port(std::string(block_name + check_flag_port_postfix), 1); 
-    fp << "\t" << generate_verilog_port(VERILOG_PORT_REG, output_port) << ";" << std::endl;
+    fp << "\t" << generate_verilog_port(VERILOG_PORT_REG, output_port) << ";\n";
   }
 
   /* Add an empty line as splitter */
-  fp << std::endl;
+  fp << "\n";
 
   /* Condition ends for the benchmark instanciation */
   print_verilog_endif(fp);
 
   /* Add an empty line as splitter */
-  fp << std::endl;
+  fp << "\n";
 }
 
 /********************************************************************
@@ -833,36 +842,7 @@ void rec_print_verilog_testbench_primitive_module_signal_initialization(std::fst
          */
         VTR_ASSERT_SAFE(child_module == primitive_module);
 
-        print_verilog_comment(fp, std::string("------ BEGIN driver initialization -----"));
-        fp << "\tinitial begin" << std::endl;
-        fp << "\t`ifdef " << VERILOG_FORMAL_VERIFICATION_PREPROC_FLAG << std::endl;
-
-        for (const auto& input_port : circuit_input_ports) {
-          /* Only for formal verification: deposite a zero signal values */
-          /* Initialize each input port */
-          BasicPort input_port_info(circuit_lib.port_lib_name(input_port), circuit_lib.port_size(input_port));
-          input_port_info.set_origin_port_width(input_port_info.get_width());
-          fp << "\t\t$deposit(";
-          fp << child_hie_path << ".";
-          fp << generate_verilog_port(VERILOG_PORT_CONKT, input_port_info, false);
-          fp << ", " <<  circuit_lib.port_size(input_port) << "'b" << std::string(circuit_lib.port_size(input_port), '0');
-          fp << ");" << std::endl;
-        }
-        fp << "\t`else" << std::endl;
-
-        /* Regular case: deposite initial signal values: a random value */
-        for (const auto& input_port : circuit_input_ports) {
-          BasicPort input_port_info(circuit_lib.port_lib_name(input_port), circuit_lib.port_size(input_port));
-          input_port_info.set_origin_port_width(input_port_info.get_width());
-          fp << "\t\t$deposit(";
-          fp << child_hie_path << ".";
-          fp << generate_verilog_port(VERILOG_PORT_CONKT, input_port_info, false);
-          fp << ", $random % 2 ? 1'b1 : 1'b0);" << std::endl;
-        }
-
-        fp << "\t`endif\n" << std::endl;
-        fp << "\tend" << std::endl;
-        print_verilog_comment(fp, std::string("------ END driver initialization -----"));
+        print_verilog_signal_init_deposits(fp, circuit_lib, circuit_input_ports, child_hie_path);
       }
     }
   }
@@ -873,12 +853,16 @@ void rec_print_verilog_testbench_primitive_module_signal_initialization(std::fst
  * which aim to deposit initial values for the input ports of primitive circuit models:
  * - Passgate
  * - Logic gates (ONLY for MUX2)
+ * When the primitive modules of the fabric initialize their own drivers,
+ * only the circuit models with user-defined Verilog netlists are deposited,
+ * as their modules are not written by OpenFPGA
  *******************************************************************/
 void print_verilog_testbench_signal_initialization(std::fstream& fp,
                                                    const std::string& top_instance_name,
                                                    const CircuitLibrary& circuit_lib,
                                                    const ModuleManager& module_manager,
-                                                   const ModuleId& top_module) {
+                                                   const ModuleId& top_module,
+                                                   const bool& fabric_signal_init) {
   /* Validate the file stream */
   valid_file_stream(fp);
 
@@ -888,26 +872,19 @@ void print_verilog_testbench_signal_initialization(std::fstream& fp,
   /* Collect the input ports that require signal initialization */
   std::map<CircuitModelId, std::vector<CircuitPortId>> signal_init_circuit_ports;
 
-  for (const CircuitModelId& model : circuit_lib.models_by_type(CIRCUIT_MODEL_PASSGATE)) {
-    signal_init_circuit_models.push_back(model);
-    /* Only 1 input requires signal initialization,
-     * which is the first port, i.e., the datapath inputs
-     */
-    std::vector<CircuitPortId> input_ports = circuit_lib.model_input_ports(model);
-    VTR_ASSERT(0 < input_ports.size());
-    signal_init_circuit_ports[model].push_back(input_ports[0]); 
-  }
-
-  for (const CircuitModelId& model : circuit_lib.models_by_type(CIRCUIT_MODEL_GATE)) {
-    if (CIRCUIT_MODEL_GATE_MUX2 == circuit_lib.gate_type(model)) {
+  /* Pass-gates come first, then the logic gates */
+  for (const enum e_circuit_model_type& model_type : {CIRCUIT_MODEL_PASSGATE, CIRCUIT_MODEL_GATE}) {
+    for (const CircuitModelId& model : circuit_lib.models_by_type(model_type)) {
+      if ( (true == fabric_signal_init)
+        && (true == circuit_lib.model_verilog_netlist(model).empty()) ) {
+        continue;
+      }
+      std::vector<CircuitPortId> input_ports = find_circuit_model_signal_init_ports(circuit_lib, model);
+      if (true == input_ports.empty()) {
+        continue;
+      }
       signal_init_circuit_models.push_back(model);
-      /* Only 2 input requires signal initialization,
-       * which is the first two port, i.e., the datapath inputs
-       */
-      std::vector<CircuitPortId> input_ports = circuit_lib.model_input_ports(model);
-      VTR_ASSERT(1 < input_ports.size());
-      signal_init_circuit_ports[model].push_back(input_ports[0]); 
-      signal_init_circuit_ports[model].push_back(input_ports[1]); 
+      signal_init_circuit_ports[model] = input_ports; 
     }
   }
 
@@ -917,8 +894,8 @@ void print_verilog_testbench_signal_initialization(std::fstream& fp,
   }
 
   /* Add signal initialization Verilog codes */
-  fp << std::endl;
-  fp << "`ifdef " << VERILOG_SIGNAL_INIT_PREPROC_FLAG << std::endl;
+  fp << "\n";
+  fp << "`ifdef " << VERILOG_SIGNAL_INIT_PREPROC_FLAG << "\n";
   for (const CircuitModelId& signal_init_circuit_model : signal_init_circuit_models) {
     /* Find the module id corresponding to the circuit model from module graph */
     ModuleId primitive_module = module_manager.find_module(circuit_lib.model_name(signal_init_circuit_model));
@@ -932,7 +909,7 @@ void print_verilog_testbench_signal_initialization(std::fstream& fp,
                                                                        primitive_module);
   }
 
-  fp << "`endif" << std::endl;
+  fp << "`endif\n";
 }
 
 } /* end namespace openfpga */
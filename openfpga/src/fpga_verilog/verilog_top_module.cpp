@@ -12,12 +12,14 @@
 
 /* Headers from openfpgautil library */
 #include "openfpga_digest.h"
+#include "openfpga_buffered_file_stream.h"
 
 #include "openfpga_naming.h"
 
 #include "verilog_constants.h"
 #include "verilog_writer_utils.h"
 #include "verilog_module_writer.h"
+#include "verilog_stub_modules.h"
 #include "verilog_top_module.h"
 
 /* begin namespace openfpga */
@@ -33,9 +35,14 @@ namespace openfpga {
  * 3. Add the submodules to the top-level graph
  * 4. Add module nets to connect datapath ports
  * 5. Add module nets/submodules to connect configuration ports
+ *
+ * The stubbed instances, if any, are replaced by the stubs of their modules,
+ * which are written in the same netlist
  *******************************************************************/
 void print_verilog_top_module(NetlistManager& netlist_manager,
                               const ModuleManager& module_manager,
+                              const std::map<ModuleId, std::vector<bool>>& stubbed_instances,
+                              const std::string& config_chain_clock_name,
                               const std::string& verilog_dir,
                               const FabricVerilogOption& options) {
   /* Create a module as the top-level fabric, and add it to the module manager */
@@ -51,25 +58,47 @@ void print_verilog_top_module(NetlistManager& netlist_manager,
           verilog_fname.c_str());
 
   /* Create the file stream */
-  std::fstream fp;
-  fp.open(verilog_fname, std::fstream::out | std::fstream::trunc);
+  BufferedFileStream netlist_file(verilog_fname, options.compression(), options.netlist_update());
+  std::fstream& fp = netlist_file.stream();
 
   check_file_stream(verilog_fname.c_str(), fp);
 
-  print_verilog_file_header(fp, std::string("Top-level Verilog module for FPGA")); 
+  print_verilog_file_header(fp, std::string("Top-level Verilog module for FPGA"), false == options.keep_unchanged_netlists()); 
+
+  /* Write the stubs of the modules whose instances are not used */
+  print_verilog_stub_modules(fp,
+                             module_manager,
+                             stubbed_instances,
+                             config_chain_clock_name,
+                             options.default_net_type());
+
+  /* Write the tile modules, if any, which are only instanciated by the top-level module */
+  for (const ModuleId& module : module_manager.modules()) {
+    if (ModuleManager::MODULE_TILE != module_manager.module_usage(module)) {
+      continue;
+    }
+    write_verilog_module_to_file(fp,
+                                 module_manager,
+                                 module,
+                                 options.explicit_port_mapping(),
+                                 options.default_net_type());
+    /* Add an empty line as a splitter */
+    fp << "\n";
+  }
 
   /* Write the module content in Verilog format */
   write_verilog_module_to_file(fp,
                                module_manager,
                                top_module,
                                options.explicit_port_mapping(),
-                               options.default_net_type());
+                               options.default_net_type(),
+                               stubbed_instances);
 
   /* Add an empty line as a splitter */
-  fp << std::endl;
+  fp << "\n";
 
   /* Close file handler */
-  fp.close();
+  close_verilog_netlist_file(netlist_file);
 
   /* Add fname to the netlist name list */
   NetlistId nlist_id = netlist_manager.add_netlist(verilog_fname);
@@ -77,6 +106,11 @@ void print_verilog_top_module(NetlistManager& netlist_manager,
   netlist_manager.set_netlist_type(nlist_id, NetlistManager::TOP_MODULE_NETLIST);
 
   VTR_LOG("Done\n");
+
+  VTR_LOGV(options.verbose_output(),
+           "Written %lu bytes in %.2f seconds (%.2f MB/s)\n",
+           netlist_file.num_bytes(), netlist_file.elapsed_sec(),
+           netlist_file.bytes_per_sec() / (1024. * 1024.));
 }
 
 } /* end namespace openfpga */
@@ -4,7 +4,9 @@
 /********************************************************************
  * Include header files that are required by function declaration
  *******************************************************************/
+#include <map>
 #include <string>
+#include <vector>
 #include "module_manager.h"
 #include "netlist_manager.h"
 #include "fabric_verilog_options.h"
@@ -18,6 +20,8 @@ namespace openfpga {
 
 void print_verilog_top_module(NetlistManager& netlist_manager,
                               const ModuleManager& module_manager,
+                              const std::map<ModuleId, std::vector<bool>>& stubbed_instances,
+                              const std::string& config_chain_clock_name,
                               const std::string& verilog_dir,
                               const FabricVerilogOption& options);
 
@@ -5,6 +5,7 @@
 #include <fstream>
 #include <iomanip>
 #include <algorithm>
+#include <map>
 
 /* Headers from vtrutil library */
 #include "vtr_log.h"
@@ -14,6 +15,10 @@
 /* Headers from openfpgautil library */
 #include "openfpga_port.h"
 #include "openfpga_digest.h"
+#include "openfpga_decode.h"
+#include "openfpga_buffered_file_stream.h"
+
+#include "command_exit_codes.h"
 
 #include "bitstream_manager_utils.h"
 
@@ -23,7 +28,9 @@
 #include "openfpga_atom_netlist_utils.h"
 
 #include "fabric_bitstream_utils.h"
+#include "config_chain_fabric_bitstream.h"
 #include "fabric_global_port_info_utils.h"
+#include "module_manager_utils.h"
 
 #include "verilog_constants.h"
 #include "verilog_writer_utils.h"
@@ -45,6 +52,28 @@ constexpr char* TOP_TESTBENCH_CHECKFLAG_PORT_POSTFIX = "_flag";
 
 constexpr char* TOP_TESTBENCH_PROG_TASK_NAME = "prog_cycle_task";
 
+constexpr char* TOP_TESTBENCH_BITSTREAM_LOADER_BLOCK_NAME = "bitstream_loader";
+constexpr char* TOP_TESTBENCH_BITSTREAM_MEMORY_NAME = "bitstream_mem";
+constexpr char* TOP_TESTBENCH_BITSTREAM_INDEX_NAME = "ibit";
+constexpr char* TOP_TESTBENCH_BL_SHIFT_INDEX_NAME = "ibl";
+constexpr char* TOP_TESTBENCH_BITSTREAM_WORD_NAME = "bitstream_word";
+constexpr char* TOP_TESTBENCH_BITSTREAM_FILE_NAME = "bitstream_fname";
+constexpr char* TOP_TESTBENCH_BITSTREAM_FILE_DESCRIPTOR_NAME = "bitstream_fd";
+constexpr char* TOP_TESTBENCH_BITSTREAM_PLUSARG_NAME = "bitstream";
+
+/* Names used by the testbench which loads bitstreams and I/O vectors at run time */
+constexpr char* TOP_TESTBENCH_IO_STIMULI_NAME = "io_stimuli";
+constexpr char* TOP_TESTBENCH_IO_EXPECTED_NAME = "io_expected";
+constexpr char* TOP_TESTBENCH_IO_OBSERVED_NAME = "io_observed";
+constexpr char* TOP_TESTBENCH_IO_OUTPUTS_NAME = "io_outputs";
+constexpr char* TOP_TESTBENCH_IO_CYCLE_NAME = "io_cycle";
+constexpr char* TOP_TESTBENCH_IO_INDEX_NAME = "ibit";
+constexpr char* TOP_TESTBENCH_IO_LOADER_BLOCK_NAME = "io_vector_loader";
+constexpr char* TOP_TESTBENCH_FILE_NAME_POSTFIX = "_fname";
+constexpr char* TOP_TESTBENCH_FILE_DESCRIPTOR_POSTFIX = "_fd";
+/* Maximum number of characters of the file paths given by plusargs */
+constexpr size_t TOP_TESTBENCH_MAX_FILE_NAME_LENGTH = 1024;
+
 constexpr char* TOP_TESTBENCH_SIM_START_PORT_NAME = "sim_start";
 
 constexpr char* TOP_TESTBENCH_ERROR_COUNTER = "nb_error";
@@ -61,6 +90,7 @@ constexpr char* TOP_TB_INOUT_REG_POSTFIX = "_reg";
 constexpr char* TOP_TB_CLOCK_REG_POSTFIX = "_reg";
 
 constexpr char* AUTOCHECK_TOP_TESTBENCH_VERILOG_MODULE_POSTFIX = "_autocheck_top_tb";
+constexpr char* RUNTIME_TOP_TESTBENCH_VERILOG_MODULE_POSTFIX = "_runtime_top_tb";
 
 /********************************************************************
  * Generate a simulation clock port name
@@ -87,13 +117,13 @@ void print_verilog_top_testbench_flatten_memory_port(std::fstream& fp,
   print_verilog_comment(fp, std::string("---- Bit Line ports -----"));
   ModulePortId bl_port_id = module_manager.find_module_port(top_module, std::string(MEMORY_BL_PORT_NAME));
   BasicPort bl_port = module_manager.module_port(top_module, bl_port_id);
-  fp << generate_verilog_port(VERILOG_PORT_REG, bl_port) << ";" << std::endl;
+  fp << generate_verilog_port(VERILOG_PORT_REG, bl_port) << ";\n";
 
   /* Print the port for Word-Line */
   print_verilog_comment(fp, std::string("---- Word Line ports -----"));
   ModulePortId wl_port_id = module_manager.find_module_port(top_module, std::string(MEMORY_WL_PORT_NAME));
   BasicPort wl_port = module_manager.module_port(top_module, wl_port_id);
-  fp << generate_verilog_port(VERILOG_PORT_REG, wl_port) << ";" << std::endl;
+  fp << generate_verilog_port(VERILOG_PORT_REG, wl_port) << ";\n";
 }
 
 
@@ -102,6 +132,7 @@ void print_verilog_top_testbench_flatten_memory_port(std::fstream& fp,
  *******************************************************************/
 static
 void print_verilog_top_testbench_config_chain_port(std::fstream& fp,
+                                                   const ConfigProtocol& config_protocol,
                                                    const ModuleManager& module_manager,
                                                    const ModuleId& top_module) {
   /* Validate the file stream */
@@ -111,13 +142,34 @@ void print_verilog_top_testbench_config_chain_port(std::fstream& fp,
   print_verilog_comment(fp, std::string("---- Configuration-chain head -----"));
   ModulePortId cc_head_port_id = module_manager.find_module_port(top_module, generate_configuration_chain_head_name());
   BasicPort config_chain_head_port = module_manager.module_port(top_module, cc_head_port_id);
-  fp << generate_verilog_port(VERILOG_PORT_REG, config_chain_head_port) << ";" << std::endl;
+  fp << generate_verilog_port(VERILOG_PORT_REG, config_chain_head_port) << ";\n";
 
   /* Print the tail of configuration-chains here */
   print_verilog_comment(fp, std::string("---- Configuration-chain tail -----"));
   ModulePortId cc_tail_port_id = module_manager.find_module_port(top_module, generate_configuration_chain_tail_name());
   BasicPort config_chain_tail_port = module_manager.module_port(top_module, cc_tail_port_id);
-  fp << generate_verilog_port(VERILOG_PORT_WIRE, config_chain_tail_port) << ";" << std::endl;
+  fp << generate_verilog_port(VERILOG_PORT_WIRE, config_chain_tail_port) << ";\n";
+
+  if (CONFIG_CHAIN_COMPRESSION_RUN_LENGTH == config_protocol.chain_compression_type()) {
+    /* Print the run length of the decompressors here */
+    print_verilog_comment(fp, std::string("---- Run length for configuration-chain decompressors -----"));
+    ModulePortId run_length_port_id = module_manager.find_module_port(top_module, std::string(CONFIG_CHAIN_RUN_LENGTH_PORT_NAME));
+    BasicPort run_length_port = module_manager.module_port(top_module, run_length_port_id);
+    fp << generate_verilog_port(VERILOG_PORT_REG, run_length_port) << ";\n";
+
+    /* The decompressors are reset and clocked along with the configuration chains */
+    print_verilog_comment(fp, std::string("---- Reset and clock for configuration-chain decompressors -----"));
+    BasicPort prog_reset_port(std::string(TOP_TB_PROG_RESET_PORT_NAME), 1);
+    BasicPort prog_clock_port(std::string(TOP_TB_PROG_CLOCK_PORT_NAME), 1);
+    ModulePortId rle_reset_port_id = module_manager.find_module_port(top_module, std::string(CONFIG_CHAIN_DECOMPRESSOR_RESET_PORT_NAME));
+    BasicPort rle_reset_port = module_manager.module_port(top_module, rle_reset_port_id);
+    ModulePortId rle_clk_port_id = module_manager.find_module_port(top_module, std::string(CONFIG_CHAIN_DECOMPRESSOR_CLOCK_PORT_NAME));
+    BasicPort rle_clk_port = module_manager.module_port(top_module, rle_clk_port_id);
+    fp << generate_verilog_port(VERILOG_PORT_WIRE, rle_reset_port) << ";\n";
+    fp << generate_verilog_port(VERILOG_PORT_WIRE, rle_clk_port) << ";\n";
+    print_verilog_wire_connection(fp, rle_reset_port, prog_reset_port, false);
+    print_verilog_wire_connection(fp, rle_clk_port, prog_clock_port, false);
+  }
 }
 
 /********************************************************************
@@ -125,18 +177,29 @@ void print_verilog_top_testbench_config_chain_port(std::fstream& fp,
  *******************************************************************/
 static
 void print_verilog_top_testbench_memory_bank_port(std::fstream& fp,
+                                                  const ConfigProtocol& config_protocol,
                                                   const ModuleManager& module_manager,
                                                   const ModuleId& top_module) {
   /* Validate the file stream */
   valid_file_stream(fp);
 
-  /* Print the address port for the Bit-Line decoder here */
-  print_verilog_comment(fp, std::string("---- Address port for Bit-Line decoder -----"));
-  ModulePortId bl_addr_port_id = module_manager.find_module_port(top_module,
-                                                                 std::string(DECODER_BL_ADDRESS_PORT_NAME));
-  BasicPort bl_addr_port = module_manager.module_port(top_module, bl_addr_port_id);
+  if (BLWL_PROTOCOL_SHIFT_REGISTER == config_protocol.bl_protocol_type()) {
+    /* Print the clock port for the Bit-Line shift registers here */
+    print_verilog_comment(fp, std::string("---- Clock port for Bit-Line shift registers -----"));
+    ModulePortId bl_sr_clk_port_id = module_manager.find_module_port(top_module,
+                                                                     std::string(BL_SHIFT_REGISTER_CLOCK_PORT_NAME));
+    BasicPort bl_sr_clk_port = module_manager.module_port(top_module, bl_sr_clk_port_id);
+
+    fp << generate_verilog_port(VERILOG_PORT_REG, bl_sr_clk_port) << ";\n";
+  } else {
+    /* Print the address port for the Bit-Line decoder here */
+    print_verilog_comment(fp, std::string("---- Address port for Bit-Line decoder -----"));
+    ModulePortId bl_addr_port_id = module_manager.find_module_port(top_module,
+                                                                   std::string(DECODER_BL_ADDRESS_PORT_NAME));
+    BasicPort bl_addr_port = module_manager.module_port(top_module, bl_addr_port_id);
 
-  fp << generate_verilog_port(VERILOG_PORT_REG, bl_addr_port) << ";" << std::endl;
+    fp << generate_verilog_port(VERILOG_PORT_REG, bl_addr_port) << ";\n";
+  }
 
   /* Print the address port for the Word-Line decoder here */
   print_verilog_comment(fp, std::string("---- Address port for Word-Line decoder -----"));
@@ -144,14 +207,14 @@ void print_verilog_top_testbench_memory_bank_port(std::fstream& fp,
                                                                  std::string(DECODER_WL_ADDRESS_PORT_NAME));
   BasicPort wl_addr_port = module_manager.module_port(top_module, wl_addr_port_id);
 
-  fp << generate_verilog_port(VERILOG_PORT_REG, wl_addr_port) << ";" << std::endl;
+  fp << generate_verilog_port(VERILOG_PORT_REG, wl_addr_port) << ";\n";
 
   /* Print the data-input port for the frame-based decoder here */
   print_verilog_comment(fp, std::string("---- Data input port for memory decoders -----"));
   ModulePortId din_port_id = module_manager.find_module_port(top_module,
                                                              std::string(DECODER_DATA_IN_PORT_NAME));
   BasicPort din_port = module_manager.module_port(top_module, din_port_id);
-  fp << generate_verilog_port(VERILOG_PORT_REG, din_port) << ";" << std::endl;
+  fp << generate_verilog_port(VERILOG_PORT_REG, din_port) << ";\n";
 
   /* Generate enable signal waveform here:
    * which is a 90 degree phase shift than the programming clock   
@@ -164,8 +227,8 @@ void print_verilog_top_testbench_memory_bank_port(std::fstream& fp,
 
   BasicPort config_done_port(std::string(TOP_TB_CONFIG_DONE_PORT_NAME), 1);
 
-  fp << generate_verilog_port(VERILOG_PORT_WIRE, en_port) << ";" << std::endl;
-  fp << generate_verilog_port(VERILOG_PORT_REG, en_register_port) << ";" << std::endl;
+  fp << generate_verilog_port(VERILOG_PORT_WIRE, en_port) << ";\n";
+  fp << generate_verilog_port(VERILOG_PORT_REG, en_register_port) << ";\n";
 
   write_tab_to_file(fp, 1);
   fp << "assign ";
@@ -174,7 +237,7 @@ void print_verilog_top_testbench_memory_bank_port(std::fstream& fp,
   fp << "~" << generate_verilog_port(VERILOG_PORT_CONKT, en_register_port);
   fp << " & ";
   fp << "~" << generate_verilog_port(VERILOG_PORT_CONKT, config_done_port);
-  fp << ";" << std::endl;
+  fp << ";\n";
 }
 
 
@@ -194,14 +257,14 @@ void print_verilog_top_testbench_frame_decoder_port(std::fstream& fp,
                                                               std::string(DECODER_ADDRESS_PORT_NAME));
   BasicPort addr_port = module_manager.module_port(top_module, addr_port_id);
 
-  fp << generate_verilog_port(VERILOG_PORT_REG, addr_port) << ";" << std::endl;
+  fp << generate_verilog_port(VERILOG_PORT_REG, addr_port) << ";\n";
 
   /* Print the data-input port for the frame-based decoder here */
   print_verilog_comment(fp, std::string("---- Data input port for frame-based decoder -----"));
   ModulePortId din_port_id = module_manager.find_module_port(top_module,
                                                              std::string(DECODER_DATA_IN_PORT_NAME));
   BasicPort din_port = module_manager.module_port(top_module, din_port_id);
-  fp << generate_verilog_port(VERILOG_PORT_REG, din_port) << ";" << std::endl;
+  fp << generate_verilog_port(VERILOG_PORT_REG, din_port) << ";\n";
 
   /* Generate enable signal waveform here:
    * which is a 90 degree phase shift than the programming clock   
@@ -214,8 +277,8 @@ void print_verilog_top_testbench_frame_decoder_port(std::fstream& fp,
 
   BasicPort config_done_port(std::string(TOP_TB_CONFIG_DONE_PORT_NAME), 1);
 
-  fp << generate_verilog_port(VERILOG_PORT_WIRE, en_port) << ";" << std::endl;
-  fp << generate_verilog_port(VERILOG_PORT_REG, en_register_port) << ";" << std::endl;
+  fp << generate_verilog_port(VERILOG_PORT_WIRE, en_port) << ";\n";
+  fp << generate_verilog_port(VERILOG_PORT_REG, en_register_port) << ";\n";
 
   write_tab_to_file(fp, 1);
   fp << "assign ";
@@ -224,7 +287,7 @@ void print_verilog_top_testbench_frame_decoder_port(std::fstream& fp,
   fp << "~" << generate_verilog_port(VERILOG_PORT_CONKT, en_register_port);
   fp << " & ";
   fp << "~" << generate_verilog_port(VERILOG_PORT_CONKT, config_done_port);
-  fp << ";" << std::endl;
+  fp << ";\n";
 }
 
 /********************************************************************
@@ -240,10 +303,10 @@ void print_verilog_top_testbench_config_protocol_port(std::fstream& fp,
     print_verilog_top_testbench_flatten_memory_port(fp, module_manager, top_module);
     break;
   case CONFIG_MEM_SCAN_CHAIN:
-    print_verilog_top_testbench_config_chain_port(fp, module_manager, top_module);
+    print_verilog_top_testbench_config_chain_port(fp, config_protocol, module_manager, top_module);
     break;
   case CONFIG_MEM_MEMORY_BANK:
-    print_verilog_top_testbench_memory_bank_port(fp, module_manager, top_module);
+    print_verilog_top_testbench_memory_bank_port(fp, config_protocol, module_manager, top_module);
     break;
   case CONFIG_MEM_FRAME_BASED:
     print_verilog_top_testbench_frame_decoder_port(fp,
@@ -662,14 +725,14 @@ void print_verilog_top_testbench_benchmark_clock_ports(std::fstream& fp,
     /* Print the clock and wire it to the clock source */
     print_verilog_comment(fp, std::string("----- Create a clock for benchmark and wire it to " + clock_source_to_connect.get_name() + " -------"));
     BasicPort clock_port(clock_port_name, 1);
-    fp << "\t" << generate_verilog_port(VERILOG_PORT_WIRE, clock_port) << ";" << std::endl;
+    fp << "\t" << generate_verilog_port(VERILOG_PORT_WIRE, clock_port) << ";\n";
     print_verilog_wire_connection(fp, clock_port, clock_source_to_connect, false);
   }
 }
 
 /********************************************************************
- * This function prints the top testbench module declaration
- * and internal wires/port declaration
+ * This function prints the internal wires/port declaration 
+ * which are required by the FPGA fabric, independent from the benchmark
  * Ports can be classified in two categories:
  * 1. General-purpose ports, which are datapath I/Os, clock signals
  *    for the FPGA fabric and input benchmark
@@ -685,26 +748,14 @@ void print_verilog_top_testbench_benchmark_clock_ports(std::fstream& fp,
  *        configuration bits
  *******************************************************************/
 static
-void print_verilog_top_testbench_ports(std::fstream& fp,
-                                       const ModuleManager& module_manager,
-                                       const ModuleId& top_module,
-                                       const AtomContext& atom_ctx,
-                                       const VprNetlistAnnotation& netlist_annotation,
-                                       const std::vector<std::string>& clock_port_names,
-                                       const PinConstraints& pin_constraints,
-                                       const SimulationSetting& simulation_parameters,
-                                       const ConfigProtocol& config_protocol,
-                                       const std::string& circuit_name){
+void print_verilog_top_testbench_fabric_ports(std::fstream& fp,
+                                              const ModuleManager& module_manager,
+                                              const ModuleId& top_module,
+                                              const SimulationSetting& simulation_parameters,
+                                              const ConfigProtocol& config_protocol) {
   /* Validate the file stream */
   valid_file_stream(fp);
 
-  print_verilog_default_net_type_declaration(fp,
-                                             VERILOG_DEFAULT_NET_TYPE_NONE);
-
-  /* Print module definition */
-  fp << "module " << circuit_name << std::string(AUTOCHECK_TOP_TESTBENCH_VERILOG_MODULE_POSTFIX);
-  fp << ";" << std::endl;
-
   /* Print regular local wires:
    * 1. global ports, i.e., reset, set and clock signals
    * 2. datapath I/O signals
@@ -712,30 +763,30 @@ void print_verilog_top_testbench_ports(std::fstream& fp,
   /* Global ports of top-level module  */
   print_verilog_comment(fp, std::string("----- Local wires for global ports of FPGA fabric -----"));
   for (const BasicPort& module_port : module_manager.module_ports_by_type(top_module, ModuleManager::MODULE_GLOBAL_PORT)) {
-    fp << generate_verilog_port(VERILOG_PORT_WIRE, module_port) << ";" << std::endl;
+    fp << generate_verilog_port(VERILOG_PORT_WIRE, module_port) << ";\n";
   }
   /* Add an empty line as a splitter */
-  fp << std::endl;
+  fp << "\n";
 
   /* Datapath I/Os of top-level module  */
   print_verilog_comment(fp, std::string("----- Local wires for I/Os of FPGA fabric -----"));
   for (const BasicPort& module_port : module_manager.module_ports_by_type(top_module, ModuleManager::MODULE_GPIO_PORT)) {
-    fp << generate_verilog_port(VERILOG_PORT_WIRE, module_port) << ";" << std::endl;
+    fp << generate_verilog_port(VERILOG_PORT_WIRE, module_port) << ";\n";
   }
   /* Add an empty line as a splitter */
-  fp << std::endl;
+  fp << "\n";
 
   for (const BasicPort& module_port : module_manager.module_ports_by_type(top_module, ModuleManager::MODULE_GPIN_PORT)) {
-    fp << generate_verilog_port(VERILOG_PORT_WIRE, module_port) << ";" << std::endl;
+    fp << generate_verilog_port(VERILOG_PORT_WIRE, module_port) << ";\n";
   }
   /* Add an empty line as a splitter */
-  fp << std::endl;
+  fp << "\n";
 
   for (const BasicPort& module_port : module_manager.module_ports_by_type(top_module, ModuleManager::MODULE_GPOUT_PORT)) {
-    fp << generate_verilog_port(VERILOG_PORT_WIRE, module_port) << ";" << std::endl;
+    fp << generate_verilog_port(VERILOG_PORT_WIRE, module_port) << ";\n";
   }
   /* Add an empty line as a splitter */
-  fp << std::endl;
+  fp << "\n";
 
   /* Add local wires/registers that drive stimulus
    * We create these general purpose ports here,
@@ -743,21 +794,21 @@ void print_verilog_top_testbench_ports(std::fstream& fp,
    */
   /* Configuration done port */
   BasicPort config_done_port(std::string(TOP_TB_CONFIG_DONE_PORT_NAME), 1);
-  fp << generate_verilog_port(VERILOG_PORT_REG, config_done_port) << ";" << std::endl;
+  fp << generate_verilog_port(VERILOG_PORT_REG, config_done_port) << ";\n";
 
   /* Programming clock */
   BasicPort prog_clock_port(std::string(TOP_TB_PROG_CLOCK_PORT_NAME), 1);
-  fp << generate_verilog_port(VERILOG_PORT_WIRE, prog_clock_port) << ";" << std::endl;
+  fp << generate_verilog_port(VERILOG_PORT_WIRE, prog_clock_port) << ";\n";
   BasicPort prog_clock_register_port(std::string(std::string(TOP_TB_PROG_CLOCK_PORT_NAME) + std::string(TOP_TB_CLOCK_REG_POSTFIX)), 1);
-  fp << generate_verilog_port(VERILOG_PORT_REG, prog_clock_register_port) << ";" << std::endl;
+  fp << generate_verilog_port(VERILOG_PORT_REG, prog_clock_register_port) << ";\n";
 
   /* Multiple operating clocks based on the simulation settings */
   for (const SimulationClockId& sim_clock : simulation_parameters.clocks()) {
     std::string sim_clock_port_name = generate_top_testbench_clock_name(std::string(TOP_TB_OP_CLOCK_PORT_PREFIX), simulation_parameters.clock_name(sim_clock));
     BasicPort sim_clock_port(sim_clock_port_name, 1);
-    fp << generate_verilog_port(VERILOG_PORT_WIRE, sim_clock_port) << ";" << std::endl;
+    fp << generate_verilog_port(VERILOG_PORT_WIRE, sim_clock_port) << ";\n";
     BasicPort sim_clock_register_port(std::string(sim_clock_port_name + std::string(TOP_TB_CLOCK_REG_POSTFIX)), 1);
-    fp << generate_verilog_port(VERILOG_PORT_REG, sim_clock_register_port) << ";" << std::endl;
+    fp << generate_verilog_port(VERILOG_PORT_REG, sim_clock_register_port) << ";\n";
   }
 
   /* FIXME: Actually, for multi-clock implementations, input and output ports
@@ -767,27 +818,58 @@ void print_verilog_top_testbench_ports(std::fstream& fp,
    * Create an operating clock_port to synchronize checkers stimulus generator 
    */
   BasicPort op_clock_port(std::string(TOP_TB_OP_CLOCK_PORT_NAME), 1);
-  fp << generate_verilog_port(VERILOG_PORT_WIRE, op_clock_port) << ";" << std::endl;
+  fp << generate_verilog_port(VERILOG_PORT_WIRE, op_clock_port) << ";\n";
   BasicPort op_clock_register_port(std::string(std::string(TOP_TB_OP_CLOCK_PORT_NAME) + std::string(TOP_TB_CLOCK_REG_POSTFIX)), 1);
-  fp << generate_verilog_port(VERILOG_PORT_REG, op_clock_register_port) << ";" << std::endl;
+  fp << generate_verilog_port(VERILOG_PORT_REG, op_clock_register_port) << ";\n";
 
   /* Programming set and reset */
   BasicPort prog_reset_port(std::string(TOP_TB_PROG_RESET_PORT_NAME), 1);
-  fp << generate_verilog_port(VERILOG_PORT_REG, prog_reset_port) << ";" << std::endl;
+  fp << generate_verilog_port(VERILOG_PORT_REG, prog_reset_port) << ";\n";
   BasicPort prog_set_port(std::string(TOP_TB_PROG_SET_PORT_NAME), 1);
-  fp << generate_verilog_port(VERILOG_PORT_REG, prog_set_port) << ";" << std::endl;
+  fp << generate_verilog_port(VERILOG_PORT_REG, prog_set_port) << ";\n";
 
   /* Global set and reset */
   BasicPort reset_port(std::string(TOP_TB_RESET_PORT_NAME), 1);
-  fp << generate_verilog_port(VERILOG_PORT_REG, reset_port) << ";" << std::endl;
+  fp << generate_verilog_port(VERILOG_PORT_REG, reset_port) << ";\n";
   BasicPort set_port(std::string(TOP_TB_SET_PORT_NAME), 1);
-  fp << generate_verilog_port(VERILOG_PORT_REG, set_port) << ";" << std::endl;
+  fp << generate_verilog_port(VERILOG_PORT_REG, set_port) << ";\n";
 
   /* Configuration ports depend on the organization of SRAMs */
   print_verilog_top_testbench_config_protocol_port(fp, config_protocol,
                                                    module_manager, top_module);
+}
+
+/********************************************************************
+ * This function prints the top testbench module declaration
+ * and internal wires/port declaration, including
+ * the ports of the FPGA fabric and those of the benchmark
+ *******************************************************************/
+static
+void print_verilog_top_testbench_ports(std::fstream& fp,
+                                       const ModuleManager& module_manager,
+                                       const ModuleId& top_module,
+                                       const AtomContext& atom_ctx,
+                                       const VprNetlistAnnotation& netlist_annotation,
+                                       const std::vector<std::string>& clock_port_names,
+                                       const PinConstraints& pin_constraints,
+                                       const SimulationSetting& simulation_parameters,
+                                       const ConfigProtocol& config_protocol,
+                                       const std::string& circuit_name){
+  /* Validate the file stream */
+  valid_file_stream(fp);
+
+  print_verilog_default_net_type_declaration(fp,
+                                             VERILOG_DEFAULT_NET_TYPE_NONE);
+
+  /* Print module definition */
+  fp << "module " << circuit_name << std::string(AUTOCHECK_TOP_TESTBENCH_VERILOG_MODULE_POSTFIX);
+  fp << ";\n";
+
+  print_verilog_top_testbench_fabric_ports(fp, module_manager, top_module,
+                                           simulation_parameters, config_protocol);
 
   /* Print clock ports */
+  BasicPort op_clock_port(std::string(TOP_TB_OP_CLOCK_PORT_NAME), 1);
   print_verilog_top_testbench_benchmark_clock_ports(fp,
                                                     module_manager, top_module,
                                                     clock_port_names,
@@ -806,7 +888,114 @@ void print_verilog_top_testbench_ports(std::fstream& fp,
    * determine if the simulation succeed or failed
    */
   print_verilog_comment(fp, std::string("----- Error counter: Deposit an error for config_done signal is not raised at the beginning -----"));
-  fp << "\tinteger " << TOP_TESTBENCH_ERROR_COUNTER << "= 1;" << std::endl;
+  fp << "\tinteger " << TOP_TESTBENCH_ERROR_COUNTER << "= 1;\n";
+}
+
+/********************************************************************
+ * View the regional bitstreams of configuration chains as they are loaded
+ * by the top testbench.
+ * For fast configuration, each region skips its own leading bits which are
+ * the same as the configuration memories after reset.
+ * The padding bits of shorter regions are the skipped value, so that they
+ * end up in the skipped tail of the chain (or are shifted out of it)
+ *******************************************************************/
+static
+ConfigChainFabricBitstream build_top_testbench_configuration_chain_bitstream(const bool& fast_configuration,
+                                                                             const bool& bit_value_to_skip,
+                                                                             const BitstreamManager& bitstream_manager,
+                                                                             const FabricBitstream& fabric_bitstream) {
+  if (false == fast_configuration) {
+    return ConfigChainFabricBitstream(bitstream_manager, fabric_bitstream);
+  }
+
+  std::vector<size_t> regional_num_bits_to_skip = find_configuration_chain_fabric_regional_bitstream_sizes_to_be_skipped(fabric_bitstream, bitstream_manager, bit_value_to_skip);
+
+  /* Keep at least one bit to load, so that the configuration done signal is raised after a clock cycle */
+  bool all_skipped = true;
+  for (const FabricBitRegionId& region : fabric_bitstream.regions()) {
+    if (regional_num_bits_to_skip[size_t(region)] < fabric_bitstream.region_bits(region).size()) {
+      all_skipped = false;
+      break;
+    }
+  }
+  if (true == all_skipped) {
+    for (size_t& num_bits_to_skip : regional_num_bits_to_skip) {
+      if (0 < num_bits_to_skip) {
+        num_bits_to_skip--;
+      }
+    }
+  }
+
+  return ConfigChainFabricBitstream(bitstream_manager, fabric_bitstream,
+                                    regional_num_bits_to_skip, bit_value_to_skip);
+}
+
+/********************************************************************
+ * Find the number of Bit-Lines driven by the shift register of each memory bank,
+ * which is the same for all the regions
+ * The shift register is the last but one configurable child of a region
+ *******************************************************************/
+static
+size_t find_top_module_bl_shift_register_size(const ModuleManager& module_manager,
+                                              const ModuleId& top_module) {
+  VTR_ASSERT(0 < module_manager.regions(top_module).size());
+  std::vector<ModuleId> configurable_children = module_manager.region_configurable_children(top_module, *module_manager.regions(top_module).begin());
+  VTR_ASSERT(2 <= configurable_children.size());
+  ModuleId bl_sr_module = configurable_children[configurable_children.size() - 2];
+
+  ModulePortId bl_sr_dout_port_id = module_manager.find_module_port(bl_sr_module, std::string(DECODER_DATA_OUT_PORT_NAME));
+  return module_manager.module_port(bl_sr_module, bl_sr_dout_port_id).get_width();
+}
+
+/********************************************************************
+ * Group the words of a memory bank bitstream by their WL addresses,
+ * when the Bit-Lines are driven by shift registers
+ * Each group is loaded in a programming cycle, and is encoded as the
+ * WL address followed by the data to be shifted into the BL shift registers, e.g.,
+ *
+ *   <wl_address> <data_in of all the regions for BL[N-1]> ... <data_in of all the regions for BL[0]>
+ *
+ * The data of BL[N-1] are shifted first, so that they reach the end of the shift registers
+ * Memory cells which do not exist in some regions are given the value to be skipped
+ * When fast configuration is enabled, the WLs whose data are all the value to be skipped
+ * are not loaded
+ *******************************************************************/
+static
+std::vector<std::string> build_memory_bank_shift_register_words(const FabricBitstreamByAddress& fabric_bits_by_addr,
+                                                                const size_t& num_bls,
+                                                                const bool& fast_configuration,
+                                                                const bool& bit_value_to_skip) {
+  size_t num_regions = fabric_bits_by_addr.num_regions();
+  char skip_char = (true == bit_value_to_skip) ? '1' : '0';
+
+  /* Words are sorted by BL addresses first, so the WLs are grouped by a map */
+  std::map<std::string, std::string> wl_words;
+  for (size_t iword = 0; iword < fabric_bits_by_addr.num_words(); ++iword) {
+    size_t bl_index = fabric_bits_by_addr.word_address_value(iword);
+    VTR_ASSERT(bl_index < num_bls);
+
+    auto result = wl_words.emplace(fabric_bits_by_addr.word_wl_address(iword), std::string());
+    std::string& wl_data = result.first->second;
+    if (true == result.second) {
+      wl_data.assign(num_bls * num_regions, skip_char);
+    }
+    size_t offset = (num_bls - 1 - bl_index) * num_regions;
+    for (size_t iregion = 0; iregion < num_regions; ++iregion) {
+      wl_data[offset + iregion] = (true == fabric_bits_by_addr.word_din(iword, iregion)) ? '1' : '0';
+    }
+  }
+
+  std::vector<std::string> words;
+  words.reserve(wl_words.size());
+  for (const auto& wl_word : wl_words) {
+    if ( (true == fast_configuration)
+      && (std::string::npos == wl_word.second.find_first_not_of(skip_char)) ) {
+      continue;
+    }
+    words.push_back(wl_word.first + wl_word.second);
+  }
+
+  return words;
 }
 
 /********************************************************************
@@ -816,20 +1005,25 @@ void print_verilog_top_testbench_ports(std::fstream& fp,
  * If we consider fast configuration, the number of clock cycles will be
  * the number of non-zero data points in the fabric bitstream
  * Note that this will not applicable to configuration chain!!!
+ * When the Bit-Lines of memory banks are driven by shift registers,
+ * each clock cycle loads the memory cells of a Word-Line
  *******************************************************************/
 static
-size_t calculate_num_config_clock_cycles(const e_config_protocol_type& sram_orgz_type,
+size_t calculate_num_config_clock_cycles(const ConfigProtocol& config_protocol,
                                          const bool& fast_configuration,
                                          const bool& bit_value_to_skip,
+                                         const ModuleManager& module_manager,
+                                         const ModuleId& top_module,
                                          const BitstreamManager& bitstream_manager,
-                                         const FabricBitstream& fabric_bitstream) {
+                                         const FabricBitstream& fabric_bitstream,
+                                         const FabricBitstreamByAddress& fabric_bitstream_by_address) {
   /* Find the longest regional bitstream */
   size_t regional_bitstream_max_size = find_fabric_regional_bitstream_max_size(fabric_bitstream);
 
   size_t num_config_clock_cycles = 1 + regional_bitstream_max_size;
 
   /* Branch on the type of configuration protocol */
-  switch (sram_orgz_type) {
+  switch (config_protocol.type()) {
   case CONFIG_MEM_STANDALONE:
     /* We just need 1 clock cycle to load all the configuration bits
      * since all the ports are exposed at the top-level
@@ -839,17 +1033,17 @@ size_t calculate_num_config_clock_cycles(const e_config_protocol_type& sram_orgz
   case CONFIG_MEM_SCAN_CHAIN:
     /* For fast configuration, the bitstream size counts from the first bit '1' */
     if (true == fast_configuration) {
-      /* For fast configuration, the number of bits to be skipped
-       * depends on each regional bitstream
+      /* For fast configuration, each regional bitstream skips its own leading bits
        * For example:
        *   Region 0: 000000001111101010
        *   Region 1:     00000011010101
        *   Region 2:   0010101111000110
-       * The number of bits that can be skipped is limited by Region 2
+       * The number of clock cycles is limited by Region 2,
+       * which has the longest bitstream after skipping
        */
-      size_t num_bits_to_skip = find_configuration_chain_fabric_bitstream_size_to_be_skipped(fabric_bitstream, bitstream_manager, bit_value_to_skip);
+      ConfigChainFabricBitstream regional_bitstreams = build_top_testbench_configuration_chain_bitstream(fast_configuration, bit_value_to_skip, bitstream_manager, fabric_bitstream);
 
-      num_config_clock_cycles = 1 + regional_bitstream_max_size - num_bits_to_skip;
+      num_config_clock_cycles = 1 + regional_bitstreams.num_cycles();
 
       VTR_LOG("Fast configuration reduces number of configuration clock cycles from %lu to %lu (compression_rate = %f%)\n",
               1 + regional_bitstream_max_size,
@@ -858,11 +1052,27 @@ size_t calculate_num_config_clock_cycles(const e_config_protocol_type& sram_orgz
     }
     break;
   case CONFIG_MEM_MEMORY_BANK: {
+    if (BLWL_PROTOCOL_SHIFT_REGISTER == config_protocol.bl_protocol_type()) {
+      size_t num_bls = find_top_module_bl_shift_register_size(module_manager, top_module);
+      num_config_clock_cycles = 1 + build_memory_bank_shift_register_words(fabric_bitstream_by_address, num_bls, false, bit_value_to_skip).size();
+      VTR_LOG("Bit-Line shift registers reduce number of configuration clock cycles from %lu to %lu\n",
+              1 + fabric_bitstream_by_address.num_words(),
+              num_config_clock_cycles);
+      if (true == fast_configuration) {
+        size_t full_num_config_clock_cycles = num_config_clock_cycles;
+        num_config_clock_cycles = 1 + build_memory_bank_shift_register_words(fabric_bitstream_by_address, num_bls, true, bit_value_to_skip).size();
+        VTR_LOG("Fast configuration reduces number of configuration clock cycles from %lu to %lu (compression_rate = %f%)\n",
+                full_num_config_clock_cycles,
+                num_config_clock_cycles,
+                100. * ((float)num_config_clock_cycles / (float)full_num_config_clock_cycles - 1.));
+      }
+      break;
+    }
     /* For fast configuration, we will skip all the zero data points */
-    num_config_clock_cycles = 1 + build_memory_bank_fabric_bitstream_by_address(fabric_bitstream).size();
+    num_config_clock_cycles = 1 + fabric_bitstream_by_address.num_words();
     if (true == fast_configuration) {
       size_t full_num_config_clock_cycles = num_config_clock_cycles;
-      num_config_clock_cycles = 1 + find_memory_bank_fast_configuration_fabric_bitstream_size(fabric_bitstream, bit_value_to_skip);
+      num_config_clock_cycles = 1 + find_fast_configuration_fabric_bitstream_by_address_size(fabric_bitstream_by_address, bit_value_to_skip);
       VTR_LOG("Fast configuration reduces number of configuration clock cycles from %lu to %lu (compression_rate = %f%)\n",
               full_num_config_clock_cycles,
               num_config_clock_cycles,
@@ -871,10 +1081,10 @@ size_t calculate_num_config_clock_cycles(const e_config_protocol_type& sram_orgz
     break;
   }
   case CONFIG_MEM_FRAME_BASED: {
-    num_config_clock_cycles = 1 + build_frame_based_fabric_bitstream_by_address(fabric_bitstream).size();
+    num_config_clock_cycles = 1 + fabric_bitstream_by_address.num_words();
     if (true == fast_configuration) {
       size_t full_num_config_clock_cycles = num_config_clock_cycles;
-      num_config_clock_cycles = 1 + find_frame_based_fast_configuration_fabric_bitstream_size(fabric_bitstream, bit_value_to_skip);
+      num_config_clock_cycles = 1 + find_fast_configuration_fabric_bitstream_by_address_size(fabric_bitstream_by_address, bit_value_to_skip);
       VTR_LOG("Fast configuration reduces number of configuration clock cycles from %lu to %lu (compression_rate = %f%)\n",
               full_num_config_clock_cycles,
               num_config_clock_cycles,
@@ -929,13 +1139,13 @@ void print_verilog_top_testbench_benchmark_instance(std::fstream& fp,
   print_verilog_comment(fp, std::string("----- End reference Benchmark Instanication -------"));
 
   /* Add an empty line as splitter */
-  fp << std::endl;
+  fp << "\n";
 
   /* Condition ends for the benchmark instanciation */
   print_verilog_endif(fp);
 
   /* Add an empty line as splitter */
-  fp << std::endl;
+  fp << "\n";
 }
 
 /********************************************************************
@@ -943,9 +1153,14 @@ void print_verilog_top_testbench_benchmark_instance(std::fstream& fp,
  * which is very useful in generating stimuli for each clock cycle
  * This function is tuned for configuration-chain manipulation:
  * During each programming cycle, we feed the input of scan chain with a memory bit
+ *
+ * When the bitstream is run-length compressed, a call to the task gives
+ * the length of a run minus 1 and the memory bits of the run, and the task lasts
+ * as many programming cycles as the run when the decompressors repeat the bits
  *******************************************************************/
 static
 void print_verilog_top_testbench_load_bitstream_task_configuration_chain(std::fstream& fp,
+                                                                         const ConfigProtocol& config_protocol,
                                                                          const ModuleManager& module_manager,
                                                                          const ModuleId& top_module) {
 
@@ -958,27 +1173,50 @@ void print_verilog_top_testbench_load_bitstream_task_configuration_chain(std::fs
   BasicPort cc_head_value(generate_configuration_chain_head_name() + std::string("_val"), cc_head_port.get_width());
 
   /* Add an empty line as splitter */
-  fp << std::endl;
+  fp << "\n";
 
   /* Feed the scan-chain input at each falling edge of programming clock
    * It aims at avoid racing the programming clock (scan-chain data changes at the rising edge).
    */
   print_verilog_comment(fp, std::string("----- Task: input values during a programming clock cycle -----"));
-  fp << "task " << std::string(TOP_TESTBENCH_PROG_TASK_NAME) << ";" << std::endl;
-  fp << generate_verilog_port(VERILOG_PORT_INPUT, cc_head_value) << ";" << std::endl;
-  fp << "\tbegin" << std::endl;
-  fp << "\t\t@(negedge " << generate_verilog_port(VERILOG_PORT_CONKT, prog_clock_port) << ");" << std::endl;
+  fp << "task " << std::string(TOP_TESTBENCH_PROG_TASK_NAME) << ";\n";
+
+  /* The run length comes first, in the same order as the fabric bitstream file */
+  bool use_decompressor = (CONFIG_CHAIN_COMPRESSION_RUN_LENGTH == config_protocol.chain_compression_type());
+  BasicPort run_length_port;
+  BasicPort run_length_value;
+  if (true == use_decompressor) {
+    ModulePortId run_length_port_id = module_manager.find_module_port(top_module, std::string(CONFIG_CHAIN_RUN_LENGTH_PORT_NAME));
+    run_length_port = module_manager.module_port(top_module, run_length_port_id);
+    run_length_value = BasicPort(std::string(CONFIG_CHAIN_RUN_LENGTH_PORT_NAME) + std::string("_val"), run_length_port.get_width());
+    fp << generate_verilog_port(VERILOG_PORT_INPUT, run_length_value) << ";\n";
+  }
+  fp << generate_verilog_port(VERILOG_PORT_INPUT, cc_head_value) << ";\n";
+
+  fp << "\tbegin\n";
+  fp << "\t\t@(negedge " << generate_verilog_port(VERILOG_PORT_CONKT, prog_clock_port) << ");\n";
   fp << "\t\t\t";
   fp << generate_verilog_port(VERILOG_PORT_CONKT, cc_head_port);
   fp << " = ";
   fp << generate_verilog_port(VERILOG_PORT_CONKT, cc_head_value);
-  fp << ";" << std::endl;
+  fp << ";\n";
 
-  fp << "\tend" << std::endl;
-  fp << "endtask" << std::endl;
+  if (true == use_decompressor) {
+    fp << "\t\t\t";
+    fp << generate_verilog_port(VERILOG_PORT_CONKT, run_length_port);
+    fp << " = ";
+    fp << generate_verilog_port(VERILOG_PORT_CONKT, run_length_value);
+    fp << ";\n";
+    /* Wait for the decompressors to repeat the bits of the run */
+    fp << "\t\trepeat (" << generate_verilog_port(VERILOG_PORT_CONKT, run_length_value) << ") ";
+    fp << "@(negedge " << generate_verilog_port(VERILOG_PORT_CONKT, prog_clock_port) << ");\n";
+  }
+
+  fp << "\tend\n";
+  fp << "endtask\n";
 
   /* Add an empty line as splitter */
-  fp << std::endl;
+  fp << "\n";
 }
 
 /********************************************************************
@@ -1019,49 +1257,139 @@ void print_verilog_top_testbench_load_bitstream_task_memory_bank(std::fstream& f
   din_value.set_name(std::string(DECODER_DATA_IN_PORT_NAME) + std::string("_val"));
 
   /* Add an empty line as splitter */
-  fp << std::endl;
+  fp << "\n";
 
   /* Feed the address and data input at each falling edge of programming clock
    * As the enable signal is wired to the programming clock, we should synchronize
    * address and data with the enable signal
    */
   print_verilog_comment(fp, std::string("----- Task: assign BL and WL address, and data values at rising edge of enable signal -----"));
-  fp << "task " << std::string(TOP_TESTBENCH_PROG_TASK_NAME) << ";" << std::endl;
-  fp << generate_verilog_port(VERILOG_PORT_INPUT, bl_addr_value) << ";" << std::endl;
-  fp << generate_verilog_port(VERILOG_PORT_INPUT, wl_addr_value) << ";" << std::endl;
-  fp << generate_verilog_port(VERILOG_PORT_INPUT, din_value) << ";" << std::endl;
-  fp << "\tbegin" << std::endl;
-  fp << "\t\t@(negedge " << generate_verilog_port(VERILOG_PORT_CONKT, prog_clock_port) << ");" << std::endl;
+  fp << "task " << std::string(TOP_TESTBENCH_PROG_TASK_NAME) << ";\n";
+  fp << generate_verilog_port(VERILOG_PORT_INPUT, bl_addr_value) << ";\n";
+  fp << generate_verilog_port(VERILOG_PORT_INPUT, wl_addr_value) << ";\n";
+  fp << generate_verilog_port(VERILOG_PORT_INPUT, din_value) << ";\n";
+  fp << "\tbegin\n";
+  fp << "\t\t@(negedge " << generate_verilog_port(VERILOG_PORT_CONKT, prog_clock_port) << ");\n";
 
   fp << "\t\t\t";
   fp << generate_verilog_port(VERILOG_PORT_CONKT, bl_addr_port);
   fp << " = ";
   fp << generate_verilog_port(VERILOG_PORT_CONKT, bl_addr_value);
-  fp << ";" << std::endl;
-  fp << std::endl;
+  fp << ";\n";
+  fp << "\n";
 
   fp << "\t\t\t";
   fp << generate_verilog_port(VERILOG_PORT_CONKT, wl_addr_port);
   fp << " = ";
   fp << generate_verilog_port(VERILOG_PORT_CONKT, wl_addr_value);
-  fp << ";" << std::endl;
-  fp << std::endl;
+  fp << ";\n";
+  fp << "\n";
 
   fp << "\t\t\t";
   fp << generate_verilog_port(VERILOG_PORT_CONKT, din_port);
   fp << " = ";
   fp << generate_verilog_port(VERILOG_PORT_CONKT, din_value);
-  fp << ";" << std::endl;
-  fp << std::endl;
+  fp << ";\n";
+  fp << "\n";
 
-  fp << "\tend" << std::endl;
-  fp << "endtask" << std::endl;
+  fp << "\tend\n";
+  fp << "endtask\n";
 
   /* Add an empty line as splitter */
-  fp << std::endl;
+  fp << "\n";
 }
 
 
+/********************************************************************
+ * Print tasks (processes) in Verilog format,
+ * which is very useful in generating stimuli for each clock cycle
+ * This function is tuned for memory banks whose Bit-Lines are driven by shift registers:
+ * During each programming cycle, we feed
+ * - an address to the WL address port of top module
+ * - the data of all the BLs, which are shifted into the BL shift registers
+ *   through the din port of top module, before the enable signal is raised
+ *
+ * The shift registers are clocked by the task itself, so that the data of
+ * all the BLs are shifted in the first quarter of a programming clock period,
+ * when the enable signal is always disabled
+ *******************************************************************/
+static
+void print_verilog_top_testbench_load_bitstream_task_memory_bank_shift_register(std::fstream& fp,
+                                                                                const ModuleManager& module_manager,
+                                                                                const ModuleId& top_module,
+                                                                                const float& prog_clock_period,
+                                                                                const float& timescale) {
+
+  /* Validate the file stream */
+  valid_file_stream(fp);
+
+  BasicPort prog_clock_port(std::string(TOP_TB_PROG_CLOCK_PORT_NAME), 1);
+
+  ModulePortId bl_sr_clk_port_id = module_manager.find_module_port(top_module,
+                                                                   std::string(BL_SHIFT_REGISTER_CLOCK_PORT_NAME));
+  BasicPort bl_sr_clk_port = module_manager.module_port(top_module, bl_sr_clk_port_id);
+
+  ModulePortId wl_addr_port_id = module_manager.find_module_port(top_module,
+                                                                 std::string(DECODER_WL_ADDRESS_PORT_NAME));
+  BasicPort wl_addr_port = module_manager.module_port(top_module, wl_addr_port_id);
+  BasicPort wl_addr_value = wl_addr_port;
+  wl_addr_value.set_name(std::string(MEMORY_WL_PORT_NAME) + std::string("_val"));
+
+  ModulePortId din_port_id = module_manager.find_module_port(top_module,
+                                                             std::string(DECODER_DATA_IN_PORT_NAME));
+  BasicPort din_port = module_manager.module_port(top_module, din_port_id);
+
+  size_t num_bls = find_top_module_bl_shift_register_size(module_manager, top_module);
+  BasicPort bl_data_value(std::string(MEMORY_BL_PORT_NAME) + std::string("_data_val"), num_bls * din_port.get_width());
+
+  /* Each bit is shifted in a period of the shift register clock,
+   * and all the bits should be shifted before the enable signal is raised
+   */
+  float bl_sr_clk_half_period = 0.25 * prog_clock_period / timescale / (2 * (num_bls + 1));
+  if (bl_sr_clk_half_period < 1e-12 / timescale) {
+    VTR_LOG_WARN("The period of Bit-Line shift register clock is shorter than the simulation precision (1ps). Please reduce the programming clock frequency!\n");
+  }
+
+  /* Add an empty line as splitter */
+  fp << "\n";
+
+  print_verilog_comment(fp, std::string("----- Task: assign WL address, and shift BL data values into shift registers at falling edge of programming clock -----"));
+  fp << "task " << std::string(TOP_TESTBENCH_PROG_TASK_NAME) << ";\n";
+  fp << generate_verilog_port(VERILOG_PORT_INPUT, wl_addr_value) << ";\n";
+  fp << generate_verilog_port(VERILOG_PORT_INPUT, bl_data_value) << ";\n";
+  fp << "integer " << std::string(TOP_TESTBENCH_BL_SHIFT_INDEX_NAME) << ";\n";
+  fp << "\tbegin\n";
+  fp << "\t\t@(negedge " << generate_verilog_port(VERILOG_PORT_CONKT, prog_clock_port) << ");\n";
+
+  fp << "\t\t\t";
+  fp << generate_verilog_port(VERILOG_PORT_CONKT, wl_addr_port);
+  fp << " = ";
+  fp << generate_verilog_port(VERILOG_PORT_CONKT, wl_addr_value);
+  fp << ";\n";
+  fp << "\n";
+
+  std::string index_name(TOP_TESTBENCH_BL_SHIFT_INDEX_NAME);
+  fp << "\t\t\tfor (" << index_name << " = 0; ";
+  fp << index_name << " < " << num_bls << "; ";
+  fp << index_name << " = " << index_name << " + 1) begin\n";
+  fp << "\t\t\t\t";
+  fp << generate_verilog_port(VERILOG_PORT_CONKT, din_port);
+  fp << " = ";
+  fp << bl_data_value.get_name() << "[" << index_name << " * " << din_port.get_width() << " +: " << din_port.get_width() << "]";
+  fp << ";\n";
+  fp << "\t\t\t\t#" << std::setprecision(10) << bl_sr_clk_half_period << " ";
+  fp << generate_verilog_port(VERILOG_PORT_CONKT, bl_sr_clk_port) << " = 1'b1;\n";
+  fp << "\t\t\t\t#" << std::setprecision(10) << bl_sr_clk_half_period << " ";
+  fp << generate_verilog_port(VERILOG_PORT_CONKT, bl_sr_clk_port) << " = 1'b0;\n";
+  fp << "\t\t\tend\n";
+
+  fp << "\tend\n";
+  fp << "endtask\n";
+
+  /* Add an empty line as splitter */
+  fp << "\n";
+}
+
 /********************************************************************
  * Print tasks (processes) in Verilog format,
  * which is very useful in generating stimuli for each clock cycle
@@ -1093,38 +1421,38 @@ void print_verilog_top_testbench_load_bitstream_task_frame_decoder(std::fstream&
   din_value.set_name(std::string(DECODER_DATA_IN_PORT_NAME) + std::string("_val"));
 
   /* Add an empty line as splitter */
-  fp << std::endl;
+  fp << "\n";
 
   /* Feed the address and data input at each falling edge of programming clock
    * As the enable signal is wired to the programming clock, we should synchronize
    * address and data with the enable signal
    */
   print_verilog_comment(fp, std::string("----- Task: assign address and data values at rising edge of enable signal -----"));
-  fp << "task " << std::string(TOP_TESTBENCH_PROG_TASK_NAME) << ";" << std::endl;
-  fp << generate_verilog_port(VERILOG_PORT_INPUT, addr_value) << ";" << std::endl;
-  fp << generate_verilog_port(VERILOG_PORT_INPUT, din_value) << ";" << std::endl;
-  fp << "\tbegin" << std::endl;
-  fp << "\t\t@(negedge " << generate_verilog_port(VERILOG_PORT_CONKT, prog_clock_port) << ");" << std::endl;
+  fp << "task " << std::string(TOP_TESTBENCH_PROG_TASK_NAME) << ";\n";
+  fp << generate_verilog_port(VERILOG_PORT_INPUT, addr_value) << ";\n";
+  fp << generate_verilog_port(VERILOG_PORT_INPUT, din_value) << ";\n";
+  fp << "\tbegin\n";
+  fp << "\t\t@(negedge " << generate_verilog_port(VERILOG_PORT_CONKT, prog_clock_port) << ");\n";
 
   fp << "\t\t\t";
   fp << generate_verilog_port(VERILOG_PORT_CONKT, addr_port);
   fp << " = ";
   fp << generate_verilog_port(VERILOG_PORT_CONKT, addr_value);
-  fp << ";" << std::endl;
-  fp << std::endl;
+  fp << ";\n";
+  fp << "\n";
 
   fp << "\t\t\t";
   fp << generate_verilog_port(VERILOG_PORT_CONKT, din_port);
   fp << " = ";
   fp << generate_verilog_port(VERILOG_PORT_CONKT, din_value);
-  fp << ";" << std::endl;
-  fp << std::endl;
+  fp << ";\n";
+  fp << "\n";
 
-  fp << "\tend" << std::endl;
-  fp << "endtask" << std::endl;
+  fp << "\tend\n";
+  fp << "endtask\n";
 
   /* Add an empty line as splitter */
-  fp << std::endl;
+  fp << "\n";
 }
 
 /********************************************************************
@@ -1132,19 +1460,30 @@ void print_verilog_top_testbench_load_bitstream_task_frame_decoder(std::fstream&
  *******************************************************************/
 static
 void print_verilog_top_testbench_load_bitstream_task(std::fstream& fp,
-                                                     const e_config_protocol_type& sram_orgz_type,
+                                                     const ConfigProtocol& config_protocol,
                                                      const ModuleManager& module_manager,
-                                                     const ModuleId& top_module) {
-  switch (sram_orgz_type) {
+                                                     const ModuleId& top_module,
+                                                     const float& prog_clock_period,
+                                                     const float& timescale) {
+  switch (config_protocol.type()) {
   case CONFIG_MEM_STANDALONE:
     /* No need to have a specific task. Loading is done in 1 clock cycle */
     break;
   case CONFIG_MEM_SCAN_CHAIN:
     print_verilog_top_testbench_load_bitstream_task_configuration_chain(fp,
+                                                                        config_protocol,
                                                                         module_manager,
                                                                         top_module);
     break;
   case CONFIG_MEM_MEMORY_BANK:
+    if (BLWL_PROTOCOL_SHIFT_REGISTER == config_protocol.bl_protocol_type()) {
+      print_verilog_top_testbench_load_bitstream_task_memory_bank_shift_register(fp,
+                                                                                module_manager,
+                                                                                top_module,
+                                                                                prog_clock_period,
+                                                                                timescale);
+      break;
+    }
     print_verilog_top_testbench_load_bitstream_task_memory_bank(fp,
                                                                 module_manager,
                                                                 top_module);
@@ -1204,7 +1543,7 @@ void print_verilog_top_testbench_generic_stimulus(std::fstream& fp,
                               0, /* Initial value */
                               num_config_clock_cycles * prog_clock_period / timescale, 0);
   print_verilog_comment(fp, "----- End configuration done signal generation -----");
-  fp << std::endl;
+  fp << "\n";
 
   /* Generate stimuli waveform for programming clock signals */
   print_verilog_comment(fp, "----- Begin raw programming clock signal generation -----");
@@ -1213,7 +1552,7 @@ void print_verilog_top_testbench_generic_stimulus(std::fstream& fp,
                               0.5 * prog_clock_period / timescale,
                               std::string());
   print_verilog_comment(fp, "----- End raw programming clock signal generation -----");
-  fp << std::endl;
+  fp << "\n";
 
   /* Programming clock should be only enabled during programming phase.
    * When configuration is done (config_done is enabled), programming clock should be always zero.
@@ -1223,9 +1562,9 @@ void print_verilog_top_testbench_generic_stimulus(std::fstream& fp,
   fp << " = " << generate_verilog_port(VERILOG_PORT_CONKT, prog_clock_register_port);
   fp << " & (~" << generate_verilog_port(VERILOG_PORT_CONKT, config_done_port) << ")";
   fp << " & (~" << generate_verilog_port(VERILOG_PORT_CONKT, prog_reset_port) << ")";
-  fp << ";" << std::endl;
+  fp << ";\n";
 
-  fp << std::endl;
+  fp << "\n";
 
   /* Generate stimuli waveform for multiple user-defined operating clock signals */
   for (const SimulationClockId& sim_clock : simulation_parameters.clocks()) {
@@ -1248,9 +1587,9 @@ void print_verilog_top_testbench_generic_stimulus(std::fstream& fp,
     fp << "\tassign " << generate_verilog_port(VERILOG_PORT_CONKT, sim_clock_port);
     fp << " = " << generate_verilog_port(VERILOG_PORT_CONKT, sim_clock_register_port);
     fp << " & " << generate_verilog_port(VERILOG_PORT_CONKT, config_done_port);
-    fp << ";" << std::endl;
+    fp << ";\n";
 
-    fp << std::endl;
+    fp << "\n";
   }
 
   /* Generate stimuli waveform for operating clock signals */
@@ -1268,9 +1607,9 @@ void print_verilog_top_testbench_generic_stimulus(std::fstream& fp,
   fp << "\tassign " << generate_verilog_port(VERILOG_PORT_CONKT, op_clock_port);
   fp << " = " << generate_verilog_port(VERILOG_PORT_CONKT, op_clock_register_port);
   fp << " & " << generate_verilog_port(VERILOG_PORT_CONKT, config_done_port);
-  fp << ";" << std::endl;
+  fp << ";\n";
 
-  fp << std::endl;
+  fp << "\n";
 
   /* Reset signal for configuration circuit:
    * only enable during the first clock cycle in programming phase
@@ -1281,7 +1620,7 @@ void print_verilog_top_testbench_generic_stimulus(std::fstream& fp,
                               prog_clock_period / timescale, 0);
   print_verilog_comment(fp, "----- End programming reset signal generation -----");
 
-  fp << std::endl;
+  fp << "\n";
 
   /* Programming set signal for configuration circuit : always disabled */
   print_verilog_comment(fp, "----- Begin programming set signal generation -----");
@@ -1290,7 +1629,7 @@ void print_verilog_top_testbench_generic_stimulus(std::fstream& fp,
                               prog_clock_period / timescale, 0);
   print_verilog_comment(fp, "----- End programming set signal generation -----");
 
-  fp << std::endl;
+  fp << "\n";
 
   /* Operating reset signals: only enabled during the first clock cycle in operation phase */
   std::vector<float> reset_pulse_widths;
@@ -1317,7 +1656,7 @@ void print_verilog_top_testbench_generic_stimulus(std::fstream& fp,
                               op_clock_period / timescale, 0);
   print_verilog_comment(fp, "----- End operating set signal generation: always disabled -----");
 
-  fp << std::endl;
+  fp << "\n";
 }
 
 /********************************************************************
@@ -1396,25 +1735,25 @@ void print_verilog_top_testbench_vanilla_bitstream(std::fstream& fp,
   std::vector<size_t> initial_wl_values(wl_port.get_width(), 0);
 
   print_verilog_comment(fp, "----- Begin bitstream loading during configuration phase -----");
-  fp << "initial" << std::endl;
-  fp << "\tbegin" << std::endl;
+  fp << "initial\n";
+  fp << "\tbegin\n";
   print_verilog_comment(fp, "----- Configuration chain default input -----");
   fp << "\t\t";
   fp << generate_verilog_port_constant_values(bl_port, initial_bl_values);
-  fp << ";" << std::endl;
+  fp << ";\n";
   fp << "\t\t";
   fp << generate_verilog_port_constant_values(wl_port, initial_wl_values);
-  fp << ";" << std::endl;
+  fp << ";\n";
 
-  fp << std::endl;
+  fp << "\n";
 
-  fp << "\t\t@(negedge " << generate_verilog_port(VERILOG_PORT_CONKT, prog_clock_port) << ") begin" << std::endl;
+  fp << "\t\t@(negedge " << generate_verilog_port(VERILOG_PORT_CONKT, prog_clock_port) << ") begin\n";
 
   /* Enable all the WLs */
   std::vector<size_t> enabled_wl_values(wl_port.get_width(), 1);
   fp << "\t\t\t";
   fp << generate_verilog_port_constant_values(wl_port, enabled_wl_values);
-  fp << ";" << std::endl;
+  fp << ";\n";
 
   size_t ibit = 0;
   for (const FabricBitId& bit_id : fabric_bitstream.bits()) {
@@ -1425,22 +1764,22 @@ void print_verilog_top_testbench_vanilla_bitstream(std::fstream& fp,
     fp << generate_verilog_port(VERILOG_PORT_CONKT, cur_bl_port);
     fp << " = ";
     fp << "1'b" << (size_t)bitstream_manager.bit_value(fabric_bitstream.config_bit(bit_id));
-    fp << ";" << std::endl;
+    fp << ";\n";
 
     ibit++;
   }
 
-  fp << "\t\tend" << std::endl;
+  fp << "\t\tend\n";
 
   /* Disable all the WLs */
-  fp << "\t\t@(negedge " << generate_verilog_port(VERILOG_PORT_CONKT, prog_clock_port) << ");" << std::endl;
+  fp << "\t\t@(negedge " << generate_verilog_port(VERILOG_PORT_CONKT, prog_clock_port) << ");\n";
 
   fp << "\t\t\t";
   fp << generate_verilog_port_constant_values(wl_port, initial_wl_values);
-  fp << ";" << std::endl;
+  fp << ";\n";
 
   /* Raise the flag of configuration done when bitstream loading is complete */
-  fp << "\t\t@(negedge " << generate_verilog_port(VERILOG_PORT_CONKT, prog_clock_port) << ");" << std::endl;
+  fp << "\t\t@(negedge " << generate_verilog_port(VERILOG_PORT_CONKT, prog_clock_port) << ");\n";
 
   BasicPort config_done_port(std::string(TOP_TB_CONFIG_DONE_PORT_NAME), 1);
   fp << "\t\t\t";
@@ -1448,9 +1787,9 @@ void print_verilog_top_testbench_vanilla_bitstream(std::fstream& fp,
   fp << " <= ";
   std::vector<size_t> config_done_enable_values(config_done_port.get_width(), 1);
   fp << generate_verilog_constant_values(config_done_enable_values);
-  fp << ";" << std::endl;
+  fp << ";\n";
 
-  fp << "\tend" << std::endl;
+  fp << "\tend\n";
   print_verilog_comment(fp, "----- End bitstream loading during configuration phase -----");
 }
 
@@ -1550,6 +1889,232 @@ bool find_bit_value_to_skip_for_fast_configuration(const e_config_protocol_type&
   return bit_value_to_skip;
 }
 
+/********************************************************************
+ * Print the codes which get the path of a file from a plusarg of the simulator
+ * and open the file, for example:
+ *   if (!$value$plusargs("bitstream=%s", bitstream_fname)) begin
+ *     $display("Error: ...");
+ *     $finish;
+ *   end
+ *   bitstream_fd = $fopen(bitstream_fname, "r");
+ * An optional file is opened only when the plusarg is given, 
+ * otherwise its file descriptor is zero
+ * The file name and the file descriptor should have been declared
+ *******************************************************************/
+static
+void print_verilog_top_testbench_plusarg_file_open(std::fstream& fp,
+                                                   const size_t& num_tabs,
+                                                   const std::string& plusarg_name,
+                                                   const std::string& fname_reg_name,
+                                                   const std::string& fd_name,
+                                                   const std::string& mode,
+                                                   const bool& required) {
+  /* Validate the file stream */
+  valid_file_stream(fp);
+
+  write_tab_to_file(fp, num_tabs);
+  fp << fd_name << " = 0;\n";
+
+  /* The file is opened inside the condition block when it is optional */
+  size_t open_tabs = num_tabs;
+  write_tab_to_file(fp, num_tabs);
+  if (true == required) {
+    fp << "if (!$value$plusargs(\"" << plusarg_name << "=%s\", " << fname_reg_name << ")) begin\n";
+    write_tab_to_file(fp, num_tabs + 1);
+    fp << "$display(\"Error: a file is required by the plusarg +" << plusarg_name << "=<file>\");\n";
+    write_tab_to_file(fp, num_tabs + 1);
+    fp << "$finish;\n";
+    write_tab_to_file(fp, num_tabs);
+    fp << "end\n";
+  } else {
+    fp << "if ($value$plusargs(\"" << plusarg_name << "=%s\", " << fname_reg_name << ")) begin\n";
+    open_tabs = num_tabs + 1;
+  }
+
+  write_tab_to_file(fp, open_tabs);
+  fp << fd_name << " = $fopen(" << fname_reg_name << ", \"" << mode << "\");\n";
+  write_tab_to_file(fp, open_tabs);
+  fp << "if (0 == " << fd_name << ") begin\n";
+  write_tab_to_file(fp, open_tabs + 1);
+  fp << "$display(\"Error: unable to open file '%0s' given by the plusarg +" << plusarg_name << "\", " << fname_reg_name << ");\n";
+  write_tab_to_file(fp, open_tabs + 1);
+  fp << "$finish;\n";
+  write_tab_to_file(fp, open_tabs);
+  fp << "end\n";
+
+  if (false == required) {
+    write_tab_to_file(fp, num_tabs);
+    fp << "end\n";
+  }
+}
+
+/********************************************************************
+ * Print the codes which read the words of a bitstream from the file
+ * given by the plusarg '+bitstream=<file>' and feed the words to the 
+ * programming task one by one, e.g.,
+ *   while (1 == $fscanf(bitstream_fd, "%b\n", bitstream_word)) begin
+ *     prog_cycle_task(bitstream_word[3:2], bitstream_word[1:0]);
+ *   end
+ * The file has the same format as the bitstream memory file,
+ * i.e., one word per line in binary format.
+ * An error is deposited if the number of words is not as expected
+ * When the first argument of the task is the length of a run minus 1,
+ * the programming cycles of the runs are counted instead of the words
+ * This function should be called inside an initial block
+ *******************************************************************/
+static
+void print_verilog_top_testbench_bitstream_runtime_loader(std::fstream& fp,
+                                                          const size_t& num_words,
+                                                          const std::vector<size_t>& task_arg_widths,
+                                                          const bool& count_run_lengths) {
+  /* Validate the file stream */
+  valid_file_stream(fp);
+
+  size_t word_width = 0;
+  for (const size_t& arg_width : task_arg_widths) {
+    word_width += arg_width;
+  }
+
+  std::string word_name(TOP_TESTBENCH_BITSTREAM_WORD_NAME);
+  std::string fname_reg_name(TOP_TESTBENCH_BITSTREAM_FILE_NAME);
+  std::string fd_name(TOP_TESTBENCH_BITSTREAM_FILE_DESCRIPTOR_NAME);
+  std::string index_name(TOP_TESTBENCH_BITSTREAM_INDEX_NAME);
+
+  print_verilog_comment(fp, std::string("----- Load bitstream from the file given by +" + std::string(TOP_TESTBENCH_BITSTREAM_PLUSARG_NAME) + "=<file> -----"));
+  fp << "\t\tbegin : " << std::string(TOP_TESTBENCH_BITSTREAM_LOADER_BLOCK_NAME) << "\n";
+  fp << "\t\t\treg [" << word_width - 1 << ":0] " << word_name << ";\n";
+  fp << "\t\t\treg [" << 8 * TOP_TESTBENCH_MAX_FILE_NAME_LENGTH - 1 << ":0] " << fname_reg_name << ";\n";
+  fp << "\t\t\tinteger " << fd_name << ";\n";
+  fp << "\t\t\tinteger " << index_name << ";\n";
+  print_verilog_top_testbench_plusarg_file_open(fp, 3,
+                                                std::string(TOP_TESTBENCH_BITSTREAM_PLUSARG_NAME),
+                                                fname_reg_name, fd_name,
+                                                std::string("r"), true);
+
+  fp << "\t\t\t" << index_name << " = 0;\n";
+  fp << "\t\t\twhile (1 == $fscanf(" << fd_name << ", \"%b\\n\", " << word_name << ")) begin\n";
+  fp << "\t\t\t\t" << std::string(TOP_TESTBENCH_PROG_TASK_NAME) << "(";
+  size_t arg_msb = word_width;
+  for (size_t iarg = 0; iarg < task_arg_widths.size(); ++iarg) {
+    if (0 < iarg) {
+      fp << ", ";
+    }
+    fp << word_name << "[" << arg_msb - 1 << ":" << arg_msb - task_arg_widths[iarg] << "]";
+    arg_msb -= task_arg_widths[iarg];
+  }
+  fp << ");\n";
+  if (true == count_run_lengths) {
+    fp << "\t\t\t\t" << index_name << " = " << index_name << " + ";
+    fp << word_name << "[" << word_width - 1 << ":" << word_width - task_arg_widths[0] << "] + 1;\n";
+  } else {
+    fp << "\t\t\t\t" << index_name << " = " << index_name << " + 1;\n";
+  }
+  fp << "\t\t\tend\n";
+  fp << "\t\t\t$fclose(" << fd_name << ");\n";
+
+  /* The number of programming cycles is fixed by the fabric when fast configuration is off */
+  std::string unit_name = (true == count_run_lengths) ? std::string("programming cycles") : std::string("words");
+  fp << "\t\t\tif (" << num_words << " != " << index_name << ") begin\n";
+  fp << "\t\t\t\t$display(\"Error: %0d " << unit_name << " are read from bitstream file '%0s' while " << num_words << " " << unit_name << " are expected by the fabric\", ";
+  fp << index_name << ", " << fname_reg_name << ");\n";
+  fp << "\t\t\t\t" << std::string(TOP_TESTBENCH_ERROR_COUNTER) << " = " << std::string(TOP_TESTBENCH_ERROR_COUNTER) << " + 1;\n";
+  fp << "\t\t\tend\n";
+  fp << "\t\tend\n";
+}
+
+/********************************************************************
+ * Write the words to be loaded during the programming cycles to a memory file,
+ * and print the codes which read the file with $readmemb and 
+ * feed the words to the programming task one by one
+ * Each word is split into the arguments of the programming task,
+ * from the MSB to the LSB, whose widths are given by task_arg_widths 
+ *
+ * The loop is independent from the number of programming cycles,
+ * so that the size of testbench does not grow with the bitstream 
+ *
+ * When the bitstream is loaded at run time, the testbench reads
+ * the file given by the plusarg '+bitstream=<file>' word by word instead,
+ * so that the testbench does not depend on the bitstream of a design.
+ * The memory file is still written as the bitstream of current design,
+ * and the number of words is checked as it is fixed by the fabric
+ * For run-length compressed bitstreams, whose first task argument is
+ * the length of a run minus 1, the number of programming cycles is checked
+ *
+ * This function should be called inside an initial block
+ *******************************************************************/
+static
+void print_verilog_top_testbench_bitstream_memory_loader(std::fstream& fp,
+                                                         const std::string& bitstream_memory_fname,
+                                                         const bool& load_at_runtime,
+                                                         const std::vector<std::string>& bitstream_words,
+                                                         const std::vector<size_t>& task_arg_widths,
+                                                         const bool& count_run_lengths) {
+  /* Validate the file stream */
+  valid_file_stream(fp);
+
+  size_t word_width = 0;
+  for (const size_t& arg_width : task_arg_widths) {
+    word_width += arg_width;
+  }
+
+  /* Write the memory file, one word per line in binary format */
+  std::fstream mem_fp;
+  mem_fp.open(bitstream_memory_fname, std::fstream::out | std::fstream::trunc);
+  check_file_stream(bitstream_memory_fname.c_str(), mem_fp);
+
+  for (const std::string& word : bitstream_words) {
+    VTR_ASSERT(word_width == word.length());
+    mem_fp << word << "\n";
+  }
+  mem_fp.close();
+
+  VTR_LOG("Written %lu programming cycles to bitstream memory file '%s'\n",
+          bitstream_words.size(), bitstream_memory_fname.c_str());
+
+  if (true == load_at_runtime) {
+    size_t num_words = bitstream_words.size();
+    if (true == count_run_lengths) {
+      num_words = 0;
+      for (const std::string& word : bitstream_words) {
+        std::string run_length_bits = word.substr(0, task_arg_widths[0]);
+        num_words += std::stoul(run_length_bits, nullptr, 2) + 1;
+      }
+    }
+    print_verilog_top_testbench_bitstream_runtime_loader(fp, num_words, task_arg_widths, count_run_lengths);
+    return;
+  }
+
+  /* Nothing to load, e.g., all the bits are skipped by fast configuration */
+  if (true == bitstream_words.empty()) {
+    return;
+  }
+
+  print_verilog_comment(fp, std::string("----- Load bitstream from memory file '" + bitstream_memory_fname + "' -----"));
+  fp << "\t\tbegin : " << std::string(TOP_TESTBENCH_BITSTREAM_LOADER_BLOCK_NAME) << "\n";
+  fp << "\t\t\treg [" << word_width - 1 << ":0] " << std::string(TOP_TESTBENCH_BITSTREAM_MEMORY_NAME);
+  fp << "[0:" << bitstream_words.size() - 1 << "];\n";
+  fp << "\t\t\tinteger " << std::string(TOP_TESTBENCH_BITSTREAM_INDEX_NAME) << ";\n";
+  fp << "\t\t\t$readmemb(\"" << bitstream_memory_fname << "\", " << std::string(TOP_TESTBENCH_BITSTREAM_MEMORY_NAME) << ");\n";
+
+  std::string index_name(TOP_TESTBENCH_BITSTREAM_INDEX_NAME);
+  fp << "\t\t\tfor (" << index_name << " = 0; ";
+  fp << index_name << " < " << bitstream_words.size() << "; ";
+  fp << index_name << " = " << index_name << " + 1) begin\n";
+  fp << "\t\t\t\t" << std::string(TOP_TESTBENCH_PROG_TASK_NAME) << "(";
+  size_t arg_msb = word_width;
+  for (size_t iarg = 0; iarg < task_arg_widths.size(); ++iarg) {
+    if (0 < iarg) {
+      fp << ", ";
+    }
+    fp << std::string(TOP_TESTBENCH_BITSTREAM_MEMORY_NAME) << "[" << index_name << "]";
+    fp << "[" << arg_msb - 1 << ":" << arg_msb - task_arg_widths[iarg] << "]";
+    arg_msb -= task_arg_widths[iarg];
+  }
+  fp << ");\n";
+  fp << "\t\t\tend\n";
+  fp << "\t\tend\n";
+}
+
 /********************************************************************
  * Print stimulus for a FPGA fabric with a configuration chain protocol
  * where configuration bits are programming in serial (one by one)
@@ -1564,8 +2129,11 @@ bool find_bit_value_to_skip_for_fast_configuration(const e_config_protocol_type&
  *******************************************************************/
 static
 void print_verilog_top_testbench_configuration_chain_bitstream(std::fstream& fp,
+                                                               const ConfigProtocol& config_protocol,
                                                                const bool& fast_configuration,
                                                                const bool& bit_value_to_skip,
+                                                               const std::string& bitstream_memory_fname,
+                                                               const bool& load_at_runtime,
                                                                const ModuleManager& module_manager,
                                                                const ModuleId& top_module,
                                                                const BitstreamManager& bitstream_manager,
@@ -1584,27 +2152,29 @@ void print_verilog_top_testbench_configuration_chain_bitstream(std::fstream& fp,
   std::vector<size_t> initial_values(config_chain_head_port.get_width(), 0);
 
   print_verilog_comment(fp, "----- Begin bitstream loading during configuration phase -----");
-  fp << "initial" << std::endl;
-  fp << "\tbegin" << std::endl;
+  fp << "initial\n";
+  fp << "\tbegin\n";
   print_verilog_comment(fp, "----- Configuration chain default input -----");
   fp << "\t\t";
   fp << generate_verilog_port_constant_values(config_chain_head_port, initial_values);
   fp << ";";
 
-  fp << std::endl;
+  fp << "\n";
 
-  /* Find the longest bitstream */
-  size_t regional_bitstream_max_size = find_fabric_regional_bitstream_max_size(fabric_bitstream);
-
-  /* For fast configuration, the bitstream size counts from the first bit '1' */
-  size_t num_bits_to_skip = 0;
-  if (true == fast_configuration) {
-    num_bits_to_skip = find_configuration_chain_fabric_bitstream_size_to_be_skipped(fabric_bitstream, bitstream_manager, bit_value_to_skip);
+  if (CONFIG_CHAIN_COMPRESSION_RUN_LENGTH == config_protocol.chain_compression_type()) {
+    ModulePortId run_length_port_id = module_manager.find_module_port(top_module, std::string(CONFIG_CHAIN_RUN_LENGTH_PORT_NAME));
+    BasicPort run_length_port = module_manager.module_port(top_module, run_length_port_id);
+    std::vector<size_t> initial_run_length_values(run_length_port.get_width(), 0);
+    fp << "\t\t";
+    fp << generate_verilog_port_constant_values(run_length_port, initial_run_length_values);
+    fp << ";\n";
   }
-  VTR_ASSERT(num_bits_to_skip < regional_bitstream_max_size);
 
-  /* Reorganize the regional bitstreams to be the same size */
-  ConfigChainFabricBitstream regional_bitstreams = build_config_chain_fabric_bitstream_by_region(bitstream_manager, fabric_bitstream);
+  /* View the regional bitstreams as they are aligned to the same size
+   * For fast configuration, each regional bitstream counts from its first bit
+   * which differs from the value to skip
+   */
+  ConfigChainFabricBitstream regional_bitstreams = build_top_testbench_configuration_chain_bitstream(fast_configuration, bit_value_to_skip, bitstream_manager, fabric_bitstream);
 
   /* Attention: when the fast configuration is enabled, we will start from the first bit '1'
    * This requires a reset signal (as we forced in the first clock cycle)
@@ -1612,29 +2182,82 @@ void print_verilog_top_testbench_configuration_chain_bitstream(std::fstream& fp,
    * Note that bitstream may come from different regions
    * The bitstream value to be loaded should be organized as follows
    *
-   *        cycleA
-   *              |
-   *   Region 0: 0|00000001111101010
-   *   Region 1:  |   00000011010101
-   *   Region 2:  | 0010101111000110
+   *                 cycleA
+   *                      |
+   *   Region 0: 00000000 |    1111101010
+   *   Region 1:   000000 |      11010101
+   *   Region 2:       00 |10101111000110
+   *
+   *   Each region skips its own leading bits, and the bits to skip will be added
+   *   to the head of those bitstreams which are shorter than the longest one
    *
-   *   Zero bits will be added to the head of those bitstreams are shorter 
-   *   than the longest bitstream
+   * When a bitstream memory file is required, the values of each cycle
+   * are written to the file as a word, instead of a call to the programming task
+   *
+   * When the bitstream is run-length compressed, the values are given per run
+   * along with the length of the run minus 1, which is the first task argument
    */
-  for (size_t ibit = num_bits_to_skip; ibit < regional_bitstream_max_size; ++ibit) { 
-    std::vector<size_t> curr_cc_head_val;
-    curr_cc_head_val.reserve(fabric_bitstream.regions().size());
-    for (const auto& region_bitstream : regional_bitstreams) {
-      curr_cc_head_val.push_back((size_t)region_bitstream[ibit]);
+  bool use_decompressor = (CONFIG_CHAIN_COMPRESSION_RUN_LENGTH == config_protocol.chain_compression_type());
+  std::vector<size_t> run_lengths;
+  if (true == use_decompressor) {
+    run_lengths = regional_bitstreams.run_lengths(size_t(1) << config_protocol.run_length_width());
+    VTR_LOG("Run-length compression reduces the configuration chain bitstream from %lu to %lu words\n",
+            regional_bitstreams.num_cycles(), run_lengths.size());
+  } else {
+    run_lengths.assign(regional_bitstreams.num_cycles(), 1);
+  }
+
+  std::vector<std::string> bitstream_words;
+  std::vector<size_t> curr_cc_head_val(regional_bitstreams.num_regions());
+  size_t ibit = 0;
+  for (const size_t& run_length : run_lengths) { 
+    for (size_t iregion = 0; iregion < regional_bitstreams.num_regions(); ++iregion) {
+      curr_cc_head_val[iregion] = (size_t)regional_bitstreams.bit_value(ibit, iregion);
     }
+    ibit += run_length;
 
-    fp << "\t\t" << std::string(TOP_TESTBENCH_PROG_TASK_NAME);
-    fp << "(" << generate_verilog_constant_values(curr_cc_head_val) << ");" << std::endl;
+    std::vector<size_t> curr_run_length_val;
+    if (true == use_decompressor) {
+      curr_run_length_val = itobin_vec(run_length - 1, config_protocol.run_length_width());
+      /* Most significant bit first */
+      std::reverse(curr_run_length_val.begin(), curr_run_length_val.end());
+    }
+
+    if (false == bitstream_memory_fname.empty()) {
+      std::string word;
+      for (const size_t& val : curr_run_length_val) {
+        word += std::to_string(val);
+      }
+      for (const size_t& val : curr_cc_head_val) {
+        word += std::to_string(val);
+      }
+      bitstream_words.push_back(word);
+      continue;
+    }
+
+    fp << "\t\t" << std::string(TOP_TESTBENCH_PROG_TASK_NAME) << "(";
+    if (true == use_decompressor) {
+      fp << generate_verilog_constant_values(curr_run_length_val) << ", ";
+    }
+    fp << generate_verilog_constant_values(curr_cc_head_val) << ");\n";
+  }
+
+  if (false == bitstream_memory_fname.empty()) {
+    std::vector<size_t> task_arg_widths;
+    if (true == use_decompressor) {
+      task_arg_widths.push_back(config_protocol.run_length_width());
+    }
+    task_arg_widths.push_back(fabric_bitstream.regions().size());
+    print_verilog_top_testbench_bitstream_memory_loader(fp, bitstream_memory_fname,
+                                                        load_at_runtime,
+                                                        bitstream_words,
+                                                        task_arg_widths,
+                                                        use_decompressor);
   }
 
   /* Raise the flag of configuration done when bitstream loading is complete */
   BasicPort prog_clock_port(std::string(TOP_TB_PROG_CLOCK_PORT_NAME), 1);
-  fp << "\t\t@(negedge " << generate_verilog_port(VERILOG_PORT_CONKT, prog_clock_port) << ");" << std::endl;
+  fp << "\t\t@(negedge " << generate_verilog_port(VERILOG_PORT_CONKT, prog_clock_port) << ");\n";
 
   BasicPort config_done_port(std::string(TOP_TB_CONFIG_DONE_PORT_NAME), 1);
   fp << "\t\t\t";
@@ -1642,9 +2265,9 @@ void print_verilog_top_testbench_configuration_chain_bitstream(std::fstream& fp,
   fp << " <= ";
   std::vector<size_t> config_done_enable_values(config_done_port.get_width(), 1);
   fp << generate_verilog_constant_values(config_done_enable_values);
-  fp << ";" << std::endl;
+  fp << ";\n";
 
-  fp << "\tend" << std::endl;
+  fp << "\tend\n";
   print_verilog_comment(fp, "----- End bitstream loading during configuration phase -----");
 }
 
@@ -1658,9 +2281,11 @@ static
 void print_verilog_top_testbench_memory_bank_bitstream(std::fstream& fp,
                                                        const bool& fast_configuration,
                                                        const bool& bit_value_to_skip,
+                                                       const std::string& bitstream_memory_fname,
+                                                       const bool& load_at_runtime,
                                                        const ModuleManager& module_manager,
                                                        const ModuleId& top_module,
-                                                       const FabricBitstream& fabric_bitstream) {
+                                                       const FabricBitstreamByAddress& fabric_bits_by_addr) {
   /* Validate the file stream */
   valid_file_stream(fp);
 
@@ -1684,63 +2309,69 @@ void print_verilog_top_testbench_memory_bank_bitstream(std::fstream& fp,
   std::vector<size_t> initial_din_values(din_port.get_width(), 0);
 
   print_verilog_comment(fp, "----- Begin bitstream loading during configuration phase -----");
-  fp << "initial" << std::endl;
-  fp << "\tbegin" << std::endl;
+  fp << "initial\n";
+  fp << "\tbegin\n";
   print_verilog_comment(fp, "----- Address port default input -----");
   fp << "\t\t";
   fp << generate_verilog_port_constant_values(bl_addr_port, initial_bl_addr_values);
   fp << ";";
-  fp << std::endl;
+  fp << "\n";
 
   fp << "\t\t";
   fp << generate_verilog_port_constant_values(wl_addr_port, initial_wl_addr_values);
   fp << ";";
-  fp << std::endl;
+  fp << "\n";
 
   print_verilog_comment(fp, "----- Data-input port default input -----");
   fp << "\t\t";
   fp << generate_verilog_port_constant_values(din_port, initial_din_values);
   fp << ";";
 
-  fp << std::endl;
+  fp << "\n";
 
-  /* Reorganize the fabric bitstream by the same address across regions */
-  MemoryBankFabricBitstream fabric_bits_by_addr = build_memory_bank_fabric_bitstream_by_address(fabric_bitstream);
-
-  for (const auto& addr_din_pair : fabric_bits_by_addr) {
+  std::vector<std::string> bitstream_words;
+  for (size_t iword = 0; iword < fabric_bits_by_addr.num_words(); ++iword) {
     /* When fast configuration is enabled,
      * the rule to skip any configuration bit should consider the whole data input values.
      * Only all the bits in the din port match the value to be skipped,
      * the programming cycle can be skipped!
      */
-    if (true == fast_configuration) {
-      bool skip_curr_bits = true;
-      for (const bool& bit : addr_din_pair.second) {
-        if (bit_value_to_skip != bit) {
-          skip_curr_bits = false;
-          break;
-        }
-      }
+    if ( (true == fast_configuration)
+      && (true == fabric_bits_by_addr.word_dins_equal(iword, bit_value_to_skip)) ) {
+      continue;
+    }
 
-      if (true == skip_curr_bits) {
-        continue;
+    std::string bl_addr_str = fabric_bits_by_addr.word_address(iword);
+    std::string wl_addr_str = fabric_bits_by_addr.word_wl_address(iword);
+    std::vector<bool> din_values = fabric_bits_by_addr.word_dins(iword);
+
+    /* Each word is the concatenation of BL address, WL address and data input */
+    if (false == bitstream_memory_fname.empty()) {
+      VTR_ASSERT(bl_addr_port.get_width() == bl_addr_str.length());
+      VTR_ASSERT(wl_addr_port.get_width() == wl_addr_str.length());
+      VTR_ASSERT(din_port.get_width() == din_values.size());
+      std::string word = bl_addr_str + wl_addr_str;
+      for (const bool& din_value : din_values) {
+        word += (true == din_value) ? '1' : '0';
       }
+      bitstream_words.push_back(word);
+      continue;
     }
 
     fp << "\t\t" << std::string(TOP_TESTBENCH_PROG_TASK_NAME);
     fp << "(" << bl_addr_port.get_width() << "'b";
-    VTR_ASSERT(bl_addr_port.get_width() == addr_din_pair.first.first.length());
-    fp << addr_din_pair.first.first;
+    VTR_ASSERT(bl_addr_port.get_width() == bl_addr_str.length());
+    fp << bl_addr_str;
 
     fp << ", ";
     fp << wl_addr_port.get_width() << "'b";
-    VTR_ASSERT(wl_addr_port.get_width() == addr_din_pair.first.second.length());
-    fp << addr_din_pair.first.second;
+    VTR_ASSERT(wl_addr_port.get_width() == wl_addr_str.length());
+    fp << wl_addr_str;
 
     fp << ", ";
     fp << din_port.get_width() << "'b";
-    VTR_ASSERT(din_port.get_width() == addr_din_pair.second.size());
-    for (const bool& din_value : addr_din_pair.second) {
+    VTR_ASSERT(din_port.get_width() == din_values.size());
+    for (const bool& din_value : din_values) {
       if (true == din_value) {
         fp << "1";
       } else {
@@ -1748,12 +2379,20 @@ void print_verilog_top_testbench_memory_bank_bitstream(std::fstream& fp,
         fp << "0";
       }
     }
-    fp << ");" << std::endl;
+    fp << ");\n";
+  }
+
+  if (false == bitstream_memory_fname.empty()) {
+    print_verilog_top_testbench_bitstream_memory_loader(fp, bitstream_memory_fname,
+                                                        load_at_runtime,
+                                                        bitstream_words,
+                                                        {bl_addr_port.get_width(), wl_addr_port.get_width(), din_port.get_width()},
+                                                        false);
   }
 
   /* Raise the flag of configuration done when bitstream loading is complete */
   BasicPort prog_clock_port(std::string(TOP_TB_PROG_CLOCK_PORT_NAME), 1);
-  fp << "\t\t@(negedge " << generate_verilog_port(VERILOG_PORT_CONKT, prog_clock_port) << ");" << std::endl;
+  fp << "\t\t@(negedge " << generate_verilog_port(VERILOG_PORT_CONKT, prog_clock_port) << ");\n";
 
   BasicPort config_done_port(std::string(TOP_TB_CONFIG_DONE_PORT_NAME), 1);
   fp << "\t\t\t";
@@ -1761,9 +2400,109 @@ void print_verilog_top_testbench_memory_bank_bitstream(std::fstream& fp,
   fp << " <= ";
   std::vector<size_t> config_done_enable_values(config_done_port.get_width(), 1);
   fp << generate_verilog_constant_values(config_done_enable_values);
-  fp << ";" << std::endl;
+  fp << ";\n";
 
-  fp << "\tend" << std::endl;
+  fp << "\tend\n";
+  print_verilog_comment(fp, "----- End bitstream loading during configuration phase -----");
+}
+
+/********************************************************************
+ * Print stimulus for a FPGA fabric with a memory bank configuration protocol
+ * whose Bit-Lines are driven by shift registers,
+ * where configuration bits are programming by Word-Lines
+ *
+ * We will use the programming task function created before
+ *******************************************************************/
+static
+void print_verilog_top_testbench_memory_bank_shift_register_bitstream(std::fstream& fp,
+                                                                      const bool& fast_configuration,
+                                                                      const bool& bit_value_to_skip,
+                                                                      const std::string& bitstream_memory_fname,
+                                                                      const bool& load_at_runtime,
+                                                                      const ModuleManager& module_manager,
+                                                                      const ModuleId& top_module,
+                                                                      const FabricBitstreamByAddress& fabric_bits_by_addr) {
+  /* Validate the file stream */
+  valid_file_stream(fp);
+
+  /* Feed WL addresss and BL data one by one
+   * Note: the first cycle is reserved for programming reset
+   * We should give dummy values
+   */
+  ModulePortId bl_sr_clk_port_id = module_manager.find_module_port(top_module,
+                                                                   std::string(BL_SHIFT_REGISTER_CLOCK_PORT_NAME));
+  BasicPort bl_sr_clk_port = module_manager.module_port(top_module, bl_sr_clk_port_id);
+  std::vector<size_t> initial_bl_sr_clk_values(bl_sr_clk_port.get_width(), 0);
+
+  ModulePortId wl_addr_port_id = module_manager.find_module_port(top_module,
+                                                                 std::string(DECODER_WL_ADDRESS_PORT_NAME));
+  BasicPort wl_addr_port = module_manager.module_port(top_module, wl_addr_port_id);
+  std::vector<size_t> initial_wl_addr_values(wl_addr_port.get_width(), 0);
+
+  ModulePortId din_port_id = module_manager.find_module_port(top_module,
+                                                             std::string(DECODER_DATA_IN_PORT_NAME));
+  BasicPort din_port = module_manager.module_port(top_module, din_port_id);
+  std::vector<size_t> initial_din_values(din_port.get_width(), 0);
+
+  size_t num_bls = find_top_module_bl_shift_register_size(module_manager, top_module);
+  size_t bl_data_width = num_bls * din_port.get_width();
+
+  print_verilog_comment(fp, "----- Begin bitstream loading during configuration phase -----");
+  fp << "initial\n";
+  fp << "\tbegin\n";
+  print_verilog_comment(fp, "----- Shift register clock and address port default input -----");
+  fp << "\t\t";
+  fp << generate_verilog_port_constant_values(bl_sr_clk_port, initial_bl_sr_clk_values);
+  fp << ";";
+  fp << "\n";
+
+  fp << "\t\t";
+  fp << generate_verilog_port_constant_values(wl_addr_port, initial_wl_addr_values);
+  fp << ";";
+  fp << "\n";
+
+  print_verilog_comment(fp, "----- Data-input port default input -----");
+  fp << "\t\t";
+  fp << generate_verilog_port_constant_values(din_port, initial_din_values);
+  fp << ";";
+
+  fp << "\n";
+
+  /* Each word is the concatenation of WL address and the data of all the BLs */
+  std::vector<std::string> bitstream_words = build_memory_bank_shift_register_words(fabric_bits_by_addr, num_bls,
+                                                                                    fast_configuration, bit_value_to_skip);
+  if (false == bitstream_memory_fname.empty()) {
+    print_verilog_top_testbench_bitstream_memory_loader(fp, bitstream_memory_fname,
+                                                        load_at_runtime,
+                                                        bitstream_words,
+                                                        {wl_addr_port.get_width(), bl_data_width},
+                                                        false);
+  } else {
+    for (const std::string& word : bitstream_words) {
+      VTR_ASSERT(wl_addr_port.get_width() + bl_data_width == word.length());
+      fp << "\t\t" << std::string(TOP_TESTBENCH_PROG_TASK_NAME);
+      fp << "(" << wl_addr_port.get_width() << "'b";
+      fp << word.substr(0, wl_addr_port.get_width());
+      fp << ", ";
+      fp << bl_data_width << "'b";
+      fp << word.substr(wl_addr_port.get_width());
+      fp << ");\n";
+    }
+  }
+
+  /* Raise the flag of configuration done when bitstream loading is complete */
+  BasicPort prog_clock_port(std::string(TOP_TB_PROG_CLOCK_PORT_NAME), 1);
+  fp << "\t\t@(negedge " << generate_verilog_port(VERILOG_PORT_CONKT, prog_clock_port) << ");\n";
+
+  BasicPort config_done_port(std::string(TOP_TB_CONFIG_DONE_PORT_NAME), 1);
+  fp << "\t\t\t";
+  fp << generate_verilog_port(VERILOG_PORT_CONKT, config_done_port);
+  fp << " <= ";
+  std::vector<size_t> config_done_enable_values(config_done_port.get_width(), 1);
+  fp << generate_verilog_constant_values(config_done_enable_values);
+  fp << ";\n";
+
+  fp << "\tend\n";
   print_verilog_comment(fp, "----- End bitstream loading during configuration phase -----");
 }
 
@@ -1777,9 +2516,11 @@ static
 void print_verilog_top_testbench_frame_decoder_bitstream(std::fstream& fp,
                                                          const bool& fast_configuration,
                                                          const bool& bit_value_to_skip,
+                                                         const std::string& bitstream_memory_fname,
+                                                         const bool& load_at_runtime,
                                                          const ModuleManager& module_manager,
                                                          const ModuleId& top_module,
-                                                         const FabricBitstream& fabric_bitstream) {
+                                                         const FabricBitstreamByAddress& fabric_bits_by_addr) {
   /* Validate the file stream */
   valid_file_stream(fp);
 
@@ -1798,52 +2539,56 @@ void print_verilog_top_testbench_frame_decoder_bitstream(std::fstream& fp,
   std::vector<size_t> initial_din_values(din_port.get_width(), 0);
 
   print_verilog_comment(fp, "----- Begin bitstream loading during configuration phase -----");
-  fp << "initial" << std::endl;
-  fp << "\tbegin" << std::endl;
+  fp << "initial\n";
+  fp << "\tbegin\n";
   print_verilog_comment(fp, "----- Address port default input -----");
   fp << "\t\t";
   fp << generate_verilog_port_constant_values(addr_port, initial_addr_values);
   fp << ";";
-  fp << std::endl;
+  fp << "\n";
 
   print_verilog_comment(fp, "----- Data-input port default input -----");
   fp << "\t\t";
   fp << generate_verilog_port_constant_values(din_port, initial_din_values);
   fp << ";";
 
-  fp << std::endl;
+  fp << "\n";
 
-  /* Reorganize the fabric bitstream by the same address across regions */
-  FrameFabricBitstream fabric_bits_by_addr = build_frame_based_fabric_bitstream_by_address(fabric_bitstream);
-
-  for (const auto& addr_din_pair : fabric_bits_by_addr) {
+  std::vector<std::string> bitstream_words;
+  for (size_t iword = 0; iword < fabric_bits_by_addr.num_words(); ++iword) {
     /* When fast configuration is enabled,
      * the rule to skip any configuration bit should consider the whole data input values.
      * Only all the bits in the din port match the value to be skipped,
      * the programming cycle can be skipped!
      */
-    if (true == fast_configuration) {
-      bool skip_curr_bits = true;
-      for (const bool& bit : addr_din_pair.second) {
-        if (bit_value_to_skip != bit) {
-          skip_curr_bits = false;
-          break;
-        }
-      }
+    if ( (true == fast_configuration)
+      && (true == fabric_bits_by_addr.word_dins_equal(iword, bit_value_to_skip)) ) {
+      continue;
+    }
 
-      if (true == skip_curr_bits) {
-        continue;
+    std::string addr_str = fabric_bits_by_addr.word_address(iword);
+    std::vector<bool> din_values = fabric_bits_by_addr.word_dins(iword);
+
+    /* Each word is the concatenation of address and data input */
+    if (false == bitstream_memory_fname.empty()) {
+      VTR_ASSERT(addr_port.get_width() == addr_str.size());
+      VTR_ASSERT(din_port.get_width() == din_values.size());
+      std::string word = addr_str;
+      for (const bool& din_value : din_values) {
+        word += (true == din_value) ? '1' : '0';
       }
+      bitstream_words.push_back(word);
+      continue;
     }
 
     fp << "\t\t" << std::string(TOP_TESTBENCH_PROG_TASK_NAME);
     fp << "(" << addr_port.get_width() << "'b";
-    VTR_ASSERT(addr_port.get_width() == addr_din_pair.first.size());
-    fp << addr_din_pair.first;
+    VTR_ASSERT(addr_port.get_width() == addr_str.size());
+    fp << addr_str;
     fp << ", ";
     fp << din_port.get_width() << "'b";
-    VTR_ASSERT(din_port.get_width() == addr_din_pair.second.size());
-    for (const bool& din_value : addr_din_pair.second) {
+    VTR_ASSERT(din_port.get_width() == din_values.size());
+    for (const bool& din_value : din_values) {
       if (true == din_value) {
         fp << "1";
       } else {
@@ -1851,7 +2596,15 @@ void print_verilog_top_testbench_frame_decoder_bitstream(std::fstream& fp,
         fp << "0";
       }
     }
-    fp << ");" << std::endl;
+    fp << ");\n";
+  }
+
+  if (false == bitstream_memory_fname.empty()) {
+    print_verilog_top_testbench_bitstream_memory_loader(fp, bitstream_memory_fname,
+                                                        load_at_runtime,
+                                                        bitstream_words,
+                                                        {addr_port.get_width(), din_port.get_width()},
+                                                        false);
   }
 
   /* Disable the address and din 
@@ -1863,12 +2616,12 @@ void print_verilog_top_testbench_frame_decoder_bitstream(std::fstream& fp,
   }
   fp << ", ";
   fp << generate_verilog_constant_values(initial_din_values);
-  fp << ");" << std::endl;
+  fp << ");\n";
   */
 
   /* Raise the flag of configuration done when bitstream loading is complete */
   BasicPort prog_clock_port(std::string(TOP_TB_PROG_CLOCK_PORT_NAME), 1);
-  fp << "\t\t@(negedge " << generate_verilog_port(VERILOG_PORT_CONKT, prog_clock_port) << ");" << std::endl;
+  fp << "\t\t@(negedge " << generate_verilog_port(VERILOG_PORT_CONKT, prog_clock_port) << ");\n";
 
   BasicPort config_done_port(std::string(TOP_TB_CONFIG_DONE_PORT_NAME), 1);
   fp << "\t\t\t";
@@ -1876,9 +2629,9 @@ void print_verilog_top_testbench_frame_decoder_bitstream(std::fstream& fp,
   fp << " <= ";
   std::vector<size_t> config_done_enable_values(config_done_port.get_width(), 1);
   fp << generate_verilog_constant_values(config_done_enable_values);
-  fp << ";" << std::endl;
+  fp << ";\n";
 
-  fp << "\tend" << std::endl;
+  fp << "\tend\n";
   print_verilog_comment(fp, "----- End bitstream loading during configuration phase -----");
 }
 
@@ -1890,38 +2643,57 @@ void print_verilog_top_testbench_frame_decoder_bitstream(std::fstream& fp,
  *******************************************************************/
 static
 void print_verilog_top_testbench_bitstream(std::fstream& fp,
-                                           const e_config_protocol_type& config_protocol_type,
+                                           const ConfigProtocol& config_protocol,
                                            const bool& fast_configuration,
                                            const bool& bit_value_to_skip,
+                                           const std::string& bitstream_memory_fname,
+                                           const bool& load_at_runtime,
                                            const ModuleManager& module_manager,
                                            const ModuleId& top_module,
                                            const BitstreamManager& bitstream_manager,
-                                           const FabricBitstream& fabric_bitstream) {
+                                           const FabricBitstream& fabric_bitstream,
+                                           const FabricBitstreamByAddress& fabric_bitstream_by_address) {
 
   /* Branch on the type of configuration protocol */
-  switch (config_protocol_type) {
+  switch (config_protocol.type()) {
   case CONFIG_MEM_STANDALONE:
     print_verilog_top_testbench_vanilla_bitstream(fp,
                                                   module_manager, top_module,
                                                   bitstream_manager, fabric_bitstream);
     break;
   case CONFIG_MEM_SCAN_CHAIN:
-    print_verilog_top_testbench_configuration_chain_bitstream(fp, fast_configuration, 
+    print_verilog_top_testbench_configuration_chain_bitstream(fp, config_protocol,
+                                                              fast_configuration, 
                                                               bit_value_to_skip,
+                                                              bitstream_memory_fname,
+                                                              load_at_runtime,
                                                               module_manager, top_module,
                                                               bitstream_manager, fabric_bitstream);
     break;
   case CONFIG_MEM_MEMORY_BANK:
+    if (BLWL_PROTOCOL_SHIFT_REGISTER == config_protocol.bl_protocol_type()) {
+      print_verilog_top_testbench_memory_bank_shift_register_bitstream(fp, fast_configuration,
+                                                                       bit_value_to_skip,
+                                                                       bitstream_memory_fname,
+                                                                       load_at_runtime,
+                                                                       module_manager, top_module,
+                                                                       fabric_bitstream_by_address);
+      break;
+    }
     print_verilog_top_testbench_memory_bank_bitstream(fp, fast_configuration,
                                                       bit_value_to_skip,
+                                                      bitstream_memory_fname,
+                                                      load_at_runtime,
                                                       module_manager, top_module,
-                                                      fabric_bitstream);
+                                                      fabric_bitstream_by_address);
     break;
   case CONFIG_MEM_FRAME_BASED:
     print_verilog_top_testbench_frame_decoder_bitstream(fp, fast_configuration,
                                                         bit_value_to_skip,
+                                                        bitstream_memory_fname,
+                                                        load_at_runtime,
                                                         module_manager, top_module,
-                                                        fabric_bitstream);
+                                                        fabric_bitstream_by_address);
     break;
   default:
     VTR_LOGF_ERROR(__FILE__, __LINE__,
@@ -2001,19 +2773,19 @@ void print_verilog_top_testbench_check(std::fstream& fp,
   BasicPort config_done_port(config_done_port_name, 1);
 
   write_tab_to_file(fp, 1);
-  fp << "always@(posedge " << generate_verilog_port(VERILOG_PORT_CONKT, config_done_port) << ") begin" << std::endl;
+  fp << "always@(posedge " << generate_verilog_port(VERILOG_PORT_CONKT, config_done_port) << ") begin\n";
 
   write_tab_to_file(fp, 2);
-  fp << error_counter_name << " = " << error_counter_name << " - 1;" << std::endl;
+  fp << error_counter_name << " = " << error_counter_name << " - 1;\n";
 
   write_tab_to_file(fp, 1);
-  fp << "end" << std::endl;
+  fp << "end\n";
 
   /* Condition ends */
   print_verilog_endif(fp);
 
   /* Add an empty line as splitter */
-  fp << std::endl;
+  fp << "\n";
 }
 
 /********************************************************************
@@ -2039,6 +2811,7 @@ void print_verilog_top_testbench_check(std::fstream& fp,
 void print_verilog_top_testbench(const ModuleManager& module_manager,
                                  const BitstreamManager& bitstream_manager,
                                  const FabricBitstream& fabric_bitstream,
+                                 const FabricBitstreamByAddress& fabric_bitstream_by_address,
                                  const CircuitLibrary& circuit_lib,
                                  const ConfigProtocol& config_protocol,
                                  const FabricGlobalPortInfo& global_ports,
@@ -2049,6 +2822,7 @@ void print_verilog_top_testbench(const ModuleManager& module_manager,
                                  const VprNetlistAnnotation& netlist_annotation,
                                  const std::string& circuit_name,
                                  const std::string& verilog_fname,
+                                 const std::string& bitstream_memory_fname,
                                  const SimulationSetting& simulation_parameters,
                                  const VerilogTestbenchOption& options) {
 
@@ -2061,8 +2835,8 @@ void print_verilog_top_testbench(const ModuleManager& module_manager,
   vtr::ScopedStartFinishTimer timer(timer_message);
 
   /* Create the file stream */
-  std::fstream fp;
-  fp.open(verilog_fname, std::fstream::out | std::fstream::trunc);
+  BufferedFileStream testbench_file(verilog_fname, options.compression());
+  std::fstream& fp = testbench_file.stream();
 
   /* Validate the file stream */
   check_file_stream(verilog_fname.c_str(), fp);
@@ -2112,11 +2886,14 @@ void print_verilog_top_testbench(const ModuleManager& module_manager,
   }
 
   /* Estimate the number of configuration clock cycles */
-  size_t num_config_clock_cycles = calculate_num_config_clock_cycles(config_protocol.type(),
+  size_t num_config_clock_cycles = calculate_num_config_clock_cycles(config_protocol,
                                                                      apply_fast_configuration,
                                                                      bit_value_to_skip,
+                                                                     module_manager,
+                                                                     top_module,
                                                                      bitstream_manager,
-                                                                     fabric_bitstream);
+                                                                     fabric_bitstream,
+                                                                     fabric_bitstream_by_address);
 
   /* Generate stimuli for general control signals */
   print_verilog_top_testbench_generic_stimulus(fp,
@@ -2190,25 +2967,34 @@ void print_verilog_top_testbench(const ModuleManager& module_manager,
 
   /* Print tasks used for loading bitstreams */
   print_verilog_top_testbench_load_bitstream_task(fp,
-                                                  config_protocol.type(),
-                                                  module_manager, top_module);
+                                                  config_protocol,
+                                                  module_manager, top_module,
+                                                  prog_clock_period,
+                                                  VERILOG_SIM_TIMESCALE);
 
   /* load bitstream to FPGA fabric in a configuration phase */
-  print_verilog_top_testbench_bitstream(fp, config_protocol.type(),
+  print_verilog_top_testbench_bitstream(fp, config_protocol,
                                         apply_fast_configuration,
                                         bit_value_to_skip,
+                                        bitstream_memory_fname,
+                                        false,
                                         module_manager, top_module,
-                                        bitstream_manager, fabric_bitstream);
+                                        bitstream_manager, fabric_bitstream,
+                                        fabric_bitstream_by_address);
 
   /* Add signal initialization: 
    * Bypass writing codes to files due to the autogenerated codes are very large.
+   * When the primitive modules of the fabric initialize their own drivers,
+   * only the primitives with user-defined netlists are initialized here
    */
-  if (true == options.include_signal_init()) {
+  if ( (true == options.include_signal_init())
+    || (true == options.fabric_signal_init()) ) {
     print_verilog_testbench_signal_initialization(fp,
                                                   std::string(TOP_TESTBENCH_FPGA_INSTANCE_NAME),
                                                   circuit_lib,
                                                   module_manager,
-                                                  top_module);
+                                                  top_module,
+                                                  options.fabric_signal_init());
   }
 
 
@@ -2272,7 +3058,404 @@ void print_verilog_top_testbench(const ModuleManager& module_manager,
   print_verilog_module_end(fp, std::string(circuit_name) + std::string(AUTOCHECK_TOP_TESTBENCH_VERILOG_MODULE_POSTFIX));
 
   /* Close the file stream */
-  fp.close();
+  testbench_file.close();
+
+  VTR_LOGV(options.verbose_output(),
+           "Written %lu bytes in %.2f seconds (%.2f MB/s)\n",
+           testbench_file.num_bytes(), testbench_file.elapsed_sec(),
+           testbench_file.bytes_per_sec() / (1024. * 1024.));
+}
+
+/********************************************************************
+ * Find the mappable I/O ports of the FPGA fabric, which are
+ * driven and observed by the I/O vectors of the run-time testbench
+ * The ports are in the sequence of MODULE_IO_PORT_TYPES
+ *******************************************************************/
+static
+std::vector<ModulePortId> find_runtime_top_testbench_io_ports(const ModuleManager& module_manager,
+                                                              const ModuleId& top_module) {
+  std::vector<ModulePortId> module_io_ports;
+  for (const ModuleManager::e_module_port_type& module_io_port_type : MODULE_IO_PORT_TYPES) {
+    for (const ModulePortId& gpio_port_id : module_manager.module_port_ids_by_type(top_module, module_io_port_type)) {
+      /* Only care mappable I/O */
+      if (false == module_manager.port_is_mappable_io(top_module, gpio_port_id)) {
+        continue;
+      }
+      module_io_ports.push_back(gpio_port_id);
+    }
+  }
+  return module_io_ports;
+}
+
+/********************************************************************
+ * Print the registers which hold the I/O vectors of the run-time testbench
+ * and wire them to the I/Os of the FPGA fabric
+ * Each I/O vector is the concatenation of all the mappable I/O ports
+ * of the FPGA fabric, where each port is listed from its MSB to its LSB, e.g.,
+ *
+ *   {gfpga_pad_GPIN[3:0], gfpga_pad_GPOUT[1:0], gfpga_pad_GPIO[7:0]}
+ *
+ * - The stimuli drive the general-purpose inputs and I/Os.
+ *   A value 'z' releases an I/O so that it can be driven by the fabric.
+ *   The stimuli of the general-purpose outputs are ignored.
+ * - The observed vector collects the values of all the I/Os
+ *******************************************************************/
+static
+size_t print_verilog_runtime_top_testbench_io_ports(std::fstream& fp,
+                                                    const ModuleManager& module_manager,
+                                                    const ModuleId& top_module) {
+  /* Validate the file stream */
+  valid_file_stream(fp);
+
+  std::vector<ModulePortId> module_io_ports = find_runtime_top_testbench_io_ports(module_manager, top_module);
+
+  size_t io_width = 0;
+  for (const ModulePortId& module_io_port_id : module_io_ports) {
+    io_width += module_manager.module_port(top_module, module_io_port_id).get_width();
+  }
+  /* Nothing to drive, but keep a one-bit vector so that the vector files can still be read */
+  size_t vector_width = std::max(io_width, size_t(1));
+
+  print_verilog_comment(fp, std::string("----- I/O vectors loaded at run time: " + std::to_string(io_width) + " bits -----"));
+  BasicPort stimuli_port(std::string(TOP_TESTBENCH_IO_STIMULI_NAME), vector_width);
+  fp << "\t" << generate_verilog_port(VERILOG_PORT_REG, stimuli_port) << ";\n";
+  BasicPort expected_port(std::string(TOP_TESTBENCH_IO_EXPECTED_NAME), vector_width);
+  fp << "\t" << generate_verilog_port(VERILOG_PORT_REG, expected_port) << ";\n";
+  BasicPort observed_port(std::string(TOP_TESTBENCH_IO_OBSERVED_NAME), vector_width);
+  fp << "\t" << generate_verilog_port(VERILOG_PORT_WIRE, observed_port) << ";\n";
+  fp << "\n";
+
+  /* The first port is at the MSB of the vectors */
+  size_t msb = io_width;
+  for (const ModulePortId& module_io_port_id : module_io_ports) {
+    BasicPort module_io_port = module_manager.module_port(top_module, module_io_port_id);
+    BasicPort stimuli_slice(stimuli_port.get_name(), msb - module_io_port.get_width(), msb - 1);
+    BasicPort observed_slice(observed_port.get_name(), msb - module_io_port.get_width(), msb - 1);
+    msb -= module_io_port.get_width();
+
+    print_verilog_comment(fp, std::string("----- FPGA I/Os " + generate_verilog_port(VERILOG_PORT_CONKT, module_io_port) + " are bits " + generate_verilog_port(VERILOG_PORT_CONKT, stimuli_slice) + " of the I/O vectors -----"));
+    if (ModuleManager::MODULE_GPOUT_PORT != module_manager.port_type(top_module, module_io_port_id)) {
+      print_verilog_wire_connection(fp, module_io_port, stimuli_slice, false);
+    }
+    print_verilog_wire_connection(fp, observed_slice, module_io_port, false);
+  }
+  /* Tie the dummy bit */
+  if (0 == io_width) {
+    print_verilog_wire_constant_values(fp, observed_port, std::vector<size_t>(1, 0));
+  }
+
+  fp << "\n";
+
+  return vector_width;
+}
+
+/********************************************************************
+ * Print the codes which apply the I/O vectors of the run-time testbench
+ * and finish the simulation when all the vectors are applied:
+ * - The stimuli are read from the file given by '+io_stimuli=<file>'.
+ *   The first vector is applied when the configuration is done, 
+ *   and the next vectors are applied at each falling edge of the operating clock
+ * - The expected outputs are read from the optional file given by '+io_expected=<file>'.
+ *   Each expected vector is compared at the falling edge of the operating clock 
+ *   which ends the cycle of its stimuli, where bits 'x' are not compared.
+ *   Each mismatch increases the error counter
+ * - The observed I/O vectors are written to the optional file given by '+io_outputs=<file>'
+ * Each file has one vector per line in binary format
+ *******************************************************************/
+static
+void print_verilog_runtime_top_testbench_io_vectors(std::fstream& fp,
+                                                    const size_t& vector_width) {
+  /* Validate the file stream */
+  valid_file_stream(fp);
+
+  std::string stimuli_name(TOP_TESTBENCH_IO_STIMULI_NAME);
+  std::string expected_name(TOP_TESTBENCH_IO_EXPECTED_NAME);
+  std::string observed_name(TOP_TESTBENCH_IO_OBSERVED_NAME);
+  std::string outputs_name(TOP_TESTBENCH_IO_OUTPUTS_NAME);
+  std::string cycle_name(TOP_TESTBENCH_IO_CYCLE_NAME);
+  std::string index_name(TOP_TESTBENCH_IO_INDEX_NAME);
+  std::string error_counter_name(TOP_TESTBENCH_ERROR_COUNTER);
+  BasicPort config_done_port(std::string(TOP_TB_CONFIG_DONE_PORT_NAME), 1);
+  BasicPort op_clock_port(std::string(TOP_TB_OP_CLOCK_PORT_NAME), 1);
+
+  print_verilog_comment(fp, "----- Begin I/O vectors loading during operating phase -----");
+  fp << "initial\n";
+  fp << "\tbegin : " << std::string(TOP_TESTBENCH_IO_LOADER_BLOCK_NAME) << "\n";
+  for (const std::string& file_name : {stimuli_name, expected_name, outputs_name}) {
+    fp << "\t\treg [" << 8 * TOP_TESTBENCH_MAX_FILE_NAME_LENGTH - 1 << ":0] " << file_name << std::string(TOP_TESTBENCH_FILE_NAME_POSTFIX) << ";\n";
+    fp << "\t\tinteger " << file_name << std::string(TOP_TESTBENCH_FILE_DESCRIPTOR_POSTFIX) << ";\n";
+  }
+  fp << "\t\tinteger " << cycle_name << ";\n";
+  fp << "\t\tinteger " << index_name << ";\n";
+
+  std::string stimuli_fd_name = stimuli_name + std::string(TOP_TESTBENCH_FILE_DESCRIPTOR_POSTFIX);
+  std::string expected_fd_name = expected_name + std::string(TOP_TESTBENCH_FILE_DESCRIPTOR_POSTFIX);
+  std::string outputs_fd_name = outputs_name + std::string(TOP_TESTBENCH_FILE_DESCRIPTOR_POSTFIX);
+  print_verilog_top_testbench_plusarg_file_open(fp, 2, stimuli_name,
+                                                stimuli_name + std::string(TOP_TESTBENCH_FILE_NAME_POSTFIX),
+                                                stimuli_fd_name,
+                                                std::string("r"), true);
+  print_verilog_top_testbench_plusarg_file_open(fp, 2, expected_name,
+                                                expected_name + std::string(TOP_TESTBENCH_FILE_NAME_POSTFIX),
+                                                expected_fd_name,
+                                                std::string("r"), false);
+  print_verilog_top_testbench_plusarg_file_open(fp, 2, outputs_name,
+                                                outputs_name + std::string(TOP_TESTBENCH_FILE_NAME_POSTFIX),
+                                                outputs_fd_name,
+                                                std::string("w"), false);
+
+  /* Release all the I/Os until the configuration is done */
+  fp << "\t\t$timeformat(-9, 2, \"ns\", 20);\n";
+  fp << "\t\t" << stimuli_name << " = {" << vector_width << "{1'bz}};\n";
+  fp << "\t\t" << expected_name << " = {" << vector_width << "{1'bx}};\n";
+  fp << "\t\t" << cycle_name << " = 0;\n";
+  fp << "\t\twait(" << generate_verilog_port(VERILOG_PORT_CONKT, config_done_port) << ");\n";
+
+  fp << "\t\twhile (1 == $fscanf(" << stimuli_fd_name << ", \"%b\\n\", " << stimuli_name << ")) begin\n";
+  fp << "\t\t\t@(negedge " << generate_verilog_port(VERILOG_PORT_CONKT, op_clock_port) << ");\n";
+
+  fp << "\t\t\tif (0 != " << outputs_fd_name << ") begin\n";
+  fp << "\t\t\t\t$fdisplay(" << outputs_fd_name << ", \"%b\", " << observed_name << ");\n";
+  fp << "\t\t\tend\n";
+
+  /* The expected vectors are read only when the file is opened */
+  fp << "\t\t\tif (0 != " << expected_fd_name << ") begin\n";
+  fp << "\t\t\t\tif (1 == $fscanf(" << expected_fd_name << ", \"%b\\n\", " << expected_name << ")) begin\n";
+  fp << "\t\t\t\t\tfor (" << index_name << " = 0; " << index_name << " < " << vector_width << "; " << index_name << " = " << index_name << " + 1) begin\n";
+  fp << "\t\t\t\t\t\tif ((1'bx !== " << expected_name << "[" << index_name << "]) && (" << expected_name << "[" << index_name << "] !== " << observed_name << "[" << index_name << "])) begin\n";
+  fp << "\t\t\t\t\t\t\t$display(\"Mismatch on bit %0d of I/O vector %0d: expect %b, observe %b at %t\", ";
+  fp << index_name << ", " << cycle_name << ", " << expected_name << "[" << index_name << "], " << observed_name << "[" << index_name << "], $realtime);\n";
+  fp << "\t\t\t\t\t\t\t" << error_counter_name << " = " << error_counter_name << " + 1;\n";
+  fp << "\t\t\t\t\t\tend\n";
+  fp << "\t\t\t\t\tend\n";
+  fp << "\t\t\t\tend\n";
+  fp << "\t\t\tend\n";
+
+  fp << "\t\t\t" << cycle_name << " = " << cycle_name << " + 1;\n";
+  fp << "\t\tend\n";
+
+  fp << "\t\t$fclose(" << stimuli_fd_name << ");\n";
+  fp << "\t\tif (0 != " << expected_fd_name << ") $fclose(" << expected_fd_name << ");\n";
+  fp << "\t\tif (0 != " << outputs_fd_name << ") $fclose(" << outputs_fd_name << ");\n";
+
+  fp << "\t\t$display(\"Applied %0d I/O vectors\", " << cycle_name << ");\n";
+  fp << "\t\tif (" << error_counter_name << " == 0) begin\n";
+  fp << "\t\t\t$display(\"Simulation Succeed\");\n";
+  fp << "\t\tend else begin\n";
+  fp << "\t\t\t$display(\"Simulation Failed with " << std::string("%d") << " error(s)\", " << error_counter_name << ");\n";
+  fp << "\t\tend\n";
+  fp << "\t\t$finish;\n";
+  fp << "\tend\n";
+  print_verilog_comment(fp, "----- End I/O vectors loading during operating phase -----");
+
+  /* Add an empty line as splitter */
+  fp << "\n";
+}
+
+/********************************************************************
+ * The top-level function to generate a testbench whose bitstream and
+ * I/O vectors are loaded at run time from the files given by plusargs:
+ *
+ *   +bitstream=<file> +io_stimuli=<file> [+io_expected=<file>] [+io_outputs=<file>]
+ *
+ * The testbench depends only on the FPGA fabric, so that the fabric netlists
+ * and the testbench can be compiled once and simulated with many designs
+ *
+ *                  +----------+           +---------------+
+ *   bitstream ---->|   FPGA   |<--------->| I/O vectors   |
+ *                  |  Fabric  |           | and checker   |
+ *                  +----------+           +---------------+
+ *
+ * Fast configuration is not applicable as the bits to skip depend on the bitstream,
+ * so that the number of programming cycles only depends on the fabric
+ * The bitstream of current design is written to a memory file
+ * in the format to be loaded
+ *******************************************************************/
+int print_verilog_runtime_top_testbench(const ModuleManager& module_manager,
+                                        const BitstreamManager& bitstream_manager,
+                                        const FabricBitstream& fabric_bitstream,
+                                        const FabricBitstreamByAddress& fabric_bitstream_by_address,
+                                        const CircuitLibrary& circuit_lib,
+                                        const ConfigProtocol& config_protocol,
+                                        const FabricGlobalPortInfo& global_ports,
+                                        const std::string& verilog_fname,
+                                        const std::string& bitstream_memory_fname,
+                                        const SimulationSetting& simulation_parameters,
+                                        const VerilogTestbenchOption& options) {
+
+  /* The bitstream of standalone memories is not loaded by programming cycles */
+  if (CONFIG_MEM_STANDALONE == config_protocol.type()) {
+    VTR_LOG_ERROR("Unable to load bitstreams at run time for the configuration protocol '%s'!\n",
+                  CONFIG_PROTOCOL_TYPE_STRING[config_protocol.type()]);
+    return CMD_EXEC_FATAL_ERROR;
+  }
+
+  if (true == options.fast_configuration()) {
+    VTR_LOG_WARN("Fast configuration depends on bitstreams and is turned off for the testbench loading bitstreams at run time\n");
+  }
+
+  std::string module_name = generate_fpga_top_module_name() + std::string(RUNTIME_TOP_TESTBENCH_VERILOG_MODULE_POSTFIX);
+
+  std::string timer_message = std::string("Write testbench for FPGA top-level Verilog netlist loading bitstreams at run time");
+
+  /* Start time count */
+  vtr::ScopedStartFinishTimer timer(timer_message);
+
+  /* Create the file stream */
+  BufferedFileStream testbench_file(verilog_fname, options.compression());
+  std::fstream& fp = testbench_file.stream();
+
+  /* Validate the file stream */
+  check_file_stream(verilog_fname.c_str(), fp);
+
+  /* Generate a brief description on the Verilog file*/
+  std::string title = std::string("FPGA Verilog Testbench for Top-level netlist with bitstreams and I/O vectors loaded at run time");
+  print_verilog_file_header(fp, title);
+
+  /* Find the top_module */
+  ModuleId top_module = module_manager.find_module(generate_fpga_top_module_name());
+  VTR_ASSERT(true == module_manager.valid_module_id(top_module));
+
+  /* Preparation: find all the reset/set ports for programming usage */
+  std::vector<FabricGlobalPortId> global_prog_reset_ports = find_fabric_global_programming_reset_ports(global_ports);
+  std::vector<FabricGlobalPortId> global_prog_set_ports = find_fabric_global_programming_set_ports(global_ports);
+
+  /* Without fast configuration, the programming reset is preferred over the programming set,
+   * regardless of the bitstream
+   */
+  bool bit_value_to_skip = global_prog_reset_ports.empty() && !global_prog_set_ports.empty();
+
+  /* Start of testbench */
+  print_verilog_default_net_type_declaration(fp,
+                                             VERILOG_DEFAULT_NET_TYPE_NONE);
+
+  /* Print module definition */
+  fp << "module " << module_name << ";\n";
+
+  print_verilog_top_testbench_fabric_ports(fp, module_manager, top_module,
+                                           simulation_parameters, config_protocol);
+
+  size_t io_vector_width = print_verilog_runtime_top_testbench_io_ports(fp, module_manager, top_module);
+
+  /* Instantiate an integer to count the number of error and
+   * determine if the simulation succeed or failed
+   */
+  print_verilog_comment(fp, std::string("----- Error counter: Deposit an error for config_done signal is not raised at the beginning -----"));
+  fp << "\tinteger " << TOP_TESTBENCH_ERROR_COUNTER << "= 1;\n";
+
+  /* Find the clock period */
+  float prog_clock_period = (1./simulation_parameters.programming_clock_frequency());
+  float default_op_clock_period = (1./simulation_parameters.default_operating_clock_frequency());
+
+  /* Estimate the number of configuration clock cycles, which only depends on the fabric */
+  size_t num_config_clock_cycles = calculate_num_config_clock_cycles(config_protocol,
+                                                                     false,
+                                                                     bit_value_to_skip,
+                                                                     module_manager,
+                                                                     top_module,
+                                                                     bitstream_manager,
+                                                                     fabric_bitstream,
+                                                                     fabric_bitstream_by_address);
+
+  /* Generate stimuli for general control signals */
+  print_verilog_top_testbench_generic_stimulus(fp,
+                                               simulation_parameters,
+                                               num_config_clock_cycles,
+                                               prog_clock_period,
+                                               default_op_clock_period,
+                                               VERILOG_SIM_TIMESCALE);
+
+  /* Generate stimuli for programming interface */
+  print_verilog_top_testbench_configuration_protocol_stimulus(fp, 
+                                                              config_protocol.type(),
+                                                              module_manager, top_module,
+                                                              prog_clock_period,
+                                                              VERILOG_SIM_TIMESCALE);
+
+  /* Activate the programming reset if defined, otherwise the programming set */
+  bool active_global_prog_reset = !global_prog_reset_ports.empty();
+  bool active_global_prog_set = !global_prog_set_ports.empty() && (false == active_global_prog_reset);
+
+  /* Generate stimuli for global ports or connect them to existed signals
+   * No pin constraints are applied, as the global ports are not mapped to any design
+   */
+  print_verilog_top_testbench_global_ports_stimuli(fp,
+                                                   module_manager, top_module,
+                                                   PinConstraints(),
+                                                   global_ports,
+                                                   simulation_parameters,
+                                                   active_global_prog_reset,
+                                                   active_global_prog_set);
+
+  /* Instanciate FPGA top-level module */
+  print_verilog_testbench_fpga_instance(fp, module_manager, top_module,
+                                        std::string(TOP_TESTBENCH_FPGA_INSTANCE_NAME),
+                                        options.explicit_port_mapping());
+
+  /* Print tasks used for loading bitstreams */
+  print_verilog_top_testbench_load_bitstream_task(fp,
+                                                  config_protocol,
+                                                  module_manager, top_module,
+                                                  prog_clock_period,
+                                                  VERILOG_SIM_TIMESCALE);
+
+  /* load bitstream to FPGA fabric in a configuration phase */
+  print_verilog_top_testbench_bitstream(fp, config_protocol,
+                                        false,
+                                        bit_value_to_skip,
+                                        bitstream_memory_fname,
+                                        true,
+                                        module_manager, top_module,
+                                        bitstream_manager, fabric_bitstream,
+                                        fabric_bitstream_by_address);
+
+  /* Add signal initialization: 
+   * Bypass writing codes to files due to the autogenerated codes are very large.
+   * When the primitive modules of the fabric initialize their own drivers,
+   * only the primitives with user-defined netlists are initialized here
+   */
+  if ( (true == options.include_signal_init())
+    || (true == options.fabric_signal_init()) ) {
+    print_verilog_testbench_signal_initialization(fp,
+                                                  std::string(TOP_TESTBENCH_FPGA_INSTANCE_NAME),
+                                                  circuit_lib,
+                                                  module_manager,
+                                                  top_module,
+                                                  options.fabric_signal_init());
+  }
+
+  /* Apply and check the I/O vectors in operating phase */
+  print_verilog_runtime_top_testbench_io_vectors(fp, io_vector_width);
+
+  /* Add autocheck for configuration phase */
+  print_verilog_top_testbench_check(fp, 
+                                    std::string(AUTOCHECKED_SIMULATION_FLAG),
+                                    std::string(TOP_TB_CONFIG_DONE_PORT_NAME),
+                                    std::string(TOP_TESTBENCH_ERROR_COUNTER));
+
+  /* Add Icarus requirement */
+  print_verilog_preprocessing_flag(fp, std::string(ICARUS_SIMULATOR_FLAG)); 
+  print_verilog_comment(fp, std::string("----- Begin Icarus requirement -------"));
+  fp << "\tinitial begin\n";
+  fp << "\t\t$dumpfile(\"" << module_name << ".vcd\");\n";
+  fp << "\t\t$dumpvars(1, " << module_name << ");\n";
+  fp << "\tend\n";
+  print_verilog_endif(fp);
+  print_verilog_comment(fp, std::string("----- END Icarus requirement -------"));
+  fp << "\n";
+
+  /* Testbench ends*/
+  print_verilog_module_end(fp, module_name);
+
+  /* Close the file stream */
+  testbench_file.close();
+
+  VTR_LOGV(options.verbose_output(),
+           "Written %lu bytes in %.2f seconds (%.2f MB/s)\n",
+           testbench_file.num_bytes(), testbench_file.elapsed_sec(),
+           testbench_file.bytes_per_sec() / (1024. * 1024.));
+
+  return CMD_EXEC_SUCCESS;
 }
 
 } /* end namespace openfpga */
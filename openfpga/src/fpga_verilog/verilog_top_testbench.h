@@ -9,6 +9,7 @@
 #include "module_manager.h"
 #include "bitstream_manager.h"
 #include "fabric_bitstream.h"
+#include "fabric_bitstream_by_address.h"
 #include "circuit_library.h"
 #include "config_protocol.h"
 #include "vpr_context.h"
@@ -29,6 +30,7 @@ namespace openfpga {
 void print_verilog_top_testbench(const ModuleManager& module_manager,
                                  const BitstreamManager& bitstream_manager,
                                  const FabricBitstream& fabric_bitstream,
+                                 const FabricBitstreamByAddress& fabric_bitstream_by_address,
                                  const CircuitLibrary& circuit_lib,
                                  const ConfigProtocol& config_protocol,
                                  const FabricGlobalPortInfo& global_ports,
@@ -39,9 +41,22 @@ void print_verilog_top_testbench(const ModuleManager& module_manager,
                                  const VprNetlistAnnotation& netlist_annotation,
                                  const std::string& circuit_name,
                                  const std::string& verilog_fname,
+                                 const std::string& bitstream_memory_fname,
                                  const SimulationSetting& simulation_parameters,
                                  const VerilogTestbenchOption& options);
 
+int print_verilog_runtime_top_testbench(const ModuleManager& module_manager,
+                                        const BitstreamManager& bitstream_manager,
+                                        const FabricBitstream& fabric_bitstream,
+                                        const FabricBitstreamByAddress& fabric_bitstream_by_address,
+                                        const CircuitLibrary& circuit_lib,
+                                        const ConfigProtocol& config_protocol,
+                                        const FabricGlobalPortInfo& global_ports,
+                                        const std::string& verilog_fname,
+                                        const std::string& bitstream_memory_fname,
+                                        const SimulationSetting& simulation_parameters,
+                                        const VerilogTestbenchOption& options);
+
 } /* end namespace openfpga */
 
 #endif
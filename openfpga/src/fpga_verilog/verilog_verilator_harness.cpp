@@ -0,0 +1,345 @@
+/********************************************************************
+ * This file includes functions that are used to generate
+ * a testbench for the Verilator simulator, in purpose of
+ * running fast functional verification of the pre-configured FPGA fabric.
+ *
+ * Verilator compiles Verilog into a cycle-based C++ model, which
+ * does not support the event-driven constructs of the other testbenches,
+ * e.g., delays and '$deposit'. Therefore, the testbench consists of
+ * 1. a module without any delay, which instanciates both the
+ *    pre-configured FPGA fabric and the reference benchmark
+ * 2. a C++ harness which drives the clocks and random stimuli
+ *    into the module and compares the outputs at each clock edge
+ *******************************************************************/
+#include <algorithm>
+#include <fstream>
+
+/* Headers from vtrutil library */
+#include "vtr_assert.h"
+#include "vtr_log.h"
+#include "vtr_time.h"
+
+/* Headers from openfpgautil library */
+#include "openfpga_port.h"
+#include "openfpga_digest.h"
+
+#include "openfpga_atom_netlist_utils.h"
+#include "fabric_global_port_info_utils.h"
+
+#include "verilog_constants.h"
+#include "verilog_writer_utils.h"
+#include "verilog_testbench_utils.h"
+#include "verilog_verilator_harness.h"
+
+/* begin namespace openfpga */
+namespace openfpga {
+
+/********************************************************************
+ * Local variables used only in this file
+ *******************************************************************/
+constexpr char* VERILATOR_FPGA_PORT_POSTFIX = "_gfpga";
+constexpr char* VERILATOR_BENCHMARK_PORT_POSTFIX = "_bench";
+constexpr char* VERILATOR_BENCHMARK_INSTANCE_NAME = "REF_DUT";
+constexpr char* VERILATOR_FPGA_INSTANCE_NAME = "FPGA_DUT";
+/* Number of clock cycles when the reset signals are active */
+constexpr size_t VERILATOR_NUM_RESET_CLOCK_CYCLES = 2;
+
+/********************************************************************
+ * Find the names of input or output I/Os of the benchmark
+ * The block may be renamed as it contains special characters which violate Verilog syntax
+ *******************************************************************/
+static
+std::vector<std::string> find_verilator_benchmark_io_names(const AtomContext& atom_ctx,
+                                                           const VprNetlistAnnotation& netlist_annotation,
+                                                           const AtomBlockType& io_type) {
+  std::vector<std::string> io_names;
+  for (const AtomBlockId& atom_blk : atom_ctx.nlist.blocks()) {
+    if (io_type != atom_ctx.nlist.block_type(atom_blk)) {
+      continue;
+    }
+    std::string block_name = atom_ctx.nlist.block_name(atom_blk);
+    if (true == netlist_annotation.is_block_renamed(atom_blk)) {
+      block_name = netlist_annotation.block_name(atom_blk);
+    }
+    io_names.push_back(block_name);
+  }
+  return io_names;
+}
+
+/********************************************************************
+ * Print a Verilog module for Verilator, which includes all the netlists
+ * that it requires and instanciates both the pre-configured FPGA fabric
+ * and the reference benchmark:
+ *
+ *                +-------------------------------------------+
+ *                |            +------------+                 |
+ *                |     +----->| FPGA_DUT   |-----> <output>_gfpga
+ *                |     |      +------------+                 |
+ *  <inputs> ---->|-----+                                     |
+ *                |     |      +------------+                 |
+ *                |     +----->| REF_DUT    |-----> <output>_bench
+ *                |            +------------+                 |
+ *                +-------------------------------------------+
+ *
+ * The module has no delay nor initial block, which is simulated
+ * cycle by cycle by the C++ harness
+ *******************************************************************/
+void print_verilog_verilator_top_module(const std::string& src_dir,
+                                        const std::string& circuit_name,
+                                        const std::string& fabric_netlist_file,
+                                        const std::string& reference_benchmark_file,
+                                        const AtomContext& atom_ctx,
+                                        const VprNetlistAnnotation& netlist_annotation,
+                                        const bool& explicit_port_mapping) {
+  std::string verilog_fname = src_dir + circuit_name + std::string(VERILATOR_TOP_VERILOG_FILE_POSTFIX);
+  std::string module_name = circuit_name + std::string(VERILATOR_TOP_MODULE_POSTFIX);
+
+  std::string timer_message = std::string("Write Verilator top-level module for design '") + circuit_name + std::string("'");
+
+  /* Start time count */
+  vtr::ScopedStartFinishTimer timer(timer_message);
+
+  /* Create the file stream */
+  std::fstream fp;
+  fp.open(verilog_fname, std::fstream::out | std::fstream::trunc);
+
+  /* Validate the file stream */
+  check_file_stream(verilog_fname.c_str(), fp);
+
+  /* Generate a brief description on the Verilog file*/
+  std::string title = std::string("Verilator top-level module for pre-configured FPGA fabric of Design: ") + circuit_name;
+  print_verilog_file_header(fp, title);
+
+  /* Include the netlists required, without any simulation defines,
+   * which enable the event-driven constructs
+   */
+  print_verilog_comment(fp, std::string("------ Include fabric top-level netlists -----"));
+  if (true == fabric_netlist_file.empty()) {
+    print_verilog_include_netlist(fp, src_dir + std::string(FABRIC_INCLUDE_VERILOG_NETLIST_FILE_NAME));
+  } else {
+    print_verilog_include_netlist(fp, fabric_netlist_file);
+  }
+  print_verilog_include_netlist(fp, src_dir + circuit_name + std::string(FORMAL_VERIFICATION_VERILOG_FILE_POSTFIX));
+  print_verilog_comment(fp, std::string("------ Include reference benchmark netlist -----"));
+  print_verilog_include_netlist(fp, reference_benchmark_file);
+  fp << "\n";
+
+  print_verilog_default_net_type_declaration(fp,
+                                             VERILOG_DEFAULT_NET_TYPE_NONE);
+
+  std::vector<std::string> input_names = find_verilator_benchmark_io_names(atom_ctx, netlist_annotation, AtomBlockType::INPAD);
+  std::vector<std::string> output_names = find_verilator_benchmark_io_names(atom_ctx, netlist_annotation, AtomBlockType::OUTPAD);
+
+  /* Print the declaration for the module */
+  fp << "module " << module_name << "(";
+  size_t port_counter = 0;
+  for (const std::string& input_name : input_names) {
+    fp << (0 < port_counter ? ",\n\t" : "\n\t") << input_name;
+    port_counter++;
+  }
+  for (const std::string& output_name : output_names) {
+    for (const std::string& postfix : {std::string(VERILATOR_FPGA_PORT_POSTFIX), std::string(VERILATOR_BENCHMARK_PORT_POSTFIX)}) {
+      fp << (0 < port_counter ? ",\n\t" : "\n\t") << output_name << postfix;
+      port_counter++;
+    }
+  }
+  fp << ");\n";
+
+  for (const std::string& input_name : input_names) {
+    fp << "\t" << generate_verilog_port(VERILOG_PORT_INPUT, BasicPort(input_name, 1)) << ";\n";
+  }
+  for (const std::string& output_name : output_names) {
+    fp << "\t" << generate_verilog_port(VERILOG_PORT_OUTPUT, BasicPort(output_name + std::string(VERILATOR_FPGA_PORT_POSTFIX), 1)) << ";\n";
+    fp << "\t" << generate_verilog_port(VERILOG_PORT_OUTPUT, BasicPort(output_name + std::string(VERILATOR_BENCHMARK_PORT_POSTFIX), 1)) << ";\n";
+  }
+  fp << "\n";
+
+  print_verilog_comment(fp, std::string("----- FPGA fabric instanciation -------"));
+  print_verilog_testbench_benchmark_instance(fp, std::string(circuit_name + std::string(FORMAL_VERIFICATION_TOP_MODULE_POSTFIX)),
+                                             std::string(VERILATOR_FPGA_INSTANCE_NAME),
+                                             std::string(FORMAL_VERIFICATION_TOP_MODULE_PORT_POSTFIX),
+                                             std::string(FORMAL_VERIFICATION_TOP_MODULE_PORT_POSTFIX),
+                                             std::vector<std::string>(),
+                                             std::string(VERILATOR_FPGA_PORT_POSTFIX),
+                                             atom_ctx, netlist_annotation,
+                                             explicit_port_mapping);
+  fp << "\n";
+
+  /* VPR added a prefix of "out_" to the output ports of input benchmark */
+  std::vector<std::string> prefix_to_remove;
+  prefix_to_remove.push_back(std::string(VPR_BENCHMARK_OUT_PORT_PREFIX));
+  prefix_to_remove.push_back(std::string(OPENFPGA_BENCHMARK_OUT_PORT_PREFIX));
+  print_verilog_comment(fp, std::string("----- Reference Benchmark Instanication -------"));
+  print_verilog_testbench_benchmark_instance(fp, circuit_name,
+                                             std::string(VERILATOR_BENCHMARK_INSTANCE_NAME),
+                                             std::string(),
+                                             std::string(),
+                                             prefix_to_remove,
+                                             std::string(VERILATOR_BENCHMARK_PORT_POSTFIX),
+                                             atom_ctx, netlist_annotation,
+                                             explicit_port_mapping);
+  fp << "\n";
+
+  print_verilog_module_end(fp, module_name);
+
+  /* Close the file stream */
+  fp.close();
+}
+
+/********************************************************************
+ * Print a C++ harness for the Verilator model of the top-level module
+ * written by print_verilog_verilator_top_module():
+ * - the reset signals are active in the first clock cycles
+ * - the other inputs get random values at each falling edge of the clocks
+ * - the outputs of the FPGA fabric and of the reference benchmark
+ *   are compared after each clock edge
+ * The harness returns a non-zero exit code when any mismatch is found
+ *
+ * As a C++ model is evaluated without any event, a cycle costs
+ * much less than in an event-driven simulator, while the bitstream
+ * is already imposed on the configuration memories
+ * by the pre-configured FPGA fabric
+ *******************************************************************/
+void print_verilator_harness(const std::string& src_dir,
+                             const std::string& circuit_name,
+                             const AtomContext& atom_ctx,
+                             const VprNetlistAnnotation& netlist_annotation,
+                             const ModuleManager& module_manager,
+                             const FabricGlobalPortInfo& global_ports,
+                             const PinConstraints& pin_constraints,
+                             const SimulationSetting& simulation_parameters) {
+  std::string harness_fname = src_dir + circuit_name + std::string(VERILATOR_HARNESS_FILE_POSTFIX);
+  std::string module_name = circuit_name + std::string(VERILATOR_TOP_MODULE_POSTFIX);
+  /* Verilator names the C++ class after the top-level module */
+  std::string model_name = std::string("V") + module_name;
+
+  std::string timer_message = std::string("Write Verilator C++ harness for design '") + circuit_name + std::string("'");
+
+  /* Start time count */
+  vtr::ScopedStartFinishTimer timer(timer_message);
+
+  /* Create the file stream */
+  std::fstream fp;
+  fp.open(harness_fname, std::fstream::out | std::fstream::trunc);
+
+  /* Validate the file stream */
+  check_file_stream(harness_fname.c_str(), fp);
+
+  /* Classify the inputs: clocks, resets and the others driven by random stimuli */
+  std::vector<std::string> clock_port_names = find_atom_netlist_clock_port_names(atom_ctx.nlist, netlist_annotation);
+  std::vector<std::string> clock_names;
+  std::vector<std::pair<std::string, size_t>> reset_names;
+  std::vector<std::string> stimulus_names;
+  for (const std::string& input_name : find_verilator_benchmark_io_names(atom_ctx, netlist_annotation, AtomBlockType::INPAD)) {
+    if (clock_port_names.end() != std::find(clock_port_names.begin(), clock_port_names.end(), input_name)) {
+      clock_names.push_back(input_name);
+      continue;
+    }
+    if (true == port_is_fabric_global_reset_port(global_ports, module_manager, pin_constraints.net_pin(input_name))) {
+      /* The reset is active at the opposite of its default value */
+      size_t active_value = 1;
+      if (1 == global_ports.global_port_default_value(find_fabric_global_port(global_ports, module_manager, pin_constraints.net_pin(input_name)))) {
+        active_value = 0;
+      }
+      reset_names.push_back(std::make_pair(input_name, active_value));
+      continue;
+    }
+    stimulus_names.push_back(input_name);
+  }
+  std::vector<std::string> output_names = find_verilator_benchmark_io_names(atom_ctx, netlist_annotation, AtomBlockType::OUTPAD);
+
+  fp << "/*********************************************\n";
+  fp << " * Verilator C++ harness for the pre-configured FPGA fabric of Design: " << circuit_name << "\n";
+  fp << " * Generated by OpenFPGA, please do not edit\n";
+  fp << " *\n";
+  fp << " * Build and run it with, e.g.,\n";
+  fp << " *   verilator --cc --exe --build -Wno-fatal --top-module " << module_name << " \\\n";
+  fp << " *     " << src_dir << circuit_name << VERILATOR_TOP_VERILOG_FILE_POSTFIX << " \\\n";
+  fp << " *     " << harness_fname << "\n";
+  fp << " *   ./obj_dir/" << model_name << " [number of clock cycles]\n";
+  fp << " *********************************************/\n";
+  fp << "#include <cstdio>\n";
+  fp << "#include <cstdlib>\n";
+  fp << "#include <memory>\n";
+  fp << "\n";
+  fp << "#include \"verilated.h\"\n";
+  fp << "#include \"" << model_name << ".h\"\n";
+  fp << "\n";
+
+  fp << "int main(int argc, char** argv) {\n";
+  fp << "  Verilated::commandArgs(argc, argv);\n";
+  fp << "  std::unique_ptr<" << model_name << "> dut(new " << model_name << ");\n";
+  fp << "\n";
+  fp << "  unsigned long num_clock_cycles = " << simulation_parameters.num_clock_cycles() << ";\n";
+  fp << "  if (1 < argc && '+' != argv[1][0]) {\n";
+  fp << "    num_clock_cycles = std::strtoul(argv[1], nullptr, 10);\n";
+  fp << "  }\n";
+  fp << "  const unsigned long num_reset_clock_cycles = " << VERILATOR_NUM_RESET_CLOCK_CYCLES << ";\n";
+  fp << "  unsigned long num_errors = 0;\n";
+  fp << "\n";
+
+  fp << "  /* Compare the outputs of the FPGA fabric and the reference benchmark */\n";
+  fp << "  auto check_outputs = [&](const unsigned long& cycle) {\n";
+  for (const std::string& output_name : output_names) {
+    fp << "    if (dut->" << output_name << VERILATOR_FPGA_PORT_POSTFIX << " != dut->" << output_name << VERILATOR_BENCHMARK_PORT_POSTFIX << ") {\n";
+    fp << "      std::printf(\"Mismatch on output '" << output_name << "' at clock cycle %lu: expect %d, got %d\\n\",\n";
+    fp << "                  cycle, int(dut->" << output_name << VERILATOR_BENCHMARK_PORT_POSTFIX << "), int(dut->" << output_name << VERILATOR_FPGA_PORT_POSTFIX << "));\n";
+    fp << "      num_errors++;\n";
+    fp << "    }\n";
+  }
+  fp << "  };\n";
+  fp << "\n";
+
+  fp << "  /* Initialization: resets are active */\n";
+  for (const std::string& clock_name : clock_names) {
+    fp << "  dut->" << clock_name << " = 0;\n";
+  }
+  for (const auto& reset : reset_names) {
+    fp << "  dut->" << reset.first << " = " << reset.second << ";\n";
+  }
+  for (const std::string& stimulus_name : stimulus_names) {
+    fp << "  dut->" << stimulus_name << " = 0;\n";
+  }
+  fp << "  dut->eval();\n";
+  fp << "\n";
+
+  fp << "  for (unsigned long cycle = 0; cycle < num_clock_cycles; ++cycle) {\n";
+  if (false == reset_names.empty()) {
+    fp << "    /* Release the resets at a falling edge, so that they work as both synchronous and asynchronous resets */\n";
+    fp << "    if (num_reset_clock_cycles == cycle) {\n";
+    for (const auto& reset : reset_names) {
+      fp << "      dut->" << reset.first << " = " << 1 - reset.second << ";\n";
+    }
+    fp << "    }\n";
+  }
+  fp << "    /* Random stimuli at the falling edge */\n";
+  for (const std::string& stimulus_name : stimulus_names) {
+    fp << "    dut->" << stimulus_name << " = std::rand() & 1;\n";
+  }
+  for (const std::string& clock_name : clock_names) {
+    fp << "    dut->" << clock_name << " = 0;\n";
+  }
+  fp << "    dut->eval();\n";
+  fp << "    check_outputs(cycle);\n";
+  fp << "    /* Rising edge */\n";
+  for (const std::string& clock_name : clock_names) {
+    fp << "    dut->" << clock_name << " = 1;\n";
+  }
+  fp << "    dut->eval();\n";
+  fp << "    check_outputs(cycle);\n";
+  fp << "  }\n";
+  fp << "  dut->final();\n";
+  fp << "\n";
+  fp << "  if (0 < num_errors) {\n";
+  fp << "    std::printf(\"Simulation Failed with %lu error(s) in %lu clock cycles\\n\", num_errors, num_clock_cycles);\n";
+  fp << "    return 1;\n";
+  fp << "  }\n";
+  fp << "  std::printf(\"Simulation Succeed in %lu clock cycles\\n\", num_clock_cycles);\n";
+  fp << "  return 0;\n";
+  fp << "}\n";
+
+  /* Close the file stream */
+  fp.close();
+}
+
+} /* end namespace openfpga */
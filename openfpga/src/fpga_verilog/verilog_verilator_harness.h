@@ -0,0 +1,40 @@
+#ifndef VERILOG_VERILATOR_HARNESS_H
+#define VERILOG_VERILATOR_HARNESS_H
+
+/********************************************************************
+ * Include header files that are required by function declaration
+ *******************************************************************/
+#include <string>
+#include "vpr_context.h"
+#include "pin_constraints.h"
+#include "module_manager.h"
+#include "fabric_global_port_info.h"
+#include "simulation_setting.h"
+
+/********************************************************************
+ * Function declaration
+ *******************************************************************/
+
+/* begin namespace openfpga */
+namespace openfpga {
+
+void print_verilog_verilator_top_module(const std::string& src_dir,
+                                        const std::string& circuit_name,
+                                        const std::string& fabric_netlist_file,
+                                        const std::string& reference_benchmark_file,
+                                        const AtomContext& atom_ctx,
+                                        const VprNetlistAnnotation& netlist_annotation,
+                                        const bool& explicit_port_mapping);
+
+void print_verilator_harness(const std::string& src_dir,
+                             const std::string& circuit_name,
+                             const AtomContext& atom_ctx,
+                             const VprNetlistAnnotation& netlist_annotation,
+                             const ModuleManager& module_manager,
+                             const FabricGlobalPortInfo& global_ports,
+                             const PinConstraints& pin_constraints,
+                             const SimulationSetting& simulation_parameters);
+
+} /* end namespace openfpga */
+
+#endif
@@ -74,8 +74,8 @@ void print_verilog_wire_module(const ModuleManager& module_manager,
   BasicPort module_output_port = module_manager.module_port(wire_module, module_output_port_id);
 
   /* Print wire declaration for the inputs and outputs */
-  fp << generate_verilog_port(VERILOG_PORT_WIRE, module_input_port) << ";" << std::endl;
-  fp << generate_verilog_port(VERILOG_PORT_WIRE, module_output_port) << ";" << std::endl;
+  fp << generate_verilog_port(VERILOG_PORT_WIRE, module_input_port) << ";\n";
+  fp << generate_verilog_port(VERILOG_PORT_WIRE, module_output_port) << ";\n";
 
   /* Direct shortcut */
   print_verilog_wire_connection(fp, module_output_port, module_input_port, false);
@@ -87,7 +87,7 @@ void print_verilog_wire_module(const ModuleManager& module_manager,
   print_verilog_module_end(fp, circuit_lib.model_name(wire_model));
 
   /* Add an empty line as a splitter */
-  fp << std::endl;
+  fp << "\n";
 }
 
 /********************************************************************
@@ -2,6 +2,7 @@
  * Include functions for most frequently
  * used Verilog writers 
  ***********************************************/
+#include <algorithm>
 #include <chrono>
 #include <ctime>
 #include <string>
@@ -33,9 +34,9 @@ void print_verilog_default_net_type_declaration(std::fstream& fp,
                                                 const e_verilog_default_net_type& default_net_type) {
   VTR_ASSERT(true == valid_file_stream(fp));
 
-  fp << "//----- Default net type -----" << std::endl;
-  fp << "`default_nettype " << VERILOG_DEFAULT_NET_TYPE_STRING[default_net_type] << std::endl;
-  fp << std::endl;
+  fp << "//----- Default net type -----\n";
+  fp << "`default_nettype " << VERILOG_DEFAULT_NET_TYPE_STRING[default_net_type] << "\n";
+  fp << "\n";
 }
 
 /************************************************
@@ -43,22 +44,39 @@ void print_verilog_default_net_type_declaration(std::fstream& fp,
  * include the description 
  ***********************************************/
 void print_verilog_file_header(std::fstream& fp,
-                               const std::string& usage) {
+                               const std::string& usage,
+                               const bool& include_time_stamp) {
   VTR_ASSERT(true == valid_file_stream(fp));
  
-  auto end = std::chrono::system_clock::now(); 
-  std::time_t end_time = std::chrono::system_clock::to_time_t(end);
-
-  fp << "//-------------------------------------------" << std::endl;
-  fp << "//\tFPGA Synthesizable Verilog Netlist" << std::endl;
-  fp << "//\tDescription: " << usage << std::endl;
-  fp << "//\tAuthor: Xifan TANG" << std::endl;
-  fp << "//\tOrganization: University of Utah" << std::endl;
-  fp << "//\tDate: " << std::ctime(&end_time) ;
-  fp << "//-------------------------------------------" << std::endl;
-  fp << "//----- Time scale -----" << std::endl;
-  fp << "`timescale 1ns / 1ps" << std::endl;
-  fp << std::endl;
+  fp << "//-------------------------------------------\n";
+  fp << "//\tFPGA Synthesizable Verilog Netlist\n";
+  fp << "//\tDescription: " << usage << "\n";
+  fp << "//\tAuthor: Xifan TANG\n";
+  fp << "//\tOrganization: University of Utah\n";
+  /* The time stamp is skipped when the contents should be the same between runs */
+  if (true == include_time_stamp) {
+    auto end = std::chrono::system_clock::now(); 
+    std::time_t end_time = std::chrono::system_clock::to_time_t(end);
+    fp << "//\tDate: " << std::ctime(&end_time) ;
+  }
+  fp << "//-------------------------------------------\n";
+  fp << "//----- Time scale -----\n";
+  fp << "`timescale 1ns / 1ps\n";
+  fp << "\n";
+}
+
+/********************************************************************
+ * Close the file of a netlist, and report if the netlist is updated
+ * when the netlists whose contents are unchanged are kept
+ *******************************************************************/
+void close_verilog_netlist_file(BufferedFileStream& netlist_file) {
+  netlist_file.close();
+
+  if ( (FILE_UPDATE_IF_CHANGED == netlist_file.update())
+    && (true == netlist_file.file_updated()) ) {
+    VTR_LOG("Updated netlist '%s'\n",
+            netlist_file.file_name().c_str());
+  }
 }
 
 /********************************************************************
@@ -68,7 +86,7 @@ void print_verilog_include_netlist(std::fstream& fp,
                                    const std::string& netlist_name) {
   VTR_ASSERT(true == valid_file_stream(fp));
 
-  fp << "`include \"" << netlist_name << "\"" << std::endl; 
+  fp << "`include \"" << netlist_name << "\"\n"; 
 }
 
 /********************************************************************
@@ -79,7 +97,7 @@ void print_verilog_define_flag(std::fstream& fp,
                                const int& flag_value) {
   VTR_ASSERT(true == valid_file_stream(fp));
 
-  fp << "`define " << flag_name << " " << flag_value << std::endl; 
+  fp << "`define " << flag_name << " " << flag_value << "\n"; 
 }
 
 /************************************************
@@ -102,7 +120,7 @@ void print_verilog_comment(std::fstream& fp,
                            const std::string& comment) {
   VTR_ASSERT(true == valid_file_stream(fp));
 
-  fp << "// " << comment << std::endl;
+  fp << "// " << comment << "\n";
 }
 
 /************************************************
@@ -112,7 +130,7 @@ void print_verilog_preprocessing_flag(std::fstream& fp,
                                       const std::string& preproc_flag) {
   VTR_ASSERT(true == valid_file_stream(fp));
 
-  fp << "`ifdef " << preproc_flag << std::endl;
+  fp << "`ifdef " << preproc_flag << "\n";
 }
 
 /************************************************
@@ -121,7 +139,7 @@ void print_verilog_preprocessing_flag(std::fstream& fp,
 void print_verilog_endif(std::fstream& fp) {
   VTR_ASSERT(true == valid_file_stream(fp));
 
-  fp << "`endif" << std::endl;
+  fp << "`endif\n";
 }
 
 /************************************************
@@ -131,11 +149,21 @@ void print_verilog_endif(std::fstream& fp) {
  ***********************************************/
 void print_verilog_module_definition(std::fstream& fp, 
                                      const ModuleManager& module_manager, const ModuleId& module_id) {
+  print_verilog_module_definition(fp, module_manager, module_id, module_manager.module_name(module_id));
+}
+
+/************************************************
+ * Print the declaration of a module with the ports of a module
+ * in module manager but under another name, e.g., the stub of the module
+ ***********************************************/
+void print_verilog_module_definition(std::fstream& fp, 
+                                     const ModuleManager& module_manager, const ModuleId& module_id,
+                                     const std::string& module_name) {
   VTR_ASSERT(true == valid_file_stream(fp));
 
-  print_verilog_comment(fp, std::string("----- Verilog module for " + module_manager.module_name(module_id) + " -----"));
+  print_verilog_comment(fp, std::string("----- Verilog module for " + module_name + " -----"));
 
-  std::string module_head_line = "module " + module_manager.module_name(module_id) + "(";
+  std::string module_head_line = "module " + module_name + "(";
   fp << module_head_line;
 
   /* port type2type mapping */
@@ -156,7 +184,7 @@ void print_verilog_module_definition(std::fstream& fp,
     for (const auto& port : module_manager.module_ports_by_type(module_id, kv.first)) {
       if (0 != port_cnt) {
         /* Do not dump a comma for the first port */
-        fp << "," << std::endl; 
+        fp << ",\n"; 
       }
 
       if (true == printed_ifdef) {
@@ -189,7 +217,7 @@ void print_verilog_module_definition(std::fstream& fp,
       port_cnt++;
     }
   }
-  fp << ");" << std::endl;
+  fp << ");\n";
 }
 
 /************************************************
@@ -225,9 +253,9 @@ void print_verilog_module_ports(std::fstream& fp,
       }
 
       /* Print port */
-      fp << "//----- " << module_manager.module_port_type_str(kv.first)  << " -----" << std::endl; 
+      fp << "//----- " << module_manager.module_port_type_str(kv.first)  << " -----\n"; 
       fp << generate_verilog_port(kv.second, port);
-      fp << ";" << std::endl;
+      fp << ";\n";
 
       if (false == preproc_flag.empty()) {
         /* Print an endif to pair the ifdef */
@@ -238,8 +266,8 @@ void print_verilog_module_ports(std::fstream& fp,
 
   /* Output any port that is also wire connection when default net type is not wire! */
   if (VERILOG_DEFAULT_NET_TYPE_WIRE != default_net_type) {
-    fp << std::endl;
-    fp << "//----- BEGIN wire-connection ports -----" << std::endl; 
+    fp << "\n";
+    fp << "//----- BEGIN wire-connection ports -----\n"; 
     for (const auto& kv : port_type2type_map) {
       for (const auto& port : module_manager.module_ports_by_type(module_id, kv.first)) {
         /* Skip the ports that are not registered */
@@ -258,7 +286,7 @@ void print_verilog_module_ports(std::fstream& fp,
 
         /* Print port */
         fp << generate_verilog_port(VERILOG_PORT_WIRE, port);
-        fp << ";" << std::endl;
+        fp << ";\n";
 
         if (false == preproc_flag.empty()) {
           /* Print an endif to pair the ifdef */
@@ -266,13 +294,13 @@ void print_verilog_module_ports(std::fstream& fp,
         }
       }
     }
-    fp << "//----- END wire-connection ports -----" << std::endl; 
-    fp << std::endl;
+    fp << "//----- END wire-connection ports -----\n"; 
+    fp << "\n";
   }
  
   /* Output any port that is registered */
-  fp << std::endl;
-  fp << "//----- BEGIN Registered ports -----" << std::endl; 
+  fp << "\n";
+  fp << "//----- BEGIN Registered ports -----\n"; 
   for (const auto& kv : port_type2type_map) {
     for (const auto& port : module_manager.module_ports_by_type(module_id, kv.first)) {
       /* Skip the ports that are not registered */
@@ -291,7 +319,7 @@ void print_verilog_module_ports(std::fstream& fp,
 
       /* Print port */
       fp << generate_verilog_port(VERILOG_PORT_REG, port);
-      fp << ";" << std::endl;
+      fp << ";\n";
 
       if (false == preproc_flag.empty()) {
         /* Print an endif to pair the ifdef */
@@ -299,8 +327,8 @@ void print_verilog_module_ports(std::fstream& fp,
       }
     }
   }
-  fp << "//----- END Registered ports -----" << std::endl; 
-  fp << std::endl;
+  fp << "//----- END Registered ports -----\n"; 
+  fp << "\n";
 }
 
 /************************************************
@@ -363,7 +391,7 @@ void print_verilog_module_instance(std::fstream& fp,
   /* Print module name */
   fp << "\t" << module_manager.module_name(module_id) << " ";
   /* Print instance name */
-  fp << instance_name << " (" << std::endl;
+  fp << instance_name << " (\n";
   
   /* Print each port with/without explicit port map */
   /* port type2type mapping */
@@ -383,7 +411,7 @@ void print_verilog_module_instance(std::fstream& fp,
     for (const auto& port : module_manager.module_ports_by_type(module_id, kv.first)) {
       if (0 != port_cnt) {
         /* Do not dump a comma for the first port */
-        fp << "," << std::endl; 
+        fp << ",\n"; 
       }
       /* Print port */
       fp << "\t\t";
@@ -413,7 +441,7 @@ void print_verilog_module_instance(std::fstream& fp,
   }
   
   /* Print an end to the instance */
-  fp << ");" << std::endl;
+  fp << ");\n";
 }
 
 
@@ -447,9 +475,9 @@ void print_verilog_module_end(std::fstream& fp,
                               const std::string& module_name) {
   VTR_ASSERT(true == valid_file_stream(fp));
 
-  fp << "endmodule" << std::endl;
+  fp << "endmodule\n";
   print_verilog_comment(fp, std::string("----- END Verilog module for " + module_name + " -----"));
-  fp << std::endl;
+  fp << "\n";
 
   /* Reset default net type to be none */
   print_verilog_default_net_type_declaration(fp,
@@ -749,7 +777,7 @@ void print_verilog_wire_constant_values(std::fstream& fp,
   fp << "\t";
   fp << "assign ";
   fp << generate_verilog_port_constant_values(output_port, const_values);
-  fp << ";" << std::endl;
+  fp << ";\n";
 }
 
 /********************************************************************
@@ -766,7 +794,7 @@ void print_verilog_deposit_wire_constant_values(std::fstream& fp,
   fp << generate_verilog_port(VERILOG_PORT_CONKT, output_port);
   fp << ", ";
   fp << generate_verilog_constant_values(const_values);
-  fp << ");" << std::endl;
+  fp << ");\n";
 }
 
 /********************************************************************
@@ -782,7 +810,7 @@ void print_verilog_force_wire_constant_values(std::fstream& fp,
   fp << "\t";
   fp << "force ";
   fp << generate_verilog_port_constant_values(output_port, const_values);
-  fp << ";" << std::endl;
+  fp << ";\n";
 }
 
 /********************************************************************
@@ -809,7 +837,70 @@ void print_verilog_wire_connection(std::fstream& fp,
   }
 
   fp << generate_verilog_port(VERILOG_PORT_CONKT, input_port);
-  fp << ";" << std::endl;
+  fp << ";\n";
+}
+
+/********************************************************************
+ * Generate wire connections for a list of pin-to-pin connections
+ * using "assign" syntax, where each output pin is driven by the input pin
+ * at the same position of the lists.
+ * Instead of an assignment for each pin, the connections are merged:
+ * - output pins which are contiguous bits of the same port are 
+ *   assigned in one statement by a slice of the port
+ * - the input pins of the slice are combined into slices 
+ *   and a concatenation, when they are not contiguous
+ * For example,
+ *   assign out[0:3] = {in[2:3], chan[0:1]};
+ * Note that output pins should be single-bit and driven only once
+ *******************************************************************/
+void print_verilog_wire_connections(std::fstream& fp,
+                                    const std::vector<BasicPort>& output_pins,
+                                    const std::vector<BasicPort>& input_pins) {
+  /* Make sure we have a valid file handler*/
+  VTR_ASSERT(true == valid_file_stream(fp));
+  VTR_ASSERT(output_pins.size() == input_pins.size());
+
+  /* Sort the connections by output pins, so that contiguous bits are next to each other */
+  std::vector<size_t> pin_order(output_pins.size());
+  for (size_t ipin = 0; ipin < output_pins.size(); ++ipin) {
+    VTR_ASSERT(1 == output_pins[ipin].get_width());
+    VTR_ASSERT(1 == input_pins[ipin].get_width());
+    pin_order[ipin] = ipin;
+  }
+  std::stable_sort(pin_order.begin(), pin_order.end(),
+                   [&](const size_t& pin_a, const size_t& pin_b) {
+                     if (output_pins[pin_a].get_name() != output_pins[pin_b].get_name()) {
+                       return output_pins[pin_a].get_name() < output_pins[pin_b].get_name();
+                     }
+                     return output_pins[pin_a].get_lsb() < output_pins[pin_b].get_lsb();
+                   });
+
+  size_t run_begin = 0;
+  while (run_begin < pin_order.size()) {
+    /* Find the longest run of contiguous output pins */
+    BasicPort output_port(output_pins[pin_order[run_begin]]);
+    std::vector<BasicPort> run_input_pins(1, input_pins[pin_order[run_begin]]);
+    size_t run_end = run_begin + 1;
+    while (run_end < pin_order.size()) {
+      const BasicPort& next_output_pin = output_pins[pin_order[run_end]];
+      if ( (false == next_output_pin.mergeable(output_port))
+        || (output_port.get_msb() + 1 != next_output_pin.get_lsb())) {
+        break;
+      }
+      output_port.set_msb(next_output_pin.get_msb());
+      run_input_pins.push_back(input_pins[pin_order[run_end]]);
+      ++run_end;
+    }
+
+    fp << "	";
+    fp << "assign ";
+    fp << generate_verilog_port(VERILOG_PORT_CONKT, output_port);
+    fp << " = ";
+    fp << generate_verilog_ports(combine_verilog_ports(run_input_pins));
+    fp << ";\n";
+
+    run_begin = run_end;
+  }
 }
 
 /********************************************************************
@@ -835,7 +926,7 @@ void print_verilog_register_connection(std::fstream& fp,
   }
 
   fp << generate_verilog_port(VERILOG_PORT_CONKT, input_port);
-  fp << ";" << std::endl;
+  fp << ";\n";
 }
 
 
@@ -991,7 +1082,7 @@ void print_verilog_local_sram_wires(std::fstream& fp,
     /* Generate the name of local wire for the CCFF inputs, CCFF output and inverted output */
     /* [0] => CCFF input */
     BasicPort ccff_config_bus_port(generate_local_config_bus_port_name(), port_size);
-    fp << generate_verilog_port(VERILOG_PORT_WIRE, ccff_config_bus_port) << ";" << std::endl; 
+    fp << generate_verilog_port(VERILOG_PORT_WIRE, ccff_config_bus_port) << ";\n"; 
     /* Connect first CCFF to the head */
     /* Head is always a 1-bit port */
     BasicPort ccff_head_port(generate_sram_port_name(sram_orgz_type, CIRCUIT_MODEL_PORT_INPUT), 1); 
@@ -1013,7 +1104,7 @@ void print_verilog_local_sram_wires(std::fstream& fp,
     sram_ports.push_back(BasicPort(generate_sram_local_port_name(circuit_lib, sram_model, sram_orgz_type, CIRCUIT_MODEL_PORT_OUTPUT), port_size));
     /* Print local wire definition */
     for (const auto& sram_port : sram_ports) {
-      fp << generate_verilog_port(VERILOG_PORT_WIRE, sram_port) << ";" << std::endl; 
+      fp << generate_verilog_port(VERILOG_PORT_WIRE, sram_port) << ";\n"; 
     }
 
     break;
@@ -1101,10 +1192,10 @@ void print_verilog_local_config_bus(std::fstream& fp,
      */
     BasicPort config_port(generate_local_sram_port_name(prefix, instance_id, CIRCUIT_MODEL_PORT_INPUT), 
                           num_conf_bits);
-    fp << generate_verilog_port(VERILOG_PORT_WIRE, config_port) << ";" << std::endl;
+    fp << generate_verilog_port(VERILOG_PORT_WIRE, config_port) << ";\n";
     BasicPort inverted_config_port(generate_local_sram_port_name(prefix, instance_id, CIRCUIT_MODEL_PORT_OUTPUT), 
                                    num_conf_bits); 
-    fp << generate_verilog_port(VERILOG_PORT_WIRE, inverted_config_port) << ";" << std::endl;
+    fp << generate_verilog_port(VERILOG_PORT_WIRE, inverted_config_port) << ";\n";
     break;
   }
   default:
@@ -1172,26 +1263,26 @@ void print_verilog_rram_mux_config_bus(std::fstream& fp,
     /* Print configuration bus to group reserved BL/WLs */
     BasicPort reserved_bl_bus(generate_reserved_sram_port_name(CIRCUIT_MODEL_PORT_BL), 
                               num_reserved_conf_bits);
-    fp << generate_verilog_port(VERILOG_PORT_WIRE, reserved_bl_bus) << ";" << std::endl;
+    fp << generate_verilog_port(VERILOG_PORT_WIRE, reserved_bl_bus) << ";\n";
     BasicPort reserved_wl_bus(generate_reserved_sram_port_name(CIRCUIT_MODEL_PORT_WL), 
                               num_reserved_conf_bits);
-    fp << generate_verilog_port(VERILOG_PORT_WIRE, reserved_wl_bus) << ";" << std::endl;
+    fp << generate_verilog_port(VERILOG_PORT_WIRE, reserved_wl_bus) << ";\n";
 
     /* Print configuration bus to group BL/WLs */
     BasicPort bl_bus(generate_mux_config_bus_port_name(circuit_lib, mux_model, mux_size, 0, false), 
                      num_conf_bits + num_reserved_conf_bits);
-    fp << generate_verilog_port(VERILOG_PORT_WIRE, bl_bus) << ";" << std::endl;
+    fp << generate_verilog_port(VERILOG_PORT_WIRE, bl_bus) << ";\n";
     BasicPort wl_bus(generate_mux_config_bus_port_name(circuit_lib, mux_model, mux_size, 1, false), 
                      num_conf_bits + num_reserved_conf_bits);
-    fp << generate_verilog_port(VERILOG_PORT_WIRE, wl_bus) << ";" << std::endl;
+    fp << generate_verilog_port(VERILOG_PORT_WIRE, wl_bus) << ";\n";
 
     /* Print bus to group SRAM outputs, this is to interface memory cells to routing multiplexers */
     BasicPort sram_output_bus(generate_mux_sram_port_name(circuit_lib, mux_model, mux_size, mux_instance_id, CIRCUIT_MODEL_PORT_INPUT), 
                           num_conf_bits);
-    fp << generate_verilog_port(VERILOG_PORT_WIRE, sram_output_bus) << ";" << std::endl;
+    fp << generate_verilog_port(VERILOG_PORT_WIRE, sram_output_bus) << ";\n";
     BasicPort inverted_sram_output_bus(generate_mux_sram_port_name(circuit_lib, mux_model, mux_size, mux_instance_id, CIRCUIT_MODEL_PORT_OUTPUT), 
                                        num_conf_bits); 
-    fp << generate_verilog_port(VERILOG_PORT_WIRE, inverted_sram_output_bus) << ";" << std::endl;
+    fp << generate_verilog_port(VERILOG_PORT_WIRE, inverted_sram_output_bus) << ";\n";
 
     /* Get the SRAM model of the mux_model */
     std::vector<CircuitModelId> sram_models = find_circuit_sram_models(circuit_lib, mux_model);
@@ -1311,13 +1402,13 @@ void print_verilog_pulse_stimuli(std::fstream& fp,
   VTR_ASSERT(true == valid_file_stream(fp));
 
   /* Config_done signal: indicate when configuration is finished */
-  fp << "initial" << std::endl;
-  fp << "\tbegin" << std::endl;
+  fp << "initial\n";
+  fp << "\tbegin\n";
   fp << "\t";
   std::vector<size_t> initial_values(port.get_width(), initial_value);
   fp << "\t";
   fp << generate_verilog_port_constant_values(port, initial_values);
-  fp << ";" << std::endl;
+  fp << ";\n";
   
   /* if flip_value is the same as initial value, we do not need to flip the signal ! */
   if (flip_value != initial_value) {
@@ -1325,13 +1416,13 @@ void print_verilog_pulse_stimuli(std::fstream& fp,
     std::vector<size_t> port_flip_values(port.get_width(), flip_value);
     fp << "\t";
     fp << generate_verilog_port_constant_values(port, port_flip_values);
-    fp << ";" << std::endl;
+    fp << ";\n";
   }
 
-  fp << "\tend" << std::endl;
+  fp << "\tend\n";
 
   /* Print an empty line as splitter */
-  fp << std::endl;
+  fp << "\n";
 }
 
 
@@ -1354,21 +1445,21 @@ void print_verilog_shifted_clock_stimuli(std::fstream& fp,
   VTR_ASSERT(true == valid_file_stream(fp));
 
   /* Config_done signal: indicate when configuration is finished */
-  fp << "initial" << std::endl;
+  fp << "initial\n";
 
   write_tab_to_file(fp, 1);
-  fp << "begin" << std::endl;
+  fp << "begin\n";
 
   write_tab_to_file(fp, 1);
   std::vector<size_t> initial_values(port.get_width(), initial_value);
 
   write_tab_to_file(fp, 1);
   fp << generate_verilog_port_constant_values(port, initial_values);
-  fp << ";" << std::endl;
+  fp << ";\n";
 
   write_tab_to_file(fp, 2);
   fp << "#" << std::setprecision(10) << initial_delay;
-  fp << ";" << std::endl;
+  fp << ";\n";
 
   write_tab_to_file(fp, 2);
   fp << "forever "; 
@@ -1376,13 +1467,13 @@ void print_verilog_shifted_clock_stimuli(std::fstream& fp,
   fp << " = "; 
   fp << "#" << std::setprecision(10) << pulse_width;
   fp << " ~" << generate_verilog_port(VERILOG_PORT_CONKT, port);
-  fp << ";" << std::endl;
+  fp << ";\n";
   
   write_tab_to_file(fp, 1);
-  fp << "end" << std::endl;
+  fp << "end\n";
 
   /* Print an empty line as splitter */
-  fp << std::endl;
+  fp << "\n";
 }
 
 /********************************************************************
@@ -1406,17 +1497,17 @@ void print_verilog_pulse_stimuli(std::fstream& fp,
   VTR_ASSERT(true == valid_file_stream(fp));
 
   /* Config_done signal: indicate when configuration is finished */
-  fp << "initial" << std::endl;
-  fp << "\tbegin" << std::endl;
+  fp << "initial\n";
+  fp << "\tbegin\n";
   fp << "\t";
   std::vector<size_t> initial_values(port.get_width(), initial_value);
   fp << "\t";
   fp << generate_verilog_port_constant_values(port, initial_values);
-  fp << ";" << std::endl;
+  fp << ";\n";
 
   /* Set a wait condition if specified */
   if (false == wait_condition.empty()) {
-    fp << "\twait(" << wait_condition << ")" << std::endl;
+    fp << "\twait(" << wait_condition << ")\n";
   }
   
   /* Number of flip conditions and values should match */
@@ -1426,13 +1517,13 @@ void print_verilog_pulse_stimuli(std::fstream& fp,
     std::vector<size_t> port_flip_value(port.get_width(), flip_values[ipulse]);
     fp << "\t";
     fp << generate_verilog_port_constant_values(port, port_flip_value);
-    fp << ";" << std::endl;
+    fp << ";\n";
   }
 
-  fp << "\tend" << std::endl;
+  fp << "\tend\n";
 
   /* Print an empty line as splitter */
-  fp << std::endl;
+  fp << "\n";
 }
 
 /********************************************************************
@@ -1456,25 +1547,25 @@ void print_verilog_clock_stimuli(std::fstream& fp,
   VTR_ASSERT(true == valid_file_stream(fp));
 
   /* Config_done signal: indicate when configuration is finished */
-  fp << "initial" << std::endl;
-  fp << "\tbegin" << std::endl;
+  fp << "initial\n";
+  fp << "\tbegin\n";
 
   std::vector<size_t> initial_values(port.get_width(), initial_value);
   fp << "\t\t";
   fp << generate_verilog_port_constant_values(port, initial_values);
-  fp << ";" << std::endl;
+  fp << ";\n";
 
-  fp << "\tend" << std::endl;
+  fp << "\tend\n";
   fp << "always";
 
   /* Set a wait condition if specified */
   if (true == wait_condition.empty()) {
-    fp << std::endl;
+    fp << "\n";
   } else {
-    fp << " wait(" << wait_condition << ")" << std::endl;
+    fp << " wait(" << wait_condition << ")\n";
   }
 
-  fp << "\tbegin" << std::endl;
+  fp << "\tbegin\n";
   fp << "\t\t" << "#" << std::setprecision(10) << pulse_width;
 
   fp << "\t";
@@ -1482,12 +1573,12 @@ void print_verilog_clock_stimuli(std::fstream& fp,
   fp << " = ";
   fp << "~";
   fp << generate_verilog_port(VERILOG_PORT_CONKT, port);
-  fp << ";" << std::endl;
+  fp << ";\n";
 
-  fp << "\tend" << std::endl;
+  fp << "\tend\n";
 
   /* Print an empty line as splitter */
-  fp << std::endl;
+  fp << "\n";
 }
 
 /********************************************************************
@@ -1511,7 +1602,7 @@ void print_verilog_netlist_include_header_file(const std::vector<std::string>& n
 
   /* Output file names */
   for (const std::string& netlist_name : netlists_to_be_included) {
-    fp << "`include \"" << netlist_name << "\"" << std::endl;
+    fp << "`include \"" << netlist_name << "\"\n";
   }
 
   /* close file stream */
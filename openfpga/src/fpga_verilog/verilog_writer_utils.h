@@ -13,6 +13,7 @@
 #include <vector>
 #include <string>
 #include "openfpga_port.h"
+#include "openfpga_buffered_file_stream.h"
 #include "verilog_port_types.h"
 #include "circuit_library.h"
 #include "module_manager.h"
@@ -35,7 +36,10 @@ void print_verilog_default_net_type_declaration(std::fstream& fp,
                                                 const e_verilog_default_net_type& default_net_type);
 
 void print_verilog_file_header(std::fstream& fp,
-                               const std::string& usage);
+                               const std::string& usage,
+                               const bool& include_time_stamp = true);
+
+void close_verilog_netlist_file(BufferedFileStream& netlist_file);
 
 void print_verilog_include_netlist(std::fstream& fp, 
                                    const std::string& netlist_name);
@@ -58,6 +62,10 @@ void print_verilog_endif(std::fstream& fp);
 void print_verilog_module_definition(std::fstream& fp, 
                                      const ModuleManager& module_manager, const ModuleId& module_id);
 
+void print_verilog_module_definition(std::fstream& fp, 
+                                     const ModuleManager& module_manager, const ModuleId& module_id,
+                                     const std::string& module_name);
+
 void print_verilog_module_ports(std::fstream& fp, 
                                 const ModuleManager& module_manager,
                                 const ModuleId& module_id,
@@ -127,6 +135,10 @@ void print_verilog_wire_connection(std::fstream& fp,
                                    const BasicPort& input_port,
                                    const bool& inverted);
 
+void print_verilog_wire_connections(std::fstream& fp,
+                                    const std::vector<BasicPort>& output_pins,
+                                    const std::vector<BasicPort>& input_pins);
+
 void print_verilog_register_connection(std::fstream& fp,
                                        const BasicPort& output_port,
                                        const BasicPort& input_port, 
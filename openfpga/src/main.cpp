@@ -5,10 +5,14 @@
 #include "vtr_time.h"
 #include "vtr_log.h"
 
+/* Header file from libopenfpgautil library */
+#include "openfpga_parallel.h"
+
 /* Header file from libopenfpgashell library */
 #include "command_parser.h"
 #include "command_echo.h"
 #include "shell.h"
+#include "command_threads.h"
 
 /* Header file from openfpga */
 #include "vpr_command.h"
@@ -45,6 +49,22 @@ int main(int argc, char** argv) {
   openfpga::CommandOptionId opt_batch_exec = start_cmd.add_option("batch_execution", false, "Launch OpenFPGA in batch  mode when running scripts");
   start_cmd.set_option_short_name(opt_batch_exec, "batch");
 
+  /* '--concurrent_commands': execute independent read-only commands of a script on multiple threads */
+  openfpga::CommandOptionId opt_concurrent_cmds = start_cmd.add_option("concurrent_commands", false, "Specify the number of threads to execute consecutive read-only commands of scripts concurrently, e.g., the writers of SDC files. Zero means all the hardware threads");
+  start_cmd.set_option_require_value(opt_concurrent_cmds, openfpga::OPT_INT);
+
+  /* '--threads': the default number of threads of the commands running on multiple threads */
+  openfpga::CommandOptionId opt_threads = start_cmd.add_option("threads", false, "Specify the number of threads used by the commands which run on multiple threads, unless their own '--threads' option is given. Default value is 1. Use 0 to take all the hardware threads");
+  start_cmd.set_option_require_value(opt_threads, openfpga::OPT_INT);
+
+  /* '--server': launch the server mode, where scripts to run are read from a file or a named pipe */
+  openfpga::CommandOptionId opt_server_mode = start_cmd.add_option("server", false, "Launch OpenFPGA in server mode, where each line of the given file (or named pipe) is a script to run, while the fabric is kept between scripts");
+  start_cmd.set_option_require_value(opt_server_mode, openfpga::OPT_STRING);
+
+  /* '--profile': record the runtime and memory usage of each command to a CSV file */
+  openfpga::CommandOptionId opt_profile = start_cmd.add_option("profile", false, "Record the runtime and memory usage of each command to a CSV file");
+  start_cmd.set_option_require_value(opt_profile, openfpga::OPT_STRING);
+
   /* '--version', -v': print version information */
   openfpga::CommandOptionId opt_version = start_cmd.add_option("version", false, "Show OpenFPGA version");
   start_cmd.set_option_short_name(opt_version, "v");
@@ -107,10 +127,34 @@ int main(int argc, char** argv) {
       print_openfpga_version_info();
       return 0;
     }
+    /* Enable concurrent execution of commands */
+    if (true == start_cmd_context.option_enable(start_cmd, opt_concurrent_cmds)) {
+      size_t num_threads = 1;
+      if (false == openfpga::find_command_num_threads(start_cmd, start_cmd_context, opt_concurrent_cmds, num_threads)) {
+        return 1; 
+      }
+      shell.set_num_concurrent_commands(num_threads);
+    }
+
+    /* Set the default number of threads of commands */
+    if (true == start_cmd_context.option_enable(start_cmd, opt_threads)) {
+      size_t num_threads = 1;
+      if (false == openfpga::find_command_num_threads(start_cmd, start_cmd_context, opt_threads, num_threads)) {
+        return 1; 
+      }
+      openfpga::set_default_num_threads(num_threads);
+    }
+
+    /* Enable profiling */
+    if (true == start_cmd_context.option_enable(start_cmd, opt_profile)) {
+      shell.set_profile_file(start_cmd_context.option_value(start_cmd, opt_profile));
+    }
+
     /* Start a shell */ 
     if (true == start_cmd_context.option_enable(start_cmd, opt_interactive)) {
 
       shell.run_interactive_mode(openfpga_context);
+      shell.write_profile_report();
       return shell.exit_code();
     } 
 
@@ -118,6 +162,15 @@ int main(int argc, char** argv) {
       shell.run_script_mode(start_cmd_context.option_value(start_cmd, opt_script_mode).c_str(),
                             openfpga_context,
                             start_cmd_context.option_enable(start_cmd, opt_batch_exec));
+      shell.write_profile_report();
+      return shell.exit_code();
+    }
+
+    if (true == start_cmd_context.option_enable(start_cmd, opt_server_mode)) {
+      shell.run_server_mode(start_cmd_context.option_value(start_cmd, opt_server_mode).c_str(),
+                            openfpga_context,
+                            [](OpenfpgaContext& context) { context.reset_benchmark_data(); });
+      shell.write_profile_report();
       return shell.exit_code();
     }
     /* Reach here there is something wrong, show the help desk */
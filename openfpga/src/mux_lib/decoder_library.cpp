@@ -1,6 +1,8 @@
 /***************************************************************************************
  * This file includes memeber functions for data structure DecoderLibrary
  **************************************************************************************/
+#include <algorithm>
+
 #include "vtr_assert.h"
 #include "decoder_library.h"
 
@@ -14,6 +16,14 @@ DecoderLibrary::decoder_range DecoderLibrary::decoders() const {
   return vtr::make_range(decoder_ids_.begin(), decoder_ids_.end());
 }
 
+const std::vector<size_t>& DecoderLibrary::shift_registers() const {
+  return shift_register_sizes_;
+}
+
+const std::vector<size_t>& DecoderLibrary::decompressors() const {
+  return decompressor_run_length_widths_;
+}
+
 /***************************************************************************************
  * Public Accessors: Data query 
  **************************************************************************************/
@@ -76,6 +86,16 @@ DecoderId DecoderLibrary::find_decoder(const size_t& addr_size,
   return DecoderId::INVALID();
 }
 
+/* Find if a shift register with a given data size is in the library */
+bool DecoderLibrary::find_shift_register(const size_t& data_size) const {
+  return shift_register_sizes_.end() != std::find(shift_register_sizes_.begin(), shift_register_sizes_.end(), data_size);
+}
+
+/* Find if a decompressor with a given run length width is in the library */
+bool DecoderLibrary::find_decompressor(const size_t& run_length_width) const {
+  return decompressor_run_length_widths_.end() != std::find(decompressor_run_length_widths_.begin(), decompressor_run_length_widths_.end(), run_length_width);
+}
+
 /***************************************************************************************
  * Public Validators
  **************************************************************************************/
@@ -106,4 +126,16 @@ DecoderId DecoderLibrary::add_decoder(const size_t& addr_size,
   return decoder;
 }
 
+/* Add a shift register to the library */
+void DecoderLibrary::add_shift_register(const size_t& data_size) {
+  VTR_ASSERT(false == find_shift_register(data_size));
+  shift_register_sizes_.push_back(data_size);
+}
+
+/* Add a decompressor to the library */
+void DecoderLibrary::add_decompressor(const size_t& run_length_width) {
+  VTR_ASSERT(false == find_decompressor(run_length_width));
+  decompressor_run_length_widths_.push_back(run_length_width);
+}
+
 } /* End namespace openfpga*/
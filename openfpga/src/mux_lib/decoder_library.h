@@ -16,12 +16,36 @@
  *                | | | ... | | |
  *                v v v     v v v
  *                    Outputs
-
+ *
+ * The library also includes the shift registers which drive the Bit-Lines
+ * of memory banks, in place of decoders. A shift register is only described
+ * by the size of its data output, and follows the port map : 
+ *
+ *                 +-------------------+
+ *      data_in -->|  Shift register   |
+ *      clock ---->|                   |
+ *                 +-------------------+
+ *                   | |   ...     | |
+ *                   v v           v v
+ *                      Data Outputs
+ *
+ * The run-length decompressors which feed the heads of configuration chains
+ * are also included. A decompressor is only described by the width of its
+ * run length, and follows the port map :
+ *
+ *                     +----------------+
+ *      data_in ------>|                |
+ *      run_length --->|  Run-length    |---> data_out
+ *      reset -------->|  decompressor  |
+ *      clock -------->|                |
+ *                     +----------------+
  ***************************************************************************************/
 
 #ifndef DECODER_LIBRARY_H
 #define DECODER_LIBRARY_H
 
+#include <vector>
+
 #include "vtr_vector.h"
 #include "vtr_range.h"
 #include "decoder_library_fwd.h"
@@ -38,6 +62,10 @@ class DecoderLibrary {
   public: /* Public accessors: Aggregates */
     /* Get all the decoders */
     decoder_range decoders() const;
+    /* Get the data sizes of all the shift registers, in the sequence they are added */
+    const std::vector<size_t>& shift_registers() const;
+    /* Get the run length widths of all the decompressors, in the sequence they are added */
+    const std::vector<size_t>& decompressors() const;
 
   public: /* Public accessors: Data query */
     /* Get the size of address input of a decoder */
@@ -65,6 +93,10 @@ class DecoderLibrary {
                            const bool& use_enable, 
                            const bool& use_data_in, 
                            const bool& use_data_inv_port) const;
+    /* Find if a shift register with a given data size is in the library */
+    bool find_shift_register(const size_t& data_size) const;
+    /* Find if a decompressor with a given run length width is in the library */
+    bool find_decompressor(const size_t& run_length_width) const;
 
   public: /* Public validators */
     /* valid ids */
@@ -77,6 +109,14 @@ class DecoderLibrary {
                           const bool& use_enable, 
                           const bool& use_data_in, 
                           const bool& use_data_inv_port);
+    /* Add a shift register to the library,
+     * which should be used after find_shift_register() to avoid duplication 
+     */
+    void add_shift_register(const size_t& data_size);
+    /* Add a decompressor to the library,
+     * which should be used after find_decompressor() to avoid duplication 
+     */
+    void add_decompressor(const size_t& run_length_width);
     
   private: /* Internal Data */
     vtr::vector<DecoderId, DecoderId> decoder_ids_;
@@ -85,6 +125,12 @@ class DecoderLibrary {
     vtr::vector<DecoderId, bool> use_enable_;
     vtr::vector<DecoderId, bool> use_data_in_;
     vtr::vector<DecoderId, bool> use_data_inv_port_;
+
+    /* Data sizes of shift registers */
+    std::vector<size_t> shift_register_sizes_;
+
+    /* Run length widths of decompressors */
+    std::vector<size_t> decompressor_run_length_widths_;
 };
 
 } /* End namespace openfpga*/
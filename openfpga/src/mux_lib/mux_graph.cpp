@@ -5,12 +5,15 @@
 #include <cmath>
 #include <list>
 #include <map>
+#include <set>
 #include <algorithm>
 
 /* Headers from vtrutil library */
 #include "vtr_assert.h"
 #include "vtr_log.h"
 
+#include "openfpga_hot_path_counters.h"
+
 #include "mux_utils.h"
 #include "mux_graph.h"
 
@@ -236,14 +239,14 @@ size_t MuxGraph::node_index_at_level(const MuxNodeId& node) const {
 std::vector<MuxEdgeId> MuxGraph::node_in_edges(const MuxNodeId& node) const {
   /* validate the node */
   VTR_ASSERT(valid_node_id(node));
-  return node_in_edges_[node];
+  return std::vector<MuxEdgeId>(node_in_edges_[node].begin(), node_in_edges_[node].end());
 }
 
 /* Find the input nodes for a edge */
 std::vector<MuxNodeId> MuxGraph::edge_src_nodes(const MuxEdgeId& edge) const {
   /* validate the edge */
   VTR_ASSERT(valid_edge_id(edge));
-  return edge_src_nodes_[edge];
+  return std::vector<MuxNodeId>(edge_src_nodes_[edge].begin(), edge_src_nodes_[edge].end());
 }
 
 /* Find the mem that control the edge */
@@ -450,6 +453,47 @@ std::vector<MuxGraph> MuxGraph::build_mux_branch_graphs() const {
   return branch_graphs;
 } 
 
+/* Generate MUX graphs for the branches which have not been built
+ * Different from the build_mux_branch_graphs() without arguments,
+ * branches are identified by their sizes as well as their number of 
+ * memory bits, as the list may be shared by different multiplexers.
+ * The number of memory bits is found before a subgraph is extracted,
+ * so that nothing is built for the branches in the list
+ */
+std::vector<MuxGraph> MuxGraph::build_mux_branch_graphs(std::set<std::pair<size_t, size_t>>& built_branches) const {
+  std::vector<MuxGraph> branch_graphs;
+
+  /* Visit each internal nodes/output nodes and find the the number of incoming edges */
+  for (auto node : node_ids_ ) {
+    /* Bypass input nodes */
+    if ( (MUX_OUTPUT_NODE != node_types_[node]) 
+      && (MUX_INTERNAL_NODE != node_types_[node]) ) {
+      continue;
+    }
+
+    size_t branch_size = node_in_edges_[node].size();
+
+    /* make sure the branch size is valid */
+    VTR_ASSERT_SAFE(valid_mux_implementation_num_inputs(branch_size));
+
+    /* Count the memory bits in the same way as subgraph() */
+    std::set<MuxMemId> branch_mems;
+    for (auto edge : node_in_edges_[node]) {
+      branch_mems.insert(edge_mem_ids_[edge]);
+    }
+
+    /* if the branch has been built, we can skip */
+    if (false == built_branches.insert(std::make_pair(branch_size, branch_mems.size())).second) {
+      continue;
+    }
+
+    /* Generate a subgraph and push back */
+    branch_graphs.push_back(subgraph(node));
+  }
+
+  return branch_graphs;
+}
+
 /* Get the input id of a given node */
 MuxInputId MuxGraph::input_id(const MuxNodeId& node_id) const {
   /* Validate node id */
@@ -548,6 +592,8 @@ MuxNodeId MuxGraph::node_id(const size_t& node_level, const size_t& node_index_a
 /* Decode memory bits based on an input id and an output id */
 vtr::vector<MuxMemId, bool> MuxGraph::decode_memory_bits(const MuxInputId& input_id,
                                                          const MuxOutputId& output_id) const {
+  OPENFPGA_COUNT_HOT_PATH_CALL(HOT_PATH_DECODE_MEMORY_BITS);
+
   /* initialize the memory bits: TODO: support default value */ 
   vtr::vector<MuxMemId, bool> mem_bits(mem_ids_.size(), false);
 
@@ -557,6 +603,7 @@ vtr::vector<MuxMemId, bool> MuxGraph::decode_memory_bits(const MuxInputId& input
 
   /* Mark all the nodes as not visited */
   vtr::vector<MuxNodeId, bool> visited(nodes().size(), false); 
+  OPENFPGA_COUNT_HOT_PATH_BYTES(HOT_PATH_DECODE_MEMORY_BITS, (mem_ids_.size() + nodes().size() + 7) / 8);
 
   /* Create a queue for Breadth-First Search */ 
   std::list<MuxNodeId> queue; 
@@ -609,6 +656,8 @@ vtr::vector<MuxMemId, bool> MuxGraph::decode_memory_bits(const MuxInputId& input
     if (false == visited[next_node]) { 
        visited[next_node] = true; 
        queue.push_back(next_node); 
+       /* A node of the list holds two pointers besides the id */
+       OPENFPGA_COUNT_HOT_PATH_BYTES(HOT_PATH_DECODE_MEMORY_BITS, sizeof(MuxNodeId) + 2 * sizeof(void*));
     }
   }
 
@@ -5,7 +5,9 @@
  * Include header files required by the data structure definition
  *******************************************************************/
 #include <map>
+#include <set>
 #include "vtr_vector.h"
+#include "vtr_small_vector.h"
 #include "vtr_range.h"
 #include "mux_graph_fwd.h"
 #include "circuit_library.h"
@@ -111,6 +113,12 @@ class MuxGraph {
     /* Generate MUX graphs for its branches */
     MuxGraph subgraph(const MuxNodeId& node) const;
     std::vector<MuxGraph> build_mux_branch_graphs() const; 
+    /* Generate MUX graphs for the branches which are not in the given list, 
+     * where a branch is identified by its size and number of memory bits.
+     * The list is updated with the new branches, so that the branches 
+     * can be shared among the multiplexers of the same circuit model
+     */
+    std::vector<MuxGraph> build_mux_branch_graphs(std::set<std::pair<size_t, size_t>>& built_branches) const; 
     /* Get the node id of a given input */
     MuxNodeId node_id(const MuxInputId& input_id) const;
     /* Get the node id of a given output */
@@ -188,12 +196,12 @@ class MuxGraph {
     vtr::vector<MuxNodeId, MuxOutputId> node_output_ids_;                 /* Unique ids for each node as an input of the MUX */
     vtr::vector<MuxNodeId, size_t> node_levels_;                       /* at which level, each node belongs to */
     vtr::vector<MuxNodeId, size_t> node_ids_at_level_;                       /* the index at the level that each node belongs to */
-    vtr::vector<MuxNodeId, std::vector<MuxEdgeId>> node_in_edges_;       /* ids of incoming edges to each node */
-    vtr::vector<MuxNodeId, std::vector<MuxEdgeId>> node_out_edges_;      /* ids of outgoing edges from each node */
+    vtr::vector<MuxNodeId, vtr::small_vector<MuxEdgeId>> node_in_edges_;       /* ids of incoming edges to each node */
+    vtr::vector<MuxNodeId, vtr::small_vector<MuxEdgeId>> node_out_edges_;      /* ids of outgoing edges from each node */
 
     vtr::vector<MuxEdgeId, MuxEdgeId> edge_ids_;                        /* Unique ids for each edge */
-    vtr::vector<MuxEdgeId, std::vector<MuxNodeId>> edge_src_nodes_;     /* source nodes drive this edge */
-    vtr::vector<MuxEdgeId, std::vector<MuxNodeId>> edge_sink_nodes_;    /* sink nodes this edge drives */
+    vtr::vector<MuxEdgeId, vtr::small_vector<MuxNodeId>> edge_src_nodes_;     /* source nodes drive this edge */
+    vtr::vector<MuxEdgeId, vtr::small_vector<MuxNodeId>> edge_sink_nodes_;    /* sink nodes this edge drives */
     vtr::vector<MuxEdgeId, CircuitModelId> edge_models_; /* type of each edge: tgate/pass-gate */
     vtr::vector<MuxEdgeId, MuxMemId> edge_mem_ids_;                   /* ids of memory bit that control the edge */
     vtr::vector<MuxEdgeId, bool> edge_inv_mem_;                       /* if the edge is controlled by an inverted output of a memory bit */
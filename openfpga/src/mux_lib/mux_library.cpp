@@ -32,7 +32,8 @@ MuxId MuxLibrary::mux_graph(const CircuitModelId& circuit_model,
   /* Validate circuit model id and mux_size */
   VTR_ASSERT_SAFE(valid_mux_size(circuit_model, mux_size));
 
-  return mux_lookup_[circuit_model][mux_size];
+  /* Never insert to the look-up here, so that the library can be queried by multiple threads */
+  return mux_lookup_.at(circuit_model).at(mux_size);
 }
 
 const MuxGraph& MuxLibrary::mux_graph(const MuxId& mux_id) const {
@@ -56,6 +57,14 @@ size_t MuxLibrary::max_mux_size() const {
   return max_mux_size;
 }
 
+/* Get the memory bits to route an input to the output of a MUX */
+const std::vector<bool>& MuxLibrary::mux_memory_bits(const MuxId& mux_id, const MuxInputId& input_id) const {
+  VTR_ASSERT_SAFE(valid_mux_id(mux_id));
+  /* Only MUXes with a single output have the memory bits */
+  VTR_ASSERT(size_t(input_id) < mux_memory_bits_[mux_id].size());
+  return mux_memory_bits_[mux_id][size_t(input_id)];
+}
+
 /**************************************************
  * Private mutators:
  *************************************************/
@@ -75,6 +84,19 @@ void MuxLibrary::add_mux(const CircuitLibrary& circuit_lib, const CircuitModelId
   /* Recorde mux cirucit model id */
   mux_circuit_models_.push_back(circuit_model);
 
+  /* Decode the memory bits for each input, when there is only one output to route to */
+  const MuxGraph& mux_graph = mux_graphs_[mux];
+  mux_memory_bits_.emplace_back();
+  std::vector<MuxNodeId> output_nodes = mux_graph.outputs();
+  if (1 == output_nodes.size()) {
+    MuxOutputId output_id = mux_graph.output_id(output_nodes[0]);
+    mux_memory_bits_[mux].reserve(mux_graph.num_inputs());
+    for (size_t input = 0; input < mux_graph.num_inputs(); ++input) {
+      vtr::vector<MuxMemId, bool> mem_bits = mux_graph.decode_memory_bits(MuxInputId(input), output_id);
+      mux_memory_bits_[mux].emplace_back(mem_bits.begin(), mem_bits.end());
+    }
+  }
+
   /* update mux_lookup*/
   mux_lookup_[circuit_model][mux_size] = mux;
 } 
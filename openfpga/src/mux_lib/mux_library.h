@@ -32,6 +32,10 @@ class MuxLibrary {
     CircuitModelId mux_circuit_model(const MuxId& mux_id) const;
     /* Find the mux sizes */
     size_t max_mux_size() const;
+    /* Get the memory bits which route an input to the only output of a MUX,
+     * which are decoded once for all when the MUX is added
+     */
+    const std::vector<bool>& mux_memory_bits(const MuxId& mux_id, const MuxInputId& input_id) const;
   public:  /* Public mutators */
     /* Add a mux to the library */
     void add_mux(const CircuitLibrary& circuit_lib, const CircuitModelId& circuit_model, const size_t& mux_size); 
@@ -50,6 +54,11 @@ class MuxLibrary {
     vtr::vector<MuxId, MuxId> mux_ids_; /* Unique identifier for each mux graph */
     vtr::vector<MuxId, MuxGraph> mux_graphs_; /* Graphs describing MUX internal structures */
     vtr::vector<MuxId, CircuitModelId> mux_circuit_models_; /* circuit model id in circuit library */
+    /* Memory bits for each input of MUXes with a single output, in the sequence of memory ids.
+     * Routing bitstream generation looks up the bits here rather than 
+     * walking the graph for each multiplexer in the device 
+     */
+    vtr::vector<MuxId, std::vector<std::vector<bool>>> mux_memory_bits_; /* [mux_ids][input_ids][mem_ids] */
 
     /* Local encoder description */
     //vtr::vector<MuxLocalDecoderId, Decoder> mux_local_encoders_; /* Graphs describing MUX internal structures */
@@ -1,13 +1,19 @@
 /********************************************************************
  * This file includes the functions of builders for MuxLibrary.
  *******************************************************************/
+#include <algorithm>
 #include <cmath>
+#include <set>
+#include <vector>
 
 /* Headers from vtrutil library */
 #include "vtr_time.h"
 #include "vtr_assert.h"
 #include "vtr_log.h"
 
+/* Headers from openfpgautil library */
+#include "openfpga_parallel.h"
+
 /* Headers from readarchopenfpga library */
 #include "circuit_types.h"
 #include "circuit_library.h"
@@ -24,46 +30,58 @@
 /* Begin namespace openfpga */
 namespace openfpga {
 
+/* Number of rr_nodes visited by a task when collecting the multiplexers
+ * A fixed size keeps the tasks, and the order of the multiplexers,
+ * independent from the number of threads
+ */
+constexpr size_t MUX_LIBRARY_NUM_RR_NODES_PER_TASK = 65536;
+
 /********************************************************************
- * Update MuxLibrary with the unique multiplexer structures
- * found in the global routing architecture
+ * The unique multiplexers found in a range of rr_nodes,
+ * in the order they are first found
+ *******************************************************************/
+struct t_rr_node_mux_collection {
+  std::vector<std::pair<CircuitModelId, size_t>> muxes;
+  std::set<std::pair<CircuitModelId, size_t>> unique_muxes;
+  /* The first node whose driver switch has no circuit model */
+  RRNodeId invalid_node = RRNodeId::INVALID();
+  RRSwitchId invalid_switch = RRSwitchId::INVALID();
+};
+
+/********************************************************************
+ * Collect the multiplexers driving a range of rr_nodes
  *******************************************************************/
 static 
-void build_routing_arch_mux_library(const DeviceContext& vpr_device_ctx,
-                                    const CircuitLibrary& circuit_lib,
-                                    const VprDeviceAnnotation& vpr_device_annotation, 
-                                    MuxLibrary& mux_lib) {
-  /* The routing path is. 
-   * OPIN ----> CHAN ----> ... ----> CHAN ----> IPIN
-   * Each edge is a switch, for IPIN, the switch is a connection block,
-   * for the rest is a switch box
-   */
-  /* Count the sizes of muliplexers in routing architecture */  
-  for (const RRNodeId& node : vpr_device_ctx.rr_graph.nodes()) {
-    switch (vpr_device_ctx.rr_graph.node_type(node)) {
+void collect_rr_node_muxes(const RRGraph& rr_graph,
+                           const VprDeviceAnnotation& vpr_device_annotation,
+                           const std::vector<RRNodeId>& nodes,
+                           const size_t& node_begin,
+                           const size_t& node_end,
+                           t_rr_node_mux_collection& collection) {
+  for (size_t inode = node_begin; inode < node_end; ++inode) {
+    const RRNodeId& node = nodes[inode];
+    switch (rr_graph.node_type(node)) {
     case IPIN: 
     case CHANX:
     case CHANY: {
       /* Have to consider the fan_in only, it is a connection block (multiplexer)*/
-      if ( (0 == vpr_device_ctx.rr_graph.node_in_edges(node).size()) 
-        || (1 == vpr_device_ctx.rr_graph.node_in_edges(node).size()) ) { 
+      size_t mux_size = rr_graph.node_in_edges(node).size();
+      if ( (0 == mux_size) || (1 == mux_size) ) { 
         break; 
       }
       /* Find the circuit_model for multiplexers in connection blocks */
-      std::vector<RRSwitchId> driver_switches = get_rr_graph_driver_switches(vpr_device_ctx.rr_graph, node);
+      std::vector<RRSwitchId> driver_switches = get_rr_graph_driver_switches(rr_graph, node);
       VTR_ASSERT(1 == driver_switches.size());
       const CircuitModelId& rr_switch_circuit_model = vpr_device_annotation.rr_switch_circuit_model(driver_switches[0]);
       /* we should select a circuit model for the routing resource switch */
       if (CircuitModelId::INVALID() == rr_switch_circuit_model) {
-        VTR_LOG_ERROR("Unable to find the circuit mode for rr_switch '%s'!\n",
-                      vpr_device_ctx.rr_graph.get_switch(driver_switches[0]).name);
-        vpr_device_ctx.rr_graph.print_node(node);
-        exit(1);
+        collection.invalid_node = node;
+        collection.invalid_switch = driver_switches[0];
+        return;
+      }
+      if (true == collection.unique_muxes.insert(std::make_pair(rr_switch_circuit_model, mux_size)).second) {
+        collection.muxes.push_back(std::make_pair(rr_switch_circuit_model, mux_size));
       }
-     
-      VTR_ASSERT(CircuitModelId::INVALID() != rr_switch_circuit_model);
-      /* Add the mux to mux_library */
-      mux_lib.add_mux(circuit_lib, rr_switch_circuit_model, vpr_device_ctx.rr_graph.node_in_edges(node).size()); 
       break;
     }
     default:
@@ -73,6 +91,52 @@ void build_routing_arch_mux_library(const DeviceContext& vpr_device_ctx,
   }
 }
 
+/********************************************************************
+ * Update MuxLibrary with the unique multiplexer structures
+ * found in the global routing architecture
+ * The rr_nodes are visited by ranges on a number of threads, and the
+ * multiplexers of each range are added to the library in the order
+ * of the rr_nodes, as a serial visit does
+ *******************************************************************/
+static 
+void build_routing_arch_mux_library(const DeviceContext& vpr_device_ctx,
+                                    const CircuitLibrary& circuit_lib,
+                                    const VprDeviceAnnotation& vpr_device_annotation, 
+                                    const size_t& num_threads,
+                                    MuxLibrary& mux_lib) {
+  /* The routing path is. 
+   * OPIN ----> CHAN ----> ... ----> CHAN ----> IPIN
+   * Each edge is a switch, for IPIN, the switch is a connection block,
+   * for the rest is a switch box
+   */
+  const RRGraph& rr_graph = vpr_device_ctx.rr_graph;
+  std::vector<RRNodeId> nodes(rr_graph.nodes().begin(), rr_graph.nodes().end());
+
+  /* Count the sizes of muliplexers in routing architecture */  
+  size_t num_tasks = (nodes.size() + MUX_LIBRARY_NUM_RR_NODES_PER_TASK - 1) / MUX_LIBRARY_NUM_RR_NODES_PER_TASK;
+  std::vector<t_rr_node_mux_collection> collections(num_tasks);
+  parallel_for(num_tasks, num_threads,
+               [&](const size_t& itask) {
+                 collect_rr_node_muxes(rr_graph, vpr_device_annotation, nodes,
+                                       itask * MUX_LIBRARY_NUM_RR_NODES_PER_TASK,
+                                       std::min(nodes.size(), (itask + 1) * MUX_LIBRARY_NUM_RR_NODES_PER_TASK),
+                                       collections[itask]);
+               });
+
+  for (const t_rr_node_mux_collection& collection : collections) {
+    for (const auto& mux : collection.muxes) {
+      /* Add the mux to mux_library */
+      mux_lib.add_mux(circuit_lib, mux.first, mux.second); 
+    }
+    if (RRNodeId::INVALID() != collection.invalid_node) {
+      VTR_LOG_ERROR("Unable to find the circuit mode for rr_switch '%s'!\n",
+                    rr_graph.get_switch(collection.invalid_switch).name);
+      rr_graph.print_node(collection.invalid_node);
+      exit(1);
+    }
+  }
+}
+
 
 /********************************************************************
  * For a given pin of a pb_graph_node
@@ -199,7 +263,8 @@ void build_lut_mux_library(MuxLibrary& mux_lib,
  * All the statistics are stored in a linked list, as a return value
  */
 MuxLibrary build_device_mux_library(const DeviceContext& vpr_device_ctx,
-                                    const OpenfpgaContext& openfpga_ctx) {
+                                    const OpenfpgaContext& openfpga_ctx,
+                                    const size_t& num_threads) {
   vtr::ScopedStartFinishTimer timer("Build a library of physical multiplexers");
 
   /* MuxLibrary to store the information of Multiplexers*/
@@ -208,6 +273,7 @@ MuxLibrary build_device_mux_library(const DeviceContext& vpr_device_ctx,
   /* Step 1: We should check the multiplexer spice models defined in routing architecture.*/
   build_routing_arch_mux_library(vpr_device_ctx, openfpga_ctx.arch().circuit_lib, 
                                  openfpga_ctx.vpr_device_annotation(),
+                                 num_threads,
                                  mux_lib);
 
   /* Step 2: Count the sizes of multiplexers in complex logic blocks */  
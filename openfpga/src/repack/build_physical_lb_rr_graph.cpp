@@ -1,16 +1,21 @@
 /***************************************************************************************
  * This file includes functions that are used to redo packing for physical pbs
  ***************************************************************************************/
+#include <vector>
 
 /* Headers from vtrutil library */
 #include "vtr_log.h"
 #include "vtr_assert.h"
 #include "vtr_time.h"
 
+/* Headers from openfpgautil library */
+#include "openfpga_parallel.h"
+
 #include "pb_type_utils.h"
 
 #include "build_physical_lb_rr_graph.h"
 #include "check_lb_rr_graph.h"
+#include "physical_lb_rr_graph_cache.h"
 
 /* begin namespace openfpga */
 namespace openfpga {
@@ -373,43 +378,144 @@ LbRRGraph build_lb_type_physical_lb_rr_graph(t_pb_graph_node* pb_graph_head,
            "\tNumber of edges: %lu\n",
            lb_rr_graph.edges().size());
 
+  /* Group the outgoing edges by modes for routers */
+  lb_rr_graph.build_node_mode_out_edges();
+
   return lb_rr_graph;
 }
 
 /***************************************************************************************
  * This functio will create physical lb_rr_graph for each pb_graph considering physical modes only
  * the lb_rr_graph willbe added to device annotation
+ *
+ * The lb_rr_graphs depend only on the architecture, so they are not rebuilt when
+ *  - the device annotation already contains them, e.g., repack is called again in the same session
+ *  - a cache directory is provided and contains a cache matching the architecture
+ * When a cache directory is provided, the graphs being built are saved to it
+ * The graphs loaded from a cache have passed the checks when the cache was written,
+ * so that the checks are skipped.
+ *
+ * The graphs of different logical block types are built and checked on a number of threads,
+ * and added to the device annotation in the order of the logical block types
  ***************************************************************************************/
 void build_physical_lb_rr_graphs(const DeviceContext& device_ctx,
                                  VprDeviceAnnotation& device_annotation,
+                                 const std::string& cache_dir,
+                                 const size_t& num_threads,
                                  const bool& verbose) {
-  vtr::ScopedStartFinishTimer timer("Build routing resource graph for the physical implementation of logical tile");
+  /* Reuse the graphs which have been built in the current session */
+  bool all_built = true;
+  for (const t_logical_block_type& lb_type : device_ctx.logical_block_types) {
+    if ( (nullptr != lb_type.pb_graph_head)
+      && (false == device_annotation.has_physical_lb_rr_graph(lb_type.pb_graph_head)) ) {
+      all_built = false;
+      break;
+    }
+  }
+  if (true == all_built) {
+    VTR_LOG("Reuse routing resource graph for the physical implementation of logical tile\n");
+    return;
+  }
+
+  /* Try to load the graphs from the cache */
+  std::string cache_fname;
+  std::string arch_hash;
+  if (false == cache_dir.empty()) {
+    arch_hash = compute_physical_lb_rr_graph_arch_hash(device_ctx, const_cast<const VprDeviceAnnotation&>(device_annotation));
+    cache_fname = physical_lb_rr_graph_cache_file_name(cache_dir, arch_hash);
+    if (0 == read_physical_lb_rr_graph_cache(cache_fname, arch_hash, device_ctx, device_annotation, verbose)) {
+      return;
+    }
+  }
+
+  {
+    vtr::ScopedStartFinishTimer timer("Build routing resource graph for the physical implementation of logical tile");
+
+    /* The logical block types whose graphs are to be built */
+    std::vector<t_pb_graph_node*> pb_graph_heads;
+    for (const t_logical_block_type& lb_type : device_ctx.logical_block_types) {
+      /* By pass nullptr for pb_graph head */
+      if (nullptr == lb_type.pb_graph_head) {
+        continue;
+      }
+
+      /* By pass the graphs which have been built */
+      if (true == device_annotation.has_physical_lb_rr_graph(lb_type.pb_graph_head)) {
+        continue;
+      }
+      pb_graph_heads.push_back(lb_type.pb_graph_head);
+    }
+
+    std::vector<LbRRGraph> lb_rr_graphs(pb_graph_heads.size());
+    std::vector<char> lb_rr_graph_valid(pb_graph_heads.size(), false);
+    parallel_for(pb_graph_heads.size(), num_threads,
+                 [&](const size_t& igraph) {
+                   VTR_LOGV(verbose,
+                            "Building routing resource graph for logical tile '%s'...",
+                            pb_graph_heads[igraph]->pb_type->name);
+
+                   lb_rr_graphs[igraph] = build_lb_type_physical_lb_rr_graph(pb_graph_heads[igraph], const_cast<const VprDeviceAnnotation&>(device_annotation), verbose); 
+                   /* Check the rr_graph */
+                   if ( (false == lb_rr_graphs[igraph].validate())
+                     || (false == check_lb_rr_graph(lb_rr_graphs[igraph])) ) {
+                     return;
+                   }
+                   VTR_LOGV(verbose, 
+                            "Check routing resource graph for logical tile passed\n");
+                   lb_rr_graph_valid[igraph] = true;
+                 });
+
+    for (size_t igraph = 0; igraph < pb_graph_heads.size(); ++igraph) {
+      if (false == lb_rr_graph_valid[igraph]) {
+        exit(1);
+      }
+      device_annotation.add_physical_lb_rr_graph(pb_graph_heads[igraph], lb_rr_graphs[igraph]);
+    }
+
+    VTR_LOGV(verbose, "Done\n");
+  }
+
+  /* Save the graphs to the cache. A failure here is not critical */
+  if (false == cache_dir.empty()) {
+    write_physical_lb_rr_graph_cache(cache_fname, arch_hash, device_ctx, const_cast<const VprDeviceAnnotation&>(device_annotation), verbose);
+  }
+}
+
+/***************************************************************************************
+ * Build the lookahead to sinks for each physical lb_rr_graph in the device annotation
+ * The lookahead is kept in the graph, so it is built only once per logical block type
+ * and reused when repack is called again in the same session
+ ***************************************************************************************/
+void build_physical_lb_rr_graph_lookaheads(const DeviceContext& device_ctx,
+                                           VprDeviceAnnotation& device_annotation,
+                                           const bool& verbose) {
+  vtr::ScopedStartFinishTimer timer("Build lookahead of routing resource graph for logical tiles");
 
   for (const t_logical_block_type& lb_type : device_ctx.logical_block_types) {
     /* By pass nullptr for pb_graph head */
     if (nullptr == lb_type.pb_graph_head) {
       continue;
     }
-
-    VTR_LOGV(verbose,
-             "Building routing resource graph for logical tile '%s'...",
-             lb_type.pb_graph_head->pb_type->name);
-
-    const LbRRGraph& lb_rr_graph = build_lb_type_physical_lb_rr_graph(lb_type.pb_graph_head, const_cast<const VprDeviceAnnotation&>(device_annotation), verbose); 
-    /* Check the rr_graph */
-    if (false == lb_rr_graph.validate()) {
-      exit(1);
+    LbRRGraph& lb_rr_graph = device_annotation.mutable_physical_lb_rr_graph(lb_type.pb_graph_head);
+
+    /* By pass the graphs whose lookahead has been built */
+    bool lookahead_built = false;
+    for (const LbRRNodeId& node : lb_rr_graph.nodes()) {
+      if (LB_SINK == lb_rr_graph.node_type(node)) {
+        lookahead_built = lb_rr_graph.has_sink_lookahead(node);
+        break;
+      }
     }
-    if (false == check_lb_rr_graph(lb_rr_graph)) {
-      exit(1);
+    if (true == lookahead_built) {
+      continue;
     }
-    VTR_LOGV(verbose, 
-             "Check routing resource graph for logical tile passed\n");
 
-    device_annotation.add_physical_lb_rr_graph(lb_type.pb_graph_head, lb_rr_graph);
+    VTR_LOGV(verbose,
+             "Building lookahead of routing resource graph for logical tile '%s'...",
+             lb_type.pb_graph_head->pb_type->name);
+    lb_rr_graph.build_sink_lookahead();
+    VTR_LOGV(verbose, "Done\n");
   }
-
-  VTR_LOGV(verbose, "Done\n");
 }
 
 } /* end namespace openfpga */
@@ -1,6 +1,8 @@
 /******************************************************************************
  * Memember functions for data structure LbRouter
  ******************************************************************************/
+#include <cmath>
+
 #include "vtr_assert.h"
 #include "vtr_log.h"
 
@@ -15,12 +17,19 @@
 /* begin namespace openfpga */
 namespace openfpga {
 
+/* The minimum factor on the cost of a node due to its fanout (see expand_edges()),
+ * which keeps the lookahead of lb_rr_graph a lower bound of the routing cost to sinks
+ */
+constexpr float LB_ROUTER_LOOKAHEAD_FACTOR = 0.85;
+
 /**************************************************
  * Public Constructors
  *************************************************/
 LbRouter::LbRouter(const LbRRGraph& lb_rr_graph, t_logical_block_type_ptr lb_type) {
   routing_status_.resize(lb_rr_graph.nodes().size());
   explored_node_tb_.resize(lb_rr_graph.nodes().size());
+  routing_node_touched_.resize(lb_rr_graph.nodes().size(), false);
+  explored_node_touched_.resize(lb_rr_graph.nodes().size(), false);
   explore_id_index_ = 1;
 
   lb_type_ = lb_type;
@@ -30,12 +39,17 @@ LbRouter::LbRouter(const LbRRGraph& lb_rr_graph, t_logical_block_type_ptr lb_typ
   params_.pres_fac = 1;
   params_.pres_fac_mult = 2;
   params_.hist_fac = 0.3;
+  params_.use_lookahead = false;
 
   is_routed_ = false;
  
   pres_con_fac_ = 1;
 }
 
+LbRouter::~LbRouter() {
+  reset_net_rt();
+}
+
 /**************************************************
  * Public Accessors 
  *************************************************/
@@ -48,6 +62,16 @@ AtomNetId LbRouter::net_atom_net_id(const NetId& net) const {
   return lb_net_atom_net_ids_[net]; 
 }
 
+const std::vector<LbRRNodeId>& LbRouter::net_sources(const NetId& net) const {
+  VTR_ASSERT(true == valid_net_id(net));
+  return lb_net_sources_[net]; 
+}
+
+const std::vector<LbRRNodeId>& LbRouter::net_sinks(const NetId& net) const {
+  VTR_ASSERT(true == valid_net_id(net));
+  return lb_net_sinks_[net]; 
+}
+
 std::vector<LbRRNodeId> LbRouter::find_congested_rr_nodes(const LbRRGraph& lb_rr_graph) const {
   /* Validate if the rr_graph is the one we used to initialize the router */
   VTR_ASSERT(true == matched_lb_rr_graph(lb_rr_graph));
@@ -209,6 +233,10 @@ void LbRouter::set_physical_pb_modes(const LbRRGraph& lb_rr_graph,
   }
 }
 
+void LbRouter::set_lookahead(const bool& enabled) {
+  params_.use_lookahead = enabled;
+}
+
 bool LbRouter::try_route_net(const LbRRGraph& lb_rr_graph,
                              const AtomNetlist& atom_nlist,
                              const NetId& net_idx,
@@ -308,21 +336,17 @@ bool LbRouter::try_route_net(const LbRRGraph& lb_rr_graph,
       if (true == sink_routed[isink]) {
         explore_id_index_++;
         if (explore_id_index_ > 2000000000) {
-          /* overflow protection */
-          for (const LbRRNodeId& id : lb_rr_graph.nodes()) {
+          /* overflow protection: untouched nodes are already OPEN */
+          for (const LbRRNodeId& id : touched_explored_nodes_) {
             explored_node_tb_[id].explored_id = OPEN;
             explored_node_tb_[id].enqueue_id = OPEN;
-            explore_id_index_ = 1;
           }
+          explore_id_index_ = 1;
         }
       } else {
         /* Route failed, reset the explore id index */
         reset_explored_node_tb();
-        for (const LbRRNodeId& id : lb_rr_graph.nodes()) {
-          explored_node_tb_[id].explored_id = OPEN;
-          explored_node_tb_[id].enqueue_id = OPEN;
-          explore_id_index_ = 1;
-        }
+        explore_id_index_ = 1;
       }
     }
 
@@ -445,6 +469,19 @@ bool LbRouter::try_route(const LbRRGraph& lb_rr_graph,
   return is_routed_;
 }
 
+void LbRouter::reset() {
+  clear_nets();
+  reset_explored_node_tb();
+  reset_routing_status();
+  reset_illegal_modes();
+  pq_.clear();
+
+  explore_id_index_ = 1;
+  is_routed_ = false;
+  mode_status_ = t_mode_selection_status();
+  pres_con_fac_ = 1;
+}
+
 /**************************************************
  * Private mutators
  *************************************************/
@@ -486,8 +523,9 @@ void LbRouter::fix_duplicate_equivalent_pins(const AtomContext& atom_ctx,
             size_t(ilb_net), size_t(lb_net_atom_net_ids_[ilb_net]), atom_ctx.nlist.net_name(lb_net_atom_net_ids_[ilb_net]).c_str(),
             kv.first, size_t(pin_index));
 
-        VTR_ASSERT(1 == lb_rr_graph.node_out_edges(pin_index, &(pb_graph_pin->parent_node->pb_type->modes[0])).size());
-        LbRRNodeId sink_index = lb_rr_graph.edge_sink_node(lb_rr_graph.node_out_edges(pin_index, &(pb_graph_pin->parent_node->pb_type->modes[0]))[0]);
+        LbRRGraph::node_edge_range pin_out_edges = lb_rr_graph.node_out_edges(pin_index, &(pb_graph_pin->parent_node->pb_type->modes[0]));
+        VTR_ASSERT(1 == pin_out_edges.size());
+        LbRRNodeId sink_index = lb_rr_graph.edge_sink_node(*pin_out_edges.begin());
         VTR_ASSERT(LB_SINK == lb_rr_graph.node_type(sink_index));
         VTR_ASSERT_MSG(sink_index == lb_net_sinks_[ilb_net][iterm], "Remapped pin must be connected to original sink");
 
@@ -563,6 +601,8 @@ void LbRouter::commit_remove_rt(const LbRRGraph& lb_rr_graph,
 
   LbRRNodeId inode = rt->current_node;
 
+  touch_routing_status(inode);
+
   /* Determine if node is being used or removed */
   if (op == RT_COMMIT) {
     incr = 1;
@@ -676,6 +716,7 @@ void LbRouter::expand_rt_rec(t_trace* rt,
   enode.node_index = rt->current_node;
   enode.prev_index = prev_index;
   pq_.push(enode);
+  touch_explored_node(enode.node_index);
   explored_node_tb_[enode.node_index].inet = irt_net;
   explored_node_tb_[enode.node_index].explored_id = OPEN;
   explored_node_tb_[enode.node_index].enqueue_id = explore_id_index;
@@ -698,6 +739,7 @@ void LbRouter::expand_rt(const NetId& inet,
 void LbRouter::expand_edges(const LbRRGraph& lb_rr_graph,
                             t_mode* mode,
                             const LbRRNodeId& cur_inode,
+                            const LbRRNodeId& target_node,
                             float cur_cost,
                             int net_fanout) {
   /* Validate if the rr_graph is the one we used to initialize the router */
@@ -746,6 +788,14 @@ void LbRouter::expand_edges(const LbRRGraph& lb_rr_graph,
     incr_cost *= fanout_factor;
     enode.cost = cur_cost + incr_cost;
 
+    /* Estimate the cost to the target. Nodes which cannot reach the target are not queued */
+    if (true == params_.use_lookahead) {
+      enode.lookahead_cost = LB_ROUTER_LOOKAHEAD_FACTOR * lb_rr_graph.node_sink_lookahead(enode.node_index, target_node);
+      if (true == std::isinf(enode.lookahead_cost)) {
+        continue;
+      }
+    }
+
     /* Add to queue if cost is lower than lowest cost path to this enode */
     if (explored_node_tb_[enode.node_index].enqueue_id == explore_id_index_) {
       if (enode.cost < explored_node_tb_[enode.node_index].enqueue_cost) {
@@ -758,6 +808,7 @@ void LbRouter::expand_edges(const LbRRGraph& lb_rr_graph,
          */
       }
     } else {
+      touch_explored_node(enode.node_index);
       explored_node_tb_[enode.node_index].enqueue_id = explore_id_index_;
       explored_node_tb_[enode.node_index].enqueue_cost = enode.cost;
       pq_.push(enode);
@@ -773,6 +824,7 @@ void LbRouter::expand_edges(const LbRRGraph& lb_rr_graph,
 
 void LbRouter::expand_node(const LbRRGraph& lb_rr_graph,
                            const t_expansion_node& exp_node,
+                           const LbRRNodeId& target_node,
                            const int& net_fanout) {
   /* Validate if the rr_graph is the one we used to initialize the router */
   VTR_ASSERT(true == matched_lb_rr_graph(lb_rr_graph));
@@ -800,11 +852,12 @@ void LbRouter::expand_node(const LbRRGraph& lb_rr_graph,
              mode->name);
   }
    */
-  expand_edges(lb_rr_graph, mode, cur_node, cur_cost, net_fanout);
+  expand_edges(lb_rr_graph, mode, cur_node, target_node, cur_cost, net_fanout);
 }
 
 void LbRouter::expand_node_all_modes(const LbRRGraph& lb_rr_graph,
                                      const t_expansion_node& exp_node,
+                                     const LbRRNodeId& target_node,
                                      const int& net_fanout) {
   /* Validate if the rr_graph is the one we used to initialize the router */
   VTR_ASSERT(true == matched_lb_rr_graph(lb_rr_graph));
@@ -839,7 +892,7 @@ void LbRouter::expand_node_all_modes(const LbRRGraph& lb_rr_graph,
     if (is_illegal == true) {
       continue;
     }
-    expand_edges(lb_rr_graph, mode, cur_inode, cur_cost, net_fanout);
+    expand_edges(lb_rr_graph, mode, cur_inode, target_node, cur_cost, net_fanout);
   }
 }
 
@@ -884,13 +937,14 @@ bool LbRouter::try_expand_nodes(const AtomNetlist& atom_nlist,
          * If the node is popped a second time, then the path to that node is higher 
          * than this path so ignore.
          */
+        touch_explored_node(exp_inode);
         explored_node_tb_[exp_inode].explored_id = explore_id_index_;
         explored_node_tb_[exp_inode].prev_index = exp_node.prev_index;
         if (exp_inode != lb_net_sinks_[lb_net][itarget]) {
           if (!try_other_modes) {
-            expand_node(lb_rr_graph, exp_node, lb_net_sinks_[lb_net].size());
+            expand_node(lb_rr_graph, exp_node, lb_net_sinks_[lb_net][itarget], lb_net_sinks_[lb_net].size());
           } else {
-            expand_node_all_modes(lb_rr_graph, exp_node, lb_net_sinks_[lb_net].size());
+            expand_node_all_modes(lb_rr_graph, exp_node, lb_net_sinks_[lb_net][itarget], lb_net_sinks_[lb_net].size());
           }
         }
       }
@@ -981,14 +1035,32 @@ bool LbRouter::check_net(const LbRRGraph& lb_rr_graph,
 /**************************************************
  * Private Initializer and cleaner
  *************************************************/
+void LbRouter::touch_explored_node(const LbRRNodeId& node) {
+  if (false == explored_node_touched_[node]) {
+    explored_node_touched_[node] = true;
+    touched_explored_nodes_.push_back(node);
+  }
+}
+
+void LbRouter::touch_routing_status(const LbRRNodeId& node) {
+  if (false == routing_node_touched_[node]) {
+    routing_node_touched_[node] = true;
+    touched_routing_nodes_.push_back(node);
+  }
+}
+
 void LbRouter::reset_explored_node_tb() {
-  for (t_explored_node_stats& explored_node : explored_node_tb_) {
+  /* Untouched nodes still have the default stats */
+  for (const LbRRNodeId& node : touched_explored_nodes_) {
+    t_explored_node_stats& explored_node = explored_node_tb_[node];
     explored_node.prev_index = LbRRNodeId::INVALID();
     explored_node.explored_id = OPEN;
     explored_node.inet = NetId::INVALID();
     explored_node.enqueue_id = OPEN;
     explored_node.enqueue_cost = 0;
+    explored_node_touched_[node] = false;
   }
+  touched_explored_nodes_.clear();
 }
 
 void LbRouter::reset_net_rt() {
@@ -1001,10 +1073,13 @@ void LbRouter::reset_net_rt() {
 }
 
 void LbRouter::reset_routing_status() {
-  for (t_routing_status& status : routing_status_) {
-    status.historical_usage = 0;
-    status.occ = 0;
+  /* Modes are not touched here, as they are only set by set_physical_pb_modes() */
+  for (const LbRRNodeId& node : touched_routing_nodes_) {
+    routing_status_[node].historical_usage = 0;
+    routing_status_[node].occ = 0;
+    routing_node_touched_[node] = false;
   }
+  touched_routing_nodes_.clear();
 }
 
 void LbRouter::clear_nets() {
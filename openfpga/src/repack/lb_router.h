@@ -54,6 +54,10 @@ namespace openfpga {
  *  // This is a must-do before running the router in the purpose of repacking!!!
  *  lb_router.set_physical_pb_modes(lb_rr_graph, device_annotation); 
  *
+ *  // Optionally, guide the expansion toward sinks by the lookahead of the lb_rr_graph
+ *  // which should be built by LbRRGraph::build_sink_lookahead()
+ *  lb_router.set_lookahead(true); 
+ *
  *  // Run the router 
  *  bool route_success = lb_router.try_route(lb_rr_graph, atom_ctx.nlist, verbose);
  *
@@ -66,6 +70,10 @@ namespace openfpga {
  *  // Here is an example to check which nodes are mapped to the 'net' created before
  *  std::vector<LbRRNodeId> routed_nodes = lb_router.net_routed_nodes(net);
  *
+ *  // Reuse the router for another logic block on the same lb_rr_graph
+ *  // The nets are removed while the physical modes are kept
+ *  lb_router.reset();
+ *
  *******************************************************************/
 
 
@@ -113,6 +121,8 @@ class LbRouter {
       float pres_fac;
       float pres_fac_mult;
       float hist_fac;
+      /* Use the lookahead of lb_rr_graph as an A* estimation of the cost to sinks */
+      bool use_lookahead;
     };
 
     /**************************************************************************
@@ -122,11 +132,13 @@ class LbRouter {
       LbRRNodeId node_index; /* Index of logic cluster_ctx.blocks rr node this expansion node represents */
       LbRRNodeId prev_index; /* Index of logic cluster_ctx.blocks rr node that drives this expansion node */
       float cost;
+      float lookahead_cost; /* Estimated cost from this expansion node to the sink */ 
     
       t_expansion_node() {
         node_index = LbRRNodeId::INVALID();
         prev_index = LbRRNodeId::INVALID();
         cost = 0;
+        lookahead_cost = 0;
       }
     };
 
@@ -134,7 +146,7 @@ class LbRouter {
       public:
         /* Returns true if t1 is earlier than t2 */
         bool operator()(t_expansion_node& e1, t_expansion_node& e2) {
-          if (e1.cost > e2.cost) {
+          if (e1.cost + e1.lookahead_cost > e2.cost + e2.lookahead_cost) {
             return true;
           }
           return false;
@@ -208,6 +220,10 @@ class LbRouter {
 
   public :  /* Public constructors */
     LbRouter(const LbRRGraph& lb_rr_graph, t_logical_block_type_ptr lb_type);
+    ~LbRouter();
+    /* The route trees are owned by the router, which should not be copied */
+    LbRouter(const LbRouter&) = delete;
+    LbRouter& operator=(const LbRouter&) = delete;
   
   public :  /* Public accessors */
     /* Return the ids for all the nets to be routed */ 
@@ -216,6 +232,10 @@ class LbRouter {
     /* Return the atom net id for a net to be routed */
     AtomNetId net_atom_net_id(const NetId& net) const;    
 
+    /* Return the source and sink nodes of a net to be routed */
+    const std::vector<LbRRNodeId>& net_sources(const NetId& net) const;
+    const std::vector<LbRRNodeId>& net_sinks(const NetId& net) const;
+
     /**
      * Find all the routing resource nodes that are over-used, which they are used more than their capacity
      * This function is call to collect the nodes and router can reroute these net
@@ -250,6 +270,12 @@ class LbRouter {
     void set_physical_pb_modes(const LbRRGraph& lb_rr_graph,
                                const VprDeviceAnnotation& device_annotation);
 
+    /* Enable/disable the lookahead to sinks when expanding nodes
+     * The lookahead is taken from the lb_rr_graph to be routed,
+     * so it is effective only when the lb_rr_graph has a lookahead to the sinks
+     */
+    void set_lookahead(const bool& enabled);
+
     /**
      * Perform routing algorithm on a given logical tile routing resource graph
      * Note: the lb_rr_graph must be the same as you initilized the router!!!
@@ -258,6 +284,14 @@ class LbRouter {
                    const AtomNetlist& atom_nlist,
                    const bool& verbosity);
 
+    /**
+     * Remove all the nets and routing results, so that the router can be
+     * reused on the same logical tile routing resource graph.
+     * The modes set by set_physical_pb_modes() are kept.
+     * Only the nodes touched by the previous routing are visited
+     */
+    void reset();
+
   private :  /* Private accessors */
     /**
      * Report if the routing is successfully done on a logical block routing resource graph
@@ -306,13 +340,16 @@ class LbRouter {
     void expand_edges(const LbRRGraph& lb_rr_graph,
                       t_mode* mode,
                       const LbRRNodeId& cur_inode,
+                      const LbRRNodeId& target_node,
                       float cur_cost,
                       int net_fanout);
     void expand_node(const LbRRGraph& lb_rr_graph,
                      const t_expansion_node& exp_node,
+                     const LbRRNodeId& target_node,
                      const int& net_fanout);
     void expand_node_all_modes(const LbRRGraph& lb_rr_graph,
                                const t_expansion_node& exp_node,
+                               const LbRRNodeId& target_node,
                                const int& net_fanout);
     bool try_expand_nodes(const AtomNetlist& atom_nlist,
                           const LbRRGraph& lb_rr_graph,
@@ -347,6 +384,10 @@ class LbRouter {
                    const NetId& net) const;
 
   private :  /* Private initializer and cleaner */
+    /* Record the nodes whose stats are changed, so that they can be reset later */
+    void touch_explored_node(const LbRRNodeId& node);
+    void touch_routing_status(const LbRRNodeId& node);
+
     void reset_explored_node_tb();
     void reset_net_rt();
     void reset_routing_status();
@@ -385,6 +426,14 @@ class LbRouter {
     /* Stores state info during Pathfinder iterative routing */
     vtr::vector<LbRRNodeId, t_explored_node_stats> explored_node_tb_; /* [0..lb_type_graph->size()-1] Stores mode exploration and traceback info for nodes */
 
+    /* Nodes whose routing status and explored stats have been changed since last reset
+     * Resetting only these nodes avoids walking through the whole lb_rr_graph for each net
+     */
+    std::vector<LbRRNodeId> touched_routing_nodes_;
+    vtr::vector<LbRRNodeId, bool> routing_node_touched_;
+    std::vector<LbRRNodeId> touched_explored_nodes_;
+    vtr::vector<LbRRNodeId, bool> explored_node_touched_;
+
     int explore_id_index_;                 /* used in conjunction with node_traceback to determine whether or not a location has been explored.  By using a unique identifier every route, I don't have to clear the previous route exploration */
 
     /* Current type */
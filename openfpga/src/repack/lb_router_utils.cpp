@@ -74,9 +74,26 @@ void save_lb_router_results_to_physical_pb(PhysicalPb& phy_pb,
                                            const LbRouter& lb_router,
                                            const LbRRGraph& lb_rr_graph) {
   /* Get mapping routing nodes per net */
+  std::vector<std::vector<LbRRNodeId>> net_routed_nodes;
+  net_routed_nodes.reserve(lb_router.nets().size());
   for (const LbRouter::NetId& net : lb_router.nets()) {
-    std::vector<LbRRNodeId> routed_nodes = lb_router.net_routed_nodes(net);
-    for (const LbRRNodeId& node : routed_nodes) {
+    net_routed_nodes.push_back(lb_router.net_routed_nodes(net));
+  }
+  save_lb_routed_nodes_to_physical_pb(phy_pb, lb_router, net_routed_nodes, lb_rr_graph);
+}
+
+/***************************************************************************************
+ * Save the routing nodes of each net of a logical block router to physical pb,
+ * where the nodes may come from the routing results of another clustered block 
+ * whose nets have the same sources and sinks 
+ ***************************************************************************************/
+void save_lb_routed_nodes_to_physical_pb(PhysicalPb& phy_pb,
+                                         const LbRouter& lb_router,
+                                         const std::vector<std::vector<LbRRNodeId>>& net_routed_nodes,
+                                         const LbRRGraph& lb_rr_graph) {
+  VTR_ASSERT(net_routed_nodes.size() == lb_router.nets().size());
+  for (const LbRouter::NetId& net : lb_router.nets()) {
+    for (const LbRRNodeId& node : net_routed_nodes[size_t(net)]) {
       t_pb_graph_pin* pb_graph_pin = lb_rr_graph.node_pb_graph_pin(node);
       if (nullptr == pb_graph_pin) {
         continue;
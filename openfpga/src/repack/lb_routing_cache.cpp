@@ -0,0 +1,99 @@
+/***************************************************************************************
+ * Member functions for class LbRoutingCache
+ ***************************************************************************************/
+/* Headers from vtrutil library */
+#include "vtr_assert.h"
+#include "vtr_hash.h"
+
+#include "lb_routing_cache.h"
+
+/* begin namespace openfpga */
+namespace openfpga {
+
+/***************************************************************************************
+ * Public accessors
+ ***************************************************************************************/
+size_t LbRoutingCache::num_lookups() const {
+  std::lock_guard<std::mutex> lock(mutex_);
+  return num_lookups_;
+}
+
+size_t LbRoutingCache::num_hits() const {
+  std::lock_guard<std::mutex> lock(mutex_);
+  return num_hits_;
+}
+
+/***************************************************************************************
+ * Public mutators
+ ***************************************************************************************/
+bool LbRoutingCache::find(t_logical_block_type_ptr lb_type,
+                          const LbRouter& lb_router,
+                          std::vector<std::vector<LbRRNodeId>>& net_routed_nodes) {
+  t_key key = build_key(lb_type, lb_router);
+
+  std::lock_guard<std::mutex> lock(mutex_);
+  ++num_lookups_;
+  auto result = net_routed_nodes_.find(key);
+  if (result == net_routed_nodes_.end()) {
+    return false;
+  }
+  ++num_hits_;
+  net_routed_nodes = result->second;
+  return true;
+}
+
+void LbRoutingCache::add(t_logical_block_type_ptr lb_type,
+                         const LbRouter& lb_router) {
+  VTR_ASSERT(true == lb_router.is_routed());
+  t_key key = build_key(lb_type, lb_router);
+
+  std::vector<std::vector<LbRRNodeId>> net_routed_nodes;
+  net_routed_nodes.reserve(key.net_sources.size());
+  for (const LbRouter::NetId& net : lb_router.nets()) {
+    net_routed_nodes.push_back(lb_router.net_routed_nodes(net));
+  }
+
+  /* Another thread may have added the same routing in the meantime, which is kept */
+  std::lock_guard<std::mutex> lock(mutex_);
+  net_routed_nodes_.emplace(std::move(key), std::move(net_routed_nodes));
+}
+
+/***************************************************************************************
+ * Internal functions
+ ***************************************************************************************/
+LbRoutingCache::t_key LbRoutingCache::build_key(t_logical_block_type_ptr lb_type,
+                                                const LbRouter& lb_router) const {
+  t_key key;
+  key.lb_type = lb_type;
+  for (const LbRouter::NetId& net : lb_router.nets()) {
+    key.net_sources.push_back(lb_router.net_sources(net));
+    key.net_sinks.push_back(lb_router.net_sinks(net));
+  }
+  return key;
+}
+
+bool LbRoutingCache::t_key::operator==(const t_key& other) const {
+  return (lb_type == other.lb_type)
+      && (net_sources == other.net_sources)
+      && (net_sinks == other.net_sinks);
+}
+
+size_t LbRoutingCache::t_key_hash::operator()(const t_key& key) const {
+  size_t hash = 0;
+  vtr::hash_combine(hash, key.lb_type);
+  VTR_ASSERT(key.net_sources.size() == key.net_sinks.size());
+  for (size_t inet = 0; inet < key.net_sources.size(); ++inet) {
+    for (const LbRRNodeId& node : key.net_sources[inet]) {
+      vtr::hash_combine(hash, node);
+    }
+    /* Separate the sources from the sinks, so that a node cannot move between them */
+    vtr::hash_combine(hash, LbRRNodeId::INVALID());
+    for (const LbRRNodeId& node : key.net_sinks[inet]) {
+      vtr::hash_combine(hash, node);
+    }
+    vtr::hash_combine(hash, LbRRNodeId::INVALID());
+  }
+  return hash;
+}
+
+} /* end namespace openfpga */
@@ -0,0 +1,82 @@
+#ifndef LB_ROUTING_CACHE_H
+#define LB_ROUTING_CACHE_H
+
+/********************************************************************
+ * Include header files that are required by data structure declaration
+ *******************************************************************/
+#include <mutex>
+#include <unordered_map>
+#include <vector>
+
+#include "physical_types.h"
+#include "lb_rr_graph.h"
+#include "lb_router.h"
+
+/* begin namespace openfpga */
+namespace openfpga {
+
+/********************************************************************
+ * A cache of the routing results of clustered blocks during repacking
+ *
+ * Many clustered blocks of a design, e.g., the slices of a datapath, 
+ * have the same nets to route inside the logical block,
+ * i.e., the same sources and sinks on the physical lb_rr_graph,
+ * while only the atom nets mapped to them differ.
+ * As the router only sees the sources and sinks of each net, 
+ * it finds the same routing for these blocks.
+ * Therefore, the routing nodes of each net are stored by
+ * - the logical block type
+ * - the source and sink nodes of each net, in the order nets are added to the router
+ * and reused by the other blocks, where the atom nets are taken 
+ * from their own router
+ *
+ * The cache can be shared by multiple threads
+ *
+ * How to use the cache:
+ *
+ *  // Add nets to be routed to a router
+ *  std::vector<std::vector<LbRRNodeId>> net_routed_nodes;
+ *  if (false == lb_routing_cache.find(lb_type, lb_router, net_routed_nodes)) {
+ *    lb_router.try_route(lb_rr_graph, atom_ctx.nlist, verbose);
+ *    lb_routing_cache.add(lb_type, lb_router);
+ *  }
+ *
+ *******************************************************************/
+class LbRoutingCache {
+  public: /* Public accessors */
+    size_t num_lookups() const;
+    size_t num_hits() const;
+  public: /* Public mutators */
+    /* Find the routing nodes of each net of a router which is not routed yet. 
+     * Return false if not found
+     */ 
+    bool find(t_logical_block_type_ptr lb_type,
+              const LbRouter& lb_router,
+              std::vector<std::vector<LbRRNodeId>>& net_routed_nodes);
+    /* Add the routing results of a router which is successfully routed */
+    void add(t_logical_block_type_ptr lb_type,
+             const LbRouter& lb_router);
+  private: /* Internal data types */
+    struct t_key {
+      t_logical_block_type_ptr lb_type;
+      /* Sources and sinks of each net */
+      std::vector<std::vector<LbRRNodeId>> net_sources;
+      std::vector<std::vector<LbRRNodeId>> net_sinks;
+      bool operator==(const t_key& other) const;
+    };
+    struct t_key_hash {
+      size_t operator()(const t_key& key) const;
+    };
+  private: /* Internal functions */
+    t_key build_key(t_logical_block_type_ptr lb_type,
+                    const LbRouter& lb_router) const;
+  private: /* Internal data */
+    std::unordered_map<t_key, std::vector<std::vector<LbRRNodeId>>, t_key_hash> net_routed_nodes_;
+    size_t num_lookups_ = 0;
+    size_t num_hits_ = 0;
+    mutable std::mutex mutex_;
+};
+
+} /* end namespace openfpga */
+
+#endif
@@ -2,8 +2,14 @@
  * Member Functions of LbRRGraph
  * include mutators, accessors and utility functions 
  ***********************************************************************/
+#include <functional>
+#include <limits>
+#include <queue>
+
 #include "vtr_assert.h"
 #include "vtr_log.h"
+#include "openfpga_memory_usage.h"
+#include "openfpga_hot_path_counters.h"
 #include "lb_rr_graph.h"
 
 /* begin namespace openfpga */
@@ -69,34 +75,40 @@ std::vector<LbRREdgeId> LbRRGraph::node_in_edges(const LbRRNodeId& node, t_mode*
   return in_edges;
 }
 
-std::vector<LbRREdgeId> LbRRGraph::node_out_edges(const LbRRNodeId& node) const {
+LbRRGraph::node_edge_range LbRRGraph::node_out_edges(const LbRRNodeId& node) const {
   VTR_ASSERT(true == valid_node_id(node));
-  return node_out_edges_[node];
+  OPENFPGA_COUNT_HOT_PATH_CALL(HOT_PATH_LB_NODE_OUT_EDGES);
+  return vtr::make_range(node_out_edges_[node].begin(), node_out_edges_[node].end());
 }
 
-std::vector<LbRREdgeId> LbRRGraph::node_out_edges(const LbRRNodeId& node, t_mode* mode) const {
-  std::vector<LbRREdgeId> out_edges;
-
+LbRRGraph::node_edge_range LbRRGraph::node_out_edges(const LbRRNodeId& node, t_mode* mode) const {
   VTR_ASSERT(true == valid_node_id(node));
-  for (const LbRREdgeId& edge : node_out_edges_[node]) {
-    if (mode == edge_mode(edge)) {
-      out_edges.push_back(edge);
+  VTR_ASSERT_SAFE(true == valid_node_mode_out_edges());
+  OPENFPGA_COUNT_HOT_PATH_CALL(HOT_PATH_LB_NODE_OUT_EDGES);
+
+  /* A node has only a few modes, so a linear search is fast enough */
+  for (size_t imode = node_mode_offsets_[size_t(node)]; imode < node_mode_offsets_[size_t(node) + 1]; ++imode) {
+    if (mode == mode_out_edge_modes_[imode]) {
+      OPENFPGA_COUNT_HOT_PATH_HIT(HOT_PATH_LB_NODE_OUT_EDGES);
+      return vtr::make_range(mode_out_edges_.begin() + mode_out_edge_offsets_[imode],
+                             mode_out_edges_.begin() + mode_out_edge_offsets_[imode + 1]);
     }
   }
 
-  return out_edges;
+  return vtr::make_range(mode_out_edges_.end(), mode_out_edges_.end());
 }
 
 LbRRNodeId LbRRGraph::find_node(const e_lb_rr_type& type, const t_pb_graph_pin* pb_graph_pin) const {
-  if (size_t(type) >= node_lookup_.size()) {
+  if ( (size_t(type) >= node_lookup_.size())
+    || (nullptr == pb_graph_pin) ) {
     return LbRRNodeId::INVALID();
   }
 
-  if (0 == node_lookup_[size_t(type)].count(pb_graph_pin)) {
+  if (size_t(pb_graph_pin->pin_count_in_cluster) >= node_lookup_[size_t(type)].size()) {
     return LbRRNodeId::INVALID();
   }
   
-  return node_lookup_[size_t(type)].at(pb_graph_pin);
+  return node_lookup_[size_t(type)][pb_graph_pin->pin_count_in_cluster];
 }
 
 LbRRNodeId LbRRGraph::ext_source_node() const {
@@ -137,6 +149,41 @@ t_mode* LbRRGraph::edge_mode(const LbRREdgeId& edge) const {
   return edge_modes_[edge];
 }
 
+bool LbRRGraph::has_sink_lookahead(const LbRRNodeId& sink) const {
+  return (size_t(sink) < sink_lookahead_rows_.size())
+      && (size_t(-1) != sink_lookahead_rows_[sink]);
+}
+
+float LbRRGraph::node_sink_lookahead(const LbRRNodeId& node, const LbRRNodeId& sink) const {
+  VTR_ASSERT_SAFE(true == valid_node_id(node));
+  if (false == has_sink_lookahead(sink)) {
+    return 0.;
+  }
+  return sink_lookaheads_[sink_lookahead_rows_[sink] * node_ids_.size() + size_t(node)];
+}
+
+size_t LbRRGraph::memory_usage() const {
+  return openfpga::memory_usage(node_ids_)
+       + openfpga::memory_usage(node_types_)
+       + openfpga::memory_usage(node_capacities_)
+       + openfpga::memory_usage(node_pb_graph_pins_)
+       + openfpga::memory_usage(node_intrinsic_costs_)
+       + openfpga::memory_usage(node_in_edges_)
+       + openfpga::memory_usage(node_out_edges_)
+       + openfpga::memory_usage(edge_ids_)
+       + openfpga::memory_usage(edge_src_nodes_)
+       + openfpga::memory_usage(edge_sink_nodes_)
+       + openfpga::memory_usage(edge_intrinsic_costs_)
+       + openfpga::memory_usage(edge_modes_)
+       + openfpga::memory_usage(node_mode_offsets_)
+       + openfpga::memory_usage(mode_out_edge_modes_)
+       + openfpga::memory_usage(mode_out_edge_offsets_)
+       + openfpga::memory_usage(mode_out_edges_)
+       + openfpga::memory_usage(sink_lookahead_rows_)
+       + openfpga::memory_usage(sink_lookaheads_)
+       + openfpga::memory_usage(node_lookup_);
+}
+
 /******************************************************************************
  * Public Mutators
  ******************************************************************************/
@@ -174,6 +221,11 @@ LbRRNodeId LbRRGraph::create_node(const e_lb_rr_type& type) {
   node_in_edges_.emplace_back();
   node_out_edges_.emplace_back();
 
+  /* Outgoing edges grouped by modes and lookahead are out-of-date */
+  node_mode_offsets_.clear();
+  sink_lookahead_rows_.clear();
+  sink_lookaheads_.clear();
+
   return node;
 }
 
@@ -206,17 +258,27 @@ void LbRRGraph::set_node_pb_graph_pin(const LbRRNodeId& node, t_pb_graph_pin* pb
   node_pb_graph_pins_[node] = pb_graph_pin;
 
   /* Register in fast node look-up */
+  if (nullptr == pb_graph_pin) {
+    return;
+  }
+
   if (node_type(node) >= node_lookup_.size()) {
     node_lookup_.resize(node_type(node) + 1);
   }
 
-  if (0 < node_lookup_[node_type(node)].count(pb_graph_pin)) {
+  std::vector<LbRRNodeId>& pin_lookup = node_lookup_[node_type(node)];
+  size_t pin_id = pb_graph_pin->pin_count_in_cluster;
+  if (pin_id >= pin_lookup.size()) {
+    pin_lookup.resize(pin_id + 1, LbRRNodeId::INVALID());
+  }
+
+  if (true == valid_node_id(pin_lookup[pin_id])) {
     VTR_LOG_WARN("Detect pb_graph_pin '%s[%lu]' is mapped to LbRRGraph nodes (exist: %lu) and (to be mapped: %lu). Overwrite is done\n",
                  pb_graph_pin->port->name, pb_graph_pin->pin_number,
-                 size_t(node_lookup_[node_type(node)].at(pb_graph_pin)),
+                 size_t(pin_lookup[pin_id]),
                  size_t(node));
   }
-  node_lookup_[node_type(node)][pb_graph_pin] = node;
+  pin_lookup[pin_id] = node;
 }
 
 void LbRRGraph::set_node_intrinsic_cost(const LbRRNodeId& node, const float& cost) {
@@ -243,6 +305,11 @@ LbRREdgeId LbRRGraph::create_edge(const LbRRNodeId& source,
   node_out_edges_[source].push_back(edge);
   node_in_edges_[sink].push_back(edge);
 
+  /* Outgoing edges grouped by modes and lookahead are out-of-date */
+  node_mode_offsets_.clear();
+  sink_lookahead_rows_.clear();
+  sink_lookaheads_.clear();
+
   return edge;
 }
 
@@ -251,6 +318,87 @@ void LbRRGraph::set_edge_intrinsic_cost(const LbRREdgeId& edge, const float& cos
   edge_intrinsic_costs_[edge] = cost;
 }
 
+void LbRRGraph::build_node_mode_out_edges() {
+  node_mode_offsets_.clear();
+  mode_out_edge_modes_.clear();
+  mode_out_edge_offsets_.clear();
+  mode_out_edges_.clear();
+
+  node_mode_offsets_.reserve(node_ids_.size() + 1);
+  mode_out_edges_.reserve(edge_ids_.size());
+
+  for (const LbRRNodeId& node : nodes()) {
+    node_mode_offsets_.push_back(mode_out_edge_modes_.size());
+    /* Modes are ordered by their first appearance in the outgoing edges */
+    for (const LbRREdgeId& edge : node_out_edges_[node]) {
+      t_mode* mode = edge_modes_[edge];
+      bool mode_exist = false;
+      for (size_t imode = node_mode_offsets_.back(); imode < mode_out_edge_modes_.size(); ++imode) {
+        if (mode == mode_out_edge_modes_[imode]) {
+          mode_exist = true;
+          break;
+        }
+      }
+      if (true == mode_exist) {
+        continue;
+      }
+      mode_out_edge_modes_.push_back(mode);
+      mode_out_edge_offsets_.push_back(mode_out_edges_.size());
+      for (const LbRREdgeId& mode_edge : node_out_edges_[node]) {
+        if (mode == edge_modes_[mode_edge]) {
+          mode_out_edges_.push_back(mode_edge);
+        }
+      }
+    }
+  }
+  node_mode_offsets_.push_back(mode_out_edge_modes_.size());
+  mode_out_edge_offsets_.push_back(mode_out_edges_.size());
+
+  VTR_ASSERT(true == valid_node_mode_out_edges());
+}
+
+void LbRRGraph::build_sink_lookahead() {
+  size_t num_nodes = node_ids_.size();
+  sink_lookahead_rows_.assign(num_nodes, size_t(-1));
+  sink_lookaheads_.clear();
+
+  size_t num_sinks = 0;
+  for (const LbRRNodeId& node : nodes()) {
+    if (LB_SINK == node_types_[node]) {
+      sink_lookahead_rows_[node] = num_sinks;
+      ++num_sinks;
+    }
+  }
+  sink_lookaheads_.resize(num_sinks * num_nodes, std::numeric_limits<float>::infinity());
+
+  /* Run a Dijkstra search backward from each sink */
+  typedef std::pair<float, LbRRNodeId> t_lookahead_node;
+  std::priority_queue<t_lookahead_node, std::vector<t_lookahead_node>, std::greater<t_lookahead_node>> pq;
+  for (const LbRRNodeId& sink : nodes()) {
+    if (false == has_sink_lookahead(sink)) {
+      continue;
+    }
+    float* lookaheads = sink_lookaheads_.data() + sink_lookahead_rows_[sink] * num_nodes;
+    lookaheads[size_t(sink)] = 0.;
+    pq.push(std::make_pair(0., sink));
+    while (false == pq.empty()) {
+      t_lookahead_node cur = pq.top();
+      pq.pop();
+      if (cur.first > lookaheads[size_t(cur.second)]) {
+        continue;
+      }
+      for (const LbRREdgeId& edge : node_in_edges_[cur.second]) {
+        LbRRNodeId src_node = edge_src_nodes_[edge];
+        float cost = cur.first + edge_intrinsic_costs_[edge] + node_intrinsic_costs_[cur.second];
+        if (cost < lookaheads[size_t(src_node)]) {
+          lookaheads[size_t(src_node)] = cost;
+          pq.push(std::make_pair(cost, src_node));
+        }
+      }
+    }
+  }
+}
+
 /******************************************************************************
  * Public validators/invalidators
  ******************************************************************************/
@@ -282,6 +430,12 @@ bool LbRRGraph::validate() const {
     num_err++;
   }
 
+  /* Outgoing edges grouped by modes are required by routers */
+  if (false == valid_node_mode_out_edges()) {
+    VTR_LOG_WARN("Outgoing edges grouped by modes are not built or out-of-date!\n");
+    num_err++;
+  }
+
   /* Error out if there is any fatal errors found */
   if (0 < num_err) {
     VTR_LOG_ERROR("Logical tile Routing Resource graph is not valid due to %d fatal errors !\n",
@@ -295,6 +449,11 @@ bool LbRRGraph::empty() const {
   return (0 == nodes().size()) && (0 == edges().size());
 }
 
+bool LbRRGraph::valid_node_mode_out_edges() const {
+  return (node_ids_.size() + 1 == node_mode_offsets_.size())
+      && (edge_ids_.size() == mode_out_edges_.size());
+}
+
 /******************************************************************************
  * Private validators/invalidators
  ******************************************************************************/
@@ -42,6 +42,12 @@
  *     for (const RREdgeId& out_edge_id : rr_graph.node_out_edges(node_id)) {
  *       // Do something with out_edge
  *     }
+ *     // Access the fan-out edges from a given node which belong to a mode
+ *     // The edges are picked from a table built by build_node_mode_out_edges(), 
+ *     // so that no list is created when expanding a node in routers
+ *     for (const RREdgeId& out_edge_id : rr_graph.node_out_edges(node_id, mode)) {
+ *       // Do something with out_edge
+ *     }
  *     // If you only want to learn the number of fan-out edges
  *     size_t num_out_edges = rr_graph.node_fan_out(node_id);
  *
@@ -65,6 +71,7 @@
  * Example: 
  *    RRGraph lb_rr_graph;
  *    ... // Building RRGraph
+ *    lb_rr_graph.build_node_mode_out_edges(); 
  *    lb_rr_graph.validate(); 
  *
  * Optionally, we strongly recommend developers to run an advance check in check_rr_graph()  
@@ -163,10 +170,13 @@ class LbRRGraph {
     /* Iterators used to create iterator-based loop for nodes/edges/switches/segments */
     typedef vtr::vector<LbRRNodeId, LbRRNodeId>::const_iterator node_iterator;
     typedef vtr::vector<LbRREdgeId, LbRREdgeId>::const_iterator edge_iterator;
+    /* Iterator on the edge list of a node */
+    typedef std::vector<LbRREdgeId>::const_iterator node_edge_iterator;
 
     /* Ranges used to create range-based loop for nodes/edges/switches/segments */
     typedef vtr::Range<node_iterator> node_range;
     typedef vtr::Range<edge_iterator> edge_range;
+    typedef vtr::Range<node_edge_iterator> node_edge_range;
 
   public: /* Constructors */
     LbRRGraph();
@@ -202,8 +212,11 @@ class LbRRGraph {
     std::vector<LbRREdgeId> node_in_edges(const LbRRNodeId& node, t_mode* mode) const;
 
     /* Get a list of edge ids, which are outgoing edges from a node */
-    std::vector<LbRREdgeId> node_out_edges(const LbRRNodeId& node) const;
-    std::vector<LbRREdgeId> node_out_edges(const LbRRNodeId& node, t_mode* mode) const;
+    node_edge_range node_out_edges(const LbRRNodeId& node) const;
+    /* Get the outgoing edges from a node which belong to a mode
+     * This requires build_node_mode_out_edges() to be called after all the edges are created
+     */
+    node_edge_range node_out_edges(const LbRRNodeId& node, t_mode* mode) const;
 
     /* General method to look up a node with type and only pb_graph_pin information */
     LbRRNodeId find_node(const e_lb_rr_type& type, const t_pb_graph_pin* pb_graph_pin) const;
@@ -221,6 +234,19 @@ class LbRRGraph {
     float edge_intrinsic_cost(const LbRREdgeId& edge) const;
     t_mode* edge_mode(const LbRREdgeId& edge) const;
 
+    /* Lookahead from a node to a sink node, built by build_sink_lookahead().
+     * This is the minimum sum of the intrinsic costs of the edges 
+     * and the nodes (excluding the starting node) along any path in any mode,
+     * which is a lower bound of the routing cost to the sink.
+     * Return 0 when the lookahead is not available for the sink,
+     * and infinity when the sink cannot be reached from the node
+     */
+    bool has_sink_lookahead(const LbRRNodeId& sink) const;
+    float node_sink_lookahead(const LbRRNodeId& node, const LbRRNodeId& sink) const;
+
+    /* Estimate the heap memory (in bytes) held by the graph */
+    size_t memory_usage() const;
+
   public: /* Mutators */
     /* Reserve the lists of nodes, edges, switches etc. to be memory efficient. 
      * This function is mainly used to reserve memory space inside RRGraph,
@@ -266,6 +292,17 @@ class LbRRGraph {
     LbRREdgeId create_edge(const LbRRNodeId& source, const LbRRNodeId& sink, t_mode* mode);
     void set_edge_intrinsic_cost(const LbRREdgeId& edge, const float& cost);
 
+    /* Group the outgoing edges of each node by modes, 
+     * which is required by node_out_edges(node, mode)
+     * Call it again after creating any node or edge
+     */
+    void build_node_mode_out_edges();
+
+    /* Compute the lookahead from all the nodes to each LB_SINK node
+     * Call it again after creating any node or edge, or changing any cost
+     */
+    void build_sink_lookahead();
+
   public: /* Public validators */
     /* Validate is the node id does exist in the RRGraph */
     bool valid_node_id(const LbRRNodeId& node) const;
@@ -277,6 +314,9 @@ class LbRRGraph {
 
     bool empty() const;
 
+    /* Validate if the outgoing edges grouped by modes are up-to-date */
+    bool valid_node_mode_out_edges() const;
+
   private: /* Private Validators */
     bool validate_node_sizes() const;
     bool validate_edge_sizes() const;
@@ -315,11 +355,27 @@ class LbRRGraph {
     vtr::vector<LbRREdgeId, float> edge_intrinsic_costs_;
     vtr::vector<LbRREdgeId, t_mode*> edge_modes_;
 
-    /* Fast look-up to search a node by its type, coordinator and ptc_num 
-     * Indexing of fast look-up: [0..NUM_TYPES-1][t_pb_graph_pin*] 
+    /* Outgoing edges grouped by nodes and then by modes, in a compressed layout
+     * The modes of a node are [node_mode_offsets_[node], node_mode_offsets_[node + 1])
+     * in mode_out_edge_modes_, and the edges of a mode (in the same order as node_out_edges_)
+     * are [mode_out_edge_offsets_[imode], mode_out_edge_offsets_[imode + 1]) in mode_out_edges_
+     */
+    std::vector<size_t> node_mode_offsets_;
+    std::vector<t_mode*> mode_out_edge_modes_;
+    std::vector<size_t> mode_out_edge_offsets_;
+    std::vector<LbRREdgeId> mode_out_edges_;
+
+    /* Lookahead to sink nodes: the row of a sink node is sink_lookahead_rows_[sink],
+     * and the lookahead of a node in a row is sink_lookaheads_[row * num_nodes + node]
+     */
+    vtr::vector<LbRRNodeId, size_t> sink_lookahead_rows_;
+    std::vector<float> sink_lookaheads_;
+
+    /* Fast look-up to search a node by its type and pb_graph_pin
+     * Indexing of fast look-up: [0..NUM_TYPES-1][pin_count_in_cluster] 
      */
-    typedef std::vector<std::map<const t_pb_graph_pin*, LbRRNodeId>> NodeLookup;
-    mutable NodeLookup node_lookup_;
+    typedef std::vector<std::vector<LbRRNodeId>> NodeLookup;
+    NodeLookup node_lookup_;
 
     /* Special node look-up */
     LbRRNodeId ext_source_node_;
@@ -0,0 +1,532 @@
+/***************************************************************************************
+ * This file includes functions to save the physical lb_rr_graphs to a binary cache file
+ * and to load them back, so that the graphs are built only once per architecture
+ *
+ * The graphs depend only on the pb_graphs and their physical modes, so the cache is
+ * keyed by a hash of these structures. Pointers to pb_graph_pins and modes are stored
+ * as indices which are deterministic for a given architecture:
+ *   - a pb_graph_pin is stored as its pin_count_in_cluster
+ *   - a mode is stored as its position in a depth-first walk through the pb_type tree
+ *
+ * Layout of the cache, which is written by the binary archives of openfpga_binary_io.h
+ *   - magic:                string "OFPGALBR"
+ *   - version:              uint32
+ *   - architecture hash:    string, the hex digits of a SHA-256 digest
+ *   - number of graphs:     uint32
+ *   - for each graph:
+ *     - logical block type: uint32, index in the logical block types of the device
+ *     - number of nodes:    uint32
+ *     - ext source node:    uint32
+ *     - ext sink node:      uint32
+ *     - nodes:              type (uint8), capacity (int16), pb_graph_pin (uint32),
+ *                           intrinsic cost (float32)
+ *     - number of edges:    uint32
+ *     - edges:              source node (uint32), sink node (uint32), mode (uint32),
+ *                           intrinsic cost (float32)
+ *   Integers are in the byte order of the machine, and a string is stored as
+ *   its length (uint64) followed by its characters
+ *   Invalid ids and null pointers are stored as the maximum value of uint32
+ ***************************************************************************************/
+#include <cstdio>
+#include <fstream>
+#include <random>
+#include <sstream>
+#include <unordered_map>
+
+/* Headers from vtrutil library */
+#include "vtr_log.h"
+#include "vtr_assert.h"
+#include "vtr_time.h"
+
+/* Headers from openfpgautil library */
+#include "openfpga_digest.h"
+#include "openfpga_binary_io.h"
+
+#include "pb_type_utils.h"
+
+#include "physical_lb_rr_graph_cache.h"
+
+/* begin namespace openfpga */
+namespace openfpga {
+
+constexpr char PHYSICAL_LB_RR_GRAPH_CACHE_MAGIC[] = "OFPGALBR";
+constexpr uint32_t PHYSICAL_LB_RR_GRAPH_CACHE_VERSION = 2;
+constexpr uint32_t PHYSICAL_LB_RR_GRAPH_CACHE_INVALID_ID = UINT32_MAX;
+
+/***************************************************************************************
+ * Assign an index to each mode of a pb_type tree by a depth-first walk
+ ***************************************************************************************/
+static
+void rec_collect_pb_type_modes(t_pb_type* pb_type,
+                               std::vector<t_mode*>& modes) {
+  for (int imode = 0; imode < pb_type->num_modes; ++imode) {
+    t_mode* mode = &(pb_type->modes[imode]);
+    modes.push_back(mode);
+    for (int ichild = 0; ichild < mode->num_pb_type_children; ++ichild) {
+      rec_collect_pb_type_modes(&(mode->pb_type_children[ichild]), modes);
+    }
+  }
+}
+
+/***************************************************************************************
+ * Index all the pb_graph_pins of a pb_graph by their pin_count_in_cluster
+ ***************************************************************************************/
+static
+void collect_pb_graph_node_pins(t_pb_graph_pin** pins, const int& num_ports, const int* num_pins,
+                                std::vector<t_pb_graph_pin*>& pb_graph_pins) {
+  for (int iport = 0; iport < num_ports; ++iport) {
+    for (int ipin = 0; ipin < num_pins[iport]; ++ipin) {
+      t_pb_graph_pin* pb_graph_pin = &(pins[iport][ipin]);
+      VTR_ASSERT((size_t)pb_graph_pin->pin_count_in_cluster < pb_graph_pins.size());
+      pb_graph_pins[pb_graph_pin->pin_count_in_cluster] = pb_graph_pin;
+    }
+  }
+}
+
+static
+void rec_collect_pb_graph_pins(t_pb_graph_node* pb_graph_node,
+                               std::vector<t_pb_graph_pin*>& pb_graph_pins) {
+  collect_pb_graph_node_pins(pb_graph_node->input_pins, pb_graph_node->num_input_ports, pb_graph_node->num_input_pins, pb_graph_pins);
+  collect_pb_graph_node_pins(pb_graph_node->output_pins, pb_graph_node->num_output_ports, pb_graph_node->num_output_pins, pb_graph_pins);
+  collect_pb_graph_node_pins(pb_graph_node->clock_pins, pb_graph_node->num_clock_ports, pb_graph_node->num_clock_pins, pb_graph_pins);
+
+  t_pb_type* pb_type = pb_graph_node->pb_type;
+  for (int imode = 0; imode < pb_type->num_modes; ++imode) {
+    for (int ichild = 0; ichild < pb_type->modes[imode].num_pb_type_children; ++ichild) {
+      for (int ipb = 0; ipb < pb_type->modes[imode].pb_type_children[ichild].num_pb; ++ipb) {
+        rec_collect_pb_graph_pins(&(pb_graph_node->child_pb_graph_nodes[imode][ichild][ipb]), pb_graph_pins);
+      }
+    }
+  }
+}
+
+/***************************************************************************************
+ * The look-ups between the pointers of a logical block type and the indices in cache
+ ***************************************************************************************/
+struct t_lb_rr_graph_cache_lookup {
+  std::vector<t_mode*> modes;
+  std::unordered_map<const t_mode*, uint32_t> mode_indices;
+  std::vector<t_pb_graph_pin*> pb_graph_pins;
+};
+
+static
+t_lb_rr_graph_cache_lookup build_lb_rr_graph_cache_lookup(t_pb_graph_node* pb_graph_head) {
+  t_lb_rr_graph_cache_lookup lookup;
+
+  rec_collect_pb_type_modes(pb_graph_head->pb_type, lookup.modes);
+  for (size_t imode = 0; imode < lookup.modes.size(); ++imode) {
+    lookup.mode_indices[lookup.modes[imode]] = imode;
+  }
+
+  lookup.pb_graph_pins.resize(pb_graph_head->total_pb_pins, nullptr);
+  rec_collect_pb_graph_pins(pb_graph_head, lookup.pb_graph_pins);
+
+  return lookup;
+}
+
+/***************************************************************************************
+ * Add the pb_graph_pins of a pb_graph_node and their fan-outs to the data to hash
+ ***************************************************************************************/
+static
+void hash_pb_graph_node_pins(BinaryWriter& hasher,
+                             t_pb_graph_pin** pins, const int& num_ports, const int* num_pins,
+                             const t_lb_rr_graph_cache_lookup& lookup) {
+  hasher(num_ports);
+  for (int iport = 0; iport < num_ports; ++iport) {
+    hasher(num_pins[iport]);
+    for (int ipin = 0; ipin < num_pins[iport]; ++ipin) {
+      const t_pb_graph_pin* pb_graph_pin = &(pins[iport][ipin]);
+      hasher(pb_graph_pin->pin_count_in_cluster,
+             pb_graph_pin->port->equivalent,
+             pb_graph_pin->num_output_edges);
+      for (int iedge = 0; iedge < pb_graph_pin->num_output_edges; ++iedge) {
+        const t_pb_graph_edge* pb_graph_edge = pb_graph_pin->output_edges[iedge];
+        auto mode_result = lookup.mode_indices.find(pb_graph_edge->interconnect->parent_mode);
+        if (mode_result == lookup.mode_indices.end()) {
+          hasher(PHYSICAL_LB_RR_GRAPH_CACHE_INVALID_ID);
+        } else {
+          hasher(mode_result->second);
+        }
+        hasher(pb_graph_edge->num_output_pins);
+        for (int iout = 0; iout < pb_graph_edge->num_output_pins; ++iout) {
+          hasher(pb_graph_edge->output_pins[iout]->pin_count_in_cluster);
+        }
+      }
+    }
+  }
+}
+
+/***************************************************************************************
+ * Add the pb_graph under the physical modes, which is what a physical lb_rr_graph
+ * is built on, to the data to hash
+ ***************************************************************************************/
+static
+void rec_hash_physical_pb_graph_node(BinaryWriter& hasher,
+                                     t_pb_graph_node* pb_graph_node,
+                                     const VprDeviceAnnotation& device_annotation,
+                                     const t_lb_rr_graph_cache_lookup& lookup) {
+  t_pb_type* pb_type = pb_graph_node->pb_type;
+  hasher(std::string(pb_type->name),
+         pb_graph_node->placement_index,
+         is_primitive_pb_type(pb_type));
+
+  hash_pb_graph_node_pins(hasher, pb_graph_node->input_pins, pb_graph_node->num_input_ports, pb_graph_node->num_input_pins, lookup);
+  hash_pb_graph_node_pins(hasher, pb_graph_node->output_pins, pb_graph_node->num_output_ports, pb_graph_node->num_output_pins, lookup);
+  hash_pb_graph_node_pins(hasher, pb_graph_node->clock_pins, pb_graph_node->num_clock_ports, pb_graph_node->num_clock_pins, lookup);
+
+  if (true == is_primitive_pb_type(pb_type)) {
+    return;
+  }
+
+  t_mode* physical_mode = device_annotation.physical_mode(pb_type);
+  VTR_ASSERT(nullptr != physical_mode);
+  hasher(physical_mode->index);
+  for (int ichild = 0; ichild < physical_mode->num_pb_type_children; ++ichild) {
+    for (int ipb = 0; ipb < physical_mode->pb_type_children[ichild].num_pb; ++ipb) {
+      rec_hash_physical_pb_graph_node(hasher, &(pb_graph_node->child_pb_graph_nodes[physical_mode->index][ichild][ipb]), device_annotation, lookup);
+    }
+  }
+}
+
+/***************************************************************************************
+ * Compute the hash of the architecture which the physical lb_rr_graphs depend on
+ ***************************************************************************************/
+std::string compute_physical_lb_rr_graph_arch_hash(const DeviceContext& device_ctx,
+                                                   const VprDeviceAnnotation& device_annotation) {
+  std::ostringstream hash_data;
+  BinaryWriter hasher(hash_data);
+  hasher(PHYSICAL_LB_RR_GRAPH_CACHE_VERSION, device_ctx.logical_block_types.size());
+
+  for (const t_logical_block_type& lb_type : device_ctx.logical_block_types) {
+    hasher(std::string(lb_type.name));
+    /* By pass nullptr for pb_graph head */
+    if (nullptr == lb_type.pb_graph_head) {
+      continue;
+    }
+    t_pb_type* pb_type = lb_type.pb_graph_head->pb_type;
+    hasher(pb_type->num_input_pins,
+           pb_type->num_output_pins,
+           pb_type->num_clock_pins,
+           lb_type.pb_graph_head->total_pb_pins);
+
+    t_lb_rr_graph_cache_lookup lookup = build_lb_rr_graph_cache_lookup(lb_type.pb_graph_head);
+    hasher(lookup.modes.size());
+    rec_hash_physical_pb_graph_node(hasher, lb_type.pb_graph_head, device_annotation, lookup);
+  }
+
+  return secure_digest_hex(hash_data.str());
+}
+
+/***************************************************************************************
+ * The name of the cache file for an architecture in a cache directory
+ ***************************************************************************************/
+std::string physical_lb_rr_graph_cache_file_name(const std::string& cache_dir,
+                                                 const std::string& arch_hash) {
+  return format_dir_path(cache_dir) + std::string("lb_rr_graph_") + arch_hash + std::string(".bin");
+}
+
+/***************************************************************************************
+ * Decode the physical lb_rr_graph of a logical block type
+ * Return false if the cache does not match the architecture
+ ***************************************************************************************/
+static
+bool read_lb_rr_graph_from_cache(BinaryReader& reader,
+                                 const t_lb_rr_graph_cache_lookup& lookup,
+                                 LbRRGraph& lb_rr_graph) {
+  uint32_t num_nodes = 0;
+  uint32_t ext_source_node = 0;
+  uint32_t ext_sink_node = 0;
+  reader(num_nodes, ext_source_node, ext_sink_node);
+  if (false == reader.good()) {
+    return false;
+  }
+
+  lb_rr_graph.reserve_nodes(num_nodes);
+  for (size_t inode = 0; inode < num_nodes; ++inode) {
+    uint8_t type = 0;
+    int16_t capacity = 0;
+    uint32_t pin = 0;
+    float cost = 0.;
+    reader(type, capacity, pin, cost);
+    if ( (false == reader.good())
+      || (NUM_LB_RR_TYPES <= type) ) {
+      return false;
+    }
+
+    LbRRNodeId node = LbRRNodeId::INVALID();
+    if (inode == ext_source_node) {
+      node = lb_rr_graph.create_ext_source_node(static_cast<e_lb_rr_type>(type));
+    } else if (inode == ext_sink_node) {
+      node = lb_rr_graph.create_ext_sink_node(static_cast<e_lb_rr_type>(type));
+    } else {
+      node = lb_rr_graph.create_node(static_cast<e_lb_rr_type>(type));
+    }
+    lb_rr_graph.set_node_capacity(node, capacity);
+    if (PHYSICAL_LB_RR_GRAPH_CACHE_INVALID_ID != pin) {
+      if ( (pin >= lookup.pb_graph_pins.size())
+        || (nullptr == lookup.pb_graph_pins[pin]) ) {
+        return false;
+      }
+      lb_rr_graph.set_node_pb_graph_pin(node, lookup.pb_graph_pins[pin]);
+    }
+    lb_rr_graph.set_node_intrinsic_cost(node, cost);
+  }
+
+  uint32_t num_edges = 0;
+  reader(num_edges);
+  if (false == reader.good()) {
+    return false;
+  }
+
+  lb_rr_graph.reserve_edges(num_edges);
+  for (size_t iedge = 0; iedge < num_edges; ++iedge) {
+    uint32_t src_node = 0;
+    uint32_t sink_node = 0;
+    uint32_t mode = 0;
+    float cost = 0.;
+    reader(src_node, sink_node, mode, cost);
+    if ( (false == reader.good())
+      || (src_node >= num_nodes)
+      || (sink_node >= num_nodes) ) {
+      return false;
+    }
+
+    t_mode* edge_mode = nullptr;
+    if (PHYSICAL_LB_RR_GRAPH_CACHE_INVALID_ID != mode) {
+      if (mode >= lookup.modes.size()) {
+        return false;
+      }
+      edge_mode = lookup.modes[mode];
+    }
+    LbRREdgeId edge = lb_rr_graph.create_edge(LbRRNodeId(src_node), LbRRNodeId(sink_node), edge_mode);
+    lb_rr_graph.set_edge_intrinsic_cost(edge, cost);
+  }
+
+  /* Group the outgoing edges by modes for routers */
+  lb_rr_graph.build_node_mode_out_edges();
+
+  return true;
+}
+
+/***************************************************************************************
+ * Load the physical lb_rr_graphs from a cache file to the device annotation
+ * Only the logical block types without a physical lb_rr_graph are loaded
+ *
+ * Return:
+ *  - 0 if succeed
+ *  - 1 if the cache is missing or does not match the architecture
+ ***************************************************************************************/
+int read_physical_lb_rr_graph_cache(const std::string& fname,
+                                    const std::string& arch_hash,
+                                    const DeviceContext& device_ctx,
+                                    VprDeviceAnnotation& device_annotation,
+                                    const bool& verbose) {
+  std::ifstream fp(fname, std::ifstream::in | std::ifstream::binary);
+  if (false == fp.is_open()) {
+    VTR_LOGV(verbose,
+             "No cache of routing resource graph found at '%s'\n",
+             fname.c_str());
+    return 1;
+  }
+
+  vtr::ScopedStartFinishTimer timer("Read routing resource graph for the physical implementation of logical tile from cache '" + fname + "'");
+
+  BinaryReader reader(fp);
+  std::string magic;
+  uint32_t version = 0;
+  std::string cached_arch_hash;
+  uint32_t num_graphs = 0;
+  reader(magic, version, cached_arch_hash, num_graphs);
+  if ( (false == reader.good())
+    || (std::string(PHYSICAL_LB_RR_GRAPH_CACHE_MAGIC) != magic)
+    || (PHYSICAL_LB_RR_GRAPH_CACHE_VERSION != version)
+    || (arch_hash != cached_arch_hash) ) {
+    VTR_LOG_WARN("Cache '%s' does not match the architecture and is ignored\n",
+                 fname.c_str());
+    return 1;
+  }
+
+  /* Decode all the graphs before updating the device annotation,
+   * so that a corrupted cache does not leave any partial result
+   */
+  std::vector<std::pair<t_pb_graph_node*, LbRRGraph>> lb_rr_graphs;
+  for (size_t igraph = 0; igraph < num_graphs; ++igraph) {
+    uint32_t lb_type_index = 0;
+    reader(lb_type_index);
+    if ( (false == reader.good())
+      || (lb_type_index >= device_ctx.logical_block_types.size())
+      || (nullptr == device_ctx.logical_block_types[lb_type_index].pb_graph_head) ) {
+      VTR_LOG_WARN("Cache '%s' is corrupted and is ignored\n",
+                   fname.c_str());
+      return 1;
+    }
+    t_pb_graph_node* pb_graph_head = device_ctx.logical_block_types[lb_type_index].pb_graph_head;
+
+    t_lb_rr_graph_cache_lookup lookup = build_lb_rr_graph_cache_lookup(pb_graph_head);
+    LbRRGraph lb_rr_graph;
+    if ( (false == read_lb_rr_graph_from_cache(reader, lookup, lb_rr_graph))
+      || (false == lb_rr_graph.validate()) ) {
+      VTR_LOG_WARN("Cache '%s' is corrupted and is ignored\n",
+                   fname.c_str());
+      return 1;
+    }
+    lb_rr_graphs.push_back(std::make_pair(pb_graph_head, std::move(lb_rr_graph)));
+  }
+  if (false == reader.at_end()) {
+    VTR_LOG_WARN("Cache '%s' is corrupted and is ignored\n",
+                 fname.c_str());
+    return 1;
+  }
+
+  /* Ensure the cache covers all the logical block types */
+  for (const t_logical_block_type& lb_type : device_ctx.logical_block_types) {
+    if (nullptr == lb_type.pb_graph_head) {
+      continue;
+    }
+    bool cached = false;
+    for (const auto& lb_rr_graph : lb_rr_graphs) {
+      if (lb_type.pb_graph_head == lb_rr_graph.first) {
+        cached = true;
+        break;
+      }
+    }
+    if (false == cached) {
+      VTR_LOG_WARN("Cache '%s' misses the logical tile '%s' and is ignored\n",
+                   fname.c_str(), lb_type.pb_graph_head->pb_type->name);
+      return 1;
+    }
+  }
+
+  for (const auto& lb_rr_graph : lb_rr_graphs) {
+    if (true == device_annotation.has_physical_lb_rr_graph(lb_rr_graph.first)) {
+      continue;
+    }
+    VTR_LOGV(verbose,
+             "Loaded routing resource graph for logical tile '%s' from cache\n",
+             lb_rr_graph.first->pb_type->name);
+    device_annotation.add_physical_lb_rr_graph(lb_rr_graph.first, lb_rr_graph.second);
+  }
+
+  return 0;
+}
+
+/***************************************************************************************
+ * Encode the physical lb_rr_graph of a logical block type
+ ***************************************************************************************/
+static
+void write_lb_rr_graph_to_cache(BinaryWriter& writer,
+                                const t_lb_rr_graph_cache_lookup& lookup,
+                                const LbRRGraph& lb_rr_graph) {
+  auto node_index = [](const LbRRNodeId& node) -> uint32_t {
+    return (true == bool(node)) ? size_t(node) : PHYSICAL_LB_RR_GRAPH_CACHE_INVALID_ID;
+  };
+
+  writer(static_cast<uint32_t>(lb_rr_graph.nodes().size()),
+         node_index(lb_rr_graph.ext_source_node()),
+         node_index(lb_rr_graph.ext_sink_node()));
+  for (const LbRRNodeId& node : lb_rr_graph.nodes()) {
+    writer(static_cast<uint8_t>(lb_rr_graph.node_type(node)),
+           static_cast<int16_t>(lb_rr_graph.node_capacity(node)));
+    const t_pb_graph_pin* pb_graph_pin = lb_rr_graph.node_pb_graph_pin(node);
+    if (nullptr == pb_graph_pin) {
+      writer(PHYSICAL_LB_RR_GRAPH_CACHE_INVALID_ID);
+    } else {
+      VTR_ASSERT(pb_graph_pin == lookup.pb_graph_pins[pb_graph_pin->pin_count_in_cluster]);
+      writer(static_cast<uint32_t>(pb_graph_pin->pin_count_in_cluster));
+    }
+    writer(lb_rr_graph.node_intrinsic_cost(node));
+  }
+
+  writer(static_cast<uint32_t>(lb_rr_graph.edges().size()));
+  for (const LbRREdgeId& edge : lb_rr_graph.edges()) {
+    writer(static_cast<uint32_t>(size_t(lb_rr_graph.edge_src_node(edge))),
+           static_cast<uint32_t>(size_t(lb_rr_graph.edge_sink_node(edge))));
+    const t_mode* mode = lb_rr_graph.edge_mode(edge);
+    if (nullptr == mode) {
+      writer(PHYSICAL_LB_RR_GRAPH_CACHE_INVALID_ID);
+    } else {
+      writer(lookup.mode_indices.at(mode));
+    }
+    writer(lb_rr_graph.edge_intrinsic_cost(edge));
+  }
+}
+
+/***************************************************************************************
+ * Save the physical lb_rr_graphs of the device annotation to a cache file
+ * The cache is written to a temporary file and then renamed, so that concurrent runs
+ * sharing the same cache never see a partial file
+ *
+ * Return:
+ *  - 0 if succeed
+ *  - 1 if critical errors occured
+ ***************************************************************************************/
+int write_physical_lb_rr_graph_cache(const std::string& fname,
+                                     const std::string& arch_hash,
+                                     const DeviceContext& device_ctx,
+                                     const VprDeviceAnnotation& device_annotation,
+                                     const bool& verbose) {
+  vtr::ScopedStartFinishTimer timer("Write routing resource graph for the physical implementation of logical tile to cache '" + fname + "'");
+
+  /* Use a random suffix for the temporary file to avoid conflicts between concurrent runs */
+  std::random_device rand_dev;
+  std::string tmp_fname = fname + std::string(".tmp") + std::to_string(rand_dev());
+
+  std::fstream fp;
+  fp.open(tmp_fname, std::fstream::out | std::fstream::trunc | std::fstream::binary);
+  if (false == fp.is_open()) {
+    /* The cache directory may not exist yet, create it and try again */
+    create_directory(find_path_dir_name(fname));
+    fp.open(tmp_fname, std::fstream::out | std::fstream::trunc | std::fstream::binary);
+  }
+  if (false == fp.is_open()) {
+    VTR_LOG_ERROR("Fail to open cache file '%s'!\n",
+                  tmp_fname.c_str());
+    return 1;
+  }
+
+  BinaryWriter writer(fp);
+  size_t num_graphs = 0;
+  for (const t_logical_block_type& lb_type : device_ctx.logical_block_types) {
+    if (nullptr != lb_type.pb_graph_head) {
+      VTR_ASSERT(true == device_annotation.has_physical_lb_rr_graph(lb_type.pb_graph_head));
+      ++num_graphs;
+    }
+  }
+  writer(std::string(PHYSICAL_LB_RR_GRAPH_CACHE_MAGIC),
+         PHYSICAL_LB_RR_GRAPH_CACHE_VERSION,
+         arch_hash,
+         static_cast<uint32_t>(num_graphs));
+
+  for (const t_logical_block_type& lb_type : device_ctx.logical_block_types) {
+    if (nullptr == lb_type.pb_graph_head) {
+      continue;
+    }
+    writer(static_cast<uint32_t>(lb_type.index));
+    t_lb_rr_graph_cache_lookup lookup = build_lb_rr_graph_cache_lookup(lb_type.pb_graph_head);
+    write_lb_rr_graph_to_cache(writer, lookup, device_annotation.physical_lb_rr_graph(lb_type.pb_graph_head));
+  }
+
+  bool written = writer.good();
+  fp.close();
+  if (false == written) {
+    VTR_LOG_ERROR("Fail to write cache file '%s'!\n",
+                  tmp_fname.c_str());
+    std::remove(tmp_fname.c_str());
+    return 1;
+  }
+
+  if (0 != std::rename(tmp_fname.c_str(), fname.c_str())) {
+    VTR_LOG_ERROR("Fail to rename cache file '%s' to '%s'!\n",
+                  tmp_fname.c_str(), fname.c_str());
+    std::remove(tmp_fname.c_str());
+    return 1;
+  }
+
+  VTR_LOGV(verbose,
+           "Saved routing resource graph of %lu logical tiles to cache '%s'\n",
+           num_graphs, fname.c_str());
+
+  return 0;
+}
+
+} /* end namespace openfpga */
@@ -0,0 +1,38 @@
+#ifndef PHYSICAL_LB_RR_GRAPH_CACHE_H
+#define PHYSICAL_LB_RR_GRAPH_CACHE_H
+
+/********************************************************************
+ * Include header files that are required by function declaration
+ *******************************************************************/
+#include <string>
+#include "vpr_context.h"
+#include "vpr_device_annotation.h"
+
+/********************************************************************
+ * Function declaration
+ *******************************************************************/
+
+/* begin namespace openfpga */
+namespace openfpga {
+
+std::string compute_physical_lb_rr_graph_arch_hash(const DeviceContext& device_ctx,
+                                                   const VprDeviceAnnotation& device_annotation);
+
+std::string physical_lb_rr_graph_cache_file_name(const std::string& cache_dir,
+                                                 const std::string& arch_hash);
+
+int read_physical_lb_rr_graph_cache(const std::string& fname,
+                                    const std::string& arch_hash,
+                                    const DeviceContext& device_ctx,
+                                    VprDeviceAnnotation& device_annotation,
+                                    const bool& verbose);
+
+int write_physical_lb_rr_graph_cache(const std::string& fname,
+                                     const std::string& arch_hash,
+                                     const DeviceContext& device_ctx,
+                                     const VprDeviceAnnotation& device_annotation,
+                                     const bool& verbose);
+
+} /* end namespace openfpga */
+
+#endif
@@ -125,6 +125,27 @@ size_t PhysicalPb::fixed_mode_select_bitstream_offset(const PhysicalPbId& pb) co
 /******************************************************************************
  * Private Mutators
  ******************************************************************************/
+void PhysicalPb::reserve_pbs(const size_t& num_pbs) {
+  pb_ids_.reserve(num_pbs);
+
+  names_.reserve(num_pbs);
+  pb_graph_nodes_.reserve(num_pbs);
+  atom_blocks_.reserve(num_pbs);
+  pin_atom_nets_.reserve(num_pbs);
+  wire_lut_outputs_.reserve(num_pbs);
+
+  child_pbs_.reserve(num_pbs);
+  parent_pbs_.reserve(num_pbs);
+
+  truth_tables_.reserve(num_pbs);
+  mode_bits_.reserve(num_pbs);
+
+  fixed_bitstreams_.reserve(num_pbs);
+  fixed_bitstream_offsets_.reserve(num_pbs);
+  fixed_mode_select_bitstreams_.reserve(num_pbs);
+  fixed_mode_select_bitstream_offsets_.reserve(num_pbs);
+}
+
 PhysicalPbId PhysicalPb::create_pb(const t_pb_graph_node* pb_graph_node) {
   /* Find if the name has been used. If used, return an invalid Id and report error! */
   std::map<const t_pb_graph_node*, PhysicalPbId>::iterator it = type2id_map_.find(pb_graph_node);
@@ -59,6 +59,10 @@ class PhysicalPb {
     std::string fixed_mode_select_bitstream(const PhysicalPbId& pb) const;
     size_t fixed_mode_select_bitstream_offset(const PhysicalPbId& pb) const;
   public: /* Public mutators */
+    /* Reserve memory for a number of pbs, 
+     * so that the pbs of a clustered block are stored contiguously without reallocation
+     */
+    void reserve_pbs(const size_t& num_pbs);
     PhysicalPbId create_pb(const t_pb_graph_node* pb_graph_node);
     void add_child(const PhysicalPbId& parent,
                    const PhysicalPbId& child,
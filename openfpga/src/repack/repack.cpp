@@ -2,11 +2,19 @@
  * This file includes functions that are used to redo packing for physical pbs
  ***************************************************************************************/
 
+#include <algorithm>
+#include <map>
+#include <memory>
+
 /* Headers from vtrutil library */
 #include "vtr_log.h"
 #include "vtr_assert.h"
 #include "vtr_time.h"
 
+/* Headers from openfpgautil library */
+#include "openfpga_parallel.h"
+#include "openfpga_progress.h"
+
 /* Headers from vpr library */
 #include "vpr_utils.h"
 
@@ -14,6 +22,7 @@
 #include "build_physical_lb_rr_graph.h"
 #include "lb_router.h"
 #include "lb_router_utils.h"
+#include "lb_routing_cache.h"
 #include "physical_pb_utils.h"
 #include "repack.h"
 
@@ -648,24 +657,71 @@ void add_lb_router_nets(LbRouter& lb_router,
            net_counter);
 }
 
+/***************************************************************************************
+ * Routers of each logical block type, which are reused by the clustered blocks 
+ * of the same type, so that the internal buffers of routers are allocated only once
+ ***************************************************************************************/
+typedef std::map<t_logical_block_type_ptr, std::unique_ptr<LbRouter>> LbRouterPool;
+
+/***************************************************************************************
+ * Find a router for a logical block type from the pool and make it ready for routing
+ * A router is created, with physical modes set, on first request of a logical block type
+ ***************************************************************************************/
+static 
+LbRouter& find_pooled_lb_router(LbRouterPool& lb_router_pool,
+                                t_logical_block_type_ptr lb_type,
+                                const LbRRGraph& lb_rr_graph,
+                                const VprDeviceAnnotation& device_annotation,
+                                const bool& use_lookahead) {
+  auto result = lb_router_pool.find(lb_type);
+  if (lb_router_pool.end() != result) {
+    result->second->reset();
+    return *(result->second);
+  }
+
+  std::unique_ptr<LbRouter>& lb_router = lb_router_pool[lb_type];
+  lb_router.reset(new LbRouter(lb_rr_graph, lb_type));
+  /* Initialize the modes to expand routing trees with the physical modes in device annotation
+   * This is a must-do before running the routeri in the purpose of repacking!!!
+   * The modes are kept when the router is reset
+   */
+  lb_router->set_physical_pb_modes(lb_rr_graph, device_annotation); 
+  lb_router->set_lookahead(use_lookahead);
+
+  return *lb_router;
+}
+
 /***************************************************************************************
  * Repack a clustered block in the physical mode
  * This function will do 
  * - Find the lb_rr_graph that is affiliated to the clustered block 
- *   and initilize the logcial tile router 
+ *   and take the logcial tile router from the pool
  * - Create nets to be routed, including the source nodes and terminals
  *   This should consider the net remapping in the clustering_annotation 
- * - Run the router to finish the repacking
- * - Output routing results to data structure PhysicalPb and store it in clustering annotation
+ * - Run the router to finish the repacking, unless the routing of a clustered block
+ *   with the same nets is found in the routing cache
+ * - Output routing results to data structure PhysicalPb
+ *
+ * Return false if the clustered block cannot be routed
+ *
+ * Note: 
+ *  - This function only reads the shared contexts and annotations,
+ *    so that clustered blocks can be repacked in parallel.
+ *    The caller is in charge of storing the physical pb in clustering annotation
+ *    and of stopping on failures
  ***************************************************************************************/
 static 
-void repack_cluster(const AtomContext& atom_ctx,
+bool repack_cluster(const AtomContext& atom_ctx,
                     const ClusteringContext& clustering_ctx,
                     const VprDeviceAnnotation& device_annotation,
-                    VprClusteringAnnotation& clustering_annotation,
+                    const VprClusteringAnnotation& clustering_annotation,
                     const VprBitstreamAnnotation& bitstream_annotation,
                     const RepackDesignConstraints& design_constraints,
                     const ClusterBlockId& block_id,
+                    LbRouterPool& lb_router_pool,
+                    LbRoutingCache& lb_routing_cache,
+                    PhysicalPb& phy_pb,
+                    const bool& use_lookahead,
                     const bool& verbose) {
   /* Get the pb graph that current clustered block is mapped to */
   t_logical_block_type_ptr lb_type = clustering_ctx.clb_nlist.block_type(block_id);
@@ -676,36 +732,33 @@ void repack_cluster(const AtomContext& atom_ctx,
   const LbRRGraph& lb_rr_graph = device_annotation.physical_lb_rr_graph(pb_graph_head);
   VTR_ASSERT(!lb_rr_graph.empty());
 
-  VTR_LOG("Repack clustered block '%s'...",
-          clustering_ctx.clb_nlist.block_name(block_id).c_str());
-  VTR_LOGV(verbose, "\n");
-
-  /* Initialize the router */
-  LbRouter lb_router(lb_rr_graph, lb_type);
+  /* Get a router with physical modes set */
+  LbRouter& lb_router = find_pooled_lb_router(lb_router_pool, lb_type, lb_rr_graph, device_annotation, use_lookahead);
 
   /* Add nets to be routed with source and terminals */
   add_lb_router_nets(lb_router, lb_type, lb_rr_graph, atom_ctx, device_annotation,
-                     clustering_ctx, const_cast<const VprClusteringAnnotation&>(clustering_annotation),
+                     clustering_ctx, clustering_annotation,
                      design_constraints,
                      block_id, verbose);
 
-  /* Initialize the modes to expand routing trees with the physical modes in device annotation
-   * This is a must-do before running the routeri in the purpose of repacking!!!
-   */
-  lb_router.set_physical_pb_modes(lb_rr_graph, device_annotation); 
-
-  /* Run the router */
-  bool route_success = lb_router.try_route(lb_rr_graph, atom_ctx.nlist, verbose);
-
-  if (false == route_success) {
-    VTR_LOGV(verbose, "Reroute failed\n");
-    exit(1);
+  /* Reuse the routing of a clustered block with the same nets, or run the router */
+  std::vector<std::vector<LbRRNodeId>> net_routed_nodes;
+  bool route_cached = lb_routing_cache.find(lb_type, lb_router, net_routed_nodes);
+  if (true == route_cached) {
+    VTR_LOGV(verbose, "Reuse the routing of a clustered block with the same nets\n");
+  } else {
+    bool route_success = lb_router.try_route(lb_rr_graph, atom_ctx.nlist, verbose);
+
+    if (false == route_success) {
+      VTR_LOG_ERROR("Reroute failed for clustered block '%s'\n",
+                    clustering_ctx.clb_nlist.block_name(block_id).c_str());
+      return false;
+    }
+    VTR_LOGV(verbose, "Reroute succeed\n");
+    lb_routing_cache.add(lb_type, lb_router);
   }
-  VTR_ASSERT(true == route_success);
-  VTR_LOGV(verbose, "Reroute succeed\n");
 
   /* Annotate routing results to physical pb */
-  PhysicalPb phy_pb;
   alloc_physical_pb_from_pb_graph(phy_pb, pb_graph_head, device_annotation);
   rec_update_physical_pb_from_operating_pb(phy_pb,
                                            clustering_ctx.clb_nlist.block_pb(block_id),
@@ -715,17 +768,28 @@ void repack_cluster(const AtomContext& atom_ctx,
                                            bitstream_annotation,
                                            verbose);
   /* Save routing results */
-  save_lb_router_results_to_physical_pb(phy_pb, lb_router, lb_rr_graph);
+  if (true == route_cached) {
+    save_lb_routed_nodes_to_physical_pb(phy_pb, lb_router, net_routed_nodes, lb_rr_graph);
+  } else {
+    save_lb_router_results_to_physical_pb(phy_pb, lb_router, lb_rr_graph);
+  }
   VTR_LOGV(verbose, "Saved results in physical pb\n");
 
-  /* Add the pb to clustering context */
-  clustering_annotation.add_physical_pb(block_id, phy_pb);
-
-  VTR_LOG("Done\n");
+  return true;
 }
 
 /***************************************************************************************
  * Repack each clustered blocks in the clustering context
+ *
+ * Note: 
+ *  - Clustered blocks are routed independently. Each thread has its own pool of routers
+ *    The routing results are cached and shared by all the threads,
+ *    so that the clustered blocks with the same nets are routed only once
+ *    When multiple threads are used, the physical pbs are built in parallel
+ *    and then added to the clustering annotation in the order of clustered blocks,
+ *    so that the results are the same as a single thread.
+ *  - Verbose outputs of different clustered blocks may interleave 
+ *    when multiple threads are used
  ***************************************************************************************/
 static 
 void repack_clusters(const AtomContext& atom_ctx,
@@ -734,17 +798,82 @@ void repack_clusters(const AtomContext& atom_ctx,
                      VprClusteringAnnotation& clustering_annotation,
                      const VprBitstreamAnnotation& bitstream_annotation,
                      const RepackDesignConstraints& design_constraints,
+                     const size_t& num_threads,
+                     const bool& use_lookahead,
                      const bool& verbose) {
   vtr::ScopedStartFinishTimer timer("Repack clustered blocks to physical implementation of logical tile");
 
-  for (auto blk_id : clustering_ctx.clb_nlist.blocks()) {
-    repack_cluster(atom_ctx, clustering_ctx, 
-                   device_annotation,
-                   clustering_annotation, 
-                   bitstream_annotation,
-                   design_constraints,
-                   blk_id, verbose);
+  ProgressReporter progress("Repacking clustered blocks", clustering_ctx.clb_nlist.blocks().size());
+
+  LbRoutingCache lb_routing_cache;
+
+  if (1 >= num_threads) {
+    LbRouterPool lb_router_pool;
+    for (auto blk_id : clustering_ctx.clb_nlist.blocks()) {
+      VTR_LOG("Repack clustered block '%s'...",
+              clustering_ctx.clb_nlist.block_name(blk_id).c_str());
+      VTR_LOGV(verbose, "\n");
+
+      PhysicalPb phy_pb;
+      if (false == repack_cluster(atom_ctx, clustering_ctx, 
+                                  device_annotation,
+                                  const_cast<const VprClusteringAnnotation&>(clustering_annotation), 
+                                  bitstream_annotation,
+                                  design_constraints,
+                                  blk_id, lb_router_pool, lb_routing_cache,
+                                  phy_pb, use_lookahead, verbose)) {
+        exit(1);
+      }
+
+      /* Add the pb to clustering context */
+      clustering_annotation.add_physical_pb(blk_id, std::move(phy_pb));
+
+      VTR_LOG("Done\n");
+      progress.advance();
+    }
+    VTR_LOG("Reused the routing of %lu out of %lu clustered blocks\n",
+            lb_routing_cache.num_hits(), lb_routing_cache.num_lookups());
+    return;
   }
+
+  std::vector<ClusterBlockId> blocks(clustering_ctx.clb_nlist.blocks().begin(),
+                                     clustering_ctx.clb_nlist.blocks().end());
+  std::vector<PhysicalPb> phy_pbs(blocks.size());
+  std::vector<LbRouterPool> lb_router_pools(num_threads);
+  /* Failures are recorded by the workers and handled after all of them are joined */
+  std::vector<char> repack_success(blocks.size(), false);
+
+  VTR_LOG("Repack %lu clustered blocks using %lu threads\n",
+          blocks.size(), num_threads);
+
+  parallel_for_with_thread_id(blocks.size(), num_threads,
+                              [&](const size_t& iblk, const size_t& ithread) {
+                                repack_success[iblk] = repack_cluster(atom_ctx, clustering_ctx, 
+                                                                      device_annotation,
+                                                                      const_cast<const VprClusteringAnnotation&>(clustering_annotation), 
+                                                                      bitstream_annotation,
+                                                                      design_constraints,
+                                                                      blocks[iblk], lb_router_pools[ithread], lb_routing_cache,
+                                                                      phy_pbs[iblk], use_lookahead, verbose);
+                                progress.advance();
+                              });
+
+  /* The errors of the failed blocks have been printed when the workers were joined */
+  size_t num_failed_blocks = std::count(repack_success.begin(), repack_success.end(), false);
+  if (0 < num_failed_blocks) {
+    VTR_LOG_ERROR("Fail to repack %lu out of %lu clustered blocks\n",
+                  num_failed_blocks, blocks.size());
+    exit(1);
+  }
+
+  /* Add the pbs to clustering context in the order of clustered blocks */
+  for (size_t iblk = 0; iblk < blocks.size(); ++iblk) {
+    clustering_annotation.add_physical_pb(blocks[iblk], std::move(phy_pbs[iblk]));
+    VTR_LOG("Repack clustered block '%s'...Done\n",
+            clustering_ctx.clb_nlist.block_name(blocks[iblk]).c_str());
+  }
+  VTR_LOG("Reused the routing of %lu out of %lu clustered blocks\n",
+          lb_routing_cache.num_hits(), lb_routing_cache.num_lookups());
 }
 
 /***************************************************************************************
@@ -790,6 +919,8 @@ void identify_physical_pb_wire_lut_created_by_repack(VprClusteringAnnotation& cl
  * This function will do :
  *  - create physical lb_rr_graph for each pb_graph considering physical modes only
  *    the lb_rr_graph will be added to device annotation
+ *    unless it is already there or it can be loaded from the cache directory
+ *  - build the lookahead of each lb_rr_graph when the router uses it
  *  - annotate nets to be routed for each clustered block from operating modes of pb_graph 
  *    to physical modes of pb_graph
  *  - rerun the routing for each clustered block
@@ -803,19 +934,32 @@ void pack_physical_pbs(const DeviceContext& device_ctx,
                        const VprBitstreamAnnotation& bitstream_annotation,
                        const RepackDesignConstraints& design_constraints,
                        const CircuitLibrary& circuit_lib,
+                       const std::string& lb_rr_graph_cache_dir,
+                       const size_t& num_threads,
+                       const bool& use_lookahead,
                        const bool& verbose) {
 
   /* build the routing resource graph for each logical tile */
   build_physical_lb_rr_graphs(device_ctx,
                               device_annotation,
+                              lb_rr_graph_cache_dir,
+                              num_threads,
                               verbose);
 
+  if (true == use_lookahead) {
+    build_physical_lb_rr_graph_lookaheads(device_ctx,
+                                          device_annotation,
+                                          verbose);
+  }
+
   /* Call the LbRouter to re-pack each clustered block to physical implementation */ 
   repack_clusters(atom_ctx, clustering_ctx, 
                   const_cast<const VprDeviceAnnotation&>(device_annotation),
                   clustering_annotation, 
                   bitstream_annotation,
                   design_constraints,
+                  num_threads,
+                  use_lookahead,
                   verbose);
 
   /* Annnotate wire LUTs that are ONLY created by repacker!!!
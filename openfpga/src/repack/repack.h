@@ -4,6 +4,7 @@
 /********************************************************************
  * Include header files that are required by function declaration
  *******************************************************************/
+#include <string>
 #include "vpr_context.h"
 #include "vpr_device_annotation.h"
 #include "vpr_clustering_annotation.h"
@@ -27,6 +28,9 @@ void pack_physical_pbs(const DeviceContext& device_ctx,
                        const VprBitstreamAnnotation& bitstream_annotation,
                        const RepackDesignConstraints& design_constraints,
                        const CircuitLibrary& circuit_lib,
+                       const std::string& lb_rr_graph_cache_dir,
+                       const size_t& num_threads,
+                       const bool& use_lookahead,
                        const bool& verbose);
 
 } /* end namespace openfpga */
@@ -3,6 +3,9 @@
  * between tiles (programmable blocks) 
  ***************************************************************************************/
 
+#include <algorithm>
+#include <map>
+
 /* Headers from vtrutil library */
 #include "vtr_log.h"
 #include "vtr_assert.h"
@@ -147,26 +150,114 @@ bool is_grid_coordinate_exist_in_device(const DeviceGrid& device_grid,
 }
 
 /********************************************************************
- * Find the coordinate of a grid in a specific column 
- * with a given type
- * This function will return the coordinate of the grid that satifies
- * the type requirement
+ * An index on the core grids of a device for a type of physical tile,
+ * which lists the rows occupied by the tile in each column
+ * and the columns occupied by the tile in each row, in ascending order.
+ * It is built once for the device, so that the search for a tile of
+ * a given type in a column/row does not walk through the grids again
+ *******************************************************************/
+struct TileTypeGridIndex {
+  /* The y of the grids in each column [x][...] */
+  std::vector<std::vector<size_t>> column_rows;
+  /* The x of the grids in each row [y][...] */
+  std::vector<std::vector<size_t>> row_columns;
+  /* The columns and rows which contain at least one grid, in ascending order */
+  std::vector<size_t> occupied_columns;
+  std::vector<size_t> occupied_rows;
+};
+
+/********************************************************************
+ * Build the index of the core grids, i.e., x = 1 to nx and y = 1 to ny,
+ * for each type of physical tile
  *******************************************************************/
 static 
-vtr::Point<size_t> find_grid_coordinate_given_type(const DeviceGrid& grids,
-                                                   const std::vector<vtr::Point<size_t>>& candidate_coords, 
-                                                   const std::string& wanted_grid_type_name) {
-  for (vtr::Point<size_t> coord : candidate_coords) {
-    /* If the next column is not longer in device range, we can return */
-    if (false == is_grid_coordinate_exist_in_device(grids, coord)) {
-      continue;
+std::map<std::string, TileTypeGridIndex> build_tile_type_grid_index(const DeviceGrid& grids) {
+  std::map<std::string, TileTypeGridIndex> tile_type_grid_index;
+
+  for (size_t ix = 1; ix < grids.width() - 1; ++ix) {
+    for (size_t iy = 1; iy < grids.height() - 1; ++iy) {
+      TileTypeGridIndex& index = tile_type_grid_index[std::string(grids[ix][iy].type->name)];
+      if (true == index.column_rows.empty()) {
+        index.column_rows.resize(grids.width());
+        index.row_columns.resize(grids.height());
+      }
+      /* Grids are visited column by column in ascending order, so the lists are sorted */
+      index.column_rows[ix].push_back(iy);
+      index.row_columns[iy].push_back(ix);
     }
-    if (wanted_grid_type_name == std::string(grids[coord.x()][coord.y()].type->name)) {
-      return coord;
+  }
+
+  for (auto& index : tile_type_grid_index) {
+    for (size_t ix = 0; ix < index.second.column_rows.size(); ++ix) {
+      if (false == index.second.column_rows[ix].empty()) {
+        index.second.occupied_columns.push_back(ix);
+      }
+    }
+    for (size_t iy = 0; iy < index.second.row_columns.size(); ++iy) {
+      if (false == index.second.row_columns[iy].empty()) {
+        index.second.occupied_rows.push_back(iy);
+      }
     }
   }
-  /* Return an valid coordinate */
-  return vtr::Point<size_t>(grids.width(), grids.height()); 
+
+  return tile_type_grid_index;
+}
+
+/********************************************************************
+ * Find the index of a type of physical tile
+ * Return nullptr if there is no such tile in the core grids
+ *******************************************************************/
+static 
+const TileTypeGridIndex* find_tile_type_grid_index(const std::map<std::string, TileTypeGridIndex>& tile_type_grid_index,
+                                                   const std::string& tile_type_name) {
+  auto result = tile_type_grid_index.find(tile_type_name);
+  if (result == tile_type_grid_index.end()) {
+    return nullptr;
+  }
+  return &(result->second);
+}
+
+/********************************************************************
+ * Find the first (or the last) grid in a column/row where a tile locates
+ * Return an invalid coordinate (the size of the device) if not found
+ *******************************************************************/
+static 
+size_t find_tile_type_grid_in_column_row(const std::vector<size_t>& grid_indices,
+                                         const bool& from_last,
+                                         const size_t& invalid_index) {
+  if (true == grid_indices.empty()) {
+    return invalid_index;
+  }
+  if (true == from_last) {
+    return grid_indices.back();
+  }
+  return grid_indices.front();
+}
+
+/********************************************************************
+ * Find the closest column/row to a given one in a direction
+ * which contains the wanted tile
+ * Return an invalid coordinate (the size of the device) if not found
+ *******************************************************************/
+static 
+size_t find_next_occupied_column_row(const std::vector<size_t>& occupied_indices,
+                                     const size_t& src_index,
+                                     const e_direct_direction& direction,
+                                     const size_t& invalid_index) {
+  if (POSITIVE_DIR == direction) {
+    auto result = std::upper_bound(occupied_indices.begin(), occupied_indices.end(), src_index);
+    if (result == occupied_indices.end()) {
+      return invalid_index;
+    }
+    return *result;
+  }
+
+  VTR_ASSERT(NEGATIVE_DIR == direction);
+  auto result = std::lower_bound(occupied_indices.begin(), occupied_indices.end(), src_index);
+  if (result == occupied_indices.begin()) {
+    return invalid_index;
+  }
+  return *(--result);
 }
 
 /********************************************************************
@@ -175,165 +266,64 @@ vtr::Point<size_t> find_grid_coordinate_given_type(const DeviceGrid& grids,
  *******************************************************************/
 static 
 vtr::Point<size_t> find_inter_direct_destination_coordinate(const DeviceGrid& grids,
+                                                            const std::map<std::string, TileTypeGridIndex>& tile_type_grid_index,
                                                             const vtr::Point<size_t>& src_coord,
                                                             const std::string des_tile_type_name,
                                                             const ArchDirect& arch_direct,
                                                             const ArchDirectId& arch_direct_id) {
   vtr::Point<size_t> des_coord(grids.width(), grids.height());
 
-  std::vector<size_t> first_search_space;
-  std::vector<size_t> second_search_space;
+  const TileTypeGridIndex* des_index = find_tile_type_grid_index(tile_type_grid_index, des_tile_type_name);
+  if (nullptr == des_index) {
+    return des_coord;
+  }
 
   /* Cross column connection from Bottom to Top on Right 
    * The next column may NOT have the grid type we want!
    * Think about heterogeneous architecture!  
    * Our search space will start from the next column 
-   * and ends at the RIGHT side of fabric 
+   * and ends at the RIGHT (or LEFT for negative x-direction) side of fabric 
+   *
+   *      x      ...      nx 
+   *   +-----+
+   *   |Grid |  ----->
+   *   +-----+
+   *
+   * In the first column which contains the wanted grid, the grid is searched
+   * from y = 1 to y = ny, or from y = ny to y = 1 for positive y-direction
    */
   if (INTER_COLUMN == arch_direct.type(arch_direct_id)) {
-    if (POSITIVE_DIR == arch_direct.x_dir(arch_direct_id)) {
-     /* Our first search space will be in x-direction:
-      *
-      *      x      ...      nx 
-      *   +-----+
-      *   |Grid |  ----->
-      *   +-----+
-      */
-      for (size_t ix = src_coord.x() + 1; ix < grids.width() - 1; ++ix) {
-        first_search_space.push_back(ix);
-      }
-    } else { 
-      VTR_ASSERT(NEGATIVE_DIR == arch_direct.x_dir(arch_direct_id));
-     /* Our first search space will be in x-direction:
-      *
-      *    1   ...      x    
-      *              +-----+
-      *     < -------|Grid | 
-      *              +-----+
-      */
-      for (size_t ix = src_coord.x() - 1; ix >= 1; --ix) {
-        first_search_space.push_back(ix);
-      }
-    }
-
-    /* Our second search space will be in y-direction:
-     *
-     *  +------+  
-     *  | Grid | ny
-     *  +------+
-     *     ^     .
-     *     |     .
-     *     |     .
-     *  +------+
-     *  | Grid | 1
-     *  +------+
-     */
-    for (size_t iy = 1 ; iy < grids.height() - 1; ++iy) {
-      second_search_space.push_back(iy);
-    }
-
-    /* For negative direction, our second search space will be in y-direction:
-     *
-     *  +------+  
-     *  | Grid | ny
-     *  +------+
-     *     |     .
-     *     |     .
-     *     v     .
-     *  +------+
-     *  | Grid | 1
-     *  +------+
-     */
-    if (POSITIVE_DIR == arch_direct.y_dir(arch_direct_id)) {
-      std::reverse(second_search_space.begin(), second_search_space.end());
+    size_t ix = find_next_occupied_column_row(des_index->occupied_columns, src_coord.x(),
+                                              arch_direct.x_dir(arch_direct_id), grids.width());
+    if (ix == grids.width()) {
+      return des_coord;
     }
+    size_t iy = find_tile_type_grid_in_column_row(des_index->column_rows[ix],
+                                                  POSITIVE_DIR == arch_direct.y_dir(arch_direct_id),
+                                                  grids.height());
+    return vtr::Point<size_t>(ix, iy);
   }
 
-
   /* Cross row connection from Bottom to Top on Right 
-   * The next column may NOT have the grid type we want!
-   * Think about heterogeneous architecture!  
-   * Our search space will start from the next column 
-   * and ends at the RIGHT side of fabric 
+   * The next row may NOT have the grid type we want!
+   * Our search space will start from the next row 
+   * and ends at the TOP (or BOTTOM for negative y-direction) side of fabric 
+   *
+   * In the first row which contains the wanted grid, the grid is searched
+   * from x = 1 to x = nx, or from x = nx to x = 1 for positive x-direction
    */
   if (INTER_ROW == arch_direct.type(arch_direct_id)) {
-    if (POSITIVE_DIR == arch_direct.y_dir(arch_direct_id)) {
-     /* Our first search space will be in y-direction:
-      *
-      *  +------+  
-      *  | Grid | ny
-      *  +------+
-      *     ^     .
-      *     |     .
-      *     |     .
-      *  +------+
-      *  | Grid | y
-      *  +------+
-      */
-      for (size_t iy = src_coord.y() + 1; iy < grids.height() - 1; ++iy) {
-        first_search_space.push_back(iy);
-      }
-    } else { 
-      VTR_ASSERT(NEGATIVE_DIR == arch_direct.y_dir(arch_direct_id));
-      /* For negative y-direction,
-       * Our first search space will be in y-direction:
-       *
-       *  +------+  
-       *  | Grid | ny
-       *  +------+
-       *     |     .
-       *     |     .
-       *     v     .
-       *  +------+
-       *  | Grid | y
-       *  +------+
-       */
-      for (size_t iy = src_coord.y() - 1; iy >= 1; --iy) {
-        first_search_space.push_back(iy);
-      }
-    }
-
-    /* Our second search space will be in x-direction:
-     *
-     *     1      ...     nx
-     *  +------+       +------+
-     *  | Grid |<------| Grid |
-     *  +------+       +------+
-     */
-    for (size_t ix = 1 ; ix < grids.width() - 1; ++ix) {
-      second_search_space.push_back(ix);
-    }
-
-    /* For negative direction,
-     * our second search space will be in x-direction:
-     *
-     *     1      ...     nx
-     *  +------+       +------+
-     *  | Grid |------>| Grid |
-     *  +------+       +------+
-     */
-    if (POSITIVE_DIR == arch_direct.x_dir(arch_direct_id)) {
-      std::reverse(second_search_space.begin(), second_search_space.end());
+    size_t iy = find_next_occupied_column_row(des_index->occupied_rows, src_coord.y(),
+                                              arch_direct.y_dir(arch_direct_id), grids.height());
+    if (iy == grids.height()) {
+      return des_coord;
     }
+    size_t ix = find_tile_type_grid_in_column_row(des_index->row_columns[iy],
+                                                  POSITIVE_DIR == arch_direct.x_dir(arch_direct_id),
+                                                  grids.width());
+    return vtr::Point<size_t>(ix, iy);
   }
 
-  for (size_t ix : first_search_space) {
-    std::vector<vtr::Point<size_t>> next_col_row_coords;
-    for (size_t iy : second_search_space) {
-      if (INTER_COLUMN == arch_direct.type(arch_direct_id)) {
-        next_col_row_coords.push_back(vtr::Point<size_t>(ix, iy));
-      } else {
-        VTR_ASSERT(INTER_ROW == arch_direct.type(arch_direct_id));
-        /* For cross-row connection, our search space is flipped */
-        next_col_row_coords.push_back(vtr::Point<size_t>(iy, ix));
-      }
-    }
-    vtr::Point<size_t> des_coord_cand = find_grid_coordinate_given_type(grids, next_col_row_coords, des_tile_type_name); 
-    /* For a valid coordinate, we can return */
-    if (true == is_grid_coordinate_exist_in_device(grids, des_coord_cand)) {
-      return des_coord_cand;
-    }
-  }
   return des_coord;
 }
 
@@ -522,6 +512,7 @@ static
 void build_inter_column_row_tile_direct(TileDirect& tile_direct,
                                         const t_direct_inf& vpr_direct,
                                         const DeviceContext& device_ctx,
+                                        const std::map<std::string, TileTypeGridIndex>& tile_type_grid_index,
                                         const ArchDirect& arch_direct,
                                         const ArchDirectId& arch_direct_id,
                                         const bool& verbose) {
@@ -541,6 +532,13 @@ void build_inter_column_row_tile_direct(TileDirect& tile_direct,
     && (INTER_ROW != arch_direct.type(arch_direct_id))) {
     return;
   }
+
+  /* Bypass the direct if there is no source tile in the device */
+  const TileTypeGridIndex* from_index = find_tile_type_grid_index(tile_type_grid_index, from_tile_name);
+  if (nullptr == from_index) {
+    return;
+  }
+
   /* For cross-column connection, we will search the first valid grid in each column 
    * from y = 1 to y = ny
    *
@@ -557,23 +555,14 @@ void build_inter_column_row_tile_direct(TileDirect& tile_direct,
    * 
    */
   if (INTER_COLUMN == arch_direct.type(arch_direct_id)) {
-    for (size_t ix = 1; ix < device_ctx.grid.width() - 1; ++ix) {
-      std::vector<vtr::Point<size_t>> next_col_src_grid_coords;
-      /* For negative y- direction, we should start from y = ny */
-      for (size_t iy = 1; iy < device_ctx.grid.height() - 1; ++iy) {
-        next_col_src_grid_coords.push_back(vtr::Point<size_t>(ix, iy));
-      }
-      /* For positive y- direction, we should start from y = 1 */
-      if (NEGATIVE_DIR == arch_direct.y_dir(arch_direct_id)) {
-        std::reverse(next_col_src_grid_coords.begin(), next_col_src_grid_coords.end());
-      }
-
-      /* Bypass the grid that does not fit the from_tile name */
-      vtr::Point<size_t> from_grid_coord = find_grid_coordinate_given_type(device_ctx.grid, next_col_src_grid_coords, from_tile_name); 
-      /* Skip if we do not have a valid coordinate for source CLB/heterogeneous block */
-      if (false == is_grid_coordinate_exist_in_device(device_ctx.grid, from_grid_coord)) {
-        continue;
-      }
+    for (const size_t& ix : from_index->occupied_columns) {
+      /* For negative y- direction, we should start from y = ny
+       * For positive y- direction, we should start from y = 1
+       */
+      vtr::Point<size_t> from_grid_coord(ix, find_tile_type_grid_in_column_row(from_index->column_rows[ix],
+                                                                               NEGATIVE_DIR == arch_direct.y_dir(arch_direct_id),
+                                                                               device_ctx.grid.height()));
+      VTR_ASSERT(true == is_grid_coordinate_exist_in_device(device_ctx.grid, from_grid_coord));
 
       /* Search all the sides, the from pin may locate any side!
        * Note: the vpr_direct.from_side is NUM_SIDES, which is unintialized
@@ -593,7 +582,7 @@ void build_inter_column_row_tile_direct(TileDirect& tile_direct,
         }
 
         /* For a valid coordinate, we can find the coordinate of the destination clb */
-         vtr::Point<size_t> to_grid_coord = find_inter_direct_destination_coordinate(device_ctx.grid, from_grid_coord, to_tile_name, arch_direct, arch_direct_id);
+         vtr::Point<size_t> to_grid_coord = find_inter_direct_destination_coordinate(device_ctx.grid, tile_type_grid_index, from_grid_coord, to_tile_name, arch_direct, arch_direct_id);
          /* If destination clb is valid, we should add something */
         if (false == is_grid_coordinate_exist_in_device(device_ctx.grid, to_grid_coord)) {
            continue;
@@ -661,22 +650,15 @@ void build_inter_column_row_tile_direct(TileDirect& tile_direct,
    *   +------+               +------+
    * 
    */
-  for (size_t iy = 1; iy < device_ctx.grid.height() - 1; ++iy) {
-    std::vector<vtr::Point<size_t>> next_col_src_grid_coords;
-    /* For negative x- direction, we should start from x = nx */
-    for (size_t ix = 1; ix < device_ctx.grid.width() - 1; ++ix) {
-      next_col_src_grid_coords.push_back(vtr::Point<size_t>(ix, iy));
-    }
-    /* For positive x- direction, we should start from x = 1 */
-    if (POSITIVE_DIR == arch_direct.x_dir(arch_direct_id)) {
-      std::reverse(next_col_src_grid_coords.begin(), next_col_src_grid_coords.end());
-    }
-
-    vtr::Point<size_t> from_grid_coord = find_grid_coordinate_given_type(device_ctx.grid, next_col_src_grid_coords, from_tile_name); 
-    /* Skip if we do not have a valid coordinate for source CLB/heterogeneous block */
-    if (false == is_grid_coordinate_exist_in_device(device_ctx.grid, from_grid_coord)) {
-      continue;
-    }
+  for (const size_t& iy : from_index->occupied_rows) {
+    /* For negative x- direction, we should start from x = 1
+     * For positive x- direction, we should start from x = nx
+     */
+    vtr::Point<size_t> from_grid_coord(find_tile_type_grid_in_column_row(from_index->row_columns[iy],
+                                                                         POSITIVE_DIR == arch_direct.x_dir(arch_direct_id),
+                                                                         device_ctx.grid.width()),
+                                       iy);
+    VTR_ASSERT(true == is_grid_coordinate_exist_in_device(device_ctx.grid, from_grid_coord));
 
     /* Search all the sides, the from pin may locate any side!
      * Note: the vpr_direct.from_side is NUM_SIDES, which is unintialized
@@ -696,7 +678,7 @@ void build_inter_column_row_tile_direct(TileDirect& tile_direct,
       }
 
       /* For a valid coordinate, we can find the coordinate of the destination clb */
-      vtr::Point<size_t> to_grid_coord = find_inter_direct_destination_coordinate(device_ctx.grid, from_grid_coord, to_tile_name, arch_direct, arch_direct_id);
+      vtr::Point<size_t> to_grid_coord = find_inter_direct_destination_coordinate(device_ctx.grid, tile_type_grid_index, from_grid_coord, to_tile_name, arch_direct, arch_direct_id);
       /* If destination clb is valid, we should add something */
       if (false == is_grid_coordinate_exist_in_device(device_ctx.grid, to_grid_coord)) {
         continue;
@@ -763,6 +745,9 @@ TileDirect build_device_tile_direct(const DeviceContext& device_ctx,
 
   TileDirect tile_direct;
 
+  /* Index the core grids by tile types, which is shared by all the directs */
+  std::map<std::string, TileTypeGridIndex> tile_type_grid_index = build_tile_type_grid_index(device_ctx.grid);
+
   /* Walk through each direct definition in the VPR arch */
   for (int idirect = 0; idirect < device_ctx.arch->num_directs; ++idirect) {
     ArchDirectId arch_direct_id = arch_direct.direct(std::string(device_ctx.arch->Directs[idirect].name));
@@ -781,6 +766,7 @@ TileDirect build_device_tile_direct(const DeviceContext& device_ctx,
     build_inter_column_row_tile_direct(tile_direct,
                                        device_ctx.arch->Directs[idirect],
                                        device_ctx,
+                                       tile_type_grid_index,
                                        arch_direct,
                                        arch_direct_id,
                                        verbose);
@@ -86,6 +86,17 @@ size_t find_memory_decoder_data_size(const size_t& num_mems) {
   return (size_t)std::ceil(std::sqrt((float)num_mems));
 }
 
+/***************************************************************************************
+ * Find the size of data lines for a frame decoder to access a number of memory cells
+ * As each frame loads a number of memory cells in parallel (the width of the data input),
+ * the decoder only needs to select the frames rather than each memory cell
+ ***************************************************************************************/
+size_t find_frame_memory_decoder_data_size(const size_t& num_mems,
+                                           const size_t& frame_data_width) {
+  VTR_ASSERT(0 < frame_data_width);
+  return (num_mems + frame_data_width - 1) / frame_data_width;
+}
+
 /***************************************************************************************
  * Try to find if the decoder already exists in the library, 
  * If there is no such decoder, add it to the library 
@@ -17,6 +17,9 @@ size_t find_memory_decoder_addr_size(const size_t& num_mems);
 
 size_t find_memory_decoder_data_size(const size_t& num_mems);
 
+size_t find_frame_memory_decoder_data_size(const size_t& num_mems,
+                                           const size_t& frame_data_width);
+
 DecoderId add_mux_local_decoder_to_library(DecoderLibrary& decoder_lib, 
                                            const size_t data_size);
 
@@ -34,21 +34,22 @@ size_t find_fabric_regional_bitstream_max_size(const FabricBitstream& fabric_bit
 }
 
 /********************************************************************
- * For fast configuration, the number of bits to be skipped
- * depends on each regional bitstream
+ * For fast configuration, find the number of bits to be skipped
+ * at the head of each regional bitstream, i.e., the leading bits
+ * whose values are the same as the configuration memories after reset.
+ * These bits are shifted to the tail of a configuration chain,
+ * so that a region does not have to load them at all
  * For example:
- *   Region 0: 000000001111101010
- *   Region 1:     00000011010101
- *   Region 2:   0010101111000110
- * The number of bits that can be skipped is limited by Region 2
- * Find the longest bitstream size of a fabric bitstream
+ *   Region 0: 000000001111101010 -> 8 bits to skip
+ *   Region 1:     00000011010101 -> 6 bits to skip
+ *   Region 2:   0010101111000110 -> 2 bits to skip
  *******************************************************************/
-size_t find_configuration_chain_fabric_bitstream_size_to_be_skipped(const FabricBitstream& fabric_bitstream,
-                                                                    const BitstreamManager& bitstream_manager,
-                                                                    const bool& bit_value_to_skip) {
-  size_t regional_bitstream_max_size = find_fabric_regional_bitstream_max_size(fabric_bitstream);
+std::vector<size_t> find_configuration_chain_fabric_regional_bitstream_sizes_to_be_skipped(const FabricBitstream& fabric_bitstream,
+                                                                                           const BitstreamManager& bitstream_manager,
+                                                                                           const bool& bit_value_to_skip) {
+  std::vector<size_t> regional_num_bits_to_skip;
+  regional_num_bits_to_skip.reserve(fabric_bitstream.num_regions());
 
-  size_t num_bits_to_skip = size_t(-1);
   for (const auto& region : fabric_bitstream.regions()) {
     size_t curr_region_num_bits_to_skip = 0;
     for (const FabricBitId& bit_id : fabric_bitstream.region_bits(region)) {
@@ -57,51 +58,40 @@ size_t find_configuration_chain_fabric_bitstream_size_to_be_skipped(const Fabric
       }
       curr_region_num_bits_to_skip++;
     }
-    /* For regional bitstream which is short than the longest region bitstream,
-     * The number of bits to skip 
-     */
-    curr_region_num_bits_to_skip += regional_bitstream_max_size - fabric_bitstream.region_bits(region).size();
-    num_bits_to_skip = std::min(curr_region_num_bits_to_skip, num_bits_to_skip); 
+    regional_num_bits_to_skip.push_back(curr_region_num_bits_to_skip);
   }
 
-  return num_bits_to_skip;
+  return regional_num_bits_to_skip;
 }
 
 /********************************************************************
- * Build a fabric bitstream which can be directly loaded to a configuration 
- * chain (either single-head or multi-bit)
- * We will organize the bitstreams in each region and align them 
- * Logic '0' bits may be deposited to those bitstream whose length is smaller
- * than the maximum bitstream among all the regions
+ * For fast configuration, the number of bits to be skipped
+ * depends on each regional bitstream
  * For example:
- *   Region 0: 000000001111101010 <- max. bitstream length
- *   Region 1:     00000011010101 <- shorter bitstream than the max.; add zeros to the head
- *   Region 2:   0010101111000110 <- shorter bitstream than the max.; add zeros to the head
+ *   Region 0: 000000001111101010
+ *   Region 1:     00000011010101
+ *   Region 2:   0010101111000110
+ * The number of bits that can be skipped is limited by Region 2
+ * when the regional bitstreams are aligned to the longest one
  *******************************************************************/
-ConfigChainFabricBitstream build_config_chain_fabric_bitstream_by_region(const BitstreamManager& bitstream_manager,
-                                                                         const FabricBitstream& fabric_bitstream) {
-  /* Find the longest bitstream */
+size_t find_configuration_chain_fabric_bitstream_size_to_be_skipped(const FabricBitstream& fabric_bitstream,
+                                                                    const BitstreamManager& bitstream_manager,
+                                                                    const bool& bit_value_to_skip) {
   size_t regional_bitstream_max_size = find_fabric_regional_bitstream_max_size(fabric_bitstream);
 
-  ConfigChainFabricBitstream regional_bitstreams;
-  regional_bitstreams.reserve(fabric_bitstream.regions().size());
-  for (const FabricBitRegionId& region : fabric_bitstream.regions()) {
-    std::vector<bool> curr_regional_bitstream;
-    curr_regional_bitstream.resize(regional_bitstream_max_size, false);
-    /* Starting index should consider the offset between the current bitstream size and 
-     * the maximum size of regional bitstream
+  std::vector<size_t> regional_num_bits_to_skip = find_configuration_chain_fabric_regional_bitstream_sizes_to_be_skipped(fabric_bitstream, bitstream_manager, bit_value_to_skip);
+
+  size_t num_bits_to_skip = size_t(-1);
+  for (const auto& region : fabric_bitstream.regions()) {
+    /* For regional bitstream which is short than the longest region bitstream,
+     * The padding bits at the head can be skipped as well
      */
-    size_t offset = regional_bitstream_max_size - fabric_bitstream.region_bits(region).size();
-    for (const FabricBitId& bit_id : fabric_bitstream.region_bits(region)) {
-      curr_regional_bitstream[offset] = bitstream_manager.bit_value(fabric_bitstream.config_bit(bit_id));
-      offset++;
-    }
-    VTR_ASSERT(offset == regional_bitstream_max_size);
-   
-    /* Add the adapt sub-bitstream */
-    regional_bitstreams.push_back(curr_regional_bitstream);
+    size_t curr_region_num_bits_to_skip = regional_num_bits_to_skip[size_t(region)]
+                                        + regional_bitstream_max_size - fabric_bitstream.region_bits(region).size();
+    num_bits_to_skip = std::min(curr_region_num_bits_to_skip, num_bits_to_skip); 
   }
-  return regional_bitstreams;
+
+  return num_bits_to_skip;
 }
 
 /********************************************************************
@@ -113,80 +103,47 @@ ConfigChainFabricBitstream build_config_chain_fabric_bitstream_by_region(const B
  * An example:
  *   000000 1011
  *
- * Note: the std::map may cause large memory footprint for large bitstream databases!
+ * Note that don't care bits in addresses are expanded,
+ * so that each address consists of only '0' and '1'
+ *
+ * When each frame loads W bits, there are W data inputs per region,
+ * where the data input (region * W + i) is the i-th bit of the frame of a region,
+ * the same as the data input port of the top-level module
+ *
+ * When the words of bits are kept, the data inputs can be updated
+ * by update_fabric_bitstream_by_address_dins() 
  *******************************************************************/
-FrameFabricBitstream build_frame_based_fabric_bitstream_by_address(const FabricBitstream& fabric_bitstream) {
-  FrameFabricBitstream fabric_bits_by_addr;
+FabricBitstreamByAddress build_frame_based_fabric_bitstream_by_address(const FabricBitstream& fabric_bitstream,
+                                                                       const bool& keep_bit_words) {
+  FabricBitstreamByAddress fabric_bits_by_addr;
+
+  size_t address_length = 0;
+  if (0 < fabric_bitstream.num_bits()) {
+    address_length = fabric_bitstream.bit_address(*fabric_bitstream.bits().begin()).size();
+  }
+  size_t data_width = fabric_bitstream.data_width();
+  fabric_bits_by_addr.reset(address_length, 0, fabric_bitstream.num_regions() * data_width);
+
   for (const FabricBitRegionId& region : fabric_bitstream.regions()) {
     for (const FabricBitId& bit_id : fabric_bitstream.region_bits(region)) {
       /* Create string for address */
-      std::string addr_str;
-      for (const char& addr_bit : fabric_bitstream.bit_address(bit_id)) {
-        addr_str.push_back(addr_bit);
-      }
+      std::string addr_str = fabric_bitstream.bit_address(bit_id).to_string();
 
       /* Expand all the don't care bits */
       for (const std::string& curr_addr_str : expand_dont_care_bin_str(addr_str)) {
         /* Place the config bit */
-        auto result = fabric_bits_by_addr.find(curr_addr_str);
-        if (result == fabric_bits_by_addr.end()) {
-          /* This is a new bit, resize the vector to the number of regions
-           * and deposit '0' to all the bits
-           */
-          fabric_bits_by_addr[curr_addr_str] = std::vector<bool>(fabric_bitstream.regions().size(), false);
-          fabric_bits_by_addr[curr_addr_str][size_t(region)] = fabric_bitstream.bit_din(bit_id);
-        } else {
-          VTR_ASSERT_SAFE(result != fabric_bits_by_addr.end());
-          result->second[size_t(region)] = fabric_bitstream.bit_din(bit_id);
-        }
+        fabric_bits_by_addr.add_bit(curr_addr_str,
+                                    size_t(region) * data_width + fabric_bitstream.bit_din_index(bit_id),
+                                    fabric_bitstream.bit_din(bit_id));
       }
     }
   }
+
+  fabric_bits_by_addr.build_words(keep_bit_words);
   
   return fabric_bits_by_addr;
 }
 
-/********************************************************************
- * For fast configuration, the number of bits to be skipped
- * the rule to skip any configuration bit should consider the whole data input values.
- * Only all the bits in the din port match the value to be skipped,
- * the programming cycle can be skipped!
- * For example:
- *   Address: 010101
- *     Region 0: 0
- *     Region 1: 1 
- *     Region 2: 0 
- *   This bit cannot be skipped if the bit_value_to_skip is 0
- *
- *   Address: 010101
- *     Region 0: 0
- *     Region 1: 0 
- *     Region 2: 0 
- *   This bit can be skipped if the bit_value_to_skip is 0
- *******************************************************************/
-size_t find_frame_based_fast_configuration_fabric_bitstream_size(const FabricBitstream& fabric_bitstream,
-                                                                 const bool& bit_value_to_skip) {
-  FrameFabricBitstream fabric_bits_by_addr = build_frame_based_fabric_bitstream_by_address(fabric_bitstream);
-
-  size_t num_bits = 0;
-
-  for (const auto& addr_din_pair : fabric_bits_by_addr) {
-    bool skip_curr_bits = true;
-    for (const bool& bit : addr_din_pair.second) {
-      if (bit_value_to_skip != bit) {
-        skip_curr_bits = false;
-        break;
-      }
-    }
-
-    if (false == skip_curr_bits) {
-      num_bits++;
-    }
-  }
-
-  return num_bits;
-}
-
 /********************************************************************
  * Reorganize the fabric bitstream for memory banks
  * by the same address across regions:
@@ -196,78 +153,119 @@ size_t find_frame_based_fast_configuration_fabric_bitstream_size(const FabricBit
  * An example:
  *   000000  00000 1011
  *
- * Note: the std::map may cause large memory footprint for large bitstream databases!
+ * When the words of bits are kept, the data inputs can be updated
+ * by update_fabric_bitstream_by_address_dins() 
  *******************************************************************/
-MemoryBankFabricBitstream build_memory_bank_fabric_bitstream_by_address(const FabricBitstream& fabric_bitstream) {
-  MemoryBankFabricBitstream fabric_bits_by_addr;
+FabricBitstreamByAddress build_memory_bank_fabric_bitstream_by_address(const FabricBitstream& fabric_bitstream,
+                                                                       const bool& keep_bit_words) {
+  FabricBitstreamByAddress fabric_bits_by_addr;
+
+  size_t bl_address_length = 0;
+  size_t wl_address_length = 0;
+  if (0 < fabric_bitstream.num_bits()) {
+    bl_address_length = fabric_bitstream.bit_bl_address(*fabric_bitstream.bits().begin()).size();
+    wl_address_length = fabric_bitstream.bit_wl_address(*fabric_bitstream.bits().begin()).size();
+  }
+  fabric_bits_by_addr.reset(bl_address_length, wl_address_length, fabric_bitstream.num_regions());
+
+  /* A single string is reused for the addresses of all the bits */
+  std::string addr_str(bl_address_length + wl_address_length, '0');
   for (const FabricBitRegionId& region : fabric_bitstream.regions()) {
     for (const FabricBitId& bit_id : fabric_bitstream.region_bits(region)) {
-      /* Create string for BL address */
-      std::string bl_addr_str;
-      for (const char& addr_bit : fabric_bitstream.bit_bl_address(bit_id)) {
-        bl_addr_str.push_back(addr_bit);
+      /* Fill the string with BL address followed by WL address */
+      FabricBitAddressView bl_address = fabric_bitstream.bit_bl_address(bit_id);
+      FabricBitAddressView wl_address = fabric_bitstream.bit_wl_address(bit_id);
+      for (size_t ichar = 0; ichar < bl_address_length; ++ichar) {
+        addr_str[ichar] = bl_address[ichar];
       }
-
-      /* Create string for WL address */
-      std::string wl_addr_str;
-      for (const char& addr_bit : fabric_bitstream.bit_wl_address(bit_id)) {
-        wl_addr_str.push_back(addr_bit);
+      for (size_t ichar = 0; ichar < wl_address_length; ++ichar) {
+        addr_str[bl_address_length + ichar] = wl_address[ichar];
       }
 
       /* Place the config bit */
-      auto result = fabric_bits_by_addr.find(std::make_pair(bl_addr_str, wl_addr_str));
-      if (result == fabric_bits_by_addr.end()) {
-        /* This is a new bit, resize the vector to the number of regions
-         * and deposit '0' to all the bits
-         */
-        fabric_bits_by_addr[std::make_pair(bl_addr_str, wl_addr_str)] = std::vector<bool>(fabric_bitstream.regions().size(), false);
-        fabric_bits_by_addr[std::make_pair(bl_addr_str, wl_addr_str)][size_t(region)] = fabric_bitstream.bit_din(bit_id);
-      } else {
-        VTR_ASSERT_SAFE(result != fabric_bits_by_addr.end());
-        result->second[size_t(region)] = fabric_bitstream.bit_din(bit_id);
-      }
+      fabric_bits_by_addr.add_bit(addr_str, size_t(region), fabric_bitstream.bit_din(bit_id));
     }
   }
 
+  fabric_bits_by_addr.build_words(keep_bit_words);
+
   return fabric_bits_by_addr;
 }
 
+/********************************************************************
+ * Reorganize the fabric bitstream by addresses for a given configuration protocol
+ * Return an empty organization if the configuration protocol does not use addresses
+ *******************************************************************/
+FabricBitstreamByAddress build_fabric_bitstream_by_address(const FabricBitstream& fabric_bitstream,
+                                                           const e_config_protocol_type& config_protocol_type,
+                                                           const bool& keep_bit_words) {
+  if (CONFIG_MEM_MEMORY_BANK == config_protocol_type) {
+    return build_memory_bank_fabric_bitstream_by_address(fabric_bitstream, keep_bit_words);
+  } else if (CONFIG_MEM_FRAME_BASED == config_protocol_type) {
+    return build_frame_based_fabric_bitstream_by_address(fabric_bitstream, keep_bit_words);
+  }
+  return FabricBitstreamByAddress();
+}
+
+/********************************************************************
+ * Update the data inputs of a fabric bitstream organized by addresses
+ * after the data inputs of the fabric bitstream are changed, 
+ * without sorting the addresses again.
+ * The organization should have been built from the same fabric bitstream
+ * with the words of bits kept. The bits are visited in the same sequence
+ * as they were added by the builders above, where each bit of frame-based
+ * protocol is added once for each expansion of the don't care bits of its address
+ *******************************************************************/
+void update_fabric_bitstream_by_address_dins(FabricBitstreamByAddress& fabric_bits_by_addr,
+                                             const FabricBitstream& fabric_bitstream,
+                                             const e_config_protocol_type& config_protocol_type) {
+  if ( (CONFIG_MEM_MEMORY_BANK != config_protocol_type)
+    && (CONFIG_MEM_FRAME_BASED != config_protocol_type) ) {
+    return;
+  }
+
+  size_t ibit = 0;
+  for (const FabricBitRegionId& region : fabric_bitstream.regions()) {
+    for (const FabricBitId& bit_id : fabric_bitstream.region_bits(region)) {
+      size_t num_expanded_bits = 1;
+      if (CONFIG_MEM_FRAME_BASED == config_protocol_type) {
+        FabricBitAddressView address = fabric_bitstream.bit_address(bit_id);
+        num_expanded_bits = size_t(1) << std::count(address.begin(), address.end(), DONT_CARE_CHAR);
+      }
+      for (size_t iexpand = 0; iexpand < num_expanded_bits; ++iexpand) {
+        fabric_bits_by_addr.set_bit_din(ibit, fabric_bitstream.bit_din(bit_id));
+        ibit++;
+      }
+    }
+  }
+}
+
 /********************************************************************
  * For fast configuration, the number of bits to be skipped
  * the rule to skip any configuration bit should consider the whole data input values.
  * Only all the bits in the din port match the value to be skipped,
  * the programming cycle can be skipped!
  * For example:
- *   BL Address: 010101
- *   WL Address: 010101
+ *   Address: 010101
  *     Region 0: 0
  *     Region 1: 1 
  *     Region 2: 0 
  *   This bit cannot be skipped if the bit_value_to_skip is 0
  *
- *   BL Address: 010101
- *   WL Address: 010101
+ *   Address: 010101
  *     Region 0: 0
  *     Region 1: 0 
  *     Region 2: 0 
  *   This bit can be skipped if the bit_value_to_skip is 0
+ *
+ * This is applicable to both frame-based and memory bank protocols
  *******************************************************************/
-size_t find_memory_bank_fast_configuration_fabric_bitstream_size(const FabricBitstream& fabric_bitstream,
-                                                                 const bool& bit_value_to_skip) {
-  MemoryBankFabricBitstream fabric_bits_by_addr = build_memory_bank_fabric_bitstream_by_address(fabric_bitstream);
-
+size_t find_fast_configuration_fabric_bitstream_by_address_size(const FabricBitstreamByAddress& fabric_bits_by_addr,
+                                                                const bool& bit_value_to_skip) {
   size_t num_bits = 0;
 
-  for (const auto& addr_din_pair : fabric_bits_by_addr) {
-    bool skip_curr_bits = true;
-    for (const bool& bit : addr_din_pair.second) {
-      if (bit_value_to_skip != bit) {
-        skip_curr_bits = false;
-        break;
-      }
-    }
-
-    if (false == skip_curr_bits) {
+  for (size_t iword = 0; iword < fabric_bits_by_addr.num_words(); ++iword) {
+    if (false == fabric_bits_by_addr.word_dins_equal(iword, bit_value_to_skip)) {
       num_bits++;
     }
   }
@@ -8,9 +8,10 @@
  * Include header files that are required by function declaration
  *******************************************************************/
 #include <vector>
-#include <map>
+#include "circuit_types.h"
 #include "bitstream_manager.h"
 #include "fabric_bitstream.h"
+#include "fabric_bitstream_by_address.h"
 
 /********************************************************************
  * Function declaration
@@ -21,28 +22,31 @@ namespace openfpga {
 
 size_t find_fabric_regional_bitstream_max_size(const FabricBitstream& fabric_bitstream);
 
+std::vector<size_t> find_configuration_chain_fabric_regional_bitstream_sizes_to_be_skipped(const FabricBitstream& fabric_bitstream,
+                                                                                           const BitstreamManager& bitstream_manager,
+                                                                                           const bool& bit_value_to_skip);
+
 size_t find_configuration_chain_fabric_bitstream_size_to_be_skipped(const FabricBitstream& fabric_bitstream,
                                                                     const BitstreamManager& bitstream_manager,
                                                                     const bool& bit_value_to_skip);
 
-/* Alias to a specific organization of bitstreams for frame-based configuration protocol */
-typedef std::vector<std::vector<bool>> ConfigChainFabricBitstream;
-ConfigChainFabricBitstream build_config_chain_fabric_bitstream_by_region(const BitstreamManager& bitstream_manager,
-                                                                         const FabricBitstream& fabric_bitstream);
+/* Organizations of bitstreams for frame-based and memory bank configuration protocols */
+FabricBitstreamByAddress build_frame_based_fabric_bitstream_by_address(const FabricBitstream& fabric_bitstream,
+                                                                       const bool& keep_bit_words = false);
 
-/* Alias to a specific organization of bitstreams for frame-based configuration protocol */
-typedef std::map<std::string, std::vector<bool>> FrameFabricBitstream;
-FrameFabricBitstream build_frame_based_fabric_bitstream_by_address(const FabricBitstream& fabric_bitstream);
+FabricBitstreamByAddress build_memory_bank_fabric_bitstream_by_address(const FabricBitstream& fabric_bitstream,
+                                                                       const bool& keep_bit_words = false);
 
-size_t find_frame_based_fast_configuration_fabric_bitstream_size(const FabricBitstream& fabric_bitstream,
-                                                                 const bool& bit_value_to_skip);
+FabricBitstreamByAddress build_fabric_bitstream_by_address(const FabricBitstream& fabric_bitstream,
+                                                           const e_config_protocol_type& config_protocol_type,
+                                                           const bool& keep_bit_words = false);
 
-/* Alias to a specific organization of bitstreams for memory bank configuration protocol */
-typedef std::map<std::pair<std::string, std::string>, std::vector<bool>> MemoryBankFabricBitstream;
-MemoryBankFabricBitstream build_memory_bank_fabric_bitstream_by_address(const FabricBitstream& fabric_bitstream);
+void update_fabric_bitstream_by_address_dins(FabricBitstreamByAddress& fabric_bits_by_addr,
+                                             const FabricBitstream& fabric_bitstream,
+                                             const e_config_protocol_type& config_protocol_type);
 
-size_t find_memory_bank_fast_configuration_fabric_bitstream_size(const FabricBitstream& fabric_bitstream,
-                                                                 const bool& bit_value_to_skip);
+size_t find_fast_configuration_fabric_bitstream_by_address_size(const FabricBitstreamByAddress& fabric_bits_by_addr,
+                                                                const bool& bit_value_to_skip);
 
 } /* end namespace openfpga */
 
@@ -2,7 +2,9 @@
  * This file includes most utilized functions to manipulate LUTs, 
  * especially their truth tables, in the OpenFPGA context
  *******************************************************************/
+#include <algorithm>
 #include <cmath>
+#include <cstdint>
 
 /* Headers from vtrutil library */
 #include "vtr_assert.h"
@@ -16,6 +18,103 @@
 /* begin namespace openfpga */
 namespace openfpga {
 
+/********************************************************************
+ * A compact form of a truth table line (a cube), where the values of
+ * inputs are packed into 64-bit words
+ *  - bit i of care_bits is set when input i is either '0' or '1'
+ *  - bit i of value_bits is the value of input i when it is cared
+ * Truth tables are converted to cubes when entering the functions
+ * of this file and converted back when leaving, so that lines are
+ * manipulated by word operations without allocating memory per line
+ *******************************************************************/
+struct t_lut_cube {
+  size_t num_inputs;
+  uint64_t care_bits;
+  uint64_t value_bits;
+  vtr::LogicValue output;
+};
+
+constexpr size_t LUT_CUBE_MAX_NUM_INPUTS = 64;
+
+/********************************************************************
+ * Return a mask where the lowest num_bits bits are set
+ *******************************************************************/
+static 
+uint64_t lut_cube_low_bits_mask(const size_t& num_bits) {
+  VTR_ASSERT(LUT_CUBE_MAX_NUM_INPUTS >= num_bits);
+  if (LUT_CUBE_MAX_NUM_INPUTS == num_bits) {
+    return ~uint64_t(0);
+  }
+  return (uint64_t(1) << num_bits) - 1;
+}
+
+/********************************************************************
+ * Convert a truth table to cubes
+ *******************************************************************/
+static 
+std::vector<t_lut_cube> truth_table_to_lut_cubes(const AtomNetlist::TruthTable& tt) {
+  std::vector<t_lut_cube> cubes;
+  cubes.reserve(tt.size());
+
+  for (const std::vector<vtr::LogicValue>& tt_line : tt) {
+    VTR_ASSERT(0 < tt_line.size());
+    t_lut_cube cube;
+    cube.num_inputs = tt_line.size() - 1;
+    VTR_ASSERT(LUT_CUBE_MAX_NUM_INPUTS >= cube.num_inputs);
+    cube.care_bits = 0;
+    cube.value_bits = 0;
+    for (size_t i = 0; i < cube.num_inputs; ++i) {
+      switch (tt_line[i]) {
+      case vtr::LogicValue::TRUE:
+        cube.value_bits |= uint64_t(1) << i;
+        cube.care_bits |= uint64_t(1) << i;
+        break;
+      case vtr::LogicValue::FALSE:
+        cube.care_bits |= uint64_t(1) << i;
+        break;
+      case vtr::LogicValue::DONT_CARE:
+        break;
+      default:
+        VTR_LOGF_ERROR(__FILE__, __LINE__, 
+                       "Invalid truth_table bit '%s', should be [0|1|-]!\n",
+                       vtr::LOGIC_VALUE_STRING[size_t(tt_line[i])]); 
+        exit(1);
+      }
+    }
+    cube.output = tt_line.back();
+    cubes.push_back(cube);
+  }
+
+  return cubes;
+}
+
+/********************************************************************
+ * Convert cubes back to a truth table
+ *******************************************************************/
+static 
+AtomNetlist::TruthTable lut_cubes_to_truth_table(const std::vector<t_lut_cube>& cubes) {
+  AtomNetlist::TruthTable tt(cubes.size());
+
+  for (size_t iline = 0; iline < cubes.size(); ++iline) {
+    const t_lut_cube& cube = cubes[iline];
+    std::vector<vtr::LogicValue>& tt_line = tt[iline];
+    tt_line.resize(cube.num_inputs + 1, vtr::LogicValue::DONT_CARE);
+    for (size_t i = 0; i < cube.num_inputs; ++i) {
+      if (0 == ((cube.care_bits >> i) & 1)) {
+        continue;
+      }
+      if (1 == ((cube.value_bits >> i) & 1)) {
+        tt_line[i] = vtr::LogicValue::TRUE;
+      } else {
+        tt_line[i] = vtr::LogicValue::FALSE;
+      }
+    }
+    tt_line.back() = cube.output;
+  }
+
+  return tt;
+}
+
 /********************************************************************
  * This function aims to adapt the truth table to a mapped physical LUT 
  * subject to a pin rotation map
@@ -52,29 +151,33 @@ namespace openfpga {
  *******************************************************************/
 AtomNetlist::TruthTable lut_truth_table_adaption(const AtomNetlist::TruthTable& orig_tt, 
                                                  const std::vector<int>& rotated_pin_map) {
-  AtomNetlist::TruthTable tt;
+  VTR_ASSERT(LUT_CUBE_MAX_NUM_INPUTS >= rotated_pin_map.size());
+
+  std::vector<t_lut_cube> cubes = truth_table_to_lut_cubes(orig_tt);
 
-  for (auto row : orig_tt) {
-    VTR_ASSERT(row.size() - 1 <= rotated_pin_map.size());
+  for (t_lut_cube& cube : cubes) {
+    VTR_ASSERT(cube.num_inputs <= rotated_pin_map.size());
 
-    std::vector<vtr::LogicValue> tt_line;
-    /* We do not care about the last digit, which is the output value */
+    uint64_t care_bits = 0;
+    uint64_t value_bits = 0;
+    /* Unused inputs are left as dont care, which is not in care bits */
     for (size_t i = 0; i < rotated_pin_map.size(); ++i) {
       if (-1 == rotated_pin_map[i]) {
-        tt_line.push_back(vtr::LogicValue::DONT_CARE);
-      } else { 
-        /* Ensure we never access the last digit, i.e., the output value! */
-        VTR_ASSERT((size_t)rotated_pin_map[i] < row.size() - 1);
-        tt_line.push_back(row[rotated_pin_map[i]]);
+        continue;
       }
-    } 
+      /* Ensure we never access the last digit, i.e., the output value! */
+      VTR_ASSERT((size_t)rotated_pin_map[i] < cube.num_inputs);
+      care_bits |= ((cube.care_bits >> rotated_pin_map[i]) & 1) << i;
+      value_bits |= ((cube.value_bits >> rotated_pin_map[i]) & 1) << i;
+    }
 
-    /* Do not miss the last digit in the final result */
-    tt_line.push_back(row.back());
-    tt.push_back(tt_line);
+    /* The output value is kept */
+    cube.num_inputs = rotated_pin_map.size();
+    cube.care_bits = care_bits;
+    cube.value_bits = value_bits;
   }
 
-  return tt;
+  return lut_cubes_to_truth_table(cubes);
 } 
 
 /********************************************************************
@@ -188,44 +291,30 @@ AtomNetlist::TruthTable adapt_truth_table_for_frac_lut(const size_t& lut_frac_le
     return truth_table;
   }
 
-  AtomNetlist::TruthTable adapt_truth_table;
+  std::vector<t_lut_cube> cubes = truth_table_to_lut_cubes(truth_table);
 
   /* Apply modification to the truth table */
-  for (const std::vector<vtr::LogicValue>& tt_line : truth_table) {
-    /* Last element is the output */
-    size_t lut_size = tt_line.size() - 1;
+  for (t_lut_cube& cube : cubes) {
     /* Get the number of bits to be masked (modified) */
-    int num_mask_bits = lut_size - lut_frac_level;
+    int num_mask_bits = cube.num_inputs - lut_frac_level;
     /* Check if we need to modify any bits */
     VTR_ASSERT(0 <= num_mask_bits);
     if ( 0 == num_mask_bits ) {
-      /* No modification needed, push to adapted truth table */
-      adapt_truth_table.push_back(tt_line);
+      /* No modification needed */
       continue;
     }
     /* Modify bits starting from lut_frac_level */
-    /* Decode the lut_output_mask to LUT input codes */ 
+    /* Decode the lut_output_mask to LUT input codes, 
+     * where the least significant bit is applied to the input at lut_frac_level
+     */ 
     int temp = pow(2., num_mask_bits) - 1 - lut_output_mask;
     VTR_ASSERT(0 <= temp);
-    std::vector<size_t> mask_bits_vec = itobin_vec(temp, num_mask_bits);
-    /* Copy the bits to the truth table line */
-    std::vector<vtr::LogicValue> adapt_tt_line = tt_line;
-    for (size_t itt = lut_frac_level; itt < lut_frac_level + mask_bits_vec.size(); ++itt) { 
-      
-      vtr::LogicValue logic_val = vtr::LogicValue::FALSE;
-      VTR_ASSERT( (1 == mask_bits_vec[itt - lut_frac_level])
-               || (0 == mask_bits_vec[itt - lut_frac_level]) );
-      if (1 == mask_bits_vec[itt - lut_frac_level]) {
-        logic_val = vtr::LogicValue::TRUE;
-      }
-      adapt_tt_line[itt] = logic_val;
-    }
-
-    /* Push to adapted truth table */
-    adapt_truth_table.push_back(adapt_tt_line);
+    uint64_t mask_bits = lut_cube_low_bits_mask(num_mask_bits) << lut_frac_level;
+    cube.care_bits |= mask_bits;
+    cube.value_bits = (cube.value_bits & ~mask_bits) | (uint64_t(temp) << lut_frac_level);
   }
 
-  return adapt_truth_table;
+  return lut_cubes_to_truth_table(cubes);
 }
 
 /********************************************************************
@@ -264,114 +353,66 @@ bool lut_truth_table_use_on_set(const AtomNetlist::TruthTable& truth_table) {
 }
 
 /********************************************************************
- * Complete a line in truth table with a given lut size
- * Due to the size of truth table may be less than the lut size.
- * i.e. in LUT-6 architecture, there exists LUT1-6 in technology-mapped netlists
- * So, in truth table line, there may be 10- 1
- * In this case, we should complete it by --10- 1
- *******************************************************************/
-static 
-std::vector<vtr::LogicValue> complete_truth_table_line(const size_t& lut_size,
-                                                       const std::vector<vtr::LogicValue>& tt_line) {
-  std::vector<vtr::LogicValue> ret;
-
-  VTR_ASSERT(0 < tt_line.size());
-
-  /* Complete the truth table line*/
-  size_t cover_len = tt_line.size() - 1; 
-  VTR_ASSERT(cover_len <= lut_size);
-
-  /* Copy the original truth table line */ 
-  ret = tt_line;
-  /* Kick out the last value for now as it is the output value */
-  ret.pop_back();
-
-  /* Add the number of '-' we should add in the back !!! */
-  for (size_t j = cover_len; j < lut_size; ++j) {
-    ret.push_back(vtr::LogicValue::DONT_CARE);
-  }
-
-  /* Copy the original truth table line */ 
-  ret.push_back(tt_line.back());
-
-  /* Check if the size of ret matches our expectation */
-  VTR_ASSERT(lut_size + 1 == ret.size());
-  
-  return ret;
-}
-
-/********************************************************************
- * For each lut_bit_lines, we should recover the truth table,
- * and then set the sram bits to "1" if the truth table defines so.
- * Start_point: the position we start converting don't care sign '-'
- *              to explicit '0' or '1'
+ * Set the SRAM bits covered by a truth table line to the output value
+ * of the line. The SRAM bits are packed in 64-bit words.
+ *
+ * The i-th bit of the index of a SRAM bit is '1' when the i-th input is '0'
+ * (the 1-lut passes sram1 when input = 0 and sram0 when input = 1).
+ * Rather than expanding the dont cares of the line one by one,
+ *  - the inputs [0, 6) select bits inside a word, whose patterns are
+ *    combined into a single word mask
+ *  - the other inputs select words, which are compared at once
+ * Truth table lines shorter than the LUT size are completed by
+ * dont cares for the missing inputs (e.g., 10- 1 -> 10--- 1)
  *******************************************************************/
 static 
-void rec_build_lut_bitstream_per_line(std::vector<bool>& lut_bitstream, 
-                                      const size_t& lut_size,
-                                      const std::vector<vtr::LogicValue>& tt_line,
-                                      const size_t& start_point) {
-  std::vector<vtr::LogicValue> temp_line = tt_line;
-
-  /* Check the length of sram bits and truth table line */
-  VTR_ASSERT(lut_size + 1 == tt_line.size()); /* lut_size + '1|0' */
+void build_lut_bitstream_per_cube(std::vector<uint64_t>& sram_words, 
+                                  const size_t& lut_size,
+                                  const t_lut_cube& cube) {
+  /* Patterns of SRAM bits inside a word whose index has the i-th bit set */
+  static const uint64_t SRAM_INDEX_BIT_PATTERNS[] = {
+    0xAAAAAAAAAAAAAAAAULL, 0xCCCCCCCCCCCCCCCCULL, 0xF0F0F0F0F0F0F0F0ULL,
+    0xFF00FF00FF00FF00ULL, 0xFFFF0000FFFF0000ULL, 0xFFFFFFFF00000000ULL
+  };
+  constexpr size_t NUM_WORD_INDEX_BITS = 6;
+
+  VTR_ASSERT(cube.num_inputs <= lut_size);
 
   /* End of truth_table_line should be "space" and "1" */ 
-  VTR_ASSERT( (vtr::LogicValue::TRUE == tt_line.back())
-           || (vtr::LogicValue::FALSE == tt_line.back()) );
-
-  /* Make sure before start point there is no '-' */
-  VTR_ASSERT(start_point < tt_line.size());
-  for (size_t i = 0; i < start_point; ++i) {
-    VTR_ASSERT(vtr::LogicValue::DONT_CARE != tt_line[i]);
+  if ( (vtr::LogicValue::TRUE != cube.output)
+    && (vtr::LogicValue::FALSE != cube.output) ) {
+    VTR_LOGF_ERROR(__FILE__, __LINE__, 
+                   "Invalid truth_table_line ending '%s'!\n",
+                   vtr::LOGIC_VALUE_STRING[size_t(cube.output)]);
+    exit(1);
   }
 
-  /* Configure sram bits recursively */
-  for (size_t i = start_point; i < lut_size; ++i) {
-    if (vtr::LogicValue::DONT_CARE == tt_line[i]) {
-      /* if we find a dont_care, we don't do configure now but recursively*/
-      /* '0' branch */
-      temp_line[i] = vtr::LogicValue::FALSE; 
-      rec_build_lut_bitstream_per_line(lut_bitstream, lut_size, temp_line, start_point + 1);
-      /* '1' branch */
-      temp_line[i] = vtr::LogicValue::TRUE; 
-      rec_build_lut_bitstream_per_line(lut_bitstream, lut_size, temp_line, start_point + 1);
-      return; 
+  /* Expected bits of the SRAM index, for the cared inputs only */
+  uint64_t index_bits = ~cube.value_bits & cube.care_bits;
+
+  uint64_t word_mask = ~uint64_t(0);
+  for (size_t i = 0; i < std::min(NUM_WORD_INDEX_BITS, lut_size); ++i) {
+    if (0 == ((cube.care_bits >> i) & 1)) {
+      continue;
+    }
+    if (1 == ((index_bits >> i) & 1)) {
+      word_mask &= SRAM_INDEX_BIT_PATTERNS[i];
+    } else {
+      word_mask &= ~SRAM_INDEX_BIT_PATTERNS[i];
     }
   }
 
-  /* TODO: Use MuxGraph to decode this!!! */
-  /* Decode bitstream only when there are only 0 or 1 in the truth table */
-  size_t sram_id = 0;
-  for (size_t i = 0; i < lut_size; ++i) {
-    /* Should be either '0' or '1' */
-    switch (tt_line[i]) {
-    case vtr::LogicValue::FALSE :
-      /* We assume the 1-lut pass sram1 when input = 0 */
-      sram_id += (size_t)pow(2., (double)(i));
-      break;
-    case vtr::LogicValue::TRUE :
-      /* We assume the 1-lut pass sram0 when input = 1 */
-      break;
-    case vtr::LogicValue::DONT_CARE :
-    default :
-      VTR_LOGF_ERROR(__FILE__, __LINE__, 
-                     "Invalid truth_table bit '%s', should be [0|1|]!\n",
-                     vtr::LOGIC_VALUE_STRING[size_t(tt_line[i])]); 
-      exit(1);
+  uint64_t word_care_bits = cube.care_bits >> NUM_WORD_INDEX_BITS;
+  uint64_t word_index_bits = index_bits >> NUM_WORD_INDEX_BITS;
+  for (size_t iword = 0; iword < sram_words.size(); ++iword) {
+    if (0 != ((iword ^ word_index_bits) & word_care_bits)) {
+      continue;
+    }
+    if (vtr::LogicValue::TRUE == cube.output) {
+      sram_words[iword] |= word_mask; /* on set */
+    } else {
+      sram_words[iword] &= ~word_mask; /* off set */
     }
-  }
-  /* Set the sram bit to '1'*/
-  VTR_ASSERT(sram_id < lut_bitstream.size());
-  if (vtr::LogicValue::TRUE == tt_line.back()) {
-    lut_bitstream[sram_id] = true; /* on set*/
-  } else if (vtr::LogicValue::FALSE == tt_line.back()) {
-    lut_bitstream[sram_id] = false; /* off set */
-  } else {
-    VTR_LOGF_ERROR(__FILE__, __LINE__, 
-                   "Invalid truth_table_line ending '%s'!\n",
-                   vtr::LOGIC_VALUE_STRING[size_t(tt_line.back())]);
-    exit(1);
   }
 }
 
@@ -387,8 +428,6 @@ std::vector<bool> build_single_output_lut_bitstream(const AtomNetlist::TruthTabl
                                                     const size_t& default_sram_bit_value) {
   size_t lut_size = lut_mux_graph.num_memory_bits();
   size_t bitstream_size = lut_mux_graph.num_inputs();
-  std::vector<bool> lut_bitstream(bitstream_size, false);
-  AtomNetlist::TruthTable completed_truth_table;
   bool on_set = false;
   bool off_set = false;
 
@@ -414,24 +453,26 @@ std::vector<bool> build_single_output_lut_bitstream(const AtomNetlist::TruthTabl
     off_set = !on_set;
   }
 
-  /* Read in truth table lines, decode one by one */
-  for (const std::vector<vtr::LogicValue>& tt_line : truth_table) {
-    /* Complete the truth table line by line*/
-    completed_truth_table.push_back(complete_truth_table_line(lut_size, tt_line));
-  }
+  /* Each input combination of the LUT must have a SRAM bit */
+  VTR_ASSERT(LUT_CUBE_MAX_NUM_INPUTS > lut_size);
+  size_t num_sram_bits = size_t(1) << lut_size;
+  VTR_ASSERT(num_sram_bits <= bitstream_size);
 
-  /* Initial all the bits in the bitstream */
-  if (true == off_set) {
-    /* By default, the lut_bitstream is initialize for on_set
-     * For off set, it should be flipped
-     */
-    lut_bitstream.clear(); 
-    lut_bitstream.resize(bitstream_size, true);
+  /* Initial all the bits in the bitstream
+   * By default, the lut_bitstream is initialize for on_set
+   * For off set, it should be flipped
+   */
+  std::vector<uint64_t> sram_words((num_sram_bits + 63) / 64, true == off_set ? ~uint64_t(0) : 0);
+
+  /* Read in truth table lines, decode one by one */
+  for (const t_lut_cube& cube : truth_table_to_lut_cubes(truth_table)) {
+    /* Update the sram bits */
+    build_lut_bitstream_per_cube(sram_words, lut_size, cube);
   }
 
-  for (const std::vector<vtr::LogicValue>& tt_line : completed_truth_table) {
-    /* Update the truth table, sram_bits */
-    rec_build_lut_bitstream_per_line(lut_bitstream, lut_size, tt_line, 0);
+  std::vector<bool> lut_bitstream(bitstream_size, off_set);
+  for (size_t ibit = 0; ibit < num_sram_bits; ++ibit) {
+    lut_bitstream[ibit] = (1 == ((sram_words[ibit / 64] >> (ibit % 64)) & 1));
   }
 
   return lut_bitstream;
@@ -451,7 +492,7 @@ std::vector<bool> build_frac_lut_bitstream(const CircuitLibrary& circuit_lib,
   /* Initialization */
   std::vector<bool> lut_bitstream(lut_mux_graph.num_inputs(), default_sram_bit_value);
 
-  for (const std::pair<const t_pb_graph_pin*, AtomNetlist::TruthTable>& element : truth_tables) {
+  for (const std::pair<const t_pb_graph_pin* const, AtomNetlist::TruthTable>& element : truth_tables) {
     /* Find the corresponding circuit model output port and assoicated lut_output_mask */
     CircuitPortId lut_model_output_port = device_annotation.pb_circuit_port(element.first->port);
     size_t lut_frac_level = circuit_lib.port_lut_frac_level(lut_model_output_port);
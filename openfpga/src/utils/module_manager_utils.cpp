@@ -9,9 +9,12 @@
 /* Headers from vtrutil library */
 #include "vtr_log.h"
 #include "vtr_assert.h"
+#include "vtr_hash.h"
 
 /* Headers from openfpgautil library */
 #include "openfpga_port.h"
+#include "openfpga_parallel.h"
+#include "openfpga_progress.h"
 
 #include "openfpga_reserved_words.h"
 #include "openfpga_naming.h"
@@ -30,6 +33,10 @@ namespace openfpga {
  * Reserved a number of module nets for a given module
  * based on the number of output ports of its child modules
  * for memory efficiency
+ * The nets to the global and I/O ports of child modules are counted as well,
+ * as one net is created for each pin of each child instance,
+ * including those to be added by add_module_global_ports_from_child_modules()
+ * and add_module_gpio_ports_from_child_modules() after this function 
  ******************************************************************************/
 void reserve_module_manager_module_nets(ModuleManager& module_manager, 
                                         const ModuleId& parent_module) {
@@ -71,6 +78,16 @@ void reserve_module_manager_module_nets(ModuleManager& module_manager,
     }
 
     num_nets += total_output_port_sizes * num_instances;
+
+    /* Sum up the port sizes for all the global and I/O input ports */
+    size_t total_global_port_sizes = 0;
+    for (const auto& port_type : {ModuleManager::MODULE_GLOBAL_PORT, ModuleManager::MODULE_GPIN_PORT, ModuleManager::MODULE_GPIO_PORT}) {
+      for (const BasicPort& port : module_manager.module_ports_by_type(child_module, port_type)) {
+        total_global_port_sizes += port.get_width();
+      }
+    }
+
+    num_nets += total_global_port_sizes * num_instances;
   }
   
   module_manager.reserve_module_nets(parent_module, num_nets);
@@ -299,14 +316,16 @@ void add_formal_verification_sram_ports_to_module_manager(ModuleManager& module_
  *    - An Enable signal
  *    - An address port, whose size depends on the number of config bits 
  *      and the maximum size of address ports of configurable children
- *    - An data_in port (single-bit)
+ *    - An data_in port, whose size is the number of bits loaded per frame,
+ *      i.e., frame_data_width
  ********************************************************************/
 void add_sram_ports_to_module_manager(ModuleManager& module_manager, 
                                       const ModuleId& module_id,
                                       const CircuitLibrary& circuit_lib,
                                       const CircuitModelId& sram_model,
                                       const e_config_protocol_type sram_orgz_type,
-                                      const size_t& num_config_bits) {
+                                      const size_t& num_config_bits,
+                                      const size_t& frame_data_width) {
   std::vector<std::string> sram_port_names = generate_sram_port_names(circuit_lib, sram_model, sram_orgz_type);
   size_t sram_port_size = generate_sram_port_size(sram_orgz_type, num_config_bits); 
 
@@ -348,7 +367,8 @@ void add_sram_ports_to_module_manager(ModuleManager& module_manager,
     BasicPort addr_port(std::string(DECODER_ADDRESS_PORT_NAME), num_config_bits);
     module_manager.add_port(module_id, addr_port, ModuleManager::MODULE_INPUT_PORT);
 
-    BasicPort din_port(std::string(DECODER_DATA_IN_PORT_NAME), 1);
+    VTR_ASSERT(0 < frame_data_width);
+    BasicPort din_port(std::string(DECODER_DATA_IN_PORT_NAME), frame_data_width);
     module_manager.add_port(module_id, din_port, ModuleManager::MODULE_INPUT_PORT);
 
     break;
@@ -446,16 +466,16 @@ bool module_net_is_local_wire(const ModuleManager& module_manager,
   /* Check all the sink modules of the net, 
    * if we have a source module is the current module, this is not local wire 
    */
-  for (ModuleId src_module : module_manager.net_source_modules(module_id, module_net)) {
-    if (module_id == src_module) {
+  for (ModuleNetSrcId net_src : module_manager.module_net_sources(module_id, module_net)) {
+    if (module_id == module_manager.net_source_module(module_id, module_net, net_src)) {
       /* Here, this is not a local wire */
       return false;
     }
   }
 
   /* Check all the sink modules of the net */
-  for (ModuleId sink_module : module_manager.net_sink_modules(module_id, module_net)) {
-    if (module_id == sink_module) {
+  for (ModuleNetSinkId net_sink : module_manager.module_net_sinks(module_id, module_net)) {
+    if (module_id == module_manager.net_sink_module(module_id, module_net, net_sink)) {
       /* Here, this is not a local wire */
       return false;
     }
@@ -483,8 +503,8 @@ bool module_net_include_output_short_connection(const ModuleManager& module_mana
                                                 const ModuleId& module_id, const ModuleNetId& module_net) {
   /* Check all the sink modules of the net */
   size_t contain_num_module_output = 0;
-  for (ModuleId sink_module : module_manager.net_sink_modules(module_id, module_net)) {
-    if (module_id == sink_module) {
+  for (ModuleNetSinkId net_sink : module_manager.module_net_sinks(module_id, module_net)) {
+    if (module_id == module_manager.net_sink_module(module_id, module_net, net_sink)) {
       contain_num_module_output++;
     }
   }
@@ -513,8 +533,8 @@ bool module_net_include_local_short_connection(const ModuleManager& module_manag
    * if we have a source module is the current module, this is not local wire 
    */
   bool contain_module_input = false;
-  for (ModuleId src_module : module_manager.net_source_modules(module_id, module_net)) {
-    if (module_id == src_module) {
+  for (ModuleNetSrcId net_src : module_manager.module_net_sources(module_id, module_net)) {
+    if (module_id == module_manager.net_source_module(module_id, module_net, net_src)) {
       contain_module_input = true;
       break;
     }
@@ -522,8 +542,8 @@ bool module_net_include_local_short_connection(const ModuleManager& module_manag
 
   /* Check all the sink modules of the net */
   bool contain_module_output = false;
-  for (ModuleId sink_module : module_manager.net_sink_modules(module_id, module_net)) {
-    if (module_id == sink_module) {
+  for (ModuleNetSinkId net_sink : module_manager.module_net_sinks(module_id, module_net)) {
+    if (module_id == module_manager.net_sink_module(module_id, module_net, net_sink)) {
       contain_module_output = true;
       break;
     }
@@ -673,10 +693,10 @@ void add_module_nets_between_logic_and_memory_sram_ports(ModuleManager& module_m
   for (size_t port_index = 0; port_index < logic_module_sram_ports.size(); ++port_index) {
     /* Create a net for each pin */
     for (size_t pin_id = 0; pin_id < logic_module_sram_ports[port_index].pins().size(); ++pin_id) {
+      /* The net is not named, as the name of its wire is built from the source,
+       * i.e., <logic_module>_<logic_instance_id>_<sram_port>
+       */
       ModuleNetId net = module_manager.create_module_net(parent_module);
-      /* TODO: Give a name to make it clear */
-      std::string net_name = module_manager.module_name(logic_module) + std::string("_") + std::to_string(logic_instance_id) + std::string("_") + logic_module_sram_ports[port_index].get_name();
-      module_manager.set_net_name(parent_module, net, net_name);
       /* Add net source */
       module_manager.add_module_net_source(parent_module, net, logic_module, logic_instance_id, logic_module_sram_port_ids[port_index], logic_module_sram_ports[port_index].pins()[pin_id]);
       /* Add net sink */
@@ -1780,6 +1800,38 @@ size_t find_module_num_config_bits_from_child_modules(ModuleManager& module_mana
   return num_config_bits;
 }
 
+/********************************************************************
+ * Find the number of configuration bits loaded under each frame address
+ * for a module in frame-based configuration protocol,
+ * which is the size of its data input port
+ * Return 0 if the module does not have any data input port
+ *******************************************************************/
+size_t find_module_frame_data_width(const ModuleManager& module_manager,
+                                    const ModuleId& module_id) {
+  ModulePortId din_port_id = module_manager.find_module_port(module_id, std::string(DECODER_DATA_IN_PORT_NAME));
+  if (false == module_manager.valid_module_port_id(module_id, din_port_id)) {
+    return 0;
+  }
+  return module_manager.module_port(module_id, din_port_id).get_width();
+}
+
+/********************************************************************
+ * Find the number of configuration bits loaded under each frame address
+ * for a module in frame-based configuration protocol,
+ * by the largest one among its configurable children
+ *
+ * Note: This function should be call ONLY after all the sub modules (instances)
+ * have been added to the module!
+ *******************************************************************/
+size_t find_module_frame_data_width_from_child_modules(const ModuleManager& module_manager,
+                                                       const ModuleId& module_id) {
+  size_t frame_data_width = 0;
+  for (const ModuleId& child : module_manager.configurable_children(module_id)) {
+    frame_data_width = std::max(frame_data_width, find_module_frame_data_width(module_manager, child));
+  }
+  return frame_data_width;
+}
+
 /********************************************************************
  * Try to create a net for the source pin
  * This function will try
@@ -1858,15 +1910,473 @@ void add_module_bus_nets(ModuleManager& module_manager,
   }
 
   /* Create a net for each pin */
-  for (size_t pin_id = 0; pin_id < src_port.pins().size(); ++pin_id) {
-    ModuleNetId net = create_module_source_pin_net(module_manager, cur_module_id, 
-                                                   src_module_id, src_instance_id, 
-                                                   src_module_port_id, src_port.pins()[pin_id]);
-    VTR_ASSERT(ModuleNetId::INVALID() != net);
+  module_manager.add_module_nets_between_pins(cur_module_id,
+                                              src_module_id, src_instance_id, src_module_port_id, src_port.pins(),
+                                              des_module_id, des_instance_id, des_module_port_id, des_port.pins());
+}
 
-    /* Configure the net sink */
-    module_manager.add_module_net_sink(cur_module_id, net, des_module_id, des_instance_id, des_module_port_id, des_port.pins()[pin_id]);
+/********************************************************************
+ * Copy the nets of a module in a fragment of module graph 
+ * to its counterpart in the module manager
+ * The ids of modules are translated by the given mapping,
+ * while the ids of instances, ports and pins are kept
+ *******************************************************************/
+static 
+void copy_module_nets_from_fragment(ModuleManager& module_manager,
+                                    const ModuleId& module,
+                                    const ModuleManager& fragment,
+                                    const ModuleId& fragment_module,
+                                    const vtr::vector<ModuleId, ModuleId>& module_map) {
+  module_manager.reserve_module_nets(module, fragment.num_nets(fragment_module));
+  for (const ModuleNetId& fragment_net : fragment.module_nets(fragment_module)) {
+    ModuleNetId net = module_manager.create_module_net(module);
+    std::string net_name = fragment.net_name(fragment_module, fragment_net);
+    if (false == net_name.empty()) {
+      module_manager.set_net_name(module, net, net_name);
+    }
+
+    vtr::vector<ModuleNetSrcId, ModuleId> src_modules = fragment.net_source_modules(fragment_module, fragment_net);
+    vtr::vector<ModuleNetSrcId, size_t> src_instances = fragment.net_source_instances(fragment_module, fragment_net);
+    vtr::vector<ModuleNetSrcId, ModulePortId> src_ports = fragment.net_source_ports(fragment_module, fragment_net);
+    vtr::vector<ModuleNetSrcId, size_t> src_pins = fragment.net_source_pins(fragment_module, fragment_net);
+    module_manager.reserve_module_net_sources(module, net, src_modules.size());
+    for (const ModuleNetSrcId& src : src_modules.keys()) {
+      module_manager.add_module_net_source(module, net,
+                                           module_map[src_modules[src]], src_instances[src],
+                                           src_ports[src], src_pins[src]);
+    }
+
+    vtr::vector<ModuleNetSinkId, ModuleId> sink_modules = fragment.net_sink_modules(fragment_module, fragment_net);
+    vtr::vector<ModuleNetSinkId, size_t> sink_instances = fragment.net_sink_instances(fragment_module, fragment_net);
+    vtr::vector<ModuleNetSinkId, ModulePortId> sink_ports = fragment.net_sink_ports(fragment_module, fragment_net);
+    vtr::vector<ModuleNetSinkId, size_t> sink_pins = fragment.net_sink_pins(fragment_module, fragment_net);
+    module_manager.reserve_module_net_sinks(module, net, sink_modules.size());
+    for (const ModuleNetSinkId& sink : sink_modules.keys()) {
+      module_manager.add_module_net_sink(module, net,
+                                         module_map[sink_modules[sink]], sink_instances[sink],
+                                         sink_ports[sink], sink_pins[sink]);
+    }
+  }
+}
+
+/********************************************************************
+ * Merge a fragment of module graph into the module manager
+ *
+ * A fragment is a copy of the module manager, where more modules
+ * are built, e.g., on another thread. The first modules of the fragment,
+ * i.e., [0, num_base_modules), should be the same as those in the module manager. 
+ * The other modules are added to the module manager in the sequence 
+ * of their ids, so that merging the fragments in a fixed order
+ * gives the same module graph as building all the modules in the same order
+ * on the module manager directly.
+ *
+ * Note:
+ *   - A module of the fragment which is already in the module manager,
+ *     e.g., a decoder shared by many modules and merged from another fragment,
+ *     is not added again. Modules are identified by their names
+ *   - The base modules should not be modified in the fragment,
+ *     except that they can be instanciated by new modules
+ *   - New modules which are merged into other modules in the fragment
+ *     are merged in the same way in the module manager
+ *******************************************************************/
+void merge_module_manager_fragment(ModuleManager& module_manager,
+                                   const ModuleManager& fragment,
+                                   const size_t& num_base_modules) {
+  VTR_ASSERT(num_base_modules <= module_manager.num_modules());
+  VTR_ASSERT(num_base_modules <= fragment.num_modules());
+
+  vtr::vector<ModuleId, ModuleId> module_map(fragment.num_modules(), ModuleId::INVALID());
+  /* Modules to be copied, in the sequence of their ids */
+  std::vector<ModuleId> fragment_modules;
+
+  /* Create modules and ports first, 
+   * as the ports of each child module should be in place before instanciating it
+   */
+  for (const ModuleId& fragment_module : fragment.modules()) {
+    if (size_t(fragment_module) < num_base_modules) {
+      module_map[fragment_module] = fragment_module;
+      continue;
+    }
+    std::string module_name = fragment.module_name(fragment_module);
+    ModuleId module = module_manager.find_module(module_name);
+    if (true == module_manager.valid_module_id(module)) {
+      module_map[fragment_module] = module;
+      continue;
+    }
+    module = module_manager.add_module(module_name);
+    VTR_ASSERT(true == module_manager.valid_module_id(module));
+    module_map[fragment_module] = module;
+    fragment_modules.push_back(fragment_module);
+
+    if (ModuleManager::NUM_MODULE_USAGE_TYPES != fragment.module_usage(fragment_module)) {
+      module_manager.set_module_usage(module, fragment.module_usage(fragment_module));
+    }
+
+    for (const ModulePortId& fragment_port : fragment.module_ports(fragment_module)) {
+      const BasicPort& port_info = fragment.module_port(fragment_module, fragment_port);
+      ModulePortId port = module_manager.add_port(module, port_info, fragment.port_type(fragment_module, fragment_port));
+      /* Port ids are kept, as they are referred by the nets */
+      VTR_ASSERT(fragment_port == port);
+      if (true == fragment.port_is_wire(fragment_module, fragment_port)) {
+        module_manager.set_port_is_wire(module, port_info.get_name(), true);
+      }
+      if (true == fragment.port_is_mappable_io(fragment_module, fragment_port)) {
+        module_manager.set_port_is_mappable_io(module, port, true);
+      }
+      if (true == fragment.port_is_register(fragment_module, fragment_port)) {
+        module_manager.set_port_is_register(module, port_info.get_name(), true);
+      }
+      std::string preproc_flag = fragment.port_preproc_flag(fragment_module, fragment_port);
+      if (false == preproc_flag.empty()) {
+        module_manager.set_port_preproc_flag(module, port, preproc_flag);
+      }
+    }
+  }
+
+  /* Add child instances, configurable children and nets */
+  for (const ModuleId& fragment_module : fragment_modules) {
+    ModuleId module = module_map[fragment_module];
+
+    for (const ModuleId& fragment_child : fragment.child_modules(fragment_module)) {
+      ModuleId child = module_map[fragment_child];
+      for (size_t inst = 0; inst < fragment.num_instance(fragment_module, fragment_child); ++inst) {
+        module_manager.add_child_module(module, child);
+        std::string instance_name = fragment.instance_name(fragment_module, fragment_child, inst);
+        if (false == instance_name.empty()) {
+          module_manager.set_child_instance_name(module, child, inst, instance_name);
+        }
+      }
+    }
+
+    std::vector<ModuleId> config_children = fragment.configurable_children(fragment_module);
+    std::vector<size_t> config_child_instances = fragment.configurable_child_instances(fragment_module);
+    VTR_ASSERT(config_children.size() == config_child_instances.size());
+    module_manager.reserve_configurable_child(module, config_children.size());
+    std::map<std::pair<ModuleId, size_t>, size_t> config_child_indices;
+    for (size_t ichild = 0; ichild < config_children.size(); ++ichild) {
+      module_manager.add_configurable_child(module, module_map[config_children[ichild]], config_child_instances[ichild]);
+      config_child_indices[std::make_pair(config_children[ichild], config_child_instances[ichild])] = ichild;
+    }
+
+    for (const ConfigRegionId& fragment_region : fragment.regions(fragment_module)) {
+      ConfigRegionId region = module_manager.add_config_region(module);
+      std::vector<ModuleId> region_children = fragment.region_configurable_children(fragment_module, fragment_region);
+      std::vector<size_t> region_child_instances = fragment.region_configurable_child_instances(fragment_module, fragment_region);
+      for (size_t ichild = 0; ichild < region_children.size(); ++ichild) {
+        size_t config_child_id = config_child_indices.at(std::make_pair(region_children[ichild], region_child_instances[ichild]));
+        module_manager.add_configurable_child_to_region(module, region,
+                                                        module_map[region_children[ichild]],
+                                                        region_child_instances[ichild],
+                                                        config_child_id);
+      }
+    }
+
+    copy_module_nets_from_fragment(module_manager, module,
+                                   fragment, fragment_module,
+                                   module_map);
   }
+
+  /* Merge modules when all the instances are in place */
+  for (const ModuleId& fragment_module : fragment_modules) {
+    ModuleId merged_module = fragment.merged_module(fragment_module);
+    if (true == fragment.valid_module_id(merged_module)) {
+      module_manager.merge_module(module_map[fragment_module], module_map[merged_module]);
+    }
+  }
+}
+
+/********************************************************************
+ * Merge the decoders which are added to a copy of the decoder library,
+ * i.e., those in [num_base_decoders, size), in the sequence of their ids
+ * Decoders which are already in the library are not added again
+ * Shift registers and decompressors which are not in the library are added as well
+ *******************************************************************/
+void merge_decoder_library_fragment(DecoderLibrary& decoder_lib,
+                                    const DecoderLibrary& fragment,
+                                    const size_t& num_base_decoders) {
+  for (const DecoderId& decoder : fragment.decoders()) {
+    if (size_t(decoder) < num_base_decoders) {
+      continue;
+    }
+    if (DecoderId::INVALID() != decoder_lib.find_decoder(fragment.addr_size(decoder),
+                                                         fragment.data_size(decoder),
+                                                         fragment.use_enable(decoder),
+                                                         fragment.use_data_in(decoder),
+                                                         fragment.use_data_inv_port(decoder))) {
+      continue;
+    }
+    decoder_lib.add_decoder(fragment.addr_size(decoder),
+                            fragment.data_size(decoder),
+                            fragment.use_enable(decoder),
+                            fragment.use_data_in(decoder),
+                            fragment.use_data_inv_port(decoder));
+  }
+  for (const size_t& shift_register_size : fragment.shift_registers()) {
+    if (false == decoder_lib.find_shift_register(shift_register_size)) {
+      decoder_lib.add_shift_register(shift_register_size);
+    }
+  }
+  for (const size_t& run_length_width : fragment.decompressors()) {
+    if (false == decoder_lib.find_decompressor(run_length_width)) {
+      decoder_lib.add_decompressor(run_length_width);
+    }
+  }
+}
+
+/********************************************************************
+ * Run independent tasks which build modules on multiple threads
+ * - Tasks are split into contiguous ranges, one for each thread.
+ *   Each thread builds its modules on a fragment, i.e., a copy of the module manager
+ *   and the decoder library, so that there is no data shared between threads.
+ *   Only one copy is made per thread, whatever number of tasks is given
+ * - The fragments are merged back in the sequence of tasks. The modules
+ *   are the same as executing the tasks one by one, whatever number of threads
+ *   is used
+ * - When only one thread is requested, tasks are executed on the
+ *   module manager directly, without any copy
+ * - The progress of the tasks is reported under the given phase name
+ *   when they take long
+ *******************************************************************/
+void build_modules_on_fragments(ModuleManager& module_manager,
+                                DecoderLibrary& decoder_lib,
+                                const size_t& num_tasks,
+                                const size_t& num_threads,
+                                const std::string& phase_name,
+                                const std::function<void(ModuleManager&, DecoderLibrary&, const size_t&)>& build_task) {
+  ProgressReporter progress(phase_name, num_tasks);
+
+  size_t num_fragments = std::min(num_threads, num_tasks);
+  if (1 >= num_fragments) {
+    for (size_t itask = 0; itask < num_tasks; ++itask) {
+      build_task(module_manager, decoder_lib, itask);
+      progress.advance();
+    }
+    return;
+  }
+
+  size_t num_base_modules = module_manager.num_modules();
+  size_t num_base_decoders = decoder_lib.decoders().size();
+  /* Spread the remainder over the first fragments */
+  size_t num_tasks_per_fragment = num_tasks / num_fragments;
+  size_t num_extra_tasks = num_tasks % num_fragments;
+
+  std::vector<ModuleManager> module_fragments(num_fragments);
+  std::vector<DecoderLibrary> decoder_fragments(num_fragments);
+  parallel_for(num_fragments, num_threads,
+               [&](const size_t& ifragment) {
+                 size_t task_begin = ifragment * num_tasks_per_fragment + std::min(ifragment, num_extra_tasks);
+                 size_t task_end = task_begin + num_tasks_per_fragment + (ifragment < num_extra_tasks ? 1 : 0);
+                 module_fragments[ifragment] = module_manager;
+                 decoder_fragments[ifragment] = decoder_lib;
+                 for (size_t itask = task_begin; itask < task_end; ++itask) {
+                   build_task(module_fragments[ifragment], decoder_fragments[ifragment], itask);
+                   progress.advance();
+                 }
+               });
+
+  for (size_t ifragment = 0; ifragment < num_fragments; ++ifragment) {
+    merge_module_manager_fragment(module_manager, module_fragments[ifragment], num_base_modules);
+    merge_decoder_library_fragment(decoder_lib, decoder_fragments[ifragment], num_base_decoders);
+    /* Release the memory of a fragment as soon as it is merged */
+    module_fragments[ifragment] = ModuleManager();
+    decoder_fragments[ifragment] = DecoderLibrary();
+  }
+}
+
+/********************************************************************
+ * Check if two vectors have the same elements, in the same sequence 
+ *******************************************************************/
+template <typename K, typename V>
+static 
+bool vectors_identical(const vtr::vector<K, V>& vector_a,
+                       const vtr::vector<K, V>& vector_b) {
+  return std::equal(vector_a.begin(), vector_a.end(), vector_b.begin(), vector_b.end());
+}
+
+/********************************************************************
+ * The module which drives or is driven by a net in a module body,
+ * where the module itself is represented by an invalid id, 
+ * so that nets of modules with different ids can be compared 
+ *******************************************************************/
+static 
+ModuleId module_body_net_terminal(const ModuleId& module,
+                                  const ModuleId& terminal_module) {
+  if (module == terminal_module) {
+    return ModuleId::INVALID();
+  }
+  return terminal_module;
+}
+
+/********************************************************************
+ * Compute a hash value of the body of a module, including
+ * its ports, child instances and nets but not its name
+ * Modules with identical bodies have the same hash value,
+ * see module_bodies_identical() 
+ *******************************************************************/
+size_t module_body_hash(const ModuleManager& module_manager,
+                        const ModuleId& module) {
+  size_t hash = 0;
+
+  for (const ModulePortId& port : module_manager.module_ports(module)) {
+    const BasicPort& port_info = module_manager.module_port(module, port);
+    vtr::hash_combine(hash, port_info.get_name());
+    vtr::hash_combine(hash, port_info.get_lsb());
+    vtr::hash_combine(hash, port_info.get_msb());
+    vtr::hash_combine(hash, size_t(module_manager.port_type(module, port)));
+  }
+
+  for (const ModuleId& child : module_manager.child_modules(module)) {
+    vtr::hash_combine(hash, size_t(child));
+    for (size_t inst = 0; inst < module_manager.num_instance(module, child); ++inst) {
+      vtr::hash_combine(hash, module_manager.instance_name(module, child, inst));
+    }
+  }
+
+  for (const ModuleNetId& net : module_manager.module_nets(module)) {
+    for (const ModuleId& src_module : module_manager.net_source_modules(module, net)) {
+      vtr::hash_combine(hash, size_t(module_body_net_terminal(module, src_module)));
+    }
+    for (const size_t& src_instance : module_manager.net_source_instances(module, net)) {
+      vtr::hash_combine(hash, src_instance);
+    }
+    for (const ModulePortId& src_port : module_manager.net_source_ports(module, net)) {
+      vtr::hash_combine(hash, size_t(src_port));
+    }
+    for (const size_t& src_pin : module_manager.net_source_pins(module, net)) {
+      vtr::hash_combine(hash, src_pin);
+    }
+    for (const ModuleId& sink_module : module_manager.net_sink_modules(module, net)) {
+      vtr::hash_combine(hash, size_t(module_body_net_terminal(module, sink_module)));
+    }
+    for (const size_t& sink_instance : module_manager.net_sink_instances(module, net)) {
+      vtr::hash_combine(hash, sink_instance);
+    }
+    for (const ModulePortId& sink_port : module_manager.net_sink_ports(module, net)) {
+      vtr::hash_combine(hash, size_t(sink_port));
+    }
+    for (const size_t& sink_pin : module_manager.net_sink_pins(module, net)) {
+      vtr::hash_combine(hash, sink_pin);
+    }
+  }
+
+  return hash;
+}
+
+/********************************************************************
+ * Check if two modules have identical bodies, i.e., they are different
+ * only in their names. This requires the same
+ * - ports, in terms of names, sizes, types and attributes
+ * - child instances, in terms of modules and instance names
+ * - nets, in terms of names, sources and sinks
+ * which means that their netlists are the same except the module names 
+ *******************************************************************/
+bool module_bodies_identical(const ModuleManager& module_manager,
+                             const ModuleId& module_a,
+                             const ModuleId& module_b) {
+  if (module_a == module_b) {
+    return true;
+  }
+
+  /* Ports */
+  if (module_manager.module_ports(module_a).size() != module_manager.module_ports(module_b).size()) {
+    return false;
+  }
+  for (const ModulePortId& port : module_manager.module_ports(module_a)) {
+    const BasicPort& port_a = module_manager.module_port(module_a, port);
+    const BasicPort& port_b = module_manager.module_port(module_b, port);
+    if ( (false == (port_a == port_b))
+      || (module_manager.port_type(module_a, port) != module_manager.port_type(module_b, port))
+      || (module_manager.port_is_wire(module_a, port) != module_manager.port_is_wire(module_b, port))
+      || (module_manager.port_is_register(module_a, port) != module_manager.port_is_register(module_b, port))
+      || (module_manager.port_preproc_flag(module_a, port) != module_manager.port_preproc_flag(module_b, port))) {
+      return false;
+    }
+  }
+
+  /* Child instances */
+  if (module_manager.child_modules(module_a) != module_manager.child_modules(module_b)) {
+    return false;
+  }
+  for (const ModuleId& child : module_manager.child_modules(module_a)) {
+    if (module_manager.num_instance(module_a, child) != module_manager.num_instance(module_b, child)) {
+      return false;
+    }
+    for (size_t inst = 0; inst < module_manager.num_instance(module_a, child); ++inst) {
+      if (module_manager.instance_name(module_a, child, inst) != module_manager.instance_name(module_b, child, inst)) {
+        return false;
+      }
+    }
+  }
+
+  /* Nets */
+  if (module_manager.num_nets(module_a) != module_manager.num_nets(module_b)) {
+    return false;
+  }
+  for (const ModuleNetId& net : module_manager.module_nets(module_a)) {
+    if (module_manager.net_name(module_a, net) != module_manager.net_name(module_b, net)) {
+      return false;
+    }
+
+    std::vector<ModuleId> src_modules_a;
+    std::vector<ModuleId> src_modules_b;
+    for (const ModuleId& src_module : module_manager.net_source_modules(module_a, net)) {
+      src_modules_a.push_back(module_body_net_terminal(module_a, src_module));
+    }
+    for (const ModuleId& src_module : module_manager.net_source_modules(module_b, net)) {
+      src_modules_b.push_back(module_body_net_terminal(module_b, src_module));
+    }
+    if ( (src_modules_a != src_modules_b)
+      || (false == vectors_identical(module_manager.net_source_instances(module_a, net), module_manager.net_source_instances(module_b, net)))
+      || (false == vectors_identical(module_manager.net_source_ports(module_a, net), module_manager.net_source_ports(module_b, net)))
+      || (false == vectors_identical(module_manager.net_source_pins(module_a, net), module_manager.net_source_pins(module_b, net)))) {
+      return false;
+    }
+
+    std::vector<ModuleId> sink_modules_a;
+    std::vector<ModuleId> sink_modules_b;
+    for (const ModuleId& sink_module : module_manager.net_sink_modules(module_a, net)) {
+      sink_modules_a.push_back(module_body_net_terminal(module_a, sink_module));
+    }
+    for (const ModuleId& sink_module : module_manager.net_sink_modules(module_b, net)) {
+      sink_modules_b.push_back(module_body_net_terminal(module_b, sink_module));
+    }
+    if ( (sink_modules_a != sink_modules_b)
+      || (false == vectors_identical(module_manager.net_sink_instances(module_a, net), module_manager.net_sink_instances(module_b, net)))
+      || (false == vectors_identical(module_manager.net_sink_ports(module_a, net), module_manager.net_sink_ports(module_b, net)))
+      || (false == vectors_identical(module_manager.net_sink_pins(module_a, net), module_manager.net_sink_pins(module_b, net)))) {
+      return false;
+    }
+  }
+
+  return true;
+}
+
+/********************************************************************
+ * Find all the modules which include instances of a given module,
+ * directly or through any level of hierarchy, including the module itself,
+ * by walking up the parents of each module.
+ * Each module is visited once, regardless of its number of instances,
+ * so that hierarchy traversals can skip the subtrees without the module
+ *******************************************************************/
+vtr::vector<ModuleId, bool> find_modules_including_module(const ModuleManager& module_manager,
+                                                          const ModuleId& module) {
+  vtr::vector<ModuleId, bool> modules_including(module_manager.num_modules(), false);
+
+  std::vector<ModuleId> modules_to_visit(1, module);
+  modules_including[module] = true;
+  while (false == modules_to_visit.empty()) {
+    ModuleId curr_module = modules_to_visit.back();
+    modules_to_visit.pop_back();
+    for (const ModuleId& parent_module : module_manager.parent_modules(curr_module)) {
+      if (true == modules_including[parent_module]) {
+        continue;
+      }
+      modules_including[parent_module] = true;
+      modules_to_visit.push_back(parent_module);
+    }
+  }
+
+  return modules_including;
 }
 
 /********************************************************************
@@ -8,6 +8,7 @@
 /********************************************************************
  * Include header files that are required by function declaration
  *******************************************************************/
+#include <functional>
 #include <vector>
 #include <tuple>
 
@@ -67,7 +68,8 @@ void add_sram_ports_to_module_manager(ModuleManager& module_manager,
                                       const CircuitLibrary& circuit_lib,
                                       const CircuitModelId& sram_model,
                                       const e_config_protocol_type sram_orgz_type,
-                                      const size_t& num_config_bits);
+                                      const size_t& num_config_bits,
+                                      const size_t& frame_data_width);
 
 void add_primitive_pb_type_ports_to_module_manager(ModuleManager& module_manager, 
                                                    const ModuleId& module_id,
@@ -153,6 +155,12 @@ size_t find_module_num_config_bits_from_child_modules(ModuleManager& module_mana
                                                       const CircuitModelId& sram_model,
                                                       const e_config_protocol_type& sram_orgz_type);
 
+size_t find_module_frame_data_width(const ModuleManager& module_manager,
+                                    const ModuleId& module_id);
+
+size_t find_module_frame_data_width_from_child_modules(const ModuleManager& module_manager,
+                                                       const ModuleId& module_id);
+
 ModuleNetId create_module_source_pin_net(ModuleManager& module_manager,
                                          const ModuleId& cur_module_id,
                                          const ModuleId& src_module_id,
@@ -169,6 +177,31 @@ void add_module_bus_nets(ModuleManager& module_manager,
                          const size_t& des_instance_id,
                          const ModulePortId& des_module_port_id);
 
+void merge_module_manager_fragment(ModuleManager& module_manager,
+                                   const ModuleManager& fragment,
+                                   const size_t& num_base_modules);
+
+void merge_decoder_library_fragment(DecoderLibrary& decoder_lib,
+                                    const DecoderLibrary& fragment,
+                                    const size_t& num_base_decoders);
+
+void build_modules_on_fragments(ModuleManager& module_manager,
+                                DecoderLibrary& decoder_lib,
+                                const size_t& num_tasks,
+                                const size_t& num_threads,
+                                const std::string& phase_name,
+                                const std::function<void(ModuleManager&, DecoderLibrary&, const size_t&)>& build_task);
+
+size_t module_body_hash(const ModuleManager& module_manager,
+                        const ModuleId& module);
+
+bool module_bodies_identical(const ModuleManager& module_manager,
+                             const ModuleId& module_a,
+                             const ModuleId& module_b);
+
+vtr::vector<ModuleId, bool> find_modules_including_module(const ModuleManager& module_manager,
+                                                          const ModuleId& module);
+
 } /* end namespace openfpga */
 
 #endif
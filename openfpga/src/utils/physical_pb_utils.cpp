@@ -8,9 +8,6 @@
 #include "vtr_assert.h"
 #include "vtr_log.h"
 
-/* Headers from openfpgautil library */
-#include "openfpga_tokenizer.h"
-
 #include "openfpga_naming.h"
 #include "lut_utils.h"
 #include "pb_type_utils.h"
@@ -58,6 +55,33 @@ void rec_alloc_physical_pb_from_pb_graph(PhysicalPb& phy_pb,
   }
 }
 
+/************************************************************************
+ * Count the number of physical pbs to be allocated for a pb graph,
+ * i.e., the nodes in the physical mode of each pb_type
+ ***********************************************************************/
+static 
+size_t rec_count_physical_pb_from_pb_graph(const t_pb_graph_node* pb_graph_node,
+                                           const VprDeviceAnnotation& device_annotation) {
+  t_pb_type* pb_type = pb_graph_node->pb_type;
+
+  if (true == is_primitive_pb_type(pb_type)) {
+    return 1;
+  } 
+
+  t_mode* physical_mode = device_annotation.physical_mode(pb_type);
+  VTR_ASSERT(nullptr != physical_mode);
+
+  size_t num_pbs = 1;
+  for (int ipb = 0; ipb < physical_mode->num_pb_type_children; ++ipb) {
+    for (int jpb = 0; jpb < physical_mode->pb_type_children[ipb].num_pb; ++jpb) {
+      num_pbs += rec_count_physical_pb_from_pb_graph(&(pb_graph_node->child_pb_graph_nodes[physical_mode->index][ipb][jpb]),
+                                                     device_annotation);
+    }
+  }
+
+  return num_pbs;
+}
+
 /************************************************************************
  * Build all the relationships between parent and children 
  * inside a physical pb graph 
@@ -113,6 +137,9 @@ void alloc_physical_pb_from_pb_graph(PhysicalPb& phy_pb,
                                      const VprDeviceAnnotation& device_annotation) {
   VTR_ASSERT(true == phy_pb.empty());
 
+  /* Allocate the storage of all the pbs at once */
+  phy_pb.reserve_pbs(rec_count_physical_pb_from_pb_graph(pb_graph_head, device_annotation));
+
   rec_alloc_physical_pb_from_pb_graph(phy_pb, pb_graph_head, device_annotation);
   rec_build_physical_pb_children_from_pb_graph(phy_pb, pb_graph_head, device_annotation);
 }
@@ -309,24 +336,26 @@ void rec_update_physical_pb_from_operating_pb(PhysicalPb& phy_pb,
      * bind the bitstream value from atom block to the physical pb 
      */
     if (VprBitstreamAnnotation::e_bitstream_source_type::BITSTREAM_SOURCE_EBLIF == bitstream_annotation.pb_type_bitstream_source(pb_type)) {
-      StringToken tokenizer = bitstream_annotation.pb_type_bitstream_content(pb_type);
-      std::vector<std::string> tokens = tokenizer.split(" ");
-      /* FIXME: The token-level check should be done much earlier!!! */
-      VTR_ASSERT(2 == tokens.size());
-      /* The token is typically organized as <.param|.attr> <identifier string> */
-      if (std::string(".param") == tokens[0]) {
+      /* The content is organized as <.param|.attr> <identifier string>, 
+       * which has been parsed and checked when annotating bitstream settings
+       */
+      VprBitstreamAnnotation::e_eblif_line_type eblif_line_type = bitstream_annotation.pb_type_bitstream_eblif_line_type(pb_type);
+      std::string eblif_identifier = bitstream_annotation.pb_type_bitstream_eblif_identifier(pb_type);
+      VTR_ASSERT(VprBitstreamAnnotation::NUM_EBLIF_LINE_TYPES != eblif_line_type);
+      if (VprBitstreamAnnotation::EBLIF_LINE_PARAM == eblif_line_type) {
         for (const auto& param_search : atom_ctx.nlist.block_params(atom_blk)) {
           /* Bypass unmatched parameter identifier */
-          if (param_search.first != tokens[1]) {
+          if (param_search.first != eblif_identifier) {
             continue;
           }
           phy_pb.set_fixed_bitstream(physical_pb, param_search.second); 
           phy_pb.set_fixed_bitstream_offset(physical_pb, bitstream_annotation.pb_type_bitstream_offset(pb_type));
         }
-      } else if (std::string(".attr") == tokens[0]) {
+      } else {
+        VTR_ASSERT(VprBitstreamAnnotation::EBLIF_LINE_ATTR == eblif_line_type);
         for (const auto& attr_search : atom_ctx.nlist.block_attrs(atom_blk)) {
           /* Bypass unmatched parameter identifier */
-          if (attr_search.first == tokens[1]) {
+          if (attr_search.first == eblif_identifier) {
             continue;
           }
           phy_pb.set_fixed_bitstream(physical_pb, attr_search.second); 
@@ -340,24 +369,26 @@ void rec_update_physical_pb_from_operating_pb(PhysicalPb& phy_pb,
      * bind the bitstream value from atom block to the physical pb 
      */
     if (VprBitstreamAnnotation::e_bitstream_source_type::BITSTREAM_SOURCE_EBLIF == bitstream_annotation.pb_type_mode_select_bitstream_source(pb_type)) {
-      StringToken tokenizer = bitstream_annotation.pb_type_mode_select_bitstream_content(pb_type);
-      std::vector<std::string> tokens = tokenizer.split(" ");
-      /* FIXME: The token-level check should be done much earlier!!! */
-      VTR_ASSERT(2 == tokens.size());
-      /* The token is typically organized as <.param|.attr> <identifier string> */
-      if (std::string(".param") == tokens[0]) {
+      /* The content is organized as <.param|.attr> <identifier string>, 
+       * which has been parsed and checked when annotating bitstream settings
+       */
+      VprBitstreamAnnotation::e_eblif_line_type eblif_line_type = bitstream_annotation.pb_type_mode_select_bitstream_eblif_line_type(pb_type);
+      std::string eblif_identifier = bitstream_annotation.pb_type_mode_select_bitstream_eblif_identifier(pb_type);
+      VTR_ASSERT(VprBitstreamAnnotation::NUM_EBLIF_LINE_TYPES != eblif_line_type);
+      if (VprBitstreamAnnotation::EBLIF_LINE_PARAM == eblif_line_type) {
         for (const auto& param_search : atom_ctx.nlist.block_params(atom_blk)) {
           /* Bypass unmatched parameter identifier */
-          if (param_search.first != tokens[1]) {
+          if (param_search.first != eblif_identifier) {
             continue;
           }
           phy_pb.set_fixed_mode_select_bitstream(physical_pb, param_search.second); 
           phy_pb.set_fixed_mode_select_bitstream_offset(physical_pb, bitstream_annotation.pb_type_mode_select_bitstream_offset(pb_type));
         }
-      } else if (std::string(".attr") == tokens[0]) {
+      } else {
+        VTR_ASSERT(VprBitstreamAnnotation::EBLIF_LINE_ATTR == eblif_line_type);
         for (const auto& attr_search : atom_ctx.nlist.block_attrs(atom_blk)) {
           /* Bypass unmatched parameter identifier */
-          if (attr_search.first == tokens[1]) {
+          if (attr_search.first == eblif_identifier) {
             continue;
           }
           phy_pb.set_fixed_mode_select_bitstream(physical_pb, attr_search.second); 
@@ -18,11 +18,6 @@ namespace openfpga {
 bool connection_block_contain_only_routing_tracks(const RRGSB& rr_gsb,
                                                   const t_rr_type& cb_type);
 
-std::vector<RRNodeId> get_rr_gsb_chan_node_configurable_driver_nodes(const RRGraph& rr_graph,
-                                                                     const RRGSB& rr_gsb,
-                                                                     const e_side& chan_side,
-                                                                     const size_t& track_id);
-
 } /* end namespace openfpga */
 
 #endif
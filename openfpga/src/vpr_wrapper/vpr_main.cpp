@@ -5,11 +5,18 @@
 #include <cstdio>
 #include <cstring>
 #include <ctime>
+#include <fstream>
+#include <sstream>
+#include <string>
+#include <vector>
+#include <unistd.h>
 
 #include "vtr_error.h"
 #include "vtr_memory.h"
 #include "vtr_log.h"
 #include "vtr_time.h"
+#include "vtr_util.h"
+#include "vtr_digest.h"
 
 #include "tatum/error.hpp"
 
@@ -22,9 +29,339 @@
 #include "vpr_main.h"
 
 #include "globals.h"
+#include "route_common.h"
+#include "route_export.h"
+
+/* Headers from openfpgautil library */
+#include "openfpga_digest.h"
+#include "openfpga_binary_io.h"
 
 namespace vpr {
 
+/* Option of the wrapper, which is not passed to VPR:
+ * the directory to cache the router lookahead and the placement delay model
+ */
+constexpr const char* VPR_LOOKAHEAD_CACHE_OPTION = "--lookahead_cache";
+
+/* Option of the wrapper, which is not passed to VPR:
+ * free the data structures which are only used by VPR itself once it succeeds
+ */
+constexpr const char* VPR_FREE_UNUSED_CONTEXTS_OPTION = "--free_unused_contexts";
+
+/* Option of the wrapper, which is not passed to VPR:
+ * the routing file of a previous run, e.g., before a small change of the netlist
+ * or the placement, from which the router only reroutes the affected nets
+ */
+constexpr const char* VPR_INCREMENTAL_ROUTE_OPTION = "--incremental_route_from";
+
+/**
+ * Options handled by the wrapper rather than VPR
+ */
+struct t_vpr_wrapper_options {
+    std::string cache_dir;
+    bool free_unused_contexts = false;
+    std::string incremental_route_file;
+};
+
+/**
+ * Remove the options of the wrapper from the arguments to VPR
+ * The directory of the cache is empty if the option is not found
+ */
+static t_vpr_wrapper_options extract_wrapper_options(int argc, char** argv, std::vector<char*>& vpr_argv) {
+    t_vpr_wrapper_options wrapper_opts;
+    for (int iarg = 0; iarg < argc; ++iarg) {
+        if ((0 == std::strcmp(argv[iarg], VPR_LOOKAHEAD_CACHE_OPTION)) && (iarg + 1 < argc)) {
+            wrapper_opts.cache_dir = argv[++iarg];
+            continue;
+        }
+        if ((0 == std::strcmp(argv[iarg], VPR_FREE_UNUSED_CONTEXTS_OPTION)) && (iarg + 1 < argc)) {
+            wrapper_opts.free_unused_contexts = (0 == std::strcmp(argv[++iarg], "on"));
+            continue;
+        }
+        if ((0 == std::strcmp(argv[iarg], VPR_INCREMENTAL_ROUTE_OPTION)) && (iarg + 1 < argc)) {
+            wrapper_opts.incremental_route_file = argv[++iarg];
+            continue;
+        }
+        vpr_argv.push_back(argv[iarg]);
+    }
+    return wrapper_opts;
+}
+
+/**
+ * Check if the device grid is known before packing,
+ * otherwise the lookahead depends on the size of the benchmark
+ */
+static bool is_device_grid_fixed(const t_vpr_setup& vpr_setup, const t_arch& arch) {
+    if (vpr_setup.device_layout != "auto") {
+        return true;
+    }
+    return (1 == arch.grid_layouts.size()) && (GridDefType::FIXED == arch.grid_layouts[0].grid_type);
+}
+
+/**
+ * Compute the hash of the architecture and the options
+ * which the router lookahead and the placement delay model depend on
+ * The hash is empty if the architecture or the rr graph file is missing
+ */
+static std::string compute_lookahead_cache_hash(const t_options& options, const t_vpr_setup& vpr_setup) {
+    std::ostringstream hash_data;
+    openfpga::BinaryWriter hasher(hash_data);
+
+    /* The architecture file includes the switches, segments and the device layouts */
+    const std::string& rr_graph_fname = vpr_setup.RoutingArch.read_rr_graph_filename;
+    if (!vtr::file_exists(options.ArchFile.value().c_str())
+        || (!rr_graph_fname.empty() && !vtr::file_exists(rr_graph_fname.c_str()))) {
+        return std::string();
+    }
+    hasher(vtr::secure_digest_file(options.ArchFile.value()));
+    if (!rr_graph_fname.empty()) {
+        hasher(vtr::secure_digest_file(rr_graph_fname));
+    }
+    hasher(vpr_setup.device_layout);
+
+    /* Options of the router which build the rr graph (see alloc_routing_structs())
+     * and the costs used by the lookahead and the delay profiler
+     */
+    const t_router_opts& router_opts = vpr_setup.RouterOpts;
+    hasher(router_opts.fixed_channel_width,
+           router_opts.route_type,
+           router_opts.base_cost_type,
+           router_opts.trim_empty_channels,
+           router_opts.trim_obs_channels,
+           router_opts.clock_modeling,
+           router_opts.lookahead_type,
+           router_opts.astar_fac,
+           router_opts.bend_cost,
+           router_opts.max_criticality,
+           router_opts.criticality_exp);
+
+    /* Options of the placement delay model (see compute_place_delay_model()) */
+    const t_placer_opts& placer_opts = vpr_setup.PlacerOpts;
+    hasher(placer_opts.delay_model_type,
+           placer_opts.delay_model_reducer,
+           placer_opts.place_delta_delay_matrix_calculation_method,
+           placer_opts.delay_offset,
+           placer_opts.delay_ramp_delta_threshold,
+           placer_opts.delay_ramp_slope,
+           placer_opts.tsu_rel_margin,
+           placer_opts.tsu_abs_margin,
+           placer_opts.allowed_tiles_for_delay_model);
+
+    return openfpga::secure_digest_hex(hash_data.str());
+}
+
+/**
+ * A file of the cache which is being written by VPR
+ * It is written to a temporary file and renamed when VPR succeeds,
+ * so that other runs never read a partial file
+ */
+struct t_lookahead_cache_file {
+    std::string tmp_fname;
+    std::string fname;
+};
+
+/**
+ * Skip the checks of an RR graph file which has passed them in a previous run
+ * A stamp named after the hash of the files is written to the cache
+ * when the flow succeeds, as the checks error out otherwise
+ */
+static void setup_rr_graph_check_cache(const std::string& cache_dir,
+                                       const t_options& options,
+                                       t_vpr_setup& vpr_setup,
+                                       std::vector<t_lookahead_cache_file>& cache_files) {
+    const std::string& rr_graph_fname = vpr_setup.RoutingArch.read_rr_graph_filename;
+    if (rr_graph_fname.empty()) {
+        return;
+    }
+
+    /* The checks depend on the architecture as well as the rr graph itself */
+    if (!vtr::file_exists(options.ArchFile.value().c_str()) || !vtr::file_exists(rr_graph_fname.c_str())) {
+        return;
+    }
+    std::ostringstream hash_data;
+    openfpga::BinaryWriter hasher(hash_data);
+    hasher(vtr::secure_digest_file(options.ArchFile.value()),
+           vtr::secure_digest_file(rr_graph_fname),
+           vpr_setup.device_layout);
+    std::string hash = openfpga::secure_digest_hex(hash_data.str());
+
+    openfpga::create_directory(cache_dir);
+    std::string fname = openfpga::format_dir_path(cache_dir) + "rr_graph_checked_" + hash + ".stamp";
+
+    if (vtr::file_exists(fname.c_str())) {
+        VTR_LOG("RR graph '%s' was checked before as recorded in cache '%s'\n",
+                rr_graph_fname.c_str(), fname.c_str());
+        vpr_setup.RoutingArch.check_rr_graph = false;
+        return;
+    }
+
+    std::string tmp_fname = fname + ".tmp" + std::to_string(getpid());
+    std::ofstream fp(tmp_fname);
+    fp << rr_graph_fname << "\n";
+    if (fp.good()) {
+        cache_files.push_back({tmp_fname, fname});
+    }
+}
+
+/**
+ * Use the cached files for the router lookahead and the placement delay model
+ * when they exist, otherwise ask VPR to write them
+ * The options given by users to read or write these files have the priority
+ */
+static void setup_lookahead_cache(const std::string& cache_dir,
+                                  const t_options& options,
+                                  t_vpr_setup& vpr_setup,
+                                  const t_arch& arch,
+                                  std::vector<t_lookahead_cache_file>& cache_files) {
+#ifndef VTR_ENABLE_CAPNPROTO
+    (void)options;
+    (void)vpr_setup;
+    (void)arch;
+    (void)cache_files;
+    VTR_LOG_WARN("Ignore option '%s %s' because VTR_ENABLE_CAPNPROTO=OFF.\n",
+                 VPR_LOOKAHEAD_CACHE_OPTION, cache_dir.c_str());
+#else
+    if (NO_FIXED_CHANNEL_WIDTH == vpr_setup.RouterOpts.fixed_channel_width) {
+        VTR_LOG_WARN("Ignore option '%s' because it requires a fixed channel width (--route_chan_width).\n",
+                     VPR_LOOKAHEAD_CACHE_OPTION);
+        return;
+    }
+    if (!is_device_grid_fixed(vpr_setup, arch)) {
+        VTR_LOG_WARN("Ignore option '%s' because it requires a fixed device layout (--device).\n",
+                     VPR_LOOKAHEAD_CACHE_OPTION);
+        return;
+    }
+
+    std::string hash = compute_lookahead_cache_hash(options, vpr_setup);
+    if (hash.empty()) {
+        VTR_LOG_WARN("Ignore option '%s' because the architecture files cannot be read.\n",
+                     VPR_LOOKAHEAD_CACHE_OPTION);
+        return;
+    }
+
+    openfpga::create_directory(cache_dir);
+    std::string prefix = openfpga::format_dir_path(cache_dir);
+    std::string tmp_suffix = ".tmp" + std::to_string(getpid());
+
+    /* Only the lookahead map can be read and written */
+    if ((e_router_lookahead::MAP == vpr_setup.RouterOpts.lookahead_type)
+        && vpr_setup.RouterOpts.read_router_lookahead.empty()
+        && vpr_setup.RouterOpts.write_router_lookahead.empty()) {
+        std::string fname = prefix + "router_lookahead_" + hash + ".capnp";
+        if (vtr::file_exists(fname.c_str())) {
+            VTR_LOG("Read router lookahead from cache '%s'\n", fname.c_str());
+            vpr_setup.RouterOpts.read_router_lookahead = fname;
+        } else {
+            vpr_setup.RouterOpts.write_router_lookahead = fname + tmp_suffix;
+            cache_files.push_back({fname + tmp_suffix, fname});
+        }
+    }
+
+    if (vpr_setup.PlacerOpts.read_placement_delay_lookup.empty()
+        && vpr_setup.PlacerOpts.write_placement_delay_lookup.empty()) {
+        std::string fname = prefix + "place_delay_model_" + hash + ".capnp";
+        if (vtr::file_exists(fname.c_str())) {
+            VTR_LOG("Read placement delay model from cache '%s'\n", fname.c_str());
+            vpr_setup.PlacerOpts.read_placement_delay_lookup = fname;
+        } else {
+            vpr_setup.PlacerOpts.write_placement_delay_lookup = fname + tmp_suffix;
+            cache_files.push_back({fname + tmp_suffix, fname});
+        }
+    }
+#endif
+}
+
+/**
+ * Publish the files written by VPR to the cache, or remove them if VPR fails
+ * Files which are not written, e.g., the placement delay model when VPR
+ * does not run the timing-driven placement, are skipped
+ */
+static void finish_lookahead_cache(const std::vector<t_lookahead_cache_file>& cache_files, const bool& flow_succeeded) {
+    for (const t_lookahead_cache_file& cache_file : cache_files) {
+        if (!vtr::file_exists(cache_file.tmp_fname.c_str())) {
+            continue;
+        }
+        if (!flow_succeeded || 0 != std::rename(cache_file.tmp_fname.c_str(), cache_file.fname.c_str())) {
+            std::remove(cache_file.tmp_fname.c_str());
+            continue;
+        }
+        VTR_LOG("Wrote cache '%s'\n", cache_file.fname.c_str());
+    }
+}
+
+/**
+ * Ask the router to start from the routing of a previous run
+ * The routing of a net is reused only if its nodes are the same in the current rr graph,
+ * which requires the same device and channel width as the previous run
+ */
+static void setup_incremental_route(const std::string& route_fname,
+                                    t_vpr_setup& vpr_setup,
+                                    const t_arch& arch) {
+    if (NO_FIXED_CHANNEL_WIDTH == vpr_setup.RouterOpts.fixed_channel_width) {
+        VTR_LOG_WARN("Ignore option '%s' because it requires a fixed channel width (--route_chan_width).\n",
+                     VPR_INCREMENTAL_ROUTE_OPTION);
+        return;
+    }
+    if (!is_device_grid_fixed(vpr_setup, arch)) {
+        VTR_LOG_WARN("Ignore option '%s' because it requires a fixed device layout (--device).\n",
+                     VPR_INCREMENTAL_ROUTE_OPTION);
+        return;
+    }
+    if (TIMING_DRIVEN != vpr_setup.RouterOpts.router_algorithm) {
+        VTR_LOG_WARN("Ignore option '%s' because it requires the timing-driven router.\n",
+                     VPR_INCREMENTAL_ROUTE_OPTION);
+        return;
+    }
+    if (!vtr::file_exists(route_fname.c_str())) {
+        VTR_LOG_WARN("Ignore option '%s' because the routing file '%s' does not exist.\n",
+                     VPR_INCREMENTAL_ROUTE_OPTION, route_fname.c_str());
+        return;
+    }
+
+    VTR_LOG("Route incrementally from routing file '%s'\n", route_fname.c_str());
+    vpr_setup.RouterOpts.incremental_route_file = route_fname;
+}
+
+/**
+ * Release the memory of a container, which clear() keeps
+ */
+template<class T>
+static void release_container(T& container) {
+    container = T();
+}
+
+/**
+ * Free the data structures which are only used by the placer and the router
+ * The commands of OpenFPGA only need the device, the netlists, the placement
+ * and the routing traces, as well as the terminals of the nets and
+ * the timing graph to compute the net delays and the critical path
+ * The placement delay model, the route budgets and the timing analyzers
+ * are freed by VPR itself when the placer and the router return
+ */
+static void free_vpr_unused_contexts() {
+    vtr::ScopedStartFinishTimer timer("Free VPR data structures unused by OpenFPGA");
+
+    auto& place_ctx = g_vpr_ctx.mutable_placement();
+    release_container(place_ctx.compressed_block_grids);
+    release_container(place_ctx.pl_macros);
+
+    /* Heap of the router in this thread: the other threads free theirs when they exit */
+    empty_heap();
+    free_route_structs();
+
+    auto& route_ctx = g_vpr_ctx.mutable_routing();
+    route_ctx.cached_router_lookahead_.clear();
+    release_container(route_ctx.trace_nodes);
+    release_container(route_ctx.rr_blk_source);
+    release_container(route_ctx.rr_node_route_inf);
+    release_container(route_ctx.net_status);
+    release_container(route_ctx.route_bb);
+    release_container(route_ctx.clb_opins_used_locally);
+
+    /* Give the freed pages back to the system */
+    vtr::malloc_trim(0);
+}
+
 /**
  * VPR program
  * Generate FPGA architecture given architecture description
@@ -44,18 +381,42 @@ int vpr(int argc, char** argv) {
     /* Arch should NOT be freed once this function is done */
     t_arch* Arch = new t_arch;
     t_vpr_setup vpr_setup = t_vpr_setup();
+    std::vector<t_lookahead_cache_file> cache_files;
+
+    /* The options of the lookahead cache, the freeing of contexts and the incremental routing
+     * are handled by this wrapper rather than VPR */
+    std::vector<char*> vpr_argv;
+    t_vpr_wrapper_options wrapper_opts = extract_wrapper_options(argc, argv, vpr_argv);
+    const std::string& cache_dir = wrapper_opts.cache_dir;
 
     try {
         vpr_install_signal_handler();
 
         /* Read options, architecture, and circuit netlist */
-        vpr_init(argc, const_cast<const char**>(argv), &Options, &vpr_setup, Arch);
+        vpr_init(vpr_argv.size(), const_cast<const char**>(vpr_argv.data()), &Options, &vpr_setup, Arch);
 
         if (Options.show_version) {
             return SUCCESS_EXIT_CODE;
         }
 
-        bool flow_succeeded = vpr_flow(vpr_setup, *Arch);
+        if (!cache_dir.empty()) {
+            setup_rr_graph_check_cache(cache_dir, Options, vpr_setup, cache_files);
+            setup_lookahead_cache(cache_dir, Options, vpr_setup, *Arch, cache_files);
+        }
+
+        if (!wrapper_opts.incremental_route_file.empty()) {
+            setup_incremental_route(wrapper_opts.incremental_route_file, vpr_setup, *Arch);
+        }
+
+        bool flow_succeeded = false;
+        try {
+            flow_succeeded = vpr_flow(vpr_setup, *Arch);
+        } catch (...) {
+            finish_lookahead_cache(cache_files, false);
+            throw;
+        }
+        finish_lookahead_cache(cache_files, flow_succeeded);
+
         if (!flow_succeeded) {
             VTR_LOG("VPR failed to implement circuit\n");
             return UNIMPLEMENTABLE_EXIT_CODE;
@@ -71,6 +432,10 @@ int vpr(int argc, char** argv) {
                 timing_ctx.stats.num_full_hold_updates,
                 timing_ctx.stats.num_full_setup_hold_updates);
 
+        if (wrapper_opts.free_unused_contexts) {
+            free_vpr_unused_contexts();
+        }
+
         /* TODO: move this to the end of flow 
          * free data structures 
          */
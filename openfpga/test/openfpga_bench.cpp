@@ -0,0 +1,240 @@
+/********************************************************************
+ * Micro-benchmarks on the core data structures of OpenFPGA
+ * Each benchmark builds a synthetic fabric of tiles in a NxN array
+ * and reports the runtime and memory usage on one line, e.g.,
+ *   module_nets,100,0.42,120.5
+ * which includes the name of benchmark, the size N,
+ * the runtime in seconds and the peak memory in MiB
+ *
+ * Usage: openfpga_bench [<size> ...]
+ * By default, sizes of 10, 50, 100 and 200 are used
+ *******************************************************************/
+#include <cstdlib>
+#include <string>
+#include <vector>
+
+/* Headers from vtrutils */
+#include "vtr_assert.h"
+#include "vtr_log.h"
+#include "vtr_time.h"
+
+/* Headers from libarchopenfpga */
+#include "circuit_library.h"
+
+/* Headers from fpga bitstream library */
+#include "bitstream_manager.h"
+#include "write_xml_arch_bitstream.h"
+
+/* Headers from openfpga */
+#include "module_manager.h"
+#include "fabric_bitstream.h"
+#include "mux_graph.h"
+
+/* Number of pins of each port of a tile */
+constexpr size_t BENCH_TILE_PORT_WIDTH = 32;
+/* Number of configuration bits of each tile */
+constexpr size_t BENCH_TILE_NUM_BITS = 256;
+
+/********************************************************************
+ * Report the results of a benchmark
+ *******************************************************************/
+static
+void report_bench(const std::string& bench_name,
+                  const size_t& size,
+                  const vtr::Timer& timer) {
+  VTR_LOG("%s,%lu,%g,%g\n",
+          bench_name.c_str(), size,
+          timer.elapsed_sec(), timer.max_rss_mib());
+}
+
+/********************************************************************
+ * Create a top module with NxN tiles, where each tile has 4 ports
+ * and the nets connect each tile to its right and upper neighbours
+ * Return the top module
+ *******************************************************************/
+static
+openfpga::ModuleId build_bench_module_graph(openfpga::ModuleManager& module_manager,
+                                            const size_t& size) {
+  openfpga::ModuleId tile_module = module_manager.add_module("tile");
+  for (const std::string& side : {"left", "right", "bottom", "top"}) {
+    module_manager.add_port(tile_module, openfpga::BasicPort(side + "_in", BENCH_TILE_PORT_WIDTH), openfpga::ModuleManager::MODULE_INPUT_PORT);
+    module_manager.add_port(tile_module, openfpga::BasicPort(side + "_out", BENCH_TILE_PORT_WIDTH), openfpga::ModuleManager::MODULE_OUTPUT_PORT);
+  }
+
+  openfpga::ModuleId top_module = module_manager.add_module("top");
+  for (size_t itile = 0; itile < size * size; ++itile) {
+    module_manager.add_child_module(top_module, tile_module);
+  }
+
+  openfpga::ModulePortId right_out = module_manager.find_module_port(tile_module, "right_out");
+  openfpga::ModulePortId left_in = module_manager.find_module_port(tile_module, "left_in");
+  openfpga::ModulePortId top_out = module_manager.find_module_port(tile_module, "top_out");
+  openfpga::ModulePortId bottom_in = module_manager.find_module_port(tile_module, "bottom_in");
+  std::vector<size_t> pins(BENCH_TILE_PORT_WIDTH);
+  for (size_t ipin = 0; ipin < pins.size(); ++ipin) {
+    pins[ipin] = ipin;
+  }
+
+  module_manager.reserve_module_nets(top_module, 2 * size * size * BENCH_TILE_PORT_WIDTH);
+  for (size_t ix = 0; ix < size; ++ix) {
+    for (size_t iy = 0; iy < size; ++iy) {
+      size_t tile_instance = ix * size + iy;
+      if (ix + 1 < size) {
+        module_manager.add_module_nets_between_pins(top_module,
+                                                    tile_module, tile_instance, right_out, pins,
+                                                    tile_module, tile_instance + size, left_in, pins);
+      }
+      if (iy + 1 < size) {
+        module_manager.add_module_nets_between_pins(top_module,
+                                                    tile_module, tile_instance, top_out, pins,
+                                                    tile_module, tile_instance + 1, bottom_in, pins);
+      }
+    }
+  }
+
+  return top_module;
+}
+
+/********************************************************************
+ * Benchmark the creation of nets and the look-up on ports in module graph
+ *******************************************************************/
+static
+void bench_module_manager(const size_t& size) {
+  openfpga::ModuleManager module_manager;
+  openfpga::ModuleId top_module;
+  {
+    vtr::Timer timer;
+    top_module = build_bench_module_graph(module_manager, size);
+    report_bench("module_nets", size, timer);
+  }
+
+  {
+    vtr::Timer timer;
+    openfpga::ModuleId tile_module = module_manager.find_module("tile");
+    size_t num_found = 0;
+    for (size_t itile = 0; itile < size * size; ++itile) {
+      for (const std::string& port_name : {"left_in", "right_out", "bottom_in", "top_out", "unknown"}) {
+        if (openfpga::ModulePortId::INVALID() != module_manager.find_module_port(tile_module, port_name)) {
+          num_found++;
+        }
+      }
+    }
+    VTR_ASSERT(4 * size * size == num_found);
+    report_bench("find_module_port", size, timer);
+  }
+
+  {
+    vtr::Timer timer;
+    openfpga::ModuleId tile_module = module_manager.find_module("tile");
+    openfpga::ModulePortId right_out = module_manager.find_module_port(tile_module, "right_out");
+    size_t num_nets = 0;
+    for (size_t itile = 0; itile < size * size; ++itile) {
+      for (size_t ipin = 0; ipin < BENCH_TILE_PORT_WIDTH; ++ipin) {
+        if (openfpga::ModuleNetId::INVALID() != module_manager.module_instance_port_net(top_module, tile_module, itile, right_out, ipin)) {
+          num_nets++;
+        }
+      }
+    }
+    VTR_ASSERT((size - 1) * size * BENCH_TILE_PORT_WIDTH == num_nets);
+    report_bench("module_instance_port_net", size, timer);
+  }
+}
+
+/********************************************************************
+ * Benchmark the insertion of bits to bitstream databases
+ * and the writer of architecture bitstream
+ *******************************************************************/
+static
+void bench_bitstream(const size_t& size) {
+  openfpga::BitstreamManager bitstream_manager;
+  {
+    vtr::Timer timer;
+    openfpga::ConfigBlockId top_block = bitstream_manager.add_block("top");
+    for (size_t itile = 0; itile < size * size; ++itile) {
+      openfpga::ConfigBlockId tile_block = bitstream_manager.add_block(std::string("tile_") + std::to_string(itile) + std::string("_"));
+      bitstream_manager.add_child_block(top_block, tile_block);
+      for (size_t ibit = 0; ibit < BENCH_TILE_NUM_BITS; ++ibit) {
+        bitstream_manager.add_bit(tile_block, 0 == ibit % 3);
+      }
+    }
+    report_bench("bitstream_manager_add_bit", size, timer);
+  }
+
+  {
+    vtr::Timer timer;
+    openfpga::FabricBitstream fabric_bitstream;
+    /* Address bits as a memory bank, where each bit has a BL and a WL address */
+    size_t addr_length = 1;
+    while ((size_t(1) << addr_length) < size * BENCH_TILE_NUM_BITS) {
+      addr_length++;
+    }
+    fabric_bitstream.set_use_address(true);
+    fabric_bitstream.set_use_wl_address(true);
+    fabric_bitstream.set_bl_address_length(addr_length);
+    fabric_bitstream.set_wl_address_length(addr_length);
+    fabric_bitstream.reserve_bits(bitstream_manager.num_bits());
+    std::vector<char> bl_address(addr_length, '0');
+    std::vector<char> wl_address(addr_length, '0');
+    for (const openfpga::ConfigBitId& config_bit : bitstream_manager.bits()) {
+      openfpga::FabricBitId fabric_bit = fabric_bitstream.add_bit(config_bit);
+      for (size_t iaddr = 0; iaddr < addr_length; ++iaddr) {
+        bl_address[iaddr] = (size_t(config_bit) >> iaddr) & 1 ? '1' : '0';
+        wl_address[iaddr] = (size_t(config_bit) >> (iaddr + 1)) & 1 ? '1' : '0';
+      }
+      fabric_bitstream.set_bit_bl_address(fabric_bit, bl_address);
+      fabric_bitstream.set_bit_wl_address(fabric_bit, wl_address);
+      fabric_bitstream.set_bit_din(fabric_bit, bitstream_manager.bit_value(config_bit) ? '1' : '0');
+    }
+    report_bench("fabric_bitstream_address", size, timer);
+  }
+
+  {
+    vtr::Timer timer;
+    openfpga::write_xml_architecture_bitstream(bitstream_manager, std::string("/dev/null"));
+    report_bench("write_xml_architecture_bitstream", size, timer);
+  }
+}
+
+/********************************************************************
+ * Benchmark the decoding of memory bits of a tree-like multiplexer
+ * whose size is the size of benchmark
+ *******************************************************************/
+static
+void bench_mux_graph(const size_t& size) {
+  CircuitLibrary circuit_lib;
+  CircuitModelId pass_gate_model = circuit_lib.add_model(CIRCUIT_MODEL_PASSGATE);
+  circuit_lib.set_model_name(pass_gate_model, "tgate");
+  CircuitModelId mux_model = circuit_lib.add_model(CIRCUIT_MODEL_MUX);
+  circuit_lib.set_model_name(mux_model, "mux_tree");
+  circuit_lib.set_mux_structure(mux_model, CIRCUIT_MODEL_STRUCTURE_TREE);
+  circuit_lib.set_model_pass_gate_logic(mux_model, "tgate");
+  circuit_lib.build_model_links();
+
+  vtr::Timer timer;
+  openfpga::MuxGraph mux_graph(circuit_lib, mux_model, size);
+  for (size_t input = 0; input < mux_graph.num_inputs(); ++input) {
+    mux_graph.decode_memory_bits(openfpga::MuxInputId(input), openfpga::MuxOutputId(0));
+  }
+  report_bench("mux_graph_decode", size, timer);
+}
+
+int main(int argc, const char** argv) {
+  std::vector<size_t> sizes;
+  for (int iarg = 1; iarg < argc; ++iarg) {
+    int size = std::atoi(argv[iarg]);
+    VTR_ASSERT(1 < size);
+    sizes.push_back(size_t(size));
+  }
+  if (true == sizes.empty()) {
+    sizes = {10, 50, 100, 200};
+  }
+
+  VTR_LOG("benchmark,size,time,max_rss\n");
+  for (const size_t& size : sizes) {
+    bench_module_manager(size);
+    bench_bitstream(size);
+    bench_mux_graph(size);
+  }
+
+  return 0;
+}
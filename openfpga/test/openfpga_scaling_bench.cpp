@@ -0,0 +1,311 @@
+/********************************************************************
+ * End-to-end scaling benchmark of OpenFPGA
+ * The benchmark drives the shell in the same process, running a script
+ * (by default, the example script of openfpga_flow) on fixed-layout
+ * fabrics of NxN grids, and reports the runtime and memory usage
+ * of each command to a JSON file, e.g.,
+ *   {"results": [{"size": 8, "commands": [{"command": "vpr", "status": 0,
+ *     "wall_time": 1.2, "cpu_time": 1.1, "max_rss": 80.5, "delta_max_rss": 60.1}, ...]}, ...]}
+ * The runtime is in seconds and the memory is in MiB
+ *
+ * The variables of the script, e.g., ${VPR_ARCH_FILE}, are replaced
+ * in the same way as the openfpga_flow scripts do.
+ * The auto layout of the VPR architecture is replaced by a fixed layout,
+ * which is selected by the '--device' option of the vpr command.
+ * Each size is run with a new context in its own directory scaling_bench_<N>
+ *
+ * Usage: openfpga_scaling_bench [--output <json>] [--route_chan_width <width>] [<size> ...]
+ * By default, sizes of 8, 16, 32, 64 and 128 are used
+ *******************************************************************/
+#include <sys/stat.h>
+#include <unistd.h>
+
+#include <cstdlib>
+#include <fstream>
+#include <sstream>
+#include <string>
+#include <vector>
+
+/* Headers from vtrutils */
+#include "vtr_assert.h"
+#include "vtr_log.h"
+
+/* Headers from libopenfpgashell library */
+#include "shell.h"
+
+/* Headers from openfpga */
+#include "vpr_command.h"
+#include "openfpga_setup_command.h"
+#include "openfpga_verilog_command.h"
+#include "openfpga_bitstream_command.h"
+#include "openfpga_spice_command.h"
+#include "openfpga_sdc_command.h"
+#include "basic_command.h"
+#include "openfpga_context.h"
+
+#ifndef OPENFPGA_SOURCE_DIR
+#  define OPENFPGA_SOURCE_DIR "."
+#endif
+
+/* Name of the fixed layout added to the VPR architecture */
+constexpr const char* SCALING_BENCH_LAYOUT_NAME = "scaling_bench";
+
+/********************************************************************
+ * Input files of the benchmark, which are those of the task
+ * basic_tests/fixed_simulation_settings of openfpga_flow
+ *******************************************************************/
+struct t_scaling_bench_files {
+  std::string script;
+  std::string vpr_arch;
+  std::string openfpga_arch;
+  std::string sim_setting;
+  std::string blif;
+  std::string activity;
+  std::string verilog;
+};
+
+static
+t_scaling_bench_files default_scaling_bench_files() {
+  const std::string flow_dir = std::string(OPENFPGA_SOURCE_DIR) + "/openfpga_flow/";
+  t_scaling_bench_files files;
+  files.script = flow_dir + "openfpga_shell_scripts/example_script.openfpga";
+  files.vpr_arch = flow_dir + "vpr_arch/k4_N4_tileable_40nm.xml";
+  files.openfpga_arch = flow_dir + "openfpga_arch/k4_N4_40nm_fixed_sim_openfpga.xml";
+  files.sim_setting = flow_dir + "openfpga_simulation_settings/fixed_sim_openfpga.xml";
+  files.blif = flow_dir + "benchmarks/micro_benchmark/and2/and2.blif";
+  files.activity = flow_dir + "benchmarks/micro_benchmark/and2/and2.act";
+  files.verilog = flow_dir + "benchmarks/micro_benchmark/and2/and2.v";
+  return files;
+}
+
+/********************************************************************
+ * Read a file to a string, error out if the file cannot be read
+ *******************************************************************/
+static
+std::string read_bench_file(const std::string& fname) {
+  std::ifstream fp(fname.c_str());
+  if (!fp.is_open()) {
+    VTR_LOG_ERROR("Fail to open file '%s'!\n", fname.c_str());
+    std::exit(1);
+  }
+  std::stringstream content;
+  content << fp.rdbuf();
+  return content.str();
+}
+
+static
+void write_bench_file(const std::string& fname, const std::string& content) {
+  std::ofstream fp(fname.c_str());
+  if (!fp.is_open()) {
+    VTR_LOG_ERROR("Fail to write file '%s'!\n", fname.c_str());
+    std::exit(1);
+  }
+  fp << content;
+}
+
+/* Replace all the occurrences of a pattern in a string */
+static
+void replace_all(std::string& content,
+                 const std::string& pattern,
+                 const std::string& substitute) {
+  for (size_t pos = content.find(pattern);
+       std::string::npos != pos;
+       pos = content.find(pattern, pos + substitute.size())) {
+    content.replace(pos, pattern.size(), substitute);
+  }
+}
+
+/********************************************************************
+ * Write a copy of the VPR architecture, where the auto layout
+ * becomes a fixed layout of NxN grids
+ *******************************************************************/
+static
+void write_scaling_vpr_arch(const std::string& vpr_arch_fname,
+                            const std::string& out_fname,
+                            const size_t& size) {
+  std::string arch = read_bench_file(vpr_arch_fname);
+
+  size_t start = arch.find("<auto_layout");
+  size_t start_end = arch.find('>', start);
+  size_t end = arch.find("</auto_layout>");
+  if ((std::string::npos == start) || (std::string::npos == end) || (end < start_end)) {
+    VTR_LOG_ERROR("No auto layout is found in VPR architecture '%s'!\n",
+                  vpr_arch_fname.c_str());
+    std::exit(1);
+  }
+  arch.replace(end, std::string("</auto_layout>").size(), "</fixed_layout>");
+  arch.replace(start, start_end + 1 - start,
+               std::string("<fixed_layout name=\"") + SCALING_BENCH_LAYOUT_NAME
+               + "\" width=\"" + std::to_string(size)
+               + "\" height=\"" + std::to_string(size) + "\">");
+
+  write_bench_file(out_fname, arch);
+}
+
+/********************************************************************
+ * Write a copy of the script, where the variables are replaced,
+ * the vpr command selects the fixed layout and the exit command is removed,
+ * so that the shell returns to the benchmark
+ *******************************************************************/
+static
+void write_scaling_script(const t_scaling_bench_files& files,
+                          const std::string& vpr_arch_fname,
+                          const std::string& out_fname,
+                          const size_t& route_chan_width) {
+  std::istringstream script(read_bench_file(files.script));
+  std::string content;
+  std::string line;
+  while (std::getline(script, line)) {
+    if ("exit" == line.substr(0, line.find_first_of(" #"))) {
+      continue;
+    }
+    if (0 == line.compare(0, 4, "vpr ")) {
+      line += " --device " + std::string(SCALING_BENCH_LAYOUT_NAME)
+            + " --route_chan_width " + std::to_string(route_chan_width);
+    }
+    content += line + "\n";
+  }
+
+  replace_all(content, "${VPR_ARCH_FILE}", vpr_arch_fname);
+  replace_all(content, "${VPR_TESTBENCH_BLIF}", files.blif);
+  replace_all(content, "${OPENFPGA_ARCH_FILE}", files.openfpga_arch);
+  replace_all(content, "${OPENFPGA_SIM_SETTING_FILE}", files.sim_setting);
+  replace_all(content, "${ACTIVITY_FILE}", files.activity);
+  replace_all(content, "${REFERENCE_VERILOG_TESTBENCH}", files.verilog);
+
+  write_bench_file(out_fname, content);
+}
+
+/********************************************************************
+ * Convert the profile report of the shell to the JSON objects of commands
+ * The CSV columns are index,command,status,wall_time,cpu_time,max_rss,delta_max_rss
+ *******************************************************************/
+static
+std::string profile_report_to_json(const std::string& profile_fname) {
+  std::istringstream report(read_bench_file(profile_fname));
+  std::string line;
+  /* Skip the header */
+  std::getline(report, line);
+
+  std::string json;
+  while (std::getline(report, line)) {
+    std::vector<std::string> fields;
+    std::istringstream line_stream(line);
+    for (std::string field; std::getline(line_stream, field, ',');) {
+      fields.push_back(field);
+    }
+    VTR_ASSERT(7 == fields.size());
+    if (false == json.empty()) {
+      json += ",\n";
+    }
+    json += "      {\"command\": \"" + fields[1] + "\""
+          + ", \"status\": " + fields[2]
+          + ", \"wall_time\": " + fields[3]
+          + ", \"cpu_time\": " + fields[4]
+          + ", \"max_rss\": " + fields[5]
+          + ", \"delta_max_rss\": " + fields[6] + "}";
+  }
+  return json;
+}
+
+/********************************************************************
+ * Run the flow on a NxN fabric with a new shell and context
+ * Return the JSON object of the results
+ *******************************************************************/
+static
+std::string bench_scaling(const t_scaling_bench_files& files,
+                          const size_t& size,
+                          const size_t& route_chan_width) {
+  const std::string work_dir = "scaling_bench_" + std::to_string(size);
+  mkdir(work_dir.c_str(), 0755);
+  if (0 != chdir(work_dir.c_str())) {
+    VTR_LOG_ERROR("Fail to enter directory '%s'!\n", work_dir.c_str());
+    std::exit(1);
+  }
+
+  write_scaling_vpr_arch(files.vpr_arch, "vpr_arch.xml", size);
+  write_scaling_script(files, "vpr_arch.xml", "scaling_bench.openfpga", route_chan_width);
+
+  /* Build the shell in the same way as the openfpga executable */
+  openfpga::Shell<OpenfpgaContext> shell("OpenFPGA");
+  openfpga::add_vpr_commands(shell);
+  openfpga::add_openfpga_setup_commands(shell);
+  openfpga::add_openfpga_verilog_commands(shell);
+  openfpga::add_openfpga_bitstream_commands(shell);
+  openfpga::add_openfpga_spice_commands(shell);
+  openfpga::add_openfpga_sdc_commands(shell);
+  openfpga::add_basic_commands(shell);
+
+  shell.set_profile_file("profile.csv");
+
+  {
+    OpenfpgaContext openfpga_context;
+    /* Batch mode: abort the benchmark on fatal errors */
+    shell.run_script_mode("scaling_bench.openfpga", openfpga_context, true);
+  }
+  shell.write_profile_report();
+
+  std::string json = "    {\"size\": " + std::to_string(size)
+                   + ", \"exit_code\": " + std::to_string(shell.exit_code())
+                   + ", \"commands\": [\n"
+                   + profile_report_to_json("profile.csv")
+                   + "\n    ]}";
+
+  if (0 != chdir("..")) {
+    VTR_LOG_ERROR("Fail to leave directory '%s'!\n", work_dir.c_str());
+    std::exit(1);
+  }
+
+  return json;
+}
+
+int main(int argc, const char** argv) {
+  std::string output_fname("scaling_bench.json");
+  size_t route_chan_width = 300;
+  std::vector<size_t> sizes;
+  for (int iarg = 1; iarg < argc; ++iarg) {
+    const std::string arg(argv[iarg]);
+    if (("--output" == arg) && (iarg + 1 < argc)) {
+      output_fname = argv[++iarg];
+      continue;
+    }
+    if (("--route_chan_width" == arg) && (iarg + 1 < argc)) {
+      int width = std::atoi(argv[++iarg]);
+      VTR_ASSERT(0 < width);
+      route_chan_width = size_t(width);
+      continue;
+    }
+    int size = std::atoi(argv[iarg]);
+    VTR_ASSERT(2 < size);
+    sizes.push_back(size_t(size));
+  }
+  if (true == sizes.empty()) {
+    sizes = {8, 16, 32, 64, 128};
+  }
+
+  /* Output file is relative to the directory where the benchmark is launched */
+  if ('/' != output_fname.front()) {
+    char* cwd = getcwd(nullptr, 0);
+    output_fname = std::string(cwd) + "/" + output_fname;
+    std::free(cwd);
+  }
+
+  const t_scaling_bench_files files = default_scaling_bench_files();
+
+  std::string json = "{\n  \"script\": \"" + files.script + "\",\n"
+                   + "  \"route_chan_width\": " + std::to_string(route_chan_width) + ",\n"
+                   + "  \"results\": [\n";
+  for (size_t isize = 0; isize < sizes.size(); ++isize) {
+    if (0 < isize) {
+      json += ",\n";
+    }
+    json += bench_scaling(files, sizes[isize], route_chan_width);
+  }
+  json += "\n  ]\n}\n";
+
+  write_bench_file(output_fname, json);
+  VTR_LOG("Wrote the results of %lu sizes to '%s'\n",
+          sizes.size(), output_fname.c_str());
+
+  return 0;
+}
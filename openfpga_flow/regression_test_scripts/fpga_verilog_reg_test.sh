@@ -95,6 +95,9 @@ run-task fpga_verilog/mux_design/const_input_gnd --debug --show_thread_logs
 echo -e "Testing Verilog generation with routing multiplexers without constant inputs";
 run-task fpga_verilog/mux_design/no_const_input --debug --show_thread_logs
 
+echo -e "Testing Verilog testbenches relying on the signal initialization of fabric netlists with standard cell MUX2";
+run-task fpga_verilog/signal_init/fabric_signal_init_stdcell_mux2 --debug --show_thread_logs
+
 echo -e "Testing Verilog generation with behavioral description";
 run-task fpga_verilog/verilog_netlist_formats/behavioral_verilog --debug --show_thread_logs
 run-task fpga_verilog/verilog_netlist_formats/behavioral_verilog_default_nettype_wire --debug --show_thread_logs
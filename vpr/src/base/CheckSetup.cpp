@@ -73,6 +73,14 @@ void CheckSetup(const t_packer_opts& PackerOpts,
         VPR_FATAL_ERROR(VPR_ERROR_OTHER,
                         "Place channel width must be positive.\n");
     }
+    if (PlacerOpts.move_batch_size < 1) {
+        VPR_FATAL_ERROR(VPR_ERROR_OTHER,
+                        "Placement move batch size must be positive.\n");
+    }
+    if (PlacerOpts.incremental_sta_full_update_period < 1) {
+        VPR_FATAL_ERROR(VPR_ERROR_OTHER,
+                        "Placement incremental timing analysis full update period must be positive.\n");
+    }
     if ((RouterOpts.fixed_channel_width != NO_FIXED_CHANNEL_WIDTH) && RouterOpts.fixed_channel_width < 0) {
         VPR_FATAL_ERROR(VPR_ERROR_OTHER,
                         "Routing channel width must be positive.\n");
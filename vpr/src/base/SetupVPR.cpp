@@ -377,6 +377,7 @@ static void SetupRouterOpts(const t_options& Options, t_router_opts* RouterOpts)
     RouterOpts->max_convergence_count = Options.router_max_convergence_count;
     RouterOpts->reconvergence_cpd_threshold = Options.router_reconvergence_cpd_threshold;
     RouterOpts->first_iteration_timing_report_file = Options.router_first_iteration_timing_report_file;
+    RouterOpts->parallel_net_routing = Options.parallel_net_routing;
 
     RouterOpts->strict_checks = Options.strict_checks;
 
@@ -501,6 +502,7 @@ static void SetupPlacerOpts(const t_options& Options, t_placer_opts* PlacerOpts)
     PlacerOpts->tsu_abs_margin = Options.place_tsu_abs_margin;
     PlacerOpts->delay_model_type = Options.place_delay_model;
     PlacerOpts->delay_model_reducer = Options.place_delay_model_reducer;
+    PlacerOpts->place_delta_delay_matrix_calculation_method = Options.place_delta_delay_matrix_calculation_method;
 
     //TODO: document?
     PlacerOpts->place_freq = PLACE_ONCE; /* DEFAULT */
@@ -509,6 +511,9 @@ static void SetupPlacerOpts(const t_options& Options, t_placer_opts* PlacerOpts)
 
     PlacerOpts->rlim_escape_fraction = Options.place_rlim_escape_fraction;
     PlacerOpts->move_stats_file = Options.place_move_stats_file;
+    PlacerOpts->move_batch_size = Options.place_move_batch_size;
+    PlacerOpts->incremental_sta = Options.place_incremental_sta;
+    PlacerOpts->incremental_sta_full_update_period = Options.place_incremental_sta_full_update_period;
 
     PlacerOpts->strict_checks = Options.strict_checks;
 
@@ -190,6 +190,9 @@ class AtomNetlist : public Netlist<AtomBlockId, AtomPortId, AtomPinId, AtomNetId
     //Shrinks internal data structures to required size to reduce memory consumption
     void shrink_to_fit_impl() override;
 
+    //Reserves internal data structures for the expected netlist size
+    void reserve_impl(size_t num_blocks, size_t num_ports, size_t num_pins, size_t num_nets) override;
+
     /*
      * Sanity checks
      */
@@ -276,6 +276,20 @@ void ClusteredNetlist::shrink_to_fit_impl() {
     net_is_global_.shrink_to_fit();
 }
 
+void ClusteredNetlist::reserve_impl(size_t num_blocks, size_t /*num_ports*/, size_t num_pins, size_t num_nets) {
+    //Block data
+    block_pbs_.reserve(num_blocks);
+    block_types_.reserve(num_blocks);
+    block_logical_pins_.reserve(num_blocks);
+
+    //Pin data
+    pin_logical_index_.reserve(num_pins);
+
+    //Net data
+    net_is_ignored_.reserve(num_nets);
+    net_is_global_.reserve(num_nets);
+}
+
 /*
  *
  * Sanity Checks
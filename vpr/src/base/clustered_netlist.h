@@ -213,6 +213,9 @@ class ClusteredNetlist : public Netlist<ClusterBlockId, ClusterPortId, ClusterPi
     //Shrinks internal data structures to required size to reduce memory consumption
     void shrink_to_fit_impl() override;
 
+    //Reserves internal data structures for the expected netlist size
+    void reserve_impl(size_t num_blocks, size_t num_ports, size_t num_pins, size_t num_nets) override;
+
     /*
      * Component removal
      */
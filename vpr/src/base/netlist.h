@@ -408,6 +408,7 @@
  *       clean_*()
  *       validate_*_sizes()
  *       shrink_to_fit()
+ *       reserve()
  *    The derived functions based off of the virtual functions have suffix *_impl()
  *
  */
@@ -735,6 +736,15 @@ class Netlist {
     //  sink_net: The target net to be merged into driver_net (must have no driver pin)
     void merge_nets(const NetId driver_net, const NetId sink_net);
 
+    //Reserves space for the specified number of components, which avoids repeated
+    //re-allocations when the size of the netlist is known (or estimated) before it is built.
+    //Any excess capacity is released by compress()
+    //  num_blocks : The expected number of blocks
+    //  num_ports  : The expected number of ports
+    //  num_pins   : The expected number of pins
+    //  num_nets   : The expected number of nets
+    void reserve(size_t num_blocks, size_t num_ports, size_t num_pins, size_t num_nets);
+
     /*
      * Note: all remove_*() will mark the associated items as invalid, but the items
      * will not be removed until compress() is called.
@@ -901,6 +911,7 @@ class Netlist {
     //The functions follow the Non-Virtual Interface (NVI) idiom, and
     //are called from this class in their respective non-impl() functions.
     virtual void shrink_to_fit_impl() = 0;
+    virtual void reserve_impl(size_t num_blocks, size_t num_ports, size_t num_pins, size_t num_nets) = 0;
 
     virtual bool validate_block_sizes_impl(size_t num_blocks) const = 0;
     virtual bool validate_port_sizes_impl(size_t num_ports) const = 0;
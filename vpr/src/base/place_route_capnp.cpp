@@ -0,0 +1,341 @@
+/*
+ * This file defines the readers and the writers of the placement and the
+ * routing in the binary Cap'n Proto format.
+ *
+ * The messages contain the same information as the .place and .route
+ * files (see read_place.cpp and read_route.cpp), stored in the sequence of
+ * block and net ids. The readers memory-map the files and check them
+ * against the clustered netlist, the placement and the device, without
+ * parsing any text.
+ */
+#include <limits>
+
+#include "vtr_assert.h"
+#include "vtr_util.h"
+#include "vtr_log.h"
+#include "vtr_digest.h"
+
+#include "globals.h"
+#include "vpr_error.h"
+#include "route_common.h"
+
+#include "place_route_capnp.h"
+
+#ifdef VTR_ENABLE_CAPNPROTO
+#    include "capnp/serialize.h"
+#    include "kj/exception.h"
+#    include "place_route.capnp.h"
+#    include "mmap_file.h"
+#    include "serdes_utils.h"
+#endif /* VTR_ENABLE_CAPNPROTO */
+
+//
+// When VPR is compiled with VTR_ENABLE_CAPNPROTO=OFF, the binary format
+// is not available, and the functions throw an exception instead.
+//
+#ifndef VTR_ENABLE_CAPNPROTO
+
+#    define DISABLE_ERROR                              \
+        "is disable because VTR_ENABLE_CAPNPROTO=OFF." \
+        "Re-compile with CMake option VTR_ENABLE_CAPNPROTO=ON to enable."
+
+void read_capnp_place(const char* /*net_file*/,
+                      const char* /*place_file*/,
+                      bool /*verify_file_digests*/,
+                      const DeviceGrid& /*grid*/) {
+    VPR_THROW(VPR_ERROR_PLACE_F, "Reading binary placement " DISABLE_ERROR);
+}
+
+void write_capnp_place(const char* /*net_file*/,
+                       const char* /*net_id*/,
+                       const char* /*place_file*/) {
+    VPR_THROW(VPR_ERROR_PLACE_F, "Writing binary placement " DISABLE_ERROR);
+}
+
+void load_capnp_route(const char* /*route_file*/,
+                      const t_router_opts& /*router_opts*/,
+                      bool /*verify_file_digests*/) {
+    VPR_THROW(VPR_ERROR_ROUTE, "Reading binary routing " DISABLE_ERROR);
+}
+
+void write_capnp_route(const char* /*placement_file*/,
+                       const char* /*route_file*/) {
+    VPR_THROW(VPR_ERROR_ROUTE, "Writing binary routing " DISABLE_ERROR);
+}
+
+#else /* VTR_ENABLE_CAPNPROTO */
+
+/* A capnp list holds up to 2^29 - 1 elements */
+constexpr size_t MAX_CAPNP_LIST_SIZE = (size_t(1) << 29) - 1;
+
+static void check_list_size(size_t size, const char* list_name, enum e_vpr_error error_type) {
+    if (size > MAX_CAPNP_LIST_SIZE) {
+        VPR_THROW(error_type,
+                  "Number of %s (%zu) exceeds the capacity of the binary format (%zu)",
+                  list_name, size, MAX_CAPNP_LIST_SIZE);
+    }
+}
+
+/* The messages are read only once, and may exceed the default traversal limit of capnp (64 MiB) */
+static ::capnp::ReaderOptions unlimited_reader_options() {
+    ::capnp::ReaderOptions options;
+    options.traversalLimitInWords = std::numeric_limits<uint64_t>::max();
+    return options;
+}
+
+void read_capnp_place(const char* net_file,
+                      const char* place_file,
+                      bool verify_file_digests,
+                      const DeviceGrid& grid) {
+    auto& cluster_ctx = g_vpr_ctx.clustering();
+    auto& place_ctx = g_vpr_ctx.mutable_placement();
+
+    try {
+        MmapFile f(place_file);
+        ::capnp::FlatArrayMessageReader reader(f.getData(), unlimited_reader_options());
+
+        auto place_msg = reader.getRoot<VprPlacement>();
+
+        //Check that the netlist used to generate this placement matches the one loaded
+        if (std::string(place_msg.getNetlistId().cStr()) != cluster_ctx.clb_nlist.netlist_id()) {
+            auto msg = vtr::string_fmt(
+                "The packed netlist file that generated placement (File: '%s' ID: '%s')"
+                " does not match current netlist (File: '%s' ID: '%s')",
+                place_msg.getNetlistFile().cStr(), place_msg.getNetlistId().cStr(),
+                net_file, cluster_ctx.clb_nlist.netlist_id().c_str());
+            if (verify_file_digests) {
+                vpr_throw(VPR_ERROR_PLACE_F, place_file, 0, msg.c_str());
+            } else {
+                VTR_LOGF_WARN(place_file, 0, "%s\n", msg.c_str());
+            }
+        }
+
+        if (grid.width() != place_msg.getGridWidth() || grid.height() != place_msg.getGridHeight()) {
+            vpr_throw(VPR_ERROR_PLACE_F, place_file, 0,
+                      "Current FPGA size (%d x %d) is different from size when placement generated (%d x %d)",
+                      grid.width(), grid.height(), place_msg.getGridWidth(), place_msg.getGridHeight());
+        }
+
+        if (place_ctx.block_locs.size() != cluster_ctx.clb_nlist.blocks().size()) {
+            //Resize if needed
+            place_ctx.block_locs.resize(cluster_ctx.clb_nlist.blocks().size());
+        }
+
+        auto blocks = place_msg.getBlocks();
+        for (size_t iblk = 0; iblk < blocks.size(); ++iblk) {
+            auto block = blocks[iblk];
+
+            //Blocks are stored by their ids, unless the netlist is different
+            ClusterBlockId blk_id(iblk);
+            if (iblk >= cluster_ctx.clb_nlist.blocks().size()
+                || cluster_ctx.clb_nlist.block_name(blk_id) != block.getName().cStr()) {
+                blk_id = cluster_ctx.clb_nlist.find_block(block.getName().cStr());
+            }
+            if (!blk_id) {
+                vpr_throw(VPR_ERROR_PLACE_F, place_file, 0,
+                          "Block '%s' in placement file is not found in the netlist",
+                          block.getName().cStr());
+            }
+
+            //Set the location
+            place_ctx.block_locs[blk_id].loc.x = block.getX();
+            place_ctx.block_locs[blk_id].loc.y = block.getY();
+            place_ctx.block_locs[blk_id].loc.z = block.getZ();
+        }
+    } catch (kj::Exception& e) {
+        vpr_throw(VPR_ERROR_PLACE_F, place_file, e.getLine(), "%s", e.getDescription().cStr());
+    }
+
+    place_ctx.placement_id = vtr::secure_digest_file(place_file);
+}
+
+void write_capnp_place(const char* net_file,
+                       const char* net_id,
+                       const char* place_file) {
+    auto& device_ctx = g_vpr_ctx.device();
+    auto& cluster_ctx = g_vpr_ctx.clustering();
+    auto& place_ctx = g_vpr_ctx.mutable_placement();
+
+    ::capnp::MallocMessageBuilder builder;
+    auto place_msg = builder.initRoot<VprPlacement>();
+
+    place_msg.setNetlistFile(net_file != nullptr ? net_file : "");
+    place_msg.setNetlistId(net_id != nullptr ? net_id : "");
+    place_msg.setGridWidth(device_ctx.grid.width());
+    place_msg.setGridHeight(device_ctx.grid.height());
+
+    if (!place_ctx.block_locs.empty()) { //Only if placement exists
+        check_list_size(cluster_ctx.clb_nlist.blocks().size(), "blocks", VPR_ERROR_PLACE_F);
+        auto blocks = place_msg.initBlocks(cluster_ctx.clb_nlist.blocks().size());
+        size_t iblk = 0;
+        for (auto blk_id : cluster_ctx.clb_nlist.blocks()) {
+            auto block = blocks[iblk];
+            block.setName(cluster_ctx.clb_nlist.block_name(blk_id).c_str());
+            block.setX(place_ctx.block_locs[blk_id].loc.x);
+            block.setY(place_ctx.block_locs[blk_id].loc.y);
+            block.setZ(place_ctx.block_locs[blk_id].loc.z);
+            ++iblk;
+        }
+    }
+
+    writeMessageToFile(place_file, &builder);
+
+    //Calculate the ID of the placement
+    place_ctx.placement_id = vtr::secure_digest_file(place_file);
+}
+
+void load_capnp_route(const char* route_file,
+                      const t_router_opts& router_opts,
+                      bool verify_file_digests) {
+    auto& device_ctx = g_vpr_ctx.device();
+    auto& cluster_ctx = g_vpr_ctx.clustering();
+    auto& place_ctx = g_vpr_ctx.placement();
+    auto& route_ctx = g_vpr_ctx.mutable_routing();
+
+    try {
+        MmapFile f(route_file);
+        ::capnp::FlatArrayMessageReader reader(f.getData(), unlimited_reader_options());
+
+        auto route_msg = reader.getRoot<VprRouting>();
+
+        if (std::string(route_msg.getPlacementId().cStr()) != place_ctx.placement_id) {
+            auto msg = vtr::string_fmt(
+                "Placement file %s specified in the routing file"
+                " does not match the loaded placement (ID %s != %s)",
+                route_msg.getPlacementFile().cStr(), route_msg.getPlacementId().cStr(), place_ctx.placement_id.c_str());
+            if (verify_file_digests) {
+                vpr_throw(VPR_ERROR_ROUTE, route_file, 0, msg.c_str());
+            } else {
+                VTR_LOGF_WARN(route_file, 0, "%s\n", msg.c_str());
+            }
+        }
+
+        /*Allocate necessary routing structures*/
+        alloc_and_load_rr_node_route_structs();
+        init_route_structs(router_opts.bb_factor);
+
+        /*Check dimensions*/
+        if (route_msg.getGridWidth() != device_ctx.grid.width() || route_msg.getGridHeight() != device_ctx.grid.height()) {
+            vpr_throw(VPR_ERROR_ROUTE, route_file, 0,
+                      "Device dimensions %ux%u specified in the routing file does not match given %dx%d ",
+                      route_msg.getGridWidth(), route_msg.getGridHeight(), device_ctx.grid.width(), device_ctx.grid.height());
+        }
+
+        /* Node ids are only valid in the same routing resource graph */
+        size_t num_rr_nodes = device_ctx.rr_graph.nodes().size();
+        if (route_msg.getNumRrNodes() != num_rr_nodes) {
+            vpr_throw(VPR_ERROR_ROUTE, route_file, 0,
+                      "Number of rr nodes %lu specified in the routing file does not match the rr graph (%zu)",
+                      route_msg.getNumRrNodes(), num_rr_nodes);
+        }
+
+        auto nets = route_msg.getNets();
+        if (nets.size() != cluster_ctx.clb_nlist.nets().size()) {
+            vpr_throw(VPR_ERROR_ROUTE, route_file, 0,
+                      "Number of nets %u specified in the routing file does not match the netlist (%zu)",
+                      nets.size(), cluster_ctx.clb_nlist.nets().size());
+        }
+
+        for (auto inet : cluster_ctx.clb_nlist.nets()) {
+            auto net = nets[size_t(inet)];
+            if (0 != cluster_ctx.clb_nlist.net_name(inet).compare(net.getName().cStr())) {
+                vpr_throw(VPR_ERROR_ROUTE, route_file, 0,
+                          "Net name %s for net number %lu specified in the routing file does not match given %s",
+                          net.getName().cStr(), size_t(inet), cluster_ctx.clb_nlist.net_name(inet).c_str());
+            }
+
+            auto nodes = net.getNodes();
+            auto switches = net.getSwitches();
+            if (nodes.size() != switches.size()) {
+                vpr_throw(VPR_ERROR_ROUTE, route_file, 0,
+                          "Net %lu has %u nodes but %u switches in the routing file",
+                          size_t(inet), nodes.size(), switches.size());
+            }
+
+            t_trace* tptr = nullptr;
+            for (size_t inode = 0; inode < nodes.size(); ++inode) {
+                if (nodes[inode] >= num_rr_nodes) {
+                    vpr_throw(VPR_ERROR_ROUTE, route_file, 0,
+                              "Net %lu has an invalid node %u in the routing file",
+                              size_t(inet), nodes[inode]);
+                }
+                RRNodeId node(nodes[inode]);
+
+                /*First node needs to be source. It is isolated to correctly set heap head.*/
+                if (0 == inode && SOURCE != device_ctx.rr_graph.node_type(node)) {
+                    vpr_throw(VPR_ERROR_ROUTE, route_file, 0,
+                              "First node in routing of net %lu has to be a source type", size_t(inet));
+                }
+
+                /* Allocate and load correct values to trace.head*/
+                t_trace* next_tptr = alloc_trace_data();
+                next_tptr->index = node;
+                next_tptr->iswitch = switches[inode];
+                next_tptr->next = nullptr;
+                if (nullptr == tptr) {
+                    route_ctx.trace[inet].head = next_tptr;
+                } else {
+                    tptr->next = next_tptr;
+                }
+                tptr = next_tptr;
+            }
+            route_ctx.trace[inet].tail = tptr;
+        }
+    } catch (kj::Exception& e) {
+        vpr_throw(VPR_ERROR_ROUTE, route_file, e.getLine(), "%s", e.getDescription().cStr());
+    }
+}
+
+void write_capnp_route(const char* placement_file,
+                       const char* route_file) {
+    auto& device_ctx = g_vpr_ctx.device();
+    auto& cluster_ctx = g_vpr_ctx.clustering();
+    auto& place_ctx = g_vpr_ctx.placement();
+    auto& route_ctx = g_vpr_ctx.mutable_routing();
+
+    ::capnp::MallocMessageBuilder builder;
+    auto route_msg = builder.initRoot<VprRouting>();
+
+    route_msg.setPlacementFile(placement_file != nullptr ? placement_file : "");
+    route_msg.setPlacementId(place_ctx.placement_id.c_str());
+    route_msg.setGridWidth(device_ctx.grid.width());
+    route_msg.setGridHeight(device_ctx.grid.height());
+    route_msg.setNumRrNodes(device_ctx.rr_graph.nodes().size());
+
+    if (!route_ctx.trace.empty()) { //Only if routing exists
+        check_list_size(cluster_ctx.clb_nlist.nets().size(), "nets", VPR_ERROR_ROUTE);
+        auto nets = route_msg.initNets(cluster_ctx.clb_nlist.nets().size());
+        for (auto net_id : cluster_ctx.clb_nlist.nets()) {
+            auto net = nets[size_t(net_id)];
+            net.setName(cluster_ctx.clb_nlist.net_name(net_id).c_str());
+
+            /* Global nets and nets used in local clusters only are never routed */
+            if (cluster_ctx.clb_nlist.net_is_ignored(net_id)
+                || cluster_ctx.clb_nlist.net_sinks(net_id).empty()) {
+                continue;
+            }
+
+            size_t num_nodes = 0;
+            for (t_trace* tptr = route_ctx.trace[net_id].head; tptr != nullptr; tptr = tptr->next) {
+                ++num_nodes;
+            }
+            check_list_size(num_nodes, "nodes of a net", VPR_ERROR_ROUTE);
+
+            auto nodes = net.initNodes(num_nodes);
+            auto switches = net.initSwitches(num_nodes);
+            size_t inode = 0;
+            for (t_trace* tptr = route_ctx.trace[net_id].head; tptr != nullptr; tptr = tptr->next) {
+                nodes.set(inode, size_t(tptr->index));
+                switches.set(inode, tptr->iswitch);
+                ++inode;
+            }
+        }
+    }
+
+    writeMessageToFile(route_file, &builder);
+
+    //Save the digest of the route file
+    route_ctx.routing_id = vtr::secure_digest_file(route_file);
+}
+
+#endif /* VTR_ENABLE_CAPNPROTO */
@@ -0,0 +1,32 @@
+/*
+ * This file defines the functions to read and write the placement and
+ * the routing in the binary Cap'n Proto format
+ * (see libs/libvtrcapnproto/place_route.capnp), which is much faster to
+ * load than the .place and .route files for large designs.
+ * The format is selected by the '.capnp' extension of the files.
+ */
+
+#ifndef PLACE_ROUTE_CAPNP_H
+#define PLACE_ROUTE_CAPNP_H
+
+#include "device_grid.h"
+#include "vpr_types.h"
+
+void read_capnp_place(const char* net_file,
+                      const char* place_file,
+                      bool verify_file_digests,
+                      const DeviceGrid& grid);
+
+void write_capnp_place(const char* net_file,
+                       const char* net_id,
+                       const char* place_file);
+
+/* Load the tracebacks of the nets, after allocating the routing structures */
+void load_capnp_route(const char* route_file,
+                      const t_router_opts& router_opts,
+                      bool verify_file_digests);
+
+void write_capnp_route(const char* placement_file,
+                       const char* route_file);
+
+#endif /* PLACE_ROUTE_CAPNP_H */
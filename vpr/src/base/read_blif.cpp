@@ -18,6 +18,7 @@
 #include <cstdio>
 #include <cstring>
 #include <ctime>
+#include <fstream>
 #include <sstream>
 #include <unordered_set>
 #include <cctype> //std::isdigit
@@ -40,8 +41,22 @@
 #include "echo_files.h"
 #include "hash.h"
 
+#ifdef VTR_ENABLE_CAPNPROTO
+#    include "mmap_file.h"
+#endif /* VTR_ENABLE_CAPNPROTO */
+
 vtr::LogicValue to_vtr_logic_value(blifparse::LogicValue);
 
+//Size of a netlist estimated from a first scan over the BLIF text
+struct BlifSizeEstimate {
+    size_t num_blocks = 0;
+    size_t num_ports = 0;
+    size_t num_pins = 0;
+    size_t num_nets = 0;
+};
+
+static BlifSizeEstimate estimate_blif_size(const char* data, size_t size);
+
 struct BlifAllocCallback : public blifparse::Callback {
   public:
     BlifAllocCallback(e_circuit_format blif_format, AtomNetlist& main_netlist, const std::string netlist_id, const t_model* user_models, const t_model* library_models)
@@ -56,6 +71,10 @@ struct BlifAllocCallback : public blifparse::Callback {
 
     static constexpr const char* OUTPAD_NAME_PREFIX = "out:";
 
+    void set_size_estimate(const BlifSizeEstimate& size_estimate) {
+        size_estimate_ = size_estimate;
+    }
+
   public: //Callback interface
     void start_parse() override {}
 
@@ -71,6 +90,12 @@ struct BlifAllocCallback : public blifparse::Callback {
         //Create a new model, and set it's name
 
         blif_models_.emplace_back(model_name, netlist_id_);
+        if (blif_models_.size() == 1) {
+            //The main model usually comes first and dominates the file,
+            //so reserve it for the size estimated over the whole file
+            blif_models_.back().reserve(size_estimate_.num_blocks, size_estimate_.num_ports,
+                                        size_estimate_.num_pins, size_estimate_.num_nets);
+        }
         blif_models_black_box_.emplace_back(false);
         ended_ = false;
         set_curr_block(AtomBlockId::INVALID()); //This statement doesn't define a block, so mark invalid
@@ -632,6 +657,8 @@ struct BlifAllocCallback : public blifparse::Callback {
     std::vector<std::pair<AtomNetId, AtomNetId>> curr_nets_to_merge_;
 
     e_circuit_format blif_format_ = e_circuit_format::BLIF;
+
+    BlifSizeEstimate size_estimate_;
 };
 
 vtr::LogicValue to_vtr_logic_value(blifparse::LogicValue val) {
@@ -655,15 +682,165 @@ vtr::LogicValue to_vtr_logic_value(blifparse::LogicValue val) {
     return new_val;
 }
 
+/*
+ * Estimates the number of blocks, ports, pins and nets of a netlist
+ * by counting the statements and their tokens, without parsing them.
+ * The estimate covers all the models of the file, so it is an upper bound
+ * for the main model in most cases.
+ */
+static BlifSizeEstimate estimate_blif_size(const char* data, size_t size) {
+    BlifSizeEstimate estimate;
+
+    enum class Statement {
+        OTHER,
+        INPUTS,
+        OUTPUTS,
+        NAMES,
+        LATCH,
+        SUBCKT
+    };
+
+    Statement statement = Statement::OTHER;
+    size_t num_tokens = 0; //Tokens of the current statement, including its keyword
+
+    auto end_statement = [&]() {
+        if (num_tokens == 0) {
+            return;
+        }
+        size_t num_args = num_tokens - 1;
+        switch (statement) {
+            case Statement::INPUTS:
+                //One inpad block, port, pin and net per input
+                estimate.num_blocks += num_args;
+                estimate.num_ports += num_args;
+                estimate.num_pins += num_args;
+                estimate.num_nets += num_args;
+                break;
+            case Statement::OUTPUTS:
+                //One outpad block, port and pin per output, driven by an existing net
+                estimate.num_blocks += num_args;
+                estimate.num_ports += num_args;
+                estimate.num_pins += num_args;
+                break;
+            case Statement::NAMES:
+                //Input and output ports, one pin per net and one driven net
+                estimate.num_blocks += 1;
+                estimate.num_ports += 2;
+                estimate.num_pins += num_args;
+                estimate.num_nets += 1;
+                break;
+            case Statement::LATCH:
+                //D, Q and clock
+                estimate.num_blocks += 1;
+                estimate.num_ports += 3;
+                estimate.num_pins += 3;
+                estimate.num_nets += 1;
+                break;
+            case Statement::SUBCKT:
+                //The model name followed by one connection per pin,
+                //assume about one driven net per block
+                estimate.num_blocks += 1;
+                estimate.num_ports += (num_args > 0) ? num_args - 1 : 0;
+                estimate.num_pins += (num_args > 0) ? num_args - 1 : 0;
+                estimate.num_nets += 1;
+                break;
+            default:
+                break;
+        }
+        statement = Statement::OTHER;
+        num_tokens = 0;
+    };
+
+    const char* end = data + size;
+    const char* line = data;
+    while (line < end) {
+        const char* line_end = static_cast<const char*>(std::memchr(line, '\n', end - line));
+        if (!line_end) {
+            line_end = end;
+        }
+
+        //Lines ending with a backslash continue the current statement
+        const char* content_end = line_end;
+        while (content_end > line && std::isspace(static_cast<unsigned char>(content_end[-1]))) {
+            --content_end;
+        }
+        bool continued = (content_end > line && content_end[-1] == '\\');
+        if (continued) {
+            --content_end;
+        }
+
+        //Count the tokens, up to any comment
+        const char* c = line;
+        while (c < content_end && *c != '#') {
+            while (c < content_end && std::isspace(static_cast<unsigned char>(*c))) {
+                ++c;
+            }
+            if (c == content_end || *c == '#') {
+                break;
+            }
+            const char* token = c;
+            while (c < content_end && !std::isspace(static_cast<unsigned char>(*c))) {
+                ++c;
+            }
+            if (num_tokens == 0) {
+                std::string keyword(token, c - token);
+                if (keyword == ".inputs") {
+                    statement = Statement::INPUTS;
+                } else if (keyword == ".outputs") {
+                    statement = Statement::OUTPUTS;
+                } else if (keyword == ".names") {
+                    statement = Statement::NAMES;
+                } else if (keyword == ".latch") {
+                    statement = Statement::LATCH;
+                } else if (keyword == ".subckt") {
+                    statement = Statement::SUBCKT;
+                } else {
+                    //Covers, parameters, attributes, etc. are skipped
+                    statement = Statement::OTHER;
+                }
+            }
+            ++num_tokens;
+        }
+
+        if (!continued) {
+            end_statement();
+        }
+        line = line_end + 1;
+    }
+    end_statement();
+
+    return estimate;
+}
+
 AtomNetlist read_blif(e_circuit_format circuit_format,
                       const char* blif_file,
                       const t_model* user_models,
                       const t_model* library_models) {
     AtomNetlist netlist;
-    std::string netlist_id = vtr::secure_digest_file(blif_file);
+
+    //The file is loaded once, and then used for the digest,
+    //the size estimate and the parser
+#ifdef VTR_ENABLE_CAPNPROTO
+    MmapFile blif_mmap(blif_file);
+    const kj::ArrayPtr<const char> blif_chars = blif_mmap.getChars();
+    const char* blif_data = blif_chars.begin();
+    size_t blif_size = blif_chars.size();
+#else
+    std::ifstream blif_stream(blif_file, std::ifstream::binary);
+    if (!blif_stream) {
+        vpr_throw(VPR_ERROR_BLIF_F, blif_file, 0, "Could not open file '%s'.\n", blif_file);
+    }
+    std::string blif_contents((std::istreambuf_iterator<char>(blif_stream)),
+                              std::istreambuf_iterator<char>());
+    const char* blif_data = blif_contents.data();
+    size_t blif_size = blif_contents.size();
+#endif /* VTR_ENABLE_CAPNPROTO */
+
+    std::string netlist_id = vtr::secure_digest_buffer(blif_data, blif_size);
 
     BlifAllocCallback alloc_callback(circuit_format, netlist, netlist_id, user_models, library_models);
-    blifparse::blif_parse_filename(blif_file, alloc_callback);
+    alloc_callback.set_size_estimate(estimate_blif_size(blif_data, blif_size));
+    blifparse::blif_parse_buffer(blif_data, blif_size, alloc_callback, blif_file);
 
     return netlist;
 }
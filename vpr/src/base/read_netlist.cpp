@@ -5,9 +5,11 @@
  * Read a circuit netlist in XML format and populate the netlist data structures for VPR
  */
 
+#include <algorithm>
 #include <cstdio>
 #include <cstring>
 #include <ctime>
+#include <fstream>
 #include <map>
 
 #include "pugixml.hpp"
@@ -34,6 +36,174 @@
 
 static const char* netlist_file_name = nullptr;
 
+/**
+ * Streaming reader of the packed netlist file.
+ *
+ * The file is read in chunks, and split into the top-level header (the root
+ * element with its non-block children) and the top-level blocks (i.e. the
+ * CLBs). Each of them is parsed into a small DOM of its own, so that the
+ * DOM of the whole file is never built. Only the markup needed to find the
+ * boundaries of the top-level blocks is scanned here; well-formedness inside
+ * a fragment is checked by pugixml when the fragment is parsed.
+ */
+class NetFileStream {
+  public:
+    enum class e_markup {
+        START, //<name ...>
+        EMPTY, //<name .../>
+        END,   //</name>
+        OTHER  //Comment, processing instruction, CDATA or DOCTYPE
+    };
+
+    NetFileStream(const char* filename)
+        : filename_(filename)
+        , in_(filename, std::ios::binary) {
+        if (!in_) {
+            throw pugiutil::XmlError("Failed to open file", filename_);
+        }
+    }
+
+    //Finds the next markup, returning false at the end of the file.
+    //[start, end) is the range of the markup in the buffer
+    bool next_markup(size_t& start, size_t& end, e_markup& kind, std::string& name) {
+        start = find("<", pos_);
+        if (std::string::npos == start) {
+            return false;
+        }
+
+        if (starts_with(start, "<!--")) {
+            end = find_end(start, "-->");
+            kind = e_markup::OTHER;
+        } else if (starts_with(start, "<![CDATA[")) {
+            end = find_end(start, "]]>");
+            kind = e_markup::OTHER;
+        } else if (starts_with(start, "<?")) {
+            end = find_end(start, "?>");
+            kind = e_markup::OTHER;
+        } else if (starts_with(start, "<!")) {
+            end = find_end(start, ">");
+            kind = e_markup::OTHER;
+        } else {
+            //Find the end of tag, skipping '>' in attribute values
+            char quote = '\0';
+            for (end = start + 1;; ++end) {
+                if (end == buf_.size() && !fill()) {
+                    throw pugiutil::XmlError("Unexpected end of file in tag", filename_, line(start));
+                }
+                char c = buf_[end];
+                if (quote != '\0') {
+                    if (c == quote) quote = '\0';
+                } else if (c == '"' || c == '\'') {
+                    quote = c;
+                } else if (c == '>') {
+                    break;
+                }
+            }
+            ++end;
+
+            size_t name_start = start + 1;
+            if (buf_[name_start] == '/') {
+                kind = e_markup::END;
+                ++name_start;
+            } else if (buf_[end - 2] == '/') {
+                kind = e_markup::EMPTY;
+            } else {
+                kind = e_markup::START;
+            }
+            size_t name_end = buf_.find_first_of(" \t\r\n/>", name_start);
+            name = buf_.substr(name_start, name_end - name_start);
+        }
+        pos_ = end;
+        return true;
+    }
+
+    //Returns the range [start, end) of the buffer
+    std::string substr(size_t start, size_t end) const {
+        return buf_.substr(start, end - start);
+    }
+
+    //Returns the line of the file at the given position of the buffer
+    size_t line(size_t pos) const {
+        return buf_line_ + std::count(buf_.begin(), buf_.begin() + pos, '\n');
+    }
+
+    //Drops the buffer before the given position, which invalidates all the
+    //previous positions
+    void discard(size_t pos) {
+        VTR_ASSERT(pos <= pos_);
+        buf_line_ = line(pos);
+        buf_.erase(0, pos);
+        pos_ -= pos;
+    }
+
+  private:
+    //Reads the next chunk of the file into the buffer
+    bool fill() {
+        constexpr size_t CHUNK_SIZE = 1 << 20;
+
+        if (!in_) {
+            return false;
+        }
+        size_t old_size = buf_.size();
+        buf_.resize(old_size + CHUNK_SIZE);
+        in_.read(&buf_[old_size], CHUNK_SIZE);
+        buf_.resize(old_size + in_.gcount());
+        return buf_.size() > old_size;
+    }
+
+    //Finds str from the given position, reading more of the file if needed
+    size_t find(const char* str, size_t from) {
+        size_t len = strlen(str);
+        while (true) {
+            size_t found = buf_.find(str, from);
+            if (std::string::npos != found) {
+                return found;
+            }
+            if (buf_.size() >= len) {
+                from = std::max(from, buf_.size() - len + 1);
+            }
+            if (!fill()) {
+                return std::string::npos;
+            }
+        }
+    }
+
+    //Returns the end of a markup starting at start and terminated by str
+    size_t find_end(size_t start, const char* str) {
+        size_t found = find(str, start + 1);
+        if (std::string::npos == found) {
+            throw pugiutil::XmlError("Unexpected end of file in markup", filename_, line(start));
+        }
+        return found + strlen(str);
+    }
+
+    bool starts_with(size_t pos, const char* str) {
+        size_t len = strlen(str);
+        while (buf_.size() < pos + len) {
+            if (!fill()) {
+                return false;
+            }
+        }
+        return 0 == buf_.compare(pos, len, str);
+    }
+
+    std::string filename_;
+    std::ifstream in_;
+    std::string buf_;
+    size_t pos_ = 0;      //Position of the next markup to scan in buf_
+    size_t buf_line_ = 1; //Line of the file at the beginning of buf_
+};
+
+static pugiutil::loc_data load_net_file_fragment(pugi::xml_document& doc, std::string& fragment, size_t first_line);
+
+static void processHeader(pugi::xml_node top,
+                          const pugiutil::loc_data& loc_data,
+                          const t_arch* arch,
+                          bool verify_file_digests,
+                          std::vector<std::string>& circuit_inputs,
+                          std::vector<std::string>& circuit_outputs,
+                          std::vector<std::string>& circuit_clocks);
+
 static int processPorts(pugi::xml_node Parent, t_pb* pb, t_pb_routes& pb_route, const pugiutil::loc_data& loc_data);
 
 static void processPb(pugi::xml_node Parent, const ClusterBlockId index, t_pb* pb, t_pb_routes& pb_route, int* num_primitives, const pugiutil::loc_data& loc_data, ClusteredNetlist* clb_nlist);
@@ -83,115 +253,107 @@ ClusteredNetlist read_netlist(const char* net_file,
     //Save an identifier for the netlist based on it's contents
     auto clb_nlist = ClusteredNetlist(net_file, vtr::secure_digest_file(net_file));
 
-    pugi::xml_document doc;
-    pugiutil::loc_data loc_data;
-    try {
-        loc_data = pugiutil::load_xml(doc, net_file);
-    } catch (pugiutil::XmlError& e) {
-        vpr_throw(VPR_ERROR_NET_F, net_file, 0,
-                  "Failed to load netlist file '%s' (%s).\n", net_file, e.what());
-    }
-
     try {
         /* Save netlist file's name in file-scoped variable */
         netlist_file_name = net_file;
 
+        NetFileStream net_stream(net_file);
+        NetFileStream::e_markup kind;
+        size_t start = 0;
+        size_t end = 0;
+        std::string name;
+
         /* Root node should be block */
-        auto top = doc.child("block");
-        if (!top) {
-            vpr_throw(VPR_ERROR_NET_F, net_file, loc_data.line(top),
+        do {
+            if (!net_stream.next_markup(start, end, kind, name)) {
+                vpr_throw(VPR_ERROR_NET_F, net_file, 0,
+                          "Failed to load netlist file '%s' (no root element).\n", net_file);
+            }
+        } while (NetFileStream::e_markup::OTHER == kind);
+        if (NetFileStream::e_markup::END == kind || name != "block") {
+            vpr_throw(VPR_ERROR_NET_F, net_file, net_stream.line(start),
                       "Root element must be 'block'.\n");
         }
+        net_stream.discard(start);
+        start = 0;
 
-        /* Check top-level netlist attributes */
-        auto top_name = top.attribute("name");
-        if (!top_name) {
-            vpr_throw(VPR_ERROR_NET_F, net_file, loc_data.line(top),
-                      "Root element must have a 'name' attribute.\n");
-        }
-
-        VTR_LOG("Netlist generated from file '%s'.\n", top_name.value());
-
-        //Verify top level attributes
-        auto top_instance = pugiutil::get_attribute(top, "instance", loc_data);
-
-        if (strcmp(top_instance.value(), "FPGA_packed_netlist[0]") != 0) {
-            vpr_throw(VPR_ERROR_NET_F, netlist_file_name, loc_data.line(top),
-                      "Expected top instance to be \"FPGA_packed_netlist[0]\", found \"%s\".",
-                      top_instance.value());
-        }
+        //Reset atom/pb mapping (it is reloaded from the packed netlist file)
+        for (auto blk_id : atom_ctx.nlist.blocks())
+            atom_ctx.lookup.set_atom_pb(blk_id, nullptr);
 
-        auto architecture_id = top.attribute("architecture_id");
-        if (architecture_id) {
-            //Netlist file has an architecture id, make sure it is
-            //consistent with the loaded architecture file.
-            //
-            //Note that we currently don't require that the architecture_id exists,
-            //to remain compatible with old .net files
-            std::string arch_id = architecture_id.value();
-            if (arch_id != arch->architecture_id) {
-                auto msg = vtr::string_fmt(
-                    "Netlist was generated from a different architecture file"
-                    " (loaded architecture ID: %s, netlist file architecture ID: %s)",
-                    arch->architecture_id, arch_id.c_str());
-                if (verify_file_digests) {
-                    vpr_throw(VPR_ERROR_NET_F, netlist_file_name, loc_data.line(top), msg.c_str());
-                } else {
-                    VTR_LOGF_WARN(netlist_file_name, loc_data.line(top), "%s\n", msg.c_str());
-                }
+        /* Process netlist: the header (root element and top level I/Os)
+         * is parsed once the first CLB block is reached, and each CLB block
+         * is parsed and loaded on its own */
+        bool header_done = false;
+        const auto process_header = [&](const size_t header_end, const bool close_root) {
+            //Close the root element as it is cut before its children blocks
+            std::string header = net_stream.substr(0, header_end);
+            if (close_root) {
+                header += "</block>";
             }
-        }
-
-        auto atom_netlist_id = top.attribute("atom_netlist_id");
-        if (atom_netlist_id) {
-            //Netlist file has an_atom netlist_id, make sure it is
-            //consistent with the loaded atom netlist.
-            //
-            //Note that we currently don't require that the atom_netlist_id exists,
-            //to remain compatible with old .net files
-            std::string atom_nl_id = atom_netlist_id.value();
-            if (atom_nl_id != atom_ctx.nlist.netlist_id()) {
-                auto msg = vtr::string_fmt(
-                    "Netlist was generated from a different atom netlist file"
-                    " (loaded atom netlist ID: %s, packed netlist atom netlist ID: %s)",
-                    atom_nl_id.c_str(), atom_ctx.nlist.netlist_id().c_str());
-                if (verify_file_digests) {
-                    vpr_throw(VPR_ERROR_NET_F, netlist_file_name, loc_data.line(top), msg.c_str());
-                } else {
-                    VTR_LOGF_WARN(netlist_file_name, loc_data.line(top), "%s\n", msg.c_str());
+            pugi::xml_document doc;
+            auto loc_data = load_net_file_fragment(doc, header, net_stream.line(0));
+            processHeader(doc.child("block"), loc_data, arch, verify_file_digests,
+                          circuit_inputs, circuit_outputs, circuit_clocks);
+            header_done = true;
+        };
+
+        if (NetFileStream::e_markup::EMPTY == kind) {
+            //Root element without any children, which is reported as a missing child
+            process_header(end, false);
+        } else {
+            size_t depth = 1;
+            while (0 < depth) {
+                if (!net_stream.next_markup(start, end, kind, name)) {
+                    throw pugiutil::XmlError("Unexpected end of file, root element is not closed", net_file, net_stream.line(start));
+                }
+                if (NetFileStream::e_markup::OTHER == kind) {
+                    continue;
+                }
+                if (NetFileStream::e_markup::END == kind) {
+                    --depth;
+                    if (0 == depth && !header_done) {
+                        process_header(start, true);
+                    }
+                    continue;
+                }
+                if (1 < depth || name != "block") {
+                    depth += (NetFileStream::e_markup::START == kind) ? 1 : 0;
+                    continue;
                 }
-            }
-        }
-
-        //Collect top level I/Os
-        auto top_inputs = pugiutil::get_single_child(top, "inputs", loc_data);
-        circuit_inputs = vtr::split(top_inputs.text().get());
 
-        auto top_outputs = pugiutil::get_single_child(top, "outputs", loc_data);
-        circuit_outputs = vtr::split(top_outputs.text().get());
+                /* A CLB block: find its end and process it */
+                if (!header_done) {
+                    process_header(start, true);
+                }
+                net_stream.discard(start);
+                end -= start;
 
-        auto top_clocks = pugiutil::get_single_child(top, "clocks", loc_data);
-        circuit_clocks = vtr::split(top_clocks.text().get());
+                for (size_t block_depth = (NetFileStream::e_markup::START == kind) ? 1 : 0; 0 < block_depth;) {
+                    if (!net_stream.next_markup(start, end, kind, name)) {
+                        throw pugiutil::XmlError("Unexpected end of file, block is not closed", net_file, net_stream.line(0));
+                    }
+                    if (NetFileStream::e_markup::START == kind) {
+                        ++block_depth;
+                    } else if (NetFileStream::e_markup::END == kind) {
+                        --block_depth;
+                    }
+                }
 
-        /* Parse all CLB blocks and all nets*/
+                std::string fragment = net_stream.substr(0, end);
+                pugi::xml_document doc;
+                auto loc_data = load_net_file_fragment(doc, fragment, net_stream.line(0));
+                processComplexBlock(doc.first_child(), ClusterBlockId(bcount), &num_primitives, loc_data, &clb_nlist);
+                ++bcount;
 
-        //Reset atom/pb mapping (it is reloaded from the packed netlist file)
-        for (auto blk_id : atom_ctx.nlist.blocks())
-            atom_ctx.lookup.set_atom_pb(blk_id, nullptr);
+                net_stream.discard(end);
+            }
+        }
 
-        //Count the number of blocks for allocation
-        bcount = pugiutil::count_children(top, "block", loc_data, pugiutil::ReqOpt::OPTIONAL);
         if (bcount == 0)
             VTR_LOG_WARN("Packed netlist contains no clustered blocks\n");
 
-        /* Process netlist */
-        unsigned i = 0;
-        for (auto curr_block = top.child("block"); curr_block; curr_block = curr_block.next_sibling("block")) {
-            processComplexBlock(curr_block, ClusterBlockId(i), &num_primitives, loc_data, &clb_nlist);
-            i++;
-        }
-        VTR_ASSERT(bcount == i);
-        VTR_ASSERT(clb_nlist.blocks().size() == i);
+        VTR_ASSERT(clb_nlist.blocks().size() == bcount);
         VTR_ASSERT(num_primitives >= 0);
         VTR_ASSERT(static_cast<size_t>(num_primitives) == atom_ctx.nlist.blocks().size());
 
@@ -254,6 +416,112 @@ ClusteredNetlist read_netlist(const char* net_file,
     return clb_nlist;
 }
 
+/**
+ * Parses a fragment of the netlist file, which starts at the given line of the file,
+ * and returns its location data for error reporting.
+ * The fragment is parsed in place, so it must outlive doc
+ */
+static pugiutil::loc_data load_net_file_fragment(pugi::xml_document& doc, std::string& fragment, size_t first_line) {
+    pugiutil::loc_data loc_data(netlist_file_name, fragment.data(), fragment.size(), first_line);
+
+    auto load_result = doc.load_buffer_inplace(&fragment[0], fragment.size());
+    if (!load_result) {
+        std::string msg = load_result.description();
+        auto line = loc_data.line(load_result.offset);
+        auto col = loc_data.col(load_result.offset);
+        throw pugiutil::XmlError("Unable to load XML file '" + std::string(netlist_file_name) + "', " + msg
+                                     + " (line: " + std::to_string(line) + " col: " + std::to_string(col) + ")",
+                                 netlist_file_name, line);
+    }
+
+    return loc_data;
+}
+
+/**
+ * XML parser to check the top-level netlist attributes and to collect the top level I/Os
+ * top - XML tag of the root block, without its children CLBs
+ * loc_data - xml location info for error reporting
+ */
+static void processHeader(pugi::xml_node top,
+                          const pugiutil::loc_data& loc_data,
+                          const t_arch* arch,
+                          bool verify_file_digests,
+                          std::vector<std::string>& circuit_inputs,
+                          std::vector<std::string>& circuit_outputs,
+                          std::vector<std::string>& circuit_clocks) {
+    auto& atom_ctx = g_vpr_ctx.atom();
+
+    /* Check top-level netlist attributes */
+    auto top_name = top.attribute("name");
+    if (!top_name) {
+        vpr_throw(VPR_ERROR_NET_F, netlist_file_name, loc_data.line(top),
+                  "Root element must have a 'name' attribute.\n");
+    }
+
+    VTR_LOG("Netlist generated from file '%s'.\n", top_name.value());
+
+    //Verify top level attributes
+    auto top_instance = pugiutil::get_attribute(top, "instance", loc_data);
+
+    if (strcmp(top_instance.value(), "FPGA_packed_netlist[0]") != 0) {
+        vpr_throw(VPR_ERROR_NET_F, netlist_file_name, loc_data.line(top),
+                  "Expected top instance to be \"FPGA_packed_netlist[0]\", found \"%s\".",
+                  top_instance.value());
+    }
+
+    auto architecture_id = top.attribute("architecture_id");
+    if (architecture_id) {
+        //Netlist file has an architecture id, make sure it is
+        //consistent with the loaded architecture file.
+        //
+        //Note that we currently don't require that the architecture_id exists,
+        //to remain compatible with old .net files
+        std::string arch_id = architecture_id.value();
+        if (arch_id != arch->architecture_id) {
+            auto msg = vtr::string_fmt(
+                "Netlist was generated from a different architecture file"
+                " (loaded architecture ID: %s, netlist file architecture ID: %s)",
+                arch->architecture_id, arch_id.c_str());
+            if (verify_file_digests) {
+                vpr_throw(VPR_ERROR_NET_F, netlist_file_name, loc_data.line(top), msg.c_str());
+            } else {
+                VTR_LOGF_WARN(netlist_file_name, loc_data.line(top), "%s\n", msg.c_str());
+            }
+        }
+    }
+
+    auto atom_netlist_id = top.attribute("atom_netlist_id");
+    if (atom_netlist_id) {
+        //Netlist file has an_atom netlist_id, make sure it is
+        //consistent with the loaded atom netlist.
+        //
+        //Note that we currently don't require that the atom_netlist_id exists,
+        //to remain compatible with old .net files
+        std::string atom_nl_id = atom_netlist_id.value();
+        if (atom_nl_id != atom_ctx.nlist.netlist_id()) {
+            auto msg = vtr::string_fmt(
+                "Netlist was generated from a different atom netlist file"
+                " (loaded atom netlist ID: %s, packed netlist atom netlist ID: %s)",
+                atom_nl_id.c_str(), atom_ctx.nlist.netlist_id().c_str());
+            if (verify_file_digests) {
+                vpr_throw(VPR_ERROR_NET_F, netlist_file_name, loc_data.line(top), msg.c_str());
+            } else {
+                VTR_LOGF_WARN(netlist_file_name, loc_data.line(top), "%s\n", msg.c_str());
+            }
+        }
+    }
+
+    //Collect top level I/Os
+    auto top_inputs = pugiutil::get_single_child(top, "inputs", loc_data);
+    circuit_inputs = vtr::split(top_inputs.text().get());
+
+    auto top_outputs = pugiutil::get_single_child(top, "outputs", loc_data);
+    circuit_outputs = vtr::split(top_outputs.text().get());
+
+    auto top_clocks = pugiutil::get_single_child(top, "clocks", loc_data);
+    circuit_clocks = vtr::split(top_clocks.text().get());
+}
+
 /**
  * XML parser to populate CLB info and to update nets with the nets of this CLB
  * Parent - XML tag for this CLB
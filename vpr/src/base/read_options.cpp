@@ -756,6 +756,37 @@ struct ParseReducer {
     }
 };
 
+struct ParsePlaceDeltaDelayAlgorithm {
+    ConvertedValue<e_place_delta_delay_algorithm> from_str(std::string str) {
+        ConvertedValue<e_place_delta_delay_algorithm> conv_value;
+        if (str == "astar")
+            conv_value.set_value(e_place_delta_delay_algorithm::ASTAR_ROUTE);
+        else if (str == "dijkstra")
+            conv_value.set_value(e_place_delta_delay_algorithm::DIJKSTRA_EXPANSION);
+        else {
+            std::stringstream msg;
+            msg << "Invalid conversion from '" << str << "' to e_place_delta_delay_algorithm (expected one of: " << argparse::join(default_choices(), ", ") << ")";
+            conv_value.set_error(msg.str());
+        }
+        return conv_value;
+    }
+
+    ConvertedValue<std::string> to_str(e_place_delta_delay_algorithm val) {
+        ConvertedValue<std::string> conv_value;
+        if (val == e_place_delta_delay_algorithm::ASTAR_ROUTE)
+            conv_value.set_value("astar");
+        else {
+            VTR_ASSERT(val == e_place_delta_delay_algorithm::DIJKSTRA_EXPANSION);
+            conv_value.set_value("dijkstra");
+        }
+        return conv_value;
+    }
+
+    std::vector<std::string> default_choices() {
+        return {"astar", "dijkstra"};
+    }
+};
+
 argparse::ArgumentParser create_arg_parser(std::string prog_name, t_options& args) {
     std::string description =
         "Implements the specified circuit onto the target FPGA architecture"
@@ -1000,11 +1031,13 @@ argparse::ArgumentParser create_arg_parser(std::string prog_name, t_options& arg
         .show_in(argparse::ShowIn::HELP_ONLY);
 
     file_grp.add_argument(args.PlaceFile, "--place_file")
-        .help("Path to placement file")
+        .help("Path to placement file."
+              " A file with the '.capnp' extension is in the binary format.")
         .show_in(argparse::ShowIn::HELP_ONLY);
 
     file_grp.add_argument(args.RouteFile, "--route_file")
-        .help("Path to routing file")
+        .help("Path to routing file."
+              " A file with the '.capnp' extension is in the binary format.")
         .show_in(argparse::ShowIn::HELP_ONLY);
 
     file_grp.add_argument(args.SDCFile, "--sdc_file")
@@ -1014,12 +1047,14 @@ argparse::ArgumentParser create_arg_parser(std::string prog_name, t_options& arg
     file_grp.add_argument(args.read_rr_graph_file, "--read_rr_graph")
         .help(
             "The routing resource graph file to load."
-            " The loaded routing resource graph overrides any routing architecture specified in the architecture file.")
+            " The loaded routing resource graph overrides any routing architecture specified in the architecture file."
+            " A file with the '.capnp' extension is read in the binary format.")
         .metavar("RR_GRAPH_FILE")
         .show_in(argparse::ShowIn::HELP_ONLY);
 
     file_grp.add_argument(args.write_rr_graph_file, "--write_rr_graph")
-        .help("Writes the routing resource graph to the specified file")
+        .help("Writes the routing resource graph to the specified file."
+              " A file with the '.capnp' extension is written in the binary format.")
         .metavar("RR_GRAPH_FILE")
         .show_in(argparse::ShowIn::HELP_ONLY);
 
@@ -1310,6 +1345,16 @@ argparse::ArgumentParser create_arg_parser(std::string prog_name, t_options& arg
         .default_value("")
         .show_in(argparse::ShowIn::HELP_ONLY);
 
+    place_grp.add_argument(args.place_move_batch_size, "--place_move_batch_size")
+        .help(
+            "The maximum number of moves which are proposed together and evaluated concurrently"
+            " by the --num_workers threads during placement."
+            " Moves in a batch involve disjoint locations and nets, and are accepted one by one in order,"
+            " so that the placement only depends on the seed and the batch size but not on the number of threads."
+            " A value of 1 evaluates moves one by one.")
+        .default_value("1")
+        .show_in(argparse::ShowIn::HELP_ONLY);
+
     auto& place_timing_grp = parser.add_argument_group("timing-driven placement options");
 
     place_timing_grp.add_argument(args.PlaceTimingTradeoff, "--timing_tradeoff")
@@ -1329,6 +1374,22 @@ argparse::ArgumentParser create_arg_parser(std::string prog_name, t_options& arg
         .default_value("0")
         .show_in(argparse::ShowIn::HELP_ONLY);
 
+    place_timing_grp.add_argument<bool, ParseOnOff>(args.place_incremental_sta, "--place_incremental_sta")
+        .help(
+            "Controls whether the timing analyses during placement are incremental."
+            " An incremental analysis only re-analyzes the parts of the timing graph"
+            " affected by the connections whose delays changed since the previous analysis"
+            " (i.e. the fan-out and fan-in of the moved blocks), and produces the same result as a full analysis.")
+        .default_value("off")
+        .show_in(argparse::ShowIn::HELP_ONLY);
+
+    place_timing_grp.add_argument(args.place_incremental_sta_full_update_period, "--place_incremental_sta_full_update_period")
+        .help(
+            "With --place_incremental_sta, the number of timing analyses after which"
+            " a full timing analysis is performed. A value of 1 makes every analysis a full analysis.")
+        .default_value("10")
+        .show_in(argparse::ShowIn::HELP_ONLY);
+
     place_timing_grp.add_argument(args.place_exp_first, "--td_place_exp_first")
         .help(
             "Controls how critical a connection is as a function of slack at the start of placement."
@@ -1358,6 +1419,17 @@ argparse::ArgumentParser create_arg_parser(std::string prog_name, t_options& arg
         .default_value("min")
         .show_in(argparse::ShowIn::HELP_ONLY);
 
+    place_timing_grp.add_argument<e_place_delta_delay_algorithm, ParsePlaceDeltaDelayAlgorithm>(args.place_delta_delay_matrix_calculation_method, "--place_delta_delay_matrix_calculation_method")
+        .help(
+            "How the delta delays of the placement delay model are profiled.\n"
+            "Valid options:\n"
+            " * 'astar' routes each sampled connection with the A* router\n"
+            " * 'dijkstra' reaches all the sampled sinks of a source with a single Dijkstra expansion,"
+            " which is much faster on large devices. The delays are those of the lowest cost paths,"
+            " and may differ slightly from the ones found by the A* router\n")
+        .default_value("astar")
+        .show_in(argparse::ShowIn::HELP_ONLY);
+
     place_timing_grp.add_argument(args.place_delay_offset, "--place_delay_offset")
         .help(
             "A constant offset (in seconds) applied to the placer's delay model.")
@@ -1620,6 +1692,16 @@ argparse::ArgumentParser create_arg_parser(std::string prog_name, t_options& arg
         .default_value("")
         .show_in(argparse::ShowIn::HELP_ONLY);
 
+    route_timing_grp.add_argument<bool, ParseOnOff>(args.parallel_net_routing, "--parallel_net_routing")
+        .help(
+            "Route the nets whose routing regions do not overlap concurrently, using the number of workers (-j)."
+            " Nets are partitioned into waves, and the nets in a wave are routed in parallel."
+            " The results do not depend on the number of threads."
+            " Serial routing is used when the device has pass-transistor switches or non-configurable nodes,"
+            " or when router debugging is enabled.")
+        .default_value("off")
+        .show_in(argparse::ShowIn::HELP_ONLY);
+
     route_timing_grp.add_argument(args.router_debug_net, "--router_debug_net")
         .help(
             "Controls when router debugging is enabled.\n"
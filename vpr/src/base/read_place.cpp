@@ -13,12 +13,18 @@
 #include "globals.h"
 #include "hash.h"
 #include "read_place.h"
+#include "place_route_capnp.h"
 #include "read_xml_arch_file.h"
 
 void read_place(const char* net_file,
                 const char* place_file,
                 bool verify_file_digests,
                 const DeviceGrid& grid) {
+    if (vtr::check_file_name_extension(place_file, ".capnp")) {
+        read_capnp_place(net_file, place_file, verify_file_digests, grid);
+        return;
+    }
+
     std::ifstream fstream(place_file);
     if (!fstream) {
         VPR_FATAL_ERROR(VPR_ERROR_PLACE_F,
@@ -288,6 +294,11 @@ void read_user_pad_loc(const char* pad_loc_file) {
 void print_place(const char* net_file,
                  const char* net_id,
                  const char* place_file) {
+    if (vtr::check_file_name_extension(place_file, ".capnp")) {
+        write_capnp_place(net_file, net_id, place_file);
+        return;
+    }
+
     FILE* fp;
 
     auto& device_ctx = g_vpr_ctx.device();
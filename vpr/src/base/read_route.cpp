@@ -17,6 +17,7 @@
 #include <sstream>
 #include <string>
 #include <unordered_set>
+#include <algorithm>
 
 #include "atom_netlist.h"
 #include "atom_netlist_utils.h"
@@ -40,8 +41,20 @@
 #include "echo_files.h"
 #include "route_common.h"
 #include "read_route.h"
+#include "place_route_capnp.h"
+
+/*************Types local to this module*************/
+/* A node of the routing of a net read for incremental routing, with the switch to the next node */
+struct t_incr_route_node {
+    RRNodeId node;
+    short iswitch;
+};
 
 /*************Functions local to this module*************/
+static bool process_incremental_route_node(const std::vector<std::string>& tokens, ClusterNetId inet, const char* filename, const int lineno, t_incr_route_node& route_node);
+static bool is_incremental_route_reusable(ClusterNetId inet, const std::vector<t_incr_route_node>& route_nodes);
+static void load_incremental_route_trace(ClusterNetId inet, const std::vector<t_incr_route_node>& route_nodes);
+static void load_text_route(const char* route_file, const t_router_opts& router_opts, bool verify_file_digests);
 static void process_route(std::ifstream& fp, const char* filename, int& lineno);
 static void process_nodes(std::ifstream& fp, ClusterNetId inet, const char* filename, int& lineno);
 static void process_nets(std::ifstream& fp, ClusterNetId inet, std::string name, std::vector<std::string> input_tokens, const char* filename, int& lineno);
@@ -55,11 +68,38 @@ bool read_route(const char* route_file, const t_router_opts& router_opts, bool v
     /* Reads in the routing file to fill in the trace.head and t_clb_opins_used data structure.
      * Perform a series of verification tests to ensure the netlist, placement, and routing
      * files match */
-    auto& device_ctx = g_vpr_ctx.mutable_device();
-    auto& place_ctx = g_vpr_ctx.placement();
     /* Begin parsing the file */
     VTR_LOG("Begin loading FPGA routing file.\n");
 
+    if (vtr::check_file_name_extension(route_file, ".capnp")) {
+        load_capnp_route(route_file, router_opts, verify_file_digests);
+    } else {
+        load_text_route(route_file, router_opts, verify_file_digests);
+    }
+
+    /*Correctly set up the clb opins*/
+    recompute_occupancy_from_scratch();
+
+    /* Note: This pres_fac is not necessarily correct since it isn't the first routing iteration*/
+    pathfinder_update_cost(router_opts.initial_pres_fac, router_opts.acc_fac);
+
+    reserve_locally_used_opins(router_opts.initial_pres_fac,
+                               router_opts.acc_fac, true);
+
+    /* Finished loading in the routing, now check it*/
+    recompute_occupancy_from_scratch();
+    bool is_feasible = feasible_routing();
+
+    VTR_LOG("Finished loading route file\n");
+
+    return is_feasible;
+}
+
+/* Read the routing file in the text format, allocate the routing structures and fill the trace.head */
+static void load_text_route(const char* route_file, const t_router_opts& router_opts, bool verify_file_digests) {
+    auto& device_ctx = g_vpr_ctx.mutable_device();
+    auto& place_ctx = g_vpr_ctx.placement();
+
     std::string header_str;
 
     std::ifstream fp;
@@ -107,23 +147,6 @@ bool read_route(const char* route_file, const t_router_opts& router_opts, bool v
     process_route(fp, route_file, lineno);
 
     fp.close();
-
-    /*Correctly set up the clb opins*/
-    recompute_occupancy_from_scratch();
-
-    /* Note: This pres_fac is not necessarily correct since it isn't the first routing iteration*/
-    pathfinder_update_cost(router_opts.initial_pres_fac, router_opts.acc_fac);
-
-    reserve_locally_used_opins(router_opts.initial_pres_fac,
-                               router_opts.acc_fac, true);
-
-    /* Finished loading in the routing, now check it*/
-    recompute_occupancy_from_scratch();
-    bool is_feasible = feasible_routing();
-
-    VTR_LOG("Finished loading route file\n");
-
-    return is_feasible;
 }
 
 static void process_route(std::ifstream& fp, const char* filename, int& lineno) {
@@ -337,6 +360,203 @@ static void process_nodes(std::ifstream& fp, ClusterNetId inet, const char* file
     }
 }
 
+std::vector<ClusterNetId> read_incremental_route(const char* route_file) {
+    auto& cluster_ctx = g_vpr_ctx.clustering();
+    auto& route_ctx = g_vpr_ctx.routing();
+
+    VTR_LOG("Begin loading FPGA routing file '%s' for incremental routing.\n", route_file);
+
+    if (vtr::check_file_name_extension(route_file, ".capnp")) {
+        vpr_throw(VPR_ERROR_ROUTE, route_file, 0,
+                  "Incremental routing only supports routing files in the text format");
+    }
+
+    std::ifstream fp(route_file);
+    int lineno = 0;
+    if (!fp.is_open()) {
+        vpr_throw(VPR_ERROR_ROUTE, route_file, lineno,
+                  "Cannot open %s routing file", route_file);
+    }
+
+    std::vector<ClusterNetId> reused_nets;
+    size_t num_file_nets = 0;
+
+    /* The net being read, which is invalid when its routing cannot be reused */
+    ClusterNetId inet = ClusterNetId::INVALID();
+    std::vector<t_incr_route_node> route_nodes;
+
+    auto finish_net = [&]() {
+        if (inet && is_incremental_route_reusable(inet, route_nodes)) {
+            load_incremental_route_trace(inet, route_nodes);
+            reused_nets.push_back(inet);
+        }
+        inet = ClusterNetId::INVALID();
+        route_nodes.clear();
+    };
+
+    std::string input;
+    while (std::getline(fp, input)) {
+        ++lineno;
+        std::vector<std::string> tokens = vtr::split(input);
+        if (tokens.empty() || tokens[0][0] == '#') {
+            continue; /*Skip blank and commented lines*/
+        }
+
+        if (tokens[0] == "Net" && tokens.size() > 2) {
+            finish_net();
+            if (tokens.size() > 3 && tokens[3] == "global") {
+                continue; /*Global nets are never routed*/
+            }
+            ++num_file_nets;
+
+            inet = cluster_ctx.clb_nlist.find_net(format_name(tokens[2]));
+            if (inet
+                && (cluster_ctx.clb_nlist.net_is_ignored(inet) || route_ctx.trace[inet].head != nullptr)) {
+                inet = ClusterNetId::INVALID();
+            }
+        } else if (tokens[0] == "Node:" && inet) {
+            t_incr_route_node route_node;
+            if (process_incremental_route_node(tokens, inet, route_file, lineno, route_node)) {
+                route_nodes.push_back(route_node);
+            } else {
+                inet = ClusterNetId::INVALID();
+            }
+        }
+    }
+    finish_net();
+
+    /* Account the reused routing in the occupancy of the rr nodes */
+    recompute_occupancy_from_scratch();
+
+    VTR_LOG("Reused the routing of %lu nets out of %lu nets in the routing file\n",
+            reused_nets.size(), num_file_nets);
+
+    return reused_nets;
+}
+
+/* Parse a node of the routing file, which has the form of
+ *   Node: <id> <type> (<x>,<y>) [to (<x>,<y>)] <Pad:|Pin:|Track:|Class:> <ptc> [<pin info>] Switch: <switch>
+ * Returns false if the node does not match the rr graph */
+static bool process_incremental_route_node(const std::vector<std::string>& tokens, ClusterNetId inet, const char* filename, const int lineno, t_incr_route_node& route_node) {
+    auto& device_ctx = g_vpr_ctx.device();
+
+    if (tokens.size() < 4) {
+        return false;
+    }
+
+    RRNodeId node = RRNodeId(atoi(tokens[1].c_str()));
+    if (!device_ctx.rr_graph.valid_node_id(node)
+        || tokens[2] != rr_node_typename[device_ctx.rr_graph.node_type(node)]) {
+        return false;
+    }
+
+    int x, y;
+    format_coordinates(x, y, tokens[3], inet, filename, lineno);
+    int x2 = x;
+    int y2 = y;
+    size_t offset = 0;
+    if (tokens.size() > 5 && tokens[4] == "to") {
+        format_coordinates(x2, y2, tokens[5], inet, filename, lineno);
+        offset = 2;
+    }
+    if (device_ctx.rr_graph.node_xlow(node) != x
+        || device_ctx.rr_graph.node_xhigh(node) != x2
+        || device_ctx.rr_graph.node_ylow(node) != y
+        || device_ctx.rr_graph.node_yhigh(node) != y2) {
+        return false;
+    }
+
+    if (tokens.size() <= 5 + offset
+        || device_ctx.rr_graph.node_ptc_num(node) != atoi(tokens[5 + offset].c_str())) {
+        return false;
+    }
+
+    auto switch_itr = std::find(tokens.begin() + 6 + offset, tokens.end(), std::string("Switch:"));
+    if (switch_itr == tokens.end() || switch_itr + 1 == tokens.end()) {
+        return false;
+    }
+
+    route_node.node = node;
+    route_node.iswitch = atoi((switch_itr + 1)->c_str());
+    return true;
+}
+
+/* The routing of a net can be reused if it starts from the source of the net,
+ * reaches exactly the sinks of the net, and each of its branches follows
+ * the edges and switches of the rr graph */
+static bool is_incremental_route_reusable(ClusterNetId inet, const std::vector<t_incr_route_node>& route_nodes) {
+    auto& device_ctx = g_vpr_ctx.device();
+    auto& route_ctx = g_vpr_ctx.routing();
+
+    const std::vector<RRNodeId>& terminals = route_ctx.net_rr_terminals[inet];
+
+    if (route_nodes.empty()
+        || route_nodes.front().node != terminals[0]
+        || route_nodes.back().iswitch != OPEN) {
+        return false;
+    }
+
+    std::unordered_set<RRNodeId> visited_nodes;
+    std::vector<RRNodeId> sinks;
+    for (size_t inode = 0; inode < route_nodes.size(); ++inode) {
+        const t_incr_route_node& route_node = route_nodes[inode];
+        if (0 < inode) {
+            const t_incr_route_node& prev_route_node = route_nodes[inode - 1];
+            if (prev_route_node.iswitch == OPEN) {
+                /* A new branch has to start from a node of the routing found so far */
+                if (0 == visited_nodes.count(route_node.node)) {
+                    return false;
+                }
+                continue;
+            }
+
+            bool edge_found = false;
+            for (const RREdgeId& edge : device_ctx.rr_graph.find_edges(prev_route_node.node, route_node.node)) {
+                if (size_t(device_ctx.rr_graph.edge_switch(edge)) == size_t(prev_route_node.iswitch)) {
+                    edge_found = true;
+                    break;
+                }
+            }
+            if (!edge_found) {
+                return false;
+            }
+        }
+
+        visited_nodes.insert(route_node.node);
+        if (device_ctx.rr_graph.node_type(route_node.node) == SINK) {
+            sinks.push_back(route_node.node);
+        }
+    }
+
+    std::vector<RRNodeId> net_sinks(terminals.begin() + 1, terminals.end());
+    std::sort(sinks.begin(), sinks.end());
+    std::sort(net_sinks.begin(), net_sinks.end());
+    return sinks == net_sinks;
+}
+
+/* Load the routing of a net to its traceback */
+static void load_incremental_route_trace(ClusterNetId inet, const std::vector<t_incr_route_node>& route_nodes) {
+    auto& route_ctx = g_vpr_ctx.mutable_routing();
+
+    t_trace* tail = nullptr;
+    for (const t_incr_route_node& route_node : route_nodes) {
+        t_trace* tptr = alloc_trace_data();
+        tptr->index = route_node.node;
+        tptr->iswitch = route_node.iswitch;
+        tptr->next = nullptr;
+
+        if (tail == nullptr) {
+            route_ctx.trace[inet].head = tptr;
+        } else {
+            tail->next = tptr;
+        }
+        tail = tptr;
+
+        route_ctx.trace_nodes[inet].insert(route_node.node);
+    }
+    route_ctx.trace[inet].tail = tail;
+}
+
 /*This function goes through all the blocks in a global net and verify it with the
  * clustered netlist and the placement */
 static void process_global_blocks(std::ifstream& fp, ClusterNetId inet, const char* filename, int& lineno) {
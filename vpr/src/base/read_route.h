@@ -6,6 +6,20 @@
 #ifndef READ_ROUTE_H
 #define READ_ROUTE_H
 
+#include <vector>
+
 bool read_route(const char* route_file, const t_router_opts& RouterOpts, bool verify_file_digests);
 
+/*
+ * Read the routing of a previous run from a .route file (text format) as the starting
+ * point of the router, e.g. after a small change of the netlist or the placement.
+ * Unlike read_route(), mismatches with the current netlist, placement and rr graph
+ * are not errors: the routing of a net (found by its name) is only reused when the net
+ * has the same source and sinks in the rr graph, and all the nodes and switches of its
+ * routing exist in the rr graph. The other nets are left unrouted for the router.
+ * The routing structures must have been initialized (init_route_structs()).
+ * Returns the nets whose routing is reused
+ */
+std::vector<ClusterNetId> read_incremental_route(const char* route_file);
+
 #endif /* READ_ROUTE_H */
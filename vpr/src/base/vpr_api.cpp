@@ -203,11 +203,15 @@ void vpr_init_with_options(const t_options* options, t_vpr_setup* vpr_setup, t_a
     }
 
     VTR_LOG("Using up to %zu parallel worker(s)\n", num_workers);
+    //Terminate the scheduler of a previous run in the same process (e.g., the vpr
+    //command of the openfpga shell) first, otherwise the new number of workers
+    //is ignored as long as the previous scheduler is alive
+    tbb_scheduler.reset();
     tbb_scheduler = std::make_unique<tbb::task_scheduler_init>(num_workers);
 #else
     //No parallel execution support
     if (num_workers != 1) {
-        VTR_LOG_WARN("VPR was compiled without parallel execution support, ignoring the specified number of workers (%zu)",
+        VTR_LOG_WARN("VPR was compiled without parallel execution support, ignoring the specified number of workers (%zu) except for building tileable routing resource graph, parallel net routing and batched placement moves\n",
                      options->num_workers.value());
     }
 #endif
@@ -279,6 +283,12 @@ void vpr_init_with_options(const t_options* options, t_vpr_setup* vpr_setup, t_a
              &vpr_setup->SaveGraphics,
              &vpr_setup->PowerOpts);
 
+    /* The tileable rr_graph builder, the parallel net routing and the batched move
+     * evaluation of placer run their own threads, which do not require parallel execution support */
+    vpr_setup->RoutingArch.num_threads = num_workers;
+    vpr_setup->RouterOpts.num_threads = num_workers;
+    vpr_setup->PlacerOpts.num_threads = num_workers;
+
     /* Check inputs are reasonable */
     CheckArch(*arch);
 
@@ -691,6 +701,10 @@ RouteStatus vpr_route_flow(t_vpr_setup& vpr_setup, const t_arch& arch) {
             check_route(router_opts.route_type);
             get_serial_num();
 
+            //Snapshot the routed nodes of the nets for the tools walking the routing afterwards
+            auto& route_ctx = g_vpr_ctx.mutable_routing();
+            route_ctx.routed_net_nodes.load(route_ctx.trace);
+
             //Update status
             VTR_LOG("Circuit successfully routed with a channel width factor of %d.\n", route_status.chan_width());
             graphics_msg = vtr::string_fmt("Routing succeeded with a channel width factor of %d.", route_status.chan_width());
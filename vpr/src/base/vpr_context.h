@@ -291,6 +291,9 @@ struct RoutingContext : public Context {
     vtr::vector<ClusterNetId, t_traceback> trace;
     vtr::vector<ClusterNetId, std::unordered_set<RRNodeId>> trace_nodes;
 
+    /* The nodes of the traces of all the nets in a single array, loaded once routing is finished */
+    t_routed_net_nodes routed_net_nodes;
+
     /* Xifan Tang: this should adopt RRNodeId as well */
     vtr::vector<ClusterNetId, std::vector<RRNodeId>> net_rr_terminals; /* [0..num_nets-1][0..num_pins-1] */
 
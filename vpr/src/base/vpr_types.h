@@ -770,6 +770,11 @@ enum class e_reducer {
     GEOMEAN
 };
 
+enum class e_place_delta_delay_algorithm {
+    ASTAR_ROUTE,        //Route each sampled connection with the A* router
+    DIJKSTRA_EXPANSION, //Reach all the sampled sinks of a source with a single Dijkstra expansion
+};
+
 enum class e_file_type {
     PDF,
     PNG,
@@ -788,15 +793,20 @@ struct t_placer_opts {
     int recompute_crit_iter;
     bool enable_timing_computations;
     int inner_loop_recompute_divider;
+    bool incremental_sta;                   //Re-analyze only the timing graph affected by the moved blocks
+    int incremental_sta_full_update_period; //Number of timing updates between two full analyses with incremental_sta
     float td_place_exp_first;
     int seed;
     float td_place_exp_last;
     e_stage_action doPlacement;
     float rlim_escape_fraction;
     std::string move_stats_file;
+    int move_batch_size;    //Maximum number of moves evaluated concurrently
+    size_t num_threads = 1; //Number of threads to evaluate the moves of a batch, 0 to use all the hardware threads
 
     PlaceDelayModelType delay_model_type;
     e_reducer delay_model_reducer;
+    e_place_delta_delay_algorithm place_delta_delay_matrix_calculation_method;
 
     float delay_offset;
     int delay_ramp_delta_threshold;
@@ -951,8 +961,13 @@ struct t_router_opts {
     std::string first_iteration_timing_report_file;
     bool strict_checks;
 
+    bool parallel_net_routing; //Route the nets of disjoint regions concurrently
+    size_t num_threads = 1;    //Number of threads for parallel net routing, 0 to use all the hardware threads
+
     std::string write_router_lookahead;
     std::string read_router_lookahead;
+
+    std::string incremental_route_file; //Routing file of a previous run, whose legal nets are kept by the router (text format)
 };
 
 struct t_analysis_opts {
@@ -996,6 +1011,10 @@ struct t_analysis_opts {
  * read_rr_graph_filename: File to read the RR graph from (overrides        *
  *                         architecture)                                    *
  * write_rr_graph_filename: File to write the RR graph to after generation  *
+ * num_threads: Number of threads to build the tileable RR graph, 0 to use  *
+ *              all the hardware threads                                    *
+ * check_rr_graph: Whether to check the RR graph read from a file. It can   *
+ *                 be skipped when the same file was already checked        *
  *                                                                          */
 
 struct t_det_routing_arch {
@@ -1023,6 +1042,10 @@ struct t_det_routing_arch {
 
     std::string read_rr_graph_filename;
     std::string write_rr_graph_filename;
+
+    size_t num_threads = 1;
+
+    bool check_rr_graph = true;
 };
 
 
@@ -145,7 +145,7 @@ short RRGraph::node_capacity(const RRNodeId& node) const {
 
 short RRGraph::node_ptc_num(const RRNodeId& node) const {
     VTR_ASSERT_SAFE(valid_node_id(node));
-    return node_ptc_nums_[node][0];
+    return node_ptc_array(node)[0];
 }
 
 short RRGraph::node_pin_num(const RRNodeId& node) const {
@@ -169,7 +169,7 @@ std::vector<short> RRGraph::node_track_ids(const RRNodeId& node) const {
     VTR_ASSERT_MSG(node_type(node) == CHANX || node_type(node) == CHANY,
                    "Track number valid only for CHANX/CHANY RR nodes");
     VTR_ASSERT_SAFE(valid_node_id(node));
-    return node_ptc_nums_[node];
+    return std::vector<short>(node_ptc_array(node), node_ptc_array(node) + node_num_ptcs(node));
 }
 
 short RRGraph::node_cost_index(const RRNodeId& node) const {
@@ -218,22 +218,22 @@ RRSegmentId RRGraph::node_segment(const RRNodeId& node) const {
 RRGraph::edge_range RRGraph::node_edges(const RRNodeId& node) const {
     VTR_ASSERT_SAFE(valid_node_id(node));
 
-    return vtr::make_range(node_edges_[node].get(),
-                           node_edges_[node].get() + node_num_in_edges_[node] + node_num_out_edges_[node]);
+    return vtr::make_range(node_edge_array(node),
+                           node_edge_array(node) + node_num_in_edges_[node] + node_num_out_edges_[node]);
 }
 
 RRGraph::edge_range RRGraph::node_in_edges(const RRNodeId& node) const {
     VTR_ASSERT_SAFE(valid_node_id(node));
 
-    return vtr::make_range(node_edges_[node].get(),
-                           node_edges_[node].get() + node_num_in_edges_[node]);
+    return vtr::make_range(node_edge_array(node),
+                           node_edge_array(node) + node_num_in_edges_[node]);
 }
 
 RRGraph::edge_range RRGraph::node_out_edges(const RRNodeId& node) const {
     VTR_ASSERT_SAFE(valid_node_id(node));
 
-    return vtr::make_range((node_edges_[node].get() + node_num_in_edges_[node]),
-                           (node_edges_[node].get() + node_num_in_edges_[node]) + node_num_out_edges_[node]);
+    return vtr::make_range((node_edge_array(node) + node_num_in_edges_[node]),
+                           (node_edge_array(node) + node_num_in_edges_[node]) + node_num_out_edges_[node]);
 }
 
 /* Get the list of configurable edges from the input edges of a given node 
@@ -242,8 +242,8 @@ RRGraph::edge_range RRGraph::node_out_edges(const RRNodeId& node) const {
 RRGraph::edge_range RRGraph::node_configurable_in_edges(const RRNodeId& node) const {
     VTR_ASSERT_SAFE(valid_node_id(node));
 
-    return vtr::make_range(node_edges_[node].get(),
-                           node_edges_[node].get() + node_num_in_edges_[node] - node_num_non_configurable_in_edges_[node]);
+    return vtr::make_range(node_edge_array(node),
+                           node_edge_array(node) + node_num_in_edges_[node] - node_num_non_configurable_in_edges_[node]);
 }
 
 /* Get the list of non configurable edges from the input edges of a given node 
@@ -252,8 +252,8 @@ RRGraph::edge_range RRGraph::node_configurable_in_edges(const RRNodeId& node) co
 RRGraph::edge_range RRGraph::node_non_configurable_in_edges(const RRNodeId& node) const {
     VTR_ASSERT_SAFE(valid_node_id(node));
 
-    return vtr::make_range(node_edges_[node].get() + node_num_in_edges_[node] - node_num_non_configurable_in_edges_[node],
-                           node_edges_[node].get() + node_num_in_edges_[node]);
+    return vtr::make_range(node_edge_array(node) + node_num_in_edges_[node] - node_num_non_configurable_in_edges_[node],
+                           node_edge_array(node) + node_num_in_edges_[node]);
 }
 
 /* Get the list of configurable edges from the output edges of a given node 
@@ -262,8 +262,8 @@ RRGraph::edge_range RRGraph::node_non_configurable_in_edges(const RRNodeId& node
 RRGraph::edge_range RRGraph::node_configurable_out_edges(const RRNodeId& node) const {
     VTR_ASSERT_SAFE(valid_node_id(node));
 
-    return vtr::make_range((node_edges_[node].get() + node_num_in_edges_[node]),
-                           (node_edges_[node].get() + node_num_in_edges_[node]) + node_num_out_edges_[node] - node_num_non_configurable_out_edges_[node]);
+    return vtr::make_range((node_edge_array(node) + node_num_in_edges_[node]),
+                           (node_edge_array(node) + node_num_in_edges_[node]) + node_num_out_edges_[node] - node_num_non_configurable_out_edges_[node]);
 }
 
 /* Get the list of non configurable edges from the output edges of a given node 
@@ -272,8 +272,8 @@ RRGraph::edge_range RRGraph::node_configurable_out_edges(const RRNodeId& node) c
 RRGraph::edge_range RRGraph::node_non_configurable_out_edges(const RRNodeId& node) const {
     VTR_ASSERT_SAFE(valid_node_id(node));
 
-    return vtr::make_range((node_edges_[node].get() + node_num_in_edges_[node]) + node_num_out_edges_[node] - node_num_non_configurable_out_edges_[node],
-                           (node_edges_[node].get() + node_num_in_edges_[node]) + node_num_out_edges_[node]);
+    return vtr::make_range((node_edge_array(node) + node_num_in_edges_[node]) + node_num_out_edges_[node] - node_num_non_configurable_out_edges_[node],
+                           (node_edge_array(node) + node_num_in_edges_[node]) + node_num_out_edges_[node]);
 }
 
 //Edge attributes
@@ -363,6 +363,10 @@ RRNodeId RRGraph::find_node(const short& x, const short& y, const t_rr_type& typ
     size_t itype = type;
     size_t iside = side;
 
+    if (true == frozen_) {
+        return find_frozen_node(x, y, itype, ptc, iside);
+    }
+
     /* Check if x, y, type and ptc, side is valid */
     if ((x < 0)                                          /* See if x is smaller than the index of first element */
         || (size_t(x) > node_lookup_.dim_size(0) - 1) /* See if x is large than the index of last element */
@@ -413,6 +417,16 @@ short RRGraph::chan_num_tracks(const short& x, const short& y, const t_rr_type&
                    "Required node_type to be CHANX or CHANY!");
     initialize_fast_node_lookup();
 
+    if (true == frozen_) {
+        if ((x < 0) || (size_t(x) >= frozen_lookup_dims_[0])
+            || (y < 0) || (size_t(y) >= frozen_lookup_dims_[1])
+            || (size_t(type) >= frozen_lookup_dims_[2])) {
+            return 0;
+        }
+        size_t ixyt = (size_t(x) * frozen_lookup_dims_[1] + size_t(y)) * frozen_lookup_dims_[2] + size_t(type);
+        return frozen_lookup_ptc_offsets_[ixyt + 1] - frozen_lookup_ptc_offsets_[ixyt];
+    }
+
     /* Check if x, y, type and ptc is valid */
     if ((x < 0)                                          /* See if x is smaller than the index of first element */
         || (size_t(x) > node_lookup_.dim_size(0) - 1)) { /* See if x is large than the index of last element */
@@ -767,6 +781,10 @@ bool RRGraph::is_dirty() const {
     return dirty_;
 }
 
+bool RRGraph::is_frozen() const {
+    return frozen_;
+}
+
 void RRGraph::set_dirty() {
     dirty_ = true;
 }
@@ -777,6 +795,8 @@ void RRGraph::clear_dirty() {
 
 /* Reserve a list of nodes */
 void RRGraph::reserve_nodes(const unsigned long& num_nodes) {
+    unfreeze();
+
     /* Reserve the full set of vectors related to nodes */
     /* Basic information */
     this->node_types_.reserve(num_nodes);
@@ -823,6 +843,8 @@ void RRGraph::reserve_segments(const size_t& num_segments) {
 
 /* Mutators */
 RRNodeId RRGraph::create_node(const t_rr_type& type) {
+    unfreeze();
+
     /* Allocate an ID */
     RRNodeId node_id = RRNodeId(num_nodes_);
     /* Expand range of node ids */
@@ -917,6 +939,8 @@ RRSegmentId RRGraph::create_segment(const t_segment_inf& segment_info) {
  * The compress() function should be called to physically remove the node 
  */
 void RRGraph::remove_node(const RRNodeId& node) {
+    unfreeze();
+
     //Invalidate all connected edges
     // TODO: consider removal of self-loop edges?
     for (auto edge : node_in_edges(node)) {
@@ -940,6 +964,8 @@ void RRGraph::remove_node(const RRNodeId& node) {
  * The compress() function should be called to physically remove the edge 
  */
 void RRGraph::remove_edge(const RREdgeId& edge) {
+    unfreeze();
+
     RRNodeId src_node = edge_src_node(edge);
     RRNodeId sink_node = edge_sink_node(edge);
 
@@ -1009,6 +1035,7 @@ void RRGraph::set_node_capacity(const RRNodeId& node, const short& capacity) {
 
 void RRGraph::set_node_ptc_num(const RRNodeId& node, const short& ptc) {
     VTR_ASSERT(valid_node_id(node));
+    unfreeze();
 
     /* For CHANX and CHANY, we will resize the ptc num to length of the node
      * For other nodes, we will always assign the first element
@@ -1050,6 +1077,7 @@ void RRGraph::add_node_track_num(const RRNodeId& node,
                                  const short& track_id) {
     VTR_ASSERT(valid_node_id(node));
     VTR_ASSERT_MSG(node_type(node) == CHANX || node_type(node) == CHANY, "Track number valid only for CHANX/CHANY RR nodes");
+    unfreeze();
 
     if ((size_t)node_length(node) + 1 != node_ptc_nums_[node].size()) {
         node_ptc_nums_[node].resize((size_t)node_length(node) + 1);
@@ -1113,6 +1141,8 @@ void RRGraph::set_node_segment(const RRNodeId& node, const RRSegmentId& segment_
     node_segments_[node] = segment_id;
 }
 void RRGraph::rebuild_node_edges() {
+    unfreeze();
+
     node_edges_.resize(nodes().size());
     node_num_in_edges_.resize(nodes().size(), 0);
     node_num_out_edges_.resize(nodes().size(), 0);
@@ -1312,7 +1342,8 @@ void RRGraph::invalidate_fast_node_lookup() const {
 }
 
 bool RRGraph::valid_fast_node_lookup() const {
-    return !node_lookup_.empty();
+    /* A frozen graph always has a flattened look-up */
+    return frozen_ || !node_lookup_.empty();
 }
 
 void RRGraph::initialize_fast_node_lookup() const {
@@ -1360,7 +1391,7 @@ bool RRGraph::validate_node_sizes() const {
     return node_types_.size() == num_nodes_
            && node_bounding_boxes_.size() == num_nodes_
            && node_capacities_.size() == num_nodes_
-           && node_ptc_nums_.size() == num_nodes_
+           && (frozen_ ? frozen_node_ptc_offsets_.size() == num_nodes_ + 1 : node_ptc_nums_.size() == num_nodes_)
            && node_cost_indices_.size() == num_nodes_
            && node_directions_.size() == num_nodes_
            && node_sides_.size() == num_nodes_
@@ -1369,7 +1400,7 @@ bool RRGraph::validate_node_sizes() const {
            && node_segments_.size() == num_nodes_
            && node_num_non_configurable_in_edges_.size() == num_nodes_
            && node_num_non_configurable_out_edges_.size() == num_nodes_
-           && node_edges_.size() == num_nodes_;
+           && (frozen_ ? frozen_node_edge_offsets_.size() == num_nodes_ + 1 : node_edges_.size() == num_nodes_);
 }
 
 bool RRGraph::validate_edge_sizes() const {
@@ -1387,6 +1418,8 @@ bool RRGraph::validate_segment_sizes() const {
 }
 
 void RRGraph::compress() {
+    unfreeze();
+
     vtr::vector<RRNodeId, RRNodeId> node_id_map(num_nodes_);
     vtr::vector<RREdgeId, RREdgeId> edge_id_map(num_edges_);
 
@@ -1491,6 +1524,159 @@ void RRGraph::rebuild_node_refs(const vtr::vector<RREdgeId, RREdgeId>& edge_id_m
     }
 }
 
+/************************************************************************
+ * Contiguous storage of a frozen graph
+ ***********************************************************************/
+void RRGraph::freeze() {
+    if (true == frozen_) {
+        return;
+    }
+    VTR_ASSERT_MSG(false == is_dirty(), "RRGraph should be compressed before being frozen");
+    VTR_ASSERT_MSG(node_edges_.size() == num_nodes_, "Node edges should be rebuilt before freezing RRGraph");
+
+    /* Build the look-up before dropping the per-node track ids it is built from */
+    initialize_fast_node_lookup();
+
+    /* Edges of nodes */
+    frozen_node_edge_offsets_.resize(num_nodes_ + 1);
+    size_t num_node_edges = 0;
+    for (size_t id = 0; id < num_nodes_; ++id) {
+        frozen_node_edge_offsets_[id] = num_node_edges;
+        if (nullptr != node_edges_[RRNodeId(id)]) {
+            num_node_edges += node_num_in_edges_[RRNodeId(id)] + node_num_out_edges_[RRNodeId(id)];
+        }
+    }
+    frozen_node_edge_offsets_[num_nodes_] = num_node_edges;
+
+    frozen_node_edges_.resize(num_node_edges);
+    for (size_t id = 0; id < num_nodes_; ++id) {
+        std::copy(node_edges_[RRNodeId(id)].get(),
+                  node_edges_[RRNodeId(id)].get() + frozen_node_edge_offsets_[id + 1] - frozen_node_edge_offsets_[id],
+                  frozen_node_edges_.begin() + frozen_node_edge_offsets_[id]);
+    }
+
+    /* Track ids of nodes */
+    frozen_node_ptc_offsets_.resize(num_nodes_ + 1);
+    size_t num_node_ptcs = 0;
+    for (size_t id = 0; id < num_nodes_; ++id) {
+        frozen_node_ptc_offsets_[id] = num_node_ptcs;
+        num_node_ptcs += node_ptc_nums_[RRNodeId(id)].size();
+    }
+    frozen_node_ptc_offsets_[num_nodes_] = num_node_ptcs;
+
+    frozen_node_ptc_nums_.reserve(num_node_ptcs);
+    for (size_t id = 0; id < num_nodes_; ++id) {
+        frozen_node_ptc_nums_.insert(frozen_node_ptc_nums_.end(),
+                                     node_ptc_nums_[RRNodeId(id)].begin(),
+                                     node_ptc_nums_[RRNodeId(id)].end());
+    }
+
+    /* Fast node look-up */
+    frozen_lookup_dims_ = {{node_lookup_.dim_size(0), node_lookup_.dim_size(1), node_lookup_.dim_size(2)}};
+    frozen_lookup_ptc_offsets_.clear();
+    frozen_lookup_side_offsets_.clear();
+    frozen_lookup_nodes_.clear();
+    frozen_lookup_ptc_offsets_.reserve(frozen_lookup_dims_[0] * frozen_lookup_dims_[1] * frozen_lookup_dims_[2] + 1);
+    for (size_t x = 0; x < frozen_lookup_dims_[0]; ++x) {
+        for (size_t y = 0; y < frozen_lookup_dims_[1]; ++y) {
+            for (size_t itype = 0; itype < frozen_lookup_dims_[2]; ++itype) {
+                frozen_lookup_ptc_offsets_.push_back(frozen_lookup_side_offsets_.size());
+                for (const std::vector<RRNodeId>& ptc_nodes : node_lookup_[x][y][itype]) {
+                    frozen_lookup_side_offsets_.push_back(frozen_lookup_nodes_.size());
+                    frozen_lookup_nodes_.insert(frozen_lookup_nodes_.end(), ptc_nodes.begin(), ptc_nodes.end());
+                }
+            }
+        }
+    }
+    frozen_lookup_ptc_offsets_.push_back(frozen_lookup_side_offsets_.size());
+    frozen_lookup_side_offsets_.push_back(frozen_lookup_nodes_.size());
+
+    /* Release the per-node storage */
+    node_edges_ = vtr::vector<RRNodeId, std::unique_ptr<RREdgeId[]>>();
+    node_ptc_nums_ = vtr::vector<RRNodeId, std::vector<short>>();
+    node_lookup_ = NodeLookup();
+
+    frozen_ = true;
+}
+
+void RRGraph::unfreeze() {
+    if (false == frozen_) {
+        return;
+    }
+
+    /* Edges of nodes */
+    node_edges_.resize(num_nodes_);
+    for (size_t id = 0; id < num_nodes_; ++id) {
+        size_t num_node_edges = frozen_node_edge_offsets_[id + 1] - frozen_node_edge_offsets_[id];
+        node_edges_[RRNodeId(id)] = std::make_unique<RREdgeId[]>(num_node_edges);
+        std::copy(frozen_node_edges_.begin() + frozen_node_edge_offsets_[id],
+                  frozen_node_edges_.begin() + frozen_node_edge_offsets_[id + 1],
+                  node_edges_[RRNodeId(id)].get());
+    }
+
+    /* Track ids of nodes */
+    node_ptc_nums_.resize(num_nodes_);
+    for (size_t id = 0; id < num_nodes_; ++id) {
+        node_ptc_nums_[RRNodeId(id)].assign(frozen_node_ptc_nums_.begin() + frozen_node_ptc_offsets_[id],
+                                            frozen_node_ptc_nums_.begin() + frozen_node_ptc_offsets_[id + 1]);
+    }
+
+    std::vector<size_t>().swap(frozen_node_edge_offsets_);
+    std::vector<RREdgeId>().swap(frozen_node_edges_);
+    std::vector<size_t>().swap(frozen_node_ptc_offsets_);
+    std::vector<short>().swap(frozen_node_ptc_nums_);
+    frozen_lookup_dims_ = {{0, 0, 0}};
+    std::vector<size_t>().swap(frozen_lookup_ptc_offsets_);
+    std::vector<size_t>().swap(frozen_lookup_side_offsets_);
+    std::vector<RRNodeId>().swap(frozen_lookup_nodes_);
+
+    /* The fast look-up will be rebuilt on request */
+    frozen_ = false;
+}
+
+const RREdgeId* RRGraph::node_edge_array(const RRNodeId& node) const {
+    if (true == frozen_) {
+        return frozen_node_edges_.data() + frozen_node_edge_offsets_[size_t(node)];
+    }
+    return node_edges_[node].get();
+}
+
+const short* RRGraph::node_ptc_array(const RRNodeId& node) const {
+    if (true == frozen_) {
+        return frozen_node_ptc_nums_.data() + frozen_node_ptc_offsets_[size_t(node)];
+    }
+    return node_ptc_nums_[node].data();
+}
+
+size_t RRGraph::node_num_ptcs(const RRNodeId& node) const {
+    if (true == frozen_) {
+        return frozen_node_ptc_offsets_[size_t(node) + 1] - frozen_node_ptc_offsets_[size_t(node)];
+    }
+    return node_ptc_nums_[node].size();
+}
+
+RRNodeId RRGraph::find_frozen_node(const short& x, const short& y, const size_t& itype, const int& ptc, const size_t& iside) const {
+    /* Check if x, y, type and ptc, side is valid */
+    if ((x < 0) || (size_t(x) >= frozen_lookup_dims_[0])
+        || (y < 0) || (size_t(y) >= frozen_lookup_dims_[1])
+        || (itype >= frozen_lookup_dims_[2])) {
+        return RRNodeId::INVALID();
+    }
+
+    size_t ixyt = (size_t(x) * frozen_lookup_dims_[1] + size_t(y)) * frozen_lookup_dims_[2] + itype;
+    size_t ptc_begin = frozen_lookup_ptc_offsets_[ixyt];
+    if ((ptc < 0) || (size_t(ptc) >= frozen_lookup_ptc_offsets_[ixyt + 1] - ptc_begin)) {
+        return RRNodeId::INVALID();
+    }
+
+    size_t side_begin = frozen_lookup_side_offsets_[ptc_begin + ptc];
+    if (iside >= frozen_lookup_side_offsets_[ptc_begin + ptc + 1] - side_begin) {
+        return RRNodeId::INVALID();
+    }
+
+    return frozen_lookup_nodes_[side_begin + iside];
+}
+
 /* Empty all the vectors related to nodes */
 void RRGraph::clear_nodes() {
     num_nodes_ = 0;
@@ -1516,6 +1702,17 @@ void RRGraph::clear_nodes() {
 
     /* clean node_look_up */
     node_lookup_.clear();
+
+    /* clean the contiguous storage */
+    frozen_ = false;
+    frozen_node_edge_offsets_.clear();
+    frozen_node_edges_.clear();
+    frozen_node_ptc_offsets_.clear();
+    frozen_node_ptc_nums_.clear();
+    frozen_lookup_dims_ = {{0, 0, 0}};
+    frozen_lookup_ptc_offsets_.clear();
+    frozen_lookup_side_offsets_.clear();
+    frozen_lookup_nodes_.clear();
 }
 
 /* Empty all the vectors related to edges */
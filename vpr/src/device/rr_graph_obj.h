@@ -196,14 +196,15 @@
  */
 /* Header files should be included in a sequence */
 /* Standard header files required go first */
+#include <array>
 #include <limits>
 #include <vector>
-#include <unordered_set>
 #include <unordered_map>
 
 /* EXTERNAL library header files go second*/
 #include "vtr_ndmatrix.h"
 #include "vtr_vector.h"
+#include "vtr_lazy_id_iterator.h"
 #include "vtr_range.h"
 #include "vtr_geometry.h"
 #include "arch_types.h"
@@ -214,21 +215,17 @@
 
 class RRGraph {
   public: /* Types */
-    //Lazy iterator utility forward declaration
-    template<class ID>
-    class lazy_id_iterator;
-
     /* Iterators used to create iterator-based loop for nodes/edges/switches/segments */
     typedef vtr::vector<RRNodeId, RRNodeId>::const_iterator node_iterator;
     typedef vtr::vector<RREdgeId, RREdgeId>::const_iterator edge_iterator;
     typedef vtr::vector<RRSwitchId, RRSwitchId>::const_iterator switch_iterator;
     typedef vtr::vector<RRSegmentId, RRSegmentId>::const_iterator segment_iterator;
-    typedef lazy_id_iterator<RRNodeId> lazy_node_iterator;
-    typedef lazy_id_iterator<RREdgeId> lazy_edge_iterator;
+    typedef vtr::lazy_id_iterator<RRNodeId> lazy_node_iterator;
+    typedef vtr::lazy_id_iterator<RREdgeId> lazy_edge_iterator;
 
     /* Ranges used to create range-based loop for nodes/edges/switches/segments */
     typedef vtr::Range<node_iterator> node_range;
-    typedef vtr::Range<RREdgeId*> edge_range;
+    typedef vtr::Range<const RREdgeId*> edge_range;
     typedef vtr::Range<switch_iterator> switch_range;
     typedef vtr::Range<segment_iterator> segment_range;
     typedef vtr::Range<lazy_node_iterator> lazy_node_range;
@@ -573,6 +570,11 @@ class RRGraph {
      */
     bool is_dirty() const;
 
+    /* This flag is raised when the RRGraph uses the contiguous storage
+     * created by freeze(). See freeze() for details
+     */
+    bool is_frozen() const;
+
   public:                                        /* Echos */
     void print_node(const RRNodeId& node) const; /* Print the detailed information of a node */
 
@@ -752,58 +754,27 @@ class RRGraph {
      */
     void compress();
 
+    /* Freeze the RRGraph once it is built, when it is only read by routers and analyzers.
+     * The edges and track ids of nodes as well as the fast node look-up
+     * are moved to contiguous arrays (compressed sparse rows),
+     * which reduces the memory footprint and improves the cache locality of accessors.
+     * The graph must be clean (is_dirty() == false) and rebuild_node_edges() must have been called.
+     * Accessors behave the same on a frozen graph.
+     * The mutators which change nodes, track ids or node edges unfreeze the graph automatically
+     */
+    void freeze();
+
     /* top-level function to free, should be called when to delete a RRGraph */
     void clear();
     
     /* Due to the rr_graph builder, we have to make this method public!!!! */
     void clear_switches();
 
-  public: /* Type implementations */
-    /*
-     * This class (forward delcared above) is a template used to represent a lazily calculated 
-     * iterator of the specified ID type. The key assumption made is that the ID space is 
-     * contiguous and can be walked by incrementing the underlying ID value. To account for 
-     * invalid IDs, it keeps a reference to the invalid ID set and returns ID::INVALID() for
-     * ID values in the set.
-     *
-     * It is used to lazily create an iteration range (e.g. as returned by RRGraph::edges() RRGraph::nodes())
-     * just based on the count of allocated elements (i.e. RRGraph::num_nodes_ or RRGraph::num_edges_),
-     * and the set of any invalid IDs (i.e. RRGraph::invalid_node_ids_, RRGraph::invalid_edge_ids_).
-     */
-    template<class ID>
-    class lazy_id_iterator : public std::iterator<std::bidirectional_iterator_tag, ID> {
-      public:
-        //Since we pass ID as a template to std::iterator we need to use an explicit 'typename'
-        //to bring the value_type and iterator names into scope
-        typedef typename std::iterator<std::bidirectional_iterator_tag, ID>::value_type value_type;
-        typedef typename std::iterator<std::bidirectional_iterator_tag, ID>::iterator iterator;
-
-        lazy_id_iterator(value_type init, const std::unordered_set<ID>& invalid_ids)
-            : value_(init)
-            , invalid_ids_(invalid_ids) {}
-
-        //Advance to the next ID value
-        iterator operator++() {
-            value_ = ID(size_t(value_) + 1);
-            return *this;
-        }
-
-        //Advance to the previous ID value
-        iterator operator--() {
-            value_ = ID(size_t(value_) - 1);
-            return *this;
-        }
-
-        //Dereference the iterator
-        value_type operator*() const { return (invalid_ids_.count(value_)) ? ID::INVALID() : value_; }
-
-        friend bool operator==(const lazy_id_iterator<ID> lhs, const lazy_id_iterator<ID> rhs) { return lhs.value_ == rhs.value_; }
-        friend bool operator!=(const lazy_id_iterator<ID> lhs, const lazy_id_iterator<ID> rhs) { return !(lhs == rhs); }
-
-      private:
-        value_type value_;
-        const std::unordered_set<ID>& invalid_ids_;
-    };
+    /* Build the fast node look-up if it is not valid yet.
+     * The look-up is built lazily by find_node(), so this method must be called
+     * before accessing the rr_graph from multiple threads
+     */
+    void initialize_fast_node_lookup() const;
 
   private: /* Internal free functions */
     void clear_nodes();
@@ -820,12 +791,21 @@ class RRGraph {
     void set_dirty();
     void clear_dirty();
 
+  private: /* Contiguous storage related */
+    /* Move the contiguous storage back to the per-node storage, so that the graph can be modified */
+    void unfreeze();
+    /* Get the first element of the edges/track ids of a node, whatever storage is used */
+    const RREdgeId* node_edge_array(const RRNodeId& node) const;
+    const short* node_ptc_array(const RRNodeId& node) const;
+    size_t node_num_ptcs(const RRNodeId& node) const;
+    /* Find a node in the flattened fast look-up */
+    RRNodeId find_frozen_node(const short& x, const short& y, const size_t& itype, const int& ptc, const size_t& iside) const;
+
   private: /* Internal validators and builders */
     /* Fast look-up builders and validators */
     void build_fast_node_lookup() const;
     void invalidate_fast_node_lookup() const;
     bool valid_fast_node_lookup() const;
-    void initialize_fast_node_lookup() const;
 
     /* Graph property Validation */
     bool validate_sizes() const;
@@ -865,7 +845,7 @@ class RRGraph {
   private: /* Internal Data */
     /* Node related data */
     size_t num_nodes_;                              /* Range of node ids */
-    std::unordered_set<RRNodeId> invalid_node_ids_; /* Invalid edge ids */
+    vtr::tombstone_bitmap<RRNodeId> invalid_node_ids_; /* Invalid edge ids */
 
     vtr::vector<RRNodeId, t_rr_type> node_types_;
 
@@ -921,7 +901,7 @@ class RRGraph {
      * the number of edges could be >10 times larger than the number of nodes! 
      */
     unsigned long num_edges_;                         
-    std::unordered_set<RREdgeId> invalid_edge_ids_;   /* Invalid edge ids */
+    vtr::tombstone_bitmap<RREdgeId> invalid_edge_ids_;   /* Invalid edge ids */
     vtr::vector<RREdgeId, RRNodeId> edge_src_nodes_;
     vtr::vector<RREdgeId, RRNodeId> edge_sink_nodes_;
     vtr::vector<RREdgeId, RRSwitchId> edge_switches_;
@@ -951,6 +931,25 @@ class RRGraph {
      */
     typedef vtr::NdMatrix<std::vector<std::vector<RRNodeId>>, 3> NodeLookup;
     mutable NodeLookup node_lookup_;
+
+    /* Contiguous storage of a frozen graph, which replaces
+     * node_edges_, node_ptc_nums_ and node_lookup_ (see freeze()) 
+     * - The edges of a node are frozen_node_edges_[frozen_node_edge_offsets_[node]..frozen_node_edge_offsets_[node + 1] - 1],
+     *   in the same sub-ranges as node_edges_
+     * - The track ids of a node are frozen_node_ptc_nums_[frozen_node_ptc_offsets_[node]..frozen_node_ptc_offsets_[node + 1] - 1]
+     * - The fast look-up is flattened in the same way for each level: 
+     *   [x][y][type] -> frozen_lookup_ptc_offsets_ -> [ptc] -> frozen_lookup_side_offsets_ -> [side] -> frozen_lookup_nodes_
+     *   where [x][y][type] is indexed by (x * dim_y + y) * dim_type + type
+     */
+    bool frozen_ = false;
+    std::vector<size_t> frozen_node_edge_offsets_;
+    std::vector<RREdgeId> frozen_node_edges_;
+    std::vector<size_t> frozen_node_ptc_offsets_;
+    std::vector<short> frozen_node_ptc_nums_;
+    std::array<size_t, 3> frozen_lookup_dims_ = {{0, 0, 0}};
+    std::vector<size_t> frozen_lookup_ptc_offsets_;
+    std::vector<size_t> frozen_lookup_side_offsets_;
+    std::vector<RRNodeId> frozen_lookup_nodes_;
 };
 
 #endif
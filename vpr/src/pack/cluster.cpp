@@ -70,8 +70,13 @@
 #include "tatum/report/graphviz_dot_writer.hpp"
 #include "tatum/TimingReporter.hpp"
 
+#if defined(VPR_USE_TBB)
+#    include <tbb/parallel_for.h>
+#endif
+
 #define AAPACK_MAX_HIGH_FANOUT_EXPLORE 10 /* For high-fanout nets that are ignored, consider a maximum of this many sinks, must be less than packer_opts.feasible_block_array_size */
 #define AAPACK_MAX_TRANSITIVE_EXPLORE 40  /* When investigating transitive fanout connections in packing, consider a maximum of this many molecules, must be less than packer_opts.feasible_block_array_size */
+#define AAPACK_MIN_PARALLEL_CANDIDATES 64 /* Evaluate the candidate molecules of a cluster on multiple threads only when there are at least this many of them */
 
 //Constant allowing all cluster pins to be used
 const t_ext_pin_util FULL_EXTERNAL_PIN_UTIL(1., 1.);
@@ -151,10 +156,16 @@ static void check_for_duplicate_inputs ();
 static bool is_atom_blk_in_pb(const AtomBlockId blk_id, const t_pb* pb);
 
 static void add_molecule_to_pb_stats_candidates(t_pack_molecule* molecule,
-                                                std::map<AtomBlockId, float>& gain,
+                                                const float molecule_gain,
                                                 t_pb* pb,
                                                 int max_queue_size);
 
+static void evaluate_candidate_molecules(const std::vector<t_pack_molecule*>& candidates,
+                                         const t_cluster_placement_stats* cluster_placement_stats_ptr,
+                                         const std::map<AtomBlockId, float>& gain,
+                                         std::vector<char>& candidate_feasible,
+                                         std::vector<float>& candidate_gains);
+
 static void alloc_and_init_clustering(const t_molecule_stats& max_molecule_stats,
                                       t_cluster_placement_stats** cluster_placement_stats,
                                       t_pb_graph_node*** primitives_list,
@@ -322,7 +333,7 @@ static std::vector<AtomBlockId> initialize_seed_atoms(const e_cluster_seed seed_
 
 static t_pack_molecule* get_highest_gain_seed_molecule(int* seedindex, const std::multimap<AtomBlockId, t_pack_molecule*>& atom_molecules, const std::vector<AtomBlockId> seed_atoms);
 
-static float get_molecule_gain(t_pack_molecule* molecule, std::map<AtomBlockId, float>& blk_gain);
+static float get_molecule_gain(const t_pack_molecule* molecule, const std::map<AtomBlockId, float>& blk_gain);
 static int compare_molecule_gain(const void* a, const void* b);
 int net_sinks_reachable_in_cluster(const t_pb_graph_pin* driver_pb_gpin, const int depth, const AtomNetId net_id);
 
@@ -810,50 +821,101 @@ static bool is_atom_blk_in_pb(const AtomBlockId blk_id, const t_pb* pb) {
 
 /* Add blk to list of feasible blocks sorted according to gain */
 static void add_molecule_to_pb_stats_candidates(t_pack_molecule* molecule,
-                                                std::map<AtomBlockId, float>& gain,
+                                                const float molecule_gain,
                                                 t_pb* pb,
                                                 int max_queue_size) {
     int i, j;
+    t_pack_molecule** feasible_blocks = pb->pb_stats->feasible_blocks;
+    float* feasible_block_gains = pb->pb_stats->feasible_block_gains;
 
     for (i = 0; i < pb->pb_stats->num_feasible_blocks; i++) {
-        if (pb->pb_stats->feasible_blocks[i] == molecule) {
+        if (feasible_blocks[i] == molecule) {
             return; /* already in queue, do nothing */
         }
     }
 
     if (pb->pb_stats->num_feasible_blocks >= max_queue_size - 1) {
         /* maximum size for array, remove smallest gain element and sort */
-        if (get_molecule_gain(molecule, gain) > get_molecule_gain(pb->pb_stats->feasible_blocks[0], gain)) {
+        if (molecule_gain > feasible_block_gains[0]) {
             /* single loop insertion sort */
             for (j = 0; j < pb->pb_stats->num_feasible_blocks - 1; j++) {
-                if (get_molecule_gain(molecule, gain) <= get_molecule_gain(pb->pb_stats->feasible_blocks[j + 1], gain)) {
-                    pb->pb_stats->feasible_blocks[j] = molecule;
+                if (molecule_gain <= feasible_block_gains[j + 1]) {
+                    feasible_blocks[j] = molecule;
+                    feasible_block_gains[j] = molecule_gain;
                     break;
                 } else {
-                    pb->pb_stats->feasible_blocks[j] = pb->pb_stats->feasible_blocks[j + 1];
+                    feasible_blocks[j] = feasible_blocks[j + 1];
+                    feasible_block_gains[j] = feasible_block_gains[j + 1];
                 }
             }
             if (j == pb->pb_stats->num_feasible_blocks - 1) {
-                pb->pb_stats->feasible_blocks[j] = molecule;
+                feasible_blocks[j] = molecule;
+                feasible_block_gains[j] = molecule_gain;
             }
         }
     } else {
         /* Expand array and single loop insertion sort */
         for (j = pb->pb_stats->num_feasible_blocks - 1; j >= 0; j--) {
-            if (get_molecule_gain(pb->pb_stats->feasible_blocks[j], gain) > get_molecule_gain(molecule, gain)) {
-                pb->pb_stats->feasible_blocks[j + 1] = pb->pb_stats->feasible_blocks[j];
+            if (feasible_block_gains[j] > molecule_gain) {
+                feasible_blocks[j + 1] = feasible_blocks[j];
+                feasible_block_gains[j + 1] = feasible_block_gains[j];
             } else {
-                pb->pb_stats->feasible_blocks[j + 1] = molecule;
+                feasible_blocks[j + 1] = molecule;
+                feasible_block_gains[j + 1] = molecule_gain;
                 break;
             }
         }
         if (j < 0) {
-            pb->pb_stats->feasible_blocks[0] = molecule;
+            feasible_blocks[0] = molecule;
+            feasible_block_gains[0] = molecule_gain;
         }
         pb->pb_stats->num_feasible_blocks++;
     }
 }
 
+/* Check the feasibility and compute the gain of the candidate molecules of a cluster.
+ * The candidates are independent from each others, as the cluster is only read,
+ * so that they are evaluated on multiple threads for large numbers of candidates.
+ * The candidates are then added to the cluster in their original order,
+ * so that the choices of the packer are the same whatever number of threads is used
+ */
+static void evaluate_candidate_molecules(const std::vector<t_pack_molecule*>& candidates,
+                                         const t_cluster_placement_stats* cluster_placement_stats_ptr,
+                                         const std::map<AtomBlockId, float>& gain,
+                                         std::vector<char>& candidate_feasible,
+                                         std::vector<float>& candidate_gains) {
+    candidate_feasible.assign(candidates.size(), false);
+    candidate_gains.assign(candidates.size(), 0.);
+
+    auto evaluate_candidate = [&](const size_t icand) {
+        auto& atom_ctx = g_vpr_ctx.atom();
+        const t_pack_molecule* molecule = candidates[icand];
+        for (int j = 0; j < get_array_size_of_molecule(molecule); j++) {
+            if (molecule->atom_block_ids[j]) {
+                VTR_ASSERT(atom_ctx.lookup.atom_clb(molecule->atom_block_ids[j]) == ClusterBlockId::INVALID());
+                auto blk_id = molecule->atom_block_ids[j];
+                if (!exists_free_primitive_for_atom_block_no_cleanup(cluster_placement_stats_ptr, blk_id)) {
+                    /* TODO: debating whether to check if placement exists for molecule
+                     * (more robust) or individual atom blocks (faster) */
+                    return;
+                }
+            }
+        }
+        candidate_feasible[icand] = true;
+        candidate_gains[icand] = get_molecule_gain(molecule, gain);
+    };
+
+#if defined(VPR_USE_TBB)
+    if (candidates.size() >= AAPACK_MIN_PARALLEL_CANDIDATES) {
+        tbb::parallel_for(size_t(0), candidates.size(), evaluate_candidate);
+        return;
+    }
+#endif
+    for (size_t icand = 0; icand < candidates.size(); icand++) {
+        evaluate_candidate(icand);
+    }
+}
+
 /*****************************************/
 static void alloc_and_init_clustering(const t_molecule_stats& max_molecule_stats,
                                       t_cluster_placement_stats** cluster_placement_stats,
@@ -1167,6 +1229,7 @@ static void alloc_and_load_pb_stats(t_pb* pb, const int feasible_block_array_siz
     pb->pb_stats->lookahead_output_pins_used = std::vector<std::vector<AtomNetId>>(pb->pb_graph_node->num_output_pin_class);
     pb->pb_stats->num_feasible_blocks = NOT_VALID;
     pb->pb_stats->feasible_blocks = (t_pack_molecule**)vtr::calloc(feasible_block_array_size, sizeof(t_pack_molecule*));
+    pb->pb_stats->feasible_block_gains = (float*)vtr::calloc(feasible_block_array_size, sizeof(float));
 
     pb->pb_stats->tie_break_high_fanout_net = AtomNetId::INVALID();
 
@@ -2224,33 +2287,30 @@ void add_cluster_molecule_candidates_by_connectivity_and_timing(t_pb* cur_pb,
 
     auto& atom_ctx = g_vpr_ctx.atom();
 
+    std::vector<t_pack_molecule*> candidates;
     for (AtomBlockId blk_id : cur_pb->pb_stats->marked_blocks) {
         if (atom_ctx.lookup.atom_clb(blk_id) == ClusterBlockId::INVALID()) {
             auto rng = atom_molecules.equal_range(blk_id);
             for (const auto& kv : vtr::make_range(rng.first, rng.second)) {
                 t_pack_molecule* molecule = kv.second;
                 if (molecule->valid) {
-                    bool success = true;
-                    for (int j = 0; j < get_array_size_of_molecule(molecule); j++) {
-                        if (molecule->atom_block_ids[j]) {
-                            VTR_ASSERT(atom_ctx.lookup.atom_clb(molecule->atom_block_ids[j]) == ClusterBlockId::INVALID());
-                            auto blk_id2 = molecule->atom_block_ids[j];
-                            if (!exists_free_primitive_for_atom_block(cluster_placement_stats_ptr, blk_id2)) {
-                                /* TODO: debating whether to check if placement exists for molecule
-                                 * (more robust) or individual atom blocks (faster) */
-                                success = false;
-                                break;
-                            }
-                        }
-                    }
-                    if (success) {
-                        add_molecule_to_pb_stats_candidates(molecule,
-                                                            cur_pb->pb_stats->gain, cur_pb, feasible_block_array_size);
-                    }
+                    candidates.push_back(molecule);
                 }
             }
         }
     }
+
+    std::vector<char> candidate_feasible;
+    std::vector<float> candidate_gains;
+    evaluate_candidate_molecules(candidates, cluster_placement_stats_ptr, cur_pb->pb_stats->gain,
+                                 candidate_feasible, candidate_gains);
+
+    for (size_t icand = 0; icand < candidates.size(); icand++) {
+        if (candidate_feasible[icand]) {
+            add_molecule_to_pb_stats_candidates(candidates[icand], candidate_gains[icand],
+                                                cur_pb, feasible_block_array_size);
+        }
+    }
 }
 
 void add_cluster_molecule_candidates_by_highfanout_connectivity(t_pb* cur_pb,
@@ -2293,8 +2353,8 @@ void add_cluster_molecule_candidates_by_highfanout_connectivity(t_pb* cur_pb,
                         }
                     }
                     if (success) {
-                        add_molecule_to_pb_stats_candidates(molecule,
-                                                            cur_pb->pb_stats->gain, cur_pb, std::min(feasible_block_array_size, AAPACK_MAX_HIGH_FANOUT_EXPLORE));
+                        add_molecule_to_pb_stats_candidates(molecule, get_molecule_gain(molecule, cur_pb->pb_stats->gain),
+                                                            cur_pb, std::min(feasible_block_array_size, AAPACK_MAX_HIGH_FANOUT_EXPLORE));
                         count++;
                     }
                 }
@@ -2313,8 +2373,6 @@ void add_cluster_molecule_candidates_by_transitive_connectivity(t_pb* cur_pb,
                                                                 const int feasible_block_array_size) {
     //TODO: For now, only done by fan-out; should also consider fan-in
 
-    auto& atom_ctx = g_vpr_ctx.atom();
-
     cur_pb->pb_stats->explore_transitive_fanout = false;
 
     /* First time finding transitive fanout candidates therefore alloc and load them */
@@ -2324,26 +2382,23 @@ void add_cluster_molecule_candidates_by_transitive_connectivity(t_pb* cur_pb,
                                       clb_inter_blk_nets,
                                       transitive_fanout_threshold);
     /* Only consider candidates that pass a very simple legality check */
+    std::vector<t_pack_molecule*> candidates;
     for (const auto& transitive_candidate : cur_pb->pb_stats->transitive_fanout_candidates) {
         t_pack_molecule* molecule = transitive_candidate.second;
         if (molecule->valid) {
-            bool success = true;
-            for (int j = 0; j < get_array_size_of_molecule(molecule); j++) {
-                if (molecule->atom_block_ids[j]) {
-                    VTR_ASSERT(atom_ctx.lookup.atom_clb(molecule->atom_block_ids[j]) == ClusterBlockId::INVALID());
-                    auto blk_id = molecule->atom_block_ids[j];
-                    if (!exists_free_primitive_for_atom_block(cluster_placement_stats_ptr, blk_id)) {
-                        /* TODO: debating whether to check if placement exists for molecule (more
-                         * robust) or individual atom blocks (faster) */
-                        success = false;
-                        break;
-                    }
-                }
-            }
-            if (success) {
-                add_molecule_to_pb_stats_candidates(molecule,
-                                                    cur_pb->pb_stats->gain, cur_pb, std::min(feasible_block_array_size, AAPACK_MAX_TRANSITIVE_EXPLORE));
-            }
+            candidates.push_back(molecule);
+        }
+    }
+
+    std::vector<char> candidate_feasible;
+    std::vector<float> candidate_gains;
+    evaluate_candidate_molecules(candidates, cluster_placement_stats_ptr, cur_pb->pb_stats->gain,
+                                 candidate_feasible, candidate_gains);
+
+    for (size_t icand = 0; icand < candidates.size(); icand++) {
+        if (candidate_feasible[icand]) {
+            add_molecule_to_pb_stats_candidates(candidates[icand], candidate_gains[icand],
+                                                cur_pb, std::min(feasible_block_array_size, AAPACK_MAX_TRANSITIVE_EXPLORE));
         }
     }
 }
@@ -2804,7 +2859,7 @@ static t_pack_molecule* get_highest_gain_seed_molecule(int* seedindex, const std
  * + molecule_base_gain*some_factor
  * - introduced_input_nets_of_unrelated_blocks_pulled_in_by_molecule*some_other_factor
  */
-static float get_molecule_gain(t_pack_molecule* molecule, std::map<AtomBlockId, float>& blk_gain) {
+static float get_molecule_gain(const t_pack_molecule* molecule, const std::map<AtomBlockId, float>& blk_gain) {
     float gain;
     int i;
     int num_introduced_inputs_of_indirectly_related_block;
@@ -2815,8 +2870,9 @@ static float get_molecule_gain(t_pack_molecule* molecule, std::map<AtomBlockId,
     for (i = 0; i < get_array_size_of_molecule(molecule); i++) {
         auto blk_id = molecule->atom_block_ids[i];
         if (blk_id) {
-            if (blk_gain.count(blk_id) > 0) {
-                gain += blk_gain[blk_id];
+            auto blk_gain_it = blk_gain.find(blk_id);
+            if (blk_gain_it != blk_gain.end()) {
+                gain += blk_gain_it->second;
             } else {
                 /* This block has no connection with current cluster, penalize molecule for having this block
                  */
@@ -710,6 +710,39 @@ bool exists_free_primitive_for_atom_block(t_cluster_placement_stats* cluster_pla
     return false;
 }
 
+/* Same as exists_free_primitive_for_atom_block(), but the invalid primitives are
+ * skipped instead of being removed from the lists of available primitives,
+ * so that the cluster placement stats can be read by multiple threads at once
+ */
+bool exists_free_primitive_for_atom_block_no_cleanup(const t_cluster_placement_stats* cluster_placement_stats,
+                                                     const AtomBlockId blk_id) {
+    /* might have a primitive in flight that's still valid */
+    if (cluster_placement_stats->in_flight) {
+        if (primitive_type_feasible(blk_id,
+                                    cluster_placement_stats->in_flight->pb_graph_node->pb_type)) {
+            return true;
+        }
+    }
+
+    /* Look through list of available primitives to see if any valid */
+    for (int i = 0; i < cluster_placement_stats->num_pb_types; i++) {
+        if (cluster_placement_stats->valid_primitives[i]->next_primitive == nullptr) {
+            continue; /* no more primitives of this type available */
+        }
+        if (primitive_type_feasible(blk_id,
+                                    cluster_placement_stats->valid_primitives[i]->next_primitive->pb_graph_node->pb_type)) {
+            for (const t_cluster_placement_primitive* cur = cluster_placement_stats->valid_primitives[i]->next_primitive;
+                 cur != nullptr; cur = cur->next_primitive) {
+                if (cur->valid) {
+                    return true;
+                }
+            }
+        }
+    }
+
+    return false;
+}
+
 void reset_tried_but_unused_cluster_placements(t_cluster_placement_stats* cluster_placement_stats) {
     flush_intermediate_queues(cluster_placement_stats);
 }
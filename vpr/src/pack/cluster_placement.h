@@ -25,6 +25,9 @@ int get_array_size_of_molecule(const t_pack_molecule* molecule);
 bool exists_free_primitive_for_atom_block(
     t_cluster_placement_stats* cluster_placement_stats,
     const AtomBlockId blk_id);
+bool exists_free_primitive_for_atom_block_no_cleanup(
+    const t_cluster_placement_stats* cluster_placement_stats,
+    const AtomBlockId blk_id);
 
 void reset_tried_but_unused_cluster_placements(
     t_cluster_placement_stats* cluster_placement_stats);
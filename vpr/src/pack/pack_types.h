@@ -71,7 +71,8 @@ struct t_pb_stats {
      * Sorted in ascending gain order so that the last cluster_ctx.blocks is the most desirable (this makes it easy to pop blocks off the list
      */
     t_pack_molecule** feasible_blocks;
-    int num_feasible_blocks; /* [0..num_marked_models-1] */
+    float* feasible_block_gains; /* Gains of the feasible blocks, which do not change until the array is rebuilt */
+    int num_feasible_blocks;     /* [0..num_marked_models-1] */
 };
 
 /**************************************************************************
@@ -37,12 +37,15 @@
 /* variable global to this section that indexes each pb graph pin within a cluster */
 static vtr::t_linked_vptr* edges_head;
 static vtr::t_linked_vptr* num_edges_head;
+/* Pools of the pin pointers of the edges, one pool is allocated for all the edges of an interconnect */
+static vtr::t_linked_vptr* edge_pins_head;
 
 /* TODO: Software engineering decision needed: Move this file to libarch?
  *
  */
 
 static int check_pb_graph();
+static t_pb_graph_pin** alloc_edge_pin_pool(const int num_pins);
 static void alloc_and_load_pb_graph(t_pb_graph_node* pb_graph_node,
                                     t_pb_graph_node* parent_pb_graph_node,
                                     t_pb_type* pb_type,
@@ -121,6 +124,7 @@ void alloc_and_load_all_pb_graphs(bool load_power_structures) {
     int errors;
     edges_head = nullptr;
     num_edges_head = nullptr;
+    edge_pins_head = nullptr;
     auto& device_ctx = g_vpr_ctx.mutable_device();
 
     for (auto& type : device_ctx.logical_block_types) {
@@ -345,8 +349,6 @@ void free_pb_graph_edges() {
         cur_num = num_edges_head;
         edges = (t_pb_graph_edge*)cur->data_vptr;
         for (int i = 0; i < (intptr_t)cur_num->data_vptr; i++) {
-            vtr::free(edges[i].input_pins);
-            vtr::free(edges[i].output_pins);
             if (edges[i].pack_pattern_indices) {
                 vtr::free(edges[i].pack_pattern_indices);
             }
@@ -360,6 +362,27 @@ void free_pb_graph_edges() {
         vtr::free(cur_num);
         vtr::free(cur);
     }
+
+    while (edge_pins_head != nullptr) {
+        cur = edge_pins_head;
+        edge_pins_head = edge_pins_head->next;
+        vtr::free(cur->data_vptr);
+        vtr::free(cur);
+    }
+}
+
+/**
+ * Allocate a pool of pin pointers shared by the edges of an interconnect,
+ * instead of a pair of tiny arrays per edge, which dominate the memory
+ * footprint and the allocation time of large crossbars
+ */
+static t_pb_graph_pin** alloc_edge_pin_pool(const int num_pins) {
+    t_pb_graph_pin** pins = (t_pb_graph_pin**)vtr::calloc(num_pins, sizeof(t_pb_graph_pin*));
+    vtr::t_linked_vptr* cur = (vtr::t_linked_vptr*)vtr::malloc(sizeof(vtr::t_linked_vptr));
+    cur->next = edge_pins_head;
+    edge_pins_head = cur;
+    cur->data_vptr = (void*)pins;
+    return pins;
 }
 
 static void alloc_and_load_interconnect_pins(t_interconnect_pins* interc_pins,
@@ -697,6 +720,7 @@ static void alloc_and_load_complete_interc_edges(t_interconnect* interconnect,
     int i_inset, i_outset, i_inpin, i_outpin;
     int in_count, out_count;
     t_pb_graph_edge* edges;
+    t_pb_graph_pin** edge_pins;
     int i_edge;
     vtr::t_linked_vptr* cur;
 
@@ -721,6 +745,8 @@ static void alloc_and_load_complete_interc_edges(t_interconnect* interconnect,
     cur->next = num_edges_head;
     num_edges_head = cur;
     cur->data_vptr = (void*)((intptr_t)in_count * out_count);
+    /* Each edge connects a single input pin to a single output pin */
+    edge_pins = alloc_edge_pin_pool(2 * in_count * out_count);
 
     for (i_inset = 0; i_inset < num_input_sets; i_inset++) {
         for (i_inpin = 0; i_inpin < num_input_ptrs[i_inset]; i_inpin++) {
@@ -755,10 +781,10 @@ static void alloc_and_load_complete_interc_edges(t_interconnect* interconnect,
                     output_pb_graph_node_pin_ptrs[i_outset][i_outpin]->num_input_edges++;
 
                     edges[i_edge].num_input_pins = 1;
-                    edges[i_edge].input_pins = (t_pb_graph_pin**)vtr::malloc(sizeof(t_pb_graph_pin*));
+                    edges[i_edge].input_pins = &edge_pins[2 * i_edge];
                     edges[i_edge].input_pins[0] = input_pb_graph_node_pin_ptrs[i_inset][i_inpin];
                     edges[i_edge].num_output_pins = 1;
-                    edges[i_edge].output_pins = (t_pb_graph_pin**)vtr::malloc(sizeof(t_pb_graph_pin*));
+                    edges[i_edge].output_pins = &edge_pins[2 * i_edge + 1];
                     edges[i_edge].output_pins[0] = output_pb_graph_node_pin_ptrs[i_outset][i_outpin];
 
                     edges[i_edge].interconnect = interconnect;
@@ -807,6 +833,8 @@ static void alloc_and_load_direct_interc_edges(t_interconnect* interconnect,
     cur->next = num_edges_head;
     num_edges_head = cur;
     cur->data_vptr = (void*)((intptr_t)num_input_ptrs[0]);
+    /* Each edge connects a single input pin to a single output pin */
+    t_pb_graph_pin** edge_pins = alloc_edge_pin_pool(2 * pins_per_set * num_output_sets);
 
     /* Reallocate memory for pins and load connections between pins and record these updates in the edges */
     for (int ipin = 0; ipin < pins_per_set; ++ipin) {
@@ -846,10 +874,10 @@ static void alloc_and_load_direct_interc_edges(t_interconnect* interconnect,
             int iedge = iset * pins_per_set + ipin;
 
             edges[iedge].num_input_pins = 1;
-            edges[iedge].input_pins = (t_pb_graph_pin**)vtr::malloc(sizeof(t_pb_graph_pin*));
+            edges[iedge].input_pins = &edge_pins[2 * iedge];
             edges[iedge].input_pins[0] = input_pb_graph_node_pin_ptrs[0][ipin];
             edges[iedge].num_output_pins = 1;
-            edges[iedge].output_pins = (t_pb_graph_pin**)vtr::malloc(sizeof(t_pb_graph_pin*));
+            edges[iedge].output_pins = &edge_pins[2 * iedge + 1];
             edges[iedge].output_pins[0] = output_pb_graph_node_pin_ptrs[iset][ipin];
 
             edges[iedge].interconnect = interconnect;
@@ -869,6 +897,7 @@ static void alloc_and_load_mux_interc_edges(t_interconnect* interconnect,
                                             const int* num_output_ptrs) {
     int i_inset, i_inpin, i_outpin;
     t_pb_graph_edge* edges;
+    t_pb_graph_pin** edge_pins;
     vtr::t_linked_vptr* cur;
 
     VTR_ASSERT(interconnect->infer_annotations == false);
@@ -888,6 +917,8 @@ static void alloc_and_load_mux_interc_edges(t_interconnect* interconnect,
     cur->next = num_edges_head;
     num_edges_head = cur;
     cur->data_vptr = (void*)((intptr_t)num_input_sets);
+    /* Each edge connects a data line of the mux to the output, pin by pin */
+    edge_pins = alloc_edge_pin_pool(2 * num_input_sets * num_output_ptrs[0]);
 
     for (i_inset = 0; i_inset < num_input_sets; i_inset++) {
         for (i_inpin = 0; i_inpin < num_input_ptrs[i_inset]; i_inpin++) {
@@ -913,8 +944,8 @@ static void alloc_and_load_mux_interc_edges(t_interconnect* interconnect,
             vpr_throw(VPR_ERROR_ARCH, get_arch_file_name(), interconnect->line_num,
                       "# of pins for a particular data line of a mux must equal number of pins at output of mux\n");
         }
-        edges[i_inset].input_pins = (t_pb_graph_pin**)vtr::calloc(num_output_ptrs[0], sizeof(t_pb_graph_pin*));
-        edges[i_inset].output_pins = (t_pb_graph_pin**)vtr::calloc(num_output_ptrs[0], sizeof(t_pb_graph_pin*));
+        edges[i_inset].input_pins = &edge_pins[2 * i_inset * num_output_ptrs[0]];
+        edges[i_inset].output_pins = &edge_pins[(2 * i_inset + 1) * num_output_ptrs[0]];
         edges[i_inset].num_input_pins = num_output_ptrs[0];
         edges[i_inset].num_output_pins = num_output_ptrs[0];
         for (i_inpin = 0; i_inpin < num_input_ptrs[i_inset]; i_inpin++) {
@@ -9,6 +9,8 @@
 #include "vtr_random.h"
 #include "vtr_geometry.h"
 
+#include "openfpga_parallel.h"
+
 #include "vpr_types.h"
 #include "vpr_error.h"
 #include "vpr_utils.h"
@@ -135,6 +137,15 @@ static vtr::vector<ClusterNetId, double*> temp_point_to_point_timing_cost;
 static vtr::vector<ClusterNetId, float*> point_to_point_delay;
 static vtr::vector<ClusterNetId, float*> temp_point_to_point_delay;
 
+/* The net sink pins whose point to point delays have changed since the last */
+/* timing update, with a flag per pin [0..cluster_ctx.clb_nlist.pins().size()-1] */
+/* to record each pin once. Only used by the incremental timing analysis.    */
+static std::vector<ClusterPinId> pins_with_modified_delay;
+static vtr::vector<ClusterPinId, char> pin_delay_modified;
+
+/* Number of incremental timing updates since the last full timing update */
+static int num_incr_timing_updates = 0;
+
 /* [0..cluster_ctx.clb_nlist.blocks().size()-1][0..pins_per_clb-1]. Indicates which pin on the net */
 /* this block corresponds to, this is only required during timing-driven */
 /* placement. It is used to allow us to update individual connections on */
@@ -163,6 +174,28 @@ static float** chany_place_cost_fac; //[0...device_ctx.grid.height()-2]
 static vtr::vector<ClusterNetId, t_bb> ts_bb_coord_new, ts_bb_edge_new;
 static std::vector<ClusterNetId> ts_nets_to_update;
 
+/* A move of a batch evaluated by try_swap_batch(), with the nets it affects *
+ * and the changes of costs it causes                                        */
+struct t_batch_move {
+    t_batch_move()
+        : blocks_affected(2) {}
+
+    t_pl_blocks_to_be_moved blocks_affected;
+    e_create_move create_move_outcome = e_create_move::ABORT;
+    std::vector<ClusterNetId> nets_to_update;
+    double bb_delta_c = 0.;
+    double timing_delta_c = 0.;
+};
+
+/* The following variables are used by try_swap_batch() to find the moves   *
+ * which can be evaluated concurrently. A move joins a batch only if the     *
+ * locations and the (non-ignored) nets it touches are not touched by the    *
+ * earlier moves of the batch.                                               */
+static std::vector<t_batch_move> ts_batch_moves;
+static std::unordered_set<t_pl_loc> ts_batch_locs;
+static vtr::vector<ClusterNetId, char> ts_net_in_batch;
+static std::vector<ClusterNetId> ts_batch_nets;
+
 /* These file-scoped variables keep track of the number of swaps       *
  * rejected, accepted or aborted. The total number of swap attempts    *
  * is the sum of the three number.                                     */
@@ -280,8 +313,8 @@ static void free_fast_cost_update();
 
 static double comp_bb_cost(e_cost_methods method);
 
-static void update_move_nets(int num_nets_affected);
-static void reset_move_nets(int num_nets_affected);
+static void update_move_nets(const std::vector<ClusterNetId>& nets_to_update);
+static void reset_move_nets(const std::vector<ClusterNetId>& nets_to_update);
 
 static e_move_result try_swap(float t,
                               t_placer_costs* costs,
@@ -294,6 +327,44 @@ static e_move_result try_swap(float t,
                               enum e_place_algorithm place_algorithm,
                               float timing_tradeoff);
 
+static size_t try_swap_batch(float t,
+                             t_placer_costs* costs,
+                             t_placer_prev_inverse_costs* prev_inverse_costs,
+                             float rlim,
+                             MoveGenerator& move_generator,
+                             const PlaceDelayModel* delay_model,
+                             const t_placer_opts& placer_opts,
+                             size_t max_num_moves,
+                             t_placer_statistics* stats);
+
+static e_create_move propose_swap(float rlim,
+                                  float rlim_escape_fraction,
+                                  MoveGenerator& move_generator,
+                                  t_pl_blocks_to_be_moved& blocks_affected);
+
+static void evaluate_swap(enum e_place_algorithm place_algorithm,
+                          const t_pl_blocks_to_be_moved& blocks_affected,
+                          const PlaceDelayModel* delay_model,
+                          std::vector<ClusterNetId>& nets_to_update,
+                          double& bb_delta_c,
+                          double& timing_delta_c);
+
+static e_move_result finalize_swap(float t,
+                                   t_placer_costs* costs,
+                                   t_placer_prev_inverse_costs* prev_inverse_costs,
+                                   MoveGenerator& move_generator,
+                                   t_pl_blocks_to_be_moved& blocks_affected,
+                                   e_create_move create_move_outcome,
+                                   const std::vector<ClusterNetId>& nets_to_update,
+                                   double bb_delta_c,
+                                   double timing_delta_c,
+                                   enum e_place_algorithm place_algorithm,
+                                   float timing_tradeoff);
+
+static bool reserve_batch_move(const t_pl_blocks_to_be_moved& blocks_affected);
+
+static void record_swap_result(e_move_result swap_result, const t_placer_costs& costs, t_placer_statistics* stats);
+
 static void check_place(const t_placer_costs& costs,
                         const PlaceDelayModel* delay_model,
                         enum e_place_algorithm place_algorithm);
@@ -333,6 +404,12 @@ static void comp_td_point_to_point_delays(const PlaceDelayModel* delay_model);
 
 static void update_td_cost(const t_pl_blocks_to_be_moved& blocks_affected);
 
+static void record_modified_delay(const ClusterPinId pin);
+
+static void update_timing_info(const t_placer_opts& placer_opts,
+                               const ClusteredPinAtomPinsLookup& netlist_pin_lookup,
+                               SetupTimingInfo& timing_info);
+
 static bool driven_by_moved_block(const ClusterNetId net, const t_pl_blocks_to_be_moved& blocks_affected);
 
 static void comp_td_costs(const PlaceDelayModel* delay_model, double* timing_cost);
@@ -346,10 +423,11 @@ static void update_bb(ClusterNetId net_id, t_bb* bb_coord_new, t_bb* bb_edge_new
 static int find_affected_nets_and_update_costs(e_place_algorithm place_algorithm,
                                                const t_pl_blocks_to_be_moved& blocks_affected,
                                                const PlaceDelayModel* delay_model,
+                                               std::vector<ClusterNetId>& nets_to_update,
                                                double& bb_delta_c,
                                                double& timing_delta_c);
 
-static void record_affected_net(const ClusterNetId net, int& num_affected_nets);
+static void record_affected_net(const ClusterNetId net, std::vector<ClusterNetId>& nets_to_update);
 
 static void update_net_bb(const ClusterNetId net,
                           const t_pl_blocks_to_be_moved& blocks_affected,
@@ -518,9 +596,10 @@ void try_place(const t_placer_opts& placer_opts,
         placement_delay_calc = std::make_shared<PlacementDelayCalculator>(atom_ctx.nlist, atom_ctx.lookup, point_to_point_delay);
         placement_delay_calc->set_tsu_margin_relative(placer_opts.tsu_rel_margin);
         placement_delay_calc->set_tsu_margin_absolute(placer_opts.tsu_abs_margin);
-        timing_info = make_setup_timing_info(placement_delay_calc);
+        timing_info = make_setup_timing_info(placement_delay_calc,
+                                             placer_opts.incremental_sta ? e_timing_update_type::INCREMENTAL : e_timing_update_type::FULL);
 
-        timing_info->update();
+        timing_info->update(); //Always a full analysis
         timing_info->set_warn_unconstrained(false); //Don't warn again about unconstrained nodes again during placement
 
         //Initial slack estimates
@@ -760,7 +839,8 @@ void try_place(const t_placer_opts& placer_opts,
         //Final timing estimate
         VTR_ASSERT(timing_info);
 
-        timing_info->update(); //Tatum
+        timing_info->invalidate_all_delays(); //Always a full analysis
+        timing_info->update();                //Tatum
         critical_path = timing_info->least_slack_critical_path();
 
         if (isEchoFileEnabled(E_ECHO_FINAL_PLACEMENT_TIMING_GRAPH)) {
@@ -847,7 +927,7 @@ static void outer_loop_recompute_criticalities(const t_placer_opts& placer_opts,
         VTR_ASSERT(num_connections > 0);
 
         //Per-temperature timing update
-        timing_info.update();
+        update_timing_info(placer_opts, netlist_pin_lookup, timing_info);
         load_criticalities(timing_info, crit_exponent, netlist_pin_lookup);
 
         /*recompute costs from scratch, based on new criticalities */
@@ -890,35 +970,36 @@ static void placement_inner_loop(float t,
     inner_crit_iter_count = 1;
 
     /* Inner loop begins */
-    for (inner_iter = 0; inner_iter < move_lim; inner_iter++) {
-        e_move_result swap_result = try_swap(t, costs, prev_inverse_costs, rlim,
-                                             move_generator,
-                                             blocks_affected,
-                                             delay_model,
-                                             placer_opts.rlim_escape_fraction,
-                                             placer_opts.place_algorithm,
-                                             placer_opts.timing_tradeoff);
-
-        if (swap_result == ACCEPTED) {
-            /* Move was accepted.  Update statistics that are useful for the annealing schedule. */
-            stats->success_sum++;
-            stats->av_cost += costs->cost;
-            stats->av_bb_cost += costs->bb_cost;
-            stats->av_timing_cost += costs->timing_cost;
-            stats->sum_of_squares += (costs->cost) * (costs->cost);
-            num_swap_accepted++;
-        } else if (swap_result == ABORTED) {
-            num_swap_aborted++;
-        } else { // swap_result == REJECTED
-            num_swap_rejected++;
+    for (inner_iter = 0; inner_iter < move_lim;) {
+        /* A batch of moves is evaluated as a whole, so that the timing and cost
+         * recomputations below only happen between batches */
+        int num_moves = 1;
+        if (placer_opts.move_batch_size > 1) {
+            num_moves = try_swap_batch(t, costs, prev_inverse_costs, rlim,
+                                       move_generator,
+                                       delay_model,
+                                       placer_opts,
+                                       std::min(placer_opts.move_batch_size, move_lim - inner_iter),
+                                       stats);
+        } else {
+            e_move_result swap_result = try_swap(t, costs, prev_inverse_costs, rlim,
+                                                 move_generator,
+                                                 blocks_affected,
+                                                 delay_model,
+                                                 placer_opts.rlim_escape_fraction,
+                                                 placer_opts.place_algorithm,
+                                                 placer_opts.timing_tradeoff);
+
+            record_swap_result(swap_result, *costs, stats);
         }
+        inner_iter += num_moves;
 
         if (placer_opts.place_algorithm == PATH_TIMING_DRIVEN_PLACE) {
             /* Do we want to re-timing analyze the circuit to get updated slack and criticality values?
              * We do this only once in a while, since it is expensive.
              */
             if (inner_crit_iter_count >= inner_recompute_limit
-                && inner_iter != move_lim - 1) { /*on last iteration don't recompute */
+                && inner_iter != move_lim) { /*on last iteration don't recompute */
 
                 inner_crit_iter_count = 0;
 #ifdef VERBOSE
@@ -928,12 +1009,12 @@ static void placement_inner_loop(float t,
                  * criticalities; then update the timing cost since it will change.
                  */
                 //Inner loop timing update
-                timing_info.update();
+                update_timing_info(placer_opts, netlist_pin_lookup, timing_info);
                 load_criticalities(timing_info, crit_exponent, netlist_pin_lookup);
 
                 comp_td_costs(delay_model, &costs->timing_cost);
             }
-            inner_crit_iter_count++;
+            inner_crit_iter_count += num_moves;
         }
 #ifdef VERBOSE
         VTR_LOG("t = %g  cost = %g   bb_cost = %g timing_cost = %g move = %d\n",
@@ -948,7 +1029,7 @@ static void placement_inner_loop(float t,
          * This round-off can lead to  error checks failing because the cost
          * is different from what you get when you recompute from scratch.
          */
-        ++(*moves_since_cost_recompute);
+        *moves_since_cost_recompute += num_moves;
         if (*moves_since_cost_recompute > MAX_MOVES_BEFORE_RECOMPUTE) {
             recompute_costs_from_scratch(placer_opts, delay_model, costs);
             *moves_since_cost_recompute = 0;
@@ -957,6 +1038,23 @@ static void placement_inner_loop(float t,
     /* Inner loop ends */
 }
 
+/* Update the statistics useful for the annealing schedule with the result of a move */
+static void record_swap_result(e_move_result swap_result, const t_placer_costs& costs, t_placer_statistics* stats) {
+    if (swap_result == ACCEPTED) {
+        /* Move was accepted.  Update statistics that are useful for the annealing schedule. */
+        stats->success_sum++;
+        stats->av_cost += costs.cost;
+        stats->av_bb_cost += costs.bb_cost;
+        stats->av_timing_cost += costs.timing_cost;
+        stats->sum_of_squares += (costs.cost) * (costs.cost);
+        num_swap_accepted++;
+    } else if (swap_result == ABORTED) {
+        num_swap_aborted++;
+    } else { // swap_result == REJECTED
+        num_swap_rejected++;
+    }
+}
+
 static void recompute_costs_from_scratch(const t_placer_opts& placer_opts, const PlaceDelayModel* delay_model, t_placer_costs* costs) {
     double new_bb_cost = recompute_bb_cost();
     if (fabs(new_bb_cost - costs->bb_cost) > costs->bb_cost * ERROR_TOL) {
@@ -1143,11 +1241,10 @@ static float starting_t(t_placer_costs* costs,
     return (20. * std_dev);
 }
 
-static void update_move_nets(int num_nets_affected) {
+static void update_move_nets(const std::vector<ClusterNetId>& nets_to_update) {
     /* update net cost functions and reset flags. */
     auto& cluster_ctx = g_vpr_ctx.clustering();
-    for (int inet_affected = 0; inet_affected < num_nets_affected; inet_affected++) {
-        ClusterNetId net_id = ts_nets_to_update[inet_affected];
+    for (ClusterNetId net_id : nets_to_update) {
 
         bb_coords[net_id] = ts_bb_coord_new[net_id];
         if (cluster_ctx.clb_nlist.net_sinks(net_id).size() >= SMALL_NET)
@@ -1161,10 +1258,9 @@ static void update_move_nets(int num_nets_affected) {
     }
 }
 
-static void reset_move_nets(int num_nets_affected) {
+static void reset_move_nets(const std::vector<ClusterNetId>& nets_to_update) {
     /* Reset the net cost function flags first. */
-    for (int inet_affected = 0; inet_affected < num_nets_affected; inet_affected++) {
-        ClusterNetId net_id = ts_nets_to_update[inet_affected];
+    for (ClusterNetId net_id : nets_to_update) {
         temp_net_cost[net_id] = -1;
         bb_updated_before[net_id] = NOT_UPDATED_YET;
     }
@@ -1186,25 +1282,217 @@ static e_move_result try_swap(float t,
      * Returns whether the swap is accepted, rejected or aborted.        *
      * Passes back the new value of the cost functions.                  */
 
-    num_ts_called++;
+    double bb_delta_c = 0;
+    double timing_delta_c = 0;
 
-    MoveOutcomeStats move_outcome_stats;
+    e_create_move create_move_outcome = propose_swap(rlim, rlim_escape_fraction, move_generator, blocks_affected);
 
-    /* I'm using negative values of temp_net_cost as a flag, so DO NOT   *
-     * use cost functions that can go negative.                          */
+    if (create_move_outcome == e_create_move::VALID) {
+        evaluate_swap(place_algorithm, blocks_affected, delay_model, ts_nets_to_update, bb_delta_c, timing_delta_c);
+    }
 
-    double delta_c = 0; /* Change in cost due to this swap. */
-    double bb_delta_c = 0;
-    double timing_delta_c = 0;
+    return finalize_swap(t, costs, prev_inverse_costs,
+                         move_generator,
+                         blocks_affected,
+                         create_move_outcome,
+                         ts_nets_to_update,
+                         bb_delta_c,
+                         timing_delta_c,
+                         place_algorithm,
+                         timing_tradeoff);
+}
+
+/* Proposes up to max_num_moves moves against the current placement and    *
+ * evaluates them concurrently, as long as each move touches locations     *
+ * and nets that the earlier moves of the batch do not touch. Since the    *
+ * moves are independent, the change of cost of each move is the same as   *
+ * if it was evaluated alone. The moves are then accepted or rejected one  *
+ * by one in the order they are proposed, so that the placement only       *
+ * depends on the seed and the batch size but not on the number of         *
+ * threads.                                                                *
+ * Returns the number of moves attempted, which is at least one.           */
+static size_t try_swap_batch(float t,
+                             t_placer_costs* costs,
+                             t_placer_prev_inverse_costs* prev_inverse_costs,
+                             float rlim,
+                             MoveGenerator& move_generator,
+                             const PlaceDelayModel* delay_model,
+                             const t_placer_opts& placer_opts,
+                             size_t max_num_moves,
+                             t_placer_statistics* stats) {
+    VTR_ASSERT(0 < max_num_moves);
+    if (ts_batch_moves.size() < max_num_moves) {
+        ts_batch_moves.resize(max_num_moves);
+    }
+
+    //Propose the moves until one of them conflicts with the earlier ones.
+    //The conflicting move is dropped and not counted as an attempt.
+    size_t num_moves = 0;
+    while (num_moves < max_num_moves) {
+        t_batch_move& move = ts_batch_moves[num_moves];
+        move.create_move_outcome = propose_swap(rlim, placer_opts.rlim_escape_fraction, move_generator, move.blocks_affected);
+        if (move.create_move_outcome == e_create_move::VALID
+            && !reserve_batch_move(move.blocks_affected)) {
+            clear_move_blocks(move.blocks_affected);
+            break;
+        }
+        ++num_moves;
+    }
+    VTR_ASSERT(0 < num_moves);
+
+    //Evaluate the moves, which only write the data of their own blocks and nets
+    openfpga::parallel_for(num_moves, openfpga::find_num_threads(placer_opts.num_threads),
+                           [&](const size_t& imove) {
+                               t_batch_move& move = ts_batch_moves[imove];
+                               move.nets_to_update.clear();
+                               move.bb_delta_c = 0.;
+                               move.timing_delta_c = 0.;
+                               if (move.create_move_outcome == e_create_move::VALID) {
+                                   evaluate_swap(placer_opts.place_algorithm, move.blocks_affected, delay_model,
+                                                 move.nets_to_update, move.bb_delta_c, move.timing_delta_c);
+                               }
+                           });
+
+    //Accept or reject the moves in order
+    for (size_t imove = 0; imove < num_moves; ++imove) {
+        t_batch_move& move = ts_batch_moves[imove];
+        e_move_result swap_result = finalize_swap(t, costs, prev_inverse_costs,
+                                                  move_generator,
+                                                  move.blocks_affected,
+                                                  move.create_move_outcome,
+                                                  move.nets_to_update,
+                                                  move.bb_delta_c,
+                                                  move.timing_delta_c,
+                                                  placer_opts.place_algorithm,
+                                                  placer_opts.timing_tradeoff);
+
+        record_swap_result(swap_result, *costs, stats);
+    }
+
+    //Release the locations and nets for the next batch
+    ts_batch_locs.clear();
+    for (ClusterNetId net_id : ts_batch_nets) {
+        ts_net_in_batch[net_id] = false;
+    }
+    ts_batch_nets.clear();
+
+    return num_moves;
+}
+
+//Reserves the locations and the nets touched by a move for the current batch.
+//
+//Returns false without reserving anything if any of them is already reserved
+//by an earlier move of the batch.
+static bool reserve_batch_move(const t_pl_blocks_to_be_moved& blocks_affected) {
+    auto& cluster_ctx = g_vpr_ctx.clustering();
+
+    //The locations cover all the moved blocks, since each block has a location
+    for (const t_pl_loc& loc : blocks_affected.moved_from) {
+        if (ts_batch_locs.count(loc)) {
+            return false;
+        }
+    }
+    for (const t_pl_loc& loc : blocks_affected.moved_to) {
+        if (ts_batch_locs.count(loc)) {
+            return false;
+        }
+    }
+
+    //The nets of the moved blocks must not be touched by any other move,
+    //so that their bounding boxes and delays are only computed from
+    //the blocks of this move and the blocks which are not moved
+    for (int iblk = 0; iblk < blocks_affected.num_moved_blocks; iblk++) {
+        ClusterBlockId blk = blocks_affected.moved_blocks[iblk].block_num;
+        for (ClusterPinId blk_pin : cluster_ctx.clb_nlist.block_pins(blk)) {
+            ClusterNetId net_id = cluster_ctx.clb_nlist.pin_net(blk_pin);
+            if (cluster_ctx.clb_nlist.net_is_ignored(net_id))
+                continue;
 
+            if (ts_net_in_batch[net_id]) {
+                return false;
+            }
+        }
+    }
+
+    ts_batch_locs.insert(blocks_affected.moved_from.begin(), blocks_affected.moved_from.end());
+    ts_batch_locs.insert(blocks_affected.moved_to.begin(), blocks_affected.moved_to.end());
+    for (int iblk = 0; iblk < blocks_affected.num_moved_blocks; iblk++) {
+        ClusterBlockId blk = blocks_affected.moved_blocks[iblk].block_num;
+        for (ClusterPinId blk_pin : cluster_ctx.clb_nlist.block_pins(blk)) {
+            ClusterNetId net_id = cluster_ctx.clb_nlist.pin_net(blk_pin);
+            if (cluster_ctx.clb_nlist.net_is_ignored(net_id) || ts_net_in_batch[net_id])
+                continue;
+
+            ts_net_in_batch[net_id] = true;
+            ts_batch_nets.push_back(net_id);
+        }
+    }
+
+    return true;
+}
+
+//Generates a new move (perturbation) used to explore the space of possible placements
+static e_create_move propose_swap(float rlim,
+                                  float rlim_escape_fraction,
+                                  MoveGenerator& move_generator,
+                                  t_pl_blocks_to_be_moved& blocks_affected) {
     //Allow some fraction of moves to not be restricted by rlim,
     //in the hopes of better escaping local minima
     if (rlim_escape_fraction > 0. && vtr::frand() < rlim_escape_fraction) {
         rlim = std::numeric_limits<float>::infinity();
     }
 
-    //Generate a new move (perturbation) used to explore the space of possible placements
-    e_create_move create_move_outcome = move_generator.propose_move(blocks_affected, rlim);
+    return move_generator.propose_move(blocks_affected, rlim);
+}
+
+//Applies a valid move and computes the change in cost it causes
+static void evaluate_swap(enum e_place_algorithm place_algorithm,
+                          const t_pl_blocks_to_be_moved& blocks_affected,
+                          const PlaceDelayModel* delay_model,
+                          std::vector<ClusterNetId>& nets_to_update,
+                          double& bb_delta_c,
+                          double& timing_delta_c) {
+    /*
+     * To make evaluating the move simpler (e.g. calculating changed bounding box),
+     * we first move the blocks to thier new locations (apply the move to
+     * place_ctx.block_locs) and then computed the change in cost. If the move is
+     * accepted, the inverse look-up in place_ctx.grid_blocks is updated (committing
+     * the move). If the move is rejected the blocks are returned to their original
+     * positions (reverting place_ctx.block_locs to its original state).
+     *
+     * Note that the inverse look-up place_ctx.grid_blocks is only updated
+     * after move acceptance is determined, and so should not be used when
+     * evaluating a move.
+     */
+
+    //Update the block positions
+    apply_move_blocks(blocks_affected);
+
+    // Find all the nets affected by this swap and update their costs
+    find_affected_nets_and_update_costs(place_algorithm, blocks_affected, delay_model, nets_to_update, bb_delta_c, timing_delta_c);
+}
+
+//Accepts or rejects a move evaluated by evaluate_swap(), and reports
+//the outcome to the move generator
+static e_move_result finalize_swap(float t,
+                                   t_placer_costs* costs,
+                                   t_placer_prev_inverse_costs* prev_inverse_costs,
+                                   MoveGenerator& move_generator,
+                                   t_pl_blocks_to_be_moved& blocks_affected,
+                                   e_create_move create_move_outcome,
+                                   const std::vector<ClusterNetId>& nets_to_update,
+                                   double bb_delta_c,
+                                   double timing_delta_c,
+                                   enum e_place_algorithm place_algorithm,
+                                   float timing_tradeoff) {
+    num_ts_called++;
+
+    MoveOutcomeStats move_outcome_stats;
+
+    /* I'm using negative values of temp_net_cost as a flag, so DO NOT   *
+     * use cost functions that can go negative.                          */
+
+    double delta_c = 0; /* Change in cost due to this swap. */
 
     LOG_MOVE_STATS_PROPOSED(t, blocks_affected);
 
@@ -1223,24 +1511,6 @@ static e_move_result try_swap(float t,
     } else {
         VTR_ASSERT(create_move_outcome == e_create_move::VALID);
 
-        /*
-         * To make evaluating the move simpler (e.g. calculating changed bounding box),
-         * we first move the blocks to thier new locations (apply the move to
-         * place_ctx.block_locs) and then computed the change in cost. If the move is
-         * accepted, the inverse look-up in place_ctx.grid_blocks is updated (committing
-         * the move). If the move is rejected the blocks are returned to their original
-         * positions (reverting place_ctx.block_locs to its original state).
-         *
-         * Note that the inverse look-up place_ctx.grid_blocks is only updated
-         * after move acceptance is determined, and so should not be used when
-         * evaluating a move.
-         */
-
-        //Update the block positions
-        apply_move_blocks(blocks_affected);
-
-        // Find all the nets affected by this swap and update their costs
-        int num_nets_affected = find_affected_nets_and_update_costs(place_algorithm, blocks_affected, delay_model, bb_delta_c, timing_delta_c);
         if (place_algorithm == PATH_TIMING_DRIVEN_PLACE) {
             /*in this case we redefine delta_c as a combination of timing and bb.  *
              *additionally, we normalize all values, therefore delta_c is in       *
@@ -1268,14 +1538,14 @@ static e_move_result try_swap(float t,
             }
 
             /* update net cost functions and reset flags. */
-            update_move_nets(num_nets_affected);
+            update_move_nets(nets_to_update);
 
             /* Update clb data structures since we kept the move. */
             commit_move_blocks(blocks_affected);
 
         } else { /* Move was rejected.  */
                  /* Reset the net cost function flags first. */
-            reset_move_nets(num_nets_affected);
+            reset_move_nets(nets_to_update);
 
             /* Restore the place_ctx.block_locs data structures to their state before the move. */
             revert_move_blocks(blocks_affected);
@@ -1314,13 +1584,14 @@ static e_move_result try_swap(float t,
 static int find_affected_nets_and_update_costs(e_place_algorithm place_algorithm,
                                                const t_pl_blocks_to_be_moved& blocks_affected,
                                                const PlaceDelayModel* delay_model,
+                                               std::vector<ClusterNetId>& nets_to_update,
                                                double& bb_delta_c,
                                                double& timing_delta_c) {
     VTR_ASSERT_SAFE(bb_delta_c == 0.);
     VTR_ASSERT_SAFE(timing_delta_c == 0.);
     auto& cluster_ctx = g_vpr_ctx.clustering();
 
-    int num_affected_nets = 0;
+    nets_to_update.clear();
 
     //Go through all the blocks moved
     for (int iblk = 0; iblk < blocks_affected.num_moved_blocks; iblk++) {
@@ -1335,7 +1606,7 @@ static int find_affected_nets_and_update_costs(e_place_algorithm place_algorithm
                 continue; //TODO: do we require anyting special here for global nets. "Global nets are assumed to span the whole chip, and do not effect costs"
 
             //Record effected nets
-            record_affected_net(net_id, num_affected_nets);
+            record_affected_net(net_id, nets_to_update);
 
             //Update the net bounding boxes
             //
@@ -1353,22 +1624,19 @@ static int find_affected_nets_and_update_costs(e_place_algorithm place_algorithm
     /* Now update the bounding box costs (since the net bounding boxes are up-to-date).
      * The cost is only updated once per net.
      */
-    for (int inet_affected = 0; inet_affected < num_affected_nets; inet_affected++) {
-        ClusterNetId net_id = ts_nets_to_update[inet_affected];
-
+    for (ClusterNetId net_id : nets_to_update) {
         temp_net_cost[net_id] = get_net_cost(net_id, &ts_bb_coord_new[net_id]);
         bb_delta_c += temp_net_cost[net_id] - net_cost[net_id];
     }
 
-    return num_affected_nets;
+    return nets_to_update.size();
 }
 
-static void record_affected_net(const ClusterNetId net, int& num_affected_nets) {
+static void record_affected_net(const ClusterNetId net, std::vector<ClusterNetId>& nets_to_update) {
     //Record effected nets
     if (temp_net_cost[net] < 0.) {
         //Net not marked yet.
-        ts_nets_to_update[num_affected_nets] = net;
-        num_affected_nets++;
+        nets_to_update.push_back(net);
 
         //Flag to say we've marked this net.
         temp_net_cost[net] = 1.;
@@ -1564,6 +1832,7 @@ static void update_td_cost(const t_pl_blocks_to_be_moved& blocks_affected) {
                     temp_point_to_point_delay[net_id][ipin] = INVALID_DELAY;
                     point_to_point_timing_cost[net_id][ipin] = temp_point_to_point_timing_cost[net_id][ipin];
                     temp_point_to_point_timing_cost[net_id][ipin] = INVALID_DELAY;
+                    record_modified_delay(cluster_ctx.clb_nlist.net_pin(net_id, ipin));
                 }
             } else {
                 //This pin is a net sink on a moved block
@@ -1577,12 +1846,67 @@ static void update_td_cost(const t_pl_blocks_to_be_moved& blocks_affected) {
                     temp_point_to_point_delay[net_id][net_pin] = INVALID_DELAY;
                     point_to_point_timing_cost[net_id][net_pin] = temp_point_to_point_timing_cost[net_id][net_pin];
                     temp_point_to_point_timing_cost[net_id][net_pin] = INVALID_DELAY;
+                    record_modified_delay(pin_id);
                 }
             }
         } /* Finished going through all the pins in the moved block */
     }     /* Finished going through all the blocks moved */
 }
 
+/* Record that the delay of the connection ending at a net sink pin has changed, *
+ * so that the next incremental timing update re-analyzes it.                    */
+static void record_modified_delay(const ClusterPinId pin) {
+    if (pin_delay_modified.empty()) {
+        return; /* Incremental timing analysis is not used */
+    }
+    if (!pin_delay_modified[pin]) {
+        pin_delay_modified[pin] = true;
+        pins_with_modified_delay.push_back(pin);
+    }
+}
+
+/* Updates the timing information from the point to point delays.               *
+ * With the incremental timing analysis, only the timing graph edges of the     *
+ * connections whose delays changed since the last update are invalidated, and  *
+ * every incremental_sta_full_update_period updates all of them are invalidated, *
+ * so that the timing graph is periodically re-analyzed from scratch.           */
+static void update_timing_info(const t_placer_opts& placer_opts,
+                               const ClusteredPinAtomPinsLookup& netlist_pin_lookup,
+                               SetupTimingInfo& timing_info) {
+    if (placer_opts.incremental_sta) {
+        if (num_incr_timing_updates + 1 >= placer_opts.incremental_sta_full_update_period) {
+            timing_info.invalidate_all_delays();
+            num_incr_timing_updates = 0;
+        } else {
+            auto& atom_ctx = g_vpr_ctx.atom();
+            const tatum::TimingGraph& timing_graph = *timing_info.timing_graph();
+
+            for (ClusterPinId clb_pin : pins_with_modified_delay) {
+                /* The delays of the inter-cluster connections to the atom pins behind the clb pin */
+                for (AtomPinId atom_pin : netlist_pin_lookup.connected_atom_pins(clb_pin)) {
+                    tatum::NodeId tnode = atom_ctx.lookup.atom_pin_tnode(atom_pin);
+                    if (!tnode) {
+                        continue;
+                    }
+                    for (tatum::EdgeId edge : timing_graph.node_in_edges(tnode)) {
+                        if (timing_graph.edge_type(edge) == tatum::EdgeType::INTERCONNECT) {
+                            timing_info.invalidate_delay(edge);
+                        }
+                    }
+                }
+            }
+            ++num_incr_timing_updates;
+        }
+
+        for (ClusterPinId clb_pin : pins_with_modified_delay) {
+            pin_delay_modified[clb_pin] = false;
+        }
+        pins_with_modified_delay.clear();
+    }
+
+    timing_info.update();
+}
+
 static bool driven_by_moved_block(const ClusterNetId net, const t_pl_blocks_to_be_moved& blocks_affected) {
     auto& cluster_ctx = g_vpr_ctx.clustering();
 
@@ -1694,6 +2018,9 @@ static void free_placement_structs(const t_placer_opts& placer_opts) {
         temp_point_to_point_timing_cost.clear();
         temp_point_to_point_delay.clear();
 
+        pins_with_modified_delay.clear();
+        pin_delay_modified.clear();
+
         net_pin_indices.clear();
     }
 
@@ -1757,6 +2084,11 @@ static void alloc_and_load_placement_structs(float place_cost_exp,
                 temp_point_to_point_delay[net_id][ipin] = 0;
             }
         }
+
+        if (placer_opts.incremental_sta) {
+            pin_delay_modified.resize(cluster_ctx.clb_nlist.pins().size(), false);
+            num_incr_timing_updates = 0;
+        }
     }
 
     net_cost.resize(num_nets, -1.);
@@ -1821,7 +2153,8 @@ static void alloc_and_load_try_swap_structs() {
 
     ts_bb_coord_new.resize(num_nets, t_bb());
     ts_bb_edge_new.resize(num_nets, t_bb());
-    ts_nets_to_update.resize(num_nets, ClusterNetId::INVALID());
+    ts_nets_to_update.reserve(num_nets);
+    ts_net_in_batch.resize(num_nets, false);
 
     auto& place_ctx = g_vpr_ctx.mutable_placement();
     place_ctx.compressed_block_grids = create_compressed_block_grids();
@@ -2491,6 +2824,11 @@ static void print_clb_placement(const char* fname) {
 
 static void free_try_swap_arrays() {
     g_vpr_ctx.mutable_placement().compressed_block_grids.clear();
+
+    ts_batch_moves.clear();
+    ts_batch_locs.clear();
+    ts_net_in_batch.clear();
+    ts_batch_nets.clear();
 }
 
 static void calc_placer_stats(t_placer_statistics& stats, float& success_rat, double& std_dev, const t_placer_costs& costs, const int move_lim) {
@@ -81,6 +81,32 @@ static float route_connection_delay(
 
 static void generic_compute_matrix(
     const RouterDelayProfiler& route_profiler,
+    vtr::Matrix<std::vector<float>>& matrix,
+    int source_x,
+    int source_y,
+    int start_x,
+    int start_y,
+    int end_x,
+    int end_y,
+    const t_placer_opts& placer_opts,
+    const t_router_opts& router_opts,
+    bool measure_directconnect,
+    const std::set<std::string>& allowed_types);
+
+static void generic_compute_matrix_route(
+    const RouterDelayProfiler& route_profiler,
+    vtr::Matrix<std::vector<float>>& matrix,
+    int source_x,
+    int source_y,
+    int start_x,
+    int start_y,
+    int end_x,
+    int end_y,
+    const t_router_opts& router_opts,
+    bool measure_directconnect,
+    const std::set<std::string>& allowed_types);
+
+static void generic_compute_matrix_dijkstra(
     vtr::Matrix<std::vector<float>>& matrix,
     int source_x,
     int source_y,
@@ -349,6 +375,37 @@ static float route_connection_delay(
 }
 
 static void generic_compute_matrix(
+    const RouterDelayProfiler& route_profiler,
+    vtr::Matrix<std::vector<float>>& matrix,
+    int source_x,
+    int source_y,
+    int start_x,
+    int start_y,
+    int end_x,
+    int end_y,
+    const t_placer_opts& placer_opts,
+    const t_router_opts& router_opts,
+    bool measure_directconnect,
+    const std::set<std::string>& allowed_types) {
+    if (placer_opts.place_delta_delay_matrix_calculation_method == e_place_delta_delay_algorithm::DIJKSTRA_EXPANSION) {
+        generic_compute_matrix_dijkstra(matrix,
+                                        source_x, source_y,
+                                        start_x, start_y,
+                                        end_x, end_y,
+                                        router_opts,
+                                        measure_directconnect, allowed_types);
+    } else {
+        VTR_ASSERT(placer_opts.place_delta_delay_matrix_calculation_method == e_place_delta_delay_algorithm::ASTAR_ROUTE);
+        generic_compute_matrix_route(route_profiler, matrix,
+                                     source_x, source_y,
+                                     start_x, start_y,
+                                     end_x, end_y,
+                                     router_opts,
+                                     measure_directconnect, allowed_types);
+    }
+}
+
+static void generic_compute_matrix_route(
     const RouterDelayProfiler& route_profiler,
     vtr::Matrix<std::vector<float>>& matrix,
     int source_x,
@@ -414,6 +471,129 @@ static void generic_compute_matrix(
     }
 }
 
+//Profiles the same connections as generic_compute_matrix_route(), with the same preference between the
+//driver and sink classes, but all the sinks are reached by a single expansion from each source rr node
+//instead of routing the connections one by one
+static void generic_compute_matrix_dijkstra(
+    vtr::Matrix<std::vector<float>>& matrix,
+    int source_x,
+    int source_y,
+    int start_x,
+    int start_y,
+    int end_x,
+    int end_y,
+    const t_router_opts& router_opts,
+    bool measure_directconnect,
+    const std::set<std::string>& allowed_types) {
+    auto& device_ctx = g_vpr_ctx.device();
+
+    t_physical_tile_type_ptr src_type = device_ctx.grid[source_x][source_y].type;
+    bool is_allowed_type = allowed_types.empty() || allowed_types.find(src_type->name) != allowed_types.end();
+    bool src_valid = (src_type != device_ctx.EMPTY_PHYSICAL_TILE_TYPE && is_allowed_type);
+
+    //Delays of the valid sink locations, in the order of the sweep, NaN until a path is found
+    auto is_sink_valid = [&](int sink_x, int sink_y) {
+        return src_valid && device_ctx.grid[sink_x][sink_y].type != device_ctx.EMPTY_PHYSICAL_TILE_TYPE;
+    };
+    std::vector<vtr::Point<int>> sink_locs;
+    for (int sink_x = start_x; sink_x <= end_x; sink_x++) {
+        for (int sink_y = start_y; sink_y <= end_y; sink_y++) {
+            if (is_sink_valid(sink_x, sink_y)) {
+                sink_locs.emplace_back(sink_x, sink_y);
+            }
+        }
+    }
+    std::vector<float> sink_loc_delays(sink_locs.size(), std::numeric_limits<float>::quiet_NaN());
+    size_t num_unreached_locs = sink_locs.size();
+
+    if (0 < num_unreached_locs) {
+        int src_width_offset = device_ctx.grid[source_x][source_y].width_offset;
+        int src_height_offset = device_ctx.grid[source_x][source_y].height_offset;
+
+        for (int driver_ptc : get_best_classes(DRIVER, src_type)) {
+            if (0 == num_unreached_locs) break;
+
+            VTR_ASSERT(driver_ptc != OPEN);
+
+            RRNodeId source_rr_node = device_ctx.rr_graph.find_node(source_x - src_width_offset, source_y - src_height_offset, SOURCE, driver_ptc);
+
+            VTR_ASSERT(source_rr_node != RRNodeId::INVALID());
+
+            //Candidate sink rr nodes of the unreached locations, in the order they are tried
+            std::vector<RRNodeId> sink_rr_nodes;
+            std::vector<size_t> sink_rr_node_locs;
+            for (size_t iloc = 0; iloc < sink_locs.size(); ++iloc) {
+                if (!std::isnan(sink_loc_delays[iloc])) continue;
+
+                int sink_x = sink_locs[iloc].x();
+                int sink_y = sink_locs[iloc].y();
+                int sink_width_offset = device_ctx.grid[sink_x][sink_y].width_offset;
+                int sink_height_offset = device_ctx.grid[sink_x][sink_y].height_offset;
+
+                for (int sink_ptc : get_best_classes(RECEIVER, device_ctx.grid[sink_x][sink_y].type)) {
+                    VTR_ASSERT(sink_ptc != OPEN);
+
+                    RRNodeId sink_rr_node = device_ctx.rr_graph.find_node(sink_x - sink_width_offset, sink_y - sink_height_offset, SINK, sink_ptc);
+
+                    VTR_ASSERT(sink_rr_node != RRNodeId::INVALID());
+
+                    if (!measure_directconnect && directconnect_exists(source_rr_node, sink_rr_node)) {
+                        //Skip if we shouldn't measure direct connects and a direct connect exists
+                        continue;
+                    }
+
+                    sink_rr_nodes.push_back(sink_rr_node);
+                    sink_rr_node_locs.push_back(iloc);
+                }
+            }
+
+            std::vector<float> delays = calculate_path_delays_from_rr_node(source_rr_node, sink_rr_nodes, router_opts);
+
+            //The first reachable sink of a location is used, as when routing the connections one by one
+            for (size_t isink = 0; isink < sink_rr_nodes.size(); ++isink) {
+                size_t iloc = sink_rr_node_locs[isink];
+                if (std::isnan(sink_loc_delays[iloc]) && !std::isnan(delays[isink])) {
+                    sink_loc_delays[iloc] = delays[isink];
+                    --num_unreached_locs;
+                }
+            }
+        }
+    }
+
+    //Record the delays as generic_compute_matrix_route() does
+    size_t iloc = 0;
+    for (int sink_x = start_x; sink_x <= end_x; sink_x++) {
+        for (int sink_y = start_y; sink_y <= end_y; sink_y++) {
+            int delta_x = abs(sink_x - source_x);
+            int delta_y = abs(sink_y - source_y);
+
+            if (!is_sink_valid(sink_x, sink_y)) {
+                if (matrix[delta_x][delta_y].empty()) {
+                    //Only set empty target if we don't already have a valid delta delay
+                    matrix[delta_x][delta_y].push_back(EMPTY_DELTA);
+                }
+                continue;
+            }
+
+            float delay = sink_loc_delays[iloc++];
+            if (std::isnan(delay)) {
+                delay = IMPOSSIBLE_DELTA;
+                VTR_LOG_WARN("Unable to route between blocks at (%d,%d) and (%d,%d) to characterize delay (setting to %g)\n",
+                             source_x, source_y, sink_x, sink_y, delay);
+            }
+
+            if (matrix[delta_x][delta_y].size() == 1 && matrix[delta_x][delta_y][0] == EMPTY_DELTA) {
+                //Overwrite empty delta
+                matrix[delta_x][delta_y][0] = delay;
+            } else {
+                //Collect delta
+                matrix[delta_x][delta_y].push_back(delay);
+            }
+        }
+    }
+    VTR_ASSERT(iloc == sink_locs.size());
+}
+
 static vtr::Matrix<float> compute_delta_delays(
     const RouterDelayProfiler& route_profiler,
     const t_placer_opts& placer_opts,
@@ -500,7 +680,7 @@ static vtr::Matrix<float> compute_delta_delays(
                            x, y,
                            x, y,
                            grid.width() - 1, grid.height() - 1,
-                           router_opts,
+                           placer_opts, router_opts,
                            measure_directconnect, allowed_types);
 
     //Find the lowest x location on the bottom edge with a non-empty block
@@ -529,7 +709,7 @@ static vtr::Matrix<float> compute_delta_delays(
                            x, y,
                            x, y,
                            grid.width() - 1, grid.height() - 1,
-                           router_opts,
+                           placer_opts, router_opts,
                            measure_directconnect, allowed_types);
 
     //Since the other delta delay values may have suffered from edge effects,
@@ -541,7 +721,7 @@ static vtr::Matrix<float> compute_delta_delays(
                            low_x, low_y,
                            low_x, low_y,
                            grid.width() - 1, grid.height() - 1,
-                           router_opts,
+                           placer_opts, router_opts,
                            measure_directconnect, allowed_types);
 
     //Since the other delta delay values may have suffered from edge effects,
@@ -553,7 +733,7 @@ static vtr::Matrix<float> compute_delta_delays(
                            high_x, high_y,
                            0, 0,
                            high_x, high_y,
-                           router_opts,
+                           placer_opts, router_opts,
                            measure_directconnect, allowed_types);
 
     //Since the other delta delay values may have suffered from edge effects,
@@ -565,7 +745,7 @@ static vtr::Matrix<float> compute_delta_delays(
                            high_x, low_y,
                            0, low_y,
                            high_x, grid.height() - 1,
-                           router_opts,
+                           placer_opts, router_opts,
                            measure_directconnect, allowed_types);
 
     //Since the other delta delay values may have suffered from edge effects,
@@ -577,7 +757,7 @@ static vtr::Matrix<float> compute_delta_delays(
                            low_x, high_y,
                            low_x, 0,
                            grid.width() - 1, high_y,
-                           router_opts,
+                           placer_opts, router_opts,
                            measure_directconnect, allowed_types);
 
     vtr::Matrix<float> delta_delays({grid.width(), grid.height()});
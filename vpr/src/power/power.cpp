@@ -47,10 +47,19 @@
 #include "rr_graph.h"
 #include "vpr_utils.h"
 
+#if defined(VPR_USE_TBB)
+#    include <tbb/parallel_for.h>
+#endif
+
 /************************* DEFINES **********************************/
 #define CONVERT_NM_PER_M 1000000000
 #define CONVERT_UM_PER_M 1000000
 
+/* Number of routing resources whose power is accumulated together.
+ * Chunks are fixed regardless of the number of threads, and their sums are
+ * merged in order, so that the result does not depend on the thread count */
+#define POWER_ROUTING_CHUNK_SIZE 4096
+
 /************************* ENUMS ************************************/
 typedef enum {
     POWER_BREAKDOWN_ENTRY_TYPE_TITLE = 0,
@@ -61,6 +70,17 @@ typedef enum {
     POWER_BREAKDOWN_ENTRY_TYPE_BUFS_WIRES
 } e_power_breakdown_entry_type;
 
+/* Power of a set of routing resources, accumulated apart from the
+ * global component tracker so that several sets can be evaluated at once */
+struct t_power_routing_usage {
+    t_power_usage total;
+    t_power_usage components[POWER_COMPONENT_MAX_NUM];
+    int num_sb_buffers;
+    float total_sb_buffer_size;
+    int num_cb_buffers;
+    float total_cb_buffer_size;
+};
+
 /************************* File Scope **********************************/
 static vtr::vector<RRNodeId, t_rr_node_power> rr_node_power;
 
@@ -69,6 +89,14 @@ static vtr::vector<RRNodeId, t_rr_node_power> rr_node_power;
 static void power_usage_routing(t_power_usage* power_usage,
                                 const t_det_routing_arch* routing_arch,
                                 const std::vector<t_segment_inf>& segment_inf);
+static void power_zero_routing_usage(t_power_routing_usage* routing_usage);
+static void power_routing_add_usage(t_power_routing_usage* routing_usage,
+                                    const t_power_usage* power_usage,
+                                    e_power_component_type component_idx);
+static void power_usage_rr_node(t_power_routing_usage* routing_usage,
+                                const RRNodeId& rr_node_idx,
+                                const t_det_routing_arch* routing_arch,
+                                const std::vector<t_segment_inf>& segment_inf);
 
 /* Tiles */
 static void power_usage_blocks(t_power_usage* power_usage);
@@ -855,174 +883,253 @@ static void power_usage_routing(t_power_usage* power_usage,
         }
     }
 
-    /* Calculate power of all routing entities */
-    for (const RRNodeId& rr_node_idx : device_ctx.rr_graph.nodes()) {
-        t_power_usage sub_power_usage;
-        const RRGraph& rr_graph = device_ctx.rr_graph;
-        t_rr_node_power* node_power = &rr_node_power[rr_node_idx];
-        float C_wire;
-        float buffer_size;
-        int connectionbox_fanout;
-        int switchbox_fanout;
-        //float C_per_seg_split;
-        int wire_length;
-
+    /* The multiplexer architectures are built on demand and shared by all the
+     * routing resources. Build them for the largest fan-in before evaluating the
+     * routing resources, which only look them up afterwards */
+    const RRGraph& rr_graph = device_ctx.rr_graph;
+    std::vector<RRNodeId> rr_nodes;
+    size_t max_mux_size = 0;
+    for (const RRNodeId& rr_node_idx : rr_graph.nodes()) {
+        rr_nodes.push_back(rr_node_idx);
         switch (rr_graph.node_type(rr_node_idx)) {
-            case SOURCE:
-            case SINK:
-            case OPIN:
-                /* No power usage for these types */
-                break;
             case IPIN:
-                /* This is part of the connectionbox.  The connection box is comprised of:
-                 *  - Driver (accounted for at end of CHANX/Y - see below)
-                 *  - Multiplexor */
-
-                if (rr_graph.node_in_edges(rr_node_idx).size()) {
-                    VTR_ASSERT(node_power->in_dens);
-                    VTR_ASSERT(node_power->in_prob);
-
-                    /* Multiplexor */
-                    power_usage_mux_multilevel(&sub_power_usage,
-                                               power_get_mux_arch(rr_graph.node_in_edges(rr_node_idx).size(),
-                                                                  power_ctx.arch->mux_transistor_size),
-                                               node_power->in_prob, node_power->in_dens,
-                                               node_power->selected_input, true,
-                                               power_ctx.solution_inf.T_crit);
-                    power_add_usage(power_usage, &sub_power_usage);
-                    power_component_add_usage(&sub_power_usage,
-                                              POWER_COMPONENT_ROUTE_CB);
-                }
-                break;
             case CHANX:
             case CHANY:
-                /* This is a wire driven by a switchbox, which includes:
-                 * 	- The Multiplexor at the beginning of the wire
-                 * 	- A buffer, after the mux to drive the wire
-                 * 	- The wire itself
-                 * 	- A buffer at the end of the wire, going to switchbox/connectionbox */
+                max_mux_size = std::max(max_mux_size, rr_graph.node_in_edges(rr_node_idx).size());
+                break;
+            default:
+                break;
+        }
+    }
+    if (max_mux_size > 0) {
+        power_get_mux_arch(max_mux_size, power_ctx.arch->mux_transistor_size);
+    }
+
+    /* Calculate power of all routing entities, by chunks of routing resources */
+    size_t num_chunks = (rr_nodes.size() + POWER_ROUTING_CHUNK_SIZE - 1) / POWER_ROUTING_CHUNK_SIZE;
+    std::vector<t_power_routing_usage> chunk_usages(num_chunks);
+
+    auto power_usage_rr_node_chunk = [&](size_t ichunk) {
+        t_power_routing_usage* chunk_usage = &chunk_usages[ichunk];
+        power_zero_routing_usage(chunk_usage);
+        size_t inode_end = std::min(rr_nodes.size(), (ichunk + 1) * POWER_ROUTING_CHUNK_SIZE);
+        for (size_t inode = ichunk * POWER_ROUTING_CHUNK_SIZE; inode < inode_end; ++inode) {
+            power_usage_rr_node(chunk_usage, rr_nodes[inode], routing_arch, segment_inf);
+        }
+    };
+
+#if defined(VPR_USE_TBB)
+    tbb::parallel_for(size_t(0), num_chunks, power_usage_rr_node_chunk);
+#else
+    for (size_t ichunk = 0; ichunk < num_chunks; ++ichunk) {
+        power_usage_rr_node_chunk(ichunk);
+    }
+#endif
+
+    /* Merge the chunks in order */
+    for (t_power_routing_usage& chunk_usage : chunk_usages) {
+        power_add_usage(power_usage, &chunk_usage.total);
+        for (e_power_component_type component_idx : {POWER_COMPONENT_ROUTE_SB,
+                                                      POWER_COMPONENT_ROUTE_CB,
+                                                      POWER_COMPONENT_ROUTE_GLB_WIRE}) {
+            power_component_add_usage(&chunk_usage.components[component_idx], component_idx);
+        }
+        power_ctx.commonly_used->num_sb_buffers += chunk_usage.num_sb_buffers;
+        power_ctx.commonly_used->total_sb_buffer_size += chunk_usage.total_sb_buffer_size;
+        power_ctx.commonly_used->num_cb_buffers += chunk_usage.num_cb_buffers;
+        power_ctx.commonly_used->total_cb_buffer_size += chunk_usage.total_cb_buffer_size;
+    }
+}
+
+static void power_zero_routing_usage(t_power_routing_usage* routing_usage) {
+    power_zero_usage(&routing_usage->total);
+    for (int component_idx = 0; component_idx < POWER_COMPONENT_MAX_NUM; component_idx++) {
+        power_zero_usage(&routing_usage->components[component_idx]);
+    }
+    routing_usage->num_sb_buffers = 0;
+    routing_usage->total_sb_buffer_size = 0.;
+    routing_usage->num_cb_buffers = 0;
+    routing_usage->total_cb_buffer_size = 0.;
+}
+
+static void power_routing_add_usage(t_power_routing_usage* routing_usage,
+                                    const t_power_usage* power_usage,
+                                    e_power_component_type component_idx) {
+    power_add_usage(&routing_usage->total, power_usage);
+    power_add_usage(&routing_usage->components[component_idx], power_usage);
+}
+
+/**
+ * Calculates the power of a single routing resource.
+ * This only reads the shared power data, so that routing resources can be
+ * evaluated concurrently, and accumulates into routing_usage
+ */
+static void power_usage_rr_node(t_power_routing_usage* routing_usage,
+                                const RRNodeId& rr_node_idx,
+                                const t_det_routing_arch* routing_arch,
+                                const std::vector<t_segment_inf>& segment_inf) {
+    auto& power_ctx = g_vpr_ctx.power();
+    auto& device_ctx = g_vpr_ctx.device();
+    const RRGraph& rr_graph = device_ctx.rr_graph;
+
+    t_power_usage sub_power_usage;
+    t_rr_node_power* node_power = &rr_node_power[rr_node_idx];
+    float C_wire;
+    float buffer_size;
+    int connectionbox_fanout;
+    int switchbox_fanout;
+    //float C_per_seg_split;
+    int wire_length;
+
+    switch (rr_graph.node_type(rr_node_idx)) {
+        case SOURCE:
+        case SINK:
+        case OPIN:
+            /* No power usage for these types */
+            break;
+        case IPIN:
+            /* This is part of the connectionbox.  The connection box is comprised of:
+             *  - Driver (accounted for at end of CHANX/Y - see below)
+             *  - Multiplexor */
+
+            if (rr_graph.node_in_edges(rr_node_idx).size()) {
                 VTR_ASSERT(node_power->in_dens);
                 VTR_ASSERT(node_power->in_prob);
 
-                wire_length = 0;
-                if (rr_graph.node_type(rr_node_idx) == CHANX) {
-                    wire_length = rr_graph.node_xhigh(rr_node_idx) - rr_graph.node_xlow(rr_node_idx) + 1;
-                } else if (rr_graph.node_type(rr_node_idx) == CHANY) {
-                    wire_length = rr_graph.node_yhigh(rr_node_idx) - rr_graph.node_ylow(rr_node_idx) + 1;
-                }
-                C_wire = wire_length
-                         * segment_inf[device_ctx.rr_indexed_data[rr_graph.node_cost_index(rr_node_idx)].seg_index].Cmetal;
-                //(double)power_ctx.commonly_used->tile_length);
-                VTR_ASSERT(node_power->selected_input < rr_graph.node_in_edges(rr_node_idx).size());
-
                 /* Multiplexor */
                 power_usage_mux_multilevel(&sub_power_usage,
                                            power_get_mux_arch(rr_graph.node_in_edges(rr_node_idx).size(),
                                                               power_ctx.arch->mux_transistor_size),
                                            node_power->in_prob, node_power->in_dens,
-                                           node_power->selected_input, true, power_ctx.solution_inf.T_crit);
-                power_add_usage(power_usage, &sub_power_usage);
-                power_component_add_usage(&sub_power_usage,
-                                          POWER_COMPONENT_ROUTE_SB);
-
-                /* Buffer Size */
-                switch (device_ctx.rr_switch_inf[node_power->driver_switch_type].power_buffer_type) {
-                    case POWER_BUFFER_TYPE_AUTO:
-                        /*
-                         * C_per_seg_split = ((float) node->num_edges
-                         * power_ctx.commonly_used->INV_1X_C_in + C_wire);
-                         * // / (float) power_ctx.arch->seg_buffer_split;
-                         * buffer_size = power_buffer_size_from_logical_effort(
-                         * C_per_seg_split);
-                         * buffer_size = std::max(buffer_size, 1.0F);
-                         */
-                        buffer_size = power_calc_buffer_size_from_Cout(device_ctx.rr_switch_inf[node_power->driver_switch_type].Cout);
-                        break;
-                    case POWER_BUFFER_TYPE_ABSOLUTE_SIZE:
-                        buffer_size = device_ctx.rr_switch_inf[node_power->driver_switch_type].power_buffer_size;
-                        buffer_size = std::max(buffer_size, 1.0F);
-                        break;
-                    case POWER_BUFFER_TYPE_NONE:
-                        buffer_size = 0.;
-                        break;
-                    default:
-                        buffer_size = 0.;
-                        VTR_ASSERT(0);
-                        break;
-                }
-
-                power_ctx.commonly_used->num_sb_buffers++;
-                power_ctx.commonly_used->total_sb_buffer_size += buffer_size;
+                                           node_power->selected_input, true,
+                                           power_ctx.solution_inf.T_crit);
+                power_routing_add_usage(routing_usage, &sub_power_usage,
+                                        POWER_COMPONENT_ROUTE_CB);
+            }
+            break;
+        case CHANX:
+        case CHANY:
+            /* This is a wire driven by a switchbox, which includes:
+             * 	- The Multiplexor at the beginning of the wire
+             * 	- A buffer, after the mux to drive the wire
+             * 	- The wire itself
+             * 	- A buffer at the end of the wire, going to switchbox/connectionbox */
+            VTR_ASSERT(node_power->in_dens);
+            VTR_ASSERT(node_power->in_prob);
+
+            wire_length = 0;
+            if (rr_graph.node_type(rr_node_idx) == CHANX) {
+                wire_length = rr_graph.node_xhigh(rr_node_idx) - rr_graph.node_xlow(rr_node_idx) + 1;
+            } else if (rr_graph.node_type(rr_node_idx) == CHANY) {
+                wire_length = rr_graph.node_yhigh(rr_node_idx) - rr_graph.node_ylow(rr_node_idx) + 1;
+            }
+            C_wire = wire_length
+                     * segment_inf[device_ctx.rr_indexed_data[rr_graph.node_cost_index(rr_node_idx)].seg_index].Cmetal;
+            //(double)power_ctx.commonly_used->tile_length);
+            VTR_ASSERT(node_power->selected_input < rr_graph.node_in_edges(rr_node_idx).size());
+
+            /* Multiplexor */
+            power_usage_mux_multilevel(&sub_power_usage,
+                                       power_get_mux_arch(rr_graph.node_in_edges(rr_node_idx).size(),
+                                                          power_ctx.arch->mux_transistor_size),
+                                       node_power->in_prob, node_power->in_dens,
+                                       node_power->selected_input, true, power_ctx.solution_inf.T_crit);
+            power_routing_add_usage(routing_usage, &sub_power_usage,
+                                    POWER_COMPONENT_ROUTE_SB);
+
+            /* Buffer Size */
+            switch (device_ctx.rr_switch_inf[node_power->driver_switch_type].power_buffer_type) {
+                case POWER_BUFFER_TYPE_AUTO:
+                    /*
+                     * C_per_seg_split = ((float) node->num_edges
+                     * power_ctx.commonly_used->INV_1X_C_in + C_wire);
+                     * // / (float) power_ctx.arch->seg_buffer_split;
+                     * buffer_size = power_buffer_size_from_logical_effort(
+                     * C_per_seg_split);
+                     * buffer_size = std::max(buffer_size, 1.0F);
+                     */
+                    buffer_size = power_calc_buffer_size_from_Cout(device_ctx.rr_switch_inf[node_power->driver_switch_type].Cout);
+                    break;
+                case POWER_BUFFER_TYPE_ABSOLUTE_SIZE:
+                    buffer_size = device_ctx.rr_switch_inf[node_power->driver_switch_type].power_buffer_size;
+                    buffer_size = std::max(buffer_size, 1.0F);
+                    break;
+                case POWER_BUFFER_TYPE_NONE:
+                    buffer_size = 0.;
+                    break;
+                default:
+                    buffer_size = 0.;
+                    VTR_ASSERT(0);
+                    break;
+            }
 
-                /*
-                 * power_ctx.commonly_used->num_sb_buffers +=
-                 * power_ctx.arch->seg_buffer_split;
-                 * power_ctx.commonly_used->total_sb_buffer_size += buffer_size
-                 * power_ctx.arch->seg_buffer_split;
-                 */
+            routing_usage->num_sb_buffers++;
+            routing_usage->total_sb_buffer_size += buffer_size;
 
-                /* Buffer */
-                power_usage_buffer(&sub_power_usage, buffer_size,
-                                   node_power->in_prob[node_power->selected_input],
-                                   node_power->in_dens[node_power->selected_input], true,
-                                   power_ctx.solution_inf.T_crit);
-                power_add_usage(power_usage, &sub_power_usage);
-                power_component_add_usage(&sub_power_usage,
-                                          POWER_COMPONENT_ROUTE_SB);
-
-                /* Wire Capacitance */
-                power_usage_wire(&sub_power_usage, C_wire,
-                                 clb_net_density(node_power->net_num), power_ctx.solution_inf.T_crit);
-                power_add_usage(power_usage, &sub_power_usage);
-                power_component_add_usage(&sub_power_usage,
-                                          POWER_COMPONENT_ROUTE_GLB_WIRE);
-
-                /* Determine types of switches that this wire drives */
-                connectionbox_fanout = 0;
-                switchbox_fanout = 0;
-                for (const RREdgeId& iedge : rr_graph.node_out_edges(rr_node_idx)) {
-                    if ((short)size_t(rr_graph.edge_switch(iedge)) == routing_arch->wire_to_rr_ipin_switch) {
-                        connectionbox_fanout++;
-                    } else if ((short)size_t(rr_graph.edge_switch(iedge)) == routing_arch->delayless_switch) {
-                        /* Do nothing */
-                    } else {
-                        switchbox_fanout++;
-                    }
-                }
+            /*
+             * power_ctx.commonly_used->num_sb_buffers +=
+             * power_ctx.arch->seg_buffer_split;
+             * power_ctx.commonly_used->total_sb_buffer_size += buffer_size
+             * power_ctx.arch->seg_buffer_split;
+             */
 
-                /* Buffer to next Switchbox */
-                if (switchbox_fanout) {
-                    buffer_size = power_buffer_size_from_logical_effort(switchbox_fanout * power_ctx.commonly_used->NMOS_1X_C_d);
-                    power_usage_buffer(&sub_power_usage, buffer_size,
-                                       1 - node_power->in_prob[node_power->selected_input],
-                                       node_power->in_dens[node_power->selected_input], false,
-                                       power_ctx.solution_inf.T_crit);
-                    power_add_usage(power_usage, &sub_power_usage);
-                    power_component_add_usage(&sub_power_usage,
-                                              POWER_COMPONENT_ROUTE_SB);
+            /* Buffer */
+            power_usage_buffer(&sub_power_usage, buffer_size,
+                               node_power->in_prob[node_power->selected_input],
+                               node_power->in_dens[node_power->selected_input], true,
+                               power_ctx.solution_inf.T_crit);
+            power_routing_add_usage(routing_usage, &sub_power_usage,
+                                    POWER_COMPONENT_ROUTE_SB);
+
+            /* Wire Capacitance */
+            power_usage_wire(&sub_power_usage, C_wire,
+                             clb_net_density(node_power->net_num), power_ctx.solution_inf.T_crit);
+            power_routing_add_usage(routing_usage, &sub_power_usage,
+                                    POWER_COMPONENT_ROUTE_GLB_WIRE);
+
+            /* Determine types of switches that this wire drives */
+            connectionbox_fanout = 0;
+            switchbox_fanout = 0;
+            for (const RREdgeId& iedge : rr_graph.node_out_edges(rr_node_idx)) {
+                if ((short)size_t(rr_graph.edge_switch(iedge)) == routing_arch->wire_to_rr_ipin_switch) {
+                    connectionbox_fanout++;
+                } else if ((short)size_t(rr_graph.edge_switch(iedge)) == routing_arch->delayless_switch) {
+                    /* Do nothing */
+                } else {
+                    switchbox_fanout++;
                 }
+            }
 
-                /* Driver for ConnectionBox */
-                if (connectionbox_fanout) {
-                    buffer_size = power_buffer_size_from_logical_effort(connectionbox_fanout * power_ctx.commonly_used->NMOS_1X_C_d);
+            /* Buffer to next Switchbox */
+            if (switchbox_fanout) {
+                buffer_size = power_buffer_size_from_logical_effort(switchbox_fanout * power_ctx.commonly_used->NMOS_1X_C_d);
+                power_usage_buffer(&sub_power_usage, buffer_size,
+                                   1 - node_power->in_prob[node_power->selected_input],
+                                   node_power->in_dens[node_power->selected_input], false,
+                                   power_ctx.solution_inf.T_crit);
+                power_routing_add_usage(routing_usage, &sub_power_usage,
+                                        POWER_COMPONENT_ROUTE_SB);
+            }
 
-                    power_usage_buffer(&sub_power_usage, buffer_size,
-                                       1 - node_power->in_prob[node_power->selected_input],
-                                       node_power->in_dens[node_power->selected_input],
-                                       false, power_ctx.solution_inf.T_crit);
-                    power_add_usage(power_usage, &sub_power_usage);
-                    power_component_add_usage(&sub_power_usage,
-                                              POWER_COMPONENT_ROUTE_CB);
+            /* Driver for ConnectionBox */
+            if (connectionbox_fanout) {
+                buffer_size = power_buffer_size_from_logical_effort(connectionbox_fanout * power_ctx.commonly_used->NMOS_1X_C_d);
 
-                    power_ctx.commonly_used->num_cb_buffers++;
-                    power_ctx.commonly_used->total_cb_buffer_size += buffer_size;
-                }
-                break;
-            default:
-                power_log_msg(POWER_LOG_WARNING,
-                              "The global routing-resource graph contains an unknown node type.");
-                break;
-        }
+                power_usage_buffer(&sub_power_usage, buffer_size,
+                                   1 - node_power->in_prob[node_power->selected_input],
+                                   node_power->in_dens[node_power->selected_input],
+                                   false, power_ctx.solution_inf.T_crit);
+                power_routing_add_usage(routing_usage, &sub_power_usage,
+                                        POWER_COMPONENT_ROUTE_CB);
+
+                routing_usage->num_cb_buffers++;
+                routing_usage->total_cb_buffer_size += buffer_size;
+            }
+            break;
+        default:
+            power_log_msg(POWER_LOG_WARNING,
+                          "The global routing-resource graph contains an unknown node type.");
+            break;
     }
 }
 
@@ -23,6 +23,7 @@
 #include <cstring>
 #include <cmath>
 #include <map>
+#include <mutex>
 
 #include "vtr_assert.h"
 #include "vtr_memory.h"
@@ -33,6 +34,9 @@
 #include "atom_netlist_utils.h"
 
 /************************* GLOBALS **********************************/
+/* Power of routing resources may be estimated on several threads,
+ * which may log messages at the same time */
+static std::mutex power_log_mutex;
 
 /************************* FUNCTION DECLARATIONS*********************/
 static void log_msg(t_log* log_ptr, const char* msg);
@@ -69,6 +73,7 @@ float power_perc_dynamic(t_power_usage* power_usage) {
 
 void power_log_msg(e_power_log_type log_type, const char* msg) {
     auto& power_ctx = g_vpr_ctx.power();
+    std::lock_guard<std::mutex> lock(power_log_mutex);
     log_msg(&power_ctx.output->logs[log_type], msg);
 }
 
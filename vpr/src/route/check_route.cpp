@@ -16,10 +16,15 @@
 #include "route_tree_type.h"
 #include "route_tree_timing.h"
 
+#if defined(VPR_USE_TBB)
+#    include <tbb/enumerable_thread_specific.h>
+#    include <tbb/parallel_for.h>
+#endif
+
 /******************** Subroutines local to this module **********************/
 static void check_node_and_range(const RRNodeId& inode, enum e_route_type route_type);
 static void check_source(const RRNodeId& inode, ClusterNetId net_id);
-static void check_sink(const RRNodeId& inode, ClusterNetId net_id, bool* pin_done);
+static void check_sink(const RRNodeId& inode, ClusterNetId net_id, std::vector<bool>& pin_done);
 static void check_switch(t_trace* tptr, int num_switch);
 static bool check_adjacent(const RRNodeId& from_node, const RRNodeId& to_node);
 static int chanx_chany_adjacent(const RRNodeId& chanx_node, const RRNodeId& chany_node);
@@ -30,6 +35,17 @@ static void check_locally_used_clb_opins(const t_clb_opins_used& clb_opins_used_
 static bool check_non_configurable_edges(ClusterNetId net, const t_non_configurable_rr_sets& non_configurable_rr_sets);
 static void check_net_for_stubs(ClusterNetId net);
 
+/* Flags used while checking the connectivity of one net at a time */
+struct t_check_route_flags {
+    vtr::vector<RRNodeId, bool> connected_to_route; /* [0 .. device_ctx.rr_nodes.size()-1] */
+    std::vector<bool> pin_done;                     /* [0 .. max_pins-1] */
+};
+
+static void check_net_connectivity(ClusterNetId net_id,
+                                   enum e_route_type route_type,
+                                   const t_non_configurable_rr_sets& non_configurable_rr_sets,
+                                   t_check_route_flags& flags);
+
 /************************ Subroutine definitions ****************************/
 
 void check_route(enum e_route_type route_type) {
@@ -39,20 +55,12 @@ void check_route(enum e_route_type route_type) {
      * oversubscribed (the occupancy of everything is recomputed from        *
      * scratch).                                                             */
 
-    int max_pins;
-    RRNodeId inode, prev_node;
-    unsigned int ipin;
-    bool valid, connects;
-    vtr::vector<RRNodeId, bool> connected_to_route; /* [0 .. device_ctx.rr_nodes.size()-1] */
-    t_trace* tptr;
-    bool* pin_done;
+    bool valid;
 
     auto& device_ctx = g_vpr_ctx.device();
     auto& cluster_ctx = g_vpr_ctx.clustering();
     auto& route_ctx = g_vpr_ctx.routing();
 
-    const int num_switches = device_ctx.rr_switch_inf.size();
-
     VTR_LOG("\n");
     VTR_LOG("Checking to ensure routing is legal...\n");
 
@@ -71,109 +79,151 @@ void check_route(enum e_route_type route_type) {
 
     auto non_configurable_rr_sets = identify_non_configurable_rr_sets();
 
-    connected_to_route.resize(device_ctx.rr_graph.nodes().size(), false);
-
-    max_pins = 0;
+    size_t max_pins = 0;
     for (auto net_id : cluster_ctx.clb_nlist.nets())
-        max_pins = std::max(max_pins, (int)cluster_ctx.clb_nlist.net_pins(net_id).size());
-
-    pin_done = (bool*)vtr::malloc(max_pins * sizeof(bool));
+        max_pins = std::max(max_pins, cluster_ctx.clb_nlist.net_pins(net_id).size());
 
-    /* Now check that all nets are indeed connected. */
+    /* Now check that all nets are indeed connected.
+     * Nets only read the routing, so that they can be checked concurrently,
+     * each thread owning its own flags. Errors are reported by exceptions,
+     * which are forwarded to this thread */
+    std::vector<ClusterNetId> nets_to_check;
     for (auto net_id : cluster_ctx.clb_nlist.nets()) {
         if (cluster_ctx.clb_nlist.net_is_ignored(net_id) || cluster_ctx.clb_nlist.net_sinks(net_id).size() == 0) /* Skip ignored nets. */
             continue;
+        nets_to_check.push_back(net_id);
+    }
 
-        for (ipin = 0; ipin < cluster_ctx.clb_nlist.net_pins(net_id).size(); ipin++)
-            pin_done[ipin] = false;
+    auto init_flags = [&]() {
+        t_check_route_flags flags;
+        flags.connected_to_route.resize(device_ctx.rr_graph.nodes().size(), false);
+        flags.pin_done.resize(max_pins, false);
+        return flags;
+    };
+
+#if defined(VPR_USE_TBB)
+    tbb::enumerable_thread_specific<t_check_route_flags> thread_flags(init_flags);
+    tbb::parallel_for(size_t(0), nets_to_check.size(), [&](size_t inet) {
+        check_net_connectivity(nets_to_check[inet], route_type, non_configurable_rr_sets, thread_flags.local());
+    });
+#else
+    t_check_route_flags flags = init_flags();
+    for (ClusterNetId net_id : nets_to_check) {
+        check_net_connectivity(net_id, route_type, non_configurable_rr_sets, flags);
+    }
+#endif
 
-        /* Check the SOURCE of the net. */
-        tptr = route_ctx.trace[net_id].head;
-        if (tptr == nullptr) {
-            VPR_ERROR(VPR_ERROR_ROUTE,
-                      "in check_route: net %d has no routing.\n", size_t(net_id));
-        }
+    /* Stubs are found on route trees, whose allocation is not thread-safe */
+    for (ClusterNetId net_id : nets_to_check) {
+        check_net_for_stubs(net_id);
+    }
 
-        inode = tptr->index;
-        check_node_and_range(inode, route_type);
-        check_switch(tptr, num_switches);
-        connected_to_route[inode] = true; /* Mark as in path. */
+    VTR_LOG("Completed routing consistency check successfully.\n");
+    VTR_LOG("\n");
+}
 
-        check_source(inode, net_id);
-        pin_done[0] = true;
+/* Checks that the routing of a net describes a properly connected path    *
+ * which connects all the pins of the net. The flags are all false on      *
+ * entry, and are reset before returning.                                  */
+static void check_net_connectivity(ClusterNetId net_id,
+                                   enum e_route_type route_type,
+                                   const t_non_configurable_rr_sets& non_configurable_rr_sets,
+                                   t_check_route_flags& flags) {
+    RRNodeId inode, prev_node;
+    unsigned int ipin;
+    bool connects;
+    t_trace* tptr;
 
-        prev_node = inode;
-        int prev_switch = tptr->iswitch;
-        tptr = tptr->next;
+    auto& device_ctx = g_vpr_ctx.device();
+    auto& cluster_ctx = g_vpr_ctx.clustering();
+    auto& route_ctx = g_vpr_ctx.routing();
 
-        /* Check the rest of the net */
-        size_t num_sinks = 0;
-        while (tptr != nullptr) {
-            inode = tptr->index;
-            check_node_and_range(inode, route_type);
-            check_switch(tptr, num_switches);
+    const int num_switches = device_ctx.rr_switch_inf.size();
+    vtr::vector<RRNodeId, bool>& connected_to_route = flags.connected_to_route;
+    std::vector<bool>& pin_done = flags.pin_done;
 
-            if (prev_switch == OPEN) { //Start of a new branch
-                if (connected_to_route[inode] == false) {
-                    VPR_ERROR(VPR_ERROR_ROUTE,
-                              "in check_route: node %d does not link into existing routing for net %d.\n", size_t(inode), size_t(net_id));
-                }
-            } else { //Continuing along existing branch
-                connects = check_adjacent(prev_node, inode);
-                if (!connects) {
-                    VPR_ERROR(VPR_ERROR_ROUTE,
-                              "in check_route: found non-adjacent segments in traceback while checking net %d:\n"
-                              "  %s\n"
-                              "  %s\n",
-                              size_t(net_id),
-                              describe_rr_node(prev_node).c_str(),
-                              describe_rr_node(inode).c_str());
-                }
+    for (ipin = 0; ipin < cluster_ctx.clb_nlist.net_pins(net_id).size(); ipin++)
+        pin_done[ipin] = false;
 
-                connected_to_route[inode] = true; /* Mark as in path. */
+    /* Check the SOURCE of the net. */
+    tptr = route_ctx.trace[net_id].head;
+    if (tptr == nullptr) {
+        VPR_ERROR(VPR_ERROR_ROUTE,
+                  "in check_route: net %d has no routing.\n", size_t(net_id));
+        return;
+    }
 
-                if (device_ctx.rr_graph.node_type(inode) == SINK) {
-                    check_sink(inode, net_id, pin_done);
-                    num_sinks += 1;
-                }
+    inode = tptr->index;
+    check_node_and_range(inode, route_type);
+    check_switch(tptr, num_switches);
+    connected_to_route[inode] = true; /* Mark as in path. */
 
-            } /* End of prev_node type != SINK */
-            prev_node = inode;
-            prev_switch = tptr->iswitch;
-            tptr = tptr->next;
-        } /* End while */
+    check_source(inode, net_id);
+    pin_done[0] = true;
 
-        if (num_sinks != cluster_ctx.clb_nlist.net_sinks(net_id).size()) {
-            VPR_FATAL_ERROR(VPR_ERROR_ROUTE,
-                            "in check_route: net %zu (%s) has %zu SINKs (expected %zu).\n",
-                            size_t(net_id), cluster_ctx.clb_nlist.net_name(net_id).c_str(),
-                            num_sinks, cluster_ctx.clb_nlist.net_sinks(net_id).size());
-        }
+    prev_node = inode;
+    int prev_switch = tptr->iswitch;
+    tptr = tptr->next;
 
-        for (ipin = 0; ipin < cluster_ctx.clb_nlist.net_pins(net_id).size(); ipin++) {
-            if (pin_done[ipin] == false) {
-                VPR_FATAL_ERROR(VPR_ERROR_ROUTE,
-                                "in check_route: net %zu does not connect to pin %d.\n", size_t(net_id), ipin);
+    /* Check the rest of the net */
+    size_t num_sinks = 0;
+    while (tptr != nullptr) {
+        inode = tptr->index;
+        check_node_and_range(inode, route_type);
+        check_switch(tptr, num_switches);
+
+        if (prev_switch == OPEN) { //Start of a new branch
+            if (connected_to_route[inode] == false) {
+                VPR_ERROR(VPR_ERROR_ROUTE,
+                          "in check_route: node %d does not link into existing routing for net %d.\n", size_t(inode), size_t(net_id));
+            }
+        } else { //Continuing along existing branch
+            connects = check_adjacent(prev_node, inode);
+            if (!connects) {
+                VPR_ERROR(VPR_ERROR_ROUTE,
+                          "in check_route: found non-adjacent segments in traceback while checking net %d:\n"
+                          "  %s\n"
+                          "  %s\n",
+                          size_t(net_id),
+                          describe_rr_node(prev_node).c_str(),
+                          describe_rr_node(inode).c_str());
             }
-        }
 
-        check_non_configurable_edges(net_id, non_configurable_rr_sets);
+            connected_to_route[inode] = true; /* Mark as in path. */
 
-        check_net_for_stubs(net_id);
+            if (device_ctx.rr_graph.node_type(inode) == SINK) {
+                check_sink(inode, net_id, pin_done);
+                num_sinks += 1;
+            }
+
+        } /* End of prev_node type != SINK */
+        prev_node = inode;
+        prev_switch = tptr->iswitch;
+        tptr = tptr->next;
+    } /* End while */
 
-        reset_flags(net_id, connected_to_route);
+    if (num_sinks != cluster_ctx.clb_nlist.net_sinks(net_id).size()) {
+        VPR_FATAL_ERROR(VPR_ERROR_ROUTE,
+                        "in check_route: net %zu (%s) has %zu SINKs (expected %zu).\n",
+                        size_t(net_id), cluster_ctx.clb_nlist.net_name(net_id).c_str(),
+                        num_sinks, cluster_ctx.clb_nlist.net_sinks(net_id).size());
+    }
+
+    for (ipin = 0; ipin < cluster_ctx.clb_nlist.net_pins(net_id).size(); ipin++) {
+        if (pin_done[ipin] == false) {
+            VPR_FATAL_ERROR(VPR_ERROR_ROUTE,
+                            "in check_route: net %zu does not connect to pin %d.\n", size_t(net_id), ipin);
+        }
+    }
 
-    } /* End for each net */
+    check_non_configurable_edges(net_id, non_configurable_rr_sets);
 
-    free(pin_done);
-    connected_to_route.clear();
-    VTR_LOG("Completed routing consistency check successfully.\n");
-    VTR_LOG("\n");
+    reset_flags(net_id, connected_to_route);
 }
 
 /* Checks that this SINK node is one of the terminals of inet, and marks   *
  * the appropriate pin as being reached.                                   */
-static void check_sink(const RRNodeId& inode, ClusterNetId net_id, bool* pin_done) {
+static void check_sink(const RRNodeId& inode, ClusterNetId net_id, std::vector<bool>& pin_done) {
     auto& device_ctx = g_vpr_ctx.device();
     auto& cluster_ctx = g_vpr_ctx.clustering();
     auto& place_ctx = g_vpr_ctx.placement();
@@ -8,6 +8,10 @@
 #include "rr_graph.h"
 #include "check_rr_graph.h"
 
+#if defined(VPR_USE_TBB)
+#    include <tbb/parallel_for.h>
+#endif
+
 /*********************** Subroutines local to this module *******************/
 
 static bool rr_node_is_global_clb_ipin(const RRNodeId& inode);
@@ -18,6 +22,8 @@ static bool has_adjacent_channel(const RRGraph& rr_graph, const RRNodeId& node,
 
 static void check_rr_edge(const RREdgeId& from_edge, const RRNodeId& to_node);
 
+static bool is_uninitialized_rr_node(const RRGraph& rr_graph, const RRNodeId& inode);
+
 /************************ Subroutine definitions ****************************/
 
 void check_rr_graph(const t_graph_type graph_type,
@@ -34,13 +40,12 @@ void check_rr_graph(const t_graph_type graph_type,
     auto switch_types_from_current_to_node = vtr::vector<RRNodeId, unsigned char>(device_ctx.rr_graph.nodes().size());
     const int num_rr_switches = device_ctx.rr_switch_inf.size();
 
-    for (const RRNodeId& inode : device_ctx.rr_graph.nodes()) {
-
+    /* The nodes only read the rr_graph, so that they can be checked concurrently.
+     * Errors are reported by exceptions, which are forwarded to this thread */
+    auto check_node = [&](const RRNodeId& inode) {
         /* Ignore any uninitialized rr_graph nodes */
-        if ((device_ctx.rr_graph.node_type(inode) == SOURCE)
-            && (device_ctx.rr_graph.node_xlow(inode) == 0) && (device_ctx.rr_graph.node_ylow(inode) == 0)
-            && (device_ctx.rr_graph.node_xhigh(inode) == 0) && (device_ctx.rr_graph.node_yhigh(inode) == 0)) {
-            continue;
+        if (is_uninitialized_rr_node(device_ctx.rr_graph, inode)) {
+            return;
         }
 
         t_rr_type rr_type = device_ctx.rr_graph.node_type(inode);
@@ -63,7 +68,6 @@ void check_rr_graph(const t_graph_type graph_type,
             check_rr_edge(iedge, to_node);
 
             edges_from_current_to_node[to_node].push_back(iedge);
-            total_edges_to_node[to_node]++;
 
             auto switch_type = size_t(device_ctx.rr_graph.edge_switch(iedge));
 
@@ -137,7 +141,28 @@ void check_rr_graph(const t_graph_type graph_type,
             }
         }
 
-    } /* End for all rr_nodes */
+    };
+
+    std::vector<RRNodeId> rr_nodes(device_ctx.rr_graph.nodes().begin(), device_ctx.rr_graph.nodes().end());
+#if defined(VPR_USE_TBB)
+    tbb::parallel_for(size_t(0), rr_nodes.size(), [&](size_t inode) {
+        check_node(rr_nodes[inode]);
+    });
+#else
+    for (const RRNodeId& inode : rr_nodes) {
+        check_node(inode);
+    }
+#endif
+
+    /* Count the edges to each node, now that all the edges are known to be valid */
+    for (const RRNodeId& inode : rr_nodes) {
+        if (is_uninitialized_rr_node(device_ctx.rr_graph, inode)) {
+            continue;
+        }
+        for (const RREdgeId& iedge : device_ctx.rr_graph.node_out_edges(inode)) {
+            total_edges_to_node[device_ctx.rr_graph.edge_sink_node(iedge)]++;
+        }
+    }
 
     /* I built a list of how many edges went to everything in the code above -- *
      * now I check that everything is reachable.                                */
@@ -198,6 +223,12 @@ void check_rr_graph(const t_graph_type graph_type,
     }
 }
 
+static bool is_uninitialized_rr_node(const RRGraph& rr_graph, const RRNodeId& inode) {
+    return (rr_graph.node_type(inode) == SOURCE)
+           && (rr_graph.node_xlow(inode) == 0) && (rr_graph.node_ylow(inode) == 0)
+           && (rr_graph.node_xhigh(inode) == 0) && (rr_graph.node_yhigh(inode) == 0);
+}
+
 static bool rr_node_is_global_clb_ipin(const RRNodeId& inode) {
     /* Returns true if inode refers to a global CLB input pin node.   */
 
@@ -20,27 +20,38 @@ class Connection_based_routing_resources {
     // the reverse lookup of route_ctx.net_rr_terminals
     vtr::vector<ClusterNetId, std::unordered_map<int, int>> rr_sink_node_to_pin;
 
-    // a property of each net, but only valid after pruning the previous route tree
-    // the "targets" in question can be either rr_node indices or pin indices, the
-    // conversion from node to pin being performed by this class
-    std::vector<int> remaining_targets;
-
-    // contains rt_nodes representing sinks reached legally while pruning the route tree
-    // used to populate rt_node_of_sink after building route tree from traceback
-    // order does not matter
-    std::vector<t_rt_node*> reached_rt_sinks;
+    // scratch-space of the net being routed
+    // each thread has its own, so that nets can be routed concurrently
+    struct t_net_scratch {
+        // the current net that's being routed
+        ClusterNetId current_inet;
+
+        // a property of each net, but only valid after pruning the previous route tree
+        // the "targets" in question can be either rr_node indices or pin indices, the
+        // conversion from node to pin being performed by this class
+        std::vector<int> remaining_targets;
+
+        // contains rt_nodes representing sinks reached legally while pruning the route tree
+        // used to populate rt_node_of_sink after building route tree from traceback
+        // order does not matter
+        std::vector<t_rt_node*> reached_rt_sinks;
+    };
+    static t_net_scratch& net_scratch() {
+        static thread_local t_net_scratch scratch;
+        return scratch;
+    }
 
   public:
     Connection_based_routing_resources();
     // adding to the resources when they are reached during pruning
     // mark rr sink node as something that still needs to be reached
-    void toreach_rr_sink(const int& rr_sink_node) { remaining_targets.push_back(rr_sink_node); }
+    void toreach_rr_sink(const int& rr_sink_node) { net_scratch().remaining_targets.push_back(rr_sink_node); }
     // mark rt sink node as something that has been legally reached
-    void reached_rt_sink(t_rt_node* rt_sink) { reached_rt_sinks.push_back(rt_sink); }
+    void reached_rt_sink(t_rt_node* rt_sink) { net_scratch().reached_rt_sinks.push_back(rt_sink); }
 
     // get a handle on the resources
-    std::vector<int>& get_remaining_targets() { return remaining_targets; }
-    std::vector<t_rt_node*>& get_reached_rt_sinks() { return reached_rt_sinks; }
+    std::vector<int>& get_remaining_targets() { return net_scratch().remaining_targets; }
+    std::vector<t_rt_node*>& get_reached_rt_sinks() { return net_scratch().reached_rt_sinks; }
 
     void convert_sink_nodes_to_net_pins(std::vector<int>& rr_sink_nodes) const;
 
@@ -67,9 +78,6 @@ class Connection_based_routing_resources {
     // determined after the first routing iteration when only optimizing for timing delay
     vtr::vector<ClusterNetId, std::vector<float>> lower_bound_connection_delay;
 
-    // the current net that's being routed
-    ClusterNetId current_inet;
-
     // the most recent stable critical path delay
     // compared against the current iteration's critical path delay
     // if the growth is too high, some connections will be forcibly ripped up
@@ -89,14 +97,15 @@ class Connection_based_routing_resources {
 
     // initialize routing resources at the start of routing to a new net
     void prepare_routing_for_net(ClusterNetId inet) {
-        current_inet = inet;
+        t_net_scratch& scratch = net_scratch();
+        scratch.current_inet = inet;
         // fresh net with fresh targets
-        remaining_targets.clear();
-        reached_rt_sinks.clear();
+        scratch.remaining_targets.clear();
+        scratch.reached_rt_sinks.clear();
     }
 
     // get a handle on the resources
-    ClusterNetId get_current_inet() const { return current_inet; }
+    ClusterNetId get_current_inet() const { return net_scratch().current_inet; }
     float get_stable_critical_path_delay() const { return last_stable_critical_path_delay; }
 
     bool critical_path_delay_grew_significantly(float new_critical_path_delay) const {
@@ -108,9 +117,10 @@ class Connection_based_routing_resources {
 
     // get whether the connection to rr_sink_node of current_inet should be forcibly rerouted (can either assign or just read)
     bool should_force_reroute_connection(int rr_sink_node) const {
-        auto itr = forcible_reroute_connection_flag[current_inet].find(rr_sink_node);
+        const auto& net_flags = forcible_reroute_connection_flag[get_current_inet()];
+        auto itr = net_flags.find(rr_sink_node);
 
-        if (itr == forcible_reroute_connection_flag[current_inet].end()) {
+        if (itr == net_flags.end()) {
             return false; //A non-SINK end of a branch
         }
         return itr->second;
@@ -4,6 +4,7 @@
 #include <algorithm>
 #include <vector>
 #include <iostream>
+#include <mutex>
 
 #include "vtr_assert.h"
 #include "vtr_util.h"
@@ -35,6 +36,9 @@
 #include "RoutingDelayCalculator.h"
 #include "timing_info.h"
 #include "tatum/echo_writer.hpp"
+#include "place_route_capnp.h"
+#include "read_route.h"
+#include "net_delay.h"
 
 /**************** Types local to route_common.c ******************/
 struct t_trace_branch {
@@ -44,22 +48,25 @@ struct t_trace_branch {
 
 /**************** Static variables local to route_common.c ******************/
 
-static t_heap** heap; /* Indexed from [1..heap_size] */
-static int heap_size; /* Number of slots in the heap array */
-static int heap_tail; /* Index of first unused slot in the heap array */
+/* Each thread owns its heap, so that nets can be routed concurrently */
+static thread_local t_heap** heap = nullptr; /* Indexed from [1..heap_size] */
+static thread_local int heap_size;           /* Number of slots in the heap array */
+static thread_local int heap_tail;           /* Index of first unused slot in the heap array */
 
 /* For managing my own list of currently free heap data structures.     */
-static t_heap* heap_free_head = nullptr;
+static thread_local t_heap* heap_free_head = nullptr;
 /* For keeping track of the sudo malloc memory for the heap*/
-static vtr::t_chunk heap_ch;
+static thread_local vtr::t_chunk heap_ch;
 
 /* For managing my own list of currently free trace data structures.    */
 static t_trace* trace_free_head = nullptr;
 /* For keeping track of the sudo malloc memory for the trace*/
 static vtr::t_chunk trace_ch;
+/* Traces are shared by the threads, as a net may be routed by different threads in different iterations */
+static std::mutex trace_mutex;
 
 static int num_trace_allocated = 0; /* To watch for memory leaks. */
-static int num_heap_allocated = 0;
+static thread_local int num_heap_allocated = 0;
 static int num_linked_f_pointer_allocated = 0;
 
 /*  The numbering relation between the channels and clbs is:				*
@@ -320,6 +327,14 @@ bool try_route(int width_fac,
         IntraLbPbPinLookup intra_lb_pb_pin_lookup(device_ctx.logical_block_types);
         ClusteredPinAtomPinsLookup netlist_pin_lookup(cluster_ctx.clb_nlist, intra_lb_pb_pin_lookup);
 
+        /* Start from the routing of a previous run: the nets whose routing is   *
+         * reused are legal and are skipped by the router, unless they become    *
+         * congested, in which case they are incrementally rerouted.             */
+        if (!router_opts.incremental_route_file.empty()) {
+            std::vector<ClusterNetId> reused_nets = read_incremental_route(router_opts.incremental_route_file.c_str());
+            load_net_delay_from_routing(net_delay, reused_nets);
+        }
+
         success = try_timing_driven_route(router_opts,
                                           analysis_opts,
                                           segment_inf,
@@ -485,6 +500,31 @@ void init_heap(const DeviceGrid& grid) {
     heap_tail = 1;
 }
 
+/* Frees the heap of a thread when the thread exits */
+struct t_heap_thread_cleanup {
+    ~t_heap_thread_cleanup() {
+        if (heap != nullptr) {
+            // coverity[offset_free : Intentional]
+            free(heap + 1);
+            heap = nullptr;
+        }
+        heap_free_head = nullptr;
+        num_heap_allocated = 0;
+        free_chunk_memory(&heap_ch);
+    }
+};
+
+/* Call this in a thread before it routes any nets, other than the thread *
+ * which called init_route_structs().  The heap is freed at thread exit.  */
+void init_route_thread_structs(const DeviceGrid& grid) {
+    static thread_local t_heap_thread_cleanup heap_cleanup;
+    (void)heap_cleanup;
+
+    if (heap == nullptr) {
+        init_heap(grid);
+    }
+}
+
 /* Call this before you route any nets.  It frees any old traceback and   *
  * sets the list of rr_nodes touched to empty.                            */
 void init_route_structs(int bb_factor) {
@@ -1434,6 +1474,7 @@ t_trace*
 alloc_trace_data() {
     t_trace* temp_ptr;
 
+    std::lock_guard<std::mutex> lock(trace_mutex);
     if (trace_free_head == nullptr) { /* No elements on the free list */
         trace_free_head = (t_trace*)vtr::chunk_malloc(sizeof(t_trace), &trace_ch);
         trace_free_head->next = nullptr;
@@ -1447,6 +1488,7 @@ alloc_trace_data() {
 void free_trace_data(t_trace* tptr) {
     /* Puts the traceback structure pointed to by tptr on the free list. */
 
+    std::lock_guard<std::mutex> lock(trace_mutex);
     tptr->next = trace_free_head;
     trace_free_head = tptr;
     num_trace_allocated--;
@@ -1580,6 +1622,11 @@ void print_route(FILE* fp, const vtr::vector<ClusterNetId, t_traceback>& traceba
 
 /* Prints out the routing to file route_file.  */
 void print_route(const char* placement_file, const char* route_file) {
+    if (vtr::check_file_name_extension(route_file, ".capnp")) {
+        write_capnp_route(placement_file, route_file);
+        return;
+    }
+
     FILE* fp;
 
     fp = fopen(route_file, "w");
@@ -121,6 +121,7 @@ void reset_rr_node_route_structs();
 void free_trace_structs();
 
 void init_heap(const DeviceGrid& grid);
+void init_route_thread_structs(const DeviceGrid& grid);
 void reserve_locally_used_opins(float pres_fac, float acc_fac, bool rip_up_local_opins);
 
 void free_chunk_memory_trace();
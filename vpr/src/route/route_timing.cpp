@@ -8,6 +8,9 @@
 #include "vtr_assert.h"
 #include "vtr_log.h"
 #include "vtr_time.h"
+#include "vtr_ndmatrix.h"
+
+#include "openfpga_parallel.h"
 
 #include "vpr_utils.h"
 #include "vpr_types.h"
@@ -39,6 +42,10 @@
 
 #define CONGESTED_SLOPE_VAL -0.04
 
+//Number of grid tiles by which the bounding box of a high fanout connection
+//is expanded around the nearby routing of its net
+constexpr int HIGH_FANOUT_BB_FAC = 3;
+
 enum class RouterCongestionMode {
     NORMAL,
     CONFLICTED
@@ -130,7 +137,16 @@ struct RoutingMetrics {
 
 //Run-time flag to control when router debug information is printed
 //Note only enables debug output if compiled with VTR_ENABLE_DEBUG_LOGGING defined
-bool f_router_debug = false;
+//Each thread has its own flag, since nets may be routed concurrently
+thread_local bool f_router_debug = false;
+
+//Set in the threads routing the nets of a wave concurrently.
+//A connection which can not be found within the bounding box of its net is
+//not retried with the full device bounding box, since that search would leave
+//the routing region of the net. The net is rerouted serially after the wave instead.
+static thread_local bool f_defer_full_device_retry = false;
+//Records whether the retry of a connection has been deferred for the net being routed
+static thread_local bool f_full_device_retry_deferred = false;
 
 /******************** Subroutines local to route_timing.c ********************/
 
@@ -312,6 +328,28 @@ static void prune_unused_non_configurable_nets(CBRR& connections_inf);
 
 static bool same_non_config_node_set(const RRNodeId& from_node, const RRNodeId& to_node);
 
+static bool is_parallel_net_routing_safe(const t_router_opts& router_opts);
+static int calc_max_rr_node_span();
+static t_bb calc_net_routing_region(ClusterNetId net_id, int high_fanout_threshold, int max_rr_node_span);
+static std::vector<std::vector<ClusterNetId>> partition_nets_into_waves(const std::vector<ClusterNetId>& sorted_nets,
+                                                                        int high_fanout_threshold,
+                                                                        int max_rr_node_span);
+static void rip_up_deferred_net(ClusterNetId net_id, float pres_fac);
+static bool try_parallel_timing_driven_route_nets(const std::vector<ClusterNetId>& sorted_nets,
+                                                  int max_rr_node_span,
+                                                  int itry,
+                                                  float pres_fac,
+                                                  const t_router_opts& router_opts,
+                                                  CBRR& connections_inf,
+                                                  RouterStats& router_stats,
+                                                  timing_driven_route_structs& route_structs,
+                                                  vtr::vector<ClusterNetId, float*>& net_delay,
+                                                  const RouterLookahead& router_lookahead,
+                                                  const ClusteredPinAtomPinsLookup& netlist_pin_lookup,
+                                                  std::shared_ptr<SetupTimingInfo> timing_info,
+                                                  route_budgets& budgeting_inf,
+                                                  std::vector<ClusterNetId>& rerouted_nets);
+
 /************************ Subroutine definitions *****************************/
 bool try_timing_driven_route(const t_router_opts& router_opts,
                              const t_analysis_opts& analysis_opts,
@@ -417,6 +455,17 @@ bool try_timing_driven_route(const t_router_opts& router_opts,
     RouterStats router_stats;
     print_route_status_header();
     timing_driven_route_structs route_structs;
+
+    //Nets whose routing regions are disjoint can be routed concurrently
+    bool parallel_net_routing = router_opts.parallel_net_routing && is_parallel_net_routing_safe(router_opts);
+    int max_rr_node_span = 0;
+    if (parallel_net_routing) {
+        max_rr_node_span = calc_max_rr_node_span();
+        //Base costs do not depend on the fanout of nets (no pass-transistor switches),
+        //set them once so that they are not modified while nets are routed concurrently
+        update_rr_base_costs(1);
+    }
+
     float prev_iter_cumm_time = 0;
     vtr::Timer iteration_timer;
     int num_net_bounding_boxes_updated = 0;
@@ -452,28 +501,48 @@ bool try_timing_driven_route(const t_router_opts& router_opts,
         /*
          * Route each net
          */
-        for (auto net_id : sorted_nets) {
-            bool was_rerouted = false;
-            bool is_routable = try_timing_driven_route_net(net_id,
-                                                           itry,
-                                                           pres_fac,
-                                                           router_opts,
-                                                           connections_inf,
-                                                           router_iteration_stats,
-                                                           route_structs.pin_criticality,
-                                                           route_structs.rt_node_of_sink,
-                                                           net_delay,
-                                                           *router_lookahead,
-                                                           netlist_pin_lookup,
-                                                           route_timing_info,
-                                                           budgeting_inf,
-                                                           was_rerouted);
+        if (parallel_net_routing) {
+            bool is_routable = try_parallel_timing_driven_route_nets(sorted_nets,
+                                                                     max_rr_node_span,
+                                                                     itry,
+                                                                     pres_fac,
+                                                                     router_opts,
+                                                                     connections_inf,
+                                                                     router_iteration_stats,
+                                                                     route_structs,
+                                                                     net_delay,
+                                                                     *router_lookahead,
+                                                                     netlist_pin_lookup,
+                                                                     route_timing_info,
+                                                                     budgeting_inf,
+                                                                     rerouted_nets);
             if (!is_routable) {
                 return (false); //Impossible to route
             }
+        } else {
+            for (auto net_id : sorted_nets) {
+                bool was_rerouted = false;
+                bool is_routable = try_timing_driven_route_net(net_id,
+                                                               itry,
+                                                               pres_fac,
+                                                               router_opts,
+                                                               connections_inf,
+                                                               router_iteration_stats,
+                                                               route_structs.pin_criticality,
+                                                               route_structs.rt_node_of_sink,
+                                                               net_delay,
+                                                               *router_lookahead,
+                                                               netlist_pin_lookup,
+                                                               route_timing_info,
+                                                               budgeting_inf,
+                                                               was_rerouted);
+                if (!is_routable) {
+                    return (false); //Impossible to route
+                }
 
-            if (was_rerouted) {
-                rerouted_nets.push_back(net_id);
+                if (was_rerouted) {
+                    rerouted_nets.push_back(net_id);
+                }
             }
         }
 
@@ -820,7 +889,7 @@ bool try_timing_driven_route_net(ClusterNetId net_id,
         /* Impossible to route? (disconnected rr_graph) */
         if (is_routed) {
             route_ctx.net_status[net_id].is_routed = true;
-        } else {
+        } else if (!f_full_device_retry_deferred) {
             VTR_LOG("Routing failed.\n");
         }
 
@@ -1119,6 +1188,9 @@ static bool timing_driven_pre_route_to_clock_root(
 
     // TODO: Parts of the rest of this function are repetitive to code in timing_driven_route_sink. Should refactor.
     if (cheapest == nullptr) {
+        if (f_full_device_retry_deferred) {
+            return false;
+        }
         ClusterBlockId src_block = cluster_ctx.clb_nlist.net_driver_block(net_id);
         VTR_LOG("Failed to route connection from '%s' to '%s' for net '%s' (#%zu)\n",
                 cluster_ctx.clb_nlist.block_name(src_block).c_str(),
@@ -1236,6 +1308,9 @@ static bool timing_driven_route_sink(ClusterNetId net_id,
     }
 
     if (cheapest == nullptr) {
+        if (f_full_device_retry_deferred) {
+            return false;
+        }
         ClusterBlockId src_block = cluster_ctx.clb_nlist.net_driver_block(net_id);
         ClusterBlockId sink_block = cluster_ctx.clb_nlist.pin_block(*(cluster_ctx.clb_nlist.net_pins(net_id).begin() + target_pin));
         VTR_LOG("Failed to route connection from '%s' to '%s' for net '%s' (#%zu)\n",
@@ -1327,6 +1402,17 @@ t_heap* timing_driven_route_connection_from_route_tree(t_rt_node* rt_root,
                                                                 modified_rr_node_inf,
                                                                 router_stats);
 
+    if (cheapest == nullptr && f_defer_full_device_retry) {
+        //The full device bounding box overlaps the routing regions of the nets
+        //being routed concurrently, leave the retry to a serial reroute of the net
+        reset_path_costs(modified_rr_node_inf);
+        modified_rr_node_inf.clear();
+        f_full_device_retry_deferred = true;
+
+        free_route_tree(rt_root);
+        return nullptr;
+    }
+
     if (cheapest == nullptr) {
         //Found no path found within the current bounding box.
         //Try again with no bounding box (i.e. a full device grid bounding box).
@@ -1431,13 +1517,14 @@ static t_heap* timing_driven_route_connection_from_route_tree_high_fanout(t_rt_n
         reset_path_costs(modified_rr_node_inf);
         modified_rr_node_inf.clear();
 
-        cheapest = timing_driven_route_connection_from_route_tree(rt_root,
-                                                                  sink_node,
-                                                                  cost_params,
-                                                                  net_bounding_box,
-                                                                  router_lookahead,
-                                                                  modified_rr_node_inf,
-                                                                  router_stats);
+        //Note the route tree has already been freed if no path is found
+        return timing_driven_route_connection_from_route_tree(rt_root,
+                                                              sink_node,
+                                                              cost_params,
+                                                              net_bounding_box,
+                                                              router_lookahead,
+                                                              modified_rr_node_inf,
+                                                              router_stats);
     }
 
     if (cheapest == nullptr) {
@@ -1661,7 +1748,8 @@ static t_rt_node* setup_routing_resources(int itry,
     // for nets below a certain size (min_incremental_reroute_fanout), rip up any old routing
     // otherwise, we incrementally reroute by reusing legal parts of the previous iteration
     // convert the previous iteration's traceback into the starting route tree for this iteration
-    if ((int)num_sinks < min_incremental_reroute_fanout || itry == 1) {
+    // (nets without any routing, e.g. ripped up by a deferred reroute, are routed from scratch)
+    if ((int)num_sinks < min_incremental_reroute_fanout || itry == 1 || route_ctx.trace[net_id].head == nullptr) {
         profiling::net_rerouted();
 
         // rip up the whole net
@@ -1914,7 +2002,6 @@ static t_bb add_high_fanout_route_tree_to_heap(t_rt_node* rt_root, const RRNodeI
 static t_bb adjust_highfanout_bounding_box(t_bb highfanout_bb) {
     t_bb bb = highfanout_bb;
 
-    constexpr int HIGH_FANOUT_BB_FAC = 3;
     bb.xmin -= HIGH_FANOUT_BB_FAC;
     bb.ymin -= HIGH_FANOUT_BB_FAC;
     bb.xmax += HIGH_FANOUT_BB_FAC;
@@ -2254,10 +2341,15 @@ void update_rr_base_costs(int fanout) {
     factor = sqrt(fanout);
 
     for (index = CHANX_COST_INDEX_START; index < device_ctx.rr_indexed_data.size(); index++) {
+        float base_cost;
         if (device_ctx.rr_indexed_data[index].T_quadratic > 0.) { /* pass transistor */
-            device_ctx.rr_indexed_data[index].base_cost = device_ctx.rr_indexed_data[index].saved_base_cost * factor;
+            base_cost = device_ctx.rr_indexed_data[index].saved_base_cost * factor;
         } else {
-            device_ctx.rr_indexed_data[index].base_cost = device_ctx.rr_indexed_data[index].saved_base_cost;
+            base_cost = device_ctx.rr_indexed_data[index].saved_base_cost;
+        }
+        /* Only write the changed costs, since the costs are read by the nets routed concurrently */
+        if (device_ctx.rr_indexed_data[index].base_cost != base_cost) {
+            device_ctx.rr_indexed_data[index].base_cost = base_cost;
         }
     }
 }
@@ -2360,9 +2452,7 @@ static bool early_exit_heuristic(const t_router_opts& router_opts, const Wirelen
 
 // incremental rerouting resources class definitions
 Connection_based_routing_resources::Connection_based_routing_resources()
-    : current_inet(NO_PREVIOUS)
-    , // not routing to a specific net yet (note that NO_PREVIOUS is not unsigned, so will be largest unsigned)
-    last_stable_critical_path_delay{0.0f}
+    : last_stable_critical_path_delay{0.0f}
     , critical_path_growth_tolerance{1.001f}
     , connection_criticality_tolerance{0.9f}
     , connection_delay_optimality_tolerance{1.1f} {
@@ -2382,8 +2472,10 @@ Connection_based_routing_resources::Connection_based_routing_resources()
     // can have as many targets as sink pins (total number of pins - SOURCE pin)
     // supposed to be used as persistent vector growing with push_back and clearing at the start of each net routing iteration
     auto max_sink_pins_per_net = std::max(get_max_pins_per_net() - 1, 0);
-    remaining_targets.reserve(max_sink_pins_per_net);
-    reached_rt_sinks.reserve(max_sink_pins_per_net);
+    t_net_scratch& scratch = net_scratch();
+    scratch.current_inet = ClusterNetId(NO_PREVIOUS); // not routing to a specific net yet (note that NO_PREVIOUS is not unsigned, so will be largest unsigned)
+    scratch.remaining_targets.reserve(max_sink_pins_per_net);
+    scratch.reached_rt_sinks.reserve(max_sink_pins_per_net);
 
     size_t routing_num_nets = cluster_ctx.clb_nlist.nets().size();
     rr_sink_node_to_pin.resize(routing_num_nets);
@@ -2415,9 +2507,9 @@ void Connection_based_routing_resources::convert_sink_nodes_to_net_pins(std::vec
     /* Turn a vector of device_ctx.rr_nodes indices, assumed to be of sinks for a net *
      * into the pin indices of the same net. */
 
-    VTR_ASSERT(current_inet != ClusterNetId::INVALID()); // not uninitialized
+    VTR_ASSERT(get_current_inet() != ClusterNetId::INVALID()); // not uninitialized
 
-    const auto& node_to_pin_mapping = rr_sink_node_to_pin[current_inet];
+    const auto& node_to_pin_mapping = rr_sink_node_to_pin[get_current_inet()];
 
     for (size_t s = 0; s < rr_sink_nodes.size(); ++s) {
         auto mapping = node_to_pin_mapping.find(rr_sink_nodes[s]);
@@ -2434,10 +2526,10 @@ void Connection_based_routing_resources::put_sink_rt_nodes_in_net_pins_lookup(co
     /* Load rt_node_of_sink (which maps a PIN index to a route tree node)
      * with a vector of route tree sink nodes. */
 
-    VTR_ASSERT(current_inet != ClusterNetId::INVALID());
+    VTR_ASSERT(get_current_inet() != ClusterNetId::INVALID());
 
     // a net specific mapping from node index to pin index
-    const auto& node_to_pin_mapping = rr_sink_node_to_pin[current_inet];
+    const auto& node_to_pin_mapping = rr_sink_node_to_pin[get_current_inet()];
 
     for (t_rt_node* rt_node : sink_rt_nodes) {
         /* Xifan Tang - TODO: should use RRNodeId later */
@@ -2544,14 +2636,14 @@ bool Connection_based_routing_resources::forcibly_reroute_connections(float max_
 }
 
 void Connection_based_routing_resources::clear_force_reroute_for_connection(int rr_sink_node) {
-    forcible_reroute_connection_flag[current_inet][rr_sink_node] = false;
+    forcible_reroute_connection_flag[get_current_inet()][rr_sink_node] = false;
     profiling::perform_forced_reroute();
 }
 
 void Connection_based_routing_resources::clear_force_reroute_for_net() {
-    VTR_ASSERT(current_inet != ClusterNetId::INVALID());
+    VTR_ASSERT(get_current_inet() != ClusterNetId::INVALID());
 
-    auto& net_flags = forcible_reroute_connection_flag[current_inet];
+    auto& net_flags = forcible_reroute_connection_flag[get_current_inet()];
     for (auto& force_reroute_flag : net_flags) {
         if (force_reroute_flag.second) {
             force_reroute_flag.second = false;
@@ -3066,3 +3158,274 @@ static bool same_non_config_node_set(const RRNodeId& from_node, const RRNodeId&
 
     return from_itr->second == to_itr->second; //Check for same non-config set IDs
 }
+
+//Returns true if the nets whose routing regions are disjoint can be routed concurrently
+//
+//This relies on the routing of a net touching only the RR nodes within its routing region,
+//which does not hold for non-configurable node sets (which may extend beyond the bounding box
+//of a net), nor for the base costs of pass-transistor switches (which update_rr_base_costs()
+//modifies for each net). Router debugging is not supported either, since it updates the graphics.
+static bool is_parallel_net_routing_safe(const t_router_opts& router_opts) {
+    auto& device_ctx = g_vpr_ctx.device();
+
+    if (router_opts.router_debug_net >= -1 || router_opts.router_debug_sink_rr >= 0) {
+        VTR_LOG_WARN("Parallel net routing is disabled while router debugging is enabled\n");
+        return false;
+    }
+
+    if (!device_ctx.rr_non_config_node_sets.empty()) {
+        VTR_LOG_WARN("Parallel net routing is disabled since the routing resource graph contains non-configurable edges\n");
+        return false;
+    }
+
+    for (size_t index = CHANX_COST_INDEX_START; index < device_ctx.rr_indexed_data.size(); index++) {
+        if (device_ctx.rr_indexed_data[index].T_quadratic > 0.) {
+            VTR_LOG_WARN("Parallel net routing is disabled since the routing resource graph contains pass-transistor switches\n");
+            return false;
+        }
+    }
+
+    VTR_LOG("Routing nets in parallel with %zu thread(s)\n", openfpga::find_num_threads(router_opts.num_threads));
+    return true;
+}
+
+//Returns the largest span of an RR node along x or y, in grid tiles
+static int calc_max_rr_node_span() {
+    auto& device_ctx = g_vpr_ctx.device();
+    const auto& rr_graph = device_ctx.rr_graph;
+
+    int max_span = 0;
+    for (const RRNodeId& node : rr_graph.nodes()) {
+        max_span = std::max<int>(max_span, rr_graph.node_xhigh(node) - rr_graph.node_xlow(node));
+        max_span = std::max<int>(max_span, rr_graph.node_yhigh(node) - rr_graph.node_ylow(node));
+    }
+    return max_span;
+}
+
+//Returns the region of the grid containing all the RR nodes the routing of a net may touch
+//in the current iteration: the nodes of its previous routing (which may be ripped up) and
+//the nodes explored within its bounding box, whose extent may cross the bounding box
+static t_bb calc_net_routing_region(ClusterNetId net_id, int high_fanout_threshold, int max_rr_node_span) {
+    auto& cluster_ctx = g_vpr_ctx.clustering();
+    auto& device_ctx = g_vpr_ctx.device();
+    auto& route_ctx = g_vpr_ctx.routing();
+
+    t_bb region;
+    region.xmin = 0;
+    region.ymin = 0;
+    region.xmax = device_ctx.grid.width() - 1;
+    region.ymax = device_ctx.grid.height() - 1;
+
+    //Global nets may be routed through the dedicated clock network, which is not bounded
+    if (cluster_ctx.clb_nlist.net_is_global(net_id)) {
+        return region;
+    }
+
+    t_bb bb = route_ctx.route_bb[net_id];
+    if (route_ctx.trace[net_id].head != nullptr) {
+        t_bb current_bb = calc_current_bb(route_ctx.trace[net_id].head);
+        bb.xmin = std::min(bb.xmin, current_bb.xmin);
+        bb.ymin = std::min(bb.ymin, current_bb.ymin);
+        bb.xmax = std::max(bb.xmax, current_bb.xmax);
+        bb.ymax = std::max(bb.ymax, current_bb.ymax);
+    }
+
+    //High fanout connections are searched within the bounding box of the nearby routing,
+    //which may cross the bounding box of the net
+    int margin = max_rr_node_span;
+    if (is_high_fanout(cluster_ctx.clb_nlist.net_sinks(net_id).size(), high_fanout_threshold)) {
+        margin += max_rr_node_span + HIGH_FANOUT_BB_FAC;
+    }
+
+    region.xmin = std::max(region.xmin, bb.xmin - margin);
+    region.ymin = std::max(region.ymin, bb.ymin - margin);
+    region.xmax = std::min(region.xmax, bb.xmax + margin);
+    region.ymax = std::min(region.ymax, bb.ymax + margin);
+
+    return region;
+}
+
+//Partitions the nets into waves, whose nets can be routed concurrently
+//
+//Each net is placed in the wave after the last wave which contains an earlier net
+//(in routing order) whose routing region overlaps its own. Hence the nets of a wave
+//touch disjoint RR nodes, and each net sees the routing of the nets overlapping it
+//just as when routing the nets one by one in routing order.
+static std::vector<std::vector<ClusterNetId>> partition_nets_into_waves(const std::vector<ClusterNetId>& sorted_nets,
+                                                                        int high_fanout_threshold,
+                                                                        int max_rr_node_span) {
+    auto& cluster_ctx = g_vpr_ctx.clustering();
+    auto& device_ctx = g_vpr_ctx.device();
+
+    //The last wave touching each grid tile, 0 if none
+    vtr::Matrix<size_t> tile_waves({device_ctx.grid.width(), device_ctx.grid.height()}, 0);
+
+    std::vector<std::vector<ClusterNetId>> net_waves;
+    for (auto net_id : sorted_nets) {
+        //Ignored nets are not routed, they can go with any wave
+        if (cluster_ctx.clb_nlist.net_is_ignored(net_id)) {
+            if (net_waves.empty()) {
+                net_waves.emplace_back();
+            }
+            net_waves[0].push_back(net_id);
+            continue;
+        }
+
+        t_bb region = calc_net_routing_region(net_id, high_fanout_threshold, max_rr_node_span);
+
+        size_t last_wave = 0;
+        for (int x = region.xmin; x <= region.xmax; ++x) {
+            for (int y = region.ymin; y <= region.ymax; ++y) {
+                last_wave = std::max(last_wave, tile_waves[x][y]);
+            }
+        }
+
+        size_t wave = last_wave + 1;
+        for (int x = region.xmin; x <= region.xmax; ++x) {
+            for (int y = region.ymin; y <= region.ymax; ++y) {
+                tile_waves[x][y] = wave;
+            }
+        }
+
+        if (net_waves.size() < wave) {
+            net_waves.resize(wave);
+        }
+        net_waves[wave - 1].push_back(net_id);
+    }
+
+    return net_waves;
+}
+
+//Rips up the partial routing of a net whose routing was interrupted by a deferred retry
+static void rip_up_deferred_net(ClusterNetId net_id, float pres_fac) {
+    auto& route_ctx = g_vpr_ctx.mutable_routing();
+
+    pathfinder_update_path_cost(route_ctx.trace[net_id].head, -1, pres_fac);
+    free_traceback(net_id);
+
+    //Unmark the sinks which were not reached
+    for (size_t ipin = 1; ipin < route_ctx.net_rr_terminals[net_id].size(); ++ipin) {
+        route_ctx.rr_node_route_inf[route_ctx.net_rr_terminals[net_id][ipin]].target_flag = 0;
+    }
+}
+
+//Routes the nets wave by wave, where the nets of a wave are routed concurrently
+//(see partition_nets_into_waves()). Returns false if any net is impossible to route.
+//
+//The results do not depend on the number of threads. The nets whose connections
+//have to be retried with the full device bounding box are rerouted serially after
+//their wave, in routing order.
+static bool try_parallel_timing_driven_route_nets(const std::vector<ClusterNetId>& sorted_nets,
+                                                  int max_rr_node_span,
+                                                  int itry,
+                                                  float pres_fac,
+                                                  const t_router_opts& router_opts,
+                                                  CBRR& connections_inf,
+                                                  RouterStats& router_stats,
+                                                  timing_driven_route_structs& route_structs,
+                                                  vtr::vector<ClusterNetId, float*>& net_delay,
+                                                  const RouterLookahead& router_lookahead,
+                                                  const ClusteredPinAtomPinsLookup& netlist_pin_lookup,
+                                                  std::shared_ptr<SetupTimingInfo> timing_info,
+                                                  route_budgets& budgeting_inf,
+                                                  std::vector<ClusterNetId>& rerouted_nets) {
+    auto& cluster_ctx = g_vpr_ctx.clustering();
+    auto& device_ctx = g_vpr_ctx.device();
+
+    std::vector<std::vector<ClusterNetId>> net_waves = partition_nets_into_waves(sorted_nets,
+                                                                                 router_opts.high_fanout_threshold,
+                                                                                 max_rr_node_span);
+
+    //Scratch storage of each thread
+    size_t num_threads = openfpga::find_num_threads(router_opts.num_threads);
+    size_t max_pins_per_net = std::max(get_max_pins_per_net(), 1);
+    std::vector<RouterStats> thread_stats(num_threads);
+    std::vector<std::vector<float>> thread_pin_criticality(num_threads, std::vector<float>(max_pins_per_net));
+    std::vector<std::vector<t_rt_node*>> thread_rt_node_of_sink(num_threads, std::vector<t_rt_node*>(max_pins_per_net, nullptr));
+
+    //Results of each net, written by the thread routing it
+    size_t num_nets = cluster_ctx.clb_nlist.nets().size();
+    vtr::vector<ClusterNetId, char> net_is_routable(num_nets, true);
+    vtr::vector<ClusterNetId, char> net_was_rerouted(num_nets, false);
+    vtr::vector<ClusterNetId, char> net_retry_deferred(num_nets, false);
+
+    for (const std::vector<ClusterNetId>& wave : net_waves) {
+        openfpga::parallel_for_with_thread_id(wave.size(), num_threads, [&](const size_t& inet, const size_t& ithread) {
+            ClusterNetId net_id = wave[inet];
+
+            init_route_thread_structs(device_ctx.grid);
+            init_route_tree_thread_structs();
+
+            f_defer_full_device_retry = true;
+            f_full_device_retry_deferred = false;
+
+            bool was_rerouted = false;
+            net_is_routable[net_id] = try_timing_driven_route_net(net_id,
+                                                                  itry,
+                                                                  pres_fac,
+                                                                  router_opts,
+                                                                  connections_inf,
+                                                                  thread_stats[ithread],
+                                                                  thread_pin_criticality[ithread].data(),
+                                                                  thread_rt_node_of_sink[ithread].data(),
+                                                                  net_delay,
+                                                                  router_lookahead,
+                                                                  netlist_pin_lookup,
+                                                                  timing_info,
+                                                                  budgeting_inf,
+                                                                  was_rerouted);
+            net_was_rerouted[net_id] = was_rerouted;
+            net_retry_deferred[net_id] = f_full_device_retry_deferred;
+
+            f_defer_full_device_retry = false;
+            f_full_device_retry_deferred = false;
+        });
+
+        for (auto net_id : wave) {
+            if (!net_retry_deferred[net_id]) {
+                continue;
+            }
+            //Reroute the net from scratch, now that no other net is being routed
+            rip_up_deferred_net(net_id, pres_fac);
+
+            bool was_rerouted = false;
+            net_is_routable[net_id] = try_timing_driven_route_net(net_id,
+                                                                  itry,
+                                                                  pres_fac,
+                                                                  router_opts,
+                                                                  connections_inf,
+                                                                  router_stats,
+                                                                  route_structs.pin_criticality,
+                                                                  route_structs.rt_node_of_sink,
+                                                                  net_delay,
+                                                                  router_lookahead,
+                                                                  netlist_pin_lookup,
+                                                                  timing_info,
+                                                                  budgeting_inf,
+                                                                  was_rerouted);
+            net_was_rerouted[net_id] = true;
+            net_retry_deferred[net_id] = false;
+        }
+
+        for (auto net_id : wave) {
+            if (!net_is_routable[net_id]) {
+                return false; //Impossible to route
+            }
+        }
+    }
+
+    for (const RouterStats& stats : thread_stats) {
+        router_stats.connections_routed += stats.connections_routed;
+        router_stats.nets_routed += stats.nets_routed;
+        router_stats.heap_pushes += stats.heap_pushes;
+        router_stats.heap_pops += stats.heap_pops;
+    }
+
+    for (auto net_id : sorted_nets) {
+        if (net_was_rerouted[net_id]) {
+            rerouted_nets.push_back(net_id);
+        }
+    }
+
+    return true;
+}
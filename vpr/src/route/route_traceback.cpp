@@ -53,3 +53,40 @@ void swap(t_traceback& first, t_traceback& second) {
     swap(first.head, second.head);
     swap(first.tail, second.tail);
 }
+
+void t_routed_net_nodes::load(const vtr::vector<ClusterNetId, t_traceback>& trace) {
+    clear();
+
+    //Size the arrays first, so that they are allocated only once
+    size_t num_nodes = 0;
+    for (const t_traceback& net_trace : trace) {
+        for (const t_trace* tptr = net_trace.head; tptr != nullptr; tptr = tptr->next) {
+            ++num_nodes;
+        }
+    }
+    net_starts.reserve(trace.size() + 1);
+    nodes.reserve(num_nodes);
+
+    net_starts.push_back(0);
+    for (const t_traceback& net_trace : trace) {
+        for (const t_trace* tptr = net_trace.head; tptr != nullptr; tptr = tptr->next) {
+            nodes.push_back(tptr->index);
+        }
+        net_starts.push_back(nodes.size());
+    }
+}
+
+void t_routed_net_nodes::clear() {
+    net_starts.clear();
+    nodes.clear();
+}
+
+size_t t_routed_net_nodes::num_nets() const {
+    return net_starts.empty() ? 0 : net_starts.size() - 1;
+}
+
+t_routed_net_nodes::node_range t_routed_net_nodes::net_nodes(const ClusterNetId& net_id) const {
+    VTR_ASSERT(size_t(net_id) < num_nets());
+    return vtr::make_range(nodes.begin() + net_starts[size_t(net_id)],
+                           nodes.begin() + net_starts[size_t(net_id) + 1]);
+}
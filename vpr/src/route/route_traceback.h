@@ -1,6 +1,13 @@
 #ifndef VPR_TRACEBACK_H
 #define VPR_TRACEBACK_H
 
+#include <vector>
+
+#include "vtr_range.h"
+#include "vtr_vector.h"
+#include "clustered_netlist_fwd.h"
+#include "rr_graph_obj.h"
+
 struct t_trace; //Forward declaration
 
 struct t_traceback {
@@ -17,4 +24,28 @@ struct t_traceback {
     t_trace* tail = nullptr;
 };
 
+//The rr nodes of the tracebacks of all the nets, packed in a single array
+//(compressed rows indexed by net), so that the routing can be walked
+//without chasing the t_trace pointers.
+//
+//The nodes of a net are in the order of its traceback, including the
+//branch points which are repeated at the start of each branch.
+//It is a snapshot: it must be loaded again if the tracebacks change.
+struct t_routed_net_nodes {
+    typedef std::vector<RRNodeId>::const_iterator node_iterator;
+    typedef vtr::Range<node_iterator> node_range;
+
+    //Rebuild from the tracebacks of all the nets
+    void load(const vtr::vector<ClusterNetId, t_traceback>& trace);
+    void clear();
+
+    //Number of nets loaded, 0 if not loaded
+    size_t num_nets() const;
+    node_range net_nodes(const ClusterNetId& net_id) const;
+
+    //The nodes of net i are nodes[net_starts[i]..net_starts[i + 1] - 1]
+    std::vector<size_t> net_starts; //[0..num_nets]
+    std::vector<RRNodeId> nodes;
+};
+
 #endif
@@ -29,13 +29,16 @@
 
 static vtr::vector<RRNodeId, t_rt_node*> rr_node_to_rt_node; /* [0..device_ctx.rr_graph.nodes().size()-1] */
 
-/* Frees lists for fast addition and deletion of nodes and edges. */
+/* Frees lists for fast addition and deletion of nodes and edges.
+ * Each thread owns its lists, so that nets can be routed concurrently */
 
-static t_rt_node* rt_node_free_list = nullptr;
-static t_linked_rt_edge* rt_edge_free_list = nullptr;
+static thread_local t_rt_node* rt_node_free_list = nullptr;
+static thread_local t_linked_rt_edge* rt_edge_free_list = nullptr;
 
 /********************** Subroutines local to this module *********************/
 
+static void free_route_tree_free_lists();
+
 static t_rt_node* alloc_rt_node();
 
 static void free_rt_node(t_rt_node* rt_node);
@@ -93,11 +96,32 @@ void free_route_tree_timing_structs() {
     /* Frees the structures needed to build routing trees, and really frees
      * (i.e. calls free) all the data on the free lists.                         */
 
+    rr_node_to_rt_node.clear();
+
+    free_route_tree_free_lists();
+}
+
+/* Frees the free lists of a thread when the thread exits */
+struct t_route_tree_thread_cleanup {
+    ~t_route_tree_thread_cleanup() {
+        free_route_tree_free_lists();
+    }
+};
+
+void init_route_tree_thread_structs() {
+    /* Call this in a thread before it builds any routing trees, other than the
+     * thread which called alloc_route_tree_timing_structs().                    */
+    static thread_local t_route_tree_thread_cleanup route_tree_cleanup;
+    (void)route_tree_cleanup;
+}
+
+static void free_route_tree_free_lists() {
+    /* Really frees (i.e. calls free) all the data on the free lists of the
+     * calling thread.                                                           */
+
     t_rt_node *rt_node, *next_node;
     t_linked_rt_edge *rt_edge, *next_edge;
 
-    rr_node_to_rt_node.clear();
-
     rt_node = rt_node_free_list;
 
     while (rt_node != nullptr) {
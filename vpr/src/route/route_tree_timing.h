@@ -13,6 +13,9 @@ bool alloc_route_tree_timing_structs(bool exists_ok = false);
 
 void free_route_tree_timing_structs();
 
+//Registers the release of the free lists of the calling thread at thread exit
+void init_route_tree_thread_structs();
+
 t_rt_node* init_route_tree_to_source(ClusterNetId inet);
 
 void free_route_tree(t_rt_node* rt_node);
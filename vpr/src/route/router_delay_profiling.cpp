@@ -155,6 +155,70 @@ vtr::vector<RRNodeId, float> calculate_all_path_delays_from_rr_node(const RRNode
     return path_delays_to;
 }
 
+//Returns the shortest path delay from src_node to each of the sink_rr_nodes, or NaN if no path exists.
+//All the sinks are reached by a single expansion from the source, which is much faster than
+//routing the connections one by one when delays to many sinks are needed (e.g. for the placement delay model)
+std::vector<float> calculate_path_delays_from_rr_node(const RRNodeId& src_rr_node, const std::vector<RRNodeId>& sink_rr_nodes, const t_router_opts& router_opts) {
+    auto& device_ctx = g_vpr_ctx.device();
+
+    std::vector<float> path_delays_to(sink_rr_nodes.size(), std::numeric_limits<float>::quiet_NaN());
+
+    t_rt_node* rt_root = setup_routing_resources_no_net(src_rr_node);
+
+    /* Update base costs according to fanout and criticality rules, as for calculate_delay() */
+    update_rr_base_costs(1);
+
+    t_bb bounding_box;
+    bounding_box.xmin = 0;
+    bounding_box.xmax = device_ctx.grid.width() + 1;
+    bounding_box.ymin = 0;
+    bounding_box.ymax = device_ctx.grid.height() + 1;
+
+    t_conn_cost_params cost_params;
+    cost_params.criticality = 1.;
+    cost_params.astar_fac = router_opts.astar_fac;
+    cost_params.bend_cost = router_opts.bend_cost;
+
+    std::vector<RRNodeId> modified_rr_node_inf;
+    RouterStats router_stats;
+
+    init_heap(device_ctx.grid);
+
+    vtr::vector<RRNodeId, t_heap> shortest_paths = timing_driven_find_all_shortest_paths_from_route_tree(rt_root,
+                                                                                                         cost_params,
+                                                                                                         bounding_box,
+                                                                                                         modified_rr_node_inf,
+                                                                                                         router_stats);
+
+    free_route_tree(rt_root);
+
+    VTR_ASSERT(shortest_paths.size() == device_ctx.rr_graph.nodes().size());
+    for (size_t isink = 0; isink < sink_rr_nodes.size(); ++isink) {
+        const RRNodeId& sink_rr_node = sink_rr_nodes[isink];
+        if (sink_rr_node == src_rr_node) {
+            path_delays_to[isink] = 0.;
+        } else {
+            if (shortest_paths[sink_rr_node].index == RRNodeId::INVALID()) continue;
+
+            VTR_ASSERT(shortest_paths[sink_rr_node].index == sink_rr_node);
+
+            //Build the routing tree to get the delay
+            rt_root = setup_routing_resources_no_net(src_rr_node);
+            t_rt_node* rt_node_of_sink = update_route_tree(&shortest_paths[sink_rr_node], nullptr);
+
+            VTR_ASSERT(rt_node_of_sink->inode == sink_rr_node);
+
+            path_delays_to[isink] = rt_node_of_sink->Tdel;
+
+            free_route_tree(rt_root);
+        }
+    }
+    reset_path_costs(modified_rr_node_inf);
+    empty_heap();
+
+    return path_delays_to;
+}
+
 static t_rt_node* setup_routing_resources_no_net(const RRNodeId& source_node) {
     /* Build and return a partial route tree from the legal connections from last iteration.
      * along the way do:
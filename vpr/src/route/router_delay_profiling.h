@@ -17,6 +17,8 @@ class RouterDelayProfiler {
 
 vtr::vector<RRNodeId, float> calculate_all_path_delays_from_rr_node(const RRNodeId& src_rr_node, const t_router_opts& router_opts);
 
+std::vector<float> calculate_path_delays_from_rr_node(const RRNodeId& src_rr_node, const std::vector<RRNodeId>& sink_rr_nodes, const t_router_opts& router_opts);
+
 void alloc_routing_structs(t_chan_width chan_width,
                            const t_router_opts& router_opts,
                            t_det_routing_arch* det_routing_arch,
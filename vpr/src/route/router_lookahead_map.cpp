@@ -28,6 +28,18 @@
 #include "rr_graph_obj_util.h"
 #include "router_lookahead_map.h"
 
+#if defined(VPR_USE_TBB)
+#    include <tbb/parallel_for.h>
+#endif
+
+#ifdef VTR_ENABLE_CAPNPROTO
+#    include "capnp/serialize.h"
+#    include "map_lookahead.capnp.h"
+#    include "ndmatrix_serdes.h"
+#    include "mmap_file.h"
+#    include "serdes_utils.h"
+#endif /* VTR_ENABLE_CAPNPROTO */
+
 /* the cost map is computed by running a Dijkstra search from channel segment rr nodes at the specified reference coordinate */
 #define REF_X 3
 #define REF_Y 3
@@ -97,6 +109,13 @@ class Expansion_Cost_Entry {
             this->cost_vector.push_back(cost_entry);
         }
     }
+    /* appends the cost entries of another expansion (e.g. a Dijkstra run from another start node), in their order,
+     * as if they had been added to this one */
+    void add_cost_entries(const Expansion_Cost_Entry& other) {
+        for (const Cost_Entry& entry : other.cost_vector) {
+            this->add_cost_entry(entry.delay, entry.congestion);
+        }
+    }
     void clear_cost_entries() {
         this->cost_vector.clear();
     }
@@ -259,20 +278,46 @@ void compute_router_lookahead(int num_segments) {
             /* allocate the cost map for this iseg/chan_type */
             t_routing_cost_map routing_cost_map({device_ctx.grid.width(), device_ctx.grid.height()});
 
+            /* collect the rr node indices from which to start routing, with their reference coordinates */
+            std::vector<RRNodeId> start_nodes;
+            std::vector<int> start_incs;
             for (int ref_inc = 0; ref_inc < 3; ref_inc++) {
                 for (int track_offset = 0; track_offset < MAX_TRACK_OFFSET; track_offset += 2) {
-                    /* get the rr node index from which to start routing */
                     RRNodeId start_node_ind = get_start_node_ind(REF_X + ref_inc, REF_Y + ref_inc,
-                                                            device_ctx.grid.width() - 2, device_ctx.grid.height() - 2, //non-corner upper right
-                                                            chan_type, iseg, track_offset);
+                                                                 device_ctx.grid.width() - 2, device_ctx.grid.height() - 2, //non-corner upper right
+                                                                 chan_type, iseg, track_offset);
 
                     if (start_node_ind == RRNodeId::INVALID()) {
                         continue;
                     }
+                    start_nodes.push_back(start_node_ind);
+                    start_incs.push_back(ref_inc);
+                }
+            }
 
-                    /* run Dijkstra's algorithm */
-                    run_dijkstra(start_node_ind, REF_X + ref_inc, REF_Y + ref_inc, routing_cost_map);
+            /* run Dijkstra's algorithm from each start node. The runs are independent: each one has its own
+             * expansion queue and cost map, which are merged afterwards in the order of the start nodes,
+             * so that the lookahead is the same whatever the number of threads */
+            std::vector<t_routing_cost_map> start_cost_maps(start_nodes.size(), routing_cost_map);
+            auto run_start_node = [&](size_t istart) {
+                run_dijkstra(start_nodes[istart], REF_X + start_incs[istart], REF_Y + start_incs[istart], start_cost_maps[istart]);
+            };
+#if defined(VPR_USE_TBB)
+            tbb::parallel_for(size_t(0), start_nodes.size(), run_start_node);
+#else
+            for (size_t istart = 0; istart < start_nodes.size(); istart++) {
+                run_start_node(istart);
+            }
+#endif
+
+            for (t_routing_cost_map& start_cost_map : start_cost_maps) {
+                for (size_t ix = 0; ix < routing_cost_map.dim_size(0); ix++) {
+                    for (size_t iy = 0; iy < routing_cost_map.dim_size(1); iy++) {
+                        routing_cost_map[ix][iy].add_cost_entries(start_cost_map[ix][iy]);
+                    }
                 }
+                /* release the memory as soon as possible */
+                start_cost_map.clear();
             }
 
             /* boil down the cost list in routing_cost_map at each coordinate to a representative cost entry and store it in the lookahead
@@ -676,3 +721,67 @@ static void print_cost_map() {
         }
     }
 }
+
+// When writing capnp targetted serialization, always allow compilation when
+// VTR_ENABLE_CAPNPROTO=OFF.  Generally this means throwing an exception
+// instead.
+//
+#ifndef VTR_ENABLE_CAPNPROTO
+
+#    define DISABLE_ERROR                              \
+        "is disable because VTR_ENABLE_CAPNPROTO=OFF." \
+        "Re-compile with CMake option VTR_ENABLE_CAPNPROTO=ON to enable."
+
+void read_router_lookahead(const std::string& /*file*/) {
+    VPR_THROW(VPR_ERROR_ROUTE, "MapLookahead::read " DISABLE_ERROR);
+}
+
+void write_router_lookahead(const std::string& /*file*/) {
+    VPR_THROW(VPR_ERROR_ROUTE, "MapLookahead::write " DISABLE_ERROR);
+}
+
+#else /* VTR_ENABLE_CAPNPROTO */
+
+static void ToCostEntry(Cost_Entry* out, const VprMapCostEntry::Reader& in) {
+    out->delay = in.getDelay();
+    out->congestion = in.getCongestion();
+}
+
+static void FromCostEntry(VprMapCostEntry::Builder* out, const Cost_Entry& in) {
+    out->setDelay(in.delay);
+    out->setCongestion(in.congestion);
+}
+
+void read_router_lookahead(const std::string& file) {
+    vtr::ScopedStartFinishTimer timer("Loading router lookahead map");
+
+    MmapFile f(file);
+    ::capnp::FlatArrayMessageReader reader(f.getData());
+
+    auto lookahead = reader.getRoot<VprMapLookahead>();
+
+    ToNdMatrix<4, VprMapCostEntry, Cost_Entry>(&f_cost_map, lookahead.getCostMap(), ToCostEntry);
+
+    /* The map must cover the relative distances of the current device */
+    auto& device_ctx = g_vpr_ctx.device();
+    if (f_cost_map.dim_size(0) != 2
+        || f_cost_map.dim_size(2) != device_ctx.grid.width()
+        || f_cost_map.dim_size(3) != device_ctx.grid.height()) {
+        VPR_THROW(VPR_ERROR_ROUTE,
+                  "Router lookahead map in '%s' does not match the device grid (%zu x %zu)",
+                  file.c_str(), device_ctx.grid.width(), device_ctx.grid.height());
+    }
+}
+
+void write_router_lookahead(const std::string& file) {
+    ::capnp::MallocMessageBuilder builder;
+
+    auto lookahead = builder.initRoot<VprMapLookahead>();
+
+    auto cost_map = lookahead.getCostMap();
+    FromNdMatrix<4, VprMapCostEntry, Cost_Entry>(&cost_map, f_cost_map, FromCostEntry);
+
+    writeMessageToFile(file, &builder);
+}
+
+#endif
@@ -1,9 +1,16 @@
 #pragma once
 
+#include <string>
+
 /* Computes the lookahead map to be used by the router. If a map was computed prior to this, a new one will not be computed again.
  * The rr graph must have been built before calling this function. */
 void compute_router_lookahead(int num_segments);
 
+/* Reads and writes the lookahead map from/to a file, so that it can be reused by the runs on the same rr graph.
+ * Both require VTR_ENABLE_CAPNPROTO, otherwise an error is thrown */
+void read_router_lookahead(const std::string& file);
+void write_router_lookahead(const std::string& file);
+
 /* queries the lookahead_map (should have been computed prior to routing) to get the expected cost
  * from the specified source to the specified target */
 float get_lookahead_map_cost(const RRNodeId& from_node_ind, const RRNodeId& to_node_ind, float criticality_fac);
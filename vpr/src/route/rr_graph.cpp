@@ -38,6 +38,7 @@
 
 #include "create_rr_graph.h"
 #include "write_xml_rr_graph_obj.h"
+#include "rr_graph_capnp.h"
 #include "rr_graph_obj_util.h"
 #include "check_rr_graph_obj.h"
 
@@ -306,7 +307,8 @@ void create_rr_graph(const t_graph_type graph_type,
                          segment_inf,
                          base_cost_type,
                          &det_routing_arch->wire_to_rr_ipin_switch,
-                         det_routing_arch->read_rr_graph_filename.c_str());
+                         det_routing_arch->read_rr_graph_filename.c_str(),
+                         det_routing_arch->check_rr_graph);
 
             /* Xifan Tang - Create rr_graph object: load rr_nodes to the object */
             //convert_rr_graph(segment_inf);
@@ -368,6 +370,7 @@ void create_rr_graph(const t_graph_type graph_type,
                                                     &det_routing_arch->wire_to_rr_ipin_switch,
                                                     trim_obs_channels, /* Allow/Prohibit through tracks across multi-height and multi-width grids */
                                                     false, /* Do not allow passing tracks to be wired to the same routing channels */
+                                                    det_routing_arch->num_threads,
                                                     Warnings);
         }
 
@@ -380,7 +383,10 @@ void create_rr_graph(const t_graph_type graph_type,
     print_rr_graph_stats();
 
     //Write out rr graph file if needed
-    if (!det_routing_arch->write_rr_graph_filename.empty()) {
+    if (vtr::check_file_name_extension(det_routing_arch->write_rr_graph_filename.c_str(), ".capnp")) {
+        //A binary RR graph is written directly from the rr_graph object
+        write_capnp_rr_graph(det_routing_arch->write_rr_graph_filename.c_str(), device_ctx.rr_graph);
+    } else if (!det_routing_arch->write_rr_graph_filename.empty()) {
         write_rr_graph(det_routing_arch->write_rr_graph_filename.c_str(), segment_inf);
 
         /* Just to test the writer of rr_graph_obj, give a filename in a fixed style*/
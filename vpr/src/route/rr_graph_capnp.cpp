@@ -0,0 +1,741 @@
+/*
+ * This file defines the reader and the writer of the routing resource graph
+ * in the binary Cap'n Proto format.
+ *
+ * The message contains the same information as the XML format (see
+ * rr_graph_reader.cpp and write_xml_rr_graph_obj.cpp). The reader memory-maps
+ * the file and loads the graph into the RRGraph object in device_ctx, after
+ * verifying that the grid, the block types and the segments of the message
+ * match the architecture.
+ */
+#include <cstring>
+#include <limits>
+
+#include "vtr_version.h"
+#include "vtr_assert.h"
+#include "vtr_log.h"
+#include "vtr_time.h"
+
+#include "read_xml_arch_file.h"
+#include "globals.h"
+#include "vpr_utils.h"
+#include "vpr_error.h"
+#include "rr_graph.h"
+#include "rr_node.h"
+#include "rr_metadata.h"
+#include "rr_graph_indexed_data.h"
+#include "check_rr_graph.h"
+#include "check_rr_graph_obj.h"
+
+#include "rr_graph_capnp.h"
+
+#ifdef VTR_ENABLE_CAPNPROTO
+#    include "capnp/serialize.h"
+#    include "kj/exception.h"
+#    include "rr_graph.capnp.h"
+#    include "mmap_file.h"
+#    include "serdes_utils.h"
+#endif /* VTR_ENABLE_CAPNPROTO */
+
+//
+// When VPR is compiled with VTR_ENABLE_CAPNPROTO=OFF, the binary format
+// is not available, and the functions throw an exception instead.
+//
+#ifndef VTR_ENABLE_CAPNPROTO
+
+#    define DISABLE_ERROR                              \
+        "is disable because VTR_ENABLE_CAPNPROTO=OFF." \
+        "Re-compile with CMake option VTR_ENABLE_CAPNPROTO=ON to enable."
+
+void load_capnp_rr_file(const t_graph_type /*graph_type*/,
+                        const DeviceGrid& /*grid*/,
+                        const std::vector<t_segment_inf>& /*segment_inf*/,
+                        const enum e_base_cost_type /*base_cost_type*/,
+                        int* /*wire_to_rr_ipin_switch*/,
+                        const char* /*read_rr_graph_name*/,
+                        const bool& /*do_check_rr_graph*/) {
+    VPR_THROW(VPR_ERROR_ROUTE, "Reading binary RR graph " DISABLE_ERROR);
+}
+
+void write_capnp_rr_graph(const char* /*file_name*/, const RRGraph& /*rr_graph*/) {
+    VPR_THROW(VPR_ERROR_ROUTE, "Writing binary RR graph " DISABLE_ERROR);
+}
+
+#else /* VTR_ENABLE_CAPNPROTO */
+
+/* The enums of the message are in the same order as their counterparts */
+static_assert(int(VprRrNodeType::CHANY) == int(CHANY), "Node types of rr_graph.capnp differ from t_rr_type");
+static_assert(int(VprRrDirection::NO_DIRECTION) == int(NO_DIRECTION), "Directions of rr_graph.capnp differ from e_direction");
+static_assert(int(VprRrSide::LEFT) == int(LEFT), "Sides of rr_graph.capnp differ from e_side");
+static_assert(int(VprRrSwitchType::BUFFER) == int(SwitchType::BUFFER), "Switch types of rr_graph.capnp differ from SwitchType");
+
+/* A capnp list holds up to 2^29 - 1 elements */
+constexpr size_t MAX_CAPNP_LIST_SIZE = (size_t(1) << 29) - 1;
+
+static VprRrPinClassType to_capnp_pin_class_type(const e_pin_type& type) {
+    if (DRIVER == type) {
+        return VprRrPinClassType::OUTPUT;
+    } else if (RECEIVER == type) {
+        return VprRrPinClassType::INPUT;
+    }
+    return VprRrPinClassType::OPEN;
+}
+
+static e_pin_type from_capnp_pin_class_type(const VprRrPinClassType& type) {
+    if (VprRrPinClassType::OUTPUT == type) {
+        return DRIVER;
+    } else if (VprRrPinClassType::INPUT == type) {
+        return RECEIVER;
+    }
+    return OPEN;
+}
+
+static void check_list_size(size_t size, const char* list_name) {
+    if (size > MAX_CAPNP_LIST_SIZE) {
+        VPR_THROW(VPR_ERROR_ROUTE,
+                  "Number of %s (%zu) exceeds the capacity of binary RR graph (%zu)",
+                  list_name, size, MAX_CAPNP_LIST_SIZE);
+    }
+}
+
+static void fill_capnp_metadata(::capnp::List<VprRrMeta>::Builder metas, const t_metadata_dict& meta) {
+    size_t imeta = 0;
+    for (const auto& meta_elem : meta) {
+        for (const auto& value : meta_elem.second) {
+            metas[imeta].setName(meta_elem.first);
+            metas[imeta].setValue(value.as_string());
+            ++imeta;
+        }
+    }
+}
+
+static size_t count_metadata_values(const t_metadata_dict& meta) {
+    size_t num_values = 0;
+    for (const auto& meta_elem : meta) {
+        num_values += meta_elem.second.size();
+    }
+    return num_values;
+}
+
+/* Grid was initialized from the architecture file. This function checks
+ * if it corresponds to the RR graph. Errors out if it doesn't correspond*/
+static void verify_capnp_grid(::capnp::List<VprRrGridLoc>::Reader grid_locs, const DeviceGrid& grid) {
+    for (const auto& grid_loc : grid_locs) {
+        int x = grid_loc.getX();
+        int y = grid_loc.getY();
+        if (x < 0 || size_t(x) >= grid.width() || y < 0 || size_t(y) >= grid.height()) {
+            VPR_FATAL_ERROR(VPR_ERROR_OTHER,
+                            "Architecture file does not match RR graph's grid: (%d, %d) is out of the device grid (%zu x %zu)",
+                            x, y, grid.width(), grid.height());
+        }
+
+        const t_grid_tile& grid_tile = grid[x][y];
+        if (grid_tile.type->index != grid_loc.getBlockTypeId()) {
+            VPR_FATAL_ERROR(VPR_ERROR_OTHER,
+                            "Architecture file does not match RR graph's block_type_id at (%d, %d): arch used ID %d, RR graph used ID %d.", x, y,
+                            grid_tile.type->index, grid_loc.getBlockTypeId());
+        }
+        if (grid_tile.width_offset != grid_loc.getWidthOffset()) {
+            VPR_FATAL_ERROR(VPR_ERROR_OTHER,
+                            "Architecture file does not match RR graph's width_offset at (%d, %d)", x, y);
+        }
+        if (grid_tile.height_offset != grid_loc.getHeightOffset()) {
+            VPR_FATAL_ERROR(VPR_ERROR_OTHER,
+                            "Architecture file does not match RR graph's height_offset at (%d, %d)", x, y);
+        }
+    }
+}
+
+/* Blocks were initialized from the architecture file. This function checks
+ * if it corresponds to the RR graph. Errors out if it doesn't correspond*/
+static void verify_capnp_blocks(::capnp::List<VprRrBlockType>::Reader block_types) {
+    auto& device_ctx = g_vpr_ctx.device();
+
+    if (block_types.size() != device_ctx.physical_tile_types.size()) {
+        VPR_FATAL_ERROR(VPR_ERROR_OTHER,
+                        "Architecture file does not match RR graph's block types: arch has %zu types, RR graph has %u types",
+                        device_ctx.physical_tile_types.size(), block_types.size());
+    }
+
+    for (size_t itype = 0; itype < block_types.size(); ++itype) {
+        const auto& block_type = block_types[itype];
+        const t_physical_tile_type& block_info = device_ctx.physical_tile_types[itype];
+
+        if (0 != strcmp(block_info.name, block_type.getName().cStr())) {
+            VPR_FATAL_ERROR(VPR_ERROR_OTHER,
+                            "Architecture file does not match RR graph's block name: arch uses name %s, RR graph uses name %s",
+                            block_info.name, block_type.getName().cStr());
+        }
+        if (block_info.width != block_type.getWidth()) {
+            VPR_FATAL_ERROR(VPR_ERROR_OTHER,
+                            "Architecture file does not match RR graph's block width");
+        }
+        if (block_info.height != block_type.getHeight()) {
+            VPR_FATAL_ERROR(VPR_ERROR_OTHER,
+                            "Architecture file does not match RR graph's block height");
+        }
+
+        auto pin_classes = block_type.getPinClasses();
+        if (block_info.num_class != int(pin_classes.size())) {
+            VPR_FATAL_ERROR(VPR_ERROR_OTHER,
+                            "Incorrect number of pin classes in block %s", block_info.name);
+        }
+        for (int iclass = 0; iclass < block_info.num_class; ++iclass) {
+            const t_class& class_inf = block_info.class_inf[iclass];
+            const auto& pin_class = pin_classes[iclass];
+
+            if (class_inf.type != from_capnp_pin_class_type(pin_class.getType())) {
+                VPR_FATAL_ERROR(VPR_ERROR_OTHER,
+                                "Architecture file does not match RR graph's block type");
+            }
+
+            auto pins = pin_class.getPins();
+            if (class_inf.num_pins != int(pins.size())) {
+                VPR_FATAL_ERROR(VPR_ERROR_OTHER,
+                                "Incorrect number of pins in %d pin_class in block %s", iclass, block_info.name);
+            }
+            for (int ipin = 0; ipin < class_inf.num_pins; ++ipin) {
+                if (class_inf.pinlist[ipin] != pins[ipin].getPtc()
+                    || block_type_pin_index_to_name(&block_info, class_inf.pinlist[ipin]) != pins[ipin].getName().cStr()) {
+                    VPR_FATAL_ERROR(VPR_ERROR_OTHER,
+                                    "Architecture file does not match RR graph's block pin list");
+                }
+            }
+        }
+    }
+}
+
+/* Segments was initialized already. This function checks
+ * if it corresponds to the RR graph. Errors out if it doesn't correspond*/
+static void verify_capnp_segments(::capnp::List<VprRrSegment>::Reader segments, const std::vector<t_segment_inf>& segment_inf) {
+    if (segments.size() != segment_inf.size()) {
+        VPR_FATAL_ERROR(VPR_ERROR_OTHER,
+                        "Architecture file does not match RR graph's segments: arch has %zu segments, RR graph has %u segments",
+                        segment_inf.size(), segments.size());
+    }
+
+    for (size_t iseg = 0; iseg < segments.size(); ++iseg) {
+        const auto& segment = segments[iseg];
+        if (segment_inf[iseg].name != segment.getName().cStr()) {
+            VPR_FATAL_ERROR(VPR_ERROR_OTHER,
+                            "Architecture file does not match RR graph's segment name: arch uses %s, RR graph uses %s",
+                            segment_inf[iseg].name.c_str(), segment.getName().cStr());
+        }
+        if (segment_inf[iseg].Rmetal != segment.getRPerMeter()) {
+            VPR_FATAL_ERROR(VPR_ERROR_OTHER,
+                            "Architecture file does not match RR graph's segment R_per_meter");
+        }
+        if (segment_inf[iseg].Cmetal != segment.getCPerMeter()) {
+            VPR_FATAL_ERROR(VPR_ERROR_OTHER,
+                            "Architecture file does not match RR graph's segment C_per_meter");
+        }
+    }
+}
+
+/* All channel info is read in and loaded into chan_width*/
+static void load_capnp_channels(t_chan_width& chan_width, const DeviceGrid& grid, VprRrChannels::Reader channels) {
+    chan_width.max = channels.getChanWidthMax();
+    chan_width.x_min = channels.getXMin();
+    chan_width.y_min = channels.getYMin();
+    chan_width.x_max = channels.getXMax();
+    chan_width.y_max = channels.getYMax();
+    chan_width.x_list.resize(grid.height());
+    chan_width.y_list.resize(grid.width());
+
+    auto x_list = channels.getXList();
+    auto y_list = channels.getYList();
+    if (x_list.size() > chan_width.x_list.size() || y_list.size() > chan_width.y_list.size()) {
+        VPR_FATAL_ERROR(VPR_ERROR_OTHER,
+                        "Channel lists of RR graph (%u, %u) exceed the device grid (%zu x %zu)",
+                        x_list.size(), y_list.size(), grid.width(), grid.height());
+    }
+    for (size_t i = 0; i < x_list.size(); ++i) {
+        chan_width.x_list[i] = x_list[i];
+    }
+    for (size_t i = 0; i < y_list.size(); ++i) {
+        chan_width.y_list[i] = y_list[i];
+    }
+}
+
+/* Reads in the switch information and adds it to device_ctx.rr_switch_inf and the RRGraph */
+static void load_capnp_switches(::capnp::List<VprRrSwitch>::Reader switches) {
+    auto& device_ctx = g_vpr_ctx.mutable_device();
+
+    device_ctx.rr_switch_inf.resize(switches.size());
+    for (size_t iswitch = 0; iswitch < switches.size(); ++iswitch) {
+        const auto& cur_switch = switches[iswitch];
+        auto& rr_switch = device_ctx.rr_switch_inf[iswitch];
+
+        //Switch names point to the names of architecture switches
+        const char* name = nullptr;
+        if (0 < cur_switch.getName().size()) {
+            for (int i = 0; i < device_ctx.num_arch_switches; ++i) {
+                if (0 == strcmp(cur_switch.getName().cStr(), device_ctx.arch_switch_inf[i].name)) {
+                    name = device_ctx.arch_switch_inf[i].name;
+                    break;
+                }
+            }
+            if (nullptr == name) {
+                VPR_FATAL_ERROR(VPR_ERROR_ROUTE, "Switch name '%s' not found in architecture\n", cur_switch.getName().cStr());
+            }
+        }
+        rr_switch.name = name;
+
+        rr_switch.set_type(SwitchType(int(cur_switch.getType())));
+        rr_switch.R = cur_switch.getR();
+        rr_switch.Cin = cur_switch.getCin();
+        rr_switch.Cout = cur_switch.getCout();
+        rr_switch.Cinternal = cur_switch.getCinternal();
+        rr_switch.Tdel = cur_switch.getTdel();
+        rr_switch.mux_trans_size = cur_switch.getMuxTransSize();
+        rr_switch.buf_size = cur_switch.getBufSize();
+    }
+
+    device_ctx.rr_graph.reserve_switches(device_ctx.rr_switch_inf.size());
+    for (size_t iswitch = 0; iswitch < device_ctx.rr_switch_inf.size(); ++iswitch) {
+        device_ctx.rr_graph.create_switch(device_ctx.rr_switch_inf[iswitch]);
+    }
+}
+
+/* Node info are processed in the sequence of their ids */
+static void load_capnp_nodes(::capnp::List<VprRrNode>::Reader nodes, const size_t& num_segments) {
+    auto& device_ctx = g_vpr_ctx.mutable_device();
+    auto& rr_graph = device_ctx.rr_graph;
+
+    rr_graph.reserve_nodes(nodes.size());
+    for (const auto& cur_node : nodes) {
+        t_rr_type node_type = t_rr_type(int(cur_node.getType()));
+        if (node_type >= NUM_RR_TYPES) {
+            VPR_FATAL_ERROR(VPR_ERROR_OTHER, "Invalid type of RR node %zu", rr_graph.nodes().size());
+        }
+
+        const RRNodeId& node = rr_graph.create_node(node_type);
+
+        if (CHANX == node_type || CHANY == node_type) {
+            rr_graph.set_node_direction(node, e_direction(int(cur_node.getDirection())));
+        }
+        if (IPIN == node_type || OPIN == node_type) {
+            rr_graph.set_node_side(node, e_side(int(cur_node.getSide())));
+        }
+
+        rr_graph.set_node_capacity(node, cur_node.getCapacity());
+        rr_graph.set_node_bounding_box(node, vtr::Rect<short>(cur_node.getXlow(), cur_node.getYlow(),
+                                                              cur_node.getXhigh(), cur_node.getYhigh()));
+        rr_graph.set_node_ptc_num(node, cur_node.getPtc());
+        rr_graph.set_node_rc_data_index(node, find_create_rr_rc_data(cur_node.getR(), cur_node.getC()));
+
+        int seg_id = cur_node.getSegmentId();
+        if (seg_id >= int(num_segments)) {
+            VPR_FATAL_ERROR(VPR_ERROR_OTHER,
+                            "segment_id %d of RR node %zu is larger than the number of segments %zu",
+                            seg_id, size_t(node), num_segments);
+        }
+    }
+}
+
+/* Loads the edges in the sequence of their ids. Nodes and switches must be loaded
+ * before calling this function */
+static void load_capnp_edges(VprRrGraph::Reader rr_graph_msg, int* wire_to_rr_ipin_switch) {
+    auto& device_ctx = g_vpr_ctx.mutable_device();
+    auto& rr_graph = device_ctx.rr_graph;
+
+    auto src_nodes = rr_graph_msg.getEdgeSrcNodes();
+    auto sink_nodes = rr_graph_msg.getEdgeSinkNodes();
+    auto switches = rr_graph_msg.getEdgeSwitches();
+    if (src_nodes.size() != sink_nodes.size() || src_nodes.size() != switches.size()) {
+        VPR_FATAL_ERROR(VPR_ERROR_OTHER,
+                        "Inconsistent edge lists of RR graph: %u source nodes, %u sink nodes, %u switches",
+                        src_nodes.size(), sink_nodes.size(), switches.size());
+    }
+
+    size_t num_nodes = rr_graph.nodes().size();
+    size_t num_rr_switches = device_ctx.rr_switch_inf.size();
+
+    //Check the edges and their number per node
+    vtr::vector<RRNodeId, size_t> num_edges_for_node(num_nodes, 0);
+    for (size_t iedge = 0; iedge < src_nodes.size(); ++iedge) {
+        if (src_nodes[iedge] >= num_nodes) {
+            VPR_FATAL_ERROR(VPR_ERROR_OTHER,
+                            "source_node %u is larger than rr_nodes.size() %zu",
+                            src_nodes[iedge], num_nodes);
+        }
+        if (sink_nodes[iedge] >= num_nodes) {
+            VPR_FATAL_ERROR(VPR_ERROR_OTHER,
+                            "sink_node %u is larger than rr_nodes.size() %zu",
+                            sink_nodes[iedge], num_nodes);
+        }
+        if (switches[iedge] >= num_rr_switches) {
+            VPR_FATAL_ERROR(VPR_ERROR_OTHER,
+                            "switch_id %u is larger than num_rr_switches %zu",
+                            switches[iedge], num_rr_switches);
+        }
+        num_edges_for_node[RRNodeId(src_nodes[iedge])]++;
+    }
+    for (const RRNodeId& inode : rr_graph.nodes()) {
+        /* See process_edges() in rr_graph_reader.cpp for the limit */
+        if (num_edges_for_node[inode] > 4 * std::numeric_limits<uint16_t>::max()) {
+            VPR_FATAL_ERROR(VPR_ERROR_OTHER,
+                            "source node %zu edge count %zu is too high",
+                            size_t(inode), num_edges_for_node[inode]);
+        }
+    }
+
+    rr_graph.reserve_edges(src_nodes.size());
+
+    /* Keep the most frequent switch which connects a wire to an ipin */
+    std::vector<int> count_for_wire_to_ipin_switches(num_rr_switches, 0);
+    //first is index, second is count
+    std::pair<int, int> most_frequent_switch(-1, 0);
+
+    for (size_t iedge = 0; iedge < src_nodes.size(); ++iedge) {
+        RRNodeId source_node = RRNodeId(src_nodes[iedge]);
+        RRNodeId sink_node = RRNodeId(sink_nodes[iedge]);
+        int switch_id = switches[iedge];
+
+        if ((CHANX == rr_graph.node_type(source_node) || CHANY == rr_graph.node_type(source_node))
+            && IPIN == rr_graph.node_type(sink_node)) {
+            count_for_wire_to_ipin_switches[switch_id]++;
+            if (count_for_wire_to_ipin_switches[switch_id] > most_frequent_switch.second) {
+                most_frequent_switch.first = switch_id;
+                most_frequent_switch.second = count_for_wire_to_ipin_switches[switch_id];
+            }
+        }
+
+        rr_graph.create_edge(source_node, sink_node, RRSwitchId(switch_id));
+    }
+    *wire_to_rr_ipin_switch = most_frequent_switch.first;
+}
+
+static void load_capnp_metadata(VprRrGraph::Reader rr_graph_msg) {
+    for (const auto& node_meta : rr_graph_msg.getNodeMetadata()) {
+        for (const auto& meta : node_meta.getMetas()) {
+            vpr::add_rr_node_metadata(node_meta.getNode(), meta.getName().cStr(), meta.getValue().cStr());
+        }
+    }
+    for (const auto& edge_meta : rr_graph_msg.getEdgeMetadata()) {
+        for (const auto& meta : edge_meta.getMetas()) {
+            vpr::add_rr_edge_metadata(edge_meta.getSrcNode(), edge_meta.getSinkNode(), edge_meta.getSwitchId(),
+                                      meta.getName().cStr(), meta.getValue().cStr());
+        }
+    }
+}
+
+/* Sets the cost index of nodes, where the cost indices of CHANX and CHANY
+ * depend on their segment ids, see set_cost_indices() in rr_graph_reader.cpp */
+static void set_capnp_cost_indices(::capnp::List<VprRrNode>::Reader nodes, const bool is_global_graph, const int num_seg_types) {
+    auto& rr_graph = g_vpr_ctx.mutable_device().rr_graph;
+
+    for (const RRNodeId& inode : rr_graph.nodes()) {
+        t_rr_type node_type = rr_graph.node_type(inode);
+        if (SOURCE == node_type) {
+            rr_graph.set_node_cost_index(inode, SOURCE_COST_INDEX);
+        } else if (SINK == node_type) {
+            rr_graph.set_node_cost_index(inode, SINK_COST_INDEX);
+        } else if (IPIN == node_type) {
+            rr_graph.set_node_cost_index(inode, IPIN_COST_INDEX);
+        } else if (OPIN == node_type) {
+            rr_graph.set_node_cost_index(inode, OPIN_COST_INDEX);
+        }
+
+        int seg_id = nodes[size_t(inode)].getSegmentId();
+        if (0 > seg_id) {
+            continue;
+        }
+        if (is_global_graph) {
+            rr_graph.set_node_cost_index(inode, 0);
+        } else if (CHANX == node_type) {
+            rr_graph.set_node_cost_index(inode, CHANX_COST_INDEX_START + seg_id);
+        } else if (CHANY == node_type) {
+            rr_graph.set_node_cost_index(inode, CHANX_COST_INDEX_START + num_seg_types + seg_id);
+        }
+    }
+}
+
+/* Assigns the nodes to their segments, after rr_indexed_data is allocated */
+static void load_capnp_seg_ids(::capnp::List<VprRrNode>::Reader nodes) {
+    auto& device_ctx = g_vpr_ctx.mutable_device();
+
+    for (const RRNodeId& inode : device_ctx.rr_graph.nodes()) {
+        int seg_id = nodes[size_t(inode)].getSegmentId();
+        if (0 > seg_id) {
+            continue;
+        }
+        device_ctx.rr_indexed_data[device_ctx.rr_graph.node_cost_index(inode)].seg_index = seg_id;
+        device_ctx.rr_graph.set_node_segment(inode, RRSegmentId(seg_id));
+    }
+}
+
+/* Loads the given binary RR graph file into the appropriate data structures,
+ * in the same way as load_rr_file() does for the XML format */
+void load_capnp_rr_file(const t_graph_type graph_type,
+                        const DeviceGrid& grid,
+                        const std::vector<t_segment_inf>& segment_inf,
+                        const enum e_base_cost_type base_cost_type,
+                        int* wire_to_rr_ipin_switch,
+                        const char* read_rr_graph_name,
+                        const bool& do_check_rr_graph) {
+    try {
+        MmapFile f(read_rr_graph_name);
+
+        /* A large graph exceeds the default traversal limit of capnp (64 MiB),
+         * while the message is read only once */
+        ::capnp::ReaderOptions options;
+        options.traversalLimitInWords = std::numeric_limits<uint64_t>::max();
+        ::capnp::FlatArrayMessageReader reader(f.getData(), options);
+
+        auto rr_graph_msg = reader.getRoot<VprRrGraph>();
+
+        auto& device_ctx = g_vpr_ctx.mutable_device();
+
+        //Check for errors
+        if (rr_graph_msg.hasToolVersion() && 0 != strcmp(rr_graph_msg.getToolVersion().cStr(), vtr::VERSION)) {
+            VTR_LOG("\n");
+            VTR_LOG_WARN("This architecture version is for VPR %s while your current VPR version is %s compatability issues may arise\n",
+                         vtr::VERSION, rr_graph_msg.getToolVersion().cStr());
+            VTR_LOG("\n");
+        }
+        std::string correct_string = "Generated from arch file ";
+        correct_string += get_arch_file_name();
+        if (rr_graph_msg.hasToolComment() && correct_string != rr_graph_msg.getToolComment().cStr()) {
+            VTR_LOG("\n");
+            VTR_LOG_WARN("This RR graph file is based on %s while your input architecture file is %s compatability issues may arise\n",
+                         get_arch_file_name(), rr_graph_msg.getToolComment().cStr());
+            VTR_LOG("\n");
+        }
+
+        //Compare with the architecture file to ensure consistency
+        verify_capnp_grid(rr_graph_msg.getGrid(), grid);
+        verify_capnp_blocks(rr_graph_msg.getBlockTypes());
+        verify_capnp_segments(rr_graph_msg.getSegments(), segment_inf);
+
+        VTR_LOG("Starting build routing resource graph...\n");
+
+        /* Add segments */
+        for (const auto& inf : segment_inf) {
+            device_ctx.rr_graph.create_segment(inf);
+        }
+
+        t_chan_width nodes_per_chan;
+        load_capnp_channels(nodes_per_chan, grid, rr_graph_msg.getChannels());
+
+        /* Decode the graph_type */
+        bool is_global_graph = (GRAPH_GLOBAL == graph_type ? true : false);
+
+        /* Global routing uses a single longwire track */
+        int max_chan_width = (is_global_graph ? 1 : nodes_per_chan.max);
+        VTR_ASSERT(max_chan_width > 0);
+
+        auto nodes = rr_graph_msg.getNodes();
+        load_capnp_nodes(nodes, segment_inf.size());
+
+        /* Loads edges, switches, and node look up tables*/
+        load_capnp_switches(rr_graph_msg.getSwitches());
+        load_capnp_edges(rr_graph_msg, wire_to_rr_ipin_switch);
+        load_capnp_metadata(rr_graph_msg);
+
+        //Partition the rr graph edges for efficient access to configurable/non-configurable
+        //edge subsets. Must be done after RR switches have been allocated
+        device_ctx.rr_graph.rebuild_node_edges();
+
+        //sets the cost index and seg id information
+        set_capnp_cost_indices(nodes, is_global_graph, segment_inf.size());
+
+        alloc_and_load_rr_indexed_data(segment_inf, device_ctx.rr_graph,
+                                       max_chan_width, *wire_to_rr_ipin_switch, base_cost_type);
+
+        load_capnp_seg_ids(nodes);
+
+        /* Essential check for rr_graph, build look-up */
+        if (false == device_ctx.rr_graph.validate()) {
+            /* Error out if built-in validator of rr_graph fails */
+            vpr_throw(VPR_ERROR_ROUTE,
+                      __FILE__,
+                      __LINE__,
+                      "Fundamental errors occurred when validating rr_graph object!\n");
+        }
+
+        device_ctx.chan_width = nodes_per_chan;
+        device_ctx.read_rr_graph_filename = std::string(read_rr_graph_name);
+
+        if (false == do_check_rr_graph) {
+            /* The very same file has already passed the checks */
+            VTR_LOG("Skipped checking the RR graph, which was checked before\n");
+        } else {
+            check_rr_graph(graph_type, grid, device_ctx.physical_tile_types);
+            /* Error out if advanced checker of rr_graph fails */
+            if (false == check_rr_graph(device_ctx.rr_graph)) {
+                vpr_throw(VPR_ERROR_ROUTE,
+                          __FILE__,
+                          __LINE__,
+                          "Advanced checking rr_graph object fails! Routing may still work "
+                          "but not smooth\n");
+            }
+        }
+    } catch (kj::Exception& e) {
+        vpr_throw(VPR_ERROR_ROUTE, read_rr_graph_name, e.getLine(), "%s", e.getDescription().cStr());
+    }
+}
+
+/* Writes the RR graph into a binary file, in the sequence of node and edge ids */
+void write_capnp_rr_graph(const char* file_name, const RRGraph& rr_graph) {
+    vtr::ScopedStartFinishTimer timer("Writing binary RR graph");
+
+    auto& device_ctx = g_vpr_ctx.device();
+
+    ::capnp::MallocMessageBuilder builder;
+    auto rr_graph_msg = builder.initRoot<VprRrGraph>();
+
+    rr_graph_msg.setToolName("vpr");
+    rr_graph_msg.setToolVersion(vtr::VERSION);
+    rr_graph_msg.setToolComment(std::string("Generated from arch file ") + get_arch_file_name());
+
+    /* Channels */
+    auto channels = rr_graph_msg.initChannels();
+    channels.setChanWidthMax(device_ctx.chan_width.max);
+    channels.setXMin(device_ctx.chan_width.x_min);
+    channels.setYMin(device_ctx.chan_width.y_min);
+    channels.setXMax(device_ctx.chan_width.x_max);
+    channels.setYMax(device_ctx.chan_width.y_max);
+    auto x_list = channels.initXList(device_ctx.chan_width.x_list.size());
+    for (size_t i = 0; i < device_ctx.chan_width.x_list.size(); ++i) {
+        x_list.set(i, device_ctx.chan_width.x_list[i]);
+    }
+    auto y_list = channels.initYList(device_ctx.chan_width.y_list.size());
+    for (size_t i = 0; i < device_ctx.chan_width.y_list.size(); ++i) {
+        y_list.set(i, device_ctx.chan_width.y_list[i]);
+    }
+
+    /* Switches */
+    auto switches = rr_graph_msg.initSwitches(rr_graph.switches().size());
+    for (auto rr_switch : rr_graph.switches()) {
+        const t_rr_switch_inf& cur_switch = rr_graph.get_switch(rr_switch);
+        auto switch_msg = switches[rr_graph.switch_index(rr_switch)];
+        if (cur_switch.type() >= SwitchType::INVALID) {
+            VPR_THROW(VPR_ERROR_ROUTE, "Invalid switch type %d\n", int(cur_switch.type()));
+        }
+        if (cur_switch.name) {
+            switch_msg.setName(cur_switch.name);
+        }
+        switch_msg.setType(VprRrSwitchType(int(cur_switch.type())));
+        switch_msg.setR(cur_switch.R);
+        switch_msg.setCin(cur_switch.Cin);
+        switch_msg.setCout(cur_switch.Cout);
+        switch_msg.setCinternal(cur_switch.Cinternal);
+        switch_msg.setTdel(cur_switch.Tdel);
+        switch_msg.setMuxTransSize(cur_switch.mux_trans_size);
+        switch_msg.setBufSize(cur_switch.buf_size);
+    }
+
+    /* Segments */
+    auto segments = rr_graph_msg.initSegments(rr_graph.segments().size());
+    for (auto seg : rr_graph.segments()) {
+        auto segment_msg = segments[rr_graph.segment_index(seg)];
+        segment_msg.setName(rr_graph.get_segment(seg).name);
+        segment_msg.setRPerMeter(rr_graph.get_segment(seg).Rmetal);
+        segment_msg.setCPerMeter(rr_graph.get_segment(seg).Cmetal);
+    }
+
+    /* Block types */
+    auto block_types = rr_graph_msg.initBlockTypes(device_ctx.physical_tile_types.size());
+    for (const auto& btype : device_ctx.physical_tile_types) {
+        VTR_ASSERT(btype.name);
+        auto block_type_msg = block_types[btype.index];
+        block_type_msg.setName(btype.name);
+        block_type_msg.setWidth(btype.width);
+        block_type_msg.setHeight(btype.height);
+
+        auto pin_classes = block_type_msg.initPinClasses(btype.num_class);
+        for (int iclass = 0; iclass < btype.num_class; ++iclass) {
+            const t_class& class_inf = btype.class_inf[iclass];
+            pin_classes[iclass].setType(to_capnp_pin_class_type(class_inf.type));
+            auto pins = pin_classes[iclass].initPins(class_inf.num_pins);
+            for (int ipin = 0; ipin < class_inf.num_pins; ++ipin) {
+                pins[ipin].setPtc(class_inf.pinlist[ipin]);
+                pins[ipin].setName(block_type_pin_index_to_name(&btype, class_inf.pinlist[ipin]));
+            }
+        }
+    }
+
+    /* Grid */
+    auto grid_locs = rr_graph_msg.initGrid(device_ctx.grid.width() * device_ctx.grid.height());
+    size_t igrid = 0;
+    for (size_t x = 0; x < device_ctx.grid.width(); ++x) {
+        for (size_t y = 0; y < device_ctx.grid.height(); ++y) {
+            const t_grid_tile& grid_tile = device_ctx.grid[x][y];
+            auto grid_loc = grid_locs[igrid++];
+            grid_loc.setX(x);
+            grid_loc.setY(y);
+            grid_loc.setBlockTypeId(grid_tile.type->index);
+            grid_loc.setWidthOffset(grid_tile.width_offset);
+            grid_loc.setHeightOffset(grid_tile.height_offset);
+        }
+    }
+
+    /* Nodes */
+    check_list_size(rr_graph.nodes().size(), "RR nodes");
+    auto nodes = rr_graph_msg.initNodes(rr_graph.nodes().size());
+    for (auto node : rr_graph.nodes()) {
+        /* Node ids are contiguous, see RRGraph::compress() */
+        auto node_msg = nodes[rr_graph.node_index(node)];
+        t_rr_type node_type = rr_graph.node_type(node);
+        node_msg.setType(VprRrNodeType(int(node_type)));
+        if (CHANX == node_type || CHANY == node_type) {
+            node_msg.setDirection(VprRrDirection(int(rr_graph.node_direction(node))));
+        }
+        if (IPIN == node_type || OPIN == node_type) {
+            node_msg.setSide(VprRrSide(int(rr_graph.node_side(node))));
+        }
+        node_msg.setCapacity(rr_graph.node_capacity(node));
+        node_msg.setXlow(rr_graph.node_xlow(node));
+        node_msg.setYlow(rr_graph.node_ylow(node));
+        node_msg.setXhigh(rr_graph.node_xhigh(node));
+        node_msg.setYhigh(rr_graph.node_yhigh(node));
+        node_msg.setPtc(rr_graph.node_ptc_num(node));
+        if (RRSegmentId::INVALID() != rr_graph.node_segment(node)) {
+            node_msg.setSegmentId(size_t(rr_graph.node_segment(node)));
+        }
+        node_msg.setR(rr_graph.node_R(node));
+        node_msg.setC(rr_graph.node_C(node));
+    }
+
+    /* Edges, grouped by their source nodes as in the XML format */
+    size_t num_edges = 0;
+    for (auto node : rr_graph.nodes()) {
+        num_edges += rr_graph.node_out_edges(node).size();
+    }
+    check_list_size(num_edges, "RR edges");
+    auto src_nodes = rr_graph_msg.initEdgeSrcNodes(num_edges);
+    auto sink_nodes = rr_graph_msg.initEdgeSinkNodes(num_edges);
+    auto edge_switches = rr_graph_msg.initEdgeSwitches(num_edges);
+    size_t iedge = 0;
+    for (auto node : rr_graph.nodes()) {
+        for (auto edge : rr_graph.node_out_edges(node)) {
+            src_nodes.set(iedge, rr_graph.node_index(node));
+            sink_nodes.set(iedge, rr_graph.node_index(rr_graph.edge_sink_node(edge)));
+            edge_switches.set(iedge, rr_graph.switch_index(rr_graph.edge_switch(edge)));
+            ++iedge;
+        }
+    }
+
+    /* Metadata */
+    auto node_metadata = rr_graph_msg.initNodeMetadata(device_ctx.rr_node_metadata.size());
+    size_t imeta = 0;
+    for (const auto& node_meta : device_ctx.rr_node_metadata) {
+        node_metadata[imeta].setNode(node_meta.first);
+        fill_capnp_metadata(node_metadata[imeta].initMetas(count_metadata_values(node_meta.second)), node_meta.second);
+        ++imeta;
+    }
+    auto edge_metadata = rr_graph_msg.initEdgeMetadata(device_ctx.rr_edge_metadata.size());
+    imeta = 0;
+    for (const auto& edge_meta : device_ctx.rr_edge_metadata) {
+        edge_metadata[imeta].setSrcNode(std::get<0>(edge_meta.first));
+        edge_metadata[imeta].setSinkNode(std::get<1>(edge_meta.first));
+        edge_metadata[imeta].setSwitchId(std::get<2>(edge_meta.first));
+        fill_capnp_metadata(edge_metadata[imeta].initMetas(count_metadata_values(edge_meta.second)), edge_meta.second);
+        ++imeta;
+    }
+
+    writeMessageToFile(file_name, &builder);
+}
+
+#endif /* VTR_ENABLE_CAPNPROTO */
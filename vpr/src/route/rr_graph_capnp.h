@@ -0,0 +1,28 @@
+/*
+ * This file defines the functions to read and write the routing resource graph
+ * in the binary Cap'n Proto format (see libs/libvtrcapnproto/rr_graph.capnp),
+ * which is much faster to load than the XML format for large devices.
+ * The format is selected by the '.capnp' extension of the rr graph file.
+ */
+
+#ifndef RR_GRAPH_CAPNP_H
+#define RR_GRAPH_CAPNP_H
+
+#include <vector>
+
+#include "vpr_types.h"
+#include "device_grid.h"
+#include "rr_graph.h"
+#include "rr_graph_obj.h"
+
+void load_capnp_rr_file(const t_graph_type graph_type,
+                        const DeviceGrid& grid,
+                        const std::vector<t_segment_inf>& segment_inf,
+                        const enum e_base_cost_type base_cost_type,
+                        int* wire_to_rr_ipin_switch,
+                        const char* read_rr_graph_name,
+                        const bool& do_check_rr_graph);
+
+void write_capnp_rr_graph(const char* file_name, const RRGraph& rr_graph);
+
+#endif /* RR_GRAPH_CAPNP_H */
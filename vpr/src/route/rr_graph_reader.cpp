@@ -48,6 +48,7 @@
 #include "check_rr_graph_obj.h"
 
 #include "rr_graph_reader.h"
+#include "rr_graph_capnp.h"
 
 /*********************** Subroutines local to this module *******************/
 void process_switches(pugi::xml_node parent, const pugiutil::loc_data& loc_data);
@@ -72,9 +73,18 @@ void load_rr_file(const t_graph_type graph_type,
                   const std::vector<t_segment_inf>& segment_inf,
                   const enum e_base_cost_type base_cost_type,
                   int* wire_to_rr_ipin_switch,
-                  const char* read_rr_graph_name) {
+                  const char* read_rr_graph_name,
+                  const bool& do_check_rr_graph) {
     vtr::ScopedStartFinishTimer timer("Loading routing resource graph");
 
+    //A binary RR graph is selected by its file extension
+    if (vtr::check_file_name_extension(read_rr_graph_name, ".capnp")) {
+        load_capnp_rr_file(graph_type, grid, segment_inf, base_cost_type,
+                           wire_to_rr_ipin_switch, read_rr_graph_name,
+                           do_check_rr_graph);
+        return;
+    }
+
     const char* Prop;
     pugi::xml_node next_component;
 
@@ -84,7 +94,7 @@ void load_rr_file(const t_graph_type graph_type,
     if (vtr::check_file_name_extension(read_rr_graph_name, ".xml") == false) {
         VTR_LOG_WARN(
             "RR graph file '%s' may be in incorrect format. "
-            "Expecting .xml format\n",
+            "Expecting .xml or .capnp format\n",
             read_rr_graph_name);
     }
     try {
@@ -190,14 +200,19 @@ void load_rr_file(const t_graph_type graph_type,
         device_ctx.chan_width = nodes_per_chan;
         device_ctx.read_rr_graph_filename = std::string(read_rr_graph_name);
 
-        check_rr_graph(graph_type, grid, device_ctx.physical_tile_types);
-        /* Error out if advanced checker of rr_graph fails */
-        if (false == check_rr_graph(device_ctx.rr_graph)) {
-            vpr_throw(VPR_ERROR_ROUTE,
-                      __FILE__,
-                      __LINE__,
-                      "Advanced checking rr_graph object fails! Routing may still work "
-                      "but not smooth\n");
+        if (false == do_check_rr_graph) {
+            /* The very same file has already passed the checks */
+            VTR_LOG("Skipped checking the RR graph, which was checked before\n");
+        } else {
+            check_rr_graph(graph_type, grid, device_ctx.physical_tile_types);
+            /* Error out if advanced checker of rr_graph fails */
+            if (false == check_rr_graph(device_ctx.rr_graph)) {
+                vpr_throw(VPR_ERROR_ROUTE,
+                          __FILE__,
+                          __LINE__,
+                          "Advanced checking rr_graph object fails! Routing may still work "
+                          "but not smooth\n");
+            }
         }
     } catch (pugiutil::XmlError& e) {
         vpr_throw(VPR_ERROR_ROUTE, read_rr_graph_name, e.line(), "%s", e.what());
@@ -9,6 +9,7 @@ void load_rr_file(const t_graph_type graph_type,
                   const std::vector<t_segment_inf>& segment_inf,
                   const enum e_base_cost_type base_cost_type,
                   int* wire_to_rr_ipin_switch,
-                  const char* read_rr_graph_name);
+                  const char* read_rr_graph_name,
+                  const bool& do_check_rr_graph = true);
 
 #endif /* RR_GRAPH_READER_H */
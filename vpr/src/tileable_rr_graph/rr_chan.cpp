@@ -3,6 +3,7 @@
  ***********************************************************************/
 #include "vtr_log.h"
 #include "vtr_assert.h"
+#include "openfpga_memory_usage.h"
 #include "rr_chan.h"
 
 /* namespace openfpga begins */
@@ -144,6 +145,11 @@ std::vector<size_t> RRChan::get_node_ids_by_segment_ids(const RRSegmentId& seg_i
   return node_list;
 } 
 
+size_t RRChan::memory_usage() const {
+  return openfpga::memory_usage(nodes_)
+       + openfpga::memory_usage(node_segments_);
+}
+
 /************************************************************************
  * Mutators
  ***********************************************************************/
@@ -44,7 +44,10 @@ namespace openfpga {
 class RRChan {
   public: /* Constructors */
     RRChan(const RRChan&); /* Copy Constructor */
+    RRChan(RRChan&&) = default; /* Move Constructor, which takes over the node arrays */
     RRChan();
+    RRChan& operator=(const RRChan&) = default;
+    RRChan& operator=(RRChan&&) = default;
   public: /* Accessors */
     t_rr_type get_type() const;
     size_t get_chan_width() const; /* get the number of tracks in this channel */
@@ -55,6 +58,7 @@ class RRChan {
     bool is_mirror(const RRGraph& rr_graph, const RRChan& cand) const; /* evaluate if two RR_chan is mirror to each other */
     std::vector<RRSegmentId> get_segment_ids() const; /* Get a list of segments used in this routing channel */
     std::vector<size_t> get_node_ids_by_segment_ids(const RRSegmentId& seg_id) const; /* Get a list of segments used in this routing channel */
+    size_t memory_usage() const; /* Estimate the heap memory (in bytes) held by this channel */
   public: /* Mutators */
     /* copy */
     void set(const RRChan&); 
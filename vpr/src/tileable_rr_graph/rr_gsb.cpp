@@ -1,12 +1,16 @@
 /************************************************************************
  * Member functions for class RRGSB
  ***********************************************************************/
+#include <algorithm>
+
 /* Headers from vtrutil library */
 #include "vtr_log.h"
 #include "vtr_assert.h"
+#include "vtr_hash.h"
 
 /* Headers from openfpgautil library */
 #include "openfpga_side_manager.h"
+#include "openfpga_memory_usage.h"
 
 #include "openfpga_rr_graph_utils.h"
 
@@ -26,6 +30,10 @@ RRGSB::RRGSB() {
   chan_node_.clear();
   chan_node_direction_.clear();
   chan_node_in_edges_.clear();
+  chan_node_in_edge_offsets_.clear();
+  mux_driver_edges_.clear();
+  mux_driver_path_ids_.clear();
+  mux_driver_offsets_.clear();
 
   ipin_node_.clear();
 
@@ -166,7 +174,7 @@ std::vector<RREdgeId> RRGSB::get_chan_node_in_edges(const RRGraph& rr_graph,
   /* if sorted, we give sorted edges
    * if not sorted, we give the empty vector
    */
-  if (0 == chan_node_in_edges_.size()) {
+  if (0 == chan_node_in_edge_offsets_.size()) {
     std::vector<RREdgeId> unsorted_edges;
     for (const RREdgeId& edge : rr_graph.node_in_edges(get_chan_node(side, track_id))) {
       unsorted_edges.push_back(edge);
@@ -175,7 +183,36 @@ std::vector<RREdgeId> RRGSB::get_chan_node_in_edges(const RRGraph& rr_graph,
     return unsorted_edges;
   } 
 
-  return chan_node_in_edges_[side_manager.to_size_t()][track_id];
+  size_t chan_node_index = get_chan_node_index(side, track_id);
+  return std::vector<RREdgeId>(chan_node_in_edges_.begin() + chan_node_in_edge_offsets_[chan_node_index],
+                               chan_node_in_edges_.begin() + chan_node_in_edge_offsets_[chan_node_index + 1]);
+}
+
+std::vector<RREdgeId> RRGSB::get_chan_node_driver_edges(const e_side& side,
+                                                        const size_t& track_id) const {
+  /* The chan node must be an output port for the GSB */
+  VTR_ASSERT(OUT_PORT == get_chan_node_direction(side, track_id));
+
+  return get_mux_driver_edges(get_chan_node_index(side, track_id));
+}
+
+std::vector<RRNodeId> RRGSB::get_chan_node_driver_nodes(const RRGraph& rr_graph,
+                                                        const e_side& side,
+                                                        const size_t& track_id) const {
+  /* The chan node must be an output port for the GSB */
+  VTR_ASSERT(OUT_PORT == get_chan_node_direction(side, track_id));
+
+  return get_mux_driver_nodes(rr_graph, get_chan_node_index(side, track_id));
+}
+
+size_t RRGSB::find_chan_node_driver_path_id(const RRGraph& rr_graph,
+                                            const e_side& side,
+                                            const size_t& track_id,
+                                            const RRNodeId& driver_node) const {
+  /* The chan node must be an output port for the GSB */
+  VTR_ASSERT(OUT_PORT == get_chan_node_direction(side, track_id));
+
+  return find_mux_driver_path_id(rr_graph, get_chan_node_index(side, track_id), driver_node);
 }
 
 /* get the segment id of a channel rr_node */
@@ -213,6 +250,23 @@ RRNodeId RRGSB::get_ipin_node(const e_side& side, const size_t& node_id) const {
   return ipin_node_[side_manager.to_size_t()][node_id]; 
 } 
 
+std::vector<RREdgeId> RRGSB::get_ipin_node_driver_edges(const e_side& side, const size_t& node_id) const {
+  return get_mux_driver_edges(get_ipin_mux_index(side, node_id));
+}
+
+std::vector<RRNodeId> RRGSB::get_ipin_node_driver_nodes(const RRGraph& rr_graph,
+                                                        const e_side& side,
+                                                        const size_t& node_id) const {
+  return get_mux_driver_nodes(rr_graph, get_ipin_mux_index(side, node_id));
+}
+
+size_t RRGSB::find_ipin_node_driver_path_id(const RRGraph& rr_graph,
+                                            const e_side& side,
+                                            const size_t& node_id,
+                                            const RRNodeId& driver_node) const {
+  return find_mux_driver_path_id(rr_graph, get_ipin_mux_index(side, node_id), driver_node);
+}
+
 /* Get the number of OPIN rr_nodes on a side */
 size_t RRGSB::get_num_opin_nodes(const e_side& side) const {
   SideManager side_manager(side);
@@ -585,6 +639,79 @@ bool RRGSB::is_sb_mirror(const RRGraph& rr_graph, const RRGSB& cand) const {
   return true;
 }
 
+/* Get a fingerprint of the connection block
+ * Only the features which are compared in is_cb_mirror() are considered:
+ * the type, directionality and segment of channel nodes,
+ * the number of ipins and the type and switch of their driving nodes 
+ */
+size_t RRGSB::get_cb_fingerprint(const RRGraph& rr_graph, const t_rr_type& cb_type) const {
+  size_t fingerprint = 0;
+
+  enum e_side chan_side = get_cb_chan_side(cb_type);
+  const RRChan& chan = chan_node_[size_t(chan_side)];
+  vtr::hash_combine(fingerprint, chan.get_chan_width());
+  for (size_t itrack = 0; itrack < chan.get_chan_width(); ++itrack) {
+    vtr::hash_combine(fingerprint, size_t(rr_graph.node_type(chan.get_node(itrack))));
+    vtr::hash_combine(fingerprint, size_t(rr_graph.node_direction(chan.get_node(itrack))));
+    vtr::hash_combine(fingerprint, size_t(chan.get_node_segment(itrack)));
+  }
+
+  for (const e_side& ipin_side : get_cb_ipin_sides(cb_type)) {
+    vtr::hash_combine(fingerprint, get_num_ipin_nodes(ipin_side));
+    for (size_t inode = 0; inode < get_num_ipin_nodes(ipin_side); ++inode) {
+      RRNodeId node = get_ipin_node(ipin_side, inode);
+      vtr::hash_combine(fingerprint, rr_graph.node_in_edges(node).size());
+      for (const RREdgeId& edge : rr_graph.node_in_edges(node)) {
+        vtr::hash_combine(fingerprint, size_t(rr_graph.node_type(rr_graph.edge_src_node(edge))));
+        vtr::hash_combine(fingerprint, size_t(rr_graph.edge_switch(edge)));
+      }
+    }
+  }
+
+  return fingerprint;
+}
+
+/* Get a fingerprint of the switch block
+ * Only the features which are compared in is_sb_mirror() are considered:
+ * the channel width, the directionality of tracks, 
+ * the type and switch of driving nodes for each track which is not a passing wire,
+ * and the number of opins and ipins on each side.
+ * Note that the segment ids are not considered, as is_sb_mirror() does not 
+ * require the same segment on each track 
+ * Also note that is_sb_mirror() skips the sides without any track in the current SB.
+ * Therefore, the fingerprint is only meaningful when every side has tracks
+ */
+size_t RRGSB::get_sb_fingerprint(const RRGraph& rr_graph) const {
+  size_t fingerprint = 0;
+
+  vtr::hash_combine(fingerprint, get_num_sides());
+  for (size_t side = 0; side < get_num_sides(); ++side) {
+    SideManager side_manager(side);
+    e_side curr_side = side_manager.get_side();
+    vtr::hash_combine(fingerprint, get_chan_width(curr_side));
+    for (size_t itrack = 0; itrack < get_chan_width(curr_side); ++itrack) {
+      vtr::hash_combine(fingerprint, size_t(get_chan_node_direction(curr_side, itrack)));
+      if (OUT_PORT != get_chan_node_direction(curr_side, itrack)) {
+        continue;
+      }
+      if (true == is_sb_node_passing_wire(rr_graph, curr_side, itrack)) {
+        vtr::hash_combine(fingerprint, true);
+        continue;
+      }
+      std::vector<RREdgeId> node_in_edges = get_chan_node_in_edges(rr_graph, curr_side, itrack);
+      vtr::hash_combine(fingerprint, node_in_edges.size());
+      for (const RREdgeId& edge : node_in_edges) {
+        vtr::hash_combine(fingerprint, size_t(rr_graph.node_type(rr_graph.edge_src_node(edge))));
+        vtr::hash_combine(fingerprint, size_t(rr_graph.edge_switch(edge)));
+      }
+    }
+    vtr::hash_combine(fingerprint, get_num_opin_nodes(curr_side));
+    vtr::hash_combine(fingerprint, get_num_ipin_nodes(curr_side));
+  }
+
+  return fingerprint;
+}
+
 /* Public Accessors: Cooridinator conversion */
 
 /* get the x coordinate of this GSB */
@@ -724,6 +851,18 @@ vtr::Point<size_t> RRGSB::get_grid_coordinate() const {
   return ret;
 }
 
+size_t RRGSB::memory_usage() const {
+  return openfpga::memory_usage(chan_node_)
+       + openfpga::memory_usage(chan_node_direction_)
+       + openfpga::memory_usage(chan_node_in_edges_)
+       + openfpga::memory_usage(chan_node_in_edge_offsets_)
+       + openfpga::memory_usage(mux_driver_edges_)
+       + openfpga::memory_usage(mux_driver_path_ids_)
+       + openfpga::memory_usage(mux_driver_offsets_)
+       + openfpga::memory_usage(ipin_node_)
+       + openfpga::memory_usage(opin_node_);
+}
+
 /************************************************************************
  * Public Mutators
  ***********************************************************************/
@@ -792,6 +931,17 @@ void RRGSB::add_chan_node(const e_side& node_side,
   }
 } 
 
+void RRGSB::add_chan_node(const e_side& node_side,
+                          RRChan&& rr_chan,
+                          std::vector<enum PORTS>&& rr_chan_dir) {
+  /* Validate: 1. side is valid, the type of node is valid */
+  VTR_ASSERT(validate_side(node_side));
+
+  /* take over the dedicated element in the vector */
+  chan_node_[size_t(node_side)] = std::move(rr_chan);
+  chan_node_direction_[size_t(node_side)] = std::move(rr_chan_dir);
+} 
+
 /* Add a node to the chan_node_ list and also assign its direction in chan_node_direction_ */
 void RRGSB::add_ipin_node(const RRNodeId& node, const e_side& node_side) {
   VTR_ASSERT(validate_side(node_side));
@@ -807,18 +957,14 @@ void RRGSB::add_opin_node(const RRNodeId& node, const e_side& node_side) {
 } 
 
 void RRGSB::sort_chan_node_in_edges(const RRGraph& rr_graph,
+                                    const std::unordered_map<RRNodeId, size_t>& src_node_sort_keys,
                                     const e_side& chan_side,
                                     const size_t& track_id) {
-  std::map<size_t, std::map<size_t, RREdgeId>> from_grid_edge_map;
-  std::map<size_t, std::map<size_t, RREdgeId>> from_track_edge_map;
-
   const RRNodeId& chan_node = chan_node_[size_t(chan_side)].get_node(track_id); 
-  
-  /* Count the edges and ensure every of them has been sorted */
-  size_t edge_counter = 0;
 
-  /* For each incoming edge, find the node side and index in this GSB.
-   * and cache these. Then we will use the data to sort the edge in the 
+  /* For each incoming edge, find the sort key of its source node,
+   * which should be an input of the GSB!!!
+   * Then we will use the keys to sort the edge in the 
    * following sequence:
    *  0----------------------------------------------------------------> num_in_edges()
    *  |<--TOP side-->|<--RIGHT side-->|<--BOTTOM side-->|<--LEFT side-->|
@@ -826,75 +972,145 @@ void RRGSB::sort_chan_node_in_edges(const RRGraph& rr_graph,
    *  For each side, the edge from grid pins will be the 1st part
    *  while the edge from routing tracks will be the 2nd part
    */
+  std::vector<std::pair<size_t, RREdgeId>> keyed_edges;
+  keyed_edges.reserve(rr_graph.node_in_edges(chan_node).size());
   for (const RREdgeId& edge : rr_graph.node_in_edges(chan_node)) {
-    /* We care the source node of this edge, and it should be an input of the GSB!!! */
     const RRNodeId& src_node = rr_graph.edge_src_node(edge);
-    e_side side = NUM_SIDES;
-    int index = 0;
-    get_node_side_and_index(rr_graph, src_node, IN_PORT, side, index);
+    auto it = src_node_sort_keys.find(src_node);
 
     /* Must have valid side and index */
-    if (NUM_SIDES == side) {
+    if (src_node_sort_keys.end() == it) {
       VTR_LOG("GSB[%lu][%lu]:\n", get_x(), get_y());
       VTR_LOG("SRC node:\n");
       rr_graph.print_node(src_node);
       VTR_LOG("Channel node:\n");
       rr_graph.print_node(chan_node);
     }
+    VTR_ASSERT(src_node_sort_keys.end() != it);
+
+    keyed_edges.push_back(std::make_pair(it->second, edge));
+  }
 
-    VTR_ASSERT(NUM_SIDES != side);
-    VTR_ASSERT(OPEN != index);
+  /* Each source node should drive the channel node through only one edge */
+  std::sort(keyed_edges.begin(), keyed_edges.end(),
+            [](const std::pair<size_t, RREdgeId>& a, const std::pair<size_t, RREdgeId>& b) {
+              return a.first < b.first;
+            });
 
-    if (OPIN == rr_graph.node_type(src_node)) {
-      from_grid_edge_map[side][index] = edge;
-    } else {
-      VTR_ASSERT( (CHANX == rr_graph.node_type(src_node))
-               || (CHANY == rr_graph.node_type(src_node)) );
-      from_track_edge_map[side][index] = edge;
+  /* Store the sorted edge */
+  for (size_t iedge = 0; iedge < keyed_edges.size(); ++iedge) {
+    VTR_ASSERT( (0 == iedge) || (keyed_edges[iedge - 1].first != keyed_edges[iedge].first) );
+    chan_node_in_edges_.push_back(keyed_edges[iedge].second);
+  }
+} 
+
+void RRGSB::sort_chan_node_in_edges(const RRGraph& rr_graph) {
+  /* Allocate here, as sort edge is optional, we do not allocate when adding nodes
+   * The edges of all the tracks are appended to a flat array in the sequence of sides and tracks
+   */
+  size_t num_chan_nodes = 0;
+  size_t num_in_edges = 0;
+  for (size_t side = 0; side < get_num_sides(); ++side) {
+    num_chan_nodes += chan_node_[side].get_chan_width();
+    for (size_t track_id = 0; track_id < chan_node_[side].get_chan_width(); ++track_id) {
+      if (OUT_PORT == chan_node_direction_[side][track_id]) {
+        num_in_edges += rr_graph.node_in_edges(chan_node_[side].get_node(track_id)).size();
+      }
     }
-    
-    edge_counter++;
   }
 
-  /* Store the sorted edge */
+  chan_node_in_edges_.clear();
+  chan_node_in_edges_.reserve(num_in_edges);
+  chan_node_in_edge_offsets_.clear();
+  chan_node_in_edge_offsets_.reserve(num_chan_nodes + 1);
+  chan_node_in_edge_offsets_.push_back(0);
+
+  /* Precompute the sort key of each node which is an input of the GSB,
+   * i.e., its position in the sequence of sides where, on each side, 
+   * grid outputs come before the input routing tracks.
+   * A node which is found on several sides is keyed by the first side,
+   * so that the keys are the same as searching the sides in sequence
+   */
+  std::unordered_map<RRNodeId, size_t> src_node_sort_keys;
+  size_t side_offset = 0;
   for (size_t side = 0; side < get_num_sides(); ++side) {
-    /* Edges from grid outputs are the 1st part */
     for (size_t opin_id = 0; opin_id < opin_node_[side].size(); ++opin_id) {
-      if ( (0 < from_grid_edge_map.count(side))
-        && (0 < from_grid_edge_map.at(side).count(opin_id)) ) {
-        chan_node_in_edges_[size_t(chan_side)][track_id].push_back(from_grid_edge_map[side][opin_id]);
-      }
+      src_node_sort_keys.emplace(opin_node_[side][opin_id], side_offset + opin_id);
     }
- 
-    /* Edges from routing tracks are the 2nd part */
+    side_offset += opin_node_[side].size();
     for (size_t itrack = 0; itrack < chan_node_[side].get_chan_width(); ++itrack) {
-      if ( (0 < from_track_edge_map.count(side))
-        && (0 < from_track_edge_map.at(side).count(itrack)) ) {
-        chan_node_in_edges_[size_t(chan_side)][track_id].push_back(from_track_edge_map[side][itrack]);
+      if (IN_PORT == chan_node_direction_[side][itrack]) {
+        src_node_sort_keys.emplace(chan_node_[side].get_node(itrack), side_offset + itrack);
       }
     }
+    side_offset += chan_node_[side].get_chan_width();
   }
 
-  VTR_ASSERT(edge_counter == chan_node_in_edges_[size_t(chan_side)][track_id].size());
-} 
-
-void RRGSB::sort_chan_node_in_edges(const RRGraph& rr_graph) {
-  /* Allocate here, as sort edge is optional, we do not allocate when adding nodes */
-  chan_node_in_edges_.resize(get_num_sides());
-
   for (size_t side = 0; side < get_num_sides(); ++side) {
     SideManager side_manager(side);
-    chan_node_in_edges_[side].resize(chan_node_[side].get_chan_width());
     for (size_t track_id = 0; track_id < chan_node_[side].get_chan_width(); ++track_id) {
       /* Only sort the output nodes and bypass passing wires */
       if ( (OUT_PORT == chan_node_direction_[side][track_id])
         && (false == is_sb_node_passing_wire(rr_graph, side_manager.get_side(), track_id)) ) {  
-        sort_chan_node_in_edges(rr_graph, side_manager.get_side(), track_id); 
+        sort_chan_node_in_edges(rr_graph, src_node_sort_keys, side_manager.get_side(), track_id); 
       }
+      chan_node_in_edge_offsets_.push_back(chan_node_in_edges_.size());
     }
   }
 }
 
+void RRGSB::build_mux_drivers(const RRGraph& rr_graph) {
+  mux_driver_edges_.clear();
+  mux_driver_path_ids_.clear();
+  mux_driver_offsets_.clear();
+  mux_driver_offsets_.push_back(0);
+
+  /* Output routing tracks: follow the sequence of the (sorted) incoming edges */
+  for (size_t side = 0; side < get_num_sides(); ++side) {
+    SideManager side_manager(side);
+    for (size_t track_id = 0; track_id < chan_node_[side].get_chan_width(); ++track_id) {
+      if (OUT_PORT == chan_node_direction_[side][track_id]) {
+        for (const RREdgeId& edge : get_chan_node_in_edges(rr_graph, side_manager.get_side(), track_id)) {
+          /* Bypass non-configurable edges */
+          if (true == rr_graph.edge_is_configurable(edge)) {
+            mux_driver_edges_.push_back(edge);
+          }
+        }
+      }
+      mux_driver_offsets_.push_back(mux_driver_edges_.size());
+    }
+  }
+
+  /* IPINs: follow the sequence of the incoming edges in the rr_graph */
+  for (size_t side = 0; side < get_num_sides(); ++side) {
+    for (const RRNodeId& ipin_node : ipin_node_[side]) {
+      for (const RREdgeId& edge : rr_graph.node_in_edges(ipin_node)) {
+        /* Bypass non-configurable edges */
+        if (true == rr_graph.edge_is_configurable(edge)) {
+          mux_driver_edges_.push_back(edge);
+        }
+      }
+      mux_driver_offsets_.push_back(mux_driver_edges_.size());
+    }
+  }
+
+  /* Sort the path ids of each multiplexer by their driver nodes.
+   * The sort is stable so that a node driving several inputs is found at its first input
+   */
+  mux_driver_path_ids_.reserve(mux_driver_edges_.size());
+  for (size_t imux = 0; imux < mux_driver_offsets_.size() - 1; ++imux) {
+    const size_t& first_edge = mux_driver_offsets_[imux];
+    for (size_t path_id = 0; path_id < mux_driver_offsets_[imux + 1] - first_edge; ++path_id) {
+      mux_driver_path_ids_.push_back(path_id);
+    }
+    std::stable_sort(mux_driver_path_ids_.begin() + first_edge, mux_driver_path_ids_.end(),
+                     [&](const size_t& a, const size_t& b) {
+                       return rr_graph.edge_src_node(mux_driver_edges_[first_edge + a])
+                            < rr_graph.edge_src_node(mux_driver_edges_[first_edge + b]);
+                     });
+  }
+}
+
 /************************************************************************
  * Public Mutators: clean-up functions
  ***********************************************************************/
@@ -942,6 +1158,13 @@ void RRGSB::clear_one_side(const e_side& node_side) {
   clear_chan_nodes(node_side);
   clear_ipin_nodes(node_side);
   clear_opin_nodes(node_side);
+}
+
+/* Release the sorted incoming edges of routing channel rr_nodes */
+void RRGSB::clear_chan_node_in_edges() {
+  /* Swap with an empty vector to release the memory */
+  std::vector<RREdgeId>().swap(chan_node_in_edges_);
+  std::vector<size_t>().swap(chan_node_in_edge_offsets_);
 } 
 
 /************************************************************************
@@ -1097,6 +1320,63 @@ size_t RRGSB::get_track_id_first_short_connection(const RRGraph& rr_graph, const
   return size_t(-1);
 }
 
+/* The routing tracks of all the sides are indexed in the sequence of sides and tracks */
+size_t RRGSB::get_chan_node_index(const e_side& side, const size_t& track_id) const {
+  VTR_ASSERT(validate_track_id(side, track_id));
+  size_t chan_node_index = track_id;
+  for (size_t iside = 0; iside < size_t(side); ++iside) {
+    chan_node_index += chan_node_[iside].get_chan_width();
+  }
+  return chan_node_index;
+}
+
+size_t RRGSB::get_ipin_mux_index(const e_side& side, const size_t& node_id) const {
+  VTR_ASSERT(validate_ipin_node_id(side, node_id));
+  size_t mux_index = node_id;
+  for (size_t iside = 0; iside < get_num_sides(); ++iside) {
+    mux_index += chan_node_[iside].get_chan_width();
+  }
+  for (size_t iside = 0; iside < size_t(side); ++iside) {
+    mux_index += ipin_node_[iside].size();
+  }
+  return mux_index;
+}
+
+std::vector<RREdgeId> RRGSB::get_mux_driver_edges(const size_t& mux_index) const {
+  /* Drivers must have been resolved */
+  VTR_ASSERT(mux_index + 1 < mux_driver_offsets_.size());
+  return std::vector<RREdgeId>(mux_driver_edges_.begin() + mux_driver_offsets_[mux_index],
+                               mux_driver_edges_.begin() + mux_driver_offsets_[mux_index + 1]);
+}
+
+std::vector<RRNodeId> RRGSB::get_mux_driver_nodes(const RRGraph& rr_graph, const size_t& mux_index) const {
+  /* Drivers must have been resolved */
+  VTR_ASSERT(mux_index + 1 < mux_driver_offsets_.size());
+  std::vector<RRNodeId> driver_nodes;
+  driver_nodes.reserve(mux_driver_offsets_[mux_index + 1] - mux_driver_offsets_[mux_index]);
+  for (size_t iedge = mux_driver_offsets_[mux_index]; iedge < mux_driver_offsets_[mux_index + 1]; ++iedge) {
+    driver_nodes.push_back(rr_graph.edge_src_node(mux_driver_edges_[iedge]));
+  }
+  return driver_nodes;
+}
+
+size_t RRGSB::find_mux_driver_path_id(const RRGraph& rr_graph, const size_t& mux_index, const RRNodeId& driver_node) const {
+  /* Drivers must have been resolved */
+  VTR_ASSERT(mux_index + 1 < mux_driver_offsets_.size());
+  const size_t& first_edge = mux_driver_offsets_[mux_index];
+  auto begin = mux_driver_path_ids_.begin() + first_edge;
+  auto end = mux_driver_path_ids_.begin() + mux_driver_offsets_[mux_index + 1];
+  auto result = std::lower_bound(begin, end, driver_node,
+                                 [&](const size_t& path_id, const RRNodeId& node) {
+                                   return rr_graph.edge_src_node(mux_driver_edges_[first_edge + path_id]) < node;
+                                 });
+  if ( (end == result)
+    || (driver_node != rr_graph.edge_src_node(mux_driver_edges_[first_edge + *result])) ) {
+    return size_t(-1);
+  }
+  return *result;
+}
+
 
 /************************************************************************
  * Internal validators
@@ -4,6 +4,8 @@
 /********************************************************************
  * Include header files required by the data structure definition
  *******************************************************************/
+#include <unordered_map>
+
 /* Headers from vtrutil library */
 #include "vtr_geometry.h"
 
@@ -53,7 +55,10 @@ namespace openfpga {
 class RRGSB {
   public: /* Contructors */
     RRGSB(const RRGSB&);/* Copy constructor */
+    RRGSB(RRGSB&&) = default;/* Move constructor, which takes over all the node and edge arrays */
     RRGSB();/* Default constructor */
+    RRGSB& operator=(const RRGSB&) = default;
+    RRGSB& operator=(RRGSB&&) = default;
   public: /* Accessors */
     /* Get the number of sides of this SB */
     size_t get_num_sides() const; 
@@ -91,6 +96,27 @@ class RRGSB {
                                                  const e_side& side,
                                                  const size_t& track_id) const; 
 
+    /* get the configurable incoming edges of a routing track output,
+     * in the sequence of the inputs of its routing multiplexer
+     */
+    std::vector<RREdgeId> get_chan_node_driver_edges(const e_side& side,
+                                                     const size_t& track_id) const; 
+
+    /* get the configurable driver nodes of a routing track output,
+     * in the sequence of the inputs of its routing multiplexer
+     */
+    std::vector<RRNodeId> get_chan_node_driver_nodes(const RRGraph& rr_graph,
+                                                     const e_side& side,
+                                                     const size_t& track_id) const; 
+
+    /* get the input (path id) of the routing multiplexer of a routing track output
+     * which is driven by a given node, return -1 if not found
+     */
+    size_t find_chan_node_driver_path_id(const RRGraph& rr_graph,
+                                         const e_side& side,
+                                         const size_t& track_id,
+                                         const RRNodeId& driver_node) const; 
+
     /* get the segment id of a channel rr_node */
     RRSegmentId get_chan_node_segment(const e_side& side, const size_t& track_id) const; 
 
@@ -100,6 +126,22 @@ class RRGSB {
     /* get a rr_node at a given side and track_id */
     RRNodeId get_ipin_node(const e_side& side, const size_t& node_id) const;
 
+    /* get the configurable incoming edges of an IPIN, in the sequence of the inputs of its routing multiplexer */
+    std::vector<RREdgeId> get_ipin_node_driver_edges(const e_side& side, const size_t& node_id) const;
+
+    /* get the configurable driver nodes of an IPIN, in the sequence of the inputs of its routing multiplexer */
+    std::vector<RRNodeId> get_ipin_node_driver_nodes(const RRGraph& rr_graph,
+                                                     const e_side& side,
+                                                     const size_t& node_id) const;
+
+    /* get the input (path id) of the routing multiplexer of an IPIN
+     * which is driven by a given node, return -1 if not found
+     */
+    size_t find_ipin_node_driver_path_id(const RRGraph& rr_graph,
+                                         const e_side& side,
+                                         const size_t& node_id,
+                                         const RRNodeId& driver_node) const;
+
     /* Get the number of OPIN rr_nodes on a side */
     size_t get_num_opin_nodes(const e_side& side) const; 
 
@@ -167,6 +209,14 @@ class RRGSB {
      */
     bool is_sb_mirror(const RRGraph& rr_graph, const RRGSB& cand) const; 
 
+    /* Get a structural fingerprint of the connection/switch block 
+     * Two mirrors always have the same fingerprint, while the reverse is not guaranteed.
+     * It is used to bucket the candidates before running mirror checks
+     * The SB fingerprint only makes sense when all the sides have tracks
+     */
+    size_t get_cb_fingerprint(const RRGraph& rr_graph, const t_rr_type& cb_type) const;
+    size_t get_sb_fingerprint(const RRGraph& rr_graph) const;
+
   public: /* Cooridinator conversion and output  */
     size_t get_x() const; /* get the x coordinate of this switch block */
     size_t get_y() const; /* get the y coordinate of this switch block */
@@ -180,6 +230,7 @@ class RRGSB {
     e_side get_cb_chan_side(const e_side& ipin_side) const; /* get the side of a Connection block */
     vtr::Point<size_t> get_side_block_coordinate(const e_side& side) const;
     vtr::Point<size_t> get_grid_coordinate() const;
+    size_t memory_usage() const; /* Estimate the heap memory (in bytes) held by this switch block */
   public: /* Mutators */
     /* get a copy from a source */
     void set(const RRGSB& src);
@@ -195,6 +246,11 @@ class RRGSB {
                        const RRChan& rr_chan,
                        const std::vector<enum PORTS>& rr_chan_dir);
 
+    /* Same as above but take over the routing channel and the directions without copying */
+    void add_chan_node(const e_side& node_side,
+                       RRChan&& rr_chan,
+                       std::vector<enum PORTS>&& rr_chan_dir);
+
     /* Add a node to the chan_rr_node_ list and also 
      * assign its direction in chan_rr_node_direction_
      */
@@ -210,6 +266,12 @@ class RRGSB {
     /* Sort all the incoming edges for routing channel rr_node */
     void sort_chan_node_in_edges(const RRGraph& rr_graph);
 
+    /* Resolve the configurable drivers of all the routing multiplexers,
+     * i.e., the routing track outputs and the IPINs.
+     * Must be called after the incoming edges are sorted, if they are
+     */
+    void build_mux_drivers(const RRGraph& rr_graph);
+
   public: /* Mutators: cleaners */
     void clear();
 
@@ -225,9 +287,15 @@ class RRGSB {
     /* Clean chan/opin/ipin nodes at one side */
     void clear_one_side(const e_side& node_side); 
 
+    /* Release the sorted incoming edges of routing channel rr_nodes */
+    void clear_chan_node_in_edges();
+
   private: /* Private Mutators: edge sorting */
-    /* Sort all the incoming edges for one channel rr_node */
+    /* Sort all the incoming edges for one channel rr_node,
+     * where the sort key of each source node is given by the look-up
+     */
     void sort_chan_node_in_edges(const RRGraph& rr_graph,
+                                 const std::unordered_map<RRNodeId, size_t>& src_node_sort_keys,
                                  const e_side& chan_side,
                                  const size_t& track_id);
 
@@ -245,6 +313,17 @@ class RRGSB {
 
     size_t get_track_id_first_short_connection(const RRGraph& rr_graph, const e_side& node_side) const; 
 
+    /* Index of a routing track among the tracks of all the sides, used to access the sorted edges */
+    size_t get_chan_node_index(const e_side& side, const size_t& track_id) const;
+
+    /* Index of an IPIN among the routing multiplexers, which follow the routing tracks of all the sides */
+    size_t get_ipin_mux_index(const e_side& side, const size_t& node_id) const;
+
+    /* Accessors to the resolved drivers of a routing multiplexer */
+    std::vector<RREdgeId> get_mux_driver_edges(const size_t& mux_index) const;
+    std::vector<RRNodeId> get_mux_driver_nodes(const RRGraph& rr_graph, const size_t& mux_index) const;
+    size_t find_mux_driver_path_id(const RRGraph& rr_graph, const size_t& mux_index, const RRNodeId& driver_node) const;
+
   private: /* internal validators */
     bool validate_num_sides() const;
     bool validate_side(const e_side& side) const;
@@ -274,9 +353,32 @@ class RRGSB {
      * the routing modules. Therefore, edge sorting can be done inside the GSB 
      *
      * Storage organization:
-     *   [chan_side][chan_node][edge_id_in_gsb_context]
+     *   The edges of all the routing tracks are stored in a flat array, track by track,
+     *   in the order of [chan_side][chan_node]. The edges of a track with index i
+     *   (see get_chan_node_index()) are in the range
+     *     [chan_node_in_edge_offsets_[i], chan_node_in_edge_offsets_[i + 1])
+     *   This avoids allocating an array for each routing track.
+     *   The offsets are empty when edges are not sorted
      */ 
-    std::vector<std::vector<std::vector<RREdgeId>>> chan_node_in_edges_;
+    std::vector<RREdgeId> chan_node_in_edges_;
+    std::vector<size_t> chan_node_in_edge_offsets_;
+
+    /* Configurable incoming edges of each routing multiplexer, in the sequence of its inputs (path ids),
+     * which are resolved once and shared by the builders of modules and bitstreams and the writers
+     *
+     * Storage organization:
+     *   The routing multiplexers are the routing tracks of all the sides (see get_chan_node_index()),
+     *   followed by the IPINs of all the sides (see get_ipin_mux_index()).
+     *   The edges of a multiplexer with index i are in the range
+     *     [mux_driver_offsets_[i], mux_driver_offsets_[i + 1])
+     *   and only the output routing tracks have edges.
+     *   In the same range, mux_driver_path_ids_ lists the path ids sorted by their driver nodes,
+     *   so that the path id of a driver node is found by a binary search
+     *   The offsets are empty when drivers are not resolved
+     */
+    std::vector<RREdgeId> mux_driver_edges_;
+    std::vector<size_t> mux_driver_path_ids_;
+    std::vector<size_t> mux_driver_offsets_;
 
     /* Logic Block Inputs data */
     std::vector<std::vector<RRNodeId>>  ipin_node_;
@@ -12,6 +12,9 @@
 #include "vtr_log.h"
 #include "vtr_memory.h"
 
+/* Headers from openfpgautil library */
+#include "openfpga_parallel.h"
+
 #include "vpr_error.h"
 #include "vpr_utils.h"
 
@@ -85,6 +88,7 @@ void build_tileable_unidir_rr_graph(const std::vector<t_physical_tile_type>& typ
                                     int* wire_to_rr_ipin_switch,
                                     const bool& through_channel,
                                     const bool& wire_opposite_side,
+                                    const size_t& num_threads,
                                     int *Warnings) { 
 
   vtr::ScopedStartFinishTimer timer("Build tileable routing resource graph");
@@ -236,7 +240,8 @@ void build_tileable_unidir_rr_graph(const std::vector<t_physical_tile_type>& typ
                        segment_inf, 
                        Fc_in, Fc_out,
                        sb_type, Fs, sb_subtype, subFs,
-                       wire_opposite_side);
+                       wire_opposite_side,
+                       find_num_threads(num_threads));
 
   /************************************************************************
    * Build direction connection lists
@@ -316,6 +321,11 @@ void build_tileable_unidir_rr_graph(const std::vector<t_physical_tile_type>& typ
               "but not smooth\n");
   }
 
+  /* The rr_graph is only read by routers and OpenFPGA from now on, 
+   * move it to the contiguous storage
+   */
+  device_ctx.rr_graph.freeze();
+
   /************************************************************************
    * Free all temp stucts 
    ***********************************************************************/
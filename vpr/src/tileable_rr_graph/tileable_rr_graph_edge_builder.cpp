@@ -9,6 +9,9 @@
 #include "vtr_log.h"
 #include "vtr_time.h"
 
+/* Headers from openfpgautil library */
+#include "openfpga_parallel.h"
+
 #include "vpr_utils.h"
 
 #include "rr_graph_builder_utils.h"
@@ -86,6 +89,11 @@ void build_rr_graph_edges_for_sink_nodes(RRGraph& rr_graph,
  * 1. create edges between CHANX | CHANY and IPINs (connections inside connection blocks)
  * 2. create edges between OPINs, CHANX and CHANY (connections inside switch blocks)
  * 3. create edges between OPINs and IPINs (direct-connections)
+ *
+ * The edges of each GSB are found independently, which is done in parallel
+ * for a batch of GSBs. Then the edges are added to the rr_graph GSB by GSB
+ * in the same order as a sequential run, so that the rr_graph
+ * is the same whatever number of threads is used
  ***********************************************************************/
 void build_rr_graph_edges(RRGraph& rr_graph, 
                           const vtr::vector<RRNodeId, RRSwitchId>& rr_node_driver_switches,
@@ -96,44 +104,67 @@ void build_rr_graph_edges(RRGraph& rr_graph,
                           const std::vector<vtr::Matrix<int>>& Fc_out,
                           const e_switch_block_type& sb_type, const int& Fs,
                           const e_switch_block_type& sb_subtype, const int& subFs,
-                          const bool& wire_opposite_side) {
+                          const bool& wire_opposite_side,
+                          const size_t& num_threads) {
 
   /* Create edges for SOURCE and SINK nodes for a tileable rr_graph */
   build_rr_graph_edges_for_source_nodes(rr_graph, rr_node_driver_switches, grids);
   build_rr_graph_edges_for_sink_nodes(rr_graph, rr_node_driver_switches, grids);
 
   vtr::Point<size_t> gsb_range(grids.width() - 2, grids.height() - 2);
+  size_t num_gsbs = (gsb_range.x() + 1) * (gsb_range.y() + 1);
+
+  /* The fast node look-up is built lazily, which should be done before going parallel */
+  rr_graph.initialize_fast_node_lookup();
+  const RRGraph& const_rr_graph = rr_graph;
+
+  /* Limit the number of GSBs in a batch, so are the edges kept in memory */
+  size_t batch_size = std::max(size_t(1), num_threads) * 64;
+  std::vector<std::vector<t_rr_gsb_edge>> gsb_edges(std::min(batch_size, num_gsbs));
+
+  /* Connection patterns are shared by identical GSBs, each thread has its own cache */
+  std::vector<t_gsb_pattern_cache> pattern_caches(std::max(size_t(1), num_threads));
 
   /* Go Switch Block by Switch Block */
-  for (size_t ix = 0; ix <= gsb_range.x(); ++ix) {
-    for (size_t iy = 0; iy <= gsb_range.y(); ++iy) { 
-      //vpr_printf(TIO_MESSAGE_INFO, "Building edges for GSB[%lu][%lu]\n", ix, iy);
+  for (size_t batch_start = 0; batch_start < num_gsbs; batch_start += batch_size) {
+    size_t num_batch_gsbs = std::min(batch_size, num_gsbs - batch_start);
 
-      vtr::Point<size_t> gsb_coord(ix, iy);
+    parallel_for_with_thread_id(num_batch_gsbs, num_threads, [&](const size_t& ibatch_gsb, const size_t& ithread) {
+      size_t igsb = batch_start + ibatch_gsb;
+      vtr::Point<size_t> gsb_coord(igsb / (gsb_range.y() + 1), igsb % (gsb_range.y() + 1));
       /* Create a GSB object */
-      const RRGSB& rr_gsb = build_one_tileable_rr_gsb(grids, rr_graph,
+      const RRGSB& rr_gsb = build_one_tileable_rr_gsb(grids, const_rr_graph,
                                                       device_chan_width, segment_inf,
                                                       gsb_coord);
 
       /* adapt the track_to_ipin_lookup for the GSB nodes */      
       t_track2pin_map track2ipin_map; /* [0..track_gsb_side][0..num_tracks][ipin_indices] */
-      track2ipin_map = build_gsb_track_to_ipin_map(rr_graph, rr_gsb, grids, segment_inf, Fc_in);
+      track2ipin_map = build_gsb_track_to_ipin_map(const_rr_graph, rr_gsb, grids, segment_inf, Fc_in,
+                                                   pattern_caches[ithread]);
 
       /* adapt the opin_to_track_map for the GSB nodes */      
       t_pin2track_map opin2track_map; /* [0..gsb_side][0..num_opin_node][track_indices] */
-      opin2track_map = build_gsb_opin_to_track_map(rr_graph, rr_gsb, grids, segment_inf, Fc_out);
+      opin2track_map = build_gsb_opin_to_track_map(const_rr_graph, rr_gsb, grids, segment_inf, Fc_out,
+                                                   pattern_caches[ithread]);
 
       /* adapt the switch_block_conn for the GSB nodes */      
       t_track2track_map sb_conn; /* [0..from_gsb_side][0..chan_width-1][track_indices] */
-      sb_conn = build_gsb_track_to_track_map(rr_graph, rr_gsb, 
+      sb_conn = build_gsb_track_to_track_map(const_rr_graph, rr_gsb, 
                                              sb_type, Fs, sb_subtype, subFs, wire_opposite_side, 
-                                             segment_inf);
-
-      /* Build edges for a GSB */
-      build_edges_for_one_tileable_rr_gsb(rr_graph, rr_gsb,
-                                          track2ipin_map, opin2track_map, 
-                                          sb_conn, rr_node_driver_switches);
-      /* Finish this GSB, go to the next*/
+                                             segment_inf, pattern_caches[ithread]);
+
+      /* Find the edges for a GSB */
+      gsb_edges[ibatch_gsb] = build_edge_list_for_one_tileable_rr_gsb(rr_gsb,
+                                                                      track2ipin_map, opin2track_map, 
+                                                                      sb_conn, rr_node_driver_switches);
+    });
+
+    /* Build edges for the GSBs in order */
+    for (size_t ibatch_gsb = 0; ibatch_gsb < num_batch_gsbs; ++ibatch_gsb) {
+      for (const t_rr_gsb_edge& edge : gsb_edges[ibatch_gsb]) {
+        rr_graph.create_edge(edge.src_node, edge.sink_node, edge.switch_id);
+      }
+      gsb_edges[ibatch_gsb].clear();
     }
   }
 }
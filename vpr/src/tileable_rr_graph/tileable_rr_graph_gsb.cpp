@@ -3,6 +3,7 @@
  *  tileable General Switch Block (GSB).
  ***********************************************************************/
 #include <vector>
+#include <map>
 #include <cmath>
 #include <algorithm>
 
@@ -312,20 +313,18 @@ std::vector<size_t> get_switch_block_to_track_id(const e_switch_block_type& swit
 
 
 /************************************************************************
- * Build the track_to_track_map[from_side][0..chan_width-1][to_side][track_indices] 
+ * Build the track_to_track_pattern[from_side][0..chan_width-1][<to_side, to_track_index>] 
  * For a group of from_track nodes and to_track nodes
  * For each side of from_tracks, we call a routine to get the list of to_tracks
- * Then, we fill the track2track_map
+ * Then, we fill the track2track_pattern
  ***********************************************************************/
 static 
-void build_gsb_one_group_track_to_track_map(const RRGraph& rr_graph, 
-                                            const RRGSB& rr_gsb, 
-                                            const e_switch_block_type& sb_type, 
-                                            const int& Fs,
-                                            const bool& wire_opposite_side,
-                                            const t_track_group& from_tracks, /* [0..gsb_side][track_indices] */
-                                            const t_track_group& to_tracks, /* [0..gsb_side][track_indices] */
-                                            t_track2track_map& track2track_map) {
+void build_gsb_one_group_track_to_track_pattern(const e_switch_block_type& sb_type, 
+                                                const int& Fs,
+                                                const bool& wire_opposite_side,
+                                                const t_track_group& from_tracks, /* [0..gsb_side][track_indices] */
+                                                const t_track_group& to_tracks, /* [0..gsb_side][track_indices] */
+                                                t_gsb_index_pattern& track2track_pattern) {
   for (size_t side = 0; side < from_tracks.size(); ++side) {
     SideManager side_manager(side);
     e_side from_side = side_manager.get_side();
@@ -363,39 +362,41 @@ void build_gsb_one_group_track_to_track_map(const RRGraph& rr_graph,
         std::vector<size_t> to_track_ids = get_switch_block_to_track_id(sb_type, Fs, from_side, inode, 
                                                                         to_side, 
                                                                         to_tracks[to_side_index].size()); 
-        /* Update the track2track_map: */
+        /* Update the track2track_pattern: */
         for (size_t to_track_id = 0; to_track_id < to_track_ids.size(); ++to_track_id) {
           size_t from_side_index = side_manager.to_size_t();
           size_t from_track_index = from_tracks[side][inode];
           /* Check the id is still in the range !*/
           VTR_ASSERT( to_track_ids[to_track_id] < to_tracks[to_side_index].size() );
-          size_t to_track_index = to_tracks[to_side_index][to_track_ids[to_track_id]];
-          //printf("from_track(size=%lu): %lu , to_track_ids[%lu]:%lu, to_track_index: %lu in a group of %lu tracks\n", 
-          //       from_tracks[side].size(), inode, to_track_id, to_track_ids[to_track_id], 
-          //       to_track_index, to_tracks[to_side_index].size());
-          const RRNodeId& to_track_node = rr_gsb.get_chan_node(to_side, to_track_index);
-          VTR_ASSERT(true == rr_graph.valid_node_id(to_track_node));
-
-          /* from_track should be IN_PORT */
-          VTR_ASSERT(IN_PORT == rr_gsb.get_chan_node_direction(from_side, from_track_index)); 
-          /* to_track should be OUT_PORT */
-          VTR_ASSERT(OUT_PORT == rr_gsb.get_chan_node_direction(to_side, to_track_index)); 
-
-          /* Check if the to_track_node is already in the list ! */
-          std::vector<RRNodeId>::iterator it = std::find(track2track_map[from_side_index][from_track_index].begin(),
-                                                         track2track_map[from_side_index][from_track_index].end(),
-                                                         to_track_node);
-          if (it != track2track_map[from_side_index][from_track_index].end()) {
-             continue; /* the node_id is already in the list, go for the next */
+          t_gsb_node_index to_track(to_side_index, to_tracks[to_side_index][to_track_ids[to_track_id]]);
+
+          /* Check if the to_track is already in the list ! */
+          std::vector<t_gsb_node_index>::iterator it = std::find(track2track_pattern[from_side_index][from_track_index].begin(),
+                                                                 track2track_pattern[from_side_index][from_track_index].end(),
+                                                                 to_track);
+          if (it != track2track_pattern[from_side_index][from_track_index].end()) {
+             continue; /* the track is already in the list, go for the next */
           }
           /* Clear, we should add to the list */
-          track2track_map[from_side_index][from_track_index].push_back(to_track_node);
+          track2track_pattern[from_side_index][from_track_index].push_back(to_track);
         }
       }
     }
   }
 }
 
+/************************************************************************
+ * Append a group of tracks to the structural signature of a GSB 
+ ***********************************************************************/
+static 
+void add_track_group_to_gsb_signature(const t_track_group& tracks, /* [0..gsb_side][track_indices] */
+                                      std::vector<size_t>& signature) {
+  for (const std::vector<int>& side_tracks : tracks) {
+    signature.push_back(side_tracks.size());
+    signature.insert(signature.end(), side_tracks.begin(), side_tracks.end());
+  }
+}
+
 /************************************************************************
  * Build the track_to_track_map[from_side][0..chan_width-1][to_side][track_indices] 
  * based on the existing routing resources in the General Switch Block (GSB)
@@ -439,6 +440,11 @@ void build_gsb_one_group_track_to_track_map(const RRGraph& rr_graph,
  *    a. tracks that will bypass at the TOP side
  *    b. tracks that will bypass at the BOTTOM side
  * 5. Apply switch block patterns to Group 2 (SUBSET, UNIVERSAL, WILTON) 
+ *
+ * The patterns depend only on the switch block types and the grouping of tracks,
+ * which are used as the signature of the GSB in the pattern cache.
+ * A pattern is therefore computed once for all the identical GSBs,
+ * and then remapped to the rr_nodes of each GSB
  ***********************************************************************/
 t_track2track_map build_gsb_track_to_track_map(const RRGraph& rr_graph,
                                                const RRGSB& rr_gsb,
@@ -447,7 +453,8 @@ t_track2track_map build_gsb_track_to_track_map(const RRGraph& rr_graph,
                                                const e_switch_block_type& sb_subtype, 
                                                const int& subFs,
                                                const bool& wire_opposite_side,
-                                               const std::vector<t_segment_inf>& segment_inf) {
+                                               const std::vector<t_segment_inf>& segment_inf,
+                                               t_gsb_pattern_cache& pattern_cache) {
   t_track2track_map track2track_map; /* [0..gsb_side][0..chan_width][track_indices] */
 
   /* Categorize tracks into 3 groups: 
@@ -502,35 +509,67 @@ t_track2track_map build_gsb_track_to_track_map(const RRGraph& rr_graph,
     }
   }
 
-  /* Allocate track2track map */
-  track2track_map.resize(rr_gsb.get_num_sides());
+  /* Build the structural signature of the GSB */
+  std::vector<size_t> signature = { size_t(sb_type), size_t(Fs), 
+                                    size_t(sb_subtype), size_t(subFs), 
+                                    size_t(wire_opposite_side) };
   for (size_t side = 0; side < rr_gsb.get_num_sides(); ++side) {
     SideManager side_manager(side);
-    enum e_side gsb_side = side_manager.get_side();
-    /* allocate track2track_map[gsb_side] */
-    track2track_map[side].resize(rr_gsb.get_chan_width(gsb_side));
-    for (size_t inode = 0; inode < rr_gsb.get_chan_width(gsb_side); ++inode) {
-      /* allocate track2track_map[gsb_side][inode] */
-      track2track_map[side][inode].clear();
-    }
+    signature.push_back(rr_gsb.get_chan_width(side_manager.get_side()));
   }
+  add_track_group_to_gsb_signature(start_tracks, signature);
+  add_track_group_to_gsb_signature(end_tracks, signature);
+  add_track_group_to_gsb_signature(pass_tracks, signature);
+
+  std::map<std::vector<size_t>, t_gsb_index_pattern>::const_iterator cached_pattern = pattern_cache.track2track.find(signature);
+  if (cached_pattern == pattern_cache.track2track.end()) {
+    /* Allocate track2track pattern */
+    t_gsb_index_pattern track2track_pattern(rr_gsb.get_num_sides());
+    for (size_t side = 0; side < rr_gsb.get_num_sides(); ++side) {
+      SideManager side_manager(side);
+      track2track_pattern[side].resize(rr_gsb.get_chan_width(side_manager.get_side()));
+    }
 
-  /* For Group 1: we build connections between end_tracks and start_tracks*/
-  build_gsb_one_group_track_to_track_map(rr_graph, rr_gsb, 
-                                         sb_type, Fs,
-                                         true, /* End tracks should always to wired to start tracks */ 
-                                         end_tracks, start_tracks,
-                                         track2track_map);
+    /* For Group 1: we build connections between end_tracks and start_tracks*/
+    build_gsb_one_group_track_to_track_pattern(sb_type, Fs,
+                                               true, /* End tracks should always to wired to start tracks */ 
+                                               end_tracks, start_tracks,
+                                               track2track_pattern);
 
-  /* For Group 2: we build connections between end_tracks and start_tracks*/
-  /* Currently, I use the same Switch Block pattern for the passing tracks and end tracks,
-   * TODO: This can be improved with different patterns! 
-   */
-  build_gsb_one_group_track_to_track_map(rr_graph, rr_gsb, 
-                                         sb_subtype, subFs,
-                                         wire_opposite_side, /* Pass tracks may not be wired to start tracks */ 
-                                         pass_tracks, start_tracks, 
-                                         track2track_map);
+    /* For Group 2: we build connections between end_tracks and start_tracks*/
+    /* Currently, I use the same Switch Block pattern for the passing tracks and end tracks,
+     * TODO: This can be improved with different patterns! 
+     */
+    build_gsb_one_group_track_to_track_pattern(sb_subtype, subFs,
+                                               wire_opposite_side, /* Pass tracks may not be wired to start tracks */ 
+                                               pass_tracks, start_tracks, 
+                                               track2track_pattern);
+
+    cached_pattern = pattern_cache.track2track.emplace(signature, track2track_pattern).first;
+  }
+
+  /* Remap the pattern to the rr_nodes of the GSB */
+  track2track_map.resize(cached_pattern->second.size());
+  for (size_t side = 0; side < cached_pattern->second.size(); ++side) {
+    SideManager side_manager(side);
+    e_side from_side = side_manager.get_side();
+    track2track_map[side].resize(cached_pattern->second[side].size());
+    for (size_t inode = 0; inode < cached_pattern->second[side].size(); ++inode) {
+      for (const t_gsb_node_index& to_track : cached_pattern->second[side][inode]) {
+        SideManager to_side_manager(to_track.first);
+        e_side to_side = to_side_manager.get_side();
+        const RRNodeId& to_track_node = rr_gsb.get_chan_node(to_side, to_track.second);
+        VTR_ASSERT(true == rr_graph.valid_node_id(to_track_node));
+
+        /* from_track should be IN_PORT */
+        VTR_ASSERT(IN_PORT == rr_gsb.get_chan_node_direction(from_side, inode)); 
+        /* to_track should be OUT_PORT */
+        VTR_ASSERT(OUT_PORT == rr_gsb.get_chan_node_direction(to_side, to_track.second)); 
+
+        track2track_map[side][inode].push_back(to_track_node);
+      }
+    }
+  }
 
   return track2track_map;
 }
@@ -897,17 +936,19 @@ RRGSB build_one_tileable_rr_gsb(const DeviceGrid& grids,
 }
 
 /************************************************************************
- * Create edges for each rr_node of a General Switch Blocks (GSB):
- * 1. create edges between CHANX | CHANY and IPINs (connections inside connection blocks) 
- * 2. create edges between OPINs, CHANX and CHANY (connections inside switch blocks) 
- * 3. create edges between OPINs and IPINs (direct-connections) 
+ * Find the edges to be created for each rr_node of a General Switch Blocks (GSB):
+ * 1. edges between CHANX | CHANY and IPINs (connections inside connection blocks) 
+ * 2. edges between OPINs, CHANX and CHANY (connections inside switch blocks) 
+ * 3. edges between OPINs and IPINs (direct-connections) 
+ * The rr_graph is not modified, so that the edges of different GSBs can be
+ * found in parallel
  ***********************************************************************/
-void build_edges_for_one_tileable_rr_gsb(RRGraph& rr_graph, 
-                                         const RRGSB& rr_gsb,
-                                         const t_track2pin_map& track2ipin_map,
-                                         const t_pin2track_map& opin2track_map,
-                                         const t_track2track_map& track2track_map,
-                                         const vtr::vector<RRNodeId, RRSwitchId>& rr_node_driver_switches) {
+std::vector<t_rr_gsb_edge> build_edge_list_for_one_tileable_rr_gsb(const RRGSB& rr_gsb,
+                                                                   const t_track2pin_map& track2ipin_map,
+                                                                   const t_pin2track_map& opin2track_map,
+                                                                   const t_track2track_map& track2track_map,
+                                                                   const vtr::vector<RRNodeId, RRSwitchId>& rr_node_driver_switches) {
+  std::vector<t_rr_gsb_edge> edges;
   
   /* Walk through each sides */ 
   for (size_t side = 0; side < rr_gsb.get_num_sides(); ++side) {
@@ -921,7 +962,7 @@ void build_edges_for_one_tileable_rr_gsb(RRGraph& rr_graph,
       /* 1. create edges between OPINs and CHANX|CHANY, using opin2track_map */
       /* add edges to the opin_node */
       for (const RRNodeId& track_node : opin2track_map[gsb_side][inode]) {
-        rr_graph.create_edge(opin_node, track_node, rr_node_driver_switches[track_node]);
+        edges.push_back({opin_node, track_node, rr_node_driver_switches[track_node]});
       }
     }
 
@@ -935,7 +976,7 @@ void build_edges_for_one_tileable_rr_gsb(RRGraph& rr_graph,
       for (size_t inode = 0; inode < rr_gsb.get_chan_width(gsb_side); ++inode) {
         const RRNodeId& chan_node = rr_gsb.get_chan_node(gsb_side, inode); 
         for (const RRNodeId& ipin_node : track2ipin_map[gsb_side][inode]) {
-          rr_graph.create_edge(chan_node, ipin_node, rr_node_driver_switches[ipin_node]);
+          edges.push_back({chan_node, ipin_node, rr_node_driver_switches[ipin_node]});
         }
       }
     }
@@ -944,53 +985,161 @@ void build_edges_for_one_tileable_rr_gsb(RRGraph& rr_graph,
     for (size_t inode = 0; inode < rr_gsb.get_chan_width(gsb_side); ++inode) {
       const RRNodeId& chan_node = rr_gsb.get_chan_node(gsb_side, inode); 
       for (const RRNodeId& track_node : track2track_map[gsb_side][inode]) {
-        rr_graph.create_edge(chan_node, track_node, rr_node_driver_switches[track_node]);
+        edges.push_back({chan_node, track_node, rr_node_driver_switches[track_node]});
       }
     }
   }
+
+  return edges;
 }
 
 /************************************************************************
- * Build track2ipin_map for an IPIN  
- * 1. build a list of routing tracks which are allowed for connections
- *    We will check the Connection Block (CB) population of each routing track. 
- *    By comparing current chan_y - ylow, we can determine if a CB connection
- *    is required for each routing track
- * 2. Divide the routing tracks by segment types, so that we can balance
- *    the connections between IPINs and different types of routing tracks.
- * 3. Scale the Fc of each pin to the actual number of routing tracks
- *    actual_Fc = (int) Fc * num_tracks / chan_width
+ * Create edges for each rr_node of a General Switch Blocks (GSB)
+ * See build_edge_list_for_one_tileable_rr_gsb() for the edges to be created
+ ***********************************************************************/
+void build_edges_for_one_tileable_rr_gsb(RRGraph& rr_graph, 
+                                         const RRGSB& rr_gsb,
+                                         const t_track2pin_map& track2ipin_map,
+                                         const t_pin2track_map& opin2track_map,
+                                         const t_track2track_map& track2track_map,
+                                         const vtr::vector<RRNodeId, RRSwitchId>& rr_node_driver_switches) {
+  for (const t_rr_gsb_edge& edge : build_edge_list_for_one_tileable_rr_gsb(rr_gsb,
+                                                                           track2ipin_map, opin2track_map,
+                                                                           track2track_map, rr_node_driver_switches)) {
+    rr_graph.create_edge(edge.src_node, edge.sink_node, edge.switch_id);
+  }
+}
+
+/************************************************************************
+ * Build a list of routing tracks for each segment of a channel in a GSB,
+ * which are allowed for connections to pins
+ * - For IPINs, we check the Connection Block (CB) population of each routing track. 
+ * - For OPINs, we check the Switch Block (SB) population of each routing track. 
+ *   and only the tracks starting from the GSB are allowed 
+ * The lists follow the order of segment ids in the channel
  ***********************************************************************/
 static 
-void build_gsb_one_ipin_track2pin_map(const RRGraph& rr_graph, 
-                                      const RRGSB& rr_gsb, 
-                                      const enum e_side& ipin_side, 
-                                      const size_t& ipin_node_id, 
-                                      const std::vector<int>& Fc, 
-                                      const size_t& offset, 
-                                      const std::vector<t_segment_inf>& segment_inf, 
-                                      t_track2pin_map& track2ipin_map) {
-  /* Get a list of segment_ids*/
-  enum e_side chan_side = rr_gsb.get_cb_chan_side(ipin_side);
-  SideManager chan_side_manager(chan_side);
+std::vector<std::vector<size_t>> build_gsb_chan_pin_track_lists(const RRGraph& rr_graph, 
+                                                                const RRGSB& rr_gsb, 
+                                                                const enum e_side& chan_side, 
+                                                                const enum e_pin_type& pin_type,
+                                                                const std::vector<t_segment_inf>& segment_inf) {
   std::vector<RRSegmentId> seg_list = rr_gsb.get_chan_segment_ids(chan_side);
-  size_t chan_width = rr_gsb.get_chan_width(chan_side);
-  SideManager ipin_side_manager(ipin_side);
-  const RRNodeId& ipin_node = rr_gsb.get_ipin_node(ipin_side, ipin_node_id);
+  std::vector<std::vector<size_t>> actual_track_lists(seg_list.size());
 
   for (size_t iseg = 0; iseg < seg_list.size(); ++iseg) {
     /* Get a list of node that have the segment id */
     std::vector<size_t> track_list = rr_gsb.get_chan_node_ids_by_segment_ids(chan_side, seg_list[iseg]);
     /* Refine the track_list: keep those will have connection blocks in the GSB */
-    std::vector<size_t> actual_track_list;
     for (size_t inode = 0; inode < track_list.size(); ++inode) {
-      /* Check if tracks allow connection blocks in the GSB*/
-      if (false == is_gsb_in_track_cb_population(rr_graph, rr_gsb, chan_side, track_list[inode], segment_inf)) {
-         continue; /* Bypass condition */
+      if (RECEIVER == pin_type) {
+        /* Check if tracks allow connection blocks in the GSB*/
+        if (false == is_gsb_in_track_cb_population(rr_graph, rr_gsb, chan_side, track_list[inode], segment_inf)) {
+           continue; /* Bypass condition */
+        }
+      } else {
+        VTR_ASSERT(DRIVER == pin_type);
+        /* Check if tracks allow switch blocks in the GSB*/
+        if (false == is_gsb_in_track_sb_population(rr_graph, rr_gsb, chan_side, 
+                                                   track_list[inode], segment_inf)) {
+           continue; /* Bypass condition */
+        }
+        if (TRACK_START != determine_track_status_of_gsb(rr_graph, rr_gsb, chan_side, track_list[inode])) {
+           continue; /* Bypass condition */
+        }
       }
       /* Push the node to actual_track_list  */
-      actual_track_list.push_back(track_list[inode]);
+      actual_track_lists[iseg].push_back(track_list[inode]);
     }
+  }
+
+  return actual_track_lists;
+}
+
+/************************************************************************
+ * Find the Fc of a pin for each segment, which is used to build 
+ * the connections between the pin and routing tracks
+ * Return an empty list if the pin should not be connected to any track:
+ * - the pin belongs to an EMPTY type
+ * - Fc = 0 or unintialized, those pins are in the <directlist>
+ ***********************************************************************/
+static 
+std::vector<int> find_gsb_pin_Fc(const RRGraph& rr_graph, 
+                                 const DeviceGrid& grids, 
+                                 const RRNodeId& pin_node, 
+                                 const std::vector<t_segment_inf>& segment_inf, 
+                                 const std::vector<vtr::Matrix<int>>& Fc) {
+  /* Skip EMPTY type */
+  if (true == is_empty_type(grids[rr_graph.node_xlow(pin_node)][rr_graph.node_ylow(pin_node)].type)) {
+    return std::vector<int>();
+  }
+
+  int grid_type_index = grids[rr_graph.node_xlow(pin_node)][rr_graph.node_ylow(pin_node)].type->index; 
+  /* Get Fc of the pin */
+  /* skip Fc = 0 or unintialized, those pins are in the <directlist> */
+  bool skip_conn2track = true; 
+  std::vector<int> pin_Fc;
+  for (size_t iseg = 0; iseg < segment_inf.size(); ++iseg) {
+    int seg_Fc = Fc[grid_type_index][rr_graph.node_pin_num(pin_node)][iseg];
+    pin_Fc.push_back(seg_Fc);
+    if (0 != seg_Fc) { 
+      skip_conn2track = false;
+      continue;
+    }
+  }
+
+  if (true == skip_conn2track) {
+    return std::vector<int>();
+  }
+
+  VTR_ASSERT(pin_Fc.size() == segment_inf.size());
+
+  return pin_Fc;
+}
+
+/************************************************************************
+ * Append the track lists and the Fc of pins to the structural signature of a GSB 
+ ***********************************************************************/
+static 
+void add_pin_tracks_to_gsb_signature(const std::vector<std::vector<size_t>>& track_lists, /* [iseg][track_indices] */
+                                     const std::vector<std::vector<int>>& pin_Fcs, /* [pin][iseg] */
+                                     std::vector<size_t>& signature) {
+  signature.push_back(track_lists.size());
+  for (const std::vector<size_t>& track_list : track_lists) {
+    signature.push_back(track_list.size());
+    signature.insert(signature.end(), track_list.begin(), track_list.end());
+  }
+  signature.push_back(pin_Fcs.size());
+  for (const std::vector<int>& pin_Fc : pin_Fcs) {
+    signature.push_back(pin_Fc.size());
+    for (const int& seg_Fc : pin_Fc) {
+      signature.push_back(size_t(seg_Fc));
+    }
+  }
+}
+
+/************************************************************************
+ * Build track2ipin_pattern for an IPIN  
+ * 1. build a list of routing tracks which are allowed for connections
+ *    We will check the Connection Block (CB) population of each routing track. 
+ *    By comparing current chan_y - ylow, we can determine if a CB connection
+ *    is required for each routing track
+ * 2. Divide the routing tracks by segment types, so that we can balance
+ *    the connections between IPINs and different types of routing tracks.
+ * 3. Scale the Fc of each pin to the actual number of routing tracks
+ *    actual_Fc = (int) Fc * num_tracks / chan_width
+ * Step 1 and 2 are done by build_gsb_chan_pin_track_lists() and shared by the IPINs
+ ***********************************************************************/
+static 
+void build_gsb_one_ipin_track2pin_pattern(const size_t& chan_side_index, 
+                                          const size_t& chan_width, 
+                                          const std::vector<std::vector<size_t>>& track_lists, /* [iseg][track_indices] */
+                                          const t_gsb_node_index& ipin, 
+                                          const std::vector<int>& Fc, 
+                                          const size_t& offset, 
+                                          t_gsb_index_pattern& track2ipin_pattern) {
+  for (size_t iseg = 0; iseg < track_lists.size(); ++iseg) {
+    std::vector<size_t> actual_track_list = track_lists[iseg];
     /* Check the actual track list */
     VTR_ASSERT(0 == actual_track_list.size() % 2);
    
@@ -1016,18 +1165,17 @@ void build_gsb_one_ipin_track2pin_map(const RRGraph& rr_graph,
     /* Keep assigning until we meet the Fc requirement */
     for (size_t itrack = 0; itrack < actual_track_list.size(); itrack = itrack + 2 * track_step) {
       /* Update pin2track map */ 
-      size_t chan_side_index = chan_side_manager.to_size_t();
       /* itrack may exceed the size of actual_track_list, adapt it */
       size_t actual_itrack = itrack % actual_track_list.size();
       /* track_index may exceed the chan_width(), adapt it */
       size_t track_index = actual_track_list[actual_itrack] % chan_width;
 
-      track2ipin_map[chan_side_index][track_index].push_back(ipin_node);
+      track2ipin_pattern[chan_side_index][track_index].push_back(ipin);
 
       /* track_index may exceed the chan_width(), adapt it */
       track_index = (actual_track_list[actual_itrack] + 1) % chan_width;
 
-      track2ipin_map[chan_side_index][track_index].push_back(ipin_node);
+      track2ipin_pattern[chan_side_index][track_index].push_back(ipin);
 
       track_cnt += 2;
     }
@@ -1045,7 +1193,7 @@ void build_gsb_one_ipin_track2pin_map(const RRGraph& rr_graph,
 }
 
 /************************************************************************
- * Build opin2track_map for an OPIN  
+ * Build opin2track_pattern for an OPIN  
  * 1. build a list of routing tracks which are allowed for connections
  *    We will check the Switch Block (SB) population of each routing track. 
  *    By comparing current chan_y - ylow, we can determine if a SB connection
@@ -1054,39 +1202,21 @@ void build_gsb_one_ipin_track2pin_map(const RRGraph& rr_graph,
  *    the connections between OPINs and different types of routing tracks.
  * 3. Scale the Fc of each pin to the actual number of routing tracks
  *    actual_Fc = (int) Fc * num_tracks / chan_width
+ * Step 1 and 2 are done by build_gsb_chan_pin_track_lists() and shared by the OPINs
  ***********************************************************************/
 static 
-void build_gsb_one_opin_pin2track_map(const RRGraph& rr_graph, 
-                                      const RRGSB& rr_gsb, 
-                                      const enum e_side& opin_side, 
-                                      const size_t& opin_node_id, 
-                                      const std::vector<int>& Fc,
-                                      const size_t& offset, 
-                                      const std::vector<t_segment_inf>& segment_inf, 
-                                      t_pin2track_map& opin2track_map) {
-  /* Get a list of segment_ids*/
-  std::vector<RRSegmentId> seg_list = rr_gsb.get_chan_segment_ids(opin_side);
-  enum e_side chan_side = opin_side;
-  size_t chan_width = rr_gsb.get_chan_width(chan_side);
-  SideManager opin_side_manager(opin_side);
-
-  for (size_t iseg = 0; iseg < seg_list.size(); ++iseg) {
-    /* Get a list of node that have the segment id */
-    std::vector<size_t> track_list = rr_gsb.get_chan_node_ids_by_segment_ids(chan_side, seg_list[iseg]);
-    /* Refine the track_list: keep those will have connection blocks in the GSB */
-    std::vector<size_t> actual_track_list;
-    for (size_t inode = 0; inode < track_list.size(); ++inode) {
-      /* Check if tracks allow connection blocks in the GSB*/
-      if (false == is_gsb_in_track_sb_population(rr_graph, rr_gsb, chan_side, 
-                                                 track_list[inode], segment_inf)) {
-         continue; /* Bypass condition */
-      }
-      if (TRACK_START != determine_track_status_of_gsb(rr_graph, rr_gsb, chan_side, track_list[inode])) {
-         continue; /* Bypass condition */
-      }
-      /* Push the node to actual_track_list  */
-      actual_track_list.push_back(track_list[inode]);
-    }
+void build_gsb_one_opin_pin2track_pattern(const size_t& opin_side_index, 
+                                          const size_t& opin_node_id, 
+                                          const size_t& chan_width, 
+                                          const std::vector<std::vector<size_t>>& track_lists, /* [iseg][track_indices] */
+                                          const std::vector<int>& Fc,
+                                          const size_t& offset, 
+                                          t_gsb_index_pattern& opin2track_pattern) {
+  /* The chan_side is the same as the opin side */
+  size_t chan_side_index = opin_side_index;
+
+  for (size_t iseg = 0; iseg < track_lists.size(); ++iseg) {
+    std::vector<size_t> actual_track_list = track_lists[iseg];
 
     /* Go the next segment if offset is zero or actual_track_list is empty */    
     if (0 == actual_track_list.size()) {
@@ -1118,12 +1248,10 @@ void build_gsb_one_opin_pin2track_map(const RRGraph& rr_graph,
     /* Keep assigning until we meet the Fc requirement */
     for (size_t itrack = 0; itrack < actual_track_list.size(); itrack = itrack + track_step) {
       /* Update pin2track map */ 
-      size_t opin_side_index = opin_side_manager.to_size_t();
       /* itrack may exceed the size of actual_track_list, adapt it */
       size_t actual_itrack = itrack % actual_track_list.size();
       size_t track_index = actual_track_list[actual_itrack];
-      const RRNodeId& track_rr_node_index = rr_gsb.get_chan_node(chan_side, track_index);
-      opin2track_map[opin_side_index][opin_node_id].push_back(track_rr_node_index);
+      opin2track_pattern[opin_side_index][opin_node_id].push_back(t_gsb_node_index(chan_side_index, track_index));
       /* update track counter */
       track_cnt++;
       /* Stop when we have enough Fc: this may lead to some tracks have zero drivers. 
@@ -1156,79 +1284,112 @@ void build_gsb_one_opin_pin2track_map(const RRGraph& rr_graph,
  *    For each IPIN, we ensure at least one connection to the tracks.
  *    Then, we assign IPINs to tracks evenly while satisfying the actual_Fc 
  * 2. Convert the ipin_to_track_map to track_to_ipin_map
+ *
+ * The mapping depends only on the channel widths, the tracks allowed 
+ * for connections and the Fc of IPINs, which are used as the signature 
+ * of the GSB in the pattern cache.
+ * The mapping is built once for all the identical GSBs, 
+ * and then remapped to the rr_nodes of each GSB
  ***********************************************************************/
 t_track2pin_map build_gsb_track_to_ipin_map(const RRGraph& rr_graph,
                                             const RRGSB& rr_gsb, 
                                             const DeviceGrid& grids, 
                                             const std::vector<t_segment_inf>& segment_inf, 
-                                            const std::vector<vtr::Matrix<int>>& Fc_in) {
-  t_track2pin_map track2ipin_map;
-  /* Resize the matrix */ 
-  track2ipin_map.resize(rr_gsb.get_num_sides());
-  
-  /* offset counter: it aims to balance the track-to-IPIN for each connection block */
-  size_t offset_size = 0;
-  std::vector<size_t> offset;
-  for (size_t side = 0; side < rr_gsb.get_num_sides(); ++side) {
-    SideManager side_manager(side);
-    enum e_side ipin_side = side_manager.get_side();
-    /* Get the chan_side */
-    enum e_side chan_side = rr_gsb.get_cb_chan_side(ipin_side);
-    SideManager chan_side_manager(chan_side);
-    /* resize offset to the maximum chan_side*/
-    offset_size = std::max(offset_size, chan_side_manager.to_size_t() + 1);
-  }
-  /* Initial offset */
-  offset.resize(offset_size);
-  offset.assign(offset.size(), 0);
-     
-  /* Walk through each side */
+                                            const std::vector<vtr::Matrix<int>>& Fc_in,
+                                            t_gsb_pattern_cache& pattern_cache) {
+  /* Collect the tracks and the Fc of IPINs on each side, and build the signature of the GSB */
+  std::vector<std::vector<std::vector<size_t>>> track_lists(rr_gsb.get_num_sides()); /* [ipin_side][iseg][track_indices] */
+  std::vector<std::vector<std::vector<int>>> ipin_Fcs(rr_gsb.get_num_sides()); /* [ipin_side][ipin][iseg] */
+  std::vector<size_t> signature;
   for (size_t side = 0; side < rr_gsb.get_num_sides(); ++side) {
     SideManager side_manager(side);
     enum e_side ipin_side = side_manager.get_side();
     /* Get the chan_side */
     enum e_side chan_side = rr_gsb.get_cb_chan_side(ipin_side);
     SideManager chan_side_manager(chan_side);
-    /* This track2pin mapping is for Connection Blocks, so we only care two sides! */
-    /* Get channel width and resize the matrix */
-    size_t chan_width = rr_gsb.get_chan_width(chan_side);
-    track2ipin_map[chan_side_manager.to_size_t()].resize(chan_width); 
-    /* Find the ipin/opin nodes */
+
+    bool require_tracks = false;
     for (size_t inode = 0; inode < rr_gsb.get_num_ipin_nodes(ipin_side); ++inode) {
       const RRNodeId& ipin_node = rr_gsb.get_ipin_node(ipin_side, inode);
-      /* Skip EMPTY type */
-      if (true == is_empty_type(grids[rr_graph.node_xlow(ipin_node)][rr_graph.node_ylow(ipin_node)].type)) {
-        continue;
+      ipin_Fcs[side].push_back(find_gsb_pin_Fc(rr_graph, grids, ipin_node, segment_inf, Fc_in));
+      if (false == ipin_Fcs[side].back().empty()) {
+        require_tracks = true;
       }
+    }
+    /* The tracks are only searched when there are IPINs to connect */
+    if (true == require_tracks) {
+      track_lists[side] = build_gsb_chan_pin_track_lists(rr_graph, rr_gsb, chan_side, RECEIVER, segment_inf);
+    }
+
+    signature.push_back(chan_side_manager.to_size_t());
+    signature.push_back(rr_gsb.get_chan_width(chan_side));
+    add_pin_tracks_to_gsb_signature(track_lists[side], ipin_Fcs[side], signature);
+  }
 
-      int grid_type_index = grids[rr_graph.node_xlow(ipin_node)][rr_graph.node_ylow(ipin_node)].type->index; 
-      /* Get Fc of the ipin */
-      /* skip Fc = 0 or unintialized, those pins are in the <directlist> */
-      bool skip_conn2track = true; 
-      std::vector<int> ipin_Fc_out;
-      for (size_t iseg = 0; iseg < segment_inf.size(); ++iseg) {
-        int ipin_Fc = Fc_in[grid_type_index][rr_graph.node_pin_num(ipin_node)][iseg];
-        ipin_Fc_out.push_back(ipin_Fc);
-        if (0 != ipin_Fc) { 
-          skip_conn2track = false;
+  std::map<std::vector<size_t>, t_gsb_index_pattern>::const_iterator cached_pattern = pattern_cache.track2ipin.find(signature);
+  if (cached_pattern == pattern_cache.track2ipin.end()) {
+    t_gsb_index_pattern track2ipin_pattern;
+    /* Resize the matrix */ 
+    track2ipin_pattern.resize(rr_gsb.get_num_sides());
+  
+    /* offset counter: it aims to balance the track-to-IPIN for each connection block */
+    size_t offset_size = 0;
+    std::vector<size_t> offset;
+    for (size_t side = 0; side < rr_gsb.get_num_sides(); ++side) {
+      SideManager side_manager(side);
+      enum e_side ipin_side = side_manager.get_side();
+      /* Get the chan_side */
+      enum e_side chan_side = rr_gsb.get_cb_chan_side(ipin_side);
+      SideManager chan_side_manager(chan_side);
+      /* resize offset to the maximum chan_side*/
+      offset_size = std::max(offset_size, chan_side_manager.to_size_t() + 1);
+    }
+    /* Initial offset */
+    offset.resize(offset_size);
+    offset.assign(offset.size(), 0);
+     
+    /* Walk through each side */
+    for (size_t side = 0; side < rr_gsb.get_num_sides(); ++side) {
+      SideManager side_manager(side);
+      enum e_side ipin_side = side_manager.get_side();
+      /* Get the chan_side */
+      enum e_side chan_side = rr_gsb.get_cb_chan_side(ipin_side);
+      SideManager chan_side_manager(chan_side);
+      /* This track2pin mapping is for Connection Blocks, so we only care two sides! */
+      /* Get channel width and resize the matrix */
+      size_t chan_width = rr_gsb.get_chan_width(chan_side);
+      track2ipin_pattern[chan_side_manager.to_size_t()].resize(chan_width); 
+      /* Find the ipin/opin nodes */
+      for (size_t inode = 0; inode < ipin_Fcs[side].size(); ++inode) {
+        /* Skip the IPINs which are not connected to tracks */
+        if (true == ipin_Fcs[side][inode].empty()) {
           continue;
         }
-      }
 
-      if (true == skip_conn2track) {
-        continue;
+        /* Build track2ipin_pattern for this IPIN */
+        build_gsb_one_ipin_track2pin_pattern(chan_side_manager.to_size_t(), chan_width, 
+                                             track_lists[side], t_gsb_node_index(side, inode), 
+                                             ipin_Fcs[side][inode], 
+                                             /* Give an offset for the first track that this ipin will connect to */
+                                             offset[chan_side_manager.to_size_t()], 
+                                             track2ipin_pattern);
+        /* update offset */
+        offset[chan_side_manager.to_size_t()] += 2;
       }
+    }
 
-      VTR_ASSERT(ipin_Fc_out.size() == segment_inf.size());
+    cached_pattern = pattern_cache.track2ipin.emplace(signature, track2ipin_pattern).first;
+  }
 
-      /* Build track2ipin_map for this IPIN */
-      build_gsb_one_ipin_track2pin_map(rr_graph, rr_gsb, ipin_side, inode, ipin_Fc_out, 
-                                       /* Give an offset for the first track that this ipin will connect to */
-                                       offset[chan_side_manager.to_size_t()], 
-                                       segment_inf, track2ipin_map);
-      /* update offset */
-      offset[chan_side_manager.to_size_t()] += 2;
-      //printf("offset[%lu]=%lu\n", chan_side_manager.to_size_t(), offset[chan_side_manager.to_size_t()]);
+  /* Remap the pattern to the rr_nodes of the GSB */
+  t_track2pin_map track2ipin_map(cached_pattern->second.size());
+  for (size_t side = 0; side < cached_pattern->second.size(); ++side) {
+    track2ipin_map[side].resize(cached_pattern->second[side].size());
+    for (size_t itrack = 0; itrack < cached_pattern->second[side].size(); ++itrack) {
+      for (const t_gsb_node_index& ipin : cached_pattern->second[side][itrack]) {
+        SideManager ipin_side_manager(ipin.first);
+        track2ipin_map[side][itrack].push_back(rr_gsb.get_ipin_node(ipin_side_manager.get_side(), ipin.second));
+      }
     }
   }
 
@@ -1246,71 +1407,95 @@ t_track2pin_map build_gsb_track_to_ipin_map(const RRGraph& rr_graph,
  *    the connections between OPINs and different types of routing tracks.
  * 3. Scale the Fc of each pin to the actual number of routing tracks
  *    actual_Fc = (int) Fc * num_tracks / chan_width
+ *
+ * Similar to the track_to_ipin_map, the mapping is cached by the signature of the GSB
  ***********************************************************************/
 t_pin2track_map build_gsb_opin_to_track_map(const RRGraph& rr_graph,
                                             const RRGSB& rr_gsb, 
                                             const DeviceGrid& grids, 
                                             const std::vector<t_segment_inf>& segment_inf, 
-                                            const std::vector<vtr::Matrix<int>>& Fc_out) {
-  t_pin2track_map opin2track_map;
-  /* Resize the matrix */ 
-  opin2track_map.resize(rr_gsb.get_num_sides());
-  
-  /* offset counter: it aims to balance the OPIN-to-track for each switch block */
-  std::vector<size_t> offset;
-  /* Get the chan_side: which is the same as the opin side  */
-  offset.resize(rr_gsb.get_num_sides());
-  /* Initial offset */
-  offset.assign(offset.size(), 0);
-     
-  /* Walk through each side */
+                                            const std::vector<vtr::Matrix<int>>& Fc_out,
+                                            t_gsb_pattern_cache& pattern_cache) {
+  /* Collect the tracks and the Fc of OPINs on each side, and build the signature of the GSB */
+  std::vector<std::vector<std::vector<size_t>>> track_lists(rr_gsb.get_num_sides()); /* [opin_side][iseg][track_indices] */
+  std::vector<std::vector<std::vector<int>>> opin_Fcs(rr_gsb.get_num_sides()); /* [opin_side][opin][iseg] */
+  std::vector<size_t> signature;
   for (size_t side = 0; side < rr_gsb.get_num_sides(); ++side) {
     SideManager side_manager(side);
     enum e_side opin_side = side_manager.get_side();
-    /* Get the chan_side */
-    /* This track2pin mapping is for Connection Blocks, so we only care two sides! */
-    /* Get channel width and resize the matrix */
-    size_t num_opin_nodes = rr_gsb.get_num_opin_nodes(opin_side);
-    opin2track_map[side].resize(num_opin_nodes); 
-    /* Find the ipin/opin nodes */
-    for (size_t inode = 0; inode < num_opin_nodes; ++inode) {
+
+    bool require_tracks = false;
+    for (size_t inode = 0; inode < rr_gsb.get_num_opin_nodes(opin_side); ++inode) {
       const RRNodeId& opin_node = rr_gsb.get_opin_node(opin_side, inode);
-      /* Skip EMPTY type */
-      if (true == is_empty_type(grids[rr_graph.node_xlow(opin_node)][rr_graph.node_ylow(opin_node)].type)) {
-        continue;
+      opin_Fcs[side].push_back(find_gsb_pin_Fc(rr_graph, grids, opin_node, segment_inf, Fc_out));
+      if (false == opin_Fcs[side].back().empty()) {
+        require_tracks = true;
       }
-      int grid_type_index = grids[rr_graph.node_xlow(opin_node)][rr_graph.node_ylow(opin_node)].type->index; 
-
-      /* Get Fc of the ipin */
-      /* skip Fc = 0 or unintialized, those pins are in the <directlist> */
-      bool skip_conn2track = true; 
-      std::vector<int> opin_Fc_out;
-      for (size_t iseg = 0; iseg < segment_inf.size(); ++iseg) {
-        int opin_Fc = Fc_out[grid_type_index][rr_graph.node_pin_num(opin_node)][iseg];
-        opin_Fc_out.push_back(opin_Fc);
-        if (0 != opin_Fc) { 
-          skip_conn2track = false;
+    }
+    /* The tracks are only searched when there are OPINs to connect */
+    if (true == require_tracks) {
+      track_lists[side] = build_gsb_chan_pin_track_lists(rr_graph, rr_gsb, opin_side, DRIVER, segment_inf);
+    }
+
+    signature.push_back(rr_gsb.get_chan_width(opin_side));
+    add_pin_tracks_to_gsb_signature(track_lists[side], opin_Fcs[side], signature);
+  }
+
+  std::map<std::vector<size_t>, t_gsb_index_pattern>::const_iterator cached_pattern = pattern_cache.opin2track.find(signature);
+  if (cached_pattern == pattern_cache.opin2track.end()) {
+    t_gsb_index_pattern opin2track_pattern;
+    /* Resize the matrix */ 
+    opin2track_pattern.resize(rr_gsb.get_num_sides());
+  
+    /* offset counter: it aims to balance the OPIN-to-track for each switch block */
+    std::vector<size_t> offset;
+    /* Get the chan_side: which is the same as the opin side  */
+    offset.resize(rr_gsb.get_num_sides());
+    /* Initial offset */
+    offset.assign(offset.size(), 0);
+     
+    /* Walk through each side */
+    for (size_t side = 0; side < rr_gsb.get_num_sides(); ++side) {
+      SideManager side_manager(side);
+      enum e_side opin_side = side_manager.get_side();
+      size_t num_opin_nodes = opin_Fcs[side].size();
+      opin2track_pattern[side].resize(num_opin_nodes); 
+      /* Find the ipin/opin nodes */
+      for (size_t inode = 0; inode < num_opin_nodes; ++inode) {
+        /* Skip the OPINs which are not connected to tracks */
+        if (true == opin_Fcs[side][inode].empty()) {
           continue;
         }
-      }
 
-      if (true == skip_conn2track) {
-        continue;
+        /* Build opin2track_pattern for this OPIN */
+        build_gsb_one_opin_pin2track_pattern(side_manager.to_size_t(), inode, 
+                                             rr_gsb.get_chan_width(opin_side), 
+                                             track_lists[side], opin_Fcs[side][inode], 
+                                             /* Give an offset for the first track that this ipin will connect to */
+                                             offset[side_manager.to_size_t()], 
+                                             opin2track_pattern);
+        /* update offset: aim to rotate starting tracks by 1*/
+        offset[side_manager.to_size_t()] += 1;
       }
-      VTR_ASSERT(opin_Fc_out.size() == segment_inf.size());
-
-      /* Build track2ipin_map for this IPIN */
-      build_gsb_one_opin_pin2track_map(rr_graph, rr_gsb, opin_side, inode, opin_Fc_out, 
-                                       /* Give an offset for the first track that this ipin will connect to */
-                                       offset[side_manager.to_size_t()], 
-                                       segment_inf, opin2track_map);
-      /* update offset: aim to rotate starting tracks by 1*/
-      offset[side_manager.to_size_t()] += 1;
+
+      /* Check:
+       * 1. We want to ensure that each OPIN will drive at least one track
+       * 2. We want to ensure that each track will be driven by at least 1 OPIN */
     }
 
-    /* Check:
-     * 1. We want to ensure that each OPIN will drive at least one track
-     * 2. We want to ensure that each track will be driven by at least 1 OPIN */
+    cached_pattern = pattern_cache.opin2track.emplace(signature, opin2track_pattern).first;
+  }
+
+  /* Remap the pattern to the rr_nodes of the GSB */
+  t_pin2track_map opin2track_map(cached_pattern->second.size());
+  for (size_t side = 0; side < cached_pattern->second.size(); ++side) {
+    opin2track_map[side].resize(cached_pattern->second[side].size());
+    for (size_t inode = 0; inode < cached_pattern->second[side].size(); ++inode) {
+      for (const t_gsb_node_index& track : cached_pattern->second[side][inode]) {
+        SideManager chan_side_manager(track.first);
+        opin2track_map[side][inode].push_back(rr_gsb.get_chan_node(chan_side_manager.get_side(), track.second));
+      }
+    }
   }
 
   return opin2track_map;
@@ -5,6 +5,8 @@
  * Include header files that are required by function declaration
  *******************************************************************/
 #include <vector>
+#include <map>
+#include <utility>
 
 #include "vtr_vector.h"
 #include "vtr_geometry.h"
@@ -30,6 +32,28 @@ typedef std::vector<std::vector<std::vector<RRNodeId>>> t_track2track_map;
 typedef std::vector<std::vector<std::vector<RRNodeId>>> t_track2pin_map;
 typedef std::vector<std::vector<std::vector<RRNodeId>>> t_pin2track_map;
 
+/* A node of a GSB in the index space: <gsb_side, node index on the side> */
+typedef std::pair<size_t, size_t> t_gsb_node_index;
+/* The maps above with the nodes in the index space of a GSB */
+typedef std::vector<std::vector<std::vector<t_gsb_node_index>>> t_gsb_index_pattern;
+
+/* Most GSBs in a tileable fabric are structurally identical.
+ * The connection patterns of GSBs are cached by their structural signature,
+ * so that a pattern is computed only once and then remapped to the rr_nodes of each GSB.
+ * A cache is not thread-safe, each thread should own one */
+struct t_gsb_pattern_cache {
+  std::map<std::vector<size_t>, t_gsb_index_pattern> track2track;
+  std::map<std::vector<size_t>, t_gsb_index_pattern> track2ipin;
+  std::map<std::vector<size_t>, t_gsb_index_pattern> opin2track;
+};
+
+/* An edge to be created in the rr_graph */
+struct t_rr_gsb_edge {
+  RRNodeId src_node;
+  RRNodeId sink_node;
+  RRSwitchId switch_id;
+};
+
 /************************************************************************
  * Functions 
  ***********************************************************************/
@@ -40,7 +64,8 @@ t_track2track_map build_gsb_track_to_track_map(const RRGraph& rr_graph,
                                                const e_switch_block_type& sb_subtype, 
                                                const int& subFs,
                                                const bool& wire_opposite_side,
-                                               const std::vector<t_segment_inf>& segment_inf);
+                                               const std::vector<t_segment_inf>& segment_inf,
+                                               t_gsb_pattern_cache& pattern_cache);
 
 RRGSB build_one_tileable_rr_gsb(const DeviceGrid& grids, 
                                 const RRGraph& rr_graph,
@@ -48,6 +73,12 @@ RRGSB build_one_tileable_rr_gsb(const DeviceGrid& grids,
                                 const std::vector<t_segment_inf>& segment_inf,
                                 const vtr::Point<size_t>& gsb_coordinate);
 
+std::vector<t_rr_gsb_edge> build_edge_list_for_one_tileable_rr_gsb(const RRGSB& rr_gsb,
+                                                                   const t_track2pin_map& track2ipin_map,
+                                                                   const t_pin2track_map& opin2track_map,
+                                                                   const t_track2track_map& track2track_map,
+                                                                   const vtr::vector<RRNodeId, RRSwitchId>& rr_node_driver_switches);
+
 void build_edges_for_one_tileable_rr_gsb(RRGraph& rr_graph, 
                                          const RRGSB& rr_gsb,
                                          const t_track2pin_map& track2ipin_map,
@@ -59,13 +90,15 @@ t_track2pin_map build_gsb_track_to_ipin_map(const RRGraph& rr_graph,
                                             const RRGSB& rr_gsb, 
                                             const DeviceGrid& grids, 
                                             const std::vector<t_segment_inf>& segment_inf, 
-                                            const std::vector<vtr::Matrix<int>>& Fc_in);
+                                            const std::vector<vtr::Matrix<int>>& Fc_in,
+                                            t_gsb_pattern_cache& pattern_cache);
 
 t_pin2track_map build_gsb_opin_to_track_map(const RRGraph& rr_graph,
                                             const RRGSB& rr_gsb, 
                                             const DeviceGrid& grids, 
                                             const std::vector<t_segment_inf>& segment_inf, 
-                                            const std::vector<vtr::Matrix<int>>& Fc_out);
+                                            const std::vector<vtr::Matrix<int>>& Fc_out,
+                                            t_gsb_pattern_cache& pattern_cache);
 
 void build_direct_connections_for_one_gsb(RRGraph& rr_graph,
                                           const DeviceGrid& grids,
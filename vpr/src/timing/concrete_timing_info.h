@@ -99,6 +99,9 @@ class ConcreteSetupTimingInfo : public SetupTimingInfo {
         }
     }
 
+    void invalidate_delay(const tatum::EdgeId edge) override { setup_analyzer_->invalidate_edge(edge); }
+    void invalidate_all_delays() override { setup_analyzer_->invalidate_all_edges(); }
+
     void update_setup() override {
         //Update the arrival and required times and re-calculate slacks
         double sta_wallclock_time = 0.;
@@ -213,6 +216,9 @@ class ConcreteHoldTimingInfo : public HoldTimingInfo {
         }
     }
 
+    void invalidate_delay(const tatum::EdgeId edge) override { hold_analyzer_->invalidate_edge(edge); }
+    void invalidate_all_delays() override { hold_analyzer_->invalidate_all_edges(); }
+
     void update_hold() override {
         double sta_wallclock_time = 0.;
         {
@@ -348,6 +354,9 @@ class ConcreteSetupHoldTimingInfo : public SetupHoldTimingInfo {
         timing_ctx.stats.num_full_setup_hold_updates += 1;
     }
 
+    void invalidate_delay(const tatum::EdgeId edge) override { setup_hold_analyzer_->invalidate_edge(edge); }
+    void invalidate_all_delays() override { setup_hold_analyzer_->invalidate_all_edges(); }
+
     //Update hold only
     void update_hold() override { hold_timing_.update_hold(); }
 
@@ -420,6 +429,8 @@ class ConstantTimingInfo : public SetupHoldTimingInfo {
 
   public: //Mutators
     void update() override {}
+    void invalidate_delay(const tatum::EdgeId /*edge*/) override {}
+    void invalidate_all_delays() override {}
     void update_hold() override {}
     void update_setup() override {}
 
@@ -7,9 +7,19 @@
 #include "tatum/timing_paths.hpp"
 #include "timing_util.h"
 
+//How the timing analyzer of a TimingInfo updates the timing information
+enum class e_timing_update_type {
+    FULL,       //Re-analyze the whole timing graph on every update
+    INCREMENTAL //Re-analyze only the parts of the timing graph affected by the invalidated delays
+};
+
 //Create a SetupTimingInfo for the given delay calculator
+//
+//With an INCREMENTAL update type, the delays of the edges modified since the last update
+//must be reported with TimingInfo::invalidate_delay() (or TimingInfo::invalidate_all_delays())
 template<class DelayCalc>
-std::unique_ptr<SetupTimingInfo> make_setup_timing_info(std::shared_ptr<DelayCalc> delay_calculator);
+std::unique_ptr<SetupTimingInfo> make_setup_timing_info(std::shared_ptr<DelayCalc> delay_calculator,
+                                                        e_timing_update_type update_type = e_timing_update_type::FULL);
 
 //Create a HoldTimingInfo for the given delay calculator
 template<class DelayCalc>
@@ -41,6 +51,15 @@ class TimingInfo {
     //Update all timing information
     virtual void update() = 0;
 
+    //Mark the delay of a timing graph edge as modified since the last update.
+    //Only incremental timing analyzers make use of it, to limit the next update
+    //to the parts of the timing graph affected by the edge
+    virtual void invalidate_delay(const tatum::EdgeId edge) = 0;
+
+    //Mark the delays of all the timing graph edges as modified, so that the next
+    //update re-analyzes the whole timing graph
+    virtual void invalidate_all_delays() = 0;
+
     //Return the underlying timing analyzer
     virtual std::shared_ptr<const tatum::TimingAnalyzer> analyzer() const = 0;
 
@@ -142,10 +161,16 @@ class SetupHoldTimingInfo : public SetupTimingInfo, public HoldTimingInfo {
 #include "concrete_timing_info.h"
 
 template<class DelayCalc>
-std::unique_ptr<SetupTimingInfo> make_setup_timing_info(std::shared_ptr<DelayCalc> delay_calculator) {
+std::unique_ptr<SetupTimingInfo> make_setup_timing_info(std::shared_ptr<DelayCalc> delay_calculator, e_timing_update_type update_type) {
     auto& timing_ctx = g_vpr_ctx.timing();
 
-    std::shared_ptr<tatum::SetupTimingAnalyzer> analyzer = tatum::AnalyzerFactory<tatum::SetupAnalysis, tatum::ParallelWalker>::make(*timing_ctx.graph, *timing_ctx.constraints, *delay_calculator);
+    std::shared_ptr<tatum::SetupTimingAnalyzer> analyzer;
+    if (update_type == e_timing_update_type::INCREMENTAL) {
+        analyzer = tatum::IncrAnalyzerFactory<tatum::SetupAnalysis, tatum::ParallelWalker>::make(*timing_ctx.graph, *timing_ctx.constraints, *delay_calculator);
+    } else {
+        VTR_ASSERT(update_type == e_timing_update_type::FULL);
+        analyzer = tatum::AnalyzerFactory<tatum::SetupAnalysis, tatum::ParallelWalker>::make(*timing_ctx.graph, *timing_ctx.constraints, *delay_calculator);
+    }
 
     return std::make_unique<ConcreteSetupTimingInfo<DelayCalc>>(timing_ctx.graph, timing_ctx.constraints, delay_calculator, analyzer);
 }
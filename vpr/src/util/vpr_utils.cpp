@@ -1510,6 +1510,9 @@ void free_pb_stats(t_pb* pb) {
         if (pb->pb_stats->feasible_blocks) {
             free(pb->pb_stats->feasible_blocks);
         }
+        if (pb->pb_stats->feasible_block_gains) {
+            free(pb->pb_stats->feasible_block_gains);
+        }
         if (!pb->parent_pb) {
             pb->pb_stats->transitive_fanout_candidates.clear();
         }
@@ -3,6 +3,7 @@
 #include "read_xml_arch_file.h"
 #include "rr_metadata.h"
 #include "rr_graph_writer.h"
+#include "rr_graph_capnp.h"
 #include "arch_util.h"
 #include "vpr_api.h"
 #include <cstring>
@@ -14,6 +15,7 @@ using Catch::Matchers::Equals;
 
 static constexpr const char kArchFile[] = "test_read_arch_metadata.xml";
 static constexpr const char kRrGraphFile[] = "test_read_rrgraph_metadata.xml";
+static constexpr const char kRrGraphCapnpFile[] = "test_read_rrgraph_metadata.capnp";
 
 TEST_CASE("read_arch_metadata", "[vpr]") {
     t_arch arch;
@@ -191,4 +193,95 @@ TEST_CASE("read_rr_graph_metadata", "[vpr]") {
     vpr_free_all(arch, vpr_setup);
 }
 
+#ifdef VTR_ENABLE_CAPNPROTO
+TEST_CASE("read_capnp_rr_graph", "[vpr]") {
+    size_t num_nodes = 0;
+    size_t num_edges = 0;
+    int src_inode = -1;
+    int sink_inode = -1;
+    short switch_id = -1;
+
+    {
+        t_vpr_setup vpr_setup;
+        t_arch arch;
+        t_options options;
+        const char* argv[] = {
+            "test_vpr",
+            kArchFile,
+            "wire.eblif",
+            "--route_chan_width",
+            "100",
+        };
+        vpr_init(sizeof(argv) / sizeof(argv[0]), argv,
+                 &options, &vpr_setup, &arch);
+        vpr_create_device(vpr_setup, arch);
+
+        const auto& rr_graph = g_vpr_ctx.device().rr_graph;
+        num_nodes = rr_graph.nodes().size();
+        num_edges = rr_graph.edges().size();
+
+        for (const RRNodeId& inode : rr_graph.nodes()) {
+            if ((rr_graph.node_type(inode) == CHANX || rr_graph.node_type(inode) == CHANY) && rr_graph.node_out_edges(inode).size() > 0) {
+                RREdgeId edge = *rr_graph.node_out_edges(inode).begin();
+                src_inode = rr_graph.node_index(inode);
+                sink_inode = rr_graph.node_index(rr_graph.edge_sink_node(edge));
+                switch_id = rr_graph.switch_index(rr_graph.edge_switch(edge));
+                break;
+            }
+        }
+
+        REQUIRE(src_inode != -1);
+
+        vpr::add_rr_node_metadata(src_inode, "node", "test node");
+        vpr::add_rr_edge_metadata(src_inode, sink_inode, switch_id, "edge", "test edge");
+
+        write_capnp_rr_graph(kRrGraphCapnpFile, rr_graph);
+        vpr_free_all(arch, vpr_setup);
+    }
+
+    t_vpr_setup vpr_setup;
+    t_arch arch;
+    t_options options;
+    const char* argv[] = {
+        "test_vpr",
+        kArchFile,
+        "wire.eblif",
+        "--route_chan_width",
+        "100",
+        "--read_rr_graph",
+        kRrGraphCapnpFile,
+    };
+
+    vpr_init(sizeof(argv) / sizeof(argv[0]), argv,
+             &options, &vpr_setup, &arch);
+    vpr_create_device(vpr_setup, arch);
+
+    const auto& device_ctx = g_vpr_ctx.device();
+    CHECK(device_ctx.rr_graph.nodes().size() == num_nodes);
+    CHECK(device_ctx.rr_graph.edges().size() == num_edges);
+    CHECK(device_ctx.rr_node_metadata.size() == 1);
+    CHECK(device_ctx.rr_edge_metadata.size() == 1);
+
+    for (const auto& node_meta : device_ctx.rr_node_metadata) {
+        CHECK(node_meta.first == src_inode);
+        REQUIRE(node_meta.second.has("node"));
+        auto* value = node_meta.second.one("node");
+        REQUIRE(value != nullptr);
+        CHECK_THAT(value->as_string(), Equals("test node"));
+    }
+
+    for (const auto& edge_meta : device_ctx.rr_edge_metadata) {
+        CHECK(std::get<0>(edge_meta.first) == src_inode);
+        CHECK(std::get<1>(edge_meta.first) == sink_inode);
+        CHECK(std::get<2>(edge_meta.first) == switch_id);
+
+        REQUIRE(edge_meta.second.has("edge"));
+        auto* value = edge_meta.second.one("edge");
+        REQUIRE(value != nullptr);
+        CHECK_THAT(value->as_string(), Equals("test edge"));
+    }
+    vpr_free_all(arch, vpr_setup);
+}
+#endif
+
 } // namespace